@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include "centurion/video/color.hpp"
+
+static void BM_ColorFromHsv(benchmark::State& state)
+{
+  float hue {};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cen::color::from_hsv(hue, 75, 50));
+    hue = (hue < 359) ? hue + 1 : 0;
+  }
+}
+BENCHMARK(BM_ColorFromHsv);
+
+static void BM_ColorFromHsl(benchmark::State& state)
+{
+  float hue {};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cen::color::from_hsl(hue, 75, 50));
+    hue = (hue < 359) ? hue + 1 : 0;
+  }
+}
+BENCHMARK(BM_ColorFromHsl);
+
+static void BM_ColorFromHsvInt(benchmark::State& state)
+{
+  int hue {};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cen::color::from_hsv_int(hue, 75, 50));
+    hue = (hue + 1) % 360;
+  }
+}
+BENCHMARK(BM_ColorFromHsvInt);
+
+static void BM_ColorFromRgba(benchmark::State& state)
+{
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cen::color::from_rgba("#1A2B3C4D"));
+  }
+}
+BENCHMARK(BM_ColorFromRgba);
+
+static void BM_ColorAsRgba(benchmark::State& state)
+{
+  const cen::color color {0x1A, 0x2B, 0x3C, 0x4D};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(color.as_rgba());
+  }
+}
+BENCHMARK(BM_ColorAsRgba);
+
+static void BM_ColorBlend(benchmark::State& state)
+{
+  const cen::color a {0x10, 0x20, 0x30};
+  const cen::color b {0xF0, 0xE0, 0xD0};
+  float bias {};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cen::blend(a, b, bias));
+    bias = (bias < 1) ? bias + 0.01f : 0;
+  }
+}
+BENCHMARK(BM_ColorBlend);
+
+static void BM_ColorBlendInt(benchmark::State& state)
+{
+  const cen::color a {0x10, 0x20, 0x30};
+  const cen::color b {0xF0, 0xE0, 0xD0};
+  cen::uint8 weight {};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(cen::blend_int(a, b, weight));
+    ++weight;
+  }
+}
+BENCHMARK(BM_ColorBlendInt);
@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include <vector>  // vector
+
+#include "centurion/events/event_batch.hpp"
+#include "centurion/events/event_dispatcher.hpp"
+#include "centurion/events/event_handler.hpp"
+#include "centurion/events/misc_events.hpp"
+
+namespace {
+
+using dispatcher_type = cen::event_dispatcher<cen::quit_event, cen::user_event>;
+
+inline constexpr int queued_events = 256;
+
+struct counter final {
+  int count {};
+
+  void operator()(const cen::user_event&) noexcept { ++count; }
+};
+
+void push_events()
+{
+  const cen::user_event event;
+  for (int index = 0; index < queued_events; ++index) {
+    cen::event_handler::push(event);
+  }
+}
+
+/* Connects the specified amount of listeners to the user event sink */
+void connect_listeners(dispatcher_type& dispatcher,
+                       std::vector<counter>& counters,
+                       const benchmark::State& state)
+{
+  counters.resize(static_cast<std::size_t>(state.range(0)));
+  for (auto& listener : counters) {
+    dispatcher.bind<cen::user_event>().connect(listener);
+  }
+}
+
+}  // namespace
+
+static void BM_EventDispatcherPoll(benchmark::State& state)
+{
+  dispatcher_type dispatcher;
+  std::vector<counter> counters;
+  connect_listeners(dispatcher, counters, state);
+
+  cen::event_handler::flush_all();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    push_events();
+    state.ResumeTiming();
+
+    dispatcher.poll();
+  }
+
+  state.SetItemsProcessed(state.iterations() * queued_events);
+}
+BENCHMARK(BM_EventDispatcherPoll)->Arg(0)->Arg(1)->Arg(4)->Arg(16);
+
+static void BM_EventDispatcherPollBatch(benchmark::State& state)
+{
+  dispatcher_type dispatcher;
+  std::vector<counter> counters;
+  connect_listeners(dispatcher, counters, state);
+
+  cen::event_batch batch;
+  cen::event_handler::flush_all();
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    push_events();
+    state.ResumeTiming();
+
+    dispatcher.poll(batch);
+  }
+
+  state.SetItemsProcessed(state.iterations() * queued_events);
+}
+BENCHMARK(BM_EventDispatcherPollBatch)->Arg(0)->Arg(1)->Arg(4)->Arg(16);
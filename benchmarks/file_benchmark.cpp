@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include <vector>  // vector
+
+#include "centurion/io/buffered_file.hpp"
+#include "centurion/io/file.hpp"
+#include "centurion/io/mapped_file.hpp"
+
+namespace {
+
+inline constexpr auto path = RESOURCE_DIR "hidden_pond.mp3";
+
+}  // namespace
+
+static void BM_FileReadWhole(benchmark::State& state)
+{
+  std::vector<cen::uint8> buffer;
+
+  for (auto _ : state) {
+    cen::file file {path, cen::file_mode::rb};
+    buffer.resize(file.size().value_or(0));
+    benchmark::DoNotOptimize(file.read_to(buffer));
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(buffer.size()));
+}
+BENCHMARK(BM_FileReadWhole);
+
+static void BM_FileReadBytes(benchmark::State& state)
+{
+  std::size_t bytes {};
+
+  for (auto _ : state) {
+    cen::file file {path, cen::file_mode::rb};
+    const auto size = file.size().value_or(0);
+
+    unsigned sum {};
+    for (std::size_t index = 0; index < size; ++index) {
+      sum += file.read_byte();
+    }
+
+    benchmark::DoNotOptimize(sum);
+    bytes = size;
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_FileReadBytes);
+
+static void BM_BufferedFileReadBytes(benchmark::State& state)
+{
+  std::size_t bytes {};
+
+  for (auto _ : state) {
+    cen::file file {path, cen::file_mode::rb};
+    const auto size = file.size().value_or(0);
+
+    cen::buffered_file_reader reader {file, static_cast<std::size_t>(state.range(0))};
+
+    unsigned sum {};
+    for (std::size_t index = 0; index < size; ++index) {
+      sum += reader.read_byte();
+    }
+
+    benchmark::DoNotOptimize(sum);
+    bytes = size;
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_BufferedFileReadBytes)->Arg(4 * 1'024)->Arg(64 * 1'024);
+
+static void BM_MappedFileRead(benchmark::State& state)
+{
+  std::size_t bytes {};
+
+  for (auto _ : state) {
+    const cen::mapped_file file {path};
+
+    unsigned sum {};
+    for (std::size_t index = 0; index < file.size(); ++index) {
+      sum += file.data()[index];
+    }
+
+    benchmark::DoNotOptimize(sum);
+    bytes = file.size();
+  }
+
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_MappedFileRead);
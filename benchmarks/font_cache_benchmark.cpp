@@ -0,0 +1,74 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include <string_view>  // string_view
+
+#include "centurion/fonts/font_cache.hpp"
+#include "centurion/video/software_canvas.hpp"
+
+namespace {
+
+inline constexpr std::string_view text = "The quick brown fox jumps over the lazy dog 0123";
+
+}  // namespace
+
+static void BM_FontCacheRenderText(benchmark::State& state)
+{
+  cen::software_canvas canvas;
+  auto& renderer = canvas.get_renderer();
+
+  cen::font_cache cache {RESOURCE_DIR "daniel.ttf", 16};
+  cache.store_basic_latin_glyphs(renderer);
+
+  for (auto _ : state) {
+    cache.render_text(renderer, text, {10, 10});
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_FontCacheRenderText);
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+static void BM_FontCacheRenderTextBatched(benchmark::State& state)
+{
+  cen::software_canvas canvas;
+  auto& renderer = canvas.get_renderer();
+
+  cen::font_cache cache {RESOURCE_DIR "daniel.ttf", 16};
+  cache.enable_atlas();
+  cache.store_basic_latin_glyphs(renderer);
+
+  for (auto _ : state) {
+    cache.render_text_batched(renderer, text, {10, 10});
+  }
+
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+BENCHMARK(BM_FontCacheRenderTextBatched);
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
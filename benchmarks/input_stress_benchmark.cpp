@@ -0,0 +1,151 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+
+#include <benchmark/benchmark.h>
+
+#include <vector>  // vector
+
+#include "centurion/events/event_dispatcher.hpp"
+#include "centurion/events/event_handler.hpp"
+#include "centurion/events/joystick_events.hpp"
+#include "centurion/input/controller.hpp"
+#include "centurion/input/controller_state.hpp"
+#include "centurion/input/input_stress.hpp"
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+
+namespace {
+
+using dispatcher_type =
+    cen::event_dispatcher<cen::joy_axis_event, cen::joy_button_event, cen::joy_hat_event>;
+
+/* Every device changes an input roughly every other millisecond */
+inline constexpr double changes_per_second = 500;
+
+inline constexpr cen::u64ms frame_time {16};
+
+struct counter final {
+  int count {};
+
+  template <typename Event>
+  void operator()(const Event&) noexcept
+  {
+    ++count;
+  }
+};
+
+[[nodiscard]] auto make_cfg(const benchmark::State& state) -> cen::stress_cfg
+{
+  cen::stress_cfg cfg;
+  cfg.devices = static_cast<cen::usize>(state.range(0));
+  cfg.rate = changes_per_second;
+  return cfg;
+}
+
+/* Opens all virtual devices as game controllers, so that they can be queried */
+[[nodiscard]] auto open_controllers(const cen::input_stress& stress)
+    -> std::vector<cen::controller>
+{
+  std::vector<cen::controller> controllers;
+  controllers.reserve(stress.device_count());
+
+  for (cen::usize device = 0; device < stress.device_count(); ++device) {
+    controllers.emplace_back(*stress.device_index_of(device));
+  }
+
+  return controllers;
+}
+
+}  // namespace
+
+static void BM_InputStressEventThroughput(benchmark::State& state)
+{
+  cen::input_stress stress {make_cfg(state)};
+  cen::event_handler::flush_all();
+
+  cen::event_handler handler;
+  int64_t events = 0;
+
+  for (auto _ : state) {
+    stress.update(frame_time);
+    cen::event_handler::update();
+
+    while (handler.poll()) {
+      ++events;
+    }
+  }
+
+  state.SetItemsProcessed(events);
+}
+BENCHMARK(BM_InputStressEventThroughput)->Arg(1)->Arg(4)->Arg(8);
+
+static void BM_InputStressDispatch(benchmark::State& state)
+{
+  cen::input_stress stress {make_cfg(state)};
+  cen::event_handler::flush_all();
+
+  counter listener;
+  dispatcher_type dispatcher;
+  dispatcher.bind<cen::joy_axis_event>().connect(listener);
+  dispatcher.bind<cen::joy_button_event>().connect(listener);
+  dispatcher.bind<cen::joy_hat_event>().connect(listener);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    stress.update(frame_time);
+    cen::event_handler::update();
+    state.ResumeTiming();
+
+    dispatcher.poll();
+  }
+
+  state.SetItemsProcessed(listener.count);
+}
+BENCHMARK(BM_InputStressDispatch)->Arg(1)->Arg(4)->Arg(8);
+
+static void BM_InputStressControllerSnapshot(benchmark::State& state)
+{
+  cen::input_stress stress {make_cfg(state)};
+  const auto controllers = open_controllers(stress);
+
+  std::vector<cen::controller_state> states;
+  int64_t snapshots = 0;
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    stress.update(frame_time);
+    state.ResumeTiming();
+
+    snapshots += static_cast<int64_t>(cen::poll_all_controllers(states));
+    benchmark::DoNotOptimize(states.data());
+  }
+
+  cen::event_handler::flush_all();
+  state.SetItemsProcessed(snapshots);
+}
+BENCHMARK(BM_InputStressControllerSnapshot)->Arg(1)->Arg(4)->Arg(8);
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
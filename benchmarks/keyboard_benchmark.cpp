@@ -0,0 +1,50 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include "centurion/input/keyboard.hpp"
+
+static void BM_KeyboardRefresh(benchmark::State& state)
+{
+  cen::keyboard keyboard;
+
+  for (auto _ : state) {
+    keyboard.refresh();
+    benchmark::ClobberMemory();
+  }
+}
+BENCHMARK(BM_KeyboardRefresh);
+
+static void BM_KeyboardJustPressed(benchmark::State& state)
+{
+  cen::keyboard keyboard;
+  keyboard.refresh();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(keyboard.just_pressed(cen::scancodes::space));
+  }
+}
+BENCHMARK(BM_KeyboardJustPressed);
@@ -0,0 +1,48 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "centurion/concurrency/adaptive_mutex.hpp"
+#include "centurion/concurrency/locks.hpp"
+#include "centurion/concurrency/mutex.hpp"
+#include "centurion/concurrency/spin_lock.hpp"
+
+/* Every thread of a run increments the same counter, so the lock is contended with threads */
+template <typename Mutex>
+static void BM_LockIncrement(benchmark::State& state)
+{
+  static Mutex mutex;
+  static int counter {};
+
+  for (auto _ : state) {
+    cen::scoped_lock lock {mutex};
+    benchmark::DoNotOptimize(++counter);
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_TEMPLATE(BM_LockIncrement, cen::mutex)->Threads(1)->Threads(4);
+BENCHMARK_TEMPLATE(BM_LockIncrement, cen::spin_lock)->Threads(1)->Threads(4);
+BENCHMARK_TEMPLATE(BM_LockIncrement, cen::adaptive_mutex)->Threads(1)->Threads(4);
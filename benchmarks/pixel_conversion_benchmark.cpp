@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "centurion/common/utils.hpp"
+#include "centurion/detail/pixel_conversion.hpp"
+#include "centurion/video/pixels.hpp"
+#include "centurion/video/surface.hpp"
+
+namespace {
+
+inline constexpr cen::iarea frame_size {3840, 2160};
+
+}  // namespace
+
+static void BM_PixelConversionSDL(benchmark::State& state)
+{
+  const auto target = cen::to_underlying(cen::pixel_format::abgr8888);
+  const cen::surface source {frame_size, cen::pixel_format::argb8888};
+
+  for (auto _ : state) {
+    SDL_FreeSurface(SDL_ConvertSurfaceFormat(source.get(), target, 0));
+  }
+
+  state.SetItemsProcessed(state.iterations() * frame_size.width * frame_size.height);
+}
+BENCHMARK(BM_PixelConversionSDL);
+
+static void BM_PixelConversionFast(benchmark::State& state)
+{
+  const auto target = cen::to_underlying(cen::pixel_format::abgr8888);
+  const cen::surface source {frame_size, cen::pixel_format::argb8888};
+
+  for (auto _ : state) {
+    SDL_FreeSurface(cen::detail::convert_surface_fast(source.get(), target));
+  }
+
+  state.SetItemsProcessed(state.iterations() * frame_size.width * frame_size.height);
+}
+BENCHMARK(BM_PixelConversionFast);
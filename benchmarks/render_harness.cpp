@@ -0,0 +1,344 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <cstdio>      // printf, fprintf
+#include <cstdlib>     // strtoull
+#include <cstring>     // strcmp
+#include <fstream>     // ifstream, ofstream
+#include <functional>  // function
+#include <map>         // map
+#include <string>      // string
+#include <vector>      // vector
+
+#include "centurion/fonts/font.hpp"
+#include "centurion/fonts/font_cache.hpp"
+#include "centurion/initialization.hpp"
+#include "centurion/system/timer.hpp"
+#include "centurion/video/color.hpp"
+#include "centurion/video/image_loader.hpp"
+#include "centurion/video/render_command_list.hpp"
+#include "centurion/video/software_canvas.hpp"
+#include "centurion/video/sprite_batch.hpp"
+#include "centurion/video/texture.hpp"
+
+/*
+ * Renders a set of fixed scenes with an offscreen software renderer, reporting the frame
+ * times and a checksum of the final frame of each scene. Software rendering is deterministic
+ * for a given SDL version, so CI can verify both speed and correctness in a single run.
+ *
+ * Usage: centurion-render-harness [--frames <n>] [--record <file>] [--verify <file>]
+ *
+ *   --frames  the amount of measured frames per scene, defaults to 100.
+ *   --record  writes the scene checksums to a file.
+ *   --verify  compares the scene checksums with a file written by --record, and fails if
+ *             any checksum differs.
+ */
+
+namespace {
+
+using checksum_map = std::map<std::string, cen::uint64>;
+
+struct scene final {
+  std::string name;
+  std::function<void(cen::renderer&)> draw;  ///< Renders a single frame.
+};
+
+struct scene_result final {
+  double mean {};  ///< Mean frame time, in milliseconds.
+  double min {};
+  double max {};
+  cen::uint64 checksum {};
+};
+
+/* A small deterministic generator, so that scenes are identical across platforms */
+class scene_random final {
+ public:
+  [[nodiscard]] auto next(const int bound) noexcept -> int
+  {
+    mState = mState * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<int>((mState >> 33u) % static_cast<cen::uint64>(bound));
+  }
+
+  [[nodiscard]] auto next_color() noexcept -> cen::color
+  {
+    return {static_cast<cen::uint8>(next(256)),
+            static_cast<cen::uint8>(next(256)),
+            static_cast<cen::uint8>(next(256))};
+  }
+
+ private:
+  cen::uint64 mState {0x853C49E6748FEA9Bull};
+};
+
+[[nodiscard]] auto record_primitives() -> cen::render_command_list
+{
+  scene_random random;
+  cen::render_command_list commands;
+
+  commands.clear_with(cen::colors::black);
+
+  for (int index = 0; index < 500; ++index) {
+    commands.set_color(random.next_color());
+    commands.fill_rect(cen::irect {random.next(760), random.next(560), 40, 40});
+  }
+
+  for (int index = 0; index < 200; ++index) {
+    commands.set_color(random.next_color());
+    commands.draw_line(cen::ipoint {random.next(800), random.next(600)},
+                       cen::ipoint {random.next(800), random.next(600)});
+  }
+
+  for (int index = 0; index < 100; ++index) {
+    commands.set_color(random.next_color());
+    commands.draw_rect(cen::irect {random.next(700), random.next(500), 100, 100});
+  }
+
+  return commands;
+}
+
+[[nodiscard]] auto record_sprites(const cen::texture& texture) -> cen::render_command_list
+{
+  scene_random random;
+  cen::render_command_list commands;
+
+  commands.clear_with(cen::colors::dark_slate_gray);
+
+  for (int index = 0; index < 1'000; ++index) {
+    const auto x = static_cast<float>(random.next(768));
+    const auto y = static_cast<float>(random.next(568));
+    commands.render(texture, cen::frect {x, y, 32, 32});
+  }
+
+  return commands;
+}
+
+[[nodiscard]] auto run_scene(cen::software_canvas& canvas,
+                             const scene& scene,
+                             const int frames) -> scene_result
+{
+  auto& renderer = canvas.get_renderer();
+
+  /* Warm up caches, e.g. glyph atlases and texture conversions */
+  for (int frame = 0; frame < 3; ++frame) {
+    scene.draw(renderer);
+    renderer.present();
+  }
+
+  scene_result result;
+  result.min = 1e9;
+
+  const auto frequency = static_cast<double>(cen::frequency());
+  double total {};
+
+  for (int frame = 0; frame < frames; ++frame) {
+    const auto start = cen::now();
+
+    scene.draw(renderer);
+    renderer.present();
+
+    const auto elapsed = static_cast<double>(cen::now() - start) * 1'000.0 / frequency;
+    total += elapsed;
+    result.min = (elapsed < result.min) ? elapsed : result.min;
+    result.max = (elapsed > result.max) ? elapsed : result.max;
+  }
+
+  result.mean = total / frames;
+  result.checksum = canvas.checksum();
+
+  return result;
+}
+
+[[nodiscard]] auto read_checksums(const char* path) -> checksum_map
+{
+  checksum_map checksums;
+
+  std::ifstream stream {path};
+  std::string name;
+  std::string value;
+  while (stream >> name >> value) {
+    checksums[name] = std::strtoull(value.c_str(), nullptr, 16);
+  }
+
+  return checksums;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[])
+{
+  int frames = 100;
+  const char* recordPath = nullptr;
+  const char* verifyPath = nullptr;
+
+  for (int index = 1; index + 1 < argc; index += 2) {
+    if (std::strcmp(argv[index], "--frames") == 0) {
+      frames = std::atoi(argv[index + 1]);
+    }
+    else if (std::strcmp(argv[index], "--record") == 0) {
+      recordPath = argv[index + 1];
+    }
+    else if (std::strcmp(argv[index], "--verify") == 0) {
+      verifyPath = argv[index + 1];
+    }
+    else {
+      std::fprintf(stderr, "Unknown option '%s'\n", argv[index]);
+      return 1;
+    }
+  }
+
+  if (frames <= 0) {
+    std::fprintf(stderr, "The amount of frames must be positive\n");
+    return 1;
+  }
+
+  SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+
+  cen::sdl_cfg cfg;
+  cfg.flags = SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER;
+  const cen::sdl sdl {cfg};
+  const cen::img img;
+  const cen::ttf ttf;
+
+  cen::software_canvas canvas;
+  auto& renderer = canvas.get_renderer();
+
+  const auto sprite = renderer.make_texture(RESOURCE_DIR "panda.png");
+  auto primitives = record_primitives();
+  auto sprites = record_sprites(sprite);
+
+  cen::font_cache glyphs {RESOURCE_DIR "daniel.ttf", 16};
+  glyphs.store_basic_latin_glyphs(renderer);
+
+  const auto draw_text = [](cen::renderer& target,
+                            cen::font_cache& cache,
+                            const bool batched) {
+    target.clear_with(cen::colors::black);
+
+    for (int line = 0; line < 30; ++line) {
+      const cen::ipoint position {10, 10 + line * 19};
+      const std::string_view text = "Sphinx of black quartz, judge my vow! 0123456789";
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+      if (batched) {
+        cache.render_text_batched(target, text, position);
+        continue;
+      }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+      static_cast<void>(batched);
+      cache.render_text(target, text, position);
+    }
+  };
+
+  std::vector<scene> scenes;
+  scenes.push_back({"primitives", [&](cen::renderer& target) { primitives.execute(target); }});
+  scenes.push_back({"sprites", [&](cen::renderer& target) { sprites.execute(target); }});
+  scenes.push_back(
+      {"text", [&](cen::renderer& target) { draw_text(target, glyphs, false); }});
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+  scene_random random;
+  std::vector<cen::frect> positions;
+  for (int index = 0; index < 1'000; ++index) {
+    positions.emplace_back(static_cast<float>(random.next(768)),
+                           static_cast<float>(random.next(568)),
+                           32.0f,
+                           32.0f);
+  }
+
+  cen::sprite_batch batch;
+  scenes.push_back({"sprites_batched", [&](cen::renderer& target) {
+                      target.clear_with(cen::colors::dark_slate_gray);
+                      for (const auto& position : positions) {
+                        batch.add(sprite, position);
+                      }
+                      static_cast<void>(batch.flush(target));
+                    }});
+
+  cen::font_cache atlasGlyphs {RESOURCE_DIR "daniel.ttf", 16};
+  atlasGlyphs.enable_atlas();
+  atlasGlyphs.store_basic_latin_glyphs(renderer);
+
+  scenes.push_back(
+      {"text_batched", [&](cen::renderer& target) { draw_text(target, atlasGlyphs, true); }});
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+  const auto expected = verifyPath ? read_checksums(verifyPath) : checksum_map {};
+  std::ofstream record;
+  if (recordPath) {
+    record.open(recordPath);
+  }
+
+  int failures = 0;
+
+  std::printf("%-16s %8s %10s %10s %10s  %-16s\n",
+              "scene",
+              "frames",
+              "mean (ms)",
+              "min (ms)",
+              "max (ms)",
+              "checksum");
+
+  for (const auto& scene : scenes) {
+    const auto result = run_scene(canvas, scene, frames);
+
+    const char* status = "";
+    if (verifyPath) {
+      const auto it = expected.find(scene.name);
+      if (it == expected.end()) {
+        status = "  (no reference)";
+      }
+      else if (it->second != result.checksum) {
+        status = "  MISMATCH";
+        ++failures;
+      }
+      else {
+        status = "  ok";
+      }
+    }
+
+    std::printf("%-16s %8d %10.3f %10.3f %10.3f  %016llx%s\n",
+                scene.name.c_str(),
+                frames,
+                result.mean,
+                result.min,
+                result.max,
+                static_cast<unsigned long long>(result.checksum),
+                status);
+
+    if (record) {
+      char checksum[17] {};
+      std::snprintf(checksum,
+                    sizeof checksum,
+                    "%016llx",
+                    static_cast<unsigned long long>(result.checksum));
+      record << scene.name << ' ' << checksum << '\n';
+    }
+  }
+
+  return (failures == 0) ? 0 : 1;
+}
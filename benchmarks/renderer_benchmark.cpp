@@ -0,0 +1,154 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include <vector>  // vector
+
+#include "centurion/video/color.hpp"
+#include "centurion/video/software_canvas.hpp"
+#include "centurion/video/sprite_batch.hpp"
+#include "centurion/video/texture.hpp"
+
+namespace {
+
+[[nodiscard]] auto make_rects(const benchmark::State& state) -> std::vector<cen::irect>
+{
+  std::vector<cen::irect> rects;
+
+  for (int index = 0; index < state.range(0); ++index) {
+    rects.emplace_back((index * 7) % 760, (index * 13) % 560, 32, 32);
+  }
+
+  return rects;
+}
+
+}  // namespace
+
+static void BM_RendererClear(benchmark::State& state)
+{
+  cen::software_canvas canvas;
+  auto& renderer = canvas.get_renderer();
+
+  for (auto _ : state) {
+    renderer.clear_with(cen::colors::black);
+  }
+}
+BENCHMARK(BM_RendererClear);
+
+static void BM_RendererFillRect(benchmark::State& state)
+{
+  cen::software_canvas canvas;
+  auto& renderer = canvas.get_renderer();
+  const auto rects = make_rects(state);
+
+  renderer.set_color(cen::colors::orange);
+
+  for (auto _ : state) {
+    for (const auto& rect : rects) {
+      renderer.fill_rect(rect);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RendererFillRect)->Arg(64)->Arg(1'024);
+
+static void BM_RendererFillRects(benchmark::State& state)
+{
+  cen::software_canvas canvas;
+  auto& renderer = canvas.get_renderer();
+  const auto rects = make_rects(state);
+
+  renderer.set_color(cen::colors::orange);
+
+  for (auto _ : state) {
+    renderer.fill_rects(rects);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RendererFillRects)->Arg(64)->Arg(1'024);
+
+static void BM_RendererDrawLine(benchmark::State& state)
+{
+  cen::software_canvas canvas;
+  auto& renderer = canvas.get_renderer();
+  renderer.set_color(cen::colors::cyan);
+
+  for (auto _ : state) {
+    for (int index = 0; index < 100; ++index) {
+      const cen::ipoint start {0, index * 6};
+      renderer.draw_line(start, cen::ipoint {799, 599 - start.y()});
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * 100);
+}
+BENCHMARK(BM_RendererDrawLine);
+
+static void BM_RendererRenderTexture(benchmark::State& state)
+{
+  cen::software_canvas canvas;
+  auto& renderer = canvas.get_renderer();
+  const auto texture = renderer.make_texture(RESOURCE_DIR "panda.png");
+  const auto rects = make_rects(state);
+
+  for (auto _ : state) {
+    for (const auto& rect : rects) {
+      renderer.render(texture, rect);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_RendererRenderTexture)->Arg(64)->Arg(1'024);
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+static void BM_SpriteBatchFlush(benchmark::State& state)
+{
+  cen::software_canvas canvas;
+  auto& renderer = canvas.get_renderer();
+  const auto texture = renderer.make_texture(RESOURCE_DIR "panda.png");
+  const auto rects = make_rects(state);
+
+  cen::sprite_batch batch;
+  batch.reserve(rects.size());
+
+  for (auto _ : state) {
+    for (const auto& rect : rects) {
+      batch.add(texture, rect.as_f());
+    }
+
+    batch.flush(renderer);
+    batch.clear();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpriteBatchFlush)->Arg(64)->Arg(1'024);
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
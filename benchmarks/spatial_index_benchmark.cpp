@@ -0,0 +1,162 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <random>       // mt19937, uniform_real_distribution
+#include <type_traits>  // is_same_v
+#include <vector>       // vector
+
+#include "centurion/common/quadtree.hpp"
+#include "centurion/common/spatial_hash.hpp"
+
+namespace {
+
+inline constexpr int query_count = 1'000;
+
+[[nodiscard]] auto random_rects(const cen::usize count, const float world, const float maxSize)
+    -> std::vector<cen::frect>
+{
+  std::mt19937 engine {42};
+  std::uniform_real_distribution<float> position {-50.0f, world};
+  std::uniform_real_distribution<float> size {0.0f, maxSize};
+
+  std::vector<cen::frect> rects;
+  rects.reserve(count);
+
+  for (cen::usize index = 0; index < count; ++index) {
+    rects.emplace_back(position(engine), position(engine), size(engine), size(engine));
+  }
+
+  return rects;
+}
+
+/* The world grows with the amount of entries, so that the density stays the same */
+struct scene final {
+  explicit scene(const benchmark::State& state)
+      : count {static_cast<cen::usize>(state.range(0))}
+      , world {40.0f * static_cast<float>(count / 1'000)}
+      , rects {random_rects(count, world, 32.0f)}
+      , regions {random_rects(static_cast<cen::usize>(query_count), world, 512.0f)}
+  {
+    ids.reserve(count);
+    for (cen::usize index = 0; index < count; ++index) {
+      ids.push_back(static_cast<cen::uint32>(index));
+    }
+  }
+
+  cen::usize count {};
+  float world {};
+  std::vector<cen::frect> rects;
+  std::vector<cen::frect> regions;
+  std::vector<cen::uint32> ids;
+};
+
+template <typename Index>
+[[nodiscard]] auto make_index(const scene& s) -> Index
+{
+  if constexpr (std::is_same_v<Index, cen::fquadtree>) {
+    return Index {{0, 0, s.world, s.world}, 10};
+  }
+  else {
+    return Index {64.0f};
+  }
+}
+
+}  // namespace
+
+template <typename Index>
+static void BM_SpatialIndexInsert(benchmark::State& state)
+{
+  const scene s {state};
+
+  for (auto _ : state) {
+    auto index = make_index<Index>(s);
+    index.insert(s.ids.data(), s.rects.data(), s.count);
+    benchmark::DoNotOptimize(index);
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SpatialIndexInsert, cen::fquadtree)
+    ->Arg(10'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_SpatialIndexInsert, cen::fspatial_hash)
+    ->Arg(10'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000);
+
+template <typename Index>
+static void BM_SpatialIndexQuery(benchmark::State& state)
+{
+  const scene s {state};
+
+  auto index = make_index<Index>(s);
+  index.insert(s.ids.data(), s.rects.data(), s.count);
+
+  for (auto _ : state) {
+    cen::usize matches {};
+    for (const auto& region : s.regions) {
+      matches += index.query(region, [](cen::uint32) {});
+    }
+
+    benchmark::DoNotOptimize(matches);
+  }
+
+  state.SetItemsProcessed(state.iterations() * query_count);
+}
+BENCHMARK_TEMPLATE(BM_SpatialIndexQuery, cen::fquadtree)
+    ->Arg(10'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_SpatialIndexQuery, cen::fspatial_hash)
+    ->Arg(10'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000);
+
+template <typename Index>
+static void BM_SpatialIndexRemove(benchmark::State& state)
+{
+  const scene s {state};
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto index = make_index<Index>(s);
+    index.insert(s.ids.data(), s.rects.data(), s.count);
+    state.ResumeTiming();
+
+    benchmark::DoNotOptimize(index.remove(s.ids.data(), s.count));
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK_TEMPLATE(BM_SpatialIndexRemove, cen::fquadtree)
+    ->Arg(10'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000);
+BENCHMARK_TEMPLATE(BM_SpatialIndexRemove, cen::fspatial_hash)
+    ->Arg(10'000)
+    ->Arg(100'000)
+    ->Arg(1'000'000);
@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <benchmark/benchmark.h>
+
+#include "centurion/video/pixels.hpp"
+#include "centurion/video/surface.hpp"
+
+static void BM_SurfaceConvertTo(benchmark::State& state)
+{
+  const auto target = static_cast<cen::pixel_format>(state.range(0));
+  const cen::surface source {{512, 512}, cen::pixel_format::rgba8888};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(source.convert_to(target));
+  }
+
+  state.SetItemsProcessed(state.iterations() * 512 * 512);
+}
+BENCHMARK(BM_SurfaceConvertTo)
+    ->Arg(SDL_PIXELFORMAT_RGBA8888)
+    ->Arg(SDL_PIXELFORMAT_ARGB8888)
+    ->Arg(SDL_PIXELFORMAT_RGB888)
+    ->Arg(SDL_PIXELFORMAT_RGB565);
+
+static void BM_SurfaceLoadAndConvert(benchmark::State& state)
+{
+  for (auto _ : state) {
+    const cen::surface image {RESOURCE_DIR "panda.png"};
+    benchmark::DoNotOptimize(image.convert_to(cen::pixel_format::argb8888));
+  }
+}
+BENCHMARK(BM_SurfaceLoadAndConvert);
@@ -9,6 +9,31 @@ function(cen_add_header_only_lib name includeDirectory sources)
   target_include_directories(${name} SYSTEM INTERFACE ${includeDirectory})
 endfunction()
 
+# Creates an interface library target that provides a precompiled header to its consumers.
+#   name: the name of the library target.
+#   includeDirectory: the path of the directory that contains the headers of the library.
+#   sources: the headers associated with the library.
+#   headers: the headers that will be precompiled for each consuming target.
+function(cen_add_precompiled_header_lib name includeDirectory sources headers)
+  cen_add_header_only_lib(${name} ${includeDirectory} "${sources}")
+  target_precompile_headers(${name} INTERFACE ${headers})
+endfunction()
+
+# Creates a static library target for a C++20 module, requires CMake 3.28.
+#   name: the name of the library target.
+#   baseDirectory: the base directory of the module interface units.
+#   modules: the module interface units (the primary interface and its partitions).
+function(cen_add_module_lib name baseDirectory modules)
+  add_library(${name} STATIC)
+  target_sources(${name}
+                 PUBLIC
+                 FILE_SET CXX_MODULES
+                 BASE_DIRS ${baseDirectory}
+                 FILES ${modules})
+  target_include_directories(${name} PRIVATE ${baseDirectory})
+  target_compile_features(${name} PUBLIC cxx_std_20)
+endfunction()
+
 # Copies a directory.
 #   target: the associated target.
 #   from: the directory that will be copied.
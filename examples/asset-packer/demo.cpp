@@ -0,0 +1,77 @@
+#include <centurion.hpp>
+
+#include <filesystem>  // path, is_directory, recursive_directory_iterator
+#include <string>      // string
+
+namespace fs = std::filesystem;
+
+namespace {
+
+auto add_path(cen::asset_pack_builder& builder,
+              const fs::path& path,
+              const fs::path& root,
+              const cen::asset_compression compression) -> bool
+{
+  // Entry names always use forward slashes, regardless of the platform
+  const auto name = path.lexically_relative(root).generic_string();
+
+  if (!builder.add_file(name, path.string().c_str(), compression)) {
+    cen::log_error("Failed to add '%s'", path.string().c_str());
+    return false;
+  }
+
+  cen::log_info("Added '%s'", name.c_str());
+  return true;
+}
+
+}  // namespace
+
+// Usage: ex-asset-packer [--lz4] <output> <file or directory>...
+int main(int argc, char** argv)
+{
+  // Compressed entries are only stored compressed if that makes them smaller
+  const bool compress = argc > 1 && std::string {argv[1]} == "--lz4";
+  const auto compression =
+      compress ? cen::asset_compression::lz4 : cen::asset_compression::none;
+
+  const int first = compress ? 2 : 1;
+  if (argc < first + 2) {
+    cen::log_error("Usage: %s [--lz4] <output> <file or directory>...", argv[0]);
+    return 1;
+  }
+
+  const char* output = argv[first];
+  cen::asset_pack_builder builder;
+
+  for (int index = first + 1; index < argc; ++index) {
+    const fs::path input {argv[index]};
+
+    if (fs::is_directory(input)) {
+      // Files in directories are named relative to the directory itself
+      for (const auto& entry : fs::recursive_directory_iterator {input}) {
+        if (entry.is_regular_file() &&
+            !add_path(builder, entry.path(), input, compression)) {
+          return 1;
+        }
+      }
+    }
+    else if (!add_path(builder, input, input.parent_path(), compression)) {
+      return 1;
+    }
+  }
+
+  if (!builder.write(output)) {
+    cen::log_error("Failed to write asset pack '%s'", output);
+    return 1;
+  }
+
+  // Verify that the pack can be read back
+  const cen::asset_pack pack {output};
+  if (!pack) {
+    cen::log_error("Failed to read back asset pack '%s'", output);
+    return 1;
+  }
+
+  cen::log_info("Wrote %u entries to '%s'", static_cast<unsigned>(pack.size()), output);
+  return 0;
+}
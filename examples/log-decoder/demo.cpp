@@ -0,0 +1,34 @@
+#include <centurion.hpp>
+
+#include <fstream>   // ifstream
+#include <iostream>  // cout
+#include <iterator>  // istreambuf_iterator
+#include <vector>    // vector
+
+// Usage: ex-log-decoder <binary log>
+//
+// Expands a log written by cen::binary_log_writer into text on the standard output.
+int main(int argc, char** argv)
+{
+  if (argc != 2) {
+    cen::log_error("Usage: %s <binary log>", argv[0]);
+    return 1;
+  }
+
+  std::ifstream file {argv[1], std::ios::binary};
+  if (!file) {
+    cen::log_error("Failed to open '%s'", argv[1]);
+    return 1;
+  }
+
+  const std::vector<char> bytes {std::istreambuf_iterator<char> {file},
+                                 std::istreambuf_iterator<char> {}};
+
+  const auto* data = reinterpret_cast<const cen::uint8*>(bytes.data());
+  if (!cen::decode_binary_log(data, bytes.size(), std::cout)) {
+    cen::log_error("'%s' is not a valid binary log", argv[1]);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,84 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+module;
+
+#include "centurion/audio.hpp"
+
+export module centurion:audio;
+
+#ifndef CENTURION_NO_SDL_MIXER
+
+export namespace cen {
+
+using cen::max_effect_channels;
+using cen::gain_effect;
+using cen::low_pass_effect;
+using cen::compressor_effect;
+using cen::reverb_effect;
+using cen::effect_chain;
+
+using cen::fade_status;
+using cen::to_string;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::operator<<;
+
+#endif  // CENTURION_NO_IOSTREAM
+
+using cen::mixer_timing;
+using cen::mixer_stats;
+using cen::enable_mixer_profiling;
+using cen::disable_mixer_profiling;
+using cen::is_profiling_mixer;
+using cen::mixer_statistics;
+using cen::reset_mixer_statistics;
+
+using cen::music;
+
+using cen::music_player_mode;
+using cen::music_player;
+
+using cen::music_type;
+
+using cen::audio_emitter;
+using cen::audio_listener;
+using cen::positional_audio;
+
+using cen::sound_cache;
+
+using cen::basic_sound_effect;
+using cen::sound_effect;
+using cen::sound_effect_handle;
+using cen::get_sound;
+
+using cen::voice_manager;
+
+using cen::audio_spectrum;
+using cen::spectrum_analyzer;
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_MIXER
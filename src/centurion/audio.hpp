@@ -22,7 +22,14 @@
  * SOFTWARE.
  */
 
+#include "audio/audio_effects.hpp"
 #include "audio/fade_status.hpp"
+#include "audio/mixer_profiling.hpp"
 #include "audio/music.hpp"
+#include "audio/music_player.hpp"
 #include "audio/music_type.hpp"
+#include "audio/positional_audio.hpp"
+#include "audio/sound_cache.hpp"
 #include "audio/sound_effect.hpp"
+#include "audio/spectrum_analyzer.hpp"
+#include "audio/voice_manager.hpp"
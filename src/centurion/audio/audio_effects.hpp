@@ -0,0 +1,544 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_AUDIO_AUDIO_EFFECTS_HPP_
+#define CENTURION_AUDIO_AUDIO_EFFECTS_HPP_
+
+#ifndef CENTURION_NO_SDL_MIXER
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+
+#include <array>        // array
+#include <atomic>       // atomic
+#include <cassert>      // assert
+#include <cmath>        // exp, pow, log10, fabs
+#include <cstddef>      // size_t
+#include <tuple>        // tuple, get, apply
+#include <type_traits>  // is_default_constructible_v
+#include <vector>       // vector
+
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../detail/audio_kernels.hpp"
+#include "../detail/stdlib.hpp"
+#include "../initialization.hpp"
+#include "../system/profiler.hpp"
+#include "../system/timer.hpp"
+#include "mixer_profiling.hpp"
+
+namespace cen {
+
+/// The maximum amount of output channels supported by the audio effects.
+inline constexpr int max_effect_channels = 8;
+
+/* Every effect stage is default constructible, and provides the following functions:
+     void prepare(const mix_spec& spec);                    // Called once, may allocate
+     void process(float* samples, usize frames) noexcept;   // Interleaved samples, in [-1, 1]
+   Parameters are atomics that are read once per buffer, so they can be changed at any time
+   from other threads, without the mixer thread ever blocking. */
+
+/// Scales samples by a gain factor, with a linear ramp whenever the gain changes.
+class gain_effect final {
+ public:
+  void prepare(const mix_spec& spec) noexcept { mChannels = spec.channels; }
+
+  void process(float* samples, const usize frames) noexcept
+  {
+    const auto target = mGain.load(std::memory_order_relaxed);
+    const auto channels = static_cast<usize>(mChannels);
+
+    if (target == mCurrent) {
+      detail::gain_n(samples, frames * channels, target);
+    }
+    else {
+      const auto step = (target - mCurrent) / static_cast<float>(frames);
+
+      for (usize frame = 0; frame < frames; ++frame) {
+        mCurrent += step;
+        detail::gain_scalar(samples, frame * channels, (frame + 1) * channels, mCurrent);
+      }
+
+      mCurrent = target;
+    }
+  }
+
+  /// Sets the linear gain factor, where 1 leaves the samples unchanged.
+  void set_gain(const float gain) noexcept { mGain.store(gain, std::memory_order_relaxed); }
+
+  /// Sets the gain in decibels.
+  void set_gain_db(const float db) noexcept { set_gain(std::pow(10.0f, db / 20.0f)); }
+
+  [[nodiscard]] auto gain() const noexcept -> float
+  {
+    return mGain.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<float> mGain {1.0f};
+  float mCurrent {1.0f};
+  int mChannels {};
+};
+
+/// Attenuates frequencies above a cutoff frequency, using a one-pole filter per channel.
+class low_pass_effect final {
+ public:
+  void prepare(const mix_spec& spec) noexcept
+  {
+    assert(spec.channels > 0 && spec.channels <= max_effect_channels);
+    mFrequency = static_cast<float>(spec.frequency);
+    mChannels = spec.channels;
+  }
+
+  void process(float* samples, const usize frames) noexcept
+  {
+    const auto cutoff = mCutoff.load(std::memory_order_relaxed);
+    constexpr float pi = 3.14159265f;
+    const auto alpha = 1.0f - std::exp(-2.0f * pi * cutoff / mFrequency);
+    const auto channels = static_cast<usize>(mChannels);
+
+    for (usize frame = 0; frame < frames; ++frame) {
+      auto* current = samples + (frame * channels);
+      for (usize channel = 0; channel < channels; ++channel) {
+        mState[channel] += alpha * (current[channel] - mState[channel]);
+        current[channel] = mState[channel];
+      }
+    }
+  }
+
+  /// Sets the cutoff frequency, in Hz.
+  void set_cutoff(const float hz) noexcept { mCutoff.store(hz, std::memory_order_relaxed); }
+
+  [[nodiscard]] auto cutoff() const noexcept -> float
+  {
+    return mCutoff.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<float> mCutoff {20'000.0f};
+  std::array<float, max_effect_channels> mState {};
+  float mFrequency {44'100.0f};
+  int mChannels {};
+};
+
+/**
+ * Reduces the dynamic range of the signal above a threshold.
+ *
+ * \details The envelope follows the peak of all channels, and the gain reduction is updated
+ *          every 16 frames, which keeps the per-sample cost to a multiplication.
+ */
+class compressor_effect final {
+ public:
+  void prepare(const mix_spec& spec) noexcept
+  {
+    mFrequency = static_cast<float>(spec.frequency);
+    mChannels = spec.channels;
+  }
+
+  void process(float* samples, const usize frames) noexcept
+  {
+    const auto threshold = std::pow(10.0f, mThreshold.load(std::memory_order_relaxed) / 20.0f);
+    const auto slope = 1.0f / mRatio.load(std::memory_order_relaxed) - 1.0f;
+    const auto attack = coefficient(mAttack.load(std::memory_order_relaxed));
+    const auto release = coefficient(mRelease.load(std::memory_order_relaxed));
+    const auto channels = static_cast<usize>(mChannels);
+
+    for (usize first = 0; first < frames; first += block_size) {
+      const auto last = (detail::min)(first + block_size, frames);
+
+      for (auto frame = first; frame < last; ++frame) {
+        float peak = 0;
+        for (usize channel = 0; channel < channels; ++channel) {
+          peak = (detail::max)(peak, std::fabs(samples[(frame * channels) + channel]));
+        }
+
+        const auto factor = (peak > mEnvelope) ? attack : release;
+        mEnvelope = peak + factor * (mEnvelope - peak);
+      }
+
+      const auto gain =
+          (mEnvelope > threshold) ? std::pow(mEnvelope / threshold, slope) : 1.0f;
+      detail::gain_n(samples + (first * channels), (last - first) * channels, gain);
+    }
+  }
+
+  /// Sets the level above which the signal is compressed, in decibels relative to full scale.
+  void set_threshold(const float db) noexcept
+  {
+    mThreshold.store(db, std::memory_order_relaxed);
+  }
+
+  /// Sets the compression ratio, e.g. 4 for 4:1, must be at least 1.
+  void set_ratio(const float ratio) noexcept
+  {
+    assert(ratio >= 1.0f);
+    mRatio.store(ratio, std::memory_order_relaxed);
+  }
+
+  /// Sets the time it takes for the envelope to respond to increasing levels.
+  void set_attack(const millis<float> attack) noexcept
+  {
+    mAttack.store(attack.count(), std::memory_order_relaxed);
+  }
+
+  /// Sets the time it takes for the envelope to respond to decreasing levels.
+  void set_release(const millis<float> release) noexcept
+  {
+    mRelease.store(release.count(), std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto threshold() const noexcept -> float
+  {
+    return mThreshold.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto ratio() const noexcept -> float
+  {
+    return mRatio.load(std::memory_order_relaxed);
+  }
+
+ private:
+  inline constexpr static usize block_size = 16;
+
+  std::atomic<float> mThreshold {-12.0f};
+  std::atomic<float> mRatio {4.0f};
+  std::atomic<float> mAttack {5.0f};
+  std::atomic<float> mRelease {100.0f};
+  float mEnvelope {};
+  float mFrequency {44'100.0f};
+  int mChannels {};
+
+  [[nodiscard]] auto coefficient(const float ms) const noexcept -> float
+  {
+    return (ms > 0) ? std::exp(-1'000.0f / (ms * mFrequency)) : 0.0f;
+  }
+};
+
+/**
+ * A simple Schroeder reverb, with four parallel comb filters and two serial all-pass filters.
+ *
+ * \details The reverb is computed from the mix of all channels, and added to every channel.
+ *          The delay lines are allocated by `prepare()`, never while processing.
+ */
+class reverb_effect final {
+ public:
+  void prepare(const mix_spec& spec)
+  {
+    mChannels = spec.channels;
+
+    /* The classic delay lengths are tuned for 44.1 kHz */
+    const auto scale = static_cast<double>(spec.frequency) / 44'100.0;
+    const auto length = [scale](const int samples) {
+      return (detail::max)(usize {1}, static_cast<usize>(samples * scale));
+    };
+
+    constexpr std::array combLengths {1'116, 1'188, 1'277, 1'356};
+    constexpr std::array allPassLengths {556, 441};
+
+    for (usize index = 0; index < mCombs.size(); ++index) {
+      mCombs[index].buffer.assign(length(combLengths[index]), 0.0f);
+    }
+
+    for (usize index = 0; index < mAllPasses.size(); ++index) {
+      mAllPasses[index].buffer.assign(length(allPassLengths[index]), 0.0f);
+    }
+  }
+
+  void process(float* samples, const usize frames) noexcept
+  {
+    const auto feedback = 0.7f + 0.28f * mRoomSize.load(std::memory_order_relaxed);
+    const auto damping = 0.4f * mDamping.load(std::memory_order_relaxed);
+    const auto wet = mWet.load(std::memory_order_relaxed);
+    const auto channels = static_cast<usize>(mChannels);
+
+    for (usize frame = 0; frame < frames; ++frame) {
+      auto* current = samples + (frame * channels);
+
+      float input = 0;
+      for (usize channel = 0; channel < channels; ++channel) {
+        input += current[channel];
+      }
+      input *= input_gain / static_cast<float>(channels);
+
+      float output = 0;
+      for (auto& comb : mCombs) {
+        auto& delayed = comb.buffer[comb.index];
+        comb.filtered = delayed + damping * (comb.filtered - delayed);
+        output += delayed;
+        delayed = input + comb.filtered * feedback;
+        comb.index = (comb.index + 1 == comb.buffer.size()) ? 0 : comb.index + 1;
+      }
+
+      for (auto& allPass : mAllPasses) {
+        auto& delayed = allPass.buffer[allPass.index];
+        const auto result = delayed - output;
+        delayed = output + delayed * 0.5f;
+        output = result;
+        allPass.index = (allPass.index + 1 == allPass.buffer.size()) ? 0 : allPass.index + 1;
+      }
+
+      for (usize channel = 0; channel < channels; ++channel) {
+        current[channel] += wet * output;
+      }
+    }
+  }
+
+  /// Sets the size of the simulated room, in the range [0, 1].
+  void set_room_size(const float size) noexcept
+  {
+    mRoomSize.store(detail::clamp(size, 0.0f, 1.0f), std::memory_order_relaxed);
+  }
+
+  /// Sets how quickly high frequencies decay, in the range [0, 1].
+  void set_damping(const float damping) noexcept
+  {
+    mDamping.store(detail::clamp(damping, 0.0f, 1.0f), std::memory_order_relaxed);
+  }
+
+  /// Sets the level of the reverberated signal added to the dry signal.
+  void set_wet(const float wet) noexcept { mWet.store(wet, std::memory_order_relaxed); }
+
+  [[nodiscard]] auto room_size() const noexcept -> float
+  {
+    return mRoomSize.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto damping() const noexcept -> float
+  {
+    return mDamping.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto wet() const noexcept -> float
+  {
+    return mWet.load(std::memory_order_relaxed);
+  }
+
+ private:
+  inline constexpr static float input_gain = 0.015f;
+
+  struct delay_line final {
+    std::vector<float> buffer;
+    usize index {};
+    float filtered {};  ///< The low-pass state of comb filters.
+  };
+
+  std::array<delay_line, 4> mCombs;
+  std::array<delay_line, 2> mAllPasses;
+  std::atomic<float> mRoomSize {0.5f};
+  std::atomic<float> mDamping {0.5f};
+  std::atomic<float> mWet {0.3f};
+  int mChannels {};
+};
+
+/**
+ * A chain of effect stages that are applied to a mixer channel, or to the final mix.
+ *
+ * The stages are run in order on float samples, directly in the mixer callback. Nothing is
+ * allocated or locked while processing, and devices with 16-bit samples are handled with a
+ * conversion buffer that is allocated up front. Other sample formats are left untouched.
+ * \code{cpp}
+ * const cen::mix mix {cfg};
+ *
+ * cen::effect_chain<cen::low_pass_effect, cen::gain_effect> muffled {*mix.spec()};
+ * muffled.stage<cen::low_pass_effect>().set_cutoff(800);
+ * muffled.attach(channel);
+ * \endcode
+ *
+ * \details A chain must only be attached to a channel once, and a channel must not have
+ *          several chains of the same type attached, since SDL_mixer identifies effects by
+ *          their callbacks when they are removed. Chains detach themselves when destroyed.
+ *
+ * \tparam Stages the effect stages, see `gain_effect` for the requirements.
+ */
+template <typename... Stages>
+class effect_chain final {
+  static_assert((std::is_default_constructible_v<Stages> && ...));
+
+ public:
+  using channel_index = int;
+  using size_type = usize;
+
+  /// The channel index used to attach a chain to the final mix of all channels.
+  inline constexpr static channel_index post_mix = MIX_CHANNEL_POST;
+
+  /**
+   * Creates an effect chain.
+   *
+   * \param spec the format of the opened audio device, see `query_mix_spec()`.
+   * \param maxFrames the amount of frames converted at a time for 16-bit devices.
+   */
+  explicit effect_chain(const mix_spec& spec, const size_type maxFrames = 4'096)
+      : mFormat {spec.format}
+      , mChannels {spec.channels}
+  {
+    assert(spec.channels > 0 && spec.channels <= max_effect_channels);
+    assert(maxFrames > 0);
+
+    if (mFormat == AUDIO_S16SYS) {
+      mScratch.resize(maxFrames * static_cast<size_type>(spec.channels));
+    }
+
+    std::apply([&spec](auto&... stage) { (stage.prepare(spec), ...); }, mStages);
+  }
+
+  CENTURION_DISABLE_COPY(effect_chain)
+  CENTURION_DISABLE_MOVE(effect_chain)
+
+  ~effect_chain() noexcept
+  {
+    for (const auto channel : mAttached) {
+      Mix_UnregisterEffect(channel, &on_effect);
+    }
+  }
+
+  /**
+   * Starts applying the chain to a channel.
+   *
+   * \param channel the mixer channel, or `post_mix` for the final mix.
+   *
+   * \return `success` if the chain was attached; `failure` otherwise.
+   */
+  auto attach(const channel_index channel) -> result
+  {
+    mAttached.reserve(mAttached.size() + 1);
+
+    if (Mix_RegisterEffect(channel, &on_effect, nullptr, this) == 0) {
+      return failure;
+    }
+
+    mAttached.push_back(channel);
+    return success;
+  }
+
+  /// Stops applying the chain to a channel.
+  auto detach(const channel_index channel) noexcept -> result
+  {
+    for (auto iter = mAttached.begin(); iter != mAttached.end(); ++iter) {
+      if (*iter == channel) {
+        mAttached.erase(iter);
+        return Mix_UnregisterEffect(channel, &on_effect) != 0;
+      }
+    }
+
+    return failure;
+  }
+
+  /**
+   * Runs all stages on a buffer of float samples.
+   *
+   * \details This is called by the mixer callback, but may also be used directly, e.g. to
+   *          process sounds offline.
+   *
+   * \param samples the interleaved samples, with the channel count of the device.
+   * \param frames the amount of sample frames.
+   */
+  void process(float* samples, const size_type frames) noexcept
+  {
+    if (mEnabled.load(std::memory_order_relaxed)) {
+      std::apply([samples, frames](auto&... stage) { (stage.process(samples, frames), ...); },
+                 mStages);
+    }
+  }
+
+  /// Enables or disables the chain, a disabled chain passes samples through unchanged.
+  void set_enabled(const bool enabled) noexcept
+  {
+    mEnabled.store(enabled, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto is_enabled() const noexcept -> bool
+  {
+    return mEnabled.load(std::memory_order_relaxed);
+  }
+
+  /// Returns a stage by index, for changing its parameters.
+  template <std::size_t Index>
+  [[nodiscard]] auto stage() noexcept -> auto&
+  {
+    return std::get<Index>(mStages);
+  }
+
+  /// Returns a stage by type, which must only occur once in the chain.
+  template <typename Stage>
+  [[nodiscard]] auto stage() noexcept -> Stage&
+  {
+    return std::get<Stage>(mStages);
+  }
+
+ private:
+  std::tuple<Stages...> mStages;
+  std::vector<float> mScratch;
+  std::vector<channel_index> mAttached;
+  std::atomic<bool> mEnabled {true};
+  uint16 mFormat {};
+  int mChannels {};
+
+  static void SDLCALL on_effect(int, void* stream, const int length, void* data) noexcept
+  {
+    static_cast<effect_chain*>(data)->process_stream(stream, length);
+  }
+
+  void process_stream(void* stream, const int length) noexcept
+  {
+    CENTURION_PROFILE_SCOPE("effect_chain::process");
+
+    if (detail::is_mixer_profiled()) {
+      const auto start = now();
+      convert_and_process(stream, length);
+      detail::get_mixer_profiler().effects.record(now() - start);
+    }
+    else {
+      convert_and_process(stream, length);
+    }
+  }
+
+  void convert_and_process(void* stream, const int length) noexcept
+  {
+    const auto channels = static_cast<size_type>(mChannels);
+
+    if (mFormat == AUDIO_F32SYS) {
+      const auto count = static_cast<size_type>(length) / sizeof(float);
+      process(static_cast<float*>(stream), count / channels);
+    }
+    else if (mFormat == AUDIO_S16SYS) {
+      auto* samples = static_cast<int16*>(stream);
+      const auto count = static_cast<size_type>(length) / sizeof(int16);
+
+      for (size_type offset = 0; offset < count; offset += mScratch.size()) {
+        const auto n = (detail::min)(mScratch.size(), count - offset);
+
+        detail::s16_to_f32_n(samples + offset, mScratch.data(), n);
+        process(mScratch.data(), n / channels);
+        detail::f32_to_s16_n(mScratch.data(), samples + offset, n);
+      }
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_MIXER
+#endif  // CENTURION_AUDIO_AUDIO_EFFECTS_HPP_
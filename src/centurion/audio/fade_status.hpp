@@ -29,11 +29,16 @@
 
 #include <SDL_mixer.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class fade_status {
@@ -59,11 +64,15 @@ enum class fade_status {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const fade_status status) -> std::ostream&
 {
   return stream << to_string(status);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_NO_SDL_MIXER
@@ -0,0 +1,341 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_AUDIO_MIXER_PROFILING_HPP_
+#define CENTURION_AUDIO_MIXER_PROFILING_HPP_
+
+#ifndef CENTURION_NO_SDL_MIXER
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+
+#include <atomic>  // atomic, memory_order_relaxed
+
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/timer.hpp"
+
+namespace cen {
+
+/// Timing statistics about a repeated mixer operation, measured in counter ticks.
+struct mixer_timing final {
+  uint64 count {};      ///< The amount of recorded operations.
+  uint64 ticks {};      ///< The total high-performance counter ticks of all operations.
+  uint64 max_ticks {};  ///< The largest amount of counter ticks of a single operation.
+
+  /// Returns the total duration of all operations.
+  [[nodiscard]] auto total_time() const noexcept -> seconds<double>
+  {
+    return seconds<double> {static_cast<double>(ticks) / static_cast<double>(frequency())};
+  }
+
+  /// Returns the longest duration of a single operation.
+  [[nodiscard]] auto max_time() const noexcept -> seconds<double>
+  {
+    return seconds<double> {static_cast<double>(max_ticks) / static_cast<double>(frequency())};
+  }
+
+  /// Returns the mean duration of each operation.
+  [[nodiscard]] auto mean_time() const noexcept -> seconds<double>
+  {
+    if (count != 0) {
+      return total_time() / static_cast<double>(count);
+    }
+    else {
+      return seconds<double> {0};
+    }
+  }
+};
+
+/// A snapshot of the mixer performance counters.
+struct mixer_stats final {
+  mixer_timing buffers;              ///< The intervals between consecutively mixed buffers.
+  mixer_timing effects;              ///< The time spent processing effect chains.
+  mixer_timing music_loads;          ///< The time spent opening music.
+  mixer_timing sound_loads;          ///< The time spent decoding sound effects.
+  uint64 underruns {};               ///< The amount of buffers that were mixed too late.
+  uint64 channel_samples {};         ///< The sum of the active channel counts of all buffers.
+  int active_channels {};            ///< The amount of channels playing in the latest buffer.
+  int peak_channels {};              ///< The largest amount of channels playing in a buffer.
+  seconds<double> buffer_period {};  ///< The playback duration of the latest buffer.
+
+  /// Returns the mean amount of channels playing in each buffer.
+  [[nodiscard]] auto mean_channels() const noexcept -> double
+  {
+    if (buffers.count != 0) {
+      return static_cast<double>(channel_samples) / static_cast<double>(buffers.count);
+    }
+    else {
+      return 0;
+    }
+  }
+
+  /// Returns the ratio of buffers that were mixed too late, in the range [0, 1].
+  [[nodiscard]] auto underrun_ratio() const noexcept -> double
+  {
+    if (buffers.count != 0) {
+      return static_cast<double>(underruns) / static_cast<double>(buffers.count);
+    }
+    else {
+      return 0;
+    }
+  }
+};
+
+namespace detail {
+
+/* A buffer counts as an underrun if it's mixed this much later than its period */
+inline constexpr double mixer_underrun_factor = 1.5;
+
+struct atomic_timing final {
+  std::atomic<uint64> count {};
+  std::atomic<uint64> ticks {};
+  std::atomic<uint64> max_ticks {};
+
+  void record(const uint64 elapsed) noexcept
+  {
+    count.fetch_add(1, std::memory_order_relaxed);
+    ticks.fetch_add(elapsed, std::memory_order_relaxed);
+
+    auto peak = max_ticks.load(std::memory_order_relaxed);
+    while (elapsed > peak &&
+           !max_ticks.compare_exchange_weak(peak, elapsed, std::memory_order_relaxed)) {
+    }
+  }
+
+  void reset() noexcept
+  {
+    count.store(0, std::memory_order_relaxed);
+    ticks.store(0, std::memory_order_relaxed);
+    max_ticks.store(0, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto snapshot() const noexcept -> mixer_timing
+  {
+    mixer_timing timing;
+    timing.count = count.load(std::memory_order_relaxed);
+    timing.ticks = ticks.load(std::memory_order_relaxed);
+    timing.max_ticks = max_ticks.load(std::memory_order_relaxed);
+    return timing;
+  }
+};
+
+struct mixer_profiler final {
+  atomic_timing buffers;
+  atomic_timing effects;
+  atomic_timing music_loads;
+  atomic_timing sound_loads;
+  std::atomic<uint64> underruns {};
+  std::atomic<uint64> channel_samples {};
+  std::atomic<int> active_channels {};
+  std::atomic<int> peak_channels {};
+  std::atomic<uint64> period_ticks {};
+  std::atomic<bool> enabled {};
+
+  /* Only accessed by the audio thread, or while the post-mix callback is unregistered */
+  uint64 previous {};
+  uint64 frame_size {};
+  int frequency {};
+};
+
+[[nodiscard]] inline auto get_mixer_profiler() noexcept -> mixer_profiler&
+{
+  static mixer_profiler profiler;
+  return profiler;
+}
+
+[[nodiscard]] inline auto is_mixer_profiled() noexcept -> bool
+{
+  return get_mixer_profiler().enabled.load(std::memory_order_relaxed);
+}
+
+inline void SDLCALL profile_post_mix(void*, uint8*, const int length) noexcept
+{
+  auto& profiler = get_mixer_profiler();
+  const auto current = now();
+
+  if (profiler.previous != 0) {
+    const auto elapsed = current - profiler.previous;
+    profiler.buffers.record(elapsed);
+
+    /* Compare the interval with the playback duration of the buffer */
+    const auto frames = static_cast<double>(length) / static_cast<double>(profiler.frame_size);
+    const auto period = frames / profiler.frequency * static_cast<double>(cen::frequency());
+    profiler.period_ticks.store(static_cast<uint64>(period), std::memory_order_relaxed);
+
+    if (static_cast<double>(elapsed) > period * mixer_underrun_factor) {
+      profiler.underruns.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const auto channels = Mix_Playing(-1);
+    profiler.active_channels.store(channels, std::memory_order_relaxed);
+    profiler.channel_samples.fetch_add(static_cast<uint64>(channels),
+                                       std::memory_order_relaxed);
+
+    auto peak = profiler.peak_channels.load(std::memory_order_relaxed);
+    while (channels > peak && !profiler.peak_channels.compare_exchange_weak(
+                                  peak, channels, std::memory_order_relaxed)) {
+    }
+  }
+
+  profiler.previous = current;
+}
+
+/* Times a load operation if the mixer is profiled, the loader returns the loaded resource */
+template <typename Loader>
+[[nodiscard]] auto profiled_load(atomic_timing& timing, Loader&& load) -> decltype(load())
+{
+  if (!is_mixer_profiled()) {
+    return load();
+  }
+
+  const auto start = now();
+  auto* resource = load();
+  timing.record(now() - start);
+
+  return resource;
+}
+
+template <typename Loader>
+[[nodiscard]] auto profiled_music_load(Loader&& load) -> decltype(load())
+{
+  return profiled_load(get_mixer_profiler().music_loads, load);
+}
+
+template <typename Loader>
+[[nodiscard]] auto profiled_sound_load(Loader&& load) -> decltype(load())
+{
+  return profiled_load(get_mixer_profiler().sound_loads, load);
+}
+
+}  // namespace detail
+
+/**
+ * Starts collecting mixer performance counters.
+ *
+ * Once enabled, the intervals between mixed buffers, underruns and the amount of active
+ * channels are recorded by a post-mix callback, which replaces any callback previously
+ * registered with `Mix_SetPostMix()`. The time spent loading music and sound effects, and the
+ * time spent in effect chains, is recorded as well.
+ *
+ * SDL_mixer doesn't report when it starts mixing a buffer, so the cost of the audio callback
+ * as a whole can't be measured. Instead, buffers that are mixed much later than the playback
+ * duration of the previous buffer are counted as underruns, which is a good indicator of an
+ * overloaded audio thread.
+ *
+ * \pre The audio device must be open.
+ *
+ * \return `success` if profiling was enabled; `failure` if the audio device isn't open.
+ *
+ * \see mixer_statistics()
+ */
+inline auto enable_mixer_profiling() noexcept -> result
+{
+  int frequency {};
+  Uint16 format {};
+  int channels {};
+  if (!Mix_QuerySpec(&frequency, &format, &channels)) {
+    return failure;
+  }
+
+  /* Registering the post-mix callback locks the audio device, so the state below is never
+     accessed by the audio thread at the same time */
+  Mix_SetPostMix(nullptr, nullptr);
+
+  auto& profiler = detail::get_mixer_profiler();
+  profiler.previous = 0;
+  profiler.frequency = frequency;
+  profiler.frame_size = static_cast<uint64>(channels) * (SDL_AUDIO_BITSIZE(format) / 8u);
+  profiler.enabled.store(true);
+
+  Mix_SetPostMix(detail::profile_post_mix, nullptr);
+  return success;
+}
+
+/// Stops collecting mixer performance counters, the collected statistics are kept.
+inline void disable_mixer_profiling() noexcept
+{
+  auto& profiler = detail::get_mixer_profiler();
+  if (profiler.enabled.exchange(false)) {
+    Mix_SetPostMix(nullptr, nullptr);
+  }
+}
+
+/// Indicates whether mixer performance counters are collected.
+[[nodiscard]] inline auto is_profiling_mixer() noexcept -> bool
+{
+  return detail::is_mixer_profiled();
+}
+
+/**
+ * Returns the collected mixer performance counters.
+ *
+ * The individual values are sampled independently, so they may be slightly out of sync with
+ * each other while the mixer is running.
+ *
+ * \return the current mixer statistics.
+ *
+ * \see enable_mixer_profiling()
+ */
+[[nodiscard]] inline auto mixer_statistics() noexcept -> mixer_stats
+{
+  const auto& profiler = detail::get_mixer_profiler();
+
+  mixer_stats stats;
+  stats.buffers = profiler.buffers.snapshot();
+  stats.effects = profiler.effects.snapshot();
+  stats.music_loads = profiler.music_loads.snapshot();
+  stats.sound_loads = profiler.sound_loads.snapshot();
+  stats.underruns = profiler.underruns.load(std::memory_order_relaxed);
+  stats.channel_samples = profiler.channel_samples.load(std::memory_order_relaxed);
+  stats.active_channels = profiler.active_channels.load(std::memory_order_relaxed);
+  stats.peak_channels = profiler.peak_channels.load(std::memory_order_relaxed);
+
+
+  const auto period = profiler.period_ticks.load(std::memory_order_relaxed);
+  stats.buffer_period =
+      seconds<double> {static_cast<double>(period) / static_cast<double>(frequency())};
+
+  return stats;
+}
+
+/// Resets all collected mixer performance counters.
+inline void reset_mixer_statistics() noexcept
+{
+  auto& profiler = detail::get_mixer_profiler();
+  profiler.buffers.reset();
+  profiler.effects.reset();
+  profiler.music_loads.reset();
+  profiler.sound_loads.reset();
+  profiler.underruns.store(0, std::memory_order_relaxed);
+  profiler.channel_samples.store(0, std::memory_order_relaxed);
+  profiler.active_channels.store(0, std::memory_order_relaxed);
+  profiler.peak_channels.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_MIXER
+#endif  // CENTURION_AUDIO_MIXER_PROFILING_HPP_
@@ -29,9 +29,11 @@
 
 #include <SDL_mixer.h>
 
-#include <ostream>      // ostream
+#include <cassert>      // assert
 #include <string>       // string, to_string
 #include <string_view>  // string_view
+#include <utility>      // move
+#include <vector>       // vector
 
 #include "../common/errors.hpp"
 #include "../common/memory.hpp"
@@ -39,8 +41,11 @@
 #include "../common/result.hpp"
 #include "../detail/stdlib.hpp"
 #include "../features.hpp"
+#include "../io/asset_pack.hpp"
 #include "../io/file.hpp"
+#include "../io/mapped_file.hpp"
 #include "fade_status.hpp"
+#include "mixer_profiling.hpp"
 #include "music_type.hpp"
 
 #if CENTURION_HAS_FEATURE_FORMAT
@@ -49,6 +54,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 /**
@@ -77,7 +88,8 @@ class music final {
 
   inline constexpr static int forever = -1;  ///< Used to loop music indefinitely.
 
-  explicit music(const char* file) : mMusic {Mix_LoadMUS(file)}
+  explicit music(const char* file)
+      : mMusic {detail::profiled_music_load([file] { return Mix_LoadMUS(file); })}
   {
     if (!mMusic) {
       throw mix_error {};
@@ -86,13 +98,102 @@ class music final {
 
   explicit music(const std::string& file) : music {file.c_str()} {}
 
-  explicit music(file& file) : mMusic {Mix_LoadMUS_RW(file.data(), SDL_FALSE)}
+  /// Streams music from a file, which must outlive the music.
+  explicit music(file& file)
+      : mMusic {detail::profiled_music_load(
+            [&file] { return Mix_LoadMUS_RW(file.data(), SDL_FALSE); })}
   {
     if (!mMusic) {
       throw mix_error {};
     }
   }
 
+  /// Streams music from a file, and takes ownership of the file.
+  explicit music(file&& file)
+      : mMusic {detail::profiled_music_load(
+            [&file] { return Mix_LoadMUS_RW(file.release(), SDL_TRUE); })}
+  {
+    if (!mMusic) {
+      throw mix_error {};
+    }
+  }
+
+  /// Streams music from a memory-mapped file, which must outlive the music.
+  explicit music(const mapped_file& mapping) : music {mapping.view()} {}
+
+  /**
+   * Streams music from an asset pack entry.
+   *
+   * \param pack the asset pack that contains the music, must outlive the music.
+   * \param name the name of the pack entry.
+   *
+   * \throws mix_error if there is no such entry, or if the music cannot be decoded.
+   */
+  music(const asset_pack& pack, const std::string_view name) : music {pack.open(name)} {}
+
+  music(music&& other) noexcept = default;
+
+  auto operator=(music&& other) noexcept -> music&
+  {
+    /* The music must be freed before the buffer that it may be decoded from */
+    mMusic = std::move(other.mMusic);
+    mBuffer = std::move(other.mBuffer);
+    return *this;
+  }
+
+  /**
+   * Reads all contents of a file into memory, and decodes the music from there.
+   *
+   * \details Unlike streamed music, preloaded music never reads from the file system during
+   *          playback, so slow reads can't cause audio dropouts. This is mostly useful for
+   *          music on slow or contended storage, at the cost of keeping the encoded music in
+   *          memory.
+   *
+   * \param source the file that contains the music, which is read from its current offset.
+   *
+   * \return the preloaded music.
+   *
+   * \throws exception if the file cannot be read.
+   * \throws mix_error if the music cannot be decoded.
+   */
+  [[nodiscard]] static auto preload(file& source) -> music
+  {
+    if (!source) {
+      throw exception {"Cannot preload music from invalid file!"};
+    }
+
+    std::vector<uint8> buffer;
+    if (const auto size = source.size()) {
+      buffer.reserve(*size);
+    }
+
+    constexpr usize chunk_size = 64 * 1'024;
+    usize count = 0;
+
+    do {
+      buffer.resize(buffer.size() + chunk_size);
+      count = source.read_to(buffer.data() + buffer.size() - chunk_size, chunk_size);
+      buffer.resize(buffer.size() - chunk_size + count);
+    } while (count == chunk_size);
+
+    return music {std::move(buffer)};
+  }
+
+  /// Reads all contents of a music file into memory, see `preload(file&)`.
+  [[nodiscard]] static auto preload(const char* path) -> music
+  {
+    assert(path);
+
+    file source {path, file_mode::rb};
+    return preload(source);
+  }
+
+  /// Reads all contents of a music file into memory, see `preload(file&)`.
+  [[nodiscard]] static auto preload(const std::string& path) -> music
+  {
+    return preload(path.c_str());
+  }
+
   auto play(const int iterations = 0) noexcept -> maybe<channel_index>
   {
     const auto channel = Mix_PlayMusic(mMusic.get(), detail::max(iterations, forever));
@@ -294,9 +395,25 @@ class music final {
 
   [[nodiscard]] auto get() const noexcept -> Mix_Music* { return mMusic.get(); }
 
+  /// Indicates whether the music was preloaded into memory, see `preload()`.
+  [[nodiscard]] auto is_preloaded() const noexcept -> bool { return !mBuffer.empty(); }
+
  private:
+  std::vector<uint8> mBuffer;  ///< The encoded music, if preloaded, outlives the music.
   managed_ptr<Mix_Music> mMusic;
 
+  explicit music(std::vector<uint8> buffer) : mBuffer {std::move(buffer)}
+  {
+    const auto size = static_cast<int>(mBuffer.size());
+    mMusic.reset(detail::profiled_music_load([this, size] {
+      return Mix_LoadMUS_RW(SDL_RWFromConstMem(mBuffer.data(), size), SDL_TRUE);
+    }));
+
+    if (!mMusic) {
+      throw mix_error {};
+    }
+  }
+
 #ifdef CENTURION_MOCK_FRIENDLY_MODE
 
  public:
@@ -317,11 +434,15 @@ class music final {
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const music& music) -> std::ostream&
 {
   return stream << to_string(music);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_NO_SDL_MIXER
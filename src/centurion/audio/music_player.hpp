@@ -0,0 +1,550 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_AUDIO_MUSIC_PLAYER_HPP_
+#define CENTURION_AUDIO_MUSIC_PLAYER_HPP_
+
+#ifndef CENTURION_NO_SDL_MIXER
+
+#include <SDL_mixer.h>
+
+#include <cassert>  // assert
+#include <deque>    // deque
+#include <memory>   // shared_ptr, make_shared
+#include <string>   // string
+#include <utility>  // move
+#include <vector>   // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/spin_lock.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../io/asset_pack.hpp"
+#include "../io/file.hpp"
+#include "../system/profiler.hpp"
+#include "../system/timer.hpp"
+#include "mixer_profiling.hpp"
+#include "music.hpp"
+#include "sound_effect.hpp"
+
+namespace cen {
+
+/// Determines how a music player plays its tracks.
+enum class music_player_mode : uint8 {
+  /// Tracks are preloaded as `music`, and transitions fade out before fading in, since
+  /// SDL_mixer only plays one music stream at a time.
+  stream,
+
+  /// Tracks are fully decoded into chunks, and played on two mixer channels, so that the
+  /// transitions overlap. This uses a lot more memory, roughly 10 MB per minute of audio.
+  decoded,
+};
+
+/**
+ * Plays a playlist, preparing the next track on a worker thread ahead of time.
+ *
+ * The next track is always read and opened in the background, so track changes never wait
+ * for the file system or for a decoder to start. Depending on the mode, the transitions
+ * between tracks either fade out and in, or crossfade.
+ * \code{cpp}
+ * cen::music_player player {pool};
+ * player.add("music/forest.ogg");
+ * player.add("music/cave.ogg");
+ * player.play();
+ *
+ * // Once per frame
+ * player.update();
+ *
+ * // On level transitions
+ * player.skip(cen::music_player::ms_type {1'500});
+ * \endcode
+ *
+ * \details In decoded mode, the player uses two mixer channels, `deck` and `deck + 1`, which
+ *          should be reserved with `Mix_ReserveChannels()` so that sound effects don't take
+ *          them. Asset packs must outlive all tracks that are loaded from them.
+ *
+ * \see music
+ * \see music_player_mode
+ */
+class music_player final {
+ public:
+  using size_type = usize;
+  using ms_type = music::ms_type;
+
+  /**
+   * Creates a music player with an empty playlist.
+   *
+   * \param pool the thread pool used to load tracks, must outlive the player.
+   * \param mode the playback mode.
+   * \param deck the first of the two channels used in decoded mode.
+   */
+  explicit music_player(thread_pool& pool,
+                        const music_player_mode mode = music_player_mode::stream,
+                        const int deck = 0)
+      : mPool {&pool}
+      , mState {std::make_shared<shared_state>()}
+      , mMode {mode}
+      , mDeck {deck}
+  {
+    assert(deck >= 0);
+  }
+
+  CENTURION_DISABLE_COPY(music_player)
+  CENTURION_DISABLE_MOVE(music_player)
+
+  ~music_player() noexcept { halt(); }
+
+  /// Appends a music file to the playlist.
+  void add(std::string path) { mPlaylist.push_back({std::move(path), nullptr}); }
+
+  /// Appends an asset pack entry to the playlist, the pack must outlive the player.
+  void add(const asset_pack& pack, std::string name)
+  {
+    mPlaylist.push_back({std::move(name), &pack});
+  }
+
+  /// Returns the amount of tracks that couldn't be loaded, and are skipped.
+  [[nodiscard]] auto failed_count() const noexcept -> size_type
+  {
+    size_type count = 0;
+    for (const auto& track : mPlaylist) {
+      count += track.failed ? 1u : 0u;
+    }
+
+    return count;
+  }
+
+  /**
+   * Starts playing the playlist from a track.
+   *
+   * \details The track starts as soon as it has been loaded, which happens immediately if
+   *          it is the prefetched next track.
+   *
+   * \param index the index of the first track.
+   * \param fade the duration of the fade-in.
+   */
+  void play(const size_type index = 0, const ms_type fade = ms_type::zero())
+  {
+    assert(index < mPlaylist.size());
+    request(index, fade);
+  }
+
+  /// Transitions to the next track in the playlist.
+  void skip(const ms_type fade = ms_type {1'000})
+  {
+    if (const auto next = next_index()) {
+      request(*next, fade);
+    }
+  }
+
+  /// Fades out and stops the playback, the prefetched track is kept.
+  void stop(const ms_type fade = ms_type {1'000})
+  {
+    mRequest.reset();
+
+    if (mMode == music_player_mode::stream) {
+      if (fade.count() > 0 && Mix_PlayingMusic()) {
+        Mix_FadeOutMusic(fade.count());
+      }
+      else {
+        Mix_HaltMusic();
+      }
+    }
+    else if (mCurrent) {
+      fade_out_deck(mActiveDeck, fade);
+    }
+
+    retire_current();
+  }
+
+  /**
+   * Advances the playback, should be called once per frame.
+   *
+   * \details This collects loaded tracks, starts pending transitions, advances to the next
+   *          track when the current track ends, and frees tracks that have faded out.
+   */
+  void update()
+  {
+    CENTURION_PROFILE_SCOPE("music_player::update");
+
+    collect();
+
+    if (mOutgoing && !is_outgoing_playing()) {
+      mOutgoing.reset();
+    }
+
+    if (mRequest) {
+      start_requested();
+    }
+    else if (mCurrent && has_ended()) {
+      if (const auto next = next_index()) {
+        request(*next, mAutoFade);
+      }
+      else {
+        retire_current();
+      }
+    }
+
+    prefetch();
+  }
+
+  /// Sets whether the playlist starts over after the last track.
+  void set_looping(const bool looping) noexcept { mLooping = looping; }
+
+  /// Sets the duration of the transitions between tracks that end by themselves.
+  void set_transition(const ms_type fade) noexcept { mAutoFade = fade; }
+
+  /// Returns the index of the track that is playing, if any.
+  [[nodiscard]] auto current_track() const noexcept -> maybe<size_type>
+  {
+    return mCurrent ? maybe<size_type> {mCurrent->index} : nothing;
+  }
+
+  /// Indicates whether a track is being loaded on the thread pool.
+  [[nodiscard]] auto is_loading() const noexcept -> bool { return mLoading; }
+
+  /// Indicates whether a requested track is waiting to be started.
+  [[nodiscard]] auto is_pending() const noexcept -> bool { return mRequest.has_value(); }
+
+  [[nodiscard]] auto is_looping() const noexcept -> bool { return mLooping; }
+
+  [[nodiscard]] auto track_count() const noexcept -> size_type { return mPlaylist.size(); }
+
+  [[nodiscard]] auto mode() const noexcept -> music_player_mode { return mMode; }
+
+ private:
+  struct track_source final {
+    std::string name;           ///< The path, or the name of the pack entry.
+    const asset_pack* pack {};  ///< The pack that contains the track, if any.
+    bool failed {};             ///< Indicates whether the track couldn't be loaded.
+  };
+
+  struct loaded_track final {
+    size_type index {};
+    maybe<music> stream;          ///< Used in stream mode.
+    maybe<sound_effect> decoded;  ///< Used in decoded mode.
+    uint64 start {};              ///< The counter value when the track started playing.
+  };
+
+  struct transition final {
+    size_type index {};
+    ms_type fade {};
+  };
+
+  struct shared_state final {
+    spin_lock lock;
+    std::deque<loaded_track> tracks;
+  };
+
+  thread_pool* mPool {};
+  std::shared_ptr<shared_state> mState;
+  std::vector<track_source> mPlaylist;
+  maybe<loaded_track> mCurrent;
+  maybe<loaded_track> mNext;      ///< The prefetched track.
+  maybe<loaded_track> mOutgoing;  ///< A track that is fading out.
+  maybe<transition> mRequest;
+  ms_type mAutoFade {1'000};
+  music_player_mode mMode {};
+  int mDeck {};
+  int mActiveDeck {};
+  int mOutgoingDeck {};
+  bool mLooping {true};
+  bool mLoading {};
+  bool mFadingOut {};
+
+  /* Returns the first track after a track that hasn't failed to load */
+  [[nodiscard]] auto following(const maybe<size_type> index) const noexcept
+      -> maybe<size_type>
+  {
+    auto next = index ? *index + 1 : 0;
+
+    for (size_type attempt = 0; attempt < mPlaylist.size(); ++attempt, ++next) {
+      if (next >= mPlaylist.size()) {
+        if (!mLooping) {
+          return nothing;
+        }
+
+        next = 0;
+      }
+
+      if (!mPlaylist[next].failed) {
+        return next;
+      }
+    }
+
+    return nothing;
+  }
+
+  [[nodiscard]] auto next_index() const noexcept -> maybe<size_type>
+  {
+    return following(current_track());
+  }
+
+  void request(const size_type index, const ms_type fade)
+  {
+    mRequest = transition {index, fade};
+    start_requested();
+  }
+
+  void start_requested()
+  {
+    const auto [index, fade] = *mRequest;
+
+    /* In stream mode, the current music has to fade out completely first */
+    if (mMode == music_player_mode::stream && mCurrent) {
+      if (!mFadingOut) {
+        mFadingOut = true;
+        if (fade.count() > 0 && Mix_PlayingMusic() && !Mix_PausedMusic()) {
+          Mix_FadeOutMusic(fade.count());
+        }
+        else {
+          Mix_HaltMusic();
+        }
+      }
+
+      if (Mix_PlayingMusic()) {
+        return;
+      }
+
+      mCurrent.reset();
+      mFadingOut = false;
+    }
+
+    if (!mNext || mNext->index != index) {
+      load(index);
+      return;
+    }
+
+    auto track = std::move(*mNext);
+    mNext.reset();
+    mRequest.reset();
+
+    start(std::move(track), fade);
+  }
+
+  void start(loaded_track track, const ms_type fade)
+  {
+    if (mMode == music_player_mode::stream) {
+      mOutgoing.reset();
+
+      if (track.stream) {
+        if (fade.count() > 0) {
+          track.stream->fade_in(fade);
+        }
+        else {
+          track.stream->play();
+        }
+      }
+    }
+    else {
+      if (mCurrent) {
+        fade_out_deck(mActiveDeck, fade);
+        mOutgoing = std::move(mCurrent);
+        mOutgoingDeck = mActiveDeck;
+        mActiveDeck = (mActiveDeck == mDeck) ? mDeck + 1 : mDeck;
+      }
+      else {
+        mActiveDeck = (mOutgoing && mOutgoingDeck == mDeck) ? mDeck + 1 : mDeck;
+      }
+
+      if (track.decoded) {
+        Mix_HaltChannel(mActiveDeck);
+        Mix_FadeInChannel(mActiveDeck, track.decoded->get(), 0, fade.count());
+      }
+    }
+
+    track.start = now();
+    mCurrent = std::move(track);
+  }
+
+  /* Keeps the current track alive until it has faded out */
+  void retire_current() noexcept
+  {
+    if (mCurrent) {
+      mOutgoing = std::move(mCurrent);
+      mOutgoingDeck = mActiveDeck;
+    }
+
+    mCurrent.reset();
+    mFadingOut = false;
+  }
+
+  void halt() noexcept
+  {
+    if (mMode == music_player_mode::stream) {
+      if (mCurrent) {
+        Mix_HaltMusic();
+      }
+    }
+    else {
+      Mix_HaltChannel(mDeck);
+      Mix_HaltChannel(mDeck + 1);
+    }
+  }
+
+  void fade_out_deck(const int deck, const ms_type fade) noexcept
+  {
+    if (fade.count() > 0) {
+      Mix_FadeOutChannel(deck, fade.count());
+    }
+    else {
+      Mix_HaltChannel(deck);
+    }
+  }
+
+  [[nodiscard]] auto is_deck_playing(const int deck) const noexcept -> bool
+  {
+    return Mix_Playing(deck) != 0;
+  }
+
+  [[nodiscard]] auto is_outgoing_playing() const noexcept -> bool
+  {
+    if (mMode == music_player_mode::stream) {
+      return Mix_PlayingMusic() != 0;
+    }
+    else {
+      return is_deck_playing(mOutgoingDeck);
+    }
+  }
+
+  [[nodiscard]] auto has_ended() const noexcept -> bool
+  {
+    if (mMode == music_player_mode::stream) {
+      return !Mix_PlayingMusic();
+    }
+    else if (!mCurrent->decoded) {
+      return true;
+    }
+
+    /* Decoded tracks start their transition early, so that the tracks overlap */
+    int frequency {};
+    uint16 format {};
+    int channels {};
+    if (!Mix_QuerySpec(&frequency, &format, &channels)) {
+      return true;
+    }
+
+    const auto bytesPerSecond = static_cast<double>(frequency) * channels *
+                                static_cast<double>(SDL_AUDIO_BITSIZE(format) / 8);
+    const auto duration = static_cast<double>(mCurrent->decoded->get()->alen) / bytesPerSecond;
+    const auto fade = static_cast<double>(mAutoFade.count()) / 1'000.0;
+
+    const auto elapsed = static_cast<double>(now() - mCurrent->start) /
+                         static_cast<double>(cen::frequency());
+
+    return elapsed >= duration - fade || !is_deck_playing(mActiveDeck);
+  }
+
+  /* Starts loading the track that follows the current track, unless it's already loaded */
+  void prefetch()
+  {
+    if (mLoading || mNext) {
+      return;
+    }
+
+    if (const auto next = next_index(); next && (!mCurrent || *next != mCurrent->index)) {
+      load(*next);
+    }
+  }
+
+  void load(const size_type index)
+  {
+    if (mLoading) {
+      return; /* The result is checked against the request once it arrives */
+    }
+
+    mLoading = true;
+    mNext.reset();
+
+    mPool->submit([state = mState, source = mPlaylist.at(index), index, mode = mMode] {
+      loaded_track track;
+      track.index = index;
+
+      try {
+        if (mode == music_player_mode::stream) {
+          if (source.pack) {
+            track.stream.emplace(*source.pack, source.name);
+          }
+          else {
+            track.stream.emplace(music::preload(source.name));
+          }
+        }
+        else {
+          auto entry = source.pack ? source.pack->open(source.name)
+                                   : file {source.name, file_mode::rb};
+          track.decoded.emplace(detail::profiled_sound_load(
+              [&entry] { return Mix_LoadWAV_RW(entry.data(), SDL_FALSE); }));
+        }
+      }
+      catch (const exception&) {
+        /* The failure is reported through the empty track */
+      }
+
+      scoped_lock lock {state->lock};
+      state->tracks.push_back(std::move(track));
+    });
+  }
+
+  void collect()
+  {
+    maybe<loaded_track> track;
+
+    {
+      scoped_lock lock {mState->lock};
+      if (mState->tracks.empty()) {
+        return;
+      }
+
+      track.emplace(std::move(mState->tracks.front()));
+      mState->tracks.pop_front();
+    }
+
+    mLoading = false;
+
+    if (!track->stream && !track->decoded) {
+      /* Tracks that can't be loaded are skipped from now on */
+      mPlaylist[track->index].failed = true;
+
+      if (mRequest && mRequest->index == track->index) {
+        if (const auto next = following(track->index)) {
+          mRequest->index = *next;
+        }
+        else {
+          mRequest.reset();
+        }
+      }
+    }
+    else if (track->index == (mRequest ? mRequest->index : next_index().value_or(0))) {
+      mNext = std::move(track);
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_MIXER
+#endif  // CENTURION_AUDIO_MUSIC_PLAYER_HPP_
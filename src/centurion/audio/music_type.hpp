@@ -29,11 +29,16 @@
 
 #include <SDL_mixer.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class music_type {
@@ -83,11 +88,15 @@ enum class music_type {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const music_type type) -> std::ostream&
 {
   return stream << to_string(type);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_NO_SDL_MIXER
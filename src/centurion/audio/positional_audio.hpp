@@ -0,0 +1,236 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_AUDIO_POSITIONAL_AUDIO_HPP_
+#define CENTURION_AUDIO_POSITIONAL_AUDIO_HPP_
+
+#ifndef CENTURION_NO_SDL_MIXER
+
+#include <SDL_mixer.h>
+
+#include <cassert>  // assert
+#include <cmath>    // atan2, sqrt, lround
+#include <vector>   // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+namespace cen {
+
+/// A sound source, i.e. a playing mixer channel with a position in the world.
+struct audio_emitter final {
+  int channel {};   ///< The mixer channel that plays the sound of the emitter.
+  fpoint position;   ///< The position of the emitter, in world coordinates.
+};
+
+/// The point of view from which positional sounds are heard.
+struct audio_listener final {
+  fpoint position;  ///< The position of the listener, in world coordinates.
+
+  /// The direction that the listener faces, in degrees clockwise from the negative y-axis.
+  float direction {};
+};
+
+/**
+ * Updates the positions of many positional sounds at once.
+ *
+ * Once per frame, all emitters are converted to angles and distances relative to the
+ * listener, in a single pass. Since `Mix_SetPosition()` works with whole degrees and 256
+ * distance steps, most emitters don't change from one frame to the next, and only those that
+ * do are pushed to the mixer. Channels that were positioned in the previous update but have
+ * no emitter in the current update are reset.
+ * \code{cpp}
+ * cen::positional_audio audio {32, 800};
+ *
+ * // Once per frame
+ * audio.update(listener, emitters.data(), emitters.size());
+ * \endcode
+ *
+ * \details The world is assumed to use screen coordinates, i.e. with the y-axis pointing
+ *          down, so an emitter straight above a listener with direction 0 is in front of it.
+ */
+class positional_audio final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a positional audio system.
+   *
+   * \param minDistance the distance up to which sounds play at full volume.
+   * \param maxDistance the distance from which sounds are inaudible, must be greater than
+   *                    `minDistance`.
+   */
+  explicit positional_audio(const float minDistance = 0, const float maxDistance = 1'000)
+      : mMinDistance {minDistance}
+      , mMaxDistance {maxDistance}
+  {
+    assert(minDistance >= 0);
+    assert(minDistance < maxDistance);
+  }
+
+  /**
+   * Updates the positions of all emitters.
+   *
+   * \param listener the listener that the positions are relative to.
+   * \param emitters the emitters, with at most one emitter per channel.
+   * \param count the amount of emitters.
+   *
+   * \return the amount of mixer calls that were made.
+   */
+  auto update(const audio_listener& listener,
+              const audio_emitter* emitters,
+              const size_type count) -> size_type
+  {
+    assert(emitters || count == 0);
+
+    ++mGeneration;
+    size_type calls = 0;
+
+    const auto range = mMaxDistance - mMinDistance;
+
+    for (size_type index = 0; index < count; ++index) {
+      const auto& emitter = emitters[index];
+      assert(emitter.channel >= 0);
+
+      const auto dx = emitter.position.x() - listener.position.x();
+      const auto dy = emitter.position.y() - listener.position.y();
+      const auto length = std::sqrt(dx * dx + dy * dy);
+
+      /* Mix_SetPosition() measures angles clockwise from straight ahead */
+      constexpr float degrees_per_radian = 57.2957795f;
+      const auto angle = std::atan2(dx, -dy) * degrees_per_radian - listener.direction;
+      const auto wrapped = static_cast<int>(std::lround(angle)) % 360;
+
+      position next;
+      next.angle = static_cast<int16>((wrapped < 0) ? wrapped + 360 : wrapped);
+
+      const auto ratio = detail::clamp((length - mMinDistance) / range, 0.0f, 1.0f);
+      next.distance = static_cast<uint8>(std::lround(ratio * 255.0f));
+
+      /* The angle of sounds at the listener is arbitrary, so it's ignored when comparing */
+      if (next.distance == 0) {
+        next.angle = 0;
+      }
+
+      auto& state = channel_state(emitter.channel);
+      state.generation = mGeneration;
+
+      if (!state.applied || state.current.angle != next.angle ||
+          state.current.distance != next.distance) {
+        Mix_SetPosition(emitter.channel, next.angle, next.distance);
+        state.current = next;
+        state.applied = true;
+        ++calls;
+      }
+    }
+
+    for (size_type channel = 0; channel < mChannels.size(); ++channel) {
+      auto& state = mChannels[channel];
+      if (state.applied && state.generation != mGeneration) {
+        Mix_SetPosition(static_cast<int>(channel), 0, 0);
+        state = channel_entry {};
+        ++calls;
+      }
+    }
+
+    return calls;
+  }
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+  /// Updates the positions of all emitters, see the pointer overload for details.
+  auto update(const audio_listener& listener, std::span<const audio_emitter> emitters)
+      -> size_type
+  {
+    return update(listener, emitters.data(), emitters.size());
+  }
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+  /// Resets the positions of all channels that have been positioned.
+  void reset() noexcept
+  {
+    for (size_type channel = 0; channel < mChannels.size(); ++channel) {
+      if (mChannels[channel].applied) {
+        Mix_SetPosition(static_cast<int>(channel), 0, 0);
+      }
+    }
+
+    mChannels.clear();
+  }
+
+  void set_distance_range(const float minDistance, const float maxDistance) noexcept
+  {
+    assert(minDistance >= 0);
+    assert(minDistance < maxDistance);
+
+    mMinDistance = minDistance;
+    mMaxDistance = maxDistance;
+  }
+
+  [[nodiscard]] auto min_distance() const noexcept -> float { return mMinDistance; }
+
+  [[nodiscard]] auto max_distance() const noexcept -> float { return mMaxDistance; }
+
+ private:
+  struct position final {
+    int16 angle {};
+    uint8 distance {};
+  };
+
+  struct channel_entry final {
+    position current;
+    uint32 generation {};  ///< The last update that the channel had an emitter in.
+    bool applied {};       ///< Indicates whether the channel has a position effect.
+  };
+
+  std::vector<channel_entry> mChannels;  ///< Indexed by channel.
+  float mMinDistance {};
+  float mMaxDistance {};
+  uint32 mGeneration {};
+
+  [[nodiscard]] auto channel_state(const int channel) -> channel_entry&
+  {
+    const auto index = static_cast<size_type>(channel);
+    if (index >= mChannels.size()) {
+      mChannels.resize(index + 1);
+    }
+
+    return mChannels[index];
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_MIXER
+#endif  // CENTURION_AUDIO_POSITIONAL_AUDIO_HPP_
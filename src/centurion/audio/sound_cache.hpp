@@ -0,0 +1,325 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_AUDIO_SOUND_CACHE_HPP_
+#define CENTURION_AUDIO_SOUND_CACHE_HPP_
+
+#ifndef CENTURION_NO_SDL_MIXER
+
+#include <SDL_mixer.h>
+
+#include <cassert>      // assert
+#include <functional>   // less
+#include <map>          // map
+#include <string>       // string
+#include <string_view>  // string_view
+#include <utility>      // move
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../io/asset_pack.hpp"
+#include "../io/file.hpp"
+#include "../io/mapped_file.hpp"
+#include "../system/cache_manager.hpp"
+#include "mixer_profiling.hpp"
+#include "sound_effect.hpp"
+
+namespace cen {
+
+/**
+ * Decodes sound effects once, and shares them between all users.
+ *
+ * Every `sound_effect` decodes its own chunk, so loading the same file for many entities
+ * wastes both time and memory. A sound cache owns a single decoded chunk per key, and hands
+ * out non-owning handles to it.
+ * \code{cpp}
+ * cen::sound_cache sounds;
+ * sounds.preload(pack, "sounds/");
+ *
+ * auto footstep = sounds.get("sounds/footstep.wav");
+ * footstep.play();
+ * \endcode
+ *
+ * \details Sounds are decoded straight into the format of the opened audio device (as
+ *          reported by `Mix_QuerySpec()`), so no conversion happens when they are mixed. As a
+ *          consequence, the mixer must be opened before any sounds are loaded, and sounds
+ *          must be reloaded if the audio device is reopened with another format.
+ *
+ * \details Load failures are reported as empty handles, rather than as exceptions. Handles
+ *          are invalidated when their sound is erased, or when the cache is destroyed.
+ *
+ * \details The cache can be registered with a `cache_manager`, which evicts the least
+ *          recently obtained sounds that aren't playing on any channel.
+ *
+ * \see sound_effect_handle
+ * \see asset_pack
+ */
+class sound_cache final {
+ public:
+  using size_type = usize;
+
+  sound_cache() = default;
+
+  CENTURION_DISABLE_COPY(sound_cache)
+
+  sound_cache(sound_cache&&) = default;
+  auto operator=(sound_cache&&) -> sound_cache& = default;
+
+  /**
+   * Loads a sound file, unless it has already been loaded.
+   *
+   * \details The file is memory-mapped while it is decoded, if possible.
+   *
+   * \param path the path of the sound file, also used as the key of the sound.
+   *
+   * \return a handle to the sound; an empty handle if the sound couldn't be loaded.
+   */
+  auto load(const std::string& path) -> sound_effect_handle
+  {
+    if (auto sound = get(path)) {
+      return sound;
+    }
+
+    const mapped_file mapping {path};
+    if (!mapping) {
+      return sound_effect_handle {nullptr};
+    }
+
+    auto view = mapping.view();
+    return insert(path, view);
+  }
+
+  /// Loads a sound file, see `load(const std::string&)`.
+  auto load(const char* path) -> sound_effect_handle
+  {
+    assert(path);
+    return load(std::string {path});
+  }
+
+  /**
+   * Loads a sound from an asset pack, unless it has already been loaded.
+   *
+   * \param pack the asset pack that contains the sound.
+   * \param name the name of the pack entry, also used as the key of the sound.
+   *
+   * \return a handle to the sound; an empty handle if the sound couldn't be loaded.
+   */
+  auto load(const asset_pack& pack, const std::string_view name) -> sound_effect_handle
+  {
+    if (auto sound = get(name)) {
+      return sound;
+    }
+
+    auto view = pack.open(name);
+    return insert(std::string {name}, view);
+  }
+
+  /**
+   * Loads a sound from a file, unless a sound with the same key has already been loaded.
+   *
+   * \param key the key associated with the sound.
+   * \param source the file that contains the encoded sound, e.g. a view of a `mapped_file`.
+   *
+   * \return a handle to the sound; an empty handle if the sound couldn't be loaded.
+   */
+  auto load(std::string key, file& source) -> sound_effect_handle
+  {
+    if (auto sound = get(key)) {
+      return sound;
+    }
+
+    return insert(std::move(key), source);
+  }
+
+  /**
+   * Loads all sounds in an asset pack with names that start with a prefix.
+   *
+   * \param pack the asset pack that contains the sounds.
+   * \param prefix the prefix of the entry names, e.g. a directory such as `"sounds/"`.
+   *
+   * \return the amount of sounds that are available after the call, including those that
+   *         had already been loaded.
+   */
+  auto preload(const asset_pack& pack, const std::string_view prefix = {}) -> size_type
+  {
+    size_type count = 0;
+
+    for (asset_pack::size_type index = 0; index < pack.size(); ++index) {
+      const auto entry = pack.at(index);
+      if (entry.name.substr(0, prefix.size()) == prefix && load(pack, entry.name)) {
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  /// Returns a handle to a loaded sound, the handle is empty if there is no such sound.
+  [[nodiscard]] auto get(const std::string_view key) const noexcept -> sound_effect_handle
+  {
+    if (const auto iter = mSounds.find(key); iter != mSounds.end()) {
+      iter->second.last_use = cache_manager::tick();
+      return sound_effect_handle {iter->second.sound.get()};
+    }
+    else {
+      return sound_effect_handle {nullptr};
+    }
+  }
+
+  [[nodiscard]] auto contains(const std::string_view key) const noexcept -> bool
+  {
+    return mSounds.find(key) != mSounds.end();
+  }
+
+  /**
+   * Frees a loaded sound.
+   *
+   * \pre The sound must not be playing.
+   *
+   * \param key the key of the sound.
+   *
+   * \return `true` if a sound was erased; `false` otherwise.
+   */
+  auto erase(const std::string_view key) -> bool
+  {
+    if (const auto iter = mSounds.find(key); iter != mSounds.end()) {
+      mMemoryUsage -= iter->second.sound.get()->alen;
+      mSounds.erase(iter);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Frees all loaded sounds, none of which may be playing.
+  void clear() noexcept
+  {
+    mSounds.clear();
+    mMemoryUsage = 0;
+  }
+
+  /// Returns the amount of loaded sounds.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mSounds.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mSounds.empty(); }
+
+  /// Returns the total size of the decoded sample data, in bytes.
+  [[nodiscard]] auto memory_usage() const noexcept -> size_type { return mMemoryUsage; }
+
+  /// Returns the usage stamp of the least recently obtained sound that isn't playing.
+  [[nodiscard]] auto oldest_use() const noexcept -> maybe<uint64>
+  {
+    if (const auto iter = find_oldest(); iter != mSounds.end()) {
+      return iter->second.last_use;
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /**
+   * Frees the least recently obtained sound that isn't playing.
+   *
+   * \details Handles to the freed sound are invalidated, like with `erase()`.
+   *
+   * \return `true` if a sound was freed; `false` if all sounds are playing.
+   */
+  auto evict_oldest() -> bool
+  {
+    if (const auto iter = find_oldest(); iter != mSounds.end()) {
+      mMemoryUsage -= iter->second.sound.get()->alen;
+      mSounds.erase(iter);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+ private:
+  struct sound_entry final {
+    explicit sound_entry(Mix_Chunk* chunk) : sound {chunk}, last_use {cache_manager::tick()} {}
+
+    sound_effect sound;
+    mutable uint64 last_use {};  ///< Updated by lookups, which are logically const.
+  };
+
+  using sound_map = std::map<std::string, sound_entry, std::less<>>;
+
+  sound_map mSounds;
+  size_type mMemoryUsage {};
+
+  [[nodiscard]] static auto is_playing(const Mix_Chunk* chunk) noexcept -> bool
+  {
+    const auto channels = Mix_AllocateChannels(-1);
+    for (int channel = 0; channel < channels; ++channel) {
+      if (Mix_Playing(channel) && Mix_GetChunk(channel) == chunk) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  [[nodiscard]] auto find_oldest() const noexcept -> sound_map::const_iterator
+  {
+    auto oldest = mSounds.end();
+
+    for (auto iter = mSounds.begin(); iter != mSounds.end(); ++iter) {
+      if ((oldest == mSounds.end() || iter->second.last_use < oldest->second.last_use) &&
+          !is_playing(iter->second.sound.get())) {
+        oldest = iter;
+      }
+    }
+
+    return oldest;
+  }
+
+  auto insert(std::string key, file& source) -> sound_effect_handle
+  {
+    /* Chunks are converted to the format of the opened device when they are decoded, so
+       there is nothing to convert them to if the mixer isn't open. */
+    if (!source || !Mix_QuerySpec(nullptr, nullptr, nullptr)) {
+      return sound_effect_handle {nullptr};
+    }
+
+    auto* chunk = detail::profiled_sound_load(
+        [&source] { return Mix_LoadWAV_RW(source.data(), SDL_FALSE); });
+    if (!chunk) {
+      return sound_effect_handle {nullptr};
+    }
+
+    mMemoryUsage += chunk->alen;
+
+    const auto [iter, inserted] = mSounds.try_emplace(std::move(key), chunk);
+    return sound_effect_handle {iter->second.sound.get()};
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_MIXER
+#endif  // CENTURION_AUDIO_SOUND_CACHE_HPP_
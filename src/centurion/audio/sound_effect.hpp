@@ -30,7 +30,6 @@
 #include <SDL_mixer.h>
 
 #include <cassert>      // assert
-#include <ostream>      // ostream
 #include <string>       // string, to_string
 #include <string_view>  // string_view
 
@@ -41,6 +40,7 @@
 #include "../detail/stdlib.hpp"
 #include "../features.hpp"
 #include "../io/file.hpp"
+#include "mixer_profiling.hpp"
 
 #if CENTURION_HAS_FEATURE_FORMAT
 
@@ -48,6 +48,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 template <typename T>
@@ -94,7 +100,8 @@ class basic_sound_effect final {
   }
 
   template <typename TT = T, detail::enable_for_owner<TT> = 0>
-  explicit basic_sound_effect(const char* file) : mChunk {Mix_LoadWAV(file)}
+  explicit basic_sound_effect(const char* file)
+      : mChunk {detail::profiled_sound_load([file] { return Mix_LoadWAV(file); })}
   {
     if (!mChunk) {
       throw mix_error {};
@@ -107,7 +114,9 @@ class basic_sound_effect final {
   }
 
   template <typename TT = T, detail::enable_for_owner<TT> = 0>
-  explicit basic_sound_effect(file& file) : mChunk {Mix_LoadWAV_RW(file.data(), SDL_FALSE)}
+  explicit basic_sound_effect(file& file)
+      : mChunk {detail::profiled_sound_load(
+            [&file] { return Mix_LoadWAV_RW(file.data(), SDL_FALSE); })}
   {
     if (!mChunk) {
       throw mix_error {};
@@ -204,6 +213,13 @@ class basic_sound_effect final {
 
   [[nodiscard]] auto get() const noexcept -> Mix_Chunk* { return mChunk.get(); }
 
+  /// Indicates whether the handle holds a non-null pointer.
+  template <typename TT = T, detail::enable_for_handle<TT> = 0>
+  explicit operator bool() const noexcept
+  {
+    return mChunk != nullptr;
+  }
+
 #if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
 
   static void set_master_volume(const int volume) noexcept { Mix_MasterVolume(volume); }
@@ -237,12 +253,16 @@ template <typename T>
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_sound_effect<T>& sound) -> std::ostream&
 {
   return stream << to_string(sound);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 /// Returns a potentially empty handle to the sound associated with a channel.
 [[nodiscard]] inline auto get_sound(const int channel) noexcept -> sound_effect_handle
 {
@@ -0,0 +1,530 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_AUDIO_SPECTRUM_ANALYZER_HPP_
+#define CENTURION_AUDIO_SPECTRUM_ANALYZER_HPP_
+
+#ifndef CENTURION_NO_SDL_MIXER
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+
+#include <algorithm>  // copy, copy_n, fill
+#include <array>      // array
+#include <atomic>     // atomic, memory_order
+#include <cmath>      // cos, sin, sqrt
+#include <cstring>    // memcpy, memmove
+#include <vector>     // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/lock_free_queue.hpp"
+#include "../concurrency/thread.hpp"
+#include "../detail/audio_kernels.hpp"
+#include "../detail/stdlib.hpp"
+#include "../initialization.hpp"
+
+namespace cen {
+
+/// The spectrum and levels of the latest analysed window of mixed audio.
+struct audio_spectrum final {
+  std::vector<float> magnitudes;  ///< The bin magnitudes, a full scale sine yields about one.
+  float rms {};                   ///< The RMS level of the window, in the range [0, 1].
+  float peak {};                  ///< The largest absolute sample value of the window.
+  float bin_width {};             ///< The frequency range covered by each bin, in Hz.
+  uint64 sequence {};             ///< The number of the spectrum, zero if there is none yet.
+
+  /// Returns the center frequency of a bin, in Hz.
+  [[nodiscard]] auto bin_frequency(const usize bin) const noexcept -> float
+  {
+    return static_cast<float>(bin) * bin_width;
+  }
+
+  /**
+   * Returns the largest magnitude of the bins in a frequency range.
+   *
+   * \param low the lower bound of the range, in Hz.
+   * \param high the upper bound of the range, in Hz.
+   *
+   * \return the largest magnitude in the range; zero if the range contains no bins.
+   */
+  [[nodiscard]] auto band(const float low, const float high) const noexcept -> float
+  {
+    if (bin_width <= 0.0f || magnitudes.empty()) {
+      return 0;
+    }
+
+    const auto first = static_cast<usize>((detail::max)(low, 0.0f) / bin_width + 0.5f);
+    const auto last = static_cast<usize>((detail::max)(high, 0.0f) / bin_width + 0.5f);
+
+    float result {};
+    for (auto bin = first; bin <= last && bin < magnitudes.size(); ++bin) {
+      result = (detail::max)(result, magnitudes[bin]);
+    }
+
+    return result;
+  }
+};
+
+/**
+ * Computes the spectrum and levels of the mixed audio, for visualisations.
+ *
+ * Once attached, the analyzer taps the final mix through a post-mix effect, which only copies
+ * the mixed samples into a lock-free ring buffer. The samples are analysed by `analyze()`,
+ * which is called by a worker thread started with `start()`, or manually. Each analysis
+ * downmixes the latest window of samples to mono, applies a Hann window and computes the
+ * magnitudes with a radix-2 FFT, using SIMD kernels when available. A new spectrum is
+ * computed whenever half a window of new samples has been mixed.
+ *
+ * The results are published through a triple buffer, so `latest()` never blocks and never
+ * observes a partially written spectrum. However, `latest()` must only be called by a single
+ * thread, usually the render thread.
+ *
+ * The post-mix effect doesn't replace callbacks registered with `Mix_SetPostMix()`, so the
+ * analyzer can be used along with mixer profiling. Effect chains attached to the final mix
+ * before the analyzer are included in the analysed samples.
+ *
+ * \note Only 16-bit and 32-bit float sample formats are supported, like for effect chains.
+ *
+ * \see effect_chain
+ */
+class spectrum_analyzer final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a spectrum analyzer.
+   *
+   * \param spec the format of the opened audio device, see `query_mix_spec()`.
+   * \param windowSize the amount of frames in each analysed window, must be a power of two
+   *                   in the range [64, 16384]. The spectrum contains half as many bins.
+   *
+   * \throws exception if the window size or sample format is unsupported.
+   */
+  explicit spectrum_analyzer(const mix_spec& spec, const size_type windowSize = 1'024)
+      : mFrequency {spec.frequency}
+      , mChannels {spec.channels}
+      , mFormat {spec.format}
+      , mWindowSize {windowSize}
+  {
+    if (windowSize < 64 || windowSize > 16'384 || (windowSize & (windowSize - 1)) != 0) {
+      throw exception {"Spectrum analyzer window size must be a power of two in [64, 16384]!"};
+    }
+
+    if (mFormat != AUDIO_F32SYS && mFormat != AUDIO_S16SYS) {
+      throw exception {"Unsupported sample format for spectrum analyzer!"};
+    }
+
+    if (spec.channels <= 0 || spec.frequency <= 0) {
+      throw exception {"Invalid mixer specification for spectrum analyzer!"};
+    }
+
+    const auto channels = static_cast<size_type>(spec.channels);
+    const auto sampleSize = (mFormat == AUDIO_F32SYS) ? sizeof(float) : sizeof(int16);
+    mFrameSize = sampleSize * channels;
+
+    /* Leaves room for a few windows, and for large mixer buffers, in case the worker is late */
+    const auto frames = (detail::max)(4 * windowSize, size_type {8'192});
+    mRing.resize(detail::queue_capacity(frames * mFrameSize));
+    mRingMask = mRing.size() - 1;
+
+    mStaging.resize(mRing.size());
+    if (mFormat == AUDIO_S16SYS) {
+      mInterleaved.resize(mRing.size() / sizeof(int16));
+    }
+    mMono.resize(windowSize);
+    mWindowed.resize(windowSize);
+    mRe.resize(windowSize);
+    mIm.resize(windowSize);
+    mMagnitudes.resize(windowSize / 2);
+
+    prepare_window();
+    prepare_fft();
+
+    const auto binWidth = static_cast<float>(spec.frequency) / static_cast<float>(windowSize);
+    for (auto& slot : mSlots) {
+      slot.magnitudes.resize(windowSize / 2);
+      slot.bin_width = binWidth;
+    }
+  }
+
+  CENTURION_DISABLE_COPY(spectrum_analyzer)
+  CENTURION_DISABLE_MOVE(spectrum_analyzer)
+
+  ~spectrum_analyzer() noexcept
+  {
+    detach();
+    stop();
+  }
+
+  /**
+   * Starts tapping the final mix.
+   *
+   * \return `success` if the post-mix effect was registered; `failure` otherwise.
+   */
+  auto attach() noexcept -> result
+  {
+    if (mAttached) {
+      return success;
+    }
+
+    mAttached = Mix_RegisterEffect(MIX_CHANNEL_POST, &on_effect, nullptr, this) != 0;
+    return mAttached;
+  }
+
+  /// Stops tapping the final mix, the latest spectrum remains available.
+  void detach() noexcept
+  {
+    if (mAttached) {
+      Mix_UnregisterEffect(MIX_CHANNEL_POST, &on_effect);
+      mAttached = false;
+    }
+  }
+
+  /**
+   * Starts a worker thread that analyses the tapped samples.
+   *
+   * \details The worker polls the ring buffer at twice the rate at which new spectra are
+   *          produced, so that the audio thread never has to signal it.
+   *
+   * \throws sdl_error if the thread cannot be created.
+   */
+  void start()
+  {
+    if (!mWorker) {
+      mRunning.store(true, std::memory_order_relaxed);
+      mWorker.emplace(&run, "spectrum_analyzer", this);
+    }
+  }
+
+  /// Stops the worker thread, if it's running.
+  void stop() noexcept
+  {
+    if (mWorker) {
+      mRunning.store(false, std::memory_order_relaxed);
+      mWorker.reset();
+    }
+  }
+
+  /**
+   * Copies samples into the ring buffer, this is what the post-mix effect does.
+   *
+   * \details This must not be called concurrently with the post-mix effect, but can be used
+   *          to analyse samples that aren't played, e.g. in tests. If the ring buffer is full,
+   *          the samples are dropped.
+   *
+   * \param samples the interleaved samples, in the format of the analyzer.
+   * \param bytes the size of the samples, in bytes.
+   */
+  void push(const void* samples, const size_type bytes) noexcept
+  {
+    const auto tail = mTail.load(std::memory_order_relaxed);
+    const auto head = mHead.load(std::memory_order_acquire);
+
+    if (bytes > mRing.size() - (tail - head)) {
+      mDropped.fetch_add(bytes / mFrameSize, std::memory_order_relaxed);
+      return;
+    }
+
+    const auto offset = tail & mRingMask;
+    const auto first = (detail::min)(bytes, mRing.size() - offset);
+
+    const auto* source = static_cast<const uint8*>(samples);
+    std::memcpy(mRing.data() + offset, source, first);
+    std::memcpy(mRing.data(), source + first, bytes - first);
+
+    mTail.store(tail + bytes, std::memory_order_release);
+  }
+
+  /**
+   * Analyses the samples in the ring buffer.
+   *
+   * \details This must only be called by one thread at a time, which must not be the worker
+   *          thread if it's running. It never allocates.
+   *
+   * \return `true` if a new spectrum was published; `false` otherwise.
+   */
+  auto analyze() noexcept -> bool
+  {
+    const auto head = mHead.load(std::memory_order_relaxed);
+    const auto tail = mTail.load(std::memory_order_acquire);
+
+    const auto bytes = tail - head;
+    if (bytes == 0) {
+      return false;
+    }
+
+    const auto offset = head & mRingMask;
+    const auto first = (detail::min)(bytes, mRing.size() - offset);
+
+    std::memcpy(mStaging.data(), mRing.data() + offset, first);
+    std::memcpy(mStaging.data() + first, mRing.data(), bytes - first);
+
+    mHead.store(tail, std::memory_order_release);
+
+    append(bytes / mFrameSize);
+
+    if (mPending < mWindowSize / 2) {
+      return false;
+    }
+
+    mPending = 0;
+    compute();
+
+    return true;
+  }
+
+  /**
+   * Returns the most recently published spectrum.
+   *
+   * \details This never blocks, and the returned spectrum isn't modified until the next call.
+   *          This must only be called by a single thread.
+   *
+   * \return the latest spectrum, with a zero sequence number if nothing has been analysed.
+   */
+  [[nodiscard]] auto latest() noexcept -> const audio_spectrum&
+  {
+    if (mShared.load(std::memory_order_relaxed) & fresh_bit) {
+      const auto previous = mShared.exchange(mFront, std::memory_order_acq_rel);
+      mFront = static_cast<uint8>(previous & slot_mask);
+    }
+
+    return mSlots[mFront];
+  }
+
+  /// Indicates whether the analyzer is tapping the final mix.
+  [[nodiscard]] auto is_attached() const noexcept -> bool { return mAttached; }
+
+  /// Indicates whether the worker thread is running.
+  [[nodiscard]] auto is_running() const noexcept -> bool { return mWorker.has_value(); }
+
+  /// Returns the amount of frames that were dropped because the ring buffer was full.
+  [[nodiscard]] auto dropped_frames() const noexcept -> uint64
+  {
+    return mDropped.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of frames in each analysed window.
+  [[nodiscard]] auto window_size() const noexcept -> size_type { return mWindowSize; }
+
+  /// Returns the amount of bins in each spectrum.
+  [[nodiscard]] auto bin_count() const noexcept -> size_type { return mWindowSize / 2; }
+
+ private:
+  inline constexpr static uint8 slot_mask = 0x3;
+  inline constexpr static uint8 fresh_bit = 0x4;
+
+  int mFrequency {};
+  int mChannels {};
+  uint16 mFormat {};
+  size_type mWindowSize {};
+  size_type mFrameSize {};
+
+  /* The ring buffer, written by the audio thread and read by the analysing thread */
+  std::vector<uint8> mRing;
+  size_type mRingMask {};
+  alignas(detail::cache_line_size) std::atomic<size_type> mTail {};
+  alignas(detail::cache_line_size) std::atomic<size_type> mHead {};
+  std::atomic<uint64> mDropped {};
+
+  /* Only accessed by the analysing thread */
+  std::vector<uint8> mStaging;
+  std::vector<float> mInterleaved;  ///< The converted samples, for 16-bit formats.
+  std::vector<float> mMono;  ///< The latest window of mono samples, oldest first.
+  std::vector<float> mWindow;
+  std::vector<float> mWindowed;
+  std::vector<float> mRe;
+  std::vector<float> mIm;
+  std::vector<float> mMagnitudes;
+  std::vector<float> mTwiddleRe;  ///< The twiddle factors of each stage, one after another.
+  std::vector<float> mTwiddleIm;
+  std::vector<uint32> mBitReverse;
+  float mWindowGain {};
+  size_type mPending {};  ///< The amount of new frames since the latest spectrum.
+  uint64 mSequence {};
+  uint8 mBack {0};
+
+  /* The triple buffer, the middle slot index and fresh flag are shared */
+  std::array<audio_spectrum, 3> mSlots;
+  std::atomic<uint8> mShared {1};
+  uint8 mFront {2};  ///< Only accessed by the reading thread.
+
+  std::atomic<bool> mRunning {};
+  bool mAttached {};
+  maybe<thread> mWorker;  ///< Must be the last member, so that it is joined first.
+
+  static void SDLCALL on_effect(int, void* stream, const int length, void* data) noexcept
+  {
+    static_cast<spectrum_analyzer*>(data)->push(stream, static_cast<size_type>(length));
+  }
+
+  static auto SDLCALL run(void* data) -> int
+  {
+    auto* self = static_cast<spectrum_analyzer*>(data);
+
+    /* Polls twice per hop, i.e. four times per window */
+    const auto hop = 1'000.0 * static_cast<double>(self->mWindowSize) /
+                     static_cast<double>(self->mFrequency) / 4.0;
+    const u32ms delay {(detail::max)(static_cast<uint32>(hop), uint32 {1})};
+
+    while (self->mRunning.load(std::memory_order_relaxed)) {
+      if (!self->analyze()) {
+        thread::sleep(delay);
+      }
+    }
+
+    return 0;
+  }
+
+  void prepare_window()
+  {
+    constexpr auto tau = 6.283185307179586;
+
+    mWindow.resize(mWindowSize);
+    mWindowGain = 0;
+
+    for (size_type index = 0; index < mWindowSize; ++index) {
+      const auto phase = tau * static_cast<double>(index) / static_cast<double>(mWindowSize);
+      mWindow[index] = static_cast<float>(0.5 - 0.5 * std::cos(phase));
+      mWindowGain += mWindow[index];
+    }
+  }
+
+  void prepare_fft()
+  {
+    constexpr auto tau = 6.283185307179586;
+
+    size_type bits = 0;
+    while ((size_type {1} << bits) < mWindowSize) {
+      ++bits;
+    }
+
+    mBitReverse.resize(mWindowSize);
+    for (size_type index = 0; index < mWindowSize; ++index) {
+      size_type reversed = 0;
+      for (size_type bit = 0; bit < bits; ++bit) {
+        reversed |= ((index >> bit) & 1u) << (bits - 1 - bit);
+      }
+
+      mBitReverse[index] = static_cast<uint32>(reversed);
+    }
+
+    /* The stage with half size H stores its factors at [H - 1, 2H - 1) */
+    mTwiddleRe.resize(mWindowSize - 1);
+    mTwiddleIm.resize(mWindowSize - 1);
+    for (size_type half = 1; half < mWindowSize; half *= 2) {
+      for (size_type index = 0; index < half; ++index) {
+        const auto angle = -tau * static_cast<double>(index) / static_cast<double>(2 * half);
+        mTwiddleRe[half - 1 + index] = static_cast<float>(std::cos(angle));
+        mTwiddleIm[half - 1 + index] = static_cast<float>(std::sin(angle));
+      }
+    }
+  }
+
+  /* Downmixes the staged frames, and appends them to the mono window */
+  void append(size_type frames) noexcept
+  {
+    const auto channels = static_cast<size_type>(mChannels);
+    const auto samples = frames * channels;
+
+    const auto* interleaved = reinterpret_cast<const float*>(mStaging.data());
+    if (mFormat == AUDIO_S16SYS) {
+      detail::s16_to_f32_n(reinterpret_cast<const int16*>(mStaging.data()),
+                           mInterleaved.data(),
+                           samples);
+      interleaved = mInterleaved.data();
+    }
+
+    mPending += frames;
+
+    /* Only the latest window of frames is of interest */
+    if (frames > mWindowSize) {
+      interleaved += (frames - mWindowSize) * channels;
+      frames = mWindowSize;
+    }
+
+    const auto kept = mWindowSize - frames;
+    std::memmove(mMono.data(), mMono.data() + frames, kept * sizeof(float));
+
+    auto* out = mMono.data() + kept;
+    const auto scale = 1.0f / static_cast<float>(channels);
+
+    if (channels == 1) {
+      std::copy_n(interleaved, frames, out);
+    }
+    else {
+      for (size_type frame = 0; frame < frames; ++frame) {
+        float sum {};
+        for (size_type channel = 0; channel < channels; ++channel) {
+          sum += interleaved[frame * channels + channel];
+        }
+
+        out[frame] = sum * scale;
+      }
+    }
+  }
+
+  void compute() noexcept
+  {
+    const auto levels = detail::levels_n(mMono.data(), mWindowSize);
+
+    detail::multiply_n(mMono.data(), mWindow.data(), mWindowed.data(), mWindowSize);
+
+    for (size_type index = 0; index < mWindowSize; ++index) {
+      mRe[mBitReverse[index]] = mWindowed[index];
+    }
+
+    std::fill(mIm.begin(), mIm.end(), 0.0f);
+
+    for (size_type half = 1; half < mWindowSize; half *= 2) {
+      const auto* wr = mTwiddleRe.data() + (half - 1);
+      const auto* wi = mTwiddleIm.data() + (half - 1);
+
+      for (size_type start = 0; start < mWindowSize; start += 2 * half) {
+        detail::butterfly_n(mRe.data() + start, mIm.data() + start, wr, wi, half);
+      }
+    }
+
+    /* Scales the magnitudes so that a full scale sine at a bin frequency yields one */
+    detail::magnitude_n(mRe.data(), mIm.data(), mMagnitudes.data(), mMagnitudes.size());
+    detail::gain_n(mMagnitudes.data(), mMagnitudes.size(), 2.0f / mWindowGain);
+
+    auto& slot = mSlots[mBack];
+    std::copy(mMagnitudes.begin(), mMagnitudes.end(), slot.magnitudes.begin());
+    slot.rms = std::sqrt(levels.squares / static_cast<float>(mWindowSize));
+    slot.peak = levels.peak;
+    slot.sequence = ++mSequence;
+
+    const auto previous =
+        mShared.exchange(static_cast<uint8>(mBack | fresh_bit), std::memory_order_acq_rel);
+    mBack = static_cast<uint8>(previous & slot_mask);
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_MIXER
+#endif  // CENTURION_AUDIO_SPECTRUM_ANALYZER_HPP_
@@ -0,0 +1,320 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_AUDIO_VOICE_MANAGER_HPP_
+#define CENTURION_AUDIO_VOICE_MANAGER_HPP_
+
+#ifndef CENTURION_NO_SDL_MIXER
+
+#include <SDL_mixer.h>
+
+#include <cassert>  // assert
+#include <vector>   // vector
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/timer.hpp"
+#include "sound_effect.hpp"
+
+namespace cen {
+
+/**
+ * Schedules sound effects on a fixed set of reserved mixer channels.
+ *
+ * Channels are partitioned into categories, each backed by a mixer channel group, so that
+ * e.g. a flood of impact sounds can never starve dialogue or UI cues of channels. When all
+ * channels of a category are busy, the voice with the lowest priority is stolen, preferring
+ * the oldest voice among equal priorities. Requests to play a sound that was already started
+ * in the same category within the deduplication window are ignored.
+ *
+ * The managed channels are reserved, which means that they are never picked by functions
+ * that play sounds on the first free channel, such as `sound_effect::play()`. Only a single
+ * voice manager should be used at a time, since categories map directly to global mixer
+ * channel groups.
+ *
+ * \see sound_effect
+ */
+class voice_manager final {
+ public:
+  using channel_index = int;
+  using category_id = int;
+
+  /// Play statistics, useful for tuning category sizes and priorities.
+  struct voice_stats final {
+    usize played {};        ///< Amount of sounds that were started.
+    usize stolen {};        ///< Amount of voices that were cut off by other sounds.
+    usize deduplicated {};  ///< Amount of requests ignored as duplicates.
+    usize dropped {};       ///< Amount of requests that found no available channel.
+  };
+
+  CENTURION_DISABLE_COPY(voice_manager)
+  CENTURION_DISABLE_MOVE(voice_manager)
+
+  /**
+   * Creates a voice manager without any categories.
+   *
+   * \param dedupWindow the duration in which identical sounds in a category are ignored,
+   *                    zero disables deduplication.
+   */
+  explicit voice_manager(const u32ms dedupWindow = u32ms {30}) noexcept
+      : mDedupWindow {dedupWindow}
+  {}
+
+  /// Releases the channel groups and the channel reservation.
+  ~voice_manager() noexcept
+  {
+    if (!mVoices.empty()) {
+      stop_all();
+      Mix_GroupChannels(0, channel_count() - 1, -1);
+      Mix_ReserveChannels(0);
+    }
+  }
+
+  /**
+   * Adds a category with a dedicated set of channels.
+   *
+   * \details Additional mixer channels are allocated if there are not enough of them.
+   *
+   * \param channels the amount of channels reserved for the category, must be positive.
+   *
+   * \return the identifier of the new category; an empty optional on failure.
+   */
+  auto add_category(const int channels) -> maybe<category_id>
+  {
+    if (channels <= 0) {
+      return nothing;
+    }
+
+    const auto first = channel_count();
+    const auto total = first + channels;
+
+    if (Mix_AllocateChannels(-1) < total && Mix_AllocateChannels(total) < total) {
+      return nothing;
+    }
+
+    const auto id = category_count();
+    if (Mix_GroupChannels(first, total - 1, id) != channels) {
+      Mix_GroupChannels(first, total - 1, -1);
+      return nothing;
+    }
+
+    Mix_ReserveChannels(total);
+
+    mCategories.push_back({first, channels});
+    mVoices.resize(static_cast<usize>(total));
+
+    return id;
+  }
+
+  /**
+   * Plays a sound in a category.
+   *
+   * \details If all channels of the category are busy, the voice with the lowest priority is
+   * stopped and replaced, as long as its priority isn't higher than the requested priority.
+   *
+   * \param category the category that the sound belongs to.
+   * \param chunk the sound data, must not be null.
+   * \param priority the priority of the voice, higher values are less likely to be stolen.
+   * \param iterations the amount of times to loop the sound, `sound_effect::forever` loops
+   *                   the sound indefinitely.
+   *
+   * \return the channel that plays the sound; an empty optional if it was not played.
+   */
+  auto play(const category_id category,
+            Mix_Chunk* chunk,
+            const int priority = 0,
+            const int iterations = 0) noexcept -> maybe<channel_index>
+  {
+    assert(category >= 0 && category < category_count());
+    assert(chunk);
+
+    const auto& [first, size] = mCategories[static_cast<usize>(category)];
+    const auto time = now();
+    const auto window = dedup_ticks();
+
+    auto available = sound_effect::undefined_channel;
+    auto victim = sound_effect::undefined_channel;
+
+    for (auto channel = first; channel < first + size; ++channel) {
+      const auto& voice = mVoices[static_cast<usize>(channel)];
+
+      if (voice.chunk == chunk && time - voice.start < window) {
+        ++mStats.deduplicated;
+        return nothing;
+      }
+
+      if (!voice.chunk || !Mix_Playing(channel)) {
+        if (available == sound_effect::undefined_channel) {
+          available = channel;
+        }
+      }
+      else if (victim == sound_effect::undefined_channel ||
+               is_weaker(voice, mVoices[static_cast<usize>(victim)])) {
+        victim = channel;
+      }
+    }
+
+    if (available == sound_effect::undefined_channel) {
+      if (victim == sound_effect::undefined_channel ||
+          mVoices[static_cast<usize>(victim)].priority > priority) {
+        ++mStats.dropped;
+        return nothing;
+      }
+
+      Mix_HaltChannel(victim);
+      ++mStats.stolen;
+
+      available = victim;
+    }
+
+    const auto channel =
+        Mix_PlayChannel(available, chunk, detail::max(iterations, sound_effect::forever));
+    if (channel == sound_effect::undefined_channel) {
+      mVoices[static_cast<usize>(available)] = voice_state {};
+      ++mStats.dropped;
+      return nothing;
+    }
+
+    mVoices[static_cast<usize>(channel)] = voice_state {chunk, time, priority};
+    ++mStats.played;
+
+    return channel;
+  }
+
+  /// Plays a sound effect in a category, see the `Mix_Chunk` overload for details.
+  template <typename T>
+  auto play(const category_id category,
+            const basic_sound_effect<T>& sound,
+            const int priority = 0,
+            const int iterations = 0) noexcept -> maybe<channel_index>
+  {
+    return play(category, sound.get(), priority, iterations);
+  }
+
+  /// Halts all sounds in a category.
+  void stop(const category_id category) noexcept
+  {
+    assert(category >= 0 && category < category_count());
+
+    Mix_HaltGroup(category);
+
+    const auto& [first, size] = mCategories[static_cast<usize>(category)];
+    for (auto channel = first; channel < first + size; ++channel) {
+      mVoices[static_cast<usize>(channel)] = voice_state {};
+    }
+  }
+
+  /// Halts all sounds in all categories.
+  void stop_all() noexcept
+  {
+    for (auto category = 0; category < category_count(); ++category) {
+      stop(category);
+    }
+  }
+
+  /// Sets the duration in which identical sounds in a category are ignored.
+  void set_dedup_window(const u32ms window) noexcept { mDedupWindow = window; }
+
+  void reset_stats() noexcept { mStats = voice_stats {}; }
+
+  /// Returns the amount of sounds currently playing in a category.
+  [[nodiscard]] auto active_count(const category_id category) const noexcept -> int
+  {
+    assert(category >= 0 && category < category_count());
+
+    const auto& [first, size] = mCategories[static_cast<usize>(category)];
+
+    auto count = 0;
+    for (auto channel = first; channel < first + size; ++channel) {
+      if (mVoices[static_cast<usize>(channel)].chunk && Mix_Playing(channel)) {
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  /// Returns the amount of channels reserved for a category.
+  [[nodiscard]] auto category_size(const category_id category) const noexcept -> int
+  {
+    assert(category >= 0 && category < category_count());
+    return mCategories[static_cast<usize>(category)].size;
+  }
+
+  [[nodiscard]] auto category_count() const noexcept -> int
+  {
+    return static_cast<int>(mCategories.size());
+  }
+
+  /// Returns the total amount of channels managed by the voice manager.
+  [[nodiscard]] auto channel_count() const noexcept -> int
+  {
+    return static_cast<int>(mVoices.size());
+  }
+
+  [[nodiscard]] auto dedup_window() const noexcept -> u32ms { return mDedupWindow; }
+
+  [[nodiscard]] auto stats() const noexcept -> const voice_stats& { return mStats; }
+
+ private:
+  struct category_range final {
+    channel_index first {};
+    int size {};
+  };
+
+  struct voice_state final {
+    Mix_Chunk* chunk {};  ///< The last sound started on the channel, null if unused.
+    uint64 start {};      ///< Performance counter value when the sound was started.
+    int priority {};
+  };
+
+  std::vector<category_range> mCategories;
+  std::vector<voice_state> mVoices;  ///< Indexed by channel.
+  voice_stats mStats;
+  u32ms mDedupWindow;
+
+  [[nodiscard]] auto dedup_ticks() const noexcept -> uint64
+  {
+    return static_cast<uint64>(mDedupWindow.count()) * frequency() / 1'000u;
+  }
+
+  /// Indicates whether a voice is a better candidate for stealing than another voice.
+  [[nodiscard]] static auto is_weaker(const voice_state& voice,
+                                      const voice_state& other) noexcept -> bool
+  {
+    if (voice.priority != other.priority) {
+      return voice.priority < other.priority;
+    }
+    else {
+      return voice.start < other.start;
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_MIXER
+#endif  // CENTURION_AUDIO_VOICE_MANAGER_HPP_
@@ -0,0 +1,243 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+module;
+
+#include "centurion/common.hpp"
+
+export module centurion:common;
+
+export namespace cen {
+
+using cen::memory_functions;
+using cen::allocation_stats;
+using cen::current_memory_functions;
+using cen::set_memory_functions;
+using cen::enable_allocation_tracking;
+using cen::is_tracking_allocations;
+using cen::allocation_statistics;
+
+using cen::log_overflow_policy;
+using cen::async_log_message_size;
+using cen::async_log_sink;
+
+using cen::log_format_id;
+using cen::log_format;
+using cen::register_log_format;
+using cen::get_log_format;
+using cen::binary_log_writer;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::decode_binary_log;
+
+#endif  // CENTURION_NO_IOSTREAM
+
+using cen::exception;
+using cen::sdl_error;
+
+#ifndef CENTURION_NO_SDL_IMAGE
+using cen::img_error;
+#endif  // CENTURION_NO_SDL_IMAGE
+
+#ifndef CENTURION_NO_SDL_TTF
+using cen::ttf_error;
+#endif  // CENTURION_NO_SDL_TTF
+
+#ifndef CENTURION_NO_SDL_MIXER
+using cen::mix_error;
+#endif  // CENTURION_NO_SDL_MIXER
+
+using cen::truncating_iterator;
+using cen::format_to_buffer;
+
+using cen::frame_arena;
+
+#if CENTURION_HAS_FEATURE_MEMORY_RESOURCE
+using cen::arena_resource;
+#endif  // CENTURION_HAS_FEATURE_MEMORY_RESOURCE
+
+using cen::basic_point_array;
+using cen::basic_rect_array;
+using cen::ipoint_array;
+using cen::fpoint_array;
+using cen::irect_array;
+using cen::frect_array;
+
+using cen::hash64;
+using cen::hasher64;
+using cen::hash64_stream;
+using cen::content_hash;
+
+using cen::log_priority;
+using cen::log_category;
+using cen::is_custom;
+using cen::refresh_log_priorities;
+using cen::reset_log_priorities;
+using cen::set_priority;
+using cen::get_priority;
+using cen::is_log_compiled;
+using cen::is_log_enabled;
+using cen::max_log_message_size;
+using cen::log;
+using cen::log_verbose;
+using cen::log_debug;
+using cen::log_info;
+using cen::log_warn;
+using cen::log_error;
+using cen::log_critical;
+using cen::log_limiter;
+using cen::log_every;
+using cen::log_once;
+
+using cen::basic_vector3;
+using cen::ivec3;
+using cen::fvec3;
+using cen::serialize;
+using cen::basic_area;
+using cen::iarea;
+using cen::farea;
+using cen::area_of;
+using cen::format_to;
+using cen::point_traits;
+using cen::basic_point;
+using cen::ipoint;
+using cen::fpoint;
+using cen::distance;
+using cen::operator+;
+using cen::operator-;
+using cen::rect_traits;
+using cen::basic_rect;
+using cen::irect;
+using cen::frect;
+using cen::intersects;
+using cen::overlaps;
+using cen::get_union;
+
+using cen::deleter;
+using cen::managed_ptr;
+using cen::simd_block;
+
+using cen::is_debug_build;
+using cen::is_release_build;
+using cen::on_msvc;
+using cen::on_gcc;
+using cen::on_clang;
+using cen::usize;
+using cen::uint;
+using cen::ulonglong;
+using cen::uint8;
+using cen::uint16;
+using cen::uint32;
+using cen::uint64;
+using cen::int8;
+using cen::int16;
+using cen::int32;
+using cen::int64;
+using cen::unicode_t;
+using cen::unicode32_t;
+using cen::seconds;
+using cen::millis;
+using cen::minutes;
+using cen::u16ms;
+using cen::u32ms;
+using cen::u64ms;
+using cen::bounded_array_ref;
+using cen::owner;
+using cen::maybe_owner;
+using cen::maybe;
+using cen::nothing;
+
+using cen::basic_quadtree;
+using cen::iquadtree;
+using cen::fquadtree;
+
+using cen::result;
+using cen::success;
+using cen::failure;
+using cen::operator==;
+using cen::operator!=;
+using cen::to_string;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::operator<<;
+
+#endif  // CENTURION_NO_IOSTREAM
+
+using cen::sdl_string;
+
+using cen::simd_vector;
+
+using cen::slot_id;
+using cen::slot_map;
+
+using cen::basic_spatial_hash;
+using cen::ispatial_hash;
+using cen::fspatial_hash;
+
+using cen::enable_for_pointer_t;
+using cen::enable_for_convertible_t;
+using cen::enable_for_enum_t;
+using cen::is_number;
+
+#if CENTURION_HAS_FEATURE_CONCEPTS
+using cen::is_stateless_callable;
+#endif  // CENTURION_HAS_FEATURE_CONCEPTS
+
+using cen::cast;
+using cen::to_underlying;
+using cen::isize;
+using cen::str_or_na;
+
+using cen::version;
+using cen::current_version;
+using cen::version_at_least;
+using cen::sdl_version;
+using cen::sdl_linked_version;
+
+#ifndef CENTURION_NO_SDL_IMAGE
+using cen::sdl_image_version;
+using cen::sdl_image_linked_version;
+#endif  // CENTURION_NO_SDL_IMAGE
+
+#ifndef CENTURION_NO_SDL_MIXER
+using cen::sdl_mixer_version;
+using cen::sdl_mixer_linked_version;
+#endif  // CENTURION_NO_SDL_MIXER
+
+#ifndef CENTURION_NO_SDL_TTF
+using cen::sdl_ttf_version;
+using cen::sdl_ttf_linked_version;
+#endif  // CENTURION_NO_SDL_TTF
+
+}  // namespace cen
+
+export namespace cen::literals::time_literals {
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+using cen::literals::time_literals::operator""_ms;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+}  // namespace cen::literals::time_literals
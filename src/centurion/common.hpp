@@ -22,14 +22,25 @@
  * SOFTWARE.
  */
 
+#include "common/allocation_tracking.hpp"
+#include "common/async_logging.hpp"
+#include "common/binary_logging.hpp"
 #include "common/errors.hpp"
+#include "common/formatting.hpp"
+#include "common/frame_arena.hpp"
+#include "common/geometry_arrays.hpp"
+#include "common/hash.hpp"
 #include "common/literals.hpp"
 #include "common/logging.hpp"
 #include "common/math.hpp"
 #include "common/memory.hpp"
 #include "common/primitives.hpp"
+#include "common/quadtree.hpp"
 #include "common/result.hpp"
 #include "common/sdl_string.hpp"
+#include "common/simd_vector.hpp"
+#include "common/slot_map.hpp"
+#include "common/spatial_hash.hpp"
 #include "common/traits.hpp"
 #include "common/utils.hpp"
 #include "common/version.hpp"
@@ -0,0 +1,305 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_COMMON_ALLOCATION_TRACKING_HPP_
+#define CENTURION_COMMON_ALLOCATION_TRACKING_HPP_
+
+#include <SDL.h>
+
+#include <atomic>   // atomic
+#include <cstddef>  // byte, max_align_t, size_t
+#include <cstring>  // memcpy
+
+#include "primitives.hpp"
+#include "result.hpp"
+
+namespace cen {
+
+/// A set of SDL-compatible memory functions.
+struct memory_functions final {
+  SDL_malloc_func malloc {};
+  SDL_calloc_func calloc {};
+  SDL_realloc_func realloc {};
+  SDL_free_func free {};
+};
+
+/// A snapshot of the memory allocated through SDL and its extension libraries.
+struct allocation_stats final {
+  usize live_bytes {};          ///< The amount of currently allocated bytes.
+  usize peak_bytes {};          ///< The highest amount of simultaneously allocated bytes.
+  usize live_allocations {};    ///< The amount of currently live allocations.
+  uint64 total_allocations {};  ///< The total amount of allocations, including reallocations.
+  uint64 total_frees {};        ///< The total amount of deallocations.
+};
+
+namespace detail {
+
+/* Every tracked block is prefixed with a header that stores the requested size, which keeps
+   the alignment guarantees of the underlying allocator intact. */
+inline constexpr usize allocation_header_size = alignof(std::max_align_t);
+
+struct allocation_tracker final {
+  memory_functions base;
+  std::atomic<usize> live_bytes {};
+  std::atomic<usize> peak_bytes {};
+  std::atomic<usize> live_allocations {};
+  std::atomic<uint64> total_allocations {};
+  std::atomic<uint64> total_frees {};
+  std::atomic<bool> installed {};
+};
+
+[[nodiscard]] inline auto get_allocation_tracker() noexcept -> allocation_tracker&
+{
+  static allocation_tracker tracker;
+  return tracker;
+}
+
+inline void record_growth(allocation_tracker& tracker, const usize bytes) noexcept
+{
+  const auto live = tracker.live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+  auto peak = tracker.peak_bytes.load(std::memory_order_relaxed);
+  while (live > peak &&
+         !tracker.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+  }
+}
+
+[[nodiscard]] inline auto write_allocation_header(void* block, const usize size) noexcept
+    -> void*
+{
+  std::memcpy(block, &size, sizeof size);
+  return static_cast<std::byte*>(block) + allocation_header_size;
+}
+
+[[nodiscard]] inline auto allocation_header(void* memory) noexcept -> void*
+{
+  return static_cast<std::byte*>(memory) - allocation_header_size;
+}
+
+[[nodiscard]] inline auto allocation_size(void* header) noexcept -> usize
+{
+  usize size {};
+  std::memcpy(&size, header, sizeof size);
+  return size;
+}
+
+inline void* SDLCALL tracked_malloc(const std::size_t size)
+{
+  auto& tracker = get_allocation_tracker();
+
+  void* block = tracker.base.malloc(size + allocation_header_size);
+  if (!block) {
+    return nullptr;
+  }
+
+  record_growth(tracker, size);
+  tracker.live_allocations.fetch_add(1, std::memory_order_relaxed);
+  tracker.total_allocations.fetch_add(1, std::memory_order_relaxed);
+
+  return write_allocation_header(block, size);
+}
+
+inline void* SDLCALL tracked_calloc(const std::size_t count, const std::size_t size)
+{
+  auto& tracker = get_allocation_tracker();
+
+  const auto bytes = count * size;
+  if (size != 0 && bytes / size != count) {
+    return nullptr;
+  }
+
+  void* block = tracker.base.calloc(1, bytes + allocation_header_size);
+  if (!block) {
+    return nullptr;
+  }
+
+  record_growth(tracker, bytes);
+  tracker.live_allocations.fetch_add(1, std::memory_order_relaxed);
+  tracker.total_allocations.fetch_add(1, std::memory_order_relaxed);
+
+  return write_allocation_header(block, bytes);
+}
+
+inline void* SDLCALL tracked_realloc(void* memory, const std::size_t size)
+{
+  if (!memory) {
+    return tracked_malloc(size);
+  }
+
+  auto& tracker = get_allocation_tracker();
+
+  void* header = allocation_header(memory);
+  const auto previous = allocation_size(header);
+
+  void* block = tracker.base.realloc(header, size + allocation_header_size);
+  if (!block) {
+    return nullptr; /* The original block is still valid */
+  }
+
+  tracker.live_bytes.fetch_sub(previous, std::memory_order_relaxed);
+  record_growth(tracker, size);
+  tracker.total_allocations.fetch_add(1, std::memory_order_relaxed);
+
+  return write_allocation_header(block, size);
+}
+
+inline void SDLCALL tracked_free(void* memory)
+{
+  if (!memory) {
+    return;
+  }
+
+  auto& tracker = get_allocation_tracker();
+
+  void* header = allocation_header(memory);
+  tracker.live_bytes.fetch_sub(allocation_size(header), std::memory_order_relaxed);
+  tracker.live_allocations.fetch_sub(1, std::memory_order_relaxed);
+  tracker.total_frees.fetch_add(1, std::memory_order_relaxed);
+
+  tracker.base.free(header);
+}
+
+}  // namespace detail
+
+/**
+ * Returns the memory functions currently used by SDL.
+ *
+ * \return the current memory functions.
+ */
+[[nodiscard]] inline auto current_memory_functions() noexcept -> memory_functions
+{
+  memory_functions functions;
+  SDL_GetMemoryFunctions(&functions.malloc,
+                         &functions.calloc,
+                         &functions.realloc,
+                         &functions.free);
+  return functions;
+}
+
+/**
+ * Makes SDL use the specified memory functions.
+ *
+ * This function must be called before any other SDL function, since memory allocated with the
+ * previous functions would otherwise be released with the new ones. As such, the function
+ * fails if SDL has any live allocations.
+ *
+ * \param functions the memory functions that will be used, none of which may be null.
+ *
+ * \return `success` if the memory functions were changed; `failure` otherwise.
+ */
+inline auto set_memory_functions(const memory_functions& functions) noexcept -> result
+{
+  if (!functions.malloc || !functions.calloc || !functions.realloc || !functions.free) {
+    return failure;
+  }
+
+  if (SDL_GetNumAllocations() != 0) {
+    return failure;
+  }
+
+  return SDL_SetMemoryFunctions(functions.malloc,
+                                functions.calloc,
+                                functions.realloc,
+                                functions.free) == 0;
+}
+
+/**
+ * Starts tracking all memory allocated by SDL and its extension libraries.
+ *
+ * The tracking functions forward all requests to the supplied allocator, or to the memory
+ * functions currently used by SDL by default, and record the amount of allocated memory. Each
+ * allocation is padded with a small header that stores its size.
+ *
+ * This function must be called before any other SDL function, see `set_memory_functions()`.
+ * It's usually easiest to enable the tracking through `sdl_cfg::track_allocations`. Once
+ * enabled, the tracking cannot be disabled, since memory allocated by SDL may outlive any
+ * Centurion object.
+ *
+ * \param allocator the memory functions that the tracking functions forward to.
+ *
+ * \return `success` if the tracking was enabled or was already enabled; `failure` otherwise.
+ *
+ * \see allocation_statistics()
+ */
+inline auto enable_allocation_tracking(const memory_functions& allocator =
+                                           current_memory_functions()) noexcept -> result
+{
+  auto& tracker = detail::get_allocation_tracker();
+
+  if (tracker.installed.load()) {
+    return success;
+  }
+
+  if (!allocator.malloc || !allocator.calloc || !allocator.realloc || !allocator.free) {
+    return failure;
+  }
+
+  tracker.base = allocator;
+
+  const auto res = set_memory_functions({detail::tracked_malloc,
+                                         detail::tracked_calloc,
+                                         detail::tracked_realloc,
+                                         detail::tracked_free});
+  tracker.installed.store(static_cast<bool>(res));
+
+  return res;
+}
+
+/**
+ * Indicates whether allocation tracking is enabled.
+ *
+ * \return `true` if the allocations made by SDL are tracked; `false` otherwise.
+ */
+[[nodiscard]] inline auto is_tracking_allocations() noexcept -> bool
+{
+  return detail::get_allocation_tracker().installed.load();
+}
+
+/**
+ * Returns statistics about the memory allocated by SDL and its extension libraries.
+ *
+ * The statistics are only updated if allocation tracking is enabled, and the individual values
+ * are sampled independently.
+ *
+ * \return the current allocation statistics.
+ *
+ * \see enable_allocation_tracking()
+ */
+[[nodiscard]] inline auto allocation_statistics() noexcept -> allocation_stats
+{
+  const auto& tracker = detail::get_allocation_tracker();
+
+  allocation_stats stats;
+  stats.live_bytes = tracker.live_bytes.load(std::memory_order_relaxed);
+  stats.peak_bytes = tracker.peak_bytes.load(std::memory_order_relaxed);
+  stats.live_allocations = tracker.live_allocations.load(std::memory_order_relaxed);
+  stats.total_allocations = tracker.total_allocations.load(std::memory_order_relaxed);
+  stats.total_frees = tracker.total_frees.load(std::memory_order_relaxed);
+
+  return stats;
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_COMMON_ALLOCATION_TRACKING_HPP_
@@ -0,0 +1,277 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_ASYNC_LOGGING_HPP_
+#define CENTURION_ASYNC_LOGGING_HPP_
+
+#include <SDL.h>
+
+#include <array>        // array
+#include <atomic>       // atomic
+#include <cstring>      // strlen, memcpy
+#include <string_view>  // string_view
+
+#include "../concurrency/lock_free_queue.hpp"
+#include "../concurrency/thread.hpp"
+#include "../detail/stdlib.hpp"
+#include "errors.hpp"
+#include "logging.hpp"
+#include "primitives.hpp"
+#include "utils.hpp"
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// Determines what happens to messages that are logged while an async log sink is full.
+enum class log_overflow_policy {
+  drop,  ///< Discard the message and count it as dropped.
+  block  ///< Wait for the background thread to free a slot.
+};
+
+[[nodiscard]] constexpr auto to_string(const log_overflow_policy policy) -> std::string_view
+{
+  switch (policy) {
+    case log_overflow_policy::drop:
+      return "drop";
+
+    case log_overflow_policy::block:
+      return "block";
+
+    default:
+      throw exception {"Did not recognize log overflow policy!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const log_overflow_policy policy)
+    -> std::ostream&
+{
+  return stream << to_string(policy);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/// The size of the message buffers of async log sinks, longer messages are truncated.
+inline constexpr usize async_log_message_size = 512;
+
+/**
+ * Moves the output of all log messages to a background thread.
+ *
+ * SDL still formats messages on the calling thread, but the sink replaces the SDL log output
+ * function, so the caller only copies the formatted message into a preallocated lock-free
+ * ring buffer. A background thread drains the buffer and forwards each message to the output
+ * function that was installed when the sink was created, which is usually the SDL default
+ * that writes to the console. The previous output function is restored when the sink is
+ * destroyed, after all accepted messages have been written.
+ *
+ * Messages logged from the background thread itself, e.g. by a custom output function, are
+ * written directly to avoid deadlocks. Only one sink should exist at a time, since the output
+ * function is global, and it should outlive all logging threads other than the main thread.
+ */
+class async_log_sink final {
+ public:
+  /**
+   * Creates an async log sink and starts its background thread.
+   *
+   * \param policy the behavior when the buffer is full.
+   * \param capacity the maximum amount of buffered messages, rounded up to a power of two.
+   *
+   * \throws sdl_error if the background thread or the semaphores cannot be created.
+   */
+  CENTURION_NODISCARD_CTOR explicit async_log_sink(
+      const log_overflow_policy policy = log_overflow_policy::drop,
+      const usize capacity = 1024)
+      : mQueue {capacity}
+      , mPolicy {policy}
+      , mThread {&async_log_sink::run, "async_log_sink", this}
+  {
+    SDL_LogGetOutputFunction(&mOutput, &mOutputData);
+    SDL_LogSetOutputFunction(&async_log_sink::on_log, this);
+  }
+
+  CENTURION_DISABLE_COPY(async_log_sink)
+  CENTURION_DISABLE_MOVE(async_log_sink)
+
+  ~async_log_sink() noexcept
+  {
+    SDL_LogSetOutputFunction(mOutput, mOutputData);
+
+    /* Wait for callers that obtained the output function before it was restored */
+    while (mProducers.load(std::memory_order_acquire) != 0) {
+      thread::sleep(u32ms {1});
+    }
+
+    mRunning.store(false, std::memory_order_release);
+    mThread.join();
+  }
+
+  /// Blocks until all messages accepted so far have been written.
+  void flush() noexcept
+  {
+    const auto target = mAccepted.load(std::memory_order_acquire);
+    while (mWritten.load(std::memory_order_acquire) < target) {
+      thread::sleep(u32ms {1});
+    }
+  }
+
+  /// Returns the total amount of messages that were discarded because the buffer was full.
+  [[nodiscard]] auto dropped() const noexcept -> usize
+  {
+    usize total {};
+
+    for (const auto& count : mDropped) {
+      total += count.load(std::memory_order_relaxed);
+    }
+
+    return total;
+  }
+
+  /// Returns the amount of discarded messages with a specific priority.
+  [[nodiscard]] auto dropped(const log_priority priority) const noexcept -> usize
+  {
+    return mDropped[index_of(priority)].load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of messages that have been written by the background thread.
+  [[nodiscard]] auto written() const noexcept -> usize
+  {
+    return mWritten.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the approximate amount of messages waiting to be written.
+  [[nodiscard]] auto pending() const noexcept -> usize { return mQueue.size(); }
+
+  /// Resets the drop counters.
+  void reset_dropped() noexcept
+  {
+    for (auto& count : mDropped) {
+      count.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  [[nodiscard]] auto policy() const noexcept -> log_overflow_policy { return mPolicy; }
+
+  [[nodiscard]] auto capacity() const noexcept -> usize { return mQueue.capacity(); }
+
+ private:
+  struct log_record final {
+    int category {};
+    SDL_LogPriority priority {};
+    std::array<char, async_log_message_size> text {};
+  };
+
+  inline static constexpr usize priority_count = SDL_NUM_LOG_PRIORITIES;
+
+  blocking_mpmc_queue<log_record> mQueue;
+  SDL_LogOutputFunction mOutput {};
+  void* mOutputData {};
+  std::array<std::atomic<usize>, priority_count> mDropped {};
+  std::atomic<usize> mAccepted {0};
+  std::atomic<usize> mWritten {0};
+  std::atomic<usize> mProducers {0};
+  std::atomic<thread_id> mWorker {0};
+  std::atomic<bool> mRunning {true};
+  log_overflow_policy mPolicy;
+  thread mThread;  ///< Must be the last member, so that it starts after initialization.
+
+  [[nodiscard]] static auto index_of(const log_priority priority) noexcept -> usize
+  {
+    return (detail::min)(static_cast<usize>(to_underlying(priority)), priority_count - 1u);
+  }
+
+  void write(const int category, const SDL_LogPriority priority, const char* message)
+  {
+    if (mOutput) {
+      mOutput(mOutputData, category, priority, message);
+    }
+  }
+
+  static void SDLCALL on_log(void* data,
+                             const int category,
+                             const SDL_LogPriority priority,
+                             const char* message) noexcept
+  {
+    auto* self = static_cast<async_log_sink*>(data);
+
+    if (thread::current_id() == self->mWorker.load(std::memory_order_relaxed)) {
+      self->write(category, priority, message);
+      return;
+    }
+
+    self->mProducers.fetch_add(1, std::memory_order_acq_rel);
+
+    log_record record;
+    record.category = category;
+    record.priority = priority;
+
+    const auto length = (detail::min)(std::strlen(message), record.text.size() - 1u);
+    std::memcpy(record.text.data(), message, length);
+    record.text[length] = '\0';
+
+    bool accepted {};
+    if (self->mPolicy == log_overflow_policy::block) {
+      accepted = static_cast<bool>(self->mQueue.push(record));
+    }
+    else {
+      accepted = self->mQueue.try_push(record);
+    }
+
+    if (accepted) {
+      self->mAccepted.fetch_add(1, std::memory_order_release);
+    }
+    else {
+      const auto index = index_of(static_cast<log_priority>(priority));
+      self->mDropped[index].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    self->mProducers.fetch_sub(1, std::memory_order_acq_rel);
+  }
+
+  static int SDLCALL run(void* data)
+  {
+    auto* self = static_cast<async_log_sink*>(data);
+    self->mWorker.store(thread::current_id(), std::memory_order_relaxed);
+
+    /* Keep draining after being stopped, so that no accepted message is lost */
+    while (self->mRunning.load(std::memory_order_acquire) || !self->mQueue.empty()) {
+      if (const auto record = self->mQueue.pop(u32ms {10})) {
+        self->write(record->category, record->priority, record->text.data());
+        self->mWritten.fetch_add(1, std::memory_order_release);
+      }
+    }
+
+    return 0;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_ASYNC_LOGGING_HPP_
@@ -0,0 +1,627 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_BINARY_LOGGING_HPP_
+#define CENTURION_BINARY_LOGGING_HPP_
+
+#include <SDL.h>
+
+#include <cstdint>      // uintptr_t
+#include <cstdio>       // snprintf
+#include <cstring>      // memcpy, strchr
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <type_traits>  // is_integral_v, is_signed_v, is_floating_point_v, is_pointer_v, ...
+#include <vector>       // vector
+
+#include "../concurrency/locks.hpp"
+#include "../concurrency/spin_lock.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/endian.hpp"
+#include "../system/timer.hpp"
+#include "errors.hpp"
+#include "logging.hpp"
+#include "primitives.hpp"
+#include "result.hpp"
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// Identifies a registered log format string.
+using log_format_id = uint32;
+
+/// A format string registered for binary logging, along with its call site properties.
+struct log_format final {
+  const char* format {};                      ///< The printf-style format string.
+  log_priority priority {log_priority::info};  ///< The priority of the records.
+  log_category category {log_category::app};   ///< The category of the records.
+};
+
+namespace detail {
+
+inline constexpr char binary_log_magic[4] {'C', 'L', 'O', 'G'};
+inline constexpr uint32 binary_log_version = 1;
+
+/* Every entry in a binary log starts with one of these tags */
+inline constexpr uint8 binary_log_format_tag = 'F';
+inline constexpr uint8 binary_log_record_tag = 'R';
+
+/* Every argument in a record starts with one of these tags */
+inline constexpr uint8 binary_log_signed_tag = 'i';
+inline constexpr uint8 binary_log_unsigned_tag = 'u';
+inline constexpr uint8 binary_log_float_tag = 'f';
+inline constexpr uint8 binary_log_pointer_tag = 'p';
+inline constexpr uint8 binary_log_string_tag = 's';
+
+struct log_format_registry final {
+  spin_lock lock;  ///< Only taken when formats are registered or first written.
+  std::vector<log_format> formats;
+};
+
+[[nodiscard]] inline auto get_log_format_registry() noexcept -> log_format_registry&
+{
+  static log_format_registry registry;
+  return registry;
+}
+
+template <typename T>
+void append_little_endian(std::vector<uint8>& buffer, const T value)
+{
+  const auto swapped = swap_little_endian(value);
+
+  const auto offset = buffer.size();
+  buffer.resize(offset + sizeof swapped);
+  std::memcpy(buffer.data() + offset, &swapped, sizeof swapped);
+}
+
+inline void append_log_string(std::vector<uint8>& buffer, const std::string_view str)
+{
+  const auto size = static_cast<uint32>(str.size());
+  buffer.push_back(binary_log_string_tag);
+  append_little_endian(buffer, size);
+  buffer.insert(buffer.end(), str.begin(), str.end());
+}
+
+template <typename T>
+void append_log_arg(std::vector<uint8>& buffer, const T& value)
+{
+  if constexpr (std::is_same_v<T, bool>) {
+    buffer.push_back(binary_log_unsigned_tag);
+    append_little_endian(buffer, static_cast<uint64>(value));
+  }
+  else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+    buffer.push_back(binary_log_signed_tag);
+    append_little_endian(buffer, static_cast<uint64>(static_cast<int64>(value)));
+  }
+  else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+    buffer.push_back(binary_log_unsigned_tag);
+    append_little_endian(buffer, static_cast<uint64>(value));
+  }
+  else if constexpr (std::is_floating_point_v<T>) {
+    const auto real = static_cast<double>(value);
+
+    uint64 bits {};
+    std::memcpy(&bits, &real, sizeof bits);
+
+    buffer.push_back(binary_log_float_tag);
+    append_little_endian(buffer, bits);
+  }
+  else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    append_log_string(buffer, std::string_view {value});
+  }
+  else if constexpr (std::is_pointer_v<T>) {
+    buffer.push_back(binary_log_pointer_tag);
+    append_little_endian(buffer, static_cast<uint64>(reinterpret_cast<std::uintptr_t>(value)));
+  }
+  else {
+    static_assert(std::is_pointer_v<T>, "Unsupported binary log argument type!");
+  }
+}
+
+/* An argument decoded from a binary log record */
+struct log_arg final {
+  uint8 tag {};
+  uint64 bits {};        ///< The raw value of numeric arguments.
+  std::string_view str;  ///< The contents of string arguments.
+};
+
+/* Reads little-endian values from a byte range, becoming empty when the range is exhausted */
+class binary_log_cursor final {
+ public:
+  binary_log_cursor(const uint8* data, const usize size) noexcept
+      : mData {data}
+      , mSize {size}
+  {}
+
+  template <typename T>
+  [[nodiscard]] auto read(T& value) noexcept -> bool
+  {
+    if (mSize - mOffset < sizeof value) {
+      return false;
+    }
+
+    std::memcpy(&value, mData + mOffset, sizeof value);
+    mOffset += sizeof value;
+
+    if constexpr (sizeof value > 1) {
+      value = swap_little_endian(value);
+    }
+
+    return true;
+  }
+
+  [[nodiscard]] auto read(std::string_view& str, const usize size) noexcept -> bool
+  {
+    if (mSize - mOffset < size) {
+      return false;
+    }
+
+    str = std::string_view {reinterpret_cast<const char*>(mData + mOffset), size};
+    mOffset += size;
+
+    return true;
+  }
+
+  [[nodiscard]] auto exhausted() const noexcept -> bool { return mOffset == mSize; }
+
+  [[nodiscard]] auto offset() const noexcept -> usize { return mOffset; }
+
+ private:
+  const uint8* mData {};
+  usize mSize {};
+  usize mOffset {};
+};
+
+/* Formats a single value with a printf-style specification */
+template <typename T>
+void append_formatted(std::string& result, const std::string& spec, const T value)
+{
+  const auto length = std::snprintf(nullptr, 0, spec.c_str(), value);
+  if (length > 0) {
+    const auto offset = result.size();
+    result.resize(offset + static_cast<usize>(length) + 1u);
+    const auto size = static_cast<usize>(length) + 1u;
+    std::snprintf(result.data() + offset, size, spec.c_str(), value);
+    result.pop_back();
+  }
+}
+
+[[nodiscard]] inline auto log_arg_as_double(const log_arg& arg) noexcept -> double
+{
+  if (arg.tag == binary_log_float_tag) {
+    double value {};
+    std::memcpy(&value, &arg.bits, sizeof value);
+    return value;
+  }
+  else if (arg.tag == binary_log_signed_tag) {
+    return static_cast<double>(static_cast<int64>(arg.bits));
+  }
+  else {
+    return static_cast<double>(arg.bits);
+  }
+}
+
+inline void append_log_arg_text(std::string& result,
+                                std::string spec,
+                                const char conversion,
+                                const log_arg& arg)
+{
+  if (arg.tag == binary_log_string_tag) {
+    spec += 's';
+    append_formatted(result, spec, std::string {arg.str}.c_str());
+  }
+  else if (std::strchr("fFeEgGaA", conversion)) {
+    spec += conversion;
+    append_formatted(result, spec, log_arg_as_double(arg));
+  }
+  else if (conversion == 'p') {
+    spec += 'p';
+    const auto address = static_cast<std::uintptr_t>(arg.bits);
+    append_formatted(result, spec, reinterpret_cast<void*>(address));
+  }
+  else if (conversion == 'c') {
+    spec += 'c';
+    append_formatted(result, spec, static_cast<int>(arg.bits));
+  }
+  else {
+    const auto integer = (arg.tag == binary_log_float_tag)
+                             ? static_cast<uint64>(static_cast<int64>(log_arg_as_double(arg)))
+                             : arg.bits;
+
+    /* Numbers passed to string conversions are printed as signed integers */
+    if (std::strchr("ouxX", conversion)) {
+      spec += "ll";
+      spec += conversion;
+      append_formatted(result, spec, static_cast<ulonglong>(integer));
+    }
+    else {
+      spec += "lld";
+      append_formatted(result, spec, static_cast<long long>(static_cast<int64>(integer)));
+    }
+  }
+}
+
+/* Expands a format string with decoded arguments, length modifiers are ignored since the
+   argument types are stored in the record. Missing arguments are rendered as "<?>" */
+[[nodiscard]] inline auto format_log_message(const char* fmt, const std::vector<log_arg>& args)
+    -> std::string
+{
+  std::string result;
+  usize next {};
+
+  for (auto it = fmt; *it != '\0'; ++it) {
+    if (*it != '%') {
+      result += *it;
+      continue;
+    }
+
+    ++it;
+    if (*it == '%') {
+      result += '%';
+      continue;
+    }
+
+    std::string spec {'%'};
+    while (*it != '\0' && std::strchr("-+ #0123456789.", *it)) {
+      spec += *it++;
+    }
+
+    while (*it != '\0' && std::strchr("hlLqjzt", *it)) {
+      ++it;
+    }
+
+    if (*it == '\0') {
+      break;
+    }
+
+    if (next < args.size()) {
+      append_log_arg_text(result, spec, *it, args[next++]);
+    }
+    else {
+      result += "<?>";
+    }
+  }
+
+  return result;
+}
+
+}  // namespace detail
+
+/**
+ * Registers a format string for binary logging.
+ *
+ * \details Call sites usually register their format string once, through a static local
+ * variable, see `CENTURION_LOG_BINARY`.
+ *
+ * \param priority the priority of the records that use the format.
+ * \param category the category of the records that use the format.
+ * \param fmt the printf-style format string, which must outlive all binary log writers.
+ *
+ * \return the identifier of the format.
+ */
+inline auto register_log_format(const log_priority priority,
+                                const log_category category,
+                                const char* fmt) -> log_format_id
+{
+  auto& registry = detail::get_log_format_registry();
+  scoped_lock lock {registry.lock};
+
+  registry.formats.push_back({fmt, priority, category});
+  return static_cast<log_format_id>(registry.formats.size() - 1u);
+}
+
+/// Returns a registered log format, or nothing if the identifier is invalid.
+[[nodiscard]] inline auto get_log_format(const log_format_id id) -> maybe<log_format>
+{
+  auto& registry = detail::get_log_format_registry();
+  scoped_lock lock {registry.lock};
+
+  if (id < registry.formats.size()) {
+    return registry.formats[id];
+  }
+  else {
+    return nothing;
+  }
+}
+
+/**
+ * Encodes log records in a compact binary format.
+ *
+ * Instead of formatting messages, a record stores the identifier of a registered format
+ * string, a high-performance counter timestamp and the raw bytes of the arguments. The format
+ * strings themselves are embedded in the stream the first time they are used, so that the
+ * stream can be expanded offline with `decode_binary_log()`.
+ *
+ * The records are accumulated in an internal buffer that should be flushed periodically.
+ * All flushed buffers of a writer form a single stream. Writers are not thread-safe, so use
+ * one writer per thread or guard it with a lock.
+ */
+class binary_log_writer final {
+ public:
+  /**
+   * Creates a binary log writer.
+   *
+   * \param capacity the initial capacity of the record buffer, in bytes.
+   */
+  explicit binary_log_writer(const usize capacity = 4096)
+  {
+    mBuffer.reserve(capacity);
+
+    mBuffer.insert(mBuffer.end(),
+                   std::begin(detail::binary_log_magic),
+                   std::end(detail::binary_log_magic));
+    detail::append_little_endian(mBuffer, detail::binary_log_version);
+    detail::append_little_endian(mBuffer, frequency());
+  }
+
+  /**
+   * Appends a record to the buffer.
+   *
+   * \param id the identifier of a registered format.
+   * \param args the arguments, which can be arithmetic values, enumerators, pointers or
+   * strings.
+   *
+   * \throws exception if the format identifier is invalid.
+   */
+  template <typename... Args>
+  void write(const log_format_id id, const Args&... args)
+  {
+    if (id >= mDefined.size() || !mDefined[id]) {
+      define(id);
+    }
+
+    mBuffer.push_back(detail::binary_log_record_tag);
+    detail::append_little_endian(mBuffer, id);
+    detail::append_little_endian(mBuffer, now());
+
+    const auto sizeOffset = mBuffer.size();
+    detail::append_little_endian(mBuffer, uint32 {0});
+
+    (detail::append_log_arg(mBuffer, args), ...);
+
+    const auto size = swap_little_endian(
+        static_cast<uint32>(mBuffer.size() - sizeOffset - sizeof(uint32)));
+    std::memcpy(mBuffer.data() + sizeOffset, &size, sizeof size);
+  }
+
+#ifndef CENTURION_NO_IOSTREAM
+
+  /**
+   * Writes the buffered bytes to a stream and clears the buffer.
+   *
+   * \param stream the output stream, which should be opened in binary mode.
+   *
+   * \return `success` if the bytes were written; `failure` otherwise.
+   */
+  auto flush(std::ostream& stream) -> result
+  {
+    stream.write(reinterpret_cast<const char*>(mBuffer.data()),
+                 static_cast<std::streamsize>(mBuffer.size()));
+    clear();
+    return stream.good();
+  }
+
+#endif  // CENTURION_NO_IOSTREAM
+
+  /// Discards the buffered bytes, the stream continues with the next record.
+  void clear() noexcept { mBuffer.clear(); }
+
+  [[nodiscard]] auto data() const noexcept -> const uint8* { return mBuffer.data(); }
+
+  /// Returns the amount of buffered bytes.
+  [[nodiscard]] auto size() const noexcept -> usize { return mBuffer.size(); }
+
+ private:
+  std::vector<uint8> mBuffer;
+  std::vector<bool> mDefined;  ///< Indicates which formats have been embedded in the stream.
+
+  void define(const log_format_id id)
+  {
+    const auto format = get_log_format(id);
+    if (!format) {
+      throw exception {"Invalid log format identifier!"};
+    }
+
+    if (id >= mDefined.size()) {
+      mDefined.resize(id + 1u);
+    }
+
+    mDefined[id] = true;
+
+    mBuffer.push_back(detail::binary_log_format_tag);
+    detail::append_little_endian(mBuffer, id);
+    mBuffer.push_back(static_cast<uint8>(format->priority));
+    detail::append_little_endian(mBuffer, static_cast<uint32>(format->category));
+    detail::append_log_string(mBuffer, format->format);
+  }
+};
+
+#ifndef CENTURION_NO_IOSTREAM
+
+/**
+ * Expands a binary log stream into text, with one line per record.
+ *
+ * \details Each line contains the timestamp in seconds, the category, the priority and the
+ * formatted message, e.g. `[1.250000] app info: Loaded 42 textures`.
+ *
+ * \param data the bytes of the stream.
+ * \param size the amount of bytes.
+ * \param stream the output stream for the decoded records.
+ *
+ * \return `success` if the whole stream was decoded; `failure` if it is malformed.
+ */
+inline auto decode_binary_log(const uint8* data, const usize size, std::ostream& stream)
+    -> result
+{
+  detail::binary_log_cursor cursor {data, size};
+
+  std::string_view magic;
+  uint32 version {};
+  uint64 freq {};
+  if (!cursor.read(magic, sizeof detail::binary_log_magic) ||
+      magic != std::string_view {detail::binary_log_magic, sizeof detail::binary_log_magic} ||
+      !cursor.read(version) || version != detail::binary_log_version || !cursor.read(freq) ||
+      freq == 0) {
+    return failure;
+  }
+
+  struct definition final {
+    std::string format;
+    log_priority priority {};
+    log_category category {};
+    bool valid {};
+  };
+
+  std::vector<definition> formats;
+  std::vector<detail::log_arg> args;
+
+  while (!cursor.exhausted()) {
+    uint8 tag {};
+    log_format_id id {};
+    if (!cursor.read(tag) || !cursor.read(id)) {
+      return failure;
+    }
+
+    if (tag == detail::binary_log_format_tag) {
+      uint8 priority {};
+      uint32 category {};
+      uint8 strTag {};
+      uint32 length {};
+      std::string_view format;
+      if (!cursor.read(priority) || !cursor.read(category) || !cursor.read(strTag) ||
+          !cursor.read(length) || !cursor.read(format, length)) {
+        return failure;
+      }
+
+      if (id >= formats.size()) {
+        formats.resize(id + 1u);
+      }
+
+      formats[id] = {std::string {format},
+                     static_cast<log_priority>(priority),
+                     static_cast<log_category>(category),
+                     true};
+    }
+    else if (tag == detail::binary_log_record_tag) {
+      uint64 timestamp {};
+      uint32 payload {};
+      if (!cursor.read(timestamp) || !cursor.read(payload) || id >= formats.size() ||
+          !formats[id].valid) {
+        return failure;
+      }
+
+      const auto end = cursor.offset() + payload;
+
+      args.clear();
+      while (cursor.offset() < end) {
+        detail::log_arg arg;
+        if (!cursor.read(arg.tag)) {
+          return failure;
+        }
+
+        bool ok {};
+        if (arg.tag == detail::binary_log_string_tag) {
+          uint32 length {};
+          ok = cursor.read(length) && cursor.read(arg.str, length);
+        }
+        else {
+          ok = cursor.read(arg.bits);
+        }
+
+        if (!ok) {
+          return failure;
+        }
+
+        args.push_back(arg);
+      }
+
+      const auto& format = formats[id];
+      char time[32] {};
+      std::snprintf(time,
+                    sizeof time,
+                    "%.6f",
+                    static_cast<double>(timestamp) / static_cast<double>(freq));
+
+      stream << '[' << time << "] " << format.category << ' ' << format.priority << ": "
+             << detail::format_log_message(format.format.c_str(), args) << '\n';
+    }
+    else {
+      return failure;
+    }
+  }
+
+  return stream.good();
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+/**
+ * Appends a binary log record, registering the format string on first use.
+ *
+ * \details The record is skipped if the priority is disabled, see `is_log_enabled()`. The
+ * priority and category are the names of `log_priority` and `log_category` enumerators.
+ */
+#if CENTURION_HAS_FEATURE_CPP20
+
+#define CENTURION_LOG_BINARY(writer, priority, category, fmt, ...)     \
+  do {                                                                 \
+    if constexpr (cen::is_log_compiled(cen::log_priority::priority)) { \
+      if (cen::is_log_enabled(cen::log_category::category,             \
+                              cen::log_priority::priority)) {          \
+        static const auto cen_log_format_id =                          \
+            cen::register_log_format(cen::log_priority::priority,      \
+                                     cen::log_category::category,      \
+                                     fmt);                             \
+        (writer).write(cen_log_format_id __VA_OPT__(, ) __VA_ARGS__);  \
+      }                                                                \
+    }                                                                  \
+  } while (false)
+
+#else
+
+#define CENTURION_LOG_BINARY(writer, priority, category, fmt, ...)     \
+  do {                                                                 \
+    if constexpr (cen::is_log_compiled(cen::log_priority::priority)) { \
+      if (cen::is_log_enabled(cen::log_category::category,             \
+                              cen::log_priority::priority)) {          \
+        static const auto cen_log_format_id =                          \
+            cen::register_log_format(cen::log_priority::priority,      \
+                                     cen::log_category::category,      \
+                                     fmt);                             \
+        (writer).write(cen_log_format_id, __VA_ARGS__);                \
+      }                                                                \
+    }                                                                  \
+  } while (false)
+
+#endif  // CENTURION_HAS_FEATURE_CPP20
+
+#endif  // CENTURION_BINARY_LOGGING_HPP_
@@ -0,0 +1,243 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_COMMON_FORMATTING_HPP_
+#define CENTURION_COMMON_FORMATTING_HPP_
+
+#include <array>        // array
+#include <charconv>     // to_chars
+#include <cstddef>      // ptrdiff_t
+#include <cstdio>       // snprintf
+#include <iterator>     // output_iterator_tag
+#include <limits>       // numeric_limits
+#include <string_view>  // string_view
+#include <type_traits>  // is_floating_point_v
+
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "primitives.hpp"
+#include "traits.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format_to, format_parse_context
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+namespace cen {
+
+/**
+ * An output iterator that writes into a fixed-size character buffer.
+ *
+ * Characters that do not fit in the buffer are silently discarded, which makes it possible to
+ * format values into stack buffers without allocating.
+ */
+class truncating_iterator final {
+ public:
+  using iterator_category = std::output_iterator_tag;
+  using value_type = void;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = void;
+
+  constexpr truncating_iterator() noexcept = default;
+
+  constexpr truncating_iterator(char* begin, char* end) noexcept
+      : mCurrent {begin}
+      , mEnd {end}
+  {}
+
+  constexpr auto operator=(const char c) noexcept -> truncating_iterator&
+  {
+    if (mCurrent != mEnd) {
+      *mCurrent = c;
+    }
+
+    return *this;
+  }
+
+  constexpr auto operator*() noexcept -> truncating_iterator& { return *this; }
+
+  constexpr auto operator++() noexcept -> truncating_iterator&
+  {
+    if (mCurrent != mEnd) {
+      ++mCurrent;
+    }
+
+    return *this;
+  }
+
+  constexpr auto operator++(int) noexcept -> truncating_iterator
+  {
+    auto copy = *this;
+    ++(*this);
+    return copy;
+  }
+
+  /// Returns a pointer to the position after the last written character.
+  [[nodiscard]] constexpr auto current() const noexcept -> char* { return mCurrent; }
+
+ private:
+  char* mCurrent {};
+  char* mEnd {};
+};
+
+/**
+ * Formats a value into a fixed-size buffer, without allocating.
+ *
+ * The output is truncated if it does not fit in the buffer, and is always null-terminated.
+ * This works with any type that provides a `format_to()` overload, e.g. rectangles and colors.
+ *
+ * \param buffer the buffer that will be written to.
+ * \param size the size of the buffer, including the space for the null-terminator.
+ * \param value the value that will be formatted.
+ *
+ * \return the amount of characters that were written, excluding the null-terminator.
+ */
+template <typename T>
+auto format_to_buffer(char* buffer, const usize size, const T& value) -> usize
+{
+  if (!buffer || size == 0) {
+    return 0;
+  }
+
+  const auto end = format_to(truncating_iterator {buffer, buffer + (size - 1u)}, value);
+  *end.current() = '\0';
+
+  return static_cast<usize>(end.current() - buffer);
+}
+
+template <usize Size, typename T>
+auto format_to_buffer(char (&buffer)[Size], const T& value) -> usize
+{
+  return format_to_buffer(static_cast<char*>(buffer), Size, value);
+}
+
+template <usize Size, typename T>
+auto format_to_buffer(std::array<char, Size>& buffer, const T& value) -> usize
+{
+  return format_to_buffer(buffer.data(), Size, value);
+}
+
+namespace detail {
+
+template <typename OutputIt>
+auto write_text(OutputIt out, const std::string_view text) -> OutputIt
+{
+  for (const auto c : text) {
+    *out++ = c;
+  }
+
+  return out;
+}
+
+/* Matches the output of std::to_string, which is what to_string uses without std::format */
+template <typename OutputIt, typename T>
+auto write_number(OutputIt out, const T value) -> OutputIt
+{
+  static_assert(is_number<T>);
+
+  if constexpr (std::is_floating_point_v<T>) {
+    char buffer[std::numeric_limits<double>::max_exponent10 + 16] {};
+    const auto length = std::snprintf(buffer, sizeof buffer, "%f", static_cast<double>(value));
+
+    if (length > 0) {
+      const auto count = (detail::min)(static_cast<usize>(length), sizeof buffer - 1u);
+      out = write_text(out, std::string_view {buffer, count});
+    }
+
+    return out;
+  }
+  else {
+    char buffer[std::numeric_limits<T>::digits10 + 3] {};
+    const auto [end, error] = std::to_chars(buffer, buffer + sizeof buffer, value);
+    return write_text(out, {buffer, static_cast<usize>(end - buffer)});
+  }
+}
+
+/* Writes two upper case hexadecimal digits */
+template <typename OutputIt>
+auto write_hex(OutputIt out, const uint8 value) -> OutputIt
+{
+  constexpr std::string_view digits {"0123456789ABCDEF"};
+
+  *out++ = digits[value >> 4u];
+  *out++ = digits[value & 0xFu];
+
+  return out;
+}
+
+/// Writes the same text as address_of(), without allocating.
+template <typename OutputIt>
+auto write_address(OutputIt out, const void* ptr) -> OutputIt
+{
+  if (!ptr) {
+    return out;
+  }
+
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format_to(out, "{}", ptr);
+#else
+  if constexpr (on_msvc) {
+    out = write_text(out, "0x");  // Only MSVC seems to omit this, add it for consistency
+  }
+
+  char buffer[32] {};
+  const auto length = std::snprintf(buffer, sizeof buffer, "%p", ptr);
+
+  if (length > 0) {
+    const auto count = (detail::min)(static_cast<usize>(length), sizeof buffer - 1u);
+    out = write_text(out, std::string_view {buffer, count});
+  }
+
+  return out;
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+/* Base class of the std::formatter specializations, which forward to format_to(). Only empty
+   format specifications, i.e. "{}", are supported. */
+template <typename T>
+struct value_formatter {
+  constexpr auto parse(std::format_parse_context& context)
+      -> std::format_parse_context::iterator
+  {
+    return context.begin();
+  }
+
+  template <typename FormatContext>
+  auto format(const T& value, FormatContext& context) const ->
+      typename FormatContext::iterator
+  {
+    return format_to(context.out(), value);
+  }
+};
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+}  // namespace detail
+}  // namespace cen
+
+#endif  // CENTURION_COMMON_FORMATTING_HPP_
@@ -0,0 +1,277 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_COMMON_FRAME_ARENA_HPP_
+#define CENTURION_COMMON_FRAME_ARENA_HPP_
+
+#include <cassert>      // assert
+#include <cstddef>      // byte, max_align_t
+#include <cstdint>      // uintptr_t
+#include <memory>       // unique_ptr
+#include <new>          // new
+#include <type_traits>  // is_trivially_destructible_v
+#include <utility>      // forward
+#include <vector>       // vector
+
+#include "../concurrency/thread_local_storage.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "primitives.hpp"
+#include "utils.hpp"
+
+#if CENTURION_HAS_FEATURE_MEMORY_RESOURCE
+
+#include <memory_resource>  // memory_resource
+
+#endif  // CENTURION_HAS_FEATURE_MEMORY_RESOURCE
+
+namespace cen {
+
+/**
+ * A linear allocator for short-lived data, intended to be reset once per frame.
+ *
+ * Allocations simply bump a pointer into a preallocated block, and individual allocations are
+ * never freed. Instead, `reset()` releases all allocations at once. If a frame needs more
+ * memory than the current block holds, additional blocks are allocated, and these are merged
+ * into a single larger block on the next reset. After a few frames, the arena therefore stops
+ * touching the heap entirely.
+ *
+ * Arenas aren't thread-safe, use `frame_arena::local()` to get a separate arena per thread.
+ *
+ * \see arena_resource
+ */
+class frame_arena final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates an arena.
+   *
+   * \param blockSize the initial capacity of the arena, in bytes.
+   */
+  explicit frame_arena(const size_type blockSize = 64 * 1024) : mBlockSize {blockSize}
+  {
+    if (mBlockSize != 0) {
+      add_block(mBlockSize);
+    }
+  }
+
+  CENTURION_DISABLE_COPY(frame_arena)
+
+  frame_arena(frame_arena&&) noexcept = default;
+  auto operator=(frame_arena&&) noexcept -> frame_arena& = default;
+
+  /**
+   * Allocates uninitialized memory from the arena.
+   *
+   * \param size the size of the allocation, in bytes.
+   * \param alignment the alignment of the allocation, must be a power of two.
+   *
+   * \return a pointer to the allocated memory, valid until the next reset.
+   */
+  [[nodiscard]] auto allocate(const size_type size,
+                              const size_type alignment = alignof(std::max_align_t)) -> void*
+  {
+    assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+
+    while (mCurrent < mBlocks.size()) {
+      if (auto* ptr = try_allocate(mBlocks[mCurrent], size, alignment)) {
+        return ptr;
+      }
+
+      ++mCurrent;
+      mOffset = 0;
+    }
+
+    add_block((detail::max)(mBlockSize, size + alignment));
+    mCurrent = mBlocks.size() - 1;
+    mOffset = 0;
+
+    auto* ptr = try_allocate(mBlocks[mCurrent], size, alignment);
+    assert(ptr);
+
+    return ptr;
+  }
+
+  /**
+   * Constructs an object in the arena.
+   *
+   * The type must be trivially destructible, since no destructors are run on reset.
+   */
+  template <typename T, typename... Args>
+  [[nodiscard]] auto make(Args&&... args) -> T*
+  {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena objects are never destroyed, so they must be trivially destructible");
+    return new (allocate(sizeof(T), alignof(T))) T {std::forward<Args>(args)...};
+  }
+
+  /// Allocates uninitialized memory for an array of trivially destructible objects.
+  template <typename T>
+  [[nodiscard]] auto allocate_array(const size_type count) -> T*
+  {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena objects are never destroyed, so they must be trivially destructible");
+    return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+  }
+
+  /**
+   * Releases all allocations, usually called at the start of each frame.
+   *
+   * If the previous frame needed more than one block, the blocks are replaced by a single
+   * block that is large enough for all of them.
+   */
+  void reset()
+  {
+    mPeak = (detail::max)(mPeak, mUsed);
+
+    if (mBlocks.size() > 1) {
+      const auto total = capacity();
+      mBlocks.clear();
+      add_block(total);
+    }
+
+    mCurrent = 0;
+    mOffset = 0;
+    mUsed = 0;
+  }
+
+  /// Returns the amount of allocated bytes since the last reset, including padding.
+  [[nodiscard]] auto used() const noexcept -> size_type { return mUsed; }
+
+  /// Returns the highest amount of bytes that were used between two resets.
+  [[nodiscard]] auto peak() const noexcept -> size_type { return (detail::max)(mPeak, mUsed); }
+
+  /// Returns the total size of all blocks owned by the arena.
+  [[nodiscard]] auto capacity() const noexcept -> size_type
+  {
+    size_type total {};
+    for (const auto& block : mBlocks) {
+      total += block.size;
+    }
+
+    return total;
+  }
+
+  /// Returns the amount of blocks owned by the arena.
+  [[nodiscard]] auto block_count() const noexcept -> size_type { return mBlocks.size(); }
+
+  /**
+   * Returns an arena that is unique to the calling thread.
+   *
+   * The arena is destroyed when the thread exits, see `thread_local_storage` for the caveats
+   * that apply to threads that weren't created by SDL.
+   */
+  [[nodiscard]] static auto local() -> frame_arena&
+  {
+    static thread_local_storage<frame_arena> arenas;
+    return arenas.get();
+  }
+
+ private:
+  struct block final {
+    std::unique_ptr<std::byte[]> data;
+    size_type size {};
+  };
+
+  std::vector<block> mBlocks;
+  size_type mBlockSize {};
+  size_type mCurrent {};  ///< The index of the block that allocations are taken from.
+  size_type mOffset {};   ///< The offset of the next allocation in the current block.
+  size_type mUsed {};
+  size_type mPeak {};
+
+  void add_block(const size_type size)
+  {
+    /* The memory is intentionally left uninitialized */
+    mBlocks.push_back(block {std::unique_ptr<std::byte[]>(new std::byte[size]), size});
+  }
+
+  [[nodiscard]] auto try_allocate(block& block, const size_type size, const size_type alignment)
+      -> void*
+  {
+    const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+    const auto start = (base + mOffset + (alignment - 1)) & ~(std::uintptr_t {alignment} - 1);
+    const auto end = static_cast<size_type>(start - base) + size;
+
+    if (end > block.size) {
+      return nullptr;
+    }
+
+    mUsed += end - mOffset;
+    mOffset = end;
+
+    return reinterpret_cast<void*>(start);
+  }
+};
+
+#if CENTURION_HAS_FEATURE_MEMORY_RESOURCE
+
+/**
+ * A memory resource that allocates from a frame arena.
+ *
+ * Deallocation is a no-op, the memory is reclaimed when the arena is reset. This makes it
+ * possible to use standard containers, such as `std::pmr::vector`, for per-frame data.
+ *
+ * \see frame_arena
+ */
+class arena_resource final : public std::pmr::memory_resource {
+ public:
+  /**
+   * Creates a memory resource.
+   *
+   * \param arena the arena that memory will be obtained from, must outlive the resource.
+   */
+  explicit arena_resource(frame_arena& arena) noexcept : mArena {&arena}
+  {
+  }
+
+  [[nodiscard]] auto arena() const noexcept -> frame_arena& { return *mArena; }
+
+ private:
+  frame_arena* mArena {};
+
+  auto do_allocate(const std::size_t bytes, const std::size_t alignment) -> void* override
+  {
+    return mArena->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* /*ptr*/,
+                     const std::size_t /*bytes*/,
+                     const std::size_t /*alignment*/) override
+  {}
+
+  [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+      -> bool override
+  {
+    const auto* resource = dynamic_cast<const arena_resource*>(&other);
+    return resource && resource->mArena == mArena;
+  }
+};
+
+#endif  // CENTURION_HAS_FEATURE_MEMORY_RESOURCE
+
+}  // namespace cen
+
+#endif  // CENTURION_COMMON_FRAME_ARENA_HPP_
@@ -0,0 +1,435 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_COMMON_GEOMETRY_ARRAYS_HPP_
+#define CENTURION_COMMON_GEOMETRY_ARRAYS_HPP_
+
+#include <cassert>  // assert
+#include <vector>   // vector
+
+#include "../detail/geometry_kernels.hpp"
+#include "math.hpp"
+#include "primitives.hpp"
+#include "simd_vector.hpp"
+
+namespace cen {
+
+/**
+ * A structure-of-arrays container of points, for batch operations on many points.
+ *
+ * The coordinates are stored in separate SIMD-aligned arrays, so that the batch functions
+ * process several points at once. Use `assign()` and `copy_to()` to convert between this
+ * container and regular arrays of points.
+ *
+ * Batch tests write one byte per point to a caller-provided mask, which is 1 for points
+ * that pass the test, and return the amount of passing points.
+ *
+ * \tparam T the representation type, i.e. `int` or `float`. Only `float` arrays use the
+ *         vectorized kernels.
+ *
+ * \see basic_rect_array
+ */
+template <typename T>
+class basic_point_array final {
+ public:
+  using value_type = T;
+  using point_type = basic_point<T>;
+  using rect_type = basic_rect<T>;
+
+  basic_point_array() noexcept = default;
+
+  /// Creates an array with copies of the specified points.
+  basic_point_array(const point_type* points, const usize count) { assign(points, count); }
+
+  /**
+   * Replaces the contents of the array.
+   *
+   * \param points the points that will be copied into the array.
+   * \param count the amount of points.
+   *
+   * \throws sdl_error if the memory cannot be allocated.
+   */
+  void assign(const point_type* points, const usize count)
+  {
+    assert(!count || points);
+
+    mX.resize(count);
+    mY.resize(count);
+
+    for (usize index = 0; index < count; ++index) {
+      mX[index] = points[index].x();
+      mY[index] = points[index].y();
+    }
+  }
+
+  /**
+   * Copies the points into a regular array of points.
+   *
+   * \param out the storage for the points, which must be able to hold `size()` points.
+   */
+  void copy_to(point_type* out) const noexcept
+  {
+    assert(empty() || out);
+
+    for (usize index = 0; index < size(); ++index) {
+      out[index] = {mX[index], mY[index]};
+    }
+  }
+
+  void push_back(const point_type& point)
+  {
+    mX.push_back(point.x());
+    mY.push_back(point.y());
+  }
+
+  void set(const usize index, const point_type& point) noexcept
+  {
+    mX[index] = point.x();
+    mY[index] = point.y();
+  }
+
+  [[nodiscard]] auto get(const usize index) const noexcept -> point_type
+  {
+    return {mX[index], mY[index]};
+  }
+
+  /**
+   * Tests which points are within a region, including its borders.
+   *
+   * \param region the region that the points are tested against.
+   * \param mask the storage for the results, which must be able to hold `size()` bytes.
+   *
+   * \return the amount of points within the region.
+   */
+  auto within(const rect_type& region, uint8* mask) const noexcept -> usize
+  {
+    assert(empty() || mask);
+    return detail::within_n(mX.data(),
+                            mY.data(),
+                            size(),
+                            region.x(),
+                            region.y(),
+                            region.max_x(),
+                            region.max_y(),
+                            mask);
+  }
+
+  auto within(const rect_type& region, std::vector<uint8>& mask) const -> usize
+  {
+    mask.resize(size());
+    return within(region, mask.data());
+  }
+
+  /// Moves every point by an offset.
+  void translate(const point_type& offset) noexcept
+  {
+    detail::affine_n(mX.data(), size(), T {1}, offset.x());
+    detail::affine_n(mY.data(), size(), T {1}, offset.y());
+  }
+
+  /**
+   * Transforms every point, i.e. `point * scale + offset` for each coordinate.
+   *
+   * This can be used to convert many points between coordinate systems at once, e.g.
+   * between window and logical renderer coordinates.
+   *
+   * \param scale the per-axis scale factors.
+   * \param offset the per-axis offsets, applied after scaling.
+   */
+  void transform(const point_type& scale, const point_type& offset) noexcept
+  {
+    detail::affine_n(mX.data(), size(), scale.x(), offset.x());
+    detail::affine_n(mY.data(), size(), scale.y(), offset.y());
+  }
+
+  /// Moves every point to the nearest position within a region, including its borders.
+  void clamp(const rect_type& bounds) noexcept
+  {
+    detail::clamp_n(mX.data(), size(), bounds.x(), bounds.max_x());
+    detail::clamp_n(mY.data(), size(), bounds.y(), bounds.max_y());
+  }
+
+  void reserve(const usize capacity)
+  {
+    mX.reserve(capacity);
+    mY.reserve(capacity);
+  }
+
+  void resize(const usize size)
+  {
+    mX.resize(size);
+    mY.resize(size);
+  }
+
+  void clear() noexcept
+  {
+    mX.clear();
+    mY.clear();
+  }
+
+  [[nodiscard]] auto x() noexcept -> T* { return mX.data(); }
+  [[nodiscard]] auto x() const noexcept -> const T* { return mX.data(); }
+
+  [[nodiscard]] auto y() noexcept -> T* { return mY.data(); }
+  [[nodiscard]] auto y() const noexcept -> const T* { return mY.data(); }
+
+  [[nodiscard]] auto size() const noexcept -> usize { return mX.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mX.empty(); }
+
+ private:
+  simd_vector<T> mX;
+  simd_vector<T> mY;
+};
+
+/**
+ * A structure-of-arrays container of rectangles, for batch operations on many rectangles.
+ *
+ * The positions and sizes are stored in separate SIMD-aligned arrays, so that the batch
+ * functions process several rectangles at once. Use `assign()` and `copy_to()` to convert
+ * between this container and regular arrays of rectangles, e.g. render destinations.
+ *
+ * Batch tests write one byte per rectangle to a caller-provided mask, which is 1 for
+ * rectangles that pass the test, and return the amount of passing rectangles. The tests
+ * match the semantics of `intersects()` and `basic_rect::contains()`.
+ *
+ * \tparam T the representation type, i.e. `int` or `float`. Only `float` arrays use the
+ *         vectorized kernels.
+ *
+ * \see basic_point_array
+ */
+template <typename T>
+class basic_rect_array final {
+ public:
+  using value_type = T;
+  using point_type = basic_point<T>;
+  using rect_type = basic_rect<T>;
+
+  basic_rect_array() noexcept = default;
+
+  /// Creates an array with copies of the specified rectangles.
+  basic_rect_array(const rect_type* rects, const usize count) { assign(rects, count); }
+
+  /**
+   * Replaces the contents of the array.
+   *
+   * \param rects the rectangles that will be copied into the array.
+   * \param count the amount of rectangles.
+   *
+   * \throws sdl_error if the memory cannot be allocated.
+   */
+  void assign(const rect_type* rects, const usize count)
+  {
+    assert(!count || rects);
+
+    resize(count);
+
+    for (usize index = 0; index < count; ++index) {
+      set(index, rects[index]);
+    }
+  }
+
+  /**
+   * Copies the rectangles into a regular array of rectangles.
+   *
+   * \param out the storage for the rectangles, which must be able to hold `size()`
+   *        rectangles.
+   */
+  void copy_to(rect_type* out) const noexcept
+  {
+    assert(empty() || out);
+
+    for (usize index = 0; index < size(); ++index) {
+      out[index] = get(index);
+    }
+  }
+
+  void push_back(const rect_type& rect)
+  {
+    mX.push_back(rect.x());
+    mY.push_back(rect.y());
+    mWidth.push_back(rect.width());
+    mHeight.push_back(rect.height());
+  }
+
+  void set(const usize index, const rect_type& rect) noexcept
+  {
+    mX[index] = rect.x();
+    mY[index] = rect.y();
+    mWidth[index] = rect.width();
+    mHeight[index] = rect.height();
+  }
+
+  [[nodiscard]] auto get(const usize index) const noexcept -> rect_type
+  {
+    return {mX[index], mY[index], mWidth[index], mHeight[index]};
+  }
+
+  /**
+   * Tests which rectangles intersect a region.
+   *
+   * \param region the region that the rectangles are tested against.
+   * \param mask the storage for the results, which must be able to hold `size()` bytes.
+   *
+   * \return the amount of rectangles that intersect the region.
+   */
+  auto intersects(const rect_type& region, uint8* mask) const noexcept -> usize
+  {
+    assert(empty() || mask);
+    return detail::intersects_n(mX.data(),
+                                mY.data(),
+                                mWidth.data(),
+                                mHeight.data(),
+                                size(),
+                                region.x(),
+                                region.y(),
+                                region.max_x(),
+                                region.max_y(),
+                                mask);
+  }
+
+  auto intersects(const rect_type& region, std::vector<uint8>& mask) const -> usize
+  {
+    mask.resize(size());
+    return intersects(region, mask.data());
+  }
+
+  /**
+   * Tests which rectangles contain a point, including their borders.
+   *
+   * \param point the point that the rectangles are tested against.
+   * \param mask the storage for the results, which must be able to hold `size()` bytes.
+   *
+   * \return the amount of rectangles that contain the point.
+   */
+  auto contains(const point_type& point, uint8* mask) const noexcept -> usize
+  {
+    assert(empty() || mask);
+    return detail::contains_n(mX.data(),
+                              mY.data(),
+                              mWidth.data(),
+                              mHeight.data(),
+                              size(),
+                              point.x(),
+                              point.y(),
+                              mask);
+  }
+
+  auto contains(const point_type& point, std::vector<uint8>& mask) const -> usize
+  {
+    mask.resize(size());
+    return contains(point, mask.data());
+  }
+
+  /// Moves every rectangle by an offset.
+  void translate(const point_type& offset) noexcept
+  {
+    detail::affine_n(mX.data(), size(), T {1}, offset.x());
+    detail::affine_n(mY.data(), size(), T {1}, offset.y());
+  }
+
+  /**
+   * Transforms every rectangle, i.e. `position * scale + offset` and `size * scale`.
+   *
+   * \param scale the per-axis scale factors, which should not be negative.
+   * \param offset the per-axis offsets, applied after scaling.
+   */
+  void transform(const point_type& scale, const point_type& offset) noexcept
+  {
+    detail::affine_n(mX.data(), size(), scale.x(), offset.x());
+    detail::affine_n(mY.data(), size(), scale.y(), offset.y());
+    detail::affine_n(mWidth.data(), size(), scale.x(), T {0});
+    detail::affine_n(mHeight.data(), size(), scale.y(), T {0});
+  }
+
+  /**
+   * Clips every rectangle to a region.
+   *
+   * Rectangles outside of the region end up at the nearest region border, with a size of
+   * zero in the axis that doesn't overlap.
+   *
+   * \param bounds the region that the rectangles are clipped to.
+   */
+  void clamp(const rect_type& bounds) noexcept
+  {
+    detail::clip_n(mX.data(), mWidth.data(), size(), bounds.x(), bounds.max_x());
+    detail::clip_n(mY.data(), mHeight.data(), size(), bounds.y(), bounds.max_y());
+  }
+
+  void reserve(const usize capacity)
+  {
+    mX.reserve(capacity);
+    mY.reserve(capacity);
+    mWidth.reserve(capacity);
+    mHeight.reserve(capacity);
+  }
+
+  void resize(const usize size)
+  {
+    mX.resize(size);
+    mY.resize(size);
+    mWidth.resize(size);
+    mHeight.resize(size);
+  }
+
+  void clear() noexcept
+  {
+    mX.clear();
+    mY.clear();
+    mWidth.clear();
+    mHeight.clear();
+  }
+
+  [[nodiscard]] auto x() noexcept -> T* { return mX.data(); }
+  [[nodiscard]] auto x() const noexcept -> const T* { return mX.data(); }
+
+  [[nodiscard]] auto y() noexcept -> T* { return mY.data(); }
+  [[nodiscard]] auto y() const noexcept -> const T* { return mY.data(); }
+
+  [[nodiscard]] auto width() noexcept -> T* { return mWidth.data(); }
+  [[nodiscard]] auto width() const noexcept -> const T* { return mWidth.data(); }
+
+  [[nodiscard]] auto height() noexcept -> T* { return mHeight.data(); }
+  [[nodiscard]] auto height() const noexcept -> const T* { return mHeight.data(); }
+
+  [[nodiscard]] auto size() const noexcept -> usize { return mX.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mX.empty(); }
+
+ private:
+  simd_vector<T> mX;
+  simd_vector<T> mY;
+  simd_vector<T> mWidth;
+  simd_vector<T> mHeight;
+};
+
+using ipoint_array = basic_point_array<int>;
+using fpoint_array = basic_point_array<float>;
+
+using irect_array = basic_rect_array<int>;
+using frect_array = basic_rect_array<float>;
+
+}  // namespace cen
+
+#endif  // CENTURION_COMMON_GEOMETRY_ARRAYS_HPP_
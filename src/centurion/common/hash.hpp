@@ -0,0 +1,254 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_COMMON_HASH_HPP_
+#define CENTURION_COMMON_HASH_HPP_
+
+#include <cassert>      // assert
+#include <cstring>      // memcpy
+#include <string_view>  // string_view
+#include <type_traits>  // has_unique_object_representations_v, enable_if_t
+#include <vector>       // vector
+
+#include "../detail/stdlib.hpp"
+#include "../detail/xxhash.hpp"
+#include "../features.hpp"
+#include "primitives.hpp"
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+namespace cen {
+
+/**
+ * Computes a fast 64-bit hash of a buffer.
+ *
+ * The hash is the 64-bit xxHash of the data, which is non-cryptographic but has excellent
+ * distribution, and processes several gigabytes per second. Use it to key caches by content,
+ * not for security purposes.
+ *
+ * \details The hash of some data never changes between platforms or library versions, so it
+ *          can be stored in files.
+ *
+ * \param data the data that will be hashed.
+ * \param size the size of the data, in bytes.
+ * \param seed the seed of the hash, which can be used to derive independent hashes.
+ *
+ * \return the hash of the data.
+ *
+ * \see hasher64
+ */
+[[nodiscard]] inline auto hash64(const void* data,
+                                 const usize size,
+                                 const uint64 seed = 0) noexcept -> uint64
+{
+  assert(data || size == 0);
+  return detail::xxh64(data, size, seed);
+}
+
+/// Computes a fast 64-bit hash of a string, see `hash64(const void*, usize, uint64)`.
+[[nodiscard]] inline auto hash64(const std::string_view text, const uint64 seed = 0) noexcept
+    -> uint64
+{
+  return detail::xxh64(text.data(), text.size(), seed);
+}
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+/// Computes a fast 64-bit hash of the bytes of an array of values.
+template <typename T, usize Extent>
+[[nodiscard]] auto hash64(const std::span<T, Extent> values, const uint64 seed = 0) noexcept
+    -> uint64
+{
+  static_assert(std::has_unique_object_representations_v<std::remove_cv_t<T>>,
+                "Values must not contain padding bytes!");
+  return detail::xxh64(values.data(), values.size_bytes(), seed);
+}
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+/**
+ * Computes a fast 64-bit hash incrementally.
+ *
+ * The result is identical to hashing all of the data at once with `hash64()`, regardless of
+ * how the updates split the data.
+ *
+ * \code{cpp}
+ * cen::hasher64 hasher;
+ * hasher.update(header, sizeof header);
+ * hasher.update(pixels, size);
+ *
+ * const auto key = hasher.digest();
+ * \endcode
+ *
+ * \see hash64()
+ * \see hash64_stream()
+ */
+class hasher64 final {
+ public:
+  using size_type = usize;
+
+  /// Creates a hasher with no data.
+  explicit hasher64(const uint64 seed = 0) noexcept : mLanes {seed}, mSeed {seed} {}
+
+  /// Discards all data, and restarts the hash with a new seed.
+  void reset(const uint64 seed = 0) noexcept { *this = hasher64 {seed}; }
+
+  /**
+   * Hashes a sequence of bytes.
+   *
+   * \param data the data that will be hashed.
+   * \param size the size of the data, in bytes.
+   */
+  void update(const void* data, size_type size) noexcept
+  {
+    assert(data || size == 0);
+
+    const auto* bytes = static_cast<const uint8*>(data);
+    mLength += size;
+
+    /* Complete a partial stripe from an earlier update first */
+    if (mBuffered != 0) {
+      const auto count = (detail::min)(size, detail::xxh64_stripe_size - mBuffered);
+      std::memcpy(mBuffer + mBuffered, bytes, count);
+
+      mBuffered += count;
+      bytes += count;
+      size -= count;
+
+      if (mBuffered < detail::xxh64_stripe_size) {
+        return;
+      }
+
+      mLanes.consume(mBuffer, 1);
+      mBuffered = 0;
+    }
+
+    const auto stripes = size / detail::xxh64_stripe_size;
+    mLanes.consume(bytes, stripes);
+
+    const auto consumed = stripes * detail::xxh64_stripe_size;
+    if (consumed != size) {
+      std::memcpy(mBuffer, bytes + consumed, size - consumed);
+      mBuffered = size - consumed;
+    }
+  }
+
+  /// Hashes the characters of a string.
+  void update(const std::string_view text) noexcept { update(text.data(), text.size()); }
+
+  /// Hashes the bytes of a value, which must not contain padding bytes.
+  template <typename T>
+  void update_value(const T& value) noexcept
+  {
+    static_assert(std::has_unique_object_representations_v<T>,
+                  "Values must not contain padding bytes!");
+    update(&value, sizeof(T));
+  }
+
+  /// Returns the hash of all data so far; the hasher can still be updated afterwards.
+  [[nodiscard]] auto digest() const noexcept -> uint64
+  {
+    const auto hash = (mLength >= detail::xxh64_stripe_size)
+                          ? mLanes.converge()
+                          : mSeed + detail::xxh64_prime5;
+    return detail::xxh64_finalize(hash, mBuffer, mBuffered, mLength);
+  }
+
+  /// Returns the total amount of hashed bytes.
+  [[nodiscard]] auto length() const noexcept -> uint64 { return mLength; }
+
+ private:
+  detail::xxh64_lanes mLanes;
+  uint64 mSeed {};
+  uint64 mLength {};
+  uint8 mBuffer[detail::xxh64_stripe_size] {};  ///< The bytes of an incomplete stripe.
+  size_type mBuffered {};
+};
+
+/**
+ * Computes a fast 64-bit hash of the remaining contents of a stream.
+ *
+ * \details The stream is read from its current offset until no more data can be read.
+ *
+ * \tparam Source a readable stream, e.g. `file` or `buffered_file_reader`.
+ *
+ * \param source the stream that will be hashed.
+ * \param seed the seed of the hash.
+ *
+ * \return the hash of the read data, which equals `hash64()` of the same data.
+ */
+template <typename Source>
+[[nodiscard]] auto hash64_stream(Source& source, const uint64 seed = 0) -> uint64
+{
+  std::vector<uint8> buffer(64 * 1'024);
+  hasher64 hasher {seed};
+
+  while (const auto count = source.read_to(buffer.data(), buffer.size())) {
+    hasher.update(buffer.data(), count);
+  }
+
+  return hasher.digest();
+}
+
+/**
+ * A `std::hash` compatible function object that hashes by content.
+ *
+ * Strings are hashed by their characters, and other values by their bytes, so this can be
+ * used as the hasher of unordered containers that are keyed by content.
+ *
+ * \code{cpp}
+ * std::unordered_map<std::string, cen::texture, cen::content_hash, std::equal_to<>> cache;
+ * \endcode
+ *
+ * \details The hasher is transparent, so containers that support heterogeneous lookup can be
+ *          searched with string views without creating temporary strings. Character
+ *          pointers and arrays are hashed as null-terminated strings, so that string literals
+ *          hash like the equivalent strings.
+ */
+struct content_hash final {
+  using is_transparent = void;
+
+  [[nodiscard]] auto operator()(const std::string_view text) const noexcept -> usize
+  {
+    return static_cast<usize>(hash64(text));
+  }
+
+  template <typename T,
+            std::enable_if_t<std::has_unique_object_representations_v<T> &&
+                                 !std::is_pointer_v<T> && !std::is_array_v<T>,
+                             int> = 0>
+  [[nodiscard]] auto operator()(const T& value) const noexcept -> usize
+  {
+    return static_cast<usize>(hash64(&value, sizeof(T)));
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_COMMON_HASH_HPP_
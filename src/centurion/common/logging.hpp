@@ -27,17 +27,26 @@
 
 #include <SDL.h>
 
+#include <array>        // array
+#include <atomic>       // atomic, memory_order_relaxed
 #include <cassert>      // assert
-#include <ostream>      // ostream
 #include <string>       // string
 #include <string_view>  // string_view
 #include <utility>      // forward
 
 #include "../features.hpp"
+#include "../system/timer.hpp"
 #include "errors.hpp"
+#include "primitives.hpp"
 #include "utils.hpp"
 #include "version.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 #if CENTURION_SDL_VERSION_IS(2, 0, 10)
 
 /* Workaround for this enum being completely anonymous in SDL 2.0.10 */
@@ -45,6 +54,19 @@ using SDL_LogCategory = decltype(SDL_LOG_CATEGORY_APPLICATION);
 
 #endif  // CENTURION_SDL_VERSION_IS(2, 0, 10)
 
+/* Numeric priorities that can be used in preprocessor conditions */
+#define CENTURION_LOG_PRIORITY_VERBOSE 1
+#define CENTURION_LOG_PRIORITY_DEBUG 2
+#define CENTURION_LOG_PRIORITY_INFO 3
+#define CENTURION_LOG_PRIORITY_WARN 4
+#define CENTURION_LOG_PRIORITY_ERROR 5
+#define CENTURION_LOG_PRIORITY_CRITICAL 6
+
+/* Log calls with a lower priority than this are removed at compile-time */
+#ifndef CENTURION_LOG_MIN_PRIORITY
+#define CENTURION_LOG_MIN_PRIORITY CENTURION_LOG_PRIORITY_VERBOSE
+#endif  // CENTURION_LOG_MIN_PRIORITY
+
 namespace cen {
 
 enum class log_priority {
@@ -82,11 +104,15 @@ enum class log_priority {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const log_priority priority) -> std::ostream&
 {
   return stream << to_string(priority);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 enum class log_category {
   app = SDL_LOG_CATEGORY_APPLICATION,
   error = SDL_LOG_CATEGORY_ERROR,
@@ -147,14 +173,65 @@ enum class log_category {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const log_category category) -> std::ostream&
 {
   return stream << to_string(category);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace detail {
+
+/* Caches the priorities of the built-in categories, where zero denotes an unknown priority */
+inline constexpr int cached_log_category_count = SDL_LOG_CATEGORY_CUSTOM + 1;
+
+[[nodiscard]] inline auto get_log_priority_cache() noexcept
+    -> std::array<std::atomic<int>, cached_log_category_count>&
+{
+  static std::array<std::atomic<int>, cached_log_category_count> cache {};
+  return cache;
+}
+
+[[nodiscard]] inline auto cached_log_priority(const int category) noexcept -> int
+{
+  if (category >= 0 && category < cached_log_category_count) {
+    auto& entry = get_log_priority_cache()[static_cast<usize>(category)];
+
+    auto priority = entry.load(std::memory_order_relaxed);
+    if (priority == 0) {
+      priority = SDL_LogGetPriority(category);
+      entry.store(priority, std::memory_order_relaxed);
+    }
+
+    return priority;
+  }
+  else {
+    return SDL_LogGetPriority(category);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Discards the cached log priorities.
+ *
+ * Log calls check a cached copy of the priorities before reaching SDL. The cache is updated
+ * by the functions in this header, so this function only needs to be called after
+ * priorities have been changed directly through SDL.
+ */
+inline void refresh_log_priorities() noexcept
+{
+  for (auto& priority : detail::get_log_priority_cache()) {
+    priority.store(0, std::memory_order_relaxed);
+  }
+}
+
 inline void reset_log_priorities() noexcept
 {
   SDL_LogResetPriorities();
+  refresh_log_priorities();
 }
 
 inline void set_priority(const log_priority priority) noexcept
@@ -162,11 +239,22 @@ inline void set_priority(const log_priority priority) noexcept
   const auto value = static_cast<SDL_LogPriority>(priority);
   SDL_LogSetAllPriority(value);
   SDL_LogSetPriority(SDL_LOG_CATEGORY_TEST, value); /* Apparently not set by SDL */
+
+  for (auto& cached : detail::get_log_priority_cache()) {
+    cached.store(value, std::memory_order_relaxed);
+  }
 }
 
 inline void set_priority(const log_category category, const log_priority priority) noexcept
 {
-  SDL_LogSetPriority(to_underlying(category), static_cast<SDL_LogPriority>(priority));
+  const auto value = to_underlying(category);
+  SDL_LogSetPriority(value, static_cast<SDL_LogPriority>(priority));
+
+  if (value >= 0 && value < detail::cached_log_category_count) {
+    detail::get_log_priority_cache()[static_cast<usize>(value)].store(
+        to_underlying(priority),
+        std::memory_order_relaxed);
+  }
 }
 
 [[nodiscard]] inline auto get_priority(const log_category category) noexcept -> log_priority
@@ -174,6 +262,27 @@ inline void set_priority(const log_category category, const log_priority priorit
   return static_cast<log_priority>(SDL_LogGetPriority(to_underlying(category)));
 }
 
+/// Indicates whether log calls with a priority are kept by `CENTURION_LOG_MIN_PRIORITY`.
+[[nodiscard]] constexpr auto is_log_compiled(const log_priority priority) noexcept -> bool
+{
+  return to_underlying(priority) >= CENTURION_LOG_MIN_PRIORITY;
+}
+
+/**
+ * Indicates whether a message would be logged, without formatting it.
+ *
+ * \param category the category of the message.
+ * \param priority the priority of the message.
+ *
+ * \return `true` if the priority is compiled and enabled for the category; `false` otherwise.
+ */
+[[nodiscard]] inline auto is_log_enabled(const log_category category,
+                                         const log_priority priority) noexcept -> bool
+{
+  return is_log_compiled(priority) &&
+         to_underlying(priority) >= detail::cached_log_priority(to_underlying(category));
+}
+
 [[nodiscard]] constexpr auto max_log_message_size() noexcept -> int
 {
   return SDL_MAX_LOG_MESSAGE;
@@ -186,16 +295,20 @@ void log(const log_priority priority,
          Args&&... args) noexcept
 {
   assert(fmt);
-  SDL_LogMessage(static_cast<SDL_LogCategory>(category),
-                 static_cast<SDL_LogPriority>(priority),
-                 fmt,
-                 std::forward<Args>(args)...);
+  if (is_log_enabled(category, priority)) {
+    SDL_LogMessage(static_cast<SDL_LogCategory>(category),
+                   static_cast<SDL_LogPriority>(priority),
+                   fmt,
+                   std::forward<Args>(args)...);
+  }
 }
 
 template <typename... Args>
 void log_verbose(const log_category category, const char* fmt, Args&&... args) noexcept
 {
-  log(log_priority::verbose, category, fmt, std::forward<Args>(args)...);
+  if constexpr (is_log_compiled(log_priority::verbose)) {
+    log(log_priority::verbose, category, fmt, std::forward<Args>(args)...);
+  }
 }
 
 template <typename... Args>
@@ -207,7 +320,9 @@ void log_verbose(const char* fmt, Args&&... args) noexcept
 template <typename... Args>
 void log_debug(const log_category category, const char* fmt, Args&&... args) noexcept
 {
-  log(log_priority::debug, category, fmt, std::forward<Args>(args)...);
+  if constexpr (is_log_compiled(log_priority::debug)) {
+    log(log_priority::debug, category, fmt, std::forward<Args>(args)...);
+  }
 }
 
 template <typename... Args>
@@ -219,7 +334,9 @@ void log_debug(const char* fmt, Args&&... args) noexcept
 template <typename... Args>
 void log_info(const log_category category, const char* fmt, Args&&... args) noexcept
 {
-  log(log_priority::info, category, fmt, std::forward<Args>(args)...);
+  if constexpr (is_log_compiled(log_priority::info)) {
+    log(log_priority::info, category, fmt, std::forward<Args>(args)...);
+  }
 }
 
 template <typename... Args>
@@ -231,7 +348,9 @@ void log_info(const char* fmt, Args&&... args) noexcept
 template <typename... Args>
 void log_warn(const log_category category, const char* fmt, Args&&... args) noexcept
 {
-  log(log_priority::warn, category, fmt, std::forward<Args>(args)...);
+  if constexpr (is_log_compiled(log_priority::warn)) {
+    log(log_priority::warn, category, fmt, std::forward<Args>(args)...);
+  }
 }
 
 template <typename... Args>
@@ -243,7 +362,9 @@ void log_warn(const char* fmt, Args&&... args) noexcept
 template <typename... Args>
 void log_error(const log_category category, const char* fmt, Args&&... args) noexcept
 {
-  log(log_priority::error, category, fmt, std::forward<Args>(args)...);
+  if constexpr (is_log_compiled(log_priority::error)) {
+    log(log_priority::error, category, fmt, std::forward<Args>(args)...);
+  }
 }
 
 template <typename... Args>
@@ -255,7 +376,9 @@ void log_error(const char* fmt, Args&&... args) noexcept
 template <typename... Args>
 void log_critical(const log_category category, const char* fmt, Args&&... args) noexcept
 {
-  log(log_priority::critical, category, fmt, std::forward<Args>(args)...);
+  if constexpr (is_log_compiled(log_priority::critical)) {
+    log(log_priority::critical, category, fmt, std::forward<Args>(args)...);
+  }
 }
 
 template <typename... Args>
@@ -264,8 +387,188 @@ void log_critical(const char* fmt, Args&&... args) noexcept
   log_critical(log_category::app, fmt, std::forward<Args>(args)...);
 }
 
+/**
+ * The per-call-site state of rate-limited log messages.
+ *
+ * A limiter is usually a static local variable, see `CENTURION_LOG_EVERY` and
+ * `CENTURION_LOG_ONCE`. It may be shared by several threads.
+ *
+ * \see log_every()
+ * \see log_once()
+ */
+class log_limiter final {
+ public:
+  /**
+   * Attempts to obtain permission to log a message.
+   *
+   * \param interval the minimum amount of time between two logged messages.
+   *
+   * \return `true` if the message should be logged; `false` if it was suppressed.
+   */
+  auto try_acquire(const u64ms interval) noexcept -> bool
+  {
+    const auto current = now();
+    const auto period = interval.count() * frequency() / 1'000u;
+
+    auto last = mLast.load(std::memory_order_relaxed);
+    if ((last == never || current - last >= period) &&
+        mLast.compare_exchange_strong(last, current, std::memory_order_relaxed)) {
+      return true;
+    }
+
+    mSuppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /**
+   * Attempts to obtain permission to log a message, which is only granted once.
+   *
+   * \return `true` if the message should be logged; `false` if it was suppressed.
+   */
+  auto try_acquire_once() noexcept -> bool
+  {
+    auto expected = never;
+    if (mLast.compare_exchange_strong(expected, now(), std::memory_order_relaxed)) {
+      return true;
+    }
+
+    mSuppressed.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  /// Returns and resets the amount of messages suppressed since the last logged message.
+  auto take_suppressed() noexcept -> usize
+  {
+    return mSuppressed.exchange(0, std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of messages suppressed since the last logged message.
+  [[nodiscard]] auto suppressed() const noexcept -> usize
+  {
+    return mSuppressed.load(std::memory_order_relaxed);
+  }
+
+ private:
+  inline static constexpr uint64 never = ~uint64 {0};
+
+  std::atomic<uint64> mLast {never};  ///< The counter value of the last logged message.
+  std::atomic<usize> mSuppressed {0};
+};
+
+/**
+ * Logs a message at most once per interval.
+ *
+ * \details The first message logged after a suppression reports the amount of suppressed
+ * messages, e.g. `Missing glyph 'x' (suppressed 59 similar messages)`.
+ *
+ * \param limiter the state of the call site.
+ * \param interval the minimum amount of time between two logged messages.
+ * \param priority the priority of the message.
+ * \param category the category of the message.
+ * \param fmt the printf-style format string.
+ * \param args the format arguments.
+ */
+template <typename... Args>
+void log_every(log_limiter& limiter,
+               const u64ms interval,
+               const log_priority priority,
+               const log_category category,
+               const char* fmt,
+               Args&&... args) noexcept
+{
+  assert(fmt);
+
+  if (!is_log_enabled(category, priority) || !limiter.try_acquire(interval)) {
+    return;
+  }
+
+  const auto suppressed = limiter.take_suppressed();
+  if (suppressed == 0) {
+    log(priority, category, fmt, std::forward<Args>(args)...);
+  }
+  else {
+    char message[SDL_MAX_LOG_MESSAGE];
+    SDL_snprintf(message, sizeof message, fmt, std::forward<Args>(args)...);
+
+    log(priority,
+        category,
+        "%s (suppressed %lu similar messages)",
+        message,
+        static_cast<unsigned long>(suppressed));
+  }
+}
+
+/**
+ * Logs a message only the first time that it is encountered.
+ *
+ * \param limiter the state of the call site, which also counts the later messages.
+ * \param priority the priority of the message.
+ * \param category the category of the message.
+ * \param fmt the printf-style format string.
+ * \param args the format arguments.
+ */
+template <typename... Args>
+void log_once(log_limiter& limiter,
+              const log_priority priority,
+              const log_category category,
+              const char* fmt,
+              Args&&... args) noexcept
+{
+  if (is_log_enabled(category, priority) && limiter.try_acquire_once()) {
+    log(priority, category, fmt, std::forward<Args>(args)...);
+  }
+}
+
 }  // namespace cen
 
+/* Rate-limited logging of app messages, where the priority is the name of a log_priority
+   enumerator. Unlike the debug macros, these are not removed in release builds */
+#if CENTURION_HAS_FEATURE_CPP20
+
+#define CENTURION_LOG_EVERY(priority, interval, fmt, ...) \
+  do {                                                    \
+    static cen::log_limiter cen_log_limiter;              \
+    cen::log_every(cen_log_limiter,                       \
+                   interval,                              \
+                   cen::log_priority::priority,           \
+                   cen::log_category::app,                \
+                   fmt __VA_OPT__(, ) __VA_ARGS__);       \
+  } while (false)
+
+#define CENTURION_LOG_ONCE(priority, fmt, ...)     \
+  do {                                             \
+    static cen::log_limiter cen_log_limiter;       \
+    cen::log_once(cen_log_limiter,                 \
+                  cen::log_priority::priority,     \
+                  cen::log_category::app,          \
+                  fmt __VA_OPT__(, ) __VA_ARGS__); \
+  } while (false)
+
+#else
+
+#define CENTURION_LOG_EVERY(priority, interval, fmt, ...) \
+  do {                                                    \
+    static cen::log_limiter cen_log_limiter;              \
+    cen::log_every(cen_log_limiter,                       \
+                   interval,                              \
+                   cen::log_priority::priority,           \
+                   cen::log_category::app,                \
+                   fmt,                                   \
+                   __VA_ARGS__);                          \
+  } while (false)
+
+#define CENTURION_LOG_ONCE(priority, fmt, ...) \
+  do {                                         \
+    static cen::log_limiter cen_log_limiter;   \
+    cen::log_once(cen_log_limiter,             \
+                  cen::log_priority::priority, \
+                  cen::log_category::app,      \
+                  fmt,                         \
+                  __VA_ARGS__);                \
+  } while (false)
+
+#endif  // CENTURION_HAS_FEATURE_CPP20
+
 #ifndef CENTURION_NO_DEBUG_LOG_MACROS
 #ifdef NDEBUG
 
@@ -298,6 +601,37 @@ void log_critical(const char* fmt, Args&&... args) noexcept
 
 #endif  // CENTURION_HAS_FEATURE_CPP20
 
+/* Remove the macros below the minimum priority, so that their arguments aren't evaluated */
+#if CENTURION_LOG_MIN_PRIORITY > CENTURION_LOG_PRIORITY_VERBOSE
+#undef CENTURION_LOG_VERBOSE
+#define CENTURION_LOG_VERBOSE(fmt, ...)
+#endif
+
+#if CENTURION_LOG_MIN_PRIORITY > CENTURION_LOG_PRIORITY_DEBUG
+#undef CENTURION_LOG_DEBUG
+#define CENTURION_LOG_DEBUG(fmt, ...)
+#endif
+
+#if CENTURION_LOG_MIN_PRIORITY > CENTURION_LOG_PRIORITY_INFO
+#undef CENTURION_LOG_INFO
+#define CENTURION_LOG_INFO(fmt, ...)
+#endif
+
+#if CENTURION_LOG_MIN_PRIORITY > CENTURION_LOG_PRIORITY_WARN
+#undef CENTURION_LOG_WARN
+#define CENTURION_LOG_WARN(fmt, ...)
+#endif
+
+#if CENTURION_LOG_MIN_PRIORITY > CENTURION_LOG_PRIORITY_ERROR
+#undef CENTURION_LOG_ERROR
+#define CENTURION_LOG_ERROR(fmt, ...)
+#endif
+
+#if CENTURION_LOG_MIN_PRIORITY > CENTURION_LOG_PRIORITY_CRITICAL
+#undef CENTURION_LOG_CRITICAL
+#define CENTURION_LOG_CRITICAL(fmt, ...)
+#endif
+
 #endif  // NDEBUG
 #endif  // CENTURION_NO_DEBUG_LOG_MACROS
 
@@ -27,23 +27,29 @@
 
 #include <SDL.h>
 
-#include <cmath>        // sqrt, pow, round
-#include <ostream>      // ostream
+#include <iterator>     // back_inserter, ostreambuf_iterator
 #include <string>       // string, to_string
 #include <type_traits>  // conditional_t, is_integral_v, is_floating_point_v, ...
 
 #include "../detail/sdl_version_at_least.hpp"
 #include "../detail/stdlib.hpp"
 #include "../features.hpp"
+#include "formatting.hpp"
 #include "primitives.hpp"
 #include "utils.hpp"
 
 #if CENTURION_HAS_FEATURE_FORMAT
 
-#include <format>  // format
+#include <format>  // format, format_to, formatter
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 template <typename T>
@@ -103,6 +109,8 @@ template <typename T>
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 [[deprecated]] auto operator<<(std::ostream& stream, const basic_vector3<T>& vector)
     -> std::ostream&
@@ -110,6 +118,8 @@ template <typename T>
   return stream << to_string(vector);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 template <typename T>
 struct basic_area;
 
@@ -168,23 +178,44 @@ template <>
   return {static_cast<int>(from.width), static_cast<int>(from.height)};
 }
 
-template <typename T>
-[[nodiscard]] auto to_string(const basic_area<T>& area) -> std::string
+/**
+ * Writes a textual representation of an area to an output iterator, without allocating.
+ *
+ * \return the output iterator past the last written character.
+ */
+template <typename OutputIt, typename T>
+auto format_to(OutputIt out, const basic_area<T>& area) -> OutputIt
 {
 #if CENTURION_HAS_FEATURE_FORMAT
-  return std::format("area(width: {}, height: {})", area.width, area.height);
+  return std::format_to(out, "area(width: {}, height: {})", area.width, area.height);
 #else
-  return "area(width: " + std::to_string(area.width) +
-         ", height: " + std::to_string(area.height) + ")";
+  out = detail::write_text(out, "area(width: ");
+  out = detail::write_number(out, area.width);
+  out = detail::write_text(out, ", height: ");
+  out = detail::write_number(out, area.height);
+  return detail::write_text(out, ")");
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+template <typename T>
+[[nodiscard]] auto to_string(const basic_area<T>& area) -> std::string
+{
+  std::string result;
+  format_to(std::back_inserter(result), area);
+  return result;
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_area<T>& area) -> std::ostream&
 {
-  return stream << to_string(area);
+  format_to(std::ostreambuf_iterator<char> {stream}, area);
+  return stream;
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 template <typename T>
 [[nodiscard]] constexpr auto operator==(const basic_area<T>& a,
                                         const basic_area<T>& b) noexcept -> bool
@@ -277,17 +308,27 @@ class basic_point final {
   point_type mPoint {};
 };
 
+/**
+ * Returns the distance between two points.
+ *
+ * This function can be used in constant expressions, if the compiler supports detecting
+ * constant evaluation. The distance between integral points is rounded to the nearest
+ * integer.
+ */
 template <typename T>
-[[nodiscard]] auto distance(const basic_point<T>& from, const basic_point<T>& to) noexcept ->
+[[nodiscard]] constexpr auto distance(const basic_point<T>& from,
+                                      const basic_point<T>& to) noexcept ->
     typename basic_point<T>::value_type
 {
-  const auto distance =
-      std::sqrt(std::pow(from.x() - to.x(), T {2}) + std::pow(from.y() - to.y(), T {2}));
   if constexpr (basic_point<T>::integral) {
-    return static_cast<int>(std::round(distance));
+    const auto dx = static_cast<double>(from.x() - to.x());
+    const auto dy = static_cast<double>(from.y() - to.y());
+    return static_cast<int>(detail::round(detail::sqrt(dx * dx + dy * dy)));
   }
   else {
-    return distance;
+    const auto dx = from.x() - to.x();
+    const auto dy = from.y() - to.y();
+    return detail::sqrt(dx * dx + dy * dy);
   }
 }
 
@@ -323,22 +364,44 @@ template <>
   return SDL_FPoint {x, y};
 }
 
-template <typename T>
-[[nodiscard]] auto to_string(const basic_point<T>& point) -> std::string
+/**
+ * Writes a textual representation of a point to an output iterator, without allocating.
+ *
+ * \return the output iterator past the last written character.
+ */
+template <typename OutputIt, typename T>
+auto format_to(OutputIt out, const basic_point<T>& point) -> OutputIt
 {
 #if CENTURION_HAS_FEATURE_FORMAT
-  return std::format("(x: {}, y: {})", point.x(), point.y());
+  return std::format_to(out, "(x: {}, y: {})", point.x(), point.y());
 #else
-  return "(x: " + std::to_string(point.x()) + ", y: " + std::to_string(point.y()) + ")";
+  out = detail::write_text(out, "(x: ");
+  out = detail::write_number(out, point.x());
+  out = detail::write_text(out, ", y: ");
+  out = detail::write_number(out, point.y());
+  return detail::write_text(out, ")");
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+template <typename T>
+[[nodiscard]] auto to_string(const basic_point<T>& point) -> std::string
+{
+  std::string result;
+  format_to(std::back_inserter(result), point);
+  return result;
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_point<T>& point) -> std::ostream&
 {
-  return stream << to_string(point);
+  format_to(std::ostreambuf_iterator<char> {stream}, point);
+  return stream;
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 template <typename T>
 [[nodiscard]] constexpr auto operator+(const basic_point<T>& a,
                                        const basic_point<T>& b) noexcept -> basic_point<T>
@@ -587,39 +650,41 @@ template <typename T>
 [[nodiscard]] constexpr auto get_union(const basic_rect<T>& a, const basic_rect<T>& b) noexcept
     -> basic_rect<T>
 {
+  /* SDL can't be called in constant expressions, so those use the fallback below */
   if constexpr (detail::sdl_version_at_least(2, 0, 22)) {
-    if constexpr (basic_rect<T>::floating) {
-      cen::frect res;
-      SDL_UnionFRect(a.data(), b.data(), res.data());
-      return res;
-    }
-    else {
-      cen::irect res;
-      SDL_UnionRect(a.data(), b.data(), res.data());
-      return res;
+    if (!detail::is_constant_evaluated()) {
+      if constexpr (basic_rect<T>::floating) {
+        cen::frect res;
+        SDL_UnionFRect(a.data(), b.data(), res.data());
+        return res;
+      }
+      else {
+        cen::irect res;
+        SDL_UnionRect(a.data(), b.data(), res.data());
+        return res;
+      }
     }
   }
-  else {
-    const auto aHasArea = a.has_area();
-    const auto bHasArea = b.has_area();
-
-    if (!aHasArea && !bHasArea) {
-      return {};
-    }
-    else if (!aHasArea) {
-      return b;
-    }
-    else if (!bHasArea) {
-      return a;
-    }
 
-    const auto x = detail::min(a.x(), b.x());
-    const auto y = detail::min(a.y(), b.y());
-    const auto maxX = detail::max(a.max_x(), b.max_x());
-    const auto maxY = detail::max(a.max_y(), b.max_y());
+  const auto aHasArea = a.has_area();
+  const auto bHasArea = b.has_area();
 
-    return {{x, y}, {maxX - x, maxY - y}};
+  if (!aHasArea && !bHasArea) {
+    return {};
+  }
+  else if (!aHasArea) {
+    return b;
+  }
+  else if (!bHasArea) {
+    return a;
   }
+
+  const auto x = detail::min(a.x(), b.x());
+  const auto y = detail::min(a.y(), b.y());
+  const auto maxX = detail::max(a.max_x(), b.max_x());
+  const auto maxY = detail::max(a.max_y(), b.max_y());
+
+  return {{x, y}, {maxX - x, maxY - y}};
 }
 
 template <>
@@ -640,28 +705,53 @@ template <>
   return irect {pos, size};
 }
 
-template <typename T>
-[[nodiscard]] auto to_string(const basic_rect<T>& rect) -> std::string
+/**
+ * Writes a textual representation of a rect to an output iterator, without allocating.
+ *
+ * \return the output iterator past the last written character.
+ */
+template <typename OutputIt, typename T>
+auto format_to(OutputIt out, const basic_rect<T>& rect) -> OutputIt
 {
 #if CENTURION_HAS_FEATURE_FORMAT
-  return std::format("(x: {}, y: {}, width: {}, height: {})",
-                     rect.x(),
-                     rect.y(),
-                     rect.width(),
-                     rect.height());
+  return std::format_to(out,
+                        "(x: {}, y: {}, width: {}, height: {})",
+                        rect.x(),
+                        rect.y(),
+                        rect.width(),
+                        rect.height());
 #else
-  return "(x: " + std::to_string(rect.x()) + ", y: " + std::to_string(rect.y()) +
-         ", width: " + std::to_string(rect.width()) +
-         ", height: " + std::to_string(rect.height()) + ")";
+  out = detail::write_text(out, "(x: ");
+  out = detail::write_number(out, rect.x());
+  out = detail::write_text(out, ", y: ");
+  out = detail::write_number(out, rect.y());
+  out = detail::write_text(out, ", width: ");
+  out = detail::write_number(out, rect.width());
+  out = detail::write_text(out, ", height: ");
+  out = detail::write_number(out, rect.height());
+  return detail::write_text(out, ")");
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+template <typename T>
+[[nodiscard]] auto to_string(const basic_rect<T>& rect) -> std::string
+{
+  std::string result;
+  format_to(std::back_inserter(result), rect);
+  return result;
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_rect<T>& rect) -> std::ostream&
 {
-  return stream << to_string(rect);
+  format_to(std::ostreambuf_iterator<char> {stream}, rect);
+  return stream;
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 template <typename T>
 [[nodiscard]] constexpr auto operator==(const basic_rect<T>& a,
                                         const basic_rect<T>& b) noexcept -> bool
@@ -679,4 +769,20 @@ template <typename T>
 
 }  // namespace cen
 
+#if CENTURION_HAS_FEATURE_FORMAT
+
+template <typename T>
+struct std::formatter<cen::basic_area<T>>
+    : cen::detail::value_formatter<cen::basic_area<T>> {};
+
+template <typename T>
+struct std::formatter<cen::basic_point<T>>
+    : cen::detail::value_formatter<cen::basic_point<T>> {};
+
+template <typename T>
+struct std::formatter<cen::basic_rect<T>>
+    : cen::detail::value_formatter<cen::basic_rect<T>> {};
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
 #endif  // CENTURION_COMMON_MATH_HPP_
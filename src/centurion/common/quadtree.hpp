@@ -0,0 +1,365 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_COMMON_QUADTREE_HPP_
+#define CENTURION_COMMON_QUADTREE_HPP_
+
+#include <algorithm>  // find
+#include <array>      // array
+#include <cassert>    // assert
+#include <vector>     // vector
+
+#include "../detail/spatial_entries.hpp"
+#include "../detail/stdlib.hpp"
+#include "math.hpp"
+#include "primitives.hpp"
+
+namespace cen {
+
+/**
+ * A loose quadtree broadphase that stores ids by their bounding rectangles.
+ *
+ * Each id is stored in exactly one node, the deepest node that is at least as large as its
+ * rectangle and whose loose bounds contain it. The loose bounds of a node extend half of the
+ * node size beyond each of its edges, so rectangles never need to be split across nodes, and
+ * updating a rectangle only touches a single node. Rectangles that don't fit anywhere, e.g.
+ * because they are outside of the tree bounds, are stored in the root node.
+ *
+ * Nodes are created on demand and reused after removals. Queries report each matching id
+ * exactly once, through a callable, and never allocate.
+ *
+ * \tparam T the representation type of the rectangles, i.e. `int` or `float`.
+ *
+ * \see basic_spatial_hash
+ */
+template <typename T>
+class basic_quadtree final {
+ public:
+  using value_type = T;
+  using rect_type = basic_rect<T>;
+  using point_type = basic_point<T>;
+  using id_type = uint32;
+
+  /// The maximum depth of a quadtree, which bounds the query stack size.
+  inline static constexpr int max_depth_limit = 16;
+
+  /**
+   * Creates an empty quadtree.
+   *
+   * \param bounds the area covered by the tree, should contain most of the stored rectangles.
+   * \param maxDepth the maximum depth of the tree, in the range [0, max_depth_limit].
+   */
+  explicit basic_quadtree(const rect_type& bounds, const int maxDepth = 8)
+      : mBounds {bounds}
+      , mMaxDepth {detail::clamp(maxDepth, 0, max_depth_limit)}
+  {
+    mNodes.push_back(node {bounds});
+  }
+
+  /**
+   * Stores an id, replacing its rectangle if the id is already stored.
+   *
+   * \param id the id that will be stored.
+   * \param rect the bounding rectangle associated with the id.
+   */
+  void insert(const id_type id, const rect_type& rect)
+  {
+    if (const auto slot = mEntries.find(id)) {
+      unlink(*slot);
+      mEntries[*slot].rect = rect;
+      link(*slot);
+    }
+    else {
+      link(mEntries.add(id, rect));
+    }
+  }
+
+  /**
+   * Stores a range of ids.
+   *
+   * \param ids the ids that will be stored.
+   * \param rects the rectangles associated with the ids.
+   * \param count the amount of ids.
+   */
+  void insert(const id_type* ids, const rect_type* rects, const usize count)
+  {
+    assert(!count || (ids && rects));
+
+    mEntries.reserve(mEntries.size() + count);
+    for (usize index = 0; index < count; ++index) {
+      insert(ids[index], rects[index]);
+    }
+  }
+
+  /**
+   * Removes an id.
+   *
+   * \param id the id that will be removed.
+   *
+   * \return `true` if the id was removed; `false` if it wasn't stored.
+   */
+  auto remove(const id_type id) -> bool
+  {
+    if (const auto slot = mEntries.find(id)) {
+      unlink(*slot);
+      mEntries.remove(*slot);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Removes a range of ids.
+   *
+   * \param ids the ids that will be removed, ids that aren't stored are ignored.
+   * \param count the amount of ids.
+   *
+   * \return the amount of removed ids.
+   */
+  auto remove(const id_type* ids, const usize count) -> usize
+  {
+    assert(!count || ids);
+
+    usize removed = 0;
+    for (usize index = 0; index < count; ++index) {
+      removed += remove(ids[index]) ? 1u : 0u;
+    }
+
+    return removed;
+  }
+
+  /// Removes all ids, but keeps the node storage for reuse.
+  void clear() noexcept
+  {
+    mEntries.clear();
+    for (auto& node : mNodes) {
+      node.slots.clear();
+    }
+  }
+
+  /**
+   * Invokes a callable for each id whose rectangle intersects a region.
+   *
+   * \param region the region that will be queried.
+   * \param callable the function object invoked with each matching id.
+   *
+   * \return the amount of matching ids.
+   */
+  template <typename Callable>
+  auto query(const rect_type& region, Callable&& callable) const -> usize
+  {
+    return visit([&](const rect_type& loose) { return intersects(loose, region); },
+                 [&](const rect_type& rect) { return intersects(rect, region); },
+                 callable);
+  }
+
+  /**
+   * Invokes a callable for each id whose rectangle contains a point.
+   *
+   * \param point the point that will be queried.
+   * \param callable the function object invoked with each matching id.
+   *
+   * \return the amount of matching ids.
+   */
+  template <typename Callable>
+  auto query(const point_type& point, Callable&& callable) const -> usize
+  {
+    return visit([&](const rect_type& loose) { return loose.contains(point); },
+                 [&](const rect_type& rect) { return rect.contains(point); },
+                 callable);
+  }
+
+  /// Indicates whether an id is stored.
+  [[nodiscard]] auto contains(const id_type id) const -> bool
+  {
+    return mEntries.find(id).has_value();
+  }
+
+  /// Returns the rectangle associated with an id, if the id is stored.
+  [[nodiscard]] auto get(const id_type id) const -> maybe<rect_type>
+  {
+    if (const auto slot = mEntries.find(id)) {
+      return mEntries[*slot].rect;
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Returns the amount of stored ids.
+  [[nodiscard]] auto size() const noexcept -> usize { return mEntries.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mEntries.size() == 0; }
+
+  [[nodiscard]] auto bounds() const noexcept -> const rect_type& { return mBounds; }
+
+  [[nodiscard]] auto max_depth() const noexcept -> int { return mMaxDepth; }
+
+  /// Returns the amount of allocated nodes, including nodes that are currently empty.
+  [[nodiscard]] auto node_count() const noexcept -> usize { return mNodes.size(); }
+
+ private:
+  struct node final {
+    rect_type bounds;
+    rect_type loose;
+    std::array<uint32, 4> children {};  ///< Child node indices, zero if absent.
+    std::vector<uint32> slots;
+
+    explicit node(const rect_type& area)
+        : bounds {area}
+        , loose {area.x() - area.width() / 2,
+                 area.y() - area.height() / 2,
+                 area.width() * 2,
+                 area.height() * 2}
+    {
+    }
+  };
+
+  detail::spatial_entries<T> mEntries;
+  std::vector<node> mNodes;
+  rect_type mBounds;
+  int mMaxDepth {};
+
+  [[nodiscard]] static auto contains(const rect_type& outer, const rect_type& inner) noexcept
+      -> bool
+  {
+    return inner.x() >= outer.x() && inner.y() >= outer.y() &&
+           inner.max_x() <= outer.max_x() && inner.max_y() <= outer.max_y();
+  }
+
+  [[nodiscard]] static auto quadrant(const rect_type& area, const int index) noexcept
+      -> rect_type
+  {
+    const auto halfWidth = area.width() / 2;
+    const auto halfHeight = area.height() / 2;
+
+    const auto right = (index & 1) != 0;
+    const auto bottom = (index & 2) != 0;
+
+    return {right ? area.x() + halfWidth : area.x(),
+            bottom ? area.y() + halfHeight : area.y(),
+            right ? area.width() - halfWidth : halfWidth,
+            bottom ? area.height() - halfHeight : halfHeight};
+  }
+
+  /* Finds the deepest node that can hold the rectangle, creating nodes as needed */
+  [[nodiscard]] auto find_node(const rect_type& rect) -> uint32
+  {
+    uint32 current = 0;
+    const auto center = rect.center();
+
+    if (!mNodes.front().bounds.contains(center)) {
+      return current;
+    }
+
+    for (int depth = 0; depth < mMaxDepth; ++depth) {
+      const auto& bounds = mNodes[current].bounds;
+      const auto index = ((center.x() >= bounds.center_x()) ? 1 : 0) +
+                         ((center.y() >= bounds.center_y()) ? 2 : 0);
+
+      const auto area = quadrant(bounds, index);
+      if (area.width() < rect.width() || area.height() < rect.height() ||
+          !area.has_area()) {
+        break;
+      }
+
+      auto child = mNodes[current].children[static_cast<usize>(index)];
+      if (child == 0) {
+        const node candidate {area};
+        if (!contains(candidate.loose, rect)) {
+          break;
+        }
+
+        child = static_cast<uint32>(mNodes.size());
+        mNodes.push_back(candidate);
+        mNodes[current].children[static_cast<usize>(index)] = child;
+      }
+      else if (!contains(mNodes[child].loose, rect)) {
+        break;
+      }
+
+      current = child;
+    }
+
+    return current;
+  }
+
+  void link(const uint32 slot)
+  {
+    auto& entry = mEntries[slot];
+    entry.node = find_node(entry.rect);
+    mNodes[entry.node].slots.push_back(slot);
+  }
+
+  void unlink(const uint32 slot)
+  {
+    auto& slots = mNodes[mEntries[slot].node].slots;
+    if (const auto pos = std::find(slots.begin(), slots.end(), slot); pos != slots.end()) {
+      *pos = slots.back();
+      slots.pop_back();
+    }
+  }
+
+  template <typename NodePredicate, typename EntryPredicate, typename Callable>
+  auto visit(NodePredicate&& visitNode, EntryPredicate&& match, Callable& callable) const
+      -> usize
+  {
+    /* Every visited node pushes at most four children, so the stack size is bounded */
+    std::array<uint32, 3 * max_depth_limit + 4> stack;
+    usize top = 0;
+    usize matches = 0;
+
+    /* The root also holds the rectangles outside of the bounds, so it is always visited */
+    stack[top++] = 0;
+
+    while (top > 0) {
+      const auto& current = mNodes[stack[--top]];
+
+      for (const auto slot : current.slots) {
+        const auto& entry = mEntries[slot];
+        if (match(entry.rect)) {
+          callable(entry.id);
+          ++matches;
+        }
+      }
+
+      for (const auto child : current.children) {
+        if (child != 0 && visitNode(mNodes[child].loose)) {
+          stack[top++] = child;
+        }
+      }
+    }
+
+    return matches;
+  }
+};
+
+using iquadtree = basic_quadtree<int>;
+using fquadtree = basic_quadtree<float>;
+
+}  // namespace cen
+
+#endif  // CENTURION_COMMON_QUADTREE_HPP_
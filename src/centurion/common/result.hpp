@@ -25,9 +25,14 @@
 #ifndef CENTURION_COMMON_RESULT_HPP_
 #define CENTURION_COMMON_RESULT_HPP_
 
-#include <ostream>  // ostream
 #include <string>   // string
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 /**
@@ -93,11 +98,15 @@ inline constexpr result failure {false};  ///< A failure.
   return result ? "success" : "failure";
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const result result) -> std::ostream&
 {
   return stream << to_string(result);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_COMMON_RESULT_HPP_
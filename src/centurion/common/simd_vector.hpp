@@ -0,0 +1,346 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_COMMON_SIMD_VECTOR_HPP_
+#define CENTURION_COMMON_SIMD_VECTOR_HPP_
+
+#include <SDL.h>
+
+#include <cassert>           // assert
+#include <cstddef>           // size_t, ptrdiff_t
+#include <cstring>           // memcpy
+#include <initializer_list>  // initializer_list
+#include <stdexcept>         // out_of_range
+#include <type_traits>       // is_trivially_copyable_v
+#include <utility>           // exchange, swap
+
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "errors.hpp"
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+namespace cen {
+
+/**
+ * A dynamic array whose storage is suitably aligned for SIMD instructions.
+ *
+ * The storage is obtained with `SDL_SIMDAlloc`, so the first element is always aligned to at
+ * least `SDL_SIMDGetAlignment()` bytes, and the allocation is padded so that kernels may
+ * safely process the elements in whole vector registers. Unlike `simd_block`, the vector
+ * keeps track of its size and capacity.
+ *
+ * \tparam T the element type, must be trivially copyable since the storage is reallocated
+ *         with `SDL_SIMDRealloc`.
+ */
+template <typename T>
+class simd_vector final {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "SIMD vector elements must be trivially copyable");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  /// Creates an empty vector without allocating.
+  simd_vector() noexcept = default;
+
+  /**
+   * Creates a vector with value-initialized elements.
+   *
+   * \param size the amount of elements.
+   *
+   * \throws sdl_error if the memory cannot be allocated.
+   */
+  explicit simd_vector(const size_type size) { resize(size); }
+
+  /// Creates a vector with copies of a value.
+  simd_vector(const size_type size, const T& value) { resize(size, value); }
+
+  simd_vector(std::initializer_list<T> values)
+  {
+    reserve(values.size());
+    for (const auto& value : values) {
+      push_back(value);
+    }
+  }
+
+  simd_vector(const simd_vector& other)
+  {
+    reserve(other.mSize);
+    copy_from(other);
+  }
+
+  simd_vector(simd_vector&& other) noexcept
+      : mData {std::exchange(other.mData, nullptr)}
+      , mSize {std::exchange(other.mSize, 0)}
+      , mCapacity {std::exchange(other.mCapacity, 0)}
+  {
+  }
+
+  auto operator=(const simd_vector& other) -> simd_vector&
+  {
+    if (this != &other) {
+      reserve(other.mSize);
+      copy_from(other);
+    }
+
+    return *this;
+  }
+
+  auto operator=(simd_vector&& other) noexcept -> simd_vector&
+  {
+    if (this != &other) {
+      SDL_SIMDFree(mData);
+      mData = std::exchange(other.mData, nullptr);
+      mSize = std::exchange(other.mSize, 0);
+      mCapacity = std::exchange(other.mCapacity, 0);
+    }
+
+    return *this;
+  }
+
+  ~simd_vector() noexcept { SDL_SIMDFree(mData); }
+
+  /**
+   * Ensures that the vector can hold at least the specified amount of elements.
+   *
+   * \throws sdl_error if the memory cannot be allocated.
+   */
+  void reserve(const size_type capacity)
+  {
+    if (capacity > mCapacity) {
+      reallocate(capacity);
+    }
+  }
+
+  /**
+   * Changes the amount of elements, value-initializing any added elements.
+   *
+   * \throws sdl_error if the memory cannot be allocated.
+   */
+  void resize(const size_type size) { resize(size, T {}); }
+
+  /// Changes the amount of elements, copying a value into any added elements.
+  void resize(const size_type size, const T& value)
+  {
+    reserve(size);
+
+    for (auto index = mSize; index < size; ++index) {
+      mData[index] = value;
+    }
+
+    mSize = size;
+  }
+
+  /**
+   * Adds an element to the end of the vector.
+   *
+   * \throws sdl_error if the memory cannot be allocated.
+   */
+  void push_back(const T& value)
+  {
+    if (mSize == mCapacity) {
+      /* The value might refer to an element of the vector itself */
+      const T copy = value;
+      reallocate((detail::max)(mCapacity * 2, size_type {8}));
+      mData[mSize++] = copy;
+    }
+    else {
+      mData[mSize++] = value;
+    }
+  }
+
+  /// Removes the last element of the vector.
+  void pop_back() noexcept
+  {
+    assert(!empty());
+    --mSize;
+  }
+
+  /// Removes all elements, without releasing the storage.
+  void clear() noexcept { mSize = 0; }
+
+  /// Reduces the capacity to the size of the vector.
+  void shrink_to_fit()
+  {
+    if (mSize == 0) {
+      SDL_SIMDFree(mData);
+      mData = nullptr;
+      mCapacity = 0;
+    }
+    else if (mCapacity > mSize) {
+      reallocate(mSize);
+    }
+  }
+
+  [[nodiscard]] auto at(const size_type index) -> T&
+  {
+    if (index < mSize) {
+      return mData[index];
+    }
+    else {
+      throw std::out_of_range {"Invalid SIMD vector index!"};
+    }
+  }
+
+  [[nodiscard]] auto at(const size_type index) const -> const T&
+  {
+    if (index < mSize) {
+      return mData[index];
+    }
+    else {
+      throw std::out_of_range {"Invalid SIMD vector index!"};
+    }
+  }
+
+  [[nodiscard]] auto operator[](const size_type index) noexcept -> T&
+  {
+    assert(index < mSize);
+    return mData[index];
+  }
+
+  [[nodiscard]] auto operator[](const size_type index) const noexcept -> const T&
+  {
+    assert(index < mSize);
+    return mData[index];
+  }
+
+  [[nodiscard]] auto front() noexcept -> T& { return (*this)[0]; }
+  [[nodiscard]] auto front() const noexcept -> const T& { return (*this)[0]; }
+
+  [[nodiscard]] auto back() noexcept -> T& { return (*this)[mSize - 1]; }
+  [[nodiscard]] auto back() const noexcept -> const T& { return (*this)[mSize - 1]; }
+
+  [[nodiscard]] auto data() noexcept -> T* { return mData; }
+  [[nodiscard]] auto data() const noexcept -> const T* { return mData; }
+
+  [[nodiscard]] auto begin() noexcept -> iterator { return mData; }
+  [[nodiscard]] auto begin() const noexcept -> const_iterator { return mData; }
+
+  [[nodiscard]] auto end() noexcept -> iterator { return mData + mSize; }
+  [[nodiscard]] auto end() const noexcept -> const_iterator { return mData + mSize; }
+
+  [[nodiscard]] auto size() const noexcept -> size_type { return mSize; }
+
+  /// Returns the size of the elements, in bytes.
+  [[nodiscard]] auto size_bytes() const noexcept -> size_type { return mSize * sizeof(T); }
+
+  [[nodiscard]] auto capacity() const noexcept -> size_type { return mCapacity; }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mSize == 0; }
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+  /// Returns a view of the elements.
+  [[nodiscard]] auto span() noexcept -> std::span<T> { return {mData, mSize}; }
+
+  /// Returns a read-only view of the elements.
+  [[nodiscard]] auto span() const noexcept -> std::span<const T> { return {mData, mSize}; }
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+  /// Returns the alignment of the storage, in bytes.
+  [[nodiscard]] static auto alignment() noexcept -> size_type
+  {
+    return SDL_SIMDGetAlignment();
+  }
+
+ private:
+  T* mData {};
+  size_type mSize {};
+  size_type mCapacity {};
+
+  void reallocate(const size_type capacity)
+  {
+    assert(capacity >= mSize);
+    assert(alignof(T) <= alignment());
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    auto* data = SDL_SIMDRealloc(mData, capacity * sizeof(T));
+    if (!data) {
+      throw sdl_error {};
+    }
+#else
+    auto* data = SDL_SIMDAlloc(capacity * sizeof(T));
+    if (!data) {
+      throw sdl_error {};
+    }
+
+    if (mData) {
+      std::memcpy(data, mData, mSize * sizeof(T));
+      SDL_SIMDFree(mData);
+    }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+
+    mData = static_cast<T*>(data);
+    mCapacity = capacity;
+  }
+
+  void copy_from(const simd_vector& other) noexcept
+  {
+    if (other.mSize != 0) {
+      std::memcpy(mData, other.mData, other.size_bytes());
+    }
+
+    mSize = other.mSize;
+  }
+};
+
+template <typename T>
+[[nodiscard]] auto operator==(const simd_vector<T>& a, const simd_vector<T>& b) -> bool
+{
+  if (a.size() != b.size()) {
+    return false;
+  }
+
+  for (std::size_t index = 0; index < a.size(); ++index) {
+    if (!(a[index] == b[index])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+template <typename T>
+[[nodiscard]] auto operator!=(const simd_vector<T>& a, const simd_vector<T>& b) -> bool
+{
+  return !(a == b);
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_COMMON_SIMD_VECTOR_HPP_
@@ -0,0 +1,436 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_COMMON_SLOT_MAP_HPP_
+#define CENTURION_COMMON_SLOT_MAP_HPP_
+
+#include <cassert>  // assert
+#include <utility>  // move, forward
+#include <vector>   // vector
+
+#include "errors.hpp"
+#include "primitives.hpp"
+
+namespace cen {
+
+/**
+ * A 32-bit generational identifier of a value in a slot map.
+ *
+ * The lower bits store the index of a slot, and the upper bits store the generation of the
+ * slot when the identifier was created. The generation of a slot is incremented each time
+ * its value is erased, which invalidates all identifiers of the erased value, even if the
+ * slot is reused.
+ *
+ * \tparam T the type of the identified values, which makes identifiers of different types
+ *           of values incompatible.
+ *
+ * \details A default-constructed identifier is null, and never refers to a value.
+ *
+ * \see slot_map
+ */
+template <typename T>
+class slot_id final {
+ public:
+  using value_type = uint32;
+
+  inline constexpr static value_type index_bits = 20;
+  inline constexpr static value_type generation_bits = 32 - index_bits;
+  inline constexpr static value_type index_mask = (value_type {1} << index_bits) - 1u;
+  inline constexpr static value_type max_generation = (value_type {1} << generation_bits) - 1u;
+
+  constexpr slot_id() noexcept = default;
+
+  constexpr slot_id(const value_type index, const value_type generation) noexcept
+      : mValue {(generation << index_bits) | (index & index_mask)}
+  {
+    assert(index <= index_mask);
+    assert(generation <= max_generation);
+  }
+
+  /// Creates an identifier from a value obtained with `value()`, e.g. when deserializing.
+  [[nodiscard]] constexpr static auto from_value(const value_type value) noexcept -> slot_id
+  {
+    slot_id id;
+    id.mValue = value;
+    return id;
+  }
+
+  [[nodiscard]] constexpr auto index() const noexcept -> value_type
+  {
+    return mValue & index_mask;
+  }
+
+  [[nodiscard]] constexpr auto generation() const noexcept -> value_type
+  {
+    return mValue >> index_bits;
+  }
+
+  [[nodiscard]] constexpr auto value() const noexcept -> value_type { return mValue; }
+
+  /// Indicates whether the identifier isn't null, it may still refer to an erased value.
+  [[nodiscard]] constexpr explicit operator bool() const noexcept { return mValue != 0; }
+
+  [[nodiscard]] constexpr auto operator==(const slot_id other) const noexcept -> bool
+  {
+    return mValue == other.mValue;
+  }
+
+  [[nodiscard]] constexpr auto operator!=(const slot_id other) const noexcept -> bool
+  {
+    return mValue != other.mValue;
+  }
+
+ private:
+  value_type mValue {};
+};
+
+/**
+ * A container that stores values contiguously, and identifies them with generational ids.
+ *
+ * Values are stored in a dense array, so iterating over all values is as cache-friendly as
+ * iterating over a vector. Identifiers refer to values through an indirection table of slots,
+ * which makes lookups O(1), and makes it possible to detect identifiers of erased values. As
+ * a result, an identifier is a safe replacement for a pointer to a value, that is only four
+ * bytes large.
+ *
+ * \code{cpp}
+ * cen::slot_map<cen::texture> textures;
+ *
+ * const auto id = textures.insert(renderer.make_texture("hero.png"));
+ * if (auto* texture = textures.find(id)) {
+ *   renderer.render(*texture, position);
+ * }
+ * \endcode
+ *
+ * \details Erasing a value moves the last value into its position, so pointers to values and
+ *          the order of values are only stable as long as no values are erased. Identifiers
+ *          remain valid until their value is erased.
+ *
+ * \details Each slot can be reused 4095 times before its generation wraps around, at which
+ *          point very old identifiers of the slot would become valid again. At most 2^20 - 1
+ *          values can be stored at the same time.
+ *
+ * \tparam T the type of the stored values, must be move-constructible and move-assignable.
+ *
+ * \see slot_id
+ */
+template <typename T>
+class slot_map final {
+ public:
+  using value_type = T;
+  using id_type = slot_id<T>;
+  using size_type = usize;
+  using iterator = typename std::vector<T>::iterator;
+  using const_iterator = typename std::vector<T>::const_iterator;
+
+  /// The maximum amount of values that can be stored at the same time.
+  inline constexpr static size_type max_values = id_type::index_mask;
+
+  slot_map() = default;
+
+  /**
+   * Stores a value.
+   *
+   * \param value the value that will be stored.
+   *
+   * \return the identifier of the stored value.
+   *
+   * \throws exception if the slot map is full.
+   */
+  auto insert(value_type value) -> id_type { return emplace(std::move(value)); }
+
+  /**
+   * Creates a value in-place.
+   *
+   * \param args the arguments forwarded to a constructor of the value.
+   *
+   * \return the identifier of the created value.
+   *
+   * \throws exception if the slot map is full.
+   */
+  template <typename... Args>
+  auto emplace(Args&&... args) -> id_type
+  {
+    if (mValues.size() >= max_values) {
+      throw exception {"Slot map is full!"};
+    }
+
+    /* The value is created first, so a throwing constructor leaves the map untouched */
+    mValues.emplace_back(std::forward<Args>(args)...);
+
+    uint32 slotIndex {};
+    try {
+      mOwners.reserve(mValues.capacity());
+      slotIndex = acquire_slot();
+    }
+    catch (...) {
+      mValues.pop_back();
+      throw;
+    }
+
+    mOwners.push_back(slotIndex);  // Never reallocates, since the capacity was reserved
+
+    auto& slot = mSlots[slotIndex];
+    slot.dense = static_cast<uint32>(mValues.size() - 1u);
+
+    return id_type {slotIndex, slot.generation};
+  }
+
+  /**
+   * Replaces a stored value, e.g. to hot-swap a reloaded asset.
+   *
+   * \details The identifier remains valid, and keeps referring to the new value.
+   *
+   * \param id the identifier of the value that will be replaced.
+   * \param value the new value.
+   *
+   * \return `true` if the value was replaced; `false` if the identifier is invalid.
+   */
+  auto replace(const id_type id, value_type value) -> bool
+  {
+    if (auto* current = find(id)) {
+      *current = std::move(value);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Erases a value, and invalidates all of its identifiers.
+   *
+   * \param id the identifier of the value that will be erased.
+   *
+   * \return `true` if the value was erased; `false` if the identifier is invalid.
+   */
+  auto erase(const id_type id) -> bool
+  {
+    if (!contains(id)) {
+      return false;
+    }
+
+    auto& slot = mSlots[id.index()];
+    const auto dense = slot.dense;
+    const auto last = static_cast<uint32>(mValues.size() - 1u);
+
+    /* Move the last value into the gap, so the values stay contiguous */
+    if (dense != last) {
+      mValues[dense] = std::move(mValues.back());
+      mOwners[dense] = mOwners[last];
+      mSlots[mOwners[dense]].dense = dense;
+    }
+
+    mValues.pop_back();
+    mOwners.pop_back();
+
+    release_slot(id.index());
+    return true;
+  }
+
+  /// Erases all values, and invalidates all identifiers.
+  void clear() noexcept
+  {
+    for (const auto slotIndex : mOwners) {
+      release_slot(slotIndex);
+    }
+
+    mValues.clear();
+    mOwners.clear();
+  }
+
+  void reserve(const size_type count)
+  {
+    mValues.reserve(count);
+    mOwners.reserve(count);
+    mSlots.reserve(count);
+  }
+
+  /// Returns a pointer to a value; a null pointer if the identifier is invalid.
+  [[nodiscard]] auto find(const id_type id) noexcept -> value_type*
+  {
+    return contains(id) ? &mValues[mSlots[id.index()].dense] : nullptr;
+  }
+
+  /// Returns a pointer to a value; a null pointer if the identifier is invalid.
+  [[nodiscard]] auto find(const id_type id) const noexcept -> const value_type*
+  {
+    return contains(id) ? &mValues[mSlots[id.index()].dense] : nullptr;
+  }
+
+  /**
+   * Returns a value.
+   *
+   * \param id the identifier of the value.
+   *
+   * \return the identified value.
+   *
+   * \throws exception if the identifier is invalid.
+   */
+  [[nodiscard]] auto at(const id_type id) -> value_type&
+  {
+    if (auto* value = find(id)) {
+      return *value;
+    }
+    else {
+      throw exception {"Invalid slot map identifier!"};
+    }
+  }
+
+  /// See `at(id_type)`.
+  [[nodiscard]] auto at(const id_type id) const -> const value_type&
+  {
+    if (const auto* value = find(id)) {
+      return *value;
+    }
+    else {
+      throw exception {"Invalid slot map identifier!"};
+    }
+  }
+
+  /// Returns a value, without checking the identifier.
+  [[nodiscard]] auto operator[](const id_type id) noexcept -> value_type&
+  {
+    assert(contains(id));
+    return mValues[mSlots[id.index()].dense];
+  }
+
+  /// See `operator[](id_type)`.
+  [[nodiscard]] auto operator[](const id_type id) const noexcept -> const value_type&
+  {
+    assert(contains(id));
+    return mValues[mSlots[id.index()].dense];
+  }
+
+  /// Indicates whether an identifier refers to a stored value.
+  [[nodiscard]] auto contains(const id_type id) const noexcept -> bool
+  {
+    const auto index = id.index();
+    return id && index < mSlots.size() && mSlots[index].generation == id.generation() &&
+           mSlots[index].live;
+  }
+
+  /**
+   * Returns the identifier of the value at a position in the dense array.
+   *
+   * \details This is useful when iterating over the values, since the identifier of the
+   *          value at `begin() + n` is `id_at(n)`.
+   *
+   * \param position the position of the value, must be less than `size()`.
+   *
+   * \return the identifier of the value.
+   */
+  [[nodiscard]] auto id_at(const size_type position) const noexcept -> id_type
+  {
+    assert(position < mValues.size());
+
+    const auto slotIndex = mOwners[position];
+    return id_type {slotIndex, mSlots[slotIndex].generation};
+  }
+
+  /**
+   * Invokes a callable for each stored value, with its identifier.
+   *
+   * \param callable the function object invoked with an identifier and a reference to the
+   *                 value. The callable must not insert or erase values.
+   */
+  template <typename Callable>
+  void each(Callable&& callable)
+  {
+    for (size_type position = 0; position < mValues.size(); ++position) {
+      callable(id_at(position), mValues[position]);
+    }
+  }
+
+  /// See `each(Callable&&)`.
+  template <typename Callable>
+  void each(Callable&& callable) const
+  {
+    for (size_type position = 0; position < mValues.size(); ++position) {
+      callable(id_at(position), mValues[position]);
+    }
+  }
+
+  [[nodiscard]] auto begin() noexcept -> iterator { return mValues.begin(); }
+  [[nodiscard]] auto begin() const noexcept -> const_iterator { return mValues.begin(); }
+
+  [[nodiscard]] auto end() noexcept -> iterator { return mValues.end(); }
+  [[nodiscard]] auto end() const noexcept -> const_iterator { return mValues.end(); }
+
+  [[nodiscard]] auto data() noexcept -> value_type* { return mValues.data(); }
+  [[nodiscard]] auto data() const noexcept -> const value_type* { return mValues.data(); }
+
+  [[nodiscard]] auto size() const noexcept -> size_type { return mValues.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mValues.empty(); }
+
+ private:
+  inline constexpr static uint32 no_slot = ~uint32 {0};
+
+  struct slot final {
+    uint32 dense {};       ///< The dense index of the value, or the next free slot.
+    uint32 generation {};  ///< The current generation, never zero.
+    bool live {};
+  };
+
+  std::vector<value_type> mValues;
+  std::vector<uint32> mOwners;  ///< The slot indices of the values, in dense order.
+  std::vector<slot> mSlots;
+  uint32 mFreeHead {no_slot};
+
+  [[nodiscard]] auto acquire_slot() -> uint32
+  {
+    if (mFreeHead != no_slot) {
+      const auto index = mFreeHead;
+      mFreeHead = mSlots[index].dense;
+      mSlots[index].live = true;
+      return index;
+    }
+    else {
+      /* Slot zero is never used, so a null identifier can't refer to a value */
+      if (mSlots.empty()) {
+        mSlots.emplace_back();
+      }
+
+      mSlots.push_back(slot {0, 1, true});
+      return static_cast<uint32>(mSlots.size() - 1u);
+    }
+  }
+
+  void release_slot(const uint32 index) noexcept
+  {
+    auto& slot = mSlots[index];
+
+    slot.live = false;
+    slot.generation = (slot.generation == id_type::max_generation) ? 1u : slot.generation + 1u;
+    slot.dense = mFreeHead;
+
+    mFreeHead = index;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_COMMON_SLOT_MAP_HPP_
@@ -0,0 +1,348 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_COMMON_SPATIAL_HASH_HPP_
+#define CENTURION_COMMON_SPATIAL_HASH_HPP_
+
+#include <algorithm>      // find
+#include <cassert>        // assert
+#include <cmath>          // floor
+#include <type_traits>    // is_floating_point_v
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+#include "../detail/spatial_entries.hpp"
+#include "../detail/stdlib.hpp"
+#include "math.hpp"
+#include "primitives.hpp"
+
+namespace cen {
+
+/**
+ * A uniform grid broadphase that stores ids by their bounding rectangles.
+ *
+ * The space is divided into square cells, and each id is stored in every cell that its
+ * rectangle overlaps. Only cells that contain something are stored, in a hash map, so the
+ * grid is unbounded. This works best when most rectangles are about the size of a cell; use
+ * a quadtree for rectangles of very different sizes.
+ *
+ * Queries report each matching id exactly once, through a callable, and never allocate.
+ *
+ * \tparam T the representation type of the rectangles, i.e. `int` or `float`.
+ *
+ * \see basic_quadtree
+ */
+template <typename T>
+class basic_spatial_hash final {
+ public:
+  using value_type = T;
+  using rect_type = basic_rect<T>;
+  using point_type = basic_point<T>;
+  using id_type = uint32;
+
+  /**
+   * Creates an empty spatial hash.
+   *
+   * \param cellSize the width and height of the grid cells, must be greater than zero.
+   */
+  explicit basic_spatial_hash(const value_type cellSize) : mCellSize {cellSize}
+  {
+    assert(cellSize > 0);
+  }
+
+  /**
+   * Stores an id, replacing its rectangle if the id is already stored.
+   *
+   * \param id the id that will be stored.
+   * \param rect the bounding rectangle associated with the id.
+   */
+  void insert(const id_type id, const rect_type& rect)
+  {
+    if (const auto slot = mEntries.find(id)) {
+      unlink(*slot);
+      mEntries[*slot].rect = rect;
+      link(*slot);
+    }
+    else {
+      link(mEntries.add(id, rect));
+    }
+  }
+
+  /**
+   * Stores a range of ids.
+   *
+   * \param ids the ids that will be stored.
+   * \param rects the rectangles associated with the ids.
+   * \param count the amount of ids.
+   */
+  void insert(const id_type* ids, const rect_type* rects, const usize count)
+  {
+    assert(!count || (ids && rects));
+
+    mEntries.reserve(mEntries.size() + count);
+    for (usize index = 0; index < count; ++index) {
+      insert(ids[index], rects[index]);
+    }
+  }
+
+  /**
+   * Removes an id.
+   *
+   * \param id the id that will be removed.
+   *
+   * \return `true` if the id was removed; `false` if it wasn't stored.
+   */
+  auto remove(const id_type id) -> bool
+  {
+    if (const auto slot = mEntries.find(id)) {
+      unlink(*slot);
+      mEntries.remove(*slot);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Removes a range of ids.
+   *
+   * \param ids the ids that will be removed, ids that aren't stored are ignored.
+   * \param count the amount of ids.
+   *
+   * \return the amount of removed ids.
+   */
+  auto remove(const id_type* ids, const usize count) -> usize
+  {
+    assert(!count || ids);
+
+    usize removed = 0;
+    for (usize index = 0; index < count; ++index) {
+      removed += remove(ids[index]) ? 1u : 0u;
+    }
+
+    return removed;
+  }
+
+  /// Removes all ids, but keeps the cell storage for reuse.
+  void clear() noexcept
+  {
+    mEntries.clear();
+    for (auto& [key, cell] : mCells) {
+      cell.clear();
+    }
+  }
+
+  /**
+   * Invokes a callable for each id whose rectangle intersects a region.
+   *
+   * \param region the region that will be queried.
+   * \param callable the function object invoked with each matching id.
+   *
+   * \return the amount of matching ids.
+   */
+  template <typename Callable>
+  auto query(const rect_type& region, Callable&& callable) -> usize
+  {
+    const auto stamp = mEntries.next_stamp();
+    usize matches = 0;
+
+    const auto visit = [&](const std::vector<uint32>& cell) {
+      for (const auto slot : cell) {
+        auto& entry = mEntries[slot];
+        if (entry.stamp != stamp) {
+          entry.stamp = stamp;
+
+          if (intersects(entry.rect, region)) {
+            callable(entry.id);
+            ++matches;
+          }
+        }
+      }
+    };
+
+    const auto range = cells_of(region);
+
+    /* Large regions with few occupied cells are cheaper to scan through the occupied cells */
+    if (range.count() > static_cast<uint64>(mCells.size())) {
+      for (const auto& [key, cell] : mCells) {
+        if (range.contains(key)) {
+          visit(cell);
+        }
+      }
+    }
+    else {
+      for (auto y = range.minY; y <= range.maxY; ++y) {
+        for (auto x = range.minX; x <= range.maxX; ++x) {
+          if (const auto iter = mCells.find(cell_key(x, y)); iter != mCells.end()) {
+            visit(iter->second);
+          }
+        }
+      }
+    }
+
+    return matches;
+  }
+
+  /**
+   * Invokes a callable for each id whose rectangle contains a point.
+   *
+   * \param point the point that will be queried.
+   * \param callable the function object invoked with each matching id.
+   *
+   * \return the amount of matching ids.
+   */
+  template <typename Callable>
+  auto query(const point_type& point, Callable&& callable) const -> usize
+  {
+    usize matches = 0;
+
+    const auto key = cell_key(cell_of(point.x()), cell_of(point.y()));
+    if (const auto iter = mCells.find(key); iter != mCells.end()) {
+      for (const auto slot : iter->second) {
+        const auto& entry = mEntries[slot];
+        if (entry.rect.contains(point)) {
+          callable(entry.id);
+          ++matches;
+        }
+      }
+    }
+
+    return matches;
+  }
+
+  /// Indicates whether an id is stored.
+  [[nodiscard]] auto contains(const id_type id) const -> bool
+  {
+    return mEntries.find(id).has_value();
+  }
+
+  /// Returns the rectangle associated with an id, if the id is stored.
+  [[nodiscard]] auto get(const id_type id) const -> maybe<rect_type>
+  {
+    if (const auto slot = mEntries.find(id)) {
+      return mEntries[*slot].rect;
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Returns the amount of stored ids.
+  [[nodiscard]] auto size() const noexcept -> usize { return mEntries.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mEntries.size() == 0; }
+
+  [[nodiscard]] auto cell_size() const noexcept -> value_type { return mCellSize; }
+
+  /// Returns the amount of allocated cells, including cells that are currently empty.
+  [[nodiscard]] auto cell_count() const noexcept -> usize { return mCells.size(); }
+
+ private:
+  struct cell_range final {
+    int32 minX {};
+    int32 minY {};
+    int32 maxX {};
+    int32 maxY {};
+
+    [[nodiscard]] auto count() const noexcept -> uint64
+    {
+      return static_cast<uint64>(maxX - minX + 1) * static_cast<uint64>(maxY - minY + 1);
+    }
+
+    [[nodiscard]] auto contains(const uint64 key) const noexcept -> bool
+    {
+      const auto x = static_cast<int32>(static_cast<uint32>(key >> 32u));
+      const auto y = static_cast<int32>(static_cast<uint32>(key));
+      return x >= minX && x <= maxX && y >= minY && y <= maxY;
+    }
+  };
+
+  /* Cell coordinates are clamped, so that huge coordinates can't overflow the cell ranges */
+  inline static constexpr int32 max_cell = 1 << 28;
+
+  detail::spatial_entries<T> mEntries;
+  std::unordered_map<uint64, std::vector<uint32>> mCells;
+  value_type mCellSize;
+
+  [[nodiscard]] static auto cell_key(const int32 x, const int32 y) noexcept -> uint64
+  {
+    return (static_cast<uint64>(static_cast<uint32>(x)) << 32u) | static_cast<uint32>(y);
+  }
+
+  [[nodiscard]] auto cell_of(const value_type value) const noexcept -> int32
+  {
+    if constexpr (std::is_floating_point_v<value_type>) {
+      constexpr auto limit = static_cast<value_type>(max_cell);
+      const auto cell = std::floor(value / mCellSize);
+      return static_cast<int32>(detail::clamp(cell, -limit, limit));
+    }
+    else {
+      const auto quotient = value / mCellSize;
+      const auto cell = (value % mCellSize < 0) ? quotient - 1 : quotient;
+      return static_cast<int32>(detail::clamp<value_type>(cell, -max_cell, max_cell));
+    }
+  }
+
+  [[nodiscard]] auto cells_of(const rect_type& rect) const noexcept -> cell_range
+  {
+    return {cell_of(rect.x()),
+            cell_of(rect.y()),
+            cell_of(rect.max_x()),
+            cell_of(rect.max_y())};
+  }
+
+  void link(const uint32 slot)
+  {
+    const auto range = cells_of(mEntries[slot].rect);
+    for (auto y = range.minY; y <= range.maxY; ++y) {
+      for (auto x = range.minX; x <= range.maxX; ++x) {
+        mCells[cell_key(x, y)].push_back(slot);
+      }
+    }
+  }
+
+  void unlink(const uint32 slot)
+  {
+    const auto range = cells_of(mEntries[slot].rect);
+    for (auto y = range.minY; y <= range.maxY; ++y) {
+      for (auto x = range.minX; x <= range.maxX; ++x) {
+        if (const auto iter = mCells.find(cell_key(x, y)); iter != mCells.end()) {
+          auto& cell = iter->second;
+          if (const auto pos = std::find(cell.begin(), cell.end(), slot); pos != cell.end()) {
+            *pos = cell.back();
+            cell.pop_back();
+          }
+        }
+      }
+    }
+  }
+};
+
+using ispatial_hash = basic_spatial_hash<int>;
+using fspatial_hash = basic_spatial_hash<float>;
+
+}  // namespace cen
+
+#endif  // CENTURION_COMMON_SPATIAL_HASH_HPP_
@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+module;
+
+#include "centurion/concurrency.hpp"
+
+export module centurion:concurrency;
+
+export namespace cen {
+
+using cen::adaptive_mutex;
+
+using cen::latch;
+using cen::barrier;
+
+using cen::condition;
+
+#if CENTURION_HAS_FEATURE_COROUTINES
+using cen::task;
+using cen::next_frame;
+using cen::resume_on;
+using cen::run_on;
+using cen::upload_texture;
+using cen::read_file;
+#endif  // CENTURION_HAS_FEATURE_COROUTINES
+
+using cen::future;
+using cen::async;
+using cen::when_all;
+
+using cen::spsc_queue;
+using cen::mpmc_queue;
+using cen::blocking_queue;
+using cen::blocking_spsc_queue;
+using cen::blocking_mpmc_queue;
+
+using cen::scoped_lock;
+using cen::try_lock;
+
+using cen::main_thread_executor;
+
+using cen::lock_status;
+using cen::to_string;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::operator<<;
+
+#endif  // CENTURION_NO_IOSTREAM
+using cen::mutex;
+
+using cen::semaphore;
+
+using cen::shared_mutex;
+using cen::shared_lock;
+
+using cen::spin_lock;
+
+using cen::task_id;
+using cen::task_affinity;
+using cen::task_graph;
+
+using cen::task_queue;
+
+using cen::thread_id;
+using cen::thread_priority;
+using cen::thread;
+
+using cen::thread_local_storage;
+
+using cen::thread_pool;
+using cen::thread_pool_options;
+using cen::task_handle;
+
+}  // namespace cen
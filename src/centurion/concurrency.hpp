@@ -22,8 +22,20 @@
  * SOFTWARE.
  */
 
+#include "concurrency/adaptive_mutex.hpp"
+#include "concurrency/barrier.hpp"
 #include "concurrency/condition.hpp"
+#include "concurrency/coroutine.hpp"
+#include "concurrency/future.hpp"
+#include "concurrency/lock_free_queue.hpp"
 #include "concurrency/locks.hpp"
+#include "concurrency/main_thread_executor.hpp"
 #include "concurrency/mutex.hpp"
 #include "concurrency/semaphore.hpp"
-#include "concurrency/thread.hpp"
\ No newline at end of file
+#include "concurrency/shared_mutex.hpp"
+#include "concurrency/spin_lock.hpp"
+#include "concurrency/task_graph.hpp"
+#include "concurrency/task_queue.hpp"
+#include "concurrency/thread.hpp"
+#include "concurrency/thread_local_storage.hpp"
+#include "concurrency/thread_pool.hpp"
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_CONCURRENCY_ADAPTIVE_MUTEX_HPP_
+#define CENTURION_CONCURRENCY_ADAPTIVE_MUTEX_HPP_
+
+#include <SDL.h>
+
+#include <atomic>  // atomic, memory_order
+
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "condition.hpp"
+#include "mutex.hpp"
+#include "spin_lock.hpp"
+
+namespace cen {
+
+/**
+ * A non-recursive mutex that spins briefly before it puts the calling thread to sleep.
+ *
+ * Uncontended locking and unlocking only use atomic operations, and short contention is
+ * resolved by spinning. Only threads that fail to acquire the lock while spinning park on an
+ * internal `mutex` and `condition`, so the kernel is only involved when it has to be.
+ *
+ * \see scoped_lock
+ * \see try_lock
+ * \see spin_lock
+ */
+class adaptive_mutex final {
+ public:
+  /**
+   * Creates an unlocked mutex.
+   *
+   * \param spins the amount of attempts to acquire the lock before sleeping.
+   *
+   * \throws sdl_error if the internal mutex or condition cannot be created.
+   */
+  explicit adaptive_mutex(const int spins = 128) : mSpins {spins}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(adaptive_mutex)
+  CENTURION_DISABLE_MOVE(adaptive_mutex)
+
+  /// Locks the mutex, spinning and then blocking if the mutex isn't available.
+  auto lock() noexcept -> result
+  {
+    for (int spin = 0; spin < mSpins; ++spin) {
+      if (try_acquire()) {
+        return success;
+      }
+
+      detail::cpu_pause();
+    }
+
+    if (!mParking.lock()) {
+      return failure;
+    }
+
+    /* Mark the lock as contended, so that the owner wakes us up when it unlocks */
+    while (mState.exchange(contended, std::memory_order_acquire) != unlocked) {
+      mWake.wait(mParking);
+    }
+
+    mParking.unlock();
+    return success;
+  }
+
+  /// Attempts to lock the mutex and returns immediately.
+  auto try_lock() noexcept -> lock_status
+  {
+    return try_acquire() ? lock_status::success : lock_status::timed_out;
+  }
+
+  auto unlock() noexcept -> result
+  {
+    if (mState.exchange(unlocked, std::memory_order_release) == contended) {
+      if (!mParking.lock()) {
+        return failure;
+      }
+
+      const auto signaled = mWake.signal();
+      mParking.unlock();
+
+      return signaled;
+    }
+
+    return success;
+  }
+
+  /// Returns the amount of attempts to acquire the lock before sleeping.
+  [[nodiscard]] auto spins() const noexcept -> int { return mSpins; }
+
+ private:
+  inline constexpr static int unlocked = 0;
+  inline constexpr static int locked = 1;
+  inline constexpr static int contended = 2;
+
+  std::atomic<int> mState {unlocked};
+  int mSpins {};
+  mutex mParking;
+  condition mWake;
+
+  [[nodiscard]] auto try_acquire() noexcept -> bool
+  {
+    auto expected = unlocked;
+    return mState.load(std::memory_order_relaxed) == unlocked &&
+           mState.compare_exchange_weak(expected,
+                                        locked,
+                                        std::memory_order_acquire,
+                                        std::memory_order_relaxed);
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_ADAPTIVE_MUTEX_HPP_
@@ -0,0 +1,308 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_CONCURRENCY_BARRIER_HPP_
+#define CENTURION_CONCURRENCY_BARRIER_HPP_
+
+#include <SDL.h>
+
+#include <atomic>  // atomic, memory_order
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "condition.hpp"
+#include "mutex.hpp"
+#include "spin_lock.hpp"
+#include "thread_pool.hpp"
+
+namespace cen {
+namespace detail {
+
+/* Spins and then parks until a condition holds. The notifier must update the state that the
+   condition depends on before calling notify(), which only involves the kernel if a thread
+   has actually parked. */
+class park_lot final {
+ public:
+  template <typename Done>
+  void wait_until(const int spins, Done&& done) noexcept
+  {
+    for (int spin = 0; spin < spins; ++spin) {
+      if (done()) {
+        return;
+      }
+
+      detail::cpu_pause();
+    }
+
+    if (!mLock.lock()) {
+      return;
+    }
+
+    /* The waiter count and the state are both sequentially consistent, so either the notifier
+       sees the waiter, or the waiter sees the updated state */
+    mWaiters.fetch_add(1);
+    while (!done()) {
+      mWake.wait(mLock);
+    }
+    mWaiters.fetch_sub(1);
+
+    mLock.unlock();
+  }
+
+  /* Executes tasks of the pool while waiting, if the calling thread is one of its workers */
+  template <typename Done>
+  void help_until(thread_pool& pool, const int spins, Done&& done)
+  {
+    if (!pool.is_worker_thread()) {
+      wait_until(spins, done);
+      return;
+    }
+
+    while (!done()) {
+      if (!pool.run_pending_task()) {
+        SDL_Delay(0);
+      }
+    }
+  }
+
+  void notify() noexcept
+  {
+    if (mWaiters.load() != 0 && mLock.lock()) {
+      mWake.broadcast();
+      mLock.unlock();
+    }
+  }
+
+ private:
+  std::atomic<usize> mWaiters {};
+  mutex mLock;
+  condition mWake;
+};
+
+}  // namespace detail
+
+/**
+ * A single-use counter that threads can wait on until it reaches zero.
+ *
+ * Waiting threads spin briefly before they park, and the kernel is only involved if a thread
+ * has parked by the time the counter reaches zero. Workers of a thread pool can wait with
+ * `wait(pool)`, which executes pending tasks of the pool instead of blocking the worker.
+ *
+ * \see barrier
+ */
+class latch final {
+ public:
+  /**
+   * Creates a latch.
+   *
+   * \param count the initial value of the counter.
+   * \param spins the amount of times waiting threads check the counter before parking.
+   *
+   * \throws sdl_error if the internal mutex or condition cannot be created.
+   */
+  explicit latch(const usize count, const int spins = 128) : mCount {count}, mSpins {spins} {}
+
+  CENTURION_DISABLE_COPY(latch)
+  CENTURION_DISABLE_MOVE(latch)
+
+  /**
+   * Decrements the counter, and releases the waiting threads if it reaches zero.
+   *
+   * \pre The counter must be at least as large as the decrement.
+   *
+   * \param n the amount to subtract from the counter.
+   */
+  void count_down(const usize n = 1) noexcept
+  {
+    if (mCount.fetch_sub(n) == n) {
+      mLot.notify();
+    }
+  }
+
+  /// Blocks until the counter reaches zero.
+  void wait() noexcept
+  {
+    mLot.wait_until(mSpins, [this] { return try_wait(); });
+  }
+
+  /**
+   * Waits until the counter reaches zero, executing tasks if called by a pool worker.
+   *
+   * \param pool the pool whose tasks are executed while waiting, if the calling thread is one
+   *             of its workers. Otherwise, this is equivalent to `wait()`.
+   */
+  void wait(thread_pool& pool)
+  {
+    mLot.help_until(pool, mSpins, [this] { return try_wait(); });
+  }
+
+  /// Decrements the counter, and then waits until it reaches zero.
+  void arrive_and_wait(const usize n = 1) noexcept
+  {
+    count_down(n);
+    wait();
+  }
+
+  /// Indicates whether the counter has reached zero.
+  [[nodiscard]] auto try_wait() const noexcept -> bool { return mCount.load() == 0; }
+
+  /// Returns the current value of the counter.
+  [[nodiscard]] auto count() const noexcept -> usize
+  {
+    return mCount.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<usize> mCount;
+  int mSpins {};
+  detail::park_lot mLot;
+};
+
+/**
+ * A reusable synchronisation point for a fixed group of threads.
+ *
+ * Each phase completes when all participants have arrived, which releases the waiting
+ * participants and starts the next phase. This is useful to separate frame phases, e.g. to
+ * ensure that all simulation chunks are finished before culling starts.
+ *
+ * Waiting participants spin briefly before they park, and the kernel is only involved if a
+ * participant has parked by the time the phase completes. Pool workers can wait with
+ * `arrive_and_wait(pool)`, which executes pending tasks of the pool instead of blocking.
+ *
+ * \see latch
+ */
+class barrier final {
+ public:
+  using phase_type = uint64;
+
+  /**
+   * Creates a barrier.
+   *
+   * \param participants the amount of threads that must arrive to complete each phase.
+   * \param spins the amount of times waiting threads check the phase before parking.
+   *
+   * \throws exception if there are no participants.
+   * \throws sdl_error if the internal mutex or condition cannot be created.
+   */
+  explicit barrier(const usize participants, const int spins = 128)
+      : mParticipants {participants}
+      , mRemaining {participants}
+      , mSpins {spins}
+  {
+    if (participants == 0) {
+      throw exception {"Cannot create barrier without participants!"};
+    }
+  }
+
+  CENTURION_DISABLE_COPY(barrier)
+  CENTURION_DISABLE_MOVE(barrier)
+
+  /**
+   * Arrives at the barrier, and waits for the other participants.
+   *
+   * \return the phase that was completed.
+   */
+  auto arrive_and_wait() noexcept -> phase_type
+  {
+    const auto phase = mPhase.load(std::memory_order_acquire);
+    if (!arrive()) {
+      mLot.wait_until(mSpins, [this, phase] { return is_past(phase); });
+    }
+
+    return phase;
+  }
+
+  /**
+   * Arrives at the barrier, and executes pending tasks while waiting if called by a worker.
+   *
+   * \details The executed tasks must not wait at the same barrier, since this participant
+   *          can't continue until those tasks have finished.
+   *
+   * \param pool the pool whose tasks are executed while waiting, if the calling thread is one
+   *             of its workers. Otherwise, this is equivalent to `arrive_and_wait()`.
+   *
+   * \return the phase that was completed.
+   */
+  auto arrive_and_wait(thread_pool& pool) -> phase_type
+  {
+    const auto phase = mPhase.load(std::memory_order_acquire);
+    if (!arrive()) {
+      mLot.help_until(pool, mSpins, [this, phase] { return is_past(phase); });
+    }
+
+    return phase;
+  }
+
+  /// Arrives at the barrier without waiting, and leaves the group for subsequent phases.
+  void arrive_and_drop() noexcept
+  {
+    mParticipants.fetch_sub(1);
+    arrive();
+  }
+
+  /// Returns the amount of completed phases.
+  [[nodiscard]] auto phase() const noexcept -> phase_type
+  {
+    return mPhase.load(std::memory_order_acquire);
+  }
+
+  /// Returns the amount of participants in subsequent phases.
+  [[nodiscard]] auto participants() const noexcept -> usize
+  {
+    return mParticipants.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::atomic<usize> mParticipants;
+  std::atomic<usize> mRemaining;
+  std::atomic<phase_type> mPhase {};
+  int mSpins {};
+  detail::park_lot mLot;
+
+  [[nodiscard]] auto is_past(const phase_type phase) const noexcept -> bool
+  {
+    return mPhase.load() != phase;
+  }
+
+  /* Returns true if the calling thread completed the phase */
+  auto arrive() noexcept -> bool
+  {
+    if (mRemaining.fetch_sub(1) != 1) {
+      return false;
+    }
+
+    /* The remaining count is reset before the next phase is published, so that participants
+       can't arrive early at the next phase */
+    mRemaining.store(mParticipants.load());
+    mPhase.fetch_add(1);
+    mLot.notify();
+
+    return true;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_BARRIER_HPP_
@@ -0,0 +1,430 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_CONCURRENCY_COROUTINE_HPP_
+#define CENTURION_CONCURRENCY_COROUTINE_HPP_
+
+#include "../features.hpp"
+
+#if CENTURION_HAS_FEATURE_COROUTINES
+
+#include <SDL.h>
+
+#include <atomic>       // atomic
+#include <cassert>      // assert
+#include <coroutine>    // coroutine_handle, suspend_always, noop_coroutine
+#include <exception>    // exception_ptr, current_exception, rethrow_exception
+#include <string>       // string
+#include <type_traits>  // decay_t, invoke_result_t, is_void_v
+#include <utility>      // move, forward, exchange
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "future.hpp"
+#include "task_queue.hpp"
+#include "thread_pool.hpp"
+
+namespace cen {
+
+template <typename T = void>
+class task;
+
+namespace detail {
+
+class task_promise_base {
+ public:
+  struct final_awaiter final {
+    [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+    template <typename Promise>
+    auto await_suspend(std::coroutine_handle<Promise> handle) noexcept
+        -> std::coroutine_handle<>
+    {
+      auto& promise = handle.promise();
+      const auto next = promise.mContinuation;
+
+      /* The frame may be destroyed by another thread as soon as the task is marked as done */
+      promise.mDone.store(true, std::memory_order_release);
+
+      if (next) {
+        return next;
+      }
+      else {
+        return std::noop_coroutine();
+      }
+    }
+
+    void await_resume() const noexcept {}
+  };
+
+  [[nodiscard]] auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
+
+  [[nodiscard]] auto final_suspend() const noexcept -> final_awaiter { return {}; }
+
+  void unhandled_exception() noexcept { mError = std::current_exception(); }
+
+  void set_continuation(const std::coroutine_handle<> continuation) noexcept
+  {
+    mContinuation = continuation;
+  }
+
+  void rethrow_if_failed() const
+  {
+    if (mError) {
+      std::rethrow_exception(mError);
+    }
+  }
+
+  [[nodiscard]] auto is_done() const noexcept -> bool
+  {
+    return mDone.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::coroutine_handle<> mContinuation;
+  std::exception_ptr mError;
+  std::atomic<bool> mDone {false};
+};
+
+template <typename T>
+class task_promise final : public task_promise_base {
+ public:
+  [[nodiscard]] auto get_return_object() noexcept -> task<T>;
+
+  template <typename U>
+  void return_value(U&& value)
+  {
+    mValue.emplace(std::forward<U>(value));
+  }
+
+  [[nodiscard]] auto take() -> T
+  {
+    rethrow_if_failed();
+    assert(mValue);
+    return std::move(*mValue);
+  }
+
+ private:
+  maybe<T> mValue;
+};
+
+template <>
+class task_promise<void> final : public task_promise_base {
+ public:
+  [[nodiscard]] auto get_return_object() noexcept -> task<void>;
+
+  void return_void() const noexcept {}
+
+  void take() const { rethrow_if_failed(); }
+};
+
+/// Resumes the awaiting coroutine on an executor.
+template <typename Executor>
+class resume_awaiter final {
+ public:
+  explicit resume_awaiter(Executor& executor) noexcept : mExecutor {&executor}
+  {
+  }
+
+  [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+  void await_suspend(const std::coroutine_handle<> handle)
+  {
+    schedule(*mExecutor, [handle] { handle.resume(); });
+  }
+
+  void await_resume() const noexcept {}
+
+ private:
+  Executor* mExecutor {};
+};
+
+/// Invokes a function object on an executor and resumes the awaiting coroutine there.
+template <typename Executor, typename Callable>
+class invoke_awaiter final {
+ public:
+  using result_type = std::invoke_result_t<Callable&>;
+
+  invoke_awaiter(Executor& executor, Callable callable)
+      : mExecutor {&executor}
+      , mCallable {std::move(callable)}
+  {
+  }
+
+  [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+  void await_suspend(const std::coroutine_handle<> handle)
+  {
+    schedule(*mExecutor, [this, handle] {
+      try {
+        if constexpr (std::is_void_v<result_type>) {
+          mCallable();
+        }
+        else {
+          mResult.emplace(mCallable());
+        }
+      }
+      catch (...) {
+        mError = std::current_exception();
+      }
+
+      handle.resume();
+    });
+  }
+
+  auto await_resume() -> result_type
+  {
+    if (mError) {
+      std::rethrow_exception(mError);
+    }
+
+    if constexpr (!std::is_void_v<result_type>) {
+      return std::move(*mResult);
+    }
+  }
+
+ private:
+  Executor* mExecutor {};
+  Callable mCallable;
+  maybe<future_value_t<result_type>> mResult;
+  std::exception_ptr mError;
+};
+
+}  // namespace detail
+
+/**
+ * A lazily started coroutine that produces a value.
+ *
+ * Tasks don't run until they are either awaited by another task, or started explicitly with
+ * `start()`. Awaiting a task resumes the awaiting coroutine once the task has finished, on
+ * whatever thread finished it. Combine tasks with `next_frame()`, `resume_on()` and
+ * `run_on()` to spread work across frames and threads without writing state machines.
+ *
+ * A task that was started explicitly must outlive its execution, so keep it around until
+ * `is_done()` returns `true`.
+ *
+ * \tparam T the type of the produced value, may be `void`.
+ */
+template <typename T>
+class task final {
+ public:
+  using value_type = T;
+  using promise_type = detail::task_promise<T>;
+  using handle_type = std::coroutine_handle<promise_type>;
+
+  task() noexcept = default;
+
+  explicit task(const handle_type handle) noexcept : mHandle {handle}
+  {
+  }
+
+  task(task&& other) noexcept : mHandle {std::exchange(other.mHandle, {})}
+  {
+  }
+
+  auto operator=(task&& other) noexcept -> task&
+  {
+    if (this != &other) {
+      destroy();
+      mHandle = std::exchange(other.mHandle, {});
+    }
+
+    return *this;
+  }
+
+  CENTURION_DISABLE_COPY(task)
+
+  ~task() noexcept { destroy(); }
+
+  /// Executes the task on the calling thread until it first suspends.
+  void start()
+  {
+    assert(mHandle);
+    mHandle.resume();
+  }
+
+  /**
+   * Returns the produced value of a finished task.
+   *
+   * \throws any exception that escaped the coroutine.
+   */
+  auto get() -> T
+  {
+    assert(is_done());
+    return mHandle.promise().take();
+  }
+
+  /// Indicates whether the task has finished executing.
+  [[nodiscard]] auto is_done() const noexcept -> bool
+  {
+    return mHandle && mHandle.promise().is_done();
+  }
+
+  /// Indicates whether the task refers to a coroutine.
+  [[nodiscard]] auto valid() const noexcept -> bool { return static_cast<bool>(mHandle); }
+
+  [[nodiscard]] auto operator co_await() && noexcept
+  {
+    struct awaiter final {
+      handle_type handle;
+
+      [[nodiscard]] auto await_ready() const noexcept -> bool { return false; }
+
+      auto await_suspend(const std::coroutine_handle<> continuation) noexcept
+          -> std::coroutine_handle<>
+      {
+        handle.promise().set_continuation(continuation);
+        return handle;
+      }
+
+      auto await_resume() -> T { return handle.promise().take(); }
+    };
+
+    assert(mHandle);
+    return awaiter {mHandle};
+  }
+
+ private:
+  handle_type mHandle;
+
+  void destroy() noexcept
+  {
+    if (mHandle) {
+      mHandle.destroy();
+      mHandle = nullptr;
+    }
+  }
+};
+
+namespace detail {
+
+template <typename T>
+auto task_promise<T>::get_return_object() noexcept -> task<T>
+{
+  return task<T> {std::coroutine_handle<task_promise<T>>::from_promise(*this)};
+}
+
+inline auto task_promise<void>::get_return_object() noexcept -> task<void>
+{
+  return task<void> {std::coroutine_handle<task_promise<void>>::from_promise(*this)};
+}
+
+}  // namespace detail
+
+/**
+ * Returns an awaitable that resumes the coroutine the next time a task queue is drained.
+ *
+ * If the queue is drained once per frame by the main thread, `co_await next_frame(queue)`
+ * continues the coroutine on the main thread in the next frame.
+ */
+[[nodiscard]] inline auto next_frame(task_queue& queue) noexcept
+    -> detail::resume_awaiter<task_queue>
+{
+  return detail::resume_awaiter<task_queue> {queue};
+}
+
+/**
+ * Returns an awaitable that resumes the coroutine on an executor.
+ *
+ * E.g. `co_await resume_on(executor)` with a `main_thread_executor` continues a coroutine
+ * that runs on a thread pool on the main thread.
+ *
+ * \param executor the `thread_pool`, `task_queue` or `main_thread_executor`.
+ */
+template <typename Executor>
+[[nodiscard]] auto resume_on(Executor& executor) noexcept -> detail::resume_awaiter<Executor>
+{
+  return detail::resume_awaiter<Executor> {executor};
+}
+
+/**
+ * Returns an awaitable that invokes a function object on an executor.
+ *
+ * The coroutine is resumed on the executor with the result of the function object, or with
+ * the exception that it threw.
+ *
+ * \param executor the `thread_pool`, `task_queue` or `main_thread_executor` that will
+ *        invoke the function object.
+ * \param callable the function object, with signature `R()`.
+ */
+template <typename Executor, typename Callable>
+[[nodiscard]] auto run_on(Executor& executor, Callable&& callable)
+    -> detail::invoke_awaiter<Executor, std::decay_t<Callable>>
+{
+  return {executor, std::forward<Callable>(callable)};
+}
+
+/**
+ * Returns an awaitable that creates a texture from a surface on the thread that drains a
+ * task queue, which should be the thread that owns the renderer.
+ *
+ * The renderer and surface must stay alive until the coroutine is resumed.
+ *
+ * \param queue the task queue drained by the renderer thread.
+ * \param renderer the renderer that will create the texture.
+ * \param surface the surface that will be uploaded.
+ */
+template <typename Renderer, typename Surface>
+[[nodiscard]] auto upload_texture(task_queue& queue,
+                                  Renderer& renderer,
+                                  const Surface& surface)
+{
+  return run_on(queue, [&renderer, &surface] { return renderer.make_texture(surface); });
+}
+
+/**
+ * Returns an awaitable that reads an entire file on a thread pool.
+ *
+ * The coroutine is resumed on a pool worker, use `next_frame()` to get back to the main
+ * thread afterwards.
+ *
+ * \param pool the thread pool that will read the file.
+ * \param path the path of the file.
+ *
+ * \throws sdl_error (when awaited) if the file cannot be read.
+ */
+[[nodiscard]] inline auto read_file(thread_pool& pool, std::string path)
+{
+  return run_on(pool, [path = std::move(path)] {
+    usize size {};
+    auto* data = static_cast<uint8*>(SDL_LoadFile(path.c_str(), &size));
+
+    if (!data) {
+      throw sdl_error {};
+    }
+
+    std::vector<uint8> contents(data, data + size);
+    SDL_free(data);
+
+    return contents;
+  });
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_HAS_FEATURE_COROUTINES
+
+#endif  // CENTURION_CONCURRENCY_COROUTINE_HPP_
@@ -0,0 +1,478 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_CONCURRENCY_FUTURE_HPP_
+#define CENTURION_CONCURRENCY_FUTURE_HPP_
+
+#include <SDL.h>
+
+#include <atomic>       // atomic
+#include <cassert>      // assert
+#include <exception>    // exception_ptr, current_exception, rethrow_exception
+#include <functional>   // function
+#include <memory>       // shared_ptr, make_shared, unique_ptr, make_unique
+#include <type_traits>  // conditional_t, decay_t, invoke_result_t, is_void_v
+#include <utility>      // move, forward
+#include <variant>      // monostate
+#include <vector>       // vector
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "locks.hpp"
+#include "semaphore.hpp"
+#include "spin_lock.hpp"
+#include "task_queue.hpp"
+#include "thread_pool.hpp"
+
+namespace cen {
+
+template <typename T>
+class future;
+
+namespace detail {
+
+template <typename T>
+using future_value_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+/// The shared state of a future, completed exactly once with either a value or an error.
+template <typename T>
+class future_state final {
+ public:
+  explicit future_state(thread_pool* pool) noexcept : mPool {pool}
+  {
+  }
+
+  void set_value(future_value_t<T> value)
+  {
+    mValue.emplace(std::move(value));
+    complete();
+  }
+
+  void set_error(std::exception_ptr error)
+  {
+    mError = std::move(error);
+    complete();
+  }
+
+  /// Invokes a callback once the state is ready, immediately if it already is.
+  void on_ready(std::function<void()> callback)
+  {
+    {
+      scoped_lock lock {mLock};
+      if (!mReady.load(std::memory_order_relaxed)) {
+        mCallbacks.push_back(std::move(callback));
+        return;
+      }
+    }
+
+    callback();
+  }
+
+  /**
+   * Blocks until the state is ready.
+   *
+   * Pool workers help executing pending tasks instead of blocking, since the value they
+   * wait for might be produced by a task in the queue of the very same worker.
+   */
+  void wait()
+  {
+    if (is_ready()) {
+      return;
+    }
+
+    if (mPool && mPool->is_worker_thread()) {
+      while (!is_ready()) {
+        if (!mPool->run_pending_task()) {
+          SDL_Delay(0);
+        }
+      }
+
+      return;
+    }
+
+    semaphore* waiter {};
+
+    {
+      scoped_lock lock {mLock};
+      if (mReady.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      if (!mWaiter) {
+        mWaiter = std::make_unique<semaphore>(0u);
+      }
+
+      ++mWaiting;
+      waiter = mWaiter.get();
+    }
+
+    waiter->acquire();
+  }
+
+  /// Moves the value out of the state, which must be ready and hold a value.
+  [[nodiscard]] auto take() -> future_value_t<T>
+  {
+    assert(is_ready());
+    assert(mValue);
+    return std::move(*mValue);
+  }
+
+  [[nodiscard]] auto error() const noexcept -> const std::exception_ptr& { return mError; }
+
+  [[nodiscard]] auto is_ready() const noexcept -> bool
+  {
+    return mReady.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] auto pool() const noexcept -> thread_pool* { return mPool; }
+
+ private:
+  thread_pool* mPool {};
+  maybe<future_value_t<T>> mValue;
+  std::exception_ptr mError;
+
+  spin_lock mLock;  ///< Protects the callbacks and waiters.
+  std::atomic<bool> mReady {false};
+  std::vector<std::function<void()>> mCallbacks;
+  std::unique_ptr<semaphore> mWaiter;  ///< Only created if a thread has to block.
+  uint32 mWaiting {};
+
+  void complete()
+  {
+    std::vector<std::function<void()>> callbacks;
+    uint32 waiting {};
+
+    {
+      scoped_lock lock {mLock};
+      assert(!mReady.load(std::memory_order_relaxed));
+
+      mReady.store(true, std::memory_order_release);
+      callbacks = std::move(mCallbacks);
+      waiting = mWaiting;
+    }
+
+    /* No more waiters can register once the state is ready */
+    for (uint32 index = 0; index < waiting; ++index) {
+      mWaiter->release();
+    }
+
+    for (auto& callback : callbacks) {
+      callback();
+    }
+  }
+};
+
+/// Completes a future state with the result of a function object, or the exception it threw.
+template <typename T, typename Callable>
+void fulfil(future_state<T>& state, Callable& callable)
+{
+  maybe<future_value_t<T>> value;
+
+  try {
+    if constexpr (std::is_void_v<T>) {
+      callable();
+      value.emplace();
+    }
+    else {
+      value.emplace(callable());
+    }
+  }
+  catch (...) {
+    state.set_error(std::current_exception());
+    return;
+  }
+
+  state.set_value(std::move(*value));
+}
+
+template <typename Callable>
+void schedule(thread_pool& pool, Callable&& callable)
+{
+  pool.submit(std::forward<Callable>(callable));
+}
+
+/* Any other executor, e.g. a task_queue or a main_thread_executor, that provides post() */
+template <typename Executor, typename Callable>
+void schedule(Executor& executor, Callable&& callable)
+{
+  executor.post(std::forward<Callable>(callable));
+}
+
+template <typename T, typename Callable>
+struct continuation_result final {
+  using type = std::invoke_result_t<Callable&, T>;
+};
+
+template <typename Callable>
+struct continuation_result<void, Callable> final {
+  using type = std::invoke_result_t<Callable&>;
+};
+
+template <typename T, typename Callable>
+using continuation_result_t = typename continuation_result<T, std::decay_t<Callable>>::type;
+
+struct future_access final {
+  template <typename T>
+  [[nodiscard]] static auto make(std::shared_ptr<future_state<T>> state) -> future<T>
+  {
+    return future<T> {std::move(state)};
+  }
+
+  template <typename T>
+  [[nodiscard]] static auto release(future<T>& future) -> std::shared_ptr<future_state<T>>
+  {
+    return std::move(future.mState);
+  }
+};
+
+}  // namespace detail
+
+/**
+ * Represents a value that will be produced asynchronously.
+ *
+ * Futures are created by `async()` and `when_all()`, and can be chained with `then()`, which
+ * schedules a continuation on a thread pool or on a task queue once the value is ready. Like
+ * `std::future`, the value can only be consumed once, either by `get()` or by `then()`.
+ *
+ * \tparam T the type of the produced value, may be `void`.
+ *
+ * \see async()
+ * \see when_all()
+ */
+template <typename T>
+class future final {
+ public:
+  using value_type = T;
+
+  future() noexcept = default;
+
+  /**
+   * Waits for the value and returns it, invalidating the future.
+   *
+   * \return the produced value.
+   *
+   * \throws any exception that was thrown while producing the value.
+   */
+  auto get() -> T
+  {
+    assert(valid());
+    mState->wait();
+
+    const auto state = std::move(mState);
+    if (state->error()) {
+      std::rethrow_exception(state->error());
+    }
+
+    if constexpr (!std::is_void_v<T>) {
+      return state->take();
+    }
+  }
+
+  /// Blocks until the value is ready, without consuming it.
+  void wait() const
+  {
+    assert(valid());
+    mState->wait();
+  }
+
+  /**
+   * Schedules a continuation on the thread pool of the future, invalidating the future.
+   *
+   * \param callable the function object invoked with the value, or without arguments if the
+   *        value type is `void`.
+   *
+   * \return a future for the result of the continuation. If the future failed, the returned
+   *         future fails with the same exception without invoking the continuation.
+   */
+  template <typename Callable>
+  auto then(Callable&& callable) -> future<detail::continuation_result_t<T, Callable>>
+  {
+    assert(valid());
+    assert(mState->pool());
+    return then(*mState->pool(), std::forward<Callable>(callable));
+  }
+
+  /**
+   * Schedules a continuation on an executor, invalidating the future.
+   *
+   * Use a `task_queue` or a `main_thread_executor` that is drained by the main thread for
+   * continuations that must run on the main thread, such as texture uploads.
+   *
+   * \param executor the `thread_pool`, `task_queue` or `main_thread_executor` that will
+   *        execute the continuation.
+   * \param callable the function object invoked with the value, or without arguments if the
+   *        value type is `void`.
+   *
+   * \return a future for the result of the continuation.
+   */
+  template <typename Executor, typename Callable>
+  auto then(Executor& executor, Callable&& callable)
+      -> future<detail::continuation_result_t<T, Callable>>
+  {
+    using result_type = detail::continuation_result_t<T, Callable>;
+
+    assert(valid());
+
+    auto parent = std::move(mState);
+    auto child = std::make_shared<detail::future_state<result_type>>(parent->pool());
+
+    auto task = [parent, child, fn = std::decay_t<Callable> {std::forward<Callable>(
+                                    callable)}]() mutable {
+      if (parent->error()) {
+        child->set_error(parent->error());
+        return;
+      }
+
+      auto invoke = [&]() -> result_type {
+        if constexpr (std::is_void_v<T>) {
+          return fn();
+        }
+        else {
+          return fn(parent->take());
+        }
+      };
+
+      detail::fulfil(*child, invoke);
+    };
+
+    auto* target = &executor;
+    parent->on_ready([target, task = std::move(task)] { detail::schedule(*target, task); });
+
+    return detail::future_access::make(std::move(child));
+  }
+
+  /// Indicates whether the future refers to a value, i.e. it hasn't been consumed.
+  [[nodiscard]] auto valid() const noexcept -> bool { return mState != nullptr; }
+
+  /// Indicates whether the value (or an error) is available.
+  [[nodiscard]] auto is_ready() const noexcept -> bool
+  {
+    assert(valid());
+    return mState->is_ready();
+  }
+
+ private:
+  friend struct detail::future_access;
+
+  std::shared_ptr<detail::future_state<T>> mState;
+
+  explicit future(std::shared_ptr<detail::future_state<T>> state) noexcept
+      : mState {std::move(state)}
+  {
+  }
+};
+
+/**
+ * Executes a function object on a thread pool.
+ *
+ * \param pool the thread pool that will execute the function object.
+ * \param callable the function object, with signature `R()`.
+ *
+ * \return a future for the result of the function object.
+ */
+template <typename Callable>
+auto async(thread_pool& pool, Callable&& callable)
+    -> future<std::invoke_result_t<std::decay_t<Callable>&>>
+{
+  using result_type = std::invoke_result_t<std::decay_t<Callable>&>;
+
+  auto state = std::make_shared<detail::future_state<result_type>>(&pool);
+  auto fn = std::decay_t<Callable> {std::forward<Callable>(callable)};
+
+  pool.submit([state, fn = std::move(fn)]() mutable { detail::fulfil(*state, fn); });
+
+  return detail::future_access::make(std::move(state));
+}
+
+/**
+ * Creates a future that is ready once all of the supplied futures are ready.
+ *
+ * \param futures the futures that will be waited for, all of which are invalidated.
+ *
+ * \return a future for the values of all futures, in the same order. If any future failed,
+ *         the returned future fails with the exception of the first failed future.
+ */
+template <typename T>
+auto when_all(std::vector<future<T>> futures)
+    -> future<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>
+{
+  using result_type = std::conditional_t<std::is_void_v<T>, void, std::vector<T>>;
+
+  struct join_state final {
+    std::vector<std::shared_ptr<detail::future_state<T>>> parents;
+    std::atomic<usize> remaining {};
+  };
+
+  auto shared = std::make_shared<join_state>();
+  for (auto& future : futures) {
+    assert(future.valid());
+    shared->parents.push_back(detail::future_access::release(future));
+  }
+
+  auto* pool = shared->parents.empty() ? nullptr : shared->parents.front()->pool();
+  auto child = std::make_shared<detail::future_state<result_type>>(pool);
+
+  const auto complete = [](join_state& state, detail::future_state<result_type>& result) {
+    for (const auto& parent : state.parents) {
+      if (parent->error()) {
+        result.set_error(parent->error());
+        return;
+      }
+    }
+
+    if constexpr (std::is_void_v<T>) {
+      result.set_value(std::monostate {});
+    }
+    else {
+      std::vector<T> values;
+      values.reserve(state.parents.size());
+
+      for (const auto& parent : state.parents) {
+        values.push_back(parent->take());
+      }
+
+      result.set_value(std::move(values));
+    }
+  };
+
+  if (shared->parents.empty()) {
+    complete(*shared, *child);
+    return detail::future_access::make(std::move(child));
+  }
+
+  shared->remaining.store(shared->parents.size());
+  for (const auto& parent : shared->parents) {
+    parent->on_ready([shared, child, complete] {
+      if (shared->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        complete(*shared, *child);
+      }
+    });
+  }
+
+  return detail::future_access::make(std::move(child));
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_FUTURE_HPP_
@@ -0,0 +1,496 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_CONCURRENCY_LOCK_FREE_QUEUE_HPP_
+#define CENTURION_CONCURRENCY_LOCK_FREE_QUEUE_HPP_
+
+#include <SDL.h>
+
+#include <atomic>       // atomic, memory_order
+#include <cstddef>      // ptrdiff_t
+#include <memory>       // unique_ptr, make_unique
+#include <type_traits>  // is_nothrow_move_constructible_v
+#include <utility>      // move, forward
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "mutex.hpp"
+#include "semaphore.hpp"
+
+namespace cen {
+
+namespace detail {
+
+/// The assumed size of a cache line, used to keep independently written data apart.
+inline constexpr usize cache_line_size = 64;
+
+[[nodiscard]] constexpr auto queue_capacity(const usize requested) noexcept -> usize
+{
+  usize result {2};
+  while (result < requested) {
+    result *= 2u;
+  }
+
+  return result;
+}
+
+}  // namespace detail
+
+/**
+ * A bounded lock-free queue for a single producer thread and a single consumer thread.
+ *
+ * The values are stored in a preallocated ring buffer, so pushing and popping never allocate
+ * and never take a lock. The producer and consumer indices live on separate cache lines, and
+ * each side caches the index of the other side to avoid touching it on every operation.
+ *
+ * \tparam T the value type.
+ *
+ * \see mpmc_queue
+ * \see blocking_queue
+ */
+template <typename T>
+class spsc_queue final {
+ public:
+  using value_type = T;
+  using size_type = usize;
+
+  /**
+   * Creates an empty queue.
+   *
+   * \param capacity the maximum amount of queued values, rounded up to a power of two.
+   */
+  explicit spsc_queue(const size_type capacity = 1024)
+      : mCapacity {detail::queue_capacity(capacity)}
+      , mMask {mCapacity - 1u}
+      , mSlots {std::make_unique<maybe<T>[]>(mCapacity)}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(spsc_queue)
+  CENTURION_DISABLE_MOVE(spsc_queue)
+
+  /**
+   * Attempts to add a value to the queue, may only be called from the producer thread.
+   *
+   * \param value the value that will be added.
+   *
+   * \return `true` if the value was added; `false` if the queue was full.
+   */
+  auto try_push(const T& value) -> bool { return try_emplace(value); }
+
+  /**
+   * Attempts to move a value into the queue, may only be called from the producer thread.
+   *
+   * \details The value is only moved from if it was added, so a failed attempt can be retried.
+   *
+   * \param value the value that will be added.
+   *
+   * \return `true` if the value was added; `false` if the queue was full.
+   */
+  auto try_push(T&& value) -> bool { return try_emplace(std::move(value)); }
+
+  /// Attempts to construct a value in the queue, may only be called from the producer thread.
+  template <typename... Args>
+  auto try_emplace(Args&&... args) -> bool
+  {
+    const auto tail = mTail.load(std::memory_order_relaxed);
+
+    if (tail - mCachedHead == mCapacity) {
+      mCachedHead = mHead.load(std::memory_order_acquire);
+      if (tail - mCachedHead == mCapacity) {
+        return false;
+      }
+    }
+
+    mSlots[tail & mMask].emplace(std::forward<Args>(args)...);
+    mTail.store(tail + 1u, std::memory_order_release);
+
+    return true;
+  }
+
+  /**
+   * Removes the oldest value in the queue, may only be called from the consumer thread.
+   *
+   * \return the removed value; an empty optional if the queue was empty.
+   */
+  auto try_pop() -> maybe<T>
+  {
+    const auto head = mHead.load(std::memory_order_relaxed);
+
+    if (head == mCachedTail) {
+      mCachedTail = mTail.load(std::memory_order_acquire);
+      if (head == mCachedTail) {
+        return nothing;
+      }
+    }
+
+    auto& slot = mSlots[head & mMask];
+
+    maybe<T> result {std::move(slot)};
+    slot.reset();
+    mHead.store(head + 1u, std::memory_order_release);
+
+    return result;
+  }
+
+  /// Returns the approximate amount of queued values.
+  [[nodiscard]] auto size() const noexcept -> size_type
+  {
+    const auto head = mHead.load(std::memory_order_acquire);
+    const auto tail = mTail.load(std::memory_order_acquire);
+    return (tail >= head) ? tail - head : 0u;
+  }
+
+  /// Indicates whether the queue appears to be empty.
+  [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0u; }
+
+  /// Returns the maximum amount of queued values.
+  [[nodiscard]] auto capacity() const noexcept -> size_type { return mCapacity; }
+
+ private:
+  size_type mCapacity {};
+  size_type mMask {};
+  std::unique_ptr<maybe<T>[]> mSlots;
+
+  /* Written by the producer */
+  alignas(detail::cache_line_size) std::atomic<size_type> mTail {};
+  size_type mCachedHead {};
+
+  /* Written by the consumer */
+  alignas(detail::cache_line_size) std::atomic<size_type> mHead {};
+  size_type mCachedTail {};
+};
+
+/**
+ * A bounded lock-free queue for any amount of producer and consumer threads.
+ *
+ * Every slot in the ring buffer has a sequence number that tells producers and consumers
+ * whether the slot is ready to be written or read, so threads only contend on the index they
+ * advance.
+ *
+ * \tparam T the value type.
+ *
+ * \see spsc_queue
+ * \see blocking_queue
+ */
+template <typename T>
+class mpmc_queue final {
+  static_assert(std::is_nothrow_move_constructible_v<T>,
+                "MPMC queue values must be nothrow move constructible!");
+
+ public:
+  using value_type = T;
+  using size_type = usize;
+
+  /**
+   * Creates an empty queue.
+   *
+   * \param capacity the maximum amount of queued values, rounded up to a power of two.
+   */
+  explicit mpmc_queue(const size_type capacity = 1024)
+      : mCapacity {detail::queue_capacity(capacity)}
+      , mMask {mCapacity - 1u}
+      , mCells {std::make_unique<cell[]>(mCapacity)}
+  {
+    for (size_type index = 0; index < mCapacity; ++index) {
+      mCells[index].sequence.store(index, std::memory_order_relaxed);
+    }
+  }
+
+  CENTURION_DISABLE_COPY(mpmc_queue)
+  CENTURION_DISABLE_MOVE(mpmc_queue)
+
+  /**
+   * Attempts to add a value to the queue, may be called from any thread.
+   *
+   * \param value the value that will be added.
+   *
+   * \return `true` if the value was added; `false` if the queue was full.
+   */
+  auto try_push(const T& value) -> bool { return try_push(T {value}); }
+
+  /**
+   * Attempts to move a value into the queue, may be called from any thread.
+   *
+   * \details The value is only moved from if it was added, so a failed attempt can be retried.
+   *
+   * \param value the value that will be added.
+   *
+   * \return `true` if the value was added; `false` if the queue was full.
+   */
+  auto try_push(T&& value) -> bool
+  {
+    auto pos = mTail.load(std::memory_order_relaxed);
+
+    for (;;) {
+      auto& c = mCells[pos & mMask];
+      const auto seq = c.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+
+      if (diff == 0) {
+        /* The slot is claimed by the CAS, so filling it must not fail */
+        if (mTail.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+          c.value.emplace(std::move(value));
+          c.sequence.store(pos + 1u, std::memory_order_release);
+          return true;
+        }
+      }
+      else if (diff < 0) {
+        return false;  // The queue is full
+      }
+      else {
+        pos = mTail.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * Attempts to construct a value in the queue, may be called from any thread.
+   *
+   * \details The value is constructed before a slot is claimed, so an exception thrown by the
+   *          constructor leaves the queue untouched.
+   */
+  template <typename... Args>
+  auto try_emplace(Args&&... args) -> bool
+  {
+    T value {std::forward<Args>(args)...};
+    return try_push(std::move(value));
+  }
+
+  /**
+   * Removes the oldest value in the queue, may be called from any thread.
+   *
+   * \return the removed value; an empty optional if the queue was empty.
+   */
+  auto try_pop() -> maybe<T>
+  {
+    auto pos = mHead.load(std::memory_order_relaxed);
+
+    for (;;) {
+      auto& c = mCells[pos & mMask];
+      const auto seq = c.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1u));
+
+      if (diff == 0) {
+        if (mHead.compare_exchange_weak(pos, pos + 1u, std::memory_order_relaxed)) {
+          maybe<T> result {std::move(c.value)};
+          c.value.reset();
+          c.sequence.store(pos + mCapacity, std::memory_order_release);
+          return result;
+        }
+      }
+      else if (diff < 0) {
+        return nothing;  // The queue is empty
+      }
+      else {
+        pos = mHead.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /// Returns the approximate amount of queued values.
+  [[nodiscard]] auto size() const noexcept -> size_type
+  {
+    const auto head = mHead.load(std::memory_order_acquire);
+    const auto tail = mTail.load(std::memory_order_acquire);
+    return (tail >= head) ? tail - head : 0u;
+  }
+
+  /// Indicates whether the queue appears to be empty.
+  [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0u; }
+
+  /// Returns the maximum amount of queued values.
+  [[nodiscard]] auto capacity() const noexcept -> size_type { return mCapacity; }
+
+ private:
+  struct cell final {
+    std::atomic<size_type> sequence {};
+    maybe<T> value;
+  };
+
+  size_type mCapacity {};
+  size_type mMask {};
+  std::unique_ptr<cell[]> mCells;
+
+  alignas(detail::cache_line_size) std::atomic<size_type> mTail {};
+  alignas(detail::cache_line_size) std::atomic<size_type> mHead {};
+};
+
+/**
+ * Adds blocking operations to a lock-free queue.
+ *
+ * Two semaphores count the queued values and the free slots, so threads only sleep when the
+ * queue is empty or full. The non-blocking operations of the underlying queue are still
+ * available and never touch the semaphores' wait path.
+ *
+ * \tparam Queue the underlying queue type, either `spsc_queue` or `mpmc_queue`.
+ */
+template <typename Queue>
+class blocking_queue final {
+ public:
+  using queue_type = Queue;
+  using value_type = typename Queue::value_type;
+  using size_type = typename Queue::size_type;
+
+  /**
+   * Creates an empty queue.
+   *
+   * \param capacity the maximum amount of queued values, rounded up to a power of two.
+   *
+   * \throws sdl_error if the semaphores cannot be created.
+   */
+  explicit blocking_queue(const size_type capacity = 1024)
+      : mQueue {capacity}
+      , mItems {0}
+      , mSlots {static_cast<uint32>(mQueue.capacity())}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(blocking_queue)
+  CENTURION_DISABLE_MOVE(blocking_queue)
+
+  /**
+   * Adds a value to the queue, blocks while the queue is full.
+   *
+   * \param value the value that will be added.
+   *
+   * \return `success` if the value was added; `failure` if waiting failed.
+   */
+  auto push(value_type value) -> result
+  {
+    if (!mSlots.acquire()) {
+      return failure;
+    }
+
+    commit(std::move(value));
+    return success;
+  }
+
+  /**
+   * Attempts to add a value to the queue without blocking.
+   *
+   * \param value the value that will be added.
+   *
+   * \return `true` if the value was added; `false` if the queue was full.
+   */
+  auto try_push(value_type value) -> bool
+  {
+    if (mSlots.try_acquire() != lock_status::success) {
+      return false;
+    }
+
+    commit(std::move(value));
+    return true;
+  }
+
+  /**
+   * Removes the oldest value in the queue, blocks while the queue is empty.
+   *
+   * \return the removed value; an empty optional if waiting failed.
+   */
+  auto pop() -> maybe<value_type>
+  {
+    if (!mItems.acquire()) {
+      return nothing;
+    }
+
+    return take();
+  }
+
+  /**
+   * Removes the oldest value in the queue, blocking for at most the specified duration.
+   *
+   * \param timeout the maximum amount of time to wait for a value.
+   *
+   * \return the removed value; an empty optional if no value was available in time.
+   */
+  auto pop(const u32ms timeout) -> maybe<value_type>
+  {
+    if (mItems.acquire(timeout) != lock_status::success) {
+      return nothing;
+    }
+
+    return take();
+  }
+
+  /// Attempts to remove the oldest value in the queue without blocking.
+  auto try_pop() -> maybe<value_type>
+  {
+    if (mItems.try_acquire() != lock_status::success) {
+      return nothing;
+    }
+
+    return take();
+  }
+
+  /// Returns the approximate amount of queued values.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mQueue.size(); }
+
+  /// Indicates whether the queue appears to be empty.
+  [[nodiscard]] auto empty() const noexcept -> bool { return mQueue.empty(); }
+
+  /// Returns the maximum amount of queued values.
+  [[nodiscard]] auto capacity() const noexcept -> size_type { return mQueue.capacity(); }
+
+ private:
+  Queue mQueue;
+  semaphore mItems;  ///< Counts the values that can be removed.
+  semaphore mSlots;  ///< Counts the slots that can be written.
+
+  void commit(value_type value)
+  {
+    /* A slot token guarantees space, but a consumer might still be finishing the removal
+       of the value in the next slot, so retry until that slot becomes available */
+    while (!mQueue.try_push(std::move(value))) {
+    }
+
+    mItems.release();
+  }
+
+  [[nodiscard]] auto take() -> maybe<value_type>
+  {
+    /* The value might still be in the process of being written by its producer */
+    auto value = mQueue.try_pop();
+    while (!value) {
+      value = mQueue.try_pop();
+    }
+
+    mSlots.release();
+    return value;
+  }
+};
+
+/// A single producer, single consumer queue with blocking operations.
+template <typename T>
+using blocking_spsc_queue = blocking_queue<spsc_queue<T>>;
+
+/// A multiple producer, multiple consumer queue with blocking operations.
+template <typename T>
+using blocking_mpmc_queue = blocking_queue<mpmc_queue<T>>;
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_LOCK_FREE_QUEUE_HPP_
@@ -34,11 +34,20 @@
 
 namespace cen {
 
-/// An RAII style blocking lock that unlocks the associated mutex upon destruction.
+/**
+ * An RAII style blocking lock that unlocks the associated mutex upon destruction.
+ *
+ * Besides `mutex`, the lock works with any type that provides `lock()`, returning something
+ * convertible to `bool`, and `unlock()` member functions, such as `spin_lock` and
+ * `adaptive_mutex`.
+ */
 class scoped_lock final {
  public:
   /// Attempts to lock a mutex.
-  CENTURION_NODISCARD_CTOR explicit scoped_lock(mutex& mutex) : mMutex {&mutex}
+  template <typename Mutex>
+  CENTURION_NODISCARD_CTOR explicit scoped_lock(Mutex& mutex)
+      : mMutex {&mutex}
+      , mUnlock {&unlock<Mutex>}
   {
     if (!mutex.lock()) {
       throw sdl_error {};
@@ -48,18 +57,32 @@ class scoped_lock final {
   CENTURION_DISABLE_COPY(scoped_lock)
   CENTURION_DISABLE_MOVE(scoped_lock)
 
-  ~scoped_lock() noexcept { mMutex->unlock(); }
+  ~scoped_lock() noexcept { mUnlock(mMutex); }
 
  private:
-  mutex* mMutex {};
+  void* mMutex {};
+  void (*mUnlock)(void*) noexcept {};
+
+  template <typename Mutex>
+  static void unlock(void* mutex) noexcept
+  {
+    static_cast<Mutex*>(mutex)->unlock();
+  }
 };
 
-/// An RAII style non-blocking lock that unlocks the associated mutex upon destruction.
+/**
+ * An RAII style non-blocking lock that unlocks the associated mutex upon destruction.
+ *
+ * Besides `mutex`, the lock works with any type that provides `try_lock()`, returning a
+ * `lock_status`, and `unlock()` member functions, such as `spin_lock` and `adaptive_mutex`.
+ */
 class try_lock final {
  public:
   /// Attempts to lock a mutex.
-  CENTURION_NODISCARD_CTOR explicit try_lock(mutex& mutex) noexcept
+  template <typename Mutex>
+  CENTURION_NODISCARD_CTOR explicit try_lock(Mutex& mutex) noexcept
       : mMutex {&mutex}
+      , mUnlock {&unlock<Mutex>}
       , mStatus {mutex.try_lock()}
   {
   }
@@ -69,7 +92,7 @@ class try_lock final {
   ~try_lock() noexcept
   {
     if (mStatus == lock_status::success) {
-      mMutex->unlock();
+      mUnlock(mMutex);
     }
   }
 
@@ -91,8 +114,15 @@ class try_lock final {
   [[nodiscard]] explicit operator bool() const noexcept { return locked(); }
 
  private:
-  mutex* mMutex {};
+  void* mMutex {};
+  void (*mUnlock)(void*) noexcept {};
   lock_status mStatus {};
+
+  template <typename Mutex>
+  static void unlock(void* mutex) noexcept
+  {
+    static_cast<Mutex*>(mutex)->unlock();
+  }
 };
 
 }  // namespace cen
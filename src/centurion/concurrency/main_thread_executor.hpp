@@ -0,0 +1,305 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_CONCURRENCY_MAIN_THREAD_EXECUTOR_HPP_
+#define CENTURION_CONCURRENCY_MAIN_THREAD_EXECUTOR_HPP_
+
+#include <SDL.h>
+
+#include <atomic>       // atomic, memory_order
+#include <exception>    // exception_ptr, current_exception, rethrow_exception
+#include <functional>   // function
+#include <type_traits>  // invoke_result_t, is_void_v, decay_t
+#include <utility>      // move, forward, swap
+#include <vector>       // vector
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "lock_free_queue.hpp"
+#include "locks.hpp"
+#include "semaphore.hpp"
+#include "spin_lock.hpp"
+#include "thread.hpp"
+
+namespace cen {
+
+/**
+ * Executes functions posted from any thread on the main thread, within a time budget.
+ *
+ * Many SDL functions, e.g. those that manipulate windows or create textures, must be called
+ * on the main thread. Worker threads post such work to the executor, which the main thread
+ * drains once per frame with `run_for()`, so that a burst of posted work is spread over
+ * several frames rather than causing a frame spike.
+ *
+ * \code{cpp}
+ * cen::main_thread_executor executor;
+ *
+ * pool.submit([&] {
+ *   auto surface = decode("hero.png");
+ *   executor.post([&, surface = std::move(surface)] { upload(surface); });
+ * });
+ *
+ * loop.run([&] {
+ *   dispatcher.poll();
+ *   executor.run_for(cen::u32ms {2});
+ * }, update, render);
+ * \endcode
+ *
+ * \details Functions are posted to a lock-free queue, and only take a lock if the queue is
+ *          full, in which case they are stored in an unbounded overflow list. Functions are
+ *          executed in the order that they were posted.
+ *
+ * \details The executor can be used with `future::then()`, `resume_on()` and `run_on()`,
+ *          to continue work on the main thread.
+ *
+ * \see task_queue
+ * \see thread_pool
+ */
+class main_thread_executor final {
+ public:
+  using size_type = usize;
+  using task_type = std::function<void()>;
+
+  /**
+   * Creates an executor that is owned by the calling thread, usually the main thread.
+   *
+   * \param capacity the capacity of the lock-free queue, rounded up to a power of two.
+   */
+  explicit main_thread_executor(const size_type capacity = 1024)
+      : mQueue {capacity}
+      , mOwner {thread::current_id()}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(main_thread_executor)
+  CENTURION_DISABLE_MOVE(main_thread_executor)
+
+  /**
+   * Adds a function object to the executor, may be called from any thread.
+   *
+   * \param callable the function object that will be executed, with signature `void()`.
+   */
+  template <typename Callable>
+  void post(Callable&& callable)
+  {
+    task_type task {std::forward<Callable>(callable)};
+
+    /* Once a function has overflowed, all functions overflow until the overflow is drained,
+       so that functions are still executed in the order that they were posted */
+    if (!mOverflowing.load(std::memory_order_acquire) && mQueue.try_push(std::move(task))) {
+      return;
+    }
+
+    scoped_lock lock {mOverflowLock};
+    mOverflow.push_back(std::move(task));
+    mOverflowing.store(true, std::memory_order_release);
+  }
+
+  /**
+   * Executes a function object on the main thread, and waits for it to finish.
+   *
+   * \details The function object is invoked immediately if this is called on the main
+   *          thread. Otherwise, the calling thread is blocked until the main thread has
+   *          drained the executor, so this must not be used during shutdown.
+   *
+   * \param callable the function object, with signature `R()`.
+   *
+   * \return the value returned by the function object.
+   *
+   * \throws any exception thrown by the function object.
+   */
+  template <typename Callable>
+  auto post_and_wait(Callable&& callable) -> std::invoke_result_t<std::decay_t<Callable>&>
+  {
+    using result_type = std::invoke_result_t<std::decay_t<Callable>&>;
+
+    if (is_owner()) {
+      return callable();
+    }
+
+    semaphore done {0};
+    std::exception_ptr error;
+
+    if constexpr (std::is_void_v<result_type>) {
+      post([&] {
+        try {
+          callable();
+        }
+        catch (...) {
+          error = std::current_exception();
+        }
+
+        done.release();
+      });
+
+      done.acquire();
+      if (error) {
+        std::rethrow_exception(error);
+      }
+    }
+    else {
+      maybe<result_type> value;
+      post([&] {
+        try {
+          value.emplace(callable());
+        }
+        catch (...) {
+          error = std::current_exception();
+        }
+
+        done.release();
+      });
+
+      done.acquire();
+      if (error) {
+        std::rethrow_exception(error);
+      }
+
+      return std::move(*value);
+    }
+  }
+
+  /**
+   * Executes posted functions until there are no more functions, or a time budget is spent.
+   *
+   * \details At least one function is executed if there are any, so that the executor keeps
+   *          making progress even with a budget of zero. Functions posted by the executed
+   *          functions may be executed by the same call.
+   *
+   * \param budget the maximum amount of time to spend executing functions.
+   *
+   * \return the amount of executed functions.
+   */
+  auto run_for(const seconds<double> budget) -> size_type
+  {
+    const auto frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    const auto start = SDL_GetPerformanceCounter();
+    const auto ticks = static_cast<uint64>(budget.count() * frequency);
+
+    size_type count = 0;
+    do {
+      if (!run_one()) {
+        break;
+      }
+
+      ++count;
+    } while (SDL_GetPerformanceCounter() - start < ticks);
+
+    return count;
+  }
+
+  /**
+   * Executes all posted functions, without a time budget.
+   *
+   * \return the amount of executed functions.
+   */
+  auto run_pending() -> size_type
+  {
+    size_type count = 0;
+    while (run_one()) {
+      ++count;
+    }
+
+    return count;
+  }
+
+  /**
+   * Executes the oldest posted function, if there is one.
+   *
+   * \return `true` if a function was executed; `false` if there were no functions.
+   */
+  auto run_one() -> bool
+  {
+    /* Functions left over from the overflow list are older than those in the queue */
+    if (mNextRunning == mRunning.size()) {
+      mRunning.clear();
+      mNextRunning = 0;
+
+      if (auto task = mQueue.try_pop()) {
+        execute(*task);
+        return true;
+      }
+
+      /* The queue is empty, so the overflowing functions are the oldest remaining ones */
+      if (!mOverflowing.load(std::memory_order_acquire)) {
+        return false;
+      }
+
+      scoped_lock lock {mOverflowLock};
+      std::swap(mRunning, mOverflow);
+      mOverflowing.store(false, std::memory_order_release);
+
+      if (mRunning.empty()) {
+        return false;
+      }
+    }
+
+    auto task = std::move(mRunning[mNextRunning++]);
+    execute(task);
+
+    return true;
+  }
+
+  /// Indicates whether the calling thread is the thread that owns the executor.
+  [[nodiscard]] auto is_owner() const noexcept -> bool
+  {
+    return thread::current_id() == mOwner;
+  }
+
+  /// Indicates whether there are no functions waiting, must be called by the owning thread.
+  [[nodiscard]] auto empty() const noexcept -> bool
+  {
+    return mQueue.empty() && !mOverflowing.load(std::memory_order_acquire) &&
+           mNextRunning == mRunning.size();
+  }
+
+  /// Returns the amount of executed functions.
+  [[nodiscard]] auto executed() const noexcept -> uint64
+  {
+    return mExecuted.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto owner() const noexcept -> thread_id { return mOwner; }
+
+ private:
+  mpmc_queue<task_type> mQueue;
+  thread_id mOwner {};
+  spin_lock mOverflowLock;
+  std::vector<task_type> mOverflow;
+  std::atomic<bool> mOverflowing {};
+  std::vector<task_type> mRunning;  ///< Overflowed functions, only used by the owner.
+  size_type mNextRunning {};
+  std::atomic<uint64> mExecuted {};
+
+  void execute(task_type& task)
+  {
+    task();
+    mExecuted.fetch_add(1, std::memory_order_relaxed);
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_MAIN_THREAD_EXECUTOR_HPP_
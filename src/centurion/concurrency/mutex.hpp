@@ -27,13 +27,18 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 #include "../common/memory.hpp"
 #include "../common/result.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class lock_status {
@@ -59,11 +64,15 @@ enum class lock_status {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const lock_status status) -> std::ostream&
 {
   return stream << to_string(status);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 /**
  * Represents a recursive mutex.
  *
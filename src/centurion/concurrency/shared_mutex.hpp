@@ -0,0 +1,218 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_CONCURRENCY_SHARED_MUTEX_HPP_
+#define CENTURION_CONCURRENCY_SHARED_MUTEX_HPP_
+
+#include <SDL.h>
+
+#include <atomic>  // atomic
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "condition.hpp"
+#include "mutex.hpp"
+
+namespace cen {
+
+/**
+ * A non-recursive reader-writer lock.
+ *
+ * Any amount of readers may hold the lock at the same time, whilst writers get exclusive
+ * access. Readers that don't have to wait only perform a single atomic operation, so they
+ * don't serialize on each other. Waiting writers take precedence over new readers, so
+ * writers can't be starved by a steady stream of readers.
+ *
+ * \see shared_lock
+ * \see scoped_lock
+ */
+class shared_mutex final {
+ public:
+  /**
+   * Creates an unlocked mutex.
+   *
+   * \throws sdl_error if the internal mutex or condition variables cannot be created.
+   */
+  shared_mutex() = default;
+
+  CENTURION_DISABLE_COPY(shared_mutex)
+  CENTURION_DISABLE_MOVE(shared_mutex)
+
+  /// Locks the mutex for exclusive (write) access, blocks if the mutex isn't available.
+  auto lock() noexcept -> result
+  {
+    if (try_lock() == lock_status::success) {
+      return success;
+    }
+
+    if (!mMutex.lock()) {
+      return failure;
+    }
+
+    ++mWaitingWriters;
+    while (!try_acquire_exclusive()) {
+      mWriters.wait(mMutex);
+    }
+    --mWaitingWriters;
+
+    mMutex.unlock();
+    return success;
+  }
+
+  /// Attempts to lock the mutex for exclusive access and returns immediately.
+  auto try_lock() noexcept -> lock_status
+  {
+    return try_acquire_exclusive() ? lock_status::success : lock_status::timed_out;
+  }
+
+  /// Releases exclusive access, waking up any waiting readers and writers.
+  auto unlock() noexcept -> result
+  {
+    if (!mMutex.lock()) {
+      return failure;
+    }
+
+    mState.store(0);
+
+    if (mWaitingWriters.load() != 0) {
+      mWriters.signal();
+    }
+
+    mReaders.broadcast();
+    mMutex.unlock();
+
+    return success;
+  }
+
+  /// Locks the mutex for shared (read) access, blocks if a writer holds or waits for the lock.
+  auto lock_shared() noexcept -> result
+  {
+    if (try_lock_shared() == lock_status::success) {
+      return success;
+    }
+
+    if (!mMutex.lock()) {
+      return failure;
+    }
+
+    while (!try_acquire_shared()) {
+      mReaders.wait(mMutex);
+    }
+
+    mMutex.unlock();
+    return success;
+  }
+
+  /// Attempts to lock the mutex for shared access and returns immediately.
+  auto try_lock_shared() noexcept -> lock_status
+  {
+    return try_acquire_shared() ? lock_status::success : lock_status::timed_out;
+  }
+
+  /// Releases shared access, waking up a waiting writer if this was the last reader.
+  auto unlock_shared() noexcept -> result
+  {
+    if (mState.fetch_sub(1) == 1 && mWaitingWriters.load() != 0) {
+      if (!mMutex.lock()) {
+        return failure;
+      }
+
+      const auto signaled = mWriters.signal();
+      mMutex.unlock();
+
+      return signaled;
+    }
+
+    return success;
+  }
+
+  /// Returns the amount of readers that currently hold the lock.
+  [[nodiscard]] auto readers() const noexcept -> uint32
+  {
+    const auto state = mState.load();
+    return (state == writer_bit) ? 0u : state;
+  }
+
+  /// Indicates whether a writer currently holds the lock.
+  [[nodiscard]] auto is_write_locked() const noexcept -> bool
+  {
+    return mState.load() == writer_bit;
+  }
+
+ private:
+  inline constexpr static uint32 writer_bit = 1u << 31u;
+
+  /* Either the amount of readers, or the writer bit. These use sequentially consistent
+     operations, which the handshake between readers and waiting writers depends on */
+  std::atomic<uint32> mState {0};
+  std::atomic<uint32> mWaitingWriters {0};
+
+  mutex mMutex;
+  condition mReaders;
+  condition mWriters;
+
+  [[nodiscard]] auto try_acquire_exclusive() noexcept -> bool
+  {
+    uint32 expected = 0;
+    return mState.compare_exchange_strong(expected, writer_bit);
+  }
+
+  [[nodiscard]] auto try_acquire_shared() noexcept -> bool
+  {
+    auto state = mState.load();
+    while (state != writer_bit && mWaitingWriters.load() == 0) {
+      if (mState.compare_exchange_weak(state, state + 1u)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+};
+
+/// An RAII style blocking lock that acquires shared access to a reader-writer lock.
+class shared_lock final {
+ public:
+  /// Locks a mutex for shared access.
+  CENTURION_NODISCARD_CTOR explicit shared_lock(shared_mutex& mutex) : mMutex {&mutex}
+  {
+    if (!mutex.lock_shared()) {
+      throw sdl_error {};
+    }
+  }
+
+  CENTURION_DISABLE_COPY(shared_lock)
+  CENTURION_DISABLE_MOVE(shared_lock)
+
+  ~shared_lock() noexcept { mMutex->unlock_shared(); }
+
+ private:
+  shared_mutex* mMutex {};
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_SHARED_MUTEX_HPP_
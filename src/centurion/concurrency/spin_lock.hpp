@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_CONCURRENCY_SPIN_LOCK_HPP_
+#define CENTURION_CONCURRENCY_SPIN_LOCK_HPP_
+
+#include <SDL.h>
+
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../detail/sdl_version_at_least.hpp"
+#include "mutex.hpp"
+
+namespace cen {
+
+namespace detail {
+
+/// Hints to the processor that the calling thread is busy-waiting.
+inline void cpu_pause() noexcept
+{
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+  SDL_CPUPauseInstruction();
+#endif  // SDL_VERSION_ATLEAST(2, 24, 0)
+}
+
+}  // namespace detail
+
+/**
+ * A non-recursive lock that busy-waits instead of sleeping, based on `SDL_AtomicLock`.
+ *
+ * Spin locks are much cheaper than mutexes for critical sections that are only a few
+ * instructions long, but waste CPU time if the lock is held for long, so use a `mutex` or an
+ * `adaptive_mutex` for anything else.
+ *
+ * \see scoped_lock
+ * \see try_lock
+ * \see adaptive_mutex
+ */
+class spin_lock final {
+ public:
+  /// Creates an unlocked spin lock.
+  spin_lock() noexcept = default;
+
+  CENTURION_DISABLE_COPY(spin_lock)
+  CENTURION_DISABLE_MOVE(spin_lock)
+
+  /// Locks the spin lock, busy-waits until the lock is available. Always succeeds.
+  auto lock() noexcept -> result
+  {
+    SDL_AtomicLock(&mLock);
+    return success;
+  }
+
+  /// Attempts to lock the spin lock and returns immediately.
+  auto try_lock() noexcept -> lock_status
+  {
+    return SDL_AtomicTryLock(&mLock) == SDL_TRUE ? lock_status::success
+                                                 : lock_status::timed_out;
+  }
+
+  auto unlock() noexcept -> result
+  {
+    SDL_AtomicUnlock(&mLock);
+    return success;
+  }
+
+  [[nodiscard]] auto data() noexcept -> SDL_SpinLock* { return &mLock; }
+
+  [[nodiscard]] auto data() const noexcept -> const SDL_SpinLock* { return &mLock; }
+
+ private:
+  SDL_SpinLock mLock {};
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_SPIN_LOCK_HPP_
@@ -0,0 +1,360 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_CONCURRENCY_TASK_GRAPH_HPP_
+#define CENTURION_CONCURRENCY_TASK_GRAPH_HPP_
+
+#include <SDL.h>
+
+#include <atomic>      // atomic, memory_order
+#include <cassert>     // assert
+#include <exception>   // exception_ptr, current_exception, rethrow_exception
+#include <functional>  // function
+#include <memory>      // unique_ptr, make_unique
+#include <utility>     // move
+#include <vector>      // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../system/profiler.hpp"
+#include "lock_free_queue.hpp"
+#include "thread_pool.hpp"
+
+namespace cen {
+
+/// Identifies a task in a task graph.
+using task_id = uint32;
+
+/// Determines which threads may execute a task in a task graph.
+enum class task_affinity : uint8 {
+  any,   ///< The task may be executed by any worker, or by the thread that runs the graph.
+  main,  ///< The task is only executed by the thread that runs the graph.
+};
+
+/**
+ * A reusable graph of tasks with dependencies, that is executed once per frame.
+ *
+ * Tasks and their dependencies are declared once, after which the graph can be executed any
+ * amount of times with `run()`. Each task starts as soon as all of its dependencies have
+ * finished, so independent tasks are executed in parallel by the workers of a thread pool.
+ *
+ * \code{cpp}
+ * cen::task_graph frame;
+ *
+ * const auto input = frame.add("input", poll_input, cen::task_affinity::main);
+ * const auto simulation = frame.add("simulation", simulate);
+ * const auto audio = frame.add("audio", update_audio);
+ * const auto culling = frame.add("culling", cull);
+ * const auto batching = frame.add("batching", build_batches);
+ * const auto submission = frame.add("submit", submit, cen::task_affinity::main);
+ *
+ * frame.precede(input, simulation);
+ * frame.precede(input, audio);
+ * frame.precede(simulation, culling);
+ * frame.precede(culling, batching);
+ * frame.precede(batching, submission);
+ *
+ * while (running) {
+ *   frame.run(pool);
+ * }
+ * \endcode
+ *
+ * \details Running a graph doesn't allocate any memory, other than what is needed by the
+ *          thread pool to queue tasks. The dependency structure is compiled by the first
+ *          call to `run()` after the graph has been modified.
+ *
+ * \details Each task is recorded as a profiler zone with the name of the task, when the
+ *          library is built with `CENTURION_ENABLE_PROFILING`, which makes the critical path
+ *          visible in the profile.
+ *
+ * \see thread_pool
+ * \see profile_zone
+ */
+class task_graph final {
+ public:
+  using size_type = usize;
+  using task_type = std::function<void()>;
+
+  task_graph() = default;
+
+  CENTURION_DISABLE_COPY(task_graph)
+  CENTURION_DISABLE_MOVE(task_graph)
+
+  /**
+   * Adds a task to the graph.
+   *
+   * \param name the name of the task, must be a string literal or otherwise outlive the
+   *             graph. Also used as the name of the profiler zone of the task.
+   * \param task the function object executed by the task, with signature `void()`.
+   * \param affinity the threads that may execute the task.
+   *
+   * \return the identifier of the task.
+   */
+  auto add(const char* name, task_type task, const task_affinity affinity = task_affinity::any)
+      -> task_id
+  {
+    assert(name);
+    assert(task);
+
+    node entry;
+    entry.name = name;
+    entry.task = std::move(task);
+    entry.affinity = affinity;
+
+    mNodes.push_back(std::move(entry));
+    mCompiled = false;
+
+    return static_cast<task_id>(mNodes.size() - 1u);
+  }
+
+  /**
+   * Adds a dependency between two tasks, so that one task finishes before the other starts.
+   *
+   * \param first the task that must finish first.
+   * \param second the task that must wait for the first task.
+   */
+  void precede(const task_id first, const task_id second)
+  {
+    assert(first < mNodes.size());
+    assert(second < mNodes.size());
+    assert(first != second);
+
+    mNodes[first].successors.push_back(second);
+    mCompiled = false;
+  }
+
+  /// Makes a task depend on another task, see `precede()`.
+  void depend(const task_id task, const task_id dependency) { precede(dependency, task); }
+
+  /**
+   * Executes all tasks, and blocks until they have finished.
+   *
+   * \details The calling thread executes all tasks with the main affinity, and helps the
+   *          workers with other tasks while it waits. If a task throws, the tasks that
+   *          haven't started yet are skipped, and the exception is rethrown once all running
+   *          tasks have finished.
+   *
+   * \param pool the thread pool that executes the tasks with any affinity.
+   *
+   * \throws exception if the dependencies contain a cycle.
+   * \throws any exception thrown by a task.
+   */
+  void run(thread_pool& pool)
+  {
+    if (mNodes.empty()) {
+      return;
+    }
+
+    compile();
+
+    mPool = &pool;
+    mError = nullptr;
+    mFailed.store(false, std::memory_order_relaxed);
+    mRemaining.store(static_cast<uint32>(mNodes.size()), std::memory_order_relaxed);
+
+    for (auto& node : mNodes) {
+      node.waiting.store(node.dependencies, std::memory_order_relaxed);
+    }
+
+    for (const auto root : mRoots) {
+      schedule(root);
+    }
+
+    while (mRemaining.load(std::memory_order_acquire) != 0) {
+      if (auto id = mMainQueue->try_pop()) {
+        execute(*id);
+      }
+      else if (!pool.run_pending_task()) {
+        SDL_Delay(0);
+      }
+    }
+
+    ++mRuns;
+
+    if (mError) {
+      std::rethrow_exception(mError);
+    }
+  }
+
+  /// Removes all tasks.
+  void clear() noexcept
+  {
+    mNodes.clear();
+    mRoots.clear();
+    mCompiled = false;
+  }
+
+  /// Returns the name of a task.
+  [[nodiscard]] auto name(const task_id id) const noexcept -> const char*
+  {
+    assert(id < mNodes.size());
+    return mNodes[id].name;
+  }
+
+  [[nodiscard]] auto affinity(const task_id id) const noexcept -> task_affinity
+  {
+    assert(id < mNodes.size());
+    return mNodes[id].affinity;
+  }
+
+  /// Returns the amount of tasks.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mNodes.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mNodes.empty(); }
+
+  /// Returns the amount of times the graph has been executed.
+  [[nodiscard]] auto runs() const noexcept -> uint64 { return mRuns; }
+
+ private:
+  struct node final {
+    const char* name {};
+    task_type task;
+    std::vector<task_id> successors;
+    uint32 dependencies {};
+    std::atomic<uint32> waiting {};
+    task_affinity affinity {task_affinity::any};
+
+    node() = default;
+
+    node(node&& other) noexcept
+        : name {other.name}
+        , task {std::move(other.task)}
+        , successors {std::move(other.successors)}
+        , dependencies {other.dependencies}
+        , affinity {other.affinity}
+    {
+    }
+  };
+
+  std::vector<node> mNodes;
+  std::vector<task_id> mRoots;
+  std::unique_ptr<mpmc_queue<task_id>> mMainQueue;
+  thread_pool* mPool {};
+  std::exception_ptr mError;
+  std::atomic<bool> mFailed {};
+  std::atomic<uint32> mRemaining {};
+  uint64 mRuns {};
+  bool mCompiled {};
+
+  /* Counts the dependencies of each task, and rejects cyclic graphs */
+  void compile()
+  {
+    if (mCompiled) {
+      return;
+    }
+
+    for (auto& node : mNodes) {
+      node.dependencies = 0;
+    }
+
+    for (const auto& node : mNodes) {
+      for (const auto successor : node.successors) {
+        ++mNodes[successor].dependencies;
+      }
+    }
+
+    mRoots.clear();
+    for (task_id id = 0; id < mNodes.size(); ++id) {
+      if (mNodes[id].dependencies == 0) {
+        mRoots.push_back(id);
+      }
+    }
+
+    /* Kahn's algorithm, a graph is acyclic if every task can be reached from the roots */
+    std::vector<uint32> waiting;
+    waiting.reserve(mNodes.size());
+    for (const auto& node : mNodes) {
+      waiting.push_back(node.dependencies);
+    }
+
+    std::vector<task_id> ready = mRoots;
+    size_type visited = 0;
+
+    while (!ready.empty()) {
+      const auto id = ready.back();
+      ready.pop_back();
+      ++visited;
+
+      for (const auto successor : mNodes[id].successors) {
+        if (--waiting[successor] == 0) {
+          ready.push_back(successor);
+        }
+      }
+    }
+
+    if (visited != mNodes.size()) {
+      throw exception {"Task graph contains a cycle!"};
+    }
+
+    if (!mMainQueue || mMainQueue->capacity() < mNodes.size()) {
+      mMainQueue = std::make_unique<mpmc_queue<task_id>>(mNodes.size());
+    }
+
+    mCompiled = true;
+  }
+
+  void schedule(const task_id id)
+  {
+    if (mNodes[id].affinity == task_affinity::main) {
+      /* The queue can hold every task, so this never fails */
+      mMainQueue->try_push(id);
+    }
+    else {
+      mPool->post([this, id] { execute(id); });
+    }
+  }
+
+  void execute(const task_id id) noexcept
+  {
+    auto& node = mNodes[id];
+
+    if (!mFailed.load(std::memory_order_acquire)) {
+      CENTURION_PROFILE_SCOPE(node.name);
+
+      try {
+        node.task();
+      }
+      catch (...) {
+        /* Only the first exception is stored, which happens before the flag is published */
+        if (!mFailed.exchange(true, std::memory_order_acq_rel)) {
+          mError = std::current_exception();
+        }
+      }
+    }
+
+    for (const auto successor : node.successors) {
+      if (mNodes[successor].waiting.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        schedule(successor);
+      }
+    }
+
+    mRemaining.fetch_sub(1, std::memory_order_release);
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_TASK_GRAPH_HPP_
@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_CONCURRENCY_TASK_QUEUE_HPP_
+#define CENTURION_CONCURRENCY_TASK_QUEUE_HPP_
+
+#include <functional>  // function
+#include <utility>     // forward, swap
+#include <vector>      // vector
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "locks.hpp"
+#include "spin_lock.hpp"
+
+namespace cen {
+
+/**
+ * A queue of functions that are executed by a specific thread, usually the main thread.
+ *
+ * Any thread may post functions to the queue, which are executed the next time the owning
+ * thread calls `run_pending()`, e.g. once per frame. This is useful for work that has to
+ * happen on a particular thread, such as uploading textures to the renderer.
+ *
+ * \see future::then()
+ */
+class task_queue final {
+ public:
+  using size_type = usize;
+
+  task_queue() = default;
+
+  CENTURION_DISABLE_COPY(task_queue)
+  CENTURION_DISABLE_MOVE(task_queue)
+
+  /**
+   * Adds a function object to the queue, may be called from any thread.
+   *
+   * \param callable the function object that will be executed, with signature `void()`.
+   */
+  template <typename Callable>
+  void post(Callable&& callable)
+  {
+    scoped_lock lock {mLock};
+    mTasks.emplace_back(std::forward<Callable>(callable));
+  }
+
+  /**
+   * Executes all functions that were posted before the call.
+   *
+   * Functions posted by the executed functions are left in the queue until the next call.
+   *
+   * \return the amount of executed functions.
+   */
+  auto run_pending() -> size_type
+  {
+    {
+      scoped_lock lock {mLock};
+      std::swap(mTasks, mRunning);
+    }
+
+    for (auto& task : mRunning) {
+      task();
+    }
+
+    const auto count = mRunning.size();
+    mRunning.clear();
+
+    return count;
+  }
+
+  /// Returns the amount of functions waiting to be executed.
+  [[nodiscard]] auto size() const -> size_type
+  {
+    scoped_lock lock {mLock};
+    return mTasks.size();
+  }
+
+  /// Indicates whether there are no functions waiting to be executed.
+  [[nodiscard]] auto empty() const -> bool { return size() == 0; }
+
+ private:
+  mutable spin_lock mLock;
+  std::vector<std::function<void()>> mTasks;
+  std::vector<std::function<void()>> mRunning;
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_TASK_QUEUE_HPP_
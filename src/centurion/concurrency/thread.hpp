@@ -28,11 +28,11 @@
 #include <SDL.h>
 
 #include <cassert>      // assert
-#include <ostream>      // ostream
 #include <string>       // string, to_string
 #include <string_view>  // string_view
 #include <type_traits>  // invoke_result_t
 #include <utility>      // declval
+#include <vector>       // vector
 
 #include "../common/errors.hpp"
 #include "../common/primitives.hpp"
@@ -48,12 +48,24 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 #if CENTURION_HAS_FEATURE_CONCEPTS
 
 #include <concepts>  // convertible_to
 
 #endif  // CENTURION_HAS_FEATURE_CONCEPTS
 
+#ifdef __linux__
+
+#include <sched.h>  // sched_setaffinity, cpu_set_t, CPU_ZERO, CPU_SET, CPU_SETSIZE
+
+#endif  // __linux__
+
 namespace cen {
 
 using thread_id = SDL_threadID;
@@ -84,6 +96,25 @@ class thread final {
     }
   }
 
+  /**
+   * Creates a thread with a specific stack size and starts executing it.
+   *
+   * \param task the function that will be executed by the thread.
+   * \param name the name of the thread.
+   * \param stackSize the size of the stack of the thread, in bytes.
+   * \param data optional user data supplied to the task.
+   */
+  CENTURION_NODISCARD_CTOR thread(SDL_ThreadFunction task,
+                                  const char* name,
+                                  const usize stackSize,
+                                  void* data = nullptr)
+      : mThread {SDL_CreateThreadWithStackSize(task, name, stackSize, data)}
+  {
+    if (!mThread) {
+      throw sdl_error {};
+    }
+  }
+
   CENTURION_DISABLE_COPY(thread)
 
   ~thread() noexcept
@@ -168,6 +199,43 @@ class thread final {
     return SDL_SetThreadPriority(static_cast<SDL_ThreadPriority>(priority)) == 0;
   }
 
+  /**
+   * Restricts the calling thread to a set of logical CPUs.
+   *
+   * \note This is currently only supported on Linux, and fails on other platforms.
+   *
+   * \param cpus the indices of the logical CPUs that the thread may run on.
+   *
+   * \return `success` if the affinity was changed; `failure` otherwise.
+   *
+   * \see physical_core_cpus()
+   */
+  static auto set_affinity([[maybe_unused]] const std::vector<int>& cpus) noexcept -> result
+  {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+
+    bool any = false;
+    for (const auto cpu : cpus) {
+      if (cpu >= 0 && cpu < CPU_SETSIZE) {
+        CPU_SET(static_cast<usize>(cpu), &set);
+        any = true;
+      }
+    }
+
+    return any && sched_setaffinity(0, sizeof set, &set) == 0;
+#else
+    return failure;
+#endif  // __linux__
+  }
+
+  /// Restricts the calling thread to a single logical CPU.
+  static auto set_affinity(const int cpu) -> result
+  {
+    return set_affinity(std::vector<int> {cpu});
+  }
+
   /// Waits for the thread to stop running.
   auto join() noexcept -> int
   {
@@ -252,6 +320,8 @@ class thread final {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const thread& thread) -> std::ostream&
 {
   return stream << to_string(thread);
@@ -262,6 +332,8 @@ inline auto operator<<(std::ostream& stream, const thread_priority priority) ->
   return stream << to_string(priority);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_CONCURRENCY_THREAD_HPP_
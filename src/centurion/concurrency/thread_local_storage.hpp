@@ -0,0 +1,195 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_CONCURRENCY_THREAD_LOCAL_STORAGE_HPP_
+#define CENTURION_CONCURRENCY_THREAD_LOCAL_STORAGE_HPP_
+
+#include <SDL.h>
+
+#include <memory>   // unique_ptr, make_unique
+#include <utility>  // forward
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+
+namespace cen {
+
+/**
+ * Stores a separate value of a type for each thread, using the SDL thread-local storage API.
+ *
+ * This is an alternative to `thread_local` variables, which aren't supported well by all
+ * toolchains. The value of a thread is created on first use, and is destroyed when the
+ * thread exits, if it was created by SDL. Other threads, including the main thread, must call
+ * `cleanup()` before exiting to destroy their values.
+ *
+ * SDL never releases thread-local storage slots, so instances should be long-lived, e.g.
+ * function-local statics. Values that still exist when an instance is destroyed are leaked
+ * until their threads exit.
+ *
+ * \tparam T the value type, pointer types are stored as non-owning pointers.
+ *
+ * \see thread_local_storage<T*>
+ */
+template <typename T>
+class thread_local_storage final {
+ public:
+  using value_type = T;
+
+  /**
+   * Creates a thread-local storage slot.
+   *
+   * \throws sdl_error if the slot cannot be created.
+   */
+  thread_local_storage() : mId {SDL_TLSCreate()}
+  {
+    if (mId == 0) {
+      throw sdl_error {};
+    }
+  }
+
+  CENTURION_DISABLE_COPY(thread_local_storage)
+  CENTURION_DISABLE_MOVE(thread_local_storage)
+
+  /**
+   * Returns the value of the calling thread, which is default constructed on first use.
+   *
+   * \throws sdl_error if the value cannot be stored.
+   */
+  [[nodiscard]] auto get() -> T&
+  {
+    if (auto* value = try_get()) {
+      return *value;
+    }
+    else {
+      return emplace();
+    }
+  }
+
+  /**
+   * Replaces the value of the calling thread.
+   *
+   * \param args the arguments forwarded to the constructor of the value.
+   *
+   * \return the new value.
+   *
+   * \throws sdl_error if the value cannot be stored.
+   */
+  template <typename... Args>
+  auto emplace(Args&&... args) -> T&
+  {
+    auto value = std::make_unique<T>(std::forward<Args>(args)...);
+
+    auto* previous = try_get();
+    if (SDL_TLSSet(mId, value.get(), &destroy) != 0) {
+      throw sdl_error {};
+    }
+
+    delete previous;
+    return *value.release();
+  }
+
+  /// Destroys the value of the calling thread, if there is one.
+  void reset() noexcept
+  {
+    if (auto* previous = try_get()) {
+      SDL_TLSSet(mId, nullptr, nullptr);
+      delete previous;
+    }
+  }
+
+  /// Returns the value of the calling thread, or a null pointer if there is none.
+  [[nodiscard]] auto try_get() const noexcept -> T*
+  {
+    return static_cast<T*>(SDL_TLSGet(mId));
+  }
+
+  /// Indicates whether the calling thread has a value.
+  [[nodiscard]] auto has_value() const noexcept -> bool { return try_get() != nullptr; }
+
+  [[nodiscard]] auto id() const noexcept -> SDL_TLSID { return mId; }
+
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+
+  /// Destroys all thread-local values of the calling thread, across all storage slots.
+  static void cleanup() noexcept { SDL_TLSCleanup(); }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 16)
+
+ private:
+  SDL_TLSID mId {};
+
+  static void SDLCALL destroy(void* value) noexcept { delete static_cast<T*>(value); }
+};
+
+/**
+ * Stores a separate non-owning pointer for each thread.
+ *
+ * Unlike the general template, this never allocates, and the pointers are simply forgotten
+ * when threads exit.
+ *
+ * \tparam T the pointee type.
+ */
+template <typename T>
+class thread_local_storage<T*> final {
+ public:
+  using value_type = T*;
+
+  /**
+   * Creates a thread-local storage slot.
+   *
+   * \throws sdl_error if the slot cannot be created.
+   */
+  thread_local_storage() : mId {SDL_TLSCreate()}
+  {
+    if (mId == 0) {
+      throw sdl_error {};
+    }
+  }
+
+  CENTURION_DISABLE_COPY(thread_local_storage)
+  CENTURION_DISABLE_MOVE(thread_local_storage)
+
+  /**
+   * Sets the pointer of the calling thread.
+   *
+   * \param ptr the new pointer, may be null.
+   *
+   * \return `success` if the pointer was stored; `failure` otherwise.
+   */
+  auto set(T* ptr) noexcept -> result { return SDL_TLSSet(mId, ptr, nullptr) == 0; }
+
+  /// Returns the pointer of the calling thread, which is null by default.
+  [[nodiscard]] auto get() const noexcept -> T* { return static_cast<T*>(SDL_TLSGet(mId)); }
+
+  [[nodiscard]] auto id() const noexcept -> SDL_TLSID { return mId; }
+
+ private:
+  SDL_TLSID mId {};
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_THREAD_LOCAL_STORAGE_HPP_
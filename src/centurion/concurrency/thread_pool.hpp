@@ -0,0 +1,621 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_CONCURRENCY_THREAD_POOL_HPP_
+#define CENTURION_CONCURRENCY_THREAD_POOL_HPP_
+
+#include <SDL.h>
+
+#include <atomic>       // atomic, atomic_flag
+#include <cassert>      // assert
+#include <deque>        // deque
+#include <exception>    // exception_ptr, current_exception, rethrow_exception
+#include <functional>   // function
+#include <memory>       // unique_ptr, make_unique, shared_ptr, make_shared
+#include <type_traits>  // decay_t
+#include <utility>      // move, forward
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/cpu.hpp"
+#include "condition.hpp"
+#include "locks.hpp"
+#include "mutex.hpp"
+#include "thread.hpp"
+#include "thread_local_storage.hpp"
+
+namespace cen {
+
+class thread_pool;
+
+/// The configuration of the worker threads of a thread pool.
+struct thread_pool_options final {
+  usize workers {};                    ///< The amount of workers, zero for the default.
+  const char* name {"thread_pool"};    ///< The name of the worker threads.
+  usize stack_size {};                 ///< The worker stack size, zero for the default.
+  maybe<thread_priority> priority;     ///< The priority of the workers, if any.
+  bool pin_to_physical_cores {false};  ///< Pins each worker to its own physical core.
+};
+
+namespace detail {
+
+/// The shared state of a task submitted to a thread pool.
+struct task_state final {
+  std::atomic<bool> done {false};
+  std::exception_ptr error;
+  std::atomic_flag guard = ATOMIC_FLAG_INIT;  ///< Protects the continuations.
+  std::vector<std::function<void()>> continuations;
+
+  void acquire() noexcept
+  {
+    while (guard.test_and_set(std::memory_order_acquire)) {
+      /* The critical sections are only a few instructions long */
+    }
+  }
+
+  void release() noexcept { guard.clear(std::memory_order_release); }
+};
+
+}  // namespace detail
+
+/**
+ * A handle to a task that was submitted to a thread pool.
+ *
+ * \see thread_pool::submit()
+ */
+class task_handle final {
+ public:
+  task_handle() noexcept = default;
+
+  /**
+   * Waits for the task to finish.
+   *
+   * Instead of blocking, the calling thread helps to execute other pending tasks while it
+   * waits, which makes it safe to wait for tasks from within other tasks.
+   *
+   * \throws any exception that was thrown by the task.
+   */
+  void wait() const;
+
+  /**
+   * Schedules a function object to run once the task has finished.
+   *
+   * \param callable the function object to run after the task, with signature `void()`.
+   *
+   * \return a handle to the continuation task.
+   */
+  template <typename Callable>
+  auto then(Callable&& callable) const -> task_handle;
+
+  /// Indicates whether the task has finished.
+  [[nodiscard]] auto is_done() const noexcept -> bool
+  {
+    return !mState || mState->done.load(std::memory_order_acquire);
+  }
+
+  /// Indicates whether the handle refers to a task.
+  [[nodiscard]] explicit operator bool() const noexcept { return mState != nullptr; }
+
+ private:
+  friend class thread_pool;
+
+  thread_pool* mPool {};
+  std::shared_ptr<detail::task_state> mState;
+
+  task_handle(thread_pool* pool, std::shared_ptr<detail::task_state> state) noexcept
+      : mPool {pool}
+      , mState {std::move(state)}
+  {
+  }
+};
+
+/**
+ * A pool of worker threads that execute tasks, using work stealing for load balancing.
+ *
+ * Each worker has its own task queue, and tasks that are submitted from a worker are added
+ * to the queue of that worker. Idle workers steal tasks from the queues of other workers, so
+ * that all cores stay busy without a single contended queue. Idle workers sleep until there
+ * are more tasks, so an idle pool doesn't consume any CPU time.
+ *
+ * The amount of active workers can be lowered at runtime, e.g. to save power. Inactive
+ * workers are parked until they are activated again, and their pending tasks are stolen by
+ * the active workers.
+ *
+ * The pool finishes all submitted tasks before it is destroyed.
+ */
+class thread_pool final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a thread pool and starts its worker threads.
+   *
+   * \param workers the amount of worker threads, defaults to the amount of logical CPU cores.
+   *
+   * \throws sdl_error if a worker thread or the thread-local worker slot cannot be created.
+   */
+  explicit thread_pool(const size_type workers = default_worker_count())
+  {
+    thread_pool_options options;
+    options.workers = (detail::max)(workers, size_type {1});
+    start(options);
+  }
+
+  /**
+   * Creates a thread pool with configured worker threads and starts them.
+   *
+   * \param options the configuration of the worker threads.
+   *
+   * \throws sdl_error if a worker thread or the thread-local worker slot cannot be created.
+   */
+  explicit thread_pool(const thread_pool_options& options) { start(options); }
+
+  CENTURION_DISABLE_COPY(thread_pool)
+  CENTURION_DISABLE_MOVE(thread_pool)
+
+  ~thread_pool() noexcept { shutdown(); }
+
+  /**
+   * Submits a task to the pool.
+   *
+   * \param callable the function object that will be executed, with signature `void()`.
+   *
+   * \return a handle to the submitted task.
+   */
+  template <typename Callable>
+  auto submit(Callable&& callable) -> task_handle
+  {
+    auto state = std::make_shared<detail::task_state>();
+    enqueue(make_task(state, std::forward<Callable>(callable)));
+    return task_handle {this, std::move(state)};
+  }
+
+  /**
+   * Submits a task to the pool, without creating a handle to it.
+   *
+   * \details This avoids allocating the shared state of a task handle, which makes it
+   *          suitable for frequently submitted tasks whose completion is tracked in other
+   *          ways. Exceptions thrown by the task are ignored.
+   *
+   * \param callable the function object that will be executed, with signature `void()`.
+   */
+  template <typename Callable>
+  void post(Callable&& callable)
+  {
+    enqueue([fn = std::decay_t<Callable> {std::forward<Callable>(callable)}]() mutable {
+      try {
+        fn();
+      }
+      catch (...) {
+      }
+    });
+  }
+
+  /**
+   * Invokes a function object for every index in a range, in parallel.
+   *
+   * The range is split into chunks that are executed by the workers, and the calling thread
+   * helps to execute the chunks until all of them have finished.
+   *
+   * \param begin the first index of the range.
+   * \param end the index one past the last index of the range.
+   * \param callable the function object invoked for each index, with signature
+   *        `void(size_type)`.
+   * \param grain the amount of indices in each chunk, zero to pick a chunk size automatically.
+   *
+   * \throws any exception that was thrown by the function object, after all chunks have
+   *         finished.
+   */
+  template <typename Callable>
+  void parallel_for(const size_type begin,
+                    const size_type end,
+                    const Callable& callable,
+                    size_type grain = 0)
+  {
+    if (begin >= end) {
+      return;
+    }
+
+    const auto count = end - begin;
+    if (grain == 0) {
+      grain = (detail::max)(count / (active_workers() * 4), size_type {1});
+    }
+
+    std::vector<task_handle> chunks;
+    chunks.reserve((count + grain - 1) / grain);
+
+    std::exception_ptr error;
+
+    try {
+      for (auto first = begin; first < end; first += grain) {
+        const auto last = (detail::min)(first + grain, end);
+        chunks.push_back(submit([first, last, &callable] {
+          for (auto index = first; index < last; ++index) {
+            callable(index);
+          }
+        }));
+      }
+    }
+    catch (...) {
+      error = std::current_exception();
+    }
+
+    // Every chunk refers to the callable, so all of them must finish before we may return
+    for (const auto& chunk : chunks) {
+      try {
+        chunk.wait();
+      }
+      catch (...) {
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  /**
+   * Executes a single pending task on the calling thread, if there is one.
+   *
+   * \return `true` if a task was executed; `false` if there were no pending tasks.
+   */
+  auto run_pending_task() -> bool
+  {
+    const auto* current = current_worker();
+    const auto index = (current && current->pool == this) ? current->index : npos;
+    if (auto task = find_task(index)) {
+      task();
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Indicates whether the calling thread is one of the workers of the pool.
+  [[nodiscard]] auto is_worker_thread() const noexcept -> bool
+  {
+    const auto* current = current_worker();
+    return current && current->pool == this;
+  }
+
+  /// Returns the amount of worker threads.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mWorkers.size(); }
+
+  /**
+   * Sets the amount of workers that execute tasks.
+   *
+   * \details The remaining workers are parked, which is cheaper than restarting them once
+   *          they are needed again. Parked workers finish the task they are executing.
+   *
+   * \param count the amount of active workers, clamped to [1, `size()`].
+   */
+  void set_active_workers(const size_type count) noexcept
+  {
+    scoped_lock lock {mSleepLock};
+    mActive.store((detail::clamp)(count, size_type {1}, mWorkers.size()),
+                  std::memory_order_relaxed);
+
+    /* Activated workers leave the parking lot, deactivated workers go there */
+    mParked.broadcast();
+    mWake.broadcast();
+  }
+
+  /// Returns the amount of workers that execute tasks.
+  [[nodiscard]] auto active_workers() const noexcept -> size_type
+  {
+    return mActive.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of submitted tasks that haven't started executing.
+  [[nodiscard]] auto pending() const noexcept -> size_type
+  {
+    return mPending.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of logical CPU cores, which is the default amount of workers.
+  [[nodiscard]] static auto default_worker_count() noexcept -> size_type
+  {
+    return static_cast<size_type>(logical_cpu_count());
+  }
+
+ private:
+  friend class task_handle;
+
+  using task_fn = std::function<void()>;
+
+  inline constexpr static size_type npos = static_cast<size_type>(-1);
+
+  struct worker final {
+    thread_pool* pool {};
+    size_type index {};
+    int cpu {-1};  ///< The logical CPU that the worker is pinned to, if any.
+    mutex lock;
+    std::deque<task_fn> tasks;
+    std::unique_ptr<thread> handle;
+  };
+
+  std::vector<std::unique_ptr<worker>> mWorkers;
+  mutex mSleepLock;
+  condition mWake;
+  condition mParked;
+  std::atomic<size_type> mActive {0};
+  std::atomic<size_type> mPending {0};
+  std::atomic<size_type> mNext {0};
+  std::atomic<bool> mStopping {false};
+  maybe<thread_priority> mPriority;
+
+  /* Identifies the worker running on the calling thread, null for other threads. The slot is
+     created by start(), which is the only call that may throw. */
+  [[nodiscard]] static auto worker_storage() -> thread_local_storage<const worker*>&
+  {
+    static thread_local_storage<const worker*> storage;
+    return storage;
+  }
+
+  /* Only used by existing pools, so the slot has already been created by start() */
+  [[nodiscard]] static auto current_worker() noexcept -> const worker*
+  {
+    return worker_storage().get();
+  }
+
+  template <typename Callable>
+  [[nodiscard]] auto make_task(std::shared_ptr<detail::task_state> state,
+                               Callable&& callable) -> task_fn
+  {
+    auto fn = std::decay_t<Callable> {std::forward<Callable>(callable)};
+
+    return [this, state = std::move(state), fn = std::move(fn)]() mutable {
+      try {
+        fn();
+      }
+      catch (...) {
+        state->error = std::current_exception();
+      }
+
+      state->acquire();
+      state->done.store(true, std::memory_order_release);
+      auto continuations = std::move(state->continuations);
+      state->release();
+
+      for (auto& continuation : continuations) {
+        enqueue(std::move(continuation));
+      }
+    };
+  }
+
+  void enqueue(task_fn task)
+  {
+    const auto* current = current_worker();
+    const auto index = (current && current->pool == this)
+                           ? current->index
+                           : mNext.fetch_add(1, std::memory_order_relaxed) % active_workers();
+
+    auto& target = *mWorkers[index];
+    {
+      scoped_lock lock {target.lock};
+      target.tasks.push_back(std::move(task));
+    }
+
+    mPending.fetch_add(1, std::memory_order_release);
+
+    scoped_lock lock {mSleepLock};
+    mWake.signal();
+  }
+
+  /// Obtains a task from the queue of a worker, or steals one from another worker.
+  [[nodiscard]] auto find_task(const size_type index) -> task_fn
+  {
+    if (mPending.load(std::memory_order_acquire) == 0) {
+      return {};
+    }
+
+    /* Workers take their own most recent tasks, which are likely to be cache-hot */
+    if (index != npos) {
+      auto& own = *mWorkers[index];
+      scoped_lock lock {own.lock};
+
+      if (!own.tasks.empty()) {
+        auto task = std::move(own.tasks.back());
+        own.tasks.pop_back();
+        mPending.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+      }
+    }
+
+    /* Steal the oldest task of another worker */
+    const auto start = (index != npos) ? index + 1 : 0;
+    for (size_type offset = 0; offset < mWorkers.size(); ++offset) {
+      auto& victim = *mWorkers[(start + offset) % mWorkers.size()];
+      scoped_lock lock {victim.lock};
+
+      if (!victim.tasks.empty()) {
+        auto task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        mPending.fetch_sub(1, std::memory_order_relaxed);
+        return task;
+      }
+    }
+
+    return {};
+  }
+
+  static int SDLCALL run_worker(void* data)
+  {
+    auto* self = static_cast<worker*>(data);
+    auto* pool = self->pool;
+
+    worker_storage().set(self);
+
+    if (pool->mPriority) {
+      thread::set_priority(*pool->mPriority);
+    }
+
+    if (self->cpu != -1) {
+      thread::set_affinity(self->cpu);
+    }
+
+    for (;;) {
+      if (self->index >= pool->active_workers()) {
+        scoped_lock lock {pool->mSleepLock};
+
+        if (pool->mStopping.load(std::memory_order_relaxed)) {
+          break;
+        }
+        else if (self->index >= pool->active_workers()) {
+          pool->mParked.wait(pool->mSleepLock);
+        }
+
+        continue;
+      }
+
+      if (auto task = pool->find_task(self->index)) {
+        task();
+        continue;
+      }
+
+      scoped_lock lock {pool->mSleepLock};
+
+      if (pool->mPending.load(std::memory_order_acquire) != 0) {
+        continue;
+      }
+      else if (pool->mStopping.load(std::memory_order_relaxed)) {
+        break;
+      }
+
+      pool->mWake.wait(pool->mSleepLock);
+    }
+
+    return 0;
+  }
+
+  void start(const thread_pool_options& options)
+  {
+    (void) worker_storage();
+
+    std::vector<int> cores;
+    if (options.pin_to_physical_cores) {
+      cores = physical_core_cpus();
+    }
+
+    auto count = options.workers;
+    if (count == 0) {
+      count = cores.empty() ? default_worker_count() : cores.size();
+    }
+
+    mPriority = options.priority;
+    mActive.store(count, std::memory_order_relaxed);
+
+    for (size_type index = 0; index < count; ++index) {
+      auto& worker = *mWorkers.emplace_back(std::make_unique<thread_pool::worker>());
+      worker.pool = this;
+      worker.index = index;
+
+      if (!cores.empty()) {
+        worker.cpu = cores[index % cores.size()];
+      }
+    }
+
+    try {
+      for (auto& worker : mWorkers) {
+        worker->handle = (options.stack_size != 0)
+                             ? std::make_unique<thread>(&thread_pool::run_worker,
+                                                        options.name,
+                                                        options.stack_size,
+                                                        worker.get())
+                             : std::make_unique<thread>(&thread_pool::run_worker,
+                                                        options.name,
+                                                        worker.get());
+      }
+    }
+    catch (...) {
+      shutdown();
+      throw;
+    }
+  }
+
+  void shutdown() noexcept
+  {
+    {
+      scoped_lock lock {mSleepLock};
+      mStopping.store(true, std::memory_order_relaxed);
+      mWake.broadcast();
+      mParked.broadcast();
+    }
+
+    for (auto& worker : mWorkers) {
+      if (worker->handle) {
+        worker->handle->join();
+      }
+    }
+  }
+};
+
+inline void task_handle::wait() const
+{
+  if (!mState) {
+    return;
+  }
+
+  while (!mState->done.load(std::memory_order_acquire)) {
+    if (!mPool->run_pending_task()) {
+      SDL_Delay(0);
+    }
+  }
+
+  if (mState->error) {
+    std::rethrow_exception(mState->error);
+  }
+}
+
+template <typename Callable>
+auto task_handle::then(Callable&& callable) const -> task_handle
+{
+  assert(mState);
+
+  auto state = std::make_shared<detail::task_state>();
+  auto task = mPool->make_task(state, std::forward<Callable>(callable));
+
+  mState->acquire();
+  if (mState->done.load(std::memory_order_acquire)) {
+    mState->release();
+    mPool->enqueue(std::move(task));
+  }
+  else {
+    mState->continuations.push_back(std::move(task));
+    mState->release();
+  }
+
+  return task_handle {mPool, std::move(state)};
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_CONCURRENCY_THREAD_POOL_HPP_
@@ -0,0 +1,207 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_DETAIL_ANIMATION_KERNELS_HPP_
+#define CENTURION_DETAIL_ANIMATION_KERNELS_HPP_
+
+#include <cmath>  // floor
+
+#include "../common/primitives.hpp"
+#include "stdlib.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>  // SSE2 intrinsics
+
+#define CENTURION_HAS_SSE2_ANIMATION_KERNELS
+#define CENTURION_HAS_SIMD_ANIMATION_KERNELS
+
+#elif defined(__ARM_NEON)
+
+#include <arm_neon.h>  // NEON intrinsics
+
+#define CENTURION_HAS_NEON_ANIMATION_KERNELS
+#define CENTURION_HAS_SIMD_ANIMATION_KERNELS
+
+#endif  // SSE2
+
+/* Kernels for the structure-of-arrays animation system. The playback times of four instances
+   are advanced at a time with SSE2 or NEON, wrapping looping clips and clamping other clips
+   to their length, with the exact same operations as the scalar kernel. Neither instruction
+   set has a floor instruction in its baseline, so floor is emulated by truncating and
+   adjusting the negative quotients, which is exact as long as the quotients fit in 32-bit
+   integers, i.e. unless the time step is more than two billion times the clip length. The
+   frame look-up kernel is scalar, since it's a search over the frames of each clip. */
+
+namespace cen::detail {
+
+struct animation_arrays final {
+  float* time {};          ///< The playback times, in seconds.
+  const float* speed {};   ///< The playback speeds, negative speeds play in reverse.
+  const float* length {};  ///< The lengths of the clips, in seconds, always positive.
+  const float* loop {};    ///< One for looping clips, zero for clips that stop at the end.
+};
+
+/* t = t + dt * speed, then wrapped to [0, length) or clamped to [0, length] */
+inline void advance_scalar(const animation_arrays& a,
+                           const usize begin,
+                           const usize end,
+                           const float dt) noexcept
+{
+  for (auto index = begin; index < end; ++index) {
+    const auto length = a.length[index];
+    const auto time = a.time[index] + dt * a.speed[index];
+
+    if (a.loop[index] > 0) {
+      a.time[index] = time - std::floor(time / length) * length;
+    }
+    else {
+      a.time[index] = (detail::min)((detail::max)(time, 0.0f), length);
+    }
+  }
+}
+
+#if defined(CENTURION_HAS_SSE2_ANIMATION_KERNELS)
+
+inline void advance_simd(const animation_arrays& a, const usize count, const float dt) noexcept
+{
+  const auto vdt = _mm_set1_ps(dt);
+  const auto vzero = _mm_setzero_ps();
+  const auto vone = _mm_set1_ps(1.0f);
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto length = _mm_loadu_ps(a.length + index);
+    const auto speed = _mm_loadu_ps(a.speed + index);
+    const auto time = _mm_add_ps(_mm_loadu_ps(a.time + index), _mm_mul_ps(vdt, speed));
+
+    const auto quotient = _mm_div_ps(time, length);
+    const auto truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(quotient));
+    const auto floored =
+        _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, quotient), vone));
+    const auto wrapped = _mm_sub_ps(time, _mm_mul_ps(floored, length));
+
+    const auto clamped = _mm_min_ps(_mm_max_ps(time, vzero), length);
+
+    const auto looping = _mm_cmpgt_ps(_mm_loadu_ps(a.loop + index), vzero);
+    const auto result =
+        _mm_or_ps(_mm_and_ps(looping, wrapped), _mm_andnot_ps(looping, clamped));
+    _mm_storeu_ps(a.time + index, result);
+  }
+
+  advance_scalar(a, index, count, dt);
+}
+
+#elif defined(CENTURION_HAS_NEON_ANIMATION_KERNELS)
+
+inline void advance_simd(const animation_arrays& a, const usize count, const float dt) noexcept
+{
+  const auto vdt = vdupq_n_f32(dt);
+  const auto vzero = vdupq_n_f32(0.0f);
+  const auto vone = vdupq_n_f32(1.0f);
+
+  /* Divides rather than multiplying by a reciprocal estimate, to match the scalar kernel */
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto length = vld1q_f32(a.length + index);
+    const auto speed = vld1q_f32(a.speed + index);
+    const auto time = vaddq_f32(vld1q_f32(a.time + index), vmulq_f32(vdt, speed));
+
+#if defined(__aarch64__)
+    const auto quotient = vdivq_f32(time, length);
+#else
+    float quotients[4];
+    float times[4];
+    float lengths[4];
+    vst1q_f32(times, time);
+    vst1q_f32(lengths, length);
+    for (int lane = 0; lane < 4; ++lane) {
+      quotients[lane] = times[lane] / lengths[lane];
+    }
+    const auto quotient = vld1q_f32(quotients);
+#endif  // defined(__aarch64__)
+
+    const auto truncated = vcvtq_f32_s32(vcvtq_s32_f32(quotient));
+    const auto adjust = vreinterpretq_f32_u32(
+        vandq_u32(vcgtq_f32(truncated, quotient), vreinterpretq_u32_f32(vone)));
+    const auto floored = vsubq_f32(truncated, adjust);
+    const auto wrapped = vsubq_f32(time, vmulq_f32(floored, length));
+
+    const auto clamped = vminq_f32(vmaxq_f32(time, vzero), length);
+
+    const auto looping = vcgtq_f32(vld1q_f32(a.loop + index), vzero);
+    vst1q_f32(a.time + index, vbslq_f32(looping, wrapped, clamped));
+  }
+
+  advance_scalar(a, index, count, dt);
+}
+
+#endif  // defined(CENTURION_HAS_SSE2_ANIMATION_KERNELS)
+
+inline void advance_n(const animation_arrays& a, const usize count, const float dt) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_ANIMATION_KERNELS
+  advance_simd(a, count, dt);
+#else
+  advance_scalar(a, 0, count, dt);
+#endif  // CENTURION_HAS_SIMD_ANIMATION_KERNELS
+}
+
+/* Finds the frame that is shown at a time, given the cumulative end times of the frames of a
+   clip. The search starts at the previous frame, since instances usually either stay on the
+   same frame or advance by a single frame, and falls back to a binary search otherwise. */
+[[nodiscard]] inline auto find_frame(const float* ends,
+                                     const uint32 count,
+                                     const uint32 previous,
+                                     const float time) noexcept -> uint32
+{
+  auto frame = (detail::min)(previous, count - 1u);
+  const auto begin = (frame == 0) ? 0.0f : ends[frame - 1];
+
+  if (time >= begin && time < ends[frame]) {
+    return frame;
+  }
+  else if (frame + 1u < count && time >= ends[frame] && time < ends[frame + 1u]) {
+    return frame + 1u;
+  }
+
+  uint32 low = 0;
+  uint32 high = count - 1u;
+  while (low < high) {
+    const auto middle = low + (high - low) / 2u;
+    if (time < ends[middle]) {
+      high = middle;
+    }
+    else {
+      low = middle + 1u;
+    }
+  }
+
+  return low;
+}
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_ANIMATION_KERNELS_HPP_
@@ -0,0 +1,472 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_DETAIL_AUDIO_KERNELS_HPP_
+#define CENTURION_DETAIL_AUDIO_KERNELS_HPP_
+
+#include <cmath>  // lrint, sqrt, fabs
+
+#include "../common/primitives.hpp"
+#include "stdlib.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>  // SSE2 intrinsics
+
+#define CENTURION_HAS_SSE2_AUDIO_KERNELS
+#define CENTURION_HAS_SIMD_AUDIO_KERNELS
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+#include <arm_neon.h>  // NEON intrinsics
+
+#define CENTURION_HAS_NEON_AUDIO_KERNELS
+#define CENTURION_HAS_SIMD_AUDIO_KERNELS
+
+#endif  // SSE2
+
+/* Sample kernels used by the audio effects, which work on interleaved sample buffers. The
+   SIMD kernels process four (or eight) samples at a time, and finish the remaining samples
+   with the scalar loops. Conversions to 16-bit samples saturate, and round to nearest in
+   both the scalar and the SIMD versions. The NEON versions require AArch64, since 32-bit
+   NEON lacks a rounding conversion. */
+
+namespace cen::detail {
+
+inline constexpr float s16_scale = 32'768.0f;
+
+inline void gain_scalar(float* samples,
+                        const usize begin,
+                        const usize count,
+                        const float gain) noexcept
+{
+  for (auto index = begin; index < count; ++index) {
+    samples[index] *= gain;
+  }
+}
+
+inline void s16_to_f32_scalar(const int16* in,
+                              float* out,
+                              const usize begin,
+                              const usize count) noexcept
+{
+  for (auto index = begin; index < count; ++index) {
+    out[index] = static_cast<float>(in[index]) / s16_scale;
+  }
+}
+
+inline void f32_to_s16_scalar(const float* in,
+                              int16* out,
+                              const usize begin,
+                              const usize count) noexcept
+{
+  for (auto index = begin; index < count; ++index) {
+    const auto scaled = std::lrint(static_cast<double>(in[index] * s16_scale));
+    out[index] = static_cast<int16>((detail::min)((detail::max)(scaled, -32'768L), 32'767L));
+  }
+}
+
+/* The sum of the squares and the largest absolute value of a range of samples */
+struct sample_levels final {
+  float squares {};
+  float peak {};
+};
+
+inline void multiply_scalar(const float* a,
+                            const float* b,
+                            float* out,
+                            const usize begin,
+                            const usize count) noexcept
+{
+  for (auto index = begin; index < count; ++index) {
+    out[index] = a[index] * b[index];
+  }
+}
+
+inline void magnitude_scalar(const float* re,
+                             const float* im,
+                             float* out,
+                             const usize begin,
+                             const usize count) noexcept
+{
+  for (auto index = begin; index < count; ++index) {
+    out[index] = std::sqrt(re[index] * re[index] + im[index] * im[index]);
+  }
+}
+
+inline void levels_scalar(const float* in,
+                          const usize begin,
+                          const usize count,
+                          sample_levels& levels) noexcept
+{
+  for (auto index = begin; index < count; ++index) {
+    levels.squares += in[index] * in[index];
+    levels.peak = (detail::max)(levels.peak, std::fabs(in[index]));
+  }
+}
+
+/* A radix-2 butterfly over split complex values, the upper half is multiplied by the
+   twiddle factors, then added to and subtracted from the lower half */
+inline void butterfly_scalar(float* re,
+                             float* im,
+                             const float* wr,
+                             const float* wi,
+                             const usize begin,
+                             const usize half) noexcept
+{
+  for (auto index = begin; index < half; ++index) {
+    const auto br = re[index + half] * wr[index] - im[index + half] * wi[index];
+    const auto bi = re[index + half] * wi[index] + im[index + half] * wr[index];
+
+    re[index + half] = re[index] - br;
+    im[index + half] = im[index] - bi;
+    re[index] += br;
+    im[index] += bi;
+  }
+}
+
+#if defined(CENTURION_HAS_SSE2_AUDIO_KERNELS)
+
+inline void gain_simd(float* samples, const usize count, const float gain) noexcept
+{
+  const auto vgain = _mm_set1_ps(gain);
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    _mm_storeu_ps(samples + index, _mm_mul_ps(_mm_loadu_ps(samples + index), vgain));
+  }
+
+  gain_scalar(samples, index, count, gain);
+}
+
+inline void s16_to_f32_simd(const int16* in, float* out, const usize count) noexcept
+{
+  const auto vscale = _mm_set1_ps(1.0f / s16_scale);
+
+  usize index = 0;
+  for (; index + 8 <= count; index += 8) {
+    const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + index));
+
+    /* Sign-extends by moving each sample to the high half of a lane, then shifting down */
+    const auto low = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    const auto high = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+
+    _mm_storeu_ps(out + index, _mm_mul_ps(_mm_cvtepi32_ps(low), vscale));
+    _mm_storeu_ps(out + index + 4, _mm_mul_ps(_mm_cvtepi32_ps(high), vscale));
+  }
+
+  s16_to_f32_scalar(in, out, index, count);
+}
+
+inline void f32_to_s16_simd(const float* in, int16* out, const usize count) noexcept
+{
+  const auto vscale = _mm_set1_ps(s16_scale);
+  const auto vmax = _mm_set1_ps(32'767.0f);
+
+  usize index = 0;
+  for (; index + 8 <= count; index += 8) {
+    /* Out of range conversions yield INT_MIN, which the saturating pack handles for negative
+       values, so only the upper bound needs to be clamped first */
+    const auto low = _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(in + index), vscale), vmax);
+    const auto high = _mm_min_ps(_mm_mul_ps(_mm_loadu_ps(in + index + 4), vscale), vmax);
+
+    const auto packed = _mm_packs_epi32(_mm_cvtps_epi32(low), _mm_cvtps_epi32(high));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + index), packed);
+  }
+
+  f32_to_s16_scalar(in, out, index, count);
+}
+
+inline void multiply_simd(const float* a, const float* b, float* out, const usize count) noexcept
+{
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    _mm_storeu_ps(out + index, _mm_mul_ps(_mm_loadu_ps(a + index), _mm_loadu_ps(b + index)));
+  }
+
+  multiply_scalar(a, b, out, index, count);
+}
+
+inline void magnitude_simd(const float* re,
+                           const float* im,
+                           float* out,
+                           const usize count) noexcept
+{
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto r = _mm_loadu_ps(re + index);
+    const auto i = _mm_loadu_ps(im + index);
+    _mm_storeu_ps(out + index, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(r, r), _mm_mul_ps(i, i))));
+  }
+
+  magnitude_scalar(re, im, out, index, count);
+}
+
+inline void levels_simd(const float* in, const usize count, sample_levels& levels) noexcept
+{
+  const auto mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFF'FFFF));
+
+  auto squares = _mm_setzero_ps();
+  auto peak = _mm_setzero_ps();
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto v = _mm_loadu_ps(in + index);
+    squares = _mm_add_ps(squares, _mm_mul_ps(v, v));
+    peak = _mm_max_ps(peak, _mm_and_ps(v, mask));
+  }
+
+  alignas(16) float lanes[4];
+
+  _mm_store_ps(lanes, squares);
+  levels.squares += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+  _mm_store_ps(lanes, peak);
+  levels.peak = (detail::max)(levels.peak,
+                              (detail::max)((detail::max)(lanes[0], lanes[1]),
+                                            (detail::max)(lanes[2], lanes[3])));
+
+  levels_scalar(in, index, count, levels);
+}
+
+inline void butterfly_simd(float* re,
+                           float* im,
+                           const float* wr,
+                           const float* wi,
+                           const usize half) noexcept
+{
+  usize index = 0;
+  for (; index + 4 <= half; index += 4) {
+    const auto ar = _mm_loadu_ps(re + index);
+    const auto ai = _mm_loadu_ps(im + index);
+    const auto cr = _mm_loadu_ps(re + index + half);
+    const auto ci = _mm_loadu_ps(im + index + half);
+    const auto tr = _mm_loadu_ps(wr + index);
+    const auto ti = _mm_loadu_ps(wi + index);
+
+    const auto br = _mm_sub_ps(_mm_mul_ps(cr, tr), _mm_mul_ps(ci, ti));
+    const auto bi = _mm_add_ps(_mm_mul_ps(cr, ti), _mm_mul_ps(ci, tr));
+
+    _mm_storeu_ps(re + index + half, _mm_sub_ps(ar, br));
+    _mm_storeu_ps(im + index + half, _mm_sub_ps(ai, bi));
+    _mm_storeu_ps(re + index, _mm_add_ps(ar, br));
+    _mm_storeu_ps(im + index, _mm_add_ps(ai, bi));
+  }
+
+  butterfly_scalar(re, im, wr, wi, index, half);
+}
+
+#elif defined(CENTURION_HAS_NEON_AUDIO_KERNELS)
+
+inline void gain_simd(float* samples, const usize count, const float gain) noexcept
+{
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    vst1q_f32(samples + index, vmulq_n_f32(vld1q_f32(samples + index), gain));
+  }
+
+  gain_scalar(samples, index, count, gain);
+}
+
+inline void s16_to_f32_simd(const int16* in, float* out, const usize count) noexcept
+{
+  const auto scale = 1.0f / s16_scale;
+
+  usize index = 0;
+  for (; index + 8 <= count; index += 8) {
+    const auto v = vld1q_s16(in + index);
+
+    const auto low = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+    const auto high = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+
+    vst1q_f32(out + index, vmulq_n_f32(low, scale));
+    vst1q_f32(out + index + 4, vmulq_n_f32(high, scale));
+  }
+
+  s16_to_f32_scalar(in, out, index, count);
+}
+
+inline void f32_to_s16_simd(const float* in, int16* out, const usize count) noexcept
+{
+  usize index = 0;
+  for (; index + 8 <= count; index += 8) {
+    /* The conversions saturate, as does the narrowing */
+    const auto low = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(in + index), s16_scale));
+    const auto high = vcvtnq_s32_f32(vmulq_n_f32(vld1q_f32(in + index + 4), s16_scale));
+
+    vst1q_s16(out + index, vcombine_s16(vqmovn_s32(low), vqmovn_s32(high)));
+  }
+
+  f32_to_s16_scalar(in, out, index, count);
+}
+
+
+inline void multiply_simd(const float* a, const float* b, float* out, const usize count) noexcept
+{
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    vst1q_f32(out + index, vmulq_f32(vld1q_f32(a + index), vld1q_f32(b + index)));
+  }
+
+  multiply_scalar(a, b, out, index, count);
+}
+
+inline void magnitude_simd(const float* re,
+                           const float* im,
+                           float* out,
+                           const usize count) noexcept
+{
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto r = vld1q_f32(re + index);
+    const auto i = vld1q_f32(im + index);
+    vst1q_f32(out + index, vsqrtq_f32(vmlaq_f32(vmulq_f32(r, r), i, i)));
+  }
+
+  magnitude_scalar(re, im, out, index, count);
+}
+
+inline void levels_simd(const float* in, const usize count, sample_levels& levels) noexcept
+{
+  auto squares = vdupq_n_f32(0.0f);
+  auto peak = vdupq_n_f32(0.0f);
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto v = vld1q_f32(in + index);
+    squares = vmlaq_f32(squares, v, v);
+    peak = vmaxq_f32(peak, vabsq_f32(v));
+  }
+
+  levels.squares += vaddvq_f32(squares);
+  levels.peak = (detail::max)(levels.peak, vmaxvq_f32(peak));
+
+  levels_scalar(in, index, count, levels);
+}
+
+inline void butterfly_simd(float* re,
+                           float* im,
+                           const float* wr,
+                           const float* wi,
+                           const usize half) noexcept
+{
+  usize index = 0;
+  for (; index + 4 <= half; index += 4) {
+    const auto ar = vld1q_f32(re + index);
+    const auto ai = vld1q_f32(im + index);
+    const auto cr = vld1q_f32(re + index + half);
+    const auto ci = vld1q_f32(im + index + half);
+    const auto tr = vld1q_f32(wr + index);
+    const auto ti = vld1q_f32(wi + index);
+
+    const auto br = vmlsq_f32(vmulq_f32(cr, tr), ci, ti);
+    const auto bi = vmlaq_f32(vmulq_f32(cr, ti), ci, tr);
+
+    vst1q_f32(re + index + half, vsubq_f32(ar, br));
+    vst1q_f32(im + index + half, vsubq_f32(ai, bi));
+    vst1q_f32(re + index, vaddq_f32(ar, br));
+    vst1q_f32(im + index, vaddq_f32(ai, bi));
+  }
+
+  butterfly_scalar(re, im, wr, wi, index, half);
+}
+
+#endif  // defined(CENTURION_HAS_SSE2_AUDIO_KERNELS)
+
+inline void gain_n(float* samples, const usize count, const float gain) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_AUDIO_KERNELS
+  gain_simd(samples, count, gain);
+#else
+  gain_scalar(samples, 0, count, gain);
+#endif  // CENTURION_HAS_SIMD_AUDIO_KERNELS
+}
+
+inline void s16_to_f32_n(const int16* in, float* out, const usize count) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_AUDIO_KERNELS
+  s16_to_f32_simd(in, out, count);
+#else
+  s16_to_f32_scalar(in, out, 0, count);
+#endif  // CENTURION_HAS_SIMD_AUDIO_KERNELS
+}
+
+inline void f32_to_s16_n(const float* in, int16* out, const usize count) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_AUDIO_KERNELS
+  f32_to_s16_simd(in, out, count);
+#else
+  f32_to_s16_scalar(in, out, 0, count);
+#endif  // CENTURION_HAS_SIMD_AUDIO_KERNELS
+}
+
+inline void multiply_n(const float* a, const float* b, float* out, const usize count) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_AUDIO_KERNELS
+  multiply_simd(a, b, out, count);
+#else
+  multiply_scalar(a, b, out, 0, count);
+#endif  // CENTURION_HAS_SIMD_AUDIO_KERNELS
+}
+
+inline void magnitude_n(const float* re, const float* im, float* out, const usize count) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_AUDIO_KERNELS
+  magnitude_simd(re, im, out, count);
+#else
+  magnitude_scalar(re, im, out, 0, count);
+#endif  // CENTURION_HAS_SIMD_AUDIO_KERNELS
+}
+
+[[nodiscard]] inline auto levels_n(const float* in, const usize count) noexcept -> sample_levels
+{
+  sample_levels levels;
+
+#ifdef CENTURION_HAS_SIMD_AUDIO_KERNELS
+  levels_simd(in, count, levels);
+#else
+  levels_scalar(in, 0, count, levels);
+#endif  // CENTURION_HAS_SIMD_AUDIO_KERNELS
+
+  return levels;
+}
+
+inline void butterfly_n(float* re,
+                        float* im,
+                        const float* wr,
+                        const float* wi,
+                        const usize half) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_AUDIO_KERNELS
+  butterfly_simd(re, im, wr, wi, half);
+#else
+  butterfly_scalar(re, im, wr, wi, 0, half);
+#endif  // CENTURION_HAS_SIMD_AUDIO_KERNELS
+}
+
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_AUDIO_KERNELS_HPP_
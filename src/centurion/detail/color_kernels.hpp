@@ -0,0 +1,376 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_DETAIL_COLOR_KERNELS_HPP_
+#define CENTURION_DETAIL_COLOR_KERNELS_HPP_
+
+#include "../common/primitives.hpp"
+#include "pixel_conversion.hpp"
+#include "stdlib.hpp"
+
+/* Batch kernels for the color conversion and blending functions. Colors are processed as
+   RGBA byte quadruples, matching the layout of SDL_Color. The conversion kernels use a
+   branchless formulation of HSV and HSL, so that four colors can be converted at once. */
+
+namespace cen::detail {
+
+/* Exact rounding of n / 255 for n <= 65025, as with multiply_channel() */
+[[nodiscard]] constexpr auto blend_channel(const uint32 a,
+                                           const uint32 b,
+                                           const uint32 weight) noexcept -> uint8
+{
+  const auto sum = a * (255u - weight) + b * weight + 128u;
+  return static_cast<uint8>((sum + (sum >> 8u)) >> 8u);
+}
+
+inline void blend_scalar(const uint8* a,
+                         const uint8* b,
+                         uint8* out,
+                         const usize count,
+                         const uint8 weight) noexcept
+{
+  for (usize index = 0; index < count * 4; ++index) {
+    out[index] = blend_channel(a[index], b[index], weight);
+  }
+}
+
+/* Channel n of a color, where k is (n + hue / 60) mod 6 for HSV */
+[[nodiscard]] inline auto hsv_channel(const float k, const float value, const float chroma)
+    -> float
+{
+  return value - chroma * (detail::max)(0.0f, (detail::min)((detail::min)(k, 4.0f - k), 1.0f));
+}
+
+/* Channel n of a color, where k is (n + hue / 30) mod 12 for HSL */
+[[nodiscard]] inline auto hsl_channel(const float k, const float lightness, const float a)
+    -> float
+{
+  const auto t = (detail::min)((detail::min)(k - 3.0f, 9.0f - k), 1.0f);
+  return lightness - a * (detail::max)(-1.0f, t);
+}
+
+[[nodiscard]] inline auto wrap(const float k, const float period) noexcept -> float
+{
+  return (k >= period) ? k - period : k;
+}
+
+[[nodiscard]] inline auto to_channel(const float value) noexcept -> uint8
+{
+  return static_cast<uint8>(value * 255.0f + 0.5f);
+}
+
+/* Clamps and normalizes HSV or HSL values, where the last component is value or lightness */
+inline void normalize_hsx(float& hue, float& saturation, float& last) noexcept
+{
+  hue = detail::clamp(hue, 0.0f, 360.0f);
+  saturation = detail::clamp(saturation, 0.0f, 100.0f) / 100.0f;
+  last = detail::clamp(last, 0.0f, 100.0f) / 100.0f;
+}
+
+template <typename Hsv>
+void hsv_scalar(const Hsv* values, uint8* out, const usize count) noexcept
+{
+  for (usize index = 0; index < count; ++index, out += 4) {
+    auto [hue, saturation, value] = values[index];
+    normalize_hsx(hue, saturation, value);
+
+    const auto chroma = value * saturation;
+    const auto hp = hue / 60.0f;
+
+    out[0] = to_channel(hsv_channel(wrap(5.0f + hp, 6.0f), value, chroma));
+    out[1] = to_channel(hsv_channel(wrap(3.0f + hp, 6.0f), value, chroma));
+    out[2] = to_channel(hsv_channel(wrap(1.0f + hp, 6.0f), value, chroma));
+    out[3] = 0xFF;
+  }
+}
+
+template <typename Hsl>
+void hsl_scalar(const Hsl* values, uint8* out, const usize count) noexcept
+{
+  for (usize index = 0; index < count; ++index, out += 4) {
+    auto [hue, saturation, lightness] = values[index];
+    normalize_hsx(hue, saturation, lightness);
+
+    const auto a = saturation * (detail::min)(lightness, 1.0f - lightness);
+    const auto hp = hue / 30.0f;
+
+    out[0] = to_channel(hsl_channel(wrap(0.0f + hp, 12.0f), lightness, a));
+    out[1] = to_channel(hsl_channel(wrap(8.0f + hp, 12.0f), lightness, a));
+    out[2] = to_channel(hsl_channel(wrap(4.0f + hp, 12.0f), lightness, a));
+    out[3] = 0xFF;
+  }
+}
+
+#ifdef CENTURION_HAS_X86_PIXEL_KERNELS
+
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+inline auto blend_half_ssse3(const __m128i lhs,
+                             const __m128i rhs,
+                             const __m128i weightA,
+                             const __m128i weightB) noexcept -> __m128i
+{
+  const auto products = _mm_add_epi16(_mm_mullo_epi16(lhs, weightA),
+                                      _mm_mullo_epi16(rhs, weightB));
+  const auto sum = _mm_add_epi16(products, _mm_set1_epi16(128));
+  return _mm_srli_epi16(_mm_add_epi16(sum, _mm_srli_epi16(sum, 8)), 8);
+}
+
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+inline void blend_ssse3(const uint8* a,
+                        const uint8* b,
+                        uint8* out,
+                        usize count,
+                        const uint8 weight) noexcept
+{
+  const auto zero = _mm_setzero_si128();
+  const auto weightB = _mm_set1_epi16(static_cast<short>(weight));
+  const auto weightA = _mm_set1_epi16(static_cast<short>(255 - weight));
+
+  for (; count >= 4; count -= 4, a += 16, b += 16, out += 16) {
+    const auto lhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a));
+    const auto rhs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b));
+
+    const auto low = blend_half_ssse3(_mm_unpacklo_epi8(lhs, zero),
+                                      _mm_unpacklo_epi8(rhs, zero),
+                                      weightA,
+                                      weightB);
+    const auto high = blend_half_ssse3(_mm_unpackhi_epi8(lhs, zero),
+                                       _mm_unpackhi_epi8(rhs, zero),
+                                       weightA,
+                                       weightB);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(low, high));
+  }
+
+  blend_scalar(a, b, out, count, weight);
+}
+
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+inline auto wrap_ssse3(const __m128 k, const __m128 period) noexcept -> __m128
+{
+  return _mm_sub_ps(k, _mm_and_ps(_mm_cmpge_ps(k, period), period));
+}
+
+/* Vectorized versions of hsv_channel() and hsl_channel() */
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+inline auto hsv_channel_ssse3(const float n,
+                              const __m128 hp,
+                              const __m128 value,
+                              const __m128 chroma) noexcept -> __m128
+{
+  const auto k = wrap_ssse3(_mm_add_ps(_mm_set1_ps(n), hp), _mm_set1_ps(6.0f));
+  const auto t =
+      _mm_min_ps(_mm_min_ps(k, _mm_sub_ps(_mm_set1_ps(4.0f), k)), _mm_set1_ps(1.0f));
+  return _mm_sub_ps(value, _mm_mul_ps(chroma, _mm_max_ps(_mm_setzero_ps(), t)));
+}
+
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+inline auto hsl_channel_ssse3(const float n,
+                              const __m128 hp,
+                              const __m128 lightness,
+                              const __m128 a) noexcept -> __m128
+{
+  const auto k = wrap_ssse3(_mm_add_ps(_mm_set1_ps(n), hp), _mm_set1_ps(12.0f));
+  const auto t = _mm_min_ps(_mm_min_ps(_mm_sub_ps(k, _mm_set1_ps(3.0f)),
+                                       _mm_sub_ps(_mm_set1_ps(9.0f), k)),
+                            _mm_set1_ps(1.0f));
+  return _mm_sub_ps(lightness, _mm_mul_ps(a, _mm_max_ps(_mm_set1_ps(-1.0f), t)));
+}
+
+/* Converts four channels to bytes and transposes them into four RGBA colors */
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+inline void store_colors_ssse3(const __m128 red,
+                               const __m128 green,
+                               const __m128 blue,
+                               uint8* out) noexcept
+{
+  const auto scale = _mm_set1_ps(255.0f);
+  const auto half = _mm_set1_ps(0.5f);
+
+  const auto r = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(red, scale), half));
+  const auto g = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(green, scale), half));
+  const auto b = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(blue, scale), half));
+
+  const auto alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+  const auto pixels = _mm_or_si128(_mm_or_si128(r, _mm_slli_epi32(g, 8)),
+                                   _mm_or_si128(_mm_slli_epi32(b, 16), alpha));
+
+  /* The lanes were assembled as little-endian integers, which matches the byte order */
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(out), pixels);
+}
+
+/* Loads four HSV or HSL triples and normalizes them like normalize_hsx() */
+template <typename Hsx>
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+void load_hsx_ssse3(const Hsx* values,
+                    float Hsx::*last,
+                    __m128& hue,
+                    __m128& saturation,
+                    __m128& third) noexcept
+{
+  const auto zero = _mm_setzero_ps();
+  const auto hundred = _mm_set1_ps(100.0f);
+
+  hue = _mm_setr_ps(values[0].hue, values[1].hue, values[2].hue, values[3].hue);
+  hue = _mm_min_ps(_mm_max_ps(hue, zero), _mm_set1_ps(360.0f));
+
+  saturation = _mm_setr_ps(values[0].saturation,
+                           values[1].saturation,
+                           values[2].saturation,
+                           values[3].saturation);
+  saturation = _mm_div_ps(_mm_min_ps(_mm_max_ps(saturation, zero), hundred), hundred);
+
+  third = _mm_setr_ps(values[0].*last, values[1].*last, values[2].*last, values[3].*last);
+  third = _mm_div_ps(_mm_min_ps(_mm_max_ps(third, zero), hundred), hundred);
+}
+
+template <typename Hsv>
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+void hsv_ssse3(const Hsv* values, uint8* out, usize count) noexcept
+{
+  for (; count >= 4; count -= 4, values += 4, out += 16) {
+    __m128 hue;
+    __m128 saturation;
+    __m128 value;
+    load_hsx_ssse3(values, &Hsv::value, hue, saturation, value);
+
+    const auto chroma = _mm_mul_ps(value, saturation);
+    const auto hp = _mm_div_ps(hue, _mm_set1_ps(60.0f));
+
+    store_colors_ssse3(hsv_channel_ssse3(5.0f, hp, value, chroma),
+                       hsv_channel_ssse3(3.0f, hp, value, chroma),
+                       hsv_channel_ssse3(1.0f, hp, value, chroma),
+                       out);
+  }
+
+  hsv_scalar(values, out, count);
+}
+
+template <typename Hsl>
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+void hsl_ssse3(const Hsl* values, uint8* out, usize count) noexcept
+{
+  const auto one = _mm_set1_ps(1.0f);
+
+  for (; count >= 4; count -= 4, values += 4, out += 16) {
+    __m128 hue;
+    __m128 saturation;
+    __m128 lightness;
+    load_hsx_ssse3(values, &Hsl::lightness, hue, saturation, lightness);
+
+    const auto a = _mm_mul_ps(saturation, _mm_min_ps(lightness, _mm_sub_ps(one, lightness)));
+    const auto hp = _mm_div_ps(hue, _mm_set1_ps(30.0f));
+
+    store_colors_ssse3(hsl_channel_ssse3(0.0f, hp, lightness, a),
+                       hsl_channel_ssse3(8.0f, hp, lightness, a),
+                       hsl_channel_ssse3(4.0f, hp, lightness, a),
+                       out);
+  }
+
+  hsl_scalar(values, out, count);
+}
+
+#endif  // CENTURION_HAS_X86_PIXEL_KERNELS
+
+#ifdef CENTURION_HAS_NEON_PIXEL_KERNELS
+
+inline void blend_neon(const uint8* a,
+                       const uint8* b,
+                       uint8* out,
+                       usize count,
+                       const uint8 weight) noexcept
+{
+  const auto weightA = vdup_n_u8(static_cast<uint8>(255 - weight));
+  const auto weightB = vdup_n_u8(weight);
+
+  for (; count >= 4; count -= 4, a += 16, b += 16, out += 16) {
+    const auto lhs = vld1q_u8(a);
+    const auto rhs = vld1q_u8(b);
+
+    const auto low = vmlal_u8(vmull_u8(vget_low_u8(lhs), weightA), vget_low_u8(rhs), weightB);
+    const auto high =
+        vmlal_u8(vmull_u8(vget_high_u8(lhs), weightA), vget_high_u8(rhs), weightB);
+
+    /* Computes (x + ((x + 128) >> 8) + 128) >> 8, matching blend_channel() */
+    vst1q_u8(out,
+             vcombine_u8(vrshrn_n_u16(vrsraq_n_u16(low, low, 8), 8),
+                         vrshrn_n_u16(vrsraq_n_u16(high, high, 8), 8)));
+  }
+
+  blend_scalar(a, b, out, count, weight);
+}
+
+#endif  // CENTURION_HAS_NEON_PIXEL_KERNELS
+
+inline void blend_colors(const simd_level level,
+                         const uint8* a,
+                         const uint8* b,
+                         uint8* out,
+                         const usize count,
+                         const uint8 weight) noexcept
+{
+  switch (level) {
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+    case simd_level::avx2:
+    case simd_level::ssse3:
+      return blend_ssse3(a, b, out, count, weight);
+#elif defined(CENTURION_HAS_NEON_PIXEL_KERNELS)
+    case simd_level::neon:
+      return blend_neon(a, b, out, count, weight);
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+    default:
+      return blend_scalar(a, b, out, count, weight);
+  }
+}
+
+template <typename Hsv>
+void hsv_colors(const simd_level level, const Hsv* values, uint8* out, const usize count)
+{
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+  if (level == simd_level::avx2 || level == simd_level::ssse3) {
+    return hsv_ssse3(values, out, count);
+  }
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+  (void) level;
+  hsv_scalar(values, out, count);
+}
+
+template <typename Hsl>
+void hsl_colors(const simd_level level, const Hsl* values, uint8* out, const usize count)
+{
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+  if (level == simd_level::avx2 || level == simd_level::ssse3) {
+    return hsl_ssse3(values, out, count);
+  }
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+  (void) level;
+  hsl_scalar(values, out, count);
+}
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_COLOR_KERNELS_HPP_
@@ -0,0 +1,363 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_DETAIL_DRAW_KERNELS_HPP_
+#define CENTURION_DETAIL_DRAW_KERNELS_HPP_
+
+#include <SDL.h>
+
+#include <cstring>  // memcpy
+
+#include "../common/primitives.hpp"
+#include "color_kernels.hpp"
+#include "pixel_conversion.hpp"
+
+/* Span kernels for the software drawing functions of surface_canvas. Fills work with pixels
+   of any size, whereas the blending kernels require 32-bit pixels with 8-bit channels. The
+   channels are then blended byte by byte, regardless of their order, using the same rounding
+   as blend_channel(), so the vectorized kernels produce the same results as the scalar ones.
+   The color is mapped with an opaque alpha byte, so blending the alpha byte yields the alpha
+   of the source-over composition. */
+
+namespace cen::detail {
+
+template <int Bytes>
+[[nodiscard]] inline auto load_pixel(const uint8* src) noexcept -> uint32
+{
+  static_assert(Bytes >= 1 && Bytes <= 4);
+
+  if constexpr (Bytes == 1) {
+    return *src;
+  }
+  else if constexpr (Bytes == 2) {
+    uint16 pixel {};
+    std::memcpy(&pixel, src, sizeof pixel);
+    return pixel;
+  }
+  else if constexpr (Bytes == 3) {
+    if constexpr (SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+      return uint32 {src[0]} | (uint32 {src[1]} << 8u) | (uint32 {src[2]} << 16u);
+    }
+    else {
+      return (uint32 {src[0]} << 16u) | (uint32 {src[1]} << 8u) | uint32 {src[2]};
+    }
+  }
+  else {
+    uint32 pixel {};
+    std::memcpy(&pixel, src, sizeof pixel);
+    return pixel;
+  }
+}
+
+template <int Bytes>
+inline void store_pixel(uint8* dst, const uint32 pixel) noexcept
+{
+  static_assert(Bytes >= 1 && Bytes <= 4);
+
+  if constexpr (Bytes == 1) {
+    *dst = static_cast<uint8>(pixel);
+  }
+  else if constexpr (Bytes == 2) {
+    const auto value = static_cast<uint16>(pixel);
+    std::memcpy(dst, &value, sizeof value);
+  }
+  else if constexpr (Bytes == 3) {
+    if constexpr (SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+      dst[0] = static_cast<uint8>(pixel);
+      dst[1] = static_cast<uint8>(pixel >> 8u);
+      dst[2] = static_cast<uint8>(pixel >> 16u);
+    }
+    else {
+      dst[0] = static_cast<uint8>(pixel >> 16u);
+      dst[1] = static_cast<uint8>(pixel >> 8u);
+      dst[2] = static_cast<uint8>(pixel);
+    }
+  }
+  else {
+    std::memcpy(dst, &pixel, sizeof pixel);
+  }
+}
+
+template <int Bytes>
+inline void fill_span_scalar(uint8* row, const uint32 pixel, const usize count) noexcept
+{
+  for (usize index = 0; index < count; ++index, row += Bytes) {
+    store_pixel<Bytes>(row, pixel);
+  }
+}
+
+inline void blend_span_scalar(uint8* row,
+                              const uint32 pixel,
+                              const usize count,
+                              const uint8 weight) noexcept
+{
+  uint8 color[4] {};
+  std::memcpy(color, &pixel, sizeof color);
+
+  for (usize index = 0; index < count; ++index, row += 4) {
+    for (usize channel = 0; channel < 4; ++channel) {
+      row[channel] = blend_channel(row[channel], color[channel], weight);
+    }
+  }
+}
+
+/* Blends a color over a span, with the weight of each pixel taken from a coverage mask */
+inline void cover_span_scalar(uint8* row,
+                              const uint32 pixel,
+                              const uint8* coverage,
+                              const usize count) noexcept
+{
+  uint8 color[4] {};
+  std::memcpy(color, &pixel, sizeof color);
+
+  for (usize index = 0; index < count; ++index, row += 4) {
+    for (usize channel = 0; channel < 4; ++channel) {
+      row[channel] = blend_channel(row[channel], color[channel], coverage[index]);
+    }
+  }
+}
+
+#ifdef CENTURION_HAS_X86_PIXEL_KERNELS
+
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+inline void fill_span32_ssse3(uint8* row, const uint32 pixel, usize count) noexcept
+{
+  const auto value = _mm_set1_epi32(static_cast<int>(pixel));
+
+  for (; count >= 8; count -= 8, row += 32) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(row), value);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(row + 16), value);
+  }
+
+  for (; count >= 4; count -= 4, row += 16) {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(row), value);
+  }
+
+  fill_span_scalar<4>(row, pixel, count);
+}
+
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+inline void blend_span_ssse3(uint8* row,
+                             const uint32 pixel,
+                             usize count,
+                             const uint8 weight) noexcept
+{
+  const auto zero = _mm_setzero_si128();
+  const auto color = _mm_set1_epi32(static_cast<int>(pixel));
+  const auto colorLow = _mm_unpacklo_epi8(color, zero);
+  const auto weightB = _mm_set1_epi16(static_cast<short>(weight));
+  const auto weightA = _mm_set1_epi16(static_cast<short>(255 - weight));
+
+  /* Both halves of the color are the same, since it's the same pixel repeated */
+  for (; count >= 4; count -= 4, row += 16) {
+    const auto dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row));
+
+    const auto low =
+        blend_half_ssse3(_mm_unpacklo_epi8(dst, zero), colorLow, weightA, weightB);
+    const auto high =
+        blend_half_ssse3(_mm_unpackhi_epi8(dst, zero), colorLow, weightA, weightB);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(row), _mm_packus_epi16(low, high));
+  }
+
+  blend_span_scalar(row, pixel, count, weight);
+}
+
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+inline void cover_span_ssse3(uint8* row,
+                             const uint32 pixel,
+                             const uint8* coverage,
+                             usize count) noexcept
+{
+  constexpr char z = -1;
+
+  /* Broadcasts the coverage of each pixel into the 16-bit lanes of its channels */
+  const auto lowMask = _mm_setr_epi8(0, z, 0, z, 0, z, 0, z, 1, z, 1, z, 1, z, 1, z);
+  const auto highMask = _mm_setr_epi8(2, z, 2, z, 2, z, 2, z, 3, z, 3, z, 3, z, 3, z);
+
+  const auto zero = _mm_setzero_si128();
+  const auto full = _mm_set1_epi16(255);
+  const auto colorLow = _mm_unpacklo_epi8(_mm_set1_epi32(static_cast<int>(pixel)), zero);
+
+  for (; count >= 4; count -= 4, row += 16, coverage += 4) {
+    int weights {};
+    std::memcpy(&weights, coverage, sizeof weights);
+
+    const auto packed = _mm_cvtsi32_si128(weights);
+    const auto weightLow = _mm_shuffle_epi8(packed, lowMask);
+    const auto weightHigh = _mm_shuffle_epi8(packed, highMask);
+
+    const auto dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row));
+
+    const auto low = blend_half_ssse3(_mm_unpacklo_epi8(dst, zero),
+                                      colorLow,
+                                      _mm_sub_epi16(full, weightLow),
+                                      weightLow);
+    const auto high = blend_half_ssse3(_mm_unpackhi_epi8(dst, zero),
+                                       colorLow,
+                                       _mm_sub_epi16(full, weightHigh),
+                                       weightHigh);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(row), _mm_packus_epi16(low, high));
+  }
+
+  cover_span_scalar(row, pixel, coverage, count);
+}
+
+#endif  // CENTURION_HAS_X86_PIXEL_KERNELS
+
+#ifdef CENTURION_HAS_NEON_PIXEL_KERNELS
+
+inline void fill_span32_neon(uint8* row, const uint32 pixel, usize count) noexcept
+{
+  const auto value = vreinterpretq_u8_u32(vdupq_n_u32(pixel));
+
+  for (; count >= 4; count -= 4, row += 16) {
+    vst1q_u8(row, value);
+  }
+
+  fill_span_scalar<4>(row, pixel, count);
+}
+
+inline void blend_span_neon(uint8* row,
+                            const uint32 pixel,
+                            usize count,
+                            const uint8 weight) noexcept
+{
+  const auto color = vreinterpret_u8_u32(vdup_n_u32(pixel));
+  const auto weightA = vdup_n_u8(static_cast<uint8>(255 - weight));
+  const auto weightB = vdup_n_u8(weight);
+  const auto source = vmull_u8(color, weightB);
+
+  for (; count >= 4; count -= 4, row += 16) {
+    const auto dst = vld1q_u8(row);
+
+    const auto low = vmlal_u8(source, vget_low_u8(dst), weightA);
+    const auto high = vmlal_u8(source, vget_high_u8(dst), weightA);
+
+    /* Computes (x + ((x + 128) >> 8) + 128) >> 8, matching blend_channel() */
+    vst1q_u8(row,
+             vcombine_u8(vrshrn_n_u16(vrsraq_n_u16(low, low, 8), 8),
+                         vrshrn_n_u16(vrsraq_n_u16(high, high, 8), 8)));
+  }
+
+  blend_span_scalar(row, pixel, count, weight);
+}
+
+#endif  // CENTURION_HAS_NEON_PIXEL_KERNELS
+
+/* Fills a span of pixels of any size, only 32-bit pixels use the vectorized kernels */
+inline void fill_span(const simd_level level,
+                      const int bytesPerPixel,
+                      uint8* row,
+                      const uint32 pixel,
+                      const usize count) noexcept
+{
+  switch (bytesPerPixel) {
+    case 1:
+      return fill_span_scalar<1>(row, pixel, count);
+
+    case 2:
+      return fill_span_scalar<2>(row, pixel, count);
+
+    case 3:
+      return fill_span_scalar<3>(row, pixel, count);
+
+    default:
+      break;
+  }
+
+  switch (level) {
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+    case simd_level::avx2:
+    case simd_level::ssse3:
+      return fill_span32_ssse3(row, pixel, count);
+#elif defined(CENTURION_HAS_NEON_PIXEL_KERNELS)
+    case simd_level::neon:
+      return fill_span32_neon(row, pixel, count);
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+    default:
+      return fill_span_scalar<4>(row, pixel, count);
+  }
+}
+
+inline void blend_span(const simd_level level,
+                       uint8* row,
+                       const uint32 pixel,
+                       const usize count,
+                       const uint8 weight) noexcept
+{
+  switch (level) {
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+    case simd_level::avx2:
+    case simd_level::ssse3:
+      return blend_span_ssse3(row, pixel, count, weight);
+#elif defined(CENTURION_HAS_NEON_PIXEL_KERNELS)
+    case simd_level::neon:
+      return blend_span_neon(row, pixel, count, weight);
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+    default:
+      return blend_span_scalar(row, pixel, count, weight);
+  }
+}
+
+inline void cover_span(const simd_level level,
+                       uint8* row,
+                       const uint32 pixel,
+                       const uint8* coverage,
+                       const usize count) noexcept
+{
+  switch (level) {
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+    case simd_level::avx2:
+    case simd_level::ssse3:
+      return cover_span_ssse3(row, pixel, coverage, count);
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+    default:
+      return cover_span_scalar(row, pixel, coverage, count);
+  }
+}
+
+/* Indicates whether the blending kernels can be used with a pixel format */
+[[nodiscard]] inline auto has_byte_channels(const SDL_PixelFormat& format) noexcept -> bool
+{
+  if (format.BytesPerPixel != 4) {
+    return false;
+  }
+
+  const auto isByte = [](const uint32 mask) {
+    return mask == 0xFFu || mask == 0xFF00u || mask == 0xFF0000u || mask == 0xFF000000u;
+  };
+
+  return isByte(format.Rmask) && isByte(format.Gmask) && isByte(format.Bmask) &&
+         (format.Amask == 0 || isByte(format.Amask));
+}
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_DRAW_KERNELS_HPP_
@@ -0,0 +1,605 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_DETAIL_GEOMETRY_KERNELS_HPP_
+#define CENTURION_DETAIL_GEOMETRY_KERNELS_HPP_
+
+#include <type_traits>  // is_same_v
+
+#include "../common/primitives.hpp"
+#include "stdlib.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>  // SSE2 intrinsics
+
+#define CENTURION_HAS_SSE2_GEOMETRY_KERNELS
+#define CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+
+#elif defined(__ARM_NEON)
+
+#include <arm_neon.h>  // NEON intrinsics
+
+#define CENTURION_HAS_NEON_GEOMETRY_KERNELS
+#define CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+
+#endif  // SSE2
+
+/* Batch kernels for the structure-of-arrays rectangle and point containers. Every kernel
+   works on separate coordinate arrays, and the float kernels process four elements at a time
+   with SSE2 or NEON, which are part of the baseline of the targets that provide them, so no
+   runtime dispatch is needed. The remaining elements, and all integer kernels, use the
+   scalar loops, which compilers readily vectorize. Masks store one byte per element. */
+
+namespace cen::detail {
+
+/* Scalar kernels, with the same semantics as intersects() and basic_rect::contains() */
+
+template <typename T>
+[[nodiscard]] auto intersects_scalar(const T* x,
+                                     const T* y,
+                                     const T* w,
+                                     const T* h,
+                                     const usize begin,
+                                     const usize count,
+                                     const T rx,
+                                     const T ry,
+                                     const T rmx,
+                                     const T rmy,
+                                     uint8* mask) noexcept -> usize
+{
+  usize hits = 0;
+  for (auto index = begin; index < count; ++index) {
+    const auto hit = x[index] < rmx && y[index] < rmy && x[index] + w[index] > rx &&
+                     y[index] + h[index] > ry;
+    mask[index] = hit ? 1u : 0u;
+    hits += hit ? 1u : 0u;
+  }
+
+  return hits;
+}
+
+template <typename T>
+[[nodiscard]] auto contains_scalar(const T* x,
+                                   const T* y,
+                                   const T* w,
+                                   const T* h,
+                                   const usize begin,
+                                   const usize count,
+                                   const T px,
+                                   const T py,
+                                   uint8* mask) noexcept -> usize
+{
+  usize hits = 0;
+  for (auto index = begin; index < count; ++index) {
+    const auto hit = !(px < x[index] || py < y[index] || px > x[index] + w[index] ||
+                       py > y[index] + h[index]);
+    mask[index] = hit ? 1u : 0u;
+    hits += hit ? 1u : 0u;
+  }
+
+  return hits;
+}
+
+template <typename T>
+[[nodiscard]] auto within_scalar(const T* x,
+                                 const T* y,
+                                 const usize begin,
+                                 const usize count,
+                                 const T rx,
+                                 const T ry,
+                                 const T rmx,
+                                 const T rmy,
+                                 uint8* mask) noexcept -> usize
+{
+  usize hits = 0;
+  for (auto index = begin; index < count; ++index) {
+    const auto hit = !(x[index] < rx || y[index] < ry || x[index] > rmx || y[index] > rmy);
+    mask[index] = hit ? 1u : 0u;
+    hits += hit ? 1u : 0u;
+  }
+
+  return hits;
+}
+
+/* values[i] = values[i] * scale + offset */
+template <typename T>
+void affine_scalar(T* values,
+                   const usize begin,
+                   const usize count,
+                   const T scale,
+                   const T offset) noexcept
+{
+  for (auto index = begin; index < count; ++index) {
+    values[index] = values[index] * scale + offset;
+  }
+}
+
+template <typename T>
+void clamp_scalar(T* values,
+                  const usize begin,
+                  const usize count,
+                  const T min,
+                  const T max) noexcept
+{
+  for (auto index = begin; index < count; ++index) {
+    values[index] = (detail::min)((detail::max)(values[index], min), max);
+  }
+}
+
+/* Clips intervals [pos, pos + size) to [min, max), empty results have a size of zero */
+template <typename T>
+void clip_scalar(T* pos,
+                 T* size,
+                 const usize begin,
+                 const usize count,
+                 const T min,
+                 const T max) noexcept
+{
+  for (auto index = begin; index < count; ++index) {
+    const auto start = (detail::min)((detail::max)(pos[index], min), max);
+    const auto end = (detail::min)((detail::max)(pos[index] + size[index], min), max);
+    pos[index] = start;
+    size[index] = end - start;
+  }
+}
+
+#if defined(CENTURION_HAS_SSE2_GEOMETRY_KERNELS)
+
+/* Stores the low bytes of four 32-bit lane masks, and returns the amount of set lanes */
+inline auto store_mask(const __m128 lanes, uint8* mask) noexcept -> usize
+{
+  const auto bits = _mm_movemask_ps(lanes);
+  mask[0] = static_cast<uint8>(bits & 1);
+  mask[1] = static_cast<uint8>((bits >> 1) & 1);
+  mask[2] = static_cast<uint8>((bits >> 2) & 1);
+  mask[3] = static_cast<uint8>((bits >> 3) & 1);
+  return static_cast<usize>(mask[0] + mask[1] + mask[2] + mask[3]);
+}
+
+[[nodiscard]] inline auto intersects_simd(const float* x,
+                                          const float* y,
+                                          const float* w,
+                                          const float* h,
+                                          const usize count,
+                                          const float rx,
+                                          const float ry,
+                                          const float rmx,
+                                          const float rmy,
+                                          uint8* mask) noexcept -> usize
+{
+  const auto vrx = _mm_set1_ps(rx);
+  const auto vry = _mm_set1_ps(ry);
+  const auto vrmx = _mm_set1_ps(rmx);
+  const auto vrmy = _mm_set1_ps(rmy);
+
+  usize hits = 0;
+  usize index = 0;
+
+  for (; index + 4 <= count; index += 4) {
+    const auto vx = _mm_loadu_ps(x + index);
+    const auto vy = _mm_loadu_ps(y + index);
+    const auto vmx = _mm_add_ps(vx, _mm_loadu_ps(w + index));
+    const auto vmy = _mm_add_ps(vy, _mm_loadu_ps(h + index));
+
+    const auto lanes = _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(vx, vrmx), _mm_cmplt_ps(vy, vrmy)),
+                                  _mm_and_ps(_mm_cmpgt_ps(vmx, vrx), _mm_cmpgt_ps(vmy, vry)));
+    hits += store_mask(lanes, mask + index);
+  }
+
+  return hits + intersects_scalar(x, y, w, h, index, count, rx, ry, rmx, rmy, mask);
+}
+
+[[nodiscard]] inline auto contains_simd(const float* x,
+                                        const float* y,
+                                        const float* w,
+                                        const float* h,
+                                        const usize count,
+                                        const float px,
+                                        const float py,
+                                        uint8* mask) noexcept -> usize
+{
+  const auto vpx = _mm_set1_ps(px);
+  const auto vpy = _mm_set1_ps(py);
+
+  usize hits = 0;
+  usize index = 0;
+
+  for (; index + 4 <= count; index += 4) {
+    const auto vx = _mm_loadu_ps(x + index);
+    const auto vy = _mm_loadu_ps(y + index);
+    const auto vmx = _mm_add_ps(vx, _mm_loadu_ps(w + index));
+    const auto vmy = _mm_add_ps(vy, _mm_loadu_ps(h + index));
+
+    const auto lanes = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(vpx, vx), _mm_cmpge_ps(vpy, vy)),
+                                  _mm_and_ps(_mm_cmple_ps(vpx, vmx), _mm_cmple_ps(vpy, vmy)));
+    hits += store_mask(lanes, mask + index);
+  }
+
+  return hits + contains_scalar(x, y, w, h, index, count, px, py, mask);
+}
+
+[[nodiscard]] inline auto within_simd(const float* x,
+                                      const float* y,
+                                      const usize count,
+                                      const float rx,
+                                      const float ry,
+                                      const float rmx,
+                                      const float rmy,
+                                      uint8* mask) noexcept -> usize
+{
+  const auto vrx = _mm_set1_ps(rx);
+  const auto vry = _mm_set1_ps(ry);
+  const auto vrmx = _mm_set1_ps(rmx);
+  const auto vrmy = _mm_set1_ps(rmy);
+
+  usize hits = 0;
+  usize index = 0;
+
+  for (; index + 4 <= count; index += 4) {
+    const auto vx = _mm_loadu_ps(x + index);
+    const auto vy = _mm_loadu_ps(y + index);
+
+    const auto lanes = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(vx, vrx), _mm_cmpge_ps(vy, vry)),
+                                  _mm_and_ps(_mm_cmple_ps(vx, vrmx), _mm_cmple_ps(vy, vrmy)));
+    hits += store_mask(lanes, mask + index);
+  }
+
+  return hits + within_scalar(x, y, index, count, rx, ry, rmx, rmy, mask);
+}
+
+inline void affine_simd(float* values,
+                        const usize count,
+                        const float scale,
+                        const float offset) noexcept
+{
+  const auto vscale = _mm_set1_ps(scale);
+  const auto voffset = _mm_set1_ps(offset);
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto v = _mm_loadu_ps(values + index);
+    _mm_storeu_ps(values + index, _mm_add_ps(_mm_mul_ps(v, vscale), voffset));
+  }
+
+  affine_scalar(values, index, count, scale, offset);
+}
+
+inline void clamp_simd(float* values,
+                       const usize count,
+                       const float min,
+                       const float max) noexcept
+{
+  const auto vmin = _mm_set1_ps(min);
+  const auto vmax = _mm_set1_ps(max);
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto v = _mm_loadu_ps(values + index);
+    _mm_storeu_ps(values + index, _mm_min_ps(_mm_max_ps(v, vmin), vmax));
+  }
+
+  clamp_scalar(values, index, count, min, max);
+}
+
+inline void clip_simd(float* pos,
+                      float* size,
+                      const usize count,
+                      const float min,
+                      const float max) noexcept
+{
+  const auto vmin = _mm_set1_ps(min);
+  const auto vmax = _mm_set1_ps(max);
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto p = _mm_loadu_ps(pos + index);
+    const auto e = _mm_add_ps(p, _mm_loadu_ps(size + index));
+
+    const auto start = _mm_min_ps(_mm_max_ps(p, vmin), vmax);
+    const auto end = _mm_min_ps(_mm_max_ps(e, vmin), vmax);
+
+    _mm_storeu_ps(pos + index, start);
+    _mm_storeu_ps(size + index, _mm_sub_ps(end, start));
+  }
+
+  clip_scalar(pos, size, index, count, min, max);
+}
+
+#elif defined(CENTURION_HAS_NEON_GEOMETRY_KERNELS)
+
+/* Stores the low bytes of four 32-bit lane masks, and returns the amount of set lanes */
+inline auto store_mask(const uint32x4_t lanes, uint8* mask) noexcept -> usize
+{
+  const auto bits = vandq_u32(lanes, vdupq_n_u32(1));
+  mask[0] = static_cast<uint8>(vgetq_lane_u32(bits, 0));
+  mask[1] = static_cast<uint8>(vgetq_lane_u32(bits, 1));
+  mask[2] = static_cast<uint8>(vgetq_lane_u32(bits, 2));
+  mask[3] = static_cast<uint8>(vgetq_lane_u32(bits, 3));
+  return static_cast<usize>(mask[0] + mask[1] + mask[2] + mask[3]);
+}
+
+[[nodiscard]] inline auto intersects_simd(const float* x,
+                                          const float* y,
+                                          const float* w,
+                                          const float* h,
+                                          const usize count,
+                                          const float rx,
+                                          const float ry,
+                                          const float rmx,
+                                          const float rmy,
+                                          uint8* mask) noexcept -> usize
+{
+  const auto vrx = vdupq_n_f32(rx);
+  const auto vry = vdupq_n_f32(ry);
+  const auto vrmx = vdupq_n_f32(rmx);
+  const auto vrmy = vdupq_n_f32(rmy);
+
+  usize hits = 0;
+  usize index = 0;
+
+  for (; index + 4 <= count; index += 4) {
+    const auto vx = vld1q_f32(x + index);
+    const auto vy = vld1q_f32(y + index);
+    const auto vmx = vaddq_f32(vx, vld1q_f32(w + index));
+    const auto vmy = vaddq_f32(vy, vld1q_f32(h + index));
+
+    const auto lanes = vandq_u32(vandq_u32(vcltq_f32(vx, vrmx), vcltq_f32(vy, vrmy)),
+                                 vandq_u32(vcgtq_f32(vmx, vrx), vcgtq_f32(vmy, vry)));
+    hits += store_mask(lanes, mask + index);
+  }
+
+  return hits + intersects_scalar(x, y, w, h, index, count, rx, ry, rmx, rmy, mask);
+}
+
+[[nodiscard]] inline auto contains_simd(const float* x,
+                                        const float* y,
+                                        const float* w,
+                                        const float* h,
+                                        const usize count,
+                                        const float px,
+                                        const float py,
+                                        uint8* mask) noexcept -> usize
+{
+  const auto vpx = vdupq_n_f32(px);
+  const auto vpy = vdupq_n_f32(py);
+
+  usize hits = 0;
+  usize index = 0;
+
+  for (; index + 4 <= count; index += 4) {
+    const auto vx = vld1q_f32(x + index);
+    const auto vy = vld1q_f32(y + index);
+    const auto vmx = vaddq_f32(vx, vld1q_f32(w + index));
+    const auto vmy = vaddq_f32(vy, vld1q_f32(h + index));
+
+    const auto lanes = vandq_u32(vandq_u32(vcgeq_f32(vpx, vx), vcgeq_f32(vpy, vy)),
+                                 vandq_u32(vcleq_f32(vpx, vmx), vcleq_f32(vpy, vmy)));
+    hits += store_mask(lanes, mask + index);
+  }
+
+  return hits + contains_scalar(x, y, w, h, index, count, px, py, mask);
+}
+
+[[nodiscard]] inline auto within_simd(const float* x,
+                                      const float* y,
+                                      const usize count,
+                                      const float rx,
+                                      const float ry,
+                                      const float rmx,
+                                      const float rmy,
+                                      uint8* mask) noexcept -> usize
+{
+  const auto vrx = vdupq_n_f32(rx);
+  const auto vry = vdupq_n_f32(ry);
+  const auto vrmx = vdupq_n_f32(rmx);
+  const auto vrmy = vdupq_n_f32(rmy);
+
+  usize hits = 0;
+  usize index = 0;
+
+  for (; index + 4 <= count; index += 4) {
+    const auto vx = vld1q_f32(x + index);
+    const auto vy = vld1q_f32(y + index);
+
+    const auto lanes = vandq_u32(vandq_u32(vcgeq_f32(vx, vrx), vcgeq_f32(vy, vry)),
+                                 vandq_u32(vcleq_f32(vx, vrmx), vcleq_f32(vy, vrmy)));
+    hits += store_mask(lanes, mask + index);
+  }
+
+  return hits + within_scalar(x, y, index, count, rx, ry, rmx, rmy, mask);
+}
+
+inline void affine_simd(float* values,
+                        const usize count,
+                        const float scale,
+                        const float offset) noexcept
+{
+  const auto vscale = vdupq_n_f32(scale);
+  const auto voffset = vdupq_n_f32(offset);
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto v = vld1q_f32(values + index);
+    vst1q_f32(values + index, vaddq_f32(vmulq_f32(v, vscale), voffset));
+  }
+
+  affine_scalar(values, index, count, scale, offset);
+}
+
+inline void clamp_simd(float* values,
+                       const usize count,
+                       const float min,
+                       const float max) noexcept
+{
+  const auto vmin = vdupq_n_f32(min);
+  const auto vmax = vdupq_n_f32(max);
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto v = vld1q_f32(values + index);
+    vst1q_f32(values + index, vminq_f32(vmaxq_f32(v, vmin), vmax));
+  }
+
+  clamp_scalar(values, index, count, min, max);
+}
+
+inline void clip_simd(float* pos,
+                      float* size,
+                      const usize count,
+                      const float min,
+                      const float max) noexcept
+{
+  const auto vmin = vdupq_n_f32(min);
+  const auto vmax = vdupq_n_f32(max);
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto p = vld1q_f32(pos + index);
+    const auto e = vaddq_f32(p, vld1q_f32(size + index));
+
+    const auto start = vminq_f32(vmaxq_f32(p, vmin), vmax);
+    const auto end = vminq_f32(vmaxq_f32(e, vmin), vmax);
+
+    vst1q_f32(pos + index, start);
+    vst1q_f32(size + index, vsubq_f32(end, start));
+  }
+
+  clip_scalar(pos, size, index, count, min, max);
+}
+
+#endif  // defined(CENTURION_HAS_SSE2_GEOMETRY_KERNELS)
+
+/* Dispatchers, which select the vectorized kernels for float coordinates */
+
+template <typename T>
+[[nodiscard]] auto intersects_n(const T* x,
+                                const T* y,
+                                const T* w,
+                                const T* h,
+                                const usize count,
+                                const T rx,
+                                const T ry,
+                                const T rmx,
+                                const T rmy,
+                                uint8* mask) noexcept -> usize
+{
+#ifdef CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  if constexpr (std::is_same_v<T, float>) {
+    return intersects_simd(x, y, w, h, count, rx, ry, rmx, rmy, mask);
+  }
+  else
+#endif  // CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  {
+    return intersects_scalar(x, y, w, h, 0, count, rx, ry, rmx, rmy, mask);
+  }
+}
+
+template <typename T>
+[[nodiscard]] auto contains_n(const T* x,
+                              const T* y,
+                              const T* w,
+                              const T* h,
+                              const usize count,
+                              const T px,
+                              const T py,
+                              uint8* mask) noexcept -> usize
+{
+#ifdef CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  if constexpr (std::is_same_v<T, float>) {
+    return contains_simd(x, y, w, h, count, px, py, mask);
+  }
+  else
+#endif  // CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  {
+    return contains_scalar(x, y, w, h, 0, count, px, py, mask);
+  }
+}
+
+template <typename T>
+[[nodiscard]] auto within_n(const T* x,
+                            const T* y,
+                            const usize count,
+                            const T rx,
+                            const T ry,
+                            const T rmx,
+                            const T rmy,
+                            uint8* mask) noexcept -> usize
+{
+#ifdef CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  if constexpr (std::is_same_v<T, float>) {
+    return within_simd(x, y, count, rx, ry, rmx, rmy, mask);
+  }
+  else
+#endif  // CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  {
+    return within_scalar(x, y, 0, count, rx, ry, rmx, rmy, mask);
+  }
+}
+
+template <typename T>
+void affine_n(T* values, const usize count, const T scale, const T offset) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  if constexpr (std::is_same_v<T, float>) {
+    affine_simd(values, count, scale, offset);
+  }
+  else
+#endif  // CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  {
+    affine_scalar(values, 0, count, scale, offset);
+  }
+}
+
+template <typename T>
+void clamp_n(T* values, const usize count, const T min, const T max) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  if constexpr (std::is_same_v<T, float>) {
+    clamp_simd(values, count, min, max);
+  }
+  else
+#endif  // CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  {
+    clamp_scalar(values, 0, count, min, max);
+  }
+}
+
+template <typename T>
+void clip_n(T* pos, T* size, const usize count, const T min, const T max) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  if constexpr (std::is_same_v<T, float>) {
+    clip_simd(pos, size, count, min, max);
+  }
+  else
+#endif  // CENTURION_HAS_SIMD_GEOMETRY_KERNELS
+  {
+    clip_scalar(pos, size, 0, count, min, max);
+  }
+}
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_GEOMETRY_KERNELS_HPP_
@@ -0,0 +1,356 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_DETAIL_KEY_NAMES_HPP_
+#define CENTURION_DETAIL_KEY_NAMES_HPP_
+
+#include <SDL.h>
+
+#include <array>        // array
+#include <string_view>  // string_view
+
+#include "../common/primitives.hpp"
+#include "stdlib.hpp"
+
+/* Precomputed tables that map key and scan code names to codes and back, without allocating
+   or calling into SDL, which resolves names using linear searches with string comparisons.
+   The names mirror the tables of SDL, and are compared case-insensitively like in SDL. The
+   name look-up table is an open-addressing hash table that is built at compile time, using
+   the hash seed that yields the shortest probe sequences. */
+
+namespace cen::detail {
+
+/* Scan codes that were added after SDL 2.0.6 aren't included, and are resolved by SDL */
+inline constexpr usize scancode_name_count = 287;
+
+inline constexpr std::array<std::string_view, scancode_name_count> scancode_names = {{
+    /*   0 */ {}, {}, {}, {},
+    /*   4 */ "A", "B", "C", "D", "E", "F", "G", "H", "I", "J", "K", "L", "M", "N", "O", "P",
+    /*  20 */ "Q", "R", "S", "T", "U", "V", "W", "X", "Y", "Z",
+    /*  30 */ "1", "2", "3", "4", "5", "6", "7", "8", "9", "0",
+    /*  40 */ "Return", "Escape", "Backspace", "Tab", "Space", "-", "=", "[", "]", "\\", "#",
+    /*  51 */ ";", "'", "`", ",", ".", "/", "CapsLock",
+    /*  58 */ "F1", "F2", "F3", "F4", "F5", "F6", "F7", "F8", "F9", "F10", "F11", "F12",
+    /*  70 */ "PrintScreen", "ScrollLock", "Pause", "Insert", "Home", "PageUp", "Delete",
+    /*  77 */ "End", "PageDown", "Right", "Left", "Down", "Up",
+    /*  83 */ "Numlock", "Keypad /", "Keypad *", "Keypad -", "Keypad +", "Keypad Enter",
+    /*  89 */ "Keypad 1", "Keypad 2", "Keypad 3", "Keypad 4", "Keypad 5", "Keypad 6",
+    /*  95 */ "Keypad 7", "Keypad 8", "Keypad 9", "Keypad 0", "Keypad .",
+    /* 100 */ {}, "Application", "Power", "Keypad =",
+    /* 104 */ "F13", "F14", "F15", "F16", "F17", "F18", "F19", "F20", "F21", "F22", "F23",
+    /* 115 */ "F24",
+    /* 116 */ "Execute", "Help", "Menu", "Select", "Stop", "Again", "Undo", "Cut", "Copy",
+    /* 125 */ "Paste", "Find", "Mute", "VolumeUp", "VolumeDown", {}, {}, {},
+    /* 133 */ "Keypad ,", "Keypad = (AS400)",
+    /* 135 */ {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {},
+    /* 153 */ "AltErase", "SysReq", "Cancel", "Clear", "Prior", "Return", "Separator", "Out",
+    /* 161 */ "Oper", "Clear / Again", "CrSel", "ExSel",
+    /* 165 */ {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {},
+    /* 176 */ "Keypad 00", "Keypad 000", "ThousandsSeparator", "DecimalSeparator",
+    /* 180 */ "CurrencyUnit", "CurrencySubUnit", "Keypad (", "Keypad )", "Keypad {",
+    /* 185 */ "Keypad }", "Keypad Tab", "Keypad Backspace", "Keypad A", "Keypad B", "Keypad C",
+    /* 191 */ "Keypad D", "Keypad E", "Keypad F", "Keypad XOR", "Keypad ^", "Keypad %",
+    /* 197 */ "Keypad <", "Keypad >", "Keypad &", "Keypad &&", "Keypad |", "Keypad ||",
+    /* 203 */ "Keypad :", "Keypad #", "Keypad Space", "Keypad @", "Keypad !",
+    /* 208 */ "Keypad MemStore", "Keypad MemRecall", "Keypad MemClear", "Keypad MemAdd",
+    /* 212 */ "Keypad MemSubtract", "Keypad MemMultiply", "Keypad MemDivide", "Keypad +/-",
+    /* 216 */ "Keypad Clear", "Keypad ClearEntry", "Keypad Binary", "Keypad Octal",
+    /* 220 */ "Keypad Decimal", "Keypad Hexadecimal", {}, {},
+    /* 224 */ "Left Ctrl", "Left Shift", "Left Alt", "Left GUI", "Right Ctrl", "Right Shift",
+    /* 230 */ "Right Alt", "Right GUI",
+    /* 232 */ {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, {},
+    /* 252 */ {}, {}, {}, {}, {},
+    /* 257 */ "ModeSwitch", "AudioNext", "AudioPrev", "AudioStop", "AudioPlay", "AudioMute",
+    /* 263 */ "MediaSelect", "WWW", "Mail", "Calculator", "Computer", "AC Search", "AC Home",
+    /* 270 */ "AC Back", "AC Forward", "AC Stop", "AC Refresh", "AC Bookmarks",
+    /* 275 */ "BrightnessDown", "BrightnessUp", "DisplaySwitch", "KBDIllumToggle",
+    /* 279 */ "KBDIllumDown", "KBDIllumUp", "Eject", "Sleep", "App1", "App2",
+    /* 285 */ "AudioRewind", "AudioFastForward",
+}};
+
+inline constexpr usize key_name_table_size = 512;  // A power of two, at least twice the names
+inline constexpr usize key_name_table_mask = key_name_table_size - 1;
+
+struct key_name_table final {
+  std::array<uint16, key_name_table_size> slots {};  ///< Scan codes, or zero for empty slots.
+  usize max_probe {};                                ///< The longest probe sequence.
+  uint32 seed {};                                    ///< The seed of the name hashes.
+};
+
+[[nodiscard]] constexpr auto ascii_to_lower(const char c) noexcept -> char
+{
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+[[nodiscard]] constexpr auto equal_ignore_case(const std::string_view a,
+                                               const std::string_view b) noexcept -> bool
+{
+  if (a.size() != b.size()) {
+    return false;
+  }
+
+  for (usize index = 0; index < a.size(); ++index) {
+    if (ascii_to_lower(a[index]) != ascii_to_lower(b[index])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/* FNV-1a of the lowercase name, with the seed as the offset basis */
+[[nodiscard]] constexpr auto key_name_hash(const std::string_view name,
+                                           const uint32 seed) noexcept -> uint32
+{
+  uint32 hash = seed;
+  for (const auto c : name) {
+    hash ^= static_cast<uint8>(ascii_to_lower(c));
+    hash *= 16'777'619u;
+  }
+
+  /* Mixes the high bits into the low bits, which are used as the slot index */
+  hash ^= hash >> 15u;
+  hash *= 0x2C1B'3C6Du;
+  hash ^= hash >> 12u;
+  return hash;
+}
+
+[[nodiscard]] constexpr auto make_key_name_table(const uint32 seed) noexcept -> key_name_table
+{
+  key_name_table table;
+  table.seed = seed;
+
+  for (usize code = 0; code < scancode_name_count; ++code) {
+    const auto name = scancode_names[code];
+    if (name.empty()) {
+      continue;
+    }
+
+    auto slot = key_name_hash(name, seed) & key_name_table_mask;
+    for (usize probe = 0;; ++probe) {
+      const auto existing = table.slots[slot];
+
+      if (existing == 0) {
+        table.slots[slot] = static_cast<uint16>(code);
+        table.max_probe = (max)(table.max_probe, probe);
+        break;
+      }
+      else if (equal_ignore_case(scancode_names[existing], name)) {
+        break;  // Duplicate names resolve to the first scan code, like in SDL
+      }
+
+      slot = (slot + 1) & key_name_table_mask;
+    }
+  }
+
+  return table;
+}
+
+/* Tries a few seeds and keeps the table with the shortest probe sequences */
+[[nodiscard]] constexpr auto make_best_key_name_table() noexcept -> key_name_table
+{
+  auto best = make_key_name_table(2'166'136'261u);
+
+  for (uint32 attempt = 1; attempt < 32; ++attempt) {
+    const auto table = make_key_name_table(2'166'136'261u + attempt * 0x9E37'79B9u);
+    if (table.max_probe < best.max_probe) {
+      best = table;
+    }
+  }
+
+  return best;
+}
+
+inline constexpr key_name_table key_name_lookup = make_best_key_name_table();
+
+static_assert(key_name_lookup.max_probe < 4, "Poorly distributed key name hashes!");
+
+/* Characters used as the names of ASCII key codes, with letters in upper case like in SDL */
+[[nodiscard]] constexpr auto make_ascii_key_names() noexcept -> std::array<char, 128>
+{
+  std::array<char, 128> chars {};
+  for (usize index = 0; index < chars.size(); ++index) {
+    const auto c = static_cast<char>(index);
+    chars[index] = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+  }
+
+  return chars;
+}
+
+inline constexpr std::array<char, 128> ascii_key_names = make_ascii_key_names();
+
+/* Returns the name of a scan code, or nothing if the scan code isn't in the table */
+[[nodiscard]] constexpr auto scancode_name(const int code) noexcept -> maybe<std::string_view>
+{
+  if (code >= 0 && static_cast<usize>(code) < scancode_name_count) {
+    return scancode_names[static_cast<usize>(code)];
+  }
+  else {
+    return nothing;
+  }
+}
+
+/* Returns the scan code with the specified name, or SDL_SCANCODE_UNKNOWN */
+[[nodiscard]] constexpr auto scancode_from_name(const std::string_view name) noexcept
+    -> SDL_Scancode
+{
+  if (name.empty()) {
+    return SDL_SCANCODE_UNKNOWN;
+  }
+
+  auto slot = key_name_hash(name, key_name_lookup.seed) & key_name_table_mask;
+  for (usize probe = 0; probe <= key_name_lookup.max_probe; ++probe) {
+    const auto code = key_name_lookup.slots[slot];
+
+    if (code == 0) {
+      break;
+    }
+    else if (equal_ignore_case(scancode_names[code], name)) {
+      return static_cast<SDL_Scancode>(code);
+    }
+
+    slot = (slot + 1) & key_name_table_mask;
+  }
+
+  return SDL_SCANCODE_UNKNOWN;
+}
+
+/* Returns the key code of a scan code in the default key map of SDL */
+[[nodiscard]] constexpr auto default_keycode(const SDL_Scancode code) noexcept -> SDL_Keycode
+{
+  constexpr std::string_view punctuation = "-=[]\\#;'`,./";
+
+  if (code >= SDL_SCANCODE_A && code <= SDL_SCANCODE_Z) {
+    return 'a' + (code - SDL_SCANCODE_A);
+  }
+  else if (code >= SDL_SCANCODE_1 && code <= SDL_SCANCODE_9) {
+    return '1' + (code - SDL_SCANCODE_1);
+  }
+  else if (code == SDL_SCANCODE_0) {
+    return '0';
+  }
+  else if (code >= SDL_SCANCODE_RETURN && code <= SDL_SCANCODE_SPACE) {
+    constexpr SDL_Keycode keys[] = {SDLK_RETURN,  //
+                                    SDLK_ESCAPE,
+                                    SDLK_BACKSPACE,
+                                    SDLK_TAB,
+                                    SDLK_SPACE};
+    return keys[code - SDL_SCANCODE_RETURN];
+  }
+  else if (code > SDL_SCANCODE_SPACE && code < SDL_SCANCODE_CAPSLOCK) {
+    return punctuation[static_cast<usize>(code - SDL_SCANCODE_SPACE - 1)];
+  }
+  else if (code == SDL_SCANCODE_DELETE) {
+    return SDLK_DELETE;
+  }
+  else if (code == SDL_SCANCODE_UNKNOWN) {
+    return SDLK_UNKNOWN;
+  }
+  else {
+    return SDL_SCANCODE_TO_KEYCODE(code);
+  }
+}
+
+/* Returns the key code with the specified name, or SDLK_UNKNOWN, like SDL_GetKeyFromName */
+[[nodiscard]] constexpr auto keycode_from_name(const std::string_view name) noexcept
+    -> SDL_Keycode
+{
+  if (name.empty()) {
+    return SDLK_UNKNOWN;
+  }
+
+  /* Names that consist of a single UTF-8 encoded character are the key codes themselves */
+  const auto byte = [name](const usize index) noexcept -> SDL_Keycode {
+    return static_cast<uint8>(name[index]);
+  };
+
+  const auto lead = byte(0);
+  if (lead >= 0xF0) {
+    return (name.size() == 4) ? ((lead & 0x07) << 18) | ((byte(1) & 0x3F) << 12) |
+                                    ((byte(2) & 0x3F) << 6) | (byte(3) & 0x3F)
+                              : SDLK_UNKNOWN;
+  }
+  else if (lead >= 0xE0) {
+    return (name.size() == 3)
+               ? ((lead & 0x0F) << 12) | ((byte(1) & 0x3F) << 6) | (byte(2) & 0x3F)
+               : SDLK_UNKNOWN;
+  }
+  else if (lead >= 0xC0) {
+    return (name.size() == 2) ? ((lead & 0x1F) << 6) | (byte(1) & 0x3F) : SDLK_UNKNOWN;
+  }
+  else if (name.size() == 1) {
+    return static_cast<uint8>(ascii_to_lower(name.front()));
+  }
+  else {
+    return default_keycode(scancode_from_name(name));
+  }
+}
+
+/* Returns the name of a key code, or nothing if the name would have to be encoded as UTF-8 or
+   the key refers to a scan code that isn't in the table */
+[[nodiscard]] constexpr auto keycode_name(const SDL_Keycode key) noexcept
+    -> maybe<std::string_view>
+{
+  if (key & SDLK_SCANCODE_MASK) {
+    return scancode_name(key & ~SDLK_SCANCODE_MASK);
+  }
+
+  switch (key) {
+    case SDLK_RETURN:
+      return scancode_names[SDL_SCANCODE_RETURN];
+
+    case SDLK_ESCAPE:
+      return scancode_names[SDL_SCANCODE_ESCAPE];
+
+    case SDLK_BACKSPACE:
+      return scancode_names[SDL_SCANCODE_BACKSPACE];
+
+    case SDLK_TAB:
+      return scancode_names[SDL_SCANCODE_TAB];
+
+    case SDLK_SPACE:
+      return scancode_names[SDL_SCANCODE_SPACE];
+
+    case SDLK_DELETE:
+      return scancode_names[SDL_SCANCODE_DELETE];
+
+    default:
+      break;
+  }
+
+  if (key == SDLK_UNKNOWN) {
+    return std::string_view {};
+  }
+  else if (key > 0 && key < 0x80) {
+    return std::string_view {&ascii_key_names[static_cast<usize>(key)], 1};
+  }
+  else {
+    return nothing;
+  }
+}
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_KEY_NAMES_HPP_
@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_DETAIL_LUT_KERNELS_HPP_
+#define CENTURION_DETAIL_LUT_KERNELS_HPP_
+
+#include <cstring>  // memcpy
+
+#include "../common/primitives.hpp"
+#include "pixel_conversion.hpp"
+
+/* Lookup table kernels for 32-bit pixels. Each pixel is read as an integer, so the kernels
+   don't depend on the byte order. Every byte of a pixel selects an entry of the table for
+   its position, which holds the replacement byte already shifted into place, and the four
+   entries are combined into the new pixel. AVX2 gathers eight entries at once, the other
+   instruction sets lack a gather, so they use the scalar kernel. */
+
+namespace cen::detail {
+
+struct packed_lut final {
+  uint32 entries[4][256] {};  ///< The shifted replacements for each byte position.
+};
+
+inline void packed_lut_scalar(const packed_lut& lut, uint8* pixels, const usize count) noexcept
+{
+  for (usize index = 0; index < count; ++index, pixels += 4) {
+    uint32 pixel;
+    std::memcpy(&pixel, pixels, 4);
+
+    pixel = lut.entries[0][pixel & 0xFFu] | lut.entries[1][(pixel >> 8u) & 0xFFu] |
+            lut.entries[2][(pixel >> 16u) & 0xFFu] | lut.entries[3][pixel >> 24u];
+
+    std::memcpy(pixels, &pixel, 4);
+  }
+}
+
+#ifdef CENTURION_HAS_X86_PIXEL_KERNELS
+
+CENTURION_PIXEL_KERNEL_TARGET("avx2")
+inline void packed_lut_avx2(const packed_lut& lut, uint8* pixels, usize count) noexcept
+{
+  const auto mask = _mm256_set1_epi32(0xFF);
+
+  const auto* t0 = reinterpret_cast<const int*>(lut.entries[0]);
+  const auto* t1 = reinterpret_cast<const int*>(lut.entries[1]);
+  const auto* t2 = reinterpret_cast<const int*>(lut.entries[2]);
+  const auto* t3 = reinterpret_cast<const int*>(lut.entries[3]);
+
+  for (; count >= 8; count -= 8, pixels += 32) {
+    const auto pixel = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels));
+
+    const auto i0 = _mm256_and_si256(pixel, mask);
+    const auto i1 = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), mask);
+    const auto i2 = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), mask);
+    const auto i3 = _mm256_srli_epi32(pixel, 24);
+
+    const auto low = _mm256_or_si256(_mm256_i32gather_epi32(t0, i0, 4),
+                                     _mm256_i32gather_epi32(t1, i1, 4));
+    const auto high = _mm256_or_si256(_mm256_i32gather_epi32(t2, i2, 4),
+                                      _mm256_i32gather_epi32(t3, i3, 4));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels), _mm256_or_si256(low, high));
+  }
+
+  packed_lut_scalar(lut, pixels, count);
+}
+
+#endif  // CENTURION_HAS_X86_PIXEL_KERNELS
+
+/**
+ * Replaces a row of 32-bit pixels, in place.
+ *
+ * \param level the instruction set used by the kernel.
+ * \param lut the tables for each byte position.
+ * \param pixels the pixels that will be replaced.
+ * \param count the amount of pixels in the row.
+ */
+inline void apply_packed_lut(const simd_level level,
+                             const packed_lut& lut,
+                             uint8* pixels,
+                             const usize count) noexcept
+{
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+  if (level == simd_level::avx2) {
+    return packed_lut_avx2(lut, pixels, count);
+  }
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+  (void) level;
+  packed_lut_scalar(lut, pixels, count);
+}
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_LUT_KERNELS_HPP_
@@ -0,0 +1,303 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_DETAIL_LZ4_HPP_
+#define CENTURION_DETAIL_LZ4_HPP_
+
+#include <array>    // array
+#include <cstring>  // memcpy
+
+#include "../common/primitives.hpp"
+
+/* A self-contained implementation of the LZ4 block format, which is compatible with the
+   reference implementation. The compressor is a simple greedy matcher with a single hash
+   table, which favours speed over ratio, and the decompressor validates all offsets and
+   lengths, so it is safe to use with untrusted input. See "LZ4 Block Format Description" for
+   the details of the format. */
+
+namespace cen::detail {
+
+inline constexpr usize lz4_min_match = 4;
+inline constexpr usize lz4_last_literals = 5;  // The last bytes of a block are literals
+inline constexpr usize lz4_match_margin = 12;  // The last match starts before these bytes
+inline constexpr usize lz4_max_offset = 65'535;
+inline constexpr usize lz4_hash_bits = 12;
+
+/* The maximum size of a compressed block, for incompressible input */
+[[nodiscard]] constexpr auto lz4_compress_bound(const usize size) noexcept -> usize
+{
+  return size + (size / 255) + 16;
+}
+
+[[nodiscard]] inline auto lz4_read32(const uint8* data) noexcept -> uint32
+{
+  uint32 value {};
+  std::memcpy(&value, data, sizeof value);
+  return value;
+}
+
+[[nodiscard]] constexpr auto lz4_hash(const uint32 value) noexcept -> usize
+{
+  return static_cast<usize>((value * 2'654'435'761u) >> (32 - lz4_hash_bits));
+}
+
+/* Writes the remainder of a length that didn't fit into its token nibble */
+inline void lz4_write_length(uint8*& out, usize length) noexcept
+{
+  while (length >= 255) {
+    *out++ = 255;
+    length -= 255;
+  }
+
+  *out++ = static_cast<uint8>(length);
+}
+
+inline void lz4_write_sequence(uint8*& out,
+                               const uint8* literals,
+                               const usize literalCount,
+                               const usize offset,
+                               const usize matchLength) noexcept
+{
+  auto* token = out++;
+
+  *token = static_cast<uint8>(((literalCount < 15) ? literalCount : 15) << 4);
+  if (literalCount >= 15) {
+    lz4_write_length(out, literalCount - 15);
+  }
+
+  if (literalCount != 0) {
+    std::memcpy(out, literals, literalCount);
+    out += literalCount;
+  }
+
+  /* The final sequence only contains literals */
+  if (matchLength == 0) {
+    return;
+  }
+
+  *out++ = static_cast<uint8>(offset & 0xFF);
+  *out++ = static_cast<uint8>(offset >> 8);
+
+  const auto length = matchLength - lz4_min_match;
+  *token |= static_cast<uint8>((length < 15) ? length : 15);
+  if (length >= 15) {
+    lz4_write_length(out, length - 15);
+  }
+}
+
+/**
+ * Compresses a buffer into an LZ4 block.
+ *
+ * \param src the data that will be compressed.
+ * \param srcSize the size of the data, in bytes.
+ * \param dst the buffer that receives the block.
+ * \param dstCapacity the size of the buffer, which must be at least the compress bound.
+ *
+ * \return the size of the block; zero if the buffer is too small.
+ */
+[[nodiscard]] inline auto lz4_compress(const uint8* src,
+                                       const usize srcSize,
+                                       uint8* dst,
+                                       const usize dstCapacity) noexcept -> usize
+{
+  if (dstCapacity < lz4_compress_bound(srcSize)) {
+    return 0;
+  }
+
+  auto* out = dst;
+  usize anchor = 0;
+
+  if (srcSize > lz4_match_margin) {
+    std::array<usize, usize {1} << lz4_hash_bits> table {};
+
+    const auto matchLimit = srcSize - lz4_match_margin;
+    const auto matchEnd = srcSize - lz4_last_literals;
+
+    usize pos = 0;
+    while (pos < matchLimit) {
+      const auto sequence = lz4_read32(src + pos);
+      const auto hash = lz4_hash(sequence);
+
+      const auto candidate = table[hash];
+      table[hash] = pos;
+
+      if (candidate < pos && pos - candidate <= lz4_max_offset &&
+          lz4_read32(src + candidate) == sequence) {
+        auto start = pos;
+        auto match = candidate;
+        auto length = lz4_min_match;
+        while (pos + length < matchEnd && src[candidate + length] == src[pos + length]) {
+          ++length;
+        }
+
+        /* Extend the match backwards into the pending literals */
+        while (start > anchor && match > 0 && src[start - 1] == src[match - 1]) {
+          --start;
+          --match;
+          ++length;
+        }
+
+        lz4_write_sequence(out, src + anchor, start - anchor, start - match, length);
+
+        pos = start + length;
+        anchor = pos;
+
+        /* Index a position near the end of the match, to find the next match sooner */
+        if (pos - 2 < matchLimit) {
+          table[lz4_hash(lz4_read32(src + pos - 2))] = pos - 2;
+        }
+      }
+      else {
+        ++pos;
+      }
+    }
+  }
+
+  lz4_write_sequence(out, src + anchor, srcSize - anchor, 0, 0);
+  return static_cast<usize>(out - dst);
+}
+
+/* Reads the remainder of a length, returns false if the input ends first */
+[[nodiscard]] inline auto lz4_read_length(const uint8* src,
+                                          const usize srcSize,
+                                          usize& pos,
+                                          usize& length) noexcept -> bool
+{
+  uint8 byte {};
+  do {
+    if (pos >= srcSize) {
+      return false;
+    }
+
+    byte = src[pos++];
+    length += byte;
+  } while (byte == 255);
+
+  return true;
+}
+
+/**
+ * Decompresses an LZ4 block that may refer to data that precedes it.
+ *
+ * \details Blocks in linked LZ4 frames may copy matches from the preceding blocks, which must
+ *          then be stored immediately before the destination buffer.
+ *
+ * \param src the block.
+ * \param srcSize the size of the block, in bytes.
+ * \param dst the buffer that receives the decompressed data.
+ * \param dstCapacity the size of the buffer, in bytes.
+ * \param prefixSize the amount of valid bytes immediately before the buffer.
+ *
+ * \return the size of the decompressed data; an empty optional if the block was invalid.
+ */
+[[nodiscard]] inline auto lz4_decompress_prefixed(const uint8* src,
+                                                  const usize srcSize,
+                                                  uint8* dst,
+                                                  const usize dstCapacity,
+                                                  const usize prefixSize) noexcept
+    -> maybe<usize>
+{
+  usize in = 0;
+  usize out = 0;
+
+  while (in < srcSize) {
+    const auto token = src[in++];
+
+    usize literalCount = token >> 4;
+    if (literalCount == 15 && !lz4_read_length(src, srcSize, in, literalCount)) {
+      return nothing;
+    }
+
+    if (literalCount > srcSize - in || literalCount > dstCapacity - out) {
+      return nothing;
+    }
+
+    if (literalCount != 0) {
+      std::memcpy(dst + out, src + in, literalCount);
+      in += literalCount;
+      out += literalCount;
+    }
+
+    if (in == srcSize) {
+      break;
+    }
+
+    if (srcSize - in < 2) {
+      return nothing;
+    }
+
+    const auto offset = static_cast<usize>(src[in]) | (static_cast<usize>(src[in + 1]) << 8);
+    in += 2;
+
+    if (offset == 0 || offset > out + prefixSize) {
+      return nothing;
+    }
+
+    usize matchLength = token & 0xF;
+    if (matchLength == 15 && !lz4_read_length(src, srcSize, in, matchLength)) {
+      return nothing;
+    }
+
+    matchLength += lz4_min_match;
+    if (matchLength > dstCapacity - out) {
+      return nothing;
+    }
+
+    /* Matches may overlap their own output, so they are copied byte by byte. The source is
+       computed from the end of the prefix, since the offset may reach into the prefix */
+    const auto* match = dst + out - offset;
+    for (usize index = 0; index < matchLength; ++index) {
+      dst[out + index] = match[index];
+    }
+
+    out += matchLength;
+  }
+
+  return out;
+}
+
+/**
+ * Decompresses an LZ4 block.
+ *
+ * \param src the block.
+ * \param srcSize the size of the block, in bytes.
+ * \param dst the buffer that receives the decompressed data.
+ * \param dstSize the exact size of the decompressed data, in bytes.
+ *
+ * \return `true` if the block was valid and decompressed into exactly `dstSize` bytes;
+ *         `false` otherwise.
+ */
+[[nodiscard]] inline auto lz4_decompress(const uint8* src,
+                                         const usize srcSize,
+                                         uint8* dst,
+                                         const usize dstSize) noexcept -> bool
+{
+  const auto size = lz4_decompress_prefixed(src, srcSize, dst, dstSize, 0);
+  return size == dstSize;
+}
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_LZ4_HPP_
@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_DETAIL_PARTICLE_KERNELS_HPP_
+#define CENTURION_DETAIL_PARTICLE_KERNELS_HPP_
+
+#include <SDL.h>
+
+#include "../common/primitives.hpp"
+#include "stdlib.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>  // SSE2 intrinsics
+
+#define CENTURION_HAS_SSE2_PARTICLE_KERNELS
+#define CENTURION_HAS_SIMD_PARTICLE_KERNELS
+
+#elif defined(__ARM_NEON)
+
+#include <arm_neon.h>  // NEON intrinsics
+
+#define CENTURION_HAS_NEON_PARTICLE_KERNELS
+#define CENTURION_HAS_SIMD_PARTICLE_KERNELS
+
+#endif  // SSE2
+
+/* Kernels for the structure-of-arrays particle system. The integration kernels process four
+   particles at a time with SSE2 or NEON, and perform the exact same operations as the scalar
+   kernel, so the results don't depend on the selected kernel. The vertex kernel writes four
+   vertices and six indices per particle, and is left to the compiler. */
+
+namespace cen::detail {
+
+struct particle_arrays final {
+  float* x {};
+  float* y {};
+  float* vx {};
+  float* vy {};
+  float* age {};
+};
+
+/* v = (v + a * dt) * damping, p = p + v * dt, age = age + dt */
+inline void integrate_scalar(const particle_arrays& p,
+                             const usize begin,
+                             const usize end,
+                             const float axdt,
+                             const float aydt,
+                             const float damping,
+                             const float dt) noexcept
+{
+  for (auto index = begin; index < end; ++index) {
+    const auto vx = (p.vx[index] + axdt) * damping;
+    const auto vy = (p.vy[index] + aydt) * damping;
+    p.vx[index] = vx;
+    p.vy[index] = vy;
+    p.x[index] = p.x[index] + vx * dt;
+    p.y[index] = p.y[index] + vy * dt;
+    p.age[index] = p.age[index] + dt;
+  }
+}
+
+#if defined(CENTURION_HAS_SSE2_PARTICLE_KERNELS)
+
+inline void integrate_simd(const particle_arrays& p,
+                           const usize count,
+                           const float axdt,
+                           const float aydt,
+                           const float damping,
+                           const float dt) noexcept
+{
+  const auto vaxdt = _mm_set1_ps(axdt);
+  const auto vaydt = _mm_set1_ps(aydt);
+  const auto vdamping = _mm_set1_ps(damping);
+  const auto vdt = _mm_set1_ps(dt);
+
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto vx = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(p.vx + index), vaxdt), vdamping);
+    const auto vy = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(p.vy + index), vaydt), vdamping);
+    _mm_storeu_ps(p.vx + index, vx);
+    _mm_storeu_ps(p.vy + index, vy);
+    _mm_storeu_ps(p.x + index, _mm_add_ps(_mm_loadu_ps(p.x + index), _mm_mul_ps(vx, vdt)));
+    _mm_storeu_ps(p.y + index, _mm_add_ps(_mm_loadu_ps(p.y + index), _mm_mul_ps(vy, vdt)));
+    _mm_storeu_ps(p.age + index, _mm_add_ps(_mm_loadu_ps(p.age + index), vdt));
+  }
+
+  integrate_scalar(p, index, count, axdt, aydt, damping, dt);
+}
+
+#elif defined(CENTURION_HAS_NEON_PARTICLE_KERNELS)
+
+inline void integrate_simd(const particle_arrays& p,
+                           const usize count,
+                           const float axdt,
+                           const float aydt,
+                           const float damping,
+                           const float dt) noexcept
+{
+  const auto vaxdt = vdupq_n_f32(axdt);
+  const auto vaydt = vdupq_n_f32(aydt);
+  const auto vdamping = vdupq_n_f32(damping);
+  const auto vdt = vdupq_n_f32(dt);
+
+  /* Separate multiplies and adds rather than vmlaq, which may be fused */
+  usize index = 0;
+  for (; index + 4 <= count; index += 4) {
+    const auto vx = vmulq_f32(vaddq_f32(vld1q_f32(p.vx + index), vaxdt), vdamping);
+    const auto vy = vmulq_f32(vaddq_f32(vld1q_f32(p.vy + index), vaydt), vdamping);
+    vst1q_f32(p.vx + index, vx);
+    vst1q_f32(p.vy + index, vy);
+    vst1q_f32(p.x + index, vaddq_f32(vld1q_f32(p.x + index), vmulq_f32(vx, vdt)));
+    vst1q_f32(p.y + index, vaddq_f32(vld1q_f32(p.y + index), vmulq_f32(vy, vdt)));
+    vst1q_f32(p.age + index, vaddq_f32(vld1q_f32(p.age + index), vdt));
+  }
+
+  integrate_scalar(p, index, count, axdt, aydt, damping, dt);
+}
+
+#endif  // defined(CENTURION_HAS_SSE2_PARTICLE_KERNELS)
+
+inline void integrate_n(const particle_arrays& p,
+                        const usize count,
+                        const float axdt,
+                        const float aydt,
+                        const float damping,
+                        const float dt) noexcept
+{
+#ifdef CENTURION_HAS_SIMD_PARTICLE_KERNELS
+  integrate_simd(p, count, axdt, aydt, damping, dt);
+#else
+  integrate_scalar(p, 0, count, axdt, aydt, damping, dt);
+#endif  // CENTURION_HAS_SIMD_PARTICLE_KERNELS
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+/* Writes centered quads, fading the alpha linearly over the lifetime if requested */
+inline void particle_quads(const float* x,
+                           const float* y,
+                           const float* size,
+                           const float* age,
+                           const float* lifetime,
+                           const SDL_Color* tint,
+                           const usize begin,
+                           const usize end,
+                           const SDL_FRect& uv,
+                           const bool fade,
+                           SDL_Vertex* vertices,
+                           int* indices) noexcept
+{
+  const auto u0 = uv.x;
+  const auto v0 = uv.y;
+  const auto u1 = uv.x + uv.w;
+  const auto v1 = uv.y + uv.h;
+
+  for (auto index = begin; index < end; ++index) {
+    const auto half = size[index] * 0.5f;
+    const auto left = x[index] - half;
+    const auto top = y[index] - half;
+    const auto right = x[index] + half;
+    const auto bottom = y[index] + half;
+
+    auto color = tint[index];
+    if (fade && lifetime[index] > 0) {
+      const auto remaining = (detail::max)(1.0f - age[index] / lifetime[index], 0.0f);
+      color.a = static_cast<uint8>(static_cast<float>(color.a) * remaining);
+    }
+
+    auto* quad = vertices + index * 4u;
+    quad[0] = {{left, top}, color, {u0, v0}};
+    quad[1] = {{right, top}, color, {u1, v0}};
+    quad[2] = {{right, bottom}, color, {u1, v1}};
+    quad[3] = {{left, bottom}, color, {u0, v1}};
+
+    const auto first = static_cast<int>(index * 4u);
+    auto* triangles = indices + index * 6u;
+    triangles[0] = first;
+    triangles[1] = first + 1;
+    triangles[2] = first + 2;
+    triangles[3] = first + 2;
+    triangles[4] = first + 3;
+    triangles[5] = first;
+  }
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_PARTICLE_KERNELS_HPP_
@@ -0,0 +1,609 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_DETAIL_PIXEL_CONVERSION_HPP_
+#define CENTURION_DETAIL_PIXEL_CONVERSION_HPP_
+
+#include <SDL.h>
+
+#include <cstring>  // memcpy
+
+#include "../common/primitives.hpp"
+#include "stdlib.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+
+#include <immintrin.h>  // SSSE3 and AVX2 intrinsics
+
+#define CENTURION_HAS_X86_PIXEL_KERNELS
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CENTURION_PIXEL_KERNEL_TARGET(Target) __attribute__((target(Target)))
+#else
+#define CENTURION_PIXEL_KERNEL_TARGET(Target)
+#endif  // defined(__GNUC__) || defined(__clang__)
+
+#elif defined(__ARM_NEON)
+
+#include <arm_neon.h>  // NEON intrinsics
+
+#define CENTURION_HAS_NEON_PIXEL_KERNELS
+
+#endif  // x86
+
+/* Fast paths for surface::convert_to() between some common pixel formats. Only conversions
+   that are pure byte shuffles are handled, everything else is left to SDL. The kernels are
+   written in terms of byte order, so they are only used on little-endian platforms. This
+   header also provides the alpha premultiplication kernels used by surface. */
+
+namespace cen::detail {
+
+enum class pixel_kernel {
+  swap_02,     ///< Swaps bytes 0 and 2 of each 32-bit pixel.
+  swap_13,     ///< Swaps bytes 1 and 3 of each 32-bit pixel.
+  expand_012,  ///< Appends an opaque alpha byte to each 24-bit pixel.
+  expand_210   ///< Reverses each 24-bit pixel and appends an opaque alpha byte.
+};
+
+enum class simd_level { scalar, ssse3, avx2, neon };
+
+[[nodiscard]] constexpr auto find_pixel_kernel(const uint32 from, const uint32 to) noexcept
+    -> maybe<pixel_kernel>
+{
+  if constexpr (SDL_BYTEORDER != SDL_LIL_ENDIAN) {
+    return nothing;
+  }
+
+  const auto is = [=](const uint32 a, const uint32 b) { return from == a && to == b; };
+
+  if (is(SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888) ||
+      is(SDL_PIXELFORMAT_ABGR8888, SDL_PIXELFORMAT_ARGB8888) ||
+      is(SDL_PIXELFORMAT_XRGB8888, SDL_PIXELFORMAT_XBGR8888) ||
+      is(SDL_PIXELFORMAT_XBGR8888, SDL_PIXELFORMAT_XRGB8888)) {
+    return pixel_kernel::swap_02;
+  }
+  else if (is(SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888) ||
+           is(SDL_PIXELFORMAT_BGRA8888, SDL_PIXELFORMAT_RGBA8888)) {
+    return pixel_kernel::swap_13;
+  }
+  else if (is(SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_ARGB8888) ||
+           is(SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_XRGB8888) ||
+           is(SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ABGR8888) ||
+           is(SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_XBGR8888)) {
+    return pixel_kernel::expand_012;
+  }
+  else if (is(SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888) ||
+           is(SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_XRGB8888) ||
+           is(SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_ABGR8888) ||
+           is(SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_XBGR8888)) {
+    return pixel_kernel::expand_210;
+  }
+  else {
+    return nothing;
+  }
+}
+
+/* Scalar kernels, also used for the remaining pixels of the vectorized kernels */
+
+template <int I0, int I1, int I2, int I3>
+void swizzle_scalar(const uint8* src, uint8* dst, const usize count) noexcept
+{
+  for (usize index = 0; index < count; ++index, src += 4, dst += 4) {
+    uint8 pixel[4];
+    std::memcpy(pixel, src, 4);
+
+    dst[0] = pixel[I0];
+    dst[1] = pixel[I1];
+    dst[2] = pixel[I2];
+    dst[3] = pixel[I3];
+  }
+}
+
+template <int I0, int I1, int I2>
+void expand_scalar(const uint8* src, uint8* dst, const usize count) noexcept
+{
+  for (usize index = 0; index < count; ++index, src += 3, dst += 4) {
+    dst[0] = src[I0];
+    dst[1] = src[I1];
+    dst[2] = src[I2];
+    dst[3] = 0xFF;
+  }
+}
+
+#ifdef CENTURION_HAS_X86_PIXEL_KERNELS
+
+template <int I0, int I1, int I2, int I3>
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+void swizzle_ssse3(const uint8* src, uint8* dst, usize count) noexcept
+{
+  const auto mask = _mm_setr_epi8(I0, I1, I2, I3,  //
+                                  I0 + 4, I1 + 4, I2 + 4, I3 + 4,
+                                  I0 + 8, I1 + 8, I2 + 8, I3 + 8,
+                                  I0 + 12, I1 + 12, I2 + 12, I3 + 12);
+
+  for (; count >= 4; count -= 4, src += 16, dst += 16) {
+    const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_shuffle_epi8(pixels, mask));
+  }
+
+  swizzle_scalar<I0, I1, I2, I3>(src, dst, count);
+}
+
+template <int I0, int I1, int I2, int I3>
+CENTURION_PIXEL_KERNEL_TARGET("avx2")
+void swizzle_avx2(const uint8* src, uint8* dst, usize count) noexcept
+{
+  const auto mask = _mm256_setr_epi8(I0, I1, I2, I3,  //
+                                     I0 + 4, I1 + 4, I2 + 4, I3 + 4,
+                                     I0 + 8, I1 + 8, I2 + 8, I3 + 8,
+                                     I0 + 12, I1 + 12, I2 + 12, I3 + 12,
+                                     I0, I1, I2, I3,
+                                     I0 + 4, I1 + 4, I2 + 4, I3 + 4,
+                                     I0 + 8, I1 + 8, I2 + 8, I3 + 8,
+                                     I0 + 12, I1 + 12, I2 + 12, I3 + 12);
+
+  for (; count >= 8; count -= 8, src += 32, dst += 32) {
+    const auto pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), _mm256_shuffle_epi8(pixels, mask));
+  }
+
+  swizzle_scalar<I0, I1, I2, I3>(src, dst, count);
+}
+
+/* Each iteration loads 16 bytes but only consumes 12, so at least six pixels must remain */
+template <int I0, int I1, int I2>
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+void expand_ssse3(const uint8* src, uint8* dst, usize count) noexcept
+{
+  const auto mask = _mm_setr_epi8(I0, I1, I2, -1,  //
+                                  I0 + 3, I1 + 3, I2 + 3, -1,
+                                  I0 + 6, I1 + 6, I2 + 6, -1,
+                                  I0 + 9, I1 + 9, I2 + 9, -1);
+  const auto alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+  for (; count >= 6; count -= 4, src += 12, dst += 16) {
+    const auto pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const auto expanded = _mm_or_si128(_mm_shuffle_epi8(pixels, mask), alpha);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), expanded);
+  }
+
+  expand_scalar<I0, I1, I2>(src, dst, count);
+}
+
+/* Each iteration reads 28 bytes but only consumes 24, so at least ten pixels must remain */
+template <int I0, int I1, int I2>
+CENTURION_PIXEL_KERNEL_TARGET("avx2")
+void expand_avx2(const uint8* src, uint8* dst, usize count) noexcept
+{
+  const auto mask = _mm256_setr_epi8(I0, I1, I2, -1,  //
+                                     I0 + 3, I1 + 3, I2 + 3, -1,
+                                     I0 + 6, I1 + 6, I2 + 6, -1,
+                                     I0 + 9, I1 + 9, I2 + 9, -1,
+                                     I0, I1, I2, -1,
+                                     I0 + 3, I1 + 3, I2 + 3, -1,
+                                     I0 + 6, I1 + 6, I2 + 6, -1,
+                                     I0 + 9, I1 + 9, I2 + 9, -1);
+  const auto alpha = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+
+  for (; count >= 10; count -= 8, src += 24, dst += 32) {
+    const auto low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const auto high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 12));
+    const auto pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+
+    const auto expanded = _mm256_or_si256(_mm256_shuffle_epi8(pixels, mask), alpha);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), expanded);
+  }
+
+  expand_scalar<I0, I1, I2>(src, dst, count);
+}
+
+#endif  // CENTURION_HAS_X86_PIXEL_KERNELS
+
+#ifdef CENTURION_HAS_NEON_PIXEL_KERNELS
+
+template <int I0, int I1, int I2, int I3>
+void swizzle_neon(const uint8* src, uint8* dst, usize count) noexcept
+{
+  for (; count >= 16; count -= 16, src += 64, dst += 64) {
+    const auto pixels = vld4q_u8(src);
+
+    uint8x16x4_t result;
+    result.val[0] = pixels.val[I0];
+    result.val[1] = pixels.val[I1];
+    result.val[2] = pixels.val[I2];
+    result.val[3] = pixels.val[I3];
+
+    vst4q_u8(dst, result);
+  }
+
+  swizzle_scalar<I0, I1, I2, I3>(src, dst, count);
+}
+
+template <int I0, int I1, int I2>
+void expand_neon(const uint8* src, uint8* dst, usize count) noexcept
+{
+  for (; count >= 16; count -= 16, src += 48, dst += 64) {
+    const auto pixels = vld3q_u8(src);
+
+    uint8x16x4_t result;
+    result.val[0] = pixels.val[I0];
+    result.val[1] = pixels.val[I1];
+    result.val[2] = pixels.val[I2];
+    result.val[3] = vdupq_n_u8(0xFF);
+
+    vst4q_u8(dst, result);
+  }
+
+  expand_scalar<I0, I1, I2>(src, dst, count);
+}
+
+#endif  // CENTURION_HAS_NEON_PIXEL_KERNELS
+
+/* Selects the best available instruction set, SSSE3 is implied by SSE4.1 */
+[[nodiscard]] inline auto best_simd_level() noexcept -> simd_level
+{
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+  if (SDL_HasAVX2()) {
+    return simd_level::avx2;
+  }
+  else if (SDL_HasSSE41()) {
+    return simd_level::ssse3;
+  }
+#elif defined(CENTURION_HAS_NEON_PIXEL_KERNELS)
+  return simd_level::neon;
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+  return simd_level::scalar;
+}
+
+template <int I0, int I1, int I2, int I3>
+void swizzle(const simd_level level, const uint8* src, uint8* dst, const usize count) noexcept
+{
+  switch (level) {
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+    case simd_level::avx2:
+      return swizzle_avx2<I0, I1, I2, I3>(src, dst, count);
+
+    case simd_level::ssse3:
+      return swizzle_ssse3<I0, I1, I2, I3>(src, dst, count);
+#elif defined(CENTURION_HAS_NEON_PIXEL_KERNELS)
+    case simd_level::neon:
+      return swizzle_neon<I0, I1, I2, I3>(src, dst, count);
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+    default:
+      return swizzle_scalar<I0, I1, I2, I3>(src, dst, count);
+  }
+}
+
+template <int I0, int I1, int I2>
+void expand(const simd_level level, const uint8* src, uint8* dst, const usize count) noexcept
+{
+  switch (level) {
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+    case simd_level::avx2:
+      return expand_avx2<I0, I1, I2>(src, dst, count);
+
+    case simd_level::ssse3:
+      return expand_ssse3<I0, I1, I2>(src, dst, count);
+#elif defined(CENTURION_HAS_NEON_PIXEL_KERNELS)
+    case simd_level::neon:
+      return expand_neon<I0, I1, I2>(src, dst, count);
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+    default:
+      return expand_scalar<I0, I1, I2>(src, dst, count);
+  }
+}
+
+/**
+ * Converts a row of pixels.
+ *
+ * \param kernel the conversion kernel.
+ * \param level the instruction set used by the kernel.
+ * \param src the source pixels.
+ * \param dst the destination pixels, which must not overlap the source pixels.
+ * \param count the amount of pixels in the row.
+ */
+inline void convert_pixels(const pixel_kernel kernel,
+                           const simd_level level,
+                           const uint8* src,
+                           uint8* dst,
+                           const usize count) noexcept
+{
+  switch (kernel) {
+    case pixel_kernel::swap_02:
+      return swizzle<2, 1, 0, 3>(level, src, dst, count);
+
+    case pixel_kernel::swap_13:
+      return swizzle<0, 3, 2, 1>(level, src, dst, count);
+
+    case pixel_kernel::expand_012:
+      return expand<0, 1, 2>(level, src, dst, count);
+
+    case pixel_kernel::expand_210:
+      return expand<2, 1, 0>(level, src, dst, count);
+  }
+}
+
+/**
+ * Attempts to convert a surface with a vectorized kernel.
+ *
+ * \param source the surface that will be converted.
+ * \param format the target pixel format.
+ *
+ * \return the converted surface; a null pointer if SDL should perform the conversion.
+ */
+[[nodiscard]] inline auto convert_surface_fast(SDL_Surface* source, const uint32 format)
+    -> owner<SDL_Surface*>
+{
+  const auto kernel = find_pixel_kernel(source->format->format, format);
+  if (!kernel || SDL_HasColorKey(source)) {
+    return nullptr;
+  }
+
+  auto* result = SDL_CreateRGBSurfaceWithFormat(0, source->w, source->h, 32, format);
+  if (!result) {
+    return nullptr;
+  }
+
+  if (SDL_MUSTLOCK(source) && SDL_LockSurface(source) != 0) {
+    SDL_FreeSurface(result);
+    return nullptr;
+  }
+
+  const auto level = best_simd_level();
+  const auto* src = static_cast<const uint8*>(source->pixels);
+  auto* dst = static_cast<uint8*>(result->pixels);
+
+  for (int y = 0; y < source->h; ++y, src += source->pitch, dst += result->pitch) {
+    convert_pixels(*kernel, level, src, dst, static_cast<usize>(source->w));
+  }
+
+  if (SDL_MUSTLOCK(source)) {
+    SDL_UnlockSurface(source);
+  }
+
+  /* Mirror SDL_ConvertSurface, which preserves the color and alpha modulation */
+  uint8 red {0xFF};
+  uint8 green {0xFF};
+  uint8 blue {0xFF};
+  uint8 alpha {0xFF};
+  SDL_GetSurfaceColorMod(source, &red, &green, &blue);
+  SDL_GetSurfaceAlphaMod(source, &alpha);
+  SDL_SetSurfaceColorMod(result, red, green, blue);
+  SDL_SetSurfaceAlphaMod(result, alpha);
+
+  return result;
+}
+
+/* Premultiplication of 32-bit pixels, in place. The alpha index is the byte offset of the
+   alpha channel within each pixel. The division by 255 is rounded exactly, so every path
+   produces identical results. */
+
+[[nodiscard]] constexpr auto multiply_channel(const uint32 channel,
+                                              const uint32 alpha) noexcept -> uint8
+{
+  const auto product = channel * alpha + 128u;
+  return static_cast<uint8>((product + (product >> 8u)) >> 8u);
+}
+
+[[nodiscard]] constexpr auto divide_channel(const uint32 channel,
+                                            const uint32 alpha) noexcept -> uint8
+{
+  if (alpha == 0) {
+    return 0;
+  }
+  else {
+    const auto quotient = (channel * 255u + alpha / 2u) / alpha;
+    return static_cast<uint8>((detail::min)(quotient, 255u));
+  }
+}
+
+template <int AlphaIndex>
+void premultiply_scalar(uint8* pixels, const usize count) noexcept
+{
+  for (usize index = 0; index < count; ++index, pixels += 4) {
+    const auto alpha = pixels[AlphaIndex];
+    for (int channel = 0; channel < 4; ++channel) {
+      if (channel != AlphaIndex) {
+        pixels[channel] = multiply_channel(pixels[channel], alpha);
+      }
+    }
+  }
+}
+
+template <int AlphaIndex>
+void unpremultiply_scalar(uint8* pixels, const usize count) noexcept
+{
+  for (usize index = 0; index < count; ++index, pixels += 4) {
+    const auto alpha = pixels[AlphaIndex];
+    for (int channel = 0; channel < 4; ++channel) {
+      if (channel != AlphaIndex) {
+        pixels[channel] = divide_channel(pixels[channel], alpha);
+      }
+    }
+  }
+}
+
+#ifdef CENTURION_HAS_X86_PIXEL_KERNELS
+
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+inline auto multiply_half_ssse3(const __m128i pixels, const __m128i alpha) noexcept -> __m128i
+{
+  const auto bias = _mm_set1_epi16(128);
+  const auto product = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), bias);
+  return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+}
+
+template <int AlphaIndex>
+CENTURION_PIXEL_KERNEL_TARGET("ssse3")
+void premultiply_ssse3(uint8* pixels, usize count) noexcept
+{
+  constexpr char a0 = AlphaIndex;
+  constexpr char a1 = AlphaIndex + 4;
+  constexpr char a2 = AlphaIndex + 8;
+  constexpr char a3 = AlphaIndex + 12;
+  constexpr char z = -1;
+
+  /* Broadcasts the alpha of each pixel into the 16-bit lanes of its channels */
+  const auto lowMask = _mm_setr_epi8(a0, z, a0, z, a0, z, a0, z, a1, z, a1, z, a1, z, a1, z);
+  const auto highMask = _mm_setr_epi8(a2, z, a2, z, a2, z, a2, z, a3, z, a3, z, a3, z, a3, z);
+  const auto alphaMask = _mm_set1_epi32(static_cast<int>(0xFFu << (AlphaIndex * 8)));
+  const auto zero = _mm_setzero_si128();
+
+  for (; count >= 4; count -= 4, pixels += 16) {
+    const auto source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels));
+
+    const auto low = multiply_half_ssse3(_mm_unpacklo_epi8(source, zero),
+                                         _mm_shuffle_epi8(source, lowMask));
+    const auto high = multiply_half_ssse3(_mm_unpackhi_epi8(source, zero),
+                                          _mm_shuffle_epi8(source, highMask));
+
+    const auto colors = _mm_andnot_si128(alphaMask, _mm_packus_epi16(low, high));
+    const auto result = _mm_or_si128(colors, _mm_and_si128(source, alphaMask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels), result);
+  }
+
+  premultiply_scalar<AlphaIndex>(pixels, count);
+}
+
+#endif  // CENTURION_HAS_X86_PIXEL_KERNELS
+
+#ifdef CENTURION_HAS_NEON_PIXEL_KERNELS
+
+template <int AlphaIndex>
+void premultiply_neon(uint8* pixels, usize count) noexcept
+{
+  for (; count >= 16; count -= 16, pixels += 64) {
+    auto source = vld4q_u8(pixels);
+    const auto alpha = source.val[AlphaIndex];
+
+    for (int channel = 0; channel < 4; ++channel) {
+      if (channel != AlphaIndex) {
+        const auto value = source.val[channel];
+        const auto low = vmull_u8(vget_low_u8(value), vget_low_u8(alpha));
+        const auto high = vmull_u8(vget_high_u8(value), vget_high_u8(alpha));
+
+        /* Computes (x + ((x + 128) >> 8) + 128) >> 8, matching multiply_channel() */
+        source.val[channel] = vcombine_u8(vrshrn_n_u16(vrsraq_n_u16(low, low, 8), 8),
+                                          vrshrn_n_u16(vrsraq_n_u16(high, high, 8), 8));
+      }
+    }
+
+    vst4q_u8(pixels, source);
+  }
+
+  premultiply_scalar<AlphaIndex>(pixels, count);
+}
+
+#endif  // CENTURION_HAS_NEON_PIXEL_KERNELS
+
+template <int AlphaIndex>
+void premultiply(const simd_level level, uint8* pixels, const usize count) noexcept
+{
+  switch (level) {
+#if defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+    case simd_level::avx2:
+    case simd_level::ssse3:
+      return premultiply_ssse3<AlphaIndex>(pixels, count);
+#elif defined(CENTURION_HAS_NEON_PIXEL_KERNELS)
+    case simd_level::neon:
+      return premultiply_neon<AlphaIndex>(pixels, count);
+#endif  // defined(CENTURION_HAS_X86_PIXEL_KERNELS)
+
+    default:
+      return premultiply_scalar<AlphaIndex>(pixels, count);
+  }
+}
+
+/**
+ * Returns the byte offset of the alpha channel in the pixels of a format.
+ *
+ * \param format the pixel format that will be inspected.
+ *
+ * \return the byte offset of the alpha channel; nothing if the format isn't a 32-bit format
+ * with an 8-bit alpha channel.
+ */
+[[nodiscard]] inline auto alpha_byte_index(const SDL_PixelFormat& format) noexcept
+    -> maybe<int>
+{
+  if (format.BytesPerPixel != 4) {
+    return nothing;
+  }
+
+  for (int index = 0; index < 4; ++index) {
+    if (format.Amask == (0xFFu << (index * 8))) {
+      return (SDL_BYTEORDER == SDL_LIL_ENDIAN) ? index : 3 - index;
+    }
+  }
+
+  return nothing;
+}
+
+/* Dispatches on the alpha index, so that the kernels can be specialized at compile-time */
+inline void premultiply_pixels(const int alphaIndex,
+                               const simd_level level,
+                               uint8* pixels,
+                               const usize count) noexcept
+{
+  switch (alphaIndex) {
+    case 0:
+      return premultiply<0>(level, pixels, count);
+
+    case 1:
+      return premultiply<1>(level, pixels, count);
+
+    case 2:
+      return premultiply<2>(level, pixels, count);
+
+    default:
+      return premultiply<3>(level, pixels, count);
+  }
+}
+
+/* Unpremultiplication is a division per channel, which is left scalar since it is usually
+   only needed when reading pixels back, e.g. before saving an image */
+inline void unpremultiply_pixels(const int alphaIndex,
+                                 uint8* pixels,
+                                 const usize count) noexcept
+{
+  switch (alphaIndex) {
+    case 0:
+      return unpremultiply_scalar<0>(pixels, count);
+
+    case 1:
+      return unpremultiply_scalar<1>(pixels, count);
+
+    case 2:
+      return unpremultiply_scalar<2>(pixels, count);
+
+    default:
+      return unpremultiply_scalar<3>(pixels, count);
+  }
+}
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_PIXEL_CONVERSION_HPP_
@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_DETAIL_SKYLINE_PACKER_HPP_
+#define CENTURION_DETAIL_SKYLINE_PACKER_HPP_
+
+#include <cstddef>  // ptrdiff_t
+#include <vector>   // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "stdlib.hpp"
+
+namespace cen::detail {
+
+/**
+ * Packs rectangles into a fixed area using the skyline bottom-left heuristic.
+ *
+ * The packer tracks the upper contour of all packed rectangles, and places each new rectangle
+ * at the position that results in the lowest top edge.
+ */
+class skyline_packer final {
+ public:
+  explicit skyline_packer(const iarea& size) : mSize {size} { reset(); }
+
+  /**
+   * Attempts to find space for a rectangle.
+   *
+   * \param size the size of the rectangle.
+   *
+   * \return the position of the rectangle; an empty optional if there was no space left.
+   */
+  [[nodiscard]] auto insert(const iarea& size) -> maybe<ipoint>
+  {
+    if (size.width <= 0 || size.height <= 0) {
+      return nothing;
+    }
+
+    usize bestIndex {};
+    int bestTop {};
+    int bestWidth {};
+    maybe<ipoint> best;
+
+    for (usize index = 0; index < mNodes.size(); ++index) {
+      if (const auto y = fit(index, size)) {
+        const auto top = *y + size.height;
+        const auto width = mNodes[index].width;
+
+        if (!best || top < bestTop || (top == bestTop && width < bestWidth)) {
+          best = ipoint {mNodes[index].x, *y};
+          bestIndex = index;
+          bestTop = top;
+          bestWidth = width;
+        }
+      }
+    }
+
+    if (best) {
+      add_node(bestIndex, {best->x(), bestTop, size.width});
+    }
+
+    return best;
+  }
+
+  /// Removes all packed rectangles.
+  void reset()
+  {
+    mNodes.clear();
+    mNodes.push_back({0, 0, mSize.width});
+  }
+
+  [[nodiscard]] auto size() const noexcept -> const iarea& { return mSize; }
+
+ private:
+  struct node final {
+    int x {};
+    int y {};
+    int width {};
+  };
+
+  iarea mSize;
+  std::vector<node> mNodes;
+
+  /// Returns the lowest y-coordinate at which a rectangle fits at the start of a node
+  [[nodiscard]] auto fit(usize index, const iarea& size) const -> maybe<int>
+  {
+    const auto x = mNodes[index].x;
+    if (x + size.width > mSize.width) {
+      return nothing;
+    }
+
+    int y = mNodes[index].y;
+    int remaining = size.width;
+
+    while (remaining > 0) {
+      y = (detail::max)(y, mNodes[index].y);
+
+      if (y + size.height > mSize.height) {
+        return nothing;
+      }
+
+      remaining -= mNodes[index].width;
+      ++index;
+    }
+
+    return y;
+  }
+
+  void add_node(const usize index, const node& added)
+  {
+    mNodes.insert(mNodes.begin() + static_cast<std::ptrdiff_t>(index), added);
+
+    /* Shrink or remove the nodes that are now covered by the new node */
+    const auto right = added.x + added.width;
+    for (auto i = index + 1; i < mNodes.size();) {
+      auto& current = mNodes[i];
+      if (current.x >= right) {
+        break;
+      }
+
+      const auto shrink = right - current.x;
+      if (shrink >= current.width) {
+        mNodes.erase(mNodes.begin() + static_cast<std::ptrdiff_t>(i));
+      }
+      else {
+        current.x += shrink;
+        current.width -= shrink;
+        break;
+      }
+    }
+
+    /* Merge neighbouring nodes at the same height */
+    for (usize i = 0; i + 1 < mNodes.size();) {
+      if (mNodes[i].y == mNodes[i + 1].y) {
+        mNodes[i].width += mNodes[i + 1].width;
+        mNodes.erase(mNodes.begin() + static_cast<std::ptrdiff_t>(i + 1));
+      }
+      else {
+        ++i;
+      }
+    }
+  }
+};
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_SKYLINE_PACKER_HPP_
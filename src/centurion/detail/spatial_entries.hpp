@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_DETAIL_SPATIAL_ENTRIES_HPP_
+#define CENTURION_DETAIL_SPATIAL_ENTRIES_HPP_
+
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+
+/* Shared entry storage for the spatial indices. Entries live in stable slots, so that the
+   cells and nodes of the indices can refer to them by slot index, and freed slots are reused
+   by later insertions. */
+
+namespace cen::detail {
+
+template <typename T>
+class spatial_entries final {
+ public:
+  using rect_type = basic_rect<T>;
+
+  struct entry final {
+    rect_type rect;
+    uint32 id {};
+    uint32 node {};      ///< The quadtree node that the entry is stored in.
+    uint32 stamp {};     ///< The last query that reported the entry.
+    bool alive {};
+  };
+
+  /* Returns the slot of an id, or nothing if the id isn't stored */
+  [[nodiscard]] auto find(const uint32 id) const -> maybe<uint32>
+  {
+    if (const auto iter = mSlots.find(id); iter != mSlots.end()) {
+      return iter->second;
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  [[nodiscard]] auto add(const uint32 id, const rect_type& rect) -> uint32
+  {
+    uint32 slot {};
+
+    if (!mFree.empty()) {
+      slot = mFree.back();
+      mFree.pop_back();
+    }
+    else {
+      slot = static_cast<uint32>(mEntries.size());
+      mEntries.emplace_back();
+    }
+
+    auto& entry = mEntries[slot];
+    entry.rect = rect;
+    entry.id = id;
+    entry.alive = true;
+
+    mSlots[id] = slot;
+    return slot;
+  }
+
+  void remove(const uint32 slot)
+  {
+    auto& entry = mEntries[slot];
+    mSlots.erase(entry.id);
+
+    entry.alive = false;
+    mFree.push_back(slot);
+  }
+
+  void reserve(const usize count)
+  {
+    mEntries.reserve(count);
+    mSlots.reserve(count);
+  }
+
+  void clear() noexcept
+  {
+    mEntries.clear();
+    mFree.clear();
+    mSlots.clear();
+  }
+
+  /* Returns a new query stamp, resetting all stamps if the counter wraps around */
+  [[nodiscard]] auto next_stamp() noexcept -> uint32
+  {
+    if (++mStamp == 0) {
+      for (auto& entry : mEntries) {
+        entry.stamp = 0;
+      }
+
+      mStamp = 1;
+    }
+
+    return mStamp;
+  }
+
+  [[nodiscard]] auto operator[](const uint32 slot) noexcept -> entry&
+  {
+    return mEntries[slot];
+  }
+
+  [[nodiscard]] auto operator[](const uint32 slot) const noexcept -> const entry&
+  {
+    return mEntries[slot];
+  }
+
+  [[nodiscard]] auto size() const noexcept -> usize { return mSlots.size(); }
+
+ private:
+  std::vector<entry> mEntries;
+  std::vector<uint32> mFree;
+  std::unordered_map<uint32, uint32> mSlots;
+  uint32 mStamp {};
+};
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_SPATIAL_ENTRIES_HPP_
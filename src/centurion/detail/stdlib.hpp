@@ -27,18 +27,25 @@
 
 #include <cassert>       // assert
 #include <charconv>      // from_chars
-#include <cmath>         // lerp
+#include <cmath>         // lerp, round, sqrt
+#include <cstdio>        // snprintf
 #include <cstring>       // strcmp, strlen
+#include <limits>        // numeric_limits
 #include <optional>      // optional, nullopt
-#include <sstream>       // stringstream
 #include <string>        // string
 #include <string_view>   // string_view
 #include <system_error>  // errc
-#include <type_traits>   // is_integral_v
+#include <type_traits>   // is_integral_v, is_floating_point_v, is_constant_evaluated
 
 #include "../common/primitives.hpp"
 #include "../features.hpp"
 
+#if CENTURION_HAS_FEATURE_CPP20
+
+#include <bit>  // countr_zero, popcount
+
+#endif  // CENTURION_HAS_FEATURE_CPP20
+
 #if CENTURION_HAS_FEATURE_FORMAT
 
 #include <format>  // format
@@ -78,6 +85,161 @@ template <typename T>
   return (a < b) ? b : a;
 }
 
+/* std::abs is not constexpr until C++23 */
+template <typename T>
+[[nodiscard]] constexpr auto abs(const T& value) noexcept(noexcept(value < T {})) -> T
+{
+  return (value < T {}) ? -value : value;
+}
+
+/// Returns the number of trailing zero bits, the word must not be zero
+[[nodiscard]] constexpr auto countr_zero(uint64 word) noexcept -> int
+{
+  assert(word != 0);
+#if CENTURION_HAS_FEATURE_CPP20
+  return std::countr_zero(word);
+#else
+  int count = 0;
+  while (!(word & 1u)) {
+    word >>= 1u;
+    ++count;
+  }
+  return count;
+#endif  // CENTURION_HAS_FEATURE_CPP20
+}
+
+/// Returns the number of set bits
+[[nodiscard]] constexpr auto popcount(uint64 word) noexcept -> int
+{
+#if CENTURION_HAS_FEATURE_CPP20
+  return std::popcount(word);
+#else
+  int count = 0;
+  while (word) {
+    word &= word - 1u;
+    ++count;
+  }
+  return count;
+#endif  // CENTURION_HAS_FEATURE_CPP20
+}
+
+/* Indicates whether the enclosing call is constant evaluated. Without compiler support, this
+   is always false, and the constexpr math functions simply use the <cmath> functions. */
+[[nodiscard]] constexpr auto is_constant_evaluated() noexcept -> bool
+{
+#if defined(__cpp_lib_is_constant_evaluated)
+  return std::is_constant_evaluated();
+#elif CENTURION_HAS_FEATURE_IS_CONSTANT_EVALUATED
+  return __builtin_is_constant_evaluated();
+#else
+  return false;
+#endif  // defined(__cpp_lib_is_constant_evaluated)
+}
+
+/* Values with at least this magnitude are always integral, so rounding is a no-op */
+template <typename T>
+inline constexpr T integral_threshold = static_cast<T>(1ull << 52u);
+
+template <>
+inline constexpr float integral_threshold<float> = static_cast<float>(1u << 23u);
+
+/* Like std::round, i.e. halfway cases are rounded away from zero */
+template <typename T>
+[[nodiscard]] constexpr auto round(const T value) noexcept -> T
+{
+  static_assert(std::is_floating_point_v<T>);
+
+  if (is_constant_evaluated()) {
+    if (!(detail::abs(value) < integral_threshold<T>)) {
+      return value;  // Also covers infinity and NaN
+    }
+
+    /* Both the truncation and the fraction are exact */
+    const auto truncated = static_cast<T>(static_cast<int64>(value));
+    const auto fraction = value - truncated;
+
+    if (fraction >= T {0.5}) {
+      return truncated + T {1};
+    }
+    else if (fraction <= T {-0.5}) {
+      return truncated - T {1};
+    }
+    else {
+      return truncated;
+    }
+  }
+  else {
+    return std::round(value);
+  }
+}
+
+/* Like std::sqrt, but uses Newton's method in constant evaluation, where the result may
+   differ from std::sqrt in the last digit for double precision */
+template <typename T>
+[[nodiscard]] constexpr auto sqrt(const T value) noexcept -> T
+{
+  static_assert(std::is_floating_point_v<T>);
+
+  if (is_constant_evaluated()) {
+    if (!(value >= T {0})) {
+      return std::numeric_limits<T>::quiet_NaN();
+    }
+    else if (value == T {0} || value == value + value) {
+      return value;  // Zero or infinity
+    }
+
+    /* The initial estimate is above the root, so the iterations decrease monotonically */
+    const auto x = static_cast<double>(value);
+    auto current = (x >= 1.0) ? x : 1.0;
+
+    while (true) {
+      const auto next = 0.5 * (current + x / current);
+      if (next >= current) {
+        break;
+      }
+
+      current = next;
+    }
+
+    return static_cast<T>(current);
+  }
+  else {
+    return std::sqrt(value);
+  }
+}
+
+/* Returns the value of a hexadecimal digit, or -1 if the character isn't a hex digit */
+[[nodiscard]] constexpr auto hex_digit(const char c) noexcept -> int
+{
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+  else if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+  else if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  else {
+    return -1;
+  }
+}
+
+/* Parses two hexadecimal digits, a constexpr alternative to stoi<uint8>(str, 16) */
+[[nodiscard]] constexpr auto parse_hex_byte(const char high, const char low) noexcept
+    -> maybe<uint8>
+{
+  const auto h = hex_digit(high);
+  const auto l = hex_digit(low);
+
+  if (h != -1 && l != -1) {
+    return static_cast<uint8>((h << 4) | l);
+  }
+  else {
+    return nothing;
+  }
+}
+
 [[nodiscard]] constexpr auto lerp(const float a, const float b, const float bias) noexcept
     -> float
 {
@@ -124,14 +286,20 @@ template <typename T = int>
   return ptr ? std::format("{}", ptr) : std::string {};
 #else
   if (ptr) {
-    std::stringstream stream;
+    char buffer[32] {};
+    const auto length = std::snprintf(buffer, sizeof buffer, "%p", ptr);
+
+    std::string result;
 
     if constexpr (on_msvc) {
-      stream << "0x";  // Only MSVC seems to omit this, add it for consistency
+      result += "0x";  // Only MSVC seems to omit this, add it for consistency
+    }
+
+    if (length > 0) {
+      result.append(buffer, (detail::min)(static_cast<usize>(length), sizeof buffer - 1u));
     }
 
-    stream << ptr;
-    return stream.str();
+    return result;
   }
   else {
     return std::string {};
@@ -29,6 +29,7 @@
 #include <tuple>        // tuple
 #include <type_traits>  // is_same_v
 #include <utility>      // index_sequence, index_sequence_for
+#include <variant>      // variant
 
 #include "../common/primitives.hpp"
 
@@ -51,6 +52,11 @@ class tuple_type_index<Target, std::tuple<T...>> {
   inline constexpr static auto value = find(std::index_sequence_for<T...> {});
 };
 
+/// Also supports variants, in which case the value is the variant alternative index.
+template <typename Target, typename... T>
+class tuple_type_index<Target, std::variant<T...>>
+    : public tuple_type_index<Target, std::tuple<T...>> {};
+
 template <typename Target, typename... T>
 inline constexpr int tuple_type_index_v = tuple_type_index<Target, T...>::value;
 
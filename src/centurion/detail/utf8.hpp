@@ -0,0 +1,179 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_DETAIL_UTF8_HPP_
+#define CENTURION_DETAIL_UTF8_HPP_
+
+#include <string_view>  // string_view
+
+#include "../common/primitives.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+
+#include <emmintrin.h>  // SSE2 intrinsics
+
+#define CENTURION_HAS_SSE2_UTF8_DECODER
+
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+
+#include <arm_neon.h>  // NEON intrinsics
+
+#define CENTURION_HAS_NEON_UTF8_DECODER
+
+#endif  // SSE2
+
+/* A UTF-8 decoder that doesn't allocate, used to measure and lay out text. Runs of ASCII
+   characters are detected sixteen bytes at a time with SSE2 or NEON, which are part of the
+   baseline of the targets that provide them, and are passed on without any decoding. Other
+   characters are decoded by the scalar decoder. Malformed sequences, i.e. truncated, overlong
+   or surrogate encodings and code points beyond U+10FFFF, are decoded as U+FFFD. */
+
+namespace cen::detail {
+
+inline constexpr unicode32_t utf8_replacement = 0xFFFD;
+
+[[nodiscard]] constexpr auto is_utf8_continuation(const uint8 byte) noexcept -> bool
+{
+  return (byte & 0xC0u) == 0x80u;
+}
+
+/* Decodes the multibyte sequence at the index, which is advanced past the sequence */
+[[nodiscard]] constexpr auto decode_utf8_sequence(const uint8* data,
+                                                  const usize length,
+                                                  usize& index) noexcept -> unicode32_t
+{
+  const auto lead = data[index];
+
+  usize size = 0;
+  unicode32_t codepoint = 0;
+  unicode32_t minimum = 0;
+
+  if ((lead & 0xE0u) == 0xC0u) {
+    size = 2;
+    codepoint = lead & 0x1Fu;
+    minimum = 0x80;
+  }
+  else if ((lead & 0xF0u) == 0xE0u) {
+    size = 3;
+    codepoint = lead & 0x0Fu;
+    minimum = 0x800;
+  }
+  else if ((lead & 0xF8u) == 0xF0u) {
+    size = 4;
+    codepoint = lead & 0x07u;
+    minimum = 0x10000;
+  }
+  else {
+    ++index;
+    return utf8_replacement;
+  }
+
+  if (length - index < size) {
+    ++index;
+    return utf8_replacement;
+  }
+
+  for (usize offset = 1; offset < size; ++offset) {
+    const auto byte = data[index + offset];
+    if (!is_utf8_continuation(byte)) {
+      ++index;
+      return utf8_replacement;
+    }
+
+    codepoint = (codepoint << 6u) | (byte & 0x3Fu);
+  }
+
+  if (codepoint < minimum || codepoint > 0x10FFFF ||
+      (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+    ++index;
+    return utf8_replacement;
+  }
+
+  index += size;
+  return codepoint;
+}
+
+/* Returns the length of the run of ASCII characters at the index, in multiples of sixteen */
+[[nodiscard]] inline auto ascii_run_length(const uint8* data,
+                                           const usize length,
+                                           const usize index) noexcept -> usize
+{
+  usize end = index;
+
+#if defined(CENTURION_HAS_SSE2_UTF8_DECODER)
+  while (length - end >= 16) {
+    const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + end));
+    if (_mm_movemask_epi8(chunk) != 0) {
+      break;
+    }
+
+    end += 16;
+  }
+#elif defined(CENTURION_HAS_NEON_UTF8_DECODER)
+  while (length - end >= 16) {
+    if (vmaxvq_u8(vld1q_u8(data + end)) >= 0x80u) {
+      break;
+    }
+
+    end += 16;
+  }
+#else
+  (void) data;
+  (void) length;
+#endif  // defined(CENTURION_HAS_SSE2_UTF8_DECODER)
+
+  return end - index;
+}
+
+/* Invokes the callable with each code point in the UTF-8 encoded string */
+template <typename Callable>
+void for_each_utf8(const std::string_view str, Callable&& callable)
+{
+  const auto* data = reinterpret_cast<const uint8*>(str.data());
+  const auto length = str.size();
+
+  usize index = 0;
+  while (index < length) {
+    const auto run = ascii_run_length(data, length, index);
+    for (const auto end = index + run; index < end; ++index) {
+      callable(static_cast<unicode32_t>(data[index]));
+    }
+
+    if (index == length) {
+      break;
+    }
+
+    if (const auto byte = data[index]; byte < 0x80u) {
+      callable(static_cast<unicode32_t>(byte));
+      ++index;
+    }
+    else {
+      callable(decode_utf8_sequence(data, length, index));
+    }
+  }
+}
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_UTF8_HPP_
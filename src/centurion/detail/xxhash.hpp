@@ -0,0 +1,263 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_DETAIL_XXHASH_HPP_
+#define CENTURION_DETAIL_XXHASH_HPP_
+
+#include <cstring>  // memcpy
+
+#include "../common/primitives.hpp"
+#include "../system/endian.hpp"
+
+/* Self-contained implementations of the 32-bit and 64-bit xxHash algorithms. The former is
+   used for the checksums in the LZ4 frame format, and the latter for content hashing. See
+   "xxHash fast digest algorithm" for the details. */
+
+namespace cen::detail {
+
+inline constexpr uint32 xxh32_prime1 = 2'654'435'761u;
+inline constexpr uint32 xxh32_prime2 = 2'246'822'519u;
+inline constexpr uint32 xxh32_prime3 = 3'266'489'917u;
+inline constexpr uint32 xxh32_prime4 = 668'265'263u;
+inline constexpr uint32 xxh32_prime5 = 374'761'393u;
+
+[[nodiscard]] constexpr auto xxh32_rotl(const uint32 value, const int bits) noexcept -> uint32
+{
+  return (value << bits) | (value >> (32 - bits));
+}
+
+[[nodiscard]] inline auto xxh32_lane(const uint8* data) noexcept -> uint32
+{
+  uint32 value {};
+  std::memcpy(&value, data, sizeof value);
+  return swap_little_endian(value);
+}
+
+[[nodiscard]] constexpr auto xxh32_round(const uint32 acc, const uint32 lane) noexcept
+    -> uint32
+{
+  return xxh32_rotl(acc + (lane * xxh32_prime2), 13) * xxh32_prime1;
+}
+
+/**
+ * Computes the 32-bit xxHash of a buffer.
+ *
+ * \param data the data that will be hashed.
+ * \param size the size of the data, in bytes.
+ * \param seed the seed of the hash.
+ *
+ * \return the hash of the data.
+ */
+[[nodiscard]] inline auto xxh32(const void* data,
+                                const usize size,
+                                const uint32 seed = 0) noexcept -> uint32
+{
+  const auto* bytes = static_cast<const uint8*>(data);
+  const auto* end = bytes + size;
+
+  uint32 hash {};
+
+  if (size >= 16) {
+    uint32 v1 = seed + xxh32_prime1 + xxh32_prime2;
+    uint32 v2 = seed + xxh32_prime2;
+    uint32 v3 = seed;
+    uint32 v4 = seed - xxh32_prime1;
+
+    const auto* limit = end - 16;
+    do {
+      v1 = xxh32_round(v1, xxh32_lane(bytes));
+      v2 = xxh32_round(v2, xxh32_lane(bytes + 4));
+      v3 = xxh32_round(v3, xxh32_lane(bytes + 8));
+      v4 = xxh32_round(v4, xxh32_lane(bytes + 12));
+      bytes += 16;
+    } while (bytes <= limit);
+
+    hash = xxh32_rotl(v1, 1) + xxh32_rotl(v2, 7) + xxh32_rotl(v3, 12) + xxh32_rotl(v4, 18);
+  }
+  else {
+    hash = seed + xxh32_prime5;
+  }
+
+  hash += static_cast<uint32>(size);
+
+  while (end - bytes >= 4) {
+    hash += xxh32_lane(bytes) * xxh32_prime3;
+    hash = xxh32_rotl(hash, 17) * xxh32_prime4;
+    bytes += 4;
+  }
+
+  while (bytes < end) {
+    hash += *bytes * xxh32_prime5;
+    hash = xxh32_rotl(hash, 11) * xxh32_prime1;
+    ++bytes;
+  }
+
+  hash ^= hash >> 15;
+  hash *= xxh32_prime2;
+  hash ^= hash >> 13;
+  hash *= xxh32_prime3;
+  hash ^= hash >> 16;
+
+  return hash;
+}
+
+inline constexpr uint64 xxh64_prime1 = 0x9E3779B185EBCA87;
+inline constexpr uint64 xxh64_prime2 = 0xC2B2AE3D27D4EB4F;
+inline constexpr uint64 xxh64_prime3 = 0x165667B19E3779F9;
+inline constexpr uint64 xxh64_prime4 = 0x85EBCA77C2B2AE63;
+inline constexpr uint64 xxh64_prime5 = 0x27D4EB2F165667C5;
+
+inline constexpr usize xxh64_stripe_size = 32;
+
+[[nodiscard]] constexpr auto xxh64_rotl(const uint64 value, const int bits) noexcept -> uint64
+{
+  return (value << bits) | (value >> (64 - bits));
+}
+
+[[nodiscard]] inline auto xxh64_lane(const uint8* data) noexcept -> uint64
+{
+  uint64 value {};
+  std::memcpy(&value, data, sizeof value);
+  return swap_little_endian(value);
+}
+
+[[nodiscard]] constexpr auto xxh64_round(const uint64 acc, const uint64 lane) noexcept
+    -> uint64
+{
+  return xxh64_rotl(acc + (lane * xxh64_prime2), 31) * xxh64_prime1;
+}
+
+[[nodiscard]] constexpr auto xxh64_merge(const uint64 acc, const uint64 value) noexcept
+    -> uint64
+{
+  return ((acc ^ xxh64_round(0, value)) * xxh64_prime1) + xxh64_prime4;
+}
+
+/* The four accumulators of the main loop, which are independent to exploit instruction-level
+   parallelism */
+struct xxh64_lanes final {
+  uint64 v1 {};
+  uint64 v2 {};
+  uint64 v3 {};
+  uint64 v4 {};
+
+  explicit constexpr xxh64_lanes(const uint64 seed) noexcept
+      : v1 {seed + xxh64_prime1 + xxh64_prime2}
+      , v2 {seed + xxh64_prime2}
+      , v3 {seed}
+      , v4 {seed - xxh64_prime1}
+  {
+  }
+
+  /* Consumes a number of whole stripes */
+  void consume(const uint8* data, const usize stripes) noexcept
+  {
+    for (usize stripe = 0; stripe < stripes; ++stripe, data += xxh64_stripe_size) {
+      v1 = xxh64_round(v1, xxh64_lane(data));
+      v2 = xxh64_round(v2, xxh64_lane(data + 8));
+      v3 = xxh64_round(v3, xxh64_lane(data + 16));
+      v4 = xxh64_round(v4, xxh64_lane(data + 24));
+    }
+  }
+
+  [[nodiscard]] constexpr auto converge() const noexcept -> uint64
+  {
+    auto hash =
+        xxh64_rotl(v1, 1) + xxh64_rotl(v2, 7) + xxh64_rotl(v3, 12) + xxh64_rotl(v4, 18);
+
+    hash = xxh64_merge(hash, v1);
+    hash = xxh64_merge(hash, v2);
+    hash = xxh64_merge(hash, v3);
+    return xxh64_merge(hash, v4);
+  }
+};
+
+/* Mixes in the bytes that don't fill a stripe, and the total length */
+[[nodiscard]] inline auto xxh64_finalize(uint64 hash,
+                                         const uint8* data,
+                                         usize size,
+                                         const uint64 length) noexcept -> uint64
+{
+  hash += length;
+
+  for (; size >= 8; size -= 8, data += 8) {
+    hash ^= xxh64_round(0, xxh64_lane(data));
+    hash = (xxh64_rotl(hash, 27) * xxh64_prime1) + xxh64_prime4;
+  }
+
+  if (size >= 4) {
+    hash ^= static_cast<uint64>(xxh32_lane(data)) * xxh64_prime1;
+    hash = (xxh64_rotl(hash, 23) * xxh64_prime2) + xxh64_prime3;
+    size -= 4;
+    data += 4;
+  }
+
+  for (; size > 0; --size, ++data) {
+    hash ^= *data * xxh64_prime5;
+    hash = xxh64_rotl(hash, 11) * xxh64_prime1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= xxh64_prime2;
+  hash ^= hash >> 29;
+  hash *= xxh64_prime3;
+  hash ^= hash >> 32;
+
+  return hash;
+}
+
+/**
+ * Computes the 64-bit xxHash of a buffer.
+ *
+ * \param data the data that will be hashed.
+ * \param size the size of the data, in bytes.
+ * \param seed the seed of the hash.
+ *
+ * \return the hash of the data.
+ */
+[[nodiscard]] inline auto xxh64(const void* data,
+                                const usize size,
+                                const uint64 seed = 0) noexcept -> uint64
+{
+  const auto* bytes = static_cast<const uint8*>(data);
+  const auto stripes = size / xxh64_stripe_size;
+
+  uint64 hash {};
+  if (stripes != 0) {
+    xxh64_lanes lanes {seed};
+    lanes.consume(bytes, stripes);
+    hash = lanes.converge();
+  }
+  else {
+    hash = seed + xxh64_prime5;
+  }
+
+  const auto consumed = stripes * xxh64_stripe_size;
+  return xxh64_finalize(hash, bytes + consumed, size - consumed, size);
+}
+
+}  // namespace cen::detail
+
+#endif  // CENTURION_DETAIL_XXHASH_HPP_
@@ -0,0 +1,133 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+module;
+
+#include "centurion/events.hpp"
+
+export module centurion:events;
+
+export namespace cen {
+
+using cen::app_lifecycle_options;
+using cen::app_lifecycle;
+
+using cen::audio_device_event;
+
+using cen::controller_axis_event;
+using cen::controller_button_event;
+using cen::controller_device_event;
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+using cen::controller_sensor_event;
+using cen::controller_touchpad_event;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+
+using cen::event_base;
+using cen::as_sdl_event;
+
+using cen::event_batch;
+
+using cen::event_range;
+using cen::event_bus;
+
+using cen::event_channel;
+
+using cen::event_dispatcher;
+
+using cen::event_filter;
+using cen::event_watch;
+
+using cen::event_handler;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+using cen::recorded_event;
+using cen::event_recorder;
+using cen::event_player;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+using cen::event_sink;
+
+using cen::latency_histogram;
+using cen::poll_statistics;
+using cen::handler_statistics;
+using cen::event_statistics;
+
+using cen::event_type;
+using cen::is_user_event;
+using cen::to_string;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::operator<<;
+
+#endif  // CENTURION_NO_IOSTREAM
+
+using cen::event_view;
+
+using cen::timed_event;
+using cen::input_thread;
+
+using cen::joy_hat_position;
+using cen::joy_axis_event;
+using cen::joy_ball_event;
+using cen::joy_button_event;
+using cen::joy_device_event;
+using cen::joy_hat_event;
+
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+using cen::joy_battery_event;
+#endif  // SDL_VERSION_ATLEAST(2, 24, 0)
+
+using cen::quit_event;
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+using cen::display_event_id;
+using cen::display_event;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+
+using cen::dollar_gesture_event;
+using cen::drop_event;
+using cen::keyboard_event;
+using cen::multi_gesture_event;
+using cen::sensor_event;
+using cen::text_editing_event;
+
+#if SDL_VERSION_ATLEAST(2, 0, 22)
+using cen::text_editing_ext_event;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 22)
+
+using cen::text_input_event;
+using cen::touch_finger_event;
+using cen::user_event;
+
+using cen::mouse_wheel_direction;
+using cen::mouse_button_event;
+using cen::mouse_motion_event;
+using cen::mouse_wheel_event;
+
+using cen::window_event_id;
+using cen::window_event;
+
+}  // namespace cen
@@ -22,13 +22,22 @@
  * SOFTWARE.
  */
 
+#include "events/app_lifecycle.hpp"
 #include "events/audio_events.hpp"
 #include "events/controller_events.hpp"
 #include "events/event_base.hpp"
+#include "events/event_batch.hpp"
+#include "events/event_bus.hpp"
+#include "events/event_channel.hpp"
 #include "events/event_dispatcher.hpp"
+#include "events/event_filter.hpp"
 #include "events/event_handler.hpp"
+#include "events/event_recording.hpp"
 #include "events/event_sink.hpp"
+#include "events/event_statistics.hpp"
 #include "events/event_type.hpp"
+#include "events/event_view.hpp"
+#include "events/input_thread.hpp"
 #include "events/joystick_events.hpp"
 #include "events/misc_events.hpp"
 #include "events/mouse_events.hpp"
@@ -0,0 +1,300 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_EVENTS_APP_LIFECYCLE_HPP_
+#define CENTURION_EVENTS_APP_LIFECYCLE_HPP_
+
+#include <SDL.h>
+
+#ifndef CENTURION_NO_SDL_MIXER
+#include <SDL_mixer.h>
+#endif  // CENTURION_NO_SDL_MIXER
+
+#include <algorithm>  // find, remove
+#include <atomic>     // atomic
+#include <vector>     // vector
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/thread.hpp"
+#include "../video/texture_restorer.hpp"
+#include "event_filter.hpp"
+
+namespace cen {
+
+/// The configuration of an application lifecycle handler.
+struct app_lifecycle_options final {
+  bool pause_audio {true};       ///< Pauses playing channels and music in the background.
+  bool evict_textures {true};    ///< Releases the textures of attached restorers.
+  bool reload_textures {false};  ///< Uploads released textures when resuming, not lazily.
+};
+
+/**
+ * Suspends an application while it is in the background, and resumes it in the foreground.
+ *
+ * Mobile systems expect applications in the background to stop rendering and to release
+ * resources, and may terminate applications that don't. The lifecycle handler watches for
+ * `SDL_APP_WILLENTERBACKGROUND` and `SDL_APP_DIDENTERFOREGROUND`. When the application is
+ * suspended, the handler pauses the channels and music that are playing, and releases the
+ * textures of attached restorers, which keep descriptors so that the textures are uploaded
+ * again lazily after resuming. Rendering is up to the application, which should not present
+ * any frames while the handler is suspended.
+ * \code{cpp}
+ * cen::app_lifecycle lifecycle;
+ * lifecycle.attach(textures);
+ *
+ * while (running) {
+ *   lifecycle.update();
+ *   // handle events...
+ *
+ *   if (lifecycle.is_suspended()) {
+ *     handler.wait_for(cen::u32ms {100});
+ *     continue;
+ *   }
+ *
+ *   // render and present...
+ * }
+ * \endcode
+ *
+ * \details Lifecycle events are pushed from the main thread on some platforms, e.g. iOS, where
+ *          the application may be suspended before the next frame. In that case, the handler
+ *          suspends or resumes immediately. Events pushed from other threads, e.g. on Android,
+ *          are applied by the next call to `update()`, which must be made on the thread that
+ *          created the handler.
+ *
+ * \details Attached restorers must outlive the handler, or be detached before they are
+ *          destroyed.
+ *
+ * \see texture_restorer
+ */
+class app_lifecycle final {
+ public:
+  using size_type = usize;
+
+  explicit app_lifecycle(const app_lifecycle_options& options = {})
+      : mOptions {options}
+      , mOwner {thread::current_id()}
+      , mListener {this}
+      , mWatch {mListener}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(app_lifecycle)
+  CENTURION_DISABLE_MOVE(app_lifecycle)
+
+  /// Releases the textures of a restorer while the application is in the background.
+  void attach(texture_restorer& restorer)
+  {
+    if (std::find(mRestorers.begin(), mRestorers.end(), &restorer) == mRestorers.end()) {
+      mRestorers.push_back(&restorer);
+    }
+
+    if (mSuspended && mOptions.evict_textures) {
+      restorer.evict();
+    }
+  }
+
+  /// Stops managing a restorer, returning `false` if it wasn't attached.
+  auto detach(texture_restorer& restorer) -> bool
+  {
+    const auto iter = std::find(mRestorers.begin(), mRestorers.end(), &restorer);
+    if (iter != mRestorers.end()) {
+      mRestorers.erase(iter);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Applies the latest lifecycle event that was pushed from another thread.
+   *
+   * \return `true` if the handler was suspended or resumed; `false` otherwise.
+   */
+  auto update() -> bool
+  {
+    const auto pending =
+        mListener.pending.exchange(transition::none, std::memory_order_acq_rel);
+    const auto wasSuspended = mSuspended;
+
+    if (pending == transition::suspend) {
+      suspend();
+    }
+    else if (pending == transition::resume) {
+      resume();
+    }
+
+    return mSuspended != wasSuspended;
+  }
+
+  /**
+   * Suspends the application, as if it entered the background.
+   *
+   * \details This pauses audio and releases textures, according to the configuration.
+   */
+  void suspend()
+  {
+    if (mSuspended) {
+      return;
+    }
+
+    mSuspended = true;
+    ++mSuspensions;
+
+    if (mOptions.pause_audio) {
+      pause_audio();
+    }
+
+    if (mOptions.evict_textures) {
+      for (auto* restorer : mRestorers) {
+        restorer->evict();
+      }
+    }
+  }
+
+  /**
+   * Resumes the application, as if it entered the foreground.
+   *
+   * \details Only the channels and music that were paused by `suspend()` are resumed.
+   *
+   * \throws any exception thrown when reloading textures, if enabled.
+   */
+  void resume()
+  {
+    if (!mSuspended) {
+      return;
+    }
+
+    mSuspended = false;
+    resume_audio();
+
+    if (mOptions.evict_textures && mOptions.reload_textures) {
+      for (auto* restorer : mRestorers) {
+        restorer->reload();
+      }
+    }
+  }
+
+  /// Indicates whether the application is suspended, in which case it shouldn't render.
+  [[nodiscard]] auto is_suspended() const noexcept -> bool { return mSuspended; }
+
+  /// Returns the amount of times that the application has been suspended.
+  [[nodiscard]] auto suspension_count() const noexcept -> size_type { return mSuspensions; }
+
+  /// Returns the amount of channels that will be resumed along with the application.
+  [[nodiscard]] auto paused_channel_count() const noexcept -> size_type
+  {
+    return mPausedChannels.size();
+  }
+
+  [[nodiscard]] auto options() const noexcept -> const app_lifecycle_options&
+  {
+    return mOptions;
+  }
+
+ private:
+  enum class transition { none, suspend, resume };
+
+  /* Invoked by the event watch, possibly from other threads */
+  struct listener final {
+    app_lifecycle* self {};
+    std::atomic<transition> pending {transition::none};  ///< The latest lifecycle event.
+
+    void operator()(const SDL_Event& event)
+    {
+      if (event.type == SDL_APP_WILLENTERBACKGROUND) {
+        pending.store(transition::suspend, std::memory_order_release);
+      }
+      else if (event.type == SDL_APP_DIDENTERFOREGROUND) {
+        pending.store(transition::resume, std::memory_order_release);
+      }
+      else {
+        return;
+      }
+
+      if (thread::current_id() == self->mOwner) {
+        try {
+          self->update();
+        }
+        catch (...) {
+          /* Textures that couldn't be reloaded are uploaded lazily instead */
+        }
+      }
+    }
+  };
+
+  app_lifecycle_options mOptions;
+  thread_id mOwner;
+  listener mListener;
+  event_watch mWatch;
+  std::vector<texture_restorer*> mRestorers;
+  std::vector<int> mPausedChannels;
+  size_type mSuspensions {};
+  bool mSuspended {};
+  bool mPausedMusic {};
+
+  void pause_audio() noexcept
+  {
+#ifndef CENTURION_NO_SDL_MIXER
+    if (!Mix_QuerySpec(nullptr, nullptr, nullptr)) {
+      return;
+    }
+
+    /* Channels that were paused by the application stay paused when resuming */
+    const auto channels = Mix_AllocateChannels(-1);
+    for (int channel = 0; channel < channels; ++channel) {
+      if (Mix_Playing(channel) && !Mix_Paused(channel)) {
+        Mix_Pause(channel);
+        mPausedChannels.push_back(channel);
+      }
+    }
+
+    if (Mix_PlayingMusic() && !Mix_PausedMusic()) {
+      Mix_PauseMusic();
+      mPausedMusic = true;
+    }
+#endif  // CENTURION_NO_SDL_MIXER
+  }
+
+  void resume_audio() noexcept
+  {
+#ifndef CENTURION_NO_SDL_MIXER
+    for (const auto channel : mPausedChannels) {
+      Mix_Resume(channel);
+    }
+
+    if (mPausedMusic) {
+      Mix_ResumeMusic();
+    }
+#endif  // CENTURION_NO_SDL_MIXER
+
+    mPausedChannels.clear();
+    mPausedMusic = false;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_EVENTS_APP_LIFECYCLE_HPP_
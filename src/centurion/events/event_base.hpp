@@ -27,13 +27,18 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 #include <utility>      // move
 
 #include "../common/primitives.hpp"
 #include "event_type.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 /// The base class of all events.
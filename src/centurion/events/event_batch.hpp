@@ -0,0 +1,318 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_EVENTS_EVENT_BATCH_HPP_
+#define CENTURION_EVENTS_EVENT_BATCH_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <string>   // string, to_string
+#include <vector>   // vector
+
+#include "../common/primitives.hpp"
+#include "../features.hpp"
+#include "event_handler.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/**
+ * A reusable buffer used to obtain several events at once.
+ *
+ * Unlike `event_handler::poll()`, which pumps the event loop and locks the event queue for
+ * every event, `drain()` pumps the event loop once and then moves up to `capacity()` events
+ * into the batch in a single call.
+ *
+ * \see event_handler
+ * \see event_dispatcher
+ */
+class event_batch final {
+ public:
+  using size_type = usize;
+  using const_iterator = const SDL_Event*;
+
+  /**
+   * Creates an empty event batch.
+   *
+   * \param capacity the maximum amount of events obtained by each call to `drain()`.
+   */
+  explicit event_batch(const size_type capacity = 256) : mEvents(capacity)
+  {
+    assert(capacity > 0);
+  }
+
+  /**
+   * Moves as many events as possible from the event queue into the batch.
+   *
+   * The previous contents of the batch are discarded. If the returned amount is equal to the
+   * capacity of the batch, there might still be events left in the queue.
+   *
+   * \return the amount of events in the batch.
+   */
+  auto drain() noexcept -> size_type
+  {
+    SDL_PumpEvents();
+
+    const auto count = SDL_PeepEvents(mEvents.data(),
+                                      static_cast<int>(mEvents.size()),
+                                      SDL_GETEVENT,
+                                      SDL_FIRSTEVENT,
+                                      SDL_LASTEVENT);
+    mSize = (count > 0) ? static_cast<size_type>(count) : 0u;
+    mDrained = mSize;
+
+    if (mCoalescing) {
+      coalesce();
+    }
+
+    return mSize;
+  }
+
+  /**
+   * Merges consecutive high-rate input events in the batch.
+   *
+   * Adjacent mouse motion events with the same window, mouse and button state are merged into
+   * the latest event, with the relative motion summed. Adjacent mouse wheel events and finger
+   * motion events are merged in the same way, summing the scroll amounts and finger deltas.
+   * The relative order of all remaining events is preserved.
+   *
+   * \return the amount of events that were merged into other events.
+   */
+  auto coalesce() noexcept -> size_type
+  {
+    if (mSize < 2) {
+      return 0;
+    }
+
+    size_type last {};
+    for (size_type index = 1; index < mSize; ++index) {
+      auto& previous = mEvents[last];
+      const auto& current = mEvents[index];
+
+      if (!merge(previous, current)) {
+        ++last;
+        mEvents[last] = current;
+      }
+    }
+
+    const auto merged = mSize - (last + 1u);
+    mSize = last + 1u;
+
+    return merged;
+  }
+
+  /**
+   * Sets whether `drain()` should automatically coalesce the obtained events.
+   *
+   * \param enabled `true` if events should be coalesced; `false` otherwise.
+   *
+   * \see coalesce()
+   */
+  void set_coalescing(const bool enabled) noexcept { mCoalescing = enabled; }
+
+  /// Indicates whether `drain()` automatically coalesces events.
+  [[nodiscard]] auto is_coalescing() const noexcept -> bool { return mCoalescing; }
+
+  /**
+   * Invokes a function object for each event in the batch.
+   *
+   * \param func a function object invoked with a `const event_handler&` for each event.
+   */
+  template <typename Func>
+  void each(Func&& func)
+  {
+    for (const auto& event : *this) {
+      mView.assign(event);
+      func(static_cast<const event_handler&>(mView));
+    }
+  }
+
+  /**
+   * Invokes a function object for each event of a specific type in the batch.
+   *
+   * \tparam T the event type to look for, e.g. `mouse_motion_event`.
+   *
+   * \param func a function object invoked with a `const T&` for each matching event.
+   */
+  template <typename T, typename Func>
+  void each(Func&& func)
+  {
+    for (const auto& event : *this) {
+      mView.assign(event);
+      if (const auto* typed = mView.try_get<T>()) {
+        func(*typed);
+      }
+    }
+  }
+
+  /// Removes all events from the batch.
+  void clear() noexcept
+  {
+    mSize = 0;
+    mDrained = 0;
+  }
+
+  [[nodiscard]] auto operator[](const size_type index) const noexcept -> const SDL_Event&
+  {
+    assert(index < mSize);
+    return mEvents[index];
+  }
+
+  [[nodiscard]] auto begin() const noexcept -> const_iterator { return mEvents.data(); }
+
+  [[nodiscard]] auto end() const noexcept -> const_iterator { return mEvents.data() + mSize; }
+
+  /// Returns the amount of events in the batch.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mSize; }
+
+  /// Returns the maximum amount of events in the batch.
+  [[nodiscard]] auto capacity() const noexcept -> size_type { return mEvents.size(); }
+
+  /// Indicates whether the batch is empty.
+  [[nodiscard]] auto empty() const noexcept -> bool { return mSize == 0; }
+
+  /**
+   * Indicates whether the latest drain filled the batch, i.e. if more events may remain in the
+   * queue. This is not affected by coalescing.
+   */
+  [[nodiscard]] auto full() const noexcept -> bool { return mDrained == mEvents.size(); }
+
+ private:
+  std::vector<SDL_Event> mEvents;
+  size_type mSize {};
+  size_type mDrained {};
+  event_handler mView;
+  bool mCoalescing {};
+
+  /// Attempts to merge an event into the previous event, returns true upon success.
+  [[nodiscard]] static auto merge(SDL_Event& previous, const SDL_Event& current) noexcept
+      -> bool
+  {
+    if (previous.type != current.type) {
+      return false;
+    }
+
+    if (current.type == SDL_MOUSEMOTION) {
+      auto& prev = previous.motion;
+      const auto& curr = current.motion;
+
+      if (prev.windowID != curr.windowID || prev.which != curr.which ||
+          prev.state != curr.state) {
+        return false;
+      }
+
+      const auto xrel = prev.xrel + curr.xrel;
+      const auto yrel = prev.yrel + curr.yrel;
+
+      prev = curr;
+      prev.xrel = xrel;
+      prev.yrel = yrel;
+
+      return true;
+    }
+    else if (current.type == SDL_MOUSEWHEEL) {
+      auto& prev = previous.wheel;
+      const auto& curr = current.wheel;
+
+      if (prev.windowID != curr.windowID || prev.which != curr.which ||
+          prev.direction != curr.direction) {
+        return false;
+      }
+
+      const auto x = prev.x + curr.x;
+      const auto y = prev.y + curr.y;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+      const auto preciseX = prev.preciseX + curr.preciseX;
+      const auto preciseY = prev.preciseY + curr.preciseY;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+      prev = curr;
+      prev.x = x;
+      prev.y = y;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+      prev.preciseX = preciseX;
+      prev.preciseY = preciseY;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+      return true;
+    }
+    else if (current.type == SDL_FINGERMOTION) {
+      auto& prev = previous.tfinger;
+      const auto& curr = current.tfinger;
+
+      if (prev.touchId != curr.touchId || prev.fingerId != curr.fingerId) {
+        return false;
+      }
+
+      const auto dx = prev.dx + curr.dx;
+      const auto dy = prev.dy + curr.dy;
+
+      prev = curr;
+      prev.dx = dx;
+      prev.dy = dy;
+
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+};
+
+[[nodiscard]] inline auto to_string(const event_batch& batch) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("event_batch(size: {}, capacity: {})", batch.size(), batch.capacity());
+#else
+  return "event_batch(size: " + std::to_string(batch.size()) +
+         ", capacity: " + std::to_string(batch.capacity()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const event_batch& batch) -> std::ostream&
+{
+  return stream << to_string(batch);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_EVENTS_EVENT_BATCH_HPP_
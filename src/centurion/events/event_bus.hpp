@@ -0,0 +1,326 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_EVENTS_EVENT_BUS_HPP_
+#define CENTURION_EVENTS_EVENT_BUS_HPP_
+
+#include <SDL.h>
+
+#include <array>        // array
+#include <cassert>      // assert
+#include <new>          // new
+#include <tuple>        // tuple, get
+#include <type_traits>  // decay_t, is_same_v, is_trivially_destructible_v
+#include <utility>      // move
+
+#include "../common/frame_arena.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/profiler.hpp"
+#include "event_batch.hpp"
+#include "event_channel.hpp"
+#include "event_handler.hpp"
+
+namespace cen {
+
+/**
+ * A read-only view of the events of a single type that were collected by an event bus.
+ *
+ * \details Views are invalidated when the event bus is cleared, or when more events of the
+ *          same type are added to the bus.
+ *
+ * \see event_bus
+ */
+template <typename Event>
+class event_range final {
+ public:
+  using value_type = Event;
+  using size_type = usize;
+  using iterator = const Event*;
+  using const_iterator = const Event*;
+
+  constexpr event_range() noexcept = default;
+
+  constexpr event_range(const Event* data, const size_type size) noexcept
+      : mData {data}
+      , mSize {size}
+  {
+  }
+
+  [[nodiscard]] constexpr auto begin() const noexcept -> iterator { return mData; }
+  [[nodiscard]] constexpr auto end() const noexcept -> iterator { return mData + mSize; }
+
+  [[nodiscard]] constexpr auto operator[](const size_type index) const noexcept
+      -> const Event&
+  {
+    assert(index < mSize);
+    return mData[index];
+  }
+
+  [[nodiscard]] constexpr auto data() const noexcept -> const Event* { return mData; }
+  [[nodiscard]] constexpr auto size() const noexcept -> size_type { return mSize; }
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool { return mSize == 0; }
+
+ private:
+  const Event* mData {};
+  size_type mSize {};
+};
+
+/**
+ * Collects the events of a frame into contiguous arrays, one for each event type.
+ *
+ * Unlike `event_dispatcher`, which invokes handlers while the events are polled, an event
+ * bus stores the events so that any amount of systems can process them later in the frame.
+ * Each event type is stored in its own array, which makes processing the events of a type a
+ * linear scan, and the arrays may be read by several threads at the same time.
+ *
+ * \code{cpp}
+ * cen::event_bus<cen::keyboard_event, cen::mouse_button_event> bus;
+ *
+ * while (running) {
+ *   bus.poll();
+ *
+ *   for (const auto& event : bus.view<cen::keyboard_event>()) {
+ *     // ...
+ *   }
+ *
+ *   bus.clear();
+ * }
+ * \endcode
+ *
+ * \details The events are stored in a frame arena, so collecting events doesn't allocate once
+ *          the arena has grown to fit the events of a busy frame. As a consequence, the event
+ *          types must be trivially destructible.
+ *
+ * \tparam Events the collected event types, all other events are ignored.
+ *
+ * \see event_dispatcher
+ * \see event_range
+ */
+template <typename... Events>
+class event_bus final {
+  static_assert((std::is_same_v<Events, std::decay_t<Events>> && ...),
+                "Event types must not be references or cv-qualified!");
+  static_assert((std::is_trivially_destructible_v<Events> && ...),
+                "Event types must be trivially destructible!");
+
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates an empty event bus.
+   *
+   * \param blockSize the size of the arena blocks that store the events, in bytes.
+   */
+  explicit event_bus(const size_type blockSize = 16 * 1024) : mArena {blockSize} {}
+
+  CENTURION_DISABLE_COPY(event_bus)
+
+  event_bus(event_bus&&) noexcept = default;
+  auto operator=(event_bus&&) noexcept -> event_bus& = default;
+
+  /// Collects all queued events, ignoring the events that aren't collected by the bus.
+  void poll()
+  {
+    CENTURION_PROFILE_SCOPE("event_bus::poll");
+
+    while (mEvent.poll()) {
+      collect_current();
+    }
+  }
+
+  /**
+   * Collects all queued events in bulk, see `event_dispatcher::poll(event_batch&)`.
+   *
+   * \param batch the reusable buffer used to obtain the events.
+   */
+  void poll(event_batch& batch)
+  {
+    CENTURION_PROFILE_SCOPE("event_bus::poll");
+
+    do {
+      batch.drain();
+
+      for (const auto& event : batch) {
+        mEvent.assign(event);
+        collect_current();
+      }
+    } while (batch.full());
+  }
+
+  /**
+   * Collects all events in a channel, e.g. custom events sent from other threads.
+   *
+   * \param channel the channel that will be drained.
+   *
+   * \return the amount of collected events.
+   */
+  template <typename Event>
+  auto poll(event_channel<Event>& channel) -> size_type
+  {
+    static_assert((std::is_same_v<Event, Events> || ...),
+                  "Cannot poll channel with uncollected event type!");
+
+    return channel.drain([this](Event&& event) { push(std::move(event)); });
+  }
+
+  /// Adds an event to the bus, e.g. an event generated by the application.
+  template <typename Event>
+  void push(Event event)
+  {
+    auto& array = get_array<Event>();
+
+    if (array.size == array.capacity) {
+      grow(array);
+    }
+
+    new (array.data + array.size) Event {std::move(event)};
+    ++array.size;
+  }
+
+  /// Returns the events of a type that were collected since the last `clear()`.
+  template <typename Event>
+  [[nodiscard]] auto view() const noexcept -> event_range<Event>
+  {
+    const auto& array = get_array<Event>();
+    return event_range<Event> {array.data, array.size};
+  }
+
+  /// Returns the amount of collected events of a type.
+  template <typename Event>
+  [[nodiscard]] auto count() const noexcept -> size_type
+  {
+    return get_array<Event>().size;
+  }
+
+  /// Returns the total amount of collected events.
+  [[nodiscard]] auto size() const noexcept -> size_type
+  {
+    return (size_type {0} + ... + get_array<Events>().size);
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+  /**
+   * Removes all collected events, usually called at the end of each frame.
+   *
+   * \details This invalidates all views, and reuses the memory of the events.
+   */
+  void clear()
+  {
+    ((get_array<Events>() = {}), ...);
+    mArena.reset();
+  }
+
+  /// Returns the arena that stores the events.
+  [[nodiscard]] auto arena() const noexcept -> const frame_arena& { return mArena; }
+
+ private:
+  template <typename Event>
+  struct array final {
+    Event* data {};
+    size_type size {};
+    size_type capacity {};
+  };
+
+  using collect_fn = void (event_bus::*)();
+  using collect_table = std::array<collect_fn, event_handler::index_count()>;
+
+  event_handler mEvent;
+  frame_arena mArena;
+  std::tuple<array<Events>...> mArrays;
+
+  template <typename Event>
+  [[nodiscard]] auto get_array() noexcept -> array<Event>&
+  {
+    static_assert((std::is_same_v<Event, Events> || ...), "Invalid event type!");
+    return std::get<array<Event>>(mArrays);
+  }
+
+  template <typename Event>
+  [[nodiscard]] auto get_array() const noexcept -> const array<Event>&
+  {
+    static_assert((std::is_same_v<Event, Events> || ...), "Invalid event type!");
+    return std::get<array<Event>>(mArrays);
+  }
+
+  /* The previous storage stays in the arena until the next clear */
+  template <typename Event>
+  void grow(array<Event>& array)
+  {
+    const auto capacity = (detail::max)(array.capacity * 2, size_type {16});
+    auto* data = mArena.template allocate_array<Event>(capacity);
+
+    for (size_type index = 0; index < array.size; ++index) {
+      new (data + index) Event {std::move(array.data[index])};
+    }
+
+    array.data = data;
+    array.capacity = capacity;
+  }
+
+  template <typename Event>
+  void collect()
+  {
+    push(*mEvent.template try_get<Event>());
+  }
+
+  template <typename Event>
+  constexpr static void add_to_table(collect_table& table) noexcept
+  {
+    /* Custom events are never stored in the event handler, only pushed or sent in channels */
+    if constexpr (event_handler::can_store<Event>()) {
+      table[event_handler::index_of<Event>()] = &event_bus::collect<Event>;
+    }
+  }
+
+  [[nodiscard]] constexpr static auto make_collect_table() noexcept -> collect_table
+  {
+    collect_table table {};
+    (add_to_table<Events>(table), ...);
+    return table;
+  }
+
+  void collect_current()
+  {
+    constexpr static collect_table table = make_collect_table();
+
+    /* Wake events are only of interest to the waiting thread */
+    if constexpr ((std::is_same_v<Events, user_event> || ...)) {
+      if (mEvent.is_wake_event()) {
+        return;
+      }
+    }
+
+    if (const auto function = table[mEvent.index()]) {
+      (this->*function)();
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_EVENTS_EVENT_BUS_HPP_
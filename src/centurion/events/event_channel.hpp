@@ -0,0 +1,156 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_EVENTS_EVENT_CHANNEL_HPP_
+#define CENTURION_EVENTS_EVENT_CHANNEL_HPP_
+
+#include <string>   // string, to_string
+#include <utility>  // move, forward
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/lock_free_queue.hpp"
+#include "../features.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/**
+ * A bounded lock-free queue used to send typed events between threads.
+ *
+ * Any amount of threads may push events into the channel, but only a single thread may
+ * consume them, usually the main thread through `event_dispatcher::poll(event_channel&)`. The
+ * payloads are stored inline in the preallocated ring buffer of an `mpmc_queue`, so sending
+ * an event never allocates and never takes the SDL event lock.
+ *
+ * \tparam T the event payload type, which must be nothrow move constructible.
+ *
+ * \see event_dispatcher
+ * \see mpmc_queue
+ */
+template <typename T>
+class event_channel final {
+ public:
+  using value_type = T;
+  using size_type = usize;
+
+  /**
+   * Creates an empty channel.
+   *
+   * \param capacity the maximum amount of queued events, rounded up to a power of two.
+   */
+  explicit event_channel(const size_type capacity = 1024) : mQueue {capacity} {}
+
+  CENTURION_DISABLE_COPY(event_channel)
+  CENTURION_DISABLE_MOVE(event_channel)
+
+  /**
+   * Attempts to add an event to the channel, may be called from any thread.
+   *
+   * \param value the event that will be added.
+   *
+   * \return `true` if the event was added; `false` if the channel was full.
+   */
+  auto push(T value) -> bool { return mQueue.try_push(std::move(value)); }
+
+  /**
+   * Attempts to construct an event in the channel, may be called from any thread.
+   *
+   * \details The event is constructed before a slot is claimed, so an exception thrown by the
+   *          constructor leaves the channel untouched.
+   */
+  template <typename... Args>
+  auto emplace(Args&&... args) -> bool
+  {
+    return mQueue.try_emplace(std::forward<Args>(args)...);
+  }
+
+  /**
+   * Removes the oldest event in the channel, may only be called from the consumer thread.
+   *
+   * \return the removed event; an empty optional if the channel was empty.
+   */
+  auto pop() -> maybe<T> { return mQueue.try_pop(); }
+
+  /**
+   * Removes all available events, invoking a function object for each of them.
+   *
+   * \param func a function object invoked with a `T&&` for each event.
+   *
+   * \return the amount of removed events.
+   */
+  template <typename Func>
+  auto drain(Func&& func) -> size_type
+  {
+    size_type count {};
+
+    while (auto value = pop()) {
+      func(std::move(*value));
+      ++count;
+    }
+
+    return count;
+  }
+
+  /// Returns the maximum amount of queued events.
+  [[nodiscard]] auto capacity() const noexcept -> size_type { return mQueue.capacity(); }
+
+ private:
+  mpmc_queue<T> mQueue;
+};
+
+template <typename T>
+[[nodiscard]] auto to_string(const event_channel<T>& channel) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("event_channel(capacity: {})", channel.capacity());
+#else
+  return "event_channel(capacity: " + std::to_string(channel.capacity()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+template <typename T>
+auto operator<<(std::ostream& stream, const event_channel<T>& channel) -> std::ostream&
+{
+  return stream << to_string(channel);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_EVENTS_EVENT_CHANNEL_HPP_
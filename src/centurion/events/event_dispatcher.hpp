@@ -25,15 +25,23 @@
 #ifndef CENTURION_EVENTS_EVENT_DISPATCHER_HPP_
 #define CENTURION_EVENTS_EVENT_DISPATCHER_HPP_
 
-#include <ostream>      // ostream
+#include <algorithm>    // lower_bound
+#include <array>        // array
+#include <memory>       // unique_ptr, make_unique
 #include <string>       // string, to_string
 #include <tuple>        // tuple
 #include <type_traits>  // decay_t, is_const_v, is_volative_v, is_reference_v, is_pointer_v
+#include <utility>      // declval
+#include <vector>       // vector
 
 #include "../common/primitives.hpp"
 #include "../detail/tuple_type_index.hpp"
 #include "../features.hpp"
+#include "../system/profiler.hpp"
+#include "event_batch.hpp"
+#include "event_channel.hpp"
 #include "event_handler.hpp"
+#include "event_statistics.hpp"
 #include "event_sink.hpp"
 
 #if CENTURION_HAS_FEATURE_FORMAT
@@ -42,7 +50,25 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
+namespace detail {
+
+/* Indicates whether events of a type are associated with a window */
+template <typename Event, typename = void>
+inline constexpr bool has_window_id = false;
+
+template <typename Event>
+inline constexpr bool
+    has_window_id<Event, std::void_t<decltype(std::declval<const Event&>().window_id())>> =
+        true;
+
+}  // namespace detail
 
 /**
  * An event dispatcher, implemented as wrapper around an event_handler instance.
@@ -66,6 +92,12 @@ namespace cen {
  * Note, it is advisable to always typedef the signature of this class with the events that you
  * want to handle, since the class name quickly grows in size.
  *
+ * Events that are associated with a window, e.g. window, keyboard and mouse events, can also
+ * be routed to handlers of a specific window with `bind<Event>(windowId)`. Such events are
+ * published to the sink of their window if it has a handler, and to the global sink
+ * otherwise. The routes are stored in a flat map sorted by window ID, so the cost of routing
+ * an event grows logarithmically with the amount of routed windows.
+ *
  * \tparam Events the list of events to "subscribe" to, all other events are ignored.
  */
 template <typename... Events>
@@ -103,17 +135,182 @@ class event_dispatcher final {
     return std::get<index>(mSinks);
   }
 
-  /// Checks for the specified event type in the event handler, returns true upon a match.
+  using dispatch_fn = void (event_dispatcher::*)();
+  using dispatch_table = std::array<dispatch_fn, event_handler::index_count()>;
+
+  /// Forwards the current event to the associated event sink.
   template <typename Event>
-  auto check_for() -> bool
+  void dispatch()
   {
-    if (const auto* event = mEvent.template try_get<Event>()) {
-      auto& function = get_sink<Event>().function();
+    publish(*mEvent.template try_get<Event>());
+  }
+
+  /// The sinks of a single window.
+  struct route final {
+    uint32 window {};
+    std::unique_ptr<sink_tuple> sinks;
+  };
 
-      if (function) {
-        function(*event);
+  [[nodiscard]] auto route_bound(const uint32 window) noexcept
+  {
+    return std::lower_bound(mRoutes.begin(),
+                            mRoutes.end(),
+                            window,
+                            [](const route& r, const uint32 id) { return r.window < id; });
+  }
+
+  [[nodiscard]] auto find_route(const uint32 window) noexcept -> sink_tuple*
+  {
+    const auto iter = route_bound(window);
+    return (iter != mRoutes.end() && iter->window == window) ? iter->sinks.get() : nullptr;
+  }
+
+  /// Forwards an event to its sink, preferring the sink of its window if it has a handler.
+  template <typename Event>
+  void publish(const Event& event)
+  {
+    if constexpr (detail::has_window_id<Event>) {
+      if (!mRoutes.empty()) {
+        if (auto* sinks = find_route(event.window_id())) {
+          auto& sink = std::get<index_of<Event>()>(*sinks);
+          if (!sink.empty()) {
+            publish_to(sink, event);
+            return;
+          }
+        }
       }
+    }
+
+    publish_to(get_sink<Event>(), event);
+  }
+
+  /// Publishes an event to a sink, measuring the time spent in the handlers if instrumented.
+  template <typename Event>
+  void publish_to(event_sink<Event>& sink, const Event& event)
+  {
+    if (mInstrumented && !sink.empty()) {
+      const auto start = now();
+      sink.publish(event);
+      mHandlerStats[index_of<Event>()].record(now() - start);
+    }
+    else {
+      sink.publish(event);
+    }
+  }
+
+  /// Creates a table that maps event indices to dispatch functions.
+  [[nodiscard]] constexpr static auto make_dispatch_table() noexcept -> dispatch_table
+  {
+    dispatch_table table {};
+    (add_to_table<Events>(table), ...);
+    return table;
+  }
+
+  template <typename Event>
+  constexpr static void add_to_table(dispatch_table& table) noexcept
+  {
+    /* Custom events, e.g. sent through channels, are never stored in the event handler */
+    if constexpr (event_handler::can_store<Event>()) {
+      table[event_handler::index_of<Event>()] = &event_dispatcher::dispatch<Event>;
+    }
+  }
+
+  /// Forwards the current event to its sink, if the event is subscribed to.
+  void dispatch_current()
+  {
+    constexpr static dispatch_table table = make_dispatch_table();
+
+    /* Wake events are only of interest to the waiting thread */
+    if constexpr ((std::is_same_v<Events, user_event> || ...)) {
+      if (mEvent.is_wake_event()) {
+        return;
+      }
+    }
+
+    if (mInstrumented) {
+      mStats.record_event(*mEvent.data(), detail::event_ticks());
+    }
+
+    if (const auto function = table[mEvent.index()]) {
+      (this->*function)();
+    }
+  }
+
+  /// Dispatches all queued events, where depth is the amount of already dispatched events.
+  void dispatch_queued(usize depth)
+  {
+    CENTURION_PROFILE_SCOPE("event_dispatcher::poll");
+
+    while (mEvent.poll()) {
+      dispatch_current();
+      ++depth;
+    }
+
+    if (mInstrumented) {
+      mStats.record_poll(depth);
+    }
+  }
+
+  /// Dispatches an event obtained by waiting, along with the remaining queued events.
+  void dispatch_waited()
+  {
+    dispatch_current();
+    dispatch_queued(1);
+  }
+
+ public:
+  /**
+   * Polls all events, checking for subscribed events.
+   *
+   * Each event is forwarded directly to its sink through a table lookup, so the cost of
+   * dispatching an event doesn't depend on the amount of subscribed events.
+   */
+  void poll() { dispatch_queued(0); }
+
+  /**
+   * Polls all events in bulk using an event batch, checking for subscribed events.
+   *
+   * This is usually faster than `poll()` when many events are queued, e.g. with high-rate
+   * mice, since the event queue is only locked once for every batch of events. Enable
+   * coalescing in the batch to also merge consecutive motion events before they are
+   * dispatched.
+   *
+   * \param batch the reusable buffer used to obtain the events.
+   */
+  void poll(event_batch& batch)
+  {
+    CENTURION_PROFILE_SCOPE("event_dispatcher::poll");
+
+    usize depth = 0;
+
+    do {
+      batch.drain();
+
+      for (const auto& event : batch) {
+        mEvent.assign(event);
+        dispatch_current();
+      }
+
+      depth += batch.size();
+    } while (batch.full());
+
+    if (mInstrumented) {
+      mStats.record_poll(depth);
+    }
+  }
 
+  /**
+   * Waits indefinitely for an event, and then dispatches all available events.
+   *
+   * This is the event-driven equivalent of `poll()`, use `event_handler::wake()` to wake up
+   * the waiting thread from other threads.
+   *
+   * \return `true` if events were dispatched; `false` if an error occurred.
+   */
+  auto wait() -> bool
+  {
+    if (mEvent.wait()) {
+      dispatch_waited();
       return true;
     }
     else {
@@ -121,13 +318,42 @@ class event_dispatcher final {
     }
   }
 
- public:
-  /// Polls all events, checking for subscribed events.
-  void poll()
+  /**
+   * Waits for an event for at most the specified amount of time, and then dispatches all
+   * available events.
+   *
+   * \param timeout the maximum amount of time to wait for an event.
+   *
+   * \return `true` if events were dispatched; `false` if the timeout elapsed or on errors.
+   */
+  auto wait_for(const u32ms timeout) -> bool
   {
-    while (mEvent.poll()) {
-      (check_for<Events>() || ...); /* Use OR to exploit short-circuiting */
+    if (mEvent.wait_for(timeout)) {
+      dispatch_waited();
+      return true;
     }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Dispatches all events in a channel to the associated event sink.
+   *
+   * The channel payload type must be one of the subscribed events, which makes it possible to
+   * subscribe to custom event types that are sent from other threads.
+   *
+   * \param channel the channel that will be drained.
+   *
+   * \return the amount of dispatched events.
+   */
+  template <typename Event>
+  auto poll(event_channel<Event>& channel) -> usize
+  {
+    static_assert((std::is_same_v<Event, Events> || ...),
+                  "Cannot poll channel with unsubscribed event type!");
+
+    return channel.drain([this](Event&& event) { publish(event); });
   }
 
   /**
@@ -146,13 +372,103 @@ class event_dispatcher final {
     return get_sink<Event>();
   }
 
-  /// Removes all set handlers from all the subscribed events.
-  void reset() noexcept { (bind<Events>().reset(), ...); }
+  /**
+   * Returns the event sink associated with an event, for the events of a specific window.
+   *
+   * Events of the window are only published to this sink if it has a handler, otherwise they
+   * are published to the global sink obtained with `bind()`.
+   *
+   * \tparam Event the subscribed event, which must be associated with a window.
+   *
+   * \param window the ID of the window, see `basic_window::id()`.
+   *
+   * \return an event sink.
+   */
+  template <typename Event>
+  auto bind(const uint32 window) -> event_sink<Event>&
+  {
+    static_assert(detail::has_window_id<std::decay_t<Event>>,
+                  "Cannot route events that aren't associated with a window!");
+
+    auto iter = route_bound(window);
+    if (iter == mRoutes.end() || iter->window != window) {
+      iter = mRoutes.insert(iter, route {window, std::make_unique<sink_tuple>()});
+    }
 
-  /// Returns the amount of set event handlers.
+    return std::get<index_of<Event>()>(*iter->sinks);
+  }
+
+  /**
+   * Removes all window-specific handlers of a window, e.g. when the window is closed.
+   *
+   * \param window the ID of the window.
+   *
+   * \return `true` if the window had a route; `false` otherwise.
+   */
+  auto unbind(const uint32 window) -> bool
+  {
+    const auto iter = route_bound(window);
+    if (iter != mRoutes.end() && iter->window == window) {
+      mRoutes.erase(iter);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Removes all set handlers from all the subscribed events, including the window routes.
+  void reset() noexcept
+  {
+    (bind<Events>().reset(), ...);
+    mRoutes.clear();
+  }
+
+  /// Returns the amount of windows with their own handlers.
+  [[nodiscard]] auto route_count() const noexcept -> usize { return mRoutes.size(); }
+
+  /// Returns the amount of subscribed events with a handler or at least one listener.
   [[nodiscard]] auto active_count() const -> usize
   {
-    return (0u + ... + (get_sink<Events>().function() ? 1u : 0u));
+    return (0u + ... + (get_sink<Events>().empty() ? 0u : 1u));
+  }
+
+  /**
+   * Enables or disables the collection of event statistics.
+   *
+   * When enabled, the dispatcher records the latency of each polled event, the amount of
+   * events handled by each poll, and the time spent in the handlers of each event sink. This
+   * makes it possible to determine whether input lag is caused by the event handlers or by
+   * events spending time in the event queue. This is disabled by default.
+   *
+   * \param enabled `true` to collect statistics; `false` otherwise.
+   */
+  void set_instrumented(const bool enabled) noexcept { mInstrumented = enabled; }
+
+  /// Clears all collected event statistics.
+  void reset_statistics()
+  {
+    mStats.reset();
+    mHandlerStats.fill(handler_statistics {});
+  }
+
+  /// Indicates whether event statistics are collected.
+  [[nodiscard]] auto is_instrumented() const noexcept -> bool { return mInstrumented; }
+
+  /// Returns the latency and queue depth statistics of polled events.
+  [[nodiscard]] auto statistics() const noexcept -> const event_statistics& { return mStats; }
+
+  /**
+   * Returns the statistics of the time spent in the handlers of a subscribed event.
+   *
+   * \tparam Event the subscribed event to obtain the handler statistics for.
+   *
+   * \return the handler statistics.
+   */
+  template <typename Event>
+  [[nodiscard]] auto handler_stats() const noexcept -> const handler_statistics&
+  {
+    return mHandlerStats[index_of<Event>()];
   }
 
   /// Returns the total number of subscribed events.
@@ -161,6 +477,10 @@ class event_dispatcher final {
  private:
   event_handler mEvent;
   sink_tuple mSinks;
+  std::vector<route> mRoutes;  ///< Sorted by window ID.
+  event_statistics mStats;
+  std::array<handler_statistics, sizeof...(Events)> mHandlerStats {};
+  bool mInstrumented {};
 };
 
 template <typename... E>
@@ -176,6 +496,8 @@ template <typename... E>
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename... E>
 auto operator<<(std::ostream& stream, const event_dispatcher<E...>& dispatcher)
     -> std::ostream&
@@ -183,6 +505,8 @@ auto operator<<(std::ostream& stream, const event_dispatcher<E...>& dispatcher)
   return stream << to_string(dispatcher);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_EVENTS_EVENT_DISPATCHER_HPP_
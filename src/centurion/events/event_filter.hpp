@@ -0,0 +1,141 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_EVENTS_EVENT_FILTER_HPP_
+#define CENTURION_EVENTS_EVENT_FILTER_HPP_
+
+#include <SDL.h>
+
+#include <type_traits>  // is_invocable_r_v, is_invocable_v
+
+#include "../common/utils.hpp"
+#include "../features.hpp"
+
+namespace cen {
+
+/**
+ * Installs a filter that is applied to events before they are added to the event queue.
+ *
+ * The filter is invoked in the thread that generates the event, and events for which the
+ * filter returns `false` are dropped. The previous filter is restored when the filter is
+ * destroyed. Note, there may only be one event filter at a time.
+ *
+ * The function object is not copied, so it must outlive the filter, and it should be cheap
+ * and thread-safe, since it may be invoked from other threads.
+ *
+ * \see event_handler::set_event_enabled
+ * \see event_watch
+ */
+class event_filter final {
+ public:
+  /**
+   * Installs an event filter.
+   *
+   * \param predicate a function object invoked with a `const SDL_Event&`, returning `true` if
+   *                  the event should be kept.
+   */
+  template <typename Predicate>
+  CENTURION_NODISCARD_CTOR explicit event_filter(Predicate& predicate)
+      : mInstance {&predicate}
+      , mInvoke {[](void* instance, const SDL_Event& event) -> bool {
+        return (*static_cast<Predicate*>(instance))(event);
+      }}
+  {
+    static_assert(std::is_invocable_r_v<bool, Predicate&, const SDL_Event&>,
+                  "Predicate must be invocable with SDL_Event and return bool!");
+
+    SDL_GetEventFilter(&mPreviousFilter, &mPreviousData);
+    SDL_SetEventFilter(&event_filter::callback, this);
+  }
+
+  CENTURION_DISABLE_COPY(event_filter)
+  CENTURION_DISABLE_MOVE(event_filter)
+
+  ~event_filter() noexcept { SDL_SetEventFilter(mPreviousFilter, mPreviousData); }
+
+ private:
+  void* mInstance {};
+  bool (*mInvoke)(void*, const SDL_Event&) {};
+  SDL_EventFilter mPreviousFilter {};
+  void* mPreviousData {};
+
+  static int SDLCALL callback(void* data, SDL_Event* event)
+  {
+    const auto* self = static_cast<const event_filter*>(data);
+    return self->mInvoke(self->mInstance, *event) ? 1 : 0;
+  }
+};
+
+/**
+ * Registers a function object that observes all events as they are added to the event queue.
+ *
+ * Watches are invoked in the thread that pushes the event, before the event is handled by
+ * `event_handler`, which makes them suitable for latency-critical listeners. The watch is
+ * removed when the instance is destroyed.
+ *
+ * The function object is not copied, so it must outlive the watch, and it should be cheap
+ * and thread-safe, since it may be invoked from other threads.
+ *
+ * \see event_filter
+ */
+class event_watch final {
+ public:
+  /**
+   * Registers an event watch.
+   *
+   * \param callable a function object invoked with a `const SDL_Event&` for every event.
+   */
+  template <typename Callable>
+  CENTURION_NODISCARD_CTOR explicit event_watch(Callable& callable)
+      : mInstance {&callable}
+      , mInvoke {[](void* instance, const SDL_Event& event) {
+        (*static_cast<Callable*>(instance))(event);
+      }}
+  {
+    static_assert(std::is_invocable_v<Callable&, const SDL_Event&>,
+                  "Callable must be invocable with SDL_Event!");
+
+    SDL_AddEventWatch(&event_watch::callback, this);
+  }
+
+  CENTURION_DISABLE_COPY(event_watch)
+  CENTURION_DISABLE_MOVE(event_watch)
+
+  ~event_watch() noexcept { SDL_DelEventWatch(&event_watch::callback, this); }
+
+ private:
+  void* mInstance {};
+  void (*mInvoke)(void*, const SDL_Event&) {};
+
+  static int SDLCALL callback(void* data, SDL_Event* event)
+  {
+    const auto* self = static_cast<const event_watch*>(data);
+    self->mInvoke(self->mInstance, *event);
+    return 0;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_EVENTS_EVENT_FILTER_HPP_
@@ -27,15 +27,16 @@
 
 #include <SDL.h>
 
-#include <ostream>  // ostream
 #include <string>   // string, to_string
-#include <variant>  // variant, monostate, get, get_if, holds_alternative
+#include <variant>  // variant, variant_size_v, monostate, get, get_if, holds_alternative
 
 #include "../common/primitives.hpp"
+#include "../detail/tuple_type_index.hpp"
 #include "../features.hpp"
 #include "audio_events.hpp"
 #include "controller_events.hpp"
 #include "event_base.hpp"
+#include "event_view.hpp"
 #include "joystick_events.hpp"
 #include "misc_events.hpp"
 #include "mouse_events.hpp"
@@ -47,6 +48,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 /// The main API for dealing with events.
@@ -69,6 +76,26 @@ class event_handler final {
     SDL_FlushEvents(SDL_FIRSTEVENT, SDL_LASTEVENT);
   }
 
+  /**
+   * Enables or disables an event type.
+   *
+   * Disabled events are dropped by SDL as soon as they are generated, so they are never
+   * queued, which is the cheapest way to get rid of unwanted high-rate events.
+   *
+   * \param type the event type that will be affected.
+   * \param enabled `true` if the events should be processed; `false` otherwise.
+   */
+  static void set_event_enabled(const event_type type, const bool enabled) noexcept
+  {
+    SDL_EventState(to_underlying(type), enabled ? SDL_ENABLE : SDL_IGNORE);
+  }
+
+  /// Indicates whether an event type is enabled.
+  [[nodiscard]] static auto is_event_enabled(const event_type type) noexcept -> bool
+  {
+    return SDL_EventState(to_underlying(type), SDL_QUERY) == SDL_ENABLE;
+  }
+
   /// Polls the next available event, if there is one.
   auto poll() noexcept -> bool
   {
@@ -83,6 +110,100 @@ class event_handler final {
     }
   }
 
+  /**
+   * Waits indefinitely for the next available event.
+   *
+   * Unlike `poll()`, this function doesn't return until there is an event, which makes it
+   * possible to write event-driven loops that don't consume any CPU time when idle.
+   *
+   * \return `true` if an event was obtained; `false` if an error occurred.
+   *
+   * \see wake()
+   */
+  auto wait() noexcept -> bool
+  {
+    SDL_Event event {};
+    if (SDL_WaitEvent(&event)) {
+      store(event);
+      return true;
+    }
+    else {
+      reset_state();
+      return false;
+    }
+  }
+
+  /**
+   * Waits for the next available event, for at most the specified amount of time.
+   *
+   * \param timeout the maximum amount of time to wait for an event.
+   *
+   * \return `true` if an event was obtained; `false` if the timeout elapsed or on errors.
+   *
+   * \see wake()
+   */
+  auto wait_for(const u32ms timeout) noexcept(noexcept(timeout.count())) -> bool
+  {
+    SDL_Event event {};
+    if (SDL_WaitEventTimeout(&event, static_cast<int>(timeout.count()))) {
+      store(event);
+      return true;
+    }
+    else {
+      reset_state();
+      return false;
+    }
+  }
+
+  /**
+   * Wakes up a thread that is waiting for events, using `wait()` or `wait_for()`.
+   *
+   * This function is thread-safe, and works by pushing a dedicated user event to the event
+   * queue. The event has the type returned by `wake_event_type()`.
+   *
+   * \return `success` if the wake event was pushed; `failure` otherwise.
+   */
+  static auto wake() noexcept -> result
+  {
+    const auto type = wake_event_type();
+    if (type == static_cast<uint32>(-1)) {
+      return failure;
+    }
+
+    SDL_Event event {};
+    event.type = type;
+
+    return SDL_PushEvent(&event) >= 0;
+  }
+
+  /**
+   * Returns the event type that is used by wake events.
+   *
+   * The type is registered as a user event type the first time it is requested.
+   *
+   * \return the wake event type; `static_cast<uint32>(-1)` if it couldn't be registered.
+   */
+  [[nodiscard]] static auto wake_event_type() noexcept -> uint32
+  {
+    static const uint32 type = SDL_RegisterEvents(1);
+    return type;
+  }
+
+  /// Indicates whether the current event was pushed by `wake()`.
+  [[nodiscard]] auto is_wake_event() const noexcept -> bool
+  {
+    return mEvent.type == wake_event_type();
+  }
+
+  /**
+   * Stores an event that was obtained without using `poll()`.
+   *
+   * This is useful to inspect events that were obtained in bulk, e.g. using `event_batch`.
+   *
+   * \param event the event that will be stored.
+   */
+  void assign(const SDL_Event& event) noexcept { store(event); }
+
   /**
    * Indicates whether the currently stored event is of a particular type.
    *
@@ -221,6 +342,42 @@ class event_handler final {
 
   [[nodiscard]] auto data() const noexcept -> const SDL_Event* { return &mEvent; }
 
+  /// Returns a lightweight view of the current event.
+  [[nodiscard]] auto view() const noexcept -> event_view { return event_view {mEvent}; }
+
+  /**
+   * Returns the index of the current event representation.
+   *
+   * This can be used to dispatch events in constant time, by comparing the index with the
+   * values obtained from `index_of()`.
+   *
+   * \return the index of the current event representation.
+   */
+  [[nodiscard]] auto index() const noexcept -> usize { return mData.index(); }
+
+  /// Indicates whether an event type can be stored in an event handler.
+  template <typename T>
+  [[nodiscard]] constexpr static auto can_store() noexcept -> bool
+  {
+    return detail::tuple_type_index_v<T, data_type> != -1;
+  }
+
+  /// Returns the index used to represent a specific event type.
+  template <typename T>
+  [[nodiscard]] constexpr static auto index_of() noexcept -> usize
+  {
+    constexpr auto index = detail::tuple_type_index_v<T, data_type>;
+    static_assert(index != -1, "Invalid event type!");
+
+    return static_cast<usize>(index);
+  }
+
+  /// Returns the total amount of possible event representations.
+  [[nodiscard]] constexpr static auto index_count() noexcept -> usize
+  {
+    return std::variant_size_v<data_type>;
+  }
+
  private:
   // Behold, the beast!
   using data_type = std::variant<std::monostate,
@@ -0,0 +1,388 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_EVENTS_EVENT_RECORDING_HPP_
+#define CENTURION_EVENTS_EVENT_RECORDING_HPP_
+
+#include <SDL.h>
+
+#include <cstring>  // memcpy
+#include <string>   // string, to_string
+#include <utility>  // move
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../features.hpp"
+#include "../io/file.hpp"
+#include "../system/timer.hpp"
+#include "event_handler.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+namespace detail {
+
+inline constexpr uint8 recording_magic[4] {'C', 'E', 'N', 'E'};
+inline constexpr uint8 recording_version = 1;
+
+}  // namespace detail
+
+/// An event read from an event recording.
+struct recorded_event final {
+  SDL_Event event {};  ///< The recorded event.
+  u64ms time {};       ///< The time of the event, relative to the start of the recording.
+};
+
+/**
+ * Records events to a compact binary stream, so that they can be replayed later.
+ *
+ * Each event is stored as the time since the previous event, encoded as a variable-length
+ * integer, followed by the raw event data without trailing zero bytes. Pointers in events,
+ * such as dropped file names and user event data, are not recorded.
+ *
+ * Note, the recordings use the native representation of `SDL_Event`, so they should only be
+ * replayed on the same platform as they were recorded on.
+ *
+ * \see event_player
+ */
+class event_recorder final {
+ public:
+  /**
+   * Creates a recorder that writes to a file.
+   *
+   * \param output the file that the events will be written to, opened in binary write mode.
+   *
+   * \throws exception if the file is invalid or if the recording header cannot be written.
+   */
+  explicit event_recorder(file output) : mFile {std::move(output)}, mStart {ticks64()}
+  {
+    if (!mFile.is_ok()) {
+      throw exception {"Cannot record events to invalid file!"};
+    }
+
+    if (mFile.write(detail::recording_magic) != 4u ||
+        !mFile.write_byte(detail::recording_version) ||
+        !mFile.write_byte(static_cast<uint8>(sizeof(SDL_Event)))) {
+      throw exception {"Failed to write event recording header!"};
+    }
+  }
+
+  /**
+   * Polls the next event from an event handler, and records it.
+   *
+   * This is meant to replace calls to `event_handler::poll()` while recording.
+   *
+   * \param handler the event handler that will be polled.
+   *
+   * \return `true` if an event was polled; `false` otherwise.
+   */
+  auto poll(event_handler& handler) -> bool
+  {
+    if (handler.poll()) {
+      record(*handler.data());
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Records an event, using the current time as the event time.
+  auto record(const SDL_Event& event) -> result { return record(event, ticks64()); }
+
+  /**
+   * Records an event.
+   *
+   * \param event the event that will be recorded.
+   * \param time the time of the event, not earlier than any previously recorded event.
+   *
+   * \return `success` if the event was recorded; `failure` otherwise.
+   */
+  auto record(const SDL_Event& event, const u64ms time) -> result
+  {
+    const auto offset = (time > mStart) ? (time - mStart) : u64ms::zero();
+    const auto delta = (offset > mPrevious) ? (offset - mPrevious) : u64ms::zero();
+
+    auto copy = event;
+    clear_pointers(copy);
+
+    uint8 bytes[sizeof(SDL_Event)] {};
+    std::memcpy(bytes, &copy, sizeof(SDL_Event));
+
+    auto size = sizeof(SDL_Event);
+    while (size > 0 && bytes[size - 1] == 0) {
+      --size;
+    }
+
+    if (!write_varint(delta.count()) || !mFile.write_byte(static_cast<uint8>(size)) ||
+        mFile.write(bytes, size) != size) {
+      return failure;
+    }
+
+    mPrevious += delta;
+    ++mCount;
+
+    return success;
+  }
+
+  /// Returns the amount of recorded events.
+  [[nodiscard]] auto count() const noexcept -> usize { return mCount; }
+
+ private:
+  file mFile;
+  u64ms mStart {};
+  u64ms mPrevious {};
+  usize mCount {};
+
+  auto write_varint(uint64 value) noexcept -> result
+  {
+    do {
+      auto byte = static_cast<uint8>(value & 0x7Fu);
+      value >>= 7u;
+
+      if (value != 0) {
+        byte |= 0x80u;
+      }
+
+      if (!mFile.write_byte(byte)) {
+        return failure;
+      }
+    } while (value != 0);
+
+    return success;
+  }
+
+  static void clear_pointers(SDL_Event& event) noexcept
+  {
+    switch (event.type) {
+      case SDL_DROPFILE:
+      case SDL_DROPTEXT:
+        event.drop.file = nullptr;
+        break;
+
+      case SDL_SYSWMEVENT:
+        event.syswm.msg = nullptr;
+        break;
+
+      default:
+        if (event.type >= SDL_USEREVENT && event.type < SDL_LASTEVENT) {
+          event.user.data1 = nullptr;
+          event.user.data2 = nullptr;
+        }
+        break;
+    }
+  }
+};
+
+/**
+ * Replays events from a recording created by `event_recorder`.
+ *
+ * Replayed events are pushed to the SDL event queue, so they are handled exactly like regular
+ * events, either at their original timing using `update()`, or as fast as possible using
+ * `push_all()`.
+ *
+ * \see event_recorder
+ */
+class event_player final {
+ public:
+  /**
+   * Creates a player that reads from a file.
+   *
+   * \param input the file that will be read, opened in binary read mode.
+   *
+   * \throws exception if the file is invalid or isn't a compatible event recording.
+   */
+  explicit event_player(file input) : mFile {std::move(input)}
+  {
+    if (!mFile.is_ok()) {
+      throw exception {"Cannot replay events from invalid file!"};
+    }
+
+    uint8 header[6] {};
+    if (mFile.read_to(header) != 6u || header[0] != detail::recording_magic[0] ||
+        header[1] != detail::recording_magic[1] || header[2] != detail::recording_magic[2] ||
+        header[3] != detail::recording_magic[3]) {
+      throw exception {"Invalid event recording!"};
+    }
+
+    if (header[4] != detail::recording_version || header[5] != sizeof(SDL_Event)) {
+      throw exception {"Incompatible event recording!"};
+    }
+
+    mNext = read_event();
+  }
+
+  /**
+   * Pushes all events that are due according to their original timing.
+   *
+   * The playback starts when this function is first called.
+   *
+   * \return the amount of pushed events.
+   */
+  auto update() -> usize
+  {
+    const auto now = ticks64();
+    if (!mStart) {
+      mStart = now;
+    }
+
+    const auto elapsed = now - *mStart;
+
+    usize count {};
+    while (mNext && mNext->time <= elapsed) {
+      push(mNext->event);
+      mNext = read_event();
+      ++count;
+    }
+
+    return count;
+  }
+
+  /// Pushes all remaining events at once, ignoring their timing.
+  auto push_all() -> usize
+  {
+    usize count {};
+    while (mNext) {
+      push(mNext->event);
+      mNext = read_event();
+      ++count;
+    }
+
+    return count;
+  }
+
+  /**
+   * Reads the next event without pushing it.
+   *
+   * \return the next recorded event; an empty optional if there are no more events.
+   */
+  auto next() -> maybe<recorded_event>
+  {
+    auto result = mNext;
+    if (result) {
+      mNext = read_event();
+    }
+
+    return result;
+  }
+
+  /// Indicates whether all events have been replayed.
+  [[nodiscard]] auto done() const noexcept -> bool { return !mNext.has_value(); }
+
+ private:
+  file mFile;
+  maybe<recorded_event> mNext;
+  maybe<u64ms> mStart;
+  u64ms mTime {};
+
+  static void push(const SDL_Event& event) noexcept
+  {
+    auto copy = event;
+    SDL_PushEvent(&copy);
+  }
+
+  auto read_event() noexcept -> maybe<recorded_event>
+  {
+    const auto delta = read_varint();
+    if (!delta) {
+      return nothing;
+    }
+
+    uint8 size {};
+    if (mFile.read_to(&size, 1) != 1u || size > sizeof(SDL_Event)) {
+      return nothing;
+    }
+
+    uint8 bytes[sizeof(SDL_Event)] {};
+    if (mFile.read_to(bytes, size) != size) {
+      return nothing;
+    }
+
+    mTime += u64ms {*delta};
+
+    recorded_event result;
+    result.time = mTime;
+    std::memcpy(&result.event, bytes, sizeof(SDL_Event));
+
+    return result;
+  }
+
+  auto read_varint() noexcept -> maybe<uint64>
+  {
+    uint64 value {};
+
+    for (uint32 shift = 0; shift < 64u; shift += 7u) {
+      uint8 byte {};
+      if (mFile.read_to(&byte, 1) != 1u) {
+        return nothing;
+      }
+
+      value |= static_cast<uint64>(byte & 0x7Fu) << shift;
+
+      if ((byte & 0x80u) == 0) {
+        return value;
+      }
+    }
+
+    return nothing;
+  }
+};
+
+[[nodiscard]] inline auto to_string(const event_recorder& recorder) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("event_recorder(count: {})", recorder.count());
+#else
+  return "event_recorder(count: " + std::to_string(recorder.count()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const event_recorder& recorder) -> std::ostream&
+{
+  return stream << to_string(recorder);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+}  // namespace cen
+
+#endif  // CENTURION_EVENTS_EVENT_RECORDING_HPP_
@@ -25,8 +25,12 @@
 #ifndef CENTURION_EVENTS_EVENT_SINK_HPP_
 #define CENTURION_EVENTS_EVENT_SINK_HPP_
 
-#include <functional>   // function, bind, placeholders
+#include <algorithm>    // find_if, remove_if
+#include <functional>   // function
 #include <type_traits>  // decay_t, is_invocable_v, is_member_function_pointer_v
+#include <vector>       // vector
+
+#include "../common/primitives.hpp"
 
 namespace cen {
 
@@ -36,6 +40,15 @@ namespace cen {
  * \details This class is used in the interface of `event_dispatcher`, and isn't meant to be
  *          used directly in client code.
  *
+ * An event sink features a primary handler, set with `to()`, and any amount of additional
+ * listeners, added with `connect()`. Listeners are stored as lightweight delegates, i.e. a
+ * function pointer and an instance pointer, so invoking them never allocates and only
+ * requires a single indirect call.
+ *
+ * Listeners may connect and disconnect listeners while an event is being published, e.g. to
+ * implement one-shot listeners. Listeners connected during publishing are first invoked for
+ * the next event, and disconnected listeners are removed once publishing has finished.
+ *
  * \tparam E the event type.
  *
  * \see event_dispatcher
@@ -47,8 +60,26 @@ class event_sink final {
   using signature_type = void(const event_type&);  ///< Signature of handler.
   using function_type = std::function<signature_type>;
 
-  /// Resets the event sink, removing any associated handler.
-  void reset() noexcept { mFunction = nullptr; }
+  /// Identifies a listener connected with `connect()`.
+  struct connection final {
+    usize id {};  ///< The unique identifier of the listener.
+  };
+
+  /// Resets the event sink, removing the handler and all listeners.
+  void reset() noexcept
+  {
+    mFunction = nullptr;
+
+    if (mPublishing != 0) {
+      for (auto& l : mListeners) {
+        kill(l);
+      }
+    }
+    else {
+      mListeners.clear();
+      mDead = 0;
+    }
+  }
 
   /// Connects to a function object.
   template <typename T>
@@ -68,7 +99,8 @@ class event_sink final {
     static_assert(std::is_invocable_v<decltype(MemberFunc), Self*, const event_type&>,
                   "Member function must be invocable with subscribed event!");
 
-    to(std::bind(MemberFunc, self, std::placeholders::_1));
+    /* A lambda that only captures a pointer fits in the small buffer of std::function */
+    to([self](const event_type& event) { (self->*MemberFunc)(event); });
   }
 
   /// Connects to a free function.
@@ -78,12 +110,188 @@ class event_sink final {
     to(Function);
   }
 
+  /**
+   * Adds a listener that invokes a free function.
+   *
+   * \tparam Function the function that will be invoked.
+   *
+   * \return a connection that can be used to remove the listener.
+   */
+  template <auto Function>
+  auto connect() -> connection
+  {
+    static_assert(std::is_invocable_v<decltype(Function), const event_type&>,
+                  "Function must be invocable with subscribed event!");
+
+    return add_listener(nullptr,
+                        [](void*, const event_type& event) { Function(event); });
+  }
+
+  /**
+   * Adds a listener that invokes a member function.
+   *
+   * \tparam MemberFunc the member function that will be invoked.
+   *
+   * \param self the instance that the member function is invoked on, must outlive the
+   *        listener.
+   *
+   * \return a connection that can be used to remove the listener.
+   */
+  template <auto MemberFunc, typename Self>
+  auto connect(Self* self) -> connection
+  {
+    static_assert(std::is_member_function_pointer_v<decltype(MemberFunc)>);
+    static_assert(std::is_invocable_v<decltype(MemberFunc), Self*, const event_type&>,
+                  "Member function must be invocable with subscribed event!");
+
+    return add_listener(self, [](void* instance, const event_type& event) {
+      (static_cast<Self*>(instance)->*MemberFunc)(event);
+    });
+  }
+
+  /**
+   * Adds a listener that invokes a function object.
+   *
+   * Note, the function object is not copied, so it must outlive the listener.
+   *
+   * \param callable the function object that will be invoked.
+   *
+   * \return a connection that can be used to remove the listener.
+   */
+  template <typename T>
+  auto connect(T& callable) -> connection
+  {
+    static_assert(std::is_invocable_v<T&, const event_type&>,
+                  "Callable must be invocable with subscribed event!");
+
+    return add_listener(&callable, [](void* instance, const event_type& event) {
+      (*static_cast<T*>(instance))(event);
+    });
+  }
+
+  /**
+   * Removes a listener.
+   *
+   * \param conn the connection associated with the listener.
+   *
+   * \return `true` if a listener was removed; `false` otherwise.
+   */
+  auto disconnect(const connection conn) -> bool
+  {
+    const auto it =
+        std::find_if(mListeners.begin(), mListeners.end(), [conn](const listener& l) {
+          return l.id == conn.id && l.invoke;
+        });
+    if (it != mListeners.end()) {
+      /* Removing the listener while publishing would shift the listeners being iterated */
+      if (mPublishing != 0) {
+        kill(*it);
+      }
+      else {
+        mListeners.erase(it);
+      }
+
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Invokes the handler and all listeners with an event.
+   *
+   * \details The handler set with `to()` must not be replaced while it is being invoked.
+   */
+  void publish(const event_type& event)
+  {
+    if (mFunction) {
+      mFunction(event);
+    }
+
+    const publish_scope scope {*this};
+
+    /* Listeners connected by the invoked listeners are appended, and might reallocate */
+    const auto count = mListeners.size();
+    for (usize index = 0; index < count; ++index) {
+      const auto l = mListeners[index];
+      if (l.invoke) {
+        l.invoke(l.instance, event);
+      }
+    }
+  }
+
+  /// Returns the amount of listeners, excluding the handler set with `to()`.
+  [[nodiscard]] auto listener_count() const noexcept -> usize
+  {
+    return mListeners.size() - mDead;
+  }
+
+  /// Indicates whether there is neither a handler nor any listeners.
+  [[nodiscard]] auto empty() const noexcept -> bool
+  {
+    return !mFunction && listener_count() == 0;
+  }
+
   [[nodiscard]] auto function() -> function_type& { return mFunction; }
 
   [[nodiscard]] auto function() const -> const function_type& { return mFunction; }
 
  private:
+  using invoker = void (*)(void*, const event_type&);
+
+  struct listener final {
+    usize id {};
+    void* instance {};
+    invoker invoke {};
+  };
+
+  /// Removes disconnected listeners once the outermost call to `publish()` has finished.
+  class publish_scope final {
+   public:
+    explicit publish_scope(event_sink& sink) noexcept : mSink {sink} { ++mSink.mPublishing; }
+
+    ~publish_scope() noexcept
+    {
+      if (--mSink.mPublishing == 0 && mSink.mDead != 0) {
+        mSink.compact();
+      }
+    }
+
+   private:
+    event_sink& mSink;
+  };
+
   function_type mFunction;
+  std::vector<listener> mListeners;
+  usize mNextId {1};
+  usize mPublishing {};  ///< The depth of nested calls to `publish()`.
+  usize mDead {};        ///< The amount of listeners that await removal.
+
+  auto add_listener(void* instance, const invoker invoke) -> connection
+  {
+    const auto id = mNextId++;
+    mListeners.push_back({id, instance, invoke});
+    return connection {id};
+  }
+
+  /// Marks a listener as disconnected, without removing it.
+  void kill(listener& l) noexcept
+  {
+    if (l.invoke) {
+      l.invoke = nullptr;
+      ++mDead;
+    }
+  }
+
+  void compact() noexcept
+  {
+    mListeners.erase(std::remove_if(mListeners.begin(),
+                                    mListeners.end(),
+                                    [](const listener& l) { return !l.invoke; }),
+                     mListeners.end());
+    mDead = 0;
+  }
 };
 
 }  // namespace cen
@@ -0,0 +1,289 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_EVENTS_EVENT_STATISTICS_HPP_
+#define CENTURION_EVENTS_EVENT_STATISTICS_HPP_
+
+#include <SDL.h>
+
+#include <array>          // array
+#include <unordered_map>  // unordered_map
+
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/timer.hpp"
+#include "event_type.hpp"
+
+namespace cen {
+namespace detail {
+
+/// Returns the current time in milliseconds, using the same clock as event timestamps.
+[[nodiscard]] inline auto event_ticks() noexcept -> uint32
+{
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  /* Event timestamps are the lower 32 bits of the 64-bit tick counter */
+  return static_cast<uint32>(SDL_GetTicks64());
+#else
+  return SDL_GetTicks();
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+}
+
+}  // namespace detail
+
+/**
+ * Records the distribution of event latencies, i.e. the time between an event being
+ * generated by SDL and it being dispatched.
+ *
+ * Latencies are recorded in buckets with exponentially growing limits, where the first
+ * bucket covers [0, 1) ms, the second covers [1, 2) ms, the third covers [2, 4) ms, and so on.
+ * The last bucket covers all latencies that are too large for the other buckets.
+ */
+class latency_histogram final {
+ public:
+  inline constexpr static usize bucket_count = 12;
+
+  /// Records a single latency value.
+  void record(const u32ms latency) noexcept
+  {
+    const auto ms = latency.count();
+
+    ++mBuckets[bucket_of(ms)];
+    ++mCount;
+    mTotal += ms;
+    mMax = (detail::max)(mMax, ms);
+  }
+
+  void reset() noexcept { *this = latency_histogram {}; }
+
+  /// Returns the amount of recorded latencies in a bucket.
+  [[nodiscard]] auto bucket(const usize index) const -> usize { return mBuckets.at(index); }
+
+  /**
+   * Returns the exclusive upper limit of a bucket.
+   *
+   * \param index the index of the bucket.
+   *
+   * \return the upper limit; the maximum `u32ms` value for the last bucket.
+   */
+  [[nodiscard]] constexpr static auto bucket_limit(const usize index) noexcept -> u32ms
+  {
+    if (index + 1 >= bucket_count) {
+      return (u32ms::max)();
+    }
+    else {
+      return u32ms {uint32 {1} << index};
+    }
+  }
+
+  /// Returns the amount of recorded latencies.
+  [[nodiscard]] auto count() const noexcept -> usize { return mCount; }
+
+  /// Returns the largest recorded latency.
+  [[nodiscard]] auto max() const noexcept -> u32ms { return u32ms {mMax}; }
+
+  /// Returns the mean recorded latency, in milliseconds.
+  [[nodiscard]] auto mean() const noexcept -> double
+  {
+    if (mCount != 0) {
+      return static_cast<double>(mTotal) / static_cast<double>(mCount);
+    }
+    else {
+      return 0;
+    }
+  }
+
+  /**
+   * Returns an upper estimate of a latency percentile.
+   *
+   * \param fraction the percentile as a fraction in the range [0, 1], e.g. 0.99.
+   *
+   * \return the upper limit of the bucket that contains the percentile.
+   */
+  [[nodiscard]] auto percentile(const double fraction) const noexcept -> u32ms
+  {
+    const auto target = fraction * static_cast<double>(mCount);
+
+    usize accumulated = 0;
+    for (usize index = 0; index < bucket_count; ++index) {
+      accumulated += mBuckets[index];
+      if (mCount != 0 && static_cast<double>(accumulated) >= target) {
+        return (detail::min)(bucket_limit(index), max());
+      }
+    }
+
+    return max();
+  }
+
+ private:
+  std::array<usize, bucket_count> mBuckets {};
+  usize mCount {};
+  uint64 mTotal {};
+  uint32 mMax {};
+
+  [[nodiscard]] constexpr static auto bucket_of(uint32 ms) noexcept -> usize
+  {
+    usize index = 0;
+    while (ms != 0 && index + 1 < bucket_count) {
+      ms >>= 1u;
+      ++index;
+    }
+    return index;
+  }
+};
+
+/// Provides information about how many events were handled by each poll.
+struct poll_statistics final {
+  usize polls {};       ///< The amount of recorded polls.
+  usize events {};      ///< The total amount of events handled by all polls.
+  usize last_depth {};  ///< The amount of events handled by the latest poll.
+  usize max_depth {};   ///< The largest amount of events handled by a single poll.
+
+  /// Returns the mean amount of events handled by each poll.
+  [[nodiscard]] auto mean_depth() const noexcept -> double
+  {
+    if (polls != 0) {
+      return static_cast<double>(events) / static_cast<double>(polls);
+    }
+    else {
+      return 0;
+    }
+  }
+};
+
+/// Provides information about the time spent in the handlers of an event sink.
+struct handler_statistics final {
+  usize calls {};       ///< The amount of times the handlers were invoked.
+  uint64 ticks {};      ///< The total high-performance counter ticks spent in handlers.
+  uint64 max_ticks {};  ///< The largest amount of counter ticks spent by a single call.
+
+  void record(const uint64 elapsed) noexcept
+  {
+    ++calls;
+    ticks += elapsed;
+    max_ticks = (detail::max)(max_ticks, elapsed);
+  }
+
+  /// Returns the total time spent in the handlers.
+  [[nodiscard]] auto total_time() const noexcept -> seconds<double>
+  {
+    return seconds<double> {static_cast<double>(ticks) / static_cast<double>(frequency())};
+  }
+
+  /// Returns the longest time spent by a single call.
+  [[nodiscard]] auto max_time() const noexcept -> seconds<double>
+  {
+    return seconds<double> {static_cast<double>(max_ticks) / static_cast<double>(frequency())};
+  }
+
+  /// Returns the mean time spent by each call.
+  [[nodiscard]] auto mean_time() const noexcept -> seconds<double>
+  {
+    if (calls != 0) {
+      return total_time() / static_cast<double>(calls);
+    }
+    else {
+      return seconds<double> {0};
+    }
+  }
+};
+
+/**
+ * Collects latency and queue depth information about polled events.
+ *
+ * Event latencies are computed by comparing the timestamp of each event with the SDL tick
+ * counter at the time the event is recorded, so the latencies have millisecond precision.
+ *
+ * \see event_dispatcher::set_instrumented()
+ */
+class event_statistics final {
+ public:
+  /**
+   * Records the latency of an event.
+   *
+   * \param event the event that is about to be dispatched.
+   * \param now the current tick count, see `detail::event_ticks()`.
+   */
+  void record_event(const SDL_Event& event, const uint32 now)
+  {
+    /* Unsigned arithmetic handles the tick counter wrapping around */
+    const u32ms latency {now - event.common.timestamp};
+
+    mLatency.record(latency);
+    mTypeLatency[event_type {event.type}].record(latency);
+  }
+
+  /// Records the amount of events handled by a single poll.
+  void record_poll(const usize depth) noexcept
+  {
+    ++mPolls.polls;
+    mPolls.events += depth;
+    mPolls.last_depth = depth;
+    mPolls.max_depth = (detail::max)(mPolls.max_depth, depth);
+  }
+
+  void reset()
+  {
+    mLatency.reset();
+    mTypeLatency.clear();
+    mPolls = poll_statistics {};
+  }
+
+  /// Returns the latency distribution of all recorded events.
+  [[nodiscard]] auto latency() const noexcept -> const latency_histogram& { return mLatency; }
+
+  /**
+   * Returns the latency distribution of a specific type of event.
+   *
+   * \param type the event type to look for.
+   *
+   * \return the latency distribution; an empty optional if no such events were recorded.
+   */
+  [[nodiscard]] auto latency(const event_type type) const -> maybe<latency_histogram>
+  {
+    if (const auto iter = mTypeLatency.find(type); iter != mTypeLatency.end()) {
+      return iter->second;
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Returns the amount of recorded events of a specific type.
+  [[nodiscard]] auto count(const event_type type) const -> usize
+  {
+    const auto histogram = latency(type);
+    return histogram ? histogram->count() : 0;
+  }
+
+  [[nodiscard]] auto polls() const noexcept -> const poll_statistics& { return mPolls; }
+
+ private:
+  latency_histogram mLatency;
+  std::unordered_map<event_type, latency_histogram> mTypeLatency;
+  poll_statistics mPolls;
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_EVENTS_EVENT_STATISTICS_HPP_
@@ -27,7 +27,6 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 #include <utility>      // move
 
@@ -35,6 +34,12 @@
 #include "../common/primitives.hpp"
 #include "../common/utils.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class event_type : uint32 {
@@ -344,11 +349,15 @@ enum class event_type : uint32 {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const event_type type) -> std::ostream&
 {
   return stream << to_string(type);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif
@@ -0,0 +1,250 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_EVENTS_EVENT_VIEW_HPP_
+#define CENTURION_EVENTS_EVENT_VIEW_HPP_
+
+#include <SDL.h>
+
+#include <cstring>      // memcpy
+#include <type_traits>  // decay_t, is_same_v
+#include <utility>      // declval
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "audio_events.hpp"
+#include "controller_events.hpp"
+#include "event_type.hpp"
+#include "joystick_events.hpp"
+#include "misc_events.hpp"
+#include "mouse_events.hpp"
+#include "window_events.hpp"
+
+namespace cen {
+namespace detail {
+
+/// Indicates whether an SDL event type is represented by a specific SDL event structure.
+template <typename Sdl>
+[[nodiscard]] constexpr auto is_represented_by(const uint32 type) noexcept -> bool
+{
+  if constexpr (std::is_same_v<Sdl, SDL_QuitEvent>) {
+    return type == SDL_QUIT;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_WindowEvent>) {
+    return type == SDL_WINDOWEVENT;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_KeyboardEvent>) {
+    return type == SDL_KEYDOWN || type == SDL_KEYUP;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_TextEditingEvent>) {
+    return type == SDL_TEXTEDITING;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_TextInputEvent>) {
+    return type == SDL_TEXTINPUT;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_MouseMotionEvent>) {
+    return type == SDL_MOUSEMOTION;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_MouseButtonEvent>) {
+    return type == SDL_MOUSEBUTTONDOWN || type == SDL_MOUSEBUTTONUP;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_MouseWheelEvent>) {
+    return type == SDL_MOUSEWHEEL;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_JoyAxisEvent>) {
+    return type == SDL_JOYAXISMOTION;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_JoyBallEvent>) {
+    return type == SDL_JOYBALLMOTION;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_JoyHatEvent>) {
+    return type == SDL_JOYHATMOTION;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_JoyButtonEvent>) {
+    return type == SDL_JOYBUTTONDOWN || type == SDL_JOYBUTTONUP;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_JoyDeviceEvent>) {
+    return type == SDL_JOYDEVICEADDED || type == SDL_JOYDEVICEREMOVED;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_ControllerAxisEvent>) {
+    return type == SDL_CONTROLLERAXISMOTION;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_ControllerButtonEvent>) {
+    return type == SDL_CONTROLLERBUTTONDOWN || type == SDL_CONTROLLERBUTTONUP;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_ControllerDeviceEvent>) {
+    return type == SDL_CONTROLLERDEVICEADDED || type == SDL_CONTROLLERDEVICEREMOVED ||
+           type == SDL_CONTROLLERDEVICEREMAPPED;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_TouchFingerEvent>) {
+    return type == SDL_FINGERDOWN || type == SDL_FINGERUP || type == SDL_FINGERMOTION;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_DollarGestureEvent>) {
+    return type == SDL_DOLLARGESTURE || type == SDL_DOLLARRECORD;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_MultiGestureEvent>) {
+    return type == SDL_MULTIGESTURE;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_DropEvent>) {
+    return type == SDL_DROPFILE || type == SDL_DROPTEXT || type == SDL_DROPBEGIN ||
+           type == SDL_DROPCOMPLETE;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_AudioDeviceEvent>) {
+    return type == SDL_AUDIODEVICEADDED || type == SDL_AUDIODEVICEREMOVED;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_SensorEvent>) {
+    return type == SDL_SENSORUPDATE;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_UserEvent>) {
+    return type >= SDL_USEREVENT && type < SDL_LASTEVENT;
+  }
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+  else if constexpr (std::is_same_v<Sdl, SDL_DisplayEvent>) {
+    return type == SDL_DISPLAYEVENT;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_ControllerTouchpadEvent>) {
+    return type == SDL_CONTROLLERTOUCHPADDOWN || type == SDL_CONTROLLERTOUCHPADMOTION ||
+           type == SDL_CONTROLLERTOUCHPADUP;
+  }
+  else if constexpr (std::is_same_v<Sdl, SDL_ControllerSensorEvent>) {
+    return type == SDL_CONTROLLERSENSORUPDATE;
+  }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+#if SDL_VERSION_ATLEAST(2, 0, 22)
+  else if constexpr (std::is_same_v<Sdl, SDL_TextEditingExtEvent>) {
+    return type == SDL_TEXTEDITING_EXT;
+  }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 22)
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+  else if constexpr (std::is_same_v<Sdl, SDL_JoyBatteryEvent>) {
+    return type == SDL_JOYBATTERYUPDATED;
+  }
+#endif  // SDL_VERSION_ATLEAST(2, 24, 0)
+  else {
+    return false;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * A lightweight alternative to `event_handler` that only stores the raw SDL event.
+ *
+ * Unlike `event_handler`, which converts every event into its corresponding event class, an
+ * event view only creates event classes on demand. This makes it cheap to store, e.g. when
+ * keeping a history of the events in each frame.
+ *
+ * \see event_handler
+ */
+class event_view final {
+ public:
+  event_view() noexcept = default;
+
+  explicit event_view(const SDL_Event& event) noexcept : mEvent {event} {}
+
+  /// Indicates whether the event is represented by a specific event class.
+  template <typename T>
+  [[nodiscard]] auto is() const noexcept -> bool
+  {
+    return detail::is_represented_by<sdl_type<T>>(mEvent.type);
+  }
+
+  /// Indicates whether the event is of a specific type.
+  [[nodiscard]] auto is(const event_type type) const noexcept -> bool
+  {
+    if (type == event_type::user && is_user_event(this->type())) {
+      return true;
+    }
+    else {
+      return mEvent.type == to_underlying(type);
+    }
+  }
+
+  /**
+   * Attempts to create the event class that represents the event.
+   *
+   * \tparam T the event class, e.g. `window_event`.
+   *
+   * \return the event; an empty optional if the event is of another type.
+   */
+  template <typename T>
+  [[nodiscard]] auto try_get() const noexcept -> maybe<T>
+  {
+    if (is<T>()) {
+      return make<T>();
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /**
+   * Creates the event class that represents the event.
+   *
+   * \tparam T the event class, e.g. `window_event`.
+   *
+   * \return the event.
+   *
+   * \throws exception if the event is of another type.
+   */
+  template <typename T>
+  [[nodiscard]] auto get() const -> T
+  {
+    if (is<T>()) {
+      return make<T>();
+    }
+    else {
+      throw exception {"Invalid event type!"};
+    }
+  }
+
+  [[nodiscard]] auto type() const noexcept -> event_type { return event_type {mEvent.type}; }
+
+  [[nodiscard]] auto timestamp() const noexcept -> u32ms
+  {
+    return u32ms {mEvent.common.timestamp};
+  }
+
+  [[nodiscard]] auto data() const noexcept -> const SDL_Event& { return mEvent; }
+
+ private:
+  SDL_Event mEvent {};
+
+  template <typename T>
+  using sdl_type = std::decay_t<decltype(std::declval<const T&>().get())>;
+
+  template <typename T>
+  [[nodiscard]] auto make() const noexcept -> T
+  {
+    /* All SDL event structures are members of the SDL_Event union */
+    sdl_type<T> raw;
+    std::memcpy(&raw, &mEvent, sizeof raw);
+    return T {raw};
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_EVENTS_EVENT_VIEW_HPP_
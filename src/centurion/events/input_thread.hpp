@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_EVENTS_INPUT_THREAD_HPP_
+#define CENTURION_EVENTS_INPUT_THREAD_HPP_
+
+#include <SDL.h>
+
+#include <array>    // array
+#include <atomic>   // atomic
+#include <utility>  // forward
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/thread.hpp"
+#include "../system/timer.hpp"
+#include "event_channel.hpp"
+
+namespace cen {
+
+/// An event obtained by an input thread, along with the time at which it was obtained.
+struct timed_event final {
+  SDL_Event event {};  ///< The event.
+  uint64 counter {};   ///< The high-performance counter value when the event was obtained.
+};
+
+/**
+ * Obtains events on a dedicated thread at a fixed rate, independently of the frame rate.
+ *
+ * The thread periodically moves all events from the SDL event queue into a lock-free channel,
+ * stamping each event with the high-performance counter. The main thread can then consume
+ * the events at its own rate using `drain()`, e.g. once per simulation tick.
+ *
+ * Note, most platforms require events to be pumped on the thread that initialized the video
+ * subsystem, so by default the input thread doesn't pump events itself, the main thread has
+ * to keep calling `event_handler::update()`. Enable pumping on the input thread only on
+ * platforms that support it, e.g. when the video subsystem isn't used. Regardless, the main
+ * thread should not poll events itself while an input thread is running.
+ */
+class input_thread final {
+ public:
+  /**
+   * Creates and starts an input thread.
+   *
+   * \param interval the time between each time the event queue is emptied.
+   * \param capacity the maximum amount of buffered events.
+   * \param pump `true` if the input thread should pump events; `false` otherwise.
+   *
+   * \throws sdl_error if the thread cannot be created.
+   */
+  CENTURION_NODISCARD_CTOR explicit input_thread(const u32ms interval = u32ms {1},
+                                                 const usize capacity = 4096,
+                                                 const bool pump = false)
+      : mChannel {capacity}
+      , mInterval {interval}
+      , mPump {pump}
+      , mThread {&input_thread::run, "input_thread", this}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(input_thread)
+  CENTURION_DISABLE_MOVE(input_thread)
+
+  ~input_thread() noexcept { stop(); }
+
+  /// Stops and joins the input thread, this function has no effect if the thread is stopped.
+  void stop() noexcept
+  {
+    mRunning.store(false, std::memory_order_relaxed);
+    mThread.join();
+  }
+
+  /**
+   * Removes all available events, invoking a function object for each of them.
+   *
+   * \param func a function object invoked with a `timed_event&&` for each event.
+   *
+   * \return the amount of removed events.
+   */
+  template <typename Func>
+  auto drain(Func&& func) -> usize
+  {
+    return mChannel.drain(std::forward<Func>(func));
+  }
+
+  /// Indicates whether the input thread is running.
+  [[nodiscard]] auto is_running() const noexcept -> bool
+  {
+    return mRunning.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of events that were discarded because the channel was full.
+  [[nodiscard]] auto dropped() const noexcept -> usize
+  {
+    return mDropped.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto interval() const noexcept -> u32ms { return mInterval; }
+
+  [[nodiscard]] auto capacity() const noexcept -> usize { return mChannel.capacity(); }
+
+ private:
+  event_channel<timed_event> mChannel;
+  std::atomic<usize> mDropped {0};
+  std::atomic<bool> mRunning {true};
+  u32ms mInterval;
+  bool mPump {};
+  thread mThread;  ///< Must be the last member, so that it starts after initialization.
+
+  static int SDLCALL run(void* data)
+  {
+    auto* self = static_cast<input_thread*>(data);
+
+    std::array<SDL_Event, 64> buffer;
+    while (self->mRunning.load(std::memory_order_relaxed)) {
+      if (self->mPump) {
+        SDL_PumpEvents();
+      }
+
+      int count {};
+      do {
+        count = SDL_PeepEvents(buffer.data(),
+                               isize(buffer),
+                               SDL_GETEVENT,
+                               SDL_FIRSTEVENT,
+                               SDL_LASTEVENT);
+
+        const auto counter = now();
+        for (int index = 0; index < count; ++index) {
+          if (!self->mChannel.push({buffer[static_cast<usize>(index)], counter})) {
+            self->mDropped.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      } while (count == isize(buffer));
+
+      thread::sleep(self->mInterval);
+    }
+
+    return 0;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_EVENTS_INPUT_THREAD_HPP_
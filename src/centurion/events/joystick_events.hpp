@@ -27,7 +27,6 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
@@ -36,6 +35,12 @@
 #include "../input/joystick.hpp"
 #include "event_base.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class joy_hat_position : uint8 {
@@ -85,11 +90,15 @@ enum class joy_hat_position : uint8 {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const joy_hat_position position) -> std::ostream&
 {
   return stream << to_string(position);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 class joy_axis_event final : public event_base<SDL_JoyAxisEvent> {
  public:
   joy_axis_event() : event_base {event_type::joy_axis_motion} {}
@@ -28,7 +28,6 @@
 #include <SDL.h>
 
 #include <array>        // array
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 #include <type_traits>  // underlying_type_t
 #include <utility>      // move
@@ -44,6 +43,12 @@
 #include "../input/sensor.hpp"
 #include "event_base.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 class quit_event final : public event_base<SDL_QuitEvent> {
@@ -90,11 +95,15 @@ enum class display_event_id {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const display_event_id id) -> std::ostream&
 {
   return stream << to_string(id);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 class display_event final : public event_base<SDL_DisplayEvent> {
  public:
   display_event() : event_base {event_type::display} {}
@@ -27,7 +27,6 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
@@ -36,6 +35,12 @@
 #include "../input/mouse.hpp"
 #include "event_base.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class mouse_wheel_direction : uint32 {
@@ -57,11 +62,15 @@ enum class mouse_wheel_direction : uint32 {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const mouse_wheel_direction dir) -> std::ostream&
 {
   return stream << to_string(dir);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 class mouse_button_event final : public event_base<SDL_MouseButtonEvent> {
  public:
   mouse_button_event() : event_base {event_type::mouse_button_down} {}
@@ -27,13 +27,18 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 #include "../common/primitives.hpp"
 #include "event_base.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class window_event_id {
@@ -131,11 +136,15 @@ enum class window_event_id {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const window_event_id id) -> std::ostream&
 {
   return stream << to_string(id);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 class window_event final : public event_base<SDL_WindowEvent> {
  public:
   window_event() : event_base {event_type::window} {}
@@ -151,6 +160,8 @@ class window_event final : public event_base<SDL_WindowEvent> {
 
   void set_data2(const int32 value) noexcept { mEvent.data2 = value; }
 
+  void set_window_id(const uint32 id) noexcept { mEvent.windowID = id; }
+
   [[nodiscard]] auto event_id() const noexcept -> window_event_id
   {
     return static_cast<window_event_id>(mEvent.event);
@@ -159,6 +170,8 @@ class window_event final : public event_base<SDL_WindowEvent> {
   [[nodiscard]] auto data1() const noexcept -> int32 { return mEvent.data1; }
 
   [[nodiscard]] auto data2() const noexcept -> int32 { return mEvent.data2; }
+
+  [[nodiscard]] auto window_id() const noexcept -> uint32 { return mEvent.windowID; }
 };
 
 template <>
@@ -45,11 +45,12 @@
 #include <version>
 #endif  // __has_include(<version>)
 
-#ifdef __cpp_lib_format
+/// std::format support, which can be disabled by defining CENTURION_NO_FORMAT
+#if defined(__cpp_lib_format) && !defined(CENTURION_NO_FORMAT)
 #define CENTURION_HAS_FEATURE_FORMAT 1
 #else
 #define CENTURION_HAS_FEATURE_FORMAT 0
-#endif  // __cpp_lib_format
+#endif  // defined(__cpp_lib_format) && !defined(CENTURION_NO_FORMAT)
 
 #ifdef __cpp_lib_concepts
 #define CENTURION_HAS_FEATURE_CONCEPTS 1
@@ -57,6 +58,24 @@
 #define CENTURION_HAS_FEATURE_CONCEPTS 0
 #endif  // __cpp_lib_concepts
 
+#ifdef __cpp_lib_coroutine
+#define CENTURION_HAS_FEATURE_COROUTINES 1
+#else
+#define CENTURION_HAS_FEATURE_COROUTINES 0
+#endif  // __cpp_lib_coroutine
+
+#ifdef __cpp_lib_memory_resource
+#define CENTURION_HAS_FEATURE_MEMORY_RESOURCE 1
+#else
+#define CENTURION_HAS_FEATURE_MEMORY_RESOURCE 0
+#endif  // __cpp_lib_memory_resource
+
+#ifdef __cpp_lib_span
+#define CENTURION_HAS_FEATURE_SPAN 1
+#else
+#define CENTURION_HAS_FEATURE_SPAN 0
+#endif  // __cpp_lib_span
+
 #ifdef __cpp_lib_interpolate
 #define CENTURION_HAS_FEATURE_LERP 1
 #else
@@ -87,6 +106,15 @@
 #define CENTURION_HAS_FEATURE_CHARCONV 0
 #endif  // __cpp_lib_to_chars >= 201611L
 
+
 #endif  // __has_include
 
+/// Can we detect constant evaluation, with std::is_constant_evaluated() or a builtin?
+#if defined(__cpp_lib_is_constant_evaluated) || (defined(__GNUC__) && __GNUC__ >= 9) || \
+    (defined(__clang__) && __clang_major__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define CENTURION_HAS_FEATURE_IS_CONSTANT_EVALUATED 1
+#else
+#define CENTURION_HAS_FEATURE_IS_CONSTANT_EVALUATED 0
+#endif  // defined(__cpp_lib_is_constant_evaluated) || ...
+
 #endif  // CENTURION_FEATURES_HPP_
@@ -0,0 +1,78 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+module;
+
+#include "centurion/fonts.hpp"
+
+export module centurion:fonts;
+
+#ifndef CENTURION_NO_SDL_TTF
+
+export namespace cen {
+
+using cen::glyph_metrics;
+
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+using cen::font_dpi;
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+
+using cen::font;
+
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+using cen::ttf_set_script;
+using cen::ttf_set_direction;
+using cen::ttf_free_type_version;
+using cen::ttf_harf_buzz_version;
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+
+using cen::font_cache;
+
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+using cen::font_direction;
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+
+using cen::to_string;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::operator<<;
+
+#endif  // CENTURION_NO_IOSTREAM
+
+using cen::font_hint;
+
+using cen::frame_stats_overlay;
+
+using cen::text_layout;
+
+using cen::text_paragraph;
+
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+using cen::wrap_alignment;
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_TTF
@@ -26,4 +26,7 @@
 #include "fonts/font_cache.hpp"
 #include "fonts/font_direction.hpp"
 #include "fonts/font_hint.hpp"
+#include "fonts/frame_stats_overlay.hpp"
+#include "fonts/text_layout.hpp"
+#include "fonts/text_paragraph.hpp"
 #include "fonts/wrap_alignment.hpp"
\ No newline at end of file
@@ -28,14 +28,20 @@
 #ifndef CENTURION_NO_SDL_TTF
 
 #include <cassert>        // assert
-#include <ostream>        // ostream
 #include <string>         // string, to_string
 #include <string_view>    // string_view
 #include <unordered_map>  // unordered_map
+#include <utility>        // move
+#include <vector>         // vector
 
 #include "../../common/errors.hpp"
 #include "../../common/primitives.hpp"
+#include "../../common/utils.hpp"
+#include "../../concurrency/locks.hpp"
+#include "../../concurrency/shared_mutex.hpp"
 #include "../../features.hpp"
+#include "../../io/file.hpp"
+#include "../../io/mapped_file.hpp"
 #include "../font.hpp"
 #include "../font_cache.hpp"
 
@@ -45,6 +51,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen::experimental {
 
 /**
@@ -62,6 +74,14 @@ namespace cen::experimental {
  * easily extract the underlying font instances if you do not need the extra features provided
  * by the `font_cache` class.
  *
+ * Each font file is memory-mapped once, and every size of the font is opened from the shared
+ * mapping, so loading additional sizes doesn't read the file from disk again. The bundle can
+ * be used by several threads at once, lookups only take a shared lock. However, the returned
+ * font caches are not thread-safe, so each cache should only be used by one thread at a time.
+ *
+ * Pools can fall back to other pools for glyphs that are missing from their fonts, e.g. a
+ * Latin font can fall back to a CJK font and then to an emoji font, see `add_fallback()`.
+ *
  * \see font
  * \see font_cache
  */
@@ -70,31 +90,60 @@ class font_bundle final {
   using id_type = usize;
   using size_type = usize;
 
+  font_bundle() = default;
+
+  CENTURION_DISABLE_COPY(font_bundle)
+  CENTURION_DISABLE_MOVE(font_bundle)
+
+  /* Fallback fonts read from the mappings of other pools, so close all fonts first */
+  ~font_bundle() noexcept
+  {
+    for (auto& [id, pool] : mPools) {
+      pool.caches.clear();
+    }
+  }
+
   /**
    * Loads a font in a specific size.
    *
    * It is safe to load a font that has already been previously loaded. Furthermore, this
    * function has no effect if there is already a font of the specified size stored in the pool
-   * for the font family.
+   * for the font family. The font file is only mapped into memory when the first size of the
+   * font is loaded, if the file cannot be mapped, the font is loaded from the path instead.
+   * The fallback fonts of the pool are loaded in the same size, see `add_fallback()`.
    *
    * \param path the file path of the font.
    * \param size the size of the font.
    *
    * \return the identifier associated with the font.
+   *
+   * \throws ttf_error if the font cannot be loaded.
    */
   auto load_font(const char* path, const int size) -> id_type
   {
     assert(path);
+    scoped_lock lock {mMutex};
+
     if (const auto id = get_id(path)) {
-      mPools[*id].caches.try_emplace(size, font {path, size});
+      auto& pool = mPools.at(*id);
+      if (pool.caches.find(size) == pool.caches.end()) {
+        auto& cache = pool.caches.try_emplace(size, open_font(pool, size)).first->second;
+        for (const auto fallback : pool.fallbacks) {
+          cache.add_fallback(open_font(pool, mPools.at(fallback), size));
+        }
+      }
+
       return *id;
     }
     else {
-      const auto newId = mNextFontId;
+      /* The pool is only added once the font has been loaded */
+      font_pool pool;
+      pool.path = path;
+      pool.data = mapped_file {path};
+      pool.caches.try_emplace(size, open_font(pool, size));
 
-      auto& pack = mPools[newId];
-      pack.path = path;
-      pack.caches.try_emplace(size, font {path, size});
+      const auto newId = mNextFontId;
+      mPools.try_emplace(newId, std::move(pool));
 
       ++mNextFontId;
 
@@ -102,21 +151,58 @@ class font_bundle final {
     }
   }
 
+  /**
+   * Makes the fonts in a pool fall back to the fonts of another pool for missing glyphs.
+   *
+   * The fallback font is loaded in every size that has been loaded in the pool, and in the
+   * sizes that are loaded later, and is added to the corresponding font caches. Fallback pools
+   * are consulted in the order that they were added, see `font_cache::add_fallback()`.
+   *
+   * \param id the identifier of the pool that will use the fallback.
+   * \param fallback the identifier of the pool that provides the missing glyphs.
+   *
+   * \throws exception if either identifier is invalid, or if they are the same.
+   * \throws ttf_error if a fallback font cannot be loaded.
+   */
+  void add_fallback(const id_type id, const id_type fallback)
+  {
+    scoped_lock lock {mMutex};
+
+    const auto pool = mPools.find(id);
+    const auto source = mPools.find(fallback);
+
+    if (pool == mPools.end() || source == mPools.end()) {
+      throw exception {"Invalid font pool identifier!"};
+    }
+    else if (id == fallback) {
+      throw exception {"A font pool cannot fall back to itself!"};
+    }
+
+    for (auto& [size, cache] : pool->second.caches) {
+      cache.add_fallback(open_font(pool->second, source->second, size));
+    }
+
+    pool->second.fallbacks.push_back(fallback);
+  }
+
   /// Indicates whether there is a font pool associated with an ID.
   [[nodiscard]] auto contains(const id_type id) const -> bool
   {
+    shared_lock lock {mMutex};
     return mPools.find(id) != mPools.end();
   }
 
   /// Indicates whether there is a pool for the specified file path.
   [[nodiscard]] auto contains(const std::string_view path) const -> bool
   {
+    shared_lock lock {mMutex};
     return get_id(path).has_value();
   }
 
   /// Indicates whether there is a font of a specific size in a pool.
   [[nodiscard]] auto contains(const id_type id, const int size) const -> bool
   {
+    shared_lock lock {mMutex};
     if (const auto pack = mPools.find(id); pack != mPools.end()) {
       return pack->second.caches.find(size) != pack->second.caches.end();
     }
@@ -125,18 +211,66 @@ class font_bundle final {
     }
   }
 
-  /// Returns a previously loaded font of a particular size from a pool.
-  [[nodiscard]] auto at(const id_type id, const int size) -> font_cache&
+  /// Returns a previously loaded font of a particular size from a pool, if there is one.
+  [[nodiscard]] auto find(const id_type id, const int size) -> font_cache*
   {
+    shared_lock lock {mMutex};
     if (const auto pool = mPools.find(id); pool != mPools.end()) {
       auto& caches = pool->second.caches;
       if (const auto cache = caches.find(size); cache != caches.end()) {
-        return cache->second;
+        return &cache->second;
       }
-      else {
-        throw exception {"No loaded font of the requested size!"};
+    }
+
+    return nullptr;
+  }
+
+  [[nodiscard]] auto find(const id_type id, const int size) const -> const font_cache*
+  {
+    shared_lock lock {mMutex};
+    if (const auto pool = mPools.find(id); pool != mPools.end()) {
+      const auto& caches = pool->second.caches;
+      if (const auto cache = caches.find(size); cache != caches.end()) {
+        return &cache->second;
       }
     }
+
+    return nullptr;
+  }
+
+  /// Returns a previously loaded font of a particular size from a pool, if there is one.
+  [[nodiscard]] auto find_font(const id_type id, const int size) -> font*
+  {
+    auto* cache = find(id, size);
+    return cache ? &cache->get_font() : nullptr;
+  }
+
+  [[nodiscard]] auto find_font(const id_type id, const int size) const -> const font*
+  {
+    const auto* cache = find(id, size);
+    return cache ? &cache->get_font() : nullptr;
+  }
+
+  /**
+   * Returns a previously loaded font of a particular size from a pool.
+   *
+   * \param id the identifier of the pool to query.
+   * \param size the size of the desired font.
+   *
+   * \return the found font cache.
+   *
+   * \throws exception if the identifier is invalid or if there is no font of the size.
+   *
+   * \see `find()`
+   */
+  [[nodiscard]] auto at(const id_type id, const int size) -> font_cache&
+  {
+    if (auto* cache = find(id, size)) {
+      return *cache;
+    }
+    else if (contains(id)) {
+      throw exception {"No loaded font of the requested size!"};
+    }
     else {
       throw exception {"Invalid font pool identifier!"};
     }
@@ -144,7 +278,15 @@ class font_bundle final {
 
   [[nodiscard]] auto at(const id_type id, const int size) const -> const font_cache&
   {
-    return mPools.at(id).caches.at(size);
+    if (const auto* cache = find(id, size)) {
+      return *cache;
+    }
+    else if (contains(id)) {
+      throw exception {"No loaded font of the requested size!"};
+    }
+    else {
+      throw exception {"Invalid font pool identifier!"};
+    }
   }
 
   /**
@@ -171,6 +313,7 @@ class font_bundle final {
   /// Returns the amount of fonts that have been loaded (including different sizes).
   [[nodiscard]] auto font_count() const noexcept -> size_type
   {
+    shared_lock lock {mMutex};
     size_type count = 0;
 
     for (const auto& [id, pack] : mPools) {
@@ -181,17 +324,45 @@ class font_bundle final {
   }
 
   /// Returns the amount of loaded font pools, i.e. font faces irrespective of sizes.
-  [[nodiscard]] auto pool_count() const -> size_type { return mPools.size(); }
+  [[nodiscard]] auto pool_count() const -> size_type
+  {
+    shared_lock lock {mMutex};
+    return mPools.size();
+  }
 
  private:
+  /* The views must outlive the fonts, and the mapping must outlive the views */
   struct font_pool final {
     std::string path;
+    mapped_file data {nullptr};                  ///< The contents of the font file.
+    std::vector<file> views;                     ///< The streams read by the fonts.
     std::unordered_map<int, font_cache> caches;  ///< Size -> Cache
+    std::vector<id_type> fallbacks;              ///< The fallback pools, in order.
   };
 
+  mutable shared_mutex mMutex;  ///< Protects the pools, but not the font caches.
   std::unordered_map<id_type, font_pool> mPools;
   id_type mNextFontId {1};
 
+  /* Each font reads from its own view of the mapping, since views have a stream position */
+  [[nodiscard]] static auto open_font(font_pool& owner, font_pool& source, const int size)
+      -> font
+  {
+    if (auto view = source.data.view()) {
+      font loaded {view, size};
+      owner.views.push_back(std::move(view));
+      return loaded;
+    }
+    else {
+      return font {source.path, size};
+    }
+  }
+
+  [[nodiscard]] static auto open_font(font_pool& pool, const int size) -> font
+  {
+    return open_font(pool, pool, size);
+  }
+
   [[nodiscard]] auto get_id(const std::string_view path) const -> maybe<id_type>
   {
     for (const auto& [id, pack] : mPools) {
@@ -218,11 +389,15 @@ class font_bundle final {
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const font_bundle& bundle) -> std::ostream&
 {
   return stream << to_string(bundle);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen::experimental
 
 #endif  // CENTURION_NO_SDL_TTF
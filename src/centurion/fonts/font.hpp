@@ -30,7 +30,6 @@
 #include <SDL_ttf.h>
 
 #include <cassert>  // assert
-#include <ostream>  // ostream
 #include <string>   // string, to_string
 
 #include "../common/errors.hpp"
@@ -53,6 +52,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 struct glyph_metrics final {
@@ -470,8 +475,8 @@ class font final {
     }
   }
 
-  [[nodiscard]] auto measure_unicode(const unicode_string& str, const int width) const noexcept
-      -> maybe<measure_result>
+  [[nodiscard]] auto measure_unicode(const unicode_string_view str,
+                                     const int width) const noexcept -> maybe<measure_result>
   {
     measure_result result;
     if (TTF_MeasureUNICODE(get(), str.data(), width, &result.extent, &result.count) < 0) {
@@ -496,7 +501,7 @@ class font final {
     return surface {TTF_RenderUTF8_Blended(get(), str, fg.get())};
   }
 
-  [[nodiscard]] auto render_blended_uni(const unicode_string& str, const color& fg) const
+  [[nodiscard]] auto render_blended_uni(const unicode_string_view str, const color& fg) const
       -> surface
   {
     return surface {TTF_RenderUNICODE_Blended(get(), str.data(), fg.get())};
@@ -514,7 +519,7 @@ class font final {
     return surface {TTF_RenderUTF8_Solid(get(), str, fg.get())};
   }
 
-  [[nodiscard]] auto render_solid_uni(const unicode_string& str, const color& fg) const
+  [[nodiscard]] auto render_solid_uni(const unicode_string_view str, const color& fg) const
       -> surface
   {
     return surface {TTF_RenderUNICODE_Solid(get(), str.data(), fg.get())};
@@ -535,7 +540,7 @@ class font final {
     return surface {TTF_RenderUTF8_Shaded(get(), str, fg.get(), bg.get())};
   }
 
-  [[nodiscard]] auto render_shaded_uni(const unicode_string& str,
+  [[nodiscard]] auto render_shaded_uni(const unicode_string_view str,
                                        const color& fg,
                                        const color& bg) const -> surface
   {
@@ -558,7 +563,7 @@ class font final {
     return surface {TTF_RenderUTF8_Blended_Wrapped(get(), str, fg.get(), wrap)};
   }
 
-  [[nodiscard]] auto render_blended_wrapped_uni(const unicode_string& str,
+  [[nodiscard]] auto render_blended_wrapped_uni(const unicode_string_view str,
                                                 const color& fg,
                                                 const uint32 wrap) const -> surface
   {
@@ -583,7 +588,7 @@ class font final {
     return surface {TTF_RenderUTF8_Solid_Wrapped(get(), str, fg.get(), wrap)};
   }
 
-  [[nodiscard]] auto render_solid_wrapped_uni(const unicode_string& str,
+  [[nodiscard]] auto render_solid_wrapped_uni(const unicode_string_view str,
                                               const color& fg,
                                               const uint32 wrap) const -> surface
   {
@@ -608,7 +613,7 @@ class font final {
     return surface {TTF_RenderUTF8_Shaded_Wrapped(get(), str, fg.get(), bg.get(), wrap)};
   }
 
-  [[nodiscard]] auto render_shaded_wrapped_uni(const unicode_string& str,
+  [[nodiscard]] auto render_shaded_wrapped_uni(const unicode_string_view str,
                                                const color& fg,
                                                const color& bg,
                                                const uint32 wrap) const -> surface
@@ -658,11 +663,15 @@ class font final {
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const font& font) -> std::ostream&
 {
   return stream << to_string(font);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 #if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
 
 [[deprecated("Use font::set_script instead")]] inline auto ttf_set_script(
@@ -29,14 +29,41 @@
 
 #include <SDL_ttf.h>
 
-#include <ostream>        // ostream
+#include <cassert>        // assert
+#include <chrono>         // duration
+#include <cmath>          // sqrt
+#include <cstring>        // memcmp
+#include <deque>          // deque
+#include <iterator>       // prev
+#include <list>           // list
+#include <memory>         // shared_ptr, make_shared
 #include <string>         // string
+#include <string_view>    // string_view
 #include <unordered_map>  // unordered_map
 #include <utility>        // move
+#include <vector>         // vector
 
+#include "../common/errors.hpp"
+#include "../common/hash.hpp"
 #include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/mutex.hpp"
+#include "../concurrency/spin_lock.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "../detail/utf8.hpp"
 #include "../features.hpp"
+#include "../io/asset_pack.hpp"
+#include "../io/file.hpp"
+#include "../io/file_mode.hpp"
+#include "../io/mapped_file.hpp"
+#include "../system/cache_manager.hpp"
+#include "../system/profiler.hpp"
+#include "../system/timer.hpp"
 #include "../video/renderer.hpp"
+#include "../video/resource_pool.hpp"
 #include "../video/texture.hpp"
 #include "font.hpp"
 
@@ -46,7 +73,39 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
+namespace detail {
+
+/* All integers in a saved atlas are stored in little-endian byte order. A saved atlas consists
+   of a header, the glyph records, and finally the pixels of each page as tightly packed RGBA32
+   rows.
+
+   The style stores the font style flags, and font_atlas_sdf_style if the glyphs are signed
+   distance fields. The effect colors are packed as R, G, B and A bytes.
+
+   Header (84 bytes): magic[4], version (u32), font hash (u64), font size (u32), style (u32),
+                      hinting (u32), outline (u32), page width (u32), page height (u32),
+                      page count (u32), glyph count (u32), current page (u32),
+                      cursor x (u32), cursor y (u32), shelf height (u32),
+                      effect outline (u32), outline color (u32), shadow x and y (i32),
+                      shadow color (u32).
+   Glyph record (44 bytes): glyph (u16), padding (u16), page (u32), source x, y, width and
+                            height (i32), min x, min y, max x, max y and advance (i32).
+*/
+inline constexpr char font_atlas_magic[4] = {'C', 'F', 'N', 'T'};
+inline constexpr uint32 font_atlas_version = 2;
+inline constexpr usize font_atlas_header_size = 84;
+inline constexpr usize font_atlas_glyph_size = 44;
+inline constexpr uint32 font_atlas_max_page_size = 16'384;
+inline constexpr uint32 font_atlas_sdf_style = 0x100;
+
+}  // namespace detail
 
 /**
  * Provides efficient font rendering.
@@ -60,7 +119,39 @@ namespace cen {
  * Furthermore, it is possible to cache rendered strings and associate them with integer
  * identifiers. In contrast with the first approach, this will result in accurate kerning. The
  * only problem is that it is hard to know the exact strings you will render at compile-time.
- * Use this option if you know that you are going to render some specific string a lot.
+ * Use this option if you know that you are going to render some specific string a lot. Strings
+ * can also be looked up by their content with `get_or_render()`, which renders and caches
+ * strings on demand, so that repeated dynamic strings such as scores are only rendered once.
+ *
+ * Glyphs can optionally be packed into a few large atlas textures instead of being stored as
+ * individual textures, see `enable_atlas()`. This means that all glyphs in a string are
+ * rendered from the same texture, which allows the renderer to batch the glyphs.
+ *
+ * The amount of cached glyphs and strings can be bounded by budgets, see
+ * `set_glyph_budget()` and `set_string_budget()`. When a budget is exceeded, the least
+ * recently used entries are evicted. Evicted glyphs are simply skipped when rendering, and
+ * evicted string identifiers are no longer valid, so check `find_string()` and store the
+ * string again if necessary. Lookups update the recency of entries and the cache statistics,
+ * so even const access to a cache must be synchronized if it is shared between threads.
+ *
+ * The cache can also be registered with a `cache_manager`, which evicts individual glyph
+ * textures and cached strings in least recently used order, along with other caches. Atlas
+ * pages are never evicted by the manager.
+ *
+ * The atlas can be saved to a file with `save_atlas()`, and loaded in later runs with
+ * `load_atlas()`, which avoids rasterizing the same glyphs every time an application starts.
+ *
+ * Instead of storing glyphs up front, missing glyphs can be stored when they are first
+ * rendered, see `set_lazy()`. Alternatively, missing glyphs can be rasterized on a thread
+ * pool and uploaded in batches with `upload_glyphs()`, see `enable_async()`. Glyphs that are
+ * being rasterized are rendered as a placeholder, see `set_placeholder()`.
+ *
+ * Outlines and drop shadows can be baked into the stored glyphs, see `set_effects()`, so that
+ * styled text is rendered with a single quad per glyph.
+ *
+ * Glyphs that are missing from the font can be provided by a chain of fallback fonts, e.g.
+ * Latin, CJK and emoji fonts, see `add_fallback()`. The glyphs of all fonts share the same
+ * atlas, so mixed-script strings are still batched.
  *
  * Note, instances of this class are initially empty, i.e. they hold no cached glyphs or
  * strings. It is up to you to explicitly specify what you want to cache.
@@ -78,6 +169,38 @@ class font_cache final {
     glyph_metrics metrics;  ///< The metrics associate with the glyph.
   };
 
+  struct atlas_glyph final {
+    usize page {};          ///< The index of the atlas page that holds the glyph.
+    irect source;           ///< The region of the glyph in the atlas page.
+    glyph_metrics metrics;  ///< The metrics associate with the glyph.
+  };
+
+  /// Limits the size of a cache, a zero limit means that there is no limit.
+  struct cache_budget final {
+    usize max_count {};  ///< The maximum amount of cached entries.
+    usize max_bytes {};  ///< The maximum amount of texture memory, in bytes.
+  };
+
+  struct cache_stats final {
+    usize hits {};       ///< The amount of lookups that found a cached entry.
+    usize misses {};     ///< The amount of lookups that did not find a cached entry.
+    usize evictions {};  ///< The amount of entries that have been evicted.
+  };
+
+  /// Describes the outline and drop shadow that are baked into stored glyphs.
+  struct text_effects final {
+    int outline {};                      ///< The outline width, zero disables the outline.
+    color outline_color {0, 0, 0};       ///< The color of the outline.
+    ipoint shadow_offset;                ///< The shadow offset, zero disables the shadow.
+    color shadow_color {0, 0, 0, 0x80};  ///< The color of the shadow.
+  };
+
+  /// The font rendering functions that can be used to render cached strings.
+  enum class render_mode : uint8 {
+    solid,   ///< Fast rendering without anti-aliasing, see `font::render_solid_utf8()`.
+    blended  ///< Anti-aliased rendering, see `font::render_blended_utf8()`.
+  };
+
   /**
    * Creates a font cache based on the font at the specified file path.
    *
@@ -90,220 +213,2262 @@ class font_cache final {
 
   explicit font_cache(font&& font) noexcept : mFont {std::move(font)} {}
 
-  /// Renders a glyph, returning the x-coordinate for the next glyph.
-  template <typename T>
-  auto render_glyph(basic_renderer<T>& renderer, const unicode_t glyph, const ipoint& position)
-      -> int
+  /**
+   * Makes subsequently stored glyphs get packed into shared atlas textures.
+   *
+   * Glyphs that have already been cached as individual textures are not affected. The page
+   * size can't be changed once glyphs have been packed into the atlas, since the existing
+   * pages and the packing cursor depend on it.
+   *
+   * \param pageSize the size of each atlas page texture.
+   *
+   * \return `success` if the atlas was enabled; `failure` if the atlas already has pages of
+   *         another size.
+   */
+  auto enable_atlas(const iarea& pageSize = {1024, 1024}) noexcept -> result
   {
-    if (const auto* data = find_glyph(glyph)) {
-      const auto& [texture, metrics] = *data;
-      const auto outline = mFont.outline();
+    if (!mAtlasPages.empty() && pageSize != mAtlasPageSize) {
+      return failure;
+    }
 
-      /* SDL_ttf handles the y-axis alignment */
-      const auto x = position.x() + metrics.min_x - outline;
-      const auto y = position.y() - outline;
+    mAtlasPageSize = pageSize;
+    mUseAtlas = true;
 
-      renderer.render(texture, ipoint {x, y});
+    return success;
+  }
 
-      return x + metrics.advance;
+  /// Returns the size of the atlas page textures.
+  [[nodiscard]] auto atlas_page_size() const noexcept -> iarea { return mAtlasPageSize; }
+
+  /// Indicates whether stored glyphs are packed into atlas textures.
+  [[nodiscard]] auto is_atlas_enabled() const noexcept -> bool { return mUseAtlas; }
+
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+
+  /**
+   * Makes subsequently stored glyphs get rasterized as signed distance fields in the atlas.
+   *
+   * Distance field glyphs stored at the base size of the font can be rendered at any size
+   * with `render_text_scaled()`, so a single cache can replace caches for several font
+   * sizes. The renderer API provides no custom shaders, so the atlas pages are sampled with
+   * linear filtering and the distance ramp is blended as alpha, which results in slightly
+   * soft edges. This function should be called before any glyphs are stored.
+   *
+   * \param pageSize the size of each atlas page texture.
+   *
+   * \return `success` if distance field rendering was enabled; `failure` if the atlas already
+   *         has pages of another size, or if the font doesn't support distance fields.
+   *
+   * \see render_text_scaled
+   */
+  auto enable_sdf(const iarea& pageSize = {1024, 1024}) -> result
+  {
+    if (!mAtlasPages.empty() && pageSize != mAtlasPageSize) {
+      return failure;
     }
-    else {
-      return position.x();
+
+    if (!mFont.set_sdf_enabled(true)) {
+      return failure;
+    }
+
+    if (mAsync) {
+      scoped_lock lock {mAsync->font_lock};
+      if (!mAsync->worker_font.set_sdf_enabled(true)) {
+        return failure;
+      }
+    }
+
+    for (auto& fallback : mFallbacks) {
+      if (!fallback.instance.set_sdf_enabled(true)) {
+        return failure;
+      }
+    }
+
+    mAtlasPageSize = pageSize;
+    mUseAtlas = true;
+    mSdf = true;
+
+    for (auto& page : mAtlasPages) {
+      page.set_scale_mode(scale_mode::linear);
     }
+
+    return success;
   }
 
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+
+  /// Indicates whether stored glyphs are rasterized as signed distance fields.
+  [[nodiscard]] auto is_sdf_enabled() const noexcept -> bool { return mSdf; }
+
   /**
-   * Renders a string as a series of glyphs.
+   * Sets the outline and drop shadow that are baked into subsequently stored glyphs.
    *
-   * You can provide null-characters in the string to indicate line breaks. This function will
-   * not output rendered text with accurate kerning.
+   * Each glyph is rasterized once, and the shadow and outline layers are composited beneath
+   * it in software, so styled text is rendered with a single quad per glyph, and in a single
+   * call per atlas page with `render_text_batched()`. Unlike `font::set_outline()`, the
+   * outline doesn't invalidate the glyph cache of SDL_ttf, and it can have its own color.
+   * The layers extend beyond the glyph metrics, so the pen advances as if there were no
+   * effects. The effects are ignored for signed distance field glyphs.
    *
-   * \tparam String the type of the string-like object, storing Unicode glyphs.
+   * This function should be called before any glyphs are stored, since the cached glyphs are
+   * not re-rasterized.
    *
-   * \param renderer the renderer that will be used.
-   * \param str the source of the Unicode glyphs.
-   * \param position the position of the rendered string.
+   * \param effects the effects that will be baked into stored glyphs.
    */
-  template <typename T, typename String>
-  void render_text(basic_renderer<T>& renderer, const String& str, ipoint position)
+  void set_effects(const text_effects& effects) noexcept
   {
-    const auto originalX = position.x();
-    const auto lineSkip = mFont.line_skip();
+    assert(effects.outline >= 0);
 
-    for (const unicode_t glyph : str) {
-      if (glyph == '\n') {
-        position.set_x(originalX);
-        position.set_y(position.y() + lineSkip);
-      }
-      else {
-        const auto x = render_glyph(renderer, glyph, position);
-        position.set_x(x);
-      }
+    mEffects = effects;
+    mHasEffects = (effects.outline > 0 && effects.outline_color.alpha() != 0) ||
+                  (effects.shadow_offset != ipoint {} && effects.shadow_color.alpha() != 0);
+
+    if (mHasEffects) {
+      const auto [left, top, right, bottom] = effect_margins(effects);
+      mEffectMargin = ipoint {left, top};
+    }
+    else {
+      mEffectMargin = ipoint {};
     }
   }
 
+  /// Returns the effects that are baked into stored glyphs.
+  [[nodiscard]] auto effects() const noexcept -> const text_effects& { return mEffects; }
+
+  /// Indicates whether any outline or shadow is baked into stored glyphs.
+  [[nodiscard]] auto has_effects() const noexcept -> bool { return mHasEffects; }
+
   /**
-   * Caches a rendered string as a texture.
+   * Makes missing glyphs get stored when they are rendered.
    *
-   * Whilst this function takes any surface as input, it is intended to be used in
-   * collaboration with the text rendering functions provided by the font class. As a result,
-   * the related functions use "string" in their names, e.g. find_string and has_string.
+   * This removes the need to store whole character ranges in advance. Glyphs that are not
+   * provided by the font are still skipped. If asynchronous rasterization is enabled, missing
+   * glyphs are requested from the workers instead, regardless of this setting.
    *
-   * \param renderer the associated renderer.
-   * \param surface the surface obtained through one of the `font` rendering functions.
+   * \param lazy `true` if missing glyphs should be stored on demand; `false` otherwise.
+   */
+  void set_lazy(const bool lazy) noexcept { mLazy = lazy; }
+
+  /// Indicates whether missing glyphs are stored when they are rendered.
+  [[nodiscard]] auto is_lazy() const noexcept -> bool { return mLazy; }
+
+  /**
+   * Makes missing glyphs get rasterized on a thread pool.
    *
-   * \return the identifier assigned to the cached string.
+   * SDL_ttf fonts cannot be used by several threads at once, so the workers use a separate
+   * font instance, which should be loaded from the same file with the same size. The style,
+   * outline and hinting of the cached font are copied to the worker font. The workers share
+   * the worker font, so rasterization is serialized, but it never blocks the render thread.
    *
-   * \see find_string
-   * \see has_string
-   * \see get_string
+   * Missing glyphs are requested when they are rendered, or explicitly with
+   * `prefetch_glyph()`. Rasterized glyphs become available once `upload_glyphs()` has been
+   * called on the render thread. Until then, they are rendered as the placeholder, if any.
+   *
+   * \param pool the thread pool used to rasterize glyphs, must outlive the cache.
+   * \param workerFont the font that is used by the workers.
+   *
+   * \see upload_glyphs
+   * \see set_placeholder
    */
-  template <typename T>
-  auto store(basic_renderer<T>& renderer, const surface& surface) -> id_type
+  void enable_async(thread_pool& pool, font&& workerFont)
   {
-    const auto id = mNextStringId;
-    assert(mStrings.find(id) == mStrings.end());
+    workerFont.set_bold(mFont.is_bold());
+    workerFont.set_italic(mFont.is_italic());
+    workerFont.set_underlined(mFont.is_underlined());
+    workerFont.set_strikethrough(mFont.is_strikethrough());
+    workerFont.set_outline(mFont.outline());
+    workerFont.set_hinting(mFont.hinting());
 
-    mStrings.try_emplace(id, renderer.make_texture(surface));
-    ++mNextStringId;
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    if (mSdf && !workerFont.set_sdf_enabled(true)) {
+      throw ttf_error {};
+    }
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 0, 18)
 
-    return id;
+    mPool = &pool;
+    mAsync = std::make_shared<async_state>(std::move(workerFont));
   }
 
-  /// Returns the cached string texture for an identifier, if there is one.
-  [[nodiscard]] auto find_string(const id_type id) const -> const texture*
+  /// Indicates whether missing glyphs are rasterized on a thread pool.
+  [[nodiscard]] auto is_async() const noexcept -> bool { return mAsync != nullptr; }
+
+  /**
+   * Sets the glyph that is rendered in place of glyphs that are being rasterized.
+   *
+   * The placeholder must be cached to be rendered. The pen is always advanced as if the
+   * missing glyph was rendered, so that text doesn't move once the glyph is available.
+   *
+   * \param glyph the placeholder glyph, e.g. `0xFFFD`; nothing if no placeholder is used.
+   */
+  void set_placeholder(const maybe<unicode_t> glyph) noexcept { mPlaceholder = glyph; }
+
+  /// Returns the glyph that is rendered in place of glyphs that are being rasterized, if any.
+  [[nodiscard]] auto placeholder() const noexcept -> const maybe<unicode_t>&
   {
-    if (const auto iter = mStrings.find(id); iter != mStrings.end()) {
-      return &iter->second;
+    return mPlaceholder;
+  }
+
+  /**
+   * Adds a font that provides the glyphs that are missing from the cached font.
+   *
+   * Fallback fonts are consulted in the order that they were added. Each glyph is resolved to
+   * a font the first time it is needed, and the result is stored in a flat table, so
+   * subsequent lookups don't query SDL_ttf. Glyphs from fallback fonts are stored in the same
+   * way as other glyphs, and are aligned to the baseline of the cached font.
+   *
+   * The style, outline and hinting of the cached font are copied to the fallback font, so
+   * they should be set before any fallback fonts are added. Note, the workers used by
+   * asynchronous rasterization only have access to the cached font, so glyphs from fallback
+   * fonts are always stored immediately.
+   *
+   * \param fallback the font that is consulted for glyphs missing from the previous fonts.
+   *
+   * \throws exception if the maximum amount of fallback fonts has been reached.
+   * \throws ttf_error if distance field rendering cannot be enabled for the fallback font.
+   *
+   * \see resolve_font
+   */
+  void add_fallback(font&& fallback)
+  {
+    if (mFallbacks.size() >= max_fallbacks) {
+      throw exception {"Too many font cache fallback fonts!"};
     }
-    else {
-      return nullptr;
+
+    fallback.set_bold(mFont.is_bold());
+    fallback.set_italic(mFont.is_italic());
+    fallback.set_underlined(mFont.is_underlined());
+    fallback.set_strikethrough(mFont.is_strikethrough());
+    fallback.set_outline(mFont.outline());
+    fallback.set_hinting(mFont.hinting());
+
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    if (mSdf && !fallback.set_sdf_enabled(true)) {
+      throw ttf_error {};
     }
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+
+    const auto offset = mFont.ascent() - fallback.ascent();
+    mFallbacks.push_back(fallback_font {std::move(fallback), offset});
+
+    /* Glyphs that were missing from the previous fonts may be provided by the new font */
+    mGlyphFonts.assign(usize {0x10000}, unresolved_font);
   }
 
-  /// Indicates whether there is a cached string associated with a specific identifier.
-  [[nodiscard]] auto has_string(const id_type id) const -> bool
+  /// Returns the amount of fallback fonts.
+  [[nodiscard]] auto fallback_count() const noexcept -> usize { return mFallbacks.size(); }
+
+  /// Returns the fallback font with the specified index, in the order they were added.
+  [[nodiscard]] auto get_fallback(const usize index) const -> const font&
   {
-    return find_string(id) != nullptr;
+    return mFallbacks.at(index).instance;
   }
 
-  /// Returns the cached rendered string associated with an identifier.
-  [[nodiscard]] auto get_string(const id_type id) const -> const texture&
+  /**
+   * Returns the font that provides a glyph.
+   *
+   * \param glyph the glyph that will be resolved.
+   *
+   * \return the cached font or a fallback font; a null pointer if no font provides the glyph.
+   */
+  [[nodiscard]] auto resolve_font(const unicode_t glyph) const -> const font*
   {
-    if (const auto* ptr = find_string(id)) {
-      return *ptr;
+    const auto index = resolve_font_index(glyph);
+    if (index == missing_font) {
+      return nullptr;
+    }
+    else if (index == primary_font) {
+      return &mFont;
     }
     else {
-      throw exception {"Invalid font cache string identifier!"};
+      return &mFallbacks[index - fallback_font_index].instance;
     }
   }
 
   /**
-   * Renders a glyph to a texture and caches it.
+   * Makes sure that a glyph becomes available, without rendering it.
    *
-   * This function has no effect if the glyph has already been cached, or if the glyph is not
-   * provided by the underlying font.
+   * The glyph is rasterized asynchronously if that is enabled, and stored immediately
+   * otherwise. This function has no effect if the glyph has already been cached or
+   * requested, or if the glyph is not provided by any font.
    *
    * \param renderer the renderer that will be used.
    * \param glyph the glyph that will be cached.
    */
   template <typename T>
-  void store_glyph(basic_renderer<T>& renderer, const unicode_t glyph)
+  void prefetch_glyph(basic_renderer<T>& renderer, const unicode_t glyph)
   {
-    if (has_glyph(glyph) || !mFont.is_glyph_provided(glyph)) {
-      return;
+    if (mAsync) {
+      request_glyph(renderer, glyph);
+    }
+    else {
+      store_glyph(renderer, glyph);
     }
+  }
 
-    glyph_data data {make_glyph_texture(renderer, glyph), mFont.get_metrics(glyph).value()};
-    mGlyphs.try_emplace(glyph, std::move(data));
+  /// Prefetches the glyphs in the range [begin, end), see `prefetch_glyph()`.
+  template <typename T>
+  void prefetch_glyphs(basic_renderer<T>& renderer, const unicode_t begin, const unicode_t end)
+  {
+    for (auto glyph = begin; glyph < end; ++glyph) {
+      prefetch_glyph(renderer, glyph);
+    }
   }
 
   /**
-   * Renders a range of glyphs to individual textures and caches them.
+   * Stores glyphs that have been rasterized by the workers, until a time budget is exhausted.
    *
-   * The glyphs that will be cached are in the range [begin, end).
+   * This function should be called regularly on the render thread, e.g. once per frame, when
+   * asynchronous rasterization is enabled. At least one glyph is uploaded if any is ready,
+   * regardless of the budget.
    *
-   * \param renderer the renderer that will be used.
-   * \param begin the first glyph that will be cached.
-   * \param end the range terminator (will not be cached).
+   * \param renderer the renderer used to create the glyph textures.
+   * \param budget the maximum amount of time to spend uploading glyphs.
    *
-   * \see https://unicode-table.com/en/blocks/
+   * \return the amount of glyphs that were processed.
    */
   template <typename T>
-  void store_glyphs(basic_renderer<T>& renderer, const unicode_t begin, const unicode_t end)
+  auto upload_glyphs(basic_renderer<T>& renderer, const millis<double> budget) -> size_type
   {
-    for (auto glyph = begin; glyph < end; ++glyph) {
-      store_glyph(renderer, glyph);
+    if (!mAsync) {
+      return 0;
     }
-  }
 
-  /// Stores the glyphs provided in the basic latin character range.
-  template <typename T>
-  void store_basic_latin_glyphs(basic_renderer<T>& renderer)
-  {
-    /* https://unicode-table.com/en/blocks/basic-latin/ */
-    store_glyphs(renderer, 0x20, 0x7F);
+    const auto start = now();
+    const auto limit =
+        static_cast<double>(frequency()) * std::chrono::duration<double>(budget).count();
+
+    size_type count {};
+    while (auto result = take_rasterized_glyph()) {
+      mPendingGlyphs.erase(result->glyph);
+
+      if (result->image && !has_glyph(result->glyph)) {
+        store_rendered_glyph(renderer, result->glyph, *result->image);
+        enforce_glyph_budget();
+      }
+
+      ++count;
+
+      if (static_cast<double>(now() - start) >= limit) {
+        break;
+      }
+    }
+
+    return count;
   }
 
-  /// Stores the glyphs provided in the Latin-1 supplement character range.
-  template <typename T>
-  void store_latin1_supplement_glyphs(basic_renderer<T>& renderer)
+  /// Returns the amount of glyphs that have been requested but not yet uploaded.
+  [[nodiscard]] auto pending_glyph_count() const noexcept -> size_type
   {
-    /* https://unicode-table.com/en/blocks/latin-1-supplement/ */
-    store_glyphs(renderer, 0xA0, 0xFF + 0x1);
+    return mPendingGlyphs.size();
   }
 
-  /// Stores the glyphs provided in the Latin-1 character range.
+  /**
+   * Renders a glyph, returning the x-coordinate for the next glyph.
+   *
+   * A missing glyph is stored or requested first if the cache is lazy or asynchronous.
+   */
   template <typename T>
-  void store_latin1_glyphs(basic_renderer<T>& renderer)
+  auto render_glyph(basic_renderer<T>& renderer, const unicode_t glyph, const ipoint& position)
+      -> int
   {
-    store_basic_latin_glyphs(renderer);
-    store_latin1_supplement_glyphs(renderer);
+    prepare_glyph(renderer, glyph);
+    return draw_glyph(renderer, glyph, position);
   }
 
-  /// Returns the cached information associated with a glyph, if there is any.
-  [[nodiscard]] auto find_glyph(const unicode_t glyph) const -> const glyph_data*
+  /**
+   * Renders a string as a series of glyphs.
+   *
+   * You can provide null-characters in the string to indicate line breaks. This function will
+   * not output rendered text with accurate kerning.
+   *
+   * \tparam String the type of the string-like object, storing Unicode glyphs.
+   *
+   * \param renderer the renderer that will be used.
+   * \param str the source of the Unicode glyphs.
+   * \param position the position of the rendered string.
+   */
+  template <typename T, typename String>
+  void render_text(basic_renderer<T>& renderer, const String& str, ipoint position)
   {
-    if (const auto it = mGlyphs.find(glyph); it != mGlyphs.end()) {
-      return &it->second;
-    }
-    else {
-      return nullptr;
+    CENTURION_PROFILE_SCOPE("font_cache::render_text");
+
+    const auto originalX = position.x();
+    const auto lineSkip = mFont.line_skip();
+
+    for (const unicode_t glyph : str) {
+      if (glyph == '\n') {
+        position.set_x(originalX);
+        position.set_y(position.y() + lineSkip);
+      }
+      else {
+        const auto x = render_glyph(renderer, glyph, position);
+        position.set_x(x);
+      }
     }
   }
 
-  /// Indicates whether a glyph has been cached.
-  [[nodiscard]] auto has_glyph(const unicode_t glyph) const noexcept -> bool
-  {
-    return find_glyph(glyph) != nullptr;
-  }
+#if SDL_VERSION_ATLEAST(2, 0, 18)
 
-  /// Returns the previously cached information associated with a glyph.
-  [[nodiscard]] auto get_glyph(const unicode_t glyph) const -> const glyph_data&
+  /**
+   * Renders a string using a single geometry call per used atlas page.
+   *
+   * This is the batched equivalent of `render_text()`. Glyphs that are not stored in the atlas
+   * are rendered individually, see `render_glyph()`. Missing glyphs are stored or requested
+   * before any glyph is rendered if the cache is lazy or asynchronous. The vertex buffers are
+   * reused between calls, so this function does not allocate once the buffers are large
+   * enough.
+   *
+   * \tparam String the type of the string-like object, storing Unicode glyphs.
+   *
+   * \param renderer the renderer that will be used.
+   * \param str the source of the Unicode glyphs.
+   * \param position the position of the rendered string.
+   *
+   * \see enable_atlas
+   */
+  template <typename T, typename String>
+  void render_text_batched(basic_renderer<T>& renderer, const String& str, ipoint position)
   {
-    if (const auto* ptr = find_glyph(glyph)) {
-      return *ptr;
+    CENTURION_PROFILE_SCOPE("font_cache::render_text_batched");
+
+    /* Storing glyphs may recycle atlas pages, so it must not happen while batching */
+    if (mLazy || mAsync) {
+      for (const unicode_t glyph : str) {
+        if (glyph != '\n') {
+          prepare_glyph(renderer, glyph);
+        }
+      }
     }
-    else {
-      throw exception {"Invalid font cache glyph!"};
+
+    mAtlasVertices.resize(mAtlasPages.size());
+    for (auto& vertices : mAtlasVertices) {
+      vertices.clear();
     }
+
+    const auto originalX = position.x();
+    const auto lineSkip = mFont.line_skip();
+    const auto outline = mFont.outline();
+
+    for (const unicode_t glyph : str) {
+      if (glyph == '\n') {
+        position.set_x(originalX);
+        position.set_y(position.y() + lineSkip);
+      }
+      else if (const auto* entry = lookup_atlas_glyph(glyph)) {
+        mark_glyph_used(*entry);
+
+        const auto* data = &entry->data;
+
+        /* SDL_ttf handles the y-axis alignment within each font */
+        const auto x = position.x() + data->metrics.min_x - outline;
+        const auto y = position.y() - outline + baseline_offset(glyph);
+
+        const fpoint quadPosition {static_cast<float>(x - mEffectMargin.x()),
+                                   static_cast<float>(y - mEffectMargin.y())};
+        add_glyph_quad(mAtlasVertices[data->page], *data, quadPosition);
+        position.set_x(x + data->metrics.advance);
+      }
+      else {
+        position.set_x(draw_glyph(renderer, glyph, position));
+      }
+    }
+
+    render_atlas_vertices(renderer);
+  }
+
+  /**
+   * Renders a string at an arbitrary scale of the font size.
+   *
+   * This function works like `render_text_batched()`, but the glyph quads, advances and line
+   * skip are multiplied by the scale. This is intended to be used with distance field glyphs,
+   * see `enable_sdf()`, since ordinary glyphs become blurry or jagged when they are scaled.
+   * Glyphs that are not in the atlas are rendered individually with the same scale.
+   *
+   * \tparam String the type of the string-like object, storing Unicode glyphs.
+   *
+   * \param renderer the renderer that will be used.
+   * \param str the source of the Unicode glyphs.
+   * \param position the position of the rendered string.
+   * \param scale the factor applied to the size of the font, e.g. `2` for twice the size.
+   *
+   * \see enable_sdf
+   */
+  template <typename T, typename String>
+  void render_text_scaled(basic_renderer<T>& renderer,
+                          const String& str,
+                          const fpoint& position,
+                          const float scale)
+  {
+    if (mLazy || mAsync) {
+      for (const unicode_t glyph : str) {
+        if (glyph != '\n') {
+          prepare_glyph(renderer, glyph);
+        }
+      }
+    }
+
+    mAtlasVertices.resize(mAtlasPages.size());
+    for (auto& vertices : mAtlasVertices) {
+      vertices.clear();
+    }
+
+    const auto lineSkip = static_cast<float>(mFont.line_skip()) * scale;
+    const auto outline = static_cast<float>(mFont.outline()) * scale;
+
+    auto x = position.x();
+    auto y = position.y();
+
+    for (const unicode_t glyph : str) {
+      if (glyph == '\n') {
+        x = position.x();
+        y += lineSkip;
+      }
+      else if (const auto* atlasEntry = lookup_atlas_glyph(glyph)) {
+        mark_glyph_used(*atlasEntry);
+
+        const auto& data = atlasEntry->data;
+        const auto quadX = x + (static_cast<float>(data.metrics.min_x) * scale) - outline;
+        const auto quadY = y - outline + (static_cast<float>(baseline_offset(glyph)) * scale);
+        const fpoint quadPosition {quadX - (static_cast<float>(mEffectMargin.x()) * scale),
+                                   quadY - (static_cast<float>(mEffectMargin.y()) * scale)};
+
+        add_glyph_quad(mAtlasVertices[data.page], data, quadPosition, scale);
+        x = quadX + (static_cast<float>(data.metrics.advance) * scale);
+      }
+      else if (const auto* entry = lookup_glyph(glyph)) {
+        mark_glyph_used(*entry);
+
+        const auto& [texture, metrics] = entry->data;
+        const auto glyphX = x + (static_cast<float>(metrics.min_x) * scale) - outline;
+        const auto glyphY = y - outline + (static_cast<float>(baseline_offset(glyph)) * scale);
+        const frect destination {glyphX - (static_cast<float>(mEffectMargin.x()) * scale),
+                                 glyphY - (static_cast<float>(mEffectMargin.y()) * scale),
+                                 static_cast<float>(texture.width()) * scale,
+                                 static_cast<float>(texture.height()) * scale};
+
+        renderer.render(texture, destination);
+        x = glyphX + (static_cast<float>(metrics.advance) * scale);
+      }
+      else {
+        ++mGlyphStats.misses;
+
+        /* Keep the layout stable whilst the glyph is being rasterized */
+        if (const auto pending = mPendingGlyphs.find(glyph); pending != mPendingGlyphs.end()) {
+          x += static_cast<float>(pending->second.advance) * scale;
+        }
+      }
+    }
+
+    render_atlas_vertices(renderer);
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+  /**
+   * Caches a rendered string as a texture.
+   *
+   * Whilst this function takes any surface as input, it is intended to be used in
+   * collaboration with the text rendering functions provided by the font class. As a result,
+   * the related functions use "string" in their names, e.g. find_string and has_string.
+   *
+   * The least recently used strings are evicted if the string budget is exceeded, but the
+   * stored string itself is never evicted by this function.
+   *
+   * \param renderer the associated renderer.
+   * \param surface the surface obtained through one of the `font` rendering functions.
+   *
+   * \return the identifier assigned to the cached string.
+   *
+   * \see find_string
+   * \see has_string
+   * \see get_string
+   */
+  template <typename T>
+  auto store(basic_renderer<T>& renderer, const surface& surface) -> id_type
+  {
+    const auto id = mNextStringId;
+    assert(mStrings.find(id) == mStrings.end());
+
+    auto text = renderer.make_texture(surface);
+    const auto bytes = texture_bytes(text);
+
+    mStringLru.push_front(id);
+    mStrings.try_emplace(id, string_entry {std::move(text), mStringLru.begin(), bytes});
+    mStringBytes += bytes;
+    ++mNextStringId;
+
+    enforce_string_budget();
+
+    return id;
+  }
+
+  /// Returns the cached string texture for an identifier, if there is one.
+  [[nodiscard]] auto find_string(const id_type id) const -> const texture*
+  {
+    if (const auto iter = mStrings.find(id); iter != mStrings.end()) {
+      mStringLru.splice(mStringLru.begin(), mStringLru, iter->second.position);
+      iter->second.last_use = cache_manager::tick();
+      ++mStringStats.hits;
+      return &iter->second.text;
+    }
+    else {
+      ++mStringStats.misses;
+      return nullptr;
+    }
+  }
+
+  /// Indicates whether there is a cached string associated with a specific identifier.
+  [[nodiscard]] auto has_string(const id_type id) const -> bool
+  {
+    return mStrings.find(id) != mStrings.end();
+  }
+
+  /// Returns the cached rendered string associated with an identifier.
+  [[nodiscard]] auto get_string(const id_type id) const -> const texture&
+  {
+    if (const auto* ptr = find_string(id)) {
+      return *ptr;
+    }
+    else {
+      throw exception {"Invalid font cache string identifier!"};
+    }
+  }
+
+  /**
+   * Returns a cached texture of a string, rendering and caching the string if necessary.
+   *
+   * Strings are looked up by their content, color and render mode, along with the current
+   * style and outline of the font, so callers don't need to keep track of string identifiers.
+   * Rendering the same string again, e.g. an unchanged score or timer, reuses the cached
+   * texture. The cached strings are subject to the string budget like any other stored
+   * string, so the returned texture may be evicted by subsequent calls that store strings.
+   *
+   * \param renderer the associated renderer.
+   * \param str the UTF-8 encoded string that will be rendered, cannot be empty.
+   * \param fg the color of the rendered text.
+   * \param mode the font rendering function that is used.
+   *
+   * \return the cached texture of the string.
+   *
+   * \throws exception if the string cannot be rendered.
+   *
+   * \see set_string_budget
+   */
+  template <typename T>
+  auto get_or_render(basic_renderer<T>& renderer,
+                     const char* str,
+                     const color& fg,
+                     const render_mode mode = render_mode::blended) -> const texture&
+  {
+    assert(str);
+
+    make_string_key(str, fg, mode);
+    if (const auto iter = mStringIds.find(mStringKey); iter != mStringIds.end()) {
+      return get_string(iter->second);
+    }
+
+    ++mStringStats.misses;
+
+    const auto image = (mode == render_mode::solid) ? mFont.render_solid_utf8(str, fg)
+                                                    : mFont.render_blended_utf8(str, fg);
+    const auto id = store(renderer, image);
+
+    auto& entry = mStrings.at(id);
+    entry.key = mStringKey;
+    mStringIds.try_emplace(entry.key, id);
+
+    return entry.text;
+  }
+
+  template <typename T>
+  auto get_or_render(basic_renderer<T>& renderer,
+                     const std::string& str,
+                     const color& fg,
+                     const render_mode mode = render_mode::blended) -> const texture&
+  {
+    return get_or_render(renderer, str.c_str(), fg, mode);
+  }
+
+  /**
+   * Returns the size of a UTF-8 encoded string, as it would be rendered by the font.
+   *
+   * The width is the sum of the glyph advances on the widest line, and the height covers all
+   * lines, which are separated by newlines. Kerning is applied if it is enabled for the font,
+   * which matches strings rendered by SDL_ttf, e.g. by `get_or_render()`. The advance of each
+   * glyph, and the kerning of each pair of glyphs, is only queried from SDL_ttf the first time
+   * it is needed, so measuring strings over and over doesn't call into SDL_ttf. The measured
+   * metrics are discarded if the style, hinting or outline of the font changes.
+   *
+   * \param str the UTF-8 encoded string that will be measured.
+   *
+   * \return the size of the rendered string.
+   *
+   * \see calc_wrapped_size
+   */
+  [[nodiscard]] auto calc_size(const std::string_view str) const -> iarea
+  {
+    return measure(str, 0);
+  }
+
+  /**
+   * Returns the size of a UTF-8 encoded string, when it is wrapped to a maximum width.
+   *
+   * Lines are broken at the last space that fits on a line, or before the glyph that doesn't
+   * fit if a line has no spaces. The spaces at a line break don't count towards the width.
+   *
+   * \param str the UTF-8 encoded string that will be measured.
+   * \param wrapWidth the maximum width of a line, in pixels; zero disables wrapping.
+   *
+   * \return the size of the wrapped string.
+   *
+   * \see calc_size
+   */
+  [[nodiscard]] auto calc_wrapped_size(const std::string_view str, const int wrapWidth) const
+      -> iarea
+  {
+    assert(wrapWidth >= 0);
+    return measure(str, wrapWidth);
+  }
+
+  /**
+   * Renders a glyph to a texture and caches it.
+   *
+   * The glyph is packed into an atlas page if the atlas has been enabled, and is rendered by
+   * the first font that provides it, see `add_fallback()`. This function has no effect if the
+   * glyph has already been cached, or if the glyph is not provided by any font. The least
+   * recently used glyphs are evicted if the glyph budget is exceeded, but the stored glyph
+   * itself is never evicted by this function.
+   *
+   * \param renderer the renderer that will be used.
+   * \param glyph the glyph that will be cached.
+   */
+  template <typename T>
+  void store_glyph(basic_renderer<T>& renderer, const unicode_t glyph)
+  {
+    if (has_glyph(glyph)) {
+      return;
+    }
+
+    const auto* source = resolve_font(glyph);
+    if (!source) {
+      return;
+    }
+
+    const auto image = source->render_blended_glyph(glyph, renderer.get_color());
+    if (mHasEffects && !mSdf) {
+      store_rendered_glyph(renderer, glyph, bake_effects(image, mEffects));
+    }
+    else {
+      store_rendered_glyph(renderer, glyph, image);
+    }
+    enforce_glyph_budget();
+  }
+
+  /**
+   * Renders a range of glyphs to individual textures and caches them.
+   *
+   * The glyphs that will be cached are in the range [begin, end).
+   *
+   * \param renderer the renderer that will be used.
+   * \param begin the first glyph that will be cached.
+   * \param end the range terminator (will not be cached).
+   *
+   * \see https://unicode-table.com/en/blocks/
+   */
+  template <typename T>
+  void store_glyphs(basic_renderer<T>& renderer, const unicode_t begin, const unicode_t end)
+  {
+    for (auto glyph = begin; glyph < end; ++glyph) {
+      store_glyph(renderer, glyph);
+    }
+  }
+
+  /// Stores the glyphs provided in the basic latin character range.
+  template <typename T>
+  void store_basic_latin_glyphs(basic_renderer<T>& renderer)
+  {
+    /* https://unicode-table.com/en/blocks/basic-latin/ */
+    store_glyphs(renderer, 0x20, 0x7F);
+  }
+
+  /// Stores the glyphs provided in the Latin-1 supplement character range.
+  template <typename T>
+  void store_latin1_supplement_glyphs(basic_renderer<T>& renderer)
+  {
+    /* https://unicode-table.com/en/blocks/latin-1-supplement/ */
+    store_glyphs(renderer, 0xA0, 0xFF + 0x1);
+  }
+
+  /// Stores the glyphs provided in the Latin-1 character range.
+  template <typename T>
+  void store_latin1_glyphs(basic_renderer<T>& renderer)
+  {
+    store_basic_latin_glyphs(renderer);
+    store_latin1_supplement_glyphs(renderer);
+  }
+
+  /// Returns the cached information associated with a glyph, if there is any.
+  [[nodiscard]] auto find_glyph(const unicode_t glyph) const -> const glyph_data*
+  {
+    if (const auto* entry = lookup_glyph(glyph)) {
+      mark_glyph_used(*entry);
+      return &entry->data;
+    }
+    else {
+      ++mGlyphStats.misses;
+      return nullptr;
+    }
+  }
+
+  /// Returns the atlas information associated with a glyph, if there is any.
+  [[nodiscard]] auto find_atlas_glyph(const unicode_t glyph) const -> const atlas_glyph*
+  {
+    if (const auto* entry = lookup_atlas_glyph(glyph)) {
+      mark_glyph_used(*entry);
+      return &entry->data;
+    }
+    else {
+      ++mGlyphStats.misses;
+      return nullptr;
+    }
+  }
+
+  /// Returns the metrics of a cached glyph, if there is one.
+  [[nodiscard]] auto find_metrics(const unicode_t glyph) const -> const glyph_metrics*
+  {
+    if (const auto* entry = lookup_atlas_glyph(glyph)) {
+      mark_glyph_used(*entry);
+      return &entry->data.metrics;
+    }
+    else if (const auto* entry = lookup_glyph(glyph)) {
+      mark_glyph_used(*entry);
+      return &entry->data.metrics;
+    }
+    else {
+      ++mGlyphStats.misses;
+      return nullptr;
+    }
+  }
+
+  /// Indicates whether a glyph has been cached, either as a texture or in the atlas.
+  [[nodiscard]] auto has_glyph(const unicode_t glyph) const noexcept -> bool
+  {
+    return lookup_glyph(glyph) != nullptr || lookup_atlas_glyph(glyph) != nullptr;
+  }
+
+  /// Returns the previously cached information associated with a glyph.
+  [[nodiscard]] auto get_glyph(const unicode_t glyph) const -> const glyph_data&
+  {
+    if (const auto* ptr = find_glyph(glyph)) {
+      return *ptr;
+    }
+    else {
+      throw exception {"Invalid font cache glyph!"};
+    }
+  }
+
+  /// Returns the atlas page texture with the specified index.
+  [[nodiscard]] auto atlas_page(const usize index) const -> const texture&
+  {
+    return mAtlasPages.at(index);
+  }
+
+  /// Returns the atlas page texture with the specified index, if there is one.
+  [[nodiscard]] auto find_atlas_page(const usize index) const noexcept -> const texture*
+  {
+    return (index < mAtlasPages.size()) ? &mAtlasPages[index] : nullptr;
+  }
+
+  /// Returns the amount of allocated atlas pages.
+  [[nodiscard]] auto atlas_page_count() const noexcept -> usize { return mAtlasPages.size(); }
+
+  /**
+   * Writes the atlas pages and the metrics of the atlas glyphs to a file.
+   *
+   * The file is keyed by the font hash, the size, style, hinting and outline of the font,
+   * and the effects, so that `load_atlas()` rejects files that were created for other fonts.
+   * Glyphs that
+   * are cached as individual textures are not saved. The pages are read back by rendering
+   * them to a temporary target texture, so the renderer must support render targets. The atlas
+   * may contain glyphs from fallback fonts, which aren't covered by the key, so combine the
+   * hashes of the fallback font files if they can change between runs.
+   *
+   * \param renderer the renderer that was used to create the atlas pages.
+   * \param path the path of the created file.
+   * \param fontHash a hash of the font file contents, see `hash_font_file()`.
+   *
+   * \return `success` if the atlas was written; `failure` otherwise.
+   *
+   * \throws sdl_error if the atlas pages cannot be read back.
+   *
+   * \see load_atlas
+   */
+  template <typename T>
+  auto save_atlas(basic_renderer<T>& renderer, const char* path, const uint64 fontHash)
+      -> result
+  {
+    file output {path, file_mode::wb};
+    if (!output) {
+      return failure;
+    }
+
+    const auto& font = mFont.get();
+    bool ok = output.write(detail::font_atlas_magic) == sizeof detail::font_atlas_magic;
+    ok = ok && output.write_native_as_little_endian(detail::font_atlas_version);
+    ok = ok && output.write_native_as_little_endian(fontHash);
+    ok = ok && write_u32(output, mFont.size());
+    ok = ok && output.write_native_as_little_endian(atlas_style());
+    ok = ok && write_u32(output, TTF_GetFontHinting(font));
+    ok = ok && write_u32(output, mFont.outline());
+    ok = ok && write_u32(output, mAtlasPageSize.width);
+    ok = ok && write_u32(output, mAtlasPageSize.height);
+    ok = ok && write_u32(output, mAtlasPages.size());
+    ok = ok && write_u32(output, mAtlasGlyphs.size());
+    ok = ok && write_u32(output, mAtlasPage);
+    ok = ok && write_u32(output, mAtlasCursor.x());
+    ok = ok && write_u32(output, mAtlasCursor.y());
+    ok = ok && write_u32(output, mAtlasShelfHeight);
+    ok = ok && write_u32(output, baked_effects().outline);
+    ok = ok && output.write_native_as_little_endian(pack_color(baked_effects().outline_color));
+    ok = ok && write_u32(output, baked_effects().shadow_offset.x());
+    ok = ok && write_u32(output, baked_effects().shadow_offset.y());
+    ok = ok && output.write_native_as_little_endian(pack_color(baked_effects().shadow_color));
+
+    for (const auto& [glyph, entry] : mAtlasGlyphs) {
+      const auto& [page, source, metrics] = entry.data;
+      ok = ok && output.write_native_as_little_endian(glyph);
+      ok = ok && output.write_native_as_little_endian(uint16 {0});
+      ok = ok && write_u32(output, page);
+      ok = ok && write_u32(output, source.x());
+      ok = ok && write_u32(output, source.y());
+      ok = ok && write_u32(output, source.width());
+      ok = ok && write_u32(output, source.height());
+      ok = ok && write_u32(output, metrics.min_x);
+      ok = ok && write_u32(output, metrics.min_y);
+      ok = ok && write_u32(output, metrics.max_x);
+      ok = ok && write_u32(output, metrics.max_y);
+      ok = ok && write_u32(output, metrics.advance);
+    }
+
+    const auto rowSize = static_cast<usize>(mAtlasPageSize.width) * sizeof(uint32);
+    for (usize index = 0; ok && index < mAtlasPages.size(); ++index) {
+      auto pixels = read_atlas_page(renderer, mAtlasPages[index]);
+      const auto* rows = static_cast<const uint8*>(pixels.pixel_data());
+
+      for (int y = 0; ok && y < mAtlasPageSize.height; ++y) {
+        ok = output.write(rows + (static_cast<usize>(y) * pixels.pitch()), rowSize) == rowSize;
+      }
+    }
+
+    return ok && output.close();
+  }
+
+  template <typename T>
+  auto save_atlas(basic_renderer<T>& renderer, const std::string& path, const uint64 fontHash)
+      -> result
+  {
+    return save_atlas(renderer, path.c_str(), fontHash);
+  }
+
+  /**
+   * Replaces the atlas with an atlas that was previously saved with `save_atlas()`.
+   *
+   * This enables the atlas, and uses the page size of the saved atlas. Glyphs that are cached
+   * as individual textures are kept. The file is rejected if it wasn't created for a font with
+   * the same hash, size, style, hinting and outline, or with other effects, in which case the
+   * cache is not modified.
+   *
+   * \param renderer the renderer used to create the atlas pages.
+   * \param path the path of the saved atlas.
+   * \param fontHash a hash of the font file contents, see `hash_font_file()`.
+   *
+   * \return `success` if the atlas was loaded; `failure` otherwise.
+   *
+   * \throws sdl_error if the atlas pages cannot be created.
+   *
+   * \see save_atlas
+   */
+  template <typename T>
+  auto load_atlas(basic_renderer<T>& renderer, const char* path, const uint64 fontHash)
+      -> result
+  {
+    const mapped_file input {path};
+    if (!input || input.size() < detail::font_atlas_header_size) {
+      return failure;
+    }
+
+    const auto* data = input.data();
+    const auto& font = mFont.get();
+
+    if (std::memcmp(data, detail::font_atlas_magic, sizeof detail::font_atlas_magic) != 0 ||
+        read_u32(data + 4) != detail::font_atlas_version ||
+        detail::read_little_endian<uint64>(data + 8) != fontHash ||
+        read_i32(data + 16) != mFont.size() || read_u32(data + 20) != atlas_style() ||
+        read_i32(data + 24) != TTF_GetFontHinting(font) ||
+        read_i32(data + 28) != mFont.outline()) {
+      return failure;
+    }
+
+    const auto& effects = baked_effects();
+    if (read_i32(data + 64) != effects.outline ||
+        read_u32(data + 68) != pack_color(effects.outline_color) ||
+        read_i32(data + 72) != effects.shadow_offset.x() ||
+        read_i32(data + 76) != effects.shadow_offset.y() ||
+        read_u32(data + 80) != pack_color(effects.shadow_color)) {
+      return failure;
+    }
+
+    const auto pageWidth = read_u32(data + 32);
+    const auto pageHeight = read_u32(data + 36);
+    const auto pageCount = static_cast<usize>(read_u32(data + 40));
+    const auto glyphCount = static_cast<usize>(read_u32(data + 44));
+    const auto currentPage = static_cast<usize>(read_u32(data + 48));
+
+    if (pageWidth == 0 || pageHeight == 0 || pageWidth > detail::font_atlas_max_page_size ||
+        pageHeight > detail::font_atlas_max_page_size ||
+        (pageCount != 0 && currentPage >= pageCount)) {
+      return failure;
+    }
+
+    const iarea pageSize {static_cast<int>(pageWidth), static_cast<int>(pageHeight)};
+    const auto pageBytes = static_cast<usize>(pageWidth) * pageHeight * sizeof(uint32);
+
+    const auto remaining = input.size() - detail::font_atlas_header_size;
+    if (glyphCount > remaining / detail::font_atlas_glyph_size ||
+        pageCount > (remaining - glyphCount * detail::font_atlas_glyph_size) / pageBytes) {
+      return failure;
+    }
+
+    const auto* records = data + detail::font_atlas_header_size;
+
+    for (usize index = 0; index < glyphCount; ++index) {
+      const auto* record = records + (index * detail::font_atlas_glyph_size);
+      const irect source {read_i32(record + 8),
+                          read_i32(record + 12),
+                          read_i32(record + 16),
+                          read_i32(record + 20)};
+
+      if (read_u32(record + 4) >= pageCount || source.x() < 0 || source.y() < 0 ||
+          source.width() < 0 || source.height() < 0 || source.width() > pageSize.width ||
+          source.height() > pageSize.height || source.x() > pageSize.width - source.width() ||
+          source.y() > pageSize.height - source.height()) {
+        return failure;
+      }
+    }
+
+    std::vector<texture> pages;
+    pages.reserve(pageCount);
+
+    const auto* pixels = records + (glyphCount * detail::font_atlas_glyph_size);
+    for (usize index = 0; index < pageCount; ++index) {
+      auto page = make_atlas_page(renderer, pageSize);
+
+      const auto* source = pixels + (index * pageBytes);
+      const auto pitch = pageSize.width * static_cast<int>(sizeof(uint32));
+      if (SDL_UpdateTexture(page.get(), nullptr, source, pitch) != 0) {
+        throw sdl_error {};
+      }
+
+      pages.push_back(std::move(page));
+    }
+
+    for (const auto& [glyph, entry] : mAtlasGlyphs) {
+      mGlyphLru.erase(entry.position);
+    }
+
+    mAtlasGlyphs.clear();
+    mAtlasPages = std::move(pages);
+    mAtlasPageUses.assign(pageCount, ++mUseTick);
+
+    mUseAtlas = true;
+    mAtlasPageSize = pageSize;
+    mAtlasPage = currentPage;
+    mAtlasCursor = ipoint {read_i32(data + 52), read_i32(data + 56)};
+    mAtlasShelfHeight = read_i32(data + 60);
+
+    for (usize index = 0; index < glyphCount; ++index) {
+      const auto* record = records + (index * detail::font_atlas_glyph_size);
+      const auto glyph = detail::read_little_endian<uint16>(record);
+
+      /* Glyphs that are cached as individual textures take precedence */
+      if (mGlyphs.find(glyph) == mGlyphs.end() &&
+          mAtlasGlyphs.find(glyph) == mAtlasGlyphs.end()) {
+        atlas_glyph data {static_cast<usize>(read_u32(record + 4)),
+                          irect {read_i32(record + 8),
+                                 read_i32(record + 12),
+                                 read_i32(record + 16),
+                                 read_i32(record + 20)},
+                          glyph_metrics {read_i32(record + 24),
+                                         read_i32(record + 28),
+                                         read_i32(record + 32),
+                                         read_i32(record + 36),
+                                         read_i32(record + 40)}};
+
+        mGlyphLru.push_back(glyph);
+
+        const auto position = std::prev(mGlyphLru.end());
+        mAtlasGlyphs.try_emplace(glyph, atlas_entry {std::move(data), position});
+      }
+    }
+
+    enforce_glyph_budget();
+    return success;
+  }
+
+  template <typename T>
+  auto load_atlas(basic_renderer<T>& renderer, const std::string& path, const uint64 fontHash)
+      -> result
+  {
+    return load_atlas(renderer, path.c_str(), fontHash);
+  }
+
+  /**
+   * Computes a hash of the contents of a font file, for use with saved atlases.
+   *
+   * \param path the path of the font file.
+   *
+   * \return a 64-bit hash of the file; nothing if the file couldn't be read.
+   */
+  [[nodiscard]] static auto hash_font_file(const char* path) -> maybe<uint64>
+  {
+    const mapped_file input {path};
+    if (!input) {
+      return nothing;
+    }
+
+    return hash64(input.data(), input.size());
+  }
+
+  [[nodiscard]] static auto hash_font_file(const std::string& path) -> maybe<uint64>
+  {
+    return hash_font_file(path.c_str());
+  }
+
+  /**
+   * Sets the limits for the cached glyphs.
+   *
+   * The glyph count includes glyphs stored both as individual textures and in the atlas. The
+   * memory of the atlas is accounted for in whole pages, so when the atlas reaches the memory
+   * limit, the least recently used page is cleared and reused instead of allocating a new
+   * page. At least one atlas page is always allowed.
+   *
+   * Least recently used glyphs are evicted immediately if the new budget is exceeded.
+   *
+   * \param budget the new glyph budget, a zero limit disables that limit.
+   */
+  void set_glyph_budget(const cache_budget& budget)
+  {
+    mGlyphBudget = budget;
+    enforce_glyph_budget();
+  }
+
+  /**
+   * Sets the limits for the cached strings.
+   *
+   * Least recently used strings are evicted immediately if the new budget is exceeded.
+   *
+   * \param budget the new string budget, a zero limit disables that limit.
+   */
+  void set_string_budget(const cache_budget& budget)
+  {
+    mStringBudget = budget;
+    enforce_string_budget();
+  }
+
+  /// Returns the limits for the cached glyphs.
+  [[nodiscard]] auto glyph_budget() const noexcept -> const cache_budget&
+  {
+    return mGlyphBudget;
+  }
+
+  /// Returns the limits for the cached strings.
+  [[nodiscard]] auto string_budget() const noexcept -> const cache_budget&
+  {
+    return mStringBudget;
+  }
+
+  /// Returns the lookup statistics for glyphs, including lookups made when rendering.
+  [[nodiscard]] auto glyph_stats() const noexcept -> const cache_stats& { return mGlyphStats; }
+
+  /// Returns the lookup statistics for strings.
+  [[nodiscard]] auto string_stats() const noexcept -> const cache_stats&
+  {
+    return mStringStats;
+  }
+
+  /// Resets the glyph and string statistics.
+  void reset_stats() noexcept
+  {
+    mGlyphStats = cache_stats {};
+    mStringStats = cache_stats {};
+  }
+
+  /// Returns the amount of cached glyphs, both as individual textures and in the atlas.
+  [[nodiscard]] auto glyph_count() const noexcept -> usize { return mGlyphLru.size(); }
+
+  /// Returns the amount of cached strings.
+  [[nodiscard]] auto string_count() const noexcept -> usize { return mStringLru.size(); }
+
+  /// Returns the approximate texture memory used by glyphs and atlas pages, in bytes.
+  [[nodiscard]] auto glyph_memory() const noexcept -> usize
+  {
+    return mGlyphTextureBytes + mAtlasPages.size() * atlas_page_bytes();
+  }
+
+  /// Returns the approximate texture memory used by cached strings, in bytes.
+  [[nodiscard]] auto string_memory() const noexcept -> usize { return mStringBytes; }
+
+  /// Returns the approximate texture memory used by glyphs, atlas pages and strings, in bytes.
+  [[nodiscard]] auto memory_usage() const noexcept -> usize
+  {
+    return glyph_memory() + string_memory();
+  }
+
+  /// Returns the usage stamp of the least recently used glyph texture or string, if any.
+  [[nodiscard]] auto oldest_use() const noexcept -> maybe<uint64>
+  {
+    maybe<uint64> oldest;
+
+    if (const auto glyph = oldest_glyph_texture(); glyph != mGlyphLru.end()) {
+      oldest = mGlyphs.find(*glyph)->second.last_use;
+    }
+
+    if (!mStringLru.empty()) {
+      const auto stamp = mStrings.find(mStringLru.back())->second.last_use;
+      if (!oldest || stamp < *oldest) {
+        oldest = stamp;
+      }
+    }
+
+    return oldest;
+  }
+
+  /**
+   * Evicts the least recently used glyph texture or string.
+   *
+   * \details Glyphs in the atlas are not considered, since evicting them doesn't free memory.
+   *
+   * \return `true` if an entry was evicted; `false` if there was nothing to evict.
+   */
+  auto evict_oldest() -> bool
+  {
+    const auto glyph = oldest_glyph_texture();
+    const auto hasGlyph = glyph != mGlyphLru.end();
+
+    if (!mStringLru.empty() &&
+        (!hasGlyph || mStrings.find(mStringLru.back())->second.last_use <
+                          mGlyphs.find(*glyph)->second.last_use)) {
+      evict_oldest_string();
+      return true;
+    }
+    else if (hasGlyph) {
+      evict_glyph(glyph);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Returns the underlying font instance.
+  [[nodiscard]] auto get_font() noexcept -> font& { return mFont; }
+  [[nodiscard]] auto get_font() const noexcept -> const font& { return mFont; }
+
+ private:
+  using glyph_lru = std::list<unicode_t>;
+  using string_lru = std::list<id_type>;
+
+  struct glyph_entry final {
+    glyph_data data;
+    glyph_lru::iterator position;  ///< The position of the glyph in the usage list.
+    usize bytes {};
+    mutable uint64 last_use {cache_manager::tick()};  ///< The stamp of the latest use.
+  };
+
+  struct atlas_entry final {
+    atlas_glyph data;
+    glyph_lru::iterator position;  ///< The position of the glyph in the usage list.
+  };
+
+  struct string_entry final {
+    texture text;
+    string_lru::iterator position;  ///< The position of the string in the usage list.
+    usize bytes {};
+    std::string key;  ///< The content key of strings cached by `get_or_render()`, if any.
+    mutable uint64 last_use {cache_manager::tick()};  ///< The stamp of the latest use.
+  };
+
+  struct rasterized_glyph final {
+    unicode_t glyph {};
+    maybe<surface> image;
+  };
+
+  struct fallback_font final {
+    font instance;
+    int offset {};  ///< Moves the baseline of the fallback font to that of the cached font.
+  };
+
+  struct async_state final {
+    explicit async_state(font&& workerFont) : worker_font {std::move(workerFont)} {}
+
+    mutex font_lock;  ///< Serializes the use of the worker font.
+    font worker_font;
+    spin_lock lock;  ///< Protects the rasterized glyphs.
+    std::deque<rasterized_glyph> glyphs;
+  };
+
+  font mFont;
+  std::vector<fallback_font> mFallbacks;
+  mutable std::vector<uint8> mGlyphFonts;  ///< Glyph -> Font index, only used with fallbacks.
+  std::unordered_map<unicode_t, glyph_entry> mGlyphs;
+  std::unordered_map<id_type, string_entry> mStrings;
+  std::unordered_map<std::string, id_type, content_hash> mStringIds;  ///< Content keys to IDs.
+  std::string mStringKey;  ///< Reused to build content keys without allocating.
+  id_type mNextStringId {1};
+
+  std::unordered_map<unicode_t, atlas_entry> mAtlasGlyphs;
+  std::vector<texture> mAtlasPages;
+  iarea mAtlasPageSize {1024, 1024};
+  usize mAtlasPage {};  ///< The index of the page that new glyphs are packed into.
+  ipoint mAtlasCursor;
+  int mAtlasShelfHeight {};
+  std::vector<uint32> mAtlasBlank;  ///< Zeroed pixels used to clear new and recycled pages.
+  bool mUseAtlas {};
+  bool mSdf {};  ///< Indicates whether glyphs are rasterized as signed distance fields.
+
+  text_effects mEffects;
+  ipoint mEffectMargin;  ///< The offset of the fill within glyphs with baked effects.
+  bool mHasEffects {};
+
+  /* Lookups are logically const, but update the usage order and statistics */
+  mutable glyph_lru mGlyphLru;                 ///< Most recently used glyphs first.
+  mutable string_lru mStringLru;               ///< Most recently used strings first.
+  mutable std::vector<uint64> mAtlasPageUses;  ///< The last use tick of each atlas page.
+  mutable uint64 mUseTick {};
+  mutable cache_stats mGlyphStats;
+  mutable cache_stats mStringStats;
+
+  /* The measurement caches are keyed by the font format, see measure_format() */
+  mutable std::unordered_map<unicode32_t, int> mAdvances;
+  mutable std::unordered_map<uint64, int> mKerningPairs;
+  mutable uint64 mMeasuredFormat {};
+
+  cache_budget mGlyphBudget;
+  cache_budget mStringBudget;
+  usize mGlyphTextureBytes {};  ///< The memory used by individual glyph textures.
+  usize mStringBytes {};
+
+  thread_pool* mPool {};
+  std::shared_ptr<async_state> mAsync;
+  std::unordered_map<unicode_t, glyph_metrics> mPendingGlyphs;  ///< Requested glyphs.
+  maybe<unicode_t> mPlaceholder;
+  bool mLazy {};
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  std::vector<std::vector<SDL_Vertex>> mAtlasVertices;
+  std::vector<int> mAtlasIndices;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+  inline constexpr static int atlas_padding = 1;
+
+  /* The values of the font table, the fallback fonts follow the cached font */
+  inline constexpr static uint8 unresolved_font = 0;
+  inline constexpr static uint8 primary_font = 1;
+  inline constexpr static uint8 fallback_font_index = 2;
+  inline constexpr static uint8 missing_font = 0xFF;
+  inline constexpr static usize max_fallbacks = missing_font - fallback_font_index;
+
+  [[nodiscard]] static auto texture_bytes(const texture& texture) noexcept -> usize
+  {
+    const auto size = texture.size();
+    const auto bpp = SDL_BYTESPERPIXEL(to_underlying(texture.format()));
+    return static_cast<usize>(size.width) * static_cast<usize>(size.height) *
+           static_cast<usize>(bpp);
+  }
+
+  [[nodiscard]] auto atlas_page_bytes() const noexcept -> usize
+  {
+    return static_cast<usize>(mAtlasPageSize.width) *
+           static_cast<usize>(mAtlasPageSize.height) * sizeof(uint32);
+  }
+
+  [[nodiscard]] static auto exceeds(const usize limit, const usize value) noexcept -> bool
+  {
+    return limit != 0 && value > limit;
+  }
+
+  [[nodiscard]] auto lookup_glyph(const unicode_t glyph) const -> const glyph_entry*
+  {
+    if (const auto it = mGlyphs.find(glyph); it != mGlyphs.end()) {
+      return &it->second;
+    }
+    else {
+      return nullptr;
+    }
+  }
+
+  [[nodiscard]] auto lookup_atlas_glyph(const unicode_t glyph) const -> const atlas_entry*
+  {
+    if (const auto it = mAtlasGlyphs.find(glyph); it != mAtlasGlyphs.end()) {
+      return &it->second;
+    }
+    else {
+      return nullptr;
+    }
+  }
+
+  [[nodiscard]] auto resolve_font_index(const unicode_t glyph) const -> uint8
+  {
+    if (mFallbacks.empty()) {
+      return mFont.is_glyph_provided(glyph) ? primary_font : missing_font;
+    }
+
+    auto& index = mGlyphFonts[glyph];
+    if (index == unresolved_font) {
+      index = missing_font;
+
+      if (mFont.is_glyph_provided(glyph)) {
+        index = primary_font;
+      }
+      else {
+        for (usize fallback = 0; fallback < mFallbacks.size(); ++fallback) {
+          if (mFallbacks[fallback].instance.is_glyph_provided(glyph)) {
+            index = static_cast<uint8>(fallback_font_index + fallback);
+            break;
+          }
+        }
+      }
+    }
+
+    return index;
+  }
+
+  /* Returns the vertical offset of glyphs from fallback fonts, without querying SDL_ttf */
+  [[nodiscard]] auto baseline_offset(const unicode_t glyph) const -> int
+  {
+    if (mFallbacks.empty()) {
+      return 0;
+    }
+
+    const auto index = resolve_font_index(glyph);
+    if (index == missing_font || index == primary_font) {
+      return 0;
+    }
+    else {
+      return mFallbacks[index - fallback_font_index].offset;
+    }
+  }
+
+  [[nodiscard]] auto get_glyph_metrics(const unicode_t glyph) const -> glyph_metrics
+  {
+    const auto* source = resolve_font(glyph);
+    return (source ? source : &mFont)->get_metrics(glyph).value();
+  }
+
+  struct effect_extent final {
+    int left {};
+    int top {};
+    int right {};
+    int bottom {};
+  };
+
+  /* The amount of pixels that the effect layers extend beyond each side of the fill */
+  [[nodiscard]] static auto effect_margins(const text_effects& effects) noexcept
+      -> effect_extent
+  {
+    const auto outline = (effects.outline_color.alpha() != 0) ? effects.outline : 0;
+    const auto hasShadow = effects.shadow_color.alpha() != 0;
+    const auto shadow = hasShadow ? effects.shadow_offset : ipoint {};
+
+    return {outline + (detail::max)(0, -shadow.x()),
+            outline + (detail::max)(0, -shadow.y()),
+            outline + (detail::max)(0, shadow.x()),
+            outline + (detail::max)(0, shadow.y())};
+  }
+
+  /* Composites the shadow, outline and fill layers of a glyph into a single RGBA32 image */
+  [[nodiscard]] static auto bake_effects(const surface& glyph, const text_effects& effects)
+      -> surface
+  {
+    const auto fill = glyph.convert_to(pixel_format::rgba32);
+    const auto width = fill.width();
+    const auto height = fill.height();
+
+    const auto radius = (effects.outline_color.alpha() != 0) ? effects.outline : 0;
+    const auto hasShadow =
+        effects.shadow_color.alpha() != 0 && effects.shadow_offset != ipoint {};
+    const auto shadow = hasShadow ? effects.shadow_offset : ipoint {};
+    const auto [left, top, right, bottom] = effect_margins(effects);
+
+    /* The coverage of the outlined glyph, the fill is at (radius, radius) */
+    const auto shapeWidth = width + (2 * radius);
+    const auto shapeHeight = height + (2 * radius);
+    std::vector<uint8> shape(static_cast<usize>(shapeWidth) * static_cast<usize>(shapeHeight));
+
+    const auto* fillPixels = static_cast<const uint8*>(fill.pixel_data());
+    const auto fillAlpha = [&](const int x, const int y) noexcept -> uint8 {
+      return fillPixels[(static_cast<usize>(y) * static_cast<usize>(fill.pitch())) +
+                        (static_cast<usize>(x) * 4u) + 3u];
+    };
+
+    /* Dilate the coverage with a disc, the edge of the disc is anti-aliased */
+    const auto diameter = (2 * radius) + 1;
+    std::vector<float> disc(static_cast<usize>(diameter) * static_cast<usize>(diameter));
+    for (int dy = -radius; dy <= radius; ++dy) {
+      for (int dx = -radius; dx <= radius; ++dx) {
+        const auto distance = std::sqrt(static_cast<float>((dx * dx) + (dy * dy)));
+        const auto index = (static_cast<usize>(dy + radius) * static_cast<usize>(diameter)) +
+                           static_cast<usize>(dx + radius);
+        disc[index] = (detail::min)(1.0f, static_cast<float>(radius) + 0.5f - distance);
+      }
+    }
+
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        const auto alpha = static_cast<float>(fillAlpha(x, y));
+        if (alpha == 0) {
+          continue;
+        }
+
+        for (int dy = 0; dy < diameter; ++dy) {
+          for (int dx = 0; dx < diameter; ++dx) {
+            const auto weight =
+                disc[(static_cast<usize>(dy) * static_cast<usize>(diameter)) +
+                     static_cast<usize>(dx)];
+            if (weight <= 0) {
+              continue;
+            }
+
+            auto& coverage =
+                shape[(static_cast<usize>(y + dy) * static_cast<usize>(shapeWidth)) +
+                      static_cast<usize>(x + dx)];
+            coverage = (detail::max)(coverage, static_cast<uint8>((alpha * weight) + 0.5f));
+          }
+        }
+      }
+    }
+
+    const auto shapeCoverage = [&](const int x, const int y) noexcept -> float {
+      if (x < 0 || y < 0 || x >= shapeWidth || y >= shapeHeight) {
+        return 0;
+      }
+
+      const auto index =
+          (static_cast<usize>(y) * static_cast<usize>(shapeWidth)) + static_cast<usize>(x);
+      return static_cast<float>(shape[index]) / 255.0f;
+    };
+
+    /* Straight alpha "over" operator, the channels are in [0, 255] and alpha in [0, 1] */
+    const auto over = [](float* dst, const float* src, const float alpha) noexcept {
+      const auto remaining = dst[3] * (1.0f - alpha);
+      const auto result = alpha + remaining;
+      if (result > 0) {
+        for (usize channel = 0; channel < 3u; ++channel) {
+          dst[channel] = ((src[channel] * alpha) + (dst[channel] * remaining)) / result;
+        }
+
+        dst[3] = result;
+      }
+    };
+
+    const float outlineColor[3] {static_cast<float>(effects.outline_color.red()),
+                                 static_cast<float>(effects.outline_color.green()),
+                                 static_cast<float>(effects.outline_color.blue())};
+    const float shadowColor[3] {static_cast<float>(effects.shadow_color.red()),
+                                static_cast<float>(effects.shadow_color.green()),
+                                static_cast<float>(effects.shadow_color.blue())};
+    const auto outlineAlpha = effects.outline_color.norm_alpha();
+    const auto shadowAlpha = effects.shadow_color.norm_alpha();
+
+    surface result {iarea {width + left + right, height + top + bottom}, pixel_format::rgba32};
+    auto* resultPixels = static_cast<uint8*>(result.pixel_data());
+
+    for (int y = 0; y < result.height(); ++y) {
+      auto* row = resultPixels + (static_cast<usize>(y) * static_cast<usize>(result.pitch()));
+
+      for (int x = 0; x < result.width(); ++x) {
+        float pixel[4] {};
+
+        /* The outline shape is at (left - radius, top - radius) */
+        const auto shapeX = x - left + radius;
+        const auto shapeY = y - top + radius;
+
+        if (hasShadow) {
+          const auto coverage = shapeCoverage(shapeX - shadow.x(), shapeY - shadow.y());
+          over(pixel, shadowColor, coverage * shadowAlpha);
+        }
+
+        if (radius > 0) {
+          over(pixel, outlineColor, shapeCoverage(shapeX, shapeY) * outlineAlpha);
+        }
+
+        const auto fillX = x - left;
+        const auto fillY = y - top;
+        if (fillX >= 0 && fillY >= 0 && fillX < width && fillY < height) {
+          const auto* src = fillPixels +
+                            (static_cast<usize>(fillY) * static_cast<usize>(fill.pitch())) +
+                            (static_cast<usize>(fillX) * 4u);
+          const float color[3] {static_cast<float>(src[0]),
+                                static_cast<float>(src[1]),
+                                static_cast<float>(src[2])};
+          over(pixel, color, static_cast<float>(src[3]) / 255.0f);
+        }
+
+        auto* dst = row + (static_cast<usize>(x) * 4u);
+        dst[0] = static_cast<uint8>(pixel[0] + 0.5f);
+        dst[1] = static_cast<uint8>(pixel[1] + 0.5f);
+        dst[2] = static_cast<uint8>(pixel[2] + 0.5f);
+        dst[3] = static_cast<uint8>((pixel[3] * 255.0f) + 0.5f);
+      }
+    }
+
+    return result;
+  }
+
+  /* The effects that are actually baked, which are used to key saved atlases */
+  [[nodiscard]] auto baked_effects() const noexcept -> text_effects
+  {
+    if (mHasEffects && !mSdf) {
+      return mEffects;
+    }
+    else {
+      return text_effects {0, color {0, 0, 0, 0}, ipoint {}, color {0, 0, 0, 0}};
+    }
+  }
+
+  [[nodiscard]] static auto pack_color(const color& color) noexcept -> uint32
+  {
+    return static_cast<uint32>(color.red()) | (static_cast<uint32>(color.green()) << 8u) |
+           (static_cast<uint32>(color.blue()) << 16u) |
+           (static_cast<uint32>(color.alpha()) << 24u);
+  }
+
+  void mark_glyph_used(const glyph_entry& entry) const
+  {
+    mGlyphLru.splice(mGlyphLru.begin(), mGlyphLru, entry.position);
+    entry.last_use = cache_manager::tick();
+    ++mGlyphStats.hits;
+  }
+
+  void mark_glyph_used(const atlas_entry& entry) const
+  {
+    mGlyphLru.splice(mGlyphLru.begin(), mGlyphLru, entry.position);
+    mAtlasPageUses[entry.data.page] = ++mUseTick;
+    ++mGlyphStats.hits;
   }
 
-  /// Returns the underlying font instance.
-  [[nodiscard]] auto get_font() noexcept -> font& { return mFont; }
-  [[nodiscard]] auto get_font() const noexcept -> const font& { return mFont; }
+  /* Evicts a glyph, returning the iterator that follows it in the usage list */
+  auto evict_glyph(const glyph_lru::iterator position) -> glyph_lru::iterator
+  {
+    if (const auto it = mGlyphs.find(*position); it != mGlyphs.end()) {
+      mGlyphTextureBytes -= it->second.bytes;
+      mGlyphs.erase(it);
+    }
+    else {
+      mAtlasGlyphs.erase(*position);
+    }
 
- private:
-  font mFont;
-  std::unordered_map<unicode_t, glyph_data> mGlyphs;
-  std::unordered_map<id_type, texture> mStrings;
-  id_type mNextStringId {1};
+    ++mGlyphStats.evictions;
+    return mGlyphLru.erase(position);
+  }
+
+  /* Returns the least recently used glyph that is stored as an individual texture */
+  [[nodiscard]] auto oldest_glyph_texture() const -> glyph_lru::iterator
+  {
+    for (auto it = mGlyphLru.end(); it != mGlyphLru.begin();) {
+      --it;
+      if (mGlyphs.find(*it) != mGlyphs.end()) {
+        return it;
+      }
+    }
+
+    return mGlyphLru.end();
+  }
+
+  /* The most recently used glyph is never evicted, so that a stored glyph is usable */
+  void enforce_glyph_budget()
+  {
+    while (mGlyphLru.size() > 1 && exceeds(mGlyphBudget.max_count, mGlyphLru.size())) {
+      evict_glyph(std::prev(mGlyphLru.end()));
+    }
+
+    /* Only individual glyph textures free memory when evicted, atlas pages are recycled */
+    auto it = mGlyphLru.end();
+    while (it != mGlyphLru.begin() && std::prev(it) != mGlyphLru.begin() &&
+           exceeds(mGlyphBudget.max_bytes, glyph_memory())) {
+      --it;
+      if (mGlyphs.find(*it) != mGlyphs.end()) {
+        it = evict_glyph(it);
+      }
+    }
+  }
+
+  [[nodiscard]] auto measure_format() const noexcept -> uint64
+  {
+    const auto style = static_cast<uint64>(TTF_GetFontStyle(mFont.get()) & 0xFF);
+    const auto hinting = static_cast<uint64>(TTF_GetFontHinting(mFont.get()) & 0xFF);
+    const auto outline = static_cast<uint64>(static_cast<uint32>(mFont.outline()));
+
+    /* The top bit distinguishes the initial state from a default format */
+    return (uint64 {1} << 63u) | (outline << 16u) | (hinting << 8u) | style;
+  }
+
+  [[nodiscard]] auto glyph_advance(const unicode32_t glyph) const -> int
+  {
+    if (const auto iter = mAdvances.find(glyph); iter != mAdvances.end()) {
+      return iter->second;
+    }
+
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    const auto metrics = mFont.get_metrics_w(glyph);
+#else
+    maybe<glyph_metrics> metrics;
+    if (glyph <= 0xFFFF) {
+      metrics = mFont.get_metrics(static_cast<unicode_t>(glyph));
+    }
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+
+    const auto advance = metrics ? metrics->advance : 0;
+    mAdvances.try_emplace(glyph, advance);
+
+    return advance;
+  }
+
+  [[nodiscard]] auto glyph_kerning(const unicode32_t previous, const unicode32_t current) const
+      -> int
+  {
+    const auto key = (static_cast<uint64>(previous) << 32u) | current;
+    if (const auto iter = mKerningPairs.find(key); iter != mKerningPairs.end()) {
+      return iter->second;
+    }
+
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+    const auto kerning = mFont.get_kerning_w(previous, current);
+#else
+    const auto kerning = (previous <= 0xFFFF && current <= 0xFFFF)
+                             ? mFont.get_kerning(static_cast<unicode_t>(previous),
+                                                 static_cast<unicode_t>(current))
+                             : 0;
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+
+    mKerningPairs.try_emplace(key, kerning);
+    return kerning;
+  }
+
+  /* Greedy line breaking, a zero wrap width disables wrapping */
+  [[nodiscard]] auto measure(const std::string_view str, const int wrapWidth) const -> iarea
+  {
+    if (const auto format = measure_format(); format != mMeasuredFormat) {
+      mAdvances.clear();
+      mKerningPairs.clear();
+      mMeasuredFormat = format;
+    }
+
+    const auto kerning = mFont.has_kerning();
+
+    int width = 0;
+    int lines = 1;
+    int lineWidth = 0;
+
+    /* The widths of the line before and after the last run of spaces */
+    int breakWidth = 0;
+    int breakEnd = 0;
+    bool hasBreak = false;
+    unicode32_t previous = 0;
+
+    detail::for_each_utf8(str, [&](const unicode32_t glyph) {
+      if (glyph == '\n') {
+        width = (detail::max)(width, lineWidth);
+        lineWidth = 0;
+        hasBreak = false;
+        previous = 0;
+        ++lines;
+        return;
+      }
+
+      auto advance = glyph_advance(glyph);
+      if (kerning && previous != 0) {
+        advance += glyph_kerning(previous, glyph);
+      }
+
+      if (wrapWidth > 0 && glyph != ' ' && lineWidth > 0 && lineWidth + advance > wrapWidth) {
+        if (hasBreak) {
+          /* Move the word after the last spaces to the next line */
+          width = (detail::max)(width, breakWidth);
+          lineWidth -= breakEnd;
+        }
+        else {
+          width = (detail::max)(width, lineWidth);
+          lineWidth = 0;
+        }
+
+        if (lineWidth == 0) {
+          advance = glyph_advance(glyph);
+        }
+
+        hasBreak = false;
+        ++lines;
+      }
+
+      if (glyph == ' ') {
+        if (previous != ' ' || !hasBreak) {
+          breakWidth = lineWidth;
+        }
+
+        breakEnd = lineWidth + advance;
+        hasBreak = true;
+      }
+
+      lineWidth += advance;
+      previous = glyph;
+    });
+
+    width = (detail::max)(width, lineWidth);
+    return {width, mFont.height() + ((lines - 1) * mFont.line_skip())};
+  }
+
+  /* The key is the render mode, color, font style and outline, followed by the string */
+  void make_string_key(const char* str, const color& fg, const render_mode mode)
+  {
+    const auto style = TTF_GetFontStyle(mFont.get());
+    const auto outline = mFont.outline();
+
+    mStringKey.clear();
+    mStringKey.push_back(static_cast<char>(mode));
+    mStringKey.push_back(static_cast<char>(fg.red()));
+    mStringKey.push_back(static_cast<char>(fg.green()));
+    mStringKey.push_back(static_cast<char>(fg.blue()));
+    mStringKey.push_back(static_cast<char>(fg.alpha()));
+    mStringKey.append(reinterpret_cast<const char*>(&style), sizeof style);
+    mStringKey.append(reinterpret_cast<const char*>(&outline), sizeof outline);
+    mStringKey.append(str);
+  }
+
+  /* The most recently stored string is never evicted, so that the returned ID is valid */
+  void enforce_string_budget()
+  {
+    while (mStringLru.size() > 1 && (exceeds(mStringBudget.max_count, mStringLru.size()) ||
+                                     exceeds(mStringBudget.max_bytes, mStringBytes))) {
+      evict_oldest_string();
+    }
+  }
+
+  void evict_oldest_string()
+  {
+    const auto it = mStrings.find(mStringLru.back());
+    assert(it != mStrings.end());
+
+    mStringBytes -= it->second.bytes;
+    if (!it->second.key.empty()) {
+      mStringIds.erase(it->second.key);
+    }
+
+    mStrings.erase(it);
+    mStringLru.pop_back();
+
+    ++mStringStats.evictions;
+  }
+
+  template <typename T>
+  auto draw_glyph(basic_renderer<T>& renderer, const unicode_t glyph, const ipoint& position)
+      -> int
+  {
+    if (const auto* entry = lookup_atlas_glyph(glyph)) {
+      mark_glyph_used(*entry);
+
+      const auto& [page, source, metrics] = entry->data;
+      const auto outline = mFont.outline();
+
+      /* SDL_ttf handles the y-axis alignment within each font */
+      const auto x = position.x() + metrics.min_x - outline;
+      const auto y = position.y() - outline + baseline_offset(glyph);
+
+      renderer.render(mAtlasPages[page],
+                      source,
+                      irect {x - mEffectMargin.x(),
+                             y - mEffectMargin.y(),
+                             source.width(),
+                             source.height()});
+
+      return x + metrics.advance;
+    }
+    else if (const auto* entry = lookup_glyph(glyph)) {
+      mark_glyph_used(*entry);
+
+      const auto& [texture, metrics] = entry->data;
+      const auto outline = mFont.outline();
+
+      /* SDL_ttf handles the y-axis alignment within each font */
+      const auto x = position.x() + metrics.min_x - outline;
+      const auto y = position.y() - outline + baseline_offset(glyph);
+
+      renderer.render(texture, ipoint {x - mEffectMargin.x(), y - mEffectMargin.y()});
+
+      return x + metrics.advance;
+    }
+    else {
+      ++mGlyphStats.misses;
+      return draw_placeholder(renderer, glyph, position);
+    }
+  }
+
+  /* Renders the placeholder of a requested glyph, and advances the pen like the glyph would */
+  template <typename T>
+  auto draw_placeholder(basic_renderer<T>& renderer,
+                        const unicode_t glyph,
+                        const ipoint& position) -> int
+  {
+    const auto iter = mPendingGlyphs.find(glyph);
+    if (iter == mPendingGlyphs.end()) {
+      return position.x();
+    }
+
+    if (mPlaceholder && *mPlaceholder != glyph && has_glyph(*mPlaceholder)) {
+      draw_glyph(renderer, *mPlaceholder, position);
+    }
+
+    const auto& metrics = iter->second;
+    return position.x() + metrics.min_x - mFont.outline() + metrics.advance;
+  }
+
+  template <typename T>
+  void prepare_glyph(basic_renderer<T>& renderer, const unicode_t glyph)
+  {
+    if (mAsync) {
+      request_glyph(renderer, glyph);
+    }
+    else if (mLazy) {
+      store_glyph(renderer, glyph);
+    }
+  }
+
+  template <typename T>
+  void request_glyph(basic_renderer<T>& renderer, const unicode_t glyph)
+  {
+    if (has_glyph(glyph) || mPendingGlyphs.find(glyph) != mPendingGlyphs.end()) {
+      return;
+    }
+
+    const auto index = resolve_font_index(glyph);
+    if (index == missing_font) {
+      return;
+    }
+    else if (index != primary_font) {
+      /* The workers don't have copies of the fallback fonts */
+      store_glyph(renderer, glyph);
+      return;
+    }
+
+    mPendingGlyphs.try_emplace(glyph, mFont.get_metrics(glyph).value());
+
+    const auto color = renderer.get_color();
+    maybe<text_effects> effects;
+    if (mHasEffects && !mSdf) {
+      effects = mEffects;
+    }
+
+    mPool->submit([state = mAsync, glyph, color, effects, atlas = mUseAtlas] {
+      rasterized_glyph result {glyph, nothing};
+
+      try {
+        {
+          scoped_lock lock {state->font_lock};
+          result.image.emplace(state->worker_font.render_blended_glyph(glyph, color));
+        }
+
+        /* Atlas pages use RGBA32, so convert on the worker instead of the render thread */
+        if (effects) {
+          *result.image = bake_effects(*result.image, *effects);
+        }
+        else if (atlas && result.image->format_info().format() != pixel_format::rgba32) {
+          *result.image = result.image->convert_to(pixel_format::rgba32);
+        }
+      }
+      catch (const exception&) {
+        /* The failure is reported through the empty surface */
+        result.image.reset();
+      }
+
+      scoped_lock lock {state->lock};
+      state->glyphs.push_back(std::move(result));
+    });
+  }
+
+  [[nodiscard]] auto take_rasterized_glyph() -> maybe<rasterized_glyph>
+  {
+    scoped_lock lock {mAsync->lock};
+
+    if (mAsync->glyphs.empty()) {
+      return nothing;
+    }
+
+    maybe<rasterized_glyph> glyph {std::move(mAsync->glyphs.front())};
+    mAsync->glyphs.pop_front();
+
+    return glyph;
+  }
+
+  template <typename T>
+  void store_rendered_glyph(basic_renderer<T>& renderer,
+                            const unicode_t glyph,
+                            const surface& image)
+  {
+    if (mUseAtlas && image.format_info().format() != pixel_format::rgba32) {
+      store_atlas_glyph(renderer, glyph, image.convert_to(pixel_format::rgba32));
+    }
+    else if (mUseAtlas) {
+      store_atlas_glyph(renderer, glyph, image);
+    }
+    else {
+      glyph_data data {renderer.make_texture(image), get_glyph_metrics(glyph)};
+      const auto bytes = texture_bytes(data.glyph);
+
+      mGlyphLru.push_front(glyph);
+      mGlyphs.try_emplace(glyph, glyph_entry {std::move(data), mGlyphLru.begin(), bytes});
+      mGlyphTextureBytes += bytes;
+    }
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+  void add_glyph_quad(std::vector<SDL_Vertex>& vertices,
+                      const atlas_glyph& data,
+                      const fpoint& position,
+                      const float scale = 1) const
+  {
+    const auto pageWidth = static_cast<float>(mAtlasPageSize.width);
+    const auto pageHeight = static_cast<float>(mAtlasPageSize.height);
+
+    const auto& source = data.source;
+    const auto u0 = static_cast<float>(source.x()) / pageWidth;
+    const auto v0 = static_cast<float>(source.y()) / pageHeight;
+    const auto u1 = static_cast<float>(source.max_x()) / pageWidth;
+    const auto v1 = static_cast<float>(source.max_y()) / pageHeight;
+
+    const auto x0 = position.x();
+    const auto y0 = position.y();
+    const auto x1 = x0 + (static_cast<float>(source.width()) * scale);
+    const auto y1 = y0 + (static_cast<float>(source.height()) * scale);
+
+    const SDL_Color tint {0xFF, 0xFF, 0xFF, 0xFF};
+    vertices.push_back({{x0, y0}, tint, {u0, v0}});
+    vertices.push_back({{x1, y0}, tint, {u1, v0}});
+    vertices.push_back({{x1, y1}, tint, {u1, v1}});
+    vertices.push_back({{x0, y1}, tint, {u0, v1}});
+  }
+
+  template <typename T>
+  void render_atlas_vertices(basic_renderer<T>& renderer)
+  {
+    for (usize page = 0; page < mAtlasVertices.size(); ++page) {
+      const auto& vertices = mAtlasVertices[page];
+      if (vertices.empty()) {
+        continue;
+      }
+
+      const auto quads = vertices.size() / 4u;
+
+      mAtlasIndices.clear();
+      for (usize quad = 0; quad < quads; ++quad) {
+        const auto first = static_cast<int>(quad * 4u);
+        mAtlasIndices.insert(mAtlasIndices.end(),
+                             {first, first + 1, first + 2, first + 2, first + 3, first});
+      }
+
+      renderer.render_geo(mAtlasPages[page], vertices, mAtlasIndices);
+    }
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+  template <typename T>
+  void store_atlas_glyph(basic_renderer<T>& renderer,
+                         const unicode_t glyph,
+                         const surface& source)
+  {
+    const auto region = allocate_atlas_region(renderer, source.size());
+    auto& page = mAtlasPages.at(mAtlasPage);
+
+    const auto* pixels = source.pixel_data();
+    if (SDL_UpdateTexture(page.get(), region.data(), pixels, source.pitch()) != 0) {
+      throw sdl_error {};
+    }
+
+    atlas_glyph data {mAtlasPage, region, get_glyph_metrics(glyph)};
+
+    mGlyphLru.push_front(glyph);
+    mAtlasGlyphs.try_emplace(glyph, atlas_entry {std::move(data), mGlyphLru.begin()});
+    mAtlasPageUses[mAtlasPage] = ++mUseTick;
+  }
+
+  /* Simple shelf packer, glyphs are placed left-to-right in rows of the current page */
+  template <typename T>
+  [[nodiscard]] auto allocate_atlas_region(basic_renderer<T>& renderer, const iarea& size)
+      -> irect
+  {
+    if (size.width > mAtlasPageSize.width || size.height > mAtlasPageSize.height) {
+      throw exception {"Glyph does not fit in font cache atlas page!"};
+    }
+
+    if (!mAtlasPages.empty() && mAtlasCursor.x() + size.width > mAtlasPageSize.width) {
+      mAtlasCursor = ipoint {0, mAtlasCursor.y() + mAtlasShelfHeight + atlas_padding};
+      mAtlasShelfHeight = 0;
+    }
+
+    if (mAtlasPages.empty() || mAtlasCursor.y() + size.height > mAtlasPageSize.height) {
+      if (!mAtlasPages.empty() &&
+          exceeds(mGlyphBudget.max_bytes, glyph_memory() + atlas_page_bytes())) {
+        recycle_atlas_page();
+      }
+      else {
+        add_atlas_page(renderer);
+      }
+    }
+
+    const irect region {mAtlasCursor, size};
+
+    mAtlasCursor.set_x(mAtlasCursor.x() + size.width + atlas_padding);
+    mAtlasShelfHeight = (detail::max)(mAtlasShelfHeight, size.height);
+
+    return region;
+  }
 
   template <typename T>
-  [[nodiscard]] auto make_glyph_texture(basic_renderer<T>& renderer, const unicode_t glyph)
+  [[nodiscard]] auto make_atlas_page(basic_renderer<T>& renderer, const iarea& size) const
       -> texture
   {
-    return renderer.make_texture(mFont.render_blended_glyph(glyph, renderer.get_color()));
+    auto page =
+        renderer.make_texture(size, pixel_format::rgba32, texture_access::non_lockable);
+    page.set_blend_mode(blend_mode::blend);
+
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+    if (mSdf) {
+      page.set_scale_mode(scale_mode::linear);
+    }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
+
+    return page;
+  }
+
+  [[nodiscard]] auto atlas_style() const noexcept -> uint32
+  {
+    const auto style = static_cast<uint32>(TTF_GetFontStyle(mFont.get()));
+    return mSdf ? (style | detail::font_atlas_sdf_style) : style;
+  }
+
+  /* Copies the pixels of an atlas page by rendering the page to a temporary target */
+  template <typename T>
+  [[nodiscard]] auto read_atlas_page(basic_renderer<T>& renderer, texture& page) const
+      -> surface
+  {
+    auto target =
+        renderer.make_texture(mAtlasPageSize, pixel_format::rgba32, texture_access::target);
+    surface pixels {mAtlasPageSize, pixel_format::rgba32};
+
+    const auto blend = page.get_blend_mode();
+    page.set_blend_mode(blend_mode::none);
+
+    bool ok {};
+    {
+      scoped_target scope {renderer, target};
+
+      const irect bounds {ipoint {0, 0}, mAtlasPageSize};
+      renderer.render(page, bounds, bounds);
+
+      ok = pixels.lock() && SDL_RenderReadPixels(renderer.get(),
+                                                 nullptr,
+                                                 to_underlying(pixel_format::rgba32),
+                                                 pixels.pixel_data(),
+                                                 pixels.pitch()) == 0;
+      pixels.unlock();
+    }
+
+    page.set_blend_mode(blend);
+
+    if (!ok) {
+      throw sdl_error {};
+    }
+
+    return pixels;
+  }
+
+  static auto write_u32(file& output, const usize value) noexcept -> result
+  {
+    return output.write_native_as_little_endian(static_cast<uint32>(value));
+  }
+
+  static auto write_u32(file& output, const int value) noexcept -> result
+  {
+    return output.write_native_as_little_endian(static_cast<uint32>(value));
+  }
+
+  [[nodiscard]] static auto read_u32(const uint8* data) noexcept -> uint32
+  {
+    return detail::read_little_endian<uint32>(data);
+  }
+
+  [[nodiscard]] static auto read_i32(const uint8* data) noexcept -> int
+  {
+    return static_cast<int>(detail::read_little_endian<uint32>(data));
+  }
+
+  template <typename T>
+  void add_atlas_page(basic_renderer<T>& renderer)
+  {
+    auto page = make_atlas_page(renderer, mAtlasPageSize);
+
+    /* The initial contents of created textures are undefined, so clear the page */
+    clear_atlas_page(page);
+
+    mAtlasPages.push_back(std::move(page));
+    mAtlasPageUses.push_back(++mUseTick);
+
+    mAtlasPage = mAtlasPages.size() - 1;
+    mAtlasCursor = ipoint {0, 0};
+    mAtlasShelfHeight = 0;
+  }
+
+  /* Evicts all glyphs on the least recently used page, and packs new glyphs into it */
+  void recycle_atlas_page()
+  {
+    usize victim = 0;
+    for (usize page = 1; page < mAtlasPageUses.size(); ++page) {
+      if (mAtlasPageUses[page] < mAtlasPageUses[victim]) {
+        victim = page;
+      }
+    }
+
+    for (auto it = mAtlasGlyphs.begin(); it != mAtlasGlyphs.end();) {
+      if (it->second.data.page == victim) {
+        mGlyphLru.erase(it->second.position);
+        it = mAtlasGlyphs.erase(it);
+        ++mGlyphStats.evictions;
+      }
+      else {
+        ++it;
+      }
+    }
+
+    clear_atlas_page(mAtlasPages[victim]);
+    mAtlasPageUses[victim] = ++mUseTick;
+
+    mAtlasPage = victim;
+    mAtlasCursor = ipoint {0, 0};
+    mAtlasShelfHeight = 0;
+  }
+
+  void clear_atlas_page(texture& page)
+  {
+    /* The zeroed pixels are shared by all pages, since they all have the same size */
+    const auto count = atlas_page_bytes() / sizeof(uint32);
+    if (mAtlasBlank.size() != count) {
+      mAtlasBlank.assign(count, 0u);
+    }
+
+    const auto pitch = mAtlasPageSize.width * static_cast<int>(sizeof(uint32));
+    if (SDL_UpdateTexture(page.get(), nullptr, mAtlasBlank.data(), pitch) != 0) {
+      throw sdl_error {};
+    }
   }
 };
 
@@ -322,11 +2487,15 @@ class font_cache final {
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const font_cache& cache) -> std::ostream&
 {
   return stream << to_string(cache);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_NO_SDL_TTF
@@ -29,12 +29,17 @@
 
 #include <SDL_ttf.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 #include "../common/primitives.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class font_hint {
@@ -76,11 +81,15 @@ enum class font_hint {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const font_hint hint) -> std::ostream&
 {
   return stream << to_string(hint);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_NO_SDL_TTF
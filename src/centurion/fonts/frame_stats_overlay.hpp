@@ -0,0 +1,289 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_FONTS_FRAME_STATS_OVERLAY_HPP_
+#define CENTURION_FONTS_FRAME_STATS_OVERLAY_HPP_
+
+#ifndef CENTURION_NO_SDL_TTF
+
+#include <SDL_ttf.h>
+
+#include <array>        // array
+#include <cstdio>       // snprintf
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../video/color.hpp"
+#include "../video/frame_stats.hpp"
+#include "../video/renderer.hpp"
+#include "../video/texture_memory.hpp"
+#include "font_cache.hpp"
+
+namespace cen {
+
+/**
+ * Draws the rolling statistics of a `frame_stats` collector, and a graph of recent frame
+ * times.
+ *
+ * The text is rendered with a font cache, which must store the basic latin glyphs, see
+ * `font_cache::store_basic_latin_glyphs()`. The graph is drawn with one bulk rectangle call
+ * per color, and frames that exceed the frame budget are highlighted. Rendering the overlay
+ * doesn't allocate once the internal buffers are large enough.
+ *
+ * The overlay can also show the estimated texture memory usage of a registry, along with a
+ * bar that shows how much of the memory budget is used.
+ *
+ * \see frame_stats
+ * \see texture_memory_registry
+ */
+class frame_stats_overlay final {
+ public:
+  /**
+   * Creates an overlay.
+   *
+   * \param cache the font cache used to render text, must outlive the overlay.
+   */
+  explicit frame_stats_overlay(font_cache& cache) noexcept : mCache {&cache} {}
+
+  /**
+   * Draws the overlay.
+   *
+   * \param renderer the renderer that will be used.
+   * \param stats the statistics that will be drawn.
+   * \param position the position of the upper left corner of the overlay.
+   */
+  template <typename T>
+  void render(basic_renderer<T>& renderer, const frame_stats& stats, const ipoint position)
+  {
+    const auto previousColor = renderer.get_color();
+
+    const auto lineSkip = mCache->get_font().line_skip();
+    const auto lineCount = frame_metric_count + (mMemory ? 1u : 0u);
+    const auto textHeight = lineSkip * static_cast<int>(lineCount);
+
+    int textWidth = 0;
+    for (usize index = 0; index < frame_metric_count; ++index) {
+      const auto metric = static_cast<frame_metric>(index);
+      textWidth = (detail::max)(textWidth, mCache->calc_size(format(stats, metric)).width);
+    }
+
+    if (mMemory) {
+      textWidth = (detail::max)(textWidth, mCache->calc_size(format(*mMemory)).width);
+    }
+
+    const auto hasMemoryBar = mMemory && mMemory->budget() != 0;
+    const auto memoryBarHeight = hasMemoryBar ? mMemoryBarHeight + mPadding : 0;
+
+    const auto graphWidth = static_cast<int>(stats.window()) * mBarWidth;
+    const auto width = (detail::max)(textWidth, graphWidth) + (2 * mPadding);
+    const auto height = textHeight + memoryBarHeight + mGraphHeight + (3 * mPadding);
+
+    renderer.set_color(mBackground);
+    renderer.fill_rect(irect {position.x(), position.y(), width, height});
+
+    auto linePos = position + ipoint {mPadding, mPadding};
+    for (usize index = 0; index < frame_metric_count; ++index) {
+      const auto metric = static_cast<frame_metric>(index);
+      mCache->render_text(renderer, format(stats, metric), linePos);
+      linePos.set_y(linePos.y() + lineSkip);
+    }
+
+    if (mMemory) {
+      mCache->render_text(renderer, format(*mMemory), linePos);
+      linePos.set_y(linePos.y() + lineSkip);
+    }
+
+    if (hasMemoryBar) {
+      render_memory_bar(renderer, *mMemory, linePos, width - (2 * mPadding));
+      linePos.set_y(linePos.y() + memoryBarHeight);
+    }
+
+    const ipoint graphPos {position.x() + mPadding, linePos.y() + mPadding};
+    render_graph(renderer, stats, graphPos);
+
+    renderer.set_color(previousColor);
+  }
+
+  /// Sets the frame time budget in milliseconds, frames above it are highlighted.
+  void set_budget(const double budget) noexcept { mBudget = (detail::max)(budget, 0.001); }
+
+  /// Sets the height of the frame time graph, in pixels.
+  void set_graph_height(const int height) noexcept { mGraphHeight = (detail::max)(height, 1); }
+
+  /// Sets the width of each bar in the frame time graph, in pixels.
+  void set_bar_width(const int width) noexcept { mBarWidth = (detail::max)(width, 1); }
+
+  /**
+   * Sets the texture memory registry whose usage is shown by the overlay.
+   *
+   * \param registry the registry, must outlive the overlay; null hides the memory usage.
+   */
+  void set_texture_memory(const texture_memory_registry* registry) noexcept
+  {
+    mMemory = registry;
+  }
+
+  void set_background(const color& background) noexcept { mBackground = background; }
+
+  void set_bar_color(const color& bar) noexcept { mBarColor = bar; }
+
+  /// Sets the color of bars that exceed the frame budget, and of the budget line.
+  void set_warning_color(const color& warning) noexcept { mWarningColor = warning; }
+
+  [[nodiscard]] auto budget() const noexcept -> double { return mBudget; }
+
+  [[nodiscard]] auto graph_height() const noexcept -> int { return mGraphHeight; }
+
+  [[nodiscard]] auto bar_width() const noexcept -> int { return mBarWidth; }
+
+ private:
+  font_cache* mCache {};
+  const texture_memory_registry* mMemory {};
+  std::vector<irect> mBars;
+  std::vector<irect> mLateBars;
+  std::array<char, 96> mLine {};
+  color mBackground {0, 0, 0, 0xC0};
+  color mBarColor {0x40, 0xC0, 0x40};
+  color mWarningColor {0xE0, 0x40, 0x40};
+  double mBudget {1'000.0 / 60.0};
+  int mGraphHeight {48};
+  int mBarWidth {2};
+  int mPadding {4};
+  int mMemoryBarHeight {4};
+
+  [[nodiscard]] auto format(const frame_stats& stats, const frame_metric metric)
+      -> std::string_view
+  {
+    const auto [min, mean, p99, max] = stats.summary(metric);
+    const auto name = to_string(metric);
+
+    const auto isTime = metric == frame_metric::frame_time ||
+                        metric == frame_metric::event_time ||
+                        metric == frame_metric::submit_time ||
+                        metric == frame_metric::present_time;
+
+    const auto length = std::snprintf(mLine.data(),
+                                      mLine.size(),
+                                      isTime ? "%-14.*s %6.2f %6.2f %6.2f %6.2f ms"
+                                             : "%-14.*s %6.0f %6.1f %6.0f %6.0f",
+                                      static_cast<int>(name.size()),
+                                      name.data(),
+                                      min,
+                                      mean,
+                                      p99,
+                                      max);
+
+    const auto size = (detail::min)(static_cast<usize>((detail::max)(length, 0)),
+                                    mLine.size() - 1);
+    return std::string_view {mLine.data(), size};
+  }
+
+  [[nodiscard]] auto format(const texture_memory_registry& memory) -> std::string_view
+  {
+    constexpr double mebibyte = 1024.0 * 1024.0;
+
+    const auto total = static_cast<double>(memory.total()) / mebibyte;
+    const auto peak = static_cast<double>(memory.peak()) / mebibyte;
+    const auto budget = static_cast<double>(memory.budget()) / mebibyte;
+
+    const auto length =
+        (memory.budget() != 0)
+            ? std::snprintf(mLine.data(),
+                            mLine.size(),
+                            "%-14s %6.1f MiB peak %6.1f MiB budget %6.1f MiB",
+                            "texture_memory",
+                            total,
+                            peak,
+                            budget)
+            : std::snprintf(mLine.data(),
+                            mLine.size(),
+                            "%-14s %6.1f MiB peak %6.1f MiB",
+                            "texture_memory",
+                            total,
+                            peak);
+
+    const auto size = (detail::min)(static_cast<usize>((detail::max)(length, 0)),
+                                    mLine.size() - 1);
+    return std::string_view {mLine.data(), size};
+  }
+
+  template <typename T>
+  void render_memory_bar(basic_renderer<T>& renderer,
+                         const texture_memory_registry& memory,
+                         const ipoint pos,
+                         const int width)
+  {
+    const auto usage = (detail::min)(memory.budget_usage(), 1.0);
+    const auto usedWidth = static_cast<int>(usage * static_cast<double>(width));
+
+    renderer.set_color(memory.over_budget() ? mWarningColor : mBarColor);
+    renderer.fill_rect(irect {pos.x(), pos.y(), usedWidth, mMemoryBarHeight});
+  }
+
+  template <typename T>
+  void render_graph(basic_renderer<T>& renderer, const frame_stats& stats, const ipoint pos)
+  {
+    mBars.clear();
+    mLateBars.clear();
+
+    /* The graph covers twice the frame budget, so the budget line is in the middle */
+    const auto scale = static_cast<double>(mGraphHeight) / (2.0 * mBudget);
+    const auto bottom = pos.y() + mGraphHeight;
+
+    for (usize index = 0; index < stats.sample_count(); ++index) {
+      const auto frameTime = stats.at(index, frame_metric::frame_time);
+      const auto barHeight =
+          (detail::min)(static_cast<int>(frameTime * scale) + 1, mGraphHeight);
+
+      const irect bar {pos.x() + (static_cast<int>(index) * mBarWidth),
+                       bottom - barHeight,
+                       mBarWidth,
+                       barHeight};
+
+      if (frameTime > mBudget) {
+        mLateBars.push_back(bar);
+      }
+      else {
+        mBars.push_back(bar);
+      }
+    }
+
+    renderer.set_color(mBarColor);
+    renderer.fill_rects(mBars);
+
+    renderer.set_color(mWarningColor);
+    renderer.fill_rects(mLateBars);
+
+    const auto graphWidth = static_cast<int>(stats.window()) * mBarWidth;
+    renderer.fill_rect(irect {pos.x(), bottom - (mGraphHeight / 2), graphWidth, 1});
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_TTF
+#endif  // CENTURION_FONTS_FRAME_STATS_OVERLAY_HPP_
@@ -0,0 +1,198 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_FONTS_TEXT_LAYOUT_HPP_
+#define CENTURION_FONTS_TEXT_LAYOUT_HPP_
+
+#ifndef CENTURION_NO_SDL_TTF
+
+#include <SDL_ttf.h>
+
+#include <string>   // string, to_string
+#include <vector>   // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "../video/renderer.hpp"
+#include "font_cache.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/**
+ * Represents a string of glyphs that has been laid out once, using the glyphs in a font cache.
+ *
+ * Unlike `font_cache::render_text()`, the layout takes kerning into account, and the glyph
+ * positions are only computed when the layout is created. This makes this class a good fit
+ * for static labels, since rendering a layout simply replays the stored glyph positions.
+ *
+ * Note, glyphs that are not cached by the font cache when the layout is created are ignored.
+ * The font cache must outlive any renders of the layout, but the layout does not need to be
+ * recreated when more glyphs are stored in the cache.
+ *
+ * \see font_cache
+ */
+class text_layout final {
+ public:
+  using size_type = usize;
+
+  struct glyph_placement final {
+    unicode_t glyph {};  ///< The glyph that is rendered.
+    ipoint position;     ///< The pen position of the glyph, relative to the layout origin.
+  };
+
+  /**
+   * Lays out a string of glyphs.
+   *
+   * You can provide newline characters in the string to indicate line breaks.
+   *
+   * \tparam String the type of the string-like object, storing Unicode glyphs.
+   *
+   * \param cache the font cache that provides the glyph metrics.
+   * \param str the source of the Unicode glyphs.
+   */
+  template <typename String>
+  text_layout(const font_cache& cache, const String& str)
+  {
+    const auto& font = cache.get_font();
+    const auto lineSkip = font.line_skip();
+    const auto useKerning = font.has_kerning();
+
+    ipoint pen;
+    unicode_t previous {};
+
+    mLineCount = 1;
+    mSize.height = lineSkip;
+
+    for (const unicode_t glyph : str) {
+      if (glyph == '\n') {
+        pen.set_x(0);
+        pen.set_y(pen.y() + lineSkip);
+        previous = 0;
+
+        ++mLineCount;
+        mSize.height += lineSkip;
+      }
+      else if (const auto* metrics = cache.find_metrics(glyph)) {
+        if (useKerning && previous != 0) {
+          pen.set_x(pen.x() + font.get_kerning(previous, glyph));
+        }
+
+        mGlyphs.push_back({glyph, pen});
+
+        pen.set_x(pen.x() + metrics->advance);
+        mSize.width = (detail::max)(mSize.width, pen.x());
+
+        previous = glyph;
+      }
+    }
+  }
+
+  /**
+   * Renders the laid out glyphs.
+   *
+   * \param cache the font cache that holds the glyphs, should be the one used for the layout.
+   * \param renderer the renderer that will be used.
+   * \param position the position of the origin of the layout.
+   */
+  template <typename T>
+  void render(font_cache& cache, basic_renderer<T>& renderer, const ipoint& position) const
+  {
+    for (const auto& [glyph, offset] : mGlyphs) {
+      cache.render_glyph(renderer, glyph, position + offset);
+    }
+  }
+
+  /// Returns the laid out glyph placements, in the order they appeared in the string.
+  [[nodiscard]] auto glyphs() const noexcept -> const std::vector<glyph_placement>&
+  {
+    return mGlyphs;
+  }
+
+  /// Returns the amount of laid out glyphs.
+  [[nodiscard]] auto glyph_count() const noexcept -> size_type { return mGlyphs.size(); }
+
+  /// Returns the amount of lines in the layout.
+  [[nodiscard]] auto line_count() const noexcept -> size_type { return mLineCount; }
+
+  /// Returns the size of the bounding box of the layout.
+  [[nodiscard]] auto size() const noexcept -> iarea { return mSize; }
+
+  /// Returns the bounds of the layout, if rendered at the specified position.
+  [[nodiscard]] auto bounds(const ipoint& position = {}) const noexcept -> irect
+  {
+    return irect {position, mSize};
+  }
+
+  /// Indicates whether the layout contains no glyphs.
+  [[nodiscard]] auto empty() const noexcept -> bool { return mGlyphs.empty(); }
+
+ private:
+  std::vector<glyph_placement> mGlyphs;
+  iarea mSize {};
+  size_type mLineCount {};
+};
+
+[[nodiscard]] inline auto to_string(const text_layout& layout) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("text_layout(glyphs: {}, lines: {}, width: {}, height: {})",
+                     layout.glyph_count(),
+                     layout.line_count(),
+                     layout.size().width,
+                     layout.size().height);
+#else
+  return "text_layout(glyphs: " + std::to_string(layout.glyph_count()) +
+         ", lines: " + std::to_string(layout.line_count()) +
+         ", width: " + std::to_string(layout.size().width) +
+         ", height: " + std::to_string(layout.size().height) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const text_layout& layout) -> std::ostream&
+{
+  return stream << to_string(layout);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_TTF
+#endif  // CENTURION_FONTS_TEXT_LAYOUT_HPP_
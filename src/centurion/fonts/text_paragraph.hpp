@@ -0,0 +1,447 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_FONTS_TEXT_PARAGRAPH_HPP_
+#define CENTURION_FONTS_TEXT_PARAGRAPH_HPP_
+
+#ifndef CENTURION_NO_SDL_TTF
+
+#include <SDL_ttf.h>
+
+#include <cassert>      // assert
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../detail/utf8.hpp"
+#include "../features.hpp"
+#include "../video/renderer.hpp"
+#include "font_cache.hpp"
+#include "wrap_alignment.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/**
+ * Represents a paragraph of text that is broken into lines once, using a font cache.
+ *
+ * The paragraph is wrapped to a maximum width, where lines are broken at the last space that
+ * fits on a line, or before the glyph that doesn't fit if a line has no spaces. The glyph
+ * positions and the width of every line are computed when text is added, so rendering simply
+ * replays the stored positions of the visible lines. Appending text only lays out the last
+ * line again, which makes this class a good fit for long scrolling text such as chat logs.
+ *
+ * Note, glyphs that are not cached by the font cache when they are laid out are ignored, like
+ * with `text_layout`. The font cache must outlive the paragraph.
+ *
+ * \see text_layout
+ * \see font_cache
+ */
+class text_paragraph final {
+ public:
+  using size_type = usize;
+
+  struct line_info final {
+    size_type first {};  ///< The index of the first glyph of the line.
+    size_type count {};  ///< The amount of glyphs on the line.
+    int width {};        ///< The width of the line, excluding trailing spaces.
+  };
+
+  /**
+   * Creates an empty paragraph.
+   *
+   * \param cache the font cache that provides the glyph metrics.
+   * \param wrapWidth the maximum width of a line, in pixels; zero disables wrapping.
+   */
+  explicit text_paragraph(const font_cache& cache, const int wrapWidth = 0)
+      : mCache {&cache}
+      , mWrapWidth {wrapWidth}
+      , mLineSkip {cache.get_font().line_skip()}
+  {
+    assert(wrapWidth >= 0);
+  }
+
+  /**
+   * Appends glyphs to the end of the paragraph.
+   *
+   * Only the last line of the paragraph is laid out again. You can provide newline
+   * characters in the string to indicate line breaks.
+   *
+   * \tparam String the type of the string-like object, storing Unicode glyphs.
+   *
+   * \param str the source of the Unicode glyphs.
+   */
+  template <typename String>
+  void append(const String& str)
+  {
+    const auto first = pop_last_line();
+
+    for (const unicode_t glyph : str) {
+      mGlyphs.push_back(glyph);
+    }
+
+    layout(first);
+  }
+
+  /**
+   * Appends a UTF-8 encoded string to the end of the paragraph.
+   *
+   * Characters outside of the basic multilingual plane are ignored, since font caches only
+   * store 16-bit glyphs.
+   *
+   * \param str the UTF-8 encoded string.
+   */
+  void append_utf8(const std::string_view str)
+  {
+    const auto first = pop_last_line();
+
+    detail::for_each_utf8(str, [this](const unicode32_t glyph) {
+      if (glyph <= 0xFFFF) {
+        mGlyphs.push_back(static_cast<unicode_t>(glyph));
+      }
+    });
+
+    layout(first);
+  }
+
+  /// Removes all text from the paragraph.
+  void clear() noexcept
+  {
+    mGlyphs.clear();
+    mOffsets.clear();
+    mLines.clear();
+    mWidth = 0;
+  }
+
+  /// Sets the maximum width of a line, which lays out the entire paragraph again.
+  void set_wrap_width(const int width)
+  {
+    assert(width >= 0);
+
+    if (width != mWrapWidth) {
+      mWrapWidth = width;
+      mLines.clear();
+      mWidth = 0;
+      layout(0);
+    }
+  }
+
+  [[nodiscard]] auto wrap_width() const noexcept -> int { return mWrapWidth; }
+
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+
+  /// Sets the horizontal alignment of the lines, which doesn't affect the line breaks.
+  void set_alignment(const wrap_alignment align) noexcept { mAlignment = align; }
+
+  [[nodiscard]] auto alignment() const noexcept -> wrap_alignment { return mAlignment; }
+
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+
+  /**
+   * Renders all lines of the paragraph.
+   *
+   * \param cache the font cache that holds the glyphs, should be the one used for the layout.
+   * \param renderer the renderer that will be used.
+   * \param position the position of the top left corner of the paragraph.
+   */
+  template <typename T>
+  void render(font_cache& cache, basic_renderer<T>& renderer, const ipoint& position) const
+  {
+    render_lines(cache, renderer, position, 0, mLines.size());
+  }
+
+  /**
+   * Renders the lines of the paragraph that intersect a viewport.
+   *
+   * Only the visible lines are visited, so the cost of this function doesn't depend on the
+   * length of the paragraph. Scrolling is done by moving the paragraph position.
+   *
+   * \param cache the font cache that holds the glyphs, should be the one used for the layout.
+   * \param renderer the renderer that will be used.
+   * \param position the position of the top left corner of the paragraph.
+   * \param viewport the visible area, e.g. the render target or a scrolled text box.
+   */
+  template <typename T>
+  void render(font_cache& cache,
+              basic_renderer<T>& renderer,
+              const ipoint& position,
+              const irect& viewport) const
+  {
+    if (mLines.empty() || mLineSkip <= 0) {
+      return;
+    }
+
+    const auto top = viewport.y() - position.y();
+    const auto bottom = viewport.max_y() - position.y();
+
+    const auto lineCount = static_cast<int>(mLines.size());
+    const auto first = detail::clamp(top / mLineSkip, 0, lineCount);
+    const auto last = detail::clamp((bottom + mLineSkip - 1) / mLineSkip, 0, lineCount);
+
+    if (first < last) {
+      render_lines(cache,
+                   renderer,
+                   position,
+                   static_cast<size_type>(first),
+                   static_cast<size_type>(last));
+    }
+  }
+
+  /// Returns the index of the line at a vertical offset from the top of the paragraph.
+  [[nodiscard]] auto line_at(const int y) const noexcept -> maybe<size_type>
+  {
+    if (y >= 0 && mLineSkip > 0 && static_cast<size_type>(y / mLineSkip) < mLines.size()) {
+      return static_cast<size_type>(y / mLineSkip);
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Returns the laid out lines, in top to bottom order.
+  [[nodiscard]] auto lines() const noexcept -> const std::vector<line_info>& { return mLines; }
+
+  [[nodiscard]] auto line_count() const noexcept -> size_type { return mLines.size(); }
+
+  [[nodiscard]] auto glyph_count() const noexcept -> size_type { return mGlyphs.size(); }
+
+  /// Returns the height of each line, which is the line skip of the font.
+  [[nodiscard]] auto line_height() const noexcept -> int { return mLineSkip; }
+
+  /// Returns the size of the bounding box of the paragraph.
+  [[nodiscard]] auto size() const noexcept -> iarea
+  {
+    return {mWidth, static_cast<int>(mLines.size()) * mLineSkip};
+  }
+
+  /// Indicates whether the paragraph contains no text.
+  [[nodiscard]] auto empty() const noexcept -> bool { return mGlyphs.empty(); }
+
+ private:
+  const font_cache* mCache {};
+  std::vector<unicode_t> mGlyphs;
+  std::vector<int> mOffsets;  ///< The horizontal pen position of each glyph on its line.
+  std::vector<line_info> mLines;
+  int mWrapWidth {};
+  int mLineSkip {};
+  int mWidth {};  ///< The width of the widest line.
+
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+  wrap_alignment mAlignment {wrap_alignment::left};
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+
+  /* Removes the last line, so that it can be laid out again, and returns its first glyph */
+  [[nodiscard]] auto pop_last_line() -> size_type
+  {
+    if (mLines.empty()) {
+      return 0;
+    }
+
+    const auto first = mLines.back().first;
+    mLines.pop_back();
+
+    mWidth = 0;
+    for (const auto& line : mLines) {
+      mWidth = (detail::max)(mWidth, line.width);
+    }
+
+    return first;
+  }
+
+  /* Lays out the glyphs from the start of a line to the end of the paragraph */
+  void layout(size_type index)
+  {
+    mOffsets.resize(mGlyphs.size());
+
+    while (index < mGlyphs.size()) {
+      index = break_line(index);
+    }
+
+    /* A trailing newline starts an empty line, so that appended text ends up below it */
+    if (!mGlyphs.empty() && mGlyphs.back() == '\n') {
+      mLines.push_back({mGlyphs.size(), 0, 0});
+    }
+  }
+
+  /* Adds the line that starts at the index, and returns the index of the next line */
+  auto break_line(const size_type first) -> size_type
+  {
+    const auto& font = mCache->get_font();
+    const auto useKerning = font.has_kerning();
+
+    int pen = 0;
+    int width = 0;
+    unicode_t previous {};
+
+    bool hasBreak = false;
+    size_type breakIndex = 0; /* The first space of the last run of spaces */
+    size_type breakNext = 0;  /* The glyph after the last run of spaces */
+    int breakWidth = 0;
+
+    for (auto index = first; index < mGlyphs.size(); ++index) {
+      const auto glyph = mGlyphs[index];
+      mOffsets[index] = pen;
+
+      if (glyph == '\n') {
+        add_line(first, index, width);
+        return index + 1;
+      }
+
+      const auto* metrics = mCache->find_metrics(glyph);
+      if (!metrics) {
+        continue;
+      }
+
+      const auto kerning =
+          (useKerning && previous != 0) ? font.get_kerning(previous, glyph) : 0;
+
+      if (mWrapWidth > 0 && glyph != ' ' && index > first &&
+          pen + kerning + metrics->advance > mWrapWidth) {
+        if (hasBreak) {
+          add_line(first, breakIndex, breakWidth);
+          return breakNext;
+        }
+        else {
+          add_line(first, index, width);
+          return index;
+        }
+      }
+
+      pen += kerning;
+      mOffsets[index] = pen;
+      pen += metrics->advance;
+
+      if (glyph == ' ') {
+        if (previous != ' ' || !hasBreak) {
+          breakIndex = index;
+          breakWidth = width;
+        }
+
+        breakNext = index + 1;
+        hasBreak = true;
+      }
+      else {
+        width = pen;
+      }
+
+      previous = glyph;
+    }
+
+    add_line(first, mGlyphs.size(), width);
+    return mGlyphs.size();
+  }
+
+  void add_line(const size_type first, const size_type end, const int width)
+  {
+    mLines.push_back({first, end - first, width});
+    mWidth = (detail::max)(mWidth, width);
+  }
+
+  [[nodiscard]] auto line_offset(const line_info& line) const noexcept -> int
+  {
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+    const auto box = (mWrapWidth > 0) ? mWrapWidth : mWidth;
+    switch (mAlignment) {
+      case wrap_alignment::center:
+        return (box - line.width) / 2;
+
+      case wrap_alignment::right:
+        return box - line.width;
+
+      case wrap_alignment::left:
+        [[fallthrough]];
+
+      default:
+        return 0;
+    }
+#else
+    (void) line;
+    return 0;
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+  }
+
+  template <typename T>
+  void render_lines(font_cache& cache,
+                    basic_renderer<T>& renderer,
+                    const ipoint& position,
+                    const size_type firstLine,
+                    const size_type lastLine) const
+  {
+    for (auto index = firstLine; index < lastLine; ++index) {
+      const auto& line = mLines[index];
+      const auto x = position.x() + line_offset(line);
+      const auto y = position.y() + (static_cast<int>(index) * mLineSkip);
+
+      for (auto glyph = line.first; glyph < line.first + line.count; ++glyph) {
+        if (const auto code = mGlyphs[glyph]; code != ' ') {
+          cache.render_glyph(renderer, code, ipoint {x + mOffsets[glyph], y});
+        }
+      }
+    }
+  }
+};
+
+[[nodiscard]] inline auto to_string(const text_paragraph& paragraph) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("text_paragraph(glyphs: {}, lines: {}, width: {}, height: {})",
+                     paragraph.glyph_count(),
+                     paragraph.line_count(),
+                     paragraph.size().width,
+                     paragraph.size().height);
+#else
+  return "text_paragraph(glyphs: " + std::to_string(paragraph.glyph_count()) +
+         ", lines: " + std::to_string(paragraph.line_count()) +
+         ", width: " + std::to_string(paragraph.size().width) +
+         ", height: " + std::to_string(paragraph.size().height) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const text_paragraph& paragraph) -> std::ostream&
+{
+  return stream << to_string(paragraph);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_TTF
+#endif  // CENTURION_FONTS_TEXT_PARAGRAPH_HPP_
@@ -29,12 +29,17 @@
 
 #include <SDL_ttf.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 #include "../common/primitives.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 #if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
@@ -62,11 +67,15 @@ enum class wrap_alignment {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const wrap_alignment align) -> std::ostream&
 {
   return stream << to_string(align);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 #endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
 
 }  // namespace cen
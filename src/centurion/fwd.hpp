@@ -25,8 +25,33 @@
 #ifndef CENTURION_FWD_HPP_
 #define CENTURION_FWD_HPP_
 
+#include <cstdint>      // uint8_t, uint16_t, uint32_t
+#include <type_traits>  // true_type, false_type
+
 namespace cen {
 
+namespace detail {
+
+using owner_tag = std::true_type;
+using handle_tag = std::false_type;
+
+}  // namespace detail
+
+class exception;
+class sdl_error;
+class img_error;
+class ttf_error;
+class mix_error;
+class result;
+class sdl_string;
+
+enum class log_priority;
+enum class log_category;
+enum class log_overflow_policy;
+class log_limiter;
+
+struct memory_functions;
+struct allocation_stats;
 struct sdl_cfg;
 struct mix_cfg;
 struct img_cfg;
@@ -34,34 +59,275 @@ class sdl;
 class mix;
 class img;
 class ttf;
+struct init_timing;
+struct initializer_cfg;
+class initializer;
+struct mix_spec;
 
 struct version;
 
+class async_log_sink;
+class binary_log_writer;
+struct log_format;
+
+class truncating_iterator;
+
+class frame_arena;
+class arena_resource;
+
+template <typename T>
+class simd_vector;
+
+template <typename T>
+class slot_id;
+
+template <typename T>
+class slot_map;
+
+class hasher64;
+struct content_hash;
+
+template <typename T>
+class basic_point_array;
+
+template <typename T>
+class basic_rect_array;
+
+template <typename T>
+class basic_quadtree;
+
+template <typename T>
+class basic_spatial_hash;
+
 class file;
+class mapped_file;
+class asset_pack;
+class asset_pack_builder;
+
+template <typename... Assets>
+class basic_asset_registry;
+
+struct save_result;
+class save_writer;
+class buffered_file_reader;
+class buffered_file_writer;
+class io_service;
+
+struct asset_entry;
+struct read_result;
+
+enum class content_type;
+enum class file_mode;
+enum class file_type : unsigned;
+enum class seek_mode;
+enum class asset_compression : std::uint8_t;
 
 class font;
 class font_cache;
+class text_layout;
+class text_paragraph;
+class frame_stats_overlay;
 class unicode_string;
+class unicode_string_view;
+struct glyph_metrics;
+struct font_dpi;
+
+enum class font_direction;
+enum class font_hint;
+enum class wrap_alignment;
 
 struct dpi_info;
 struct blend_task;
 struct renderer_scale;
+struct atlas_region;
 class color;
+class color_lut;
+class color_cube;
 class gl_library;
+struct gl_functions;
+class gl_pass_timer;
+class gl_pass_scope;
+struct gl_pass_result;
+class gl_state_cache;
+class gl_texture_streamer;
+class gl_upload_context;
 class vk_library;
+class vk_swapchain;
+struct vk_swapchain_config;
+struct vk_swapchain_functions;
+struct vk_frame;
 class display_mode;
+struct display_info;
+class display_registry;
+class software_canvas;
+class surface_canvas;
+class surface_presenter;
+class collision_mask;
+struct particle;
+class particle_system;
+class sprite_batch;
+struct animation_clip;
+class animation_system;
+struct nine_slice_insets;
+class nine_slice;
+struct stroke_style;
+class shape_builder;
+struct upscale_layout;
+class pixel_pipeline;
+class render_layer;
+struct render_view;
+class render_command_list;
+struct render_frame;
+class render_thread;
+struct render_driver_score;
+struct renderer_selector_cfg;
+class renderer_selector;
+struct render_counters;
+struct frame_metric_summary;
+class frame_stats;
+class resize_coordinator;
+class texture_atlas;
+struct texture_memory_entry;
+struct texture_memory_tag;
+class texture_memory_registry;
+class texture_restorer;
+class texture_streamer;
+class mipmapped_texture;
+class texture_disk_cache;
+class image_loader;
+class texture_pool;
+class surface_pool;
+class render_target_pool;
+class scoped_target;
+struct hsv;
+struct hsl;
+class texture_lock;
+class animation;
+class animated_texture;
+class camera;
+class renderer_info;
+class damage_tracker;
+class frame_capture;
+struct frame_pacer_options;
+class frame_pacer;
+struct game_loop_options;
+class game_loop;
+class tilemap_layer;
+class video_frame;
+class video_stream;
+
+enum class blend_mode;
+enum class blend_factor;
+enum class blend_op;
+enum class alpha_mode;
+enum class pixel_format : std::uint32_t;
+enum class texture_access;
+enum class scale_mode;
+enum class renderer_flip;
+enum class flash_op;
+enum class orientation;
+enum class gl_attribute;
+enum class gl_swap_interval;
+enum class pacing_mode;
+enum class frame_metric : std::uint8_t;
+enum class message_box_type : std::uint32_t;
+enum class message_box_button_order : std::uint32_t;
+enum class message_box_color_type : int;
+enum class nine_slice_fill;
+enum class upscale_mode;
+enum class dither_mode;
+enum class video_frame_format;
+enum class line_join;
+enum class line_cap;
+enum class chunk_cache;
+enum class vk_present_mode;
+
+template <pixel_format Format>
+struct pixel_traits;
+
+template <pixel_format Format>
+class pixel_row;
+
+template <pixel_format Format>
+class pixel_span;
+
+template <typename Pool>
+class pooled;
+
+struct mixer_timing;
+struct mixer_stats;
 
 class music;
+class music_player;
+
+class sound_cache;
+
+struct audio_emitter;
+struct audio_listener;
+class positional_audio;
+
+class voice_manager;
+
+struct audio_spectrum;
+class spectrum_analyzer;
+
+class gain_effect;
+class low_pass_effect;
+class compressor_effect;
+class reverb_effect;
+
+template <typename... Stages>
+class effect_chain;
+
+enum class fade_status;
+enum class music_type;
+enum class music_player_mode : std::uint8_t;
 
 class palette;
+struct quantize_options;
 
+class adaptive_mutex;
+class barrier;
+class latch;
 class condition;
 class mutex;
 class scoped_lock;
 class try_lock;
 class semaphore;
+class shared_mutex;
+class shared_lock;
+class spin_lock;
 class thread;
 
+template <typename T>
+class thread_local_storage;
+
+struct thread_pool_options;
+class thread_pool;
+class task_handle;
+class task_graph;
+class task_queue;
+class main_thread_executor;
+
+enum class lock_status;
+enum class thread_priority;
+enum class task_affinity : std::uint8_t;
+
+template <typename T>
+class future;
+
+template <typename T>
+class task;
+
+template <typename T>
+class spsc_queue;
+
+template <typename T>
+class mpmc_queue;
+
+template <typename Queue>
+class blocking_queue;
+
 class audio_device_event;
 class controller_axis_event;
 class controller_button_event;
@@ -89,18 +355,110 @@ class display_event;
 class controller_touchpad_event;
 class controller_sensor_event;
 class event_handler;
+class event_view;
+class latency_histogram;
+class event_statistics;
+struct poll_statistics;
+struct handler_statistics;
+class event_batch;
+class event_recorder;
+class event_player;
+class input_thread;
+struct timed_event;
+class event_filter;
+class event_watch;
+struct app_lifecycle_options;
+class app_lifecycle;
+class joy_battery_event;
+class text_editing_ext_event;
+struct recorded_event;
+
+enum class event_type : std::uint32_t;
+enum class joy_hat_position : std::uint8_t;
+enum class mouse_wheel_direction : std::uint32_t;
+enum class display_event_id;
+enum class window_event_id;
 
 struct ball_axis_delta;
 class key_code;
 class scan_code;
 class keyboard;
+class keyboard_snapshot;
+class keyboard_state;
+struct input_snapshot;
+class input_delta_encoder;
+class input_delta_decoder;
+class input_history;
+class input_map;
+struct stress_step;
+class stress_script;
+struct stress_cfg;
+class input_stress;
+struct controller_state;
+class device_registry;
+struct controller_db_cfg;
+class controller_db;
+class sensor_buffer;
+struct sensor_sample;
+class touch_tracker;
+struct tracked_finger;
+class mouse_history;
+class cursor_cache;
+struct mouse_sample;
+struct rumble_effect;
+class rumble_scheduler;
 class mouse;
 class finger;
+class virtual_joystick_desc;
+struct controller_finger_state;
+
+enum class button_state : std::uint8_t;
+enum class joystick_type;
+enum class joystick_power;
+enum class hat_state : std::uint8_t;
+enum class sensor_type;
+enum class rumble_mix;
+enum class controller_button;
+enum class controller_axis;
+enum class controller_bind_type;
+enum class controller_type;
+enum class controller_mapping_result;
+enum class key_mod : std::uint16_t;
+enum class system_cursor;
+enum class mouse_button : std::uint8_t;
+enum class stress_input : std::uint8_t;
+enum class touch_device_type;
 
 class locale;
+class locale_cache;
+class clipboard_cache;
+struct cache_manager_options;
+struct cache_info;
+class cache_manager;
+struct power_info;
+class power_cache;
+struct power_governor_options;
+class power_governor;
+
+enum class platform_id;
+enum class power_state;
+enum class power_profile;
 
 class simd_block;
 class shared_object;
+class symbol_binder;
+
+template <typename Table>
+class plugin_interface;
+
+struct profile_event;
+class profile_zone;
+
+enum class profile_event_kind : std::uint8_t;
+
+class stopwatch;
+class periodic_timer;
+struct timer_event;
 
 class message_box_color_scheme;
 class message_box;
@@ -115,9 +473,18 @@ class event_base;
 template <typename... Events>
 class event_dispatcher;
 
+template <typename... Events>
+class event_bus;
+
+template <typename Event>
+class event_range;
+
 template <typename E>
 class event_sink;
 
+template <typename T>
+class event_channel;
+
 template <typename T>
 struct basic_vector3;
 
@@ -166,6 +533,36 @@ class basic_texture;
 template <typename T>
 struct deleter;
 
+using iarea = basic_area<int>;
+using farea = basic_area<float>;
+using ipoint = basic_point<int>;
+using fpoint = basic_point<float>;
+using irect = basic_rect<int>;
+using frect = basic_rect<float>;
+
+using window = basic_window<detail::owner_tag>;
+using window_handle = basic_window<detail::handle_tag>;
+using renderer = basic_renderer<detail::owner_tag>;
+using renderer_handle = basic_renderer<detail::handle_tag>;
+using texture = basic_texture<detail::owner_tag>;
+using texture_handle = basic_texture<detail::handle_tag>;
+using surface = basic_surface<detail::owner_tag>;
+using surface_handle = basic_surface<detail::handle_tag>;
+using pixel_format_info = basic_pixel_format_info<detail::owner_tag>;
+using pixel_format_info_handle = basic_pixel_format_info<detail::handle_tag>;
+using gl_context = basic_gl_context<detail::owner_tag>;
+using gl_context_handle = basic_gl_context<detail::handle_tag>;
+using sound_effect = basic_sound_effect<detail::owner_tag>;
+using sound_effect_handle = basic_sound_effect<detail::handle_tag>;
+using controller = basic_controller<detail::owner_tag>;
+using controller_handle = basic_controller<detail::handle_tag>;
+using joystick = basic_joystick<detail::owner_tag>;
+using joystick_handle = basic_joystick<detail::handle_tag>;
+using cursor = basic_cursor<detail::owner_tag>;
+using cursor_handle = basic_cursor<detail::handle_tag>;
+using sensor = basic_sensor<detail::owner_tag>;
+using sensor_handle = basic_sensor<detail::handle_tag>;
+
 }  // namespace cen
 
 #endif  // CENTURION_FWD_HPP_
@@ -27,12 +27,23 @@
 
 #include <SDL.h>
 
-#include <cassert>   // assert
-#include <optional>  // optional
+#include <atomic>       // atomic
+#include <cassert>      // assert
+#include <optional>     // optional
+#include <string>       // string
+#include <string_view>  // string_view
+#include <vector>       // vector
 
+#include "common/allocation_tracking.hpp"
 #include "common/primitives.hpp"
 #include "common/errors.hpp"
+#include "common/result.hpp"
+#include "concurrency/locks.hpp"
+#include "concurrency/mutex.hpp"
+#include "concurrency/spin_lock.hpp"
+#include "concurrency/thread.hpp"
 #include "features.hpp"
+#include "system/timer.hpp"
 
 #ifndef CENTURION_NO_SDL_IMAGE
 #include <SDL_image.h>
@@ -51,11 +62,18 @@ namespace cen {
 /// Used to specify how the core SDL library is initialized.
 struct sdl_cfg final {
   uint32 flags {SDL_INIT_EVERYTHING};
+  bool track_allocations {false};     ///< Track memory, see `allocation_statistics()`.
+  maybe<memory_functions> allocator;  ///< Custom memory functions used by SDL, if any.
+  const char* video_driver {};        ///< Overrides the video driver, e.g. "dummy".
+  const char* audio_driver {};        ///< Overrides the audio driver, e.g. "disk".
 };
 
 /**
  * Used to load and subsequently unload the core SDL library.
  *
+ * Custom memory functions and allocation tracking are installed before SDL is initialized,
+ * so the `sdl` instance must be created before calling any other SDL function.
+ *
  * \see img
  * \see mix
  * \see ttf
@@ -64,6 +82,28 @@ class sdl final {
  public:
   CENTURION_NODISCARD_CTOR explicit sdl(const sdl_cfg& cfg = {})
   {
+    if (cfg.track_allocations) {
+      const auto allocator = cfg.allocator.value_or(current_memory_functions());
+      if (!enable_allocation_tracking(allocator)) {
+        throw exception {"Failed to enable allocation tracking!"};
+      }
+    }
+    else if (cfg.allocator) {
+      if (!set_memory_functions(*cfg.allocator)) {
+        throw exception {"Failed to set memory functions!"};
+      }
+    }
+
+    /* The drivers are selected through the environment, since the driver hints are only
+       respected by SDL 2.0.22 and later */
+    if (cfg.video_driver) {
+      SDL_setenv("SDL_VIDEODRIVER", cfg.video_driver, 1);
+    }
+
+    if (cfg.audio_driver) {
+      SDL_setenv("SDL_AUDIODRIVER", cfg.audio_driver, 1);
+    }
+
     if (SDL_Init(cfg.flags) < 0) {
       throw sdl_error {};
     }
@@ -96,26 +136,61 @@ class img final {
 
 #ifndef CENTURION_NO_SDL_MIXER
 
-/// Used to specify how the SDL_mixer library is initialized.
+/**
+ * Used to specify how the SDL_mixer library is initialized.
+ *
+ * The chunk size is the amount of sample frames in each audio buffer, and is the main factor
+ * of the output latency. Small buffers, e.g. 256 frames at 48 kHz for roughly 5 ms, suit
+ * rhythm games, whereas large buffers require less CPU time.
+ */
 struct mix_cfg final {
   int flags {MIX_INIT_MP3 | MIX_INIT_OGG | MIX_INIT_FLAC | MIX_INIT_MID | MIX_INIT_MOD |
              MIX_INIT_OPUS};
-  int frequency {MIX_DEFAULT_FREQUENCY};
-  uint16 format {MIX_DEFAULT_FORMAT};
-  int channels {MIX_DEFAULT_CHANNELS};
-  int chunk_size {4096};
+  int frequency {MIX_DEFAULT_FREQUENCY};  ///< The sample rate, in Hz.
+  uint16 format {MIX_DEFAULT_FORMAT};     ///< The sample format, e.g. `AUDIO_F32SYS`.
+  int channels {MIX_DEFAULT_CHANNELS};    ///< The amount of output channels.
+  int chunk_size {4096};                  ///< The size of the audio buffers, in sample frames.
+  const char* device {};                  ///< The name of the device, null for the default.
+
+  /// The `SDL_AUDIO_ALLOW_*` flags for the parts of the spec that SDL may change.
+  int allowed_changes {SDL_AUDIO_ALLOW_FREQUENCY_CHANGE | SDL_AUDIO_ALLOW_CHANNELS_CHANGE};
+};
+
+/// Describes the negotiated format of an opened audio device.
+struct mix_spec final {
+  int frequency {};  ///< The sample rate, in Hz.
+  uint16 format {};  ///< The sample format.
+  int channels {};   ///< The amount of output channels.
 };
 
+/// Returns the format of the opened audio device, if the device is open.
+[[nodiscard]] inline auto query_mix_spec() noexcept -> maybe<mix_spec>
+{
+  mix_spec spec;
+  if (Mix_QuerySpec(&spec.frequency, &spec.format, &spec.channels)) {
+    return spec;
+  }
+  else {
+    return nothing;
+  }
+}
+
 /// Used to load and subsequently unload the SDL_mixer library.
 class mix final {
  public:
-  CENTURION_NODISCARD_CTOR explicit mix(const mix_cfg& cfg = {})
+  CENTURION_NODISCARD_CTOR explicit mix(const mix_cfg& cfg = {}) : mChunkSize {cfg.chunk_size}
   {
-    if (!Mix_Init(cfg.flags)) {
+    /* No flags means that no decoders are needed, which Mix_Init() reports as a failure */
+    if (cfg.flags != 0 && !Mix_Init(cfg.flags)) {
       throw mix_error {};
     }
 
-    if (Mix_OpenAudio(cfg.frequency, cfg.format, cfg.channels, cfg.chunk_size) == -1) {
+    if (Mix_OpenAudioDevice(cfg.frequency,
+                            cfg.format,
+                            cfg.channels,
+                            cfg.chunk_size,
+                            cfg.device,
+                            cfg.allowed_changes) == -1) {
       throw mix_error {};
     }
   }
@@ -125,6 +200,35 @@ class mix final {
     Mix_CloseAudio();
     Mix_Quit();
   }
+
+  /// Returns the format of the audio device, which may differ from the requested format.
+  [[nodiscard]] auto spec() const noexcept -> maybe<mix_spec> { return query_mix_spec(); }
+
+  /**
+   * Returns the estimated output latency.
+   *
+   * \details The estimate is the duration of a single audio buffer at the negotiated sample
+   *          rate, which is a lower bound of the latency. The audio driver and hardware
+   *          typically add a few milliseconds on top of this.
+   *
+   * \return the estimated latency; an empty optional if the device isn't open.
+   */
+  [[nodiscard]] auto estimated_latency() const noexcept -> maybe<millis<double>>
+  {
+    if (const auto current = spec(); current && current->frequency > 0) {
+      return millis<double> {1'000.0 * static_cast<double>(mChunkSize) /
+                             static_cast<double>(current->frequency)};
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Returns the requested size of the audio buffers, in sample frames.
+  [[nodiscard]] auto chunk_size() const noexcept -> int { return mChunkSize; }
+
+ private:
+  int mChunkSize {};
 };
 
 #endif  // CENTURION_NO_SDL_MIXER
@@ -146,6 +250,285 @@ class ttf final {
 
 #endif  // CENTURION_NO_SDL_TTF
 
+/// The time it took to initialize a single subsystem.
+struct init_timing final {
+  std::string_view name;
+  millis<double> duration {};
+  bool succeeded {};
+};
+
+/// Used to specify how the `initializer` loads the libraries.
+struct initializer_cfg final {
+  /// The core configuration, only cheap subsystems should be initialized up front.
+  sdl_cfg core {SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER, false, nothing};
+
+  /// A game controller mapping file that is loaded along with the controller subsystem.
+  const char* controller_db {};
+
+  bool parallel {true};  ///< Initialize the extension libraries on a background thread.
+
+#ifndef CENTURION_NO_SDL_IMAGE
+  maybe<img_cfg> image {img_cfg {}};  ///< Nothing to skip SDL_image.
+#endif  // CENTURION_NO_SDL_IMAGE
+
+#ifndef CENTURION_NO_SDL_MIXER
+  maybe<mix_cfg> mixer {mix_cfg {}};  ///< Nothing to skip SDL_mixer.
+#endif  // CENTURION_NO_SDL_MIXER
+
+#ifndef CENTURION_NO_SDL_TTF
+  bool ttf {true};
+#endif  // CENTURION_NO_SDL_TTF
+};
+
+/**
+ * Returns an initializer configuration for dedicated servers and other headless processes.
+ *
+ * The dummy video and audio drivers are used, so no windows or audio devices are opened, but
+ * the usual APIs keep working. Windows and renderers can still be created, using the
+ * software renderer, and presenting is a no-op. SDL_mixer opens a silent audio device, so
+ * sounds and music can be played as usual, without any output. The mixer doesn't load any
+ * decoders up front and uses a low sample rate, to keep the cost of the audio thread down.
+ *
+ * Neither SDL_image nor SDL_ttf are initialized, although images can still be loaded since
+ * SDL_image loads its codecs on demand. Everything is initialized on the calling thread,
+ * since there are no slow devices to wait for.
+ *
+ * \return a configuration for headless processes, which can be adjusted further.
+ *
+ * \see is_headless()
+ */
+[[nodiscard]] inline auto headless_cfg() noexcept -> initializer_cfg
+{
+  initializer_cfg cfg;
+  cfg.core.flags = SDL_INIT_VIDEO | SDL_INIT_EVENTS | SDL_INIT_TIMER;
+  cfg.core.video_driver = "dummy";
+  cfg.core.audio_driver = "dummy";
+  cfg.parallel = false;
+
+#ifndef CENTURION_NO_SDL_IMAGE
+  cfg.image = nothing;
+#endif  // CENTURION_NO_SDL_IMAGE
+
+#ifndef CENTURION_NO_SDL_MIXER
+  mix_cfg mixer;
+  mixer.flags = 0;
+  mixer.frequency = 22'050;
+  mixer.channels = 1;
+  mixer.chunk_size = 8'192;
+  cfg.mixer = mixer;
+#endif  // CENTURION_NO_SDL_MIXER
+
+#ifndef CENTURION_NO_SDL_TTF
+  cfg.ttf = false;
+#endif  // CENTURION_NO_SDL_TTF
+
+  return cfg;
+}
+
+/// Indicates whether the video subsystem is uninitialized or uses a headless driver.
+[[nodiscard]] inline auto is_headless() noexcept -> bool
+{
+  const auto* driver = SDL_GetCurrentVideoDriver();
+  if (!driver) {
+    return true;
+  }
+
+  const std::string_view name {driver};
+  return name == "dummy" || name == "offscreen";
+}
+
+/**
+ * Loads SDL and its extension libraries, deferring expensive work.
+ *
+ * Only the core subsystems are initialized by the constructor, on the calling thread, along
+ * with SDL_ttf, which is cheap. The SDL_image codecs, the audio subsystem and the SDL_mixer
+ * audio device are initialized on a background thread, since loading codecs and opening
+ * audio devices may take hundreds of milliseconds. Other subsystems, e.g. joysticks and
+ * haptics, are initialized on first use, see `require()`.
+ *
+ * Subsystems should only be initialized through `require()` while the background work is in
+ * progress, since SDL doesn't synchronize subsystem initialization. The time spent on each
+ * subsystem is recorded, see `timings()`.
+ *
+ * \see sdl
+ * \see img
+ * \see mix
+ * \see ttf
+ */
+class initializer final {
+ public:
+  CENTURION_NODISCARD_CTOR explicit initializer(const initializer_cfg& cfg = {})
+      : mCfg {cfg}
+      , mCore {cfg.core}
+  {
+    record("core", mCreated, true);
+
+#ifndef CENTURION_NO_SDL_TTF
+    if (mCfg.ttf) {
+      const auto start = now();
+      mTtf.emplace();
+      record("ttf", start, true);
+    }
+#endif  // CENTURION_NO_SDL_TTF
+
+    if (mCfg.parallel) {
+      mWorker.emplace(&initializer::run, "cen-init", this);
+    }
+    else {
+      run(this);
+    }
+  }
+
+  CENTURION_DISABLE_COPY(initializer)
+  CENTURION_DISABLE_MOVE(initializer)
+
+  /**
+   * Initializes SDL subsystems, if they aren't already initialized.
+   *
+   * \details This should be called before a subsystem is used for the first time, e.g. with
+   * `SDL_INIT_GAMECONTROLLER` before the first controller is opened. Subsystems are
+   * initialized on the calling thread, which should usually be the main thread.
+   *
+   * \param flags the `SDL_INIT_*` flags of the subsystems that will be initialized.
+   *
+   * \return `success` if all subsystems are initialized; `failure` otherwise.
+   */
+  auto require(const uint32 flags) -> result
+  {
+    scoped_lock lock {mInitMutex};
+
+    /* Dependencies are initialized before the subsystems that use them */
+    constexpr struct {
+      uint32 flag;
+      std::string_view name;
+    } subsystems[] = {{SDL_INIT_TIMER, "timer"},
+                      {SDL_INIT_EVENTS, "events"},
+                      {SDL_INIT_VIDEO, "video"},
+                      {SDL_INIT_AUDIO, "audio"},
+                      {SDL_INIT_JOYSTICK, "joystick"},
+                      {SDL_INIT_HAPTIC, "haptic"},
+                      {SDL_INIT_GAMECONTROLLER, "game_controller"},
+                      {SDL_INIT_SENSOR, "sensor"}};
+
+    bool succeeded = true;
+    for (const auto& [flag, name] : subsystems) {
+      if ((flags & flag) && !SDL_WasInit(flag)) {
+        const auto start = now();
+        const auto ok = SDL_InitSubSystem(flag) == 0;
+        record(name, start, ok);
+
+        if (ok && flag == SDL_INIT_GAMECONTROLLER && mCfg.controller_db) {
+          const auto dbStart = now();
+          record("controller_db",
+                 dbStart,
+                 SDL_GameControllerAddMappingsFromFile(mCfg.controller_db) >= 0);
+        }
+
+        succeeded = succeeded && ok;
+      }
+    }
+
+    return succeeded;
+  }
+
+  /**
+   * Blocks until the background initialization has finished.
+   *
+   * \throws exception if an extension library failed to initialize.
+   */
+  void wait()
+  {
+    if (mWorker && mWorker->joinable()) {
+      mWorker->join();
+    }
+
+    if (!mError.empty()) {
+      throw exception {mError.c_str()};
+    }
+  }
+
+  /// Indicates whether the background initialization has finished.
+  [[nodiscard]] auto is_ready() const noexcept -> bool
+  {
+    return mReady.load(std::memory_order_acquire);
+  }
+
+  /// Returns the time spent on each initialized subsystem so far, in initialization order.
+  [[nodiscard]] auto timings() const -> std::vector<init_timing>
+  {
+    scoped_lock lock {mTimingLock};
+    return mTimings;
+  }
+
+ private:
+  initializer_cfg mCfg;
+  mutex mInitMutex;  ///< Serializes subsystem initialization across threads.
+  mutable spin_lock mTimingLock;
+  std::vector<init_timing> mTimings;
+  std::string mError;  ///< Only written by the worker, before the ready flag is set.
+  std::atomic<bool> mReady {false};
+  uint64 mCreated {now()};  ///< Must precede the core, so that it is included in its timing.
+
+  sdl mCore;
+
+#ifndef CENTURION_NO_SDL_TTF
+  maybe<ttf> mTtf;
+#endif  // CENTURION_NO_SDL_TTF
+
+#ifndef CENTURION_NO_SDL_IMAGE
+  maybe<img> mImg;
+#endif  // CENTURION_NO_SDL_IMAGE
+
+#ifndef CENTURION_NO_SDL_MIXER
+  maybe<mix> mMix;
+#endif  // CENTURION_NO_SDL_MIXER
+
+  maybe<thread> mWorker;  ///< Must be the last member, so that it is joined first.
+
+  void record(const std::string_view name, const uint64 start, const bool succeeded)
+  {
+    const auto ticks = static_cast<double>(now() - start);
+    const millis<double> duration {1'000.0 * ticks / static_cast<double>(frequency())};
+
+    scoped_lock lock {mTimingLock};
+    mTimings.push_back({name, duration, succeeded});
+  }
+
+  static auto SDLCALL run(void* data) -> int
+  {
+    auto* self = static_cast<initializer*>(data);
+
+    try {
+#ifndef CENTURION_NO_SDL_IMAGE
+      if (self->mCfg.image) {
+        const auto start = now();
+        self->mImg.emplace(*self->mCfg.image);
+        self->record("image", start, true);
+      }
+#endif  // CENTURION_NO_SDL_IMAGE
+
+#ifndef CENTURION_NO_SDL_MIXER
+      if (self->mCfg.mixer) {
+        /* SDL_mixer initializes the audio subsystem itself, which must be synchronized */
+        if (!self->require(SDL_INIT_AUDIO)) {
+          throw sdl_error {};
+        }
+
+        const auto start = now();
+        self->mMix.emplace(*self->mCfg.mixer);
+        self->record("mixer", start, true);
+      }
+#endif  // CENTURION_NO_SDL_MIXER
+    }
+    catch (const std::exception& e) {
+      self->mError = e.what();
+    }
+
+    self->mReady.store(true, std::memory_order_release);
+    return 0;
+  }
+};
+
 }  // namespace cen
 
 #endif  // CENTURION_INITIALIZATION_HPP_
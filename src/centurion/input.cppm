@@ -0,0 +1,298 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+module;
+
+#include "centurion/input.hpp"
+
+export module centurion:input;
+
+export namespace cen {
+
+using cen::button_state;
+using cen::to_string;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::operator<<;
+
+#endif  // CENTURION_NO_IOSTREAM
+
+using cen::controller_button;
+using cen::controller_axis;
+using cen::controller_bind_type;
+
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+using cen::controller_type;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
+
+using cen::controller_mapping_result;
+using cen::controller_finger_state;
+using cen::basic_controller;
+using cen::controller;
+using cen::controller_handle;
+using cen::add_controller_mapping;
+using cen::load_controller_mappings;
+using cen::controller_mapping_count;
+
+using cen::controller_db_cfg;
+using cen::controller_db;
+
+using cen::controller_state;
+using cen::capture;
+using cen::poll_all_controllers;
+
+using cen::device_registry;
+
+using cen::rumble_mix;
+using cen::rumble_effect;
+using cen::rumble_scheduler;
+
+using cen::input_map;
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+using cen::stress_input;
+using cen::stress_step;
+using cen::stress_script;
+using cen::stress_cfg;
+using cen::input_stress;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+
+using cen::ball_axis_delta;
+using cen::joystick_type;
+using cen::joystick_power;
+using cen::hat_state;
+
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+using cen::virtual_joystick_desc;
+#endif  // SDL_VERSION_ATLEAST(2, 24, 0)
+
+using cen::basic_joystick;
+using cen::joystick;
+using cen::joystick_handle;
+
+using cen::key_mod;
+using cen::operator~;
+using cen::operator&;
+using cen::operator|;
+using cen::set_modifiers;
+using cen::get_modifiers;
+using cen::is_active;
+using cen::is_only_active;
+using cen::is_only_subset_active;
+using cen::key_code;
+using cen::operator==;
+using cen::operator!=;
+using cen::scan_code;
+using cen::keyboard;
+using cen::has_screen_keyboard;
+
+using cen::keyboard_snapshot;
+using cen::keyboard_state;
+
+using cen::input_snapshot;
+using cen::input_delta_encoder;
+using cen::input_delta_decoder;
+using cen::input_history;
+
+using cen::system_cursor;
+using cen::system_cursor_count;
+using cen::mouse_button;
+using cen::mouse;
+using cen::basic_cursor;
+using cen::cursor;
+using cen::cursor_handle;
+using cen::cursor_cache;
+
+using cen::mouse_sample;
+using cen::mouse_history;
+
+using cen::sensor_id;
+using cen::standard_gravity;
+using cen::sensor_type;
+using cen::basic_sensor;
+using cen::sensor;
+using cen::sensor_handle;
+
+using cen::sensor_sample;
+using cen::sensor_buffer;
+
+using cen::touch_id;
+using cen::touch_mouse_id;
+using cen::mouse_touch_id;
+using cen::touch_device_type;
+using cen::finger;
+using cen::touch_device_count;
+using cen::get_touch_device;
+using cen::get_touch_type;
+using cen::get_touch_finger_count;
+
+using cen::tracked_finger;
+using cen::touch_tracker;
+
+}  // namespace cen
+
+export namespace cen::keycodes {
+
+using cen::keycodes::unknown;
+using cen::keycodes::a;
+using cen::keycodes::b;
+using cen::keycodes::c;
+using cen::keycodes::d;
+using cen::keycodes::e;
+using cen::keycodes::f;
+using cen::keycodes::g;
+using cen::keycodes::h;
+using cen::keycodes::i;
+using cen::keycodes::j;
+using cen::keycodes::k;
+using cen::keycodes::l;
+using cen::keycodes::m;
+using cen::keycodes::n;
+using cen::keycodes::o;
+using cen::keycodes::p;
+using cen::keycodes::q;
+using cen::keycodes::r;
+using cen::keycodes::s;
+using cen::keycodes::t;
+using cen::keycodes::u;
+using cen::keycodes::v;
+using cen::keycodes::w;
+using cen::keycodes::x;
+using cen::keycodes::y;
+using cen::keycodes::z;
+using cen::keycodes::one;
+using cen::keycodes::two;
+using cen::keycodes::three;
+using cen::keycodes::four;
+using cen::keycodes::five;
+using cen::keycodes::six;
+using cen::keycodes::seven;
+using cen::keycodes::eight;
+using cen::keycodes::nine;
+using cen::keycodes::zero;
+using cen::keycodes::f1;
+using cen::keycodes::f2;
+using cen::keycodes::f3;
+using cen::keycodes::f4;
+using cen::keycodes::f5;
+using cen::keycodes::f6;
+using cen::keycodes::f7;
+using cen::keycodes::f8;
+using cen::keycodes::f9;
+using cen::keycodes::f10;
+using cen::keycodes::f11;
+using cen::keycodes::f12;
+using cen::keycodes::left;
+using cen::keycodes::right;
+using cen::keycodes::up;
+using cen::keycodes::down;
+using cen::keycodes::space;
+using cen::keycodes::enter;
+using cen::keycodes::escape;
+using cen::keycodes::backspace;
+using cen::keycodes::tab;
+using cen::keycodes::caps_lock;
+using cen::keycodes::left_shift;
+using cen::keycodes::right_shift;
+using cen::keycodes::left_ctrl;
+using cen::keycodes::right_ctrl;
+using cen::keycodes::left_alt;
+using cen::keycodes::right_alt;
+using cen::keycodes::left_gui;
+using cen::keycodes::right_gui;
+
+}  // namespace cen::keycodes
+
+export namespace cen::scancodes {
+
+using cen::scancodes::unknown;
+using cen::scancodes::a;
+using cen::scancodes::b;
+using cen::scancodes::c;
+using cen::scancodes::d;
+using cen::scancodes::e;
+using cen::scancodes::f;
+using cen::scancodes::g;
+using cen::scancodes::h;
+using cen::scancodes::i;
+using cen::scancodes::j;
+using cen::scancodes::k;
+using cen::scancodes::l;
+using cen::scancodes::m;
+using cen::scancodes::n;
+using cen::scancodes::o;
+using cen::scancodes::p;
+using cen::scancodes::q;
+using cen::scancodes::r;
+using cen::scancodes::s;
+using cen::scancodes::t;
+using cen::scancodes::u;
+using cen::scancodes::v;
+using cen::scancodes::w;
+using cen::scancodes::x;
+using cen::scancodes::y;
+using cen::scancodes::z;
+using cen::scancodes::one;
+using cen::scancodes::two;
+using cen::scancodes::three;
+using cen::scancodes::four;
+using cen::scancodes::five;
+using cen::scancodes::six;
+using cen::scancodes::seven;
+using cen::scancodes::eight;
+using cen::scancodes::nine;
+using cen::scancodes::zero;
+using cen::scancodes::f1;
+using cen::scancodes::f2;
+using cen::scancodes::f3;
+using cen::scancodes::f4;
+using cen::scancodes::f5;
+using cen::scancodes::f6;
+using cen::scancodes::f7;
+using cen::scancodes::f8;
+using cen::scancodes::f9;
+using cen::scancodes::f10;
+using cen::scancodes::f11;
+using cen::scancodes::f12;
+using cen::scancodes::left;
+using cen::scancodes::right;
+using cen::scancodes::up;
+using cen::scancodes::down;
+using cen::scancodes::space;
+using cen::scancodes::enter;
+using cen::scancodes::escape;
+using cen::scancodes::backspace;
+using cen::scancodes::tab;
+using cen::scancodes::caps_lock;
+using cen::scancodes::left_shift;
+using cen::scancodes::right_shift;
+using cen::scancodes::left_ctrl;
+using cen::scancodes::right_ctrl;
+using cen::scancodes::left_alt;
+using cen::scancodes::right_alt;
+using cen::scancodes::left_gui;
+using cen::scancodes::right_gui;
+
+}  // namespace cen::scancodes
@@ -24,8 +24,20 @@
 
 #include "input/button_state.hpp"
 #include "input/controller.hpp"
+#include "input/controller_db.hpp"
+#include "input/controller_state.hpp"
+#include "input/cursor_cache.hpp"
+#include "input/device_registry.hpp"
+#include "input/input_delta.hpp"
+#include "input/input_map.hpp"
+#include "input/input_stress.hpp"
 #include "input/joystick.hpp"
 #include "input/keyboard.hpp"
+#include "input/keyboard_snapshot.hpp"
 #include "input/mouse.hpp"
+#include "input/mouse_history.hpp"
+#include "input/rumble_scheduler.hpp"
 #include "input/sensor.hpp"
-#include "input/touch.hpp"
\ No newline at end of file
+#include "input/sensor_buffer.hpp"
+#include "input/touch.hpp"
+#include "input/touch_tracker.hpp"
\ No newline at end of file
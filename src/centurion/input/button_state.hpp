@@ -27,12 +27,17 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/primitives.hpp"
 #include "../common/errors.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class button_state : uint8 {
@@ -54,11 +59,15 @@ enum class button_state : uint8 {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const button_state state) -> std::ostream&
 {
   return stream << to_string(state);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_INPUT_BUTTON_STATE_HPP_
@@ -31,7 +31,6 @@
 #include <cassert>      // assert
 #include <cstddef>      // size_t
 #include <optional>     // optional
-#include <ostream>      // ostream
 #include <string>       // string
 #include <string_view>  // string_view
 
@@ -56,6 +55,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class controller_button {
@@ -176,11 +181,15 @@ enum class controller_button {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const controller_button button) -> std::ostream&
 {
   return stream << to_string(button);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 enum class controller_axis {
   invalid = SDL_CONTROLLER_AXIS_INVALID,
 
@@ -227,11 +236,15 @@ enum class controller_axis {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const controller_axis axis) -> std::ostream&
 {
   return stream << to_string(axis);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 enum class controller_bind_type {
   none = SDL_CONTROLLER_BINDTYPE_NONE,
   button = SDL_CONTROLLER_BINDTYPE_BUTTON,
@@ -259,11 +272,15 @@ enum class controller_bind_type {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const controller_bind_type type) -> std::ostream&
 {
   return stream << to_string(type);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 #if SDL_VERSION_ATLEAST(2, 0, 12)
 
 enum class controller_type {
@@ -336,11 +353,15 @@ enum class controller_type {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const controller_type type) -> std::ostream&
 {
   return stream << to_string(type);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 #endif  // SDL_VERSION_ATLEAST(2, 0, 12)
 
 enum class controller_mapping_result {
@@ -366,12 +387,16 @@ enum class controller_mapping_result {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const controller_mapping_result result)
     -> std::ostream&
 {
   return stream << to_string(result);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 struct controller_finger_state final {
   button_state state {};  ///< Whether the finger is pressed or release.
   float x {};             ///< The current x-coordinate.
@@ -959,12 +984,16 @@ template <typename T>
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_controller<T>& controller) -> std::ostream&
 {
   return stream << to_string(controller);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_INPUT_CONTROLLER_HPP_
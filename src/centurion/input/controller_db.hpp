@@ -0,0 +1,309 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_INPUT_CONTROLLER_DB_HPP_
+#define CENTURION_INPUT_CONTROLLER_DB_HPP_
+
+#include <SDL.h>
+
+#include <atomic>       // atomic
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <utility>      // move
+
+#include "../common/primitives.hpp"
+#include "../concurrency/thread.hpp"
+#include "../io/asset_pack.hpp"
+#include "../io/file.hpp"
+#include "../io/file_mode.hpp"
+
+namespace cen {
+
+/// Used to specify how controller mappings are loaded by `controller_db`.
+struct controller_db_cfg final {
+  std::string platform {SDL_GetPlatform()};  ///< The platform that mappings are filtered for.
+  std::string cache_path;  ///< The file that filtered mappings are cached in, if any.
+};
+
+namespace detail {
+
+inline constexpr std::string_view controller_db_cache_magic = "# centurion controller db ";
+
+/**
+ * Returns the mappings in a game controller database that apply to a platform.
+ *
+ * \details Comments and empty lines are removed, as are mappings with a platform field that
+ * doesn't match the specified platform. Mappings without a platform field are kept, since SDL
+ * applies them to all platforms.
+ */
+[[nodiscard]] inline auto filter_controller_mappings(const std::string_view db,
+                                                     const std::string_view platform)
+    -> std::string
+{
+  constexpr std::string_view field = "platform:";
+
+  std::string result;
+
+  usize begin = 0;
+  while (begin < db.size()) {
+    auto end = db.find('\n', begin);
+    if (end == std::string_view::npos) {
+      end = db.size();
+    }
+
+    auto line = db.substr(begin, end - begin);
+    begin = end + 1;
+
+    if (!line.empty() && line.back() == '\r') {
+      line.remove_suffix(1);
+    }
+
+    if (line.empty() || line.front() == '#') {
+      continue;
+    }
+
+    if (const auto pos = line.find(field); pos != std::string_view::npos) {
+      auto value = line.substr(pos + field.size());
+      value = value.substr(0, value.find(','));
+
+      if (value != platform) {
+        continue;
+      }
+    }
+
+    result.append(line);
+    result.push_back('\n');
+  }
+
+  return result;
+}
+
+/* The cache key covers both the source database and the platform it was filtered for */
+[[nodiscard]] inline auto controller_db_key(const std::string_view db,
+                                            const std::string_view platform) noexcept
+    -> uint64
+{
+  return asset_hash(db) ^ (asset_hash(platform) * 0x9E3779B97F4A7C15);
+}
+
+}  // namespace detail
+
+/**
+ * Loads a game controller mapping database on a worker thread.
+ *
+ * The community game controller database contains thousands of mappings for all platforms,
+ * and SDL parses every line of it on the calling thread. This class reads the database from
+ * memory or from an asset pack on a worker thread, and only keeps the mappings that apply to
+ * the current platform, so that `apply()` only hands a fraction of the database to SDL.
+ *
+ * If a cache path is specified, the filtered mappings are also written to disk, and later
+ * loads of the same database for the same platform use the cached result instead of
+ * filtering the database again.
+ *
+ * \see load_controller_mappings
+ */
+class controller_db final {
+ public:
+  /**
+   * Starts filtering a database that is stored in memory.
+   *
+   * \param db the contents of the database.
+   * \param cfg the configuration of the loader.
+   */
+  explicit controller_db(std::string db, controller_db_cfg cfg = {})
+      : mCfg {std::move(cfg)}
+      , mSource {std::move(db)}
+      , mView {mSource}
+      , mThread {&controller_db::run, "cen-controller-db", this}
+  {
+  }
+
+  /**
+   * Starts filtering a database that is stored in an asset pack.
+   *
+   * \param pack the asset pack, which must outlive the loader.
+   * \param name the name of the database entry.
+   * \param cfg the configuration of the loader.
+   */
+  controller_db(const asset_pack& pack,
+                const std::string_view name,
+                controller_db_cfg cfg = {})
+      : mCfg {std::move(cfg)}
+      , mView {view_of(pack, name)}
+      , mThread {&controller_db::run, "cen-controller-db", this}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(controller_db)
+  CENTURION_DISABLE_MOVE(controller_db)
+
+  /**
+   * Adds the filtered mappings to SDL, blocking until the worker has finished.
+   *
+   * \return the amount of added mappings; an empty optional if something went wrong.
+   */
+  auto apply() -> maybe<int>
+  {
+    wait();
+
+    if (!mSucceeded) {
+      return nothing;
+    }
+    else if (mMappings.empty()) {
+      return 0;
+    }
+
+    const auto size = static_cast<int>(mMappings.size());
+    const auto result =
+        SDL_GameControllerAddMappingsFromRW(SDL_RWFromConstMem(mMappings.data(), size), 1);
+
+    if (result != -1) {
+      return result;
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Blocks until the worker has finished.
+  void wait() noexcept
+  {
+    if (mThread.joinable()) {
+      mThread.join();
+    }
+  }
+
+  /// Indicates whether the worker has finished.
+  [[nodiscard]] auto is_ready() const noexcept -> bool
+  {
+    return mReady.load(std::memory_order_acquire);
+  }
+
+  /// Returns the filtered mappings, blocking until the worker has finished.
+  [[nodiscard]] auto mappings() -> std::string_view
+  {
+    wait();
+    return mMappings;
+  }
+
+  /// Indicates whether the filtered mappings were read from the cache.
+  [[nodiscard]] auto from_cache() -> bool
+  {
+    wait();
+    return mFromCache;
+  }
+
+ private:
+  controller_db_cfg mCfg;
+  std::string mSource;
+  std::string_view mView;
+  std::string mMappings;
+  bool mSucceeded {};
+  bool mFromCache {};
+  std::atomic<bool> mReady {false};
+  thread mThread;  ///< Must be the last member, so that it starts after initialization.
+
+  [[nodiscard]] static auto view_of(const asset_pack& pack, const std::string_view name)
+      -> std::string_view
+  {
+    if (const auto entry = pack.find(name);
+        entry && entry->compression == asset_compression::none) {
+      return {reinterpret_cast<const char*>(pack.data(*entry)), entry->size};
+    }
+    else {
+      return {};
+    }
+  }
+
+  [[nodiscard]] static auto read_cache(const std::string& path, const std::string& header)
+      -> maybe<std::string>
+  {
+    file cache {path, file_mode::rb};
+    if (!cache) {
+      return nothing;
+    }
+
+    const auto size = cache.size();
+    if (!size || *size < header.size()) {
+      return nothing;
+    }
+
+    std::string contents(*size, '\0');
+    if (cache.read_to(contents.data(), contents.size()) != contents.size() ||
+        contents.compare(0, header.size(), header) != 0) {
+      return nothing;
+    }
+
+    return contents.substr(header.size());
+  }
+
+  static void write_cache(const std::string& path,
+                          const std::string& header,
+                          const std::string& mappings)
+  {
+    /* Caching is an optimization, so failing to write the cache isn't an error */
+    if (file cache {path, file_mode::wb}) {
+      cache.write(header.data(), header.size());
+      cache.write(mappings.data(), mappings.size());
+    }
+  }
+
+  static auto SDLCALL run(void* data) -> int
+  {
+    auto* self = static_cast<controller_db*>(data);
+
+    if (!self->mView.empty()) {
+      const auto& cfg = self->mCfg;
+
+      std::string header {detail::controller_db_cache_magic};
+      header += std::to_string(detail::controller_db_key(self->mView, cfg.platform));
+      header += '\n';
+
+      if (!cfg.cache_path.empty()) {
+        if (auto cached = read_cache(cfg.cache_path, header)) {
+          self->mMappings = std::move(*cached);
+          self->mFromCache = true;
+        }
+      }
+
+      if (!self->mFromCache) {
+        self->mMappings = detail::filter_controller_mappings(self->mView, cfg.platform);
+
+        if (!cfg.cache_path.empty()) {
+          write_cache(cfg.cache_path, header, self->mMappings);
+        }
+      }
+
+      self->mSucceeded = true;
+    }
+
+    self->mReady.store(true, std::memory_order_release);
+    return 0;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_CONTROLLER_DB_HPP_
@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_INPUT_CONTROLLER_STATE_HPP_
+#define CENTURION_INPUT_CONTROLLER_STATE_HPP_
+
+#include <SDL.h>
+
+#include <array>        // array
+#include <type_traits>  // is_trivially_copyable_v
+#include <vector>       // vector
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "button_state.hpp"
+#include "controller.hpp"
+
+namespace cen {
+
+/**
+ * A plain snapshot of the state of a game controller.
+ *
+ * Snapshots are trivially copyable, so they can be stored and sent over the network as plain
+ * memory. Use `capture()` to create a snapshot of a single controller, or
+ * `poll_all_controllers()` to obtain snapshots of all open controllers.
+ *
+ * \see poll_all_controllers()
+ */
+struct controller_state final {
+  inline constexpr static int button_count = SDL_CONTROLLER_BUTTON_MAX;
+  inline constexpr static int axis_count = SDL_CONTROLLER_AXIS_MAX;
+
+  static_assert(button_count <= 32, "Controller buttons don't fit in the button mask!");
+
+  SDL_JoystickID id {-1};                 ///< The joystick instance ID of the controller.
+  uint32 buttons {};                      ///< The pressed buttons, as a mask of button bits.
+  std::array<int16, axis_count> axes {};  ///< The values of all axes.
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+
+  inline constexpr static int max_fingers = 2;
+
+  /// The fingers on the first touchpad, released if there is no such finger.
+  std::array<controller_finger_state, max_fingers> fingers {};
+  std::array<float, 3> gyro {};   ///< Gyroscope data, if the gyroscope is enabled.
+  std::array<float, 3> accel {};  ///< Accelerometer data, if the accelerometer is enabled.
+  bool has_gyro {};               ///< Indicates whether the gyroscope data is valid.
+  bool has_accel {};              ///< Indicates whether the accelerometer data is valid.
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+
+  /// Indicates whether a button is pressed.
+  [[nodiscard]] constexpr auto is_pressed(const controller_button button) const noexcept
+      -> bool
+  {
+    const auto index = to_underlying(button);
+    return index >= 0 && index < button_count && (buttons & (uint32 {1} << index));
+  }
+
+  /// Returns the value of an axis.
+  [[nodiscard]] constexpr auto axis(const controller_axis axis) const noexcept -> int16
+  {
+    const auto index = to_underlying(axis);
+    if (index >= 0 && index < axis_count) {
+      return axes[static_cast<usize>(index)];
+    }
+    else {
+      return 0;
+    }
+  }
+};
+
+static_assert(std::is_trivially_copyable_v<controller_state>);
+
+namespace detail {
+
+inline void fill_state(SDL_GameController* controller, controller_state& state) noexcept
+{
+  state.id = SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(controller));
+
+  state.buttons = 0;
+  for (int index = 0; index < controller_state::button_count; ++index) {
+    const auto button = static_cast<SDL_GameControllerButton>(index);
+    if (SDL_GameControllerGetButton(controller, button)) {
+      state.buttons |= uint32 {1} << index;
+    }
+  }
+
+  for (int index = 0; index < controller_state::axis_count; ++index) {
+    const auto axis = static_cast<SDL_GameControllerAxis>(index);
+    state.axes[static_cast<usize>(index)] = SDL_GameControllerGetAxis(controller, axis);
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+  for (int index = 0; index < controller_state::max_fingers; ++index) {
+    auto& finger = state.fingers[static_cast<usize>(index)];
+    uint8 pressed {};
+
+    if (SDL_GameControllerGetTouchpadFinger(controller,
+                                            0,
+                                            index,
+                                            &pressed,
+                                            &finger.x,
+                                            &finger.y,
+                                            &finger.pressure) == 0) {
+      finger.state = static_cast<button_state>(pressed);
+    }
+    else {
+      finger = controller_finger_state {};
+    }
+  }
+
+  state.has_gyro =
+      SDL_GameControllerGetSensorData(controller, SDL_SENSOR_GYRO, state.gyro.data(), 3) == 0;
+  state.has_accel =
+      SDL_GameControllerGetSensorData(controller, SDL_SENSOR_ACCEL, state.accel.data(), 3) ==
+      0;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+}
+
+}  // namespace detail
+
+/**
+ * Creates a snapshot of the current state of a controller.
+ *
+ * Note, this function doesn't update the controller state, see `controller::update()`.
+ *
+ * \param controller the controller to create a snapshot of.
+ *
+ * \return a snapshot of the controller.
+ */
+template <typename T>
+[[nodiscard]] auto capture(const basic_controller<T>& controller) noexcept -> controller_state
+{
+  controller_state state;
+  detail::fill_state(controller.get(), state);
+  return state;
+}
+
+/**
+ * Obtains snapshots of all open game controllers.
+ *
+ * The controller state is updated once, after which every open controller is queried in a
+ * single pass. The supplied vector is reused, so no allocations are made once it is large
+ * enough to hold all controllers.
+ *
+ * \param states the vector that will be filled with one snapshot per open controller.
+ *
+ * \return the amount of obtained snapshots.
+ */
+inline auto poll_all_controllers(std::vector<controller_state>& states) -> usize
+{
+  SDL_GameControllerUpdate();
+
+  usize count = 0;
+  const auto joysticks = SDL_NumJoysticks();
+
+  for (int index = 0; index < joysticks; ++index) {
+    if (!SDL_IsGameController(index)) {
+      continue;
+    }
+
+    const auto id = SDL_JoystickGetDeviceInstanceID(index);
+    if (auto* controller = SDL_GameControllerFromInstanceID(id)) {
+      if (count == states.size()) {
+        states.emplace_back();
+      }
+
+      detail::fill_state(controller, states[count]);
+      ++count;
+    }
+  }
+
+  states.resize(count);
+  return count;
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_CONTROLLER_STATE_HPP_
@@ -0,0 +1,363 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_INPUT_CURSOR_CACHE_HPP_
+#define CENTURION_INPUT_CURSOR_CACHE_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>  // sort, unique
+#include <cmath>      // abs, lround
+#include <utility>    // move
+#include <vector>     // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../video/blend.hpp"
+#include "../video/display.hpp"
+#include "../video/pixels.hpp"
+#include "../video/surface.hpp"
+#include "mouse.hpp"
+
+namespace cen {
+
+/**
+ * Stores prebuilt color cursors, including animated cursors and DPI scale variants.
+ *
+ * Creating a cursor from a surface converts the pixels every time, so switching between
+ * surface cursors, or animating a cursor by swapping surfaces, repeatedly creates and frees
+ * `SDL_Cursor` instances. This cache instead creates every frame of every cursor in all scale
+ * variants up front. Afterwards, `enable()`, `set_scale()` and `update()` only select one of
+ * the stored cursors, and `SDL_SetCursor()` is only called when the selected cursor differs
+ * from the active one.
+ *
+ * The scale variants are typically obtained with `display_scales()`, which derives a scale
+ * factor from the DPI of each display.
+ *
+ * \see cursor
+ */
+class cursor_cache final {
+ public:
+  using id_type = usize;
+
+  /// The DPI that corresponds to a scale factor of one.
+  inline constexpr static float base_dpi = 96.0f;
+
+  /**
+   * Creates a cursor cache.
+   *
+   * \param scales the scale factors of the cursor variants, duplicates are ignored.
+   *
+   * \throws exception if there are no scale factors, or if any scale factor isn't positive.
+   */
+  explicit cursor_cache(std::vector<float> scales = {1.0f}) : mScales {std::move(scales)}
+  {
+    if (mScales.empty()) {
+      throw exception {"Cannot create cursor cache without scale factors!"};
+    }
+
+    for (const auto scale : mScales) {
+      if (!(scale > 0.0f)) {
+        throw exception {"Cursor scale factors must be positive!"};
+      }
+    }
+
+    std::sort(mScales.begin(), mScales.end());
+    mScales.erase(std::unique(mScales.begin(), mScales.end()), mScales.end());
+  }
+
+  /**
+   * Returns the scale factors of all displays, based on their horizontal DPI.
+   *
+   * \return the sorted scale factors, which are never empty.
+   */
+  [[nodiscard]] static auto display_scales() -> std::vector<float>
+  {
+    std::vector<float> scales;
+
+    const auto count = display_count().value_or(0);
+    for (int index = 0; index < count; ++index) {
+      if (const auto dpi = display_dpi(index); dpi && dpi->horizontal > 0.0f) {
+        scales.push_back(dpi->horizontal / base_dpi);
+      }
+    }
+
+    if (scales.empty()) {
+      scales.push_back(1.0f);
+    }
+
+    std::sort(scales.begin(), scales.end());
+    scales.erase(std::unique(scales.begin(), scales.end()), scales.end());
+
+    return scales;
+  }
+
+  /**
+   * Adds a static cursor, in all scale variants.
+   *
+   * \param image the cursor image, at a scale factor of one.
+   * \param hotspot the hotspot of the cursor, at a scale factor of one.
+   *
+   * \return the identifier of the cursor.
+   *
+   * \throws sdl_error if a cursor cannot be created.
+   */
+  auto add(const surface& image, const ipoint& hotspot) -> id_type
+  {
+    return add_animated(image, image.size(), hotspot, u64ms::zero());
+  }
+
+  /**
+   * Adds an animated cursor, in all scale variants.
+   *
+   * The frames are read from a sprite sheet, from left to right and then top to bottom.
+   *
+   * \param sheet the sprite sheet that contains the frames, at a scale factor of one.
+   * \param frameSize the size of each frame in the sprite sheet.
+   * \param hotspot the hotspot of the cursor, relative to each frame.
+   * \param frameDuration the duration of each frame, zero disables the animation.
+   *
+   * \return the identifier of the cursor.
+   *
+   * \throws exception if the frame size is empty or larger than the sprite sheet.
+   * \throws sdl_error if a cursor cannot be created.
+   */
+  auto add_animated(const surface& sheet,
+                    const iarea& frameSize,
+                    const ipoint& hotspot,
+                    const u64ms frameDuration) -> id_type
+  {
+    if (frameSize.width <= 0 || frameSize.height <= 0 || frameSize.width > sheet.width() ||
+        frameSize.height > sheet.height()) {
+      throw exception {"Invalid cursor frame size!"};
+    }
+
+    const auto columns = sheet.width() / frameSize.width;
+    const auto rows = sheet.height() / frameSize.height;
+
+    /* The conversion makes the scaled blits straightforward copies */
+    auto source = sheet.convert_to(pixel_format::argb8888);
+    source.set_blend_mode(blend_mode::none);
+
+    entry cursorEntry;
+    cursorEntry.first = mCursors.size();
+    cursorEntry.frames = static_cast<usize>(columns) * static_cast<usize>(rows);
+    cursorEntry.duration = frameDuration;
+
+    mCursors.reserve(mCursors.size() + cursorEntry.frames * mScales.size());
+    for (int row = 0; row < rows; ++row) {
+      for (int column = 0; column < columns; ++column) {
+        const irect frame {{column * frameSize.width, row * frameSize.height}, frameSize};
+        for (const auto scale : mScales) {
+          mCursors.push_back(make_cursor(source, frame, hotspot, scale));
+        }
+      }
+    }
+
+    mEntries.push_back(cursorEntry);
+    return mEntries.size() - 1;
+  }
+
+  /**
+   * Activates a cursor, restarting its animation.
+   *
+   * \param id the identifier of the cursor.
+   *
+   * \throws exception if the identifier is invalid.
+   */
+  void enable(const id_type id)
+  {
+    if (id >= mEntries.size()) {
+      throw exception {"Invalid cursor identifier!"};
+    }
+
+    mActive = id;
+    mFrame = 0;
+    mElapsed = u64ms::zero();
+    mEnabled = true;
+
+    apply();
+  }
+
+  /**
+   * Selects the scale variant that is closest to a scale factor.
+   *
+   * \param scale the desired scale factor, e.g. for the display that contains the window.
+   */
+  void set_scale(const float scale) noexcept
+  {
+    usize closest = 0;
+    for (usize index = 1; index < mScales.size(); ++index) {
+      if (std::abs(mScales[index] - scale) < std::abs(mScales[closest] - scale)) {
+        closest = index;
+      }
+    }
+
+    mScaleIndex = closest;
+
+    if (mEnabled) {
+      apply();
+    }
+  }
+
+  /**
+   * Advances the animation of the active cursor.
+   *
+   * This function never allocates, and only changes the cursor when the frame changes.
+   *
+   * \param delta the time that has passed since the previous update.
+   */
+  void update(const u64ms delta) noexcept
+  {
+    if (!mEnabled) {
+      return;
+    }
+
+    const auto& entry = mEntries[mActive];
+    if (entry.frames < 2 || entry.duration == u64ms::zero()) {
+      return;
+    }
+
+    mElapsed += delta;
+
+    const auto steps = static_cast<usize>(mElapsed / entry.duration);
+    if (steps != 0) {
+      mElapsed %= entry.duration;
+      mFrame = (mFrame + steps) % entry.frames;
+      apply();
+    }
+  }
+
+  /// Stops using the cache, and restores the default cursor.
+  void disable() noexcept
+  {
+    mEnabled = false;
+    cursor::reset();
+  }
+
+  /**
+   * Returns a cursor from the cache.
+   *
+   * \param id the identifier of the cursor.
+   * \param frame the index of the frame.
+   *
+   * \return a handle to the cursor, in the current scale variant.
+   *
+   * \throws exception if the identifier or frame index is invalid.
+   */
+  [[nodiscard]] auto get(const id_type id, const usize frame = 0) const -> cursor_handle
+  {
+    if (id >= mEntries.size() || frame >= mEntries[id].frames) {
+      throw exception {"Invalid cursor identifier or frame!"};
+    }
+
+    return cursor_handle {mCursors[index_of(mEntries[id], frame)].get()};
+  }
+
+  /// Indicates whether a cursor from the cache has been enabled.
+  [[nodiscard]] auto is_enabled() const noexcept -> bool { return mEnabled; }
+
+  /// Returns the identifier of the most recently enabled cursor.
+  [[nodiscard]] auto active() const noexcept -> id_type { return mActive; }
+
+  /// Returns the current animation frame of the active cursor.
+  [[nodiscard]] auto frame() const noexcept -> usize { return mFrame; }
+
+  /// Returns the amount of frames in a cursor, or zero if the identifier is invalid.
+  [[nodiscard]] auto frame_count(const id_type id) const noexcept -> usize
+  {
+    return (id < mEntries.size()) ? mEntries[id].frames : 0;
+  }
+
+  /// Returns the scale factor of the selected scale variant.
+  [[nodiscard]] auto scale() const noexcept -> float { return mScales[mScaleIndex]; }
+
+  /// Returns the sorted scale factors of the cursor variants.
+  [[nodiscard]] auto scales() const noexcept -> const std::vector<float>& { return mScales; }
+
+  /// Returns the amount of cursors in the cache.
+  [[nodiscard]] auto size() const noexcept -> usize { return mEntries.size(); }
+
+  /// Returns the total amount of `SDL_Cursor` instances stored by the cache.
+  [[nodiscard]] auto cursor_instances() const noexcept -> usize { return mCursors.size(); }
+
+ private:
+  struct entry final {
+    usize first {};   ///< The index of the first cursor.
+    usize frames {};  ///< The amount of animation frames.
+    u64ms duration {};
+  };
+
+  std::vector<float> mScales;
+  std::vector<cursor> mCursors;  ///< Frame-major, with the scale variants of each frame.
+  std::vector<entry> mEntries;
+  u64ms mElapsed {};
+  usize mScaleIndex {};
+  usize mActive {};
+  usize mFrame {};
+  bool mEnabled {};
+
+  [[nodiscard]] auto index_of(const entry& entry, const usize frame) const noexcept -> usize
+  {
+    return entry.first + frame * mScales.size() + mScaleIndex;
+  }
+
+  void apply() noexcept
+  {
+    auto* target = mCursors[index_of(mEntries[mActive], mFrame)].get();
+    if (SDL_GetCursor() != target) {
+      SDL_SetCursor(target);
+    }
+  }
+
+  [[nodiscard]] static auto make_cursor(const surface& source,
+                                        const irect& frame,
+                                        const ipoint& hotspot,
+                                        const float scale) -> cursor
+  {
+    const auto scaled = [=](const int value) {
+      return (detail::max)(1, static_cast<int>(std::lround(static_cast<float>(value) * scale)));
+    };
+
+    const iarea size {scaled(frame.width()), scaled(frame.height())};
+    surface image {size, pixel_format::argb8888};
+
+    SDL_Rect dst {0, 0, size.width, size.height};
+    if (SDL_BlitScaled(source.get(), frame.data(), image.get(), &dst) != 0) {
+      throw sdl_error {};
+    }
+
+    const auto x = static_cast<int>(std::lround(static_cast<float>(hotspot.x()) * scale));
+    const auto y = static_cast<int>(std::lround(static_cast<float>(hotspot.y()) * scale));
+
+    return cursor {image,
+                   {detail::clamp(x, 0, size.width - 1), detail::clamp(y, 0, size.height - 1)}};
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_CURSOR_CACHE_HPP_
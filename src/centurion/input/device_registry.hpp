@@ -0,0 +1,251 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_INPUT_DEVICE_REGISTRY_HPP_
+#define CENTURION_INPUT_DEVICE_REGISTRY_HPP_
+
+#include <SDL.h>
+
+#include <type_traits>    // is_same_v
+#include <unordered_map>  // unordered_map
+#include <utility>        // move
+#include <vector>         // vector
+
+#include "../common/primitives.hpp"
+#include "../events/event_base.hpp"
+#include "controller.hpp"
+#include "joystick.hpp"
+
+namespace cen {
+
+/**
+ * Keeps track of connected game controllers and joysticks, using device events.
+ *
+ * The registry opens devices when they are connected, and closes them when they are
+ * disconnected. Devices are stored in dense arrays, with look-up tables for instance IDs and
+ * player indices, so there is no need to enumerate the devices using SDL every frame.
+ *
+ * Devices that are recognized as game controllers are only opened as controllers, all other
+ * devices are opened as joysticks. Note, SDL emits device added events for all devices that
+ * are connected when the joystick subsystem is initialized, so no manual enumeration is
+ * required as long as all device events are forwarded to the registry.
+ */
+class device_registry final {
+ public:
+  using id_type = SDL_JoystickID;
+  using player_index = int;
+
+  /**
+   * Updates the registry using a controller device event.
+   *
+   * \param event the event that will be processed.
+   *
+   * \return `true` if a controller was added or removed; `false` otherwise.
+   */
+  auto update(const event_base<SDL_ControllerDeviceEvent>& event) -> bool
+  {
+    const auto& data = event.get();
+    if (data.type == SDL_CONTROLLERDEVICEADDED) {
+      return add(mControllers, mControllerIds, SDL_GameControllerOpen(data.which));
+    }
+    else if (data.type == SDL_CONTROLLERDEVICEREMOVED) {
+      return remove(mControllers, mControllerIds, data.which);
+    }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Updates the registry using a joystick device event.
+   *
+   * \param event the event that will be processed.
+   *
+   * \return `true` if a joystick was added or removed; `false` otherwise.
+   */
+  auto update(const event_base<SDL_JoyDeviceEvent>& event) -> bool
+  {
+    const auto& data = event.get();
+    if (data.type == SDL_JOYDEVICEADDED) {
+      /* Game controllers are handled by the corresponding controller event */
+      if (SDL_IsGameController(data.which)) {
+        return false;
+      }
+
+      return add(mJoysticks, mJoystickIds, SDL_JoystickOpen(data.which));
+    }
+    else if (data.type == SDL_JOYDEVICEREMOVED) {
+      return remove(mJoysticks, mJoystickIds, data.which);
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Updates the player index look-up table, use this after changing player indices.
+  void refresh_player_indices()
+  {
+    mPlayers.clear();
+    for (const auto& controller : mControllers) {
+      if (const auto index = controller.index(); index && *index >= 0) {
+        mPlayers[*index] = controller.get();
+      }
+    }
+  }
+
+  /// Returns the controller with the specified instance ID, which may be null.
+  [[nodiscard]] auto find_controller(const id_type id) const -> controller_handle
+  {
+    if (const auto iter = mControllerIds.find(id); iter != mControllerIds.end()) {
+      return controller_handle {mControllers[iter->second]};
+    }
+    else {
+      return controller_handle {nullptr};
+    }
+  }
+
+  /// Returns the joystick with the specified instance ID, which may be null.
+  [[nodiscard]] auto find_joystick(const id_type id) const -> joystick_handle
+  {
+    if (const auto iter = mJoystickIds.find(id); iter != mJoystickIds.end()) {
+      return joystick_handle {mJoysticks[iter->second]};
+    }
+    else {
+      return joystick_handle {nullptr};
+    }
+  }
+
+  /// Returns the controller associated with a player index, which may be null.
+  [[nodiscard]] auto find_player(const player_index index) const -> controller_handle
+  {
+    if (const auto iter = mPlayers.find(index); iter != mPlayers.end()) {
+      return controller_handle {iter->second};
+    }
+    else {
+      return controller_handle {nullptr};
+    }
+  }
+
+  /// Returns all open controllers, in no particular order.
+  [[nodiscard]] auto controllers() const noexcept -> const std::vector<controller>&
+  {
+    return mControllers;
+  }
+
+  /// Returns all open joysticks that aren't game controllers, in no particular order.
+  [[nodiscard]] auto joysticks() const noexcept -> const std::vector<joystick>&
+  {
+    return mJoysticks;
+  }
+
+  [[nodiscard]] auto controller_count() const noexcept -> usize { return mControllers.size(); }
+
+  [[nodiscard]] auto joystick_count() const noexcept -> usize { return mJoysticks.size(); }
+
+  /// Closes all devices.
+  void clear() noexcept
+  {
+    mControllers.clear();
+    mJoysticks.clear();
+    mControllerIds.clear();
+    mJoystickIds.clear();
+    mPlayers.clear();
+  }
+
+ private:
+  std::vector<controller> mControllers;
+  std::vector<joystick> mJoysticks;
+  std::unordered_map<id_type, usize> mControllerIds;  ///< Instance ID to controller index.
+  std::unordered_map<id_type, usize> mJoystickIds;    ///< Instance ID to joystick index.
+  std::unordered_map<player_index, SDL_GameController*> mPlayers;
+
+  [[nodiscard]] static auto instance_id(const controller& device) noexcept -> id_type
+  {
+    return SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(device.get()));
+  }
+
+  [[nodiscard]] static auto instance_id(const joystick& device) noexcept -> id_type
+  {
+    return SDL_JoystickInstanceID(device.get());
+  }
+
+  template <typename Device, typename Pointer>
+  auto add(std::vector<Device>& devices,
+           std::unordered_map<id_type, usize>& ids,
+           Pointer* ptr) -> bool
+  {
+    if (!ptr) {
+      return false;
+    }
+
+    Device device {ptr};
+    const auto id = instance_id(device);
+
+    /* Opening a device twice only increments its reference count in SDL */
+    if (ids.find(id) != ids.end()) {
+      return false;
+    }
+
+    ids.emplace(id, devices.size());
+    devices.push_back(std::move(device));
+
+    if constexpr (std::is_same_v<Device, controller>) {
+      refresh_player_indices();
+    }
+
+    return true;
+  }
+
+  template <typename Device>
+  auto remove(std::vector<Device>& devices,
+              std::unordered_map<id_type, usize>& ids,
+              const id_type id) -> bool
+  {
+    const auto iter = ids.find(id);
+    if (iter == ids.end()) {
+      return false;
+    }
+
+    /* Keep the devices contiguous by moving the last device into the hole */
+    const auto index = iter->second;
+    ids.erase(iter);
+
+    if (index != devices.size() - 1) {
+      devices[index] = std::move(devices.back());
+      ids[instance_id(devices[index])] = index;
+    }
+
+    devices.pop_back();
+
+    if constexpr (std::is_same_v<Device, controller>) {
+      refresh_player_indices();
+    }
+
+    return true;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_DEVICE_REGISTRY_HPP_
@@ -0,0 +1,486 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_INPUT_INPUT_DELTA_HPP_
+#define CENTURION_INPUT_INPUT_DELTA_HPP_
+
+#include <SDL.h>
+
+#include <array>    // array
+#include <cassert>  // assert
+#include <vector>   // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "controller_state.hpp"
+#include "keyboard.hpp"
+#include "keyboard_snapshot.hpp"
+
+namespace cen {
+
+/**
+ * The input of a single player during one tick, as sent by delta-compressed input streams.
+ *
+ * \see input_delta_encoder
+ * \see input_delta_decoder
+ * \see input_history
+ */
+struct input_snapshot final {
+  keyboard_snapshot keys;                                   ///< The pressed keys.
+  uint32 buttons {};                                        ///< The pressed buttons.
+  std::array<int16, controller_state::axis_count> axes {};  ///< The controller axes.
+
+  /// Creates an input snapshot from a keyboard and controller snapshot.
+  [[nodiscard]] static auto from(const keyboard_snapshot& keys,
+                                 const controller_state& controller) noexcept
+      -> input_snapshot
+  {
+    return {keys, controller.buttons, controller.axes};
+  }
+};
+
+[[nodiscard]] inline auto operator==(const input_snapshot& a, const input_snapshot& b) noexcept
+    -> bool
+{
+  return a.keys == b.keys && a.buttons == b.buttons && a.axes == b.axes;
+}
+
+[[nodiscard]] inline auto operator!=(const input_snapshot& a, const input_snapshot& b) noexcept
+    -> bool
+{
+  return !(a == b);
+}
+
+namespace detail {
+
+inline constexpr uint8 input_keys_changed = 1u << 0u;
+inline constexpr uint8 input_buttons_changed = 1u << 1u;
+inline constexpr uint8 input_axes_changed = 1u << 2u;
+inline constexpr uint8 input_delta_flags =
+    input_keys_changed | input_buttons_changed | input_axes_changed;
+
+static_assert(controller_state::axis_count <= 8,
+              "Controller axes don't fit in the axis mask!");
+
+inline void write_input_varint(std::vector<uint8>& buffer, uint32 value)
+{
+  while (value >= 0x80u) {
+    buffer.push_back(static_cast<uint8>(value | 0x80u));
+    value >>= 7u;
+  }
+
+  buffer.push_back(static_cast<uint8>(value));
+}
+
+/* Reads the bytes of an encoded tick, every read fails once the data is exhausted */
+struct input_delta_cursor final {
+  const uint8* data {};
+  usize size {};
+  usize offset {};
+
+  [[nodiscard]] auto read(uint8& value) noexcept -> bool
+  {
+    if (offset == size) {
+      return false;
+    }
+
+    value = data[offset++];
+    return true;
+  }
+
+  [[nodiscard]] auto read(uint32& value) noexcept -> bool
+  {
+    value = 0;
+    for (uint32 shift = 0; shift < 32u; shift += 7u) {
+      uint8 byte {};
+      if (!read(byte)) {
+        return false;
+      }
+
+      value |= static_cast<uint32>(byte & 0x7Fu) << shift;
+
+      if ((byte & 0x80u) == 0) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+};
+
+[[nodiscard]] constexpr auto zigzag_encode(const int32 value) noexcept -> uint32
+{
+  return (static_cast<uint32>(value) << 1u) ^ static_cast<uint32>(value < 0 ? -1 : 0);
+}
+
+[[nodiscard]] constexpr auto zigzag_decode(const uint32 value) noexcept -> int32
+{
+  return static_cast<int32>(value >> 1u) ^ -static_cast<int32>(value & 1u);
+}
+
+inline void validate_axis_bits(const int bits)
+{
+  if (bits < 1 || bits > 16) {
+    throw exception {"Axis precision must be between 1 and 16 bits!"};
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Delta-compresses consecutive input snapshots into a compact byte stream.
+ *
+ * Each tick is encoded relative to the previous tick, starting with a byte of flags that
+ * indicate which parts of the input changed. Unchanged ticks take a single byte. Changed
+ * keys are encoded as a list of scan code gaps, the buttons as a mask of toggled buttons, and
+ * axis values are quantized and encoded as variable-length differences. A typical tick in
+ * which a key is pressed and a stick moves takes about five bytes.
+ *
+ * Axis quantization is lossy, so the encoder tracks the snapshot that the decoder will
+ * reconstruct, which prevents the quantization errors from accumulating. The encoder and
+ * decoder must use the same axis precision, and must be reset at the same tick.
+ *
+ * \see input_delta_decoder
+ */
+class input_delta_encoder final {
+ public:
+  /**
+   * Creates an encoder.
+   *
+   * \param axisBits the amount of bits of precision kept for each axis value, in [1, 16].
+   *
+   * \throws exception if the axis precision is invalid.
+   */
+  explicit input_delta_encoder(const int axisBits = 8) : mAxisShift {16 - axisBits}
+  {
+    detail::validate_axis_bits(axisBits);
+  }
+
+  /**
+   * Encodes the difference between a snapshot and the previously encoded snapshot.
+   *
+   * \param snapshot the input of the next tick.
+   * \param buffer the buffer that the encoded tick is appended to.
+   *
+   * \return the amount of bytes that were appended.
+   */
+  auto encode(const input_snapshot& snapshot, std::vector<uint8>& buffer) -> usize
+  {
+    const auto start = buffer.size();
+    buffer.push_back(0);
+
+    uint8 flags {};
+
+    const auto keys = snapshot.keys.changed_since(mReference.keys);
+    if (!keys.empty()) {
+      flags |= detail::input_keys_changed;
+      detail::write_input_varint(buffer, static_cast<uint32>(keys.count()));
+
+      int next = 0;
+      keys.each([&](const scan_code& code) {
+        detail::write_input_varint(buffer, static_cast<uint32>(code.get() - next));
+        next = code.get() + 1;
+      });
+
+      mReference.keys = snapshot.keys;
+    }
+
+    if (const auto buttons = snapshot.buttons ^ mReference.buttons) {
+      flags |= detail::input_buttons_changed;
+      detail::write_input_varint(buffer, buttons);
+
+      mReference.buttons = snapshot.buttons;
+    }
+
+    uint8 axisMask {};
+    int32 deltas[controller_state::axis_count] {};
+
+    for (usize index = 0; index < mReference.axes.size(); ++index) {
+      const auto previous = static_cast<int32>(mReference.axes[index]) >> mAxisShift;
+      const auto current = static_cast<int32>(snapshot.axes[index]) >> mAxisShift;
+
+      if (current != previous) {
+        axisMask |= static_cast<uint8>(1u << index);
+        deltas[index] = current - previous;
+        mReference.axes[index] = static_cast<int16>(current * (int32 {1} << mAxisShift));
+      }
+    }
+
+    if (axisMask) {
+      flags |= detail::input_axes_changed;
+      buffer.push_back(axisMask);
+
+      for (usize index = 0; index < mReference.axes.size(); ++index) {
+        if (axisMask & (1u << index)) {
+          detail::write_input_varint(buffer, detail::zigzag_encode(deltas[index]));
+        }
+      }
+    }
+
+    buffer[start] = flags;
+    return buffer.size() - start;
+  }
+
+  /// Resets the reference snapshot, the next tick is encoded relative to an idle input.
+  void reset() noexcept { mReference = input_snapshot {}; }
+
+  /// Returns the snapshot that the decoder reconstructs from the last encoded tick.
+  [[nodiscard]] auto reference() const noexcept -> const input_snapshot& { return mReference; }
+
+  [[nodiscard]] auto axis_bits() const noexcept -> int { return 16 - mAxisShift; }
+
+ private:
+  input_snapshot mReference;
+  int mAxisShift {};
+};
+
+/**
+ * Reconstructs input snapshots from a stream encoded by an `input_delta_encoder`.
+ *
+ * \see input_delta_encoder
+ */
+class input_delta_decoder final {
+ public:
+  /**
+   * Creates a decoder.
+   *
+   * \param axisBits the axis precision used by the encoder, in [1, 16].
+   *
+   * \throws exception if the axis precision is invalid.
+   */
+  explicit input_delta_decoder(const int axisBits = 8) : mAxisShift {16 - axisBits}
+  {
+    detail::validate_axis_bits(axisBits);
+  }
+
+  /**
+   * Decodes the next tick in a stream.
+   *
+   * The current snapshot is left unchanged if the data is malformed.
+   *
+   * \param data the encoded bytes, starting at the next tick.
+   * \param size the amount of available bytes.
+   *
+   * \return the amount of consumed bytes; an empty optional if the data is malformed.
+   */
+  auto decode(const uint8* data, const usize size) -> maybe<usize>
+  {
+    assert(data || size == 0);
+
+    detail::input_delta_cursor cursor {data, size};
+    auto snapshot = mCurrent;
+
+    uint8 flags {};
+    if (!cursor.read(flags) || (flags & ~detail::input_delta_flags)) {
+      return nothing;
+    }
+
+    if (flags & detail::input_keys_changed) {
+      uint32 count {};
+      if (!cursor.read(count) || count == 0) {
+        return nothing;
+      }
+
+      uint32 next = 0;
+      for (uint32 index = 0; index < count; ++index) {
+        uint32 gap {};
+        if (!cursor.read(gap) || gap >= static_cast<uint32>(scan_code::count()) - next) {
+          return nothing;
+        }
+
+        const scan_code code {static_cast<SDL_Scancode>(next + gap)};
+        snapshot.keys.set(code, !snapshot.keys.is_pressed(code));
+
+        next += gap + 1u;
+      }
+    }
+
+    if (flags & detail::input_buttons_changed) {
+      uint32 buttons {};
+      if (!cursor.read(buttons)) {
+        return nothing;
+      }
+
+      snapshot.buttons ^= buttons;
+    }
+
+    if (flags & detail::input_axes_changed) {
+      uint8 axisMask {};
+      if (!cursor.read(axisMask) || axisMask == 0 ||
+          (axisMask >> controller_state::axis_count) != 0) {
+        return nothing;
+      }
+
+      const auto min = -(int32 {1} << (15 - mAxisShift));
+      const auto max = (int32 {1} << (15 - mAxisShift)) - 1;
+
+      for (usize index = 0; index < snapshot.axes.size(); ++index) {
+        if (axisMask & (1u << index)) {
+          uint32 encoded {};
+          if (!cursor.read(encoded)) {
+            return nothing;
+          }
+
+          const auto previous = static_cast<int32>(snapshot.axes[index]) >> mAxisShift;
+          const auto current = previous + detail::zigzag_decode(encoded);
+          if (current < min || current > max) {
+            return nothing;
+          }
+
+          snapshot.axes[index] = static_cast<int16>(current * (int32 {1} << mAxisShift));
+        }
+      }
+    }
+
+    mCurrent = snapshot;
+    return cursor.offset;
+  }
+
+  /// Resets the decoder to an idle input, this must be mirrored by the encoder.
+  void reset() noexcept { mCurrent = input_snapshot {}; }
+
+  /// Returns the snapshot of the last decoded tick.
+  [[nodiscard]] auto current() const noexcept -> const input_snapshot& { return mCurrent; }
+
+  [[nodiscard]] auto axis_bits() const noexcept -> int { return 16 - mAxisShift; }
+
+ private:
+  input_snapshot mCurrent;
+  int mAxisShift {};
+};
+
+/**
+ * A replay buffer of the input snapshots of the most recent ticks.
+ *
+ * This is intended for rollback netcode, which needs to resimulate past ticks when late
+ * input arrives. Snapshots are stored by tick in a ring buffer, so lookups are constant time
+ * and no allocations are made after construction.
+ *
+ * \see input_snapshot
+ */
+class input_history final {
+ public:
+  /**
+   * Creates an input history.
+   *
+   * \param capacity the maximum amount of stored ticks, the oldest ticks are discarded.
+   *
+   * \throws exception if the capacity is zero.
+   */
+  explicit input_history(const usize capacity = 128) : mSnapshots(capacity)
+  {
+    if (capacity == 0) {
+      throw exception {"Cannot create input history without capacity!"};
+    }
+  }
+
+  /**
+   * Stores the input of a tick.
+   *
+   * \param tick the tick of the input, must directly follow the newest stored tick.
+   * \param snapshot the input during the tick.
+   *
+   * \throws exception if the tick doesn't follow the newest stored tick.
+   */
+  void push(const uint64 tick, const input_snapshot& snapshot)
+  {
+    if (mSize != 0 && tick != mNewest + 1u) {
+      throw exception {"Input history ticks must be consecutive!"};
+    }
+
+    mSnapshots[tick % mSnapshots.size()] = snapshot;
+    mNewest = tick;
+
+    if (mSize < mSnapshots.size()) {
+      ++mSize;
+    }
+  }
+
+  /**
+   * Discards all ticks after a tick, e.g. to replace predicted input with received input.
+   *
+   * \param tick the newest tick to keep.
+   */
+  void rewind(const uint64 tick) noexcept
+  {
+    if (mSize == 0 || tick >= mNewest) {
+      return;
+    }
+    else if (tick < oldest_tick()) {
+      clear();
+    }
+    else {
+      mSize -= static_cast<usize>(mNewest - tick);
+      mNewest = tick;
+    }
+  }
+
+  /// Returns the input of a tick, or null if the tick isn't stored.
+  [[nodiscard]] auto find(const uint64 tick) const noexcept -> const input_snapshot*
+  {
+    if (contains(tick)) {
+      return &mSnapshots[tick % mSnapshots.size()];
+    }
+    else {
+      return nullptr;
+    }
+  }
+
+  [[nodiscard]] auto contains(const uint64 tick) const noexcept -> bool
+  {
+    return mSize != 0 && tick <= mNewest && tick >= oldest_tick();
+  }
+
+  /// Removes all ticks.
+  void clear() noexcept { mSize = 0; }
+
+  /// Returns the oldest stored tick, the history must not be empty.
+  [[nodiscard]] auto oldest_tick() const noexcept -> uint64
+  {
+    assert(mSize != 0);
+    return mNewest + 1u - mSize;
+  }
+
+  /// Returns the newest stored tick, the history must not be empty.
+  [[nodiscard]] auto newest_tick() const noexcept -> uint64
+  {
+    assert(mSize != 0);
+    return mNewest;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> usize { return mSize; }
+
+  [[nodiscard]] auto capacity() const noexcept -> usize { return mSnapshots.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mSize == 0; }
+
+ private:
+  std::vector<input_snapshot> mSnapshots;
+  uint64 mNewest {};  ///< The newest stored tick, if the history isn't empty.
+  usize mSize {};     ///< Amount of stored ticks.
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_INPUT_DELTA_HPP_
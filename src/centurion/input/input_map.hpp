@@ -0,0 +1,380 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_INPUT_INPUT_MAP_HPP_
+#define CENTURION_INPUT_INPUT_MAP_HPP_
+
+#include <SDL.h>
+
+#include <cassert>        // assert
+#include <string>         // string
+#include <unordered_map>  // unordered_map
+#include <utility>        // move
+#include <vector>         // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "controller.hpp"
+#include "joystick.hpp"
+#include "keyboard.hpp"
+#include "mouse.hpp"
+
+namespace cen {
+
+/**
+ * Maps named actions and axes to bindings across the keyboard, mouse, game controllers and
+ * joysticks.
+ *
+ * All bindings are compiled into flat tables of scan codes and button indices when they are
+ * added, e.g. key codes are translated to scan codes once. The state of every action and axis
+ * is then evaluated once per frame in `update()`, after which querying an action or axis only
+ * requires an array lookup.
+ *
+ * Note, bindings to key codes are resolved using the keyboard layout at the time the binding
+ * is added.
+ */
+class input_map final {
+ public:
+  using id_type = usize;
+
+  /**
+   * Adds a named action, i.e. a digital input such as "jump".
+   *
+   * \param name the unique name of the action.
+   *
+   * \return the identifier of the action.
+   *
+   * \throws exception if there is already an action with the specified name.
+   */
+  auto add_action(std::string name) -> id_type
+  {
+    const auto id = mActionState.size();
+    if (!mActionNames.try_emplace(std::move(name), id).second) {
+      throw exception {"Duplicate action name!"};
+    }
+
+    mActionState.push_back(0);
+    return id;
+  }
+
+  /**
+   * Adds a named axis, i.e. an analog input in the range [-1, 1] such as "move_x".
+   *
+   * \param name the unique name of the axis.
+   *
+   * \return the identifier of the axis.
+   *
+   * \throws exception if there is already an axis with the specified name.
+   */
+  auto add_axis(std::string name) -> id_type
+  {
+    const auto id = mAxisValues.size();
+    if (!mAxisNames.try_emplace(std::move(name), id).second) {
+      throw exception {"Duplicate axis name!"};
+    }
+
+    mAxisValues.push_back(0);
+    return id;
+  }
+
+  void bind(const id_type action, const scan_code& code)
+  {
+    assert(action < mActionState.size());
+    if (code.get() >= 0 && code.get() < scan_code::count()) {
+      mKeyBindings.push_back({static_cast<uint32>(code.get()), action});
+    }
+  }
+
+  void bind(const id_type action, const key_code& code) { bind(action, code.to_scancode()); }
+
+  void bind(const id_type action, const mouse_button button)
+  {
+    assert(action < mActionState.size());
+    mMouseBindings.push_back({static_cast<uint32>(SDL_BUTTON(to_underlying(button))), action});
+  }
+
+  void bind(const id_type action, const controller_button button)
+  {
+    assert(action < mActionState.size());
+    mControllerBindings.push_back({static_cast<uint32>(to_underlying(button)), action});
+  }
+
+  void bind_joystick_button(const id_type action, const int button)
+  {
+    assert(action < mActionState.size());
+    assert(button >= 0);
+    mJoystickBindings.push_back({static_cast<uint32>(button), action});
+  }
+
+  /// Binds two keys to an axis, where the axis is -1 or 1 when either key is pressed.
+  void bind_axis(const id_type axis, const scan_code& negative, const scan_code& positive)
+  {
+    assert(axis < mAxisValues.size());
+    mKeyAxisBindings.push_back({negative.get(), positive.get(), axis});
+  }
+
+  void bind_axis(const id_type axis, const key_code& negative, const key_code& positive)
+  {
+    bind_axis(axis, negative.to_scancode(), positive.to_scancode());
+  }
+
+  /**
+   * Binds a game controller axis to an axis.
+   *
+   * \param axis the axis that will be affected.
+   * \param source the controller axis that will be read.
+   * \param deadzone the fraction of the axis range around zero that is ignored.
+   */
+  void bind_axis(const id_type axis, const controller_axis source, const float deadzone = 0)
+  {
+    assert(axis < mAxisValues.size());
+    mControllerAxisBindings.push_back({to_underlying(source), axis, deadzone});
+  }
+
+  /// Binds a joystick axis to an axis, see `bind_axis(id_type, controller_axis, float)`.
+  void bind_joystick_axis(const id_type axis, const int source, const float deadzone = 0)
+  {
+    assert(axis < mAxisValues.size());
+    assert(source >= 0);
+    mJoystickAxisBindings.push_back({source, axis, deadzone});
+  }
+
+  /// Evaluates all keyboard and mouse bindings.
+  void update() noexcept { evaluate(nullptr, nullptr); }
+
+  /// Evaluates all keyboard, mouse, and game controller bindings.
+  template <typename T>
+  void update(const basic_controller<T>& controller) noexcept
+  {
+    evaluate(controller.get(), nullptr);
+  }
+
+  /// Evaluates all keyboard, mouse, and joystick bindings.
+  template <typename T>
+  void update(const basic_joystick<T>& joystick) noexcept
+  {
+    evaluate(nullptr, joystick.get());
+  }
+
+  /// Evaluates all bindings.
+  template <typename T, typename U>
+  void update(const basic_controller<T>& controller,
+              const basic_joystick<U>& joystick) noexcept
+  {
+    evaluate(controller.get(), joystick.get());
+  }
+
+  /// Indicates whether any of the inputs bound to an action are active.
+  [[nodiscard]] auto is_active(const id_type action) const noexcept -> bool
+  {
+    assert(action < mActionState.size());
+    return mActionState[action] & current_bit;
+  }
+
+  /// Indicates whether an action became active during the last update.
+  [[nodiscard]] auto just_activated(const id_type action) const noexcept -> bool
+  {
+    assert(action < mActionState.size());
+    return mActionState[action] == current_bit;
+  }
+
+  /// Indicates whether an action became inactive during the last update.
+  [[nodiscard]] auto just_deactivated(const id_type action) const noexcept -> bool
+  {
+    assert(action < mActionState.size());
+    return mActionState[action] == previous_bit;
+  }
+
+  /// Returns the value of an axis in the range [-1, 1], the sum of all of its bindings.
+  [[nodiscard]] auto value(const id_type axis) const noexcept -> float
+  {
+    assert(axis < mAxisValues.size());
+    return mAxisValues[axis];
+  }
+
+  /// Returns the identifier of the action with the specified name, if there is one.
+  [[nodiscard]] auto find_action(const std::string& name) const -> maybe<id_type>
+  {
+    return find(mActionNames, name);
+  }
+
+  /// Returns the identifier of the axis with the specified name, if there is one.
+  [[nodiscard]] auto find_axis(const std::string& name) const -> maybe<id_type>
+  {
+    return find(mAxisNames, name);
+  }
+
+  /// Removes all bindings, but keeps the actions and axes.
+  void clear_bindings() noexcept
+  {
+    mKeyBindings.clear();
+    mMouseBindings.clear();
+    mControllerBindings.clear();
+    mJoystickBindings.clear();
+    mKeyAxisBindings.clear();
+    mControllerAxisBindings.clear();
+    mJoystickAxisBindings.clear();
+  }
+
+  [[nodiscard]] auto action_count() const noexcept -> usize { return mActionState.size(); }
+
+  [[nodiscard]] auto axis_count() const noexcept -> usize { return mAxisValues.size(); }
+
+  /// Returns the total amount of bindings.
+  [[nodiscard]] auto binding_count() const noexcept -> usize
+  {
+    return mKeyBindings.size() + mMouseBindings.size() + mControllerBindings.size() +
+           mJoystickBindings.size() + mKeyAxisBindings.size() +
+           mControllerAxisBindings.size() + mJoystickAxisBindings.size();
+  }
+
+ private:
+  inline constexpr static uint8 current_bit = 1u;
+  inline constexpr static uint8 previous_bit = 2u;
+
+  /// Maps a scan code, mouse button mask or button index to an action.
+  struct button_binding final {
+    uint32 source {};
+    id_type action {};
+  };
+
+  struct key_axis_binding final {
+    int negative {};
+    int positive {};
+    id_type axis {};
+  };
+
+  struct analog_binding final {
+    int source {};
+    id_type axis {};
+    float deadzone {};
+  };
+
+  std::unordered_map<std::string, id_type> mActionNames;
+  std::unordered_map<std::string, id_type> mAxisNames;
+
+  std::vector<uint8> mActionState;  ///< Current state in bit 0, previous state in bit 1.
+  std::vector<float> mAxisValues;
+
+  std::vector<button_binding> mKeyBindings;
+  std::vector<button_binding> mMouseBindings;
+  std::vector<button_binding> mControllerBindings;
+  std::vector<button_binding> mJoystickBindings;
+  std::vector<key_axis_binding> mKeyAxisBindings;
+  std::vector<analog_binding> mControllerAxisBindings;
+  std::vector<analog_binding> mJoystickAxisBindings;
+
+  void evaluate(SDL_GameController* controller, SDL_Joystick* joystick) noexcept
+  {
+    for (auto& state : mActionState) {
+      state = static_cast<uint8>((state & current_bit) << 1u);
+    }
+
+    for (auto& value : mAxisValues) {
+      value = 0;
+    }
+
+    int keyCount {};
+    const auto* keys = SDL_GetKeyboardState(&keyCount);
+
+    const auto is_key_down = [keys, keyCount](const int code) noexcept {
+      return code >= 0 && code < keyCount && keys[code];
+    };
+
+    for (const auto& [code, action] : mKeyBindings) {
+      if (is_key_down(static_cast<int>(code))) {
+        mActionState[action] |= current_bit;
+      }
+    }
+
+    const auto mask = SDL_GetMouseState(nullptr, nullptr);
+    for (const auto& [buttonMask, action] : mMouseBindings) {
+      if (mask & buttonMask) {
+        mActionState[action] |= current_bit;
+      }
+    }
+
+    for (const auto& [negative, positive, axis] : mKeyAxisBindings) {
+      mAxisValues[axis] += static_cast<float>(is_key_down(positive) - is_key_down(negative));
+    }
+
+    if (controller) {
+      for (const auto& [button, action] : mControllerBindings) {
+        const auto id = static_cast<SDL_GameControllerButton>(button);
+        if (SDL_GameControllerGetButton(controller, id)) {
+          mActionState[action] |= current_bit;
+        }
+      }
+
+      for (const auto& [source, axis, deadzone] : mControllerAxisBindings) {
+        const auto id = static_cast<SDL_GameControllerAxis>(source);
+        mAxisValues[axis] += normalize(SDL_GameControllerGetAxis(controller, id), deadzone);
+      }
+    }
+
+    if (joystick) {
+      for (const auto& [button, action] : mJoystickBindings) {
+        if (SDL_JoystickGetButton(joystick, static_cast<int>(button))) {
+          mActionState[action] |= current_bit;
+        }
+      }
+
+      for (const auto& [source, axis, deadzone] : mJoystickAxisBindings) {
+        mAxisValues[axis] += normalize(SDL_JoystickGetAxis(joystick, source), deadzone);
+      }
+    }
+
+    for (auto& value : mAxisValues) {
+      value = detail::clamp(value, -1.0f, 1.0f);
+    }
+  }
+
+  [[nodiscard]] static auto normalize(const int16 raw, const float deadzone) noexcept -> float
+  {
+    const auto value = detail::clamp(static_cast<float>(raw) / 32'767.0f, -1.0f, 1.0f);
+    if (value > -deadzone && value < deadzone) {
+      return 0;
+    }
+    else {
+      return value;
+    }
+  }
+
+  [[nodiscard]] static auto find(const std::unordered_map<std::string, id_type>& names,
+                                 const std::string& name) -> maybe<id_type>
+  {
+    if (const auto iter = names.find(name); iter != names.end()) {
+      return iter->second;
+    }
+    else {
+      return nothing;
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_INPUT_MAP_HPP_
@@ -0,0 +1,514 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_INPUT_INPUT_STRESS_HPP_
+#define CENTURION_INPUT_INPUT_STRESS_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>  // upper_bound, find
+#include <utility>    // move
+#include <vector>     // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../events/joystick_events.hpp"
+#include "button_state.hpp"
+#include "joystick.hpp"
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+
+namespace cen {
+
+/// Represents the kind of input that is changed by a stress step.
+enum class stress_input : uint8 {
+  axis,
+  button,
+  hat
+};
+
+/// Represents a single change to the state of a virtual device.
+struct stress_step final {
+  u64ms time {};                            ///< The offset from the start of the session.
+  usize device {};                          ///< The index of the affected virtual device.
+  stress_input input {stress_input::axis};  ///< The kind of input that is changed.
+  uint8 index {};                           ///< The index of the axis, button or hat.
+  int16 value {};  ///< The axis value, the button state or the hat state bits.
+};
+
+/**
+ * A time-ordered sequence of input changes, that can be replayed by `input_stress`.
+ *
+ * Scripts can either be written by hand, using `add()`, or be recorded from joystick events
+ * during a real session. Recorded devices are assigned device indices in the order they are
+ * first encountered, so a session with four players replays on the first four virtual devices.
+ */
+class stress_script final {
+ public:
+  /**
+   * Adds a step to the script.
+   *
+   * \details Steps are kept sorted by time, steps with the same time are replayed in the order
+   * they were added.
+   *
+   * \param step the step that will be added.
+   */
+  void add(const stress_step& step)
+  {
+    const auto pos = std::upper_bound(mSteps.begin(),
+                                      mSteps.end(),
+                                      step.time,
+                                      [](const u64ms time, const stress_step& other) {
+                                        return time < other.time;
+                                      });
+    mSteps.insert(pos, step);
+    mDeviceCount = (detail::max)(mDeviceCount, step.device + 1u);
+  }
+
+  /**
+   * Records a joystick axis event.
+   *
+   * \param event the event that will be recorded.
+   * \param time the offset from the start of the recorded session.
+   */
+  void record(const joy_axis_event& event, const u64ms time)
+  {
+    add({time, device_of(event.which()), stress_input::axis, event.axis(), event.value()});
+  }
+
+  /**
+   * Records a joystick button event.
+   *
+   * \param event the event that will be recorded.
+   * \param time the offset from the start of the recorded session.
+   */
+  void record(const joy_button_event& event, const u64ms time)
+  {
+    add({time,
+         device_of(event.which()),
+         stress_input::button,
+         event.button(),
+         static_cast<int16>(to_underlying(event.state()))});
+  }
+
+  /**
+   * Records a joystick hat event.
+   *
+   * \param event the event that will be recorded.
+   * \param time the offset from the start of the recorded session.
+   */
+  void record(const joy_hat_event& event, const u64ms time)
+  {
+    const auto& data = event.get();
+    add({time, device_of(data.which), stress_input::hat, data.hat, data.value});
+  }
+
+  /// Removes all steps and forgets all recorded devices.
+  void clear() noexcept
+  {
+    mSteps.clear();
+    mDevices.clear();
+    mDeviceCount = 0;
+  }
+
+  [[nodiscard]] auto steps() const noexcept -> const std::vector<stress_step>&
+  {
+    return mSteps;
+  }
+
+  /// Returns the time of the last step, i.e. the length of the script.
+  [[nodiscard]] auto duration() const noexcept -> u64ms
+  {
+    return mSteps.empty() ? u64ms::zero() : mSteps.back().time;
+  }
+
+  /// Returns the amount of devices that are needed to replay the script.
+  [[nodiscard]] auto device_count() const noexcept -> usize { return mDeviceCount; }
+
+  [[nodiscard]] auto size() const noexcept -> usize { return mSteps.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mSteps.empty(); }
+
+ private:
+  std::vector<stress_step> mSteps;
+  std::vector<SDL_JoystickID> mDevices;  ///< Recorded instance IDs, by device index.
+  usize mDeviceCount {};
+
+  [[nodiscard]] auto device_of(const SDL_JoystickID id) -> usize
+  {
+    const auto iter = std::find(mDevices.begin(), mDevices.end(), id);
+    if (iter != mDevices.end()) {
+      return static_cast<usize>(iter - mDevices.begin());
+    }
+    else {
+      mDevices.push_back(id);
+      return mDevices.size() - 1u;
+    }
+  }
+};
+
+/// Configuration of the virtual devices and the generated load of an `input_stress` instance.
+struct stress_cfg final {
+  usize devices {8};                                    ///< The amount of virtual devices.
+  joystick_type type {joystick_type::game_controller};  ///< The type of the virtual devices.
+  int axes {6};                                         ///< The amount of axes per device.
+  int buttons {15};                                     ///< The amount of buttons per device.
+  int hats {1};                                         ///< The amount of hats per device.
+  double rate {};  ///< Generated changes per second and device, zero disables generation.
+  uint32 seed {0x9E3779B9u};  ///< The seed of the generated load, must not be zero.
+  bool loop {true};           ///< Indicates whether the script restarts when it finishes.
+};
+
+/**
+ * Drives a set of virtual joysticks, to stress-test input handling without physical devices.
+ *
+ * The generator attaches the configured amount of virtual devices and changes their axes,
+ * buttons and hats, either by replaying a script, at a fixed random rate, or both. All
+ * changes are applied in `update()`, which advances the session clock by the specified
+ * amount of time. This makes the load deterministic, since it only depends on the script, the
+ * seed and the time steps, which is useful for benchmarks.
+ *
+ * Note, SDL only emits events for the changed virtual device state when the joysticks are
+ * updated, which happens when events are pumped, e.g. using `event_handler::update()`.
+ *
+ * Game controller devices use the standard controller layout, so they are recognized as game
+ * controllers by SDL, with the default configuration of 6 axes, 15 buttons and one hat.
+ */
+class input_stress final {
+ public:
+  /**
+   * Attaches the virtual devices.
+   *
+   * \param cfg the configuration of the devices and generated load.
+   *
+   * \throws sdl_error if a virtual device cannot be attached or opened.
+   */
+  explicit input_stress(const stress_cfg& cfg = {}) : mCfg {cfg}, mRandom {cfg.seed}
+  {
+    if (mRandom == 0) {
+      mRandom = 1;
+    }
+
+    mDevices.reserve(mCfg.devices);
+    try {
+      for (usize i = 0; i < mCfg.devices; ++i) {
+        attach();
+      }
+    }
+    catch (...) {
+      detach_all();
+      throw;
+    }
+  }
+
+  CENTURION_DISABLE_COPY(input_stress)
+  CENTURION_DISABLE_MOVE(input_stress)
+
+  ~input_stress() noexcept { detach_all(); }
+
+  /**
+   * Sets the script that will be replayed, and restarts the session clock.
+   *
+   * \details Steps that refer to devices that aren't attached are ignored.
+   *
+   * \param script the script that will be replayed.
+   */
+  void play(stress_script script)
+  {
+    mScript = std::move(script);
+    restart();
+  }
+
+  /// Restarts the session clock and the script, without changing any device state.
+  void restart() noexcept
+  {
+    mClock = u64ms::zero();
+    mScriptClock = u64ms::zero();
+    mNext = 0;
+    for (auto& device : mDevices) {
+      device.pending = 0;
+    }
+  }
+
+  /**
+   * Advances the session clock and applies all changes that are due.
+   *
+   * \param elapsed the amount of time that has passed since the last update.
+   *
+   * \return the amount of changes that were applied.
+   */
+  auto update(const u64ms elapsed) -> usize
+  {
+    mClock += elapsed;
+
+    usize applied = replay(elapsed);
+    if (mCfg.rate > 0) {
+      applied += generate(elapsed);
+    }
+
+    mChanges += applied;
+    return applied;
+  }
+
+  /// Returns the SDL device index of a virtual device, which changes as devices are detached.
+  [[nodiscard]] auto device_index_of(const usize device) const noexcept -> maybe<int>
+  {
+    if (device < mDevices.size()) {
+      return find_index(mDevices[device].id);
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Returns the joystick instance ID of a virtual device.
+  [[nodiscard]] auto id_of(const usize device) const -> SDL_JoystickID
+  {
+    return mDevices.at(device).id;
+  }
+
+  /// Returns the total amount of applied changes.
+  [[nodiscard]] auto changes() const noexcept -> uint64 { return mChanges; }
+
+  /// Returns the amount of changes that SDL refused to apply.
+  [[nodiscard]] auto failed() const noexcept -> uint64 { return mFailed; }
+
+  /// Returns the time of the session clock.
+  [[nodiscard]] auto clock() const noexcept -> u64ms { return mClock; }
+
+  [[nodiscard]] auto script() const noexcept -> const stress_script& { return mScript; }
+
+  [[nodiscard]] auto device_count() const noexcept -> usize { return mDevices.size(); }
+
+  [[nodiscard]] auto config() const noexcept -> const stress_cfg& { return mCfg; }
+
+ private:
+  struct device final {
+    joystick stick;
+    SDL_JoystickID id {};
+    uint32 buttons {};  ///< The generated button states, as a bit mask.
+    double pending {};  ///< Accumulated generated changes that haven't been applied.
+  };
+
+  stress_cfg mCfg;
+  std::vector<device> mDevices;
+  stress_script mScript;
+  u64ms mClock {};
+  u64ms mScriptClock {};
+  usize mNext {};
+  uint64 mChanges {};
+  uint64 mFailed {};
+  uint32 mRandom {};
+
+  void attach()
+  {
+    const auto index = joystick::attach_virtual(mCfg.type, mCfg.axes, mCfg.buttons, mCfg.hats);
+    if (!index) {
+      throw sdl_error {};
+    }
+
+    try {
+      joystick stick {*index};
+      const auto id = stick.id();
+      mDevices.push_back({std::move(stick), id});
+    }
+    catch (...) {
+      joystick::detach_virtual(*index);
+      throw;
+    }
+  }
+
+  void detach_all() noexcept
+  {
+    while (!mDevices.empty()) {
+      /* Close the joystick before detaching it */
+      const auto id = mDevices.back().id;
+      mDevices.pop_back();
+
+      if (const auto index = find_index(id)) {
+        joystick::detach_virtual(*index);
+      }
+    }
+  }
+
+  [[nodiscard]] static auto find_index(const SDL_JoystickID id) noexcept -> maybe<int>
+  {
+    const auto count = SDL_NumJoysticks();
+    for (int index = 0; index < count; ++index) {
+      if (SDL_JoystickGetDeviceInstanceID(index) == id) {
+        return index;
+      }
+    }
+
+    return nothing;
+  }
+
+  auto replay(const u64ms elapsed) -> usize
+  {
+    const auto& steps = mScript.steps();
+    if (steps.empty()) {
+      return 0;
+    }
+
+    mScriptClock += elapsed;
+
+    usize applied = 0;
+    while (true) {
+      while (mNext < steps.size() && steps[mNext].time <= mScriptClock) {
+        applied += apply(steps[mNext]) ? 1u : 0u;
+        ++mNext;
+      }
+
+      /* Wrap around, keeping the overshoot, so that looping doesn't drift */
+      const auto duration = mScript.duration();
+      if (mNext == steps.size() && mCfg.loop && mScriptClock > duration) {
+        mScriptClock -= duration + u64ms {1};
+        mNext = 0;
+      }
+      else {
+        break;
+      }
+    }
+
+    return applied;
+  }
+
+  auto generate(const u64ms elapsed) -> usize
+  {
+    const auto seconds = static_cast<double>(elapsed.count()) / 1'000.0;
+
+    usize applied = 0;
+    for (usize index = 0; index < mDevices.size(); ++index) {
+      auto& dev = mDevices[index];
+      dev.pending += mCfg.rate * seconds;
+
+      while (dev.pending >= 1.0) {
+        dev.pending -= 1.0;
+        applied += apply(random_step(index)) ? 1u : 0u;
+      }
+    }
+
+    return applied;
+  }
+
+  [[nodiscard]] auto apply(const stress_step& step) -> bool
+  {
+    if (step.device >= mDevices.size()) {
+      return false;
+    }
+
+    auto& stick = mDevices[step.device].stick;
+
+    result ok = failure;
+    switch (step.input) {
+      case stress_input::axis:
+        ok = stick.set_virtual_axis(step.index, step.value);
+        break;
+
+      case stress_input::button:
+        ok = stick.set_virtual_button(step.index, static_cast<button_state>(step.value));
+        break;
+
+      case stress_input::hat:
+        ok = stick.set_virtual_hat(step.index, static_cast<hat_state>(step.value));
+        break;
+    }
+
+    if (!ok) {
+      ++mFailed;
+    }
+
+    return static_cast<bool>(ok);
+  }
+
+  [[nodiscard]] auto random_step(const usize index) noexcept -> stress_step
+  {
+    /* Only pick kinds of inputs that the devices actually have */
+    const int kinds[] = {mCfg.axes, mCfg.buttons, mCfg.hats};
+    const auto total = kinds[0] + kinds[1] + kinds[2];
+
+    stress_step step;
+    step.time = mClock;
+    step.device = index;
+
+    if (total <= 0) {
+      step.device = mDevices.size();  // Rejected by apply()
+      return step;
+    }
+
+    const auto pick = static_cast<int>(next_random() % static_cast<uint32>(total));
+    if (pick < kinds[0]) {
+      step.input = stress_input::axis;
+      step.index = static_cast<uint8>(pick);
+      step.value = static_cast<int16>(next_random() & 0xFFFFu);
+    }
+    else if (pick < kinds[0] + kinds[1]) {
+      const auto button = pick - kinds[0];
+      auto& buttons = mDevices[index].buttons;
+
+      /* Buttons are toggled, so that every change produces an event */
+      const auto mask = 1u << (button % 32);
+      buttons ^= mask;
+
+      step.input = stress_input::button;
+      step.index = static_cast<uint8>(button);
+      step.value = static_cast<int16>((buttons & mask) ? SDL_PRESSED : SDL_RELEASED);
+    }
+    else {
+      constexpr uint8 states[] = {SDL_HAT_CENTERED,
+                                  SDL_HAT_UP,
+                                  SDL_HAT_RIGHT,
+                                  SDL_HAT_DOWN,
+                                  SDL_HAT_LEFT,
+                                  SDL_HAT_RIGHTUP,
+                                  SDL_HAT_RIGHTDOWN,
+                                  SDL_HAT_LEFTUP,
+                                  SDL_HAT_LEFTDOWN};
+
+      step.input = stress_input::hat;
+      step.index = static_cast<uint8>(pick - kinds[0] - kinds[1]);
+      step.value = states[next_random() % 9u];
+    }
+
+    return step;
+  }
+
+  /* A xorshift generator, which makes the generated load reproducible across platforms */
+  auto next_random() noexcept -> uint32
+  {
+    mRandom ^= mRandom << 13u;
+    mRandom ^= mRandom >> 17u;
+    mRandom ^= mRandom << 5u;
+    return mRandom;
+  }
+};
+
+}  // namespace cen
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+#endif  // CENTURION_INPUT_INPUT_STRESS_HPP_
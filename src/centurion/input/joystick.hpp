@@ -29,7 +29,6 @@
 
 #include <cassert>      // assert
 #include <optional>     // optional, nullopt
-#include <ostream>      // ostream
 #include <string>       // string, to_string
 #include <string_view>  // string_view
 
@@ -50,6 +49,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 struct ball_axis_delta final {
@@ -108,11 +113,15 @@ enum class joystick_type {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const joystick_type type) -> std::ostream&
 {
   return stream << to_string(type);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 enum class joystick_power {
   unknown = SDL_JOYSTICK_POWER_UNKNOWN,  ///< Unknown power level.
   empty = SDL_JOYSTICK_POWER_EMPTY,      ///< Indicates <= 5% power.
@@ -153,11 +162,15 @@ enum class joystick_power {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const joystick_power power) -> std::ostream&
 {
   return stream << to_string(power);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 enum class hat_state : uint8 {
   centered = SDL_HAT_CENTERED,
   up = SDL_HAT_UP,
@@ -205,11 +218,15 @@ enum class hat_state : uint8 {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const hat_state state) -> std::ostream&
 {
   return stream << to_string(state);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 #if SDL_VERSION_ATLEAST(2, 24, 0)
 
 class virtual_joystick_desc final {
@@ -798,12 +815,16 @@ template <typename T>
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_joystick<T>& joystick) -> std::ostream&
 {
   return stream << to_string(joystick);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_INPUT_JOYSTICK_HPP_
\ No newline at end of file
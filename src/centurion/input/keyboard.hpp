@@ -27,16 +27,16 @@
 
 #include <SDL.h>
 
-#include <algorithm>  // copy
-#include <array>      // array
-#include <cassert>    // assert
-#include <ostream>    // ostream
-#include <sstream>    // stringstream
-#include <string>     // string, to_string
+#include <algorithm>    // copy
+#include <array>        // array
+#include <cassert>      // assert
+#include <string>       // string, to_string
+#include <string_view>  // string_view
 
 #include "../common/primitives.hpp"
 #include "../common/utils.hpp"
 #include "../common/version.hpp"
+#include "../detail/key_names.hpp"
 #include "../features.hpp"
 
 #if CENTURION_HAS_FEATURE_FORMAT
@@ -45,6 +45,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class key_mod : uint16 {
@@ -142,16 +148,15 @@ namespace detail {
   }
 
   const auto mask = to_underlying(mods);
-  std::stringstream stream;
+  std::string result;
 
-  auto check = [&stream, mask, count = 0](const key_mod mod, const char* name) mutable {
+  auto check = [&result, mask](const key_mod mod, const char* name) {
     if (mask & to_underlying(mod)) {
-      if (count != 0) {
-        stream << ',';
+      if (!result.empty()) {
+        result += ',';
       }
 
-      stream << name;
-      ++count;
+      result += name;
     }
   };
 
@@ -171,14 +176,18 @@ namespace detail {
   check(key_mod::caps, "caps");
   check(key_mod::mode, "mode");
 
-  return stream.str();
+  return result;
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const key_mod& mods) -> std::ostream&
 {
   return stream << to_string(mods);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 inline void set_modifiers(const key_mod mods) noexcept
 {
   SDL_SetModState(static_cast<SDL_Keymod>(mods));
@@ -253,10 +262,7 @@ class key_code final {
   {
   }
 
-  explicit key_code(const char* name) noexcept
-      : mKey {static_cast<SDL_KeyCode>(SDL_GetKeyFromName(name))}
-  {
-  }
+  explicit key_code(const char* name) noexcept : mKey {from_name_or_sdl(name)} {}
 
   explicit key_code(const std::string& name) noexcept : key_code {name.c_str()} {}
 
@@ -279,7 +285,7 @@ class key_code final {
   auto operator=(const char* name) noexcept -> key_code&
   {
     assert(name);
-    mKey = static_cast<SDL_KeyCode>(SDL_GetKeyFromName(name));
+    mKey = from_name_or_sdl(name);
     return *this;
   }
 
@@ -293,7 +299,44 @@ class key_code final {
     return mKey == SDLK_UNKNOWN;
   }
 
-  [[nodiscard]] auto name() const -> std::string { return SDL_GetKeyName(mKey); }
+  /**
+   * Returns the key code with the specified name, using precomputed tables.
+   *
+   * \details Unlike the constructors, this function doesn't allocate or call into SDL, which
+   * makes it suitable for loading large key binding configurations. Names are resolved like
+   * `SDL_GetKeyFromName()`, i.e. names of single characters are the key codes themselves,
+   * and other names are resolved using the scan code names and the default key map of SDL.
+   *
+   * \param name the case-insensitive name of the key.
+   *
+   * \return the key code; an unknown key code if the name isn't recognized.
+   */
+  [[nodiscard]] constexpr static auto from_name(const std::string_view name) noexcept
+      -> key_code
+  {
+    return key_code {static_cast<SDL_KeyCode>(detail::keycode_from_name(name))};
+  }
+
+  [[nodiscard]] auto name() const -> std::string
+  {
+    if (const auto name = detail::keycode_name(mKey)) {
+      return std::string {*name};
+    }
+    else {
+      return SDL_GetKeyName(mKey);
+    }
+  }
+
+  /**
+   * Returns the name of the key, using precomputed tables.
+   *
+   * \return the name of the key; an empty string if the key doesn't have an ASCII name, e.g.
+   *         the keys of other Unicode characters, use `name()` for those.
+   */
+  [[nodiscard]] constexpr auto name_view() const noexcept -> std::string_view
+  {
+    return detail::keycode_name(mKey).value_or(std::string_view {});
+  }
 
   [[nodiscard]] auto to_scancode() const noexcept -> SDL_Scancode
   {
@@ -310,6 +353,22 @@ class key_code final {
 
  private:
   SDL_KeyCode mKey {SDLK_UNKNOWN};
+
+  /* Names that aren't in the tables might be known by newer versions of SDL */
+  [[nodiscard]] static auto from_name_or_sdl(const char* name) noexcept -> SDL_KeyCode
+  {
+    if (!name) {
+      return SDLK_UNKNOWN;
+    }
+
+    const auto key = detail::keycode_from_name(name);
+    if (key != SDLK_UNKNOWN) {
+      return static_cast<SDL_KeyCode>(key);
+    }
+    else {
+      return static_cast<SDL_KeyCode>(SDL_GetKeyFromName(name));
+    }
+  }
 };
 
 [[nodiscard]] constexpr auto operator==(const key_code& a, const key_code& b) noexcept -> bool
@@ -331,11 +390,15 @@ class key_code final {
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const key_code& code) -> std::ostream&
 {
   return stream << to_string(code);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 /**
  * Represents a scan code.
  *
@@ -354,7 +417,7 @@ class scan_code final {
 
   explicit scan_code(const SDL_Keycode key) noexcept : mCode {SDL_GetScancodeFromKey(key)} {}
 
-  explicit scan_code(const char* name) noexcept : mCode {SDL_GetScancodeFromName(name)} {}
+  explicit scan_code(const char* name) noexcept : mCode {from_name_or_sdl(name)} {}
 
   explicit scan_code(const std::string& name) noexcept : scan_code {name.c_str()} {}
 
@@ -377,7 +440,7 @@ class scan_code final {
   auto operator=(const char* name) noexcept -> scan_code&
   {
     assert(name);
-    mCode = SDL_GetScancodeFromName(name);
+    mCode = from_name_or_sdl(name);
     return *this;
   }
 
@@ -393,7 +456,41 @@ class scan_code final {
     return mCode == SDL_SCANCODE_UNKNOWN;
   }
 
-  [[nodiscard]] auto name() const -> std::string { return SDL_GetScancodeName(mCode); }
+  /**
+   * Returns the scan code with the specified name, using precomputed tables.
+   *
+   * \details Unlike the constructors, this function doesn't allocate or call into SDL, which
+   * makes it suitable for loading large key binding configurations.
+   *
+   * \param name the case-insensitive name of the scan code.
+   *
+   * \return the scan code; an unknown scan code if the name isn't recognized.
+   */
+  [[nodiscard]] constexpr static auto from_name(const std::string_view name) noexcept
+      -> scan_code
+  {
+    return scan_code {detail::scancode_from_name(name)};
+  }
+
+  [[nodiscard]] auto name() const -> std::string
+  {
+    if (const auto name = detail::scancode_name(mCode)) {
+      return std::string {*name};
+    }
+    else {
+      return SDL_GetScancodeName(mCode);
+    }
+  }
+
+  /**
+   * Returns the name of the scan code, using precomputed tables.
+   *
+   * \return the name of the scan code; an empty string if the scan code has no name.
+   */
+  [[nodiscard]] constexpr auto name_view() const noexcept -> std::string_view
+  {
+    return detail::scancode_name(mCode).value_or(std::string_view {});
+  }
 
   [[nodiscard]] auto to_key() const noexcept -> SDL_KeyCode
   {
@@ -410,6 +507,22 @@ class scan_code final {
 
  private:
   SDL_Scancode mCode {SDL_SCANCODE_UNKNOWN};
+
+  /* Names that aren't in the tables might be known by newer versions of SDL */
+  [[nodiscard]] static auto from_name_or_sdl(const char* name) noexcept -> SDL_Scancode
+  {
+    if (!name) {
+      return SDL_SCANCODE_UNKNOWN;
+    }
+
+    const auto code = detail::scancode_from_name(name);
+    if (code != SDL_SCANCODE_UNKNOWN) {
+      return code;
+    }
+    else {
+      return SDL_GetScancodeFromName(name);
+    }
+  }
 };
 
 [[nodiscard]] constexpr auto operator==(const scan_code& a, const scan_code& b) noexcept
@@ -433,11 +546,15 @@ class scan_code final {
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const scan_code& code) -> std::ostream&
 {
   return stream << to_string(code);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 /**
  * Provides a view into the keyboard state.
  *
@@ -540,11 +657,15 @@ class keyboard final {
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const keyboard& keyboard) -> std::ostream&
 {
   return stream << to_string(keyboard);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace keycodes {
 
 inline constexpr key_code unknown;
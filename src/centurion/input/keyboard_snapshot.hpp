@@ -0,0 +1,325 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_INPUT_KEYBOARD_SNAPSHOT_HPP_
+#define CENTURION_INPUT_KEYBOARD_SNAPSHOT_HPP_
+
+#include <SDL.h>
+
+#include <array>   // array
+#include <cassert>  // assert
+
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "keyboard.hpp"
+
+namespace cen {
+
+/**
+ * Represents the state of all keys at a point in time, packed into a bitset.
+ *
+ * Snapshots are small (a bit per scan code), so they are cheap to copy and store, e.g. to keep
+ * a history of inputs for rollback netcode. Comparing two snapshots is done using word-wide
+ * bitwise operations, so computing the pressed and released keys for the entire keyboard
+ * only requires a handful of instructions.
+ *
+ * \see keyboard_state
+ */
+class keyboard_snapshot final {
+ public:
+  using word_type = uint64;
+
+  inline constexpr static usize word_bits = 64;
+  inline constexpr static usize word_count =
+      (static_cast<usize>(scan_code::count()) + word_bits - 1) / word_bits;
+
+  using word_array = std::array<word_type, word_count>;
+
+  constexpr keyboard_snapshot() noexcept = default;
+
+  constexpr explicit keyboard_snapshot(const word_array& words) noexcept : mWords {words} {}
+
+  /**
+   * Creates a snapshot from a keyboard state array.
+   *
+   * \param state the key states, indexed by scan codes.
+   * \param count the amount of keys in the state array.
+   *
+   * \return a snapshot of the keyboard state.
+   */
+  [[nodiscard]] static auto from(const uint8* state, const int count) noexcept
+      -> keyboard_snapshot
+  {
+    assert(state || count == 0);
+    keyboard_snapshot snapshot;
+
+    const auto n = (detail::min)(count, scan_code::count());
+    for (int index = 0; index < n; ++index) {
+      const auto bit = static_cast<word_type>(state[index] != 0);
+      snapshot.mWords[static_cast<usize>(index) / word_bits] |=
+          bit << (static_cast<usize>(index) % word_bits);
+    }
+
+    return snapshot;
+  }
+
+  /// Creates a snapshot of the current keyboard state.
+  [[nodiscard]] static auto capture() noexcept -> keyboard_snapshot
+  {
+    int count {};
+    const auto* state = SDL_GetKeyboardState(&count);
+    return from(state, count);
+  }
+
+  /// Sets whether a key is pressed in the snapshot.
+  constexpr void set(const scan_code& code, const bool pressed) noexcept
+  {
+    if (valid(code)) {
+      const auto mask = mask_of(code);
+      auto& word = mWords[word_of(code)];
+      word = pressed ? (word | mask) : (word & ~mask);
+    }
+  }
+
+  /// Indicates whether a key is pressed in the snapshot.
+  [[nodiscard]] constexpr auto is_pressed(const scan_code& code) const noexcept -> bool
+  {
+    return valid(code) && (mWords[word_of(code)] & mask_of(code));
+  }
+
+  /// Returns a snapshot of the keys that are pressed in this snapshot but not in another.
+  [[nodiscard]] constexpr auto pressed_since(const keyboard_snapshot& previous) const noexcept
+      -> keyboard_snapshot
+  {
+    keyboard_snapshot edges;
+    for (usize index = 0; index < word_count; ++index) {
+      edges.mWords[index] = mWords[index] & ~previous.mWords[index];
+    }
+    return edges;
+  }
+
+  /// Returns a snapshot of the keys that are pressed in another snapshot but not in this.
+  [[nodiscard]] constexpr auto released_since(const keyboard_snapshot& previous) const noexcept
+      -> keyboard_snapshot
+  {
+    return previous.pressed_since(*this);
+  }
+
+  /// Returns a snapshot of the keys that differ between this and another snapshot.
+  [[nodiscard]] constexpr auto changed_since(const keyboard_snapshot& previous) const noexcept
+      -> keyboard_snapshot
+  {
+    keyboard_snapshot edges;
+    for (usize index = 0; index < word_count; ++index) {
+      edges.mWords[index] = mWords[index] ^ previous.mWords[index];
+    }
+    return edges;
+  }
+
+  /**
+   * Invokes a function object for each pressed key in the snapshot.
+   *
+   * Only the set bits are visited, so this is efficient when few keys are pressed.
+   *
+   * \param callable a function object with the signature `void(scan_code)`.
+   */
+  template <typename T>
+  void each(T&& callable) const
+  {
+    for (usize index = 0; index < word_count; ++index) {
+      auto word = mWords[index];
+      while (word) {
+        const auto bit = static_cast<usize>(detail::countr_zero(word));
+        callable(scan_code {static_cast<SDL_Scancode>(index * word_bits + bit)});
+        word &= word - 1u;
+      }
+    }
+  }
+
+  /// Returns the amount of pressed keys in the snapshot.
+  [[nodiscard]] constexpr auto count() const noexcept -> usize
+  {
+    usize result = 0;
+    for (const auto word : mWords) {
+      result += static_cast<usize>(detail::popcount(word));
+    }
+    return result;
+  }
+
+  /// Indicates whether no keys are pressed in the snapshot.
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool
+  {
+    for (const auto word : mWords) {
+      if (word) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Clears all key states in the snapshot.
+  constexpr void clear() noexcept { mWords = {}; }
+
+  [[nodiscard]] constexpr auto words() const noexcept -> const word_array& { return mWords; }
+
+ private:
+  word_array mWords {};
+
+  [[nodiscard]] constexpr static auto valid(const scan_code& code) noexcept -> bool
+  {
+    return code.get() >= 0 && code.get() < scan_code::count();
+  }
+
+  [[nodiscard]] constexpr static auto word_of(const scan_code& code) noexcept -> usize
+  {
+    return static_cast<usize>(code.get()) / word_bits;
+  }
+
+  [[nodiscard]] constexpr static auto mask_of(const scan_code& code) noexcept -> word_type
+  {
+    return word_type {1} << (static_cast<usize>(code.get()) % word_bits);
+  }
+};
+
+[[nodiscard]] constexpr auto operator==(const keyboard_snapshot& a,
+                                        const keyboard_snapshot& b) noexcept -> bool
+{
+  for (usize index = 0; index < keyboard_snapshot::word_count; ++index) {
+    if (a.words()[index] != b.words()[index]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+[[nodiscard]] constexpr auto operator!=(const keyboard_snapshot& a,
+                                        const keyboard_snapshot& b) noexcept -> bool
+{
+  return !(a == b);
+}
+
+/**
+ * A double-buffered keyboard state based on bitset snapshots.
+ *
+ * This is an alternative to `keyboard` that doesn't copy the entire SDL keyboard state array
+ * into a second buffer for each update. Instead, the current and previous states are stored
+ * as packed snapshots in two buffers that are swapped on each refresh.
+ *
+ * \see keyboard
+ * \see keyboard_snapshot
+ */
+class keyboard_state final {
+ public:
+  /// Creates a keyboard state, capturing the current state of the keyboard.
+  keyboard_state() noexcept
+  {
+    mBuffers[0] = keyboard_snapshot::capture();
+    mBuffers[1] = mBuffers[0];
+  }
+
+  /// Swaps the buffers and captures the current state of the keyboard.
+  void refresh() noexcept { refresh(keyboard_snapshot::capture()); }
+
+  /// Swaps the buffers and uses the supplied snapshot as the current keyboard state.
+  void refresh(const keyboard_snapshot& snapshot) noexcept
+  {
+    mCurrent ^= 1u;
+    mBuffers[mCurrent] = snapshot;
+  }
+
+  /// Indicates whether a key is being pressed.
+  [[nodiscard]] auto is_pressed(const scan_code& code) const noexcept -> bool
+  {
+    return current().is_pressed(code);
+  }
+
+  [[nodiscard]] auto is_pressed(const key_code& code) const noexcept -> bool
+  {
+    return is_pressed(code.to_scancode());
+  }
+
+  /// Indicates whether a key is held, i.e. pressed for at least two consecutive updates.
+  [[nodiscard]] auto is_held(const scan_code& code) const noexcept -> bool
+  {
+    return current().is_pressed(code) && previous().is_pressed(code);
+  }
+
+  [[nodiscard]] auto is_held(const key_code& code) const noexcept -> bool
+  {
+    return is_held(code.to_scancode());
+  }
+
+  /// Indicates whether a key was initially pressed during the the last update.
+  [[nodiscard]] auto just_pressed(const scan_code& code) const noexcept -> bool
+  {
+    return current().is_pressed(code) && !previous().is_pressed(code);
+  }
+
+  [[nodiscard]] auto just_pressed(const key_code& code) const noexcept -> bool
+  {
+    return just_pressed(code.to_scancode());
+  }
+
+  /// Indicates whether a key was released during the the last update.
+  [[nodiscard]] auto just_released(const scan_code& code) const noexcept -> bool
+  {
+    return !current().is_pressed(code) && previous().is_pressed(code);
+  }
+
+  [[nodiscard]] auto just_released(const key_code& code) const noexcept -> bool
+  {
+    return just_released(code.to_scancode());
+  }
+
+  /// Returns all keys that were initially pressed during the last update.
+  [[nodiscard]] auto pressed() const noexcept -> keyboard_snapshot
+  {
+    return current().pressed_since(previous());
+  }
+
+  /// Returns all keys that were released during the last update.
+  [[nodiscard]] auto released() const noexcept -> keyboard_snapshot
+  {
+    return current().released_since(previous());
+  }
+
+  [[nodiscard]] auto current() const noexcept -> const keyboard_snapshot&
+  {
+    return mBuffers[mCurrent];
+  }
+
+  [[nodiscard]] auto previous() const noexcept -> const keyboard_snapshot&
+  {
+    return mBuffers[mCurrent ^ 1u];
+  }
+
+ private:
+  std::array<keyboard_snapshot, 2> mBuffers;
+  usize mCurrent {};
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_KEYBOARD_SNAPSHOT_HPP_
@@ -27,7 +27,6 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string>       // string, to_string
 #include <string_view>  // string_view
 
@@ -47,6 +46,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class system_cursor {
@@ -113,11 +118,15 @@ enum class system_cursor {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const system_cursor cursor) -> std::ostream&
 {
   return stream << to_string(cursor);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 enum class mouse_button : uint8 {
   left = SDL_BUTTON_LEFT,
   middle = SDL_BUTTON_MIDDLE,
@@ -149,11 +158,15 @@ enum class mouse_button : uint8 {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const mouse_button button) -> std::ostream&
 {
   return stream << to_string(button);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 /// Provides a view into the mouse state.
 class mouse final {
  public:
@@ -319,11 +332,15 @@ class mouse final {
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const mouse& mouse) -> std::ostream&
 {
   return stream << to_string(mouse);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 template <typename T>
 class basic_cursor;
 
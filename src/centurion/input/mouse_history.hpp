@@ -0,0 +1,195 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_INPUT_MOUSE_HISTORY_HPP_
+#define CENTURION_INPUT_MOUSE_HISTORY_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <vector>   // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../events/mouse_events.hpp"
+#include "../video/renderer.hpp"
+
+namespace cen {
+
+/// Represents a single mouse position sample, obtained from a mouse motion event.
+struct mouse_sample final {
+  u32ms time {};    ///< The timestamp of the motion event.
+  fpoint position;  ///< The position of the mouse.
+  fpoint delta;     ///< The relative motion since the previous event.
+};
+
+/**
+ * Records the mouse positions reported by mouse motion events.
+ *
+ * The `mouse` class only samples the mouse state once per frame, which discards any motion
+ * in between frames. This class instead keeps a ring buffer of all reported positions, which
+ * is useful for drawing and aiming code that needs precise input without having to raise
+ * the frame rate.
+ *
+ * Call `new_frame()` once per frame before handling events, and then feed the history with
+ * all mouse motion events. The samples of the current frame are then available through
+ * `frame_size()`, `frame_sample()` and `frame_delta()`.
+ *
+ * \see mouse
+ */
+class mouse_history final {
+ public:
+  /**
+   * Creates a mouse history.
+   *
+   * \param capacity the maximum amount of stored samples, the oldest samples are discarded.
+   *
+   * \throws exception if the capacity is zero.
+   */
+  explicit mouse_history(const usize capacity = 128) : mSamples(capacity)
+  {
+    if (capacity == 0) {
+      throw exception {"Cannot create mouse history without capacity!"};
+    }
+  }
+
+  /// Records the position reported by a mouse motion event.
+  void record(const mouse_motion_event& event)
+  {
+    const auto x = static_cast<float>(event.x());
+    const auto y = static_cast<float>(event.y());
+    const auto dx = static_cast<float>(event.dx());
+    const auto dy = static_cast<float>(event.dy());
+    push({event.timestamp(), {x, y}, {dx, dy}});
+  }
+
+  /// Records the position reported by a mouse motion event, in logical renderer coordinates.
+  template <typename T>
+  void record(const mouse_motion_event& event, const basic_renderer<T>& renderer)
+  {
+    const auto logicalSize = renderer.logical_size();
+    if (logicalSize.width != 0 && logicalSize.height != 0) {
+      const auto position = renderer.to_logical(event.x(), event.y());
+      const auto origin = renderer.to_logical(event.x() - event.dx(), event.y() - event.dy());
+      push({event.timestamp(), position, position - origin});
+    }
+    else {
+      /* No logical size has been set for the renderer */
+      record(event);
+    }
+  }
+
+  /// Marks the start of a new frame, subsequent samples belong to the new frame.
+  void new_frame() noexcept
+  {
+    mFrameSize = 0;
+    mFrameDelta = {};
+  }
+
+  /// Removes all samples.
+  void clear() noexcept
+  {
+    mHead = 0;
+    mSize = 0;
+    new_frame();
+  }
+
+  /**
+   * Returns a stored sample.
+   *
+   * \param index the index of the sample, where zero is the oldest stored sample.
+   *
+   * \return the sample.
+   */
+  [[nodiscard]] auto at(const usize index) const noexcept -> const mouse_sample&
+  {
+    assert(index < mSize);
+    return mSamples[(mHead + mSamples.size() - mSize + index) % mSamples.size()];
+  }
+
+  /**
+   * Returns a sample from the current frame.
+   *
+   * \param index the index of the sample, where zero is the oldest sample in the frame.
+   *
+   * \return the sample.
+   */
+  [[nodiscard]] auto frame_sample(const usize index) const noexcept -> const mouse_sample&
+  {
+    assert(index < frame_size());
+    return at(mSize - frame_size() + index);
+  }
+
+  /// Returns the most recent sample, if there is one.
+  [[nodiscard]] auto latest() const noexcept -> maybe<mouse_sample>
+  {
+    if (mSize != 0) {
+      return at(mSize - 1);
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Returns the total motion during the current frame, including discarded samples.
+  [[nodiscard]] auto frame_delta() const noexcept -> fpoint { return mFrameDelta; }
+
+  /// Returns the amount of stored samples that belong to the current frame.
+  [[nodiscard]] auto frame_size() const noexcept -> usize
+  {
+    return (mFrameSize < mSize) ? mFrameSize : mSize;
+  }
+
+  /// Returns the amount of stored samples.
+  [[nodiscard]] auto size() const noexcept -> usize { return mSize; }
+
+  [[nodiscard]] auto capacity() const noexcept -> usize { return mSamples.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mSize == 0; }
+
+ private:
+  std::vector<mouse_sample> mSamples;
+  usize mHead {};       ///< Index of the next sample to write.
+  usize mSize {};       ///< Amount of stored samples.
+  usize mFrameSize {};  ///< Amount of samples recorded during the current frame.
+  fpoint mFrameDelta;
+
+  void push(const mouse_sample& sample) noexcept
+  {
+    mSamples[mHead] = sample;
+    mHead = (mHead + 1) % mSamples.size();
+
+    if (mSize < mSamples.size()) {
+      ++mSize;
+    }
+
+    ++mFrameSize;
+    mFrameDelta = mFrameDelta + sample.delta;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_MOUSE_HISTORY_HPP_
@@ -0,0 +1,422 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_INPUT_RUMBLE_SCHEDULER_HPP_
+#define CENTURION_INPUT_RUMBLE_SCHEDULER_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>    // remove_if, find_if
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/timer.hpp"
+#include "controller.hpp"
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// Represents the ways that concurrent rumble effects of the same priority are combined.
+enum class rumble_mix {
+  max,  ///< Each motor uses the strongest intensity.
+  sum   ///< The intensities are added per motor, saturating at the maximum intensity.
+};
+
+[[nodiscard]] constexpr auto to_string(const rumble_mix mix) -> std::string_view
+{
+  switch (mix) {
+    case rumble_mix::max:
+      return "max";
+
+    case rumble_mix::sum:
+      return "sum";
+
+    default:
+      throw exception {"Did not recognize rumble mix!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const rumble_mix mix) -> std::ostream&
+{
+  return stream << to_string(mix);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/// A rumble request, the effect starts at the update following its submission.
+struct rumble_effect final {
+  uint16 low {};            ///< The intensity of the low frequency (left) motor.
+  uint16 high {};           ///< The intensity of the high frequency (right) motor.
+  uint16 left_trigger {};   ///< The intensity of the left trigger motor, if any.
+  uint16 right_trigger {};  ///< The intensity of the right trigger motor, if any.
+  u32ms duration {};        ///< The duration of the effect.
+  int priority {};          ///< Only the effects with the highest active priority are felt.
+};
+
+/**
+ * Merges rumble requests, and sends at most one rumble update per controller and frame.
+ *
+ * Calling `controller::rumble()` for every hit can be expensive, since some controllers
+ * perform a HID write for every call, which can saturate the connection during bursts of
+ * effects. This class instead collects the requested effects, and `update()` combines the
+ * active effects of each controller into a single rumble state, which is only sent when it
+ * changes.
+ *
+ * Effects expire after their duration, or when they are cancelled. Among the active effects
+ * of a controller, only the effects with the highest priority are felt, and these are
+ * combined according to the rumble mix. Trigger rumble is sent separately from the motors,
+ * and only if the effects use it.
+ *
+ * \see rumble_effect
+ * \see rumble_mix
+ */
+class rumble_scheduler final {
+ public:
+  using id_type = SDL_JoystickID;
+  using handle_type = uint32;
+
+  /// Creates a rumble scheduler.
+  explicit rumble_scheduler(const rumble_mix mix = rumble_mix::max) noexcept : mMix {mix} {}
+
+  /**
+   * Adds a rumble effect for a controller.
+   *
+   * \param controller the instance ID of the controller.
+   * \param effect the requested effect.
+   *
+   * \return a handle that can be used to cancel the effect.
+   */
+  auto add(const id_type controller, const rumble_effect& effect) -> handle_type
+  {
+    const auto handle = ++mNextHandle;
+    get_channel(controller).effects.push_back({effect, u64ms::zero(), handle, true});
+    return handle;
+  }
+
+  /// Adds a rumble effect for a controller.
+  template <typename T>
+  auto add(const basic_controller<T>& controller, const rumble_effect& effect) -> handle_type
+  {
+    return add(SDL_JoystickInstanceID(SDL_GameControllerGetJoystick(controller.get())),
+               effect);
+  }
+
+  /**
+   * Cancels an effect before it expires.
+   *
+   * \param handle the handle of the effect.
+   *
+   * \return `true` if the effect was active or pending; `false` otherwise.
+   */
+  auto cancel(const handle_type handle) noexcept -> bool
+  {
+    for (auto& channel : mChannels) {
+      auto& effects = channel.effects;
+      const auto it = std::find_if(effects.begin(), effects.end(), [=](const auto& active) {
+        return active.handle == handle;
+      });
+
+      if (it != effects.end()) {
+        effects.erase(it);
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /// Cancels all effects of a controller, it stops rumbling at the next update.
+  void cancel_all(const id_type controller) noexcept
+  {
+    for (auto& channel : mChannels) {
+      if (channel.id == controller) {
+        channel.effects.clear();
+      }
+    }
+  }
+
+  /// Cancels all effects, all controllers stop rumbling at the next update.
+  void cancel_all() noexcept
+  {
+    for (auto& channel : mChannels) {
+      channel.effects.clear();
+    }
+  }
+
+  /**
+   * Starts pending effects, removes expired effects and sends the changed rumble states.
+   *
+   * This should be called once per frame. Controllers that have been disconnected are
+   * forgotten, along with their effects.
+   *
+   * \param now the current time, e.g. obtained with `ticks64()`.
+   *
+   * \return the amount of rumble updates that were sent.
+   */
+  auto update(const u64ms now) -> usize
+  {
+    usize sent = 0;
+
+    for (auto& channel : mChannels) {
+      auto* controller = SDL_GameControllerFromInstanceID(channel.id);
+      if (!controller) {
+        channel.effects.clear();
+        channel.sent = {};
+        channel.sentTriggers = {};
+        continue;
+      }
+
+      auto& effects = channel.effects;
+      for (auto& active : effects) {
+        if (active.pending) {
+          active.end = now + active.effect.duration;
+          active.pending = false;
+        }
+      }
+
+      effects.erase(std::remove_if(effects.begin(),
+                                   effects.end(),
+                                   [=](const auto& active) { return active.end <= now; }),
+                    effects.end());
+
+      const auto target = combine(effects);
+      sent += send_motors(channel, controller, target, now);
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+      sent += send_triggers(channel, controller, target, now);
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+    }
+
+    /* Forget idle controllers, so that the channels don't accumulate */
+    mChannels.erase(std::remove_if(mChannels.begin(),
+                                   mChannels.end(),
+                                   [](const channel& channel) {
+                                     return channel.effects.empty() &&
+                                            channel.sent == motor_state {} &&
+                                            channel.sentTriggers == motor_state {};
+                                   }),
+                    mChannels.end());
+
+    return sent;
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+  /// Updates the scheduler using the current time.
+  auto update() -> usize { return update(ticks64()); }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+  /// Returns the amount of active and pending effects for a controller.
+  [[nodiscard]] auto count(const id_type controller) const noexcept -> usize
+  {
+    for (const auto& channel : mChannels) {
+      if (channel.id == controller) {
+        return channel.effects.size();
+      }
+    }
+
+    return 0;
+  }
+
+  /// Returns the amount of active and pending effects for all controllers.
+  [[nodiscard]] auto count() const noexcept -> usize
+  {
+    usize result = 0;
+    for (const auto& channel : mChannels) {
+      result += channel.effects.size();
+    }
+    return result;
+  }
+
+  void set_mix(const rumble_mix mix) noexcept { mMix = mix; }
+
+  [[nodiscard]] auto mix() const noexcept -> rumble_mix { return mMix; }
+
+ private:
+  struct active_effect final {
+    rumble_effect effect;
+    u64ms end {};         ///< The time at which the effect expires.
+    handle_type handle {};
+    bool pending {};      ///< Indicates whether the effect has yet to start.
+  };
+
+  struct motor_state final {
+    uint16 a {};
+    uint16 b {};
+    u64ms end {};  ///< The time at which the sent state expires.
+
+    [[nodiscard]] auto operator==(const motor_state& other) const noexcept -> bool
+    {
+      return a == other.a && b == other.b && end == other.end;
+    }
+  };
+
+  struct combined_state final {
+    motor_state motors;
+    motor_state triggers;
+  };
+
+  struct channel final {
+    id_type id {};
+    std::vector<active_effect> effects;
+    motor_state sent;          ///< The last sent motor state.
+    motor_state sentTriggers;  ///< The last sent trigger state.
+  };
+
+  std::vector<channel> mChannels;
+  handle_type mNextHandle {};
+  rumble_mix mMix {};
+
+  [[nodiscard]] auto get_channel(const id_type id) -> channel&
+  {
+    for (auto& channel : mChannels) {
+      if (channel.id == id) {
+        return channel;
+      }
+    }
+
+    auto& channel = mChannels.emplace_back();
+    channel.id = id;
+    return channel;
+  }
+
+  [[nodiscard]] auto merge(const uint16 a, const uint16 b) const noexcept -> uint16
+  {
+    if (mMix == rumble_mix::sum) {
+      return static_cast<uint16>((detail::min)(uint32 {a} + uint32 {b}, uint32 {0xFFFF}));
+    }
+    else {
+      return (detail::max)(a, b);
+    }
+  }
+
+  [[nodiscard]] auto combine(const std::vector<active_effect>& effects) const noexcept
+      -> combined_state
+  {
+    combined_state state;
+    if (effects.empty()) {
+      return state;
+    }
+
+    auto priority = effects.front().effect.priority;
+    for (const auto& active : effects) {
+      priority = (detail::max)(priority, active.effect.priority);
+    }
+
+    for (const auto& active : effects) {
+      const auto& effect = active.effect;
+      if (effect.priority != priority) {
+        continue;
+      }
+
+      auto& motors = state.motors;
+      motors.a = merge(motors.a, effect.low);
+      motors.b = merge(motors.b, effect.high);
+      if (effect.low != 0 || effect.high != 0) {
+        motors.end = (detail::max)(motors.end, active.end);
+      }
+
+      auto& triggers = state.triggers;
+      triggers.a = merge(triggers.a, effect.left_trigger);
+      triggers.b = merge(triggers.b, effect.right_trigger);
+      if (effect.left_trigger != 0 || effect.right_trigger != 0) {
+        triggers.end = (detail::max)(triggers.end, active.end);
+      }
+    }
+
+    return state;
+  }
+
+  /* Returns the duration to send for a state, zero stops the rumble */
+  [[nodiscard]] static auto remaining(const motor_state& state, const u64ms now) noexcept
+      -> uint32
+  {
+    if ((state.a == 0 && state.b == 0) || state.end <= now) {
+      return 0;
+    }
+
+    const auto count = (state.end - now).count();
+    return static_cast<uint32>((detail::min)(count, uint64 {0xFFFF'FFFF}));
+  }
+
+  static auto send_motors(channel& channel,
+                          SDL_GameController* controller,
+                          const combined_state& target,
+                          const u64ms now) noexcept -> usize
+  {
+    auto state = target.motors;
+    if (state.a == 0 && state.b == 0) {
+      state = {};
+    }
+
+    if (state == channel.sent) {
+      return 0;
+    }
+
+    /* Failures are ignored, resending the same state every frame wouldn't help */
+    SDL_GameControllerRumble(controller, state.a, state.b, remaining(state, now));
+    channel.sent = state;
+
+    return 1;
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+
+  static auto send_triggers(channel& channel,
+                            SDL_GameController* controller,
+                            const combined_state& target,
+                            const u64ms now) noexcept -> usize
+  {
+    auto state = target.triggers;
+    if (state.a == 0 && state.b == 0) {
+      state = {};
+    }
+
+    if (state == channel.sentTriggers) {
+      return 0;
+    }
+
+    SDL_GameControllerRumbleTriggers(controller, state.a, state.b, remaining(state, now));
+    channel.sentTriggers = state;
+
+    return 1;
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_RUMBLE_SCHEDULER_HPP_
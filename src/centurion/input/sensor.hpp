@@ -30,7 +30,6 @@
 #include <array>        // array
 #include <cstddef>      // size_t
 #include <optional>     // optional
-#include <ostream>      // ostream
 #include <string>       // string, to_string
 #include <string_view>  // string_view
 
@@ -48,6 +47,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 using sensor_id = SDL_SensorID;
@@ -84,11 +89,15 @@ enum class sensor_type {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const sensor_type type) -> std::ostream&
 {
   return stream << to_string(type);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 template <typename T>
 class basic_sensor;
 
@@ -256,12 +265,16 @@ template <typename T>
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_sensor<T>& sensor) -> std::ostream&
 {
   return stream << to_string(sensor);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_INPUT_SENSOR_HPP_
@@ -0,0 +1,221 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_INPUT_SENSOR_BUFFER_HPP_
+#define CENTURION_INPUT_SENSOR_BUFFER_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>  // copy_n
+#include <array>      // array
+#include <atomic>     // atomic
+#include <vector>     // vector
+
+#include "../common/primitives.hpp"
+#include "../events/event_channel.hpp"
+#include "sensor.hpp"
+
+namespace cen {
+
+/// Represents a single sensor reading.
+struct sensor_sample final {
+  sensor_id which {-1};                     ///< The instance ID of the sensor or controller.
+  sensor_type type {sensor_type::unknown};  ///< The type of the sensor, if known.
+  u32ms time {};                            ///< The tick count when the sample was recorded.
+  uint64 timestamp_us {};                   ///< The sensor timestamp in microseconds, or zero.
+  std::array<float, 6> data {};             ///< The sensor values.
+};
+
+/**
+ * A lock-free buffer of sensor samples, that doesn't lose readings between frames.
+ *
+ * The buffer can be fed from any thread, e.g. from an event watch that receives sensor events
+ * as they are pushed to the event queue, or from a thread that polls a sensor. All samples
+ * that were recorded since the last frame can then be obtained using `take()`. Sensor
+ * timestamps are stored when they are available, i.e. for SDL 2.26 and later.
+ *
+ * Note, instances of this class are function objects that accept SDL events, so they can be
+ * used directly with `event_watch`.
+ *
+ * \see event_watch
+ */
+class sensor_buffer final {
+ public:
+  /**
+   * Creates a sensor buffer for all sensors.
+   *
+   * \param capacity the maximum amount of buffered samples.
+   */
+  explicit sensor_buffer(const usize capacity = 1024) : mChannel {capacity} {}
+
+  /**
+   * Creates a sensor buffer that only records samples from a specific sensor or controller.
+   *
+   * \param which the instance ID of the sensor, or of the controller for controller sensors.
+   * \param capacity the maximum amount of buffered samples.
+   */
+  sensor_buffer(const sensor_id which, const usize capacity)
+      : mChannel {capacity}
+      , mFilter {which}
+  {
+  }
+
+  /// Records the values of a sensor event.
+  auto record(const SDL_SensorEvent& event) -> bool
+  {
+    if (!accepts(event.which)) {
+      return false;
+    }
+
+    sensor_sample sample;
+    sample.which = event.which;
+    sample.time = u32ms {event.timestamp};
+    std::copy_n(event.data, 6, sample.data.begin());
+
+#if SDL_VERSION_ATLEAST(2, 26, 0)
+    sample.timestamp_us = event.timestamp_us;
+#endif  // SDL_VERSION_ATLEAST(2, 26, 0)
+
+    return push(sample);
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+
+  /// Records the values of a controller sensor event.
+  auto record(const SDL_ControllerSensorEvent& event) -> bool
+  {
+    if (!accepts(event.which)) {
+      return false;
+    }
+
+    sensor_sample sample;
+    sample.which = event.which;
+    sample.type = static_cast<sensor_type>(event.sensor);
+    sample.time = u32ms {event.timestamp};
+    std::copy_n(event.data, 3, sample.data.begin());
+
+#if SDL_VERSION_ATLEAST(2, 26, 0)
+    sample.timestamp_us = event.timestamp_us;
+#endif  // SDL_VERSION_ATLEAST(2, 26, 0)
+
+    return push(sample);
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+
+  /// Records the event if it is a sensor event, which makes it possible to use as event watch.
+  void operator()(const SDL_Event& event)
+  {
+    if (event.type == SDL_SENSORUPDATE) {
+      record(event.sensor);
+    }
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    else if (event.type == SDL_CONTROLLERSENSORUPDATE) {
+      record(event.csensor);
+    }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+  }
+
+  /**
+   * Records the current values of a sensor.
+   *
+   * This is intended to be called from a dedicated polling thread, after updating the sensor.
+   *
+   * \param sensor the sensor that will be read.
+   *
+   * \return `true` if a sample was recorded; `false` otherwise.
+   */
+  template <typename T>
+  auto poll(const basic_sensor<T>& sensor) -> bool
+  {
+    const auto id = SDL_SensorGetInstanceID(sensor.get());
+    if (!accepts(id)) {
+      return false;
+    }
+
+    sensor_sample sample;
+    sample.which = id;
+    sample.type = sensor.type();
+    sample.time = u32ms {SDL_GetTicks()};
+
+#if SDL_VERSION_ATLEAST(2, 26, 0)
+    const auto res = SDL_SensorGetDataWithTimestamp(sensor.get(),
+                                                    &sample.timestamp_us,
+                                                    sample.data.data(),
+                                                    isize(sample.data));
+#else
+    const auto res = SDL_SensorGetData(sensor.get(), sample.data.data(), isize(sample.data));
+#endif  // SDL_VERSION_ATLEAST(2, 26, 0)
+
+    return res == 0 && push(sample);
+  }
+
+  /**
+   * Moves all buffered samples into a vector, in the order that they were recorded.
+   *
+   * This should only be called by a single thread, usually once per frame.
+   *
+   * \param samples the vector that will be cleared and then filled with the samples.
+   *
+   * \return the amount of obtained samples.
+   */
+  auto take(std::vector<sensor_sample>& samples) -> usize
+  {
+    samples.clear();
+    return mChannel.drain([&](sensor_sample&& sample) { samples.push_back(sample); });
+  }
+
+  /// Returns the amount of samples that were discarded because the buffer was full.
+  [[nodiscard]] auto dropped() const noexcept -> usize
+  {
+    return mDropped.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto capacity() const noexcept -> usize { return mChannel.capacity(); }
+
+ private:
+  event_channel<sensor_sample> mChannel;
+  std::atomic<usize> mDropped {0};
+  maybe<sensor_id> mFilter;
+
+  [[nodiscard]] auto accepts(const sensor_id which) const noexcept -> bool
+  {
+    return !mFilter || *mFilter == which;
+  }
+
+  auto push(const sensor_sample& sample) -> bool
+  {
+    if (mChannel.push(sample)) {
+      return true;
+    }
+    else {
+      mDropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_SENSOR_BUFFER_HPP_
@@ -28,12 +28,17 @@
 #include <SDL.h>
 
 #include <optional>     // optional
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 #include "../common/primitives.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 using touch_id = SDL_TouchID;
@@ -75,11 +80,15 @@ enum class touch_device_type {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const touch_device_type type) -> std::ostream&
 {
   return stream << to_string(type);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 /// Provides a view into the state of a touch finger.
 class finger final {
  public:
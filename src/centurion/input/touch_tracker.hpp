@@ -0,0 +1,302 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_INPUT_TOUCH_TRACKER_HPP_
+#define CENTURION_INPUT_TOUCH_TRACKER_HPP_
+
+#include <SDL.h>
+
+#include <array>    // array
+#include <cassert>  // assert
+#include <cmath>    // atan2
+#include <cstddef>  // ptrdiff_t
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../events/event_base.hpp"
+#include "touch.hpp"
+
+namespace cen {
+
+/// Represents the state of a finger tracked by a `touch_tracker`.
+struct tracked_finger final {
+  SDL_FingerID id {};  ///< The SDL finger ID.
+  touch_id touch {};   ///< The touch device that the finger belongs to.
+  fpoint position;     ///< The current normalized position.
+  fpoint start;        ///< The normalized position where the finger was pressed.
+  fpoint velocity;     ///< The smoothed velocity, in normalized units per second.
+  float pressure {};   ///< The current pressure.
+  u32ms down_time {};  ///< The time when the finger was pressed.
+  u32ms last_time {};  ///< The time of the latest event.
+};
+
+/**
+ * Tracks the state of all fingers on touch devices, using touch finger events.
+ *
+ * The finger states are stored in fixed-size arrays and are updated incrementally from touch
+ * finger events, so there is no need to query SDL for every finger each frame. Pinch and
+ * rotation gestures are computed while updating the finger states, relative to the centroid
+ * of all pressed fingers.
+ *
+ * Call `new_frame()` once per frame to reset the accumulated gesture deltas.
+ */
+class touch_tracker final {
+ public:
+  inline constexpr static usize max_fingers = 10;
+
+  /**
+   * Updates the finger states using a touch finger event.
+   *
+   * \param event the event that will be processed.
+   *
+   * \return `true` if the event was used; `false` if there was no room for another finger.
+   */
+  auto update(const SDL_TouchFingerEvent& event) noexcept -> bool
+  {
+    switch (event.type) {
+      case SDL_FINGERDOWN:
+        return press(event);
+
+      case SDL_FINGERUP:
+        release(event);
+        return true;
+
+      case SDL_FINGERMOTION:
+        move(event);
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+  /// Updates the finger states using a touch finger event, see `touch_finger_event`.
+  auto update(const event_base<SDL_TouchFingerEvent>& event) noexcept -> bool
+  {
+    return update(event.get());
+  }
+
+  /// Resets the accumulated pinch and rotation deltas.
+  void new_frame() noexcept
+  {
+    mPinch = 1;
+    mRotation = 0;
+  }
+
+  /// Removes all tracked fingers.
+  void clear() noexcept
+  {
+    mCount = 0;
+    new_frame();
+  }
+
+  /// Returns the tracked finger with the specified ID, if there is one.
+  [[nodiscard]] auto find(const SDL_FingerID id) const noexcept -> const tracked_finger*
+  {
+    const auto index = index_of(id);
+    return (index != max_fingers) ? &mFingers[index] : nullptr;
+  }
+
+  /// Returns a pressed finger, in the range [0, count()).
+  [[nodiscard]] auto at(const usize index) const noexcept -> const tracked_finger&
+  {
+    assert(index < mCount);
+    return mFingers[index];
+  }
+
+  [[nodiscard]] auto begin() const noexcept { return mFingers.begin(); }
+
+  [[nodiscard]] auto end() const noexcept
+  {
+    return mFingers.begin() + static_cast<std::ptrdiff_t>(mCount);
+  }
+
+  /// Returns the centroid of all pressed fingers.
+  [[nodiscard]] auto centroid() const noexcept -> fpoint { return mCentroid; }
+
+  /**
+   * Returns the pinch scale factor accumulated since the last call to `new_frame()`.
+   *
+   * A value greater than one means that the fingers moved apart, requires two fingers.
+   */
+  [[nodiscard]] auto pinch() const noexcept -> float { return mPinch; }
+
+  /// Returns the rotation in radians accumulated since the last call to `new_frame()`.
+  [[nodiscard]] auto rotation() const noexcept -> float { return mRotation; }
+
+  /// Returns the amount of pressed fingers.
+  [[nodiscard]] auto count() const noexcept -> usize { return mCount; }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mCount == 0; }
+
+ private:
+  std::array<tracked_finger, max_fingers> mFingers {};
+  usize mCount {};
+  fpoint mCentroid;
+  float mSpread {};  ///< The mean distance between the fingers and the centroid.
+  float mPinch {1};
+  float mRotation {};
+
+  [[nodiscard]] auto index_of(const SDL_FingerID id) const noexcept -> usize
+  {
+    for (usize index = 0; index < mCount; ++index) {
+      if (mFingers[index].id == id) {
+        return index;
+      }
+    }
+
+    return max_fingers;
+  }
+
+  auto press(const SDL_TouchFingerEvent& event) noexcept -> bool
+  {
+    auto index = index_of(event.fingerId);
+    if (index == max_fingers) {
+      if (mCount == max_fingers) {
+        return false;
+      }
+
+      index = mCount++;
+    }
+
+    const fpoint position {event.x, event.y};
+
+    auto& finger = mFingers[index];
+    finger.id = event.fingerId;
+    finger.touch = event.touchId;
+    finger.position = position;
+    finger.start = position;
+    finger.velocity = {};
+    finger.pressure = event.pressure;
+    finger.down_time = u32ms {event.timestamp};
+    finger.last_time = finger.down_time;
+
+    refresh_shape();
+    return true;
+  }
+
+  void release(const SDL_TouchFingerEvent& event) noexcept
+  {
+    const auto index = index_of(event.fingerId);
+    if (index != max_fingers) {
+      /* Keep the pressed fingers contiguous by moving the last finger into the hole */
+      mFingers[index] = mFingers[mCount - 1];
+      --mCount;
+
+      refresh_shape();
+    }
+  }
+
+  void move(const SDL_TouchFingerEvent& event) noexcept
+  {
+    const auto index = index_of(event.fingerId);
+    if (index == max_fingers) {
+      return;
+    }
+
+    auto& finger = mFingers[index];
+    const auto previous = finger.position;
+    const fpoint position {event.x, event.y};
+
+    const auto elapsed = (u32ms {event.timestamp} - finger.last_time).count();
+    const auto seconds = static_cast<float>((elapsed != 0) ? elapsed : 1) / 1'000.0f;
+    const auto delta = position - previous;
+
+    /* Smooth the velocity to reduce the noise of individual events */
+    const auto& velocity = finger.velocity;
+    finger.velocity = {(velocity.x() + delta.x() / seconds) / 2.0f,
+                       (velocity.y() + delta.y() / seconds) / 2.0f};
+    finger.position = position;
+    finger.pressure = event.pressure;
+    finger.last_time = u32ms {event.timestamp};
+
+    if (mCount < 2) {
+      refresh_shape();
+      return;
+    }
+
+    /* The rotation contributed by this finger, around the centroid before the movement */
+    const auto before = angle(previous - mCentroid);
+    const auto after = angle(position - mCentroid);
+    mRotation += wrap(after - before) / static_cast<float>(mCount);
+
+    const auto spread = mSpread;
+    refresh_shape();
+
+    if (spread > 0) {
+      mPinch *= mSpread / spread;
+    }
+  }
+
+  /// Updates the centroid and spread of the pressed fingers.
+  void refresh_shape() noexcept
+  {
+    if (mCount == 0) {
+      mCentroid = {};
+      mSpread = 0;
+      return;
+    }
+
+    float x = 0;
+    float y = 0;
+    for (usize index = 0; index < mCount; ++index) {
+      x += mFingers[index].position.x();
+      y += mFingers[index].position.y();
+    }
+
+    const auto n = static_cast<float>(mCount);
+    mCentroid = {x / n, y / n};
+
+    float spread = 0;
+    for (usize index = 0; index < mCount; ++index) {
+      spread += distance(mCentroid, mFingers[index].position);
+    }
+
+    mSpread = spread / n;
+  }
+
+  [[nodiscard]] static auto angle(const fpoint vector) noexcept -> float
+  {
+    return std::atan2(vector.y(), vector.x());
+  }
+
+  /// Wraps an angle difference to the range [-pi, pi].
+  [[nodiscard]] static auto wrap(float radians) noexcept -> float
+  {
+    constexpr float pi = 3.14159265f;
+
+    if (radians > pi) {
+      radians -= 2 * pi;
+    }
+    else if (radians < -pi) {
+      radians += 2 * pi;
+    }
+
+    return radians;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_INPUT_TOUCH_TRACKER_HPP_
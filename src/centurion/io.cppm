@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+module;
+
+#include "centurion/io.hpp"
+
+export module centurion:io;
+
+export namespace cen {
+
+using cen::asset_compression;
+using cen::asset_entry;
+using cen::asset_pack;
+using cen::asset_pack_builder;
+
+using cen::asset_id;
+using cen::texture_id;
+using cen::surface_id;
+
+#ifndef CENTURION_NO_SDL_MIXER
+using cen::sound_id;
+#endif  // CENTURION_NO_SDL_MIXER
+
+using cen::basic_asset_registry;
+
+#ifndef CENTURION_NO_SDL_MIXER
+using cen::asset_registry;
+#endif  // CENTURION_NO_SDL_MIXER
+
+using cen::buffered_file_reader;
+using cen::buffered_file_writer;
+
+using cen::is_bulk_serializable_v;
+using cen::write_bulk;
+using cen::read_bulk;
+
+using cen::content_type;
+using cen::is_image;
+using cen::is_audio;
+using cen::to_string;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::operator<<;
+
+#endif  // CENTURION_NO_IOSTREAM
+
+using cen::file;
+
+using cen::file_mode;
+
+using cen::file_type;
+
+using cen::read_result;
+using cen::io_service;
+
+using cen::open_lz4;
+using cen::create_lz4;
+
+using cen::mapped_file;
+
+using cen::base_path;
+using cen::preferred_path;
+
+using cen::save_result;
+using cen::save_writer;
+
+using cen::seek_mode;
+
+}  // namespace cen
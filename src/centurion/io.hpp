@@ -22,8 +22,17 @@
  * SOFTWARE.
  */
 
+#include "io/asset_pack.hpp"
+#include "io/asset_registry.hpp"
+#include "io/buffered_file.hpp"
+#include "io/bulk_serialization.hpp"
+#include "io/content_type.hpp"
 #include "io/file.hpp"
 #include "io/file_mode.hpp"
 #include "io/file_type.hpp"
+#include "io/io_service.hpp"
+#include "io/lz4_file.hpp"
+#include "io/mapped_file.hpp"
 #include "io/paths.hpp"
+#include "io/save_writer.hpp"
 #include "io/seek_mode.hpp"
\ No newline at end of file
@@ -0,0 +1,560 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_IO_ASSET_PACK_HPP_
+#define CENTURION_IO_ASSET_PACK_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>    // sort, any_of
+#include <cassert>      // assert
+#include <cstring>      // memcmp
+#include <string>       // string
+#include <string_view>  // string_view
+#include <utility>      // move
+#include <vector>       // vector
+
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../system/endian.hpp"
+#include "file.hpp"
+#include "file_mode.hpp"
+#include "lz4_file.hpp"
+#include "mapped_file.hpp"
+
+namespace cen {
+
+/// Represents the different ways that asset pack entries can be stored.
+enum class asset_compression : uint8 {
+  none = 0,  ///< The entry is stored as-is.
+  lz4 = 1,   ///< The entry is stored as an LZ4 frame, see `open_lz4()`.
+};
+
+/// Describes an entry in an asset pack.
+struct asset_entry final {
+  std::string_view name;             ///< The name of the entry, which refers to the pack.
+  usize offset {};                   ///< The offset of the entry data in the pack, in bytes.
+  usize size {};                     ///< The size of the decompressed entry, in bytes.
+  usize stored_size {};              ///< The size of the entry data in the pack, in bytes.
+  asset_compression compression {};  ///< How the entry is stored.
+};
+
+namespace detail {
+
+/* All integers in a pack are stored in little-endian byte order. A pack consists of a header,
+   the entry blobs (each aligned to the pack alignment), an index sorted by name hash, and
+   finally the concatenated entry names.
+
+   Header (32 bytes): magic[4], version (u32), entry count (u32), alignment (u32),
+                      index offset (u64), names offset (u64).
+   Index entry (40 bytes): name hash (u64), offset (u64), size (u64), stored size (u64),
+                           name offset (u32), name size (u16), compression (u8), padding (u8).
+*/
+inline constexpr char asset_pack_magic[4] = {'C', 'P', 'A', 'K'};
+inline constexpr uint32 asset_pack_version = 1;
+inline constexpr usize asset_pack_header_size = 32;
+inline constexpr usize asset_pack_entry_size = 40;
+
+/* 64-bit FNV-1a */
+[[nodiscard]] constexpr auto asset_hash(const std::string_view name) noexcept -> uint64
+{
+  uint64 hash {0xCBF29CE484222325};
+
+  for (const auto ch : name) {
+    hash ^= static_cast<uint8>(ch);
+    hash *= 0x100000001B3;
+  }
+
+  return hash;
+}
+
+[[nodiscard]] constexpr auto align_offset(const usize offset, const usize alignment) noexcept
+    -> usize
+{
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
+}  // namespace detail
+
+/**
+ * A read-only archive of named assets, backed by a memory-mapped file.
+ *
+ * Packing many small files into a single pack avoids the cost of opening each file separately,
+ * which tends to dominate load times on some platforms. Packs are created with
+ * `asset_pack_builder`, or with the `asset-packer` tool among the examples.
+ *
+ * Entries are found through a binary search of the index, and are opened as read-only `file`
+ * views of the mapping that can be passed to any function that accepts a `file`.
+ * \code{cpp}
+ * const cen::asset_pack pack {"assets.pak"};
+ * auto entry = pack.open("sprites/player.png");
+ * const cen::texture texture = renderer.make_texture(entry);
+ * \endcode
+ *
+ * \details Like `file`, this class doesn't throw if the pack can't be opened or is malformed,
+ *          use `is_ok()`. The pack must outlive all entry views.
+ *
+ * \see asset_pack_builder
+ * \see mapped_file
+ */
+class asset_pack final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Opens an asset pack.
+   *
+   * \param path the path of the pack file.
+   */
+  explicit asset_pack(const char* path) noexcept : mFile {path}
+  {
+    mOk = mFile && validate();
+  }
+
+  explicit asset_pack(const std::string& path) noexcept : asset_pack {path.c_str()} {}
+
+  /**
+   * Looks up an entry in the pack.
+   *
+   * \param name the name of the entry.
+   *
+   * \return the entry; an empty optional if there is no such entry.
+   */
+  [[nodiscard]] auto find(const std::string_view name) const noexcept -> maybe<asset_entry>
+  {
+    if (!mOk) {
+      return nothing;
+    }
+
+    const auto hash = detail::asset_hash(name);
+
+    /* Find the first entry with a matching hash, and then compare names for collisions */
+    size_type first = 0;
+    size_type count = mCount;
+    while (count > 0) {
+      const auto step = count / 2;
+      if (hash_at(first + step) < hash) {
+        first += step + 1;
+        count -= step + 1;
+      }
+      else {
+        count = step;
+      }
+    }
+
+    for (auto index = first; index < mCount && hash_at(index) == hash; ++index) {
+      auto entry = at(index);
+      if (entry.name == name) {
+        return entry;
+      }
+    }
+
+    return nothing;
+  }
+
+  /// Indicates whether the pack contains an entry with the specified name.
+  [[nodiscard]] auto contains(const std::string_view name) const noexcept -> bool
+  {
+    return find(name).has_value();
+  }
+
+  /**
+   * Opens an entry as a read-only file, without copying any data.
+   *
+   * \details Compressed entries are decompressed transparently while they are read.
+   *
+   * \param name the name of the entry.
+   *
+   * \return a file view of the entry, which is invalid if there is no such entry, if the entry
+   *         uses an unknown compression, or if it is empty.
+   */
+  [[nodiscard]] auto open(const std::string_view name) const -> file
+  {
+    if (const auto entry = find(name)) {
+      return open(*entry);
+    }
+    else {
+      return file {nullptr};
+    }
+  }
+
+  /// Opens an entry as a read-only file, see `open(std::string_view)`.
+  [[nodiscard]] auto open(const asset_entry& entry) const -> file
+  {
+    if (entry.compression == asset_compression::none) {
+      return mFile.view(entry.offset, entry.stored_size);
+    }
+    else if (entry.compression == asset_compression::lz4) {
+      return open_lz4(mFile.view(entry.offset, entry.stored_size));
+    }
+    else {
+      return file {nullptr};
+    }
+  }
+
+  /// Returns a pointer to the stored data of an entry.
+  [[nodiscard]] auto data(const asset_entry& entry) const noexcept -> const uint8*
+  {
+    return mFile.data() + entry.offset;
+  }
+
+  /**
+   * Returns the entry at an index.
+   *
+   * \pre `index` must be less than `size()`.
+   *
+   * \param index the index of the entry, entries are ordered by the hashes of their names.
+   *
+   * \return the entry at the index.
+   */
+  [[nodiscard]] auto at(const size_type index) const noexcept -> asset_entry
+  {
+    assert(index < mCount);
+
+    const auto* data = entry_data(index);
+
+    const auto nameOffset = detail::read_little_endian<uint32>(data + 32);
+    const auto nameSize = detail::read_little_endian<uint16>(data + 36);
+    const auto* name = reinterpret_cast<const char*>(mFile.data() + mNamesOffset + nameOffset);
+
+    asset_entry entry;
+    entry.name = std::string_view {name, nameSize};
+    entry.offset = static_cast<usize>(detail::read_little_endian<uint64>(data + 8));
+    entry.size = static_cast<usize>(detail::read_little_endian<uint64>(data + 16));
+    entry.stored_size = static_cast<usize>(detail::read_little_endian<uint64>(data + 24));
+    entry.compression = static_cast<asset_compression>(data[38]);
+
+    return entry;
+  }
+
+  /// Returns the amount of entries in the pack.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mCount; }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mCount == 0; }
+
+  /// Returns the alignment of the entry data in the pack, in bytes.
+  [[nodiscard]] auto alignment() const noexcept -> size_type { return mAlignment; }
+
+  /// Returns the underlying file mapping.
+  [[nodiscard]] auto mapping() const noexcept -> const mapped_file& { return mFile; }
+
+  [[nodiscard]] auto is_ok() const noexcept -> bool { return mOk; }
+
+  /// Indicates whether the pack was successfully opened and validated.
+  explicit operator bool() const noexcept { return is_ok(); }
+
+ private:
+  mapped_file mFile;
+  usize mCount {};
+  usize mAlignment {};
+  usize mIndexOffset {};
+  usize mNamesOffset {};
+  bool mOk {};
+
+  [[nodiscard]] auto entry_data(const size_type index) const noexcept -> const uint8*
+  {
+    return mFile.data() + mIndexOffset + (index * detail::asset_pack_entry_size);
+  }
+
+  [[nodiscard]] auto hash_at(const size_type index) const noexcept -> uint64
+  {
+    return detail::read_little_endian<uint64>(entry_data(index));
+  }
+
+  /* Validates the header and all entries, so that lookups never have to check bounds */
+  [[nodiscard]] auto validate() noexcept -> bool
+  {
+    const auto fileSize = mFile.size();
+    const auto* data = mFile.data();
+
+    if (fileSize < detail::asset_pack_header_size ||
+        std::memcmp(data, detail::asset_pack_magic, sizeof detail::asset_pack_magic) != 0 ||
+        detail::read_little_endian<uint32>(data + 4) != detail::asset_pack_version) {
+      return false;
+    }
+
+    const auto count = detail::read_little_endian<uint32>(data + 8);
+    const auto alignment = detail::read_little_endian<uint32>(data + 12);
+    const auto indexOffset = detail::read_little_endian<uint64>(data + 16);
+    const auto namesOffset = detail::read_little_endian<uint64>(data + 24);
+
+    if (alignment == 0 || indexOffset > fileSize || namesOffset > fileSize ||
+        (fileSize - indexOffset) / detail::asset_pack_entry_size < count ||
+        indexOffset + (count * detail::asset_pack_entry_size) > namesOffset) {
+      return false;
+    }
+
+    mCount = count;
+    mAlignment = alignment;
+    mIndexOffset = static_cast<usize>(indexOffset);
+    mNamesOffset = static_cast<usize>(namesOffset);
+
+    const auto namesSize = fileSize - mNamesOffset;
+
+    uint64 previousHash {};
+    for (size_type index = 0; index < mCount; ++index) {
+      const auto* entry = entry_data(index);
+
+      const auto hash = detail::read_little_endian<uint64>(entry);
+      const auto offset = detail::read_little_endian<uint64>(entry + 8);
+      const auto storedSize = detail::read_little_endian<uint64>(entry + 24);
+      const auto nameOffset = detail::read_little_endian<uint32>(entry + 32);
+      const auto nameSize = detail::read_little_endian<uint16>(entry + 36);
+
+      if (hash < previousHash || offset > fileSize || storedSize > fileSize - offset ||
+          nameOffset > namesSize || nameSize > namesSize - nameOffset) {
+        return false;
+      }
+
+      previousHash = hash;
+    }
+
+    return true;
+  }
+};
+
+/**
+ * Creates asset packs that can be read with `asset_pack`.
+ *
+ * \see asset_pack
+ */
+class asset_pack_builder final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates an empty builder.
+   *
+   * \param alignment the alignment of each entry in the pack, in bytes.
+   */
+  explicit asset_pack_builder(const size_type alignment = 16) noexcept
+      : mAlignment {alignment != 0 ? alignment : 1}
+  {
+  }
+
+  /**
+   * Adds an entry with the specified contents.
+   *
+   * \details Compressed entries are stored as-is if compression doesn't make them smaller,
+   *          which is common for formats that are already compressed, such as PNG files.
+   *
+   * \param name the unique name of the entry, at most 65535 bytes long.
+   * \param data the contents of the entry.
+   * \param size the size of the contents, in bytes.
+   * \param compression the preferred way to store the entry.
+   *
+   * \return `success` if the entry was added; `failure` if the name is taken or too long.
+   */
+  auto add(std::string name,
+           const void* data,
+           const size_type size,
+           const asset_compression compression = asset_compression::none) -> result
+  {
+    assert(data || size == 0);
+
+    if (name.size() > 0xFFFF || contains(name)) {
+      return failure;
+    }
+
+    if (compression == asset_compression::lz4) {
+      auto frame = detail::lz4_compress_frame(data, size);
+      if (frame.size() < size) {
+        mEntries.push_back({std::move(name), std::move(frame), size, compression});
+        return success;
+      }
+    }
+
+    const auto* bytes = static_cast<const uint8*>(data);
+    mEntries.push_back({std::move(name),
+                        std::vector<uint8>(bytes, bytes + size),
+                        size,
+                        asset_compression::none});
+
+    return success;
+  }
+
+  /**
+   * Adds an entry with the contents of a file.
+   *
+   * \param name the unique name of the entry.
+   * \param path the path of the file that will be added.
+   * \param compression the preferred way to store the entry.
+   *
+   * \return `success` if the entry was added; `failure` otherwise.
+   */
+  auto add_file(std::string name,
+                const char* path,
+                const asset_compression compression = asset_compression::none) -> result
+  {
+    assert(path);
+
+    usize size {};
+    if (auto* data = SDL_LoadFile(path, &size)) {
+      const auto res = add(std::move(name), data, size, compression);
+      SDL_free(data);
+      return res;
+    }
+    else {
+      return failure;
+    }
+  }
+
+  /// Indicates whether an entry with the specified name has been added.
+  [[nodiscard]] auto contains(const std::string_view name) const noexcept -> bool
+  {
+    return std::any_of(mEntries.begin(), mEntries.end(), [name](const pending_entry& entry) {
+      return entry.name == name;
+    });
+  }
+
+  /**
+   * Writes the pack to a file.
+   *
+   * \param path the path of the created pack file.
+   *
+   * \return `success` if the pack was written; `failure` otherwise.
+   */
+  auto write(const char* path) const -> result
+  {
+    std::vector<const pending_entry*> sorted;
+    sorted.reserve(mEntries.size());
+
+    for (const auto& entry : mEntries) {
+      sorted.push_back(&entry);
+    }
+
+    std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) {
+      return a->hash < b->hash;
+    });
+
+    /* Compute the layout before writing anything, so that the file is written sequentially */
+    std::vector<usize> offsets;
+    offsets.reserve(sorted.size());
+
+    usize offset = detail::asset_pack_header_size;
+    for (const auto* entry : sorted) {
+      offset = detail::align_offset(offset, mAlignment);
+      offsets.push_back(offset);
+      offset += entry->data.size();
+    }
+
+    const auto indexOffset = detail::align_offset(offset, 8);
+    const auto namesOffset = indexOffset + (sorted.size() * detail::asset_pack_entry_size);
+
+    file pack {path, file_mode::wb};
+    if (!pack) {
+      return failure;
+    }
+
+    bool ok = pack.write(detail::asset_pack_magic) == sizeof detail::asset_pack_magic;
+    ok = ok && pack.write_native_as_little_endian(detail::asset_pack_version);
+    ok = ok && pack.write_native_as_little_endian(static_cast<uint32>(sorted.size()));
+    ok = ok && pack.write_native_as_little_endian(static_cast<uint32>(mAlignment));
+    ok = ok && pack.write_native_as_little_endian(static_cast<uint64>(indexOffset));
+    ok = ok && pack.write_native_as_little_endian(static_cast<uint64>(namesOffset));
+
+    usize position = detail::asset_pack_header_size;
+    for (usize index = 0; ok && index < sorted.size(); ++index) {
+      const auto& data = sorted[index]->data;
+
+      ok = write_padding(pack, offsets[index] - position);
+      ok = ok && pack.write(data.data(), data.size()) == data.size();
+
+      position = offsets[index] + data.size();
+    }
+
+    ok = ok && write_padding(pack, indexOffset - position);
+
+    uint32 nameOffset {};
+    for (usize index = 0; ok && index < sorted.size(); ++index) {
+      const auto* entry = sorted[index];
+      const auto storedSize = static_cast<uint64>(entry->data.size());
+
+      ok = ok && pack.write_native_as_little_endian(entry->hash);
+      ok = ok && pack.write_native_as_little_endian(static_cast<uint64>(offsets[index]));
+      ok = ok && pack.write_native_as_little_endian(static_cast<uint64>(entry->size));
+      ok = ok && pack.write_native_as_little_endian(storedSize);
+      ok = ok && pack.write_native_as_little_endian(nameOffset);
+      ok = ok && pack.write_native_as_little_endian(static_cast<uint16>(entry->name.size()));
+      ok = ok && pack.write_byte(static_cast<uint8>(entry->compression));
+      ok = ok && pack.write_byte(0);
+
+      nameOffset += static_cast<uint32>(entry->name.size());
+    }
+
+    for (usize index = 0; ok && index < sorted.size(); ++index) {
+      const auto& name = sorted[index]->name;
+      ok = pack.write(name.data(), name.size()) == name.size();
+    }
+
+    return ok && pack.close();
+  }
+
+  /// Writes the pack to a file, see `write(const char*)`.
+  auto write(const std::string& path) const -> result { return write(path.c_str()); }
+
+  /// Returns the amount of added entries.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mEntries.size(); }
+
+  [[nodiscard]] auto alignment() const noexcept -> size_type { return mAlignment; }
+
+ private:
+  struct pending_entry final {
+    pending_entry(std::string name,
+                  std::vector<uint8> data,
+                  const usize size,
+                  const asset_compression compression)
+        : name {std::move(name)}
+        , data {std::move(data)}
+        , hash {detail::asset_hash(this->name)}
+        , size {size}
+        , compression {compression}
+    {
+    }
+
+    std::string name;
+    std::vector<uint8> data;  ///< The stored data, which may be compressed.
+    uint64 hash {};
+    usize size {};  ///< The size of the uncompressed data.
+    asset_compression compression {};
+  };
+
+  std::vector<pending_entry> mEntries;
+  size_type mAlignment {};
+
+  [[nodiscard]] static auto write_padding(file& pack, usize count) noexcept -> bool
+  {
+    for (; count > 0; --count) {
+      if (!pack.write_byte(0)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_IO_ASSET_PACK_HPP_
@@ -0,0 +1,219 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_IO_ASSET_REGISTRY_HPP_
+#define CENTURION_IO_ASSET_REGISTRY_HPP_
+
+#include <tuple>        // tuple, get
+#include <type_traits>  // is_same_v
+#include <utility>      // move
+
+#include "../common/primitives.hpp"
+#include "../common/slot_map.hpp"
+#include "../video/surface.hpp"
+#include "../video/texture.hpp"
+
+#ifndef CENTURION_NO_SDL_MIXER
+#include "../audio/sound_effect.hpp"
+#endif  // CENTURION_NO_SDL_MIXER
+
+namespace cen {
+
+/// Identifies an asset stored in an asset registry.
+template <typename T>
+using asset_id = slot_id<T>;
+
+using texture_id = asset_id<texture>;
+using surface_id = asset_id<surface>;
+
+#ifndef CENTURION_NO_SDL_MIXER
+using sound_id = asset_id<sound_effect>;
+#endif  // CENTURION_NO_SDL_MIXER
+
+/**
+ * Owns assets of several types, and identifies them with 32-bit generational ids.
+ *
+ * Each asset type is stored contiguously in its own slot map, so game objects can refer to
+ * assets with four-byte identifiers rather than with pointers or handles. Identifiers of
+ * erased assets are detected, rather than dangling, and reloading an asset only replaces the
+ * value in its slot, so all existing identifiers refer to the reloaded asset.
+ *
+ * \code{cpp}
+ * cen::asset_registry assets;
+ *
+ * const auto hero = assets.add(renderer.make_texture("hero.png"));
+ *
+ * // Later, e.g. when the file has changed on disk
+ * assets.replace(hero, renderer.make_texture("hero.png"));
+ *
+ * if (auto* texture = assets.find(hero)) {
+ *   renderer.render(*texture, position);
+ * }
+ * \endcode
+ *
+ * \tparam Assets the types of the stored assets, which must be unique.
+ *
+ * \see asset_registry
+ * \see slot_map
+ */
+template <typename... Assets>
+class basic_asset_registry final {
+ public:
+  using size_type = usize;
+
+  template <typename T>
+  using pool_type = slot_map<T>;
+
+  /**
+   * Stores an asset.
+   *
+   * \param asset the asset that will be owned by the registry.
+   *
+   * \return the identifier of the asset.
+   *
+   * \throws exception if there are too many assets of the same type.
+   */
+  template <typename T>
+  auto add(T asset) -> asset_id<T>
+  {
+    return pool<T>().insert(std::move(asset));
+  }
+
+  /**
+   * Replaces an asset, in a way that keeps its identifiers valid.
+   *
+   * \param id the identifier of the asset that will be replaced.
+   * \param asset the new asset, the previous asset is destroyed.
+   *
+   * \return `true` if the asset was replaced; `false` if the identifier is invalid.
+   */
+  template <typename T>
+  auto replace(const asset_id<T> id, T asset) -> bool
+  {
+    return pool<T>().replace(id, std::move(asset));
+  }
+
+  /**
+   * Destroys an asset, and invalidates all of its identifiers.
+   *
+   * \param id the identifier of the asset.
+   *
+   * \return `true` if the asset was destroyed; `false` if the identifier is invalid.
+   */
+  template <typename T>
+  auto erase(const asset_id<T> id) -> bool
+  {
+    return pool<T>().erase(id);
+  }
+
+  /// Destroys all assets, and invalidates all identifiers.
+  void clear() noexcept { (pool<Assets>().clear(), ...); }
+
+  /// Returns a pointer to an asset; a null pointer if the identifier is invalid.
+  template <typename T>
+  [[nodiscard]] auto find(const asset_id<T> id) noexcept -> T*
+  {
+    return pool<T>().find(id);
+  }
+
+  /// Returns a pointer to an asset; a null pointer if the identifier is invalid.
+  template <typename T>
+  [[nodiscard]] auto find(const asset_id<T> id) const noexcept -> const T*
+  {
+    return pool<T>().find(id);
+  }
+
+  /**
+   * Returns an asset.
+   *
+   * \param id the identifier of the asset.
+   *
+   * \return the identified asset.
+   *
+   * \throws exception if the identifier is invalid.
+   */
+  template <typename T>
+  [[nodiscard]] auto at(const asset_id<T> id) -> T&
+  {
+    return pool<T>().at(id);
+  }
+
+  /// See `at(asset_id<T>)`.
+  template <typename T>
+  [[nodiscard]] auto at(const asset_id<T> id) const -> const T&
+  {
+    return pool<T>().at(id);
+  }
+
+  template <typename T>
+  [[nodiscard]] auto contains(const asset_id<T> id) const noexcept -> bool
+  {
+    return pool<T>().contains(id);
+  }
+
+  /// Returns the storage of all assets of a type, e.g. to iterate over them.
+  template <typename T>
+  [[nodiscard]] auto pool() noexcept -> pool_type<T>&
+  {
+    static_assert((std::is_same_v<T, Assets> || ...), "Asset type is not stored!");
+    return std::get<pool_type<T>>(mPools);
+  }
+
+  /// See `pool()`.
+  template <typename T>
+  [[nodiscard]] auto pool() const noexcept -> const pool_type<T>&
+  {
+    static_assert((std::is_same_v<T, Assets> || ...), "Asset type is not stored!");
+    return std::get<pool_type<T>>(mPools);
+  }
+
+  /// Returns the amount of stored assets of a type.
+  template <typename T>
+  [[nodiscard]] auto count() const noexcept -> size_type
+  {
+    return pool<T>().size();
+  }
+
+  /// Returns the total amount of stored assets.
+  [[nodiscard]] auto size() const noexcept -> size_type
+  {
+    return (size_type {0} + ... + pool<Assets>().size());
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+ private:
+  std::tuple<pool_type<Assets>...> mPools;
+};
+
+#ifndef CENTURION_NO_SDL_MIXER
+using asset_registry = basic_asset_registry<texture, surface, sound_effect>;
+#else
+using asset_registry = basic_asset_registry<texture, surface>;
+#endif  // CENTURION_NO_SDL_MIXER
+
+}  // namespace cen
+
+#endif  // CENTURION_IO_ASSET_REGISTRY_HPP_
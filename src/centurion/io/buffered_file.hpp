@@ -0,0 +1,448 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_IO_BUFFERED_FILE_HPP_
+#define CENTURION_IO_BUFFERED_FILE_HPP_
+
+#include <SDL.h>
+
+#include <cassert>      // assert
+#include <cstring>      // memcpy, memmove
+#include <type_traits>  // is_trivially_copyable_v
+#include <vector>       // vector
+
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/endian.hpp"
+#include "file.hpp"
+#include "seek_mode.hpp"
+
+namespace cen {
+
+/**
+ * Reads from a file through an internal buffer.
+ *
+ * Reading individual values through `file` goes through the `SDL_RWops` callbacks for every
+ * value, which is slow when parsing binary formats. This class instead refills its buffer in
+ * large blocks, and performs small reads directly from the buffer.
+ *
+ * The reader doesn't own the file, which must outlive the reader. Don't use the file directly
+ * while it is being read through a reader, since the file offset is ahead of the reader.
+ *
+ * \see buffered_file_writer
+ */
+class buffered_file_reader final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a buffered reader.
+   *
+   * \param source the file that will be read from.
+   * \param bufferSize the size of the internal buffer, in bytes.
+   */
+  explicit buffered_file_reader(file& source, const size_type bufferSize = 64 * 1'024)
+      : mFile {&source}
+      , mBuffer((detail::max)(bufferSize, size_type {16}))
+  {
+    assert(source);
+  }
+
+  CENTURION_DISABLE_COPY(buffered_file_reader)
+
+  /**
+   * Reads a sequence of objects.
+   *
+   * Large reads bypass the buffer and are read directly into the destination.
+   *
+   * \param data the array that the objects are read into.
+   * \param maxCount the maximum amount of objects to read.
+   *
+   * \return the amount of complete objects that were read.
+   */
+  template <typename T>
+  auto read_to(T* data, const size_type maxCount) noexcept -> size_type
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    assert(data || maxCount == 0);
+    return read_bytes(data, maxCount * sizeof(T)) / sizeof(T);
+  }
+
+  template <typename T, size_type Size>
+  auto read_to(bounded_array_ref<T, Size> data) noexcept -> size_type
+  {
+    return read_to(data, Size);
+  }
+
+  template <typename Container>
+  auto read_to(Container& container) noexcept -> size_type
+  {
+    return read_to(container.data(), container.size());
+  }
+
+  /// Reads an array of little-endian values, and converts them to native byte order.
+  template <typename T>
+  auto read_little_endian_array(T* data, const size_type maxCount) noexcept -> size_type
+  {
+    const auto count = read_to(data, maxCount);
+    swap_little_endian(data, count);
+    return count;
+  }
+
+  /// Reads an array of big-endian values, and converts them to native byte order.
+  template <typename T>
+  auto read_big_endian_array(T* data, const size_type maxCount) noexcept -> size_type
+  {
+    const auto count = read_to(data, maxCount);
+    swap_big_endian(data, count);
+    return count;
+  }
+
+  /// Reads a single object, which is value-initialized if it couldn't be read.
+  template <typename T>
+  auto read() noexcept -> T
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+
+    T value {};
+    if (available() >= sizeof(T)) {
+      std::memcpy(&value, mBuffer.data() + mPos, sizeof(T));
+      mPos += sizeof(T);
+    }
+    else {
+      read_bytes(&value, sizeof(T));
+    }
+
+    return value;
+  }
+
+  auto read_byte() noexcept -> uint8 { return read<uint8>(); }
+
+  auto read_little_endian_u16() noexcept -> uint16
+  {
+    return swap_little_endian(read<uint16>());
+  }
+
+  auto read_little_endian_u32() noexcept -> uint32
+  {
+    return swap_little_endian(read<uint32>());
+  }
+
+  auto read_little_endian_u64() noexcept -> uint64
+  {
+    return swap_little_endian(read<uint64>());
+  }
+
+  auto read_big_endian_u16() noexcept -> uint16 { return swap_big_endian(read<uint16>()); }
+
+  auto read_big_endian_u32() noexcept -> uint32 { return swap_big_endian(read<uint32>()); }
+
+  auto read_big_endian_u64() noexcept -> uint64 { return swap_big_endian(read<uint64>()); }
+
+  /**
+   * Skips a number of bytes.
+   *
+   * \param count the amount of bytes to skip.
+   *
+   * \return `success` if the bytes were skipped; `failure` otherwise.
+   */
+  auto skip(const size_type count) noexcept -> result
+  {
+    if (count <= available()) {
+      mPos += count;
+      return success;
+    }
+    else {
+      return seek(static_cast<int64>(count), seek_mode::relative_to_current).has_value();
+    }
+  }
+
+  /**
+   * Changes the read offset, which discards the buffered data.
+   *
+   * \param offset the offset, relative to the position specified by `mode`.
+   * \param mode the position to seek relative to.
+   *
+   * \return the new read offset; an empty optional on failure.
+   */
+  auto seek(int64 offset, const seek_mode mode) noexcept -> maybe<int64>
+  {
+    if (mode == seek_mode::relative_to_current) {
+      offset -= static_cast<int64>(available());
+    }
+
+    mPos = 0;
+    mEnd = 0;
+    mEof = false;
+
+    return mFile->seek(offset, mode);
+  }
+
+  /// Returns the read offset in the file, accounting for buffered data.
+  [[nodiscard]] auto offset() const noexcept -> int64
+  {
+    return mFile->offset() - static_cast<int64>(available());
+  }
+
+  /// Indicates whether a read has reached the end of the file.
+  [[nodiscard]] auto eof() const noexcept -> bool { return mEof && available() == 0; }
+
+  /// Returns the amount of buffered bytes that haven't been read yet.
+  [[nodiscard]] auto available() const noexcept -> size_type { return mEnd - mPos; }
+
+  /// Returns the size of the internal buffer, in bytes.
+  [[nodiscard]] auto buffer_size() const noexcept -> size_type { return mBuffer.size(); }
+
+ private:
+  file* mFile {};
+  std::vector<uint8> mBuffer;
+  size_type mPos {};
+  size_type mEnd {};
+  bool mEof {};
+
+  auto read_bytes(void* destination, const size_type size) noexcept -> size_type
+  {
+    auto* out = static_cast<uint8*>(destination);
+    size_type total {};
+
+    while (total < size) {
+      if (available() == 0) {
+        /* Large reads skip the buffer entirely, avoiding an extra copy */
+        if (size - total >= mBuffer.size()) {
+          const auto count = mFile->read_to(out + total, size - total);
+          total += count;
+
+          if (count == 0) {
+            mEof = true;
+            break;
+          }
+
+          continue;
+        }
+
+        if (!refill()) {
+          break;
+        }
+      }
+
+      const auto count = (detail::min)(available(), size - total);
+      std::memcpy(out + total, mBuffer.data() + mPos, count);
+
+      mPos += count;
+      total += count;
+    }
+
+    return total;
+  }
+
+  auto refill() noexcept -> bool
+  {
+    mPos = 0;
+    mEnd = mFile->read_to(mBuffer.data(), mBuffer.size());
+
+    if (mEnd == 0) {
+      mEof = true;
+    }
+
+    return mEnd != 0;
+  }
+};
+
+/**
+ * Writes to a file through an internal buffer.
+ *
+ * Small writes are collected in the buffer, which is written to the file in a single call
+ * once it is full, when `flush()` is called, or when the writer is destroyed. Write errors are
+ * therefore only reported by `flush()`.
+ *
+ * The writer doesn't own the file, which must outlive the writer.
+ *
+ * \see buffered_file_reader
+ */
+class buffered_file_writer final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a buffered writer.
+   *
+   * \param target the file that will be written to.
+   * \param bufferSize the size of the internal buffer, in bytes.
+   */
+  explicit buffered_file_writer(file& target, const size_type bufferSize = 64 * 1'024)
+      : mFile {&target}
+      , mBuffer((detail::max)(bufferSize, size_type {16}))
+  {
+    assert(target);
+  }
+
+  CENTURION_DISABLE_COPY(buffered_file_writer)
+
+  /// Flushes any buffered data.
+  ~buffered_file_writer() noexcept { flush(); }
+
+  /**
+   * Writes a sequence of objects.
+   *
+   * Large writes bypass the buffer and are written directly to the file.
+   *
+   * \param data the objects that will be written.
+   * \param count the amount of objects to write.
+   *
+   * \return the amount of objects that were written or buffered.
+   */
+  template <typename T>
+  auto write(const T* data, const size_type count) noexcept -> size_type
+  {
+    static_assert(std::is_trivially_copyable_v<T>);
+    assert(data || count == 0);
+    return write_bytes(data, count * sizeof(T)) / sizeof(T);
+  }
+
+  template <typename T, size_type Size>
+  auto write(const T (&data)[Size]) noexcept -> size_type
+  {
+    return write(data, Size);
+  }
+
+  template <typename Container>
+  auto write(const Container& container) noexcept -> size_type
+  {
+    return write(container.data(), container.size());
+  }
+
+  auto write_byte(const uint8 value) noexcept -> result { return put(value); }
+
+  auto write_native_as_little_endian(const uint16 value) noexcept -> result
+  {
+    return put(swap_little_endian(value));
+  }
+
+  auto write_native_as_little_endian(const uint32 value) noexcept -> result
+  {
+    return put(swap_little_endian(value));
+  }
+
+  auto write_native_as_little_endian(const uint64 value) noexcept -> result
+  {
+    return put(swap_little_endian(value));
+  }
+
+  auto write_native_as_big_endian(const uint16 value) noexcept -> result
+  {
+    return put(swap_big_endian(value));
+  }
+
+  auto write_native_as_big_endian(const uint32 value) noexcept -> result
+  {
+    return put(swap_big_endian(value));
+  }
+
+  auto write_native_as_big_endian(const uint64 value) noexcept -> result
+  {
+    return put(swap_big_endian(value));
+  }
+
+  /**
+   * Writes all buffered data to the file.
+   *
+   * \return `success` if all data was written; `failure` otherwise.
+   */
+  auto flush() noexcept -> result
+  {
+    if (mSize == 0) {
+      return success;
+    }
+
+    const auto written = mFile->write(mBuffer.data(), mSize);
+    const auto ok = written == mSize;
+
+    /* Keep whatever couldn't be written, so that it can be retried */
+    std::memmove(mBuffer.data(), mBuffer.data() + written, mSize - written);
+    mSize -= written;
+
+    return ok;
+  }
+
+  /// Returns the write offset in the file, accounting for buffered data.
+  [[nodiscard]] auto offset() const noexcept -> int64
+  {
+    return mFile->offset() + static_cast<int64>(mSize);
+  }
+
+  /// Returns the amount of buffered bytes that haven't been written yet.
+  [[nodiscard]] auto buffered() const noexcept -> size_type { return mSize; }
+
+  /// Returns the size of the internal buffer, in bytes.
+  [[nodiscard]] auto buffer_size() const noexcept -> size_type { return mBuffer.size(); }
+
+ private:
+  file* mFile {};
+  std::vector<uint8> mBuffer;
+  size_type mSize {};
+
+  template <typename T>
+  auto put(const T value) noexcept -> result
+  {
+    if (mBuffer.size() - mSize >= sizeof(T) || flush()) {
+      std::memcpy(mBuffer.data() + mSize, &value, sizeof(T));
+      mSize += sizeof(T);
+      return success;
+    }
+    else {
+      return failure;
+    }
+  }
+
+  auto write_bytes(const void* source, const size_type size) noexcept -> size_type
+  {
+    const auto* in = static_cast<const uint8*>(source);
+
+    if (size <= mBuffer.size() - mSize) {
+      std::memcpy(mBuffer.data() + mSize, in, size);
+      mSize += size;
+      return size;
+    }
+
+    if (!flush()) {
+      return 0;
+    }
+
+    /* Large writes skip the buffer entirely, avoiding an extra copy */
+    if (size >= mBuffer.size()) {
+      return mFile->write(in, size);
+    }
+
+    std::memcpy(mBuffer.data(), in, size);
+    mSize = size;
+
+    return size;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_IO_BUFFERED_FILE_HPP_
@@ -0,0 +1,312 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_IO_BULK_SERIALIZATION_HPP_
+#define CENTURION_IO_BULK_SERIALIZATION_HPP_
+
+#include <cassert>      // assert
+#include <cstring>      // memcpy
+#include <type_traits>  // enable_if_t, void_t, is_trivially_copyable_v, is_signed_v, ...
+#include <vector>       // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/traits.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/endian.hpp"
+#include "../video/color.hpp"
+
+namespace cen {
+namespace detail {
+
+/* Bulk arrays are stored as a header, followed by the elements as tightly packed little-endian
+   scalars, e.g. x and y for points, and red, green, blue and alpha for colors.
+
+   The element tag identifies the element type: shape (u8), scalar kind (u8, 0 is unsigned,
+   1 is signed and 2 is floating-point), scalar size (u8) and component count (u8).
+
+   Header (16 bytes): magic[4], version (u32), element tag (u32), element count (u32).
+*/
+inline constexpr char bulk_magic[4] = {'C', 'B', 'L', 'K'};
+inline constexpr uint32 bulk_version = 1;
+inline constexpr usize bulk_header_size = 16;
+
+/* The amount of scalars that are byte swapped at a time when writing on big-endian targets */
+inline constexpr usize bulk_swap_chunk = 512;
+
+/* The amount of elements that are read at a time into vectors, so that corrupt element
+   counts don't lead to huge allocations */
+inline constexpr usize bulk_read_chunk = 4'096;
+
+enum class bulk_shape : uint8 {
+  scalar = 0,
+  point = 1,
+  area = 2,
+  rect = 3,
+  color = 4
+};
+
+template <typename Scalar, usize Components, bulk_shape Shape>
+struct bulk_layout {
+  using scalar_type = Scalar;
+
+  inline constexpr static usize components = Components;
+  inline constexpr static bulk_shape shape = Shape;
+};
+
+template <typename T, typename = void>
+struct bulk_traits;
+
+template <typename T>
+struct bulk_traits<T, std::enable_if_t<is_number<T>>> : bulk_layout<T, 1, bulk_shape::scalar> {
+};
+
+template <typename T>
+struct bulk_traits<basic_point<T>> : bulk_layout<T, 2, bulk_shape::point> {};
+
+template <typename T>
+struct bulk_traits<basic_area<T>> : bulk_layout<T, 2, bulk_shape::area> {};
+
+template <typename T>
+struct bulk_traits<basic_rect<T>> : bulk_layout<T, 4, bulk_shape::rect> {};
+
+template <>
+struct bulk_traits<color> : bulk_layout<uint8, 4, bulk_shape::color> {};
+
+template <typename T, typename = void>
+inline constexpr bool has_bulk_traits = false;
+
+template <typename T>
+inline constexpr bool has_bulk_traits<T, std::void_t<typename bulk_traits<T>::scalar_type>> =
+    true;
+
+template <typename T>
+[[nodiscard]] constexpr auto bulk_tag() noexcept -> uint32
+{
+  using traits = bulk_traits<T>;
+  using scalar = typename traits::scalar_type;
+
+  constexpr uint32 kind = std::is_floating_point_v<scalar> ? 2u
+                          : std::is_signed_v<scalar>       ? 1u
+                                                           : 0u;
+
+  return (static_cast<uint32>(traits::shape) << 24u) | (kind << 16u) |
+         (static_cast<uint32>(sizeof(scalar)) << 8u) | static_cast<uint32>(traits::components);
+}
+
+/* Converts scalars between native and little-endian byte order, in-place */
+template <typename T>
+void swap_bulk_elements(T* data, const usize count) noexcept
+{
+  using scalar = typename bulk_traits<T>::scalar_type;
+
+  if constexpr (sizeof(scalar) != 1) {
+    swap_little_endian(reinterpret_cast<scalar*>(data), count * bulk_traits<T>::components);
+  }
+  else {
+    static_cast<void>(data);
+    static_cast<void>(count);
+  }
+}
+
+/* Reads and validates a header, and returns the element count */
+template <typename Input>
+[[nodiscard]] auto read_bulk_header(Input& input, const uint32 tag) noexcept -> maybe<usize>
+{
+  uint8 header[bulk_header_size] {};
+  if (input.read_to(header, bulk_header_size) != bulk_header_size ||
+      std::memcmp(header, bulk_magic, sizeof bulk_magic) != 0 ||
+      read_little_endian<uint32>(header + 4) != bulk_version ||
+      read_little_endian<uint32>(header + 8) != tag) {
+    return nothing;
+  }
+
+  return static_cast<usize>(read_little_endian<uint32>(header + 12));
+}
+
+}  // namespace detail
+
+/// Indicates whether an array of a type can be serialized with `write_bulk()`.
+template <typename T>
+inline constexpr bool is_bulk_serializable_v =
+    detail::has_bulk_traits<T> && std::is_trivially_copyable_v<T>;
+
+/**
+ * Writes an array of values as a single binary block, preceded by a versioned header.
+ *
+ * This is a fast alternative to serializing large arrays of geometry or colors one member at
+ * a time. The values are written in little-endian byte order, and on little-endian targets
+ * the array is written directly without any conversion. On big-endian targets, the values are
+ * converted in small chunks on the stack with `swap_byte_order()`.
+ *
+ * \tparam Output either `file` or `buffered_file_writer`.
+ * \tparam T a bulk serializable type, i.e. a number, point, area, rectangle or color.
+ *
+ * \param output the file that will be written to.
+ * \param data the values that will be written, can be null if the count is zero.
+ * \param count the amount of values, at most the maximum value of a `uint32`.
+ *
+ * \return `success` if all values were written; `failure` otherwise.
+ *
+ * \see read_bulk()
+ */
+template <typename Output, typename T>
+auto write_bulk(Output& output, const T* data, const usize count) noexcept -> result
+{
+  static_assert(is_bulk_serializable_v<T>);
+  static_assert(sizeof(T) == sizeof(typename detail::bulk_traits<T>::scalar_type) *
+                                 detail::bulk_traits<T>::components,
+                "Bulk serializable types must not be padded");
+  assert(data || count == 0);
+
+  if (count > static_cast<usize>(static_cast<uint32>(-1))) {
+    return failure;
+  }
+
+  uint8 header[detail::bulk_header_size] {};
+  std::memcpy(header, detail::bulk_magic, sizeof detail::bulk_magic);
+  detail::write_little_endian(header + 4, detail::bulk_version);
+  detail::write_little_endian(header + 8, detail::bulk_tag<T>());
+  detail::write_little_endian(header + 12, static_cast<uint32>(count));
+
+  if (output.write(header) != detail::bulk_header_size) {
+    return failure;
+  }
+  else if (count == 0) {
+    return success;
+  }
+
+  using scalar = typename detail::bulk_traits<T>::scalar_type;
+  if constexpr (is_little_endian() || sizeof(scalar) == 1) {
+    return output.write(data, count) == count;
+  }
+  else {
+    scalar buffer[detail::bulk_swap_chunk];
+
+    const auto* source = reinterpret_cast<const uint8*>(data);
+    auto remaining = count * detail::bulk_traits<T>::components;
+
+    while (remaining != 0) {
+      const auto n = (detail::min)(remaining, detail::bulk_swap_chunk);
+      std::memcpy(buffer, source, n * sizeof(scalar));
+      swap_byte_order(buffer, n);
+
+      if (output.write(buffer, n) != n) {
+        return failure;
+      }
+
+      source += n * sizeof(scalar);
+      remaining -= n;
+    }
+
+    return success;
+  }
+}
+
+/// Writes the values of a contiguous container, see `write_bulk(Output&, const T*, usize)`.
+template <typename Output, typename Container>
+auto write_bulk(Output& output, const Container& container) noexcept -> result
+{
+  return write_bulk(output, container.data(), container.size());
+}
+
+/**
+ * Reads an array of values that was written with `write_bulk()` into a buffer.
+ *
+ * \tparam Input either `file` or `buffered_file_reader`.
+ * \tparam T the type of the written values.
+ *
+ * \param input the file that will be read from.
+ * \param data the buffer that the values are read into.
+ * \param capacity the maximum amount of values that can be stored in the buffer.
+ *
+ * \return the amount of read values; an empty optional if the header is invalid, if the values
+ * were written as another type, if the buffer is too small, or if the array is truncated.
+ */
+template <typename Input, typename T>
+auto read_bulk(Input& input, T* data, const usize capacity) noexcept -> maybe<usize>
+{
+  static_assert(is_bulk_serializable_v<T>);
+  assert(data || capacity == 0);
+
+  const auto count = detail::read_bulk_header(input, detail::bulk_tag<T>());
+  if (!count || *count > capacity) {
+    return nothing;
+  }
+  else if (*count != 0 && input.read_to(data, *count) != *count) {
+    return nothing;
+  }
+
+  detail::swap_bulk_elements(data, *count);
+  return count;
+}
+
+/**
+ * Reads an array of values that was written with `write_bulk()` into a vector.
+ *
+ * The values are appended to the vector, which is restored to its original size if the array
+ * cannot be read.
+ *
+ * \param input the file that will be read from.
+ * \param values the vector that the values are appended to.
+ * \param maxCount the maximum amount of values that will be accepted.
+ *
+ * \return `success` if the array was read; `failure` otherwise.
+ */
+template <typename Input, typename T>
+auto read_bulk(Input& input,
+               std::vector<T>& values,
+               const usize maxCount = static_cast<uint32>(-1)) -> result
+{
+  static_assert(is_bulk_serializable_v<T>);
+
+  const auto count = detail::read_bulk_header(input, detail::bulk_tag<T>());
+  if (!count || *count > maxCount) {
+    return failure;
+  }
+
+  const auto offset = values.size();
+  auto remaining = *count;
+
+  while (remaining != 0) {
+    const auto n = (detail::min)(remaining, detail::bulk_read_chunk);
+    const auto start = values.size();
+
+    values.resize(start + n);
+    if (input.read_to(values.data() + start, n) != n) {
+      values.resize(offset);
+      return failure;
+    }
+
+    remaining -= n;
+  }
+
+  detail::swap_bulk_elements(values.data() + offset, *count);
+  return success;
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_IO_BULK_SERIALIZATION_HPP_
@@ -0,0 +1,452 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_IO_CONTENT_TYPE_HPP_
+#define CENTURION_IO_CONTENT_TYPE_HPP_
+
+#include <string_view>  // string_view
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// The image and audio formats that can be recognized from the first bytes of a file.
+enum class content_type {
+  unknown,
+
+  /* Images */
+  png,
+  jpg,
+  gif,
+  bmp,
+  webp,
+  tif,
+  ico,
+  cur,
+  pnm,
+  pcx,
+  lbm,
+  xcf,
+  xpm,
+  xv,
+  svg,
+  avif,
+  jxl,
+  qoi,
+
+  /* Audio */
+  wav,
+  aiff,
+  voc,
+  ogg,
+  opus,
+  flac,
+  mp3,
+  midi,
+  mod
+};
+
+/// Indicates whether a content type is an image format.
+[[nodiscard]] constexpr auto is_image(const content_type type) noexcept -> bool
+{
+  return type >= content_type::png && type <= content_type::qoi;
+}
+
+/// Indicates whether a content type is an audio format.
+[[nodiscard]] constexpr auto is_audio(const content_type type) noexcept -> bool
+{
+  return type >= content_type::wav && type <= content_type::mod;
+}
+
+[[nodiscard]] constexpr auto to_string(const content_type type) -> std::string_view
+{
+  switch (type) {
+    case content_type::unknown:
+      return "unknown";
+
+    case content_type::png:
+      return "png";
+
+    case content_type::jpg:
+      return "jpg";
+
+    case content_type::gif:
+      return "gif";
+
+    case content_type::bmp:
+      return "bmp";
+
+    case content_type::webp:
+      return "webp";
+
+    case content_type::tif:
+      return "tif";
+
+    case content_type::ico:
+      return "ico";
+
+    case content_type::cur:
+      return "cur";
+
+    case content_type::pnm:
+      return "pnm";
+
+    case content_type::pcx:
+      return "pcx";
+
+    case content_type::lbm:
+      return "lbm";
+
+    case content_type::xcf:
+      return "xcf";
+
+    case content_type::xpm:
+      return "xpm";
+
+    case content_type::xv:
+      return "xv";
+
+    case content_type::svg:
+      return "svg";
+
+    case content_type::avif:
+      return "avif";
+
+    case content_type::jxl:
+      return "jxl";
+
+    case content_type::qoi:
+      return "qoi";
+
+    case content_type::wav:
+      return "wav";
+
+    case content_type::aiff:
+      return "aiff";
+
+    case content_type::voc:
+      return "voc";
+
+    case content_type::ogg:
+      return "ogg";
+
+    case content_type::opus:
+      return "opus";
+
+    case content_type::flac:
+      return "flac";
+
+    case content_type::mp3:
+      return "mp3";
+
+    case content_type::midi:
+      return "midi";
+
+    case content_type::mod:
+      return "mod";
+
+    default:
+      throw exception {"Did not recognize content type!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const content_type type) -> std::ostream&
+{
+  return stream << to_string(type);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace detail {
+
+/// The amount of bytes inspected by `sniff_content()`, enough for all signatures.
+inline constexpr usize sniff_size = 1'088;
+
+[[nodiscard]] constexpr auto starts_with(const uint8* bytes,
+                                         const usize count,
+                                         const std::string_view magic,
+                                         const usize offset = 0) noexcept -> bool
+{
+  if (count < offset + magic.size()) {
+    return false;
+  }
+
+  for (usize index = 0; index < magic.size(); ++index) {
+    if (bytes[offset + index] != static_cast<uint8>(magic[index])) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+[[nodiscard]] constexpr auto contains(const uint8* bytes,
+                                      const usize count,
+                                      const std::string_view needle) noexcept -> bool
+{
+  for (usize offset = 0; offset + needle.size() <= count; ++offset) {
+    if (starts_with(bytes, count, needle, offset)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/* ISO base media files, where the brands follow the box size and the "ftyp" tag */
+[[nodiscard]] constexpr auto has_ftyp_brand(const uint8* bytes,
+                                            const usize count,
+                                            const std::string_view brand) noexcept -> bool
+{
+  if (!starts_with(bytes, count, "ftyp", 4)) {
+    return false;
+  }
+
+  const auto boxSize = (usize {bytes[0]} << 24u) | (usize {bytes[1]} << 16u) |
+                       (usize {bytes[2]} << 8u) | usize {bytes[3]};
+  const auto end = (boxSize < count) ? boxSize : count;
+
+  /* The major brand, followed by the minor version and the compatible brands */
+  if (starts_with(bytes, end, brand, 8)) {
+    return true;
+  }
+
+  for (usize offset = 16; offset + 4 <= end; offset += 4) {
+    if (starts_with(bytes, end, brand, offset)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/* MPEG audio frame header, i.e. an 11-bit sync word followed by a valid version and layer */
+[[nodiscard]] constexpr auto is_mpeg_frame(const uint8* bytes, const usize count) noexcept
+    -> bool
+{
+  if (count < 3) {
+    return false;
+  }
+
+  const auto version = (bytes[1] >> 3u) & 0x3u;
+  const auto layer = (bytes[1] >> 1u) & 0x3u;
+  const auto bitrate = bytes[2] >> 4u;
+
+  return bytes[0] == 0xFF && (bytes[1] & 0xE0u) == 0xE0u && version != 1 && layer != 0 &&
+         bitrate != 0xF;
+}
+
+/**
+ * Recognizes the format of a file from its first bytes.
+ *
+ * All signatures are matched against the same buffer, which only has to be read once, as
+ * opposed to the `IMG_is*()` functions, which seek and read the header for every format. The
+ * checks mirror those of SDL_image and SDL_mixer, excluding formats without a signature, e.g.
+ * TGA images and raw audio.
+ *
+ * \param bytes the first bytes of the file, ideally `sniff_size` of them.
+ * \param count the amount of bytes.
+ *
+ * \return the recognized content type; `content_type::unknown` if no signature matched.
+ */
+[[nodiscard]] constexpr auto sniff_content(const uint8* bytes, const usize count) noexcept
+    -> content_type
+{
+  const auto has = [=](const std::string_view magic, const usize offset = 0) {
+    return starts_with(bytes, count, magic, offset);
+  };
+
+  if (has("\x89PNG\r\n\x1A\n")) {
+    return content_type::png;
+  }
+  else if (has("\xFF\xD8\xFF")) {
+    return content_type::jpg;
+  }
+  else if (has("GIF87a") || has("GIF89a")) {
+    return content_type::gif;
+  }
+  else if (has("BM")) {
+    return content_type::bmp;
+  }
+  else if (has("RIFF") && has("WEBPVP8", 8)) {
+    return content_type::webp;
+  }
+  else if (has("RIFF") && has("WAVE", 8)) {
+    return content_type::wav;
+  }
+  else if (has("RIFF") && has("RMID", 8)) {
+    return content_type::midi;
+  }
+  else if (has("II*") && count > 3 && bytes[3] == 0) {
+    return content_type::tif;
+  }
+  else if (has("MM") && count > 3 && bytes[2] == 0 && bytes[3] == '*') {
+    return content_type::tif;
+  }
+  else if (count >= 6 && bytes[0] == 0 && bytes[1] == 0 && bytes[3] == 0 &&
+           (bytes[4] != 0 || bytes[5] != 0)) {
+    /* The reserved word, the resource type and a non-zero image count */
+    if (bytes[2] == 1) {
+      return content_type::ico;
+    }
+    else if (bytes[2] == 2) {
+      return content_type::cur;
+    }
+  }
+
+  if (has("P7 332")) {
+    return content_type::xv;
+  }
+  else if (count >= 3 && bytes[0] == 'P' && bytes[1] >= '1' && bytes[1] <= '6' &&
+           (bytes[2] == ' ' || bytes[2] == '\t' || bytes[2] == '\r' || bytes[2] == '\n')) {
+    return content_type::pnm;
+  }
+  else if (count >= 3 && bytes[0] == 0x0A && bytes[2] == 1 &&
+           (bytes[1] == 0 || bytes[1] == 2 || bytes[1] == 3 || bytes[1] == 5)) {
+    return content_type::pcx;
+  }
+  else if (has("FORM") && (has("ILBM", 8) || has("PBM ", 8))) {
+    return content_type::lbm;
+  }
+  else if (has("FORM") && (has("AIFF", 8) || has("AIFC", 8))) {
+    return content_type::aiff;
+  }
+  else if (has("gimp xcf ")) {
+    return content_type::xcf;
+  }
+  else if (has("/* XPM */")) {
+    return content_type::xpm;
+  }
+  else if (has("qoif")) {
+    return content_type::qoi;
+  }
+  else if (has("\xFF\x0A") || has(std::string_view {"\0\0\0\x0CJXL \r\n\x87\n", 12})) {
+    return content_type::jxl;
+  }
+  else if (has_ftyp_brand(bytes, count, "avif") || has_ftyp_brand(bytes, count, "avis")) {
+    return content_type::avif;
+  }
+  else if (has("Creative Voice File\x1A")) {
+    return content_type::voc;
+  }
+  else if (has("OggS")) {
+    return has("OpusHead", 28) ? content_type::opus : content_type::ogg;
+  }
+  else if (has("fLaC")) {
+    return content_type::flac;
+  }
+  else if (has("MThd")) {
+    return content_type::midi;
+  }
+  else if (has("Extended Module:") || has("IMPM") || has("SCRM", 44) || has("M.K.", 1080)) {
+    return content_type::mod;
+  }
+  else if (has("ID3") || is_mpeg_frame(bytes, count)) {
+    return content_type::mp3;
+  }
+  else if (contains(bytes, count, "<svg")) {
+    return content_type::svg;
+  }
+  else {
+    return content_type::unknown;
+  }
+}
+
+/// Returns the SDL_image type name of an image format, for `IMG_LoadTyped_RW()`.
+[[nodiscard]] constexpr auto image_type_name(const content_type type) noexcept -> const char*
+{
+  switch (type) {
+    case content_type::png:
+      return "PNG";
+
+    case content_type::jpg:
+      return "JPG";
+
+    case content_type::gif:
+      return "GIF";
+
+    case content_type::bmp:
+      return "BMP";
+
+    case content_type::webp:
+      return "WEBP";
+
+    case content_type::tif:
+      return "TIF";
+
+    case content_type::ico:
+      return "ICO";
+
+    case content_type::cur:
+      return "CUR";
+
+    case content_type::pnm:
+      return "PNM";
+
+    case content_type::pcx:
+      return "PCX";
+
+    case content_type::lbm:
+      return "LBM";
+
+    case content_type::xcf:
+      return "XCF";
+
+    case content_type::xpm:
+      return "XPM";
+
+    case content_type::xv:
+      return "XV";
+
+    case content_type::svg:
+      return "SVG";
+
+    case content_type::avif:
+      return "AVIF";
+
+    case content_type::jxl:
+      return "JXL";
+
+    case content_type::qoi:
+      return "QOI";
+
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace detail
+}  // namespace cen
+
+#endif  // CENTURION_IO_CONTENT_TYPE_HPP_
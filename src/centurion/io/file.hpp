@@ -34,17 +34,24 @@
 #endif  // CENTURION_NO_SDL_IMAGE
 
 #include <cassert>      // assert
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/memory.hpp"
 #include "../common/primitives.hpp"
 #include "../common/result.hpp"
 #include "../common/utils.hpp"
+#include "../system/endian.hpp"
+#include "content_type.hpp"
 #include "file_mode.hpp"
 #include "file_type.hpp"
 #include "seek_mode.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 /**
@@ -175,6 +182,45 @@ class file final {
 
   // clang-format on
 
+  /**
+   * Reads an array of little-endian values, and converts them to native byte order.
+   *
+   * \tparam T an arithmetic type that is 2, 4 or 8 bytes large.
+   *
+   * \param data the array that the values are read into.
+   * \param maxCount the maximum amount of values to read.
+   *
+   * \return the amount of values that were read.
+   */
+  template <typename T>
+  auto read_little_endian_array(T* data, const size_type maxCount) noexcept -> size_type
+  {
+    const auto count = read_to(data, maxCount);
+    swap_little_endian(data, count);
+    return count;
+  }
+
+  /// Reads an array of big-endian values, see `read_little_endian_array()`.
+  template <typename T>
+  auto read_big_endian_array(T* data, const size_type maxCount) noexcept -> size_type
+  {
+    const auto count = read_to(data, maxCount);
+    swap_big_endian(data, count);
+    return count;
+  }
+
+  template <typename Container>
+  auto read_little_endian_array(Container& container) noexcept -> size_type
+  {
+    return read_little_endian_array(container.data(), container.size());
+  }
+
+  template <typename Container>
+  auto read_big_endian_array(Container& container) noexcept -> size_type
+  {
+    return read_big_endian_array(container.data(), container.size());
+  }
+
   template <typename T>
   auto read() noexcept(noexcept(T {})) -> T
   {
@@ -237,6 +283,40 @@ class file final {
     }
   }
 
+  /**
+   * Detects the image or audio format of the file, from the bytes at the current offset.
+   *
+   * All supported signatures are matched against a single read of the header, and the offset
+   * is restored afterwards. This is much cheaper than calling the `is_*()` functions in turn,
+   * since each of those seeks and reads the header again.
+   *
+   * \return the detected format; `content_type::unknown` if it wasn't recognized.
+   */
+  [[nodiscard]] auto detect_type() const noexcept -> content_type
+  {
+    assert(mContext);
+
+    const auto start = SDL_RWtell(data());
+    if (start < 0) {
+      return content_type::unknown;
+    }
+
+    /* Streams may return fewer bytes than requested, even before the end */
+    uint8 header[detail::sniff_size];
+    usize count = 0;
+    while (count < sizeof header) {
+      const auto read = SDL_RWread(data(), header + count, 1, sizeof header - count);
+      if (read == 0) {
+        break;
+      }
+
+      count += read;
+    }
+
+    SDL_RWseek(data(), start, RW_SEEK_SET);
+    return detail::sniff_content(header, count);
+  }
+
 #ifndef CENTURION_NO_SDL_IMAGE
 
   [[nodiscard]] auto is_png() const noexcept -> bool { return IMG_isPNG(data()) == 1; }
@@ -0,0 +1,300 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_IO_IO_SERVICE_HPP_
+#define CENTURION_IO_IO_SERVICE_HPP_
+
+#include <SDL.h>
+
+#include <atomic>   // atomic
+#include <cassert>  // assert
+#include <cstring>  // memcpy
+#include <memory>   // unique_ptr, make_unique, shared_ptr, make_shared
+#include <string>   // string
+#include <utility>  // move
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/future.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "../events/event_channel.hpp"
+#include "asset_pack.hpp"
+#include "file.hpp"
+#include "file_mode.hpp"
+#include "seek_mode.hpp"
+
+namespace cen {
+
+/// Describes a completed read request.
+struct read_result final {
+  uint64 id {};         ///< The user-supplied identifier of the request.
+  void* buffer {};      ///< The buffer that the data was read into.
+  usize requested {};   ///< The requested amount of bytes.
+  usize bytes_read {};  ///< The amount of bytes that were read, less at the end of a file.
+  bool succeeded {};    ///< Indicates whether the source could be opened and read.
+};
+
+namespace detail {
+
+[[nodiscard]] inline auto read_file_region(const char* path,
+                                           const usize offset,
+                                           void* buffer,
+                                           const usize size) noexcept -> read_result
+{
+  read_result result;
+  result.buffer = buffer;
+  result.requested = size;
+
+  file source {path, file_mode::rb};
+  if (!source) {
+    return result;
+  }
+
+  if (offset != 0 &&
+      !source.seek(static_cast<int64>(offset), seek_mode::from_beginning).has_value()) {
+    return result;
+  }
+
+  result.bytes_read = source.read_to(static_cast<uint8*>(buffer), size);
+  result.succeeded = true;
+
+  return result;
+}
+
+[[nodiscard]] inline auto read_pack_region(const asset_pack& pack,
+                                           const asset_entry& entry,
+                                           const usize offset,
+                                           void* buffer,
+                                           const usize size) noexcept -> read_result
+{
+  read_result result;
+  result.buffer = buffer;
+  result.requested = size;
+
+  if (entry.compression != asset_compression::none || offset > entry.stored_size) {
+    return result;
+  }
+
+  /* Copying from the mapping is what pages the data in, so this still happens off-thread */
+  result.bytes_read = (detail::min)(size, entry.stored_size - offset);
+  std::memcpy(buffer, pack.data(entry) + offset, result.bytes_read);
+  result.succeeded = true;
+
+  return result;
+}
+
+}  // namespace detail
+
+/**
+ * Performs file reads asynchronously on worker threads.
+ *
+ * Read requests specify a file path or an entry in an asset pack, along with a region and a
+ * caller-supplied buffer that the data is read into. Completion is reported either through a
+ * future, or by pushing a `read_result` into an event channel that is polled by the main
+ * thread. The caller must keep buffers (and asset packs) alive until the associated requests
+ * have completed.
+ *
+ * The reads are currently performed with blocking I/O on a thread pool, which should be
+ * dedicated to I/O since the workers spend most of their time waiting on the file system.
+ *
+ * \see read_result
+ */
+class io_service final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates an I/O service with its own worker threads.
+   *
+   * \param workers the amount of I/O worker threads.
+   *
+   * \throws sdl_error if the worker threads cannot be created.
+   */
+  explicit io_service(const size_type workers = 2)
+      : mOwnedPool {std::make_unique<thread_pool>(workers)}
+      , mPool {mOwnedPool.get()}
+  {
+  }
+
+  /**
+   * Creates an I/O service that uses an existing thread pool.
+   *
+   * \param pool the thread pool that performs the reads, must outlive the service.
+   */
+  explicit io_service(thread_pool& pool) noexcept : mPool {&pool}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(io_service)
+  CENTURION_DISABLE_MOVE(io_service)
+
+  /// Waits for all pending requests to complete.
+  ~io_service() noexcept { wait_idle(); }
+
+  /**
+   * Reads a region of a file into a buffer.
+   *
+   * \param path the path of the file.
+   * \param offset the offset of the region in the file, in bytes.
+   * \param size the size of the region, in bytes.
+   * \param buffer the buffer that the data is read into, must be at least `size` bytes large.
+   * \param id an identifier that is forwarded to the result.
+   *
+   * \return a future for the result of the read.
+   */
+  auto read(std::string path,
+            const size_type offset,
+            const size_type size,
+            void* buffer,
+            const uint64 id = 0) -> future<read_result>
+  {
+    assert(buffer || size == 0);
+    return submit(id, [path = std::move(path), offset, size, buffer] {
+      return detail::read_file_region(path.c_str(), offset, buffer, size);
+    });
+  }
+
+  /**
+   * Reads a region of an asset pack entry into a buffer.
+   *
+   * \param pack the asset pack that contains the entry.
+   * \param entry the entry that will be read, must be uncompressed.
+   * \param offset the offset of the region in the entry, in bytes.
+   * \param size the size of the region, in bytes.
+   * \param buffer the buffer that the data is read into, must be at least `size` bytes large.
+   * \param id an identifier that is forwarded to the result.
+   *
+   * \return a future for the result of the read.
+   */
+  auto read(const asset_pack& pack,
+            const asset_entry& entry,
+            const size_type offset,
+            const size_type size,
+            void* buffer,
+            const uint64 id = 0) -> future<read_result>
+  {
+    assert(buffer || size == 0);
+    return submit(id, [&pack, entry, offset, size, buffer] {
+      return detail::read_pack_region(pack, entry, offset, buffer, size);
+    });
+  }
+
+  /**
+   * Reads a region of a file into a buffer, and pushes the result into a channel.
+   *
+   * \details If the channel is full, the worker waits until the result can be pushed.
+   *
+   * \param channel the channel that receives the result, must outlive the request.
+   * \param path the path of the file.
+   * \param offset the offset of the region in the file, in bytes.
+   * \param size the size of the region, in bytes.
+   * \param buffer the buffer that the data is read into, must be at least `size` bytes large.
+   * \param id an identifier that is forwarded to the result.
+   */
+  void read(event_channel<read_result>& channel,
+            std::string path,
+            const size_type offset,
+            const size_type size,
+            void* buffer,
+            const uint64 id = 0)
+  {
+    assert(buffer || size == 0);
+    post(channel, id, [path = std::move(path), offset, size, buffer] {
+      return detail::read_file_region(path.c_str(), offset, buffer, size);
+    });
+  }
+
+  /// Reads a region of an asset pack entry, and pushes the result into a channel.
+  void read(event_channel<read_result>& channel,
+            const asset_pack& pack,
+            const asset_entry& entry,
+            const size_type offset,
+            const size_type size,
+            void* buffer,
+            const uint64 id = 0)
+  {
+    assert(buffer || size == 0);
+    post(channel, id, [&pack, entry, offset, size, buffer] {
+      return detail::read_pack_region(pack, entry, offset, buffer, size);
+    });
+  }
+
+  /// Blocks until all pending requests have completed, helping with any pending work.
+  void wait_idle() noexcept
+  {
+    while (mPending->load(std::memory_order_acquire) != 0) {
+      if (!mPool->run_pending_task()) {
+        SDL_Delay(1);
+      }
+    }
+  }
+
+  /// Returns the amount of requests that haven't completed yet.
+  [[nodiscard]] auto pending() const noexcept -> size_type
+  {
+    return mPending->load(std::memory_order_acquire);
+  }
+
+  /// Returns the thread pool that performs the reads.
+  [[nodiscard]] auto pool() noexcept -> thread_pool& { return *mPool; }
+
+ private:
+  std::unique_ptr<thread_pool> mOwnedPool;
+  thread_pool* mPool {};
+  std::shared_ptr<std::atomic<size_type>> mPending {
+      std::make_shared<std::atomic<size_type>>(0)};
+
+  template <typename Read>
+  auto submit(const uint64 id, Read read) -> future<read_result>
+  {
+    mPending->fetch_add(1, std::memory_order_relaxed);
+    return async(*mPool, [pending = mPending, id, read = std::move(read)] {
+      auto result = read();
+      result.id = id;
+      pending->fetch_sub(1, std::memory_order_release);
+      return result;
+    });
+  }
+
+  template <typename Read>
+  void post(event_channel<read_result>& channel, const uint64 id, Read read)
+  {
+    mPending->fetch_add(1, std::memory_order_relaxed);
+    mPool->submit([&channel, pending = mPending, id, read = std::move(read)] {
+      auto result = read();
+      result.id = id;
+
+      while (!channel.push(result)) {
+        SDL_Delay(1);
+      }
+
+      pending->fetch_sub(1, std::memory_order_release);
+    });
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_IO_IO_SERVICE_HPP_
@@ -0,0 +1,690 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_IO_LZ4_FILE_HPP_
+#define CENTURION_IO_LZ4_FILE_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>  // upper_bound
+#include <cstring>    // memcpy, memmove
+#include <limits>     // numeric_limits
+#include <memory>     // unique_ptr, make_unique
+#include <utility>    // move
+#include <vector>     // vector
+
+#include "../common/primitives.hpp"
+#include "../detail/lz4.hpp"
+#include "../detail/stdlib.hpp"
+#include "../detail/xxhash.hpp"
+#include "../system/endian.hpp"
+#include "file.hpp"
+#include "seek_mode.hpp"
+
+namespace cen {
+namespace detail {
+
+/* Streams use the LZ4 frame format, so that they are interchangeable with the files created
+   by the lz4 command line tool. A frame consists of a header, a sequence of blocks that are
+   each preceded by their little-endian size, and an end mark. See "LZ4 Frame Format
+   Description" for the details.
+
+   Header (7-19 bytes): magic (u32), flags (u8), block descriptor (u8), content size (u64,
+                        optional), dictionary ID (u32, optional), header checksum (u8).
+*/
+inline constexpr uint32 lz4_frame_magic = 0x184D2204;
+inline constexpr usize lz4_frame_max_header_size = 19;
+inline constexpr usize lz4_frame_block_size = 64 * 1'024;  // Block size of written frames
+inline constexpr usize lz4_history_size = 64 * 1'024;      // Reach of linked blocks
+
+inline constexpr uint8 lz4_flag_version = 0x40;
+inline constexpr uint8 lz4_flag_independent = 0x20;
+inline constexpr uint8 lz4_flag_block_checksum = 0x10;
+inline constexpr uint8 lz4_flag_content_size = 0x08;
+inline constexpr uint8 lz4_flag_content_checksum = 0x04;
+inline constexpr uint8 lz4_flag_dictionary = 0x01;
+
+inline constexpr uint32 lz4_uncompressed_block = 0x80000000u;
+
+struct lz4_frame_info final {
+  usize header_size {};        ///< The size of the frame header, in bytes.
+  usize block_max_size {};     ///< The maximum decompressed size of a block, in bytes.
+  maybe<uint64> content_size;  ///< The total decompressed size, if present in the header.
+  bool independent {};         ///< Indicates whether blocks can be decoded on their own.
+  bool block_checksum {};      ///< Indicates whether each block is followed by a checksum.
+};
+
+[[nodiscard]] inline auto lz4_parse_frame_header(const uint8* data, const usize size) noexcept
+    -> maybe<lz4_frame_info>
+{
+  if (size < 7 || read_little_endian<uint32>(data) != lz4_frame_magic) {
+    return nothing;
+  }
+
+  const auto flags = data[4];
+  const auto descriptor = data[5];
+
+  /* Dictionaries aren't supported, since there is no way to provide one */
+  if ((flags & 0xC0) != lz4_flag_version || (flags & 0x02) != 0 ||
+      (flags & lz4_flag_dictionary) != 0 || (descriptor & 0x8F) != 0) {
+    return nothing;
+  }
+
+  const auto sizeId = (descriptor >> 4) & 0x7;
+  if (sizeId < 4) {
+    return nothing;
+  }
+
+  lz4_frame_info info;
+  info.block_max_size = usize {1} << (8 + (2 * sizeId));
+  info.independent = (flags & lz4_flag_independent) != 0;
+  info.block_checksum = (flags & lz4_flag_block_checksum) != 0;
+
+  usize pos = 6;
+  if ((flags & lz4_flag_content_size) != 0) {
+    if (size < pos + 9) {
+      return nothing;
+    }
+
+    info.content_size = read_little_endian<uint64>(data + pos);
+    pos += 8;
+  }
+
+  const auto checksum = static_cast<uint8>((xxh32(data + 4, pos - 4) >> 8) & 0xFF);
+  if (data[pos] != checksum) {
+    return nothing;
+  }
+
+  info.header_size = pos + 1;
+  return info;
+}
+
+inline void lz4_append(std::vector<uint8>& out, const void* data, const usize size)
+{
+  const auto* bytes = static_cast<const uint8*>(data);
+  out.insert(out.end(), bytes, bytes + size);
+}
+
+template <typename T>
+void lz4_append_little_endian(std::vector<uint8>& out, const T value)
+{
+  uint8 bytes[sizeof(T)] {};
+  write_little_endian(bytes, value);
+  lz4_append(out, bytes, sizeof bytes);
+}
+
+/* Appends the header of a frame with independent 64 KB blocks */
+inline void lz4_append_frame_header(std::vector<uint8>& out, const maybe<uint64> contentSize)
+{
+  const auto start = out.size();
+
+  lz4_append_little_endian(out, lz4_frame_magic);
+
+  auto flags = static_cast<uint8>(lz4_flag_version | lz4_flag_independent);
+  if (contentSize) {
+    flags |= lz4_flag_content_size;
+  }
+
+  out.push_back(flags);
+  out.push_back(0x40);
+
+  if (contentSize) {
+    lz4_append_little_endian(out, *contentSize);
+  }
+
+  const auto checksum = xxh32(out.data() + start + 4, out.size() - start - 4);
+  out.push_back(static_cast<uint8>((checksum >> 8) & 0xFF));
+}
+
+/* Appends a block, which is stored uncompressed if compression doesn't make it smaller */
+inline void lz4_append_block(std::vector<uint8>& out,
+                             const uint8* data,
+                             const usize size,
+                             std::vector<uint8>& scratch)
+{
+  scratch.resize(lz4_compress_bound(size));
+  const auto compressed = lz4_compress(data, size, scratch.data(), scratch.size());
+
+  if (compressed != 0 && compressed < size) {
+    lz4_append_little_endian(out, static_cast<uint32>(compressed));
+    lz4_append(out, scratch.data(), compressed);
+  }
+  else {
+    lz4_append_little_endian(out, static_cast<uint32>(size) | lz4_uncompressed_block);
+    lz4_append(out, data, size);
+  }
+}
+
+/* Compresses a buffer into a complete frame, which records the content size */
+[[nodiscard]] inline auto lz4_compress_frame(const void* data, const usize size)
+    -> std::vector<uint8>
+{
+  std::vector<uint8> frame;
+  frame.reserve(lz4_frame_max_header_size + lz4_compress_bound(size) + 4);
+
+  lz4_append_frame_header(frame, static_cast<uint64>(size));
+
+  std::vector<uint8> scratch;
+  const auto* bytes = static_cast<const uint8*>(data);
+
+  for (usize offset = 0; offset < size; offset += lz4_frame_block_size) {
+    const auto count = (detail::min)(lz4_frame_block_size, size - offset);
+    lz4_append_block(frame, bytes + offset, count, scratch);
+  }
+
+  lz4_append_little_endian(frame, uint32 {0});
+  return frame;
+}
+
+/* Decompresses a frame on demand. The start of every block that has been reached is
+   remembered, so seeking backwards only decodes a single block for frames with independent
+   blocks. Linked blocks depend on the preceding blocks, so such frames are decoded from the
+   beginning when seeking backwards. */
+class lz4_read_stream final {
+ public:
+  lz4_read_stream(file source, const lz4_frame_info& info, const uint64 start)
+      : mSource {std::move(source)}
+      , mInfo {info}
+      , mBuffer(lz4_history_size + info.block_max_size)
+      , mCompressed(info.block_max_size + 4)
+  {
+    mBlocks.push_back({0, start + info.header_size});
+  }
+
+  auto read(void* data, const usize size) noexcept -> usize
+  {
+    auto* out = static_cast<uint8*>(data);
+
+    usize total = 0;
+    while (total < size && locate(mPosition)) {
+      const auto offset = static_cast<usize>(mPosition - mBlocks[mCurrent].raw);
+      const auto count = (detail::min)(size - total, mCurrentSize - offset);
+
+      std::memcpy(out + total, block() + offset, count);
+
+      total += count;
+      mPosition += count;
+    }
+
+    return total;
+  }
+
+  auto seek(const int64 offset, const int whence) noexcept -> int64
+  {
+    int64 base {};
+    if (whence == RW_SEEK_CUR) {
+      base = static_cast<int64>(mPosition);
+    }
+    else if (whence == RW_SEEK_END) {
+      base = size();
+    }
+    else if (whence != RW_SEEK_SET) {
+      return SDL_SetError("Invalid seek mode for LZ4 stream");
+    }
+
+    if (base < 0 || base + offset < 0) {
+      return -1;
+    }
+
+    mPosition = static_cast<uint64>(base + offset);
+    return static_cast<int64>(mPosition);
+  }
+
+  /* Frames without a content size are decoded once to find their size */
+  auto size() noexcept -> int64
+  {
+    if (mInfo.content_size) {
+      return static_cast<int64>(*mInfo.content_size);
+    }
+
+    while (!mEnded) {
+      if (!decode(mBlocks.size() - 1) && !mEnded) {
+        return -1;
+      }
+    }
+
+    return static_cast<int64>(mBlocks.back().raw);
+  }
+
+ private:
+  struct block_entry final {
+    uint64 raw {};     ///< The decompressed offset of the block.
+    uint64 source {};  ///< The offset of the block in the source file.
+  };
+
+  inline static constexpr usize npos = std::numeric_limits<usize>::max();
+
+  file mSource;
+  lz4_frame_info mInfo;
+  std::vector<block_entry> mBlocks;  ///< The start of each block that has been reached.
+  std::vector<uint8> mBuffer;        ///< The history of linked blocks, then the current block.
+  std::vector<uint8> mCompressed;
+  uint64 mPosition {};
+  usize mCurrent {npos};
+  usize mCurrentSize {};
+  usize mHistory {};
+  bool mEnded {};
+  bool mFailed {};
+
+  [[nodiscard]] auto block() noexcept -> uint8* { return mBuffer.data() + lz4_history_size; }
+
+  /* Makes the block that contains a decompressed offset the current block */
+  auto locate(const uint64 position) noexcept -> bool
+  {
+    if (mCurrent != npos && position >= mBlocks[mCurrent].raw &&
+        position - mBlocks[mCurrent].raw < mCurrentSize) {
+      return true;
+    }
+
+    const auto next = std::upper_bound(mBlocks.begin(),
+                                       mBlocks.end(),
+                                       position,
+                                       [](const uint64 pos, const block_entry& entry) {
+                                         return pos < entry.raw;
+                                       });
+
+    auto index = static_cast<usize>(next - mBlocks.begin()) - 1;
+    while (decode(index)) {
+      if (position - mBlocks[index].raw < mCurrentSize) {
+        return true;
+      }
+
+      ++index;
+    }
+
+    return false;
+  }
+
+  /* Decodes a known block, returns false at the end of the frame or if the frame is corrupt */
+  auto decode(const usize index) noexcept -> bool
+  {
+    if (mFailed || (mEnded && index == mBlocks.size() - 1)) {
+      return false;
+    }
+
+    if (!mInfo.independent && index != 0 && mCurrent != index - 1) {
+      for (usize previous = 0; previous < index; ++previous) {
+        if (!decode_block(previous)) {
+          return false;
+        }
+      }
+    }
+
+    return decode_block(index);
+  }
+
+  auto decode_block(const usize index) noexcept -> bool
+  {
+    const auto entry = mBlocks[index];
+    if (index == 0) {
+      mHistory = 0;
+    }
+
+    uint8 header[4] {};
+    if (!mSource.seek(static_cast<int64>(entry.source), seek_mode::from_beginning) ||
+        mSource.read_to(header, 4) != 4) {
+      return fail();
+    }
+
+    const auto value = read_little_endian<uint32>(header);
+    if (value == 0) {
+      mEnded = true;
+      return false;
+    }
+
+    const auto storedSize = static_cast<usize>(value & ~lz4_uncompressed_block);
+    const auto checksumSize = mInfo.block_checksum ? usize {4} : usize {0};
+
+    if (storedSize > mInfo.block_max_size ||
+        mSource.read_to(mCompressed.data(), storedSize + checksumSize) !=
+            storedSize + checksumSize) {
+      return fail();
+    }
+
+    if (mInfo.block_checksum && read_little_endian<uint32>(mCompressed.data() + storedSize) !=
+                                    xxh32(mCompressed.data(), storedSize)) {
+      return fail();
+    }
+
+    usize size = storedSize;
+    if ((value & lz4_uncompressed_block) != 0) {
+      std::memcpy(block(), mCompressed.data(), storedSize);
+    }
+    else {
+      const auto decompressed = lz4_decompress_prefixed(mCompressed.data(),
+                                                        storedSize,
+                                                        block(),
+                                                        mInfo.block_max_size,
+                                                        mHistory);
+      if (!decompressed) {
+        return fail();
+      }
+
+      size = *decompressed;
+    }
+
+    mCurrent = index;
+    mCurrentSize = size;
+
+    if (index + 1 == mBlocks.size()) {
+      mBlocks.push_back({entry.raw + size, entry.source + 4 + storedSize + checksumSize});
+    }
+
+    /* Keep the end of the decoded data in front of the next block, for linked blocks */
+    if (!mInfo.independent) {
+      const auto kept = (detail::min)(mHistory + size, lz4_history_size);
+      std::memmove(block() - kept, block() + size - kept, kept);
+      mHistory = kept;
+    }
+
+    return true;
+  }
+
+  auto fail() noexcept -> bool
+  {
+    mFailed = true;
+    SDL_SetError("Corrupt LZ4 stream");
+    return false;
+  }
+};
+
+/* Compresses written data into a frame, one block at a time */
+class lz4_write_stream final {
+ public:
+  explicit lz4_write_stream(file target) : mTarget {std::move(target)}
+  {
+    mBlock.reserve(lz4_frame_block_size);
+  }
+
+  auto write(const void* data, const usize size) -> usize
+  {
+    if (mFailed) {
+      return 0;
+    }
+
+    const auto* bytes = static_cast<const uint8*>(data);
+
+    usize total = 0;
+    while (total < size) {
+      const auto count = (detail::min)(size - total, lz4_frame_block_size - mBlock.size());
+      lz4_append(mBlock, bytes + total, count);
+      total += count;
+
+      if (mBlock.size() == lz4_frame_block_size && !flush()) {
+        return 0;
+      }
+    }
+
+    mPosition += size;
+    return size;
+  }
+
+  auto close() -> bool
+  {
+    bool ok = flush();
+    if (ok) {
+      mOutput.clear();
+      lz4_append_little_endian(mOutput, uint32 {0});
+      ok = mTarget.write(mOutput) == mOutput.size();
+    }
+
+    return mTarget.close() && ok;
+  }
+
+  [[nodiscard]] auto position() const noexcept -> int64
+  {
+    return static_cast<int64>(mPosition);
+  }
+
+ private:
+  file mTarget;
+  std::vector<uint8> mBlock;
+  std::vector<uint8> mOutput;
+  std::vector<uint8> mScratch;
+  uint64 mPosition {};
+  bool mFailed {};
+
+  auto flush() -> bool
+  {
+    if (mFailed) {
+      return false;
+    }
+
+    if (!mBlock.empty()) {
+      mOutput.clear();
+      lz4_append_block(mOutput, mBlock.data(), mBlock.size(), mScratch);
+      mBlock.clear();
+
+      mFailed = mTarget.write(mOutput) != mOutput.size();
+    }
+
+    return !mFailed;
+  }
+};
+
+template <typename Stream>
+[[nodiscard]] auto lz4_stream(SDL_RWops* context) noexcept -> Stream*
+{
+  return static_cast<Stream*>(context->hidden.unknown.data1);
+}
+
+inline auto SDLCALL lz4_read_size(SDL_RWops* context) -> Sint64
+{
+  return lz4_stream<lz4_read_stream>(context)->size();
+}
+
+inline auto SDLCALL lz4_read_seek(SDL_RWops* context, const Sint64 offset, const int whence)
+    -> Sint64
+{
+  return lz4_stream<lz4_read_stream>(context)->seek(offset, whence);
+}
+
+inline auto SDLCALL lz4_read_read(SDL_RWops* context,
+                                  void* data,
+                                  const size_t size,
+                                  const size_t count) -> size_t
+{
+  if (size == 0) {
+    return 0;
+  }
+
+  return lz4_stream<lz4_read_stream>(context)->read(data, size * count) / size;
+}
+
+inline auto SDLCALL lz4_read_write(SDL_RWops*, const void*, size_t, size_t) -> size_t
+{
+  SDL_SetError("LZ4 read stream is read-only");
+  return 0;
+}
+
+inline auto SDLCALL lz4_read_close(SDL_RWops* context) -> int
+{
+  delete lz4_stream<lz4_read_stream>(context);
+  SDL_FreeRW(context);
+  return 0;
+}
+
+inline auto SDLCALL lz4_write_size(SDL_RWops*) -> Sint64
+{
+  return -1;
+}
+
+/* Only the current offset can be queried, since written blocks are final */
+inline auto SDLCALL lz4_write_seek(SDL_RWops* context, const Sint64 offset, const int whence)
+    -> Sint64
+{
+  if (offset != 0 || whence != RW_SEEK_CUR) {
+    return SDL_SetError("LZ4 write stream is not seekable");
+  }
+
+  return lz4_stream<lz4_write_stream>(context)->position();
+}
+
+inline auto SDLCALL lz4_write_read(SDL_RWops*, void*, size_t, size_t) -> size_t
+{
+  SDL_SetError("LZ4 write stream is write-only");
+  return 0;
+}
+
+inline auto SDLCALL lz4_write_write(SDL_RWops* context,
+                                    const void* data,
+                                    const size_t size,
+                                    const size_t count) -> size_t
+{
+  if (size == 0) {
+    return 0;
+  }
+
+  return lz4_stream<lz4_write_stream>(context)->write(data, size * count) / size;
+}
+
+inline auto SDLCALL lz4_write_close(SDL_RWops* context) -> int
+{
+  auto* stream = lz4_stream<lz4_write_stream>(context);
+
+  const auto ok = stream->close();
+  delete stream;
+  SDL_FreeRW(context);
+
+  return ok ? 0 : -1;
+}
+
+}  // namespace detail
+
+/**
+ * Opens an LZ4-compressed file for reading, with transparent decompression.
+ *
+ * The returned file can be passed to any function that accepts a `file`, e.g. to load
+ * textures, music or fonts from compressed data. Data is decompressed one block at a time
+ * when it is read, and seeking is supported. The start of every block that has been read is
+ * remembered, so seeking backwards only needs to decompress a single block.
+ *
+ * \code{cpp}
+ * auto data = cen::open_lz4(cen::file {"sprites.png.lz4", cen::file_mode::rb});
+ * const cen::texture texture = renderer.make_texture(cen::surface {data});
+ * \endcode
+ *
+ * \details The data must be a single frame in the LZ4 frame format, which starts at the
+ *          current offset of the source, e.g. a file created by `lz4` or with `create_lz4()`.
+ *          Dictionaries are not supported, and content checksums are ignored, but block
+ *          checksums are validated. Seeking backwards in frames with linked blocks, which
+ *          `lz4` creates with `--BD`, decompresses the frame from the beginning. Querying the
+ *          size of a frame without a stored content size decompresses the entire frame once.
+ *
+ * \param source the compressed file, which is owned by the returned file.
+ *
+ * \return a read-only file; an invalid file if the source is invalid or is not an LZ4 frame.
+ *
+ * \see create_lz4()
+ */
+[[nodiscard]] inline auto open_lz4(file source) -> file
+{
+  if (!source) {
+    return file {nullptr};
+  }
+
+  const auto start = source.offset();
+
+  uint8 header[detail::lz4_frame_max_header_size] {};
+  const auto count = source.read_to(header, sizeof header);
+
+  const auto info = detail::lz4_parse_frame_header(header, count);
+  if (start < 0 || !info) {
+    return file {nullptr};
+  }
+
+  auto* context = SDL_AllocRW();
+  if (!context) {
+    return file {nullptr};
+  }
+
+  auto stream = std::make_unique<detail::lz4_read_stream>(std::move(source),
+                                                          *info,
+                                                          static_cast<uint64>(start));
+
+  context->size = detail::lz4_read_size;
+  context->seek = detail::lz4_read_seek;
+  context->read = detail::lz4_read_read;
+  context->write = detail::lz4_read_write;
+  context->close = detail::lz4_read_close;
+  context->type = SDL_RWOPS_UNKNOWN;
+  context->hidden.unknown.data1 = stream.release();
+
+  return file {context};
+}
+
+/**
+ * Creates an LZ4-compressed file for writing, with transparent compression.
+ *
+ * Data written to the returned file is compressed in blocks of 64 KB, and closing the file
+ * finishes the frame and closes the target. The result can be read with `open_lz4()`, or
+ * decompressed with the `lz4` command line tool.
+ *
+ * \details The returned file can't be read from, and only supports querying the current
+ *          offset. Make sure to check the result of `file::close()`, since buffered data is
+ *          written when the file is closed.
+ *
+ * \param target the file that receives the compressed data, which is owned by the returned
+ *        file.
+ *
+ * \return a write-only file; an invalid file if the target is invalid or the frame header
+ *         could not be written.
+ *
+ * \see open_lz4()
+ */
+[[nodiscard]] inline auto create_lz4(file target) -> file
+{
+  if (!target) {
+    return file {nullptr};
+  }
+
+  std::vector<uint8> header;
+  detail::lz4_append_frame_header(header, nothing);
+
+  if (target.write(header) != header.size()) {
+    return file {nullptr};
+  }
+
+  auto* context = SDL_AllocRW();
+  if (!context) {
+    return file {nullptr};
+  }
+
+  auto stream = std::make_unique<detail::lz4_write_stream>(std::move(target));
+
+  context->size = detail::lz4_write_size;
+  context->seek = detail::lz4_write_seek;
+  context->read = detail::lz4_write_read;
+  context->write = detail::lz4_write_write;
+  context->close = detail::lz4_write_close;
+  context->type = SDL_RWOPS_UNKNOWN;
+  context->hidden.unknown.data1 = stream.release();
+
+  return file {context};
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_IO_LZ4_FILE_HPP_
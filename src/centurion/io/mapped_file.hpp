@@ -0,0 +1,322 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_IO_MAPPED_FILE_HPP_
+#define CENTURION_IO_MAPPED_FILE_HPP_
+
+#include <SDL.h>
+
+#include <cstddef>  // byte
+#include <limits>   // numeric_limits
+#include <string>   // string, wstring
+#include <utility>  // exchange
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../features.hpp"
+#include "file.hpp"
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+#ifdef _WIN32
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define CENTURION_UNDEF_WIN32_LEAN_AND_MEAN
+#endif  // WIN32_LEAN_AND_MEAN
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#define CENTURION_UNDEF_NOMINMAX
+#endif  // NOMINMAX
+
+#include <windows.h>
+
+#ifdef CENTURION_UNDEF_WIN32_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef CENTURION_UNDEF_WIN32_LEAN_AND_MEAN
+#endif  // CENTURION_UNDEF_WIN32_LEAN_AND_MEAN
+
+#ifdef CENTURION_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef CENTURION_UNDEF_NOMINMAX
+#endif  // CENTURION_UNDEF_NOMINMAX
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+#include <fcntl.h>     // open, O_RDONLY
+#include <sys/mman.h>  // mmap, munmap
+#include <sys/stat.h>  // fstat
+#include <unistd.h>    // close
+
+#define CENTURION_HAS_POSIX_MMAP
+
+#endif  // _WIN32
+
+namespace cen {
+
+/**
+ * A read-only view of the contents of a file, backed by a memory mapping.
+ *
+ * The file is mapped with `mmap` or `MapViewOfFile`, so its contents are paged in on demand
+ * instead of being copied into user buffers. On platforms without memory mapping, the file is
+ * instead read into memory with `SDL_LoadFile`, see `is_mapped()`.
+ *
+ * Regions of the mapping can be wrapped as `file` instances without copying any data, which
+ * lets surfaces, textures, music and fonts load straight from the mapping.
+ * \code{cpp}
+ * const cen::mapped_file pack {"assets.pak"};
+ * auto view = pack.view(offset, size);
+ * const cen::surface image {view};
+ * \endcode
+ *
+ * \details Like `file`, this class doesn't throw if the file can't be opened, use `is_ok()`.
+ *          The mapping must outlive all views of it, including any resources that keep reading
+ *          from a view after being loaded, such as fonts.
+ *
+ * \see file
+ */
+class mapped_file final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Maps a file into memory.
+   *
+   * \param path the path of the file, encoded in UTF-8.
+   */
+  explicit mapped_file(const char* path) noexcept
+  {
+    if (path) {
+      open(path);
+    }
+  }
+
+  explicit mapped_file(const std::string& path) noexcept : mapped_file {path.c_str()} {}
+
+  CENTURION_DISABLE_COPY(mapped_file)
+
+  mapped_file(mapped_file&& other) noexcept
+      : mData {std::exchange(other.mData, nullptr)}
+      , mSize {std::exchange(other.mSize, 0)}
+      , mOk {std::exchange(other.mOk, false)}
+      , mMapped {std::exchange(other.mMapped, false)}
+  {
+  }
+
+  auto operator=(mapped_file&& other) noexcept -> mapped_file&
+  {
+    if (this != &other) {
+      unmap();
+      mData = std::exchange(other.mData, nullptr);
+      mSize = std::exchange(other.mSize, 0);
+      mOk = std::exchange(other.mOk, false);
+      mMapped = std::exchange(other.mMapped, false);
+    }
+
+    return *this;
+  }
+
+  ~mapped_file() noexcept { unmap(); }
+
+  /**
+   * Returns a file context that reads the entire mapping, without copying it.
+   *
+   * \return a read-only file context, which is invalid if the mapping is invalid or empty.
+   */
+  [[nodiscard]] auto view() const noexcept -> file { return view(0, mSize); }
+
+  /**
+   * Returns a file context that reads a region of the mapping, without copying it.
+   *
+   * \param offset the offset of the region, in bytes.
+   * \param size the size of the region, in bytes.
+   *
+   * \return a read-only file context, which is invalid if the region is empty or out of range.
+   */
+  [[nodiscard]] auto view(const size_type offset, const size_type size) const noexcept -> file
+  {
+    if (!mData || size == 0 || offset > mSize || size > mSize - offset ||
+        size > static_cast<size_type>((std::numeric_limits<int>::max)())) {
+      return file {nullptr};
+    }
+
+    return file {SDL_RWFromConstMem(mData + offset, static_cast<int>(size))};
+  }
+
+  [[nodiscard]] auto data() const noexcept -> const uint8* { return mData; }
+
+  [[nodiscard]] auto size() const noexcept -> size_type { return mSize; }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mSize == 0; }
+
+  [[nodiscard]] auto begin() const noexcept -> const uint8* { return mData; }
+
+  [[nodiscard]] auto end() const noexcept -> const uint8* { return mData + mSize; }
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+  [[nodiscard]] auto bytes() const noexcept -> std::span<const std::byte>
+  {
+    return {reinterpret_cast<const std::byte*>(mData), mSize};
+  }
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+  /// Indicates whether the file is memory-mapped, as opposed to being loaded into memory.
+  [[nodiscard]] auto is_mapped() const noexcept -> bool { return mMapped; }
+
+  [[nodiscard]] auto is_ok() const noexcept -> bool { return mOk; }
+
+  /// Indicates whether the file was successfully opened.
+  explicit operator bool() const noexcept { return is_ok(); }
+
+ private:
+  const uint8* mData {};
+  size_type mSize {};
+  bool mOk {};
+  bool mMapped {};
+
+  void open(const char* path) noexcept
+  {
+#ifdef _WIN32
+    const auto length = MultiByteToWideChar(CP_UTF8, 0, path, -1, nullptr, 0);
+    if (length <= 0) {
+      return;
+    }
+
+    /* Failing to allocate the path is treated like failing to open the file */
+    std::wstring widePath;
+    try {
+      widePath.resize(static_cast<usize>(length));
+    }
+    catch (...) {
+      return;
+    }
+
+    MultiByteToWideChar(CP_UTF8, 0, path, -1, widePath.data(), length);
+
+    const auto handle = CreateFileW(widePath.c_str(),
+                                    GENERIC_READ,
+                                    FILE_SHARE_READ,
+                                    nullptr,
+                                    OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL,
+                                    nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+      return;
+    }
+
+    LARGE_INTEGER fileSize {};
+    if (!GetFileSizeEx(handle, &fileSize)) {
+      CloseHandle(handle);
+      return;
+    }
+
+    if (fileSize.QuadPart == 0) {
+      mOk = true;
+    }
+    else {
+      /* The view remains valid after both handles are closed */
+      const auto mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping) {
+        if (auto* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0)) {
+          mData = static_cast<const uint8*>(view);
+          mSize = static_cast<size_type>(fileSize.QuadPart);
+          mOk = true;
+          mMapped = true;
+        }
+
+        CloseHandle(mapping);
+      }
+    }
+
+    CloseHandle(handle);
+#elif defined(CENTURION_HAS_POSIX_MMAP)
+    const auto descriptor = ::open(path, O_RDONLY);
+    if (descriptor == -1) {
+      return;
+    }
+
+    struct stat info {};
+    if (fstat(descriptor, &info) == 0) {
+      if (info.st_size == 0) {
+        mOk = true;
+      }
+      else {
+        /* The mapping remains valid after the descriptor is closed */
+        const auto size = static_cast<size_type>(info.st_size);
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+        if (mapping != MAP_FAILED) {
+          mData = static_cast<const uint8*>(mapping);
+          mSize = size;
+          mOk = true;
+          mMapped = true;
+        }
+      }
+    }
+
+    ::close(descriptor);
+#else
+    usize size {};
+    if (auto* data = SDL_LoadFile(path, &size)) {
+      mData = static_cast<const uint8*>(data);
+      mSize = size;
+      mOk = true;
+    }
+#endif  // _WIN32
+  }
+
+  void unmap() noexcept
+  {
+    if (!mData) {
+      return;
+    }
+
+    if (mMapped) {
+#ifdef _WIN32
+      UnmapViewOfFile(mData);
+#elif defined(CENTURION_HAS_POSIX_MMAP)
+      munmap(const_cast<uint8*>(mData), mSize);
+#endif  // _WIN32
+    }
+    else {
+      SDL_free(const_cast<uint8*>(mData));
+    }
+
+    mData = nullptr;
+    mSize = 0;
+  }
+};
+
+}  // namespace cen
+
+#undef CENTURION_HAS_POSIX_MMAP
+
+#endif  // CENTURION_IO_MAPPED_FILE_HPP_
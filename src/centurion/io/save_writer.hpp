@@ -0,0 +1,491 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_IO_SAVE_WRITER_HPP_
+#define CENTURION_IO_SAVE_WRITER_HPP_
+
+#include <SDL.h>
+
+#include <atomic>         // atomic, memory_order
+#include <cassert>        // assert
+#include <cstdio>         // remove, rename
+#include <deque>          // deque
+#include <string>         // string, wstring
+#include <string_view>    // string_view
+#include <unordered_map>  // unordered_map
+#include <utility>        // move
+#include <vector>         // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/condition.hpp"
+#include "../concurrency/mutex.hpp"
+#include "../concurrency/thread.hpp"
+#include "../events/event_channel.hpp"
+#include "file.hpp"
+#include "file_mode.hpp"
+#include "paths.hpp"
+
+#ifdef _WIN32
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#define CENTURION_UNDEF_WIN32_LEAN_AND_MEAN
+#endif  // WIN32_LEAN_AND_MEAN
+
+#ifndef NOMINMAX
+#define NOMINMAX
+#define CENTURION_UNDEF_NOMINMAX
+#endif  // NOMINMAX
+
+#include <windows.h>
+
+#ifdef CENTURION_UNDEF_WIN32_LEAN_AND_MEAN
+#undef WIN32_LEAN_AND_MEAN
+#undef CENTURION_UNDEF_WIN32_LEAN_AND_MEAN
+#endif  // CENTURION_UNDEF_WIN32_LEAN_AND_MEAN
+
+#ifdef CENTURION_UNDEF_NOMINMAX
+#undef NOMINMAX
+#undef CENTURION_UNDEF_NOMINMAX
+#endif  // CENTURION_UNDEF_NOMINMAX
+
+#elif defined(__unix__) || defined(__APPLE__)
+
+#include <errno.h>     // errno, EINTR
+#include <fcntl.h>     // open, O_WRONLY, O_CREAT, O_TRUNC, O_RDONLY
+#include <stdio.h>     // rename
+#include <unistd.h>    // write, fsync, close
+
+#define CENTURION_HAS_POSIX_FSYNC
+
+#endif  // _WIN32
+
+namespace cen {
+
+/// Emitted by a save writer each time a file has been written, or failed to be written.
+struct save_result final {
+  std::string name;    ///< The name of the file, relative to the save directory.
+  usize size {};       ///< The size of the written data, in bytes.
+  usize coalesced {};  ///< The amount of earlier saves of the file that were superseded.
+  bool succeeded {};   ///< Indicates whether the file was completely written and replaced.
+};
+
+namespace detail {
+
+#ifdef _WIN32
+
+[[nodiscard]] inline auto to_wide_path(const std::string& path) -> std::wstring
+{
+  const auto length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+  if (length <= 0) {
+    return {};
+  }
+
+  std::wstring widePath(static_cast<usize>(length), L'\0');
+  MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, widePath.data(), length);
+
+  return widePath;
+}
+
+#endif  // _WIN32
+
+/**
+ * Replaces a file with new contents, such that the file either has its old or new contents if
+ * the application or system crashes while it is being written.
+ *
+ * The data is written to a temporary file next to the target, which is flushed to the storage
+ * device before it is renamed over the target. Renaming is atomic on POSIX systems, and with
+ * `MoveFileExW()` on Windows. On other platforms, the data is written through `file`, and the
+ * target is removed before the temporary file is renamed, which isn't atomic.
+ */
+[[nodiscard]] inline auto replace_file(const std::string& path,
+                                       const uint8* data,
+                                       const usize size) -> bool
+{
+  assert(data || size == 0);
+
+  const auto temporary = path + ".tmp";
+
+#ifdef _WIN32
+  const auto widePath = to_wide_path(path);
+  const auto wideTemporary = to_wide_path(temporary);
+  if (widePath.empty() || wideTemporary.empty()) {
+    return false;
+  }
+
+  const auto handle = CreateFileW(wideTemporary.c_str(),
+                                  GENERIC_WRITE,
+                                  0,
+                                  nullptr,
+                                  CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+  if (handle == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+
+  bool ok = true;
+  for (usize offset = 0; ok && offset < size;) {
+    const auto chunk = static_cast<DWORD>((detail::min)(size - offset, usize {1} << 30));
+
+    DWORD written {};
+    ok = WriteFile(handle, data + offset, chunk, &written, nullptr) && written != 0;
+    offset += written;
+  }
+
+  ok = ok && FlushFileBuffers(handle);
+  ok = CloseHandle(handle) && ok;
+
+  ok = ok && MoveFileExW(wideTemporary.c_str(),
+                         widePath.c_str(),
+                         MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+#elif defined(CENTURION_HAS_POSIX_FSYNC)
+  const auto descriptor = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (descriptor == -1) {
+    return false;
+  }
+
+  bool ok = true;
+  for (usize offset = 0; ok && offset < size;) {
+    const auto written = ::write(descriptor, data + offset, size - offset);
+    if (written > 0) {
+      offset += static_cast<usize>(written);
+    }
+    else {
+      ok = written == -1 && errno == EINTR;
+    }
+  }
+
+  ok = ok && ::fsync(descriptor) == 0;
+  ok = ::close(descriptor) == 0 && ok;
+
+  ok = ok && ::rename(temporary.c_str(), path.c_str()) == 0;
+
+  /* The rename itself is only durable once the directory has been flushed */
+  if (ok) {
+    const auto separator = path.find_last_of('/');
+    const auto directory = (separator != std::string::npos) ? path.substr(0, separator + 1)
+                                                            : std::string {"."};
+
+    const auto parent = ::open(directory.c_str(), O_RDONLY);
+    if (parent != -1) {
+      ::fsync(parent);
+      ::close(parent);
+    }
+  }
+#else
+  bool ok = false;
+  {
+    file output {temporary, file_mode::wb};
+    ok = output && output.write(data, size) == size && output.close();
+  }
+
+  if (ok) {
+    std::remove(path.c_str());
+    ok = std::rename(temporary.c_str(), path.c_str()) == 0;
+  }
+#endif  // _WIN32
+
+  if (!ok) {
+    std::remove(temporary.c_str());
+  }
+
+  return ok;
+}
+
+}  // namespace detail
+
+/**
+ * Writes save files on a background thread, without blocking the main thread.
+ *
+ * Each save takes ownership of a byte buffer, which is written to a temporary file in the
+ * save directory that is flushed to the storage device and then atomically renamed over the
+ * previous file. A crash or power loss while saving therefore never leaves a corrupt save.
+ *
+ * When a file is saved again before an earlier save of it has started to be written, the
+ * earlier save is discarded in favor of the new data. This makes it cheap to save often, e.g.
+ * for autosaves or replays, since only the most recent data is written.
+ *
+ * A `save_result` is pushed into an event channel when each file has been written, which is
+ * usually consumed on the main thread with `event_dispatcher::poll(event_channel&)`.
+ *
+ * \code{cpp}
+ * cen::event_channel<cen::save_result> saves {16};
+ * cen::save_writer writer {saves, "org", "game"};
+ *
+ * writer.save("slot1.sav", serialize(world));
+ * \endcode
+ *
+ * \details Pending saves are completed before the destructor returns. File names may refer to
+ *          subdirectories of the save directory, which must already exist.
+ *
+ * \see save_result
+ */
+class save_writer final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a writer that saves files in the preferred path of the application.
+   *
+   * \param channel the channel that receives the save results, must outlive the writer.
+   * \param org the name of the organization.
+   * \param app the name of the application.
+   *
+   * \throws exception if the preferred path is unavailable.
+   * \throws sdl_error if the writer thread cannot be created.
+   */
+  save_writer(event_channel<save_result>& channel, const char* org, const char* app)
+      : save_writer {channel, preferred_directory(org, app)}
+  {
+  }
+
+  /**
+   * Creates a writer that saves files in a specific directory.
+   *
+   * \param channel the channel that receives the save results, must outlive the writer.
+   * \param directory the directory that files are saved in, which must exist.
+   *
+   * \throws sdl_error if the writer thread cannot be created.
+   */
+  save_writer(event_channel<save_result>& channel, std::string directory)
+      : mChannel {channel}
+      , mDirectory {with_separator(std::move(directory))}
+      , mThread {&save_writer::run, "save_writer", this}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(save_writer)
+  CENTURION_DISABLE_MOVE(save_writer)
+
+  /// Completes all pending saves, and stops the writer thread.
+  ~save_writer() noexcept
+  {
+    mMutex.lock();
+    mStopping = true;
+    mMutex.unlock();
+
+    mWork.signal();
+    mThread.join();
+  }
+
+  /**
+   * Saves a file in the background.
+   *
+   * \param name the name of the file, relative to the save directory.
+   * \param data the new contents of the file.
+   */
+  void save(std::string name, std::vector<uint8> data)
+  {
+    assert(!name.empty());
+
+    mMutex.lock();
+
+    if (const auto it = mPending.find(name); it != mPending.end()) {
+      it->second.data = std::move(data);
+      ++it->second.coalesced;
+      mCoalesced.fetch_add(1, std::memory_order_relaxed);
+    }
+    else {
+      mOrder.push_back(name);
+      mPending.try_emplace(std::move(name), pending_save {std::move(data), 0});
+    }
+
+    mMutex.unlock();
+    mWork.signal();
+  }
+
+  /// Saves a copy of a buffer in the background, see `save(std::string, std::vector<uint8>)`.
+  void save(std::string name, const void* data, const size_type size)
+  {
+    assert(data || size == 0);
+
+    const auto* bytes = static_cast<const uint8*>(data);
+    save(std::move(name), std::vector<uint8>(bytes, bytes + size));
+  }
+
+  /// Blocks until all pending saves have been written.
+  void wait_idle() noexcept
+  {
+    mMutex.lock();
+
+    while (!mPending.empty() || mWriting) {
+      mIdle.wait(mMutex);
+    }
+
+    mMutex.unlock();
+  }
+
+  /// Returns the amount of saves that haven't been written yet.
+  [[nodiscard]] auto pending() noexcept -> size_type
+  {
+    mMutex.lock();
+    const auto count = mPending.size() + (mWriting ? 1u : 0u);
+    mMutex.unlock();
+
+    return count;
+  }
+
+  /// Returns the full path of a file in the save directory.
+  [[nodiscard]] auto path_of(const std::string_view name) const -> std::string
+  {
+    return mDirectory + std::string {name};
+  }
+
+  [[nodiscard]] auto directory() const noexcept -> const std::string& { return mDirectory; }
+
+  /// Returns the amount of files that have been written successfully.
+  [[nodiscard]] auto written() const noexcept -> uint64
+  {
+    return mWritten.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of files that couldn't be written.
+  [[nodiscard]] auto failed() const noexcept -> uint64
+  {
+    return mFailed.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of saves that were superseded by later saves of the same file.
+  [[nodiscard]] auto coalesced() const noexcept -> uint64
+  {
+    return mCoalesced.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of results that were lost because the channel was full.
+  [[nodiscard]] auto dropped() const noexcept -> uint64
+  {
+    return mDropped.load(std::memory_order_relaxed);
+  }
+
+ private:
+  struct pending_save final {
+    std::vector<uint8> data;
+    size_type coalesced {};
+  };
+
+  event_channel<save_result>& mChannel;
+  std::string mDirectory;
+  mutex mMutex;
+  condition mWork;
+  condition mIdle;
+  std::unordered_map<std::string, pending_save> mPending;
+  std::deque<std::string> mOrder;  ///< The names of the pending saves, in order.
+  std::atomic<uint64> mWritten {};
+  std::atomic<uint64> mFailed {};
+  std::atomic<uint64> mCoalesced {};
+  std::atomic<uint64> mDropped {};
+  bool mWriting {};
+  bool mStopping {};
+  thread mThread;  ///< Must be the last member, so that it starts after initialization.
+
+  [[nodiscard]] static auto preferred_directory(const char* org, const char* app)
+      -> std::string
+  {
+    const auto path = preferred_path(org, app);
+    if (!path) {
+      throw exception {"Failed to determine the preferred path!"};
+    }
+
+    return path.copy();
+  }
+
+  [[nodiscard]] static auto with_separator(std::string directory) -> std::string
+  {
+    if (!directory.empty() && directory.back() != '/' && directory.back() != '\\') {
+      directory += '/';
+    }
+
+    return directory;
+  }
+
+  static int SDLCALL run(void* data)
+  {
+    auto* self = static_cast<save_writer*>(data);
+    self->process();
+    return 0;
+  }
+
+  void process()
+  {
+    mMutex.lock();
+
+    for (;;) {
+      while (mOrder.empty() && !mStopping) {
+        mWork.wait(mMutex);
+      }
+
+      /* Pending saves are still written when stopping */
+      if (mOrder.empty()) {
+        break;
+      }
+
+      auto name = std::move(mOrder.front());
+      mOrder.pop_front();
+
+      const auto it = mPending.find(name);
+      auto save = std::move(it->second);
+      mPending.erase(it);
+
+      mWriting = true;
+      mMutex.unlock();
+
+      save_result result;
+      result.size = save.data.size();
+      result.coalesced = save.coalesced;
+      const auto path = path_of(name);
+      result.succeeded = detail::replace_file(path, save.data.data(), save.data.size());
+      result.name = std::move(name);
+
+      if (result.succeeded) {
+        mWritten.fetch_add(1, std::memory_order_relaxed);
+      }
+      else {
+        mFailed.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      if (!mChannel.push(std::move(result))) {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      mMutex.lock();
+      mWriting = false;
+
+      if (mOrder.empty()) {
+        mIdle.broadcast();
+      }
+    }
+
+    mMutex.unlock();
+  }
+};
+
+}  // namespace cen
+
+#undef CENTURION_HAS_POSIX_FSYNC
+
+#endif  // CENTURION_IO_SAVE_WRITER_HPP_
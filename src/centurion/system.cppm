@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+module;
+
+#include "centurion/system.hpp"
+
+export module centurion:system;
+
+export namespace cen {
+
+using cen::cache_manager_options;
+using cen::cache_info;
+using cen::cache_manager;
+
+using cen::set_clipboard;
+using cen::has_clipboard;
+using cen::get_clipboard;
+using cen::clipboard_cache;
+
+using cen::logical_cpu_count;
+using cen::physical_core_cpus;
+using cen::physical_core_count;
+
+using cen::is_little_endian;
+using cen::is_big_endian;
+using cen::swap_byte_order;
+using cen::swap_big_endian;
+using cen::swap_little_endian;
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+using cen::locale;
+using cen::locale_cache;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+
+using cen::ram_mb;
+using cen::ram_gb;
+
+using cen::timer_id;
+using cen::timer_event;
+using cen::periodic_timer;
+
+using cen::on_linux;
+using cen::on_apple;
+using cen::on_win32;
+using cen::on_win64;
+using cen::on_windows;
+using cen::on_android;
+using cen::platform_id;
+using cen::to_string;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::operator<<;
+
+#endif  // CENTURION_NO_IOSTREAM
+using cen::platform_name;
+using cen::current_platform;
+using cen::is_windows;
+using cen::is_macos;
+using cen::is_linux;
+using cen::is_ios;
+using cen::is_android;
+using cen::is_tablet;
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+using cen::open_url;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+
+using cen::symbol_binder;
+using cen::plugin_interface;
+
+using cen::power_state;
+using cen::battery_seconds;
+using cen::battery_minutes;
+using cen::battery_percentage;
+using cen::query_battery;
+using cen::is_battery_available;
+using cen::is_battery_charging;
+using cen::is_battery_charged;
+using cen::power_info;
+using cen::query_power_info;
+using cen::power_cache;
+
+using cen::power_profile;
+using cen::power_governor_options;
+using cen::power_governor;
+
+using cen::profile_event_kind;
+using cen::profile_event;
+using cen::enable_profiling;
+using cen::disable_profiling;
+using cen::is_profiling;
+using cen::profile_zone;
+using cen::mark_profile_frame;
+using cen::record_gpu_profile_zone;
+using cen::collect_profile;
+using cen::dropped_profile_events;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::write_chrome_trace;
+
+#endif  // CENTURION_NO_IOSTREAM
+
+using cen::shared_object;
+
+using cen::frequency;
+using cen::now;
+using cen::now_in_seconds;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+using cen::ticks64;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+using cen::ticks32;
+using cen::stopwatch;
+
+}  // namespace cen
@@ -22,11 +22,17 @@
  * SOFTWARE.
  */
 
+#include "system/cache_manager.hpp"
 #include "system/clipboard.hpp"
+#include "system/cpu.hpp"
 #include "system/endian.hpp"
 #include "system/memory.hpp"
 #include "system/platform.hpp"
 #include "system/locale.hpp"
 #include "system/power.hpp"
+#include "system/power_governor.hpp"
+#include "system/periodic_timer.hpp"
+#include "system/plugin_interface.hpp"
+#include "system/profiler.hpp"
 #include "system/shared_object.hpp"
 #include "system/timer.hpp"
\ No newline at end of file
@@ -0,0 +1,352 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_SYSTEM_CACHE_MANAGER_HPP_
+#define CENTURION_SYSTEM_CACHE_MANAGER_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>   // find_if
+#include <atomic>      // atomic
+#include <functional>  // function
+#include <string>      // string
+#include <utility>     // move
+#include <vector>      // vector
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../events/event_filter.hpp"
+#include "memory.hpp"
+
+namespace cen {
+
+/// The configuration of a cache manager.
+struct cache_manager_options final {
+  usize budget {};             ///< The global budget in bytes, zero to derive it from the RAM.
+  double ram_fraction {0.25};  ///< The fraction of the system RAM used as the default budget.
+  double low_memory_fraction {0.5};  ///< The fraction of the budget kept on low memory.
+  bool trim_in_background {true};    ///< Evicts all cached entries in the background.
+  bool watch_events {true};          ///< Reacts to low memory and background events.
+};
+
+/// Describes a cache registered with a `cache_manager`.
+struct cache_info final {
+  usize id {};       ///< The identifier of the cache.
+  std::string name;  ///< The name of the cache, used for diagnostics.
+  usize bytes {};    ///< The memory used by the cache, in bytes.
+};
+
+/**
+ * Enforces a global memory budget for several caches, by evicting their least recently used
+ * entries.
+ *
+ * Font caches, texture pools, surface pools and sound caches register with a manager, which
+ * evicts entries across all of them in least recently used order until the total memory usage
+ * fits the budget. Cache entries are stamped with `tick()` when they are used, so that the
+ * entries of different caches can be compared.
+ * \code{cpp}
+ * cen::cache_manager caches;
+ * caches.add(fonts, "fonts");
+ * caches.add(sounds, "sounds");
+ *
+ * while (running) {
+ *   // ...
+ *   caches.update();
+ * }
+ * \endcode
+ *
+ * \details By default, the manager watches for `SDL_APP_LOWMEMORY` and
+ *          `SDL_APP_WILLENTERBACKGROUND` events. On low memory, caches are trimmed to a
+ *          fraction of the budget, and all cached entries are evicted when the application
+ *          enters the background. Events may be pushed from other threads, so the trimming is
+ *          deferred to the next call to `update()`, which should be made on the main thread.
+ *
+ * \details A cache is registered by reference, so it must outlive the manager or be removed
+ *          before it is destroyed. A registered cache must provide the following functions.
+ *          - `memory_usage() const -> usize`, the memory used by the cache, in bytes.
+ *          - `oldest_use() const -> maybe<uint64>`, the stamp of the least recently used
+ *            evictable entry, if there is one.
+ *          - `evict_oldest() -> bool`, evicts the least recently used evictable entry.
+ */
+class cache_manager final {
+ public:
+  using size_type = usize;
+  using id_type = usize;
+
+  /// The budget used if the amount of system RAM is unknown, in bytes.
+  inline constexpr static size_type fallback_budget = 256u * 1024u * 1024u;
+
+  explicit cache_manager(const cache_manager_options& options = {})
+      : mOptions {options}
+      , mBudget {options.budget != 0 ? options.budget : default_budget(options.ram_fraction)}
+  {
+    if (options.watch_events) {
+      mWatch.emplace(mListener);
+    }
+  }
+
+  CENTURION_DISABLE_COPY(cache_manager)
+  CENTURION_DISABLE_MOVE(cache_manager)
+
+  /**
+   * Registers a cache, which will be trimmed along with the other registered caches.
+   *
+   * \param cache the cache that will be managed.
+   * \param name the name of the cache, used for diagnostics.
+   *
+   * \return the identifier of the cache, used to remove it.
+   */
+  template <typename Cache>
+  auto add(Cache& cache, std::string name = {}) -> id_type
+  {
+    auto& entry = mCaches.emplace_back();
+    entry.id = mNextId++;
+    entry.name = std::move(name);
+    entry.usage = [&cache] { return static_cast<size_type>(cache.memory_usage()); };
+    entry.oldest = [&cache]() -> maybe<uint64> { return cache.oldest_use(); };
+    entry.evict = [&cache] { return cache.evict_oldest(); };
+    return entry.id;
+  }
+
+  /**
+   * Unregisters a cache, without evicting any of its entries.
+   *
+   * \param id the identifier of the cache.
+   *
+   * \return `true` if a cache was removed; `false` otherwise.
+   */
+  auto remove(const id_type id) -> bool
+  {
+    const auto iter = std::find_if(mCaches.begin(), mCaches.end(), [id](const entry& e) {
+      return e.id == id;
+    });
+
+    if (iter != mCaches.end()) {
+      mCaches.erase(iter);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Reacts to pending low memory and background events, and enforces the budget.
+   *
+   * \return the amount of bytes that were freed.
+   */
+  auto update() -> size_type
+  {
+    size_type freed = 0;
+
+    if (mListener.background.exchange(false, std::memory_order_acquire) &&
+        mOptions.trim_in_background) {
+      freed += trim(0);
+    }
+
+    if (mListener.low_memory.exchange(false, std::memory_order_acquire)) {
+      freed += trim_for_low_memory();
+    }
+
+    return freed + trim(mBudget);
+  }
+
+  /**
+   * Evicts the least recently used entries of all caches, until the memory usage fits a limit.
+   *
+   * \details Caches may keep entries that they cannot evict, so the memory usage may remain
+   *          above the limit.
+   *
+   * \param limit the maximum amount of memory used by all caches, in bytes.
+   *
+   * \return the amount of bytes that were freed.
+   */
+  auto trim(const size_type limit) -> size_type
+  {
+    std::vector<size_type> usage;
+    usage.reserve(mCaches.size());
+
+    size_type total = 0;
+    for (const auto& cache : mCaches) {
+      total += usage.emplace_back(cache.usage());
+    }
+
+    const auto initial = total;
+    std::vector<bool> exhausted(mCaches.size(), false);
+
+    while (total > limit) {
+      /* Find the cache with the least recently used entry */
+      maybe<size_type> victim;
+      uint64 oldest {};
+
+      for (size_type index = 0; index < mCaches.size(); ++index) {
+        if (exhausted[index]) {
+          continue;
+        }
+
+        const auto stamp = mCaches[index].oldest();
+        if (!stamp) {
+          exhausted[index] = true;
+        }
+        else if (!victim || *stamp < oldest) {
+          victim = index;
+          oldest = *stamp;
+        }
+      }
+
+      if (!victim) {
+        break;
+      }
+
+      auto& cache = mCaches[*victim];
+      if (!cache.evict()) {
+        exhausted[*victim] = true;
+        continue;
+      }
+
+      ++mEvictions;
+
+      const auto after = cache.usage();
+      total = total - usage[*victim] + after;
+      usage[*victim] = after;
+    }
+
+    return (initial > total) ? initial - total : 0;
+  }
+
+  /// Trims all caches to the low memory fraction of the budget, like on `SDL_APP_LOWMEMORY`.
+  auto trim_for_low_memory() -> size_type
+  {
+    const auto fraction = (detail::clamp)(mOptions.low_memory_fraction, 0.0, 1.0);
+    return trim(static_cast<size_type>(static_cast<double>(mBudget) * fraction));
+  }
+
+  /// Returns the total memory used by all registered caches, in bytes.
+  [[nodiscard]] auto memory_usage() const -> size_type
+  {
+    size_type total = 0;
+    for (const auto& cache : mCaches) {
+      total += cache.usage();
+    }
+
+    return total;
+  }
+
+  /// Returns descriptions of all registered caches.
+  [[nodiscard]] auto caches() const -> std::vector<cache_info>
+  {
+    std::vector<cache_info> result;
+    result.reserve(mCaches.size());
+
+    for (const auto& cache : mCaches) {
+      result.push_back(cache_info {cache.id, cache.name, cache.usage()});
+    }
+
+    return result;
+  }
+
+  /// Sets the global budget, which is enforced by the next call to `update()`.
+  void set_budget(const size_type budget) noexcept { mBudget = budget; }
+
+  /// Returns the global budget, in bytes.
+  [[nodiscard]] auto budget() const noexcept -> size_type { return mBudget; }
+
+  /// Returns the amount of registered caches.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mCaches.size(); }
+
+  /// Returns the amount of entries that have been evicted by the manager.
+  [[nodiscard]] auto evictions() const noexcept -> uint64 { return mEvictions; }
+
+  /// Indicates whether the manager reacts to low memory and background events.
+  [[nodiscard]] auto is_watching_events() const noexcept -> bool { return mWatch.has_value(); }
+
+  /**
+   * Returns a new usage stamp, which caches use to record when their entries were used.
+   *
+   * \details The stamps are shared by all caches, and increase monotonically.
+   *
+   * \return a usage stamp that is greater than all previous stamps.
+   */
+  [[nodiscard]] static auto tick() noexcept -> uint64
+  {
+    static std::atomic<uint64> counter {0};
+    return counter.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  /**
+   * Returns the default budget, derived from the amount of system RAM.
+   *
+   * \param fraction the fraction of the system RAM that is used as the budget.
+   *
+   * \return the default budget, in bytes.
+   */
+  [[nodiscard]] static auto default_budget(const double fraction = 0.25) noexcept -> size_type
+  {
+    const auto ram = ram_mb();
+    if (ram <= 0) {
+      return fallback_budget;
+    }
+
+    const auto bytes = static_cast<double>(ram) * 1024.0 * 1024.0;
+    return static_cast<size_type>(bytes * (detail::clamp)(fraction, 0.0, 1.0));
+  }
+
+ private:
+  struct entry final {
+    id_type id {};
+    std::string name;
+    std::function<size_type()> usage;
+    std::function<maybe<uint64>()> oldest;
+    std::function<bool()> evict;
+  };
+
+  /* Invoked by the event watch, possibly from other threads */
+  struct listener final {
+    std::atomic<bool> low_memory {false};
+    std::atomic<bool> background {false};
+
+    void operator()(const SDL_Event& event) noexcept
+    {
+      if (event.type == SDL_APP_LOWMEMORY) {
+        low_memory.store(true, std::memory_order_release);
+      }
+      else if (event.type == SDL_APP_WILLENTERBACKGROUND) {
+        background.store(true, std::memory_order_release);
+      }
+    }
+  };
+
+  cache_manager_options mOptions;
+  size_type mBudget {};
+  std::vector<entry> mCaches;
+  id_type mNextId {1};
+  uint64 mEvictions {};
+  listener mListener;
+  maybe<event_watch> mWatch;
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_SYSTEM_CACHE_MANAGER_HPP_
@@ -27,11 +27,14 @@
 
 #include <SDL.h>
 
-#include <cassert>  // assert
-#include <string>   // string
+#include <cassert>      // assert
+#include <string>       // string
+#include <string_view>  // string_view
 
+#include "../common/primitives.hpp"
 #include "../common/result.hpp"
 #include "../common/sdl_string.hpp"
+#include "../events/event_type.hpp"
 
 namespace cen {
 
@@ -57,6 +60,85 @@ inline auto set_clipboard(const std::string& text) noexcept -> result
   return text.copy();
 }
 
+/**
+ * Caches the clipboard text, so that it can be queried every frame without allocations.
+ *
+ * The clipboard is only queried again when the cache is notified of a clipboard update
+ * event, or when it is explicitly refreshed.
+ */
+class clipboard_cache final {
+ public:
+  using generation_type = uint64;
+
+  /// Creates a cache and queries the current clipboard text.
+  clipboard_cache() { refresh(); }
+
+  /**
+   * Updates the cache using the type of an event.
+   *
+   * \param type the type of the event that will be processed.
+   *
+   * \return `true` if the clipboard was queried again; `false` otherwise.
+   */
+  auto update(const event_type type) -> bool
+  {
+    if (type == event_type::clipboard_update) {
+      refresh();
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Queries the current clipboard text.
+  void refresh()
+  {
+    if (SDL_HasClipboardText()) {
+      const sdl_string text {SDL_GetClipboardText()};
+      mText.assign(text.get() ? text.get() : "");
+    }
+    else {
+      mText.clear();
+    }
+
+    ++mGeneration;
+  }
+
+  /**
+   * Sets the clipboard text, and updates the cache accordingly.
+   *
+   * \param text the new clipboard text.
+   *
+   * \return `success` if the clipboard was updated; `failure` otherwise.
+   */
+  auto set(const char* text) -> result
+  {
+    assert(text);
+
+    if (SDL_SetClipboardText(text) == 0) {
+      mText.assign(text);
+      ++mGeneration;
+      return success;
+    }
+    else {
+      return failure;
+    }
+  }
+
+  /// Returns the cached text, which is invalidated by the next refresh.
+  [[nodiscard]] auto text() const noexcept -> std::string_view { return mText; }
+
+  [[nodiscard]] auto has_text() const noexcept -> bool { return !mText.empty(); }
+
+  /// Returns a counter that is incremented every time the cached text is replaced.
+  [[nodiscard]] auto generation() const noexcept -> generation_type { return mGeneration; }
+
+ private:
+  std::string mText;
+  generation_type mGeneration {};
+};
+
 }  // namespace cen
 
 #endif  // CENTURION_SYSTEM_CLIPBOARD_HPP_
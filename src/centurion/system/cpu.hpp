@@ -0,0 +1,126 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_SYSTEM_CPU_HPP_
+#define CENTURION_SYSTEM_CPU_HPP_
+
+#include <SDL.h>
+
+#include <set>      // set
+#include <string>   // string, to_string
+#include <utility>  // pair
+#include <vector>   // vector
+
+#ifdef __linux__
+
+#include <cstdio>  // FILE, fopen, fscanf, fclose
+
+#endif  // __linux__
+
+namespace cen {
+
+#ifdef __linux__
+
+namespace detail {
+
+/// Reads a single integer from a sysfs file, returns false if that failed.
+inline auto read_sysfs_int(const std::string& path, int& value) -> bool
+{
+  if (std::FILE* file = std::fopen(path.c_str(), "r")) {
+    const auto read = std::fscanf(file, "%d", &value);
+    std::fclose(file);
+    return read == 1;
+  }
+  else {
+    return false;
+  }
+}
+
+}  // namespace detail
+
+#endif  // __linux__
+
+/// Returns the amount of logical CPU cores, at least one.
+[[nodiscard]] inline auto logical_cpu_count() noexcept -> int
+{
+  const auto count = SDL_GetCPUCount();
+  return (count > 0) ? count : 1;
+}
+
+/**
+ * Returns the index of one logical CPU for each physical core.
+ *
+ * Pinning threads to the returned CPUs ensures that no two threads share a physical core
+ * through simultaneous multithreading. The topology is only available on Linux, on other
+ * platforms every logical CPU is treated as a physical core.
+ *
+ * \return the indices of logical CPUs, in ascending order.
+ */
+[[nodiscard]] inline auto physical_core_cpus() -> std::vector<int>
+{
+  const auto count = logical_cpu_count();
+
+  std::vector<int> cpus;
+  cpus.reserve(static_cast<std::size_t>(count));
+
+#ifdef __linux__
+  std::set<std::pair<int, int>> cores;  // (package, core) pairs
+
+  for (int cpu = 0; cpu < count; ++cpu) {
+    const auto topology = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+
+    int core {};
+    int package {};
+    if (!detail::read_sysfs_int(topology + "core_id", core) ||
+        !detail::read_sysfs_int(topology + "physical_package_id", package)) {
+      cpus.clear();
+      break;  // The topology is unavailable, e.g. in some containers
+    }
+
+    if (cores.emplace(package, core).second) {
+      cpus.push_back(cpu);
+    }
+  }
+
+  if (!cpus.empty()) {
+    return cpus;
+  }
+#endif  // __linux__
+
+  for (int cpu = 0; cpu < count; ++cpu) {
+    cpus.push_back(cpu);
+  }
+
+  return cpus;
+}
+
+/// Returns the amount of physical CPU cores.
+[[nodiscard]] inline auto physical_core_count() -> int
+{
+  return static_cast<int>(physical_core_cpus().size());
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_SYSTEM_CPU_HPP_
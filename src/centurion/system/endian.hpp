@@ -27,7 +27,27 @@
 
 #include <SDL.h>
 
+#include <cstring>      // memcpy
+#include <type_traits>  // is_arithmetic_v, conditional_t
+
 #include "../common/primitives.hpp"
+#include "../features.hpp"
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+#if defined(__SSSE3__)
+
+#include <tmmintrin.h>  // _mm_shuffle_epi8, _mm_setr_epi8, _mm_loadu_si128, _mm_storeu_si128
+
+#elif defined(__ARM_NEON)
+
+#include <arm_neon.h>  // vrev16q_u8, vrev32q_u8, vrev64q_u8, vld1q_u8, vst1q_u8
+
+#endif  // defined(__SSSE3__)
 
 namespace cen {
 
@@ -101,6 +121,194 @@ namespace cen {
   return SDL_SwapFloatLE(value);
 }
 
+namespace detail {
+
+template <typename T>
+inline constexpr bool is_bulk_swappable_v =
+    std::is_arithmetic_v<T> && (sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+template <typename T>
+void swap_bytes_scalar(uint8* data, const usize count) noexcept
+{
+  for (usize index = 0; index < count; ++index, data += sizeof(T)) {
+    T value {};
+    std::memcpy(&value, data, sizeof(T));
+
+    if constexpr (sizeof(T) == 2) {
+      value = SDL_Swap16(value);
+    }
+    else if constexpr (sizeof(T) == 4) {
+      value = SDL_Swap32(value);
+    }
+    else {
+      value = SDL_Swap64(value);
+    }
+
+    std::memcpy(data, &value, sizeof(T));
+  }
+}
+
+/* Reverses the bytes of each Size-byte element, 16 bytes at a time where possible */
+template <usize Size>
+void swap_bytes(uint8* data, usize count) noexcept
+{
+  using unsigned_type =
+      std::conditional_t<Size == 2, uint16, std::conditional_t<Size == 4, uint32, uint64>>;
+
+  constexpr usize per_block = 16 / Size;
+  const auto blocks = count / per_block;
+
+#if defined(__SSSE3__)
+  const auto mask = [] {
+    if constexpr (Size == 2) {
+      return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    }
+    else if constexpr (Size == 4) {
+      return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    }
+    else {
+      return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    }
+  }();
+
+  for (usize block = 0; block < blocks; ++block, data += 16) {
+    auto* ptr = reinterpret_cast<__m128i*>(data);
+    _mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr), mask));
+  }
+
+  count -= blocks * per_block;
+#elif defined(__ARM_NEON)
+  for (usize block = 0; block < blocks; ++block, data += 16) {
+    const auto bytes = vld1q_u8(data);
+
+    if constexpr (Size == 2) {
+      vst1q_u8(data, vrev16q_u8(bytes));
+    }
+    else if constexpr (Size == 4) {
+      vst1q_u8(data, vrev32q_u8(bytes));
+    }
+    else {
+      vst1q_u8(data, vrev64q_u8(bytes));
+    }
+  }
+
+  count -= blocks * per_block;
+#else
+  static_cast<void>(blocks);
+#endif  // defined(__SSSE3__)
+
+  swap_bytes_scalar<unsigned_type>(data, count);
+}
+
+/* Reads a little-endian value from a possibly unaligned buffer */
+template <typename T>
+[[nodiscard]] auto read_little_endian(const uint8* data) noexcept -> T
+{
+  T value {};
+  std::memcpy(&value, data, sizeof value);
+
+  if constexpr (sizeof(T) == 1) {
+    return value;
+  }
+  else {
+    return swap_little_endian(value);
+  }
+}
+
+/* Writes a value to a possibly unaligned buffer in little-endian byte order */
+template <typename T>
+void write_little_endian(uint8* data, const T value) noexcept
+{
+  if constexpr (sizeof(T) == 1) {
+    std::memcpy(data, &value, sizeof value);
+  }
+  else {
+    const auto swapped = swap_little_endian(value);
+    std::memcpy(data, &swapped, sizeof swapped);
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Reverses the byte order of each value in an array.
+ *
+ * The conversion uses SSSE3 or NEON shuffles if they are enabled at compile-time.
+ *
+ * \tparam T an arithmetic type that is 2, 4 or 8 bytes large.
+ *
+ * \param values the values that will be converted in-place.
+ * \param count the amount of values.
+ */
+template <typename T>
+void swap_byte_order(T* values, const usize count) noexcept
+{
+  static_assert(detail::is_bulk_swappable_v<T>);
+  detail::swap_bytes<sizeof(T)>(reinterpret_cast<uint8*>(values), count);
+}
+
+/**
+ * Converts an array of big-endian values to native byte order, or vice versa.
+ *
+ * \details This does nothing on big-endian platforms.
+ *
+ * \see swap_byte_order()
+ */
+template <typename T>
+void swap_big_endian(T* values, const usize count) noexcept
+{
+  if constexpr (is_little_endian()) {
+    swap_byte_order(values, count);
+  }
+  else {
+    static_assert(detail::is_bulk_swappable_v<T>);
+    static_cast<void>(values);
+    static_cast<void>(count);
+  }
+}
+
+/**
+ * Converts an array of little-endian values to native byte order, or vice versa.
+ *
+ * \details This does nothing on little-endian platforms.
+ *
+ * \see swap_byte_order()
+ */
+template <typename T>
+void swap_little_endian(T* values, const usize count) noexcept
+{
+  if constexpr (is_big_endian()) {
+    swap_byte_order(values, count);
+  }
+  else {
+    static_assert(detail::is_bulk_swappable_v<T>);
+    static_cast<void>(values);
+    static_cast<void>(count);
+  }
+}
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+template <typename T>
+void swap_byte_order(const std::span<T> values) noexcept
+{
+  swap_byte_order(values.data(), values.size());
+}
+
+template <typename T>
+void swap_big_endian(const std::span<T> values) noexcept
+{
+  swap_big_endian(values.data(), values.size());
+}
+
+template <typename T>
+void swap_little_endian(const std::span<T> values) noexcept
+{
+  swap_little_endian(values.data(), values.size());
+}
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
 }  // namespace cen
 
 #endif  // CENTURION_SYSTEM_ENDIAN_HPP_
@@ -31,8 +31,10 @@
 #include <cstddef>  // size_t
 #include <memory>   // unique_ptr
 
+#include "../common/primitives.hpp"
 #include "../detail/sdl_deleter.hpp"
 #include "../detail/stdlib.hpp"
+#include "../events/event_type.hpp"
 
 namespace cen {
 
@@ -98,6 +100,60 @@ class locale final {
   explicit locale(SDL_Locale* locales) noexcept : mLocales {locales} {}
 };
 
+/**
+ * Caches the preferred locales, which are only queried again after locale changed events.
+ *
+ * \see locale::get_preferred
+ */
+class locale_cache final {
+ public:
+  using generation_type = uint64;
+
+  /// Creates a cache and queries the preferred locales.
+  locale_cache() noexcept : mLocale {locale::get_preferred()}, mGeneration {1} {}
+
+  /**
+   * Updates the cache using the type of an event.
+   *
+   * \param type the type of the event that will be processed.
+   *
+   * \return `true` if the preferred locales were queried again; `false` otherwise.
+   */
+  auto update(const event_type type) noexcept -> bool
+  {
+    if (type == event_type::locale_changed) {
+      refresh();
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Queries the preferred locales.
+  void refresh() noexcept
+  {
+    mLocale = locale::get_preferred();
+    ++mGeneration;
+  }
+
+  /// Returns the cached locales, which are invalidated by the next refresh.
+  [[nodiscard]] auto get() const noexcept -> const locale& { return mLocale; }
+
+  [[nodiscard]] auto has_language(const char* language,
+                                  const char* country = nullptr) const noexcept -> bool
+  {
+    return mLocale.has_language(language, country);
+  }
+
+  /// Returns a counter that is incremented every time the cached locales are replaced.
+  [[nodiscard]] auto generation() const noexcept -> generation_type { return mGeneration; }
+
+ private:
+  locale mLocale;
+  generation_type mGeneration {};
+};
+
 #endif  // SDL_VERSION_ATLEAST(2, 0, 14)
 
 }  // namespace cen
@@ -0,0 +1,231 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_SYSTEM_PERIODIC_TIMER_HPP_
+#define CENTURION_SYSTEM_PERIODIC_TIMER_HPP_
+
+#include <SDL.h>
+
+#include <atomic>         // atomic, memory_order
+#include <cassert>        // assert
+#include <cstdint>        // uintptr_t
+#include <string>         // string, to_string
+#include <unordered_map>  // unordered_map
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/spin_lock.hpp"
+#include "../events/event_channel.hpp"
+#include "../features.hpp"
+#include "timer.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+using timer_id = SDL_TimerID;
+
+/// Emitted by a periodic timer each time it fires.
+struct timer_event final {
+  timer_id id {};     ///< The timer that fired.
+  uint64 count {};    ///< The amount of times the timer has fired, including this time.
+  uint64 counter {};  ///< The high-performance counter value when the timer fired.
+};
+
+class periodic_timer;
+
+namespace detail {
+
+/* Maps timer keys to live timers, so that callbacks never see destroyed timers */
+struct timer_registry final {
+  spin_lock lock;
+  std::unordered_map<std::uintptr_t, periodic_timer*> timers;
+  std::uintptr_t next {1};
+};
+
+[[nodiscard]] inline auto get_timer_registry() -> timer_registry&
+{
+  static timer_registry registry;
+  return registry;
+}
+
+}  // namespace detail
+
+/**
+ * A periodic timer, implemented on top of `SDL_AddTimer()`.
+ *
+ * SDL invokes timer callbacks on a dedicated timer thread, which makes it easy to introduce
+ * data races in user code. Instead, this timer only pushes a `timer_event` into an event
+ * channel each time it fires, which is then consumed on the main thread, usually with
+ * `event_dispatcher::poll(event_channel&)`.
+ *
+ * Destroying the timer is safe even if SDL is firing it concurrently, no events are emitted
+ * once the destructor has returned.
+ *
+ * \see event_channel
+ */
+class periodic_timer final {
+ public:
+  /**
+   * Creates and starts a periodic timer.
+   *
+   * \param channel the channel that receives the timer events, must outlive the timer.
+   * \param interval the time between each firing, must be greater than zero.
+   *
+   * \throws sdl_error if the timer cannot be created.
+   */
+  periodic_timer(event_channel<timer_event>& channel, const u32ms interval)
+      : mChannel {channel}
+      , mInterval {interval.count()}
+  {
+    assert(interval.count() > 0);
+
+    auto& registry = detail::get_timer_registry();
+    scoped_lock lock {registry.lock};
+
+    mKey = registry.next++;
+    mId = SDL_AddTimer(interval.count(), &periodic_timer::on_timer, to_param(mKey));
+
+    if (mId == 0) {
+      throw sdl_error {};
+    }
+
+    registry.timers[mKey] = this;
+  }
+
+  CENTURION_DISABLE_COPY(periodic_timer)
+  CENTURION_DISABLE_MOVE(periodic_timer)
+
+  ~periodic_timer() noexcept
+  {
+    SDL_RemoveTimer(mId);
+
+    /* Callbacks hold the lock while they access the timer, so it's safe to return after
+       the timer has been unregistered, even if the callback is running right now */
+    auto& registry = detail::get_timer_registry();
+    scoped_lock lock {registry.lock};
+    registry.timers.erase(mKey);
+  }
+
+  /**
+   * Changes the interval of the timer, which takes effect after the next firing.
+   *
+   * \param interval the new interval, must be greater than zero.
+   */
+  void set_interval(const u32ms interval) noexcept
+  {
+    assert(interval.count() > 0);
+    mInterval.store(interval.count(), std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto interval() const noexcept -> u32ms
+  {
+    return u32ms {mInterval.load(std::memory_order_relaxed)};
+  }
+
+  [[nodiscard]] auto id() const noexcept -> timer_id { return mId; }
+
+  /// Returns the amount of times the timer has fired.
+  [[nodiscard]] auto fired() const noexcept -> uint64
+  {
+    return mFired.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of events that were lost because the channel was full.
+  [[nodiscard]] auto dropped() const noexcept -> uint64
+  {
+    return mDropped.load(std::memory_order_relaxed);
+  }
+
+ private:
+  event_channel<timer_event>& mChannel;
+  std::atomic<uint32> mInterval {};
+  std::atomic<uint64> mFired {};
+  std::atomic<uint64> mDropped {};
+  std::uintptr_t mKey {};
+  timer_id mId {};
+
+  [[nodiscard]] static auto to_param(const std::uintptr_t key) noexcept -> void*
+  {
+    return reinterpret_cast<void*>(key);
+  }
+
+  static uint32 SDLCALL on_timer(uint32, void* param) noexcept
+  {
+    auto& registry = detail::get_timer_registry();
+    scoped_lock lock {registry.lock};
+
+    const auto it = registry.timers.find(reinterpret_cast<std::uintptr_t>(param));
+    if (it == registry.timers.end()) {
+      return 0;  // The timer is being destroyed
+    }
+
+    auto* self = it->second;
+    const auto count = self->mFired.fetch_add(1, std::memory_order_relaxed) + 1u;
+
+    if (!self->mChannel.push(timer_event {self->mId, count, now()})) {
+      self->mDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    return self->mInterval.load(std::memory_order_relaxed);
+  }
+};
+
+[[nodiscard]] inline auto to_string(const periodic_timer& timer) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("periodic_timer(id: {}, interval: {}ms)",
+                     timer.id(),
+                     timer.interval().count());
+#else
+  return "periodic_timer(id: " + std::to_string(timer.id()) +
+         ", interval: " + std::to_string(timer.interval().count()) + "ms)";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const periodic_timer& timer) -> std::ostream&
+{
+  return stream << to_string(timer);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_SYSTEM_PERIODIC_TIMER_HPP_
@@ -28,13 +28,18 @@
 #include <SDL.h>
 
 #include <cassert>      // assert
-#include <ostream>      // ostream
 #include <string>       // string
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 #include "../common/primitives.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 #ifdef __linux__
@@ -104,11 +109,15 @@ enum class platform_id {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const platform_id id) -> std::ostream&
 {
   return stream << to_string(id);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 [[nodiscard]] inline auto platform_name() -> maybe<std::string>
 {
   std::string name {SDL_GetPlatform()};
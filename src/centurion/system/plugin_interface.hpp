@@ -0,0 +1,258 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_SYSTEM_PLUGIN_INTERFACE_HPP_
+#define CENTURION_SYSTEM_PLUGIN_INTERFACE_HPP_
+
+#include <SDL.h>
+
+#include <atomic>   // atomic, memory_order_acquire, memory_order_release
+#include <cassert>  // assert
+#include <memory>   // unique_ptr, make_unique
+#include <string>   // string
+#include <utility>  // move
+#include <vector>   // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "shared_object.hpp"
+
+namespace cen {
+
+/**
+ * Resolves the functions of a function table from a shared object.
+ *
+ * An instance is passed to the `bind_symbols()` overload of a function table, which names
+ * the symbol of each function pointer. Missing required symbols are recorded, so that the
+ * table can be rejected as a whole.
+ *
+ * \see plugin_interface
+ */
+class symbol_binder final {
+ public:
+  explicit symbol_binder(const shared_object& object) noexcept : mObject {&object} {}
+
+  /**
+   * Resolves a function that the shared object must provide.
+   *
+   * \param name the name of the C function.
+   * \param function the function pointer that will be assigned, null if it wasn't found.
+   */
+  template <typename T>
+  void required(const char* name, T*& function) noexcept
+  {
+    function = mObject->load_function<T>(name);
+
+    if (!function && !mMissing) {
+      mMissing = name;
+    }
+  }
+
+  /// Resolves a function that the shared object may provide, i.e. it may remain null.
+  template <typename T>
+  void optional(const char* name, T*& function) noexcept
+  {
+    function = mObject->load_function<T>(name);
+  }
+
+  /// Returns the name of the first missing required function; a null pointer if none.
+  [[nodiscard]] auto missing() const noexcept -> const char* { return mMissing; }
+
+ private:
+  const shared_object* mObject {};
+  const char* mMissing {};
+};
+
+/**
+ * A function table that is resolved from a plugin once, when the plugin is loaded.
+ *
+ * This replaces a symbol lookup per call with an indirect call through a cached table. The
+ * table is a struct of function pointers with a `bind_symbols()` overload, found through
+ * argument-dependent lookup, that names the symbol of each pointer.
+ *
+ * \code{cpp}
+ * struct mod_api final {
+ *   int (*init)(int version) {};
+ *   void (*update)(float delta) {};
+ *   void (*on_event)(const SDL_Event* event) {};
+ * };
+ *
+ * void bind_symbols(cen::symbol_binder& binder, mod_api& api)
+ * {
+ *   binder.required("mod_init", api.init);
+ *   binder.required("mod_update", api.update);
+ *   binder.optional("mod_on_event", api.on_event);
+ * }
+ *
+ * cen::plugin_interface<mod_api> mod {"mods/example.so"};
+ * mod->update(delta);
+ * \endcode
+ *
+ * Plugins can be reloaded while the table is in use by other threads, since the current table
+ * is swapped atomically. A failed reload keeps the current table. Previous versions of the
+ * plugin stay loaded, so that threads that still execute their functions aren't affected,
+ * until `release_retired()` is called at a point where no previous function can be running,
+ * e.g. between two frames. Most platforms return the already loaded library if the same path
+ * is loaded again, so a rebuilt plugin should be copied to a new path before it's reloaded.
+ *
+ * The table accessors are thread-safe, the functions that load and unload plugins must be
+ * called by the owning thread.
+ *
+ * \tparam Table the function table type.
+ *
+ * \see shared_object
+ * \see symbol_binder
+ */
+template <typename Table>
+class plugin_interface final {
+ public:
+  using table_type = Table;
+
+  /**
+   * Loads a plugin and resolves its function table.
+   *
+   * \param path the path of the shared object.
+   *
+   * \throws sdl_error if the shared object cannot be loaded.
+   * \throws exception if a required function is missing.
+   */
+  explicit plugin_interface(std::string path)
+  {
+    if (!reload(std::move(path))) {
+      if (mLoadError) {
+        throw sdl_error {};
+      }
+      else {
+        throw exception {"Missing required plugin function!"};
+      }
+    }
+  }
+
+  CENTURION_DISABLE_COPY(plugin_interface)
+  CENTURION_DISABLE_MOVE(plugin_interface)
+
+  /**
+   * Loads the plugin again from its current path.
+   *
+   * \return `success` if the plugin was loaded and the table was swapped; `failure` otherwise.
+   *
+   * \see reload(std::string)
+   */
+  auto reload() -> result { return reload(mPath); }
+
+  /**
+   * Loads a new version of the plugin, and makes it the current version.
+   *
+   * The functions of the new version are resolved before the table is swapped, so the table
+   * is never partially updated.
+   *
+   * \param path the path of the new version, which becomes the path of the plugin.
+   *
+   * \return `success` if the plugin was loaded and the table was swapped; `failure` if the
+   * shared object couldn't be loaded or lacks a required function, which is reported by
+   * `missing_symbol()`.
+   */
+  auto reload(std::string path) -> result
+  {
+    mLoadError = false;
+    mMissing = nullptr;
+
+    std::unique_ptr<version> next;
+    try {
+      next = std::make_unique<version>(path.c_str());
+    }
+    catch (const sdl_error&) {
+      mLoadError = true;
+      return failure;
+    }
+
+    symbol_binder binder {next->object};
+    bind_symbols(binder, next->table);
+
+    if (binder.missing()) {
+      mMissing = binder.missing();
+      return failure;
+    }
+
+    mPath = std::move(path);
+    mVersions.push_back(std::move(next));
+    mCurrent.store(mVersions.back().get(), std::memory_order_release);
+    ++mLoads;
+
+    return success;
+  }
+
+  /**
+   * Unloads all previous versions of the plugin.
+   *
+   * \pre no thread may still execute, or later call, a function of a previous version.
+   */
+  void release_retired() noexcept
+  {
+    if (mVersions.size() > 1) {
+      mVersions.erase(mVersions.begin(), mVersions.end() - 1);
+    }
+  }
+
+  /// Returns the function table of the current version, may be called by any thread.
+  [[nodiscard]] auto table() const noexcept -> const table_type&
+  {
+    return mCurrent.load(std::memory_order_acquire)->table;
+  }
+
+  [[nodiscard]] auto operator->() const noexcept -> const table_type* { return &table(); }
+
+  /// Returns the path of the current version.
+  [[nodiscard]] auto path() const noexcept -> const std::string& { return mPath; }
+
+  /// Returns the function missing from the most recent failed load; a null pointer if none.
+  [[nodiscard]] auto missing_symbol() const noexcept -> const char* { return mMissing; }
+
+  /// Returns the amount of versions that were loaded successfully.
+  [[nodiscard]] auto loads() const noexcept -> uint64 { return mLoads; }
+
+  /// Returns the amount of previous versions that are still loaded.
+  [[nodiscard]] auto retired_count() const noexcept -> usize { return mVersions.size() - 1; }
+
+ private:
+  struct version final {
+    explicit version(const char* path) : object {path} {}
+
+    shared_object object;
+    table_type table {};
+  };
+
+  std::string mPath;
+  std::vector<std::unique_ptr<version>> mVersions;
+  std::atomic<const version*> mCurrent {};
+  const char* mMissing {};
+  uint64 mLoads {};
+  bool mLoadError {};
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_SYSTEM_PLUGIN_INTERFACE_HPP_
@@ -28,12 +28,17 @@
 #include <SDL.h>
 
 #include <optional>     // optional, nullopt
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 #include "../common/primitives.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class power_state {
@@ -99,6 +104,109 @@ enum class power_state {
   return query_battery() == power_state::charged;
 }
 
+/// A snapshot of the power status of the system.
+struct power_info final {
+  power_state state {power_state::unknown};
+  maybe<seconds<int>> seconds_left;  ///< The remaining battery time, if known.
+  maybe<int> percentage;             ///< The remaining battery charge, if known.
+};
+
+/// Returns the current power status, using a single query.
+[[nodiscard]] inline auto query_power_info() noexcept -> power_info
+{
+  int secondsLeft = -1;
+  int percentage = -1;
+
+  power_info info;
+  info.state = static_cast<power_state>(SDL_GetPowerInfo(&secondsLeft, &percentage));
+
+  if (secondsLeft != -1) {
+    info.seconds_left = seconds<int> {secondsLeft};
+  }
+
+  if (percentage != -1) {
+    info.percentage = percentage;
+  }
+
+  return info;
+}
+
+/**
+ * Caches the power status of the system, which is refreshed at a fixed interval.
+ *
+ * SDL doesn't emit events when the power status changes, and querying it may involve system
+ * calls, so the cache only queries the power status again once the refresh interval has
+ * passed. Call `poll()` once per frame.
+ */
+class power_cache final {
+ public:
+  inline constexpr static u32ms default_interval {5'000};
+
+  /// Creates a cache and queries the current power status.
+  explicit power_cache(const u32ms interval = default_interval) noexcept
+      : mInfo {query_power_info()}
+      , mInterval {interval}
+      , mLastRefresh {SDL_GetTicks()}
+  {
+  }
+
+  /**
+   * Queries the power status again, if the refresh interval has passed.
+   *
+   * \param now the current time.
+   *
+   * \return `true` if the power status changed; `false` otherwise.
+   */
+  auto poll(const u32ms now) noexcept -> bool
+  {
+    if (now - mLastRefresh >= mInterval) {
+      mLastRefresh = now;
+      return refresh();
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Queries the power status again, if the refresh interval has passed.
+  auto poll() noexcept -> bool { return poll(u32ms {SDL_GetTicks()}); }
+
+  /**
+   * Immediately queries the power status.
+   *
+   * \return `true` if the power status changed; `false` otherwise.
+   */
+  auto refresh() noexcept -> bool
+  {
+    const auto info = query_power_info();
+    const auto changed = info.state != mInfo.state ||
+                         info.seconds_left != mInfo.seconds_left ||
+                         info.percentage != mInfo.percentage;
+    mInfo = info;
+    return changed;
+  }
+
+  void set_interval(const u32ms interval) noexcept { mInterval = interval; }
+
+  [[nodiscard]] auto interval() const noexcept -> u32ms { return mInterval; }
+
+  [[nodiscard]] auto info() const noexcept -> const power_info& { return mInfo; }
+
+  [[nodiscard]] auto state() const noexcept -> power_state { return mInfo.state; }
+
+  [[nodiscard]] auto seconds_left() const noexcept -> maybe<seconds<int>>
+  {
+    return mInfo.seconds_left;
+  }
+
+  [[nodiscard]] auto percentage() const noexcept -> maybe<int> { return mInfo.percentage; }
+
+ private:
+  power_info mInfo;
+  u32ms mInterval;
+  u32ms mLastRefresh;
+};
+
 [[nodiscard]] constexpr auto to_string(const power_state state) -> std::string_view
 {
   switch (state) {
@@ -122,11 +230,15 @@ enum class power_state {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const power_state state) -> std::ostream&
 {
   return stream << to_string(state);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_SYSTEM_POWER_HPP_
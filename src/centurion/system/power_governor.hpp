@@ -0,0 +1,342 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_SYSTEM_POWER_GOVERNOR_HPP_
+#define CENTURION_SYSTEM_POWER_GOVERNOR_HPP_
+
+#include <SDL.h>
+
+#include <cmath>        // llround
+#include <string_view>  // string_view
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "../video/frame_pacer.hpp"
+#include "power.hpp"
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// Represents the performance levels selected by a power governor.
+enum class power_profile {
+  full,        ///< Plugged in, or the power status is unknown.
+  battery,     ///< Running on battery.
+  low_battery  ///< Running on battery, with little charge left.
+};
+
+[[nodiscard]] constexpr auto to_string(const power_profile profile) -> std::string_view
+{
+  switch (profile) {
+    case power_profile::full:
+      return "full";
+
+    case power_profile::battery:
+      return "battery";
+
+    case power_profile::low_battery:
+      return "low_battery";
+
+    default:
+      throw exception {"Did not recognize power profile!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const power_profile profile) -> std::ostream&
+{
+  return stream << to_string(profile);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/// The configuration of a power governor.
+struct power_governor_options final {
+  double battery_rate {30};           ///< The frame rate cap on battery, in Hz.
+  double low_battery_rate {20};       ///< The frame rate cap on low battery, in Hz.
+  double battery_workers {0.5};       ///< The fraction of pool workers used on battery.
+  double low_battery_workers {0.25};  ///< The fraction of pool workers used on low battery.
+  int low_battery_percentage {20};    ///< The charge at or below which the battery is low.
+  u32ms interval {power_cache::default_interval};  ///< The power status refresh interval.
+};
+
+/**
+ * Scales performance down while the system runs on battery, and back up on AC power.
+ *
+ * The governor polls the power status and selects a power profile. Once the profile
+ * changes, the governor lowers or restores the frame rate cap of an attached frame pacer and
+ * the amount of active workers of an attached thread pool, and pushes an event with the
+ * type returned by `event_type()`. The `code` member of the user event holds the new
+ * profile.
+ *
+ * Rendering paths are up to the application, which should prefer cheaper paths such as
+ * cached layers and dirty rectangles while `prefers_cached_rendering()` returns `true`.
+ *
+ * The attached pacer and pool must outlive the governor, or be detached before they are
+ * destroyed. Call `update()` once per frame.
+ */
+class power_governor final {
+ public:
+  /// Creates a governor and queries the current power status.
+  explicit power_governor(const power_governor_options& options = {}) noexcept
+      : mOptions {options}
+      , mCache {options.interval}
+      , mDetected {classify(mCache.info(), options)}
+      , mProfile {mDetected}
+  {
+  }
+
+  /**
+   * Lets the governor control the frame rate cap of a frame pacer.
+   *
+   * \details The current refresh rate of the pacer is used as the full frame rate, and the
+   *          current profile is applied immediately.
+   *
+   * \param pacer the frame pacer that will be controlled.
+   */
+  void attach(frame_pacer& pacer)
+  {
+    mPacer = &pacer;
+    mFullRate = pacer.refresh_rate();
+    apply_rate();
+  }
+
+  /**
+   * Lets the governor control the amount of active workers of a thread pool.
+   *
+   * \param pool the thread pool that will be controlled.
+   */
+  void attach(thread_pool& pool) noexcept
+  {
+    mPool = &pool;
+    apply_workers();
+  }
+
+  /// Restores the full performance of any attached pacer and pool, and detaches them.
+  void detach()
+  {
+    if (mPacer) {
+      mPacer->set_refresh_rate(mFullRate);
+      mPacer = nullptr;
+    }
+
+    if (mPool) {
+      mPool->set_active_workers(mPool->size());
+      mPool = nullptr;
+    }
+  }
+
+  /**
+   * Polls the power status, and applies a new profile if the status calls for one.
+   *
+   * \param now the current time.
+   *
+   * \return `true` if the profile changed; `false` otherwise.
+   */
+  auto update(const u32ms now) -> bool
+  {
+    if (!mCache.poll(now)) {
+      return false;
+    }
+
+    const auto detected = classify(mCache.info(), mOptions);
+    if (detected == mDetected) {
+      return false;
+    }
+
+    mDetected = detected;
+    return set_profile(detected);
+  }
+
+  /// Polls the power status, and applies a new profile if the status calls for one.
+  auto update() -> bool { return update(u32ms {SDL_GetTicks()}); }
+
+  /**
+   * Applies a profile, regardless of the power status.
+   *
+   * \details This can be used for a user-selected power saving mode. The profile is kept
+   *          until the power status changes.
+   *
+   * \param profile the profile that will be applied.
+   *
+   * \return `true` if the profile changed; `false` otherwise.
+   */
+  auto set_profile(const power_profile profile) -> bool
+  {
+    if (profile == mProfile) {
+      return false;
+    }
+
+    mProfile = profile;
+    apply_rate();
+    apply_workers();
+    push_event();
+
+    return true;
+  }
+
+  /**
+   * Selects the profile that suits a power status.
+   *
+   * \param info the power status.
+   * \param options the governor configuration.
+   *
+   * \return the suitable profile.
+   */
+  [[nodiscard]] static auto classify(const power_info& info,
+                                     const power_governor_options& options) noexcept
+      -> power_profile
+  {
+    if (info.state != power_state::on_battery) {
+      return power_profile::full;
+    }
+    else if (info.percentage && *info.percentage <= options.low_battery_percentage) {
+      return power_profile::low_battery;
+    }
+    else {
+      return power_profile::battery;
+    }
+  }
+
+  /**
+   * Returns the event type that is used to report profile changes.
+   *
+   * \details The type is registered with `SDL_RegisterEvents()` the first time that this
+   *          function is called.
+   *
+   * \return the event type; `static_cast<uint32>(-1)` if it couldn't be registered.
+   */
+  [[nodiscard]] static auto event_type() noexcept -> uint32
+  {
+    static const uint32 type = SDL_RegisterEvents(1);
+    return type;
+  }
+
+  /// Returns the current profile.
+  [[nodiscard]] auto profile() const noexcept -> power_profile { return mProfile; }
+
+  /// Indicates whether renderers should prefer cached layers and dirty rectangles.
+  [[nodiscard]] auto prefers_cached_rendering() const noexcept -> bool
+  {
+    return mProfile != power_profile::full;
+  }
+
+  /// Returns the frame rate cap of the current profile, in Hz.
+  [[nodiscard]] auto frame_rate() const noexcept -> double
+  {
+    switch (mProfile) {
+      case power_profile::battery:
+        return (detail::min)(mFullRate, mOptions.battery_rate);
+
+      case power_profile::low_battery:
+        return (detail::min)(mFullRate, mOptions.low_battery_rate);
+
+      default:
+        return mFullRate;
+    }
+  }
+
+  /**
+   * Returns the amount of active workers of the current profile.
+   *
+   * \param workers the total amount of workers.
+   *
+   * \return the amount of workers that should be active, at least one.
+   */
+  [[nodiscard]] auto worker_count(const usize workers) const noexcept -> usize
+  {
+    double fraction = 1;
+    if (mProfile == power_profile::battery) {
+      fraction = mOptions.battery_workers;
+    }
+    else if (mProfile == power_profile::low_battery) {
+      fraction = mOptions.low_battery_workers;
+    }
+
+    fraction = (detail::clamp)(fraction, 0.0, 1.0);
+
+    const auto scaled = std::llround(static_cast<double>(workers) * fraction);
+    const auto count = static_cast<usize>(scaled);
+    return (detail::clamp)(count, usize {1}, (detail::max)(workers, usize {1}));
+  }
+
+  /// Returns the latest power status.
+  [[nodiscard]] auto info() const noexcept -> const power_info& { return mCache.info(); }
+
+  [[nodiscard]] auto options() const noexcept -> const power_governor_options&
+  {
+    return mOptions;
+  }
+
+ private:
+  power_governor_options mOptions;
+  power_cache mCache;
+  power_profile mDetected;  ///< The profile selected by the latest power status.
+  power_profile mProfile;   ///< The applied profile.
+  frame_pacer* mPacer {};
+  thread_pool* mPool {};
+  double mFullRate {60};
+
+  void apply_rate()
+  {
+    if (mPacer) {
+      const auto rate = frame_rate();
+      if (rate != mPacer->refresh_rate()) {
+        mPacer->set_refresh_rate(rate);
+      }
+    }
+  }
+
+  void apply_workers() noexcept
+  {
+    if (mPool) {
+      mPool->set_active_workers(worker_count(mPool->size()));
+    }
+  }
+
+  void push_event() noexcept
+  {
+    const auto type = event_type();
+    if (type == static_cast<uint32>(-1)) {
+      return;
+    }
+
+    SDL_Event event {};
+    event.user.type = type;
+    event.user.code = static_cast<int32>(mProfile);
+
+    SDL_PushEvent(&event);
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_SYSTEM_POWER_GOVERNOR_HPP_
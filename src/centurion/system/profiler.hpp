@@ -0,0 +1,411 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_SYSTEM_PROFILER_HPP_
+#define CENTURION_SYSTEM_PROFILER_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>  // sort, any_of
+#include <atomic>     // atomic, memory_order_relaxed, memory_order_acquire, ...
+#include <ios>        // ios_base
+#include <memory>     // unique_ptr, make_unique
+#include <vector>     // vector
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/spin_lock.hpp"
+#include "../concurrency/thread_local_storage.hpp"
+#include "timer.hpp"
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// Represents the different kinds of recorded profiling events.
+enum class profile_event_kind : uint8 {
+  zone,   ///< A named scope with a duration.
+  frame,  ///< An instantaneous frame marker.
+  gpu     ///< A named GPU pass, converted to high-performance counter timestamps.
+};
+
+/// A recorded profiling event, with timestamps from the high-performance counter.
+struct profile_event final {
+  const char* name {};  ///< The name of the event, always a string literal.
+  uint64 begin {};      ///< The counter value when the event started.
+  uint64 end {};        ///< The counter value when the event ended.
+  uint64 thread {};     ///< The identifier of the thread that recorded the event.
+  profile_event_kind kind {profile_event_kind::zone};
+};
+
+namespace detail {
+
+/* Must be a power of two, events are dropped when the buffer of a thread is full */
+inline constexpr usize profile_buffer_capacity = 8'192;
+
+/* A bounded single-producer single-consumer queue, owned by each profiled thread */
+struct profile_buffer final {
+  std::unique_ptr<profile_event[]> events {new profile_event[profile_buffer_capacity]};
+  std::atomic<usize> head {};  ///< Only written by the owning thread.
+  std::atomic<usize> tail {};  ///< Only written while collecting events.
+  std::atomic<uint64> dropped {};
+  uint64 thread {};
+
+  void push(const profile_event& event) noexcept
+  {
+    const auto h = head.load(std::memory_order_relaxed);
+    const auto t = tail.load(std::memory_order_acquire);
+
+    if (h - t == profile_buffer_capacity) {
+      dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    events[h & (profile_buffer_capacity - 1)] = event;
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  void drain(std::vector<profile_event>& out)
+  {
+    auto t = tail.load(std::memory_order_relaxed);
+    const auto h = head.load(std::memory_order_acquire);
+
+    for (; t != h; ++t) {
+      auto& event = out.emplace_back(events[t & (profile_buffer_capacity - 1)]);
+      event.thread = thread;
+    }
+
+    tail.store(h, std::memory_order_release);
+  }
+};
+
+struct profiler_registry final {
+  spin_lock lock;  ///< Guards the buffer list, never held while recording events.
+  std::vector<std::unique_ptr<profile_buffer>> buffers;
+  std::atomic<bool> enabled {};
+};
+
+[[nodiscard]] inline auto get_profiler_registry() noexcept -> profiler_registry&
+{
+  static profiler_registry registry;
+  return registry;
+}
+
+/* Returns the buffer of the calling thread, which is registered on first use. Buffers are
+   never released, so that events recorded by threads that have exited can be collected. */
+[[nodiscard]] inline auto local_profile_buffer() noexcept -> profile_buffer*
+{
+  try {
+    static thread_local_storage<profile_buffer*> buffers;
+
+    auto* buffer = buffers.get();
+    if (!buffer) {
+      auto owned = std::make_unique<profile_buffer>();
+      owned->thread = static_cast<uint64>(SDL_ThreadID());
+
+      auto& registry = get_profiler_registry();
+      scoped_lock lock {registry.lock};
+      registry.buffers.reserve(registry.buffers.size() + 1);
+
+      if (!buffers.set(owned.get())) {
+        return nullptr;
+      }
+
+      buffer = owned.get();
+      registry.buffers.push_back(std::move(owned));
+    }
+
+    return buffer;
+  }
+  catch (...) {
+    return nullptr; /* The events of this thread are dropped */
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline void write_trace_string(std::ostream& stream, const char* str)
+{
+  stream << '"';
+
+  for (; str && *str != '\0'; ++str) {
+    const auto ch = *str;
+    if (ch == '"' || ch == '\\') {
+      stream << '\\' << ch;
+    }
+    else if (static_cast<unsigned char>(ch) >= 0x20) {
+      stream << ch;
+    }
+  }
+
+  stream << '"';
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace detail
+
+/**
+ * Starts recording profiling zones and frame markers.
+ *
+ * Profiling is cheap but not free, so zones placed with `CENTURION_PROFILE_SCOPE` are only
+ * compiled when `CENTURION_ENABLE_PROFILING` is defined. Even then, nothing is recorded until
+ * this function is called.
+ *
+ * \see collect_profile()
+ */
+inline void enable_profiling() noexcept
+{
+  detail::get_profiler_registry().enabled.store(true, std::memory_order_relaxed);
+}
+
+/// Stops recording profiling events, events that have already been recorded are kept.
+inline void disable_profiling() noexcept
+{
+  detail::get_profiler_registry().enabled.store(false, std::memory_order_relaxed);
+}
+
+/// Indicates whether profiling events are recorded.
+[[nodiscard]] inline auto is_profiling() noexcept -> bool
+{
+  return detail::get_profiler_registry().enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Records the time spent in a scope.
+ *
+ * Each thread records events into its own lock-free buffer, so zones may be used from any
+ * thread, including the audio thread. Prefer the `CENTURION_PROFILE_SCOPE` macro, which
+ * compiles to nothing unless profiling is enabled at build time.
+ *
+ * \see CENTURION_PROFILE_SCOPE
+ */
+class profile_zone final {
+ public:
+  /**
+   * Starts a zone, if profiling is enabled.
+   *
+   * \param name the name of the zone, must be a string literal or otherwise outlive the
+   *             recorded events.
+   */
+  explicit profile_zone(const char* name) noexcept : mName {name}
+  {
+    if (is_profiling()) {
+      mBuffer = detail::local_profile_buffer();
+      mBegin = now();
+    }
+  }
+
+  CENTURION_DISABLE_COPY(profile_zone)
+  CENTURION_DISABLE_MOVE(profile_zone)
+
+  ~profile_zone() noexcept
+  {
+    if (mBuffer) {
+      mBuffer->push({mName, mBegin, now(), 0, profile_event_kind::zone});
+    }
+  }
+
+ private:
+  const char* mName {};
+  detail::profile_buffer* mBuffer {};
+  uint64 mBegin {};
+};
+
+/**
+ * Records a frame marker, if profiling is enabled.
+ *
+ * Frame markers are recorded by `renderer::present()` when profiling is enabled at build
+ * time, so this is only needed for applications that present frames in other ways.
+ *
+ * \param name the name of the marker, must be a string literal.
+ */
+inline void mark_profile_frame(const char* name = "frame") noexcept
+{
+  if (is_profiling()) {
+    if (auto* buffer = detail::local_profile_buffer()) {
+      const auto timestamp = now();
+      buffer->push({name, timestamp, timestamp, 0, profile_event_kind::frame});
+    }
+  }
+}
+
+/**
+ * Records a GPU pass, if profiling is enabled.
+ *
+ * GPU passes are usually recorded by a GPU timer, such as `gl_pass_timer`, once their results
+ * are available, which is typically a few frames after the pass was executed.
+ *
+ * \param name the name of the pass, must be a string literal.
+ * \param begin the start of the pass, converted to a high-performance counter value.
+ * \param end the end of the pass, converted to a high-performance counter value.
+ */
+inline void record_gpu_profile_zone(const char* name,
+                                    const uint64 begin,
+                                    const uint64 end) noexcept
+{
+  if (is_profiling()) {
+    if (auto* buffer = detail::local_profile_buffer()) {
+      buffer->push({name, begin, end, 0, profile_event_kind::gpu});
+    }
+  }
+}
+
+/**
+ * Removes all recorded events from the thread buffers and returns them.
+ *
+ * This should be called regularly, e.g. once per frame or once per second, since events are
+ * dropped when the buffer of a thread is full. Only one thread may collect events at a time.
+ *
+ * \return the recorded events, sorted by their start time.
+ */
+[[nodiscard]] inline auto collect_profile() -> std::vector<profile_event>
+{
+  auto& registry = detail::get_profiler_registry();
+  std::vector<profile_event> events;
+
+  {
+    scoped_lock lock {registry.lock};
+    for (const auto& buffer : registry.buffers) {
+      buffer->drain(events);
+    }
+  }
+
+  std::sort(events.begin(), events.end(), [](const profile_event& a, const profile_event& b) {
+    return a.begin < b.begin;
+  });
+
+  return events;
+}
+
+/// Returns the total amount of events that were dropped due to full thread buffers.
+[[nodiscard]] inline auto dropped_profile_events() -> uint64
+{
+  auto& registry = detail::get_profiler_registry();
+  scoped_lock lock {registry.lock};
+
+  uint64 dropped = 0;
+  for (const auto& buffer : registry.buffers) {
+    dropped += buffer->dropped.load(std::memory_order_relaxed);
+  }
+
+  return dropped;
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+/**
+ * Writes profiling events in the Chrome trace event format.
+ *
+ * The output can be inspected with `chrome://tracing` or the Perfetto UI. Zones are written
+ * as complete events and frame markers as global instant events, with timestamps in
+ * microseconds relative to the first event. GPU passes are written as complete events of a
+ * separate "GPU" process, so that they are shown on their own track.
+ *
+ * \param stream the stream that the JSON document will be written to.
+ * \param events the events to write, as obtained from `collect_profile()`.
+ */
+inline void write_chrome_trace(std::ostream& stream, const std::vector<profile_event>& events)
+{
+  const auto origin = events.empty() ? uint64 {0} : events.front().begin;
+  const auto ticksPerMicro = static_cast<double>(frequency()) / 1'000'000.0;
+
+  const auto flags = stream.flags();
+  const auto precision = stream.precision();
+  stream.setf(std::ios_base::fixed, std::ios_base::floatfield);
+  stream.precision(3);
+
+  stream << "{\"traceEvents\":[";
+
+  const auto hasGpuEvents =
+      std::any_of(events.begin(), events.end(), [](const profile_event& event) {
+        return event.kind == profile_event_kind::gpu;
+      });
+
+  bool first = true;
+  if (hasGpuEvents) {
+    stream << "\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":2,"
+           << "\"args\":{\"name\":\"GPU\"}}";
+    first = false;
+  }
+
+  for (const auto& event : events) {
+    stream << (first ? "\n" : ",\n") << "{\"name\":";
+    detail::write_trace_string(stream, event.name);
+
+    const auto begin = static_cast<double>(event.begin - origin) / ticksPerMicro;
+
+    if (event.kind == profile_event_kind::frame) {
+      stream << ",\"ph\":\"i\",\"s\":\"g\"";
+    }
+    else {
+      const auto duration = static_cast<double>(event.end - event.begin) / ticksPerMicro;
+      stream << ",\"ph\":\"X\",\"dur\":" << duration;
+    }
+
+    if (event.kind == profile_event_kind::gpu) {
+      stream << ",\"ts\":" << begin << ",\"pid\":2,\"tid\":0}";
+    }
+    else {
+      stream << ",\"ts\":" << begin << ",\"pid\":1,\"tid\":" << event.thread << '}';
+    }
+
+    first = false;
+  }
+
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#define CENTURION_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CENTURION_PROFILE_CONCAT(a, b) CENTURION_PROFILE_CONCAT_IMPL(a, b)
+
+#ifdef CENTURION_ENABLE_PROFILING
+
+/// Records the time spent in the enclosing scope, the name must be a string literal.
+#define CENTURION_PROFILE_SCOPE(name) \
+  const cen::profile_zone CENTURION_PROFILE_CONCAT(cenProfileZone, __LINE__) { name }
+
+/// Records a frame marker.
+#define CENTURION_PROFILE_FRAME() cen::mark_profile_frame()
+
+#else
+
+#define CENTURION_PROFILE_SCOPE(name)
+#define CENTURION_PROFILE_FRAME()
+
+#endif  // CENTURION_ENABLE_PROFILING
+
+#endif  // CENTURION_SYSTEM_PROFILER_HPP_
@@ -27,6 +27,8 @@
 
 #include <SDL.h>
 
+#include <chrono>  // nanoseconds, duration_cast
+
 #include "../common/primitives.hpp"
 
 namespace cen {
@@ -64,6 +66,132 @@ namespace cen {
   return u32ms {SDL_GetTicks()};
 }
 
+/**
+ * A stopwatch based on the high-performance counter.
+ *
+ * The stopwatch accumulates the time it has been running, so it can be stopped and resumed,
+ * e.g. to exclude loading screens from a measurement. Laps measure the running time since the
+ * previous lap, and splits peek at the current lap without starting a new one.
+ *
+ * \see now()
+ * \see frequency()
+ */
+class stopwatch final {
+ public:
+  using duration = std::chrono::nanoseconds;
+
+  /**
+   * Creates a stopwatch.
+   *
+   * \param started `true` if the stopwatch should be started immediately; `false` otherwise.
+   */
+  explicit stopwatch(const bool started = true) noexcept : mFrequency {frequency()}
+  {
+    if (started) {
+      start();
+    }
+  }
+
+  /// Starts or resumes the stopwatch, has no effect if it is already running.
+  void start() noexcept
+  {
+    if (!mRunning) {
+      mStart = now();
+      mRunning = true;
+    }
+  }
+
+  /// Pauses the stopwatch, the elapsed time is kept until the stopwatch is reset.
+  void stop() noexcept
+  {
+    if (mRunning) {
+      mAccumulated += now() - mStart;
+      mRunning = false;
+    }
+  }
+
+  /// Stops the stopwatch and clears the elapsed time and the current lap.
+  void reset() noexcept
+  {
+    mAccumulated = 0;
+    mLapStart = 0;
+    mRunning = false;
+  }
+
+  /**
+   * Resets and starts the stopwatch.
+   *
+   * \return the total elapsed time before the restart.
+   */
+  auto restart() noexcept -> duration
+  {
+    const auto ticks = elapsed_ticks();
+
+    reset();
+    start();
+
+    return to_duration(ticks);
+  }
+
+  /**
+   * Ends the current lap and starts a new one.
+   *
+   * \return the running time since the previous lap, or since the stopwatch was reset.
+   */
+  auto lap() noexcept -> duration
+  {
+    const auto ticks = elapsed_ticks();
+    const auto lap = ticks - mLapStart;
+
+    mLapStart = ticks;
+
+    return to_duration(lap);
+  }
+
+  /// Returns the running time of the current lap, without starting a new lap.
+  [[nodiscard]] auto split() const noexcept -> duration
+  {
+    return to_duration(elapsed_ticks() - mLapStart);
+  }
+
+  /**
+   * Returns the total running time of the stopwatch.
+   *
+   * \tparam Duration the `std::chrono` duration type that will be returned.
+   *
+   * \return the accumulated running time since the stopwatch was reset.
+   */
+  template <typename Duration = duration>
+  [[nodiscard]] auto elapsed() const noexcept(noexcept(Duration {})) -> Duration
+  {
+    return std::chrono::duration_cast<Duration>(to_duration(elapsed_ticks()));
+  }
+
+  /// Returns the total running time of the stopwatch, in high-performance counter ticks.
+  [[nodiscard]] auto elapsed_ticks() const noexcept -> uint64
+  {
+    return mRunning ? mAccumulated + (now() - mStart) : mAccumulated;
+  }
+
+  [[nodiscard]] auto is_running() const noexcept -> bool { return mRunning; }
+
+ private:
+  uint64 mFrequency {};
+  uint64 mStart {};        ///< Counter value when the stopwatch was last started.
+  uint64 mAccumulated {};  ///< Ticks accumulated before the last start.
+  uint64 mLapStart {};     ///< Elapsed ticks at the start of the current lap.
+  bool mRunning {};
+
+  [[nodiscard]] auto to_duration(const uint64 ticks) const noexcept -> duration
+  {
+    /* Split the conversion to avoid overflowing for long measurements */
+    constexpr uint64 nanosPerSecond = 1'000'000'000;
+    const auto whole = (ticks / mFrequency) * nanosPerSecond;
+    const auto rest = ((ticks % mFrequency) * nanosPerSecond) / mFrequency;
+    return duration {static_cast<duration::rep>(whole + rest)};
+  }
+};
+
 }  // namespace cen
 
 #endif  // CENTURION_SYSTEM_TIMER_HPP_
@@ -0,0 +1,520 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+module;
+
+#include "centurion/video.hpp"
+
+export module centurion:video;
+
+export namespace cen {
+
+#ifndef CENTURION_NO_SDL_IMAGE
+#if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+using cen::animated_texture;
+
+using cen::animation;
+#endif  // SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+#endif  // CENTURION_NO_SDL_IMAGE
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+using cen::animation_clip;
+using cen::animation_system;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+using cen::atlas_region;
+
+using cen::blend_mode;
+using cen::blend_factor;
+using cen::blend_op;
+using cen::blend_task;
+using cen::compose_blend_mode;
+using cen::alpha_mode;
+using cen::premultiplied_blend_mode;
+using cen::to_string;
+
+#ifndef CENTURION_NO_IOSTREAM
+
+using cen::operator<<;
+
+#endif  // CENTURION_NO_IOSTREAM
+
+using cen::camera;
+
+using cen::collision_mask;
+
+using cen::hsv;
+using cen::hsl;
+using cen::color;
+using cen::blend;
+using cen::blend_int;
+using cen::blend_n;
+using cen::format_to;
+using cen::operator==;
+using cen::operator!=;
+
+using cen::color_lut;
+using cen::color_cube;
+using cen::apply_lut;
+
+using cen::damage_tracker;
+
+using cen::orientation;
+using cen::dpi_info;
+using cen::display_mode;
+using cen::set_screen_saver_enabled;
+using cen::is_screen_saver_enabled;
+using cen::display_count;
+using cen::display_name;
+using cen::display_orientation;
+using cen::display_dpi;
+using cen::display_bounds;
+using cen::display_usable_bounds;
+
+#if SDL_VERSION_ATLEAST(2, 24, 0)
+using cen::display_with;
+#endif  // SDL_VERSION_ATLEAST(2, 24, 0)
+
+using cen::display_info;
+using cen::display_registry;
+
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+using cen::flash_op;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 16)
+
+using cen::frame_capture;
+
+using cen::pacing_mode;
+using cen::frame_pacer_options;
+using cen::frame_pacer;
+
+using cen::frame_metric;
+using cen::frame_metric_count;
+using cen::frame_metric_summary;
+using cen::frame_stats;
+
+using cen::game_loop_options;
+using cen::game_loop;
+
+#ifndef CENTURION_NO_OPENGL
+using cen::gl_pass_result;
+using cen::gl_pass_timer;
+using cen::gl_pass_scope;
+
+using cen::gl_functions;
+using cen::gl_state_cache;
+
+using cen::gl_texture_streamer;
+
+using cen::gl_upload_id;
+using cen::gl_upload_context;
+#endif  // CENTURION_NO_OPENGL
+
+#ifndef CENTURION_NO_SDL_IMAGE
+using cen::image_loader;
+#endif  // CENTURION_NO_SDL_IMAGE
+
+using cen::message_box_type;
+using cen::message_box_button_order;
+using cen::message_box_color_type;
+using cen::message_box_color_scheme;
+using cen::message_box;
+
+using cen::mipmapped_texture;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+using cen::nine_slice_fill;
+using cen::nine_slice_insets;
+using cen::nine_slice;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+#ifndef CENTURION_NO_OPENGL
+using cen::gl_attribute;
+using cen::gl_swap_interval;
+using cen::gl_library;
+using cen::basic_gl_context;
+using cen::gl_context;
+using cen::gl_context_handle;
+#endif  // CENTURION_NO_OPENGL
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+using cen::particle;
+using cen::particle_system;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+using cen::upscale_mode;
+using cen::upscale_layout;
+using cen::make_upscale_layout;
+using cen::pixel_pipeline;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
+
+using cen::pixel_traits;
+using cen::pixel_row;
+using cen::pixel_span;
+using cen::parallel_for_rows;
+
+using cen::pixel_format;
+using cen::palette;
+using cen::basic_pixel_format_info;
+using cen::pixel_format_info;
+using cen::pixel_format_info_handle;
+
+using cen::dither_mode;
+using cen::quantize_options;
+using cen::make_palette;
+using cen::quantize;
+using cen::remap;
+
+using cen::render_command_list;
+
+using cen::render_counters;
+
+using cen::render_layer;
+
+using cen::render_frame;
+using cen::render_thread;
+
+using cen::render_view;
+using cen::make_render_view;
+using cen::split_screen;
+
+using cen::renderer_flip;
+using cen::renderer_scale;
+using cen::basic_renderer;
+using cen::renderer;
+using cen::renderer_handle;
+
+using cen::render_driver_count;
+using cen::video_driver_count;
+using cen::renderer_info;
+using cen::get_info;
+
+using cen::render_driver_score;
+using cen::renderer_selector_cfg;
+using cen::renderer_selector;
+
+using cen::resize_coordinator;
+
+using cen::pooled;
+using cen::texture_pool;
+using cen::render_target_pool;
+using cen::scoped_target;
+using cen::surface_pool;
+using cen::pooled_texture;
+using cen::pooled_surface;
+using cen::pooled_target;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+using cen::line_join;
+using cen::line_cap;
+using cen::stroke_style;
+using cen::shape_builder;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+using cen::pixel_checksum;
+using cen::software_canvas;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+using cen::sprite_batch;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+using cen::basic_surface;
+using cen::surface;
+using cen::surface_handle;
+
+using cen::surface_canvas;
+
+using cen::blit;
+using cen::blit_scaled;
+using cen::parallel_blit;
+using cen::parallel_blit_scaled;
+using cen::downscale;
+using cen::make_mip_chain;
+using cen::select_mip_level;
+
+using cen::surface_presenter;
+
+using cen::texture_access;
+
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+using cen::scale_mode;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
+
+using cen::basic_texture;
+using cen::texture;
+using cen::texture_handle;
+using cen::texture_lock;
+
+using cen::texture_atlas;
+
+#ifndef CENTURION_NO_SDL_IMAGE
+using cen::texture_disk_cache;
+#endif  // CENTURION_NO_SDL_IMAGE
+
+using cen::estimate_texture_bytes;
+using cen::texture_memory_entry;
+using cen::texture_memory_tag;
+using cen::texture_memory_registry;
+
+using cen::texture_restorer;
+
+#ifndef CENTURION_NO_SDL_IMAGE
+using cen::texture_streamer;
+#endif  // CENTURION_NO_SDL_IMAGE
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+using cen::chunk_cache;
+using cen::tilemap_layer;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+using cen::unicode_string;
+using cen::unicode_string_view;
+
+using cen::video_frame_format;
+using cen::to_pixel_format;
+using cen::video_frame;
+using cen::video_stream;
+
+#ifndef CENTURION_NO_SDL_MIXER
+#if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+using cen::music_clock;
+#endif  // SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+#endif  // CENTURION_NO_SDL_MIXER
+
+#if __has_include(<vulkan/vulkan.h>)
+#ifndef CENTURION_NO_VULKAN
+using cen::vk_present_mode;
+using cen::vk_swapchain_config;
+using cen::vk_swapchain_functions;
+using cen::vk_frame;
+using cen::vk_swapchain;
+#endif  // CENTURION_NO_VULKAN
+#endif  // __has_include(<vulkan/vulkan.h>)
+
+#ifndef CENTURION_NO_VULKAN
+using cen::vk_library;
+#endif  // CENTURION_NO_VULKAN
+
+using cen::basic_window;
+using cen::window;
+using cen::window_handle;
+using cen::get_grabbed_window;
+using cen::get_mouse_focus_window;
+using cen::get_keyboard_focus_window;
+using cen::get_window;
+
+}  // namespace cen
+
+export namespace cen::colors {
+
+using cen::colors::transparent;
+using cen::colors::white;
+using cen::colors::black;
+using cen::colors::alice_blue;
+using cen::colors::antique_white;
+using cen::colors::aqua;
+using cen::colors::aquamarine;
+using cen::colors::azure;
+using cen::colors::beige;
+using cen::colors::bisque;
+using cen::colors::blanched_almond;
+using cen::colors::blue;
+using cen::colors::blue_violet;
+using cen::colors::brown;
+using cen::colors::burly_wood;
+using cen::colors::cadet_blue;
+using cen::colors::chartreuse;
+using cen::colors::chocolate;
+using cen::colors::coral;
+using cen::colors::cornflower_blue;
+using cen::colors::cornsilk;
+using cen::colors::crimson;
+using cen::colors::cyan;
+using cen::colors::deep_pink;
+using cen::colors::deep_sky_blue;
+using cen::colors::dim_gray;
+using cen::colors::dim_grey;
+using cen::colors::dodger_blue;
+using cen::colors::fire_brick;
+using cen::colors::floral_white;
+using cen::colors::forest_green;
+using cen::colors::fuchsia;
+using cen::colors::gainsboro;
+using cen::colors::ghost_white;
+using cen::colors::gold;
+using cen::colors::golden_rod;
+using cen::colors::gray;
+using cen::colors::grey;
+using cen::colors::green;
+using cen::colors::green_yellow;
+using cen::colors::honey_dew;
+using cen::colors::hot_pink;
+using cen::colors::indian_red;
+using cen::colors::indigo;
+using cen::colors::ivory;
+using cen::colors::khaki;
+using cen::colors::lavender;
+using cen::colors::lavender_blush;
+using cen::colors::lawn_green;
+using cen::colors::lemon_chiffon;
+using cen::colors::lime;
+using cen::colors::lime_green;
+using cen::colors::linen;
+using cen::colors::magenta;
+using cen::colors::maroon;
+using cen::colors::midnight_blue;
+using cen::colors::mint_cream;
+using cen::colors::misty_rose;
+using cen::colors::moccasin;
+using cen::colors::navajo_white;
+using cen::colors::navy;
+using cen::colors::old_lace;
+using cen::colors::olive;
+using cen::colors::olive_drab;
+using cen::colors::orange;
+using cen::colors::orange_red;
+using cen::colors::orchid;
+using cen::colors::pale_golden_rod;
+using cen::colors::pale_green;
+using cen::colors::pale_turquoise;
+using cen::colors::pale_violet_red;
+using cen::colors::papaya_whip;
+using cen::colors::peach_puff;
+using cen::colors::peru;
+using cen::colors::pink;
+using cen::colors::plum;
+using cen::colors::powder_blue;
+using cen::colors::purple;
+using cen::colors::rebecca_purple;
+using cen::colors::red;
+using cen::colors::rosy_brown;
+using cen::colors::royal_blue;
+using cen::colors::saddle_brown;
+using cen::colors::salmon;
+using cen::colors::sandy_brown;
+using cen::colors::sea_green;
+using cen::colors::sea_shell;
+using cen::colors::sienna;
+using cen::colors::silver;
+using cen::colors::sky_blue;
+using cen::colors::slate_blue;
+using cen::colors::slate_gray;
+using cen::colors::slate_grey;
+using cen::colors::snow;
+using cen::colors::spring_green;
+using cen::colors::steel_blue;
+using cen::colors::tan;
+using cen::colors::teal;
+using cen::colors::thistle;
+using cen::colors::tomato;
+using cen::colors::turquoise;
+using cen::colors::violet;
+using cen::colors::wheat;
+using cen::colors::white_smoke;
+using cen::colors::yellow;
+using cen::colors::yellow_green;
+using cen::colors::light_blue;
+using cen::colors::light_coral;
+using cen::colors::light_cyan;
+using cen::colors::light_golden_rod_yellow;
+using cen::colors::light_gray;
+using cen::colors::light_grey;
+using cen::colors::light_green;
+using cen::colors::light_pink;
+using cen::colors::light_salmon;
+using cen::colors::light_sea_green;
+using cen::colors::light_sky_blue;
+using cen::colors::light_slate_gray;
+using cen::colors::light_slate_grey;
+using cen::colors::light_steel_blue;
+using cen::colors::light_yellow;
+using cen::colors::medium_aqua_marine;
+using cen::colors::medium_blue;
+using cen::colors::medium_orchid;
+using cen::colors::medium_purple;
+using cen::colors::medium_sea_green;
+using cen::colors::medium_slate_blue;
+using cen::colors::medium_spring_green;
+using cen::colors::medium_turquoise;
+using cen::colors::medium_violet_red;
+using cen::colors::dark_blue;
+using cen::colors::dark_cyan;
+using cen::colors::dark_golden_rod;
+using cen::colors::dark_gray;
+using cen::colors::dark_grey;
+using cen::colors::dark_green;
+using cen::colors::dark_khaki;
+using cen::colors::dark_magenta;
+using cen::colors::dark_olive_green;
+using cen::colors::dark_orange;
+using cen::colors::dark_orchid;
+using cen::colors::dark_red;
+using cen::colors::dark_salmon;
+using cen::colors::dark_sea_green;
+using cen::colors::dark_slate_blue;
+using cen::colors::dark_slate_gray;
+using cen::colors::dark_slate_grey;
+using cen::colors::dark_turquoise;
+using cen::colors::dark_violet;
+
+}  // namespace cen::colors
+
+export namespace cen::gl {
+
+#ifndef CENTURION_NO_OPENGL
+using cen::gl::swap;
+using cen::gl::drawable_size;
+using cen::gl::reset_attributes;
+using cen::gl::set;
+using cen::gl::get;
+using cen::gl::set_swap_interval;
+using cen::gl::swap_interval;
+using cen::gl::get_window;
+using cen::gl::get_context;
+using cen::gl::is_extension_supported;
+using cen::gl::bind;
+using cen::gl::unbind;
+#endif  // CENTURION_NO_OPENGL
+
+}  // namespace cen::gl
+
+export namespace cen::literals::color_literals {
+
+using cen::literals::color_literals::operator""_rgb;
+using cen::literals::color_literals::operator""_rgba;
+using cen::literals::color_literals::operator""_argb;
+
+}  // namespace cen::literals::color_literals
+
+export namespace cen::vk {
+
+#ifndef CENTURION_NO_VULKAN
+using cen::vk::get_instance_proc_addr;
+using cen::vk::make_surface;
+using cen::vk::required_extensions;
+using cen::vk::drawable_size;
+#endif  // CENTURION_NO_VULKAN
+
+}  // namespace cen::vk
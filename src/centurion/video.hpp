@@ -22,18 +22,67 @@
  * SOFTWARE.
  */
 
+#include "video/animated_texture.hpp"
 #include "video/animation.hpp"
+#include "video/animation_system.hpp"
+#include "video/atlas_region.hpp"
 #include "video/blend.hpp"
+#include "video/camera.hpp"
+#include "video/collision_mask.hpp"
 #include "video/color.hpp"
+#include "video/color_lut.hpp"
+#include "video/damage_tracker.hpp"
 #include "video/display.hpp"
+#include "video/display_registry.hpp"
 #include "video/flash_op.hpp"
+#include "video/frame_capture.hpp"
+#include "video/frame_pacer.hpp"
+#include "video/frame_stats.hpp"
+#include "video/game_loop.hpp"
+#include "video/gl_pass_timer.hpp"
+#include "video/gl_state.hpp"
+#include "video/gl_texture_streamer.hpp"
+#include "video/gl_upload_context.hpp"
+#include "video/image_loader.hpp"
 #include "video/message_box.hpp"
+#include "video/mipmapped_texture.hpp"
+#include "video/nine_slice.hpp"
 #include "video/opengl.hpp"
+#include "video/particle_system.hpp"
+#include "video/pixel_pipeline.hpp"
+#include "video/pixel_span.hpp"
 #include "video/pixels.hpp"
+#include "video/quantization.hpp"
+#include "video/render_command_list.hpp"
+#include "video/render_layer.hpp"
+#include "video/render_thread.hpp"
+#include "video/render_view.hpp"
 #include "video/renderer.hpp"
 #include "video/renderer_info.hpp"
+#include "video/renderer_selector.hpp"
+#include "video/resize_coordinator.hpp"
+#include "video/resource_pool.hpp"
+#include "video/shape_builder.hpp"
+#include "video/software_canvas.hpp"
+#include "video/sprite_batch.hpp"
 #include "video/surface.hpp"
+#include "video/surface_canvas.hpp"
+#include "video/surface_ops.hpp"
+#include "video/surface_presenter.hpp"
 #include "video/texture.hpp"
+#include "video/texture_atlas.hpp"
+#include "video/texture_disk_cache.hpp"
+#include "video/texture_memory.hpp"
+#include "video/texture_restorer.hpp"
+#include "video/texture_streamer.hpp"
+#include "video/tilemap_layer.hpp"
 #include "video/unicode_string.hpp"
+#include "video/video_stream.hpp"
 #include "video/vulkan.hpp"
 #include "video/window.hpp"
+
+#ifdef __has_include
+#if __has_include(<vulkan/vulkan.h>)
+#include "video/vk_swapchain.hpp"
+#endif  // __has_include(<vulkan/vulkan.h>)
+#endif  // __has_include
@@ -0,0 +1,260 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_ANIMATED_TEXTURE_HPP_
+#define CENTURION_VIDEO_ANIMATED_TEXTURE_HPP_
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+#include <SDL.h>
+#include <SDL_image.h>
+
+#include <algorithm>  // upper_bound
+#include <cmath>      // ceil, sqrt
+#include <string>     // string, to_string
+#include <vector>     // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "animation.hpp"
+#include "atlas_region.hpp"
+#include "renderer.hpp"
+#include "renderer_info.hpp"
+#include "surface.hpp"
+#include "texture_atlas.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+#if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+
+/**
+ * An animation whose frames have been uploaded to the GPU.
+ *
+ * All frames are uploaded once, when the animated texture is created, and are packed into as
+ * few atlas pages as the renderer allows. The frame delays are stored as cumulative end
+ * times, so finding the frame to show at a given time is a binary search. As a result,
+ * playing an animation requires no allocations or texture uploads.
+ *
+ * \see animation
+ * \see texture_atlas
+ */
+class animated_texture final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Uploads the frames of an animation.
+   *
+   * \param renderer the renderer used to create the atlas pages.
+   * \param anim the animation that will be uploaded.
+   *
+   * \throws exception if the animation has no frames, or if its frames are too large for a
+   * texture.
+   * \throws sdl_error if a frame cannot be copied or uploaded.
+   */
+  template <typename T>
+  animated_texture(const basic_renderer<T>& renderer, const animation& anim)
+      : mAtlas {page_size(renderer, anim)}
+      , mSize {anim.size()}
+  {
+    const auto count = static_cast<usize>(anim.count());
+    mEndTimes.reserve(count);
+
+    uint64 time {};
+    for (usize index = 0; index < count; ++index) {
+      /* The frames are copied, since the atlas changes the blend mode of its images */
+      auto* copy = SDL_DuplicateSurface(anim.get()->frames[index]);
+      if (!copy) {
+        throw sdl_error {};
+      }
+
+      mAtlas.add(surface {copy});
+
+      time += static_cast<uint64>((detail::max)(anim.delay(index), 0));
+      mEndTimes.push_back(time);
+    }
+
+    mAtlas.build(renderer);
+  }
+
+  /**
+   * Returns the index of the frame that is shown at a specific time.
+   *
+   * \param time the time since the start of the animation.
+   * \param loop `true` if the animation restarts after its duration; `false` if the last frame
+   * is shown indefinitely.
+   *
+   * \return the index of the frame that should be shown.
+   */
+  [[nodiscard]] auto frame_at(const u64ms time, const bool loop = true) const noexcept
+      -> size_type
+  {
+    const auto total = mEndTimes.back();
+    if (total == 0) {
+      return 0;
+    }
+
+    const auto ms = loop ? time.count() % total : time.count();
+
+    /* Frames without a delay end where they start, so they are skipped */
+    const auto iter = std::upper_bound(mEndTimes.begin(), mEndTimes.end(), ms);
+    if (iter != mEndTimes.end()) {
+      return static_cast<size_type>(iter - mEndTimes.begin());
+    }
+    else {
+      return mEndTimes.size() - 1u;
+    }
+  }
+
+  /**
+   * Returns the atlas region of a frame.
+   *
+   * \param index the index of the frame.
+   *
+   * \return the region of the frame, which can be rendered directly.
+   *
+   * \throws std::out_of_range if the index is invalid.
+   */
+  [[nodiscard]] auto region(const size_type index) const -> const atlas_region&
+  {
+    return mAtlas.region(index);
+  }
+
+  /// Returns the atlas region of the frame that is shown at a specific time.
+  [[nodiscard]] auto region_at(const u64ms time, const bool loop = true) const
+      -> const atlas_region&
+  {
+    return region(frame_at(time, loop));
+  }
+
+  /// Returns the delay of a frame, in milliseconds.
+  [[nodiscard]] auto delay(const size_type index) const -> u64ms
+  {
+    if (index < mEndTimes.size()) {
+      const auto start = (index == 0) ? 0u : mEndTimes[index - 1u];
+      return u64ms {mEndTimes[index] - start};
+    }
+    else {
+      throw exception {"Invalid animation frame index!"};
+    }
+  }
+
+  /// Returns the sum of all frame delays.
+  [[nodiscard]] auto duration() const noexcept -> u64ms { return u64ms {mEndTimes.back()}; }
+
+  /// Returns the amount of frames.
+  [[nodiscard]] auto count() const noexcept -> size_type { return mEndTimes.size(); }
+
+  [[nodiscard]] auto width() const noexcept -> int { return mSize.width; }
+  [[nodiscard]] auto height() const noexcept -> int { return mSize.height; }
+  [[nodiscard]] auto size() const noexcept -> iarea { return mSize; }
+
+  /// Returns the atlas that contains the frames.
+  [[nodiscard]] auto atlas() const noexcept -> const texture_atlas& { return mAtlas; }
+
+ private:
+  texture_atlas mAtlas;
+  iarea mSize;
+  std::vector<uint64> mEndTimes;
+
+  /* Determines a page size that fits as many frames as possible, in a roughly square grid */
+  template <typename T>
+  [[nodiscard]] static auto page_size(const basic_renderer<T>& renderer,
+                                      const animation& anim) -> iarea
+  {
+    if (anim.count() <= 0) {
+      throw exception {"Cannot upload animation without frames!"};
+    }
+
+    iarea limit {2048, 2048};
+    if (const auto info = get_info(renderer)) {
+      if (info->max_texture_width() > 0 && info->max_texture_height() > 0) {
+        limit = info->max_texture_size();
+      }
+    }
+
+    /* Each frame is surrounded by the default atlas padding */
+    const iarea frame {anim.width() + 2, anim.height() + 2};
+
+    const auto maxColumns = limit.width / frame.width;
+    const auto maxRows = limit.height / frame.height;
+    if (maxColumns == 0 || maxRows == 0) {
+      throw exception {"Animation frames are too large for a texture!"};
+    }
+
+    const auto frames = (detail::min)(anim.count(), maxColumns * maxRows);
+
+    auto rows = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(frames))));
+    rows = (detail::min)(rows, maxRows);
+
+    const auto columns = (detail::min)((frames + rows - 1) / rows, maxColumns);
+    rows = (frames + columns - 1) / columns;
+
+    return {columns * frame.width, rows * frame.height};
+  }
+};
+
+[[nodiscard]] inline auto to_string(const animated_texture& texture) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("animated_texture(count: {}, duration: {} ms)",
+                     texture.count(),
+                     texture.duration().count());
+#else
+  return "animated_texture(count: " + std::to_string(texture.count()) +
+         ", duration: " + std::to_string(texture.duration().count()) + " ms)";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const animated_texture& texture)
+    -> std::ostream&
+{
+  return stream << to_string(texture);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#endif  // SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_IMAGE
+#endif  // CENTURION_VIDEO_ANIMATED_TEXTURE_HPP_
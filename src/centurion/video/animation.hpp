@@ -31,7 +31,6 @@
 #include <SDL_image.h>
 
 #include <cassert>  // assert
-#include <ostream>  // ostream
 #include <string>   // string
 
 #include "../common/errors.hpp"
@@ -48,6 +47,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 #if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
@@ -131,11 +136,15 @@ class animation final {
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const animation& anim) -> std::ostream&
 {
   return stream << to_string(anim);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 #endif  // SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
 
 }  // namespace cen
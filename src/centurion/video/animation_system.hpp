@@ -0,0 +1,442 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_ANIMATION_SYSTEM_HPP_
+#define CENTURION_VIDEO_ANIMATION_SYSTEM_HPP_
+
+#include <SDL.h>
+
+#include <vector>  // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/simd_vector.hpp"
+#include "../common/slot_map.hpp"
+#include "../detail/animation_kernels.hpp"
+#include "../detail/stdlib.hpp"
+#include "atlas_region.hpp"
+#include "sprite_batch.hpp"
+
+namespace cen {
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+/// Describes an animation clip, which is shared by all instances that play it.
+struct animation_clip final {
+  std::vector<atlas_region> frames;  ///< The atlas regions of the frames.
+  std::vector<float> durations;      ///< The duration of each frame, in seconds.
+  bool loop {true};                  ///< Indicates whether the clip restarts at the end.
+};
+
+/**
+ * Plays sprite animations for large amounts of instances.
+ *
+ * Clips are stored once, as flat arrays of atlas regions and cumulative frame end times, and
+ * are shared by all instances. The state of each instance, i.e. its clip, playback time,
+ * speed, current frame and position, is stored as structure-of-arrays. Updating advances the
+ * playback times of all instances with a vectorized kernel, after which the current frames
+ * are found with a search that starts at the previous frame, so it's usually constant time.
+ * Rendering then writes the source rectangles of the current frames straight into a sprite
+ * batch.
+ *
+ * \code{cpp}
+ * cen::animation_system animations;
+ * const auto walk = animations.add_clip({walkFrames, walkDurations});
+ *
+ * const auto id = animations.play(walk, {100, 200});
+ *
+ * animations.update(dt);
+ * animations.render(batch);
+ * batch.flush(renderer);
+ * \endcode
+ *
+ * \details Instances are identified by generational identifiers, which are invalidated when
+ *          the instance is erased. Erasing an instance moves the last instance into its
+ *          position, so the order of instances is only stable as long as none are erased.
+ *
+ * \see animation_clip
+ * \see sprite_batch
+ */
+class animation_system final {
+ public:
+  using size_type = usize;
+  using clip_id = usize;
+  using instance_id = slot_id<animation_system>;
+
+  animation_system() { mSlots.push_back({}); }  // Slot zero is reserved for null identifiers
+
+  /// Reserves space for the specified amount of instances.
+  void reserve(const size_type capacity)
+  {
+    mClip.reserve(capacity);
+    mFrame.reserve(capacity);
+    mTime.reserve(capacity);
+    mSpeed.reserve(capacity);
+    mLength.reserve(capacity);
+    mLoop.reserve(capacity);
+    mPosition.reserve(capacity);
+    mOwners.reserve(capacity);
+  }
+
+  /**
+   * Adds a clip.
+   *
+   * \param clip the clip that will be added.
+   *
+   * \return the identifier of the clip.
+   *
+   * \throws exception if the clip has no frames, if the amount of durations doesn't match the
+   *         amount of frames, or if a duration isn't positive.
+   */
+  auto add_clip(const animation_clip& clip) -> clip_id
+  {
+    if (clip.frames.empty()) {
+      throw exception {"Animation clip has no frames!"};
+    }
+    else if (clip.frames.size() != clip.durations.size()) {
+      throw exception {"Animation clip frame and duration counts differ!"};
+    }
+
+    clip_data data;
+    data.first = static_cast<uint32>(mRegions.size());
+    data.count = static_cast<uint32>(clip.frames.size());
+    data.loop = clip.loop;
+
+    float end = 0;
+    for (usize index = 0; index < clip.frames.size(); ++index) {
+      if (!(clip.durations[index] > 0)) {
+        throw exception {"Animation clip frame durations must be positive!"};
+      }
+
+      end += clip.durations[index];
+      mEnds.push_back(end);
+      mRegions.push_back(clip.frames[index]);
+    }
+
+    data.length = end;
+    mClips.push_back(data);
+
+    return mClips.size() - 1u;
+  }
+
+  /**
+   * Starts playing a clip with a new instance.
+   *
+   * \param clip the clip that will be played.
+   * \param position the position of the instance, i.e. the top-left corner of its sprites.
+   * \param speed the playback speed, where negative speeds play the clip in reverse.
+   *
+   * \return the identifier of the instance.
+   *
+   * \throws exception if the clip identifier is invalid.
+   */
+  auto play(const clip_id clip, const fpoint& position = {}, const float speed = 1)
+      -> instance_id
+  {
+    const auto& data = clip_at(clip);
+
+    uint32 slot {};
+    if (!mFree.empty()) {
+      slot = mFree.back();
+      mFree.pop_back();
+    }
+    else if (mSlots.size() <= instance_id::index_mask) {
+      slot = static_cast<uint32>(mSlots.size());
+      mSlots.emplace_back();
+    }
+    else {
+      throw exception {"Too many animation instances!"};
+    }
+
+    mSlots[slot].dense = static_cast<uint32>(size());
+    mOwners.push_back(slot);
+
+    /* Clips that don't loop start at the end when they are played in reverse */
+    const auto time = (speed < 0 && !data.loop) ? data.length : 0.0f;
+
+    mClip.push_back(static_cast<uint32>(clip));
+    mFrame.push_back(detail::find_frame(mEnds.data() + data.first, data.count, 0, time));
+    mTime.push_back(time);
+    mSpeed.push_back(speed);
+    mLength.push_back(data.length);
+    mLoop.push_back(data.loop ? 1.0f : 0.0f);
+    mPosition.push_back(position);
+
+    return instance_id {slot, mSlots[slot].generation};
+  }
+
+  /**
+   * Erases an instance.
+   *
+   * \param id the identifier of the instance that will be erased.
+   *
+   * \return `true` if the instance was erased; `false` if the identifier was invalid.
+   */
+  auto erase(const instance_id id) noexcept -> bool
+  {
+    if (!contains(id)) {
+      return false;
+    }
+
+    auto& slot = mSlots[id.index()];
+    const auto index = static_cast<size_type>(slot.dense);
+    const auto last = size() - 1u;
+
+    mClip[index] = mClip[last];
+    mFrame[index] = mFrame[last];
+    mTime[index] = mTime[last];
+    mSpeed[index] = mSpeed[last];
+    mLength[index] = mLength[last];
+    mLoop[index] = mLoop[last];
+    mPosition[index] = mPosition[last];
+    mOwners[index] = mOwners[last];
+    mSlots[mOwners[index]].dense = static_cast<uint32>(index);
+
+    mClip.pop_back();
+    mFrame.pop_back();
+    mTime.pop_back();
+    mSpeed.pop_back();
+    mLength.pop_back();
+    mLoop.pop_back();
+    mPosition.pop_back();
+    mOwners.pop_back();
+
+    slot.generation = (slot.generation + 1u) & instance_id::max_generation;
+    mFree.push_back(id.index());
+
+    return true;
+  }
+
+  /// Indicates whether an identifier refers to an instance.
+  [[nodiscard]] auto contains(const instance_id id) const noexcept -> bool
+  {
+    const auto index = id.index();
+    return index != 0 && index < mSlots.size() && mSlots[index].generation == id.generation();
+  }
+
+  /**
+   * Advances all instances.
+   *
+   * \param dt the time step, in seconds.
+   */
+  void update(const float dt) noexcept
+  {
+    detail::animation_arrays arrays;
+    arrays.time = mTime.data();
+    arrays.speed = mSpeed.data();
+    arrays.length = mLength.data();
+    arrays.loop = mLoop.data();
+
+    detail::advance_n(arrays, size(), dt);
+
+    for (size_type index = 0; index < size(); ++index) {
+      const auto& clip = mClips[mClip[index]];
+      mFrame[index] = detail::find_frame(mEnds.data() + clip.first,
+                                         clip.count,
+                                         mFrame[index],
+                                         mTime[index]);
+    }
+  }
+
+  /**
+   * Adds the current frames of all instances to a sprite batch.
+   *
+   * \param batch the batch that the sprites will be added to.
+   * \param layer the layer of the sprites in the batch.
+   */
+  void render(sprite_batch& batch, const int layer = 0) const
+  {
+    for (size_type index = 0; index < size(); ++index) {
+      const auto& region = region_at(index);
+      batch.add(region, frect {mPosition[index], region.size().as_f()}, layer);
+    }
+  }
+
+  /// Switches the clip of an instance, and restarts it.
+  void set_clip(const instance_id id, const clip_id clip)
+  {
+    const auto index = index_of(id);
+    const auto& data = clip_at(clip);
+
+    mClip[index] = static_cast<uint32>(clip);
+    mLength[index] = data.length;
+    mLoop[index] = data.loop ? 1.0f : 0.0f;
+    set_time(id, (mSpeed[index] < 0 && !data.loop) ? data.length : 0.0f);
+  }
+
+  /// Sets the playback time of an instance, which is clamped to the length of its clip.
+  void set_time(const instance_id id, const float time)
+  {
+    const auto index = index_of(id);
+    const auto& clip = mClips[mClip[index]];
+
+    mTime[index] = (detail::clamp)(time, 0.0f, clip.length);
+    mFrame[index] =
+        detail::find_frame(mEnds.data() + clip.first, clip.count, mFrame[index], mTime[index]);
+  }
+
+  void set_speed(const instance_id id, const float speed) { mSpeed[index_of(id)] = speed; }
+
+  void set_position(const instance_id id, const fpoint& position)
+  {
+    mPosition[index_of(id)] = position;
+  }
+
+  [[nodiscard]] auto clip_of(const instance_id id) const -> clip_id
+  {
+    return mClip[index_of(id)];
+  }
+
+  [[nodiscard]] auto time(const instance_id id) const -> float { return mTime[index_of(id)]; }
+
+  [[nodiscard]] auto speed(const instance_id id) const -> float
+  {
+    return mSpeed[index_of(id)];
+  }
+
+  [[nodiscard]] auto position(const instance_id id) const -> fpoint
+  {
+    return mPosition[index_of(id)];
+  }
+
+  /// Returns the index of the current frame of an instance, within its clip.
+  [[nodiscard]] auto frame(const instance_id id) const -> size_type
+  {
+    return mFrame[index_of(id)];
+  }
+
+  /// Returns the atlas region of the current frame of an instance.
+  [[nodiscard]] auto region(const instance_id id) const -> const atlas_region&
+  {
+    return region_at(index_of(id));
+  }
+
+  /// Indicates whether an instance of a clip that doesn't loop has reached its end.
+  [[nodiscard]] auto is_finished(const instance_id id) const -> bool
+  {
+    const auto index = index_of(id);
+    if (mLoop[index] > 0) {
+      return false;
+    }
+    else {
+      return (mSpeed[index] < 0) ? mTime[index] <= 0 : mTime[index] >= mLength[index];
+    }
+  }
+
+  /// Removes all instances, but keeps the clips.
+  void clear() noexcept
+  {
+    for (const auto slot : mOwners) {
+      auto& data = mSlots[slot];
+      data.generation = (data.generation + 1u) & instance_id::max_generation;
+      mFree.push_back(slot);
+    }
+
+    mClip.clear();
+    mFrame.clear();
+    mTime.clear();
+    mSpeed.clear();
+    mLength.clear();
+    mLoop.clear();
+    mPosition.clear();
+    mOwners.clear();
+  }
+
+  /// Returns the playback times of all instances, in the same order as the instances.
+  [[nodiscard]] auto times() const noexcept -> const float* { return mTime.data(); }
+
+  /// Returns the current frames of all instances, in the same order as the instances.
+  [[nodiscard]] auto frames() const noexcept -> const uint32* { return mFrame.data(); }
+
+  [[nodiscard]] auto clip_count() const noexcept -> size_type { return mClips.size(); }
+
+  [[nodiscard]] auto size() const noexcept -> size_type { return mClip.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mClip.empty(); }
+
+ private:
+  struct clip_data final {
+    uint32 first {};  ///< The index of the first frame in the flat frame arrays.
+    uint32 count {};  ///< The amount of frames.
+    float length {};  ///< The total duration, in seconds.
+    bool loop {};
+  };
+
+  struct instance_slot final {
+    uint32 dense {};       ///< The index of the instance in the dense arrays.
+    uint32 generation {};  ///< Incremented when the instance of the slot is erased.
+  };
+
+  /* Clips, with the frames of all clips in flat arrays */
+  std::vector<clip_data> mClips;
+  std::vector<atlas_region> mRegions;
+  std::vector<float> mEnds;  ///< Cumulative frame end times, relative to the clip start.
+
+  /* Instances, as structure-of-arrays */
+  std::vector<uint32> mClip;
+  std::vector<uint32> mFrame;
+  simd_vector<float> mTime;
+  simd_vector<float> mSpeed;
+  simd_vector<float> mLength;
+  simd_vector<float> mLoop;
+  std::vector<fpoint> mPosition;
+
+  /* Indirection from identifiers to instances */
+  std::vector<instance_slot> mSlots;
+  std::vector<uint32> mOwners;  ///< The slot of each instance.
+  std::vector<uint32> mFree;
+
+  [[nodiscard]] auto clip_at(const clip_id clip) const -> const clip_data&
+  {
+    if (clip < mClips.size()) {
+      return mClips[clip];
+    }
+    else {
+      throw exception {"Invalid animation clip!"};
+    }
+  }
+
+  [[nodiscard]] auto index_of(const instance_id id) const -> size_type
+  {
+    if (contains(id)) {
+      return mSlots[id.index()].dense;
+    }
+    else {
+      throw exception {"Invalid animation instance!"};
+    }
+  }
+
+  [[nodiscard]] auto region_at(const size_type index) const noexcept -> const atlas_region&
+  {
+    return mRegions[mClips[mClip[index]].first + mFrame[index]];
+  }
+};
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_ANIMATION_SYSTEM_HPP_
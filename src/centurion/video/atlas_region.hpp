@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_ATLAS_REGION_HPP_
+#define CENTURION_VIDEO_ATLAS_REGION_HPP_
+
+#include <SDL.h>
+
+#include <string>   // string, to_string
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../features.hpp"
+#include "texture.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/**
+ * Represents a region of a texture atlas page.
+ *
+ * Atlas regions are lightweight non-owning handles, the atlas that created a region must
+ * outlive it.
+ *
+ * \see texture_atlas
+ */
+struct atlas_region final {
+  SDL_Texture* texture {};  ///< The atlas page that contains the region.
+  irect source;             ///< The area of the page that the region occupies.
+  usize page {};            ///< The index of the associated atlas page.
+
+  /// Returns a handle to the atlas page that contains the region.
+  [[nodiscard]] auto page_texture() const noexcept -> texture_handle
+  {
+    return texture_handle {texture};
+  }
+
+  /// Returns the size of the region.
+  [[nodiscard]] auto size() const noexcept -> iarea { return source.size(); }
+
+  /// Indicates whether the region is associated with a texture.
+  [[nodiscard]] explicit operator bool() const noexcept { return texture != nullptr; }
+};
+
+[[nodiscard]] inline auto to_string(const atlas_region& region) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("atlas_region(page: {}, x: {}, y: {}, width: {}, height: {})",
+                     region.page,
+                     region.source.x(),
+                     region.source.y(),
+                     region.source.width(),
+                     region.source.height());
+#else
+  return "atlas_region(page: " + std::to_string(region.page) +
+         ", x: " + std::to_string(region.source.x()) +
+         ", y: " + std::to_string(region.source.y()) +
+         ", width: " + std::to_string(region.source.width()) +
+         ", height: " + std::to_string(region.source.height()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const atlas_region& region) -> std::ostream&
+{
+  return stream << to_string(region);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_ATLAS_REGION_HPP_
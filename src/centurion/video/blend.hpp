@@ -27,12 +27,17 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 #include "../common/primitives.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class blend_mode {
@@ -94,6 +99,26 @@ struct blend_task final {
   return static_cast<blend_mode>(res);
 }
 
+/// Describes whether the color channels of pixel data have been multiplied by its alpha.
+enum class alpha_mode {
+  straight,      ///< The color channels are independent of the alpha channel.
+  premultiplied  ///< The color channels have been multiplied by the alpha channel.
+};
+
+/**
+ * Returns a blend mode for source pixels with premultiplied alpha.
+ *
+ * The resulting destination color is `src + dst * (1 - srcA)`, which avoids the dark fringes
+ * that straight alpha produces when filtering transparent edges.
+ *
+ * \return a custom blend mode for premultiplied alpha.
+ */
+[[nodiscard]] inline auto premultiplied_blend_mode() noexcept -> blend_mode
+{
+  const blend_task task {blend_factor::one, blend_factor::one_minus_src_alpha, blend_op::add};
+  return compose_blend_mode(task, task);
+}
+
 [[nodiscard]] constexpr auto to_string(const blend_mode mode) -> std::string_view
 {
   switch (mode) {
@@ -185,6 +210,22 @@ struct blend_task final {
   }
 }
 
+[[nodiscard]] constexpr auto to_string(const alpha_mode mode) -> std::string_view
+{
+  switch (mode) {
+    case alpha_mode::straight:
+      return "straight";
+
+    case alpha_mode::premultiplied:
+      return "premultiplied";
+
+    default:
+      throw exception {"Did not recognize alpha mode!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const blend_mode mode) -> std::ostream&
 {
   return stream << to_string(mode);
@@ -200,6 +241,13 @@ inline auto operator<<(std::ostream& stream, const blend_op op) -> std::ostream&
   return stream << to_string(op);
 }
 
+inline auto operator<<(std::ostream& stream, const alpha_mode mode) -> std::ostream&
+{
+  return stream << to_string(mode);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_VIDEO_BLEND_HPP_
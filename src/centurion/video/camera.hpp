@@ -0,0 +1,323 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_CAMERA_HPP_
+#define CENTURION_VIDEO_CAMERA_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <string>   // string
+#include <vector>   // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../features.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+namespace cen {
+
+/**
+ * Represents a view into a world-space coordinate system.
+ *
+ * A camera maps its world-space view rectangle onto a logical output area, e.g. the renderer
+ * output size or logical size. It is used to reject draws that are entirely off-screen, and
+ * to transform world-space rectangles into render destinations, either one at a time or in
+ * bulk.
+ *
+ * The bulk functions write their results into caller-provided storage, so that the same
+ * buffers can be reused every frame without any allocations.
+ */
+class camera final {
+ public:
+  /**
+   * Creates a camera.
+   *
+   * \param view the visible area, in world coordinates.
+   * \param logicalSize the size of the output area that the view is mapped onto.
+   */
+  constexpr camera(const frect& view, const farea& logicalSize) noexcept
+      : mView {view}
+      , mLogicalSize {logicalSize}
+  {
+  }
+
+  /**
+   * Creates a camera that maps world units directly to output units.
+   *
+   * \param logicalSize the size of the output area, which is also the size of the view.
+   */
+  constexpr explicit camera(const farea& logicalSize) noexcept
+      : camera {frect {{0, 0}, logicalSize}, logicalSize}
+  {
+  }
+
+  constexpr void set_view(const frect& view) noexcept { mView = view; }
+
+  constexpr void set_position(const fpoint& position) noexcept
+  {
+    mView.set_position(position);
+  }
+
+  constexpr void set_logical_size(const farea& size) noexcept { mLogicalSize = size; }
+
+  /// Moves the view by the specified world-space offset.
+  constexpr void move_by(const fpoint& offset) noexcept
+  {
+    mView.offset_x(offset.x());
+    mView.offset_y(offset.y());
+  }
+
+  /// Moves the view so that it is centered on a world-space point.
+  constexpr void center_on(const fpoint& point) noexcept
+  {
+    mView.set_x(point.x() - (mView.width() / 2.0f));
+    mView.set_y(point.y() - (mView.height() / 2.0f));
+  }
+
+  /**
+   * Indicates whether a world-space rectangle is at least partially visible.
+   *
+   * \param rect the world-space rectangle that will be tested.
+   *
+   * \return `true` if the rectangle intersects the view; `false` otherwise.
+   */
+  [[nodiscard]] constexpr auto visible(const frect& rect) const noexcept -> bool
+  {
+    return intersects(mView, rect);
+  }
+
+  /// Indicates whether a world-space point is within the view.
+  [[nodiscard]] constexpr auto visible(const fpoint& point) const noexcept -> bool
+  {
+    return mView.contains(point);
+  }
+
+  /// Transforms a world-space point into output coordinates.
+  [[nodiscard]] constexpr auto to_screen(const fpoint& point) const noexcept -> fpoint
+  {
+    return {(point.x() - mView.x()) * scale_x(), (point.y() - mView.y()) * scale_y()};
+  }
+
+  /// Transforms a world-space rectangle into an output rectangle, i.e. a render destination.
+  [[nodiscard]] constexpr auto to_screen(const frect& rect) const noexcept -> frect
+  {
+    const auto sx = scale_x();
+    const auto sy = scale_y();
+    return {(rect.x() - mView.x()) * sx,
+            (rect.y() - mView.y()) * sy,
+            rect.width() * sx,
+            rect.height() * sy};
+  }
+
+  /// Transforms an output point, e.g. the mouse position, into world coordinates.
+  [[nodiscard]] constexpr auto to_world(const fpoint& point) const noexcept -> fpoint
+  {
+    return {mView.x() + (point.x() / scale_x()), mView.y() + (point.y() / scale_y())};
+  }
+
+  /**
+   * Transforms a range of world-space rectangles into output rectangles.
+   *
+   * \param rects the world-space rectangles.
+   * \param out the storage for the output rectangles, may be the same as the input.
+   * \param count the amount of rectangles.
+   */
+  void to_screen(const frect* rects, frect* out, const usize count) const noexcept
+  {
+    assert(!count || (rects && out));
+
+    const auto sx = scale_x();
+    const auto sy = scale_y();
+    const auto vx = mView.x();
+    const auto vy = mView.y();
+
+    for (usize i = 0; i < count; ++i) {
+      const auto& rect = rects[i];
+      out[i] = {(rect.x() - vx) * sx,
+                (rect.y() - vy) * sy,
+                rect.width() * sx,
+                rect.height() * sy};
+    }
+  }
+
+  /**
+   * Determines which rectangles in a range are visible.
+   *
+   * \param rects the world-space rectangles.
+   * \param count the amount of rectangles.
+   * \param indices the storage for the indices of the visible rectangles, which must be able
+   *        to hold `count` indices.
+   *
+   * \return the amount of visible rectangles, i.e. the amount of written indices.
+   */
+  auto cull(const frect* rects, const usize count, usize* indices) const noexcept -> usize
+  {
+    assert(!count || (rects && indices));
+
+    usize visibleCount = 0;
+    for (usize i = 0; i < count; ++i) {
+      indices[visibleCount] = i;
+      visibleCount += visible(rects[i]) ? 1u : 0u;
+    }
+
+    return visibleCount;
+  }
+
+  /**
+   * Culls a range of world-space rectangles and transforms the visible ones.
+   *
+   * This is the typical preparation of render destinations for a large set of sprites, where
+   * the indices are used to look up the associated source rectangles or textures.
+   *
+   * \param rects the world-space rectangles.
+   * \param count the amount of rectangles.
+   * \param out the storage for the output rectangles of the visible rectangles, which must be
+   *        able to hold `count` rectangles.
+   * \param indices the storage for the indices of the visible rectangles, may be null.
+   *
+   * \return the amount of visible rectangles.
+   */
+  auto cull_to_screen(const frect* rects,
+                      const usize count,
+                      frect* out,
+                      usize* indices = nullptr) const noexcept -> usize
+  {
+    assert(!count || (rects && out));
+
+    usize visibleCount = 0;
+    for (usize i = 0; i < count; ++i) {
+      if (visible(rects[i])) {
+        out[visibleCount] = to_screen(rects[i]);
+        if (indices) {
+          indices[visibleCount] = i;
+        }
+        ++visibleCount;
+      }
+    }
+
+    return visibleCount;
+  }
+
+  /**
+   * Determines which rectangles are visible.
+   *
+   * \param rects the world-space rectangles.
+   * \param indices the vector that will be filled with the indices of the visible rectangles,
+   *        any previous contents are discarded.
+   */
+  void cull(const std::vector<frect>& rects, std::vector<usize>& indices) const
+  {
+    indices.resize(rects.size());
+    indices.resize(cull(rects.data(), rects.size(), indices.data()));
+  }
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+  void to_screen(const std::span<const frect> rects, const std::span<frect> out) const noexcept
+  {
+    assert(rects.size() <= out.size());
+    to_screen(rects.data(), out.data(), rects.size());
+  }
+
+  [[nodiscard]] auto cull(const std::span<const frect> rects,
+                          const std::span<usize> indices) const noexcept -> usize
+  {
+    assert(rects.size() <= indices.size());
+    return cull(rects.data(), rects.size(), indices.data());
+  }
+
+  [[nodiscard]] auto cull_to_screen(const std::span<const frect> rects,
+                                    const std::span<frect> out) const noexcept -> usize
+  {
+    assert(rects.size() <= out.size());
+    return cull_to_screen(rects.data(), rects.size(), out.data());
+  }
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+  [[nodiscard]] constexpr auto view() const noexcept -> const frect& { return mView; }
+
+  [[nodiscard]] constexpr auto position() const noexcept -> fpoint { return mView.position(); }
+
+  [[nodiscard]] constexpr auto logical_size() const noexcept -> farea { return mLogicalSize; }
+
+  /// Returns the horizontal scale from world units to output units.
+  [[nodiscard]] constexpr auto scale_x() const noexcept -> float
+  {
+    return (mView.width() > 0) ? mLogicalSize.width / mView.width() : 0.0f;
+  }
+
+  /// Returns the vertical scale from world units to output units.
+  [[nodiscard]] constexpr auto scale_y() const noexcept -> float
+  {
+    return (mView.height() > 0) ? mLogicalSize.height / mView.height() : 0.0f;
+  }
+
+ private:
+  frect mView;
+  farea mLogicalSize;
+};
+
+[[nodiscard]] inline auto to_string(const camera& camera) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("camera(view: {}, logical_size: {})",
+                     to_string(camera.view()),
+                     to_string(camera.logical_size()));
+#else
+  return "camera(view: " + to_string(camera.view()) +
+         ", logical_size: " + to_string(camera.logical_size()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const camera& camera) -> std::ostream&
+{
+  return stream << to_string(camera);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_CAMERA_HPP_
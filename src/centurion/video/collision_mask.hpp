@@ -0,0 +1,397 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_COLLISION_MASK_HPP_
+#define CENTURION_VIDEO_COLLISION_MASK_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <vector>   // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/pixel_conversion.hpp"
+#include "../detail/stdlib.hpp"
+#include "pixels.hpp"
+#include "surface.hpp"
+
+namespace cen {
+
+/**
+ * A pixel-perfect collision mask, packed into a bitset with a bit per pixel.
+ *
+ * Masks are built once from the alpha channel of a surface, pixels with an alpha value of at
+ * least the threshold are considered solid. Every row is padded to a whole number of 64-bit
+ * words, so overlap tests compare 64 pixels at a time, using a couple of shifts to align the
+ * rows of the other mask. Only the intersection of the bounding rectangles of the solid
+ * pixels is ever inspected, so most disjoint masks are rejected without touching the bits.
+ *
+ * \see basic_surface
+ */
+class collision_mask final {
+ public:
+  using word_type = uint64;
+
+  inline constexpr static int word_bits = 64;
+
+  /// Creates an empty mask, without any pixels.
+  collision_mask() noexcept = default;
+
+  /**
+   * Creates a mask where all pixels are clear.
+   *
+   * \param size the size of the mask, the dimensions must not be negative.
+   */
+  explicit collision_mask(const iarea size)
+      : mWidth {size.width}
+      , mHeight {size.height}
+      , mWordsPerRow {(size.width + word_bits - 1) / word_bits}
+  {
+    assert(size.width >= 0);
+    assert(size.height >= 0);
+    mWords.resize(static_cast<usize>(mWordsPerRow) * static_cast<usize>(mHeight));
+  }
+
+  /**
+   * Creates a mask from the alpha channel of a surface.
+   *
+   * Surfaces without an 8-bit alpha channel are converted first, which means that color keyed
+   * pixels are treated as transparent.
+   *
+   * \param surface the source surface.
+   * \param threshold the minimum alpha value of solid pixels.
+   *
+   * \throws sdl_error if the surface had to be converted, and the conversion failed.
+   */
+  template <typename T>
+  explicit collision_mask(const basic_surface<T>& surface, const uint8 threshold = 128)
+      : collision_mask {surface.size()}
+  {
+    const auto alphaIndex = detail::alpha_byte_index(*surface.get()->format);
+    if (alphaIndex && !surface.must_lock()) {
+      read_alpha(*surface.get(), *alphaIndex, threshold);
+    }
+    else {
+      const auto converted = surface.convert_to(pixel_format::rgba32);
+      read_alpha(*converted.get(),
+                 *detail::alpha_byte_index(*converted.get()->format),
+                 threshold);
+    }
+  }
+
+  /**
+   * Sets the state of a single pixel.
+   *
+   * The bounds are only ever grown by this function, so they might not be tight after pixels
+   * have been cleared, which is harmless since they are only used to skip work.
+   *
+   * \param point the position of the pixel, must be within the mask.
+   * \param solid `true` if the pixel should be solid; `false` otherwise.
+   */
+  void set(const ipoint point, const bool solid = true) noexcept
+  {
+    assert(contains(point));
+
+    auto& word = mWords[word_index(point.x(), point.y())];
+    const auto bit = word_type {1} << static_cast<unsigned>(point.x() % word_bits);
+
+    if (solid) {
+      word |= bit;
+      include(point);
+    }
+    else {
+      word &= ~bit;
+    }
+  }
+
+  /**
+   * Indicates whether a pixel is solid.
+   *
+   * \param point the position of the pixel, pixels outside of the mask are never solid.
+   *
+   * \return `true` if the pixel is solid; `false` otherwise.
+   */
+  [[nodiscard]] auto test(const ipoint point) const noexcept -> bool
+  {
+    if (!contains(point)) {
+      return false;
+    }
+
+    const auto word = mWords[word_index(point.x(), point.y())];
+    return (word >> static_cast<unsigned>(point.x() % word_bits)) & 1u;
+  }
+
+  /**
+   * Indicates whether any solid pixels of two masks overlap.
+   *
+   * \param other the other mask.
+   * \param offset the position of the other mask, relative to this mask.
+   *
+   * \return `true` if the masks overlap; `false` otherwise.
+   */
+  [[nodiscard]] auto overlaps(const collision_mask& other, const ipoint offset) const noexcept
+      -> bool
+  {
+    return find_overlap(other, offset).has_value();
+  }
+
+  /**
+   * Returns the first overlapping solid pixel of two masks, in row-major order.
+   *
+   * \param other the other mask.
+   * \param offset the position of the other mask, relative to this mask.
+   *
+   * \return the position of the overlapping pixel, relative to this mask; nothing if the
+   * masks don't overlap.
+   */
+  [[nodiscard]] auto find_overlap(const collision_mask& other, const ipoint offset) const
+      noexcept -> maybe<ipoint>
+  {
+    maybe<ipoint> result;
+
+    for_each_overlap_word(other, offset, [&](const int x, const int y, const word_type bits) {
+      result = ipoint {x + detail::countr_zero(bits), y};
+      return false;
+    });
+
+    return result;
+  }
+
+  /**
+   * Returns the amount of overlapping solid pixels of two masks.
+   *
+   * \param other the other mask.
+   * \param offset the position of the other mask, relative to this mask.
+   *
+   * \return the size of the overlapping area, in pixels.
+   */
+  [[nodiscard]] auto overlap_count(const collision_mask& other, const ipoint offset) const
+      noexcept -> usize
+  {
+    usize count = 0;
+
+    for_each_overlap_word(other, offset, [&](int, int, const word_type bits) {
+      count += static_cast<usize>(detail::popcount(bits));
+      return true;
+    });
+
+    return count;
+  }
+
+  /// Returns the amount of solid pixels.
+  [[nodiscard]] auto count() const noexcept -> usize
+  {
+    usize count = 0;
+
+    for (const auto word : mWords) {
+      count += static_cast<usize>(detail::popcount(word));
+    }
+
+    return count;
+  }
+
+  /// Indicates whether a point is within the mask.
+  [[nodiscard]] auto contains(const ipoint point) const noexcept -> bool
+  {
+    return point.x() >= 0 && point.y() >= 0 && point.x() < mWidth && point.y() < mHeight;
+  }
+
+  /// Returns a rectangle that covers all solid pixels, which is empty if there are none.
+  [[nodiscard]] auto bounds() const noexcept -> irect
+  {
+    if (mMaxX < mMinX) {
+      return {};
+    }
+    else {
+      return {mMinX, mMinY, mMaxX - mMinX + 1, mMaxY - mMinY + 1};
+    }
+  }
+
+  /// Returns the packed rows, each row is `words_per_row()` words long.
+  [[nodiscard]] auto words() const noexcept -> const std::vector<word_type>&
+  {
+    return mWords;
+  }
+
+  [[nodiscard]] auto words_per_row() const noexcept -> int { return mWordsPerRow; }
+
+  [[nodiscard]] auto width() const noexcept -> int { return mWidth; }
+
+  [[nodiscard]] auto height() const noexcept -> int { return mHeight; }
+
+  [[nodiscard]] auto size() const noexcept -> iarea { return {mWidth, mHeight}; }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mMaxX < mMinX; }
+
+ private:
+  std::vector<word_type> mWords;
+  int mWidth {};
+  int mHeight {};
+  int mWordsPerRow {};
+  int mMinX {0};
+  int mMinY {0};
+  int mMaxX {-1};  ///< Less than the minimum x-coordinate when there are no solid pixels.
+  int mMaxY {-1};
+
+  [[nodiscard]] auto word_index(const int x, const int y) const noexcept -> usize
+  {
+    return static_cast<usize>(y) * static_cast<usize>(mWordsPerRow) +
+           static_cast<usize>(x / word_bits);
+  }
+
+  void include(const ipoint point) noexcept
+  {
+    if (empty()) {
+      mMinX = mMaxX = point.x();
+      mMinY = mMaxY = point.y();
+    }
+    else {
+      mMinX = (detail::min)(mMinX, point.x());
+      mMinY = (detail::min)(mMinY, point.y());
+      mMaxX = (detail::max)(mMaxX, point.x());
+      mMaxY = (detail::max)(mMaxY, point.y());
+    }
+  }
+
+  void read_alpha(const SDL_Surface& source, const int alphaIndex, const uint8 threshold)
+  {
+    const auto* row = static_cast<const uint8*>(source.pixels);
+    for (int y = 0; y < mHeight; ++y, row += source.pitch) {
+      auto* words = mWords.data() + word_index(0, y);
+
+      for (int x = 0; x < mWidth; ++x) {
+        const auto solid = row[x * 4 + alphaIndex] >= threshold;
+        words[x / word_bits] |= word_type {solid} << static_cast<unsigned>(x % word_bits);
+      }
+
+      /* Only the first and last solid pixels of each row can grow the bounds */
+      int first = -1;
+      int last = -1;
+      for (int index = 0; index < mWordsPerRow; ++index) {
+        if (const auto word = words[index]) {
+          if (first == -1) {
+            first = index * word_bits + detail::countr_zero(word);
+          }
+
+          last = index * word_bits + last_bit(word);
+        }
+      }
+
+      if (first != -1) {
+        include({first, y});
+        include({last, y});
+      }
+    }
+  }
+
+  [[nodiscard]] static auto last_bit(word_type word) noexcept -> int
+  {
+    assert(word != 0);
+
+    int bit = 0;
+    while (word >>= 1u) {
+      ++bit;
+    }
+
+    return bit;
+  }
+
+  /* Returns the 64 bits of a row that start at a bit index, bits outside the row are zero */
+  [[nodiscard]] auto extract(const word_type* row, const int start) const noexcept
+      -> word_type
+  {
+    /* Rounds towards negative infinity, since the start is negative to the left of the row */
+    const auto index = (start >= 0) ? start / word_bits : (start - word_bits + 1) / word_bits;
+    const auto shift = static_cast<unsigned>(start - index * word_bits);
+
+    const auto low = (index >= 0 && index < mWordsPerRow) ? row[index] : word_type {0};
+    if (shift == 0) {
+      return low;
+    }
+
+    const auto next = index + 1;
+    const auto high = (next >= 0 && next < mWordsPerRow) ? row[next] : word_type {0};
+
+    return (low >> shift) | (high << (word_bits - shift));
+  }
+
+  /* Invokes a callback with every non-zero word of overlapping bits, until it returns false */
+  template <typename Callback>
+  void for_each_overlap_word(const collision_mask& other,
+                             const ipoint offset,
+                             Callback&& callback) const noexcept
+  {
+    if (empty() || other.empty()) {
+      return;
+    }
+
+    const auto a = bounds();
+    const auto b = other.bounds();
+
+    const auto minX = (detail::max)(a.x(), b.x() + offset.x());
+    const auto minY = (detail::max)(a.y(), b.y() + offset.y());
+    const auto maxX = (detail::min)(a.max_x(), b.max_x() + offset.x());
+    const auto maxY = (detail::min)(a.max_y(), b.max_y() + offset.y());
+
+    if (minX >= maxX || minY >= maxY) {
+      return;
+    }
+
+    const auto firstWord = minX / word_bits;
+    const auto lastWord = (maxX - 1) / word_bits;
+
+    const auto firstMask = ~word_type {0} << static_cast<unsigned>(minX % word_bits);
+    const auto lastBits = maxX - lastWord * word_bits;
+    const auto lastMask = (lastBits == word_bits)
+                              ? ~word_type {0}
+                              : (word_type {1} << static_cast<unsigned>(lastBits)) - 1u;
+
+    for (auto y = minY; y < maxY; ++y) {
+      const auto* row = mWords.data() + word_index(0, y);
+      const auto* otherRow = other.mWords.data() + other.word_index(0, y - offset.y());
+
+      for (auto index = firstWord; index <= lastWord; ++index) {
+        auto bits = row[index] & other.extract(otherRow, index * word_bits - offset.x());
+
+        if (index == firstWord) {
+          bits &= firstMask;
+        }
+
+        if (index == lastWord) {
+          bits &= lastMask;
+        }
+
+        if (bits && !callback(index * word_bits, y, bits)) {
+          return;
+        }
+      }
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_COLLISION_MASK_HPP_
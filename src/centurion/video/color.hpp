@@ -28,27 +28,52 @@
 #include <SDL.h>
 
 #include <cassert>      // assert
-#include <cmath>        // round, abs, fmod, lerp
-#include <iomanip>      // setfill, setw
-#include <ios>          // uppercase, hex
+#include <iterator>     // back_inserter, ostreambuf_iterator
 #include <optional>     // optional
-#include <ostream>      // ostream
-#include <sstream>      // stringstream
 #include <string>       // string, to_string
 #include <string_view>  // string_view
 
+#include "../common/errors.hpp"
+#include "../common/formatting.hpp"
 #include "../common/primitives.hpp"
+#include "../detail/color_kernels.hpp"
 #include "../detail/stdlib.hpp"
 #include "../features.hpp"
 
 #if CENTURION_HAS_FEATURE_FORMAT
 
-#include <format>  // format
+#include <format>  // format, format_to, formatter
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
 namespace cen {
 
+/// HSV-encoded color values, see `color::from_hsv()`.
+struct hsv final {
+  float hue {};         ///< The hue, in the range [0, 360].
+  float saturation {};  ///< The saturation, in the range [0, 100].
+  float value {};       ///< The value, in the range [0, 100].
+};
+
+/// HSL-encoded color values, see `color::from_hsl()`.
+struct hsl final {
+  float hue {};         ///< The hue, in the range [0, 360].
+  float saturation {};  ///< The saturation, in the range [0, 100].
+  float lightness {};   ///< The lightness, in the range [0, 100].
+};
+
 /**
  * A representation of an 8-bit RGBA color.
  *
@@ -90,7 +115,8 @@ class color final {
    *
    * \return an RGBA color converted from the HSV values.
    */
-  [[nodiscard]] static auto from_hsv(float hue, float saturation, float value) -> color
+  [[nodiscard]] static constexpr auto from_hsv(float hue, float saturation, float value)
+      -> color
   {
     hue = detail::clamp(hue, 0.0f, 360.0f);
     saturation = detail::clamp(saturation, 0.0f, 100.0f);
@@ -100,7 +126,9 @@ class color final {
     const auto chroma = v * (saturation / 100.0f);
     const auto hp = hue / 60.0f;
 
-    const auto x = chroma * (1.0f - std::abs(std::fmod(hp, 2.0f) - 1.0f));
+    /* Equivalent to std::fmod(hp, 2), which is exact for hp in [0, 6] */
+    const auto sector = hp - 2.0f * static_cast<float>(static_cast<int>(hp / 2.0f));
+    const auto x = chroma * (1.0f - detail::abs(sector - 1.0f));
 
     float red {};
     float green {};
@@ -139,9 +167,9 @@ class color final {
 
     const auto m = v - chroma;
 
-    const auto r = static_cast<uint8>(std::round((red + m) * 255.0f));
-    const auto g = static_cast<uint8>(std::round((green + m) * 255.0f));
-    const auto b = static_cast<uint8>(std::round((blue + m) * 255.0f));
+    const auto r = static_cast<uint8>(detail::round((red + m) * 255.0f));
+    const auto g = static_cast<uint8>(detail::round((green + m) * 255.0f));
+    const auto b = static_cast<uint8>(detail::round((blue + m) * 255.0f));
 
     return {r, g, b};
   }
@@ -157,7 +185,8 @@ class color final {
    *
    * \return an RGBA color converted from the HSL values.
    */
-  [[nodiscard]] static auto from_hsl(float hue, float saturation, float lightness) -> color
+  [[nodiscard]] static constexpr auto from_hsl(float hue, float saturation, float lightness)
+      -> color
   {
     hue = detail::clamp(hue, 0.0f, 360.0f);
     saturation = detail::clamp(saturation, 0.0f, 100.0f);
@@ -166,10 +195,12 @@ class color final {
     const auto s = saturation / 100.0f;
     const auto l = lightness / 100.0f;
 
-    const auto chroma = (1.0f - std::abs(2.0f * l - 1.0f)) * s;
+    const auto chroma = (1.0f - detail::abs(2.0f * l - 1.0f)) * s;
     const auto hp = hue / 60.0f;
 
-    const auto x = chroma * (1.0f - std::abs(std::fmod(hp, 2.0f) - 1.0f));
+    /* Equivalent to std::fmod(hp, 2), which is exact for hp in [0, 6] */
+    const auto sector = hp - 2.0f * static_cast<float>(static_cast<int>(hp / 2.0f));
+    const auto x = chroma * (1.0f - detail::abs(sector - 1.0f));
 
     float red {};
     float green {};
@@ -208,13 +239,126 @@ class color final {
 
     const auto m = l - (chroma / 2.0f);
 
-    const auto r = static_cast<uint8>(std::round((red + m) * 255.0f));
-    const auto g = static_cast<uint8>(std::round((green + m) * 255.0f));
-    const auto b = static_cast<uint8>(std::round((blue + m) * 255.0f));
+    const auto r = static_cast<uint8>(detail::round((red + m) * 255.0f));
+    const auto g = static_cast<uint8>(detail::round((green + m) * 255.0f));
+    const auto b = static_cast<uint8>(detail::round((blue + m) * 255.0f));
 
     return {r, g, b};
   }
 
+  /**
+   * Creates a color from integral HSV values, using only integer arithmetic.
+   *
+   * Unlike `from_hsv()`, this function can be used in constant expressions, e.g. to compute
+   * static palettes at compile-time. The channels are rounded to the nearest integer.
+   *
+   * \param hue the hue of the color, in the range [0, 360].
+   * \param saturation the saturation of the color, in the range [0, 100].
+   * \param value the value of the color, in the range [0, 100].
+   *
+   * \return an RGBA color converted from the HSV values.
+   */
+  [[nodiscard]] constexpr static auto from_hsv_int(int hue,
+                                                   int saturation,
+                                                   int value) noexcept -> color
+  {
+    hue = detail::clamp(hue, 0, 360);
+    saturation = detail::clamp(saturation, 0, 100);
+    value = detail::clamp(value, 0, 100);
+
+    /* Every term is scaled by 100 * 100 * 60, so that no precision is lost */
+    const auto chroma = value * saturation * 60;
+    const auto x = value * saturation * (60 - detail::abs(hue % 120 - 60));
+    const auto m = value * 100 * 60 - chroma;
+
+    /* The sectors include their upper bound, as with from_hsv() */
+    const auto sector = (hue == 0) ? 0 : (hue - 1) / 60;
+    return from_sector(sector, chroma, x, m);
+  }
+
+  /**
+   * Creates a color from integral HSL values, using only integer arithmetic.
+   *
+   * \param hue the hue of the color, in the range [0, 360].
+   * \param saturation the saturation of the color, in the range [0, 100].
+   * \param lightness the lightness of the color, in the range [0, 100].
+   *
+   * \return an RGBA color converted from the HSL values.
+   *
+   * \see from_hsv_int()
+   */
+  [[nodiscard]] constexpr static auto from_hsl_int(int hue,
+                                                   int saturation,
+                                                   int lightness) noexcept -> color
+  {
+    hue = detail::clamp(hue, 0, 360);
+    saturation = detail::clamp(saturation, 0, 100);
+    lightness = detail::clamp(lightness, 0, 100);
+
+    const auto spread = 100 - detail::abs(2 * lightness - 100);
+    const auto chroma = spread * saturation * 60;
+    const auto x = spread * saturation * (60 - detail::abs(hue % 120 - 60));
+    const auto m = lightness * 100 * 60 - chroma / 2;
+
+    return from_sector(hue / 60, chroma, x, m);
+  }
+
+  /**
+   * Converts a batch of HSV values to colors.
+   *
+   * Four colors are converted at a time when SIMD instructions are available. The results
+   * may differ from those of `from_hsv()` by one, due to a different order of operations.
+   *
+   * \param values the HSV values that will be converted.
+   * \param colors the colors that the results are written to, at least `count` of them.
+   * \param count the amount of values to convert.
+   */
+  static void from_hsv_n(const hsv* values, color* colors, const usize count) noexcept
+  {
+    static_assert(sizeof(color) == 4);
+    detail::hsv_colors(detail::best_simd_level(),
+                       values,
+                       reinterpret_cast<uint8*>(colors),
+                       count);
+  }
+
+  /**
+   * Converts a batch of HSL values to colors.
+   *
+   * The results may differ from those of `from_hsl()` by one, and a hue of 360 is treated
+   * like a hue of 0.
+   *
+   * \param values the HSL values that will be converted.
+   * \param colors the colors that the results are written to, at least `count` of them.
+   * \param count the amount of values to convert.
+   */
+  static void from_hsl_n(const hsl* values, color* colors, const usize count) noexcept
+  {
+    static_assert(sizeof(color) == 4);
+    detail::hsl_colors(detail::best_simd_level(),
+                       values,
+                       reinterpret_cast<uint8*>(colors),
+                       count);
+  }
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+  static void from_hsv_n(const std::span<const hsv> values,
+                         const std::span<color> colors) noexcept
+  {
+    assert(values.size() <= colors.size());
+    from_hsv_n(values.data(), colors.data(), values.size());
+  }
+
+  static void from_hsl_n(const std::span<const hsl> values,
+                         const std::span<color> colors) noexcept
+  {
+    assert(values.size() <= colors.size());
+    from_hsl_n(values.data(), colors.data(), values.size());
+  }
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
   /**
    * Attempts to create a color based on a hexadecimal RGB color code.
    *
@@ -227,7 +371,7 @@ class color final {
    * \see `from_rgba()`
    * \see `from_argb()`
    */
-  [[nodiscard]] static auto from_rgb(const std::string_view rgb) -> maybe<color>
+  [[nodiscard]] static constexpr auto from_rgb(const std::string_view rgb) -> maybe<color>
   {
     if (rgb.length() != 7 || rgb.at(0) != '#') {
       return nothing;
@@ -235,13 +379,9 @@ class color final {
 
     const auto noHash = rgb.substr(1);
 
-    const auto rr = noHash.substr(0, 2);
-    const auto gg = noHash.substr(2, 2);
-    const auto bb = noHash.substr(4, 2);
-
-    const auto red = detail::stoi<uint8>(rr, 16);
-    const auto green = detail::stoi<uint8>(gg, 16);
-    const auto blue = detail::stoi<uint8>(bb, 16);
+    const auto red = detail::parse_hex_byte(noHash[0], noHash[1]);
+    const auto green = detail::parse_hex_byte(noHash[2], noHash[3]);
+    const auto blue = detail::parse_hex_byte(noHash[4], noHash[5]);
 
     if (red && green && blue) {
       return color {*red, *green, *blue};
@@ -263,7 +403,7 @@ class color final {
    * \see `from_rgb()`
    * \see `from_argb()`
    */
-  [[nodiscard]] static auto from_rgba(const std::string_view rgba) -> maybe<color>
+  [[nodiscard]] static constexpr auto from_rgba(const std::string_view rgba) -> maybe<color>
   {
     if (rgba.length() != 9 || rgba.at(0) != '#') {
       return nothing;
@@ -271,15 +411,10 @@ class color final {
 
     const auto noHash = rgba.substr(1);
 
-    const auto rr = noHash.substr(0, 2);
-    const auto gg = noHash.substr(2, 2);
-    const auto bb = noHash.substr(4, 2);
-    const auto aa = noHash.substr(6, 2);
-
-    const auto red = detail::stoi<uint8>(rr, 16);
-    const auto green = detail::stoi<uint8>(gg, 16);
-    const auto blue = detail::stoi<uint8>(bb, 16);
-    const auto alpha = detail::stoi<uint8>(aa, 16);
+    const auto red = detail::parse_hex_byte(noHash[0], noHash[1]);
+    const auto green = detail::parse_hex_byte(noHash[2], noHash[3]);
+    const auto blue = detail::parse_hex_byte(noHash[4], noHash[5]);
+    const auto alpha = detail::parse_hex_byte(noHash[6], noHash[7]);
 
     if (red && green && blue && alpha) {
       return color {*red, *green, *blue, *alpha};
@@ -301,7 +436,7 @@ class color final {
    * \see `from_rgb()`
    * \see `from_rgba()`
    */
-  [[nodiscard]] static auto from_argb(const std::string_view argb) -> maybe<color>
+  [[nodiscard]] static constexpr auto from_argb(const std::string_view argb) -> maybe<color>
   {
     if (argb.length() != 9 || argb.at(0) != '#') {
       return nothing;
@@ -309,15 +444,10 @@ class color final {
 
     const auto noHash = argb.substr(1);
 
-    const auto aa = noHash.substr(0, 2);
-    const auto rr = noHash.substr(2, 2);
-    const auto gg = noHash.substr(4, 2);
-    const auto bb = noHash.substr(6, 2);
-
-    const auto alpha = detail::stoi<uint8>(aa, 16);
-    const auto red = detail::stoi<uint8>(rr, 16);
-    const auto green = detail::stoi<uint8>(gg, 16);
-    const auto blue = detail::stoi<uint8>(bb, 16);
+    const auto alpha = detail::parse_hex_byte(noHash[0], noHash[1]);
+    const auto red = detail::parse_hex_byte(noHash[2], noHash[3]);
+    const auto green = detail::parse_hex_byte(noHash[4], noHash[5]);
+    const auto blue = detail::parse_hex_byte(noHash[6], noHash[7]);
 
     if (alpha && red && green && blue) {
       return color {*red, *green, *blue, *alpha};
@@ -337,10 +467,10 @@ class color final {
     blue = detail::clamp(blue, 0.0f, 1.0f);
     alpha = detail::clamp(alpha, 0.0f, 1.0f);
 
-    const auto r = static_cast<uint8>(std::round(red * 255.0f));
-    const auto g = static_cast<uint8>(std::round(green * 255.0f));
-    const auto b = static_cast<uint8>(std::round(blue * 255.0f));
-    const auto a = static_cast<uint8>(std::round(alpha * 255.0f));
+    const auto r = static_cast<uint8>(detail::round(red * 255.0f));
+    const auto g = static_cast<uint8>(detail::round(green * 255.0f));
+    const auto b = static_cast<uint8>(detail::round(blue * 255.0f));
+    const auto a = static_cast<uint8>(detail::round(alpha * 255.0f));
 
     return color {r, g, b, a};
   }
@@ -396,15 +526,15 @@ class color final {
 #if CENTURION_HAS_FEATURE_FORMAT
     return std::format("#{:02X}{:02X}{:02X}", +mColor.r, +mColor.g, +mColor.b);
 #else
-    std::stringstream stream;
-    stream << std::setfill('0') << std::hex << std::uppercase;
+    std::string code = "#";
+    code.reserve(7);
 
-    stream << '#';
-    stream << std::setw(2) << +mColor.r;
-    stream << std::setw(2) << +mColor.g;
-    stream << std::setw(2) << +mColor.b;
+    auto out = std::back_inserter(code);
+    out = detail::write_hex(out, mColor.r);
+    out = detail::write_hex(out, mColor.g);
+    detail::write_hex(out, mColor.b);
 
-    return stream.str();
+    return code;
 #endif  // CENTURION_HAS_FEATURE_FORMAT
   }
 
@@ -427,16 +557,16 @@ class color final {
                        +mColor.b,
                        +mColor.a);
 #else
-    std::stringstream stream;
-    stream << std::setfill('0') << std::hex << std::uppercase;
+    std::string code = "#";
+    code.reserve(9);
 
-    stream << '#';
-    stream << std::setw(2) << +mColor.r;
-    stream << std::setw(2) << +mColor.g;
-    stream << std::setw(2) << +mColor.b;
-    stream << std::setw(2) << +mColor.a;
+    auto out = std::back_inserter(code);
+    out = detail::write_hex(out, mColor.r);
+    out = detail::write_hex(out, mColor.g);
+    out = detail::write_hex(out, mColor.b);
+    detail::write_hex(out, mColor.a);
 
-    return stream.str();
+    return code;
 #endif  // CENTURION_HAS_FEATURE_FORMAT
   }
 
@@ -459,16 +589,16 @@ class color final {
                        +mColor.g,
                        +mColor.b);
 #else
-    std::stringstream stream;
-    stream << std::setfill('0') << std::hex << std::uppercase;
+    std::string code = "#";
+    code.reserve(9);
 
-    stream << '#';
-    stream << std::setw(2) << +mColor.a;
-    stream << std::setw(2) << +mColor.r;
-    stream << std::setw(2) << +mColor.g;
-    stream << std::setw(2) << +mColor.b;
+    auto out = std::back_inserter(code);
+    out = detail::write_hex(out, mColor.a);
+    out = detail::write_hex(out, mColor.r);
+    out = detail::write_hex(out, mColor.g);
+    detail::write_hex(out, mColor.b);
 
-    return stream.str();
+    return code;
 #endif  // CENTURION_HAS_FEATURE_FORMAT
   }
 
@@ -491,6 +621,59 @@ class color final {
 
  private:
   SDL_Color mColor {0, 0, 0, 0xFF};
+
+  /* Assembles a color from the chroma, second largest and offset terms of a hue sector */
+  [[nodiscard]] constexpr static auto from_sector(const int sector,
+                                                  const int chroma,
+                                                  const int x,
+                                                  const int m) noexcept -> color
+  {
+    int red {};
+    int green {};
+    int blue {};
+
+    switch (sector) {
+      case 0:
+        red = chroma;
+        green = x;
+        break;
+
+      case 1:
+        red = x;
+        green = chroma;
+        break;
+
+      case 2:
+        green = chroma;
+        blue = x;
+        break;
+
+      case 3:
+        green = x;
+        blue = chroma;
+        break;
+
+      case 4:
+        red = x;
+        blue = chroma;
+        break;
+
+      case 5:
+        red = chroma;
+        blue = x;
+        break;
+
+      default:
+        break;
+    }
+
+    constexpr int scale = 100 * 100 * 60;
+    const auto to_channel = [](const int value) constexpr noexcept {
+      return static_cast<uint8>((value * 255 + scale / 2) / scale);
+    };
+
+    return {to_channel(red + m), to_channel(green + m), to_channel(blue + m)};
+  }
 };
 
 /**
@@ -524,16 +707,114 @@ class color final {
   return color::from_norm(red, green, blue, alpha);
 }
 
+/**
+ * Blends two colors, using only integer arithmetic.
+ *
+ * This is the constant expression counterpart of `blend()`, where the bias is expressed as
+ * a weight in the range [0, 255]. The channels are rounded to the nearest integer.
+ *
+ * \param a the first color.
+ * \param b the second color.
+ * \param weight the weight of the second color, where 0 yields `a` and 255 yields `b`.
+ *
+ * \return a color obtained by blending the two supplied colors.
+ */
+[[nodiscard]] constexpr auto blend_int(const color& a,
+                                       const color& b,
+                                       const uint8 weight = 128) noexcept -> color
+{
+  return {detail::blend_channel(a.red(), b.red(), weight),
+          detail::blend_channel(a.green(), b.green(), weight),
+          detail::blend_channel(a.blue(), b.blue(), weight),
+          detail::blend_channel(a.alpha(), b.alpha(), weight)};
+}
+
+/**
+ * Blends two batches of colors pairwise.
+ *
+ * Every result is equal to `blend_int()` with the bias scaled to a weight, which may differ
+ * by one from `blend()`. Four colors are blended at a time when SIMD instructions are
+ * available.
+ *
+ * \param a the first colors.
+ * \param b the second colors.
+ * \param out the colors that the results are written to, which may alias `a` or `b`.
+ * \param count the amount of colors in each batch.
+ * \param bias the bias that determines how the colors are blended, in the range [0, 1].
+ */
+inline void blend_n(const color* a,
+                    const color* b,
+                    color* out,
+                    const usize count,
+                    const float bias = 0.5f) noexcept
+{
+  assert(bias >= 0);
+  assert(bias <= 1.0f);
+
+  const auto weight = static_cast<uint8>(bias * 255.0f + 0.5f);
+  detail::blend_colors(detail::best_simd_level(),
+                       reinterpret_cast<const uint8*>(a),
+                       reinterpret_cast<const uint8*>(b),
+                       reinterpret_cast<uint8*>(out),
+                       count,
+                       weight);
+}
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+inline void blend_n(const std::span<const color> a,
+                    const std::span<const color> b,
+                    const std::span<color> out,
+                    const float bias = 0.5f) noexcept
+{
+  assert(a.size() == b.size());
+  assert(a.size() <= out.size());
+  blend_n(a.data(), b.data(), out.data(), a.size(), bias);
+}
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+/**
+ * Writes the RGBA hexadecimal representation of a color, without allocating.
+ *
+ * \return the output iterator past the last written character.
+ *
+ * \see `color::as_rgba()`
+ */
+template <typename OutputIt>
+auto format_to(OutputIt out, const color& color) -> OutputIt
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format_to(out,
+                        "#{:02X}{:02X}{:02X}{:02X}",
+                        +color.red(),
+                        +color.green(),
+                        +color.blue(),
+                        +color.alpha());
+#else
+  *out++ = '#';
+  out = detail::write_hex(out, color.red());
+  out = detail::write_hex(out, color.green());
+  out = detail::write_hex(out, color.blue());
+  return detail::write_hex(out, color.alpha());
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
 [[nodiscard]] inline auto to_string(const color& color) -> std::string
 {
   return color.as_rgba();
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const color& color) -> std::ostream&
 {
-  return stream << to_string(color);
+  format_to(std::ostreambuf_iterator<char> {stream}, color);
+  return stream;
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 [[nodiscard]] constexpr auto operator==(const color& a, const color& b) noexcept -> bool
 {
   return (a.red() == b.red()) && (a.green() == b.green()) && (a.blue() == b.blue()) &&
@@ -545,6 +826,63 @@ inline auto operator<<(std::ostream& stream, const color& color) -> std::ostream
   return !(a == b);
 }
 
+namespace literals {
+inline namespace color_literals {
+
+/**
+ * Creates a color from an RGB color code, e.g. `"#1A2B3C"_rgb`.
+ *
+ * Invalid color codes are reported as compilation errors in constant expressions.
+ *
+ * \throws exception if the color code is invalid.
+ */
+[[nodiscard]] constexpr auto operator""_rgb(const char* str, const usize size) -> color
+{
+  if (const auto color = color::from_rgb({str, size})) {
+    return *color;
+  }
+  else {
+    throw exception {"Invalid RGB color code!"};
+  }
+}
+
+/**
+ * Creates a color from an RGBA color code, e.g. `"#1A2B3CFF"_rgba`.
+ *
+ * Invalid color codes are reported as compilation errors in constant expressions.
+ *
+ * \throws exception if the color code is invalid.
+ */
+[[nodiscard]] constexpr auto operator""_rgba(const char* str, const usize size) -> color
+{
+  if (const auto color = color::from_rgba({str, size})) {
+    return *color;
+  }
+  else {
+    throw exception {"Invalid RGBA color code!"};
+  }
+}
+
+/**
+ * Creates a color from an ARGB color code, e.g. `"#FF1A2B3C"_argb`.
+ *
+ * Invalid color codes are reported as compilation errors in constant expressions.
+ *
+ * \throws exception if the color code is invalid.
+ */
+[[nodiscard]] constexpr auto operator""_argb(const char* str, const usize size) -> color
+{
+  if (const auto color = color::from_argb({str, size})) {
+    return *color;
+  }
+  else {
+    throw exception {"Invalid ARGB color code!"};
+  }
+}
+
+}  // namespace color_literals
+}  // namespace literals
+
 namespace colors {
 
 inline constexpr color transparent {0, 0, 0, 0};
@@ -704,4 +1042,11 @@ inline constexpr color dark_violet {0x94, 0, 0xD3};
 }  // namespace colors
 }  // namespace cen
 
+#if CENTURION_HAS_FEATURE_FORMAT
+
+template <>
+struct std::formatter<cen::color> : cen::detail::value_formatter<cen::color> {};
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
 #endif  // CENTURION_VIDEO_COLOR_HPP_
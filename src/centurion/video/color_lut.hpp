@@ -0,0 +1,669 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_COLOR_LUT_HPP_
+#define CENTURION_VIDEO_COLOR_LUT_HPP_
+
+#include <SDL.h>
+
+#include <array>    // array
+#include <cassert>  // assert
+#include <cmath>    // pow
+#include <cstring>  // memcpy
+#include <vector>   // vector
+
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/lut_kernels.hpp"
+#include "../detail/pixel_conversion.hpp"
+#include "../detail/stdlib.hpp"
+#include "color.hpp"
+#include "pixel_span.hpp"
+#include "pixels.hpp"
+#include "surface.hpp"
+#include "surface_ops.hpp"
+
+namespace cen {
+
+namespace detail {
+
+/* Maps a normalized channel value to eight bits, with rounding, NaN maps to zero */
+[[nodiscard]] inline auto to_lut_entry(const float value) noexcept -> uint8
+{
+  const auto clamped = (value >= 0.0f) ? (detail::min)(value, 1.0f) : 0.0f;
+  return static_cast<uint8>(clamped * 255.0f + 0.5f);
+}
+
+}  // namespace detail
+
+/**
+ * Per-channel lookup tables for tone adjustments, e.g. gamma correction.
+ *
+ * Every channel has a table with the replacement of each of its 256 values. The tables are
+ * built once, and then applied to any amount of pixels with `apply_lut()`, which replaces
+ * the per-pixel arithmetic of the adjustment with a lookup per channel. Several adjustments
+ * can be combined into a single set of tables with `then()`.
+ *
+ * \see color_cube
+ * \see apply_lut()
+ */
+class color_lut final {
+ public:
+  using table_type = std::array<uint8, 256>;
+
+  /// Creates tables that leave every color unchanged.
+  color_lut() noexcept
+  {
+    for (usize index = 0; index < mRed.size(); ++index) {
+      mRed[index] = static_cast<uint8>(index);
+    }
+
+    mGreen = mRed;
+    mBlue = mRed;
+    mAlpha = mRed;
+  }
+
+  /**
+   * Creates tables from a tone curve, which is applied to the color channels.
+   *
+   * \param curve a function object with the signature `float(float)`, which maps normalized
+   *        channel values in [0, 1] to new normalized values, which are clamped.
+   *
+   * \return tables that apply the curve to the red, green and blue channels, the alpha
+   * channel is left unchanged.
+   */
+  template <typename Curve>
+  [[nodiscard]] static auto from_curve(const Curve& curve) -> color_lut
+  {
+    color_lut lut;
+
+    for (usize index = 0; index < lut.mRed.size(); ++index) {
+      lut.mRed[index] = detail::to_lut_entry(curve(static_cast<float>(index) / 255.0f));
+    }
+
+    lut.mGreen = lut.mRed;
+    lut.mBlue = lut.mRed;
+
+    return lut;
+  }
+
+  /**
+   * Creates tables for gamma correction.
+   *
+   * \param gamma the gamma value, where values above one brighten the midtones and values
+   *        below one darken them. The tables compute `value ^ (1 / gamma)`.
+   *
+   * \return tables that apply the gamma correction to the color channels.
+   */
+  [[nodiscard]] static auto gamma(const float gamma) -> color_lut
+  {
+    assert(gamma > 0);
+
+    const auto exponent = 1.0f / gamma;
+    return from_curve([=](const float value) { return std::pow(value, exponent); });
+  }
+
+  /**
+   * Creates tables that adjust brightness and contrast.
+   *
+   * \param brightness the offset added to the normalized channels, in [-1, 1].
+   * \param contrast the factor applied to the distance of the channels from mid-gray, where
+   *        one leaves the contrast unchanged.
+   *
+   * \return tables that apply the adjustment to the color channels.
+   */
+  [[nodiscard]] static auto brightness_contrast(const float brightness, const float contrast)
+      -> color_lut
+  {
+    return from_curve([=](const float value) {
+      return (value - 0.5f) * contrast + 0.5f + brightness;
+    });
+  }
+
+  /**
+   * Combines these tables with other tables.
+   *
+   * \param next the tables that are applied after these tables.
+   *
+   * \return tables that have the same effect as applying these tables and then `next`.
+   */
+  [[nodiscard]] auto then(const color_lut& next) const noexcept -> color_lut
+  {
+    color_lut result;
+
+    for (usize index = 0; index < mRed.size(); ++index) {
+      result.mRed[index] = next.mRed[mRed[index]];
+      result.mGreen[index] = next.mGreen[mGreen[index]];
+      result.mBlue[index] = next.mBlue[mBlue[index]];
+      result.mAlpha[index] = next.mAlpha[mAlpha[index]];
+    }
+
+    return result;
+  }
+
+  /// Returns the color that a color is replaced with.
+  [[nodiscard]] auto apply(const color& input) const noexcept -> color
+  {
+    return {mRed[input.red()],
+            mGreen[input.green()],
+            mBlue[input.blue()],
+            mAlpha[input.alpha()]};
+  }
+
+  [[nodiscard]] auto red() noexcept -> table_type& { return mRed; }
+  [[nodiscard]] auto red() const noexcept -> const table_type& { return mRed; }
+
+  [[nodiscard]] auto green() noexcept -> table_type& { return mGreen; }
+  [[nodiscard]] auto green() const noexcept -> const table_type& { return mGreen; }
+
+  [[nodiscard]] auto blue() noexcept -> table_type& { return mBlue; }
+  [[nodiscard]] auto blue() const noexcept -> const table_type& { return mBlue; }
+
+  [[nodiscard]] auto alpha() noexcept -> table_type& { return mAlpha; }
+  [[nodiscard]] auto alpha() const noexcept -> const table_type& { return mAlpha; }
+
+ private:
+  table_type mRed {};
+  table_type mGreen {};
+  table_type mBlue {};
+  table_type mAlpha {};
+};
+
+/**
+ * A three-dimensional lookup table for color grading.
+ *
+ * The cube samples a color transform on a regular grid over the RGB color space, colors
+ * between the grid points are interpolated trilinearly. Unlike `color_lut`, cubes can
+ * express transforms that mix the channels, e.g. saturation changes or the looks exported
+ * by color grading tools. The alpha channel is left unchanged.
+ *
+ * \see color_lut
+ * \see apply_lut()
+ */
+class color_cube final {
+ public:
+  inline constexpr static int min_size = 2;
+  inline constexpr static int max_size = 65;
+
+  /**
+   * Creates a cube that leaves every color unchanged.
+   *
+   * \param size the amount of grid points along each axis, in [2, 65].
+   */
+  explicit color_cube(const int size = 17)
+      : mSize {(detail::clamp)(size, min_size, max_size)}
+      , mEntries(static_cast<usize>(mSize) * static_cast<usize>(mSize) *
+                 static_cast<usize>(mSize))
+  {
+    assert(size >= min_size && size <= max_size);
+
+    const auto steps = static_cast<float>(mSize - 1);
+    for (int index = 0; index < 256; ++index) {
+      const auto position = static_cast<float>(index) * steps / 255.0f;
+      const auto cell = (detail::min)(static_cast<int>(position), mSize - 2);
+
+      mCells[static_cast<usize>(index)] = cell;
+      mWeights[static_cast<usize>(index)] = position - static_cast<float>(cell);
+    }
+
+    for (int blue = 0; blue < mSize; ++blue) {
+      for (int green = 0; green < mSize; ++green) {
+        for (int red = 0; red < mSize; ++red) {
+          mEntries[offset_of(red, green, blue)] =
+              color {grid_value(red), grid_value(green), grid_value(blue)};
+        }
+      }
+    }
+  }
+
+  /**
+   * Creates a cube by sampling a color transform.
+   *
+   * \param transform a function object with the signature `color(const color&)`, which is
+   *        invoked once for every grid point.
+   * \param size the amount of grid points along each axis, in [2, 65].
+   *
+   * \return a cube that approximates the transform.
+   */
+  template <typename Transform>
+  [[nodiscard]] static auto from_function(const Transform& transform, const int size = 17)
+      -> color_cube
+  {
+    color_cube cube {size};
+
+    for (auto& entry : cube.mEntries) {
+      entry = transform(entry);
+    }
+
+    return cube;
+  }
+
+  /**
+   * Sets the color of a grid point.
+   *
+   * The grid points are ordered with red varying fastest, as in the common `.cube` format.
+   *
+   * \param red the index of the grid point along the red axis.
+   * \param green the index of the grid point along the green axis.
+   * \param blue the index of the grid point along the blue axis.
+   * \param value the color that the grid point is mapped to.
+   */
+  void set(const int red, const int green, const int blue, const color& value) noexcept
+  {
+    mEntries[offset_of(red, green, blue)] = value;
+  }
+
+  [[nodiscard]] auto at(const int red, const int green, const int blue) const noexcept
+      -> const color&
+  {
+    return mEntries[offset_of(red, green, blue)];
+  }
+
+  /// Returns the color that a color is replaced with, interpolated from the grid.
+  [[nodiscard]] auto apply(const color& input) const noexcept -> color
+  {
+    const auto red = mCells[input.red()];
+    const auto green = mCells[input.green()];
+    const auto blue = mCells[input.blue()];
+
+    const auto wr = mWeights[input.red()];
+    const auto wg = mWeights[input.green()];
+    const auto wb = mWeights[input.blue()];
+
+    const auto* c000 = mEntries[offset_of(red, green, blue)].data();
+    const auto* c100 = mEntries[offset_of(red + 1, green, blue)].data();
+    const auto* c010 = mEntries[offset_of(red, green + 1, blue)].data();
+    const auto* c110 = mEntries[offset_of(red + 1, green + 1, blue)].data();
+    const auto* c001 = mEntries[offset_of(red, green, blue + 1)].data();
+    const auto* c101 = mEntries[offset_of(red + 1, green, blue + 1)].data();
+    const auto* c011 = mEntries[offset_of(red, green + 1, blue + 1)].data();
+    const auto* c111 = mEntries[offset_of(red + 1, green + 1, blue + 1)].data();
+
+    const auto interpolate = [=](uint8 SDL_Color::*channel) {
+      const auto x00 = lerp(c000->*channel, c100->*channel, wr);
+      const auto x10 = lerp(c010->*channel, c110->*channel, wr);
+      const auto x01 = lerp(c001->*channel, c101->*channel, wr);
+      const auto x11 = lerp(c011->*channel, c111->*channel, wr);
+
+      const auto value = lerp(lerp(x00, x10, wg), lerp(x01, x11, wg), wb);
+      return static_cast<uint8>(value + 0.5f);
+    };
+
+    return {interpolate(&SDL_Color::r),
+            interpolate(&SDL_Color::g),
+            interpolate(&SDL_Color::b),
+            input.alpha()};
+  }
+
+  /// Returns the amount of grid points along each axis.
+  [[nodiscard]] auto size() const noexcept -> int { return mSize; }
+
+ private:
+  int mSize {};
+  std::vector<color> mEntries;
+  std::array<int, 256> mCells {};      ///< The grid cell of each channel value.
+  std::array<float, 256> mWeights {};  ///< The position of each channel value in its cell.
+
+  [[nodiscard]] auto offset_of(const int red, const int green, const int blue) const noexcept
+      -> usize
+  {
+    assert(red >= 0 && red < mSize);
+    assert(green >= 0 && green < mSize);
+    assert(blue >= 0 && blue < mSize);
+
+    const auto size = static_cast<usize>(mSize);
+    return (static_cast<usize>(blue) * size + static_cast<usize>(green)) * size +
+           static_cast<usize>(red);
+  }
+
+  [[nodiscard]] auto grid_value(const int index) const noexcept -> uint8
+  {
+    return static_cast<uint8>((index * 255 + (mSize - 1) / 2) / (mSize - 1));
+  }
+
+  [[nodiscard]] static auto lerp(const float a, const float b, const float t) noexcept
+      -> float
+  {
+    return a + (b - a) * t;
+  }
+};
+
+namespace detail {
+
+/* The byte positions of the channels of a 32-bit format with 8-bit channels, as integers */
+struct byte_channels final {
+  int red {};
+  int green {};
+  int blue {};
+  int alpha {-1};  ///< The alpha position, or -1 if the pixels are opaque.
+};
+
+[[nodiscard]] inline auto byte_channels_of(const SDL_PixelFormat& format) noexcept
+    -> maybe<byte_channels>
+{
+  const auto is_byte = [](const uint8 loss, const uint8 shift) {
+    return loss == 0 && shift % 8 == 0;
+  };
+
+  if (format.BytesPerPixel != 4 || !is_byte(format.Rloss, format.Rshift) ||
+      !is_byte(format.Gloss, format.Gshift) || !is_byte(format.Bloss, format.Bshift) ||
+      (format.Amask != 0 && !is_byte(format.Aloss, format.Ashift))) {
+    return nothing;
+  }
+
+  return byte_channels {format.Rshift / 8,
+                        format.Gshift / 8,
+                        format.Bshift / 8,
+                        (format.Amask != 0) ? format.Ashift / 8 : -1};
+}
+
+template <int RShift, int GShift, int BShift, int AShift, int ABits>
+[[nodiscard]] constexpr auto packed_channels_of(
+    const packed_pixel_traits<uint32, RShift, GShift, BShift, AShift, 8, ABits>*) noexcept
+    -> maybe<byte_channels>
+{
+  return byte_channels {RShift / 8, GShift / 8, BShift / 8, (ABits != 0) ? AShift / 8 : -1};
+}
+
+[[nodiscard]] constexpr auto packed_channels_of(const void*) noexcept -> maybe<byte_channels>
+{
+  return nothing;
+}
+
+[[nodiscard]] inline auto make_packed_lut(const color_lut& lut,
+                                          const byte_channels& channels) noexcept
+    -> packed_lut
+{
+  packed_lut packed;
+
+  const auto fill = [&](const int position, const color_lut::table_type* table) {
+    const auto shift = static_cast<uint32>(position) * 8u;
+    auto& entries = packed.entries[position];
+
+    for (usize index = 0; index < 256; ++index) {
+      const auto value = table ? (*table)[index] : static_cast<uint8>(index);
+      entries[index] = static_cast<uint32>(value) << shift;
+    }
+  };
+
+  /* Bytes without a channel, i.e. padding, are kept as they are */
+  for (int position = 0; position < 4; ++position) {
+    fill(position, nullptr);
+  }
+
+  fill(channels.red, &lut.red());
+  fill(channels.green, &lut.green());
+  fill(channels.blue, &lut.blue());
+
+  if (channels.alpha != -1) {
+    fill(channels.alpha, &lut.alpha());
+  }
+
+  return packed;
+}
+
+/* Returns a function object that transforms rows of 32-bit pixels, in place */
+[[nodiscard]] inline auto make_row_kernel(const color_lut& lut,
+                                          const byte_channels& channels) noexcept
+{
+  return [packed = make_packed_lut(lut, channels),
+          level = best_simd_level()](uint8* row, const usize width) noexcept {
+    apply_packed_lut(level, packed, row, width);
+  };
+}
+
+[[nodiscard]] inline auto make_row_kernel(const color_cube& cube,
+                                          const byte_channels& channels) noexcept
+{
+  return [&cube, channels](uint8* row, const usize width) noexcept {
+    const auto byte = [](const uint32 pixel, const int position) {
+      return static_cast<uint8>(pixel >> (static_cast<uint32>(position) * 8u));
+    };
+
+    const auto shifted = [](const uint8 value, const int position) {
+      return static_cast<uint32>(value) << (static_cast<uint32>(position) * 8u);
+    };
+
+    const auto mask = shifted(0xFF, channels.red) | shifted(0xFF, channels.green) |
+                      shifted(0xFF, channels.blue);
+
+    for (usize x = 0; x < width; ++x, row += 4) {
+      uint32 pixel;
+      std::memcpy(&pixel, row, 4);
+
+      const auto result = cube.apply(color {byte(pixel, channels.red),
+                                            byte(pixel, channels.green),
+                                            byte(pixel, channels.blue)});
+
+      /* The alpha and padding bytes are kept as they are */
+      pixel = (pixel & ~mask) | shifted(result.red(), channels.red) |
+              shifted(result.green(), channels.green) | shifted(result.blue(), channels.blue);
+
+      std::memcpy(row, &pixel, 4);
+    }
+  };
+}
+
+template <typename Lut>
+[[nodiscard]] auto transform_palette(SDL_Palette& palette, const Lut& lut) -> result
+{
+  std::vector<SDL_Color> colors(palette.colors, palette.colors + palette.ncolors);
+
+  for (auto& entry : colors) {
+    entry = lut.apply(color {entry}).get();
+  }
+
+  /* The palette is replaced through SDL, so that its version and the blit maps are updated */
+  return SDL_SetPaletteColors(&palette, colors.data(), 0, palette.ncolors) == 0;
+}
+
+template <typename Lut>
+[[nodiscard]] auto transform_surface(thread_pool* pool, SDL_Surface& surface, const Lut& lut)
+    -> result
+{
+  if (SDL_ISPIXELFORMAT_INDEXED(surface.format->format)) {
+    return surface.format->palette ? transform_palette(*surface.format->palette, lut)
+                                   : failure;
+  }
+
+  const auto channels = byte_channels_of(*surface.format);
+  if (!channels) {
+    return failure;
+  }
+
+  if (SDL_MUSTLOCK(&surface) && SDL_LockSurface(&surface) != 0) {
+    return failure;
+  }
+
+  const auto kernel = make_row_kernel(lut, *channels);
+  const auto width = static_cast<usize>(surface.w);
+
+  const auto transform_rows = [&](const int first, const int last) {
+    auto* row = static_cast<uint8*>(surface.pixels) + first * surface.pitch;
+    for (auto y = first; y < last; ++y, row += surface.pitch) {
+      kernel(row, width);
+    }
+  };
+
+  try {
+    if (pool && surface.h > 1) {
+      const auto bandHeight = band_height(*pool, surface.h);
+      const auto bands = static_cast<usize>((surface.h + bandHeight - 1) / bandHeight);
+
+      const auto task = [&](const usize band) {
+        const auto first = static_cast<int>(band) * bandHeight;
+        transform_rows(first, (detail::min)(first + bandHeight, surface.h));
+      };
+
+      pool->parallel_for(0, bands, task, 1);
+    }
+    else {
+      transform_rows(0, surface.h);
+    }
+  }
+  catch (...) {
+    if (SDL_MUSTLOCK(&surface)) {
+      SDL_UnlockSurface(&surface);
+    }
+
+    throw;
+  }
+
+  if (SDL_MUSTLOCK(&surface)) {
+    SDL_UnlockSurface(&surface);
+  }
+
+  return success;
+}
+
+template <pixel_format Format, typename Lut>
+void transform_span(thread_pool* pool, const pixel_span<Format>& span, const Lut& lut)
+{
+  constexpr auto channels =
+      packed_channels_of(static_cast<const pixel_traits<Format>*>(nullptr));
+
+  const auto for_each_row = [&](const auto& callable) {
+    if (pool) {
+      parallel_for_rows(*pool, span, callable);
+    }
+    else {
+      for (int y = 0; y < span.height(); ++y) {
+        callable(span.row(y), y);
+      }
+    }
+  };
+
+  if constexpr (channels.has_value()) {
+    const auto kernel = make_row_kernel(lut, *channels);
+    for_each_row([&](const pixel_row<Format> row, int) {
+      kernel(reinterpret_cast<uint8*>(row.data()), static_cast<usize>(row.width()));
+    });
+  }
+  else {
+    for_each_row([&](const pixel_row<Format> row, int) {
+      for (int x = 0; x < row.width(); ++x) {
+        row.set_color(x, lut.apply(row.color_at(x)));
+      }
+    });
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Replaces the colors of a surface with lookup tables, in place.
+ *
+ * Indexed surfaces are transformed by replacing the colors of their palettes, which is
+ * independent of the amount of pixels. Other surfaces must have four bytes per pixel with
+ * 8-bit channels, e.g. `argb8888` or `rgbx8888`, convert other surfaces first. The tables are
+ * applied to the stored channel values, so premultiplied pixels stay premultiplied only if the
+ * alpha channel is unchanged and the tables are linear.
+ *
+ * \param surface the surface that will be transformed.
+ * \param lut the tables that will be applied to the pixels.
+ *
+ * \return `success` if the surface was transformed; `failure` if the pixel format isn't
+ * supported or if the surface couldn't be locked.
+ */
+template <typename T>
+auto apply_lut(basic_surface<T>& surface, const color_lut& lut) -> result
+{
+  return detail::transform_surface(nullptr, *surface.get(), lut);
+}
+
+/**
+ * Replaces the colors of a surface with lookup tables, using a thread pool.
+ *
+ * The surface is split into bands of rows, which are transformed by the workers of the pool.
+ *
+ * \see apply_lut(basic_surface<T>&, const color_lut&)
+ */
+template <typename T>
+auto apply_lut(thread_pool& pool, basic_surface<T>& surface, const color_lut& lut) -> result
+{
+  return detail::transform_surface(&pool, *surface.get(), lut);
+}
+
+/**
+ * Replaces the colors of a surface with a color cube, in place.
+ *
+ * The supported surfaces are the same as for per-channel tables, the alpha channel is left
+ * unchanged.
+ *
+ * \see apply_lut(basic_surface<T>&, const color_lut&)
+ */
+template <typename T>
+auto apply_lut(basic_surface<T>& surface, const color_cube& cube) -> result
+{
+  return detail::transform_surface(nullptr, *surface.get(), cube);
+}
+
+/// Replaces the colors of a surface with a color cube, using a thread pool.
+template <typename T>
+auto apply_lut(thread_pool& pool, basic_surface<T>& surface, const color_cube& cube)
+    -> result
+{
+  return detail::transform_surface(&pool, *surface.get(), cube);
+}
+
+/**
+ * Replaces the colors of a pixel span with lookup tables, in place.
+ *
+ * Formats with 8-bit channels in 32-bit pixels use the same kernel as surfaces, other formats
+ * are transformed pixel by pixel through `pixel_traits`.
+ *
+ * \param span the pixels that will be transformed.
+ * \param lut the tables that will be applied to the pixels.
+ */
+template <pixel_format Format>
+void apply_lut(const pixel_span<Format>& span, const color_lut& lut)
+{
+  detail::transform_span(nullptr, span, lut);
+}
+
+/// Replaces the colors of a pixel span with lookup tables, using a thread pool.
+template <pixel_format Format>
+void apply_lut(thread_pool& pool, const pixel_span<Format>& span, const color_lut& lut)
+{
+  detail::transform_span(&pool, span, lut);
+}
+
+/// Replaces the colors of a pixel span with a color cube, in place.
+template <pixel_format Format>
+void apply_lut(const pixel_span<Format>& span, const color_cube& cube)
+{
+  detail::transform_span(nullptr, span, cube);
+}
+
+/// Replaces the colors of a pixel span with a color cube, using a thread pool.
+template <pixel_format Format>
+void apply_lut(thread_pool& pool, const pixel_span<Format>& span, const color_cube& cube)
+{
+  detail::transform_span(&pool, span, cube);
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_COLOR_LUT_HPP_
@@ -0,0 +1,239 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_DAMAGE_TRACKER_HPP_
+#define CENTURION_VIDEO_DAMAGE_TRACKER_HPP_
+
+#include <SDL.h>
+
+#include <cstddef>  // ptrdiff_t
+#include <vector>   // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../detail/stdlib.hpp"
+#include "renderer.hpp"
+#include "window.hpp"
+
+namespace cen {
+
+/**
+ * Tracks the areas of a render output that changed since the last presented frame.
+ *
+ * Damaged areas are clipped to the output bounds, and overlapping or touching areas are
+ * merged as they are added. If the number of areas exceeds the configured limit, all areas
+ * are collapsed into their bounding rectangle, since at that point individual updates are
+ * rarely cheaper than a single larger one.
+ *
+ * Use redraw() to render only the damaged areas, by invoking a callable for each area with
+ * the renderer clip set accordingly, and present() to push only those areas of a window
+ * surface to the screen. Partial redraws require the previous frame contents to be
+ * preserved, which is the case for window surfaces, software renderers and target textures,
+ * but usually not for the back buffer of a hardware renderer.
+ *
+ * \see basic_window::update_surface()
+ */
+class damage_tracker final {
+ public:
+  /**
+   * Creates a damage tracker for an output of the specified size.
+   *
+   * The whole output is initially considered to be damaged.
+   *
+   * \param bounds the size of the tracked output.
+   * \param maxRects the maximum amount of separate damaged areas, must be at least 1.
+   */
+  explicit damage_tracker(const iarea bounds, const usize maxRects = 16)
+      : mBounds {bounds}
+      , mMaxRects {(detail::max)(maxRects, usize {1})}
+  {
+    mRects.reserve(mMaxRects);
+    invalidate();
+  }
+
+  /**
+   * Marks an area of the output as damaged.
+   *
+   * The area is clipped to the output bounds, and ignored if nothing remains.
+   *
+   * \param area the damaged area.
+   */
+  void add(const irect& area)
+  {
+    auto damaged = clip(area);
+    if (!damaged.has_area()) {
+      return;
+    }
+
+    /* Keep absorbing tracked areas until the damaged area no longer touches any of them */
+    for (auto i = mRects.size(); i > 0; --i) {
+      const auto index = i - 1;
+      if (overlaps(mRects[index], damaged)) {
+        damaged = get_union(mRects[index], damaged);
+        mRects.erase(mRects.begin() + static_cast<std::ptrdiff_t>(index));
+        i = mRects.size() + 1;
+      }
+    }
+
+    if (mRects.size() < mMaxRects) {
+      mRects.push_back(damaged);
+    }
+    else {
+      for (const auto& rect : mRects) {
+        damaged = get_union(rect, damaged);
+      }
+
+      mRects.clear();
+      mRects.push_back(damaged);
+    }
+  }
+
+  /// Marks the whole output as damaged.
+  void invalidate()
+  {
+    mRects.clear();
+
+    const irect all {0, 0, mBounds.width, mBounds.height};
+    if (all.has_area()) {
+      mRects.push_back(all);
+    }
+  }
+
+  /// Discards all damaged areas, i.e. marks the output as up-to-date.
+  void clear() noexcept { mRects.clear(); }
+
+  /**
+   * Changes the size of the tracked output, which marks the whole output as damaged.
+   *
+   * \param bounds the new output size.
+   */
+  void resize(const iarea bounds)
+  {
+    mBounds = bounds;
+    invalidate();
+  }
+
+  /**
+   * Redraws each damaged area, with the renderer clip restricted to the area.
+   *
+   * The renderer clip is restored afterwards. The damaged areas are not cleared, so that they
+   * can still be presented with present().
+   *
+   * \param renderer the renderer used to redraw the damaged areas.
+   * \param callable the function object invoked with each damaged `irect`.
+   *
+   * \return `success` if the clip could be set for every area; `failure` otherwise.
+   */
+  template <typename T, typename Callable>
+  auto redraw(basic_renderer<T>& renderer, Callable&& callable) -> result
+  {
+    const auto previous = renderer.clip();
+
+    result res = success;
+    for (const auto& rect : mRects) {
+      if (renderer.set_clip(rect)) {
+        callable(rect);
+      }
+      else {
+        res = failure;
+      }
+    }
+
+    if (previous) {
+      renderer.set_clip(*previous);
+    }
+    else {
+      renderer.reset_clip();
+    }
+
+    return res;
+  }
+
+  /**
+   * Copies the damaged areas of a window surface to the screen, and clears the damage.
+   *
+   * \param window the window whose surface should be updated.
+   *
+   * \return `success` if the surface was updated; `failure` otherwise.
+   */
+  template <typename T>
+  auto present(basic_window<T>& window) -> result
+  {
+    if (window.update_surface(mRects)) {
+      clear();
+      return success;
+    }
+    else {
+      return failure;
+    }
+  }
+
+  /// Returns the damaged areas, which never overlap or touch each other.
+  [[nodiscard]] auto rects() const noexcept -> const std::vector<irect>& { return mRects; }
+
+  /// Returns the amount of separate damaged areas.
+  [[nodiscard]] auto count() const noexcept -> usize { return mRects.size(); }
+
+  /// Indicates whether there is nothing to redraw.
+  [[nodiscard]] auto empty() const noexcept -> bool { return mRects.empty(); }
+
+  /// Returns the total amount of damaged pixels.
+  [[nodiscard]] auto damaged_area() const noexcept -> int
+  {
+    int sum = 0;
+    for (const auto& rect : mRects) {
+      sum += rect.area();
+    }
+    return sum;
+  }
+
+  [[nodiscard]] auto bounds() const noexcept -> iarea { return mBounds; }
+
+  [[nodiscard]] auto max_rects() const noexcept -> usize { return mMaxRects; }
+
+ private:
+  std::vector<irect> mRects;
+  iarea mBounds;
+  usize mMaxRects;
+
+  [[nodiscard]] auto clip(const irect& area) const noexcept -> irect
+  {
+    const auto x = (detail::max)(area.x(), 0);
+    const auto y = (detail::max)(area.y(), 0);
+    const auto maxX = (detail::min)(area.max_x(), mBounds.width);
+    const auto maxY = (detail::min)(area.max_y(), mBounds.height);
+
+    if (maxX > x && maxY > y) {
+      return {x, y, maxX - x, maxY - y};
+    }
+    else {
+      return {};
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_DAMAGE_TRACKER_HPP_
@@ -27,13 +27,18 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/math.hpp"
 #include "../common/primitives.hpp"
 #include "pixels.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class orientation {
@@ -97,6 +102,8 @@ class display_mode final {
   [[nodiscard]] auto driver_data() const noexcept -> const void* { return mMode.driverdata; }
 
  private:
+  friend class display_registry;
+
   SDL_DisplayMode mMode {};
 
   explicit display_mode(const SDL_DisplayMode mode) : mMode {mode} {}
@@ -225,11 +232,15 @@ inline void set_screen_saver_enabled(const bool enabled) noexcept
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const orientation o) -> std::ostream&
 {
   return stream << to_string(o);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_VIDEO_DISPLAY_HPP_
@@ -0,0 +1,304 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_DISPLAY_REGISTRY_HPP_
+#define CENTURION_VIDEO_DISPLAY_REGISTRY_HPP_
+
+#include <SDL.h>
+
+#include <string>       // string
+#include <string_view>  // string_view
+#include <utility>      // move
+#include <vector>       // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../events/event_base.hpp"
+#include "display.hpp"
+
+namespace cen {
+
+/// A snapshot of the properties of a single display.
+struct display_info final {
+  int index {};
+  std::string name;
+  maybe<display_mode> current_mode;
+  maybe<display_mode> desktop_mode;
+  maybe<dpi_info> dpi;
+  maybe<irect> bounds;
+  maybe<irect> usable_bounds;
+  orientation orient {orientation::unknown};
+};
+
+/**
+ * Caches the properties of all connected displays.
+ *
+ * Querying display properties such as the DPI or the bounds may result in system calls on
+ * some platforms, which makes them unsuitable for code that runs every frame. The registry
+ * queries all displays once, and then only refreshes its cache when it is notified of display
+ * events, or window events that indicate that a window moved to another display.
+ *
+ * The generation counter is incremented whenever a refresh results in a different snapshot,
+ * so dependent caches, e.g. DPI-scaled layouts, can compare generations to decide when they
+ * need to be rebuilt.
+ */
+class display_registry final {
+ public:
+  using generation_type = uint64;
+
+  /// Creates a registry and queries the properties of all displays.
+  display_registry() { refresh(); }
+
+  /**
+   * Queries the properties of all displays.
+   *
+   * \return `true` if the display properties changed; `false` otherwise.
+   */
+  auto refresh() -> bool
+  {
+    std::vector<display_info> displays;
+
+    const auto count = SDL_GetNumVideoDisplays();
+    displays.reserve(static_cast<usize>((detail::max)(count, 0)));
+
+    for (int index = 0; index < count; ++index) {
+      displays.push_back(query(index));
+    }
+
+    if (same(displays, mDisplays)) {
+      return false;
+    }
+
+    mDisplays = std::move(displays);
+    ++mGeneration;
+
+    return true;
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+
+  /**
+   * Updates the registry using a display event.
+   *
+   * \param event the event that will be processed.
+   *
+   * \return `true` if the display properties changed; `false` otherwise.
+   */
+  auto update(const event_base<SDL_DisplayEvent>& event) -> bool
+  {
+    if (event.get().event != SDL_DISPLAYEVENT_NONE) {
+      return refresh();
+    }
+    else {
+      return false;
+    }
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+
+  /**
+   * Updates the registry using a window event.
+   *
+   * \details Only display change events trigger a refresh, since moving a window between
+   * displays with different scale factors may be accompanied by changed display properties.
+   *
+   * \param event the event that will be processed.
+   *
+   * \return `true` if the display properties changed; `false` otherwise.
+   */
+  auto update(const event_base<SDL_WindowEvent>& event) -> bool
+  {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (event.get().event == SDL_WINDOWEVENT_DISPLAY_CHANGED) {
+      return refresh();
+    }
+#else
+    static_cast<void>(event);
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+    return false;
+  }
+
+  /// Returns the cached properties of a display, which may be null.
+  [[nodiscard]] auto find(const int index) const noexcept -> const display_info*
+  {
+    if (index >= 0 && static_cast<usize>(index) < mDisplays.size()) {
+      return &mDisplays[static_cast<usize>(index)];
+    }
+    else {
+      return nullptr;
+    }
+  }
+
+  [[nodiscard]] auto name(const int index = 0) const -> maybe<std::string_view>
+  {
+    if (const auto* info = find(index)) {
+      return std::string_view {info->name};
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  [[nodiscard]] auto current_mode(const int index = 0) const -> maybe<display_mode>
+  {
+    const auto* info = find(index);
+    return info ? info->current_mode : nothing;
+  }
+
+  [[nodiscard]] auto desktop_mode(const int index = 0) const -> maybe<display_mode>
+  {
+    const auto* info = find(index);
+    return info ? info->desktop_mode : nothing;
+  }
+
+  [[nodiscard]] auto dpi(const int index = 0) const noexcept -> maybe<dpi_info>
+  {
+    const auto* info = find(index);
+    return info ? info->dpi : nothing;
+  }
+
+  [[nodiscard]] auto bounds(const int index = 0) const noexcept -> maybe<irect>
+  {
+    const auto* info = find(index);
+    return info ? info->bounds : nothing;
+  }
+
+  [[nodiscard]] auto usable_bounds(const int index = 0) const noexcept -> maybe<irect>
+  {
+    const auto* info = find(index);
+    return info ? info->usable_bounds : nothing;
+  }
+
+  [[nodiscard]] auto display_orientation(const int index = 0) const noexcept -> orientation
+  {
+    const auto* info = find(index);
+    return info ? info->orient : orientation::unknown;
+  }
+
+  /// Returns the index of the display whose bounds contain a point, if there is one.
+  [[nodiscard]] auto display_with(const ipoint& point) const noexcept -> maybe<int>
+  {
+    for (const auto& info : mDisplays) {
+      if (info.bounds && info.bounds->contains(point)) {
+        return info.index;
+      }
+    }
+
+    return nothing;
+  }
+
+  [[nodiscard]] auto displays() const noexcept -> const std::vector<display_info>&
+  {
+    return mDisplays;
+  }
+
+  [[nodiscard]] auto count() const noexcept -> usize { return mDisplays.size(); }
+
+  /// Returns a counter that is incremented every time the cached properties change.
+  [[nodiscard]] auto generation() const noexcept -> generation_type { return mGeneration; }
+
+ private:
+  std::vector<display_info> mDisplays;
+  generation_type mGeneration {};
+
+  [[nodiscard]] static auto query(const int index) -> display_info
+  {
+    display_info info;
+    info.index = index;
+
+    if (const char* name = SDL_GetDisplayName(index)) {
+      info.name = name;
+    }
+
+    SDL_DisplayMode mode {};
+    if (SDL_GetCurrentDisplayMode(index, &mode) == 0) {
+      info.current_mode = display_mode {mode};
+    }
+
+    if (SDL_GetDesktopDisplayMode(index, &mode) == 0) {
+      info.desktop_mode = display_mode {mode};
+    }
+
+    info.dpi = cen::display_dpi(index);
+    info.bounds = cen::display_bounds(index);
+    info.usable_bounds = cen::display_usable_bounds(index);
+    info.orient = cen::display_orientation(index);
+
+    return info;
+  }
+
+  [[nodiscard]] static auto same(const maybe<display_mode>& a,
+                                 const maybe<display_mode>& b) noexcept -> bool
+  {
+    if (a && b) {
+      return a->mMode.format == b->mMode.format && a->mMode.w == b->mMode.w &&
+             a->mMode.h == b->mMode.h && a->mMode.refresh_rate == b->mMode.refresh_rate;
+    }
+    else {
+      return a.has_value() == b.has_value();
+    }
+  }
+
+  [[nodiscard]] static auto same(const maybe<dpi_info>& a, const maybe<dpi_info>& b) noexcept
+      -> bool
+  {
+    if (a && b) {
+      return a->diagonal == b->diagonal && a->horizontal == b->horizontal &&
+             a->vertical == b->vertical;
+    }
+    else {
+      return a.has_value() == b.has_value();
+    }
+  }
+
+  [[nodiscard]] static auto same(const display_info& a, const display_info& b) noexcept
+      -> bool
+  {
+    return a.name == b.name && a.bounds == b.bounds && a.usable_bounds == b.usable_bounds &&
+           a.orient == b.orient && same(a.current_mode, b.current_mode) &&
+           same(a.desktop_mode, b.desktop_mode) && same(a.dpi, b.dpi);
+  }
+
+  [[nodiscard]] static auto same(const std::vector<display_info>& a,
+                                 const std::vector<display_info>& b) noexcept -> bool
+  {
+    if (a.size() != b.size()) {
+      return false;
+    }
+
+    for (usize index = 0; index < a.size(); ++index) {
+      if (!same(a[index], b[index])) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_DISPLAY_REGISTRY_HPP_
@@ -27,12 +27,17 @@
 
 #include <SDL.h>
 
-#include <ostream>      // ostream
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
 #include "../common/primitives.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 #if SDL_VERSION_ATLEAST(2, 0, 16)
@@ -60,11 +65,15 @@ enum class flash_op {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const flash_op op) -> std::ostream&
 {
   return stream << to_string(op);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 #endif  // SDL_VERSION_ATLEAST(2, 0, 16)
 
 }  // namespace cen
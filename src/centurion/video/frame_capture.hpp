@@ -0,0 +1,461 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_FRAME_CAPTURE_HPP_
+#define CENTURION_VIDEO_FRAME_CAPTURE_HPP_
+
+#include <SDL.h>
+
+#include <cstddef>     // ptrdiff_t
+#include <cstring>     // memcpy, strcmp
+#include <functional>  // function
+#include <utility>     // move
+#include <vector>      // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "renderer_info.hpp"
+#include "surface.hpp"
+
+#if !defined(CENTURION_NO_OPENGL) && SDL_VERSION_ATLEAST(2, 0, 10)
+#define CENTURION_HAS_PIXEL_BUFFER_READBACK
+#endif  // !defined(CENTURION_NO_OPENGL) && SDL_VERSION_ATLEAST(2, 0, 10)
+
+namespace cen {
+
+namespace detail {
+
+#ifdef CENTURION_HAS_PIXEL_BUFFER_READBACK
+
+#if defined(_WIN32) && !defined(_WIN64)
+#define CENTURION_GL_CALL __stdcall
+#else
+#define CENTURION_GL_CALL
+#endif  // defined(_WIN32) && !defined(_WIN64)
+
+/* The subset of OpenGL used to read the framebuffer into pixel buffer objects. The functions
+   are loaded from the context of the SDL renderer, so that no OpenGL headers are needed. */
+class gl_pixel_buffers final {
+ public:
+  inline constexpr static uint32 pack_buffer = 0x88EB;     /* GL_PIXEL_PACK_BUFFER */
+  inline constexpr static uint32 stream_read = 0x88E1;     /* GL_STREAM_READ */
+  inline constexpr static uint32 read_only = 0x88B8;       /* GL_READ_ONLY */
+  inline constexpr static uint32 pack_row_length = 0x0D02; /* GL_PACK_ROW_LENGTH */
+  inline constexpr static uint32 pack_alignment = 0x0D05;  /* GL_PACK_ALIGNMENT */
+  inline constexpr static uint32 rgba = 0x1908;            /* GL_RGBA */
+  inline constexpr static uint32 bgra = 0x80E1;            /* GL_BGRA */
+  inline constexpr static uint32 packed_8888 = 0x8367;     /* GL_UNSIGNED_INT_8_8_8_8_REV */
+
+  /// Loads the functions from the current context, if it is an OpenGL renderer.
+  template <typename T>
+  [[nodiscard]] static auto load(const basic_renderer<T>& renderer) -> maybe<gl_pixel_buffers>
+  {
+    const auto info = get_info(renderer);
+    if (!info || !info->name() || std::strcmp(info->name(), "opengl") != 0 ||
+        !SDL_GL_GetCurrentContext()) {
+      return nothing;
+    }
+
+    gl_pixel_buffers gl;
+    const auto ok = load(gl.gen_buffers, "glGenBuffers") &&
+                    load(gl.delete_buffers, "glDeleteBuffers") &&
+                    load(gl.bind_buffer, "glBindBuffer") &&
+                    load(gl.buffer_data, "glBufferData") &&
+                    load(gl.map_buffer, "glMapBuffer") &&
+                    load(gl.unmap_buffer, "glUnmapBuffer") &&
+                    load(gl.read_pixels, "glReadPixels") &&
+                    load(gl.pixel_store, "glPixelStorei");
+    if (ok) {
+      return gl;
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  void(CENTURION_GL_CALL* gen_buffers)(int, uint32*) {};
+  void(CENTURION_GL_CALL* delete_buffers)(int, const uint32*) {};
+  void(CENTURION_GL_CALL* bind_buffer)(uint32, uint32) {};
+  void(CENTURION_GL_CALL* buffer_data)(uint32, std::ptrdiff_t, const void*, uint32) {};
+  void*(CENTURION_GL_CALL* map_buffer)(uint32, uint32) {};
+  uint8(CENTURION_GL_CALL* unmap_buffer)(uint32) {};
+  void(CENTURION_GL_CALL* read_pixels)(int, int, int, int, uint32, uint32, void*) {};
+  void(CENTURION_GL_CALL* pixel_store)(uint32, int) {};
+
+ private:
+  template <typename Function>
+  [[nodiscard]] static auto load(Function& function, const char* name) noexcept -> bool
+  {
+    function = reinterpret_cast<Function>(SDL_GL_GetProcAddress(name));
+    return function != nullptr;
+  }
+};
+
+#undef CENTURION_GL_CALL
+
+#endif  // CENTURION_HAS_PIXEL_BUFFER_READBACK
+
+}  // namespace detail
+
+/**
+ * Captures rendered frames and processes them on worker threads.
+ *
+ * Unlike `renderer::capture()`, a frame capture reuses a ring of surfaces, so capturing
+ * doesn't allocate, and the captured frames are handed to a callback that runs on a thread
+ * pool, e.g. to encode them. A slot in the ring is only reused once its callback has
+ * finished.
+ *
+ * With the OpenGL backend, `argb8888` and `abgr8888` frames are read asynchronously into
+ * pixel buffer objects, and each frame is passed to the callback `latency` frames after it
+ * was captured. This avoids stalling the GPU. Other backends read the pixels synchronously,
+ * and the frames are passed on immediately.
+ *
+ * The frame capture must be destroyed before its renderer.
+ *
+ * \see renderer::capture()
+ */
+class frame_capture final {
+ public:
+  using size_type = usize;
+
+  /// The callback for captured frames, invoked with the frame and its index.
+  using callback_type = std::function<void(const surface&, uint64)>;
+
+  /**
+   * Creates a frame capture.
+   *
+   * \param pool the thread pool that invokes the callback.
+   * \param callback the function object invoked for every captured frame.
+   * \param latency the amount of frames in flight, i.e. the size of the ring.
+   * \param format the pixel format of the captured frames.
+   *
+   * \throws exception if the callback is empty.
+   */
+  frame_capture(thread_pool& pool,
+                callback_type callback,
+                const size_type latency = 2,
+                const pixel_format format = pixel_format::argb8888)
+      : mPool {&pool}
+      , mCallback {std::move(callback)}
+      , mLatency {(detail::max)(latency, size_type {1})}
+      , mFormat {format}
+  {
+    if (!mCallback) {
+      throw exception {"Cannot create frame capture with empty callback!"};
+    }
+  }
+
+  CENTURION_DISABLE_COPY(frame_capture)
+  CENTURION_DISABLE_MOVE(frame_capture)
+
+  ~frame_capture() noexcept
+  {
+    for (auto& slot : mSlots) {
+      try {
+        slot.task.wait();
+      }
+      catch (...) {
+        /* Errors are reported by capture() and flush(), there is no one to report to here */
+      }
+    }
+
+    release_buffers();
+  }
+
+  /**
+   * Captures the current frame of a renderer.
+   *
+   * This should be called after rendering a frame, but before presenting it.
+   *
+   * \param renderer the renderer whose output is captured.
+   *
+   * \return `success` if the frame was captured; `failure` otherwise.
+   *
+   * \throws any exception thrown by the callback for an earlier frame.
+   */
+  template <typename T>
+  auto capture(const basic_renderer<T>& renderer) -> result
+  {
+    const auto size = renderer.output_size();
+    if (mSlots.empty() || size != mSize) {
+      flush(renderer);
+      allocate(renderer, size);
+    }
+
+    auto& slot = mSlots[mNext];
+    mNext = (mNext + 1u) % mSlots.size();
+
+#ifdef CENTURION_HAS_PIXEL_BUFFER_READBACK
+    if (mGL) {
+      if (slot.pending && !resolve(slot)) {
+        return failure;
+      }
+
+      return read_into_buffer(renderer, slot);
+    }
+#endif  // CENTURION_HAS_PIXEL_BUFFER_READBACK
+
+    /* The surface might still be used by the callback for an earlier frame */
+    slot.task.wait();
+
+    if (!slot.image.lock()) {
+      return failure;
+    }
+
+    const auto res = SDL_RenderReadPixels(renderer.get(),
+                                          nullptr,
+                                          to_underlying(mFormat),
+                                          slot.image.pixel_data(),
+                                          slot.image.pitch());
+    slot.image.unlock();
+
+    if (res != 0) {
+      return failure;
+    }
+
+    slot.frame = mCount++;
+    submit(slot);
+
+    return success;
+  }
+
+  /**
+   * Passes all frames in flight to the callback, and waits for the callbacks to finish.
+   *
+   * \param renderer the renderer that was used to capture the frames.
+   *
+   * \throws any exception thrown by a callback.
+   */
+  template <typename T>
+  void flush([[maybe_unused]] const basic_renderer<T>& renderer)
+  {
+#ifdef CENTURION_HAS_PIXEL_BUFFER_READBACK
+    if (mGL) {
+      SDL_RenderFlush(renderer.get());
+
+      /* The oldest frame is in the next slot */
+      for (size_type offset = 0; offset < mSlots.size(); ++offset) {
+        auto& slot = mSlots[(mNext + offset) % mSlots.size()];
+        if (slot.pending) {
+          resolve(slot);
+        }
+      }
+    }
+#endif  // CENTURION_HAS_PIXEL_BUFFER_READBACK
+
+    for (auto& slot : mSlots) {
+      slot.task.wait();
+    }
+  }
+
+  /// Returns the amount of frames that have been captured.
+  [[nodiscard]] auto count() const noexcept -> uint64 { return mCount; }
+
+  /// Returns the maximum amount of frames in flight.
+  [[nodiscard]] auto latency() const noexcept -> size_type { return mLatency; }
+
+  [[nodiscard]] auto format() const noexcept -> pixel_format { return mFormat; }
+
+  /// Indicates whether frames are read asynchronously, using OpenGL pixel buffer objects.
+  [[nodiscard]] auto uses_pixel_buffers() const noexcept -> bool
+  {
+#ifdef CENTURION_HAS_PIXEL_BUFFER_READBACK
+    return mGL.has_value();
+#else
+    return false;
+#endif  // CENTURION_HAS_PIXEL_BUFFER_READBACK
+  }
+
+ private:
+  struct slot final {
+    surface image;
+    task_handle task;  ///< The callback that uses the surface.
+    uint64 frame {};   ///< The index of the frame in the slot.
+    uint32 buffer {};  ///< The associated pixel buffer object, if any.
+    bool pending {};   ///< Indicates whether the pixel buffer holds an unresolved frame.
+    bool flip {};      ///< Indicates whether the pixel buffer rows are stored bottom-up.
+  };
+
+  thread_pool* mPool {};
+  callback_type mCallback;
+  size_type mLatency {};
+  pixel_format mFormat {};
+  iarea mSize {};
+  std::vector<slot> mSlots;
+  size_type mNext {};
+  uint64 mCount {};
+
+#ifdef CENTURION_HAS_PIXEL_BUFFER_READBACK
+  maybe<detail::gl_pixel_buffers> mGL;
+  bool mLoadedGL {};
+#endif  // CENTURION_HAS_PIXEL_BUFFER_READBACK
+
+  void submit(slot& slot)
+  {
+    slot.task = mPool->submit(
+        [&callback = mCallback, &image = slot.image, frame = slot.frame] {
+          callback(image, frame);
+        });
+  }
+
+  template <typename T>
+  void allocate([[maybe_unused]] const basic_renderer<T>& renderer, const iarea& size)
+  {
+    release_buffers();
+
+    mSlots.clear();
+    mSlots.reserve(mLatency);
+
+    for (size_type index = 0; index < mLatency; ++index) {
+      mSlots.push_back(slot {surface {size, mFormat}, task_handle {}});
+    }
+
+    mSize = size;
+    mNext = 0;
+
+#ifdef CENTURION_HAS_PIXEL_BUFFER_READBACK
+    if (!mLoadedGL) {
+      mLoadedGL = true;
+      if (mFormat == pixel_format::argb8888 || mFormat == pixel_format::abgr8888) {
+        mGL = detail::gl_pixel_buffers::load(renderer);
+      }
+    }
+
+    if (mGL) {
+      const auto bytes = static_cast<std::ptrdiff_t>(size.width) * size.height * 4;
+      for (auto& slot : mSlots) {
+        mGL->gen_buffers(1, &slot.buffer);
+        mGL->bind_buffer(detail::gl_pixel_buffers::pack_buffer, slot.buffer);
+        mGL->buffer_data(detail::gl_pixel_buffers::pack_buffer,
+                         bytes,
+                         nullptr,
+                         detail::gl_pixel_buffers::stream_read);
+      }
+
+      mGL->bind_buffer(detail::gl_pixel_buffers::pack_buffer, 0);
+    }
+#endif  // CENTURION_HAS_PIXEL_BUFFER_READBACK
+  }
+
+  void release_buffers() noexcept
+  {
+#ifdef CENTURION_HAS_PIXEL_BUFFER_READBACK
+    if (mGL) {
+      for (auto& slot : mSlots) {
+        if (slot.buffer != 0) {
+          mGL->delete_buffers(1, &slot.buffer);
+          slot.buffer = 0;
+        }
+      }
+    }
+#endif  // CENTURION_HAS_PIXEL_BUFFER_READBACK
+  }
+
+#ifdef CENTURION_HAS_PIXEL_BUFFER_READBACK
+
+  /* Starts an asynchronous transfer of the current frame into the pixel buffer of a slot */
+  template <typename T>
+  auto read_into_buffer(const basic_renderer<T>& renderer, slot& slot) -> result
+  {
+    using detail::gl_pixel_buffers;
+
+    /* Executes the pending render commands, and makes the renderer context current */
+    if (SDL_RenderFlush(renderer.get()) != 0) {
+      return failure;
+    }
+
+    /* Render targets are stored top-down by SDL, unlike the default framebuffer */
+    slot.flip = SDL_GetRenderTarget(renderer.get()) == nullptr;
+
+    const auto format =
+        (mFormat == pixel_format::argb8888) ? gl_pixel_buffers::bgra : gl_pixel_buffers::rgba;
+
+    /* SDL_RenderReadPixels() changes the row length without restoring it */
+    mGL->pixel_store(gl_pixel_buffers::pack_alignment, 4);
+    mGL->pixel_store(gl_pixel_buffers::pack_row_length, 0);
+
+    mGL->bind_buffer(gl_pixel_buffers::pack_buffer, slot.buffer);
+    mGL->read_pixels(0,
+                     0,
+                     mSize.width,
+                     mSize.height,
+                     format,
+                     gl_pixel_buffers::packed_8888,
+                     nullptr);
+    mGL->bind_buffer(gl_pixel_buffers::pack_buffer, 0);
+
+    slot.frame = mCount++;
+    slot.pending = true;
+
+    return success;
+  }
+
+  /* Copies a finished transfer into the surface of a slot, and passes it to the callback */
+  auto resolve(slot& slot) -> result
+  {
+    using detail::gl_pixel_buffers;
+
+    slot.task.wait();
+    slot.pending = false;
+
+    mGL->bind_buffer(gl_pixel_buffers::pack_buffer, slot.buffer);
+
+    auto* data =
+        static_cast<const uint8*>(mGL->map_buffer(gl_pixel_buffers::pack_buffer,
+                                                  gl_pixel_buffers::read_only));
+    if (!data) {
+      mGL->bind_buffer(gl_pixel_buffers::pack_buffer, 0);
+      return failure;
+    }
+
+    const auto rowSize = static_cast<std::ptrdiff_t>(mSize.width) * 4;
+    auto* pixels = static_cast<uint8*>(slot.image.pixel_data());
+
+    for (int y = 0; y < mSize.height; ++y) {
+      const auto row = slot.flip ? (mSize.height - 1 - y) : y;
+      std::memcpy(pixels + static_cast<std::ptrdiff_t>(y) * slot.image.pitch(),
+                  data + static_cast<std::ptrdiff_t>(row) * rowSize,
+                  static_cast<usize>(rowSize));
+    }
+
+    mGL->unmap_buffer(gl_pixel_buffers::pack_buffer);
+    mGL->bind_buffer(gl_pixel_buffers::pack_buffer, 0);
+
+    submit(slot);
+    return success;
+  }
+
+#endif  // CENTURION_HAS_PIXEL_BUFFER_READBACK
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_FRAME_CAPTURE_HPP_
@@ -0,0 +1,442 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_FRAME_PACER_HPP_
+#define CENTURION_VIDEO_FRAME_PACER_HPP_
+
+#include <SDL.h>
+
+#include <cmath>        // llround
+#include <string>       // string
+#include <string_view>  // string_view
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "../system/timer.hpp"
+#include "display.hpp"
+#include "opengl.hpp"
+#include "renderer.hpp"
+#include "window.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// Represents the different strategies used to pace frames.
+enum class pacing_mode {
+  vsync,           ///< Presentation waits for the vertical blank.
+  late_swap_tear,  ///< Like vsync, but late frames are presented immediately, with tearing.
+  limiter          ///< Presentation is immediate, and the pacer sleeps until the next frame.
+};
+
+[[nodiscard]] constexpr auto to_string(const pacing_mode mode) -> std::string_view
+{
+  switch (mode) {
+    case pacing_mode::vsync:
+      return "vsync";
+
+    case pacing_mode::late_swap_tear:
+      return "late_swap_tear";
+
+    case pacing_mode::limiter:
+      return "limiter";
+
+    default:
+      throw exception {"Did not recognize pacing mode!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const pacing_mode mode) -> std::ostream&
+{
+  return stream << to_string(mode);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/// The configuration of a frame pacer.
+struct frame_pacer_options final {
+  double refresh_rate {60};               ///< The target frame rate, in Hz.
+  usize window {120};                     ///< The amount of frames between evaluations.
+  double miss_tolerance {0.05};           ///< The tolerated fraction of missed frames.
+  bool allow_tearing {true};              ///< Allows late frames to tear instead of waiting.
+  pacing_mode mode {pacing_mode::vsync};  ///< The initial strategy.
+};
+
+/**
+ * Presents frames at a consistent rate, and adapts the pacing strategy to the system.
+ *
+ * The pacer starts out with the configured mode, and measures the time between presented
+ * frames. Frames that take more than one and a half refresh periods are counted as missed.
+ * Every few frames, the pacer reconsiders its strategy.
+ *
+ * - If vsync misses too many frames, the pacer switches to late swap tearing where that is
+ *   allowed and supported, so that late frames tear instead of being held for a whole
+ *   refresh period.
+ * - If frames are presented noticeably faster than the refresh rate, vsync is evidently not
+ *   in effect, e.g. because the driver overrides it, and the pacer switches to sleep-based
+ *   limiting.
+ *
+ * Strategies that cannot be applied fall back to vsync, and then to the limiter.
+ *
+ * \see display_mode::refresh_rate()
+ */
+class frame_pacer final {
+ public:
+  using size_type = usize;
+
+  explicit frame_pacer(const frame_pacer_options& options = {})
+      : mOptions {options}
+      , mFrequency {frequency()}
+      , mMode {options.mode}
+      , mCanTear {options.allow_tearing}
+  {
+    if (mOptions.refresh_rate <= 0) {
+      throw exception {"Invalid frame pacer refresh rate!"};
+    }
+
+    mOptions.window = (detail::max)(mOptions.window, size_type {1});
+    mPeriod = static_cast<uint64>(static_cast<double>(mFrequency) / mOptions.refresh_rate);
+  }
+
+  /**
+   * Creates a frame pacer that targets the refresh rate of a display.
+   *
+   * \param index the index of the display.
+   * \param options the pacer configuration, the refresh rate is only used if the display
+   * doesn't report one.
+   *
+   * \return a frame pacer for the display.
+   */
+  [[nodiscard]] static auto for_display(const int index = 0,
+                                        frame_pacer_options options = {}) -> frame_pacer
+  {
+    if (const auto rate = display_mode::current(index).refresh_rate()) {
+      options.refresh_rate = static_cast<double>(*rate);
+    }
+
+    return frame_pacer {options};
+  }
+
+  /// Presents the current frame of a renderer, according to the current strategy.
+  template <typename T>
+  void present(basic_renderer<T>& renderer)
+  {
+    apply([&](const pacing_mode mode) -> result {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+      switch (mode) {
+        case pacing_mode::vsync:
+          return renderer.set_vsync(true);
+
+        case pacing_mode::limiter:
+          renderer.set_vsync(false);
+          return success;
+
+        default:
+          return failure;
+      }
+#else
+      /* The vsync state of the renderer cannot be changed */
+      return mode == pacing_mode::limiter;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+    });
+
+    sleep_until_deadline();
+
+    const auto start = now();
+    renderer.present();
+    record(start, now());
+  }
+
+#ifndef CENTURION_NO_OPENGL
+
+  /// Swaps the buffers of an OpenGL window, according to the current strategy.
+  template <typename T>
+  void swap(basic_window<T>& window)
+  {
+    apply([](const pacing_mode mode) -> result {
+      switch (mode) {
+        case pacing_mode::vsync:
+          return gl::set_swap_interval(gl_swap_interval::synchronized);
+
+        case pacing_mode::late_swap_tear:
+          return gl::set_swap_interval(gl_swap_interval::late_immediate);
+
+        case pacing_mode::limiter:
+          gl::set_swap_interval(gl_swap_interval::immediate);
+          return success;
+
+        default:
+          return failure;
+      }
+    });
+
+    sleep_until_deadline();
+
+    const auto start = now();
+    gl::swap(window);
+    record(start, now());
+  }
+
+#endif  // CENTURION_NO_OPENGL
+
+  /**
+   * Waits until the next frame is due, if the pacer uses the limiter.
+   *
+   * The pacer sleeps for most of the remaining time, and busy-waits for the last
+   * millisecond or two, since sleeping is too coarse for consistent frame times. This is
+   * only needed when presenting frames manually.
+   *
+   * \see record()
+   */
+  void sleep_until_deadline() noexcept
+  {
+    if (mMode != pacing_mode::limiter || mDeadline == 0) {
+      return;
+    }
+
+    const auto slack = mFrequency / 500u;  // 2 ms
+    for (auto current = now(); current < mDeadline; current = now()) {
+      const auto remaining = mDeadline - current;
+      if (remaining > slack) {
+        SDL_Delay(static_cast<uint32>((remaining - slack) * 1'000u / mFrequency));
+      }
+    }
+  }
+
+  /**
+   * Records a presented frame.
+   *
+   * This is done by `present()` and `swap()`, and is only needed when presenting frames
+   * manually, e.g. with Vulkan.
+   *
+   * \param start the value of the high-performance counter before presenting.
+   * \param end the value of the high-performance counter after presenting.
+   */
+  void record(const uint64 start, const uint64 end) noexcept
+  {
+    mPresentTime = end - start;
+
+    if (mLastPresent != 0) {
+      const auto interval = end - mLastPresent;
+      mFrameTime = interval;
+
+      ++mFrames;
+      ++mWindowFrames;
+      mWindowTime += interval;
+
+      /* A frame counts as missed once it is closer to two periods than to one */
+      if (interval * 2u > mPeriod * 3u) {
+        const auto periods = std::llround(static_cast<double>(interval) /
+                                          static_cast<double>(mPeriod));
+        const auto missed = static_cast<uint64>((detail::max)(periods - 1, 1ll));
+        mMissed += missed;
+        mWindowMissed += missed;
+      }
+    }
+
+    mLastPresent = end;
+
+    if (mMode == pacing_mode::limiter) {
+      /* Start over after a hitch, instead of rushing several frames to catch up */
+      mDeadline = (mDeadline == 0 || end > mDeadline + mPeriod) ? end + mPeriod
+                                                                : mDeadline + mPeriod;
+    }
+
+    if (mWindowFrames >= mOptions.window) {
+      evaluate();
+    }
+  }
+
+  /**
+   * Changes the target frame rate.
+   *
+   * The pacer starts over with the configured initial strategy, since a strategy that suited
+   * the previous rate might not suit the new one. Rates below the refresh rate of the display
+   * are enforced by the limiter, which the pacer switches to after the next evaluation.
+   *
+   * \param rate the new target frame rate, in Hz.
+   *
+   * \throws exception if the rate isn't positive.
+   */
+  void set_refresh_rate(const double rate)
+  {
+    if (rate <= 0) {
+      throw exception {"Invalid frame pacer refresh rate!"};
+    }
+
+    mOptions.refresh_rate = rate;
+    mPeriod = static_cast<uint64>(static_cast<double>(mFrequency) / rate);
+    mCanTear = mOptions.allow_tearing;
+
+    mWindowFrames = 0;
+    mWindowTime = 0;
+    mWindowMissed = 0;
+
+    switch_to(mOptions.mode);
+  }
+
+  /// Returns the current pacing strategy.
+  [[nodiscard]] auto mode() const noexcept -> pacing_mode { return mMode; }
+
+  /// Returns the target frame rate, in Hz.
+  [[nodiscard]] auto refresh_rate() const noexcept -> double { return mOptions.refresh_rate; }
+
+  /// Returns the amount of frames presented, excluding the first.
+  [[nodiscard]] auto frame_count() const noexcept -> uint64 { return mFrames; }
+
+  /// Returns the amount of refresh periods that frames have missed.
+  [[nodiscard]] auto missed_frames() const noexcept -> uint64 { return mMissed; }
+
+  /// Returns the time between the two latest presented frames.
+  [[nodiscard]] auto frame_time() const noexcept(noexcept(seconds<double> {}))
+      -> seconds<double>
+  {
+    return to_seconds(mFrameTime);
+  }
+
+  /// Returns the time that the latest frame spent presenting, including any vsync wait.
+  [[nodiscard]] auto present_time() const noexcept(noexcept(seconds<double> {}))
+      -> seconds<double>
+  {
+    return to_seconds(mPresentTime);
+  }
+
+ private:
+  frame_pacer_options mOptions;
+  uint64 mFrequency {};
+  uint64 mPeriod {};
+  pacing_mode mMode {};
+  bool mApplied {};
+  bool mCanTear {};
+
+  uint64 mLastPresent {};
+  uint64 mDeadline {};
+  uint64 mFrameTime {};
+  uint64 mPresentTime {};
+  uint64 mFrames {};
+  uint64 mMissed {};
+
+  uint64 mWindowFrames {};
+  uint64 mWindowTime {};
+  uint64 mWindowMissed {};
+
+  /* Applies the current mode, falling back to vsync and then to the limiter if necessary */
+  template <typename Setter>
+  void apply(const Setter& setter)
+  {
+    if (mApplied) {
+      return;
+    }
+
+    while (!setter(mMode) && mMode != pacing_mode::limiter) {
+      if (mMode == pacing_mode::late_swap_tear) {
+        mCanTear = false;
+        mMode = pacing_mode::vsync;
+      }
+      else {
+        mMode = pacing_mode::limiter;
+      }
+    }
+
+    mApplied = true;
+    mDeadline = 0;
+  }
+
+  void evaluate() noexcept
+  {
+    const auto average = mWindowTime / mWindowFrames;
+    const auto missRate =
+        static_cast<double>(mWindowMissed) / static_cast<double>(mWindowFrames);
+
+    mWindowFrames = 0;
+    mWindowTime = 0;
+    mWindowMissed = 0;
+
+    if (mMode == pacing_mode::limiter) {
+      return;
+    }
+
+    if (average * 4u < mPeriod * 3u) {
+      /* Frames are presented much faster than the display refreshes, so vsync is off */
+      switch_to(pacing_mode::limiter);
+    }
+    else if (mMode == pacing_mode::vsync && mCanTear && missRate > mOptions.miss_tolerance) {
+      switch_to(pacing_mode::late_swap_tear);
+    }
+  }
+
+  void switch_to(const pacing_mode mode) noexcept
+  {
+    mMode = mode;
+    mApplied = false;
+    mDeadline = 0;
+  }
+
+  [[nodiscard]] auto to_seconds(const uint64 ticks) const
+      noexcept(noexcept(seconds<double> {})) -> seconds<double>
+  {
+    return seconds<double> {static_cast<double>(ticks) / static_cast<double>(mFrequency)};
+  }
+};
+
+[[nodiscard]] inline auto to_string(const frame_pacer& pacer) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("frame_pacer(mode: {}, frames: {}, missed: {})",
+                     to_string(pacer.mode()),
+                     pacer.frame_count(),
+                     pacer.missed_frames());
+#else
+  return "frame_pacer(mode: " + std::string {to_string(pacer.mode())} +
+         ", frames: " + std::to_string(pacer.frame_count()) +
+         ", missed: " + std::to_string(pacer.missed_frames()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const frame_pacer& pacer) -> std::ostream&
+{
+  return stream << to_string(pacer);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_FRAME_PACER_HPP_
@@ -0,0 +1,390 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_FRAME_STATS_HPP_
+#define CENTURION_VIDEO_FRAME_STATS_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>    // nth_element, minmax_element
+#include <array>        // array
+#include <cstddef>      // ptrdiff_t
+#include <stdexcept>    // out_of_range
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "../system/timer.hpp"
+#include "render_counters.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// Represents the values recorded for each frame by `frame_stats`.
+enum class frame_metric : uint8 {
+  frame_time,    ///< The time between the start of consecutive frames, in milliseconds.
+  event_time,    ///< The time spent polling and handling events, in milliseconds.
+  submit_time,   ///< The time spent submitting rendering commands, in milliseconds.
+  present_time,  ///< The time spent presenting the frame, in milliseconds.
+  draw_calls,    ///< The amount of issued draw calls.
+  texture_binds  ///< The amount of texture changes.
+};
+
+/// The amount of frame metrics.
+inline constexpr usize frame_metric_count = 6;
+
+[[nodiscard]] constexpr auto to_string(const frame_metric metric) -> std::string_view
+{
+  switch (metric) {
+    case frame_metric::frame_time:
+      return "frame_time";
+
+    case frame_metric::event_time:
+      return "event_time";
+
+    case frame_metric::submit_time:
+      return "submit_time";
+
+    case frame_metric::present_time:
+      return "present_time";
+
+    case frame_metric::draw_calls:
+      return "draw_calls";
+
+    case frame_metric::texture_binds:
+      return "texture_binds";
+
+    default:
+      throw exception {"Did not recognize frame metric!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const frame_metric metric) -> std::ostream&
+{
+  return stream << to_string(metric);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/// Rolling statistics about a frame metric.
+struct frame_metric_summary final {
+  double min {};   ///< The smallest recorded value.
+  double mean {};  ///< The mean of the recorded values.
+  double p99 {};   ///< The 99th percentile of the recorded values.
+  double max {};   ///< The largest recorded value.
+};
+
+/**
+ * Collects per-frame timings and counters, with rolling statistics over recent frames.
+ *
+ * Call `begin_frame()` at the start of every frame, which computes the frame time and commits
+ * the values recorded during the previous frame. Phases of a frame are timed with `time()`,
+ * and counters are added with `record()`.
+ *
+ * \code{cpp}
+ * cen::frame_stats stats;
+ *
+ * while (running) {
+ *   stats.begin_frame();
+ *
+ *   {
+ *     const auto timer = stats.time(cen::frame_metric::event_time);
+ *     dispatcher.poll();
+ *   }
+ *
+ *   ...
+ * }
+ * \endcode
+ *
+ * \see frame_stats_overlay
+ */
+class frame_stats final {
+ public:
+  using size_type = usize;
+
+  /// Times a frame phase, and adds the elapsed time to the current frame when destroyed.
+  class phase_timer final {
+   public:
+    CENTURION_DISABLE_COPY(phase_timer)
+    CENTURION_DISABLE_MOVE(phase_timer)
+
+    ~phase_timer() noexcept
+    {
+      mStats->record(mMetric, mStats->to_millis(now() - mStart));
+    }
+
+   private:
+    friend class frame_stats;
+
+    frame_stats* mStats {};
+    frame_metric mMetric {};
+    uint64 mStart {};
+
+    phase_timer(frame_stats& stats, const frame_metric metric) noexcept
+        : mStats {&stats}
+        , mMetric {metric}
+        , mStart {now()}
+    {}
+  };
+
+  /**
+   * Creates a frame statistics collector.
+   *
+   * \param window the amount of recent frames that the statistics are computed over.
+   *
+   * \throws exception if the window is zero.
+   */
+  explicit frame_stats(const size_type window = 120) : mFrequency {frequency()}
+  {
+    if (window == 0) {
+      throw exception {"Invalid frame statistics window!"};
+    }
+
+    mSamples.resize(window);
+    mScratch.reserve(window);
+  }
+
+  /// Starts a new frame, using the high-performance counter.
+  void begin_frame() noexcept { begin_frame(now()); }
+
+  /**
+   * Starts a new frame.
+   *
+   * The values recorded since the previous call are committed as a frame, the first call only
+   * starts the measurements.
+   *
+   * \param timestamp the current value of the high-performance counter.
+   */
+  void begin_frame(const uint64 timestamp) noexcept
+  {
+    if (mStarted) {
+      mCurrent[index_of(frame_metric::frame_time)] = to_millis(timestamp - mFrameStart);
+
+      mSamples[mNext] = mCurrent;
+      mNext = (mNext + 1) % mSamples.size();
+      mCount = (detail::min)(mCount + 1, mSamples.size());
+      ++mFrames;
+    }
+
+    mCurrent.fill(0);
+    mFrameStart = timestamp;
+    mStarted = true;
+  }
+
+  /**
+   * Adds a value to a metric of the current frame.
+   *
+   * \param metric the affected metric.
+   * \param value the added value, in milliseconds for time metrics.
+   */
+  void record(const frame_metric metric, const double value) noexcept
+  {
+    mCurrent[index_of(metric)] += value;
+  }
+
+  /**
+   * Adds the draw call and texture bind counts of a renderer to the current frame.
+   *
+   * \param counters the counters of the frame, usually obtained just before `present()`.
+   */
+  void record(const render_counters& counters) noexcept
+  {
+    record(frame_metric::draw_calls, static_cast<double>(counters.submissions()));
+    record(frame_metric::texture_binds, static_cast<double>(counters.texture_binds));
+  }
+
+  /**
+   * Times a phase of the current frame.
+   *
+   * \param metric the time metric that the elapsed time is added to.
+   *
+   * \return a timer that records the elapsed time when destroyed.
+   */
+  [[nodiscard]] auto time(const frame_metric metric) noexcept -> phase_timer
+  {
+    return phase_timer {*this, metric};
+  }
+
+  /**
+   * Computes rolling statistics about a metric.
+   *
+   * This function doesn't allocate, but it is linear in the window size, so call it at most
+   * once per frame and metric.
+   *
+   * \param metric the metric to summarize.
+   *
+   * \return the statistics of the recent frames, all zero if no frames have been recorded.
+   */
+  [[nodiscard]] auto summary(const frame_metric metric) const -> frame_metric_summary
+  {
+    frame_metric_summary result;
+
+    if (mCount == 0) {
+      return result;
+    }
+
+    mScratch.clear();
+
+    double total = 0;
+    for (size_type index = 0; index < mCount; ++index) {
+      const auto value = at(index, metric);
+      mScratch.push_back(value);
+      total += value;
+    }
+
+    const auto [min, max] = std::minmax_element(mScratch.begin(), mScratch.end());
+    result.min = *min;
+    result.max = *max;
+    result.mean = total / static_cast<double>(mCount);
+
+    /* The nearest-rank percentile, i.e. the smallest value not exceeded by 99% of frames */
+    const auto rank = (mCount * 99 + 99) / 100;
+    const auto nth = mScratch.begin() + static_cast<std::ptrdiff_t>(rank - 1);
+    std::nth_element(mScratch.begin(), nth, mScratch.end());
+    result.p99 = *nth;
+
+    return result;
+  }
+
+  /**
+   * Returns the value of a metric in a recent frame.
+   *
+   * \param index the index of the frame, where zero is the oldest frame in the window.
+   * \param metric the requested metric.
+   *
+   * \return the recorded value.
+   *
+   * \throws std::out_of_range if the index is out of bounds.
+   */
+  [[nodiscard]] auto at(const size_type index, const frame_metric metric) const -> double
+  {
+    if (index >= mCount) {
+      throw std::out_of_range {"Invalid frame statistics index!"};
+    }
+
+    const auto first = (mNext + mSamples.size() - mCount) % mSamples.size();
+    return mSamples[(first + index) % mSamples.size()][index_of(metric)];
+  }
+
+  /// Returns the value of a metric in the latest committed frame, or zero.
+  [[nodiscard]] auto latest(const frame_metric metric) const noexcept -> double
+  {
+    if (mCount != 0) {
+      const auto last = (mNext + mSamples.size() - 1) % mSamples.size();
+      return mSamples[last][index_of(metric)];
+    }
+    else {
+      return 0;
+    }
+  }
+
+  /// Forgets all recorded frames, the next frame starts the measurements again.
+  void reset() noexcept
+  {
+    mCurrent.fill(0);
+    mNext = 0;
+    mCount = 0;
+    mFrames = 0;
+    mStarted = false;
+  }
+
+  /// Returns the amount of frames in the statistics window.
+  [[nodiscard]] auto sample_count() const noexcept -> size_type { return mCount; }
+
+  /// Returns the maximum amount of frames that the statistics are computed over.
+  [[nodiscard]] auto window() const noexcept -> size_type { return mSamples.size(); }
+
+  /// Returns the total amount of recorded frames.
+  [[nodiscard]] auto frame_count() const noexcept -> uint64 { return mFrames; }
+
+ private:
+  using sample = std::array<double, frame_metric_count>;
+
+  std::vector<sample> mSamples;          ///< A ring buffer of committed frames.
+  mutable std::vector<double> mScratch;  ///< Used to compute the percentiles.
+  sample mCurrent {};
+  uint64 mFrequency {};
+  uint64 mFrameStart {};
+  uint64 mFrames {};
+  size_type mNext {};
+  size_type mCount {};
+  bool mStarted {};
+
+  [[nodiscard]] constexpr static auto index_of(const frame_metric metric) noexcept -> usize
+  {
+    return static_cast<usize>(metric);
+  }
+
+  [[nodiscard]] auto to_millis(const uint64 ticks) const noexcept -> double
+  {
+    return static_cast<double>(ticks) * 1'000.0 / static_cast<double>(mFrequency);
+  }
+};
+
+[[nodiscard]] inline auto to_string(const frame_stats& stats) -> std::string
+{
+  const auto frameTime = stats.summary(frame_metric::frame_time);
+
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("frame_stats(frames: {}, mean: {} ms, p99: {} ms)",
+                     stats.frame_count(),
+                     frameTime.mean,
+                     frameTime.p99);
+#else
+  return "frame_stats(frames: " + std::to_string(stats.frame_count()) +
+         ", mean: " + std::to_string(frameTime.mean) +
+         " ms, p99: " + std::to_string(frameTime.p99) + " ms)";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const frame_stats& stats) -> std::ostream&
+{
+  return stream << to_string(stats);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_FRAME_STATS_HPP_
@@ -0,0 +1,253 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_GAME_LOOP_HPP_
+#define CENTURION_VIDEO_GAME_LOOP_HPP_
+
+#include <SDL.h>
+
+#include <string>   // string, to_string
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "../system/timer.hpp"
+#include "frame_pacer.hpp"
+#include "renderer.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// The configuration of a game loop.
+struct game_loop_options final {
+  double tick_rate {60};          ///< The amount of simulation ticks per second.
+  usize max_ticks_per_frame {8};  ///< The maximum amount of ticks simulated for each frame.
+};
+
+/**
+ * Drives a game loop with a fixed simulation rate, and a variable rendering rate.
+ *
+ * Each iteration of the loop polls for input, runs as many fixed-length simulation ticks as
+ * the elapsed time calls for, and then renders a frame. The leftover time that was too short
+ * for another tick is provided to the renderer as an interpolation factor in the range
+ * [0, 1), so that the rendered state can be blended between the two latest ticks.
+ *
+ * If a frame would need more than `max_ticks_per_frame` ticks to catch up, e.g. after a
+ * hitch or when the simulation is too slow for the tick rate, the remaining time is
+ * dropped. This avoids the "spiral of death", where catching up takes longer and longer.
+ *
+ * \code{cpp}
+ * cen::game_loop loop;
+ * dispatcher.bind<cen::quit_event>().to([&](const cen::quit_event&) { loop.stop(); });
+ *
+ * loop.run(dispatcher, renderer, pacer, update, [&](const double alpha) { draw(alpha); });
+ * \endcode
+ *
+ * \see frame_pacer
+ */
+class game_loop final {
+ public:
+  using size_type = usize;
+
+  explicit game_loop(const game_loop_options& options = {})
+      : mOptions {options}
+      , mFrequency {frequency()}
+  {
+    if (mOptions.tick_rate <= 0) {
+      throw exception {"Invalid game loop tick rate!"};
+    }
+
+    mOptions.max_ticks_per_frame = (detail::max)(mOptions.max_ticks_per_frame, size_type {1});
+    mStep = (detail::max)(
+        static_cast<uint64>(static_cast<double>(mFrequency) / mOptions.tick_rate),
+        uint64 {1});
+  }
+
+  /**
+   * Runs the loop until it is stopped.
+   *
+   * \param input the function object invoked first in every iteration, with signature
+   *        `void()`, e.g. to poll events.
+   * \param update the function object invoked for every simulation tick, with signature
+   *        `void(seconds<double>)`, where the argument is the fixed tick duration.
+   * \param render the function object invoked once per iteration, with signature
+   *        `void(double)`, where the argument is the interpolation factor. This is
+   *        responsible for presenting the frame.
+   */
+  template <typename Input, typename Update, typename Render>
+  void run(Input&& input, Update&& update, Render&& render)
+  {
+    mRunning = true;
+    mPrevious = 0;
+    mAccumulator = 0;
+
+    const auto step = tick_duration();
+
+    while (mRunning) {
+      input();
+      if (!mRunning) {
+        break;
+      }
+
+      for (auto ticks = advance(now()); ticks > 0 && mRunning; --ticks) {
+        update(step);
+      }
+
+      if (mRunning) {
+        render(alpha());
+      }
+    }
+  }
+
+  /**
+   * Runs the loop with an event dispatcher, and presents frames using a frame pacer.
+   *
+   * \param dispatcher the event dispatcher that is polled in every iteration.
+   * \param renderer the renderer whose frames are presented.
+   * \param pacer the frame pacer used to present the frames.
+   * \param update the function object invoked for every simulation tick, with signature
+   *        `void(seconds<double>)`.
+   * \param draw the function object that renders a frame, with signature `void(double)`.
+   *
+   * \see event_dispatcher
+   */
+  template <typename Dispatcher, typename T, typename Update, typename Draw>
+  void run(Dispatcher& dispatcher,
+           basic_renderer<T>& renderer,
+           frame_pacer& pacer,
+           Update&& update,
+           Draw&& draw)
+  {
+    run([&] { dispatcher.poll(); },
+        update,
+        [&](const double alpha) {
+          draw(alpha);
+          pacer.present(renderer);
+        });
+  }
+
+  /// Makes the loop return after the current callback.
+  void stop() noexcept { mRunning = false; }
+
+  /**
+   * Accumulates the time since the previous call, and returns the amount of ticks to run.
+   *
+   * This is done by `run()`, and is only needed when writing a custom loop.
+   *
+   * \param counter the current value of the high-performance counter.
+   *
+   * \return the amount of simulation ticks that are due.
+   */
+  auto advance(const uint64 counter) noexcept -> size_type
+  {
+    if (mPrevious != 0) {
+      mAccumulator += counter - mPrevious;
+    }
+
+    mPrevious = counter;
+
+    auto ticks = static_cast<size_type>(mAccumulator / mStep);
+    mAccumulator -= ticks * mStep;
+
+    if (ticks > mOptions.max_ticks_per_frame) {
+      mDropped += ticks - mOptions.max_ticks_per_frame;
+      ticks = mOptions.max_ticks_per_frame;
+    }
+
+    mTicks += ticks;
+    return ticks;
+  }
+
+  /// Returns the fraction of a tick that has accumulated, in the range [0, 1).
+  [[nodiscard]] auto alpha() const noexcept -> double
+  {
+    return static_cast<double>(mAccumulator) / static_cast<double>(mStep);
+  }
+
+  /// Returns the fixed duration of a simulation tick.
+  [[nodiscard]] auto tick_duration() const noexcept(noexcept(seconds<double> {}))
+      -> seconds<double>
+  {
+    return seconds<double> {static_cast<double>(mStep) / static_cast<double>(mFrequency)};
+  }
+
+  [[nodiscard]] auto tick_rate() const noexcept -> double { return mOptions.tick_rate; }
+
+  /// Returns the amount of simulation ticks that have been run.
+  [[nodiscard]] auto tick_count() const noexcept -> uint64 { return mTicks; }
+
+  /// Returns the amount of ticks that were skipped to avoid falling behind.
+  [[nodiscard]] auto dropped_ticks() const noexcept -> uint64 { return mDropped; }
+
+  [[nodiscard]] auto is_running() const noexcept -> bool { return mRunning; }
+
+ private:
+  game_loop_options mOptions;
+  uint64 mFrequency {};
+  uint64 mStep {};
+  uint64 mPrevious {};
+  uint64 mAccumulator {};
+  uint64 mTicks {};
+  uint64 mDropped {};
+  bool mRunning {};
+};
+
+[[nodiscard]] inline auto to_string(const game_loop& loop) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("game_loop(tick_rate: {}, ticks: {}, dropped: {})",
+                     loop.tick_rate(),
+                     loop.tick_count(),
+                     loop.dropped_ticks());
+#else
+  return "game_loop(tick_rate: " + std::to_string(loop.tick_rate()) +
+         ", ticks: " + std::to_string(loop.tick_count()) +
+         ", dropped: " + std::to_string(loop.dropped_ticks()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const game_loop& loop) -> std::ostream&
+{
+  return stream << to_string(loop);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_GAME_LOOP_HPP_
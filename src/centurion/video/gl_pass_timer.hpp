@@ -0,0 +1,278 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_GL_PASS_TIMER_HPP_
+#define CENTURION_VIDEO_GL_PASS_TIMER_HPP_
+
+#ifndef CENTURION_NO_OPENGL
+
+#include <SDL.h>
+#include <SDL_opengl.h>
+
+#include <array>    // array
+#include <cassert>  // assert
+#include <chrono>   // nanoseconds
+#include <vector>   // vector
+
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../system/profiler.hpp"
+#include "../system/timer.hpp"
+#include "gl_state.hpp"
+
+namespace cen {
+
+/// The measured GPU time of a render pass.
+struct gl_pass_result final {
+  const char* name {};  ///< The name of the pass.
+  uint64 begin {};      ///< The start of the pass, as a high-performance counter value.
+  uint64 end {};        ///< The end of the pass, as a high-performance counter value.
+
+  /// Returns the GPU time spent in the pass.
+  [[nodiscard]] auto elapsed() const noexcept -> std::chrono::nanoseconds
+  {
+    using rep = std::chrono::nanoseconds::rep;
+    const auto ticks = static_cast<double>(end - begin);
+    return std::chrono::nanoseconds {
+        static_cast<rep>(ticks * 1e9 / static_cast<double>(frequency()))};
+  }
+};
+
+/**
+ * Measures the GPU time of named render passes with OpenGL timestamp queries.
+ *
+ * Each pass is enclosed by two `GL_TIMESTAMP` queries, so passes may be nested, unlike
+ * `GL_TIME_ELAPSED` queries. The queries are double-buffered: the results of a frame are
+ * read when its queries are about to be reused, two frames later, and only if they are
+ * already available, so reading results never stalls the pipeline.
+ *
+ * GPU timestamps are converted to high-performance counter values, using a calibration
+ * taken at the start of each frame. If profiling is enabled, the passes are also recorded as
+ * GPU profiling events, which `write_chrome_trace()` shows on a separate track.
+ *
+ * \see gl_pass_scope
+ * \see record_gpu_profile_zone()
+ */
+class gl_pass_timer final {
+ public:
+  /**
+   * Creates a pass timer.
+   *
+   * \param functions the functions of the current context, must support timer queries.
+   * \param maxPasses the maximum amount of passes per frame, additional passes are ignored.
+   */
+  explicit gl_pass_timer(const gl_functions& functions, const usize maxPasses = 32)
+      : mFunctions {functions}
+      , mMaxPasses {maxPasses}
+  {
+    assert(is_supported(functions));
+
+    for (auto& frame : mFrames) {
+      frame.queries.resize(maxPasses * 2u);
+      frame.passes.reserve(maxPasses);
+      mFunctions.gen_queries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+    }
+
+    mResults.reserve(maxPasses);
+    calibrate(mFrames[mIndex]);
+  }
+
+  CENTURION_DISABLE_COPY(gl_pass_timer)
+  CENTURION_DISABLE_MOVE(gl_pass_timer)
+
+  ~gl_pass_timer() noexcept
+  {
+    for (const auto& frame : mFrames) {
+      mFunctions.delete_queries(static_cast<GLsizei>(frame.queries.size()),
+                                frame.queries.data());
+    }
+  }
+
+  /// Indicates whether a function table provides the functions needed for timer queries.
+  [[nodiscard]] static auto is_supported(const gl_functions& functions) noexcept -> bool
+  {
+    return functions.gen_queries && functions.query_counter && functions.get_integer64v;
+  }
+
+  /**
+   * Starts a new frame, should be called once per frame before any passes.
+   *
+   * This collects the results of the frame that previously used the same queries.
+   */
+  void begin_frame()
+  {
+    assert(mOpen.empty());
+
+    mIndex = (mIndex + 1u) % mFrames.size();
+
+    auto& frame = mFrames[mIndex];
+    collect(frame);
+    calibrate(frame);
+  }
+
+  /**
+   * Starts a pass, which must be ended with `end()`.
+   *
+   * \param name the name of the pass, must be a string literal.
+   */
+  void begin(const char* name)
+  {
+    auto& frame = mFrames[mIndex];
+
+    if (frame.passes.size() == mMaxPasses) {
+      mOpen.push_back(invalid_pass);
+      ++mDropped;
+      return;
+    }
+
+    const auto index = frame.passes.size();
+    frame.passes.push_back({name});
+
+    mFunctions.query_counter(frame.queries[index * 2u], GL_TIMESTAMP);
+    mOpen.push_back(index);
+  }
+
+  /// Ends the most recently started pass.
+  void end()
+  {
+    assert(!mOpen.empty());
+
+    const auto index = mOpen.back();
+    mOpen.pop_back();
+
+    if (index != invalid_pass) {
+      mFunctions.query_counter(mFrames[mIndex].queries[(index * 2u) + 1u], GL_TIMESTAMP);
+    }
+  }
+
+  /// Returns the results of the most recent frame with available results.
+  [[nodiscard]] auto results() const noexcept -> const std::vector<gl_pass_result>&
+  {
+    return mResults;
+  }
+
+  /// Returns the amount of passes that were not measured, e.g. due to unavailable results.
+  [[nodiscard]] auto dropped() const noexcept -> uint64 { return mDropped; }
+
+ private:
+  inline constexpr static usize invalid_pass = ~usize {0};
+
+  struct frame_queries final {
+    std::vector<GLuint> queries;      ///< Begin and end query of each pass.
+    std::vector<const char*> passes;  ///< The names of the passes.
+    GLint64 gpuOrigin {};             ///< GPU timestamp at the start of the frame.
+    uint64 cpuOrigin {};              ///< Counter value at the start of the frame.
+  };
+
+  gl_functions mFunctions;
+  usize mMaxPasses {};
+  std::array<frame_queries, 2> mFrames;
+  usize mIndex {};
+  std::vector<usize> mOpen;  ///< The indices of the passes that haven't ended.
+  std::vector<gl_pass_result> mResults;
+  uint64 mDropped {};
+
+  void calibrate(frame_queries& frame)
+  {
+    mFunctions.get_integer64v(GL_TIMESTAMP, &frame.gpuOrigin);
+    frame.cpuOrigin = now();
+  }
+
+  [[nodiscard]] static auto to_counter(const frame_queries& frame, const GLuint64 timestamp)
+      -> uint64
+  {
+    const auto offset = static_cast<double>(static_cast<GLint64>(timestamp) - frame.gpuOrigin);
+    const auto ticks = offset * static_cast<double>(frequency()) / 1e9;
+    return frame.cpuOrigin + static_cast<uint64>(ticks > 0 ? ticks : 0);
+  }
+
+  void collect(frame_queries& frame)
+  {
+    if (frame.passes.empty()) {
+      return;
+    }
+
+    /* The end query of the last pass is the last query to complete */
+    GLint available {};
+    const auto last = frame.queries[(frame.passes.size() * 2u) - 1u];
+    mFunctions.get_query_objectiv(last, GL_QUERY_RESULT_AVAILABLE, &available);
+
+    if (!available) {
+      mDropped += frame.passes.size();
+      frame.passes.clear();
+      return;
+    }
+
+    mResults.clear();
+
+    for (usize index = 0; index < frame.passes.size(); ++index) {
+      GLuint64 begin {};
+      GLuint64 end {};
+      mFunctions.get_query_objectui64v(frame.queries[index * 2u], GL_QUERY_RESULT, &begin);
+      mFunctions.get_query_objectui64v(frame.queries[(index * 2u) + 1u],
+                                       GL_QUERY_RESULT,
+                                       &end);
+
+      const auto& result = mResults.emplace_back(gl_pass_result {frame.passes[index],
+                                                                 to_counter(frame, begin),
+                                                                 to_counter(frame, end)});
+      record_gpu_profile_zone(result.name, result.begin, result.end);
+    }
+
+    frame.passes.clear();
+  }
+};
+
+/**
+ * Measures the GPU time of a scope with a pass timer.
+ *
+ * \see gl_pass_timer
+ */
+class gl_pass_scope final {
+ public:
+  /**
+   * Starts a pass.
+   *
+   * \param timer the timer that measures the pass.
+   * \param name the name of the pass, must be a string literal.
+   */
+  gl_pass_scope(gl_pass_timer& timer, const char* name) : mTimer {timer}
+  {
+    mTimer.begin(name);
+  }
+
+  CENTURION_DISABLE_COPY(gl_pass_scope)
+  CENTURION_DISABLE_MOVE(gl_pass_scope)
+
+  ~gl_pass_scope() noexcept { mTimer.end(); }
+
+ private:
+  gl_pass_timer& mTimer;
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_OPENGL
+#endif  // CENTURION_VIDEO_GL_PASS_TIMER_HPP_
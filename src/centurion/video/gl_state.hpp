@@ -0,0 +1,449 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_GL_STATE_HPP_
+#define CENTURION_VIDEO_GL_STATE_HPP_
+
+#ifndef CENTURION_NO_OPENGL
+
+#include <SDL.h>
+#include <SDL_opengl.h>
+
+#include <array>    // array
+#include <cassert>  // assert
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "opengl.hpp"
+
+namespace cen {
+
+/**
+ * A table of typed OpenGL function pointers.
+ *
+ * The table is filled once per context with `load()`, instead of resolving each function
+ * with `gl_library::address_of()` at every call site. Optional functions are null if the
+ * context doesn't provide them.
+ *
+ * \see gl_state_cache
+ */
+struct gl_functions final {
+  void(APIENTRY* bind_texture)(GLenum, GLuint) {};
+  void(APIENTRY* active_texture)(GLenum) {};
+  void(APIENTRY* use_program)(GLuint) {};
+  void(APIENTRY* enable)(GLenum) {};
+  void(APIENTRY* disable)(GLenum) {};
+  void(APIENTRY* blend_func_separate)(GLenum, GLenum, GLenum, GLenum) {};
+  void(APIENTRY* blend_equation_separate)(GLenum, GLenum) {};
+  void(APIENTRY* bind_buffer)(GLenum, GLuint) {};
+  void(APIENTRY* viewport)(GLint, GLint, GLsizei, GLsizei) {};
+  void(APIENTRY* scissor)(GLint, GLint, GLsizei, GLsizei) {};
+  void(APIENTRY* clear_color)(GLfloat, GLfloat, GLfloat, GLfloat) {};
+  void(APIENTRY* clear)(GLbitfield) {};
+  void(APIENTRY* get_integerv)(GLenum, GLint*) {};
+  GLenum(APIENTRY* get_error)() {};
+  void(APIENTRY* flush)() {};
+  void(APIENTRY* finish)() {};
+  void(APIENTRY* gen_buffers)(GLsizei, GLuint*) {};
+  void(APIENTRY* delete_buffers)(GLsizei, const GLuint*) {};
+  void(APIENTRY* buffer_data)(GLenum, GLsizeiptr, const void*, GLenum) {};
+  void(APIENTRY* pixel_storei)(GLenum, GLint) {};
+  void(APIENTRY* tex_sub_image_2d)(GLenum, GLint, GLint, GLint,
+                                   GLsizei, GLsizei, GLenum, GLenum, const void*) {};
+
+  void(APIENTRY* bind_framebuffer)(GLenum, GLuint) {};  ///< Optional, requires OpenGL 3.0.
+  void(APIENTRY* bind_vertex_array)(GLuint) {};         ///< Optional, requires OpenGL 3.0.
+
+  GLsync(APIENTRY* fence_sync)(GLenum, GLbitfield) {};  ///< Optional, requires OpenGL 3.2.
+  GLenum(APIENTRY* client_wait_sync)(GLsync, GLbitfield, GLuint64) {};  ///< Optional.
+  void(APIENTRY* delete_sync)(GLsync) {};                               ///< Optional.
+
+  /* Optional, all of these are required for persistently mapped buffers (OpenGL 4.4) */
+  void(APIENTRY* buffer_storage)(GLenum, GLsizeiptr, const void*, GLbitfield) {};
+  void*(APIENTRY* map_buffer_range)(GLenum, GLintptr, GLsizeiptr, GLbitfield) {};
+  GLboolean(APIENTRY* unmap_buffer)(GLenum) {};
+
+  /* Optional, all of these are required for timer queries (OpenGL 3.3) */
+  void(APIENTRY* gen_queries)(GLsizei, GLuint*) {};
+  void(APIENTRY* delete_queries)(GLsizei, const GLuint*) {};
+  void(APIENTRY* query_counter)(GLuint, GLenum) {};
+  void(APIENTRY* get_query_objectiv)(GLuint, GLenum, GLint*) {};
+  void(APIENTRY* get_query_objectui64v)(GLuint, GLenum, GLuint64*) {};
+  void(APIENTRY* get_integer64v)(GLenum, GLint64*) {};
+
+  /**
+   * Resolves all functions for the current context.
+   *
+   * \return the loaded functions; an empty optional if a required function is missing.
+   */
+  [[nodiscard]] static auto load() -> maybe<gl_functions>
+  {
+    assert(SDL_GL_GetCurrentContext());
+
+    gl_functions functions;
+    const auto loaded =
+        resolve(functions.bind_texture, "glBindTexture") &&
+        resolve(functions.active_texture, "glActiveTexture") &&
+        resolve(functions.use_program, "glUseProgram") &&
+        resolve(functions.enable, "glEnable") &&
+        resolve(functions.disable, "glDisable") &&
+        resolve(functions.blend_func_separate, "glBlendFuncSeparate") &&
+        resolve(functions.blend_equation_separate, "glBlendEquationSeparate") &&
+        resolve(functions.bind_buffer, "glBindBuffer") &&
+        resolve(functions.viewport, "glViewport") &&
+        resolve(functions.scissor, "glScissor") &&
+        resolve(functions.clear_color, "glClearColor") &&
+        resolve(functions.clear, "glClear") &&
+        resolve(functions.get_integerv, "glGetIntegerv") &&
+        resolve(functions.get_error, "glGetError") &&
+        resolve(functions.flush, "glFlush") &&
+        resolve(functions.finish, "glFinish") &&
+        resolve(functions.gen_buffers, "glGenBuffers") &&
+        resolve(functions.delete_buffers, "glDeleteBuffers") &&
+        resolve(functions.buffer_data, "glBufferData") &&
+        resolve(functions.pixel_storei, "glPixelStorei") &&
+        resolve(functions.tex_sub_image_2d, "glTexSubImage2D");
+
+    if (!loaded) {
+      return nothing;
+    }
+
+    static_cast<void>(resolve(functions.bind_framebuffer, "glBindFramebuffer"));
+    static_cast<void>(resolve(functions.bind_vertex_array, "glBindVertexArray"));
+
+    /* Sync objects are only used if all of the functions are available */
+    if (!resolve(functions.fence_sync, "glFenceSync") ||
+        !resolve(functions.client_wait_sync, "glClientWaitSync") ||
+        !resolve(functions.delete_sync, "glDeleteSync")) {
+      functions.fence_sync = nullptr;
+      functions.client_wait_sync = nullptr;
+      functions.delete_sync = nullptr;
+    }
+
+    if (!resolve(functions.buffer_storage, "glBufferStorage") ||
+        !resolve(functions.map_buffer_range, "glMapBufferRange") ||
+        !resolve(functions.unmap_buffer, "glUnmapBuffer")) {
+      functions.buffer_storage = nullptr;
+      functions.map_buffer_range = nullptr;
+      functions.unmap_buffer = nullptr;
+    }
+
+    if (!resolve(functions.gen_queries, "glGenQueries") ||
+        !resolve(functions.delete_queries, "glDeleteQueries") ||
+        !resolve(functions.query_counter, "glQueryCounter") ||
+        !resolve(functions.get_query_objectiv, "glGetQueryObjectiv") ||
+        !resolve(functions.get_query_objectui64v, "glGetQueryObjectui64v") ||
+        !resolve(functions.get_integer64v, "glGetInteger64v")) {
+      functions.gen_queries = nullptr;
+      functions.delete_queries = nullptr;
+      functions.query_counter = nullptr;
+      functions.get_query_objectiv = nullptr;
+      functions.get_query_objectui64v = nullptr;
+      functions.get_integer64v = nullptr;
+    }
+
+    return functions;
+  }
+
+ private:
+  template <typename Function>
+  [[nodiscard]] static auto resolve(Function& function, const char* name) noexcept -> bool
+  {
+    function = reinterpret_cast<Function>(SDL_GL_GetProcAddress(name));
+    return function != nullptr;
+  }
+};
+
+/**
+ * Tracks a subset of the OpenGL state, and skips redundant state changes.
+ *
+ * Rebinding an already bound texture or program is not free, since drivers usually
+ * validate the state on each call. This cache remembers the bound textures, program,
+ * buffers and the blend state, and only forwards changes to the driver.
+ *
+ * The cache must be the only code changing the tracked state. If anything else touches it,
+ * e.g. an SDL renderer or `gl::bind()`, call `invalidate()` afterwards, which makes the
+ * next change of each kind of state go through unconditionally.
+ *
+ * \see gl_functions
+ */
+class gl_state_cache final {
+ public:
+  inline constexpr static usize max_texture_units = 16;
+
+  /**
+   * Creates a state cache that loads the functions of the current context.
+   *
+   * \param context the context that the cache will be used with, must be current.
+   *
+   * \throws exception if a required OpenGL function cannot be loaded.
+   */
+  template <typename T>
+  explicit gl_state_cache(const basic_gl_context<T>& context)
+  {
+    assert(context.get() == SDL_GL_GetCurrentContext());
+    static_cast<void>(context);
+
+    if (auto functions = gl_functions::load()) {
+      mFunctions = *functions;
+    }
+    else {
+      throw exception {"Failed to load OpenGL functions!"};
+    }
+  }
+
+  /// Creates a state cache that uses existing functions, all required functions must be set.
+  explicit gl_state_cache(const gl_functions& functions) noexcept : mFunctions {functions} {}
+
+  /// Forgets all tracked state, use after anything else has modified the OpenGL state.
+  void invalidate() noexcept
+  {
+    mTextures.fill(unknown);
+    mActiveUnit = unknown;
+    mProgram = unknown;
+    mArrayBuffer = unknown;
+    mElementBuffer = unknown;
+    mUnpackBuffer = unknown;
+    mFramebuffer = unknown;
+    mVertexArray = unknown;
+    mBlendEnabled = unknown;
+    mBlendFunc.fill(unknown);
+    mBlendEquation.fill(unknown);
+    mViewport.reset();
+  }
+
+  /**
+   * Binds a 2D texture to a texture unit.
+   *
+   * \param texture the OpenGL texture name.
+   * \param unit the index of the texture unit, e.g. 0 for `GL_TEXTURE0`.
+   */
+  void bind_texture(const GLuint texture, const usize unit = 0)
+  {
+    assert(unit < max_texture_units);
+
+    if (mTextures[unit] == texture) {
+      ++mSkipped;
+      return;
+    }
+
+    set_active_unit(static_cast<GLuint>(GL_TEXTURE0 + unit));
+    mFunctions.bind_texture(GL_TEXTURE_2D, texture);
+    mTextures[unit] = texture;
+    ++mIssued;
+  }
+
+  void use_program(const GLuint program)
+  {
+    if (update(mProgram, program)) {
+      mFunctions.use_program(program);
+    }
+  }
+
+  /**
+   * Binds a buffer object.
+   *
+   * \param target `GL_ARRAY_BUFFER`, `GL_ELEMENT_ARRAY_BUFFER` or `GL_PIXEL_UNPACK_BUFFER`.
+   * \param buffer the OpenGL buffer name.
+   */
+  void bind_buffer(const GLenum target, const GLuint buffer)
+  {
+    if (update(buffer_binding(target), buffer)) {
+      mFunctions.bind_buffer(target, buffer);
+    }
+  }
+
+  /// Binds a framebuffer to `GL_FRAMEBUFFER`, requires `glBindFramebuffer()`.
+  void bind_framebuffer(const GLuint framebuffer)
+  {
+    assert(mFunctions.bind_framebuffer);
+    if (update(mFramebuffer, framebuffer)) {
+      mFunctions.bind_framebuffer(GL_FRAMEBUFFER, framebuffer);
+    }
+  }
+
+  /// Binds a vertex array object, requires `glBindVertexArray()`.
+  void bind_vertex_array(const GLuint vertexArray)
+  {
+    assert(mFunctions.bind_vertex_array);
+    if (update(mVertexArray, vertexArray)) {
+      mFunctions.bind_vertex_array(vertexArray);
+    }
+  }
+
+  void set_blend_enabled(const bool enabled)
+  {
+    if (update(mBlendEnabled, enabled ? 1u : 0u)) {
+      if (enabled) {
+        mFunctions.enable(GL_BLEND);
+      }
+      else {
+        mFunctions.disable(GL_BLEND);
+      }
+    }
+  }
+
+  void set_blend_func(const GLenum src, const GLenum dst)
+  {
+    set_blend_func(src, dst, src, dst);
+  }
+
+  void set_blend_func(const GLenum srcColor,
+                      const GLenum dstColor,
+                      const GLenum srcAlpha,
+                      const GLenum dstAlpha)
+  {
+    const std::array<GLuint, 4> func {srcColor, dstColor, srcAlpha, dstAlpha};
+    if (update(mBlendFunc, func)) {
+      mFunctions.blend_func_separate(srcColor, dstColor, srcAlpha, dstAlpha);
+    }
+  }
+
+  void set_blend_equation(const GLenum mode) { set_blend_equation(mode, mode); }
+
+  void set_blend_equation(const GLenum colorMode, const GLenum alphaMode)
+  {
+    const std::array<GLuint, 2> equation {colorMode, alphaMode};
+    if (update(mBlendEquation, equation)) {
+      mFunctions.blend_equation_separate(colorMode, alphaMode);
+    }
+  }
+
+  void set_viewport(const irect& viewport)
+  {
+    if (mViewport == viewport) {
+      ++mSkipped;
+      return;
+    }
+
+    mFunctions.viewport(viewport.x(), viewport.y(), viewport.width(), viewport.height());
+    mViewport = viewport;
+    ++mIssued;
+  }
+
+  /// Returns the bound 2D texture of a texture unit, if known.
+  [[nodiscard]] auto bound_texture(const usize unit = 0) const noexcept -> maybe<GLuint>
+  {
+    assert(unit < max_texture_units);
+    return known(mTextures[unit]);
+  }
+
+  [[nodiscard]] auto current_program() const noexcept -> maybe<GLuint>
+  {
+    return known(mProgram);
+  }
+
+  [[nodiscard]] auto functions() const noexcept -> const gl_functions& { return mFunctions; }
+
+  /// Returns the amount of state changes that were forwarded to OpenGL.
+  [[nodiscard]] auto issued() const noexcept -> uint64 { return mIssued; }
+
+  /// Returns the amount of redundant state changes that were skipped.
+  [[nodiscard]] auto skipped() const noexcept -> uint64 { return mSkipped; }
+
+  void reset_counters() noexcept
+  {
+    mIssued = 0;
+    mSkipped = 0;
+  }
+
+ private:
+  /* Marks unknown state, OpenGL never generates this name or enum value */
+  inline constexpr static GLuint unknown = ~GLuint {0};
+
+  gl_functions mFunctions;
+  std::array<GLuint, max_texture_units> mTextures {unknown, unknown, unknown, unknown,
+                                                   unknown, unknown, unknown, unknown,
+                                                   unknown, unknown, unknown, unknown,
+                                                   unknown, unknown, unknown, unknown};
+  GLuint mActiveUnit {unknown};
+  GLuint mProgram {unknown};
+  GLuint mArrayBuffer {unknown};
+  GLuint mElementBuffer {unknown};
+  GLuint mUnpackBuffer {unknown};
+  GLuint mFramebuffer {unknown};
+  GLuint mVertexArray {unknown};
+  GLuint mBlendEnabled {unknown};
+  std::array<GLuint, 4> mBlendFunc {unknown, unknown, unknown, unknown};
+  std::array<GLuint, 2> mBlendEquation {unknown, unknown};
+  maybe<irect> mViewport;
+  uint64 mIssued {};
+  uint64 mSkipped {};
+
+  template <typename U>
+  [[nodiscard]] auto update(U& current, const U& value) noexcept -> bool
+  {
+    if (current == value) {
+      ++mSkipped;
+      return false;
+    }
+    else {
+      current = value;
+      ++mIssued;
+      return true;
+    }
+  }
+
+  [[nodiscard]] auto buffer_binding(const GLenum target) noexcept -> GLuint&
+  {
+    switch (target) {
+      case GL_ARRAY_BUFFER:
+        return mArrayBuffer;
+
+      case GL_ELEMENT_ARRAY_BUFFER:
+        return mElementBuffer;
+
+      default:
+        assert(target == GL_PIXEL_UNPACK_BUFFER);
+        return mUnpackBuffer;
+    }
+  }
+
+  void set_active_unit(const GLuint unit)
+  {
+    /* The active unit is an implementation detail, so it isn't counted */
+    if (mActiveUnit != unit) {
+      mFunctions.active_texture(unit);
+      mActiveUnit = unit;
+    }
+  }
+
+  [[nodiscard]] static auto known(const GLuint value) noexcept -> maybe<GLuint>
+  {
+    if (value != unknown) {
+      return value;
+    }
+    else {
+      return nothing;
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_OPENGL
+#endif  // CENTURION_VIDEO_GL_STATE_HPP_
@@ -0,0 +1,323 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_GL_TEXTURE_STREAMER_HPP_
+#define CENTURION_VIDEO_GL_TEXTURE_STREAMER_HPP_
+
+#ifndef CENTURION_NO_OPENGL
+
+#include <SDL.h>
+#include <SDL_opengl.h>
+
+#include <cassert>  // assert
+#include <cstring>  // memcpy
+#include <vector>   // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "gl_state.hpp"
+#include "surface.hpp"
+
+namespace cen {
+
+/**
+ * Streams pixel data into an OpenGL texture through a ring of pixel buffer objects.
+ *
+ * Uploading with `glTexSubImage2D()` from client memory stalls until the driver has copied the
+ * pixels. Instead, each frame is written into a pixel buffer, and the texture is updated from
+ * the buffer, which lets the copy happen asynchronously. The streamer cycles through several
+ * buffers, so the CPU writes the next frame while the GPU still reads the previous ones.
+ *
+ * If `glBufferStorage()` and sync objects are available, the buffers are mapped persistently
+ * and `acquire()` returns a pointer into the mapped memory, which may be filled by any thread,
+ * e.g. a video decoder. Fences prevent overwriting a buffer before the GPU has consumed it.
+ * Otherwise, frames are written to a staging buffer and the pixel buffers are orphaned and
+ * refilled with `glBufferData()` on each commit.
+ *
+ * All functions other than writing to acquired memory must be called on the thread where the
+ * OpenGL context is current.
+ *
+ * \see gl_state_cache
+ */
+class gl_texture_streamer final {
+ public:
+  /**
+   * Creates a texture streamer.
+   *
+   * \param cache the state cache used to bind the texture and buffers, must outlive the
+   *        streamer.
+   * \param texture the OpenGL name of a 2D texture, which must already be allocated.
+   * \param size the size of the streamed frames, and of the texture.
+   * \param format the pixel format of the frames, e.g. `GL_RGBA`.
+   * \param type the component type of the frames, e.g. `GL_UNSIGNED_BYTE`.
+   * \param bytesPerPixel the size of each pixel, in bytes.
+   * \param depth the amount of pixel buffers, at least two.
+   */
+  gl_texture_streamer(gl_state_cache& cache,
+                      const GLuint texture,
+                      const iarea& size,
+                      const GLenum format = GL_RGBA,
+                      const GLenum type = GL_UNSIGNED_BYTE,
+                      const int bytesPerPixel = 4,
+                      const usize depth = 3)
+      : mCache {cache}
+      , mTexture {texture}
+      , mSize {size}
+      , mFormat {format}
+      , mType {type}
+      , mPitch {size.width * bytesPerPixel}
+      , mFrameSize {static_cast<usize>(mPitch) * static_cast<usize>(size.height)}
+      , mBuffers(depth)
+      , mFences(depth)
+  {
+    assert(size.width > 0 && size.height > 0);
+    assert(bytesPerPixel > 0);
+    assert(depth >= 2);
+
+    const auto& gl = functions();
+    mPersistent = gl.buffer_storage && gl.fence_sync;
+
+    gl.gen_buffers(static_cast<GLsizei>(mPersistent ? 1u : depth), mBuffers.data());
+
+    if (mPersistent) {
+      constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT |
+                                   GL_MAP_COHERENT_BIT;
+      const auto total = static_cast<GLsizeiptr>(mFrameSize * depth);
+
+      mCache.bind_buffer(GL_PIXEL_UNPACK_BUFFER, mBuffers.front());
+      gl.buffer_storage(GL_PIXEL_UNPACK_BUFFER, total, nullptr, flags);
+      auto* mapped = gl.map_buffer_range(GL_PIXEL_UNPACK_BUFFER, 0, total, flags);
+      mMapped = static_cast<uint8*>(mapped);
+      mCache.bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+      if (!mMapped) {
+        gl.delete_buffers(1, mBuffers.data());
+        throw exception {"Failed to map pixel buffer!"};
+      }
+    }
+    else {
+      mStaging.resize(mFrameSize);
+    }
+  }
+
+  CENTURION_DISABLE_COPY(gl_texture_streamer)
+  CENTURION_DISABLE_MOVE(gl_texture_streamer)
+
+  ~gl_texture_streamer() noexcept
+  {
+    const auto& gl = functions();
+
+    for (auto* fence : mFences) {
+      if (fence) {
+        gl.delete_sync(fence);
+      }
+    }
+
+    if (mPersistent) {
+      mCache.bind_buffer(GL_PIXEL_UNPACK_BUFFER, mBuffers.front());
+      gl.unmap_buffer(GL_PIXEL_UNPACK_BUFFER);
+      mCache.bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    const auto count = mPersistent ? 1u : mBuffers.size();
+    gl.delete_buffers(static_cast<GLsizei>(count), mBuffers.data());
+  }
+
+  /**
+   * Returns the memory that the next frame should be written to.
+   *
+   * The memory holds `size().height` tightly packed rows of `pitch()` bytes. The returned
+   * pointer is valid until the next call to `commit()`. This may block if the GPU hasn't
+   * finished reading the buffer yet.
+   *
+   * \return a pointer to writable memory for a single frame.
+   */
+  [[nodiscard]] auto acquire() -> void*
+  {
+    if (mPersistent) {
+      wait_for(mFences[mIndex]);
+      return mMapped + (mIndex * mFrameSize);
+    }
+    else {
+      return mStaging.data();
+    }
+  }
+
+  /// Updates the texture with the frame that was written to the memory from `acquire()`.
+  void commit()
+  {
+    const auto& gl = functions();
+
+    mCache.bind_texture(mTexture);
+    gl.pixel_storei(GL_UNPACK_ALIGNMENT, 1);
+
+    if (mPersistent) {
+      mCache.bind_buffer(GL_PIXEL_UNPACK_BUFFER, mBuffers.front());
+      gl.tex_sub_image_2d(GL_TEXTURE_2D,
+                          0,
+                          0,
+                          0,
+                          mSize.width,
+                          mSize.height,
+                          mFormat,
+                          mType,
+                          reinterpret_cast<const void*>(mIndex * mFrameSize));
+      mFences[mIndex] = gl.fence_sync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    else {
+      /* Orphaning the previous storage avoids waiting for the GPU to finish reading it */
+      mCache.bind_buffer(GL_PIXEL_UNPACK_BUFFER, mBuffers[mIndex]);
+      gl.buffer_data(GL_PIXEL_UNPACK_BUFFER,
+                     static_cast<GLsizeiptr>(mFrameSize),
+                     mStaging.data(),
+                     GL_STREAM_DRAW);
+      gl.tex_sub_image_2d(GL_TEXTURE_2D,
+                          0,
+                          0,
+                          0,
+                          mSize.width,
+                          mSize.height,
+                          mFormat,
+                          mType,
+                          nullptr);
+    }
+
+    /* Unbind the buffer, so that other client memory uploads, e.g. by SDL, are unaffected */
+    mCache.bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    gl.pixel_storei(GL_UNPACK_ALIGNMENT, 4);
+
+    mIndex = (mIndex + 1u) % mFences.size();
+    ++mFrames;
+  }
+
+  /**
+   * Copies a frame from client memory and updates the texture with it.
+   *
+   * \param pixels the pixel data, with the same size and format as the streamer.
+   * \param pitch the length of each row of the pixel data, in bytes.
+   */
+  void upload(const void* pixels, const int pitch)
+  {
+    assert(pixels);
+    assert(pitch >= mPitch);
+
+    auto* target = static_cast<uint8*>(acquire());
+    const auto* source = static_cast<const uint8*>(pixels);
+
+    if (pitch == mPitch) {
+      std::memcpy(target, source, mFrameSize);
+    }
+    else {
+      for (int y = 0; y < mSize.height; ++y) {
+        std::memcpy(target + (y * mPitch), source + (y * pitch), static_cast<usize>(mPitch));
+      }
+    }
+
+    commit();
+  }
+
+  /**
+   * Copies a frame from a surface and updates the texture with it.
+   *
+   * \param surface a surface with the same size and bytes per pixel as the streamer, which
+   *        must not require locking.
+   */
+  template <typename T>
+  void upload(const basic_surface<T>& surface)
+  {
+    assert(surface.size() == mSize);
+    assert(!surface.must_lock());
+    assert(surface.get()->format->BytesPerPixel * mSize.width == mPitch);
+
+    upload(surface.get()->pixels, surface.pitch());
+  }
+
+  /// Indicates whether the pixel buffers are persistently mapped.
+  [[nodiscard]] auto is_persistent() const noexcept -> bool { return mPersistent; }
+
+  [[nodiscard]] auto size() const noexcept -> iarea { return mSize; }
+
+  /// Returns the length of each row in acquired memory, in bytes.
+  [[nodiscard]] auto pitch() const noexcept -> int { return mPitch; }
+
+  /// Returns the amount of pixel buffers.
+  [[nodiscard]] auto depth() const noexcept -> usize { return mFences.size(); }
+
+  /// Returns the amount of committed frames.
+  [[nodiscard]] auto frames() const noexcept -> uint64 { return mFrames; }
+
+  /// Returns the amount of times `acquire()` had to wait for the GPU.
+  [[nodiscard]] auto stalls() const noexcept -> uint64 { return mStalls; }
+
+ private:
+  gl_state_cache& mCache;
+  GLuint mTexture {};
+  iarea mSize {};
+  GLenum mFormat {};
+  GLenum mType {};
+  int mPitch {};
+  usize mFrameSize {};
+  std::vector<GLuint> mBuffers;
+  std::vector<GLsync> mFences;  ///< Only used by persistently mapped buffers.
+  std::vector<uint8> mStaging;  ///< Only used without persistently mapped buffers.
+  uint8* mMapped {};
+  usize mIndex {};
+  uint64 mFrames {};
+  uint64 mStalls {};
+  bool mPersistent {};
+
+  [[nodiscard]] auto functions() const noexcept -> const gl_functions&
+  {
+    return mCache.functions();
+  }
+
+  void wait_for(GLsync& fence)
+  {
+    if (!fence) {
+      return;
+    }
+
+    const auto& gl = functions();
+
+    auto status = gl.client_wait_sync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+      ++mStalls;
+
+      while (status == GL_TIMEOUT_EXPIRED) {
+        status = gl.client_wait_sync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+      }
+    }
+
+    gl.delete_sync(fence);
+    fence = nullptr;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_OPENGL
+#endif  // CENTURION_VIDEO_GL_TEXTURE_STREAMER_HPP_
@@ -0,0 +1,303 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_GL_UPLOAD_CONTEXT_HPP_
+#define CENTURION_VIDEO_GL_UPLOAD_CONTEXT_HPP_
+
+#ifndef CENTURION_NO_OPENGL
+
+#include <SDL.h>
+#include <SDL_opengl.h>
+
+#include <atomic>      // atomic, memory_order
+#include <cassert>     // assert
+#include <functional>  // function
+#include <memory>      // unique_ptr
+#include <utility>     // move
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/semaphore.hpp"
+#include "../concurrency/task_queue.hpp"
+#include "../concurrency/thread.hpp"
+#include "gl_state.hpp"
+#include "opengl.hpp"
+#include "window.hpp"
+
+namespace cen {
+
+/// Identifies an upload submitted to a `gl_upload_context`, the first upload has ID 1.
+using gl_upload_id = uint64;
+
+/**
+ * Runs OpenGL uploads on a loader thread, using a context that shares objects with the
+ * render context.
+ *
+ * Each submitted upload is followed by a fence, and the loader thread waits for the fence
+ * before marking the upload as complete. Objects created or filled by a completed upload can
+ * therefore be used by the render context without further synchronization. Uploads complete
+ * in submission order.
+ *
+ * The loader thread makes the upload context current on the supplied window. Some platforms
+ * don't allow a window to be used by two threads, in which case a hidden window should be
+ * supplied instead of the main window.
+ *
+ * \see basic_gl_context
+ * \see gl_functions
+ */
+class gl_upload_context final {
+ public:
+  /// Uploads are executed on the loader thread, with the upload context current.
+  using upload_type = std::function<void(const gl_functions&)>;
+
+  /**
+   * Creates an upload context and starts the loader thread.
+   *
+   * The shared context is current again when the constructor returns.
+   *
+   * \param window the window that the shared context and the loader thread use.
+   * \param shared the render context, which must be current on the calling thread.
+   *
+   * \throws sdl_error if the context or the thread cannot be created.
+   * \throws exception if the context cannot be made current on the loader thread, or if
+   *         the required OpenGL functions cannot be loaded.
+   */
+  template <typename T, typename U>
+  gl_upload_context(basic_window<T>& window, const basic_gl_context<U>& shared)
+      : mWindow {window.get()}
+      , mContext {create_shared_context(window, shared)}
+      , mThread {&gl_upload_context::run, "gl_upload_context", this}
+  {
+    wait_until_started();
+  }
+
+  /**
+   * Starts a loader thread that runs uploads with existing functions, without creating an
+   * OpenGL context.
+   *
+   * \details No context is made current on the loader thread, so the functions must not
+   *          depend on one, e.g. when they forward the calls to a context that they manage
+   *          themselves. All required functions must be set.
+   *
+   * \param functions the functions that uploads are invoked with.
+   *
+   * \throws sdl_error if the thread cannot be created.
+   */
+  explicit gl_upload_context(const gl_functions& functions)
+      : mFunctions {functions}
+      , mThread {&gl_upload_context::run, "gl_upload_context", this}
+  {
+    wait_until_started();
+  }
+
+  CENTURION_DISABLE_COPY(gl_upload_context)
+  CENTURION_DISABLE_MOVE(gl_upload_context)
+
+  /// Completes all submitted uploads and stops the loader thread.
+  ~gl_upload_context() noexcept
+  {
+    mRunning.store(false, std::memory_order_release);
+    mWakeup.release();
+    mThread.join();
+  }
+
+  /**
+   * Schedules an upload, may be called from any thread.
+   *
+   * \param upload the function object that performs the upload.
+   *
+   * \return the ID of the upload, see `is_complete()`.
+   */
+  auto submit(upload_type upload) -> gl_upload_id
+  {
+    const auto id = mSubmitted.fetch_add(1, std::memory_order_relaxed) + 1u;
+
+    mUploads.post([this, id, task = std::move(upload)] { execute(id, task); });
+    mWakeup.release();
+
+    return id;
+  }
+
+  /// Indicates whether an upload and its OpenGL commands have completed.
+  [[nodiscard]] auto is_complete(const gl_upload_id id) const noexcept -> bool
+  {
+    return id <= mCompleted.load(std::memory_order_acquire);
+  }
+
+  /// Blocks until an upload has completed.
+  void wait(const gl_upload_id id) const noexcept
+  {
+    while (!is_complete(id)) {
+      thread::sleep(u32ms {1});
+    }
+  }
+
+  /// Blocks until all uploads submitted so far have completed.
+  void wait_all() const noexcept { wait(mSubmitted.load(std::memory_order_relaxed)); }
+
+  /// Returns the amount of uploads that have been submitted but not yet completed.
+  [[nodiscard]] auto pending() const noexcept -> uint64
+  {
+    return mSubmitted.load(std::memory_order_relaxed) -
+           mCompleted.load(std::memory_order_acquire);
+  }
+
+  /// Returns the amount of uploads that threw an exception.
+  [[nodiscard]] auto failed() const noexcept -> uint64
+  {
+    return mFailed.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto get() const noexcept -> SDL_GLContext { return mContext.get(); }
+
+ private:
+  enum class status { starting, ready, failed };
+
+  struct deleter final {
+    void operator()(SDL_GLContext context) noexcept { SDL_GL_DeleteContext(context); }
+  };
+
+  SDL_Window* mWindow {};
+  std::unique_ptr<void, deleter> mContext;
+  task_queue mUploads;
+  semaphore mWakeup {0};
+  gl_functions mFunctions;
+  std::atomic<status> mStatus {status::starting};
+  std::atomic<bool> mRunning {true};
+  std::atomic<uint64> mSubmitted {};
+  std::atomic<uint64> mCompleted {};
+  std::atomic<uint64> mFailed {};
+  thread mThread;  ///< Must be declared last, since it uses the other members immediately.
+
+  void wait_until_started()
+  {
+    while (mStatus.load(std::memory_order_acquire) == status::starting) {
+      thread::sleep(u32ms {1});
+    }
+
+    if (mStatus.load(std::memory_order_acquire) == status::failed) {
+      mThread.join();
+      throw exception {"Failed to initialize OpenGL upload context!"};
+    }
+  }
+
+  template <typename T, typename U>
+  [[nodiscard]] static auto create_shared_context(basic_window<T>& window,
+                                                  const basic_gl_context<U>& shared)
+      -> SDL_GLContext
+  {
+    assert(window.is_opengl());
+    assert(shared.get() == SDL_GL_GetCurrentContext());
+
+    const auto previous = gl::get(gl_attribute::share_with_current_context).value_or(0);
+    gl::set(gl_attribute::share_with_current_context, 1);
+
+    /* Creating a context makes it current, so the shared context is restored afterwards */
+    auto* context = SDL_GL_CreateContext(window.get());
+
+    gl::set(gl_attribute::share_with_current_context, previous);
+    SDL_GL_MakeCurrent(window.get(), shared.get());
+
+    if (!context) {
+      throw sdl_error {};
+    }
+
+    return context;
+  }
+
+  void execute(const gl_upload_id id, const upload_type& upload) noexcept
+  {
+    try {
+      upload(mFunctions);
+    }
+    catch (...) {
+      mFailed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /* Don't report completion before the GPU has executed the commands of the upload */
+    if (mFunctions.fence_sync) {
+      auto* fence = mFunctions.fence_sync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+      mFunctions.flush();
+
+      while (mFunctions.client_wait_sync(fence, 0, 1'000'000) == GL_TIMEOUT_EXPIRED) {
+        /* Wait in one millisecond steps, until the fence is signaled or the wait fails */
+      }
+
+      mFunctions.delete_sync(fence);
+    }
+    else {
+      mFunctions.finish();
+    }
+
+    mCompleted.store(id, std::memory_order_release);
+  }
+
+  static int SDLCALL run(void* data)
+  {
+    auto* self = static_cast<gl_upload_context*>(data);
+
+    if (self->mContext && !self->make_current()) {
+      self->mStatus.store(status::failed, std::memory_order_release);
+      return -1;
+    }
+
+    self->mStatus.store(status::ready, std::memory_order_release);
+
+    /* Keep running after being stopped, so that no submitted upload is lost */
+    while (self->mRunning.load(std::memory_order_acquire) || !self->mUploads.empty()) {
+      self->mWakeup.acquire(u32ms {10});
+      self->mUploads.run_pending();
+    }
+
+    if (self->mContext) {
+      SDL_GL_MakeCurrent(self->mWindow, nullptr);
+    }
+
+    return 0;
+  }
+
+  /* Makes the upload context current on the loader thread, and loads its functions */
+  auto make_current() -> bool
+  {
+    if (SDL_GL_MakeCurrent(mWindow, mContext.get()) != 0) {
+      return false;
+    }
+
+    if (auto functions = gl_functions::load()) {
+      mFunctions = *functions;
+      return true;
+    }
+    else {
+      SDL_GL_MakeCurrent(mWindow, nullptr);
+      return false;
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_OPENGL
+#endif  // CENTURION_VIDEO_GL_UPLOAD_CONTEXT_HPP_
@@ -0,0 +1,279 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_IMAGE_LOADER_HPP_
+#define CENTURION_VIDEO_IMAGE_LOADER_HPP_
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+#include <SDL.h>
+
+#include <atomic>       // atomic
+#include <deque>        // deque
+#include <memory>       // shared_ptr, make_shared
+#include <string>       // string
+#include <string_view>  // string_view
+#include <utility>      // move, forward
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/spin_lock.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../io/asset_pack.hpp"
+#include "../system/timer.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+#include "texture.hpp"
+
+namespace cen {
+
+/**
+ * Decodes images on worker threads, and uploads them as textures within a time budget.
+ *
+ * Images are decoded into surfaces, and optionally converted to a pixel format, on a thread
+ * pool. Decoded surfaces are queued until the render thread calls `upload()`, which creates
+ * textures until the supplied time budget is exhausted. This spreads texture creation over
+ * several frames, while all decoding work happens off the render thread.
+ * \code{cpp}
+ * cen::image_loader loader {pool, cen::get_info(renderer)->get_format(0)};
+ * const auto id = loader.load("sprites/player.png");
+ *
+ * // Once per frame
+ * loader.upload(renderer, cen::millis<double> {2}, [&](const auto id, auto texture) {
+ *   if (texture) {
+ *     textures.emplace(id, std::move(*texture));
+ *   }
+ * });
+ * \endcode
+ *
+ * \details Decoding failures are reported as empty optionals, rather than as exceptions. The
+ *          loader may be destroyed while images are still being decoded, but asset packs must
+ *          outlive all images that are loaded from them.
+ */
+class image_loader final {
+ public:
+  using id_type = uint64;
+  using size_type = usize;
+
+  /**
+   * Creates an image loader.
+   *
+   * \param pool the thread pool used to decode images, must outlive the loader.
+   * \param format the pixel format that the decoded images are converted to, if any. Using
+   *        the preferred format of the renderer avoids conversions when creating textures.
+   */
+  explicit image_loader(thread_pool& pool, const maybe<pixel_format> format = nothing)
+      : mPool {&pool}
+      , mState {std::make_shared<shared_state>()}
+      , mFormat {format}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(image_loader)
+  CENTURION_DISABLE_MOVE(image_loader)
+
+  /**
+   * Starts decoding an image file.
+   *
+   * \param path the path of the image file.
+   *
+   * \return the identifier of the image.
+   */
+  auto load(std::string path) -> id_type
+  {
+    return submit([path = std::move(path)] { return surface {path.c_str()}; });
+  }
+
+  /**
+   * Starts decoding an image in an asset pack.
+   *
+   * \param pack the asset pack that contains the image, must outlive the decoding.
+   * \param name the name of the pack entry.
+   *
+   * \return the identifier of the image.
+   */
+  auto load(const asset_pack& pack, const std::string_view name) -> id_type
+  {
+    return submit([&pack, name = std::string {name}] {
+      auto view = pack.open(name);
+      return surface {view};
+    });
+  }
+
+  /**
+   * Creates textures from decoded images until a time budget is exhausted.
+   *
+   * At least one image is uploaded if any is ready, regardless of the budget.
+   *
+   * \param renderer the renderer used to create the textures.
+   * \param budget the maximum amount of time to spend creating textures.
+   * \param callable the function object that receives the textures, with signature
+   *        `void(id_type, maybe<texture>)`. The texture is empty if the image couldn't be
+   *        decoded or uploaded.
+   *
+   * \return the amount of images that were processed.
+   */
+  template <typename T, typename Callable>
+  auto upload(const basic_renderer<T>& renderer,
+              const millis<double> budget,
+              Callable&& callable) -> size_type
+  {
+    const auto start = now();
+    const auto limit =
+        static_cast<double>(frequency()) * std::chrono::duration<double>(budget).count();
+
+    size_type count {};
+    while (auto image = take()) {
+      maybe<texture> result;
+
+      if (image->image) {
+        try {
+          result.emplace(renderer.make_texture(*image->image));
+        }
+        catch (const sdl_error&) {
+          /* The failure is reported through the empty texture */
+        }
+      }
+
+      callable(image->id, std::move(result));
+      ++count;
+
+      if (static_cast<double>(now() - start) >= limit) {
+        break;
+      }
+    }
+
+    return count;
+  }
+
+  /**
+   * Takes all decoded images as surfaces, without creating any textures.
+   *
+   * \param callable the function object that receives the surfaces, with signature
+   *        `void(id_type, maybe<surface>)`.
+   *
+   * \return the amount of images that were processed.
+   */
+  template <typename Callable>
+  auto poll(Callable&& callable) -> size_type
+  {
+    size_type count {};
+    while (auto image = take()) {
+      callable(image->id, std::move(image->image));
+      ++count;
+    }
+
+    return count;
+  }
+
+  /// Returns the amount of images that are still being decoded.
+  [[nodiscard]] auto decoding() const noexcept -> size_type
+  {
+    return mState->decoding.load(std::memory_order_acquire);
+  }
+
+  /// Returns the amount of decoded images that are waiting to be uploaded.
+  [[nodiscard]] auto ready() const -> size_type
+  {
+    scoped_lock lock {mState->lock};
+    return mState->images.size();
+  }
+
+  /// Indicates whether there are no images that are being decoded or waiting to be uploaded.
+  [[nodiscard]] auto idle() const -> bool { return decoding() == 0 && ready() == 0; }
+
+  [[nodiscard]] auto format() const noexcept -> const maybe<pixel_format>& { return mFormat; }
+
+ private:
+  struct decoded_image final {
+    id_type id {};
+    maybe<surface> image;
+  };
+
+  struct shared_state final {
+    spin_lock lock;
+    std::deque<decoded_image> images;
+    std::atomic<size_type> decoding {};
+  };
+
+  thread_pool* mPool {};
+  std::shared_ptr<shared_state> mState;
+  maybe<pixel_format> mFormat;
+  id_type mNextId {1};
+
+  template <typename Decode>
+  auto submit(Decode decode) -> id_type
+  {
+    const auto id = mNextId++;
+
+    mState->decoding.fetch_add(1, std::memory_order_relaxed);
+    mPool->submit([state = mState, format = mFormat, id, decode = std::move(decode)] {
+      decoded_image result {id, nothing};
+
+      try {
+        auto image = decode();
+
+        if (format && image.format_info().format() != *format) {
+          image = image.convert_to(*format);
+        }
+
+        result.image.emplace(std::move(image));
+      }
+      catch (const exception&) {
+        /* The failure is reported through the empty surface */
+      }
+
+      {
+        scoped_lock lock {state->lock};
+        state->images.push_back(std::move(result));
+      }
+
+      state->decoding.fetch_sub(1, std::memory_order_release);
+    });
+
+    return id;
+  }
+
+  [[nodiscard]] auto take() -> maybe<decoded_image>
+  {
+    scoped_lock lock {mState->lock};
+
+    if (mState->images.empty()) {
+      return nothing;
+    }
+
+    maybe<decoded_image> image {std::move(mState->images.front())};
+    mState->images.pop_front();
+
+    return image;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_IMAGE
+#endif  // CENTURION_VIDEO_IMAGE_LOADER_HPP_
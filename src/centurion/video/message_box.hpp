@@ -29,7 +29,6 @@
 
 #include <algorithm>    // max, any_of
 #include <optional>     // optional, nullopt
-#include <ostream>      // ostream
 #include <string>       // string
 #include <string_view>  // string_view
 #include <utility>      // move
@@ -40,6 +39,12 @@
 #include "color.hpp"
 #include "window.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class message_box_type : uint32 {
@@ -65,11 +70,15 @@ enum class message_box_type : uint32 {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const message_box_type type) -> std::ostream&
 {
   return stream << to_string(type);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 enum class message_box_button_order : uint32 {
 #if SDL_VERSION_ATLEAST(2, 0, 12)
   left_to_right = SDL_MESSAGEBOX_BUTTONS_LEFT_TO_RIGHT,
@@ -95,12 +104,16 @@ enum class message_box_button_order : uint32 {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const message_box_button_order order)
     -> std::ostream&
 {
   return stream << to_string(order);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 enum class message_box_color_type : int {
   background = SDL_MESSAGEBOX_COLOR_BACKGROUND,
   text = SDL_MESSAGEBOX_COLOR_TEXT,
@@ -132,12 +145,16 @@ enum class message_box_color_type : int {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const message_box_color_type type)
     -> std::ostream&
 {
   return stream << to_string(type);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 class message_box_color_scheme final {
  public:
   message_box_color_scheme() noexcept
@@ -0,0 +1,261 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_MIPMAPPED_TEXTURE_HPP_
+#define CENTURION_VIDEO_MIPMAPPED_TEXTURE_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <string>   // string, to_string
+#include <utility>  // move
+#include <vector>   // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+#include "surface_ops.hpp"
+#include "texture.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/**
+ * A texture with a chain of progressively halved levels, for images that are minified.
+ *
+ * SDL only samples the full size texture, so heavily minified images shimmer and waste
+ * texture bandwidth. This class stores the image as a chain of textures, where each level
+ * halves the size of the previous one, and the rendering functions select the level from the
+ * ratio between the destination and source sizes. The levels are generated with
+ * `make_mip_chain()`, using a thread pool.
+ *
+ * \details The level textures use linear filtering, when it is supported, which together
+ *          with the level selection approximates trilinear filtering without blending
+ *          between levels. Texture state, such as the blend mode, is applied to every level.
+ *
+ * \see make_mip_chain
+ * \see select_mip_level
+ */
+class mipmapped_texture final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a mipmapped texture from a surface.
+   *
+   * \param renderer the renderer used to create the level textures.
+   * \param pool the thread pool used to filter the levels.
+   * \param image the full size image.
+   * \param maxLevels the maximum amount of levels, including the full size level, zero means
+   *        that the chain continues until the size is 1x1.
+   *
+   * \throws sdl_error if the levels cannot be created.
+   */
+  template <typename T, typename U>
+  mipmapped_texture(const basic_renderer<T>& renderer,
+                    thread_pool& pool,
+                    const basic_surface<U>& image,
+                    const size_type maxLevels = 0)
+  {
+    mLevels.push_back(renderer.make_texture(image));
+
+    for (auto& level : make_mip_chain(pool, image)) {
+      if (maxLevels != 0 && mLevels.size() == maxLevels) {
+        break;
+      }
+
+      mLevels.push_back(renderer.make_texture(level));
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+    set_scale_mode(scale_mode::linear);
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
+  }
+
+  /**
+   * Selects the level used to render a region of the image.
+   *
+   * \param source the region of the full size image.
+   * \param destination the destination of the region.
+   *
+   * \return the index of the selected level, where zero is the full size level.
+   */
+  [[nodiscard]] auto select_level(const irect& source, const frect& destination) const noexcept
+      -> size_type
+  {
+    if (!source.has_area()) {
+      return 0;
+    }
+
+    /* The least minified axis decides, since a smaller level would blur that axis */
+    const auto sx = destination.width() / static_cast<float>(source.width());
+    const auto sy = destination.height() / static_cast<float>(source.height());
+    return select_mip_level((detail::max)(sx, sy), mLevels.size(), mBias);
+  }
+
+  /**
+   * Renders the entire image, using the level that matches the destination size.
+   *
+   * \param renderer the renderer that will be used.
+   * \param destination the destination of the image.
+   *
+   * \return `success` if the image was rendered; `failure` otherwise.
+   */
+  template <typename T>
+  auto render(basic_renderer<T>& renderer, const frect& destination) noexcept -> result
+  {
+    return render(renderer, irect {{0, 0}, size()}, destination);
+  }
+
+  /**
+   * Renders a region of the image, using the level that matches the destination size.
+   *
+   * \param renderer the renderer that will be used.
+   * \param source the region of the full size image that will be rendered.
+   * \param destination the destination of the region.
+   *
+   * \return `success` if the image was rendered; `failure` otherwise.
+   */
+  template <typename T>
+  auto render(basic_renderer<T>& renderer,
+              const irect& source,
+              const frect& destination) noexcept -> result
+  {
+    const auto index = select_level(source, destination);
+    mLastLevel = index;
+
+    const auto& level = mLevels[index];
+    if (index == 0) {
+      return renderer.render(level, source, destination);
+    }
+    else {
+      const auto region = detail::mip_source(source, size(), level.size());
+      return renderer.render(level, region, destination);
+    }
+  }
+
+  /// Sets the level bias, positive values prefer smaller levels.
+  void set_lod_bias(const float bias) noexcept { mBias = bias; }
+
+  void set_blend_mode(const blend_mode mode) noexcept
+  {
+    for (auto& level : mLevels) {
+      level.set_blend_mode(mode);
+    }
+  }
+
+  void set_color_mod(const color& color) noexcept
+  {
+    for (auto& level : mLevels) {
+      level.set_color_mod(color);
+    }
+  }
+
+  void set_alpha_mod(const uint8 alpha) noexcept
+  {
+    for (auto& level : mLevels) {
+      level.set_alpha_mod(alpha);
+    }
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+
+  void set_scale_mode(const scale_mode mode) noexcept
+  {
+    for (auto& level : mLevels) {
+      level.set_scale_mode(mode);
+    }
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
+
+  /// Returns the texture of a level, where zero is the full size level.
+  [[nodiscard]] auto level(const size_type index) const -> const texture&
+  {
+    assert(index < mLevels.size());
+    return mLevels[index];
+  }
+
+  /// Returns the amount of levels, including the full size level.
+  [[nodiscard]] auto level_count() const noexcept -> size_type { return mLevels.size(); }
+
+  /// Returns the level used by the latest rendering call.
+  [[nodiscard]] auto last_level() const noexcept -> size_type { return mLastLevel; }
+
+  [[nodiscard]] auto lod_bias() const noexcept -> float { return mBias; }
+
+  /// Returns the size of the full size level.
+  [[nodiscard]] auto size() const noexcept -> iarea { return mLevels.front().size(); }
+
+ private:
+  std::vector<texture> mLevels;
+  size_type mLastLevel {};
+  float mBias {};
+};
+
+[[nodiscard]] inline auto to_string(const mipmapped_texture& texture) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("mipmapped_texture(size: {}, levels: {})",
+                     to_string(texture.size()),
+                     texture.level_count());
+#else
+  return "mipmapped_texture(size: " + to_string(texture.size()) +
+         ", levels: " + std::to_string(texture.level_count()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const mipmapped_texture& texture)
+    -> std::ostream&
+{
+  return stream << to_string(texture);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_MIPMAPPED_TEXTURE_HPP_
@@ -0,0 +1,444 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_NINE_SLICE_HPP_
+#define CENTURION_VIDEO_NINE_SLICE_HPP_
+
+#include <SDL.h>
+
+#include <array>        // array
+#include <cmath>        // lround
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "atlas_region.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "renderer.hpp"
+#include "sprite_batch.hpp"
+#include "texture.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+/// Provides different ways of filling the edges and center of a nine-slice.
+enum class nine_slice_fill {
+  stretch,  ///< The slice is stretched to cover the destination.
+  tile      ///< The slice is repeated, and the last repetition is cropped.
+};
+
+[[nodiscard]] constexpr auto to_string(const nine_slice_fill fill) -> std::string_view
+{
+  switch (fill) {
+    case nine_slice_fill::stretch:
+      return "stretch";
+
+    case nine_slice_fill::tile:
+      return "tile";
+
+    default:
+      throw exception {"Did not recognize nine-slice fill!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const nine_slice_fill fill) -> std::ostream&
+{
+  return stream << to_string(fill);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/// Describes the border widths of a nine-slice, in source texture pixels.
+struct nine_slice_insets final {
+  int left {};
+  int top {};
+  int right {};
+  int bottom {};
+};
+
+/**
+ * Renders a scalable panel from a texture region that is split into nine slices.
+ *
+ * The corners keep their source size, unless the destination is too small for them, in
+ * which case they are scaled down. The edges and the center are either stretched or tiled,
+ * where tiles keep the aspect ratio of their source slice.
+ *
+ * The source rectangles of the slices are computed once, when the nine-slice is created.
+ * All quads of a panel can either be added to a `sprite_batch`, or be appended to a vertex
+ * and index buffer, so that many panels that share a texture can be rendered with a single
+ * geometry call.
+ *
+ * Note, only a raw texture pointer is stored, so the texture must outlive the nine-slice.
+ *
+ * \see sprite_batch
+ * \see basic_renderer::render_geo
+ */
+class nine_slice final {
+ public:
+  /// A single quad of a panel, the source is specified in texture pixels.
+  struct quad final {
+    frect source;
+    frect destination;
+  };
+
+  /**
+   * Creates a nine-slice from a region of a texture.
+   *
+   * \param texture the texture that contains the panel.
+   * \param source the region of the texture that contains the panel.
+   * \param insets the border widths, which determine the size of the corners.
+   * \param edges the way that the edges are filled.
+   * \param center the way that the center is filled.
+   *
+   * \throws exception if the insets are negative or do not fit within the source region.
+   */
+  template <typename T>
+  nine_slice(const basic_texture<T>& texture,
+             const irect& source,
+             const nine_slice_insets& insets,
+             const nine_slice_fill edges = nine_slice_fill::stretch,
+             const nine_slice_fill center = nine_slice_fill::stretch)
+      : nine_slice {texture.get(), texture.size(), source, insets, edges, center}
+  {
+  }
+
+  /// Creates a nine-slice that uses an entire texture.
+  template <typename T>
+  nine_slice(const basic_texture<T>& texture,
+             const nine_slice_insets& insets,
+             const nine_slice_fill edges = nine_slice_fill::stretch,
+             const nine_slice_fill center = nine_slice_fill::stretch)
+      : nine_slice {texture, irect {{0, 0}, texture.size()}, insets, edges, center}
+  {
+  }
+
+  /// Creates a nine-slice from a texture atlas region.
+  nine_slice(const atlas_region& region,
+             const nine_slice_insets& insets,
+             const nine_slice_fill edges = nine_slice_fill::stretch,
+             const nine_slice_fill center = nine_slice_fill::stretch)
+      : nine_slice {region.page_texture(), region.source, insets, edges, center}
+  {
+  }
+
+  /**
+   * Adds the quads of a panel to a sprite batch.
+   *
+   * \details The sources of cropped tiles are rounded to whole pixels, since sprite batches
+   * use integer source rectangles. Use `append()` for exact texture coordinates.
+   *
+   * \param batch the sprite batch that the quads are added to.
+   * \param destination the area covered by the panel.
+   * \param layer the layer of the panel.
+   * \param tint the color modulation of the panel.
+   * \param blend the blend mode used by the panel.
+   */
+  void add_to(sprite_batch& batch,
+              const frect& destination,
+              const int layer = 0,
+              const color& tint = colors::white,
+              const blend_mode blend = blend_mode::blend) const
+  {
+    const texture_handle texture {mTexture};
+    for_each_quad(destination, [&](const quad& q) {
+      const irect source {static_cast<int>(std::lround(q.source.x())),
+                          static_cast<int>(std::lround(q.source.y())),
+                          static_cast<int>(std::lround(q.source.width())),
+                          static_cast<int>(std::lround(q.source.height()))};
+      batch.add(texture, source, q.destination, layer, tint, blend);
+    });
+  }
+
+  /**
+   * Appends the triangles of a panel to vertex and index buffers.
+   *
+   * \details The buffers may contain the geometry of other panels that use the same
+   * texture, and are then rendered with a single call to `basic_renderer::render_geo()`.
+   *
+   * \param destination the area covered by the panel.
+   * \param vertices the vertex buffer that will be appended to.
+   * \param indices the index buffer that will be appended to.
+   * \param tint the color modulation of the panel.
+   */
+  void append(const frect& destination,
+              std::vector<SDL_Vertex>& vertices,
+              std::vector<int>& indices,
+              const color& tint = colors::white) const
+  {
+    const auto& rgba = tint.get();
+    for_each_quad(destination, [&](const quad& q) {
+      const auto u0 = q.source.x() * mInverseSize.width;
+      const auto v0 = q.source.y() * mInverseSize.height;
+      const auto u1 = q.source.max_x() * mInverseSize.width;
+      const auto v1 = q.source.max_y() * mInverseSize.height;
+
+      const auto& dst = q.destination;
+      const auto first = static_cast<int>(vertices.size());
+
+      vertices.push_back({{dst.x(), dst.y()}, rgba, {u0, v0}});
+      vertices.push_back({{dst.max_x(), dst.y()}, rgba, {u1, v0}});
+      vertices.push_back({{dst.max_x(), dst.max_y()}, rgba, {u1, v1}});
+      vertices.push_back({{dst.x(), dst.max_y()}, rgba, {u0, v1}});
+
+      indices.insert(indices.end(),
+                     {first, first + 1, first + 2, first + 2, first + 3, first});
+    });
+  }
+
+  /**
+   * Renders a panel with a single geometry call.
+   *
+   * \param renderer the renderer that will be used.
+   * \param destination the area covered by the panel.
+   * \param tint the color modulation of the panel.
+   *
+   * \return `success` if the panel was rendered; `failure` otherwise.
+   */
+  template <typename T>
+  auto render(basic_renderer<T>& renderer,
+              const frect& destination,
+              const color& tint = colors::white) -> result
+  {
+    mVertices.clear();
+    mIndices.clear();
+
+    append(destination, mVertices, mIndices, tint);
+    return renderer.render_geo(texture_handle {mTexture}, mVertices, mIndices);
+  }
+
+  /// Returns the amount of quads that are used to render a panel.
+  [[nodiscard]] auto quad_count(const frect& destination) const noexcept -> usize
+  {
+    usize count = 0;
+    for_each_quad(destination, [&](const quad&) noexcept { ++count; });
+    return count;
+  }
+
+  /**
+   * Returns the source rectangles of the slices, in row-major order.
+   *
+   * \details The first slice is the top-left corner, and the last slice is the bottom-right
+   * corner. Slices without any area, i.e. due to zero insets, have empty sources.
+   */
+  [[nodiscard]] auto sources() const noexcept -> const std::array<frect, 9>&
+  {
+    return mSources;
+  }
+
+  [[nodiscard]] auto insets() const noexcept -> const nine_slice_insets& { return mInsets; }
+
+  [[nodiscard]] auto edge_fill() const noexcept -> nine_slice_fill { return mEdges; }
+
+  [[nodiscard]] auto center_fill() const noexcept -> nine_slice_fill { return mCenter; }
+
+  [[nodiscard]] auto get() const noexcept -> SDL_Texture* { return mTexture; }
+
+ private:
+  SDL_Texture* mTexture {};
+  farea mInverseSize;
+  std::array<frect, 9> mSources;
+  nine_slice_insets mInsets;
+  nine_slice_fill mEdges {nine_slice_fill::stretch};
+  nine_slice_fill mCenter {nine_slice_fill::stretch};
+  std::vector<SDL_Vertex> mVertices;
+  std::vector<int> mIndices;
+
+  nine_slice(SDL_Texture* texture,
+             const iarea& textureSize,
+             const irect& source,
+             const nine_slice_insets& insets,
+             const nine_slice_fill edges,
+             const nine_slice_fill center)
+      : mTexture {texture}
+      , mInsets {insets}
+      , mEdges {edges}
+      , mCenter {center}
+  {
+    if (insets.left < 0 || insets.top < 0 || insets.right < 0 || insets.bottom < 0) {
+      throw exception {"Nine-slice insets cannot be negative!"};
+    }
+
+    if (insets.left + insets.right > source.width() ||
+        insets.top + insets.bottom > source.height()) {
+      throw exception {"Nine-slice insets do not fit within the source region!"};
+    }
+
+    if (textureSize.width > 0 && textureSize.height > 0) {
+      mInverseSize = {1.0f / static_cast<float>(textureSize.width),
+                      1.0f / static_cast<float>(textureSize.height)};
+    }
+
+    const std::array<int, 4> xs {source.x(),
+                                 source.x() + insets.left,
+                                 source.max_x() - insets.right,
+                                 source.max_x()};
+    const std::array<int, 4> ys {source.y(),
+                                 source.y() + insets.top,
+                                 source.max_y() - insets.bottom,
+                                 source.max_y()};
+
+    for (usize row = 0; row < 3; ++row) {
+      for (usize col = 0; col < 3; ++col) {
+        mSources[row * 3 + col] = {static_cast<float>(xs[col]),
+                                   static_cast<float>(ys[row]),
+                                   static_cast<float>(xs[col + 1] - xs[col]),
+                                   static_cast<float>(ys[row + 1] - ys[row])};
+      }
+    }
+  }
+
+  /* Corners are scaled down uniformly on each axis if the destination is too small */
+  template <typename Callable>
+  void for_each_quad(const frect& destination, const Callable& callable) const
+  {
+    const auto horizontal = static_cast<float>(mInsets.left + mInsets.right);
+    const auto vertical = static_cast<float>(mInsets.top + mInsets.bottom);
+
+    const auto sx = (horizontal > destination.width() && horizontal > 0)
+                        ? destination.width() / horizontal
+                        : 1.0f;
+    const auto sy = (vertical > destination.height() && vertical > 0)
+                        ? destination.height() / vertical
+                        : 1.0f;
+
+    const auto left = static_cast<float>(mInsets.left) * sx;
+    const auto right = static_cast<float>(mInsets.right) * sx;
+    const auto top = static_cast<float>(mInsets.top) * sy;
+    const auto bottom = static_cast<float>(mInsets.bottom) * sy;
+
+    const std::array<float, 4> xs {destination.x(),
+                                   destination.x() + left,
+                                   destination.max_x() - right,
+                                   destination.max_x()};
+    const std::array<float, 4> ys {destination.y(),
+                                   destination.y() + top,
+                                   destination.max_y() - bottom,
+                                   destination.max_y()};
+
+    for (usize row = 0; row < 3; ++row) {
+      for (usize col = 0; col < 3; ++col) {
+        const auto& source = mSources[row * 3 + col];
+        const frect dst {xs[col], ys[row], xs[col + 1] - xs[col], ys[row + 1] - ys[row]};
+
+        if (source.width() <= 0 || source.height() <= 0 || dst.width() <= 0 ||
+            dst.height() <= 0) {
+          continue;
+        }
+
+        const auto isCenter = row == 1 && col == 1;
+        const auto isCorner = row != 1 && col != 1;
+        const auto fill = isCenter ? mCenter : mEdges;
+
+        if (isCorner || fill == nine_slice_fill::stretch) {
+          callable(quad {source, dst});
+        }
+        else {
+          /* Edges only repeat along their length, and keep the scale of the border */
+          const auto tileX = row != 1 || isCenter;
+          const auto tileY = col != 1 || isCenter;
+
+          const auto tileWidth = tileX ? source.width() * (row == 1 ? sx : sy) : dst.width();
+          const auto tileHeight =
+              tileY ? source.height() * (col == 1 ? sy : sx) : dst.height();
+
+          tile(source, dst, {tileWidth, tileHeight}, callable);
+        }
+      }
+    }
+  }
+
+  template <typename Callable>
+  static void tile(const frect& source,
+                   const frect& dst,
+                   const farea& tileSize,
+                   const Callable& callable)
+  {
+    for (auto y = dst.y(); y < dst.max_y(); y += tileSize.height) {
+      const auto height = (detail::min)(tileSize.height, dst.max_y() - y);
+      const auto sourceHeight = source.height() * (height / tileSize.height);
+
+      for (auto x = dst.x(); x < dst.max_x(); x += tileSize.width) {
+        const auto width = (detail::min)(tileSize.width, dst.max_x() - x);
+        const auto sourceWidth = source.width() * (width / tileSize.width);
+
+        callable(quad {{source.x(), source.y(), sourceWidth, sourceHeight},
+                       {x, y, width, height}});
+      }
+    }
+  }
+};
+
+[[nodiscard]] inline auto to_string(const nine_slice& slice) -> std::string
+{
+  const auto& insets = slice.insets();
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("nine_slice(left: {}, top: {}, right: {}, bottom: {})",
+                     insets.left,
+                     insets.top,
+                     insets.right,
+                     insets.bottom);
+#else
+  return "nine_slice(left: " + std::to_string(insets.left) +
+         ", top: " + std::to_string(insets.top) + ", right: " + std::to_string(insets.right) +
+         ", bottom: " + std::to_string(insets.bottom) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const nine_slice& slice) -> std::ostream&
+{
+  return stream << to_string(slice);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_NINE_SLICE_HPP_
@@ -32,7 +32,6 @@
 #include <cassert>      // assert
 #include <memory>       // unique_ptr
 #include <optional>     // optional
-#include <ostream>      // ostream
 #include <string>       // string
 #include <string_view>  // string_view
 
@@ -44,6 +43,12 @@
 #include "texture.hpp"
 #include "window.hpp"
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class gl_attribute {
@@ -180,11 +185,15 @@ enum class gl_attribute {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const gl_attribute attr) -> std::ostream&
 {
   return stream << to_string(attr);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 enum class gl_swap_interval {
   late_immediate = -1,
   immediate = 0,
@@ -208,11 +217,15 @@ enum class gl_swap_interval {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const gl_swap_interval interval) -> std::ostream&
 {
   return stream << to_string(interval);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 /**
  * \brief Manages the initialization and de-initialization of an OpenGL library.
  */
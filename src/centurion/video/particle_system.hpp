@@ -0,0 +1,363 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_PARTICLE_SYSTEM_HPP_
+#define CENTURION_VIDEO_PARTICLE_SYSTEM_HPP_
+
+#include <SDL.h>
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/simd_vector.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/particle_kernels.hpp"
+#include "../detail/stdlib.hpp"
+#include "color.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+
+namespace cen {
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+/// Describes a particle that is emitted by a `particle_system`.
+struct particle final {
+  fpoint position;             ///< The center of the particle.
+  fpoint velocity;             ///< The velocity, in units per second.
+  float lifetime {1};          ///< The time the particle is alive for, in seconds.
+  float size {4};              ///< The side length of the particle quad.
+  color tint {colors::white};  ///< The color modulation of the particle.
+};
+
+/**
+ * Simulates and renders large amounts of particles that share a single texture.
+ *
+ * The particle properties are stored as structure-of-arrays in SIMD-friendly vectors, and
+ * are integrated with vectorized kernels, optionally split across a thread pool. Rendering
+ * writes a single vertex and index stream for all particles, which is submitted with one
+ * geometry call, instead of one call per particle.
+ *
+ * Use one system per texture, since each system is rendered with a single texture. Particle
+ * order is not preserved, since dead particles are replaced by the last particle.
+ *
+ * \see basic_renderer::render_geo
+ */
+class particle_system final {
+ public:
+  using size_type = usize;
+
+  /// The default amount of particles processed by each task when using a thread pool.
+  inline constexpr static size_type default_grain = 4'096;
+
+  particle_system() noexcept = default;
+
+  /// Creates a system with storage for the specified amount of particles.
+  explicit particle_system(const size_type capacity) { reserve(capacity); }
+
+  void reserve(const size_type capacity)
+  {
+    mX.reserve(capacity);
+    mY.reserve(capacity);
+    mVelocityX.reserve(capacity);
+    mVelocityY.reserve(capacity);
+    mAge.reserve(capacity);
+    mLifetime.reserve(capacity);
+    mSize.reserve(capacity);
+    mTint.reserve(capacity);
+  }
+
+  /// Adds a particle to the system.
+  void emit(const particle& p)
+  {
+    mX.push_back(p.position.x());
+    mY.push_back(p.position.y());
+    mVelocityX.push_back(p.velocity.x());
+    mVelocityY.push_back(p.velocity.y());
+    mAge.push_back(0);
+    mLifetime.push_back(p.lifetime);
+    mSize.push_back(p.size);
+    mTint.push_back(p.tint.get());
+    mGeometryValid = false;
+  }
+
+  /**
+   * Advances the simulation, and removes particles that have exceeded their lifetime.
+   *
+   * \param dt the elapsed time, in seconds.
+   */
+  void update(const float dt)
+  {
+    const auto arrays = particle_arrays();
+    const auto [axdt, aydt, damping] = step_factors(dt);
+
+    detail::integrate_n(arrays, size(), axdt, aydt, damping, dt);
+    remove_dead();
+  }
+
+  /**
+   * Advances the simulation using a thread pool, see `update(float)`.
+   *
+   * \param dt the elapsed time, in seconds.
+   * \param pool the thread pool that the particles are integrated on.
+   * \param grain the amount of particles processed by each task.
+   */
+  void update(const float dt, thread_pool& pool, const size_type grain = default_grain)
+  {
+    const auto arrays = particle_arrays();
+    const auto [axdt, aydt, damping] = step_factors(dt);
+
+    for_each_chunk(pool, grain, [&](const size_type first, const size_type last) {
+      const detail::particle_arrays chunk {arrays.x + first,
+                                           arrays.y + first,
+                                           arrays.vx + first,
+                                           arrays.vy + first,
+                                           arrays.age + first};
+      detail::integrate_n(chunk, last - first, axdt, aydt, damping, dt);
+    });
+
+    remove_dead();
+  }
+
+  /// Writes the vertex and index streams for the current particles using a thread pool.
+  void build_geometry(thread_pool& pool, const size_type grain = default_grain)
+  {
+    prepare_geometry();
+    for_each_chunk(pool, grain, [this](const size_type first, const size_type last) {
+      write_quads(first, last);
+    });
+
+    mGeometryValid = true;
+  }
+
+  /**
+   * Renders all particles with a texture, using a single geometry call.
+   *
+   * \details The geometry is written by this function, unless it is up-to-date since a call
+   * to `build_geometry()`.
+   *
+   * \param renderer the renderer that will be used.
+   * \param texture the texture that is mapped onto every particle quad.
+   *
+   * \return `success` if the particles were rendered, or if there were no particles;
+   *         `failure` otherwise.
+   */
+  template <typename T, typename X>
+  auto render(basic_renderer<T>& renderer, const basic_texture<X>& texture) -> result
+  {
+    if (empty()) {
+      return success;
+    }
+
+    if (!mGeometryValid) {
+      prepare_geometry();
+      write_quads(0, size());
+      mGeometryValid = true;
+    }
+
+    return renderer.render_geo(texture, mVertices, mIndices);
+  }
+
+  /// Renders all particles as untextured quads, using a single geometry call.
+  template <typename T>
+  auto render(basic_renderer<T>& renderer) -> result
+  {
+    return render(renderer, texture_handle {static_cast<SDL_Texture*>(nullptr)});
+  }
+
+  /// Removes all particles, without releasing the storage.
+  void clear() noexcept
+  {
+    mX.clear();
+    mY.clear();
+    mVelocityX.clear();
+    mVelocityY.clear();
+    mAge.clear();
+    mLifetime.clear();
+    mSize.clear();
+    mTint.clear();
+    mGeometryValid = false;
+  }
+
+  /// Sets the acceleration applied to all particles, e.g. gravity, in units per second².
+  void set_acceleration(const fpoint& acceleration) noexcept { mAcceleration = acceleration; }
+
+  /// Sets the fraction of the velocity that is lost per second, in the range [0, 1].
+  void set_drag(const float drag) noexcept { mDrag = drag; }
+
+  /// Sets whether particles fade out linearly over their lifetime.
+  void set_fade_enabled(const bool enabled) noexcept
+  {
+    mFade = enabled;
+    mGeometryValid = false;
+  }
+
+  /// Sets the normalized texture coordinates that are mapped onto every particle quad.
+  void set_uv(const frect& uv) noexcept
+  {
+    mUV = uv;
+    mGeometryValid = false;
+  }
+
+  [[nodiscard]] auto acceleration() const noexcept -> fpoint { return mAcceleration; }
+
+  [[nodiscard]] auto drag() const noexcept -> float { return mDrag; }
+
+  [[nodiscard]] auto is_fade_enabled() const noexcept -> bool { return mFade; }
+
+  [[nodiscard]] auto uv() const noexcept -> frect { return mUV; }
+
+  /// Returns the x-coordinates of the particle centers.
+  [[nodiscard]] auto x() const noexcept -> const float* { return mX.data(); }
+
+  /// Returns the y-coordinates of the particle centers.
+  [[nodiscard]] auto y() const noexcept -> const float* { return mY.data(); }
+
+  /// Returns the age of each particle, in seconds.
+  [[nodiscard]] auto age() const noexcept -> const float* { return mAge.data(); }
+
+  [[nodiscard]] auto vertices() const noexcept -> const simd_vector<SDL_Vertex>&
+  {
+    return mVertices;
+  }
+
+  [[nodiscard]] auto indices() const noexcept -> const simd_vector<int>& { return mIndices; }
+
+  [[nodiscard]] auto size() const noexcept -> size_type { return mX.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mX.empty(); }
+
+ private:
+  simd_vector<float> mX;
+  simd_vector<float> mY;
+  simd_vector<float> mVelocityX;
+  simd_vector<float> mVelocityY;
+  simd_vector<float> mAge;
+  simd_vector<float> mLifetime;
+  simd_vector<float> mSize;
+  simd_vector<SDL_Color> mTint;
+  simd_vector<SDL_Vertex> mVertices;
+  simd_vector<int> mIndices;
+  fpoint mAcceleration;
+  frect mUV {0, 0, 1, 1};
+  float mDrag {};
+  bool mFade {true};
+  bool mGeometryValid {};
+
+  struct step_data final {
+    float axdt {};
+    float aydt {};
+    float damping {};
+  };
+
+  [[nodiscard]] auto particle_arrays() noexcept -> detail::particle_arrays
+  {
+    return {mX.data(), mY.data(), mVelocityX.data(), mVelocityY.data(), mAge.data()};
+  }
+
+  [[nodiscard]] auto step_factors(const float dt) const noexcept -> step_data
+  {
+    const auto damping = (detail::max)(1.0f - mDrag * dt, 0.0f);
+    return {mAcceleration.x() * dt, mAcceleration.y() * dt, damping};
+  }
+
+  template <typename Callable>
+  void for_each_chunk(thread_pool& pool, const size_type grain, const Callable& callable)
+  {
+    const auto count = size();
+    const auto chunk_size = (detail::max)(grain, size_type {1});
+    const auto chunks = (count + chunk_size - 1) / chunk_size;
+
+    pool.parallel_for(
+        0,
+        chunks,
+        [&](const size_type chunk) {
+          const auto first = chunk * chunk_size;
+          callable(first, (detail::min)(first + chunk_size, count));
+        },
+        1);
+  }
+
+  void prepare_geometry()
+  {
+    mVertices.resize(size() * 4u);
+    mIndices.resize(size() * 6u);
+  }
+
+  void write_quads(const size_type first, const size_type last) noexcept
+  {
+    detail::particle_quads(mX.data(),
+                           mY.data(),
+                           mSize.data(),
+                           mAge.data(),
+                           mLifetime.data(),
+                           mTint.data(),
+                           first,
+                           last,
+                           *mUV.data(),
+                           mFade,
+                           mVertices.data(),
+                           mIndices.data());
+  }
+
+  /* Dead particles are replaced by the last particle, which is much cheaper than shifting */
+  void remove_dead() noexcept
+  {
+    size_type index = 0;
+    while (index < size()) {
+      if (mAge[index] >= mLifetime[index]) {
+        const auto last = size() - 1;
+        mX[index] = mX[last];
+        mY[index] = mY[last];
+        mVelocityX[index] = mVelocityX[last];
+        mVelocityY[index] = mVelocityY[last];
+        mAge[index] = mAge[last];
+        mLifetime[index] = mLifetime[last];
+        mSize[index] = mSize[last];
+        mTint[index] = mTint[last];
+
+        mX.pop_back();
+        mY.pop_back();
+        mVelocityX.pop_back();
+        mVelocityY.pop_back();
+        mAge.pop_back();
+        mLifetime.pop_back();
+        mSize.pop_back();
+        mTint.pop_back();
+      }
+      else {
+        ++index;
+      }
+    }
+
+    mGeometryValid = false;
+  }
+};
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_PARTICLE_SYSTEM_HPP_
@@ -0,0 +1,436 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_PIXEL_PIPELINE_HPP_
+#define CENTURION_VIDEO_PIXEL_PIPELINE_HPP_
+
+#include <SDL.h>
+
+#include <cmath>        // floor, lround
+#include <optional>     // optional
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+
+/// Provides different ways of upscaling a low-resolution image to the window.
+enum class upscale_mode {
+  integer,        ///< The largest integer scale that fits, with nearest sampling.
+  sharp_bilinear  ///< Fills the output, with an integer prescale followed by linear filtering.
+};
+
+[[nodiscard]] constexpr auto to_string(const upscale_mode mode) -> std::string_view
+{
+  switch (mode) {
+    case upscale_mode::integer:
+      return "integer";
+
+    case upscale_mode::sharp_bilinear:
+      return "sharp_bilinear";
+
+    default:
+      throw exception {"Did not recognize upscale mode!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const upscale_mode mode) -> std::ostream&
+{
+  return stream << to_string(mode);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/**
+ * Describes how a low-resolution image is placed in the output of a renderer.
+ *
+ * \see make_upscale_layout()
+ */
+struct upscale_layout final {
+  iarea native;               ///< The size of the low-resolution image.
+  irect destination;          ///< The area covered by the image, in output pixels.
+  int prescale {1};           ///< The nearest-neighbour scale applied before filtering.
+  farea window_scale {1, 1};  ///< The amount of output pixels per window coordinate.
+
+  /**
+   * Converts window coordinates, e.g. of a mouse event, to native coordinates.
+   *
+   * \details This is the equivalent of `basic_renderer::to_logical()`. Positions in the
+   * letterbox are mapped to coordinates outside of the native area.
+   */
+  [[nodiscard]] auto to_native(const float x, const float y) const noexcept -> fpoint
+  {
+    if (destination.width() <= 0 || destination.height() <= 0) {
+      return {x, y};
+    }
+
+    const auto outputX = x * window_scale.width;
+    const auto outputY = y * window_scale.height;
+
+    return {(outputX - static_cast<float>(destination.x())) *
+                static_cast<float>(native.width) / static_cast<float>(destination.width()),
+            (outputY - static_cast<float>(destination.y())) *
+                static_cast<float>(native.height) / static_cast<float>(destination.height())};
+  }
+
+  [[nodiscard]] auto to_native(const ipoint& window) const noexcept -> fpoint
+  {
+    return to_native(static_cast<float>(window.x()), static_cast<float>(window.y()));
+  }
+
+  /// Converts native coordinates to window coordinates, the inverse of `to_native()`.
+  [[nodiscard]] auto from_native(const fpoint& position) const noexcept -> ipoint
+  {
+    if (native.width <= 0 || native.height <= 0 || window_scale.width <= 0 ||
+        window_scale.height <= 0) {
+      return {static_cast<int>(position.x()), static_cast<int>(position.y())};
+    }
+
+    const auto outputX = static_cast<float>(destination.x()) +
+                         position.x() * static_cast<float>(destination.width()) /
+                             static_cast<float>(native.width);
+    const auto outputY = static_cast<float>(destination.y()) +
+                         position.y() * static_cast<float>(destination.height()) /
+                             static_cast<float>(native.height);
+
+    return {static_cast<int>(std::lround(outputX / window_scale.width)),
+            static_cast<int>(std::lround(outputY / window_scale.height))};
+  }
+
+  /// Returns the horizontal scale from native to output pixels.
+  [[nodiscard]] auto scale() const noexcept -> float
+  {
+    return native.width > 0
+               ? static_cast<float>(destination.width()) / static_cast<float>(native.width)
+               : 1.0f;
+  }
+};
+
+/**
+ * Computes where a low-resolution image is placed in the output of a renderer.
+ *
+ * \details The image is always centered. In the integer mode, the image is scaled by the
+ * largest integer factor that fits, but never by less than one. In the sharp bilinear mode,
+ * the image fills as much of the output as possible while keeping its aspect ratio.
+ *
+ * \param native the size of the low-resolution image.
+ * \param output the size of the renderer output, in pixels.
+ * \param mode the upscale mode.
+ *
+ * \return the computed layout, with a window scale of one.
+ */
+[[nodiscard]] inline auto make_upscale_layout(const iarea& native,
+                                              const iarea& output,
+                                              const upscale_mode mode) noexcept
+    -> upscale_layout
+{
+  upscale_layout layout;
+  layout.native = native;
+
+  if (native.width <= 0 || native.height <= 0 || output.width <= 0 || output.height <= 0) {
+    return layout;
+  }
+
+  iarea size {};
+  if (mode == upscale_mode::integer) {
+    const auto fit = (detail::min)(output.width / native.width, output.height / native.height);
+    const auto factor = (detail::max)(fit, 1);
+    size = {native.width * factor, native.height * factor};
+    layout.prescale = factor;
+  }
+  else {
+    const auto factor =
+        (detail::min)(static_cast<float>(output.width) / static_cast<float>(native.width),
+                      static_cast<float>(output.height) / static_cast<float>(native.height));
+    size = {static_cast<int>(std::lround(static_cast<float>(native.width) * factor)),
+            static_cast<int>(std::lround(static_cast<float>(native.height) * factor))};
+    layout.prescale = (detail::max)(static_cast<int>(std::floor(factor)), 1);
+  }
+
+  layout.destination = {(output.width - size.width) / 2,
+                        (output.height - size.height) / 2,
+                        size.width,
+                        size.height};
+  return layout;
+}
+
+/**
+ * Renders a scene at a low native resolution, and upscales it to the window once per frame.
+ *
+ * This is intended for pixel-art games, where all draw calls then only touch the native
+ * amount of pixels, instead of blending and scaling at the output resolution. Only the final
+ * copy runs at the output resolution, without blending.
+ *
+ * Note, the logical size of the renderer should not be set when using this class, since the
+ * pipeline performs the scaling itself. Use `layout().to_native()` instead of
+ * `basic_renderer::to_logical()` to map mouse coordinates.
+ *
+ * \code{cpp}
+ * cen::pixel_pipeline pipeline {renderer, {320, 180}};
+ *
+ * pipeline.begin(renderer);
+ * // render the scene, in native coordinates
+ * pipeline.end(renderer);
+ *
+ * renderer.present();
+ * \endcode
+ */
+class pixel_pipeline final {
+ public:
+  /**
+   * Creates a pipeline with a native render target.
+   *
+   * \param renderer the renderer that creates the render targets.
+   * \param native the native resolution of the scene.
+   * \param mode the upscale mode.
+   *
+   * \throws exception if the native size isn't positive.
+   * \throws sdl_error if the render target cannot be created.
+   */
+  template <typename T>
+  pixel_pipeline(const basic_renderer<T>& renderer,
+                 const iarea& native,
+                 const upscale_mode mode = upscale_mode::integer)
+      : mNative {native}
+      , mMode {mode}
+      , mTarget {make_target(renderer, native, scale_mode::nearest)}
+  {
+  }
+
+  /**
+   * Redirects rendering to the native render target, and clears it.
+   *
+   * \param renderer the renderer that is used to render the scene.
+   *
+   * \return `success` if the target was enabled; `failure` otherwise.
+   */
+  template <typename T>
+  auto begin(basic_renderer<T>& renderer) noexcept -> result
+  {
+    if (!renderer.set_target(mTarget)) {
+      return failure;
+    }
+
+    renderer.clear_with(mClearColor);
+    return success;
+  }
+
+  /**
+   * Restores the default render target, and upscales the native image to it.
+   *
+   * \details The output is cleared with the border color first, which fills the letterbox.
+   * The renderer is not presented.
+   *
+   * \param renderer the renderer that was used to render the scene.
+   *
+   * \return `success` if the image was upscaled; `failure` otherwise.
+   *
+   * \throws sdl_error if a prescale target is needed and cannot be created.
+   */
+  template <typename T>
+  auto end(basic_renderer<T>& renderer) -> result
+  {
+    if (!renderer.reset_target()) {
+      return failure;
+    }
+
+    update_layout(renderer);
+    renderer.clear_with(mBorderColor);
+
+    /* Only the sharp bilinear mode filters, and only after the prescale if there is one */
+    const auto sharp = mMode == upscale_mode::sharp_bilinear;
+    const auto prescaled = sharp && mLayout.prescale > 1;
+    mTarget.set_scale_mode(sharp && !prescaled ? scale_mode::linear : scale_mode::nearest);
+
+    if (prescaled) {
+      const iarea size {mNative.width * mLayout.prescale, mNative.height * mLayout.prescale};
+      if (!mPrescaled || mPrescaled->size() != size) {
+        mPrescaled.reset();
+        mPrescaled = make_target(renderer, size, scale_mode::linear);
+      }
+
+      if (!renderer.set_target(*mPrescaled)) {
+        return failure;
+      }
+
+      const auto res = renderer.render(mTarget, irect {{0, 0}, size});
+      if (!renderer.reset_target() || !res) {
+        return failure;
+      }
+
+      return renderer.render(*mPrescaled, mLayout.destination);
+    }
+    else {
+      return renderer.render(mTarget, mLayout.destination);
+    }
+  }
+
+  /**
+   * Changes the native resolution of the pipeline.
+   *
+   * \throws exception if the native size isn't positive.
+   * \throws sdl_error if the render target cannot be created.
+   */
+  template <typename T>
+  void set_native_size(const basic_renderer<T>& renderer, const iarea& native)
+  {
+    if (native != mNative) {
+      mTarget = make_target(renderer, native, scale_mode::nearest);
+      mPrescaled.reset();
+      mNative = native;
+      mLayout.native = native;
+    }
+  }
+
+  void set_mode(const upscale_mode mode) noexcept { mMode = mode; }
+
+  /// Sets the color that the native target is cleared with by `begin()`.
+  void set_clear_color(const color& color) noexcept { mClearColor = color; }
+
+  /// Sets the color of the letterbox around the upscaled image.
+  void set_border_color(const color& color) noexcept { mBorderColor = color; }
+
+  [[nodiscard]] auto mode() const noexcept -> upscale_mode { return mMode; }
+
+  [[nodiscard]] auto native_size() const noexcept -> const iarea& { return mNative; }
+
+  [[nodiscard]] auto clear_color() const noexcept -> const color& { return mClearColor; }
+
+  [[nodiscard]] auto border_color() const noexcept -> const color& { return mBorderColor; }
+
+  /// Returns the layout computed by the latest call to `end()`.
+  [[nodiscard]] auto layout() const noexcept -> const upscale_layout& { return mLayout; }
+
+  /// Returns the native render target, which may be used directly, e.g. for screenshots.
+  [[nodiscard]] auto target() noexcept -> texture& { return mTarget; }
+
+  [[nodiscard]] auto target() const noexcept -> const texture& { return mTarget; }
+
+ private:
+  iarea mNative;
+  upscale_mode mMode {upscale_mode::integer};
+  color mClearColor {colors::black};
+  color mBorderColor {colors::black};
+  upscale_layout mLayout;
+  texture mTarget;
+  std::optional<texture> mPrescaled;
+
+  template <typename T>
+  [[nodiscard]] static auto make_target(const basic_renderer<T>& renderer,
+                                        const iarea& size,
+                                        const scale_mode scaling) -> texture
+  {
+    if (size.width <= 0 || size.height <= 0) {
+      throw exception {"Pixel pipeline sizes must be positive!"};
+    }
+
+    /* The scene is composited in the target, so the copy to the output doesn't blend */
+    auto target = renderer.make_texture(size, pixel_format::rgba32, texture_access::target);
+    target.set_blend_mode(blend_mode::none);
+    target.set_scale_mode(scaling);
+    return target;
+  }
+
+  template <typename T>
+  void update_layout(basic_renderer<T>& renderer) noexcept
+  {
+    const auto output = renderer.output_size();
+    mLayout = make_upscale_layout(mNative, output, mMode);
+
+#if SDL_VERSION_ATLEAST(2, 0, 22)
+    if (auto* window = SDL_RenderGetWindow(renderer.get())) {
+      int width {};
+      int height {};
+      SDL_GetWindowSize(window, &width, &height);
+
+      if (width > 0 && height > 0) {
+        mLayout.window_scale = {static_cast<float>(output.width) / static_cast<float>(width),
+                                static_cast<float>(output.height) /
+                                    static_cast<float>(height)};
+      }
+    }
+#endif  // SDL_VERSION_ATLEAST(2, 0, 22)
+  }
+};
+
+[[nodiscard]] inline auto to_string(const upscale_layout& layout) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("upscale_layout(x: {}, y: {}, width: {}, height: {}, prescale: {})",
+                     layout.destination.x(),
+                     layout.destination.y(),
+                     layout.destination.width(),
+                     layout.destination.height(),
+                     layout.prescale);
+#else
+  return "upscale_layout(x: " + std::to_string(layout.destination.x()) +
+         ", y: " + std::to_string(layout.destination.y()) +
+         ", width: " + std::to_string(layout.destination.width()) +
+         ", height: " + std::to_string(layout.destination.height()) +
+         ", prescale: " + std::to_string(layout.prescale) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const upscale_layout& layout) -> std::ostream&
+{
+  return stream << to_string(layout);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_PIXEL_PIPELINE_HPP_
@@ -0,0 +1,442 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_PIXEL_SPAN_HPP_
+#define CENTURION_VIDEO_PIXEL_SPAN_HPP_
+
+#include <SDL.h>
+
+#include <cassert>   // assert
+#include <cstddef>   // ptrdiff_t
+#include <iterator>  // input_iterator_tag
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "color.hpp"
+#include "pixels.hpp"
+#include "surface.hpp"
+
+namespace cen {
+
+/**
+ * Provides compile-time information about the pixels of a pixel format.
+ *
+ * Specializations provide a `value_type` that represents a single pixel, along with
+ * `to_color()` and `from_color()` conversion functions. Only formats whose pixels can be
+ * addressed individually are supported, i.e. no indexed or YUV formats.
+ *
+ * \see pixel_span
+ */
+template <pixel_format Format>
+struct pixel_traits;
+
+namespace detail {
+
+/* Channels as bytes at fixed offsets */
+template <int RIndex, int GIndex, int BIndex>
+struct byte_pixel_traits {
+  struct value_type final {
+    uint8 bytes[3];
+  };
+
+  static_assert(sizeof(value_type) == 3);
+
+  inline constexpr static bool has_alpha = false;
+
+  [[nodiscard]] constexpr static auto to_color(const value_type& pixel) noexcept -> color
+  {
+    return {pixel.bytes[RIndex], pixel.bytes[GIndex], pixel.bytes[BIndex]};
+  }
+
+  [[nodiscard]] constexpr static auto from_color(const color& color) noexcept -> value_type
+  {
+    value_type pixel {};
+    pixel.bytes[RIndex] = color.red();
+    pixel.bytes[GIndex] = color.green();
+    pixel.bytes[BIndex] = color.blue();
+    return pixel;
+  }
+};
+
+}  // namespace detail
+
+// clang-format off
+
+template <>
+struct pixel_traits<pixel_format::argb8888> final
+    : detail::packed_pixel_traits<uint32, 16, 8, 0, 24, 8, 8> {};
+
+template <>
+struct pixel_traits<pixel_format::rgba8888> final
+    : detail::packed_pixel_traits<uint32, 24, 16, 8, 0, 8, 8> {};
+
+template <>
+struct pixel_traits<pixel_format::abgr8888> final
+    : detail::packed_pixel_traits<uint32, 0, 8, 16, 24, 8, 8> {};
+
+template <>
+struct pixel_traits<pixel_format::bgra8888> final
+    : detail::packed_pixel_traits<uint32, 8, 16, 24, 0, 8, 8> {};
+
+template <>
+struct pixel_traits<pixel_format::rgb888> final
+    : detail::packed_pixel_traits<uint32, 16, 8, 0, 0, 8, 0> {};
+
+template <>
+struct pixel_traits<pixel_format::bgr888> final
+    : detail::packed_pixel_traits<uint32, 0, 8, 16, 0, 8, 0> {};
+
+template <>
+struct pixel_traits<pixel_format::rgbx8888> final
+    : detail::packed_pixel_traits<uint32, 24, 16, 8, 0, 8, 0> {};
+
+template <>
+struct pixel_traits<pixel_format::bgrx8888> final
+    : detail::packed_pixel_traits<uint32, 8, 16, 24, 0, 8, 0> {};
+
+template <>
+struct pixel_traits<pixel_format::rgb555> final
+    : detail::packed_pixel_traits<uint16, 10, 5, 0, 0, 5, 0> {};
+
+template <>
+struct pixel_traits<pixel_format::bgr555> final
+    : detail::packed_pixel_traits<uint16, 0, 5, 10, 0, 5, 0> {};
+
+template <>
+struct pixel_traits<pixel_format::argb4444> final
+    : detail::packed_pixel_traits<uint16, 8, 4, 0, 12, 4, 4> {};
+
+template <>
+struct pixel_traits<pixel_format::rgba4444> final
+    : detail::packed_pixel_traits<uint16, 12, 8, 4, 0, 4, 4> {};
+
+template <>
+struct pixel_traits<pixel_format::rgb24> final : detail::byte_pixel_traits<0, 1, 2> {};
+
+template <>
+struct pixel_traits<pixel_format::bgr24> final : detail::byte_pixel_traits<2, 1, 0> {};
+
+// clang-format on
+
+/* RGB565 has a six-bit green channel, so it doesn't fit the uniform packed traits */
+template <>
+struct pixel_traits<pixel_format::rgb565> final {
+  using value_type = uint16;
+
+  inline constexpr static bool has_alpha = false;
+
+  [[nodiscard]] constexpr static auto to_color(const value_type pixel) noexcept -> color
+  {
+    return {detail::expand_channel<5>((pixel >> 11u) & 0x1Fu),
+            detail::expand_channel<6>((pixel >> 5u) & 0x3Fu),
+            detail::expand_channel<5>(pixel & 0x1Fu)};
+  }
+
+  [[nodiscard]] constexpr static auto from_color(const color& color) noexcept -> value_type
+  {
+    return static_cast<value_type>((detail::reduce_channel<5>(color.red()) << 11u) |
+                                   (detail::reduce_channel<6>(color.green()) << 5u) |
+                                   detail::reduce_channel<5>(color.blue()));
+  }
+};
+
+/**
+ * A row of pixels in a pixel span.
+ *
+ * \see pixel_span
+ */
+template <pixel_format Format>
+class pixel_row final {
+ public:
+  using traits = pixel_traits<Format>;
+  using value_type = typename traits::value_type;
+  using iterator = value_type*;
+
+  constexpr pixel_row(value_type* pixels, const int width) noexcept
+      : mPixels {pixels}
+      , mWidth {width}
+  {
+  }
+
+  [[nodiscard]] constexpr auto operator[](const int x) const noexcept -> value_type&
+  {
+    assert(x >= 0 && x < mWidth);
+    return mPixels[x];
+  }
+
+  [[nodiscard]] constexpr auto color_at(const int x) const noexcept -> color
+  {
+    return traits::to_color((*this)[x]);
+  }
+
+  constexpr void set_color(const int x, const color& color) const noexcept
+  {
+    (*this)[x] = traits::from_color(color);
+  }
+
+  [[nodiscard]] constexpr auto begin() const noexcept -> iterator { return mPixels; }
+  [[nodiscard]] constexpr auto end() const noexcept -> iterator { return mPixels + mWidth; }
+
+  [[nodiscard]] constexpr auto data() const noexcept -> value_type* { return mPixels; }
+  [[nodiscard]] constexpr auto width() const noexcept -> int { return mWidth; }
+
+ private:
+  value_type* mPixels {};
+  int mWidth {};
+};
+
+/**
+ * A non-owning view of a rectangle of pixels with a statically known pixel format.
+ *
+ * Unlike `pixel_format_info::pixel_to_rgba()`, which dispatches on the format of every
+ * pixel at runtime, the accessors of this view are resolved at compile-time and can be
+ * inlined. The view keeps track of the pitch, so that sub-rectangles, e.g. a single tile
+ * of a sheet, can be processed like any other view.
+ *
+ * Surfaces that must be locked need to stay locked while a view of their pixels is used.
+ *
+ * \tparam Format the pixel format of the pixels, see `pixel_traits`.
+ *
+ * \see pixel_traits
+ * \see parallel_for_rows()
+ */
+template <pixel_format Format>
+class pixel_span final {
+ public:
+  using traits = pixel_traits<Format>;
+  using value_type = typename traits::value_type;
+  using row_type = pixel_row<Format>;
+
+  inline constexpr static pixel_format format = Format;
+
+  /// An iterator over the rows of a pixel span.
+  class row_iterator final {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = row_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = row_type;
+
+    constexpr row_iterator(uint8* row, const int pitch, const int width) noexcept
+        : mRow {row}
+        , mPitch {pitch}
+        , mWidth {width}
+    {
+    }
+
+    [[nodiscard]] constexpr auto operator*() const noexcept -> row_type
+    {
+      return {reinterpret_cast<typename row_type::value_type*>(mRow), mWidth};
+    }
+
+    constexpr auto operator++() noexcept -> row_iterator&
+    {
+      mRow += mPitch;
+      return *this;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const row_iterator& other) const noexcept -> bool
+    {
+      return mRow == other.mRow;
+    }
+
+    [[nodiscard]] constexpr auto operator!=(const row_iterator& other) const noexcept -> bool
+    {
+      return mRow != other.mRow;
+    }
+
+   private:
+    uint8* mRow {};
+    int mPitch {};
+    int mWidth {};
+  };
+
+  /// An iterable range over the rows of a pixel span, which doesn't refer to the span.
+  class row_range final {
+   public:
+    constexpr row_range(uint8* first, const int pitch, const iarea& size) noexcept
+        : mFirst {first}
+        , mPitch {pitch}
+        , mSize {size}
+    {
+    }
+
+    [[nodiscard]] constexpr auto begin() const noexcept -> row_iterator
+    {
+      return {mFirst, mPitch, mSize.width};
+    }
+
+    [[nodiscard]] constexpr auto end() const noexcept -> row_iterator
+    {
+      return {mFirst + mSize.height * mPitch, mPitch, mSize.width};
+    }
+
+   private:
+    uint8* mFirst {};
+    int mPitch {};
+    iarea mSize {};
+  };
+
+  /**
+   * Creates a view of pixel data.
+   *
+   * \param pixels the first pixel of the view.
+   * \param size the size of the view, in pixels.
+   * \param pitch the number of bytes between the first pixels of two consecutive rows.
+   */
+  constexpr pixel_span(void* pixels, const iarea& size, const int pitch) noexcept
+      : mPixels {static_cast<uint8*>(pixels)}
+      , mSize {size}
+      , mPitch {pitch}
+  {
+    assert(mSize.width >= 0);
+    assert(mSize.height >= 0);
+    assert(mPitch >= mSize.width * static_cast<int>(sizeof(value_type)));
+  }
+
+  /**
+   * Creates a view of all pixels of a surface.
+   *
+   * \pre the pixel format of the surface must be `Format`.
+   *
+   * \param surface the surface that will be viewed.
+   */
+  template <typename T>
+  explicit pixel_span(basic_surface<T>& surface) noexcept
+      : pixel_span {surface.pixel_data(), surface.size(), surface.pitch()}
+  {
+    assert(surface.format_info().format() == Format);
+  }
+
+  /**
+   * Returns a view of a rectangle within this view.
+   *
+   * \pre the rectangle must be contained within the view.
+   *
+   * \param rect the rectangle that will be viewed, relative to this view.
+   *
+   * \return a view of the rectangle, which shares the pitch of this view.
+   */
+  [[nodiscard]] constexpr auto subspan(const irect& rect) const noexcept -> pixel_span
+  {
+    assert(rect.x() >= 0 && rect.y() >= 0);
+    assert(rect.max_x() <= width() && rect.max_y() <= height());
+
+    auto* first = mPixels + rect.y() * mPitch +
+                  rect.x() * static_cast<int>(sizeof(value_type));
+    return pixel_span {first, rect.size(), mPitch};
+  }
+
+  /// Returns a view of a range of rows, `[first, last)`.
+  [[nodiscard]] constexpr auto rows(const int first, const int last) const noexcept
+      -> pixel_span
+  {
+    return subspan({0, first, width(), last - first});
+  }
+
+  /// Returns an iterable range over all rows of the view.
+  [[nodiscard]] constexpr auto rows() const noexcept -> row_range
+  {
+    return {mPixels, mPitch, mSize};
+  }
+
+  [[nodiscard]] constexpr auto row(const int y) const noexcept -> row_type
+  {
+    assert(y >= 0 && y < height());
+    return {reinterpret_cast<value_type*>(mPixels + y * mPitch), width()};
+  }
+
+  [[nodiscard]] constexpr auto at(const int x, const int y) const noexcept -> value_type&
+  {
+    return row(y)[x];
+  }
+
+  [[nodiscard]] constexpr auto color_at(const int x, const int y) const noexcept -> color
+  {
+    return row(y).color_at(x);
+  }
+
+  constexpr void set_color(const int x, const int y, const color& color) const noexcept
+  {
+    row(y).set_color(x, color);
+  }
+
+  /// Sets every pixel in the view to a color.
+  constexpr void fill(const color& color) const noexcept
+  {
+    const auto pixel = traits::from_color(color);
+    for (const auto row : rows()) {
+      for (auto& value : row) {
+        value = pixel;
+      }
+    }
+  }
+
+  [[nodiscard]] constexpr auto data() const noexcept -> void* { return mPixels; }
+  [[nodiscard]] constexpr auto size() const noexcept -> iarea { return mSize; }
+  [[nodiscard]] constexpr auto width() const noexcept -> int { return mSize.width; }
+  [[nodiscard]] constexpr auto height() const noexcept -> int { return mSize.height; }
+  [[nodiscard]] constexpr auto pitch() const noexcept -> int { return mPitch; }
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool
+  {
+    return mSize.width == 0 || mSize.height == 0;
+  }
+
+ private:
+  uint8* mPixels {};
+  iarea mSize {};
+  int mPitch {};
+};
+
+/**
+ * Invokes a function object for every row of a pixel span, in parallel.
+ *
+ * The rows are split into bands of consecutive rows, which are processed by the workers of
+ * the thread pool. The calling thread helps until every row has been processed.
+ *
+ * \param pool the thread pool that will process the rows.
+ * \param span the pixels that will be processed.
+ * \param callable the function object invoked for each row, with signature
+ *        `void(pixel_row<Format>, int y)`.
+ */
+template <pixel_format Format, typename Callable>
+void parallel_for_rows(thread_pool& pool,
+                       const pixel_span<Format>& span,
+                       const Callable& callable)
+{
+  const auto task = [&](const usize index) {
+    const auto y = static_cast<int>(index);
+    callable(span.row(y), y);
+  };
+
+  pool.parallel_for(0, static_cast<usize>(span.height()), task);
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_PIXEL_SPAN_HPP_
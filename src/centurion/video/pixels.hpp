@@ -29,7 +29,6 @@
 
 #include <cassert>      // assert
 #include <memory>       // unique_ptr
-#include <ostream>      // ostream
 #include <string>       // string, to_string
 #include <string_view>  // string_view
 
@@ -49,6 +48,18 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
 namespace cen {
 
 enum class pixel_format : uint32 {
@@ -262,11 +273,15 @@ enum class pixel_format : uint32 {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const pixel_format format) -> std::ostream&
 {
   return stream << to_string(format);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 /// Represents a palette of colors.
 class palette final {
  public:
@@ -332,11 +347,75 @@ class palette final {
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const palette& palette) -> std::ostream&
 {
   return stream << to_string(palette);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace detail {
+
+/* Scales an N-bit channel to and from eight bits. This matches SDL_GetRGBA(), which
+   replicates the high bits, and SDL_MapRGBA(), which truncates. */
+template <int Bits>
+[[nodiscard]] constexpr auto expand_channel(const uint32 value) noexcept -> uint8
+{
+  static_assert(Bits >= 4 && Bits <= 8);
+  return static_cast<uint8>((value << (8 - Bits)) | (value >> (2 * Bits - 8)));
+}
+
+template <int Bits>
+[[nodiscard]] constexpr auto reduce_channel(const uint8 value) noexcept -> uint32
+{
+  static_assert(Bits >= 4 && Bits <= 8);
+  return static_cast<uint32>(value) >> (8 - Bits);
+}
+
+/* Pixels stored as a single integer, independent of the byte order. An alpha channel with
+   zero bits means that the pixels are opaque. */
+template <typename Value, int RShift, int GShift, int BShift, int AShift, int Bits, int ABits>
+struct packed_pixel_traits {
+  using value_type = Value;
+
+  inline constexpr static bool has_alpha = ABits > 0;
+
+  [[nodiscard]] constexpr static auto to_color(const value_type pixel) noexcept -> color
+  {
+    constexpr uint32 mask = (1u << Bits) - 1u;
+    const auto value = static_cast<uint32>(pixel);
+
+    const auto red = expand_channel<Bits>((value >> RShift) & mask);
+    const auto green = expand_channel<Bits>((value >> GShift) & mask);
+    const auto blue = expand_channel<Bits>((value >> BShift) & mask);
+
+    if constexpr (has_alpha) {
+      constexpr uint32 alphaMask = (1u << ABits) - 1u;
+      return {red, green, blue, expand_channel<ABits>((value >> AShift) & alphaMask)};
+    }
+    else {
+      return {red, green, blue};
+    }
+  }
+
+  [[nodiscard]] constexpr static auto from_color(const color& color) noexcept -> value_type
+  {
+    auto value = (reduce_channel<Bits>(color.red()) << RShift) |
+                 (reduce_channel<Bits>(color.green()) << GShift) |
+                 (reduce_channel<Bits>(color.blue()) << BShift);
+
+    if constexpr (has_alpha) {
+      value |= reduce_channel<ABits>(color.alpha()) << AShift;
+    }
+
+    return static_cast<value_type>(value);
+  }
+};
+
+}  // namespace detail
+
 template <typename T>
 class basic_pixel_format_info;
 
@@ -418,6 +497,77 @@ class basic_pixel_format_info final {
     return SDL_MapRGBA(mFormat, color.red(), color.green(), color.blue(), color.alpha());
   }
 
+  /**
+   * Converts a batch of pixels to colors.
+   *
+   * The common 32-bit formats, such as `argb8888` and `rgba8888`, are unpacked with shifts
+   * and masks known at compile-time. Other formats fall back to `pixel_to_rgba()`.
+   *
+   * \param pixels the pixels that will be converted, encoded in this format.
+   * \param colors the colors that the results are written to, at least `count` of them.
+   * \param count the amount of pixels to convert.
+   */
+  void pixels_to_rgba(const uint32* pixels, color* colors, const usize count) const noexcept
+  {
+    assert(count == 0 || (pixels && colors));
+
+    const auto unpacked = visit_packed([=](auto traits) {
+      for (usize index = 0; index < count; ++index) {
+        colors[index] = decltype(traits)::to_color(pixels[index]);
+      }
+    });
+
+    if (!unpacked) {
+      for (usize index = 0; index < count; ++index) {
+        colors[index] = pixel_to_rgba(pixels[index]);
+      }
+    }
+  }
+
+  /**
+   * Converts a batch of colors to pixels.
+   *
+   * \param colors the colors that will be converted.
+   * \param pixels the pixels that the results are written to, at least `count` of them.
+   * \param count the amount of colors to convert.
+   *
+   * \see pixels_to_rgba()
+   */
+  void rgba_to_pixels(const color* colors, uint32* pixels, const usize count) const noexcept
+  {
+    assert(count == 0 || (pixels && colors));
+
+    const auto packed = visit_packed([=](auto traits) {
+      for (usize index = 0; index < count; ++index) {
+        pixels[index] = decltype(traits)::from_color(colors[index]);
+      }
+    });
+
+    if (!packed) {
+      for (usize index = 0; index < count; ++index) {
+        pixels[index] = rgba_to_pixel(colors[index]);
+      }
+    }
+  }
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+  void pixels_to_rgba(const std::span<const uint32> pixels,
+                      const std::span<color> colors) const noexcept
+  {
+    assert(pixels.size() <= colors.size());
+    pixels_to_rgba(pixels.data(), colors.data(), pixels.size());
+  }
+
+  void rgba_to_pixels(const std::span<const color> colors,
+                      const std::span<uint32> pixels) const noexcept
+  {
+    assert(colors.size() <= pixels.size());
+    rgba_to_pixels(colors.data(), pixels.data(), colors.size());
+  }
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
   [[nodiscard]] auto format() const noexcept -> pixel_format
   {
     return static_cast<pixel_format>(mFormat->format);
@@ -439,6 +589,50 @@ class basic_pixel_format_info final {
 
  private:
   detail::pointer<T, SDL_PixelFormat> mFormat;
+
+  /* Invokes the callable with the traits of the format, if it is a 32-bit packed format */
+  template <typename Callable>
+  auto visit_packed(Callable&& callable) const -> bool
+  {
+    using detail::packed_pixel_traits;
+
+    switch (format()) {
+      case pixel_format::argb8888:
+        callable(packed_pixel_traits<uint32, 16, 8, 0, 24, 8, 8> {});
+        return true;
+
+      case pixel_format::rgba8888:
+        callable(packed_pixel_traits<uint32, 24, 16, 8, 0, 8, 8> {});
+        return true;
+
+      case pixel_format::abgr8888:
+        callable(packed_pixel_traits<uint32, 0, 8, 16, 24, 8, 8> {});
+        return true;
+
+      case pixel_format::bgra8888:
+        callable(packed_pixel_traits<uint32, 8, 16, 24, 0, 8, 8> {});
+        return true;
+
+      case pixel_format::rgb888:
+        callable(packed_pixel_traits<uint32, 16, 8, 0, 0, 8, 0> {});
+        return true;
+
+      case pixel_format::bgr888:
+        callable(packed_pixel_traits<uint32, 0, 8, 16, 0, 8, 0> {});
+        return true;
+
+      case pixel_format::rgbx8888:
+        callable(packed_pixel_traits<uint32, 24, 16, 8, 0, 8, 0> {});
+        return true;
+
+      case pixel_format::bgrx8888:
+        callable(packed_pixel_traits<uint32, 8, 16, 24, 0, 8, 0> {});
+        return true;
+
+      default:
+        return false;
+    }
+  }
 };
 
 template <typename T>
@@ -454,12 +648,16 @@ template <typename T>
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_pixel_format_info<T>& info) -> std::ostream&
 {
   return stream << to_string(info);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_VIDEO_PIXELS_HPP_
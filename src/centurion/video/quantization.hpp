@@ -0,0 +1,661 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_QUANTIZATION_HPP_
+#define CENTURION_VIDEO_QUANTIZATION_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>    // sort, inplace_merge, fill, swap
+#include <cassert>      // assert
+#include <cmath>        // cbrt, lround
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "color.hpp"
+#include "pixels.hpp"
+#include "surface.hpp"
+#include "surface_ops.hpp"
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/* Color quantization of true color surfaces to indexed surfaces. Palettes are generated with
+   the median cut algorithm, and pixels are mapped to their nearest palette color. */
+
+namespace cen {
+
+/// Provides different ways of spreading the error when pixels are mapped to a palette.
+enum class dither_mode {
+  none,             ///< Pixels are mapped to their nearest palette color.
+  ordered,          ///< Applies a 4x4 Bayer matrix, which can be parallelized.
+  error_diffusion,  ///< Floyd-Steinberg error diffusion, which is always performed serially.
+};
+
+[[nodiscard]] inline auto to_string(const dither_mode mode) -> std::string_view
+{
+  switch (mode) {
+    case dither_mode::none:
+      return "none";
+
+    case dither_mode::ordered:
+      return "ordered";
+
+    case dither_mode::error_diffusion:
+      return "error_diffusion";
+
+    default:
+      throw exception {"Did not recognize dither mode!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const dither_mode mode) -> std::ostream&
+{
+  return stream << to_string(mode);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+struct quantize_options final {
+  int colors {256};                        ///< The maximum amount of colors, in [1, 256].
+  dither_mode dither {dither_mode::none};  ///< The dithering applied when mapping pixels.
+};
+
+namespace detail {
+
+struct color_count final {
+  uint32 rgba {};  ///< The color, with red in the most significant byte.
+  uint32 count {};
+};
+
+/* A range of histogram entries, which becomes one palette color */
+struct color_box final {
+  usize first {};
+  usize last {};
+  uint64 population {};
+  int channel {};  ///< The channel with the largest range.
+  int range {};    ///< The range of the widest channel.
+};
+
+[[nodiscard]] constexpr auto pack_rgba(const uint8 red,
+                                       const uint8 green,
+                                       const uint8 blue,
+                                       const uint8 alpha) noexcept -> uint32
+{
+  return (uint32 {red} << 24u) | (uint32 {green} << 16u) | (uint32 {blue} << 8u) |
+         uint32 {alpha};
+}
+
+[[nodiscard]] constexpr auto channel_of(const uint32 rgba, const int channel) noexcept
+    -> uint8
+{
+  return static_cast<uint8>(rgba >> (24u - (8u * static_cast<uint32>(channel))));
+}
+
+[[nodiscard]] inline auto row_of(const SDL_Surface& surface, const int y) noexcept
+    -> const uint8*
+{
+  return static_cast<const uint8*>(surface.pixels) +
+         (static_cast<usize>(y) * static_cast<usize>(surface.pitch));
+}
+
+/* Counts the distinct colors of an RGBA32 surface. With a pool, bands of rows are sorted in
+   parallel, and then merged pairwise. */
+[[nodiscard]] inline auto make_histogram(thread_pool* pool, const SDL_Surface& source)
+    -> std::vector<color_count>
+{
+  const auto width = static_cast<usize>(source.w);
+  std::vector<uint32> colors(width * static_cast<usize>(source.h));
+
+  const auto sort_rows = [&](const int first, const int last) {
+    for (auto y = first; y < last; ++y) {
+      const auto* row = row_of(source, y);
+      auto* out = colors.data() + (static_cast<usize>(y) * width);
+
+      for (usize x = 0; x < width; ++x, row += 4) {
+        out[x] = pack_rgba(row[0], row[1], row[2], row[3]);
+      }
+    }
+
+    std::sort(colors.data() + (static_cast<usize>(first) * width),
+              colors.data() + (static_cast<usize>(last) * width));
+  };
+
+  if (pool && source.h > 1) {
+    const auto bandHeight = band_height(*pool, source.h);
+    const auto bands = static_cast<usize>((source.h + bandHeight - 1) / bandHeight);
+
+    pool->parallel_for(
+        0,
+        bands,
+        [&](const usize band) {
+          const auto first = static_cast<int>(band) * bandHeight;
+          sort_rows(first, (detail::min)(first + bandHeight, source.h));
+        },
+        1);
+
+    /* Merging neighbouring runs doubles the run length, until one sorted run remains */
+    for (auto step = bandHeight; step < source.h; step *= 2) {
+      const auto merges = static_cast<usize>((source.h + (2 * step) - 1) / (2 * step));
+
+      pool->parallel_for(
+          0,
+          merges,
+          [&](const usize merge) {
+            const auto first = static_cast<int>(merge) * 2 * step;
+            const auto middle = first + step;
+            if (middle < source.h) {
+              const auto last = (detail::min)(middle + step, source.h);
+              std::inplace_merge(colors.data() + (static_cast<usize>(first) * width),
+                                 colors.data() + (static_cast<usize>(middle) * width),
+                                 colors.data() + (static_cast<usize>(last) * width));
+            }
+          },
+          1);
+    }
+  }
+  else {
+    sort_rows(0, source.h);
+  }
+
+  std::vector<color_count> histogram;
+  for (usize index = 0; index < colors.size();) {
+    auto next = index + 1;
+    while (next < colors.size() && colors[next] == colors[index]) {
+      ++next;
+    }
+
+    histogram.push_back({colors[index], static_cast<uint32>(next - index)});
+    index = next;
+  }
+
+  return histogram;
+}
+
+inline void measure_box(const std::vector<color_count>& histogram, color_box& box) noexcept
+{
+  int low[4] {255, 255, 255, 255};
+  int high[4] {};
+
+  box.population = 0;
+  for (auto index = box.first; index < box.last; ++index) {
+    const auto& entry = histogram[index];
+    box.population += entry.count;
+
+    for (int channel = 0; channel < 4; ++channel) {
+      const int value = channel_of(entry.rgba, channel);
+      low[channel] = (detail::min)(low[channel], value);
+      high[channel] = (detail::max)(high[channel], value);
+    }
+  }
+
+  box.channel = 0;
+  box.range = high[0] - low[0];
+
+  for (int channel = 1; channel < 4; ++channel) {
+    if (high[channel] - low[channel] > box.range) {
+      box.channel = channel;
+      box.range = high[channel] - low[channel];
+    }
+  }
+}
+
+/* Repeatedly splits the box with the widest channel range at its population median, and
+   returns the population weighted mean color of each box */
+[[nodiscard]] inline auto median_cut(std::vector<color_count>& histogram, const int colors)
+    -> std::vector<color>
+{
+  assert(colors >= 1);
+  assert(colors <= 256);
+
+  if (histogram.empty()) {
+    return {color {0, 0, 0, 0}};
+  }
+
+  std::vector<color_box> boxes;
+  boxes.reserve(static_cast<usize>(colors));
+
+  boxes.push_back({0, histogram.size()});
+  measure_box(histogram, boxes.back());
+
+  while (boxes.size() < static_cast<usize>(colors)) {
+    auto best = boxes.size();
+
+    for (usize index = 0; index < boxes.size(); ++index) {
+      const auto& box = boxes[index];
+      if (box.last - box.first < 2) {
+        continue;
+      }
+
+      if (best == boxes.size() || box.range > boxes[best].range ||
+          (box.range == boxes[best].range && box.population > boxes[best].population)) {
+        best = index;
+      }
+    }
+
+    if (best == boxes.size()) {
+      break;  // Every box has a single color
+    }
+
+    auto box = boxes[best];
+    std::sort(histogram.data() + box.first,
+              histogram.data() + box.last,
+              [channel = box.channel](const color_count& a, const color_count& b) {
+                return channel_of(a.rgba, channel) < channel_of(b.rgba, channel);
+              });
+
+    /* Leave at least one color on each side of the split */
+    uint64 accumulated = 0;
+    auto split = box.first + 1;
+    for (auto index = box.first; index + 1 < box.last; ++index) {
+      accumulated += histogram[index].count;
+      split = index + 1;
+
+      if (accumulated * 2 >= box.population) {
+        break;
+      }
+    }
+
+    color_box upper {split, box.last};
+    box.last = split;
+
+    measure_box(histogram, box);
+    measure_box(histogram, upper);
+
+    boxes[best] = box;
+    boxes.push_back(upper);
+  }
+
+  std::vector<color> palette;
+  palette.reserve(boxes.size());
+
+  for (const auto& box : boxes) {
+    uint64 sums[4] {};
+    for (auto index = box.first; index < box.last; ++index) {
+      const auto& entry = histogram[index];
+      for (int channel = 0; channel < 4; ++channel) {
+        sums[channel] += uint64 {channel_of(entry.rgba, channel)} * entry.count;
+      }
+    }
+
+    const auto mean = [&](const int channel) {
+      return static_cast<uint8>((sums[channel] + (box.population / 2)) / box.population);
+    };
+
+    palette.emplace_back(mean(0), mean(1), mean(2), mean(3));
+  }
+
+  return palette;
+}
+
+/* A direct-mapped cache of nearest palette indices, since most images repeat their colors */
+class palette_lookup final {
+ public:
+  explicit palette_lookup(const std::vector<color>& palette)
+      : mPalette {palette}
+      , mEntries(lookup_size)
+  {
+    assert(!mPalette.empty());
+    assert(mPalette.size() <= 256u);
+  }
+
+  [[nodiscard]] auto find(const uint32 rgba) -> uint8
+  {
+    auto& entry = mEntries[(rgba * 2'654'435'761u) >> (32u - lookup_bits)];
+
+    if (!entry.valid || entry.rgba != rgba) {
+      entry.rgba = rgba;
+      entry.index = nearest(rgba);
+      entry.valid = true;
+    }
+
+    return entry.index;
+  }
+
+ private:
+  struct lookup_entry final {
+    uint32 rgba {};
+    uint8 index {};
+    bool valid {};
+  };
+
+  inline constexpr static uint32 lookup_bits = 12;
+  inline constexpr static usize lookup_size = usize {1} << lookup_bits;
+
+  const std::vector<color>& mPalette;
+  std::vector<lookup_entry> mEntries;
+
+  [[nodiscard]] auto nearest(const uint32 rgba) const noexcept -> uint8
+  {
+    const int red = channel_of(rgba, 0);
+    const int green = channel_of(rgba, 1);
+    const int blue = channel_of(rgba, 2);
+    const int alpha = channel_of(rgba, 3);
+
+    usize best = 0;
+    auto bestDistance = -1;
+
+    for (usize index = 0; index < mPalette.size(); ++index) {
+      const auto& candidate = mPalette[index];
+
+      const auto dr = red - candidate.red();
+      const auto dg = green - candidate.green();
+      const auto db = blue - candidate.blue();
+      const auto da = alpha - candidate.alpha();
+      const auto distance = (dr * dr) + (dg * dg) + (db * db) + (da * da);
+
+      if (bestDistance < 0 || distance < bestDistance) {
+        best = index;
+        bestDistance = distance;
+      }
+    }
+
+    return static_cast<uint8>(best);
+  }
+};
+
+[[nodiscard]] inline auto clamp_channel(const int value) noexcept -> uint8
+{
+  return static_cast<uint8>(detail::clamp(value, 0, 255));
+}
+
+/* Maps a range of rows to palette indices, optionally with ordered dithering */
+inline void map_rows(const SDL_Surface& source,
+                     SDL_Surface& target,
+                     const std::vector<color>& palette,
+                     const bool ordered,
+                     const int firstRow,
+                     const int lastRow)
+{
+  constexpr int bayer[4][4] {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+
+  /* The threshold offsets are scaled to the approximate distance between palette colors */
+  int offsets[4][4] {};
+  if (ordered) {
+    const auto spread = 255.0f / std::cbrt(static_cast<float>(palette.size()));
+    for (int y = 0; y < 4; ++y) {
+      for (int x = 0; x < 4; ++x) {
+        const auto threshold = (static_cast<float>(bayer[y][x]) - 7.5f) / 16.0f;
+        offsets[y][x] = static_cast<int>(std::lround(threshold * spread));
+      }
+    }
+  }
+
+  palette_lookup lookup {palette};
+
+  for (auto y = firstRow; y < lastRow; ++y) {
+    const auto* row = row_of(source, y);
+    auto* out = static_cast<uint8*>(target.pixels) +
+                (static_cast<usize>(y) * static_cast<usize>(target.pitch));
+
+    for (int x = 0; x < source.w; ++x, row += 4) {
+      const auto offset = offsets[y & 3][x & 3];
+      out[x] = lookup.find(pack_rgba(clamp_channel(row[0] + offset),
+                                     clamp_channel(row[1] + offset),
+                                     clamp_channel(row[2] + offset),
+                                     row[3]));
+    }
+  }
+}
+
+/* Maps every row to palette indices with Floyd-Steinberg error diffusion of the color
+   channels, the errors are stored in sixteenths, with a column of padding on each side */
+inline void diffuse_rows(const SDL_Surface& source,
+                         SDL_Surface& target,
+                         const std::vector<color>& palette)
+{
+  const auto width = static_cast<usize>(source.w);
+  std::vector<int> current((width + 2) * 3);
+  std::vector<int> next((width + 2) * 3);
+
+  palette_lookup lookup {palette};
+
+  for (int y = 0; y < source.h; ++y) {
+    const auto* row = row_of(source, y);
+    auto* out = static_cast<uint8*>(target.pixels) +
+                (static_cast<usize>(y) * static_cast<usize>(target.pitch));
+
+    std::fill(next.begin(), next.end(), 0);
+
+    for (usize x = 0; x < width; ++x, row += 4) {
+      const auto* error = current.data() + ((x + 1) * 3);
+
+      const auto red = clamp_channel(row[0] + (error[0] / 16));
+      const auto green = clamp_channel(row[1] + (error[1] / 16));
+      const auto blue = clamp_channel(row[2] + (error[2] / 16));
+
+      const auto index = lookup.find(pack_rgba(red, green, blue, row[3]));
+      out[x] = index;
+
+      const auto& chosen = palette[index];
+      const int errors[3] {red - chosen.red(), green - chosen.green(), blue - chosen.blue()};
+
+      for (usize channel = 0; channel < 3; ++channel) {
+        const auto value = errors[channel];
+        current[((x + 2) * 3) + channel] += value * 7;
+        next[(x * 3) + channel] += value * 3;
+        next[((x + 1) * 3) + channel] += value * 5;
+        next[((x + 2) * 3) + channel] += value;
+      }
+    }
+
+    std::swap(current, next);
+  }
+}
+
+/* Maps an RGBA32 surface to an indexed surface with the specified palette colors */
+[[nodiscard]] inline auto map_to_palette(thread_pool* pool,
+                                         const surface& source,
+                                         const std::vector<color>& palette,
+                                         const dither_mode dither) -> surface
+{
+  assert(!source.must_lock());
+  assert(!palette.empty());
+  assert(palette.size() <= 256u);
+
+  surface output {source.size(), pixel_format::index8};
+  output.set_blend_mode(source.get_blend_mode());
+
+  auto* colors = output.get()->format->palette;
+  for (usize index = 0; index < palette.size(); ++index) {
+    if (SDL_SetPaletteColors(colors, palette[index].data(), static_cast<int>(index), 1) != 0) {
+      throw sdl_error {};
+    }
+  }
+
+  const auto& input = *source.get();
+  auto& target = *output.get();
+
+  if (dither == dither_mode::error_diffusion) {
+    diffuse_rows(input, target, palette);
+  }
+  else if (pool) {
+    const auto bandHeight = band_height(*pool, source.height());
+    const auto bands = static_cast<usize>((source.height() + bandHeight - 1) / bandHeight);
+
+    const auto task = [&](const usize band) {
+      const auto first = static_cast<int>(band) * bandHeight;
+      const auto last = (detail::min)(first + bandHeight, source.height());
+      map_rows(input, target, palette, dither == dither_mode::ordered, first, last);
+    };
+
+    pool->parallel_for(0, bands, task, 1);
+  }
+  else {
+    map_rows(input, target, palette, dither == dither_mode::ordered, 0, source.height());
+  }
+
+  return output;
+}
+
+template <typename T>
+[[nodiscard]] auto quantize(thread_pool* pool,
+                            const basic_surface<T>& source,
+                            const quantize_options& options) -> surface
+{
+  assert(options.colors >= 1);
+  assert(options.colors <= 256);
+
+  const auto rgba = source.convert_to(pixel_format::rgba32);
+  auto histogram = make_histogram(pool, *rgba.get());
+
+  const auto colors = median_cut(histogram, (detail::clamp)(options.colors, 1, 256));
+  return map_to_palette(pool, rgba, colors, options.dither);
+}
+
+[[nodiscard]] inline auto colors_of(const palette& palette) -> std::vector<color>
+{
+  std::vector<color> colors;
+  colors.reserve(static_cast<usize>(palette.size()));
+
+  for (const auto& entry : palette) {
+    colors.emplace_back(entry);
+  }
+
+  return colors;
+}
+
+}  // namespace detail
+
+/**
+ * Computes a palette that approximates the colors of a surface.
+ *
+ * The palette is computed with the median cut algorithm, where the transparency of the
+ * pixels is treated as a fourth color channel.
+ *
+ * \param source the surface that will be analyzed.
+ * \param colors the maximum amount of colors in the palette, in the range [1, 256].
+ *
+ * \return a palette with at most the specified amount of colors, and fewer colors if the
+ * surface has fewer distinct colors.
+ *
+ * \throws sdl_error if the surface cannot be converted or if the palette cannot be created.
+ */
+template <typename T>
+[[nodiscard]] auto make_palette(const basic_surface<T>& source, const int colors = 256)
+    -> palette
+{
+  assert(colors >= 1);
+  assert(colors <= 256);
+
+  const auto rgba = source.convert_to(pixel_format::rgba32);
+  auto histogram = detail::make_histogram(nullptr, *rgba.get());
+  const auto entries = detail::median_cut(histogram, (detail::clamp)(colors, 1, 256));
+
+  palette result {static_cast<int>(entries.size())};
+  for (usize index = 0; index < entries.size(); ++index) {
+    result.set_color(static_cast<int>(index), entries[index]);
+  }
+
+  return result;
+}
+
+/**
+ * Converts a surface to an indexed surface, with a palette that is computed for the surface.
+ *
+ * The colors are reduced with the median cut algorithm, see `make_palette()`. The created
+ * surface uses the `index8` pixel format, and takes a quarter of the memory of 32-bit
+ * surfaces. Its palette can be replaced with `set_palette()`, to recolor the image.
+ *
+ * \param source the surface that will be quantized.
+ * \param options the maximum amount of colors, and the dithering mode.
+ *
+ * \return an indexed surface with the same size as the source surface.
+ *
+ * \throws sdl_error if the surfaces cannot be converted or created.
+ */
+template <typename T>
+[[nodiscard]] auto quantize(const basic_surface<T>& source,
+                            const quantize_options& options = {}) -> surface
+{
+  return detail::quantize(nullptr, source, options);
+}
+
+/**
+ * Converts a surface to an indexed surface, using a thread pool.
+ *
+ * The colors are counted and the pixels are mapped in bands of rows, which are processed by
+ * the workers of the pool. Error diffusion is inherently serial, and is always performed on
+ * the calling thread.
+ *
+ * \see quantize(const basic_surface<T>&, const quantize_options&)
+ */
+template <typename T>
+[[nodiscard]] auto quantize(thread_pool& pool,
+                            const basic_surface<T>& source,
+                            const quantize_options& options = {}) -> surface
+{
+  return detail::quantize(&pool, source, options);
+}
+
+/**
+ * Converts a surface to an indexed surface, with an existing palette.
+ *
+ * This makes it possible for several images to share a palette, e.g. so that they can all be
+ * recolored with a single palette swap.
+ *
+ * \param source the surface that will be converted.
+ * \param palette the palette that the pixels are mapped to, with at most 256 colors.
+ * \param dither the dithering applied when mapping the pixels.
+ *
+ * \return an indexed surface with a copy of the palette colors.
+ *
+ * \throws sdl_error if the surfaces cannot be converted or created.
+ */
+template <typename T>
+[[nodiscard]] auto remap(const basic_surface<T>& source,
+                         const palette& palette,
+                         const dither_mode dither = dither_mode::none) -> surface
+{
+  assert(palette.size() <= 256);
+
+  const auto rgba = source.convert_to(pixel_format::rgba32);
+  return detail::map_to_palette(nullptr, rgba, detail::colors_of(palette), dither);
+}
+
+/// Converts a surface to an indexed surface with an existing palette, using a thread pool.
+template <typename T>
+[[nodiscard]] auto remap(thread_pool& pool,
+                         const basic_surface<T>& source,
+                         const palette& palette,
+                         const dither_mode dither = dither_mode::none) -> surface
+{
+  assert(palette.size() <= 256);
+
+  const auto rgba = source.convert_to(pixel_format::rgba32);
+  return detail::map_to_palette(&pool, rgba, detail::colors_of(palette), dither);
+}
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_QUANTIZATION_HPP_
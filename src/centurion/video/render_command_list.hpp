@@ -0,0 +1,778 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_RENDER_COMMAND_LIST_HPP_
+#define CENTURION_VIDEO_RENDER_COMMAND_LIST_HPP_
+
+#include <SDL.h>
+
+#include <cmath>        // floor, ceil
+#include <cstddef>      // ptrdiff_t
+#include <string>       // string, to_string
+#include <type_traits>  // decay_t, is_same_v
+#include <utility>      // move
+#include <variant>      // variant, visit, holds_alternative, get
+#include <vector>       // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../features.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "render_view.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+namespace cen {
+
+/**
+ * Records renderer calls so that they can be replayed later.
+ *
+ * Recording commands never calls into SDL, so a command list can be populated on any thread,
+ * e.g. to prepare the next frame while the current frame is presented. However, a single
+ * command list must not be used by several threads at the same time, and the list must be
+ * executed on the rendering thread.
+ *
+ * Note, only raw texture pointers are stored, so all recorded textures must outlive the next
+ * call to `execute()`.
+ *
+ * \see basic_renderer
+ */
+class render_command_list final {
+ public:
+  using size_type = usize;
+
+  /// Records a call to clear the rendering target with the current color.
+  void clear() { mCommands.emplace_back(clear_cmd {}); }
+
+  /// Records a call to clear the rendering target with a specific color.
+  void clear_with(const color& color)
+  {
+    mCommands.emplace_back(clear_with_cmd {color});
+  }
+
+  void set_color(const color& color) { mCommands.emplace_back(color_cmd {color}); }
+
+  void set_blend_mode(const blend_mode mode) { mCommands.emplace_back(blend_cmd {mode}); }
+
+  template <typename T>
+  void draw_rect(const basic_rect<T>& rect)
+  {
+    mCommands.emplace_back(draw_rect_cmd {as_float(rect)});
+  }
+
+  template <typename T>
+  void fill_rect(const basic_rect<T>& rect)
+  {
+    mCommands.emplace_back(fill_rect_cmd {as_float(rect)});
+  }
+
+  template <typename T>
+  void draw_line(const basic_point<T>& start, const basic_point<T>& end)
+  {
+    mCommands.emplace_back(draw_line_cmd {as_float(start), as_float(end)});
+  }
+
+  template <typename T>
+  void draw_point(const basic_point<T>& point)
+  {
+    mCommands.emplace_back(draw_point_cmd {as_float(point)});
+  }
+
+  /// Records a call to render an entire texture.
+  template <typename T>
+  void render(const basic_texture<T>& texture, const frect& destination)
+  {
+    mCommands.emplace_back(render_cmd {texture.get(), nothing, destination});
+  }
+
+  /// Records a call to render a region of a texture.
+  template <typename T>
+  void render(const basic_texture<T>& texture, const irect& source, const frect& destination)
+  {
+    mCommands.emplace_back(render_cmd {texture.get(), source, destination});
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+  /**
+   * Records a call to render geometry.
+   *
+   * The vertices and indices are copied into the command list.
+   *
+   * \param texture the texture that will be used by the geometry.
+   * \param vertices the vertices of the geometry.
+   * \param indices the vertex indices, may be empty.
+   */
+  template <typename T, typename VertexContainer, typename IndexContainer>
+  void render_geo(const basic_texture<T>& texture,
+                  const VertexContainer& vertices,
+                  const IndexContainer& indices)
+  {
+    geo_cmd cmd;
+    cmd.texture = texture.get();
+    cmd.firstVertex = mVertices.size();
+    cmd.vertexCount = vertices.size();
+    cmd.firstIndex = mIndices.size();
+    cmd.indexCount = indices.size();
+
+    mVertices.insert(mVertices.end(), vertices.begin(), vertices.end());
+    mIndices.insert(mIndices.end(), indices.begin(), indices.end());
+
+    /* The bounds let views cull the geometry without visiting every vertex */
+    if (cmd.vertexCount != 0) {
+      auto minX = mVertices[cmd.firstVertex].position.x;
+      auto minY = mVertices[cmd.firstVertex].position.y;
+      auto maxX = minX;
+      auto maxY = minY;
+
+      for (auto i = cmd.firstVertex; i < mVertices.size(); ++i) {
+        const auto& position = mVertices[i].position;
+        minX = (detail::min)(minX, position.x);
+        minY = (detail::min)(minY, position.y);
+        maxX = (detail::max)(maxX, position.x);
+        maxY = (detail::max)(maxY, position.y);
+      }
+
+      cmd.bounds = {minX, minY, maxX - minX, maxY - minY};
+    }
+
+    mCommands.emplace_back(cmd);
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+  void set_clip(const irect& area) { mCommands.emplace_back(clip_cmd {area}); }
+
+  void reset_clip() { mCommands.emplace_back(clip_cmd {nothing}); }
+
+  void set_viewport(const irect& viewport) { mCommands.emplace_back(viewport_cmd {viewport}); }
+
+  template <typename T>
+  void set_target(basic_texture<T>& target)
+  {
+    mCommands.emplace_back(target_cmd {target.get()});
+  }
+
+  void reset_target() { mCommands.emplace_back(target_cmd {nullptr}); }
+
+  /**
+   * Removes state changes that have no effect.
+   *
+   * A state change is removed if it is overridden by another change of the same state before
+   * anything is rendered, or if it sets a state to the value it already had. Since the state
+   * of the renderer is unknown before the list is executed, the first change of each state is
+   * always kept.
+   *
+   * \return the amount of removed commands.
+   */
+  auto optimize() -> size_type
+  {
+    const auto previousSize = mCommands.size();
+
+    std::vector<command> commands;
+    commands.reserve(mCommands.size());
+
+    pending_state pending;
+    known_state known;
+
+    for (const auto& cmd : mCommands) {
+      std::visit(
+          [&](const auto& c) {
+            using C = std::decay_t<decltype(c)>;
+            if constexpr (std::is_same_v<C, color_cmd>) {
+              pending.color = c;
+            }
+            else if constexpr (std::is_same_v<C, blend_cmd>) {
+              pending.blend = c;
+            }
+            else if constexpr (std::is_same_v<C, clip_cmd>) {
+              pending.clip = c;
+            }
+            else if constexpr (std::is_same_v<C, viewport_cmd>) {
+              pending.viewport = c;
+            }
+            else if constexpr (std::is_same_v<C, target_cmd>) {
+              // Changing the target may reset the viewport and clip, so pending changes of
+              // those states must be applied before the target is changed
+              flush_state(pending, known, commands);
+              pending.target = c;
+            }
+            else {
+              flush_state(pending, known, commands);
+              commands.emplace_back(c);
+            }
+          },
+          cmd);
+    }
+
+    // Trailing state changes still affect the renderer after the list has been executed
+    flush_state(pending, known, commands);
+
+    mCommands = std::move(commands);
+    return previousSize - mCommands.size();
+  }
+
+  /**
+   * Executes all recorded commands, in the order they were recorded.
+   *
+   * The commands are kept in the list, so a list may be executed several times.
+   *
+   * \param renderer the renderer that will execute the commands.
+   *
+   * \return `success` if all commands were successful; `failure` otherwise.
+   */
+  template <typename T>
+  auto execute(basic_renderer<T>& renderer) -> result
+  {
+    result res = success;
+
+    for (const auto& cmd : mCommands) {
+      if (!std::visit([&](const auto& c) { return run(renderer, c); }, cmd)) {
+        res = failure;
+      }
+    }
+
+    return res;
+  }
+
+  /**
+   * Executes all recorded commands once for each view.
+   *
+   * The recorded coordinates are treated as world coordinates, and each view replays the
+   * commands through its own camera into its own viewport, e.g. for split-screen rendering.
+   * Rectangles, points and textures that are outside of a view are skipped for that view, and
+   * the bounds of recorded geometry are computed once when the geometry is recorded.
+   *
+   * Since every view owns the viewport, recorded viewport and target changes are ignored.
+   * Clearing only affects the viewport of the current view, and recorded clip areas are
+   * transformed by the camera and limited to the viewport.
+   *
+   * The viewport and clip area of the renderer are restored afterwards.
+   *
+   * \param renderer the renderer that will execute the commands.
+   * \param views the views that the commands are replayed into, may be null if the count is
+   *        zero.
+   * \param count the amount of views.
+   *
+   * \return `success` if all commands were successful; `failure` otherwise.
+   */
+  template <typename T>
+  auto execute(basic_renderer<T>& renderer, const render_view* views, const size_type count)
+      -> result
+  {
+    if (count == 0) {
+      return success;
+    }
+
+    detail::view_scope<T> scope {renderer};
+    result res = success;
+
+    for (size_type index = 0; index < count; ++index) {
+      const auto& view = views[index];
+      if (!scope.apply(view)) {
+        res = failure;
+      }
+
+      for (const auto& cmd : mCommands) {
+        if (!run_in_view(renderer, view, cmd)) {
+          res = failure;
+        }
+      }
+    }
+
+    return res;
+  }
+
+  /// Executes all recorded commands once for each view.
+  template <typename T>
+  auto execute(basic_renderer<T>& renderer, const std::vector<render_view>& views) -> result
+  {
+    return execute(renderer, views.data(), views.size());
+  }
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+  template <typename T>
+  auto execute(basic_renderer<T>& renderer, const std::span<const render_view> views)
+      -> result
+  {
+    return execute(renderer, views.data(), views.size());
+  }
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+  /// Removes all recorded commands.
+  void reset() noexcept
+  {
+    mCommands.clear();
+    mVertices.clear();
+    mIndices.clear();
+    mViewVertices.clear();
+  }
+
+  /// Reserves space for the specified amount of commands.
+  void reserve(const size_type count) { mCommands.reserve(count); }
+
+  /// Returns the amount of recorded commands.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mCommands.size(); }
+
+  /// Indicates whether there are no recorded commands.
+  [[nodiscard]] auto empty() const noexcept -> bool { return mCommands.empty(); }
+
+ private:
+  struct clear_cmd final {};
+
+  struct clear_with_cmd final {
+    color value;
+  };
+
+  struct color_cmd final {
+    color value;
+  };
+
+  struct blend_cmd final {
+    blend_mode mode {};
+  };
+
+  struct draw_rect_cmd final {
+    frect rect;
+  };
+
+  struct fill_rect_cmd final {
+    frect rect;
+  };
+
+  struct draw_line_cmd final {
+    fpoint start;
+    fpoint end;
+  };
+
+  struct draw_point_cmd final {
+    fpoint point;
+  };
+
+  struct render_cmd final {
+    SDL_Texture* texture {};
+    maybe<irect> source;
+    frect destination;
+  };
+
+  struct geo_cmd final {
+    SDL_Texture* texture {};
+    usize firstVertex {};
+    usize vertexCount {};
+    usize firstIndex {};
+    usize indexCount {};
+    frect bounds;  ///< The world-space bounds of the vertices.
+  };
+
+  struct clip_cmd final {
+    maybe<irect> area;
+  };
+
+  struct viewport_cmd final {
+    irect viewport;
+  };
+
+  struct target_cmd final {
+    SDL_Texture* texture {};
+  };
+
+  using command = std::variant<clear_cmd,
+                               clear_with_cmd,
+                               color_cmd,
+                               blend_cmd,
+                               draw_rect_cmd,
+                               fill_rect_cmd,
+                               draw_line_cmd,
+                               draw_point_cmd,
+                               render_cmd,
+                               geo_cmd,
+                               clip_cmd,
+                               viewport_cmd,
+                               target_cmd>;
+
+  struct pending_state final {
+    maybe<target_cmd> target;
+    maybe<viewport_cmd> viewport;
+    maybe<clip_cmd> clip;
+    maybe<color_cmd> color;
+    maybe<blend_cmd> blend;
+  };
+
+  struct known_state final {
+    maybe<SDL_Texture*> target;
+    maybe<irect> viewport;
+    maybe<maybe<irect>> clip;
+    maybe<cen::color> color;
+    maybe<blend_mode> blend;
+  };
+
+  std::vector<command> mCommands;
+  std::vector<SDL_Vertex> mVertices;
+  std::vector<int> mIndices;
+  std::vector<SDL_Vertex> mViewVertices;  ///< Scratch storage for transformed geometry.
+
+  template <typename T>
+  [[nodiscard]] static constexpr auto as_float(const basic_rect<T>& rect) noexcept -> frect
+  {
+    if constexpr (basic_rect<T>::floating) {
+      return rect;
+    }
+    else {
+      return rect.as_f();
+    }
+  }
+
+  template <typename T>
+  [[nodiscard]] static constexpr auto as_float(const basic_point<T>& point) noexcept -> fpoint
+  {
+    if constexpr (basic_point<T>::floating) {
+      return point;
+    }
+    else {
+      return point.as_f();
+    }
+  }
+
+  template <typename Value, typename Command>
+  static void flush_value(maybe<Command>& pending,
+                          maybe<Value>& known,
+                          const Value& value,
+                          std::vector<command>& commands)
+  {
+    if (pending) {
+      if (!known || *known != value) {
+        commands.emplace_back(*pending);
+        known = value;
+      }
+
+      pending.reset();
+    }
+  }
+
+  static void flush_state(pending_state& pending,
+                          known_state& known,
+                          std::vector<command>& commands)
+  {
+    if (pending.target) {
+      const auto changed = !known.target || *known.target != pending.target->texture;
+      flush_value(pending.target, known.target, pending.target->texture, commands);
+
+      if (changed) {
+        known.viewport.reset();
+        known.clip.reset();
+      }
+    }
+
+    if (pending.viewport) {
+      flush_value(pending.viewport, known.viewport, pending.viewport->viewport, commands);
+    }
+
+    if (pending.clip) {
+      flush_value(pending.clip, known.clip, pending.clip->area, commands);
+    }
+
+    if (pending.color) {
+      flush_value(pending.color, known.color, pending.color->value, commands);
+    }
+
+    if (pending.blend) {
+      flush_value(pending.blend, known.blend, pending.blend->mode, commands);
+    }
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const clear_cmd&) noexcept -> result
+  {
+    return renderer.clear();
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const clear_with_cmd& cmd) noexcept -> result
+  {
+    renderer.clear_with(cmd.value);
+    return success;
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const color_cmd& cmd) noexcept -> result
+  {
+    return renderer.set_color(cmd.value);
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const blend_cmd& cmd) noexcept -> result
+  {
+    return renderer.set_blend_mode(cmd.mode);
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const draw_rect_cmd& cmd) noexcept -> result
+  {
+    return renderer.draw_rect(cmd.rect);
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const fill_rect_cmd& cmd) noexcept -> result
+  {
+    return renderer.fill_rect(cmd.rect);
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const draw_line_cmd& cmd) noexcept -> result
+  {
+    return renderer.draw_line(cmd.start, cmd.end);
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const draw_point_cmd& cmd) noexcept -> result
+  {
+    return renderer.draw_point(cmd.point);
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const render_cmd& cmd) noexcept -> result
+  {
+    const SDL_Rect* source = cmd.source ? cmd.source->data() : nullptr;
+    return SDL_RenderCopyF(renderer.get(), cmd.texture, source, cmd.destination.data()) == 0;
+  }
+
+  template <typename T>
+  auto run(basic_renderer<T>& renderer, const geo_cmd& cmd) const noexcept -> result
+  {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    const auto* indices = cmd.indexCount ? mIndices.data() + cmd.firstIndex : nullptr;
+    return SDL_RenderGeometry(renderer.get(),
+                              cmd.texture,
+                              mVertices.data() + cmd.firstVertex,
+                              static_cast<int>(cmd.vertexCount),
+                              indices,
+                              static_cast<int>(cmd.indexCount)) == 0;
+#else
+    static_cast<void>(renderer);
+    static_cast<void>(cmd);
+    return failure;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const clip_cmd& cmd) noexcept -> result
+  {
+    if (cmd.area) {
+      return renderer.set_clip(*cmd.area);
+    }
+    else {
+      return renderer.reset_clip();
+    }
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const viewport_cmd& cmd) noexcept -> result
+  {
+    return renderer.set_viewport(cmd.viewport);
+  }
+
+  template <typename T>
+  static auto run(basic_renderer<T>& renderer, const target_cmd& cmd) noexcept -> result
+  {
+    /* Go through the renderer, so that its cached target, viewport and clip stay valid */
+    if (cmd.texture) {
+      texture_handle target {cmd.texture};
+      return renderer.set_target(target);
+    }
+    else {
+      return renderer.reset_target();
+    }
+  }
+
+  /// Returns the entire area of a view, relative to its viewport.
+  [[nodiscard]] static auto view_area(const render_view& view) noexcept -> irect
+  {
+    return irect {{0, 0}, view.viewport.size()};
+  }
+
+  /// Transforms a world-space clip area into a clip area within the viewport of a view.
+  [[nodiscard]] static auto view_clip(const render_view& view, const irect& area) noexcept
+      -> irect
+  {
+    const auto screen = view.eye.to_screen(area.as_f());
+    const auto size = view.viewport.size();
+
+    const auto snap = [](const float value, const int limit) noexcept {
+      return (detail::clamp)(static_cast<int>(value), 0, limit);
+    };
+
+    const auto minX = snap(std::floor(screen.x()), size.width);
+    const auto minY = snap(std::floor(screen.y()), size.height);
+    const auto maxX = snap(std::ceil(screen.max_x()), size.width);
+    const auto maxY = snap(std::ceil(screen.max_y()), size.height);
+
+    return {minX, minY, maxX - minX, maxY - minY};
+  }
+
+  /// Fills the viewport of a view, ignoring the blend mode, like clearing would.
+  template <typename T>
+  static auto clear_view(basic_renderer<T>& renderer, const render_view& view) noexcept
+      -> result
+  {
+    const auto previous = renderer.get_blend_mode();
+    renderer.set_blend_mode(blend_mode::none);
+    const auto res = renderer.fill_rect(view_area(view));
+    renderer.set_blend_mode(previous);
+    return res;
+  }
+
+  template <typename T>
+  auto run_in_view(basic_renderer<T>& renderer, const render_view& view, const command& cmd)
+      -> result
+  {
+    const auto& eye = view.eye;
+    return std::visit(
+        [&](const auto& c) -> result {
+          using C = std::decay_t<decltype(c)>;
+          if constexpr (std::is_same_v<C, clear_cmd>) {
+            return clear_view(renderer, view);
+          }
+          else if constexpr (std::is_same_v<C, clear_with_cmd>) {
+            const auto previous = renderer.get_color();
+            renderer.set_color(c.value);
+            const auto res = clear_view(renderer, view);
+            renderer.set_color(previous);
+            return res;
+          }
+          else if constexpr (std::is_same_v<C, draw_rect_cmd>) {
+            return eye.visible(c.rect) ? renderer.draw_rect(eye.to_screen(c.rect)) : success;
+          }
+          else if constexpr (std::is_same_v<C, fill_rect_cmd>) {
+            return eye.visible(c.rect) ? renderer.fill_rect(eye.to_screen(c.rect)) : success;
+          }
+          else if constexpr (std::is_same_v<C, draw_line_cmd>) {
+            /* Lines are not culled, the clip area rejects the parts outside of the view */
+            return renderer.draw_line(eye.to_screen(c.start), eye.to_screen(c.end));
+          }
+          else if constexpr (std::is_same_v<C, draw_point_cmd>) {
+            return eye.visible(c.point) ? renderer.draw_point(eye.to_screen(c.point))
+                                        : success;
+          }
+          else if constexpr (std::is_same_v<C, render_cmd>) {
+            if (!eye.visible(c.destination)) {
+              return success;
+            }
+
+            const render_cmd screen {c.texture, c.source, eye.to_screen(c.destination)};
+            return run(renderer, screen);
+          }
+          else if constexpr (std::is_same_v<C, geo_cmd>) {
+            return run_geo_in_view(renderer, eye, c);
+          }
+          else if constexpr (std::is_same_v<C, clip_cmd>) {
+            return renderer.set_clip(c.area ? view_clip(view, *c.area) : view_area(view));
+          }
+          else if constexpr (std::is_same_v<C, viewport_cmd> ||
+                             std::is_same_v<C, target_cmd>) {
+            return success;
+          }
+          else {
+            return run(renderer, c);
+          }
+        },
+        cmd);
+  }
+
+  template <typename T>
+  auto run_geo_in_view(basic_renderer<T>& renderer, const camera& eye, const geo_cmd& cmd)
+      -> result
+  {
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (cmd.vertexCount == 0 || !eye.visible(cmd.bounds)) {
+      return success;
+    }
+
+    mViewVertices.assign(mVertices.begin() + static_cast<std::ptrdiff_t>(cmd.firstVertex),
+                         mVertices.begin() +
+                             static_cast<std::ptrdiff_t>(cmd.firstVertex + cmd.vertexCount));
+
+    for (auto& vertex : mViewVertices) {
+      const auto position = eye.to_screen(fpoint {vertex.position.x, vertex.position.y});
+      vertex.position = {position.x(), position.y()};
+    }
+
+    const auto* indices = cmd.indexCount ? mIndices.data() + cmd.firstIndex : nullptr;
+    return SDL_RenderGeometry(renderer.get(),
+                              cmd.texture,
+                              mViewVertices.data(),
+                              static_cast<int>(cmd.vertexCount),
+                              indices,
+                              static_cast<int>(cmd.indexCount)) == 0;
+#else
+    static_cast<void>(renderer);
+    static_cast<void>(eye);
+    static_cast<void>(cmd);
+    return failure;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+  }
+};
+
+[[nodiscard]] inline auto to_string(const render_command_list& list) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("render_command_list(size: {})", list.size());
+#else
+  return "render_command_list(size: " + std::to_string(list.size()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const render_command_list& list) -> std::ostream&
+{
+  return stream << to_string(list);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RENDER_COMMAND_LIST_HPP_
@@ -0,0 +1,129 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_RENDER_COUNTERS_HPP_
+#define CENTURION_VIDEO_RENDER_COUNTERS_HPP_
+
+#include <SDL.h>
+
+#include "../common/primitives.hpp"
+
+namespace cen {
+
+/**
+ * Counts the calls made through a renderer since the counters were last reset.
+ *
+ * The counters are only collected if `CENTURION_ENABLE_RENDER_COUNTERS` is defined, and are
+ * otherwise always zero, without any overhead.
+ *
+ * \see basic_renderer::counters()
+ */
+struct render_counters final {
+  usize draw_calls {};      ///< Clears and primitive draws, e.g. of rectangles and points.
+  usize copies {};          ///< Texture and atlas region copies.
+  usize geometry_calls {};  ///< Submitted triangle lists.
+  usize texture_binds {};   ///< Copies and geometry that use another texture than the last.
+  usize state_changes {};   ///< Color, blend, viewport, clip, scale and logical size changes.
+  usize skipped_state_changes {};  ///< State and target changes skipped by the state cache.
+  usize target_changes {};         ///< Render target changes forwarded to SDL.
+  usize presents {};               ///< Presented frames.
+
+  /// Returns the total amount of submitted draw calls.
+  [[nodiscard]] constexpr auto submissions() const noexcept -> usize
+  {
+    return draw_calls + copies + geometry_calls;
+  }
+};
+
+namespace detail {
+
+#ifdef CENTURION_ENABLE_RENDER_COUNTERS
+
+inline constexpr bool has_render_counters = true;
+
+struct render_counter_recorder final {
+  render_counters counters;
+  SDL_Texture* texture {};  ///< The texture used by the latest copy or geometry call.
+  bool bound {};
+
+  void draw() noexcept { ++counters.draw_calls; }
+
+  void copy(SDL_Texture* used) noexcept
+  {
+    ++counters.copies;
+    bind(used);
+  }
+
+  void geometry(SDL_Texture* used) noexcept
+  {
+    ++counters.geometry_calls;
+    bind(used);
+  }
+
+  void state_change() noexcept { ++counters.state_changes; }
+
+  void skipped_state_change() noexcept { ++counters.skipped_state_changes; }
+
+  void target_change() noexcept { ++counters.target_changes; }
+
+  void present() noexcept { ++counters.presents; }
+
+  void reset() noexcept { counters = render_counters {}; }
+
+  [[nodiscard]] auto get() const noexcept -> render_counters { return counters; }
+
+  void bind(SDL_Texture* used) noexcept
+  {
+    if (!bound || used != texture) {
+      ++counters.texture_binds;
+      texture = used;
+      bound = true;
+    }
+  }
+};
+
+#else
+
+inline constexpr bool has_render_counters = false;
+
+/* Compiles to nothing when the counters are disabled */
+struct render_counter_recorder final {
+  void draw() noexcept {}
+  void copy(SDL_Texture*) noexcept {}
+  void geometry(SDL_Texture*) noexcept {}
+  void state_change() noexcept {}
+  void skipped_state_change() noexcept {}
+  void target_change() noexcept {}
+  void present() noexcept {}
+  void reset() noexcept {}
+
+  [[nodiscard]] auto get() const noexcept -> render_counters { return {}; }
+};
+
+#endif  // CENTURION_ENABLE_RENDER_COUNTERS
+
+}  // namespace detail
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RENDER_COUNTERS_HPP_
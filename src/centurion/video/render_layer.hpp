@@ -0,0 +1,317 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_RENDER_LAYER_HPP_
+#define CENTURION_VIDEO_RENDER_LAYER_HPP_
+
+#include <SDL.h>
+
+#include <cmath>       // ceil
+#include <functional>  // function
+#include <optional>    // optional
+#include <string>      // string, to_string
+#include <utility>     // move
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../events/event_type.hpp"
+#include "../features.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/**
+ * A retained layer of rarely changing content, e.g. static parts of a HUD.
+ *
+ * The content is drawn into a target texture by a callback, and the texture is then
+ * composited with a single copy every frame. The callback is only invoked again when the
+ * layer has been invalidated, when its revision changes, or when the renderer scale changes,
+ * e.g. due to a new logical size or a display with another pixel density.
+ *
+ * The layer size is specified in renderer coordinates, and the backing texture uses the
+ * current renderer scale, so that the layer stays sharp on high-DPI outputs. The callback
+ * draws in layer coordinates, where the origin is the top-left corner of the layer.
+ *
+ * The texture uses premultiplied alpha, since translucent content that is drawn into a
+ * cleared target ends up premultiplied.
+ *
+ * \see basic_renderer::set_logical_size()
+ */
+class render_layer final {
+ public:
+  using draw_callback = std::function<void(renderer_handle&)>;
+
+  /**
+   * Creates a layer, the backing texture is created lazily.
+   *
+   * \param size the size of the layer, in renderer coordinates.
+   * \param draw the callback that draws the content of the layer.
+   *
+   * \throws exception if the size isn't positive or if the callback is empty.
+   */
+  render_layer(const farea& size, draw_callback draw) : mSize {size}, mDraw {std::move(draw)}
+  {
+    if (size.width <= 0 || size.height <= 0) {
+      throw exception {"Render layer sizes must be positive!"};
+    }
+
+    if (!mDraw) {
+      throw exception {"Render layers require a draw callback!"};
+    }
+  }
+
+  /**
+   * Redraws the layer, if it is out-of-date.
+   *
+   * \details This is called by `render()`, but may be called earlier to move the redraw
+   * elsewhere in the frame, e.g. before the scene is rendered.
+   *
+   * \param renderer the renderer that the layer is composited with.
+   *
+   * \return `success` if the layer is up-to-date; `failure` if it couldn't be redrawn.
+   *
+   * \throws sdl_error if the backing texture cannot be created.
+   */
+  template <typename T>
+  auto prepare(basic_renderer<T>& renderer) -> result
+  {
+    auto scale = renderer.scale();
+    if (scale.x <= 0 || scale.y <= 0) {
+      scale = {1, 1};
+    }
+
+    if (scale.x != mScale.x || scale.y != mScale.y) {
+      mScale = scale;
+      mTexture.reset();
+    }
+
+    if (!mTexture) {
+      const iarea pixels {
+          (detail::max)(static_cast<int>(std::ceil(mSize.width * mScale.x)), 1),
+          (detail::max)(static_cast<int>(std::ceil(mSize.height * mScale.y)), 1)};
+
+      mTexture = renderer.make_texture(pixels,
+                                       pixel_format::rgba32,
+                                       texture_access::target,
+                                       alpha_mode::premultiplied);
+      mDirty = true;
+    }
+
+    if (mDirty) {
+      if (!redraw(renderer)) {
+        return failure;
+      }
+
+      mDirty = false;
+      ++mRedraws;
+    }
+
+    return success;
+  }
+
+  /**
+   * Composites the layer, redrawing it first if it is out-of-date.
+   *
+   * \param renderer the renderer that will be used.
+   * \param position the position of the top-left corner of the layer.
+   *
+   * \return `success` if the layer was rendered; `failure` otherwise.
+   *
+   * \throws sdl_error if the backing texture cannot be created.
+   */
+  template <typename T>
+  auto render(basic_renderer<T>& renderer, const fpoint& position) -> result
+  {
+    if (!prepare(renderer)) {
+      return failure;
+    }
+
+    return renderer.render(*mTexture, frect {position, mSize});
+  }
+
+  /// Forces the layer to be redrawn the next time it is used.
+  void invalidate() noexcept { mDirty = true; }
+
+  /**
+   * Sets the revision of the inputs of the layer, e.g. a hash or a version counter.
+   *
+   * \details The layer is redrawn if the revision differs from the previous revision.
+   *
+   * \param revision the revision of the inputs.
+   */
+  void set_revision(const uint64 revision) noexcept
+  {
+    if (revision != mRevision) {
+      mRevision = revision;
+      mDirty = true;
+    }
+  }
+
+  /**
+   * Handles events that cause the texture contents to be lost.
+   *
+   * \details Render targets may be cleared by the renderer when the device is reset, e.g. with
+   * Direct3D when the window is resized or toggled to fullscreen.
+   *
+   * \param type the type of the event.
+   *
+   * \return `true` if the layer was invalidated; `false` otherwise.
+   */
+  auto update(const event_type type) noexcept -> bool
+  {
+    if (type == event_type::render_targets_reset) {
+      mDirty = true;
+      return true;
+    }
+    else if (type == event_type::render_device_reset) {
+      mTexture.reset();
+      mDirty = true;
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Changes the size of the layer, which causes it to be redrawn if the size differs.
+  void set_size(const farea& size)
+  {
+    if (size.width <= 0 || size.height <= 0) {
+      throw exception {"Render layer sizes must be positive!"};
+    }
+
+    if (size.width != mSize.width || size.height != mSize.height) {
+      mSize = size;
+      mTexture.reset();
+    }
+  }
+
+  /// Replaces the draw callback, and invalidates the layer.
+  void set_callback(draw_callback draw)
+  {
+    if (!draw) {
+      throw exception {"Render layers require a draw callback!"};
+    }
+
+    mDraw = std::move(draw);
+    mDirty = true;
+  }
+
+  /// Indicates whether the layer will be redrawn the next time it is used.
+  [[nodiscard]] auto is_dirty() const noexcept -> bool { return mDirty || !mTexture; }
+
+  [[nodiscard]] auto size() const noexcept -> const farea& { return mSize; }
+
+  [[nodiscard]] auto revision() const noexcept -> uint64 { return mRevision; }
+
+  /// Returns the amount of times that the layer has been drawn.
+  [[nodiscard]] auto redraws() const noexcept -> usize { return mRedraws; }
+
+  /// Returns the backing texture, if it has been created.
+  [[nodiscard]] auto get() const noexcept -> SDL_Texture*
+  {
+    return mTexture ? mTexture->get() : nullptr;
+  }
+
+ private:
+  farea mSize;
+  draw_callback mDraw;
+  std::optional<texture> mTexture;
+  renderer_scale mScale;
+  uint64 mRevision {};
+  usize mRedraws {};
+  bool mDirty {true};
+
+  template <typename T>
+  auto redraw(basic_renderer<T>& renderer) -> result
+  {
+    auto previous = renderer.get_target();
+    if (!renderer.set_target(*mTexture)) {
+      return failure;
+    }
+
+    /* The scale of a render target is independent of the scale of the window */
+    renderer.clear_with(colors::transparent);
+    renderer.set_scale(mScale);
+
+    renderer_handle handle {renderer.get()};
+    mDraw(handle);
+
+    /* The callback may have changed state that isn't visible to the renderer cache */
+    renderer.invalidate_state_cache();
+
+    if (previous) {
+      return renderer.set_target(previous);
+    }
+    else {
+      return renderer.reset_target();
+    }
+  }
+};
+
+[[nodiscard]] inline auto to_string(const render_layer& layer) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("render_layer(width: {}, height: {}, redraws: {})",
+                     layer.size().width,
+                     layer.size().height,
+                     layer.redraws());
+#else
+  return "render_layer(width: " + std::to_string(layer.size().width) +
+         ", height: " + std::to_string(layer.size().height) +
+         ", redraws: " + std::to_string(layer.redraws()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const render_layer& layer) -> std::ostream&
+{
+  return stream << to_string(layer);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RENDER_LAYER_HPP_
@@ -0,0 +1,387 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_RENDER_THREAD_HPP_
+#define CENTURION_VIDEO_RENDER_THREAD_HPP_
+
+#include <SDL.h>
+
+#include <array>        // array
+#include <atomic>       // atomic, memory_order
+#include <functional>   // function
+#include <string>       // string
+#include <type_traits>  // is_void_v
+#include <utility>      // move, declval
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/mutex.hpp"
+#include "../concurrency/semaphore.hpp"
+#include "../concurrency/thread.hpp"
+#include "render_command_list.hpp"
+#include "renderer.hpp"
+#include "sprite_batch.hpp"
+#include "window.hpp"
+
+namespace cen {
+
+/// The contents of a frame that is rendered by a render thread.
+struct render_frame final {
+  render_command_list commands;  ///< Executed first, usually starts with a clear.
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  sprite_batch sprites;  ///< Flushed after the commands.
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+};
+
+/**
+ * Owns a window and a renderer, and renders submitted frames on a dedicated thread.
+ *
+ * SDL requires that a renderer is only used by the thread that created it. A render thread
+ * creates its renderer on its own thread, so that the main thread is free to simulate the
+ * next frame while the previous frame is rendered and presented.
+ *
+ * Frames are recorded into one of three frame buffers, and handed over to the render thread
+ * without blocking. If the main thread submits frames faster than they can be rendered, the
+ * render thread skips to the most recently submitted frame.
+ *
+ * \code{cpp}
+ * cen::render_thread rendering {cen::window {"Game"}};
+ * const auto hero = rendering.invoke([](cen::renderer& renderer) {
+ *   return renderer.make_texture("hero.png");
+ * });
+ *
+ * while (running) {
+ *   handler.poll();  // Events are still handled on the main thread
+ *   update();
+ *
+ *   auto& frame = rendering.begin_frame();
+ *   frame.commands.clear_with(cen::colors::black);
+ *   frame.commands.render(hero, position);
+ *   rendering.submit_frame();
+ * }
+ * \endcode
+ *
+ * \details Textures must be created and destroyed on the render thread, through `post()` or
+ *          `invoke()`. Posted functions are executed after the frame that was most recently
+ *          submitted before them, so a texture may be destroyed by a posted function as soon
+ *          as the frames that use it have been submitted.
+ *
+ * \details Recorded frames only store raw texture pointers, see `render_command_list`. All
+ *          textures must be destroyed before the render thread, since the renderer is
+ *          destroyed when the thread stops.
+ *
+ * \see render_frame
+ * \see render_command_list
+ */
+class render_thread final {
+ public:
+  using task_type = std::function<void(renderer&)>;
+
+  /**
+   * Takes ownership of a window, and starts rendering to it on a new thread.
+   *
+   * \details The window should be created on the main thread, which is required by some
+   *          platforms. The constructor returns once the renderer has been created.
+   *
+   * \param window the window that will be rendered to.
+   * \param flags the renderer flags, see `renderer_options`.
+   *
+   * \throws sdl_error if the thread or the renderer cannot be created.
+   */
+  explicit render_thread(window window, const uint32 flags = renderer::default_flags())
+      : mWindow {std::move(window)}
+      , mFlags {flags}
+      , mThread {&render_thread::run, "render_thread", this}
+  {
+    while (mStatus.load(std::memory_order_acquire) == status::starting) {
+      thread::sleep(u32ms {1});
+    }
+
+    if (mStatus.load(std::memory_order_acquire) == status::failed) {
+      mThread.join();
+      throw sdl_error {mError.c_str()};
+    }
+  }
+
+  CENTURION_DISABLE_COPY(render_thread)
+  CENTURION_DISABLE_MOVE(render_thread)
+
+  /// Renders the last submitted frame and runs all posted functions, then stops the thread.
+  ~render_thread() noexcept
+  {
+    if (mThread.joinable()) {
+      mRunning.store(false, std::memory_order_release);
+      mWakeup.release();
+      mThread.join();
+    }
+  }
+
+  /**
+   * Returns the frame buffer that the next frame should be recorded into.
+   *
+   * \details The frame buffer is emptied, and is not used by the render thread until it is
+   *          submitted. This function must only be called by the thread that submits frames.
+   *
+   * \return the frame buffer of the next frame.
+   */
+  auto begin_frame() noexcept -> render_frame&
+  {
+    auto& frame = mFrames[mWriteIndex];
+
+    frame.commands.reset();
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    frame.sprites.clear();
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+    return frame;
+  }
+
+  /// Hands the frame recorded since the last `begin_frame()` over to the render thread.
+  void submit_frame() noexcept
+  {
+    const auto previous = mShared.exchange(mWriteIndex | fresh_bit, std::memory_order_acq_rel);
+    mWriteIndex = previous & index_mask;
+
+    /* The previous frame was never rendered, since it wasn't picked up in time */
+    if (previous & fresh_bit) {
+      mDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    mSubmitted.fetch_add(1, std::memory_order_relaxed);
+    mWakeup.release();
+  }
+
+  /**
+   * Executes a function on the render thread, may be called from any thread.
+   *
+   * \param task the function object, which is invoked with the renderer.
+   */
+  void post(task_type task)
+  {
+    {
+      scoped_lock lock {mTaskMutex};
+      mTasks.push_back(std::move(task));
+    }
+
+    mWakeup.release();
+  }
+
+  /**
+   * Executes a function on the render thread, and waits for it to finish.
+   *
+   * \details This must not be called on the render thread, i.e. by a posted function.
+   *
+   * \param callable the function object, which is invoked with the renderer.
+   *
+   * \return the value returned by the function object.
+   *
+   * \throws exception if the function object threw an exception.
+   */
+  template <typename Callable>
+  auto invoke(Callable&& callable) -> decltype(callable(std::declval<renderer&>()))
+  {
+    using value_type = decltype(callable(std::declval<renderer&>()));
+
+    semaphore done {0};
+    bool failed = false;
+
+    if constexpr (std::is_void_v<value_type>) {
+      post([&](renderer& renderer) {
+        try {
+          callable(renderer);
+        }
+        catch (...) {
+          failed = true;
+        }
+
+        done.release();
+      });
+
+      done.acquire();
+      if (failed) {
+        throw exception {"Render thread task failed!"};
+      }
+    }
+    else {
+      maybe<value_type> value;
+      post([&](renderer& renderer) {
+        try {
+          value.emplace(callable(renderer));
+        }
+        catch (...) {
+          failed = true;
+        }
+
+        done.release();
+      });
+
+      done.acquire();
+      if (failed) {
+        throw exception {"Render thread task failed!"};
+      }
+
+      return std::move(*value);
+    }
+  }
+
+  /// Returns the window, which may be used by the main thread, e.g. to change its title.
+  [[nodiscard]] auto get_window() noexcept -> window& { return mWindow; }
+
+  [[nodiscard]] auto get_window() const noexcept -> const window& { return mWindow; }
+
+  /// Returns the amount of submitted frames.
+  [[nodiscard]] auto submitted() const noexcept -> uint64
+  {
+    return mSubmitted.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of frames that have been rendered and presented.
+  [[nodiscard]] auto rendered() const noexcept -> uint64
+  {
+    return mRendered.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of frames that were replaced by a newer frame before being rendered.
+  [[nodiscard]] auto dropped() const noexcept -> uint64
+  {
+    return mDropped.load(std::memory_order_relaxed);
+  }
+
+  /// Returns the amount of frames that couldn't be rendered, and posted functions that threw.
+  [[nodiscard]] auto failed() const noexcept -> uint64
+  {
+    return mFailed.load(std::memory_order_relaxed);
+  }
+
+ private:
+  enum class status { starting, ready, failed };
+
+  inline constexpr static uint32 index_mask = 0b011;
+  inline constexpr static uint32 fresh_bit = 0b100;
+
+  window mWindow;
+  uint32 mFlags {};
+  std::string mError;
+  std::array<render_frame, 3> mFrames;
+  uint32 mWriteIndex {0};  ///< Only used by the submitting thread.
+  uint32 mReadIndex {1};   ///< Only used by the render thread.
+  std::atomic<uint32> mShared {2};
+  mutex mTaskMutex;
+  std::vector<task_type> mTasks;
+  semaphore mWakeup {0};
+  std::atomic<status> mStatus {status::starting};
+  std::atomic<bool> mRunning {true};
+  std::atomic<uint64> mSubmitted {};
+  std::atomic<uint64> mRendered {};
+  std::atomic<uint64> mDropped {};
+  std::atomic<uint64> mFailed {};
+  thread mThread;  ///< Must be declared last, since it uses the other members immediately.
+
+  void render(renderer& renderer, render_frame& frame) noexcept
+  {
+    bool ok = static_cast<bool>(frame.commands.execute(renderer));
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    ok = frame.sprites.flush(renderer) && ok;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+    if (!ok) {
+      mFailed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    renderer.present();
+    mRendered.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /* Returns false if there was nothing to do */
+  auto tick(renderer& renderer, std::vector<task_type>& tasks) -> bool
+  {
+    /* Tasks are collected before the frame, so they run after every frame submitted before
+       them, which makes it safe for a task to destroy textures used by those frames */
+    {
+      scoped_lock lock {mTaskMutex};
+      tasks.swap(mTasks);
+    }
+
+    const bool fresh = mShared.load(std::memory_order_acquire) & fresh_bit;
+    if (fresh) {
+      mReadIndex = mShared.exchange(mReadIndex, std::memory_order_acq_rel) & index_mask;
+      render(renderer, mFrames[mReadIndex]);
+    }
+
+    for (auto& task : tasks) {
+      try {
+        task(renderer);
+      }
+      catch (...) {
+        mFailed.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    const bool worked = fresh || !tasks.empty();
+    tasks.clear();
+
+    return worked;
+  }
+
+  static int SDLCALL run(void* data)
+  {
+    auto* self = static_cast<render_thread*>(data);
+
+    maybe<renderer> renderer;
+    try {
+      renderer.emplace(self->mWindow.make_renderer(self->mFlags));
+    }
+    catch (const std::exception& e) {
+      self->mError = e.what();
+      self->mStatus.store(status::failed, std::memory_order_release);
+      return -1;
+    }
+
+    self->mStatus.store(status::ready, std::memory_order_release);
+
+    std::vector<task_type> tasks;
+    while (self->mRunning.load(std::memory_order_acquire)) {
+      self->mWakeup.acquire(u32ms {10});
+      while (self->tick(*renderer, tasks)) {
+        /* Keep going until everything submitted so far has been handled */
+      }
+    }
+
+    /* Handle work submitted right before stopping, e.g. functions that destroy textures */
+    while (self->tick(*renderer, tasks)) {
+    }
+
+    return 0;
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RENDER_THREAD_HPP_
@@ -0,0 +1,212 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_RENDER_VIEW_HPP_
+#define CENTURION_VIDEO_RENDER_VIEW_HPP_
+
+#include <SDL.h>
+
+#include <cmath>    // ceil, sqrt
+#include <string>   // string
+#include <vector>   // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../features.hpp"
+#include "camera.hpp"
+#include "renderer.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/**
+ * Describes a region of the rendering target that shows a part of the world.
+ *
+ * Views are used to replay the same recorded content several times, e.g. once for each
+ * player in a split-screen game. The camera maps world coordinates onto the viewport, so its
+ * logical size should match the size of the viewport.
+ *
+ * \see sprite_batch::flush
+ * \see render_command_list::execute
+ */
+struct render_view final {
+  irect viewport;  ///< The region of the rendering target, in output coordinates.
+  camera eye;      ///< Maps world coordinates onto the viewport.
+};
+
+/**
+ * Creates a view that shows a world-space area in a viewport.
+ *
+ * \param viewport the region of the rendering target, in output coordinates.
+ * \param world the visible area, in world coordinates.
+ *
+ * \return a view with a camera that maps the world area onto the entire viewport.
+ */
+[[nodiscard]] inline auto make_render_view(const irect& viewport, const frect& world) noexcept
+    -> render_view
+{
+  return {viewport, camera {world, viewport.size().as_f()}};
+}
+
+/**
+ * Divides an area into a grid of equally sized viewports.
+ *
+ * The grid uses as few columns as possible while being at least as wide as it is tall, so
+ * two viewports are placed side by side, and three or four viewports use a 2x2 grid. The
+ * viewports are ordered row by row, and any remainder of the division is given to the last
+ * row and column, so that the viewports cover the entire area.
+ *
+ * \param area the area that will be divided, e.g. the renderer output size.
+ * \param count the amount of viewports.
+ *
+ * \return the viewports, which is empty if the count is zero.
+ */
+[[nodiscard]] inline auto split_screen(const irect& area, const usize count)
+    -> std::vector<irect>
+{
+  std::vector<irect> viewports;
+  if (count == 0) {
+    return viewports;
+  }
+
+  const auto columns =
+      static_cast<int>(std::ceil(std::sqrt(static_cast<double>(count))));
+  const auto rows = static_cast<int>((count + static_cast<usize>(columns) - 1) /
+                                     static_cast<usize>(columns));
+
+  const auto cellWidth = area.width() / columns;
+  const auto cellHeight = area.height() / rows;
+
+  viewports.reserve(count);
+  for (usize index = 0; index < count; ++index) {
+    const auto column = static_cast<int>(index % static_cast<usize>(columns));
+    const auto row = static_cast<int>(index / static_cast<usize>(columns));
+
+    const auto x = area.x() + column * cellWidth;
+    const auto y = area.y() + row * cellHeight;
+    const auto width = (column == columns - 1) ? area.max_x() - x : cellWidth;
+    const auto height = (row == rows - 1) ? area.max_y() - y : cellHeight;
+
+    viewports.push_back({x, y, width, height});
+  }
+
+  return viewports;
+}
+
+namespace detail {
+
+/// Returns the smallest world-space area that contains the areas of all views.
+[[nodiscard]] inline auto view_bounds(const render_view* views, const usize count) noexcept
+    -> frect
+{
+  frect bounds = views[0].eye.view();
+  for (usize index = 1; index < count; ++index) {
+    bounds = get_union(bounds, views[index].eye.view());
+  }
+
+  return bounds;
+}
+
+/// Restores the viewport and clip of a renderer when a replay into views is done.
+template <typename T>
+class view_scope final {
+ public:
+  explicit view_scope(basic_renderer<T>& renderer) noexcept
+      : mRenderer {renderer}
+      , mViewport {renderer.viewport()}
+      , mClip {renderer.clip()}
+  {
+  }
+
+  view_scope(const view_scope&) = delete;
+  auto operator=(const view_scope&) -> view_scope& = delete;
+
+  ~view_scope() noexcept
+  {
+    mRenderer.set_viewport(mViewport);
+
+    if (mClip) {
+      mRenderer.set_clip(*mClip);
+    }
+    else {
+      mRenderer.reset_clip();
+    }
+  }
+
+  /// Makes a view the destination of subsequent draws, clipped to its viewport.
+  auto apply(const render_view& view) noexcept -> result
+  {
+    const auto viewportResult = mRenderer.set_viewport(view.viewport);
+
+    /* The clip area is relative to the viewport */
+    const auto clipResult = mRenderer.set_clip(irect {{0, 0}, view.viewport.size()});
+
+    return viewportResult && clipResult;
+  }
+
+ private:
+  basic_renderer<T>& mRenderer;
+  irect mViewport;
+  maybe<irect> mClip;
+};
+
+}  // namespace detail
+
+[[nodiscard]] inline auto to_string(const render_view& view) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("render_view(viewport: {}, view: {})",
+                     to_string(view.viewport),
+                     to_string(view.eye.view()));
+#else
+  return "render_view(viewport: " + to_string(view.viewport) +
+         ", view: " + to_string(view.eye.view()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const render_view& view) -> std::ostream&
+{
+  return stream << to_string(view);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RENDER_VIEW_HPP_
@@ -34,32 +34,52 @@
 #include <cassert>      // assert
 #include <cmath>        // floor, sqrt
 #include <cstddef>      // size_t
+#include <iterator>     // back_inserter, ostreambuf_iterator
 #include <optional>     // optional
-#include <ostream>      // ostream
 #include <string>       // string, to_string
 #include <string>       // string, string_literals
 #include <string_view>  // string_view
-#include <utility>      // pair
+#include <type_traits>  // is_same_v, remove_cv_t, enable_if_t, void_t, is_pointer_v
+#include <utility>      // pair, declval
+#include <vector>       // vector
 
 #include "../common/errors.hpp"
+#include "../common/formatting.hpp"
 #include "../common/math.hpp"
 #include "../common/primitives.hpp"
 #include "../common/result.hpp"
+#include "../common/utils.hpp"
 #include "../detail/owner_handle_api.hpp"
 #include "../detail/stdlib.hpp"
 #include "../features.hpp"
 #include "../io/file.hpp"
+#include "../system/profiler.hpp"
+#include "atlas_region.hpp"
+#include "blend.hpp"
 #include "color.hpp"
+#include "render_counters.hpp"
 #include "surface.hpp"
 #include "texture.hpp"
 #include "unicode_string.hpp"
 
 #if CENTURION_HAS_FEATURE_FORMAT
 
-#include <format>  // format
+#include <format>  // formatter
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
 namespace cen {
 
 enum class renderer_flip {
@@ -85,11 +105,15 @@ enum class renderer_flip {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const renderer_flip flip) -> std::ostream&
 {
   return stream << to_string(flip);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 struct renderer_scale final {
   float x {};
   float y {};
@@ -98,6 +122,68 @@ struct renderer_scale final {
 template <typename T>
 class basic_renderer;
 
+namespace detail {
+
+/// Shadow copies of renderer state, used to skip redundant state changes.
+struct renderer_state final {
+  maybe<color> draw_color;
+  maybe<blend_mode> blend;
+  maybe<irect> viewport;
+  maybe<maybe<irect>> clip;
+  maybe<SDL_Texture*> target;
+  bool enabled {};
+
+  void invalidate() noexcept
+  {
+    draw_color.reset();
+    blend.reset();
+    viewport.reset();
+    clip.reset();
+    target.reset();
+  }
+};
+
+/* Reused by the renderer for shapes that are submitted with a single draw call */
+struct renderer_scratch final {
+  std::vector<SDL_FPoint> points;
+  std::vector<SDL_FRect> rects;
+};
+
+/// Indicates whether a type may be used for geometry vertex indices.
+template <typename T>
+inline constexpr bool is_geometry_index_v =
+    std::is_same_v<T, int> || std::is_same_v<T, uint8> || std::is_same_v<T, uint16> ||
+    std::is_same_v<T, uint32>;
+
+/* Indicates whether a type is a contiguous container of values, with data() and size() */
+template <typename T, typename = void>
+inline constexpr bool is_geometry_container_v = false;
+
+template <typename T>
+inline constexpr bool is_geometry_container_v<
+    T,
+    std::void_t<typename T::value_type,
+                decltype(std::declval<const T&>().data()),
+                decltype(std::declval<const T&>().size())>> = !std::is_pointer_v<T>;
+
+/* Indicates whether a type is a container of vertices */
+template <typename T, typename = void>
+inline constexpr bool is_vertex_container_v = false;
+
+template <typename T>
+inline constexpr bool is_vertex_container_v<T, std::enable_if_t<is_geometry_container_v<T>>> =
+    std::is_same_v<std::remove_cv_t<typename T::value_type>, SDL_Vertex>;
+
+/* Indicates whether a type is a container of geometry indices */
+template <typename T, typename = void>
+inline constexpr bool is_index_container_v = false;
+
+template <typename T>
+inline constexpr bool is_index_container_v<T, std::enable_if_t<is_geometry_container_v<T>>> =
+    is_geometry_index_v<std::remove_cv_t<typename T::value_type>>;
+
+}  // namespace detail
+
 using renderer = basic_renderer<detail::owner_tag>;
 using renderer_handle = basic_renderer<detail::handle_tag>;
 
@@ -135,11 +221,22 @@ class basic_renderer final {
   {
   }
 
+  /**
+   * Creates a texture from a surface.
+   *
+   * \param surface the surface that provides the pixel data.
+   * \param alpha whether the surface pixels are premultiplied, in which case the texture uses
+   * `premultiplied_blend_mode()`. The pixels are never modified.
+   *
+   * \return the created texture.
+   */
   template <typename X>
-  [[nodiscard]] auto make_texture(const basic_surface<X>& surface) const -> texture
+  [[nodiscard]] auto make_texture(const basic_surface<X>& surface,
+                                  const alpha_mode alpha = alpha_mode::straight) const
+      -> texture
   {
     if (auto* ptr = SDL_CreateTextureFromSurface(get(), surface.get())) {
-      return texture {ptr};
+      return apply_alpha_mode(texture {ptr}, alpha);
     }
     else {
       throw sdl_error {};
@@ -148,14 +245,16 @@ class basic_renderer final {
 
   [[nodiscard]] auto make_texture(const iarea& size,
                                   const pixel_format format,
-                                  const texture_access access) const -> texture
+                                  const texture_access access,
+                                  const alpha_mode alpha = alpha_mode::straight) const
+      -> texture
   {
     if (auto* ptr = SDL_CreateTexture(get(),
                                       to_underlying(format),
                                       to_underlying(access),
                                       size.width,
                                       size.height)) {
-      return texture {ptr};
+      return apply_alpha_mode(texture {ptr}, alpha);
     }
     else {
       throw sdl_error {};
@@ -182,7 +281,9 @@ class basic_renderer final {
 
   [[nodiscard]] auto make_texture(file& file) const -> texture
   {
-    if (auto* ptr = IMG_LoadTextureRW(get(), file.data(), SDL_FALSE)) {
+    /* Unrecognized formats have no type name, in which case SDL_image probes every format */
+    const auto* type = detail::image_type_name(file.detect_type());
+    if (auto* ptr = IMG_LoadTextureTyped_RW(get(), file.data(), SDL_FALSE, type)) {
       return texture {ptr};
     }
     else {
@@ -192,7 +293,11 @@ class basic_renderer final {
 
 #endif  // CENTURION_NO_SDL_IMAGE
 
-  auto clear() noexcept -> result { return SDL_RenderClear(get()) == 0; }
+  auto clear() noexcept -> result
+  {
+    mCounters.draw();
+    return SDL_RenderClear(get()) == 0;
+  }
 
   void clear_with(const color& color) noexcept
   {
@@ -202,7 +307,31 @@ class basic_renderer final {
     set_color(previous);
   }
 
-  void present() noexcept { SDL_RenderPresent(get()); }
+  /**
+   * Submits all pending render commands to the GPU, without presenting.
+   *
+   * This is mostly useful when mixing the renderer with direct OpenGL or Vulkan calls. When
+   * profiling, the flush is recorded as a zone, which together with the frame markers of
+   * `present()` shows how the frame time is split between recording and submission.
+   *
+   * \return `success` if the commands were flushed; `failure` otherwise.
+   */
+  auto flush() noexcept -> result
+  {
+    CENTURION_PROFILE_SCOPE("renderer::flush");
+    return SDL_RenderFlush(get()) == 0;
+  }
+
+  void present() noexcept
+  {
+    {
+      CENTURION_PROFILE_SCOPE("renderer::present");
+      SDL_RenderPresent(get());
+      mCounters.present();
+    }
+
+    CENTURION_PROFILE_FRAME();
+  }
 
   void fill() noexcept
   {
@@ -224,6 +353,8 @@ class basic_renderer final {
   template <typename X>
   auto draw_rect(const basic_rect<X>& rect) noexcept -> result
   {
+    mCounters.draw();
+
     if constexpr (basic_rect<X>::integral) {
       return SDL_RenderDrawRect(get(), rect.data()) == 0;
     }
@@ -235,6 +366,8 @@ class basic_renderer final {
   template <typename X>
   auto fill_rect(const basic_rect<X>& rect) noexcept -> result
   {
+    mCounters.draw();
+
     if constexpr (basic_rect<X>::integral) {
       return SDL_RenderFillRect(get(), rect.data()) == 0;
     }
@@ -246,6 +379,8 @@ class basic_renderer final {
   template <typename X>
   auto draw_line(const basic_point<X>& start, const basic_point<X>& end) noexcept -> result
   {
+    mCounters.draw();
+
     if constexpr (basic_point<X>::integral) {
       return SDL_RenderDrawLine(get(), start.x(), start.y(), end.x(), end.y()) == 0;
     }
@@ -261,6 +396,8 @@ class basic_renderer final {
     using value_t = typename point_t::value_type;    // either int or float
 
     if (!container.empty()) {
+      mCounters.draw();
+
       const auto& front = container.front();
       const auto* first = front.data();
 
@@ -276,9 +413,122 @@ class basic_renderer final {
     }
   }
 
+  /**
+   * Draws the outlines of a collection of rectangles with a single draw call.
+   *
+   * The container must store its rectangles contiguously, e.g. `std::vector<irect>`. The
+   * rectangles are passed to SDL without being copied.
+   *
+   * \param container the rectangles that will be drawn.
+   *
+   * \return `success` if the rectangles were drawn; `failure` otherwise.
+   */
+  template <typename Container>
+  auto draw_rects(const Container& container) noexcept -> result
+  {
+    using rect_t = typename Container::value_type;  // a rectangle of int or float
+    using value_t = typename rect_t::value_type;    // either int or float
+
+    static_assert(sizeof(rect_t) == sizeof(typename rect_t::rect_type),
+                  "Rectangles must have the same layout as the SDL rectangle types!");
+
+    if (!container.empty()) {
+      mCounters.draw();
+
+      const auto& front = container.front();
+      const auto* first = front.data();
+
+      if constexpr (std::is_same_v<value_t, int>) {
+        return SDL_RenderDrawRects(get(), first, isize(container)) == 0;
+      }
+      else {
+        return SDL_RenderDrawRectsF(get(), first, isize(container)) == 0;
+      }
+    }
+    else {
+      return failure;
+    }
+  }
+
+  /**
+   * Fills a collection of rectangles with a single draw call.
+   *
+   * The container must store its rectangles contiguously, e.g. `std::vector<irect>`. The
+   * rectangles are passed to SDL without being copied.
+   *
+   * \param container the rectangles that will be filled.
+   *
+   * \return `success` if the rectangles were filled; `failure` otherwise.
+   */
+  template <typename Container>
+  auto fill_rects(const Container& container) noexcept -> result
+  {
+    using rect_t = typename Container::value_type;  // a rectangle of int or float
+    using value_t = typename rect_t::value_type;    // either int or float
+
+    static_assert(sizeof(rect_t) == sizeof(typename rect_t::rect_type),
+                  "Rectangles must have the same layout as the SDL rectangle types!");
+
+    if (!container.empty()) {
+      mCounters.draw();
+
+      const auto& front = container.front();
+      const auto* first = front.data();
+
+      if constexpr (std::is_same_v<value_t, int>) {
+        return SDL_RenderFillRects(get(), first, isize(container)) == 0;
+      }
+      else {
+        return SDL_RenderFillRectsF(get(), first, isize(container)) == 0;
+      }
+    }
+    else {
+      return failure;
+    }
+  }
+
+  /**
+   * Draws a collection of points with a single draw call.
+   *
+   * The container must store its points contiguously, e.g. `std::vector<ipoint>`. The points
+   * are passed to SDL without being copied.
+   *
+   * \param container the points that will be drawn.
+   *
+   * \return `success` if the points were drawn; `failure` otherwise.
+   */
+  template <typename Container>
+  auto draw_points(const Container& container) noexcept -> result
+  {
+    using point_t = typename Container::value_type;  // a point of int or float
+    using value_t = typename point_t::value_type;    // either int or float
+
+    static_assert(sizeof(point_t) == sizeof(typename point_t::point_type),
+                  "Points must have the same layout as the SDL point types!");
+
+    if (!container.empty()) {
+      mCounters.draw();
+
+      const auto& front = container.front();
+      const auto* first = front.data();
+
+      if constexpr (std::is_same_v<value_t, int>) {
+        return SDL_RenderDrawPoints(get(), first, isize(container)) == 0;
+      }
+      else {
+        return SDL_RenderDrawPointsF(get(), first, isize(container)) == 0;
+      }
+    }
+    else {
+      return failure;
+    }
+  }
+
   template <typename X>
   auto draw_point(const basic_point<X>& point) noexcept -> result
   {
+    mCounters.draw();
+
     if constexpr (basic_point<X>::integral) {
       return SDL_RenderDrawPoint(get(), point.x(), point.y()) == 0;
     }
@@ -287,11 +537,20 @@ class basic_renderer final {
     }
   }
 
+  /**
+   * Draws the outline of a circle.
+   *
+   * All points of the circle are collected and submitted with a single draw call. The points
+   * are stored in a buffer owned by the renderer, which is reused by subsequent calls.
+   *
+   * \param position the center of the circle.
+   * \param radius the radius of the circle.
+   *
+   * \return `success` if the circle was drawn; `failure` otherwise.
+   */
   template <typename X>
-  void draw_circle(const basic_point<X>& position, const float radius) noexcept
+  auto draw_circle(const basic_point<X>& position, const float radius) noexcept -> result
   {
-    using value_t = typename basic_point<X>::value_type;
-
     auto error = -radius;
     auto x = radius - 0.5f;
     auto y = 0.5f;
@@ -299,23 +558,42 @@ class basic_renderer final {
     const auto cx = static_cast<float>(position.x()) - 0.5f;
     const auto cy = static_cast<float>(position.y()) - 0.5f;
 
+    /* Each octant contributes at most radius + 1 points, so the points never reallocate */
+    auto& points = mScratch.points;
+    points.clear();
+
+    const auto octant = static_cast<usize>((detail::max)(radius, 0.0f)) + 2u;
+    if (!reserve_scratch(points, octant * 8u)) {
+      return failure;
+    }
+
+    const auto add = [&points](const float px, const float py) {
+      if constexpr (basic_point<X>::integral) {
+        points.push_back({static_cast<float>(static_cast<int>(px)),
+                          static_cast<float>(static_cast<int>(py))});
+      }
+      else {
+        points.push_back({px, py});
+      }
+    };
+
     while (x >= y) {
-      draw_point<value_t>({static_cast<value_t>(cx + x), static_cast<value_t>(cy + y)});
-      draw_point<value_t>({static_cast<value_t>(cx + y), static_cast<value_t>(cy + x)});
+      add(cx + x, cy + y);
+      add(cx + y, cy + x);
 
       if (x != 0) {
-        draw_point<value_t>({static_cast<value_t>(cx - x), static_cast<value_t>(cy + y)});
-        draw_point<value_t>({static_cast<value_t>(cx + y), static_cast<value_t>(cy - x)});
+        add(cx - x, cy + y);
+        add(cx + y, cy - x);
       }
 
       if (y != 0) {
-        draw_point<value_t>({static_cast<value_t>(cx + x), static_cast<value_t>(cy - y)});
-        draw_point<value_t>({static_cast<value_t>(cx - y), static_cast<value_t>(cy + x)});
+        add(cx + x, cy - y);
+        add(cx - y, cy + x);
       }
 
       if (x != 0 && y != 0) {
-        draw_point<value_t>({static_cast<value_t>(cx - x), static_cast<value_t>(cy - y)});
-        draw_point<value_t>({static_cast<value_t>(cx - y), static_cast<value_t>(cy - x)});
+        add(cx - x, cy - y);
+        add(cx - y, cy - x);
       }
 
       error += y;
@@ -328,24 +606,64 @@ class basic_renderer final {
         error -= x;
       }
     }
+
+    if (!points.empty()) {
+      mCounters.draw();
+      return SDL_RenderDrawPointsF(get(), points.data(), isize(points)) == 0;
+    }
+    else {
+      return failure;
+    }
   }
 
+  /**
+   * Draws a filled circle.
+   *
+   * The circle is filled with one rectangle per scanline, and all rectangles are submitted
+   * with a single draw call. Like `draw_circle()`, the rectangles are stored in a reused
+   * buffer owned by the renderer.
+   *
+   * \param center the center of the circle.
+   * \param radius the radius of the circle.
+   *
+   * \return `success` if the circle was drawn; `failure` otherwise.
+   */
   template <typename X>
-  void fill_circle(const basic_point<X>& center, const float radius)
+  auto fill_circle(const basic_point<X>& center, const float radius) noexcept -> result
   {
     const auto cx = static_cast<float>(center.x());
     const auto cy = static_cast<float>(center.y());
 
+    auto& lines = mScratch.rects;
+    lines.clear();
+
+    const auto scanlines = static_cast<usize>((detail::max)(radius, 0.0f)) + 1u;
+    if (!reserve_scratch(lines, scanlines * 2u)) {
+      return failure;
+    }
+
     for (auto dy = 1.0f; dy <= radius; dy += 1.0f) {
       const auto dx = std::floor(std::sqrt((2.0f * radius * dy) - (dy * dy)));
-      draw_line<float>({cx - dx, cy + dy - radius}, {cx + dx, cy + dy - radius});
-      draw_line<float>({cx - dx, cy - dy + radius}, {cx + dx, cy - dy + radius});
+      const auto width = (2.0f * dx) + 1.0f;
+
+      lines.push_back({cx - dx, cy + dy - radius, width, 1.0f});
+      lines.push_back({cx - dx, cy - dy + radius, width, 1.0f});
+    }
+
+    if (!lines.empty()) {
+      mCounters.draw();
+      return SDL_RenderFillRectsF(get(), lines.data(), isize(lines)) == 0;
+    }
+    else {
+      return failure;
     }
   }
 
   template <typename X, typename Y>
   auto render(const basic_texture<X>& texture, const basic_point<Y>& pos) noexcept -> result
   {
+    mCounters.copy(texture.get());
+
     if constexpr (basic_point<Y>::floating) {
       const auto size = texture.size().as_f();
       const SDL_FRect dst {pos.x(), pos.y(), size.width, size.height};
@@ -360,6 +678,8 @@ class basic_renderer final {
   template <typename X, typename Y>
   auto render(const basic_texture<X>& texture, const basic_rect<Y>& dst) noexcept -> result
   {
+    mCounters.copy(texture.get());
+
     if constexpr (basic_rect<Y>::floating) {
       return SDL_RenderCopyF(get(), texture.get(), nullptr, dst.data()) == 0;
     }
@@ -373,6 +693,8 @@ class basic_renderer final {
               const irect& src,
               const basic_rect<Y>& dst) noexcept -> result
   {
+    mCounters.copy(texture.get());
+
     if constexpr (basic_rect<Y>::floating) {
       return SDL_RenderCopyF(get(), texture.get(), src.data(), dst.data()) == 0;
     }
@@ -387,6 +709,8 @@ class basic_renderer final {
               const basic_rect<Y>& dst,
               const double angle) noexcept -> result
   {
+    mCounters.copy(texture.get());
+
     if constexpr (basic_rect<Y>::floating) {
       return SDL_RenderCopyExF(get(),
                                texture.get(),
@@ -415,6 +739,8 @@ class basic_renderer final {
               const basic_point<Z>& center,
               const renderer_flip flip) noexcept -> result
   {
+    mCounters.copy(texture.get());
+
     static_assert(std::is_same_v<typename basic_rect<Y>::value_type,
                                  typename basic_point<Z>::value_type>,
                   "Destination rectangle and center point must have the same "
@@ -440,11 +766,44 @@ class basic_renderer final {
     }
   }
 
+  /// Renders an atlas region at a position, using the size of the region.
+  template <typename Y>
+  auto render(const atlas_region& region, const basic_point<Y>& pos) noexcept -> result
+  {
+    mCounters.copy(region.texture);
+
+    if constexpr (basic_point<Y>::floating) {
+      const auto size = region.size().as_f();
+      const SDL_FRect dst {pos.x(), pos.y(), size.width, size.height};
+      return SDL_RenderCopyF(get(), region.texture, region.source.data(), &dst) == 0;
+    }
+    else {
+      const auto size = region.size();
+      const SDL_Rect dst {pos.x(), pos.y(), size.width, size.height};
+      return SDL_RenderCopy(get(), region.texture, region.source.data(), &dst) == 0;
+    }
+  }
+
+  /// Renders an atlas region to a destination rectangle.
+  template <typename Y>
+  auto render(const atlas_region& region, const basic_rect<Y>& dst) noexcept -> result
+  {
+    mCounters.copy(region.texture);
+
+    if constexpr (basic_rect<Y>::floating) {
+      return SDL_RenderCopyF(get(), region.texture, region.source.data(), dst.data()) == 0;
+    }
+    else {
+      return SDL_RenderCopy(get(), region.texture, region.source.data(), dst.data()) == 0;
+    }
+  }
+
 #if SDL_VERSION_ATLEAST(2, 0, 18)
 
   template <usize Size>
   auto render_geo(bounded_array_ref<const SDL_Vertex, Size> vertices) noexcept -> result
   {
+    mCounters.geometry(nullptr);
     return SDL_RenderGeometry(mRenderer,
                               nullptr,
                               vertices,
@@ -457,6 +816,7 @@ class basic_renderer final {
   auto render_geo(bounded_array_ref<const SDL_Vertex, VertexCount> vertices,
                   bounded_array_ref<const int, IndexCount> indices) noexcept -> result
   {
+    mCounters.geometry(nullptr);
     static_assert(IndexCount <= VertexCount);
     return SDL_RenderGeometry(mRenderer,
                               nullptr,
@@ -470,6 +830,7 @@ class basic_renderer final {
   auto render_geo(const basic_texture<X>& texture,
                   bounded_array_ref<const SDL_Vertex, Size> vertices) noexcept -> result
   {
+    mCounters.geometry(texture.get());
     return SDL_RenderGeometry(mRenderer,
                               texture.get(),
                               vertices,
@@ -483,6 +844,7 @@ class basic_renderer final {
                   bounded_array_ref<const SDL_Vertex, VertexCount>& vertices,
                   bounded_array_ref<const int, IndexCount>& indices) noexcept -> result
   {
+    mCounters.geometry(texture.get());
     static_assert(IndexCount <= VertexCount);
     return SDL_RenderGeometry(mRenderer,
                               texture.get(),
@@ -492,15 +854,179 @@ class basic_renderer final {
                               static_cast<int>(IndexCount)) == 0;
   }
 
+  /**
+   * Renders a textured triangle list, where the data is provided by contiguous containers.
+   *
+   * \details The index container may store `int`, `uint8`, `uint16` or `uint32` values, which
+   * makes it possible to use compact indices for large meshes. Views such as `std::span` are
+   * also accepted.
+   *
+   * \param texture the texture that will be used.
+   * \param vertices the vertices, e.g. a `std::vector<SDL_Vertex>`.
+   * \param indices the vertex indices, e.g. a `std::vector<int>`. May be empty.
+   *
+   * \return `success` if the geometry was rendered; `failure` otherwise.
+   */
+  template <typename X,
+            typename VertexContainer,
+            typename IndexContainer,
+            std::enable_if_t<detail::is_vertex_container_v<VertexContainer> &&
+                                 detail::is_index_container_v<IndexContainer>,
+                             int> = 0>
+  auto render_geo(const basic_texture<X>& texture,
+                  const VertexContainer& vertices,
+                  const IndexContainer& indices) noexcept -> result
+  {
+    if (!vertices.empty()) {
+      return submit_geometry(texture.get(),
+                             vertices.data(),
+                             vertices.size(),
+                             indices.empty() ? nullptr : indices.data(),
+                             indices.size());
+    }
+    else {
+      return failure;
+    }
+  }
+
+  /**
+   * Renders a textured triangle list, where the amount of vertices is only known at runtime.
+   *
+   * \param texture the texture that will be used.
+   * \param vertices the vertices.
+   * \param vertexCount the number of vertices.
+   * \param indices optional vertex indices, stored as `int`, `uint8`, `uint16` or `uint32`.
+   * \param indexCount the number of indices.
+   *
+   * \return `success` if the geometry was rendered; `failure` otherwise.
+   */
+  template <typename X, typename Index = int>
+  auto render_geo(const basic_texture<X>& texture,
+                  const SDL_Vertex* vertices,
+                  const usize vertexCount,
+                  const Index* indices = nullptr,
+                  const usize indexCount = 0) noexcept -> result
+  {
+    return submit_geometry(texture.get(), vertices, vertexCount, indices, indexCount);
+  }
+
+  /// Renders an untextured triangle list, see the textured overload for details.
+  template <typename Index = int>
+  auto render_geo(const SDL_Vertex* vertices,
+                  const usize vertexCount,
+                  const Index* indices = nullptr,
+                  const usize indexCount = 0) noexcept -> result
+  {
+    return submit_geometry(nullptr, vertices, vertexCount, indices, indexCount);
+  }
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+  /// Renders a textured triangle list, see the pointer overload for details.
+  template <typename X, typename Index = int>
+  auto render_geo(const basic_texture<X>& texture,
+                  const std::span<const SDL_Vertex> vertices,
+                  const std::span<const Index> indices = {}) noexcept -> result
+  {
+    return submit_geometry(texture.get(),
+                           vertices.data(),
+                           vertices.size(),
+                           indices.empty() ? nullptr : indices.data(),
+                           indices.size());
+  }
+
+  /// Renders an untextured triangle list, see the pointer overload for details.
+  template <typename Index = int>
+  auto render_geo(const std::span<const SDL_Vertex> vertices,
+                  const std::span<const Index> indices = {}) noexcept -> result
+  {
+    return submit_geometry(nullptr,
+                           vertices.data(),
+                           vertices.size(),
+                           indices.empty() ? nullptr : indices.data(),
+                           indices.size());
+  }
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+  /**
+   * Renders a textured triangle list from separate vertex attribute arrays.
+   *
+   * \details This makes it possible to submit structure-of-arrays data, e.g. particles or
+   * tiles, without repacking it into `SDL_Vertex` instances. Every stride is the distance
+   * in bytes between two consecutive elements, so the attributes may also be interleaved in
+   * a custom vertex type. A color stride of zero uses the first color for all vertices.
+   *
+   * \param texture the texture that will be used.
+   * \param xy the vertex positions, stored as pairs of x- and y-coordinates.
+   * \param xyStride the byte stride of the positions.
+   * \param colors the vertex colors.
+   * \param colorStride the byte stride of the colors.
+   * \param uv the normalized texture coordinates, stored as pairs of u- and v-coordinates.
+   * \param uvStride the byte stride of the texture coordinates.
+   * \param vertexCount the number of vertices.
+   * \param indices optional vertex indices, stored as `int`, `uint8`, `uint16` or `uint32`.
+   * \param indexCount the number of indices.
+   *
+   * \return `success` if the geometry was rendered; `failure` otherwise.
+   */
+  template <typename X, typename Index = int>
+  auto render_geo_raw(const basic_texture<X>& texture,
+                      const float* xy,
+                      const int xyStride,
+                      const SDL_Color* colors,
+                      const int colorStride,
+                      const float* uv,
+                      const int uvStride,
+                      const usize vertexCount,
+                      const Index* indices = nullptr,
+                      const usize indexCount = 0) noexcept -> result
+  {
+    mCounters.geometry(texture.get());
+    return submit_raw_geometry(texture.get(),
+                               xy,
+                               xyStride,
+                               colors,
+                               colorStride,
+                               uv,
+                               uvStride,
+                               vertexCount,
+                               indices,
+                               indexCount);
+  }
+
+  /// Renders an untextured triangle list from separate vertex attribute arrays.
+  template <typename Index = int>
+  auto render_geo_raw(const float* xy,
+                      const int xyStride,
+                      const SDL_Color* colors,
+                      const int colorStride,
+                      const usize vertexCount,
+                      const Index* indices = nullptr,
+                      const usize indexCount = 0) noexcept -> result
+  {
+    mCounters.geometry(nullptr);
+    return submit_raw_geometry(nullptr,
+                               xy,
+                               xyStride,
+                               colors,
+                               colorStride,
+                               nullptr,
+                               0,
+                               vertexCount,
+                               indices,
+                               indexCount);
+  }
+
 #endif  // SDL_VERSION_ATLEAST(2, 0, 18)
 
-  auto reset_target() noexcept -> result { return SDL_SetRenderTarget(get(), nullptr) == 0; }
+  auto reset_target() noexcept -> result { return change_target(nullptr); }
 
   template <typename X>
   auto set_target(basic_texture<X>& target) noexcept -> result
   {
     assert(target.is_target());
-    return SDL_SetRenderTarget(get(), target.get()) == 0;
+    return change_target(target.get());
   }
 
   [[nodiscard]] auto get_target() noexcept -> texture_handle
@@ -508,12 +1034,9 @@ class basic_renderer final {
     return texture_handle {SDL_GetRenderTarget(get())};
   }
 
-  auto reset_clip() noexcept -> result { return SDL_RenderSetClipRect(get(), nullptr) == 0; }
+  auto reset_clip() noexcept -> result { return change_clip(nothing); }
 
-  auto set_clip(const irect& area) noexcept -> result
-  {
-    return SDL_RenderSetClipRect(get(), area.data()) == 0;
-  }
+  auto set_clip(const irect& area) noexcept -> result { return change_clip(area); }
 
   [[nodiscard]] auto clip() const noexcept -> maybe<irect>
   {
@@ -536,11 +1059,18 @@ class basic_renderer final {
   {
     assert(size.width >= 0);
     assert(size.height >= 0);
+
+    /* The logical size affects both the viewport and the clip */
+    mState.viewport.reset();
+    mState.clip.reset();
+
+    mCounters.state_change();
     return SDL_RenderSetLogicalSize(get(), size.width, size.height) == 0;
   }
 
   auto set_logical_integer_scaling(const bool enabled) noexcept -> result
   {
+    mCounters.state_change();
     return SDL_RenderSetIntegerScale(get(), enabled ? SDL_TRUE : SDL_FALSE) == 0;
   }
 
@@ -589,30 +1119,107 @@ class basic_renderer final {
 
   auto set_color(const color& color) noexcept -> result
   {
-    return SDL_SetRenderDrawColor(get(),
-                                  color.red(),
-                                  color.green(),
-                                  color.blue(),
-                                  color.alpha()) == 0;
+    if (mState.enabled && mState.draw_color == color) {
+      mCounters.skipped_state_change();
+      return success;
+    }
+
+    mCounters.state_change();
+    const result res = SDL_SetRenderDrawColor(get(),
+                                              color.red(),
+                                              color.green(),
+                                              color.blue(),
+                                              color.alpha()) == 0;
+    update_cached(mState.draw_color, color, res);
+    return res;
   }
 
   auto set_blend_mode(const blend_mode mode) noexcept -> result
   {
-    return SDL_SetRenderDrawBlendMode(get(), static_cast<SDL_BlendMode>(mode)) == 0;
+    if (mState.enabled && mState.blend == mode) {
+      mCounters.skipped_state_change();
+      return success;
+    }
+
+    mCounters.state_change();
+    const auto sdlMode = static_cast<SDL_BlendMode>(mode);
+    const result res = SDL_SetRenderDrawBlendMode(get(), sdlMode) == 0;
+    update_cached(mState.blend, mode, res);
+    return res;
   }
 
   auto set_viewport(const irect& viewport) noexcept -> result
   {
-    return SDL_RenderSetViewport(get(), viewport.data()) == 0;
+    if (mState.enabled && mState.viewport == viewport) {
+      mCounters.skipped_state_change();
+      return success;
+    }
+
+    mCounters.state_change();
+    const result res = SDL_RenderSetViewport(get(), viewport.data()) == 0;
+    update_cached(mState.viewport, viewport, res);
+    return res;
   }
 
   auto set_scale(const renderer_scale scale) noexcept -> result
   {
     assert(scale.x > 0);
     assert(scale.y > 0);
+
+    /* The viewport is reported in scaled coordinates */
+    mState.viewport.reset();
+
+    mCounters.state_change();
     return SDL_RenderSetScale(get(), scale.x, scale.y) == 0;
   }
 
+  /**
+   * Enables or disables caching of the renderer state.
+   *
+   * When enabled, the renderer remembers the latest draw color, blend mode, viewport, clip and
+   * render target, and skips state changes that would not change anything. This avoids
+   * needless flushes of the internal SDL render batch, which are expensive with some backends.
+   *
+   * Note, the cache is only aware of changes made through this renderer instance. Call
+   * `invalidate_state_cache()` if the state may have been changed in other ways, e.g. through
+   * another handle, raw SDL calls or when the window is resized.
+   *
+   * \param enabled `true` if the state should be cached; `false` otherwise.
+   */
+  void set_state_caching(const bool enabled) noexcept
+  {
+    mState.invalidate();
+    mState.enabled = enabled;
+  }
+
+  /// Forgets all cached state, so that the next state changes are always forwarded to SDL.
+  void invalidate_state_cache() noexcept { mState.invalidate(); }
+
+  /// Indicates whether the renderer caches its state.
+  [[nodiscard]] auto is_caching_state() const noexcept -> bool { return mState.enabled; }
+
+  /**
+   * Returns the counters of the calls made through this renderer instance.
+   *
+   * The counters are only collected if `CENTURION_ENABLE_RENDER_COUNTERS` is defined, and are
+   * always zero otherwise. Every renderer and renderer handle has its own counters, so calls
+   * made through other handles to the same renderer are not included.
+   *
+   * \return the counters since the last call to `reset_counters()`.
+   *
+   * \see reset_counters()
+   */
+  [[nodiscard]] auto counters() const noexcept -> render_counters { return mCounters.get(); }
+
+  /// Resets the call counters, usually done once per frame.
+  void reset_counters() noexcept { mCounters.reset(); }
+
+  /// Indicates whether the renderer collects call counters.
+  [[nodiscard]] constexpr static auto has_counters() noexcept -> bool
+  {
+    return detail::has_render_counters;
+  }
+
 #if SDL_VERSION_ATLEAST(2, 0, 18)
 
   auto set_vsync(const bool enabled) noexcept -> result
@@ -624,6 +1231,10 @@ class basic_renderer final {
 
   [[nodiscard]] auto get_color() const noexcept -> color
   {
+    if (mState.enabled && mState.draw_color) {
+      return *mState.draw_color;
+    }
+
     uint8 red {};
     uint8 green {};
     uint8 blue {};
@@ -634,6 +1245,10 @@ class basic_renderer final {
 
   [[nodiscard]] auto get_blend_mode() const noexcept -> blend_mode
   {
+    if (mState.enabled && mState.blend) {
+      return *mState.blend;
+    }
+
     SDL_BlendMode mode {};
     SDL_GetRenderDrawBlendMode(get(), &mode);
     return static_cast<blend_mode>(mode);
@@ -641,6 +1256,10 @@ class basic_renderer final {
 
   [[nodiscard]] auto viewport() const noexcept -> irect
   {
+    if (mState.enabled && mState.viewport) {
+      return *mState.viewport;
+    }
+
     irect viewport {};
     SDL_RenderGetViewport(get(), viewport.data());
     return viewport;
@@ -694,24 +1313,188 @@ class basic_renderer final {
 
  private:
   detail::pointer<T, SDL_Renderer> mRenderer;
+  detail::renderer_state mState;
+  detail::renderer_scratch mScratch;
+  detail::render_counter_recorder mCounters;
+
+  [[nodiscard]] static auto apply_alpha_mode(texture result, const alpha_mode alpha) noexcept
+      -> texture
+  {
+    if (alpha == alpha_mode::premultiplied) {
+      result.set_blend_mode(premultiplied_blend_mode());
+    }
+
+    return result;
+  }
+
+  /* Only allocates when a shape needs more space than any previous shape */
+  template <typename Value>
+  [[nodiscard]] static auto reserve_scratch(std::vector<Value>& buffer,
+                                            const usize count) noexcept -> bool
+  {
+    try {
+      buffer.reserve(count);
+      return true;
+    }
+    catch (...) {
+      return false;
+    }
+  }
+
+  template <typename Value>
+  void update_cached(maybe<Value>& cached, const Value& value, const result res) noexcept
+  {
+    if (mState.enabled && res) {
+      cached = value;
+    }
+    else {
+      cached.reset();
+    }
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+  /* Integer indices use the plain geometry API, other index types go through the raw API */
+  template <typename Index>
+  auto submit_geometry(SDL_Texture* texture,
+                       const SDL_Vertex* vertices,
+                       const usize vertexCount,
+                       const Index* indices,
+                       const usize indexCount) noexcept -> result
+  {
+    static_assert(detail::is_geometry_index_v<Index>,
+                  "Indices must be int, uint8, uint16 or uint32 values!");
+
+    mCounters.geometry(texture);
+
+    if constexpr (std::is_same_v<Index, int>) {
+      return SDL_RenderGeometry(mRenderer,
+                                texture,
+                                vertices,
+                                static_cast<int>(vertexCount),
+                                indices,
+                                static_cast<int>(indexCount)) == 0;
+    }
+    else {
+      if (!vertices) {
+        return failure;
+      }
+
+      constexpr auto stride = static_cast<int>(sizeof(SDL_Vertex));
+      return submit_raw_geometry(texture,
+                                 &vertices->position.x,
+                                 stride,
+                                 &vertices->color,
+                                 stride,
+                                 &vertices->tex_coord.x,
+                                 stride,
+                                 vertexCount,
+                                 indices,
+                                 indexCount);
+    }
+  }
+
+  template <typename Index>
+  auto submit_raw_geometry(SDL_Texture* texture,
+                           const float* xy,
+                           const int xyStride,
+                           const SDL_Color* colors,
+                           const int colorStride,
+                           const float* uv,
+                           const int uvStride,
+                           const usize vertexCount,
+                           const Index* indices,
+                           const usize indexCount) noexcept -> result
+  {
+    static_assert(detail::is_geometry_index_v<Index>,
+                  "Indices must be int, uint8, uint16 or uint32 values!");
+    return SDL_RenderGeometryRaw(mRenderer,
+                                 texture,
+                                 xy,
+                                 xyStride,
+                                 colors,
+                                 colorStride,
+                                 uv,
+                                 uvStride,
+                                 static_cast<int>(vertexCount),
+                                 indices,
+                                 static_cast<int>(indexCount),
+                                 static_cast<int>(sizeof(Index))) == 0;
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+  auto change_target(SDL_Texture* target) noexcept -> result
+  {
+    if (mState.enabled && mState.target == target) {
+      mCounters.skipped_state_change();
+      return success;
+    }
+
+    /* Changing the render target resets both the viewport and the clip */
+    mState.viewport.reset();
+    mState.clip.reset();
+
+    mCounters.target_change();
+    const result res = SDL_SetRenderTarget(get(), target) == 0;
+    update_cached(mState.target, target, res);
+    return res;
+  }
+
+  auto change_clip(const maybe<irect>& area) noexcept -> result
+  {
+    if (mState.enabled && mState.clip && *mState.clip == area) {
+      mCounters.skipped_state_change();
+      return success;
+    }
+
+    mCounters.state_change();
+    const result res = SDL_RenderSetClipRect(get(), area ? area->data() : nullptr) == 0;
+    update_cached(mState.clip, area, res);
+    return res;
+  }
 };
 
+/**
+ * Writes a textual representation of a renderer to an output iterator, without allocating.
+ *
+ * \return the output iterator past the last written character.
+ */
+template <typename OutputIt, typename T>
+auto format_to(OutputIt out, const basic_renderer<T>& renderer) -> OutputIt
+{
+  out = detail::write_text(out, "renderer(data: ");
+  out = detail::write_address(out, renderer.get());
+  return detail::write_text(out, ")");
+}
+
 template <typename T>
 [[nodiscard]] auto to_string(const basic_renderer<T>& renderer) -> std::string
 {
-#if CENTURION_HAS_FEATURE_FORMAT
-  return std::format("renderer(data: {})", detail::address_of(renderer.get()));
-#else
-  return "renderer(data: " + detail::address_of(renderer.get()) + ")";
-#endif  // CENTURION_HAS_FEATURE_FORMAT
+  std::string result;
+  format_to(std::back_inserter(result), renderer);
+  return result;
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_renderer<T>& renderer) -> std::ostream&
 {
-  return stream << to_string(renderer);
+  format_to(std::ostreambuf_iterator<char> {stream}, renderer);
+  return stream;
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
+#if CENTURION_HAS_FEATURE_FORMAT
+
+template <typename T>
+struct std::formatter<cen::basic_renderer<T>>
+    : cen::detail::value_formatter<cen::basic_renderer<T>> {};
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
 #endif  // CENTURION_VIDEO_RENDERER_HPP_
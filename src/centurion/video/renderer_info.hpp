@@ -35,7 +35,6 @@
 #include <cmath>        // floor, sqrt
 #include <cstddef>      // size_t
 #include <optional>     // optional
-#include <ostream>      // ostream
 #include <string>       // string, to_string
 #include <string>       // string, string_literals
 #include <string_view>  // string_view
@@ -58,6 +57,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 [[nodiscard]] inline auto render_driver_count() noexcept -> int
@@ -160,11 +165,15 @@ template <typename T>
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const renderer_info& info) -> std::ostream&
 {
   return stream << to_string(info);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_VIDEO_RENDERER_INFO_HPP_
@@ -0,0 +1,467 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_RENDERER_SELECTOR_HPP_
+#define CENTURION_VIDEO_RENDERER_SELECTOR_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>  // find_if, stable_sort
+#include <string>     // string
+#include <utility>    // move, pair
+#include <vector>     // vector
+
+#include "../common/errors.hpp"
+#include "../common/memory.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../io/file.hpp"
+#include "../io/save_writer.hpp"
+#include "../system/timer.hpp"
+#include "renderer.hpp"
+#include "window.hpp"
+
+namespace cen {
+
+/// The result of benchmarking a render driver.
+struct render_driver_score final {
+  int index {-1};                ///< The index of the render driver.
+  std::string name;              ///< The name of the render driver.
+  millis<double> frame_time {};  ///< The average time of a benchmark frame.
+  bool succeeded {};             ///< Indicates whether the benchmark could be run.
+};
+
+/// Configuration of a `renderer_selector`.
+struct renderer_selector_cfg final {
+  std::string cache_path;  ///< The file of cached selections, empty to disable caching.
+  uint32 flags {renderer::default_flags()};  ///< The flags of the created renderer.
+  int frames {16};                           ///< The amount of measured frames per driver.
+  int sprites {2'000};                       ///< The amount of sprites drawn per frame.
+  int triangles {2'000};                     ///< The amount of triangles drawn per frame.
+  int glyphs {4'000};                        ///< The amount of glyph quads drawn per frame.
+  bool allow_software {};  ///< Indicates whether the software driver may be selected.
+};
+
+/**
+ * Selects the fastest render driver on the current system, by benchmarking all of them.
+ *
+ * SDL selects a render driver using its own heuristics, which doesn't necessarily pick the
+ * fastest driver on a given system. The selector instead draws a short offscreen workload
+ * with every available render driver, made of sprites, untextured geometry and small glyph
+ * quads with the same layout as rendered text, and creates the renderer with the winner.
+ * Every frame renders into a target texture and is finished by reading back a pixel, so the
+ * measured time includes the work of the GPU.
+ *
+ * The selected driver is cached on disk, keyed by the video driver, the display and the
+ * available render drivers, so the benchmark only runs again when the system changes.
+ *
+ * \code{cpp}
+ * cen::renderer_selector_cfg cfg;
+ * cfg.cache_path = cen::preferred_path("org", "game").copy() + "renderer.cache";
+ *
+ * cen::renderer_selector selector {std::move(cfg)};
+ * auto renderer = selector.make_renderer(window);
+ * \endcode
+ *
+ * \details SDL might recreate the window when a renderer that uses another graphics API is
+ *          created for it, so the selector should be used before the window is shown. The
+ *          benchmark takes a fraction of a second per driver.
+ */
+class renderer_selector final {
+ public:
+  explicit renderer_selector(renderer_selector_cfg cfg = {}) : mCfg {std::move(cfg)} {}
+
+  /**
+   * Creates a renderer for a window, using the cached or fastest render driver.
+   *
+   * \details The render drivers are benchmarked if there is no valid cached selection. If no
+   *          driver could be benchmarked, SDL selects the driver.
+   *
+   * \param window the window that the renderer will be associated with.
+   *
+   * \return the created renderer.
+   *
+   * \throws sdl_error if the renderer cannot be created.
+   */
+  [[nodiscard]] auto make_renderer(window& window) -> renderer
+  {
+    const auto key = cache_key(window);
+    mUsedCache = false;
+
+    if (const auto index = find_driver(load_cached(key)); index != -1) {
+      if (auto* ptr = SDL_CreateRenderer(window.get(), index, mCfg.flags)) {
+        mUsedCache = true;
+        return renderer {ptr};
+      }
+    }
+
+    const auto& scores = benchmark(window);
+    const auto best = std::find_if(scores.begin(), scores.end(), [](const auto& score) {
+      return score.succeeded;
+    });
+
+    if (best != scores.end()) {
+      if (auto* ptr = SDL_CreateRenderer(window.get(), best->index, mCfg.flags)) {
+        store_cached(key, best->name);
+        return renderer {ptr};
+      }
+    }
+
+    return window.make_renderer(mCfg.flags);
+  }
+
+  /**
+   * Benchmarks all available render drivers.
+   *
+   * \param window the window that the benchmark renderers will be associated with.
+   *
+   * \return the scores of all drivers, ordered from fastest to slowest, with the drivers that
+   *         couldn't be benchmarked last.
+   */
+  auto benchmark(window& window) -> const std::vector<render_driver_score>&
+  {
+    mScores.clear();
+
+    const auto count = SDL_GetNumRenderDrivers();
+    for (int index = 0; index < count; ++index) {
+      SDL_RendererInfo info {};
+      if (SDL_GetRenderDriverInfo(index, &info) != 0) {
+        continue;
+      }
+
+      if ((info.flags & SDL_RENDERER_SOFTWARE) && !mCfg.allow_software) {
+        continue;
+      }
+
+      auto& score = mScores.emplace_back();
+      score.index = index;
+      score.name = info.name;
+      run(window, score);
+    }
+
+    std::stable_sort(mScores.begin(), mScores.end(), [](const auto& a, const auto& b) {
+      if (a.succeeded != b.succeeded) {
+        return a.succeeded;
+      }
+      else {
+        return a.frame_time < b.frame_time;
+      }
+    });
+
+    return mScores;
+  }
+
+  /// Returns the key that identifies the current system in the cache file.
+  [[nodiscard]] static auto cache_key(const window& window) -> std::string
+  {
+    std::string key = str_or_na(SDL_GetCurrentVideoDriver());
+
+    key += '|';
+    key += str_or_na(SDL_GetDisplayName(SDL_GetWindowDisplayIndex(window.get())));
+
+    const auto count = SDL_GetNumRenderDrivers();
+    for (int index = 0; index < count; ++index) {
+      SDL_RendererInfo info {};
+      if (SDL_GetRenderDriverInfo(index, &info) == 0) {
+        key += '|';
+        key += info.name;
+      }
+    }
+
+    return key;
+  }
+
+  /// Returns the scores of the latest benchmark.
+  [[nodiscard]] auto scores() const noexcept -> const std::vector<render_driver_score>&
+  {
+    return mScores;
+  }
+
+  /// Indicates whether the latest created renderer used the cached selection.
+  [[nodiscard]] auto used_cache() const noexcept -> bool { return mUsedCache; }
+
+  [[nodiscard]] auto config() const noexcept -> const renderer_selector_cfg& { return mCfg; }
+
+ private:
+  inline constexpr static int target_size = 512;
+  inline constexpr static int sprite_size = 32;
+  inline constexpr static int glyph_width = 8;
+  inline constexpr static int glyph_height = 16;
+  inline constexpr static int atlas_size = 128;  ///< Holds 16x8 glyphs.
+
+  renderer_selector_cfg mCfg;
+  std::vector<render_driver_score> mScores;
+  bool mUsedCache {};
+
+  /* Runs the benchmark with a single driver, using raw SDL calls to keep the overhead low */
+  void run(window& window, render_driver_score& score) const
+  {
+    const auto flags = (mCfg.flags & ~SDL_RENDERER_PRESENTVSYNC) | SDL_RENDERER_TARGETTEXTURE;
+
+    managed_ptr<SDL_Renderer> renderer {SDL_CreateRenderer(window.get(), score.index, flags)};
+    if (!renderer) {
+      return;
+    }
+
+    auto* ptr = renderer.get();
+    managed_ptr<SDL_Texture> target {SDL_CreateTexture(ptr,
+                                                       SDL_PIXELFORMAT_RGBA8888,
+                                                       SDL_TEXTUREACCESS_TARGET,
+                                                       target_size,
+                                                       target_size)};
+    managed_ptr<SDL_Texture> sprite {make_pattern(ptr, sprite_size, sprite_size)};
+    managed_ptr<SDL_Texture> atlas {make_pattern(ptr, atlas_size, atlas_size)};
+
+    if (!target || !sprite || !atlas) {
+      return;
+    }
+
+    SDL_SetTextureBlendMode(sprite.get(), SDL_BLENDMODE_BLEND);
+    SDL_SetTextureBlendMode(atlas.get(), SDL_BLENDMODE_BLEND);
+
+    std::vector<SDL_Vertex> vertices;
+    uint32 seed = 0x2545'F491u;
+
+    /* The first frame is a warm-up, which hides shader compilation and texture uploads */
+    stopwatch watch {false};
+    for (int frame = 0; frame <= mCfg.frames; ++frame) {
+      if (frame == 1) {
+        watch.start();
+      }
+
+      if (!draw(ptr, target.get(), sprite.get(), atlas.get(), vertices, seed)) {
+        return;
+      }
+    }
+
+    watch.stop();
+    SDL_SetRenderTarget(ptr, nullptr);
+
+    score.frame_time = watch.elapsed<millis<double>>() / (detail::max)(mCfg.frames, 1);
+    score.succeeded = true;
+  }
+
+  [[nodiscard]] auto draw(SDL_Renderer* renderer,
+                          SDL_Texture* target,
+                          SDL_Texture* sprite,
+                          SDL_Texture* atlas,
+                          std::vector<SDL_Vertex>& vertices,
+                          uint32& seed) const -> bool
+  {
+    const auto next = [&seed]() noexcept {
+      seed = seed * 1'664'525u + 1'013'904'223u;
+      return static_cast<int>(seed >> 8u);
+    };
+
+    if (SDL_SetRenderTarget(renderer, target) != 0) {
+      return false;
+    }
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0xFF);
+    SDL_RenderClear(renderer);
+
+    for (int index = 0; index < mCfg.sprites; ++index) {
+      const auto x = next() % target_size;
+      const auto y = next() % target_size;
+      const SDL_Rect dst {x, y, sprite_size, sprite_size};
+      SDL_RenderCopy(renderer, sprite, nullptr, &dst);
+    }
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+    vertices.resize(static_cast<usize>(mCfg.triangles) * 3u);
+    for (auto& vertex : vertices) {
+      vertex.position.x = static_cast<float>(next() % target_size);
+      vertex.position.y = static_cast<float>(next() % target_size);
+      vertex.color = {static_cast<uint8>(next()), static_cast<uint8>(next()), 0xFF, 0x80};
+    }
+
+    SDL_RenderGeometry(renderer,
+                       nullptr,
+                       vertices.data(),
+                       static_cast<int>(vertices.size()),
+                       nullptr,
+                       0);
+
+#else
+
+    /* Geometry rendering isn't available, so the triangles are approximated with rectangles */
+    for (int index = 0; index < mCfg.triangles; ++index) {
+      const SDL_Rect rect {next() % target_size, next() % target_size, 16, 16};
+      SDL_RenderFillRect(renderer, &rect);
+    }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+    /* Glyphs are laid out in lines of text, with source rectangles from the atlas */
+    constexpr int columns = atlas_size / glyph_width;
+    constexpr int line_length = target_size / glyph_width;
+    for (int index = 0; index < mCfg.glyphs; ++index) {
+      const auto glyph = next() % (columns * (atlas_size / glyph_height));
+      const SDL_Rect src {(glyph % columns) * glyph_width,
+                          (glyph / columns) * glyph_height,
+                          glyph_width,
+                          glyph_height};
+      const SDL_Rect dst {(index % line_length) * glyph_width,
+                          ((index / line_length) * glyph_height) % target_size,
+                          glyph_width,
+                          glyph_height};
+      SDL_RenderCopy(renderer, atlas, &src, &dst);
+    }
+
+    /* Reading back a pixel waits for the GPU to finish the frame */
+    const SDL_Rect pixel {0, 0, 1, 1};
+    uint32 value {};
+    return SDL_RenderReadPixels(renderer, &pixel, SDL_PIXELFORMAT_RGBA8888, &value, 4) == 0;
+  }
+
+  /* Creates a static texture with a checkerboard pattern with transparent cells */
+  [[nodiscard]] static auto make_pattern(SDL_Renderer* renderer,
+                                         const int width,
+                                         const int height) -> SDL_Texture*
+  {
+    auto* texture = SDL_CreateTexture(renderer,
+                                      SDL_PIXELFORMAT_RGBA8888,
+                                      SDL_TEXTUREACCESS_STATIC,
+                                      width,
+                                      height);
+    if (!texture) {
+      return nullptr;
+    }
+
+    std::vector<uint32> pixels(static_cast<usize>(width) * static_cast<usize>(height));
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        const auto opaque = ((x / 4) + (y / 4)) % 2 == 0;
+        pixels[static_cast<usize>(y * width + x)] = opaque ? 0xFFFF'FFFFu : 0x0000'0000u;
+      }
+    }
+
+    SDL_UpdateTexture(texture, nullptr, pixels.data(), width * 4);
+    return texture;
+  }
+
+  [[nodiscard]] static auto find_driver(const std::string& name) -> int
+  {
+    if (name.empty()) {
+      return -1;
+    }
+
+    const auto count = SDL_GetNumRenderDrivers();
+    for (int index = 0; index < count; ++index) {
+      SDL_RendererInfo info {};
+      if (SDL_GetRenderDriverInfo(index, &info) == 0 && name == info.name) {
+        return index;
+      }
+    }
+
+    return -1;
+  }
+
+  /* The cache file stores one "key\tdriver" line per known system */
+  [[nodiscard]] auto read_cache() const -> std::vector<std::pair<std::string, std::string>>
+  {
+    std::vector<std::pair<std::string, std::string>> entries;
+    if (mCfg.cache_path.empty()) {
+      return entries;
+    }
+
+    file source {mCfg.cache_path, file_mode::rb};
+    const auto size = source ? source.size() : nothing;
+    if (!size || *size == 0) {
+      return entries;
+    }
+
+    std::string contents(*size, '\0');
+    contents.resize(source.read_to(contents.data(), contents.size()));
+
+    usize begin = 0;
+    while (begin < contents.size()) {
+      auto end = contents.find('\n', begin);
+      if (end == std::string::npos) {
+        end = contents.size();
+      }
+
+      const auto line = contents.substr(begin, end - begin);
+      const auto tab = line.rfind('\t');
+      if (tab != std::string::npos) {
+        entries.emplace_back(line.substr(0, tab), line.substr(tab + 1));
+      }
+
+      begin = end + 1;
+    }
+
+    return entries;
+  }
+
+  [[nodiscard]] auto load_cached(const std::string& key) const -> std::string
+  {
+    for (auto& [entryKey, driver] : read_cache()) {
+      if (entryKey == key) {
+        return driver;
+      }
+    }
+
+    return {};
+  }
+
+  void store_cached(const std::string& key, const std::string& driver) const
+  {
+    if (mCfg.cache_path.empty()) {
+      return;
+    }
+
+    auto entries = read_cache();
+    const auto iter = std::find_if(entries.begin(), entries.end(), [&](const auto& entry) {
+      return entry.first == key;
+    });
+
+    if (iter != entries.end()) {
+      iter->second = driver;
+    }
+    else {
+      entries.emplace_back(key, driver);
+    }
+
+    std::string contents;
+    for (const auto& [entryKey, entryDriver] : entries) {
+      contents += entryKey;
+      contents += '\t';
+      contents += entryDriver;
+      contents += '\n';
+    }
+
+    /* A failure to write the cache only means that the benchmark runs again */
+    [[maybe_unused]] const auto written =
+        detail::replace_file(mCfg.cache_path,
+                             reinterpret_cast<const uint8*>(contents.data()),
+                             contents.size());
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RENDERER_SELECTOR_HPP_
@@ -0,0 +1,219 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_RESIZE_COORDINATOR_HPP_
+#define CENTURION_VIDEO_RESIZE_COORDINATOR_HPP_
+
+#include <SDL.h>
+
+#include <functional>  // function
+#include <utility>     // move
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../events/event_base.hpp"
+#include "renderer.hpp"
+#include "window.hpp"
+
+namespace cen {
+
+/**
+ * Coalesces window size changes during interactive resizing.
+ *
+ * Interactive resizing results in a storm of size changed events, and reallocating render
+ * targets and atlases for every one of them makes resizing stutter. The coordinator tracks
+ * the live size of the window as events arrive, but only commits a new size once no size
+ * events have been received for the debounce delay, at which point the commit callback is
+ * invoked exactly once with the final size.
+ *
+ * In between, content should be rendered at the committed size and scaled to the live size,
+ * see `scale()`, which is cheap since it doesn't involve any reallocations.
+ *
+ * Some platforms block the main loop while a window is being resized. To keep rendering in
+ * that case, forward events to the coordinator from an `event_watch`, and render from the
+ * live resize callback, which is invoked for every size change.
+ *
+ * Sizes are expressed in window coordinates, like the data of size changed events.
+ *
+ * \see event_watch
+ */
+class resize_coordinator final {
+ public:
+  using size_callback = std::function<void(const iarea&)>;
+
+  inline constexpr static u32ms default_delay {150};
+
+  explicit resize_coordinator(const iarea size, const u32ms delay = default_delay)
+      : mLive {size}
+      , mCommitted {size}
+      , mDelay {delay}
+  {
+  }
+
+  template <typename T>
+  explicit resize_coordinator(const basic_window<T>& window,
+                              const u32ms delay = default_delay)
+      : resize_coordinator {window.size(), delay}
+  {
+  }
+
+  /// Sets the function invoked once with the final size when a resize is committed.
+  void on_commit(size_callback callback) { mOnCommit = std::move(callback); }
+
+  /// Sets the function invoked with the live size for every received size change.
+  void on_live_resize(size_callback callback) { mOnLiveResize = std::move(callback); }
+
+  /**
+   * Updates the coordinator using a window event.
+   *
+   * \param event the event that will be processed, only size changed events are considered.
+   *
+   * \return `true` if the live size changed; `false` otherwise.
+   */
+  auto update(const event_base<SDL_WindowEvent>& event) -> bool
+  {
+    const auto& data = event.get();
+    if (data.event != SDL_WINDOWEVENT_SIZE_CHANGED) {
+      return false;
+    }
+
+    const iarea size {data.data1, data.data2};
+    if (size == mLive) {
+      return false;
+    }
+
+    if (mPending) {
+      ++mCoalesced;
+    }
+
+    mLive = size;
+    mLastEvent = event.timestamp();
+    mPending = mLive != mCommitted;
+
+    if (mOnLiveResize) {
+      mOnLiveResize(mLive);
+    }
+
+    return true;
+  }
+
+  /**
+   * Commits the live size if the debounce delay has passed since the last size change.
+   *
+   * \details This should be called once per frame, before any render targets are used.
+   *
+   * \param now the current time, in the same time base as event timestamps.
+   *
+   * \return `true` if a new size was committed; `false` otherwise.
+   */
+  auto poll(const u32ms now) -> bool
+  {
+    if (mPending && now - mLastEvent >= mDelay) {
+      return flush();
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Commits the live size if the debounce delay has passed, using the current time.
+  auto poll() -> bool { return poll(u32ms {SDL_GetTicks()}); }
+
+  /**
+   * Immediately commits the live size, if there is a pending resize.
+   *
+   * \details This is useful when the end of a resize is known, e.g. when a window is
+   * maximized, or when the mouse button that started the drag is released.
+   *
+   * \return `true` if a new size was committed; `false` otherwise.
+   */
+  auto flush() -> bool
+  {
+    if (!mPending) {
+      return false;
+    }
+
+    mPending = false;
+    mCommitted = mLive;
+    ++mCommits;
+
+    if (mOnCommit) {
+      mOnCommit(mCommitted);
+    }
+
+    return true;
+  }
+
+  /// Sets the delay without size changes after which a resize is committed.
+  void set_delay(const u32ms delay) noexcept { mDelay = delay; }
+
+  /**
+   * Returns the scale that maps content rendered at the committed size onto the live size.
+   *
+   * \details The returned scale can be passed to `basic_renderer::set_scale()`.
+   */
+  [[nodiscard]] auto scale() const noexcept -> renderer_scale
+  {
+    if (mCommitted.width > 0 && mCommitted.height > 0) {
+      return {static_cast<float>(mLive.width) / static_cast<float>(mCommitted.width),
+              static_cast<float>(mLive.height) / static_cast<float>(mCommitted.height)};
+    }
+    else {
+      return {1, 1};
+    }
+  }
+
+  /// Indicates whether there is a resize that hasn't been committed yet.
+  [[nodiscard]] auto is_resizing() const noexcept -> bool { return mPending; }
+
+  /// Returns the most recently reported window size.
+  [[nodiscard]] auto live_size() const noexcept -> iarea { return mLive; }
+
+  /// Returns the size that render targets should currently be allocated for.
+  [[nodiscard]] auto committed_size() const noexcept -> iarea { return mCommitted; }
+
+  [[nodiscard]] auto delay() const noexcept -> u32ms { return mDelay; }
+
+  /// Returns the number of committed resizes.
+  [[nodiscard]] auto commits() const noexcept -> uint64 { return mCommits; }
+
+  /// Returns the number of size changes that were merged into later commits.
+  [[nodiscard]] auto coalesced() const noexcept -> uint64 { return mCoalesced; }
+
+ private:
+  iarea mLive;
+  iarea mCommitted;
+  u32ms mDelay;
+  u32ms mLastEvent {};
+  bool mPending {};
+  uint64 mCommits {};
+  uint64 mCoalesced {};
+  size_callback mOnCommit;
+  size_callback mOnLiveResize;
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RESIZE_COORDINATOR_HPP_
@@ -0,0 +1,780 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_RESOURCE_POOL_HPP_
+#define CENTURION_VIDEO_RESOURCE_POOL_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>  // find
+#include <cassert>    // assert
+#include <cstddef>    // ptrdiff_t
+#include <map>        // map
+#include <tuple>      // tie
+#include <utility>    // move, exchange
+#include <vector>     // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/cache_manager.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+#include "texture.hpp"
+#include "texture_memory.hpp"
+
+namespace cen {
+
+namespace detail {
+
+/* Stores idle resources grouped by a key, with an upper limit on idle resources per key. The
+   resources are stamped when they are stored, so that the oldest ones can be evicted. */
+template <typename Key, typename Resource>
+class pool_storage final {
+ public:
+  explicit pool_storage(const usize maxIdle) noexcept : mMaxIdle {maxIdle} {}
+
+  [[nodiscard]] auto take(const Key& key) -> maybe<Resource>
+  {
+    if (const auto iter = mIdle.find(key); iter != mIdle.end() && !iter->second.empty()) {
+      auto& idle = iter->second.back();
+      maybe<Resource> resource {std::move(idle.resource)};
+      mBytes -= idle.bytes;
+      iter->second.pop_back();
+
+      --mIdleCount;
+      ++mHits;
+
+      return resource;
+    }
+    else {
+      ++mMisses;
+      return nothing;
+    }
+  }
+
+  /* Resources that don't fit in the pool, or can't be stored, are simply destroyed */
+  void give(const Key& key, Resource&& resource, const usize bytes = 0) noexcept
+  {
+    try {
+      auto& bucket = mIdle[key];
+      if (bucket.size() < mMaxIdle) {
+        bucket.push_back(idle_resource {std::move(resource), cache_manager::tick(), bytes});
+        ++mIdleCount;
+        mBytes += bytes;
+      }
+    }
+    catch (...) {
+    }
+  }
+
+  void clear() noexcept
+  {
+    mIdle.clear();
+    mIdleCount = 0;
+    mBytes = 0;
+  }
+
+  void set_max_idle(const usize maxIdle)
+  {
+    mMaxIdle = maxIdle;
+
+    for (auto& [key, bucket] : mIdle) {
+      while (bucket.size() > maxIdle) {
+        mBytes -= bucket.back().bytes;
+        bucket.pop_back();
+        --mIdleCount;
+      }
+    }
+  }
+
+  /* The oldest resource of each key is at the front of its bucket */
+  [[nodiscard]] auto oldest_use() const noexcept -> maybe<uint64>
+  {
+    maybe<uint64> oldest;
+
+    for (const auto& [key, bucket] : mIdle) {
+      if (!bucket.empty() && (!oldest || bucket.front().stamp < *oldest)) {
+        oldest = bucket.front().stamp;
+      }
+    }
+
+    return oldest;
+  }
+
+  auto evict_oldest() -> bool
+  {
+    auto victim = mIdle.end();
+
+    for (auto iter = mIdle.begin(); iter != mIdle.end(); ++iter) {
+      auto& bucket = iter->second;
+      if (!bucket.empty() &&
+          (victim == mIdle.end() || bucket.front().stamp < victim->second.front().stamp)) {
+        victim = iter;
+      }
+    }
+
+    if (victim != mIdle.end()) {
+      auto& bucket = victim->second;
+      mBytes -= bucket.front().bytes;
+      bucket.erase(bucket.begin());
+      --mIdleCount;
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  [[nodiscard]] auto max_idle() const noexcept -> usize { return mMaxIdle; }
+  [[nodiscard]] auto idle_count() const noexcept -> usize { return mIdleCount; }
+  [[nodiscard]] auto memory_usage() const noexcept -> usize { return mBytes; }
+  [[nodiscard]] auto hits() const noexcept -> uint64 { return mHits; }
+  [[nodiscard]] auto misses() const noexcept -> uint64 { return mMisses; }
+
+ private:
+  struct idle_resource final {
+    Resource resource;
+    uint64 stamp {};
+    usize bytes {};
+  };
+
+  std::map<Key, std::vector<idle_resource>> mIdle;
+  usize mMaxIdle {};
+  usize mIdleCount {};
+  usize mBytes {};
+  uint64 mHits {};
+  uint64 mMisses {};
+};
+
+}  // namespace detail
+
+/**
+ * A resource obtained from a `texture_pool` or `surface_pool`.
+ *
+ * The resource is returned to its pool when the pooled object is destroyed, so the pool must
+ * outlive all of its pooled objects. Use `release()` to keep the resource.
+ *
+ * \tparam Pool the type of the pool that the resource belongs to.
+ */
+template <typename Pool>
+class pooled final {
+ public:
+  using resource_type = typename Pool::resource_type;
+
+  pooled(resource_type resource, Pool& pool) noexcept
+      : mResource {std::move(resource)}
+      , mPool {&pool}
+  {
+  }
+
+  pooled(const pooled&) = delete;
+
+  pooled(pooled&& other) noexcept
+      : mResource {std::move(other.mResource)}
+      , mPool {std::exchange(other.mPool, nullptr)}
+  {
+  }
+
+  auto operator=(const pooled&) -> pooled& = delete;
+
+  auto operator=(pooled&& other) noexcept -> pooled&
+  {
+    if (this != &other) {
+      recycle();
+      mResource = std::move(other.mResource);
+      mPool = std::exchange(other.mPool, nullptr);
+    }
+
+    return *this;
+  }
+
+  ~pooled() noexcept { recycle(); }
+
+  /**
+   * Detaches the resource from its pool.
+   *
+   * \return the resource, which will not be returned to the pool.
+   */
+  [[nodiscard]] auto release() noexcept -> resource_type
+  {
+    assert(mPool);
+    mPool = nullptr;
+    return std::move(mResource);
+  }
+
+  [[nodiscard]] auto get() noexcept -> resource_type& { return mResource; }
+  [[nodiscard]] auto get() const noexcept -> const resource_type& { return mResource; }
+
+  [[nodiscard]] auto operator*() noexcept -> resource_type& { return mResource; }
+  [[nodiscard]] auto operator*() const noexcept -> const resource_type& { return mResource; }
+
+  [[nodiscard]] auto operator->() noexcept -> resource_type* { return &mResource; }
+  [[nodiscard]] auto operator->() const noexcept -> const resource_type* { return &mResource; }
+
+  /// Indicates whether the resource will be returned to a pool.
+  [[nodiscard]] auto is_pooled() const noexcept -> bool { return mPool != nullptr; }
+
+ private:
+  resource_type mResource;
+  Pool* mPool {};
+
+  void recycle() noexcept
+  {
+    if (mPool) {
+      mPool->recycle(std::move(mResource));
+      mPool = nullptr;
+    }
+  }
+};
+
+/**
+ * Recycles textures with the same size, pixel format and access.
+ *
+ * Creating textures is expensive for most render drivers, so frequently recreated textures,
+ * e.g. dynamic text labels, should be acquired from a pool instead. Recycled textures keep
+ * their previous pixel data, but their alpha, color, and blend modes are reset.
+ *
+ * The pool doesn't own the associated renderer, which must outlive the pool.
+ *
+ * \see surface_pool
+ * \see pooled
+ */
+class texture_pool final {
+ public:
+  using resource_type = texture;
+
+  /**
+   * Creates a texture pool.
+   *
+   * \param renderer the renderer used to create textures.
+   * \param maxIdle the maximum amount of idle textures for each combination of size, format
+   *        and access.
+   */
+  template <typename T>
+  explicit texture_pool(const basic_renderer<T>& renderer, const usize maxIdle = 4)
+      : mRenderer {renderer.get()}
+      , mStorage {maxIdle}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(texture_pool)
+  CENTURION_DISABLE_MOVE(texture_pool)
+
+  /**
+   * Returns a texture, which is recycled if possible.
+   *
+   * \param size the size of the texture.
+   * \param format the pixel format of the texture.
+   * \param access the access of the texture.
+   *
+   * \return a texture that is returned to the pool when destroyed.
+   *
+   * \throws sdl_error if a new texture cannot be created.
+   */
+  [[nodiscard]] auto acquire(const iarea& size,
+                             const pixel_format format,
+                             const texture_access access) -> pooled<texture_pool>
+  {
+    if (auto recycled = mStorage.take({size.width, size.height, format, access})) {
+      return {std::move(*recycled), *this};
+    }
+    else {
+      return {mRenderer.make_texture(size, format, access), *this};
+    }
+  }
+
+  /**
+   * Returns a streaming texture with the contents of a surface.
+   *
+   * This is a pooled alternative to `renderer::make_texture()`, and the texture uses blending
+   * if the surface has an alpha channel.
+   *
+   * \param surface the surface that will be uploaded.
+   *
+   * \return a texture that is returned to the pool when destroyed.
+   *
+   * \throws sdl_error if the texture cannot be created or updated.
+   */
+  template <typename T>
+  [[nodiscard]] auto upload(basic_surface<T>& surface) -> pooled<texture_pool>
+  {
+    const auto format = surface.format_info().format();
+    auto result = acquire(surface.size(), format, texture_access::streaming);
+
+    if (!surface.lock()) {
+      throw sdl_error {};
+    }
+
+    const auto updated = result->update(surface.pixel_data(), surface.pitch());
+    surface.unlock();
+
+    if (!updated) {
+      throw sdl_error {};
+    }
+
+    if (SDL_ISPIXELFORMAT_ALPHA(to_underlying(format))) {
+      result->set_blend_mode(blend_mode::blend);
+    }
+
+    return result;
+  }
+
+  /// Returns a texture to the pool, this is usually done automatically by `pooled`.
+  void recycle(texture&& texture) noexcept
+  {
+    if (!texture.get()) {
+      return;
+    }
+
+    texture.set_alpha_mod(0xFF);
+    texture.set_color_mod(colors::white);
+    texture.set_blend_mode(blend_mode::none);
+
+    const auto size = texture.size();
+    const auto bytes = estimate_texture_bytes(texture);
+    mStorage.give({size.width, size.height, texture.format(), texture.access()},
+                  std::move(texture),
+                  bytes);
+  }
+
+  /// Destroys all idle textures.
+  void clear() noexcept { mStorage.clear(); }
+
+  /// Sets the maximum amount of idle textures per key, destroying any excess textures.
+  void set_max_idle(const usize maxIdle) { mStorage.set_max_idle(maxIdle); }
+
+  [[nodiscard]] auto max_idle() const noexcept -> usize { return mStorage.max_idle(); }
+
+  /// Returns the total amount of idle textures.
+  [[nodiscard]] auto idle_count() const noexcept -> usize { return mStorage.idle_count(); }
+
+  /// Returns the amount of acquisitions that recycled a texture.
+  [[nodiscard]] auto hits() const noexcept -> uint64 { return mStorage.hits(); }
+
+  /// Returns the amount of acquisitions that created a new texture.
+  [[nodiscard]] auto misses() const noexcept -> uint64 { return mStorage.misses(); }
+
+  /// Returns the estimated memory used by idle textures, in bytes.
+  [[nodiscard]] auto memory_usage() const noexcept -> usize { return mStorage.memory_usage(); }
+
+  /// Returns the usage stamp of the oldest idle texture, see `cache_manager`.
+  [[nodiscard]] auto oldest_use() const noexcept -> maybe<uint64>
+  {
+    return mStorage.oldest_use();
+  }
+
+  /// Destroys the oldest idle texture, returning `false` if there are no idle textures.
+  auto evict_oldest() -> bool { return mStorage.evict_oldest(); }
+
+ private:
+  struct key final {
+    int width {};
+    int height {};
+    pixel_format format {};
+    texture_access access {};
+
+    [[nodiscard]] auto operator<(const key& other) const noexcept -> bool
+    {
+      return std::tie(width, height, format, access) <
+             std::tie(other.width, other.height, other.format, other.access);
+    }
+  };
+
+  renderer_handle mRenderer;
+  detail::pool_storage<key, texture> mStorage;
+};
+
+/**
+ * Recycles render target textures for multi-pass effects, e.g. blur or bloom chains.
+ *
+ * Targets are usually sized relative to the renderer output, so the pool tracks the output
+ * size. When the output size changes, all idle targets are destroyed, and targets that were
+ * acquired before the change are destroyed instead of recycled once they are returned.
+ * Recycled targets keep their previous pixel data, but their alpha, color, and blend modes
+ * are reset.
+ *
+ * The pool doesn't own the associated renderer, which must outlive the pool.
+ *
+ * \see scoped_target
+ * \see texture_pool
+ */
+class render_target_pool final {
+ public:
+  using resource_type = texture;
+
+  /**
+   * Creates a render target pool.
+   *
+   * \param renderer the renderer used to create the targets.
+   * \param format the default pixel format of the targets.
+   * \param maxIdle the maximum amount of idle targets for each combination of size and format.
+   */
+  template <typename T>
+  explicit render_target_pool(const basic_renderer<T>& renderer,
+                              const pixel_format format = pixel_format::rgba8888,
+                              const usize maxIdle = 2)
+      : mRenderer {renderer.get()}
+      , mOutputSize {renderer.output_size()}
+      , mFormat {format}
+      , mStorage {maxIdle}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(render_target_pool)
+  CENTURION_DISABLE_MOVE(render_target_pool)
+
+  /**
+   * Returns a render target, which is recycled if possible.
+   *
+   * \param size the size of the target.
+   * \param format the pixel format of the target.
+   *
+   * \return a target texture that is returned to the pool when destroyed.
+   *
+   * \throws sdl_error if a new target cannot be created.
+   */
+  [[nodiscard]] auto acquire(const iarea& size, const pixel_format format)
+      -> pooled<render_target_pool>
+  {
+    const key id {size.width, size.height, format};
+    if (auto recycled = mStorage.take(id)) {
+      return {std::move(*recycled), *this};
+    }
+    else {
+      if (std::find(mKeys.begin(), mKeys.end(), id) == mKeys.end()) {
+        mKeys.push_back(id);
+      }
+
+      return {mRenderer.make_texture(size, format, texture_access::target), *this};
+    }
+  }
+
+  /**
+   * Returns a render target with a size relative to the output, using the default format.
+   *
+   * \param divisor the value that the output width and height are divided by, e.g. 2 for a
+   *        half-resolution target. Values less than 1 are treated as 1.
+   *
+   * \return a target texture that is returned to the pool when destroyed.
+   *
+   * \throws sdl_error if a new target cannot be created.
+   */
+  [[nodiscard]] auto acquire(const int divisor = 1) -> pooled<render_target_pool>
+  {
+    const auto d = (detail::max)(divisor, 1);
+    const iarea size {(detail::max)(mOutputSize.width / d, 1),
+                      (detail::max)(mOutputSize.height / d, 1)};
+    return acquire(size, mFormat);
+  }
+
+  /**
+   * Updates the tracked output size, which should be done when the window is resized.
+   *
+   * \param size the new output size.
+   *
+   * \return `true` if the size changed, in which case all idle targets were destroyed.
+   */
+  auto set_output_size(const iarea& size) noexcept -> bool
+  {
+    if (size != mOutputSize) {
+      mOutputSize = size;
+      mStorage.clear();
+      mKeys.clear();
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Updates the tracked output size from the renderer.
+   *
+   * \return `true` if the size changed, in which case all idle targets were destroyed.
+   *
+   * \see set_output_size()
+   */
+  auto sync() noexcept -> bool { return set_output_size(mRenderer.output_size()); }
+
+  /// Returns a target to the pool, this is usually done automatically by `pooled`.
+  void recycle(texture&& texture) noexcept
+  {
+    if (!texture.get()) {
+      return;
+    }
+
+    const auto size = texture.size();
+    const key id {size.width, size.height, texture.format()};
+
+    /* Targets created before the output was resized are simply destroyed */
+    if (std::find(mKeys.begin(), mKeys.end(), id) == mKeys.end()) {
+      return;
+    }
+
+    texture.set_alpha_mod(0xFF);
+    texture.set_color_mod(colors::white);
+    texture.set_blend_mode(blend_mode::none);
+
+    const auto bytes = estimate_texture_bytes(texture);
+    mStorage.give(id, std::move(texture), bytes);
+  }
+
+  /// Destroys all idle targets.
+  void clear() noexcept { mStorage.clear(); }
+
+  /// Sets the maximum amount of idle targets per key, destroying any excess targets.
+  void set_max_idle(const usize maxIdle) { mStorage.set_max_idle(maxIdle); }
+
+  [[nodiscard]] auto max_idle() const noexcept -> usize { return mStorage.max_idle(); }
+
+  [[nodiscard]] auto output_size() const noexcept -> iarea { return mOutputSize; }
+
+  [[nodiscard]] auto format() const noexcept -> pixel_format { return mFormat; }
+
+  /// Returns the total amount of idle targets.
+  [[nodiscard]] auto idle_count() const noexcept -> usize { return mStorage.idle_count(); }
+
+  /// Returns the amount of acquisitions that recycled a target.
+  [[nodiscard]] auto hits() const noexcept -> uint64 { return mStorage.hits(); }
+
+  /// Returns the amount of acquisitions that created a new target.
+  [[nodiscard]] auto misses() const noexcept -> uint64 { return mStorage.misses(); }
+
+  /// Returns the estimated memory used by idle targets, in bytes.
+  [[nodiscard]] auto memory_usage() const noexcept -> usize { return mStorage.memory_usage(); }
+
+  /// Returns the usage stamp of the oldest idle target, see `cache_manager`.
+  [[nodiscard]] auto oldest_use() const noexcept -> maybe<uint64>
+  {
+    return mStorage.oldest_use();
+  }
+
+  /// Destroys the oldest idle target, returning `false` if there are no idle targets.
+  auto evict_oldest() -> bool { return mStorage.evict_oldest(); }
+
+ private:
+  struct key final {
+    int width {};
+    int height {};
+    pixel_format format {};
+
+    [[nodiscard]] auto operator<(const key& other) const noexcept -> bool
+    {
+      return std::tie(width, height, format) <
+             std::tie(other.width, other.height, other.format);
+    }
+
+    [[nodiscard]] auto operator==(const key& other) const noexcept -> bool
+    {
+      return width == other.width && height == other.height && format == other.format;
+    }
+  };
+
+  renderer_handle mRenderer;
+  iarea mOutputSize;
+  pixel_format mFormat;
+  detail::pool_storage<key, texture> mStorage;
+  std::vector<key> mKeys;  ///< The keys of all targets created since the last resize.
+};
+
+/**
+ * Temporarily redirects rendering to a target texture.
+ *
+ * The render target that was active when the scoped target was created is restored when the
+ * scoped target is destroyed, which makes it safe to nest scoped targets in multi-pass
+ * effects. The renderer and the target texture must outlive the scoped target.
+ *
+ * \see render_target_pool
+ */
+class scoped_target final {
+ public:
+  /**
+   * Makes a texture the current render target.
+   *
+   * \param renderer the renderer whose target will be changed.
+   * \param target the new render target, which must have target access.
+   *
+   * \throws sdl_error if the render target cannot be changed.
+   */
+  template <typename T, typename X>
+  scoped_target(basic_renderer<T>& renderer, basic_texture<X>& target)
+      : mRenderer {renderer.get()}
+      , mPrevious {renderer.get_target()}
+  {
+    if (!mRenderer.set_target(target)) {
+      throw sdl_error {};
+    }
+  }
+
+  template <typename T>
+  scoped_target(basic_renderer<T>& renderer, pooled<render_target_pool>& target)
+      : scoped_target {renderer, target.get()}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(scoped_target)
+  CENTURION_DISABLE_MOVE(scoped_target)
+
+  ~scoped_target() noexcept
+  {
+    if (mPrevious) {
+      mRenderer.set_target(mPrevious);
+    }
+    else {
+      mRenderer.reset_target();
+    }
+  }
+
+  /// Returns the render target that will be restored.
+  [[nodiscard]] auto previous() const noexcept -> const texture_handle& { return mPrevious; }
+
+ private:
+  renderer_handle mRenderer;
+  texture_handle mPrevious;
+};
+
+/**
+ * Recycles surfaces with the same size and pixel format.
+ *
+ * Recycled surfaces keep their previous pixel data, but their alpha, color, and blend modes
+ * are reset, along with their clip rectangles.
+ *
+ * \see texture_pool
+ * \see pooled
+ */
+class surface_pool final {
+ public:
+  using resource_type = surface;
+
+  /**
+   * Creates a surface pool.
+   *
+   * \param maxIdle the maximum amount of idle surfaces for each combination of size and
+   *        format.
+   */
+  explicit surface_pool(const usize maxIdle = 4) : mStorage {maxIdle}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(surface_pool)
+  CENTURION_DISABLE_MOVE(surface_pool)
+
+  /**
+   * Returns a surface, which is recycled if possible.
+   *
+   * \param size the size of the surface.
+   * \param format the pixel format of the surface.
+   *
+   * \return a surface that is returned to the pool when destroyed.
+   *
+   * \throws sdl_error if a new surface cannot be created.
+   */
+  [[nodiscard]] auto acquire(const iarea& size, const pixel_format format)
+      -> pooled<surface_pool>
+  {
+    if (auto recycled = mStorage.take({size.width, size.height, format})) {
+      return {std::move(*recycled), *this};
+    }
+    else {
+      return {surface {size, format}, *this};
+    }
+  }
+
+  /// Returns a surface to the pool, this is usually done automatically by `pooled`.
+  void recycle(surface&& surface) noexcept
+  {
+    if (!surface.get()) {
+      return;
+    }
+
+    const auto format = surface.format_info().format();
+
+    surface.set_alpha_mod(0xFF);
+    surface.set_color_mod(colors::white);
+    surface.set_blend_mode(SDL_ISPIXELFORMAT_ALPHA(to_underlying(format)) ? blend_mode::blend
+                                                                          : blend_mode::none);
+    SDL_SetClipRect(surface.get(), nullptr);
+
+    const auto size = surface.size();
+    const auto bytes = static_cast<usize>(surface.pitch()) * static_cast<usize>(size.height);
+    mStorage.give({size.width, size.height, format}, std::move(surface), bytes);
+  }
+
+  /// Destroys all idle surfaces.
+  void clear() noexcept { mStorage.clear(); }
+
+  /// Sets the maximum amount of idle surfaces per key, destroying any excess surfaces.
+  void set_max_idle(const usize maxIdle) { mStorage.set_max_idle(maxIdle); }
+
+  [[nodiscard]] auto max_idle() const noexcept -> usize { return mStorage.max_idle(); }
+
+  /// Returns the total amount of idle surfaces.
+  [[nodiscard]] auto idle_count() const noexcept -> usize { return mStorage.idle_count(); }
+
+  /// Returns the amount of acquisitions that recycled a surface.
+  [[nodiscard]] auto hits() const noexcept -> uint64 { return mStorage.hits(); }
+
+  /// Returns the amount of acquisitions that created a new surface.
+  [[nodiscard]] auto misses() const noexcept -> uint64 { return mStorage.misses(); }
+
+  /// Returns the estimated memory used by idle surfaces, in bytes.
+  [[nodiscard]] auto memory_usage() const noexcept -> usize { return mStorage.memory_usage(); }
+
+  /// Returns the usage stamp of the oldest idle surface, see `cache_manager`.
+  [[nodiscard]] auto oldest_use() const noexcept -> maybe<uint64>
+  {
+    return mStorage.oldest_use();
+  }
+
+  /// Destroys the oldest idle surface, returning `false` if there are no idle surfaces.
+  auto evict_oldest() -> bool { return mStorage.evict_oldest(); }
+
+ private:
+  struct key final {
+    int width {};
+    int height {};
+    pixel_format format {};
+
+    [[nodiscard]] auto operator<(const key& other) const noexcept -> bool
+    {
+      return std::tie(width, height, format) <
+             std::tie(other.width, other.height, other.format);
+    }
+  };
+
+  detail::pool_storage<key, surface> mStorage;
+};
+
+using pooled_texture = pooled<texture_pool>;
+using pooled_surface = pooled<surface_pool>;
+using pooled_target = pooled<render_target_pool>;
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_RESOURCE_POOL_HPP_
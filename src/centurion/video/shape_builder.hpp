@@ -0,0 +1,712 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_SHAPE_BUILDER_HPP_
+#define CENTURION_VIDEO_SHAPE_BUILDER_HPP_
+
+#include <SDL.h>
+
+#include <cmath>        // sqrt, acos, atan2, ceil, cos, sin, abs
+#include <cstddef>      // ptrdiff_t
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "color.hpp"
+#include "renderer.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+/// Provides different ways of joining consecutive segments of a stroke.
+enum class line_join {
+  miter,  ///< The outer edges are extended until they meet, limited by the miter limit.
+  bevel,  ///< The outer corners are connected by a straight edge.
+  round   ///< The outer corners are connected by a circular arc.
+};
+
+/// Provides different ways of ending an open stroke.
+enum class line_cap {
+  butt,    ///< The stroke ends exactly at the end points.
+  square,  ///< The stroke is extended by half of its width.
+  round    ///< The stroke ends with a half circle.
+};
+
+[[nodiscard]] constexpr auto to_string(const line_join join) -> std::string_view
+{
+  switch (join) {
+    case line_join::miter:
+      return "miter";
+
+    case line_join::bevel:
+      return "bevel";
+
+    case line_join::round:
+      return "round";
+
+    default:
+      throw exception {"Did not recognize line join!"};
+  }
+}
+
+[[nodiscard]] constexpr auto to_string(const line_cap cap) -> std::string_view
+{
+  switch (cap) {
+    case line_cap::butt:
+      return "butt";
+
+    case line_cap::square:
+      return "square";
+
+    case line_cap::round:
+      return "round";
+
+    default:
+      throw exception {"Did not recognize line cap!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const line_join join) -> std::ostream&
+{
+  return stream << to_string(join);
+}
+
+inline auto operator<<(std::ostream& stream, const line_cap cap) -> std::ostream&
+{
+  return stream << to_string(cap);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/// Describes how lines and polylines are stroked.
+struct stroke_style final {
+  float width {1};                    ///< The thickness of the stroke.
+  line_join join {line_join::miter};  ///< The join used between segments.
+  line_cap cap {line_cap::butt};      ///< The cap used at the ends of open strokes.
+  float miter_limit {4};              ///< The maximum miter length, relative to the width.
+};
+
+namespace detail {
+
+struct shape_vec final {
+  float x {};
+  float y {};
+};
+
+[[nodiscard]] inline auto shape_cross(const shape_vec& o,
+                                      const shape_vec& a,
+                                      const shape_vec& b) noexcept -> float
+{
+  return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+}
+
+/* Returns the amount of arc segments needed to stay within a quarter pixel of a circle */
+[[nodiscard]] inline auto arc_segments(const float radius, const float angle) noexcept -> int
+{
+  constexpr float tolerance = 0.25f;
+  if (radius <= tolerance) {
+    return 1;
+  }
+
+  const auto step = 2.0f * std::acos(1.0f - tolerance / radius);
+  const auto segments = static_cast<int>(std::ceil(std::abs(angle) / step));
+  return (detail::clamp)(segments, 1, 64);
+}
+
+[[nodiscard]] inline auto point_in_triangle(const shape_vec& p,
+                                            const shape_vec& a,
+                                            const shape_vec& b,
+                                            const shape_vec& c) noexcept -> bool
+{
+  const auto d1 = shape_cross(a, b, p);
+  const auto d2 = shape_cross(b, c, p);
+  const auto d3 = shape_cross(c, a, p);
+
+  const auto hasNegative = d1 < 0 || d2 < 0 || d3 < 0;
+  const auto hasPositive = d1 > 0 || d2 > 0 || d3 > 0;
+
+  return !(hasNegative && hasPositive);
+}
+
+}  // namespace detail
+
+/**
+ * Builds triangle geometry for thick lines, polylines and filled polygons.
+ *
+ * All shapes are appended to a single vertex and index buffer, which is rendered with one
+ * untextured geometry call. The buffers keep their capacity when the builder is cleared, so
+ * a builder can be reused every frame without allocating.
+ *
+ * Filled polygons may be concave, in which case they are triangulated with ear clipping.
+ * Self-intersecting polygons are not supported.
+ *
+ * \see basic_renderer::render_geo
+ */
+class shape_builder final {
+ public:
+  using size_type = usize;
+
+  /// Reserves space for the specified amount of vertices and indices.
+  void reserve(const size_type vertices, const size_type indices)
+  {
+    mVertices.reserve(vertices);
+    mIndices.reserve(indices);
+  }
+
+  /**
+   * Adds a thick line segment.
+   *
+   * \param from the start point of the line.
+   * \param to the end point of the line.
+   * \param style the stroke style, where the join is ignored.
+   * \param tint the color of the line.
+   */
+  void add_line(const fpoint& from,
+                const fpoint& to,
+                const stroke_style& style,
+                const color& tint = colors::white)
+  {
+    const fpoint points[] {from, to};
+    add_polyline(points, 2, style, tint, false);
+  }
+
+  /**
+   * Adds a thick polyline.
+   *
+   * \details Consecutive duplicate points are ignored.
+   *
+   * \param points the points of the polyline.
+   * \param count the number of points.
+   * \param style the stroke style.
+   * \param tint the color of the polyline.
+   * \param closed `true` if the last point should be connected to the first point, in which
+   *               case no caps are added.
+   */
+  void add_polyline(const fpoint* points,
+                    const size_type count,
+                    const stroke_style& style,
+                    const color& tint = colors::white,
+                    const bool closed = false)
+  {
+    if (style.width <= 0 || !load_points(points, count)) {
+      return;
+    }
+
+    if (closed && mPoints.size() > 2 && same(mPoints.front(), mPoints.back())) {
+      mPoints.pop_back();
+    }
+
+    const auto n = mPoints.size();
+    if (n < 2) {
+      return;
+    }
+
+    const auto isClosed = closed && n > 2;
+    const auto hw = style.width * 0.5f;
+    const auto& rgba = tint.get();
+
+    if (!isClosed && style.cap == line_cap::square) {
+      extend(mPoints[0], mPoints[1], hw);
+      extend(mPoints[n - 1], mPoints[n - 2], hw);
+    }
+
+    const auto segments = isClosed ? n : n - 1;
+    for (size_type index = 0; index < segments; ++index) {
+      add_segment(mPoints[index], mPoints[(index + 1) % n], hw, rgba);
+    }
+
+    const auto firstJoin = isClosed ? size_type {0} : size_type {1};
+    const auto lastJoin = isClosed ? n : n - 1;
+    for (auto index = firstJoin; index < lastJoin; ++index) {
+      const auto& prev = mPoints[(index + n - 1) % n];
+      const auto& curr = mPoints[index];
+      const auto& next = mPoints[(index + 1) % n];
+      add_join(prev, curr, next, hw, style, rgba);
+    }
+
+    if (!isClosed && style.cap == line_cap::round) {
+      add_round_cap(mPoints[0], mPoints[1], hw, rgba);
+      add_round_cap(mPoints[n - 1], mPoints[n - 2], hw, rgba);
+    }
+  }
+
+  /// Adds a thick polyline, where the points are provided by a contiguous container.
+  template <typename Container>
+  void add_polyline(const Container& points,
+                    const stroke_style& style,
+                    const color& tint = colors::white,
+                    const bool closed = false)
+  {
+    add_polyline(points.data(), points.size(), style, tint, closed);
+  }
+
+  /**
+   * Adds a filled polygon, which may be concave.
+   *
+   * \param points the vertices of the polygon, in either winding order.
+   * \param count the number of vertices.
+   * \param tint the fill color.
+   *
+   * \return `true` if the polygon was triangulated; `false` if it is degenerate or
+   *         self-intersecting, in which case nothing is added.
+   */
+  auto add_polygon(const fpoint* points,
+                   const size_type count,
+                   const color& tint = colors::white) -> bool
+  {
+    if (!load_points(points, count)) {
+      return false;
+    }
+
+    if (mPoints.size() > 2 && same(mPoints.front(), mPoints.back())) {
+      mPoints.pop_back();
+    }
+
+    const auto n = mPoints.size();
+    if (n < 3) {
+      return false;
+    }
+
+    const auto area = signed_area();
+    if (area == 0) {
+      return false;
+    }
+
+    /* The remaining polygon is stored as indices, ordered to have a positive signed area */
+    mRemaining.clear();
+    if (area > 0) {
+      for (size_type index = 0; index < n; ++index) {
+        mRemaining.push_back(index);
+      }
+    }
+    else {
+      for (size_type index = n; index > 0; --index) {
+        mRemaining.push_back(index - 1);
+      }
+    }
+
+    const auto vertexStart = mVertices.size();
+    const auto indexStart = mIndices.size();
+    const auto base = static_cast<int>(vertexStart);
+
+    const auto& rgba = tint.get();
+    for (const auto& point : mPoints) {
+      mVertices.push_back({{point.x, point.y}, rgba, {0, 0}});
+    }
+
+    size_type misses = 0;
+    size_type current = 0;
+
+    while (mRemaining.size() > 3) {
+      const auto size = mRemaining.size();
+      if (misses >= size) {
+        /* No ear was found during a full pass, so the polygon is self-intersecting */
+        mVertices.resize(vertexStart);
+        mIndices.resize(indexStart);
+        return false;
+      }
+
+      const auto prev = mRemaining[(current + size - 1) % size];
+      const auto curr = mRemaining[current % size];
+      const auto next = mRemaining[(current + 1) % size];
+
+      const auto cross = detail::shape_cross(mPoints[prev], mPoints[curr], mPoints[next]);
+      if (cross == 0) {
+        /* Collinear vertices do not contribute any area */
+        mRemaining.erase(mRemaining.begin() + static_cast<std::ptrdiff_t>(current % size));
+        misses = 0;
+      }
+      else if (cross > 0 && is_ear(prev, curr, next)) {
+        mIndices.insert(mIndices.end(),
+                        {base + static_cast<int>(prev),
+                         base + static_cast<int>(curr),
+                         base + static_cast<int>(next)});
+        mRemaining.erase(mRemaining.begin() + static_cast<std::ptrdiff_t>(current % size));
+        misses = 0;
+      }
+      else {
+        ++current;
+        ++misses;
+      }
+
+      current %= mRemaining.size();
+    }
+
+    if (detail::shape_cross(mPoints[mRemaining[0]],
+                            mPoints[mRemaining[1]],
+                            mPoints[mRemaining[2]]) != 0) {
+      mIndices.insert(mIndices.end(),
+                      {base + static_cast<int>(mRemaining[0]),
+                       base + static_cast<int>(mRemaining[1]),
+                       base + static_cast<int>(mRemaining[2])});
+    }
+
+    return true;
+  }
+
+  /// Adds a filled polygon, where the points are provided by a contiguous container.
+  template <typename Container>
+  auto add_polygon(const Container& points, const color& tint = colors::white) -> bool
+  {
+    return add_polygon(points.data(), points.size(), tint);
+  }
+
+  /**
+   * Adds a filled convex polygon, which is cheaper than `add_polygon()`.
+   *
+   * \details The polygon is triangulated as a fan, so the result is only correct for convex
+   * polygons.
+   *
+   * \param points the vertices of the polygon, in either winding order.
+   * \param count the number of vertices.
+   * \param tint the fill color.
+   */
+  void add_convex_polygon(const fpoint* points,
+                          const size_type count,
+                          const color& tint = colors::white)
+  {
+    if (count < 3) {
+      return;
+    }
+
+    const auto base = static_cast<int>(mVertices.size());
+    const auto& rgba = tint.get();
+
+    for (size_type index = 0; index < count; ++index) {
+      mVertices.push_back({points[index].get(), rgba, {0, 0}});
+    }
+
+    for (size_type index = 1; index + 1 < count; ++index) {
+      push_triangle(base, base + static_cast<int>(index), base + static_cast<int>(index + 1));
+    }
+  }
+
+  /// Adds a filled convex polygon, where the points are provided by a contiguous container.
+  template <typename Container>
+  void add_convex_polygon(const Container& points, const color& tint = colors::white)
+  {
+    add_convex_polygon(points.data(), points.size(), tint);
+  }
+
+  /**
+   * Renders all shapes with a single geometry call.
+   *
+   * \param renderer the renderer that will be used.
+   *
+   * \return `success` if the shapes were rendered, or if there was nothing to render;
+   *         `failure` otherwise.
+   */
+  template <typename T>
+  auto render(basic_renderer<T>& renderer) const noexcept -> result
+  {
+    if (mIndices.empty()) {
+      return success;
+    }
+
+    return renderer.render_geo(mVertices.data(),
+                               mVertices.size(),
+                               mIndices.data(),
+                               mIndices.size());
+  }
+
+  /// Removes all shapes, without releasing the storage.
+  void clear() noexcept
+  {
+    mVertices.clear();
+    mIndices.clear();
+  }
+
+  [[nodiscard]] auto vertices() const noexcept -> const std::vector<SDL_Vertex>&
+  {
+    return mVertices;
+  }
+
+  [[nodiscard]] auto indices() const noexcept -> const std::vector<int>& { return mIndices; }
+
+  /// Returns the amount of triangles in the builder.
+  [[nodiscard]] auto triangle_count() const noexcept -> size_type
+  {
+    return mIndices.size() / 3u;
+  }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mIndices.empty(); }
+
+ private:
+  std::vector<SDL_Vertex> mVertices;
+  std::vector<int> mIndices;
+  std::vector<detail::shape_vec> mPoints;  ///< Scratch buffer for the current shape.
+  std::vector<size_type> mRemaining;       ///< Scratch buffer for ear clipping.
+
+  [[nodiscard]] static auto same(const detail::shape_vec& a,
+                                 const detail::shape_vec& b) noexcept -> bool
+  {
+    return a.x == b.x && a.y == b.y;
+  }
+
+  auto load_points(const fpoint* points, const size_type count) -> bool
+  {
+    mPoints.clear();
+    if (!points) {
+      return false;
+    }
+
+    for (size_type index = 0; index < count; ++index) {
+      const detail::shape_vec point {points[index].x(), points[index].y()};
+      if (mPoints.empty() || !same(mPoints.back(), point)) {
+        mPoints.push_back(point);
+      }
+    }
+
+    return !mPoints.empty();
+  }
+
+  [[nodiscard]] auto signed_area() const noexcept -> float
+  {
+    float area = 0;
+
+    const auto n = mPoints.size();
+    for (size_type index = 0; index < n; ++index) {
+      const auto& a = mPoints[index];
+      const auto& b = mPoints[(index + 1) % n];
+      area += a.x * b.y - b.x * a.y;
+    }
+
+    return area * 0.5f;
+  }
+
+  [[nodiscard]] auto is_ear(const size_type prev,
+                            const size_type curr,
+                            const size_type next) const noexcept -> bool
+  {
+    const auto& a = mPoints[prev];
+    const auto& b = mPoints[curr];
+    const auto& c = mPoints[next];
+
+    for (const auto index : mRemaining) {
+      if (index == prev || index == curr || index == next) {
+        continue;
+      }
+
+      const auto& p = mPoints[index];
+      if (!same(p, a) && !same(p, b) && !same(p, c) && detail::point_in_triangle(p, a, b, c)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  [[nodiscard]] static auto unit_normal(const detail::shape_vec& from,
+                                        const detail::shape_vec& to) noexcept
+      -> detail::shape_vec
+  {
+    const auto dx = to.x - from.x;
+    const auto dy = to.y - from.y;
+    const auto length = std::sqrt(dx * dx + dy * dy);
+    return {-dy / length, dx / length};
+  }
+
+  /* Moves an end point away from its neighbour, by the specified distance */
+  static void extend(detail::shape_vec& end,
+                     const detail::shape_vec& neighbour,
+                     const float distance) noexcept
+  {
+    const auto dx = end.x - neighbour.x;
+    const auto dy = end.y - neighbour.y;
+    const auto length = std::sqrt(dx * dx + dy * dy);
+    end.x += dx / length * distance;
+    end.y += dy / length * distance;
+  }
+
+  void push_vertex(const float x, const float y, const SDL_Color& rgba)
+  {
+    mVertices.push_back({{x, y}, rgba, {0, 0}});
+  }
+
+  void push_triangle(const int a, const int b, const int c)
+  {
+    mIndices.insert(mIndices.end(), {a, b, c});
+  }
+
+  void add_segment(const detail::shape_vec& from,
+                   const detail::shape_vec& to,
+                   const float hw,
+                   const SDL_Color& rgba)
+  {
+    const auto normal = unit_normal(from, to);
+    const auto nx = normal.x * hw;
+    const auto ny = normal.y * hw;
+
+    const auto first = static_cast<int>(mVertices.size());
+    push_vertex(from.x + nx, from.y + ny, rgba);
+    push_vertex(to.x + nx, to.y + ny, rgba);
+    push_vertex(to.x - nx, to.y - ny, rgba);
+    push_vertex(from.x - nx, from.y - ny, rgba);
+
+    push_triangle(first, first + 1, first + 2);
+    push_triangle(first + 2, first + 3, first);
+  }
+
+  /* Fills the gap on the outer side of the corner at the current point */
+  void add_join(const detail::shape_vec& prev,
+                const detail::shape_vec& curr,
+                const detail::shape_vec& next,
+                const float hw,
+                const stroke_style& style,
+                const SDL_Color& rgba)
+  {
+    const auto cross = detail::shape_cross(prev, curr, next);
+    if (cross == 0) {
+      return;
+    }
+
+    const auto side = cross > 0 ? -1.0f : 1.0f;
+    const auto n0 = unit_normal(prev, curr);
+    const auto n1 = unit_normal(curr, next);
+
+    const auto center = static_cast<int>(mVertices.size());
+    push_vertex(curr.x, curr.y, rgba);
+    push_vertex(curr.x + n0.x * hw * side, curr.y + n0.y * hw * side, rgba);
+
+    if (style.join == line_join::round) {
+      const auto start = std::atan2(n0.y * side, n0.x * side);
+      auto sweep = std::atan2(n1.y * side, n1.x * side) - start;
+
+      constexpr auto pi = 3.14159265358979f;
+      if (sweep > pi) {
+        sweep -= 2 * pi;
+      }
+      else if (sweep < -pi) {
+        sweep += 2 * pi;
+      }
+
+      add_arc(curr, hw, start, sweep, center, rgba);
+      return;
+    }
+
+    const auto mx = n0.x + n1.x;
+    const auto my = n0.y + n1.y;
+    const auto ml = std::sqrt(mx * mx + my * my);
+
+    /* The miter length relative to the half width is 1 / cos(theta / 2) */
+    const auto cosHalf = ml > 0 ? (mx * n0.x + my * n0.y) / ml : 0.0f;
+    const auto ratio = cosHalf > 0 ? 1.0f / cosHalf : 0.0f;
+
+    if (style.join == line_join::miter && ratio > 0 && ratio <= style.miter_limit) {
+      const auto length = hw * ratio;
+      push_vertex(curr.x + mx / ml * length * side, curr.y + my / ml * length * side, rgba);
+      push_vertex(curr.x + n1.x * hw * side, curr.y + n1.y * hw * side, rgba);
+      push_triangle(center, center + 1, center + 2);
+      push_triangle(center, center + 2, center + 3);
+    }
+    else {
+      push_vertex(curr.x + n1.x * hw * side, curr.y + n1.y * hw * side, rgba);
+      push_triangle(center, center + 1, center + 2);
+    }
+  }
+
+  void add_round_cap(const detail::shape_vec& end,
+                     const detail::shape_vec& neighbour,
+                     const float hw,
+                     const SDL_Color& rgba)
+  {
+    const auto normal = unit_normal(neighbour, end);
+
+    const auto center = static_cast<int>(mVertices.size());
+    push_vertex(end.x, end.y, rgba);
+    push_vertex(end.x + normal.x * hw, end.y + normal.y * hw, rgba);
+
+    /* Rotating the normal clockwise sweeps around the tip, to the other side of the end */
+    constexpr auto pi = 3.14159265358979f;
+    add_arc(end, hw, std::atan2(normal.y, normal.x), -pi, center, rgba);
+  }
+
+  /* Expects the center and the first rim vertex to have been pushed already */
+  void add_arc(const detail::shape_vec& center,
+               const float radius,
+               const float start,
+               const float sweep,
+               const int centerIndex,
+               const SDL_Color& rgba)
+  {
+    const auto segments = detail::arc_segments(radius, sweep);
+    const auto step = sweep / static_cast<float>(segments);
+
+    for (auto segment = 1; segment <= segments; ++segment) {
+      const auto angle = start + step * static_cast<float>(segment);
+      push_vertex(center.x + std::cos(angle) * radius,
+                  center.y + std::sin(angle) * radius,
+                  rgba);
+
+      const auto last = static_cast<int>(mVertices.size()) - 1;
+      push_triangle(centerIndex, last - 1, last);
+    }
+  }
+};
+
+[[nodiscard]] inline auto to_string(const shape_builder& builder) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("shape_builder(triangles: {})", builder.triangle_count());
+#else
+  return "shape_builder(triangles: " + std::to_string(builder.triangle_count()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const shape_builder& builder) -> std::ostream&
+{
+  return stream << to_string(builder);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_SHAPE_BUILDER_HPP_
@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_SOFTWARE_CANVAS_HPP_
+#define CENTURION_VIDEO_SOFTWARE_CANVAS_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+
+namespace cen {
+
+/**
+ * Computes a 64-bit FNV-1a checksum of the pixels of a surface.
+ *
+ * Only the visible bytes of each row are hashed, so the checksum doesn't depend on the row
+ * padding. This makes it possible to compare rendered frames against reference checksums,
+ * e.g. in regression tests.
+ *
+ * \param surface the surface that will be hashed, which must not require locking.
+ *
+ * \return the checksum of the pixel data.
+ */
+template <typename T>
+[[nodiscard]] auto pixel_checksum(const basic_surface<T>& surface) noexcept -> uint64
+{
+  assert(!surface.must_lock());
+
+  const auto* ptr = surface.get();
+  const auto rowSize = static_cast<usize>(ptr->w) * ptr->format->BytesPerPixel;
+
+  uint64 hash {0xCBF29CE484222325};
+
+  for (int y = 0; y < ptr->h; ++y) {
+    const auto* row = static_cast<const uint8*>(ptr->pixels) + (y * ptr->pitch);
+    for (usize x = 0; x < rowSize; ++x) {
+      hash ^= row[x];
+      hash *= 0x100000001B3;
+    }
+  }
+
+  return hash;
+}
+
+/**
+ * An offscreen render target backed by a surface and a software renderer.
+ *
+ * The canvas doesn't need a window, so it works with the dummy video driver, which makes it
+ * suitable for headless benchmarks and tests. Software rendering is deterministic for a given
+ * SDL version, so `checksum()` can be used to verify the rendered output.
+ */
+class software_canvas final {
+ public:
+  /**
+   * Creates a canvas.
+   *
+   * \param size the size of the canvas.
+   * \param format the pixel format of the backing surface.
+   *
+   * \throws sdl_error if the surface or the renderer cannot be created.
+   */
+  explicit software_canvas(const iarea& size = {800, 600},
+                           const pixel_format format = pixel_format::argb8888)
+      : mSurface {size, format}
+      , mRenderer {SDL_CreateSoftwareRenderer(mSurface.get())}
+  {}
+
+  CENTURION_DISABLE_COPY(software_canvas)
+  CENTURION_DISABLE_MOVE(software_canvas)
+
+  /// Returns a checksum of the current contents of the canvas, see `pixel_checksum()`.
+  [[nodiscard]] auto checksum() const noexcept -> uint64 { return pixel_checksum(mSurface); }
+
+  [[nodiscard]] auto get_renderer() noexcept -> renderer& { return mRenderer; }
+
+  [[nodiscard]] auto get_surface() const noexcept -> const surface& { return mSurface; }
+
+  [[nodiscard]] auto size() const noexcept -> iarea { return mSurface.size(); }
+
+ private:
+  surface mSurface;
+  renderer mRenderer;  ///< Must be declared after the surface, which it draws into.
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_SOFTWARE_CANVAS_HPP_
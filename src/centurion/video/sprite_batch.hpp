@@ -0,0 +1,408 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_SPRITE_BATCH_HPP_
+#define CENTURION_VIDEO_SPRITE_BATCH_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>   // stable_sort, remove_if
+#include <functional>  // less
+#include <string>      // string, to_string
+#include <vector>      // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../features.hpp"
+#include "atlas_region.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "render_view.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+#include <span>  // span
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+namespace cen {
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+/**
+ * Collects sprites and renders them in as few geometry calls as possible.
+ *
+ * Sprites are sorted by their layer, texture and blend mode when the batch is flushed, so
+ * that all consecutive sprites that share the same state are submitted as a single geometry
+ * call. Sprites with the same key keep the order in which they were added.
+ *
+ * Tints are applied through the vertex colors rather than the color and alpha modulation of
+ * the textures, so differently tinted or faded sprites of the same texture are still rendered
+ * in a single geometry call. The alpha of a tint modulates the opacity of the sprite. The
+ * modulation of the textures themselves is never changed by the batch, and the blend modes of
+ * the textures are restored after each geometry call.
+ *
+ * Note, the batch only stores raw texture pointers, so the textures must outlive the next
+ * call to `flush()`.
+ *
+ * \see basic_renderer::render_geo
+ */
+class sprite_batch final {
+ public:
+  using size_type = usize;
+
+  struct sprite final {
+    SDL_Texture* texture {};               ///< The source texture.
+    irect source;                          ///< The region of the texture that is rendered.
+    frect destination;                     ///< The destination of the sprite.
+    color tint {colors::white};            ///< The color and alpha modulation of the sprite.
+    int layer {};                          ///< The layer, lower layers are rendered first.
+    blend_mode blend {blend_mode::blend};  ///< The blend mode used by the sprite.
+  };
+
+  /// Reserves space for the specified amount of sprites.
+  void reserve(const size_type count)
+  {
+    mSprites.reserve(count);
+    mVertices.reserve(count * 4u);
+    mIndices.reserve(count * 6u);
+  }
+
+  /**
+   * Adds a sprite to the batch.
+   *
+   * \param texture the source texture.
+   * \param source the region of the texture that is rendered.
+   * \param destination the destination of the sprite.
+   * \param layer the layer of the sprite, lower layers are rendered first.
+   * \param tint the color modulation of the sprite.
+   * \param blend the blend mode used when rendering the sprite.
+   */
+  template <typename T>
+  void add(const basic_texture<T>& texture,
+           const irect& source,
+           const frect& destination,
+           const int layer = 0,
+           const color& tint = colors::white,
+           const blend_mode blend = blend_mode::blend)
+  {
+    mSprites.push_back({texture.get(), source, destination, tint, layer, blend});
+  }
+
+  /// Adds a sprite that renders the entire texture.
+  template <typename T>
+  void add(const basic_texture<T>& texture,
+           const frect& destination,
+           const int layer = 0,
+           const color& tint = colors::white)
+  {
+    add(texture, irect {{0, 0}, texture.size()}, destination, layer, tint);
+  }
+
+  /// Adds a sprite that renders a region of a texture atlas.
+  void add(const atlas_region& region,
+           const frect& destination,
+           const int layer = 0,
+           const color& tint = colors::white,
+           const blend_mode blend = blend_mode::blend)
+  {
+    mSprites.push_back({region.texture, region.source, destination, tint, layer, blend});
+  }
+
+  /**
+   * Renders all sprites in the batch, and clears the batch afterwards.
+   *
+   * \param renderer the renderer that will be used.
+   *
+   * \return `success` if all sprites were rendered; `failure` otherwise.
+   */
+  template <typename T>
+  auto flush(basic_renderer<T>& renderer) -> result
+  {
+    sort_sprites();
+
+    mDrawCalls = 0;
+    result res = success;
+
+    auto first = mSprites.begin();
+    while (first != mSprites.end()) {
+      auto last = first;
+      while (last != mSprites.end() && last->layer == first->layer &&
+             last->texture == first->texture && last->blend == first->blend) {
+        ++last;
+      }
+
+      mVertices.clear();
+      mIndices.clear();
+
+      texture_handle texture {first->texture};
+      const auto size = texture.size().as_f();
+
+      for (auto it = first; it != last; ++it) {
+        add_quad(*it, it->destination, size);
+      }
+
+      if (!render_run(renderer, texture, first->blend)) {
+        res = failure;
+      }
+
+      ++mDrawCalls;
+      first = last;
+    }
+
+    mSprites.clear();
+    return res;
+  }
+
+  /**
+   * Renders all sprites in the batch into several views, and clears the batch afterwards.
+   *
+   * The sprite destinations are treated as world coordinates, and each view renders the
+   * sprites through its own camera into its own viewport, e.g. for split-screen rendering.
+   * Sprites that are not visible in any view are discarded before the batch is sorted, and
+   * the sorting and texture size queries are shared by all views. Each view issues one
+   * geometry call for every texture, layer and blend mode that is visible in that view.
+   *
+   * The viewport and clip area of the renderer are restored afterwards.
+   *
+   * \param renderer the renderer that will be used.
+   * \param views the views that the sprites are rendered into, may be null if the count is
+   *        zero.
+   * \param count the amount of views.
+   *
+   * \return `success` if all sprites were rendered; `failure` otherwise.
+   */
+  template <typename T>
+  auto flush(basic_renderer<T>& renderer, const render_view* views, const size_type count)
+      -> result
+  {
+    mDrawCalls = 0;
+
+    if (count == 0) {
+      mSprites.clear();
+      return success;
+    }
+
+    const auto bounds = detail::view_bounds(views, count);
+    mSprites.erase(std::remove_if(mSprites.begin(),
+                                  mSprites.end(),
+                                  [&](const sprite& sprite) {
+                                    return !intersects(bounds, sprite.destination);
+                                  }),
+                   mSprites.end());
+
+    sort_sprites();
+    collect_runs();
+
+    detail::view_scope<T> scope {renderer};
+    result res = success;
+
+    for (size_type index = 0; index < count; ++index) {
+      const auto& view = views[index];
+      if (!scope.apply(view)) {
+        res = failure;
+      }
+
+      for (const auto& run : mRuns) {
+        mVertices.clear();
+        mIndices.clear();
+
+        for (auto i = run.first; i != run.last; ++i) {
+          const auto& sprite = mSprites[i];
+          if (view.eye.visible(sprite.destination)) {
+            add_quad(sprite, view.eye.to_screen(sprite.destination), run.textureSize);
+          }
+        }
+
+        if (mIndices.empty()) {
+          continue;
+        }
+
+        texture_handle texture {mSprites[run.first].texture};
+        if (!render_run(renderer, texture, mSprites[run.first].blend)) {
+          res = failure;
+        }
+
+        ++mDrawCalls;
+      }
+    }
+
+    mSprites.clear();
+    return res;
+  }
+
+  /// Renders all sprites in the batch into several views, and clears the batch afterwards.
+  template <typename T>
+  auto flush(basic_renderer<T>& renderer, const std::vector<render_view>& views) -> result
+  {
+    return flush(renderer, views.data(), views.size());
+  }
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+  template <typename T>
+  auto flush(basic_renderer<T>& renderer, const std::span<const render_view> views) -> result
+  {
+    return flush(renderer, views.data(), views.size());
+  }
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
+
+  /// Removes all sprites from the batch, without rendering them.
+  void clear() noexcept { mSprites.clear(); }
+
+  /// Returns the amount of sprites in the batch.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mSprites.size(); }
+
+  /// Indicates whether the batch is empty.
+  [[nodiscard]] auto empty() const noexcept -> bool { return mSprites.empty(); }
+
+  /// Returns the amount of geometry calls issued by the latest flush.
+  [[nodiscard]] auto draw_calls() const noexcept -> size_type { return mDrawCalls; }
+
+ private:
+  /// A range of sorted sprites that share the same layer, texture and blend mode.
+  struct sprite_run final {
+    size_type first {};  ///< The index of the first sprite.
+    size_type last {};   ///< The index one past the last sprite.
+    farea textureSize;   ///< The size of the shared texture.
+  };
+
+  std::vector<sprite> mSprites;
+  std::vector<sprite_run> mRuns;
+  std::vector<SDL_Vertex> mVertices;
+  std::vector<int> mIndices;
+  size_type mDrawCalls {};
+
+  void sort_sprites()
+  {
+    std::stable_sort(mSprites.begin(), mSprites.end(), [](const sprite& a, const sprite& b) {
+      if (a.layer != b.layer) {
+        return a.layer < b.layer;
+      }
+      else if (a.texture != b.texture) {
+        /* The built-in operator< doesn't define a total order for unrelated pointers */
+        return std::less<SDL_Texture*> {}(a.texture, b.texture);
+      }
+      else {
+        return a.blend < b.blend;
+      }
+    });
+  }
+
+  /// Renders the collected vertices, temporarily using the blend mode of the run.
+  template <typename T>
+  auto render_run(basic_renderer<T>& renderer, texture_handle& texture, const blend_mode blend)
+      -> result
+  {
+    const auto previous = texture.get_blend_mode();
+    texture.set_blend_mode(blend);
+
+    const auto res = renderer.render_geo(texture, mVertices, mIndices);
+
+    texture.set_blend_mode(previous);
+    return res;
+  }
+
+  void collect_runs()
+  {
+    mRuns.clear();
+
+    size_type first = 0;
+    while (first != mSprites.size()) {
+      const auto& head = mSprites[first];
+
+      auto last = first;
+      while (last != mSprites.size() && mSprites[last].layer == head.layer &&
+             mSprites[last].texture == head.texture && mSprites[last].blend == head.blend) {
+        ++last;
+      }
+
+      const texture_handle texture {head.texture};
+      mRuns.push_back({first, last, texture.size().as_f()});
+
+      first = last;
+    }
+  }
+
+  void add_quad(const sprite& sprite, const frect& dst, const farea& textureSize)
+  {
+    const auto& src = sprite.source;
+
+    const auto u0 = static_cast<float>(src.x()) / textureSize.width;
+    const auto v0 = static_cast<float>(src.y()) / textureSize.height;
+    const auto u1 = static_cast<float>(src.max_x()) / textureSize.width;
+    const auto v1 = static_cast<float>(src.max_y()) / textureSize.height;
+
+    const auto first = static_cast<int>(mVertices.size());
+    const auto& tint = sprite.tint.get();
+
+    mVertices.push_back({{dst.x(), dst.y()}, tint, {u0, v0}});
+    mVertices.push_back({{dst.max_x(), dst.y()}, tint, {u1, v0}});
+    mVertices.push_back({{dst.max_x(), dst.max_y()}, tint, {u1, v1}});
+    mVertices.push_back({{dst.x(), dst.max_y()}, tint, {u0, v1}});
+
+    mIndices.insert(mIndices.end(),
+                    {first, first + 1, first + 2, first + 2, first + 3, first});
+  }
+};
+
+[[nodiscard]] inline auto to_string(const sprite_batch& batch) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("sprite_batch(size: {})", batch.size());
+#else
+  return "sprite_batch(size: " + std::to_string(batch.size()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const sprite_batch& batch) -> std::ostream&
+{
+  return stream << to_string(batch);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_SPRITE_BATCH_HPP_
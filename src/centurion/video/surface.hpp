@@ -33,14 +33,15 @@
 
 #include <cassert>   // assert
 #include <optional>  // optional, nullopt
-#include <ostream>   // ostream
 #include <string>    // string, to_string
 
 #include "../common/errors.hpp"
 #include "../common/math.hpp"
+#include "../common/memory.hpp"
 #include "../common/primitives.hpp"
 #include "../common/result.hpp"
 #include "../detail/owner_handle_api.hpp"
+#include "../detail/pixel_conversion.hpp"
 #include "../detail/stdlib.hpp"
 #include "../features.hpp"
 #include "../io/file.hpp"
@@ -54,6 +55,12 @@
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 template <typename T>
@@ -110,7 +117,10 @@ class basic_surface final {
   }
 
   template <typename TT = T, detail::enable_for_owner<TT> = 0>
-  explicit basic_surface(file& file) : mSurface {IMG_Load_RW(file.data(), SDL_FALSE)}
+  explicit basic_surface(file& file)
+      : mSurface {IMG_LoadTyped_RW(file.data(),
+                                   SDL_FALSE,
+                                   detail::image_type_name(file.detect_type()))}
   {
     if (!mSurface) {
       throw img_error {};
@@ -198,6 +208,93 @@ class basic_surface final {
     return from_bmp(file.c_str());
   }
 
+  /**
+   * Creates a surface that uses existing pixel data, without copying it.
+   *
+   * The surface doesn't take ownership of the pixel data, which must outlive the surface.
+   * This makes it possible to blit, convert or upload externally allocated pixels, such as
+   * decoded video frames or shared memory. Copies of the surface own their pixel data.
+   *
+   * \param pixels the pixel data, which is not freed by the surface.
+   * \param size the size of the pixel data, in pixels.
+   * \param pitch the number of bytes in a row of pixel data, including any padding.
+   * \param format the pixel format of the pixel data.
+   *
+   * \return a surface that uses the supplied pixel data.
+   *
+   * \throws sdl_error if the surface cannot be created.
+   *
+   * \see owns_pixels()
+   */
+  template <typename TT = T, detail::enable_for_owner<TT> = 0>
+  [[nodiscard]] static auto from_pixels(void* pixels,
+                                        const iarea& size,
+                                        const int pitch,
+                                        const pixel_format format) -> surface
+  {
+    assert(pixels);
+    assert(pitch >= size.width * static_cast<int>(SDL_BYTESPERPIXEL(to_underlying(format))));
+
+    if (auto* ptr = SDL_CreateRGBSurfaceWithFormatFrom(pixels,
+                                                       size.width,
+                                                       size.height,
+                                                       0,
+                                                       pitch,
+                                                       to_underlying(format))) {
+      return surface {ptr};
+    }
+    else {
+      throw sdl_error {};
+    }
+  }
+
+  /**
+   * Creates a surface that uses the memory of a SIMD block as its pixel data.
+   *
+   * The block must hold at least `pitch * size.height` bytes, and must not be reallocated
+   * while the surface exists. The SIMD alignment of the block makes it suitable for the
+   * vectorized surface operations.
+   *
+   * \see from_pixels()
+   */
+  template <typename TT = T, detail::enable_for_owner<TT> = 0>
+  [[nodiscard]] static auto from_pixels(simd_block& block,
+                                        const iarea& size,
+                                        const int pitch,
+                                        const pixel_format format) -> surface
+  {
+    return from_pixels(block.data(), size, pitch, format);
+  }
+
+  /**
+   * Creates a surface that uses the memory of a SIMD block as its pixel data, without row
+   * padding.
+   *
+   * \see from_pixels()
+   */
+  template <typename TT = T, detail::enable_for_owner<TT> = 0>
+  [[nodiscard]] static auto from_pixels(simd_block& block,
+                                        const iarea& size,
+                                        const pixel_format format) -> surface
+  {
+    return from_pixels(block, size, min_pitch(size.width, format), format);
+  }
+
+  /**
+   * Returns the smallest pitch of pixel data in a format, i.e. without any row padding.
+   *
+   * \param width the width of the pixel data, in pixels.
+   * \param format the pixel format of the pixel data.
+   *
+   * \return the number of bytes needed for a row of pixels.
+   */
+  [[nodiscard]] constexpr static auto min_pitch(const int width,
+                                                const pixel_format format) noexcept -> int
+  {
+    const auto bits = static_cast<int>(SDL_BITSPERPIXEL(to_underlying(format)));
+    return (width * bits + 7) / 8;
+  }
+
   auto save_as_bmp(const char* file) const noexcept -> result
   {
     assert(file);
@@ -237,7 +334,13 @@ class basic_surface final {
 
   [[nodiscard]] auto convert_to(const pixel_format format) const -> surface
   {
-    if (auto* converted = SDL_ConvertSurfaceFormat(mSurface, to_underlying(format), 0)) {
+    /* Common byte shuffles are handled by vectorized kernels, everything else by SDL */
+    auto* converted = detail::convert_surface_fast(mSurface, to_underlying(format));
+    if (!converted) {
+      converted = SDL_ConvertSurfaceFormat(mSurface, to_underlying(format), 0);
+    }
+
+    if (converted) {
       surface result {converted};
       result.set_blend_mode(get_blend_mode());
       return result;
@@ -247,6 +350,41 @@ class basic_surface final {
     }
   }
 
+  /**
+   * Multiplies the color channels of every pixel by its alpha channel.
+   *
+   * Only 32-bit pixel formats with an 8-bit alpha channel, such as `argb8888`, are supported.
+   * Pair the result with `premultiplied_blend_mode()` when rendering it.
+   *
+   * \return `success` if the pixels were premultiplied; `failure` otherwise.
+   *
+   * \see unpremultiply()
+   * \see premultiplied_blend_mode()
+   */
+  auto premultiply() noexcept -> result
+  {
+    return for_each_alpha_row([](const int alphaIndex, uint8* row, const usize count) {
+      detail::premultiply_pixels(alphaIndex, detail::best_simd_level(), row, count);
+    });
+  }
+
+  /**
+   * Divides the color channels of every pixel by its alpha channel.
+   *
+   * This reverses `premultiply()`, although precision is lost for translucent pixels. The
+   * color of fully transparent pixels is set to black.
+   *
+   * \return `success` if the pixels were unpremultiplied; `failure` otherwise.
+   *
+   * \see premultiply()
+   */
+  auto unpremultiply() noexcept -> result
+  {
+    return for_each_alpha_row([](const int alphaIndex, uint8* row, const usize count) {
+      detail::unpremultiply_pixels(alphaIndex, row, count);
+    });
+  }
+
   /// Attempts to lock the surface, so that the associated pixel data can be modified.
   auto lock() noexcept -> result
   {
@@ -267,6 +405,12 @@ class basic_surface final {
 
   [[nodiscard]] auto must_lock() const noexcept -> bool { return SDL_MUSTLOCK(mSurface); }
 
+  /// Indicates whether the pixel data is owned by the surface, see `from_pixels()`.
+  [[nodiscard]] auto owns_pixels() const noexcept -> bool
+  {
+    return (mSurface->flags & SDL_PREALLOC) == 0;
+  }
+
   [[nodiscard]] auto pixel_data() noexcept -> void* { return mSurface->pixels; }
   [[nodiscard]] auto pixel_data() const noexcept -> const void* { return mSurface->pixels; }
 
@@ -287,6 +431,20 @@ class basic_surface final {
     return SDL_SetSurfaceRLE(mSurface, enabled ? 1 : 0) == 0;
   }
 
+  /**
+   * Sets the palette of an indexed surface, e.g. to recolor an image by swapping palettes.
+   *
+   * The palette is shared with the surface, so changes to the palette affect the surface.
+   *
+   * \param palette the palette that will be used by the surface.
+   *
+   * \return `success` if the palette was set; `failure` otherwise.
+   */
+  auto set_palette(const palette& palette) noexcept -> result
+  {
+    return SDL_SetSurfacePalette(mSurface, palette.get()) == 0;
+  }
+
   [[nodiscard]] auto alpha() const noexcept -> uint8
   {
     uint8 alpha {0xFF};
@@ -363,6 +521,24 @@ class basic_surface final {
     }
   }
 
+  /* Invokes a kernel for each row of pixels, if the format has an 8-bit alpha channel */
+  template <typename Kernel>
+  auto for_each_alpha_row(Kernel&& kernel) noexcept -> result
+  {
+    const auto alphaIndex = detail::alpha_byte_index(*mSurface->format);
+    if (!alphaIndex || !lock()) {
+      return failure;
+    }
+
+    auto* row = static_cast<uint8*>(mSurface->pixels);
+    for (int y = 0; y < mSurface->h; ++y, row += mSurface->pitch) {
+      kernel(*alphaIndex, row, static_cast<usize>(mSurface->w));
+    }
+
+    unlock();
+    return success;
+  }
+
 #ifdef CENTURION_MOCK_FRIENDLY_MODE
 
  public:
@@ -386,12 +562,16 @@ template <typename T>
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_surface<T>& surface) -> std::ostream&
 {
   return stream << to_string(surface);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
 #endif  // CENTURION_VIDEO_SURFACE_HPP_
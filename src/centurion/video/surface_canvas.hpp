@@ -0,0 +1,466 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_SURFACE_CANVAS_HPP_
+#define CENTURION_VIDEO_SURFACE_CANVAS_HPP_
+
+#include <SDL.h>
+
+#include <cassert>  // assert
+#include <vector>   // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/color_kernels.hpp"
+#include "../detail/draw_kernels.hpp"
+#include "../detail/pixel_conversion.hpp"
+#include "../detail/stdlib.hpp"
+#include "color.hpp"
+#include "pixels.hpp"
+#include "surface.hpp"
+#include "surface_ops.hpp"
+
+namespace cen {
+
+/**
+ * Draws shapes and glyphs directly into the pixels of a surface, without a renderer.
+ *
+ * This is intended for headless use, e.g. rendering thumbnails or minimaps on a server. All
+ * drawing is clipped to the clip rectangle of the surface. Fills work with any pixel format,
+ * and use vectorized span kernels for 32-bit formats. Blending is vectorized for 32-bit
+ * formats with 8-bit channels, such as `rgba32` or `rgb888`, other formats go through
+ * `SDL_GetRGBA()` and `SDL_MapRGBA()` for each pixel.
+ *
+ * Large rectangles are split into bands of rows that are drawn by the workers of a thread
+ * pool, if one is provided. The surface is locked for the lifetime of the canvas.
+ *
+ * \see surface
+ * \see software_canvas
+ */
+class surface_canvas final {
+ public:
+  /// The minimum amount of pixels of a rectangle before it's drawn in parallel.
+  inline constexpr static int parallel_threshold = 256 * 256;
+
+  CENTURION_DISABLE_COPY(surface_canvas)
+  CENTURION_DISABLE_MOVE(surface_canvas)
+
+  /**
+   * Creates a canvas that draws to a surface.
+   *
+   * \param surface the target surface, which must outlive the canvas.
+   * \param pool an optional thread pool used to draw large rectangles.
+   *
+   * \throws sdl_error if the surface cannot be locked.
+   */
+  template <typename T>
+  explicit surface_canvas(basic_surface<T>& surface, thread_pool* pool = nullptr)
+      : mSurface {surface.get()}
+      , mPool {pool}
+      , mLevel {detail::best_simd_level()}
+  {
+    assert(mSurface);
+
+    if (SDL_MUSTLOCK(mSurface) && SDL_LockSurface(mSurface) != 0) {
+      throw sdl_error {};
+    }
+
+    mBytesPerPixel = mSurface->format->BytesPerPixel;
+    mByteChannels = detail::has_byte_channels(*mSurface->format);
+  }
+
+  ~surface_canvas() noexcept
+  {
+    if (SDL_MUSTLOCK(mSurface)) {
+      SDL_UnlockSurface(mSurface);
+    }
+  }
+
+  /// Fills the clip rectangle with a color, replacing the previous pixels.
+  void clear(const color& color) { fill_rect(clip(), color); }
+
+  /**
+   * Fills a rectangle with a color, replacing the previous pixels.
+   *
+   * \param rect the rectangle that will be filled.
+   * \param color the fill color, including the alpha that will be stored.
+   */
+  void fill_rect(const irect& rect, const color& color)
+  {
+    const auto area = clipped(rect);
+    if (!area.has_area()) {
+      return;
+    }
+
+    const auto pixel = map(color, color.alpha());
+    for_each_band(area, [&](const int first, const int last) {
+      for (auto y = first; y < last; ++y) {
+        detail::fill_span(mLevel,
+                          mBytesPerPixel,
+                          pixel_at(area.x(), y),
+                          pixel,
+                          static_cast<usize>(area.width()));
+      }
+    });
+  }
+
+  /**
+   * Blends a color over a rectangle, using the alpha of the color.
+   *
+   * \param rect the rectangle that will be blended.
+   * \param color the color that will be blended over the previous pixels.
+   */
+  void blend_rect(const irect& rect, const color& color)
+  {
+    if (color.alpha() == 0xFF) {
+      return fill_rect(rect, color);
+    }
+
+    const auto area = clipped(rect);
+    if (!area.has_area() || color.alpha() == 0) {
+      return;
+    }
+
+    const auto pixel = map(color, 0xFF);
+    for_each_band(area, [&](const int first, const int last) {
+      for (auto y = first; y < last; ++y) {
+        if (mByteChannels) {
+          detail::blend_span(mLevel,
+                             pixel_at(area.x(), y),
+                             pixel,
+                             static_cast<usize>(area.width()),
+                             color.alpha());
+        }
+        else {
+          for (auto x = area.x(); x < area.max_x(); ++x) {
+            blend_pixel(pixel_at(x, y), color, color.alpha());
+          }
+        }
+      }
+    });
+  }
+
+  /**
+   * Draws a horizontal line, which is blended if the color is translucent.
+   *
+   * \param start the leftmost point of the line.
+   * \param length the amount of pixels in the line.
+   * \param color the color of the line.
+   */
+  void draw_hline(const ipoint& start, const int length, const color& color)
+  {
+    blend_rect({start, {length, 1}}, color);
+  }
+
+  /**
+   * Draws a vertical line, which is blended if the color is translucent.
+   *
+   * \param start the topmost point of the line.
+   * \param length the amount of pixels in the line.
+   * \param color the color of the line.
+   */
+  void draw_vline(const ipoint& start, const int length, const color& color)
+  {
+    blend_rect({start, {1, length}}, color);
+  }
+
+  /**
+   * Draws a line between two points, which is blended if the color is translucent.
+   *
+   * Both end points are included. Horizontal and vertical lines are drawn as spans, other
+   * lines are rasterized using Bresenham's algorithm.
+   *
+   * \param from the start point of the line.
+   * \param to the end point of the line.
+   * \param color the color of the line.
+   */
+  void draw_line(const ipoint& from, const ipoint& to, const color& color)
+  {
+    if (from.y() == to.y()) {
+      const auto x = (detail::min)(from.x(), to.x());
+      return draw_hline({x, from.y()}, detail::abs(to.x() - from.x()) + 1, color);
+    }
+    else if (from.x() == to.x()) {
+      const auto y = (detail::min)(from.y(), to.y());
+      return draw_vline({from.x(), y}, detail::abs(to.y() - from.y()) + 1, color);
+    }
+
+    if (color.alpha() == 0) {
+      return;
+    }
+
+    const auto bounds = clip();
+    const auto opaque = color.alpha() == 0xFF;
+    const auto pixel = map(color, opaque ? color.alpha() : 0xFF);
+
+    const auto dx = detail::abs(to.x() - from.x());
+    const auto dy = -detail::abs(to.y() - from.y());
+    const auto sx = (from.x() < to.x()) ? 1 : -1;
+    const auto sy = (from.y() < to.y()) ? 1 : -1;
+
+    auto x = from.x();
+    auto y = from.y();
+    auto error = dx + dy;
+
+    while (true) {
+      if (x >= bounds.x() && y >= bounds.y() && x < bounds.max_x() && y < bounds.max_y()) {
+        plot(pixel_at(x, y), pixel, color, opaque);
+      }
+
+      if (x == to.x() && y == to.y()) {
+        break;
+      }
+
+      const auto twice = 2 * error;
+      if (twice >= dy) {
+        error += dy;
+        x += sx;
+      }
+
+      if (twice <= dx) {
+        error += dx;
+        y += sy;
+      }
+    }
+  }
+
+  /**
+   * Draws the outline of a rectangle, which is blended if the color is translucent.
+   *
+   * \param rect the rectangle that will be outlined.
+   * \param color the color of the outline.
+   */
+  void draw_rect(const irect& rect, const color& color)
+  {
+    if (rect.width() <= 0 || rect.height() <= 0) {
+      return;
+    }
+
+    /* The edges don't overlap, so translucent corners aren't blended twice */
+    draw_hline(rect.position(), rect.width(), color);
+
+    if (rect.height() > 1) {
+      draw_hline({rect.x(), rect.max_y() - 1}, rect.width(), color);
+      draw_vline({rect.x(), rect.y() + 1}, rect.height() - 2, color);
+
+      if (rect.width() > 1) {
+        draw_vline({rect.max_x() - 1, rect.y() + 1}, rect.height() - 2, color);
+      }
+    }
+  }
+
+  /**
+   * Blends a glyph over the surface, using the alpha channel of the glyph as coverage.
+   *
+   * The glyph is tinted with the color, whose alpha scales the coverage. This is intended for
+   * surfaces rendered with `font::render_blended()`, which are white with antialiased alpha.
+   * Glyphs without an 8-bit alpha channel are converted first, e.g. the color keyed output
+   * of `font::render_solid()`.
+   *
+   * \param glyph the glyph surface.
+   * \param position the position of the top-left corner of the glyph.
+   * \param color the color of the glyph.
+   *
+   * \throws sdl_error if the glyph had to be converted, and the conversion failed.
+   */
+  template <typename T>
+  void draw_glyph(const basic_surface<T>& glyph, const ipoint& position, const color& color)
+  {
+    const auto alphaIndex = detail::alpha_byte_index(*glyph.get()->format);
+    if (!alphaIndex || glyph.must_lock()) {
+      return draw_glyph(glyph.convert_to(pixel_format::argb8888), position, color);
+    }
+
+    const auto area = clipped({position, glyph.size()});
+    if (!area.has_area() || color.alpha() == 0) {
+      return;
+    }
+
+    const auto* source = glyph.get();
+    const auto offset = area.position() - position;
+    const auto pixel = map(color, 0xFF);
+
+    for_each_band(area, [&](const int first, const int last) {
+      const auto width = static_cast<usize>(area.width());
+      std::vector<uint8> coverage(width);
+
+      for (auto y = first; y < last; ++y) {
+        const auto sourceY = y - position.y();
+        const auto* row = static_cast<const uint8*>(source->pixels) +
+                          sourceY * source->pitch + offset.x() * 4 + *alphaIndex;
+
+        for (usize index = 0; index < width; ++index) {
+          coverage[index] = detail::multiply_channel(row[index * 4], color.alpha());
+        }
+
+        if (mByteChannels) {
+          detail::cover_span(mLevel, pixel_at(area.x(), y), pixel, coverage.data(), width);
+        }
+        else {
+          for (usize index = 0; index < width; ++index) {
+            blend_pixel(pixel_at(area.x() + static_cast<int>(index), y),
+                        color,
+                        coverage[index]);
+          }
+        }
+      }
+    });
+  }
+
+  void set_thread_pool(thread_pool* pool) noexcept { mPool = pool; }
+
+  [[nodiscard]] auto get_thread_pool() const noexcept -> thread_pool* { return mPool; }
+
+  /// Returns the clip rectangle of the surface, which limits all drawing.
+  [[nodiscard]] auto clip() const noexcept -> irect { return irect {mSurface->clip_rect}; }
+
+  [[nodiscard]] auto size() const noexcept -> iarea { return {mSurface->w, mSurface->h}; }
+
+  /// Indicates whether blending uses the vectorized kernels.
+  [[nodiscard]] auto has_fast_blending() const noexcept -> bool { return mByteChannels; }
+
+ private:
+  SDL_Surface* mSurface {};
+  thread_pool* mPool {};
+  detail::simd_level mLevel {detail::simd_level::scalar};
+  int mBytesPerPixel {};
+  bool mByteChannels {};
+
+  [[nodiscard]] auto clipped(const irect& rect) const noexcept -> irect
+  {
+    const auto bounds = clip();
+
+    const auto minX = (detail::max)(rect.x(), bounds.x());
+    const auto minY = (detail::max)(rect.y(), bounds.y());
+    const auto maxX = (detail::min)(rect.max_x(), bounds.max_x());
+    const auto maxY = (detail::min)(rect.max_y(), bounds.max_y());
+
+    if (minX >= maxX || minY >= maxY) {
+      return {};
+    }
+    else {
+      return {minX, minY, maxX - minX, maxY - minY};
+    }
+  }
+
+  [[nodiscard]] auto map(const color& color, const uint8 alpha) const noexcept -> uint32
+  {
+    return SDL_MapRGBA(mSurface->format, color.red(), color.green(), color.blue(), alpha);
+  }
+
+  [[nodiscard]] auto pixel_at(const int x, const int y) const noexcept -> uint8*
+  {
+    return static_cast<uint8*>(mSurface->pixels) + y * mSurface->pitch + x * mBytesPerPixel;
+  }
+
+  [[nodiscard]] auto load(const uint8* pixel) const noexcept -> uint32
+  {
+    switch (mBytesPerPixel) {
+      case 1:
+        return detail::load_pixel<1>(pixel);
+
+      case 2:
+        return detail::load_pixel<2>(pixel);
+
+      case 3:
+        return detail::load_pixel<3>(pixel);
+
+      default:
+        return detail::load_pixel<4>(pixel);
+    }
+  }
+
+  void store(uint8* pixel, const uint32 value) const noexcept
+  {
+    switch (mBytesPerPixel) {
+      case 1:
+        return detail::store_pixel<1>(pixel, value);
+
+      case 2:
+        return detail::store_pixel<2>(pixel, value);
+
+      case 3:
+        return detail::store_pixel<3>(pixel, value);
+
+      default:
+        return detail::store_pixel<4>(pixel, value);
+    }
+  }
+
+  /* Blends a single pixel of any format, by converting it to a color and back */
+  void blend_pixel(uint8* pixel, const color& color, const uint8 weight) const noexcept
+  {
+    uint8 red {};
+    uint8 green {};
+    uint8 blue {};
+    uint8 alpha {};
+    SDL_GetRGBA(load(pixel), mSurface->format, &red, &green, &blue, &alpha);
+
+    store(pixel,
+          SDL_MapRGBA(mSurface->format,
+                      detail::blend_channel(red, color.red(), weight),
+                      detail::blend_channel(green, color.green(), weight),
+                      detail::blend_channel(blue, color.blue(), weight),
+                      detail::blend_channel(alpha, 0xFF, weight)));
+  }
+
+  void plot(uint8* target, const uint32 pixel, const color& color, const bool opaque) const
+      noexcept
+  {
+    if (opaque) {
+      store(target, pixel);
+    }
+    else if (mByteChannels) {
+      detail::blend_span_scalar(target, pixel, 1, color.alpha());
+    }
+    else {
+      blend_pixel(target, color, color.alpha());
+    }
+  }
+
+  /* Invokes a kernel with ranges of rows, which are split into bands for large areas */
+  template <typename Kernel>
+  void for_each_band(const irect& area, const Kernel& kernel)
+  {
+    if (!mPool || area.width() * area.height() < parallel_threshold) {
+      return kernel(area.y(), area.max_y());
+    }
+
+    const auto bandHeight = detail::band_height(*mPool, area.height());
+    const auto bands = static_cast<usize>((area.height() + bandHeight - 1) / bandHeight);
+
+    mPool->parallel_for(0, bands, [&](const usize band) {
+      const auto first = area.y() + static_cast<int>(band) * bandHeight;
+      kernel(first, (detail::min)(first + bandHeight, area.max_y()));
+    }, 1);
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_SURFACE_CANVAS_HPP_
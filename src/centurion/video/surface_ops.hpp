@@ -0,0 +1,521 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_SURFACE_OPS_HPP_
+#define CENTURION_VIDEO_SURFACE_OPS_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>  // fill
+#include <atomic>     // atomic, memory_order_relaxed
+#include <cassert>    // assert
+#include <cmath>      // floor, log2, lround
+#include <numeric>    // gcd
+#include <vector>     // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "pixels.hpp"
+#include "surface.hpp"
+
+/* Software compositing helpers for surfaces. The parallel variants split the destination
+   into horizontal bands, which are processed by the workers of a thread pool. */
+
+namespace cen {
+
+namespace detail {
+
+/* Rows per band, chosen so that every worker gets a few bands to balance the load */
+[[nodiscard]] inline auto band_height(const thread_pool& pool, const int rows) noexcept
+    -> int
+{
+  const auto bands = static_cast<int>(pool.size() * 4);
+  return (detail::max)((rows + bands - 1) / bands, 16);
+}
+
+/* SDL only locks surfaces for RLE acceleration, the lock count isn't thread-safe */
+[[nodiscard]] inline auto can_blit_in_parallel(SDL_Surface* source,
+                                               SDL_Surface* destination) noexcept -> bool
+{
+  return source != destination && !SDL_MUSTLOCK(source) && !SDL_MUSTLOCK(destination);
+}
+
+[[nodiscard]] inline auto is_within(const irect& rect, const irect& bounds) noexcept -> bool
+{
+  return rect.x() >= bounds.x() && rect.y() >= bounds.y() &&
+         rect.max_x() <= bounds.max_x() && rect.max_y() <= bounds.max_y();
+}
+
+/* The source pixels covered by each target pixel, with weights normalized to one */
+struct box_filter final {
+  std::vector<int> first;      ///< The first source pixel of each target pixel.
+  std::vector<usize> offsets;  ///< The offset into the weights of each target pixel.
+  std::vector<float> weights;  ///< The weights of the covered source pixels.
+
+  [[nodiscard]] auto taps(const int target) const noexcept -> usize
+  {
+    const auto index = static_cast<usize>(target);
+    return offsets[index + 1] - offsets[index];
+  }
+};
+
+[[nodiscard]] inline auto make_box_filter(const int source, const int target) -> box_filter
+{
+  box_filter filter;
+  filter.first.reserve(static_cast<usize>(target));
+  filter.offsets.reserve(static_cast<usize>(target) + 1);
+  filter.offsets.push_back(0);
+
+  const auto scale = static_cast<double>(source) / static_cast<double>(target);
+
+  for (int index = 0; index < target; ++index) {
+    const auto begin = index * scale;
+    const auto end = (detail::min)((index + 1) * scale, static_cast<double>(source));
+
+    const auto first = static_cast<int>(std::floor(begin));
+    filter.first.push_back(first);
+
+    for (auto pixel = first; pixel < end; ++pixel) {
+      const auto coverage =
+          (detail::min)(end, pixel + 1.0) - (detail::max)(begin, static_cast<double>(pixel));
+      filter.weights.push_back(static_cast<float>(coverage / scale));
+    }
+
+    filter.offsets.push_back(filter.weights.size());
+  }
+
+  return filter;
+}
+
+/* Filters a range of target rows of a 32-bit surface, channel by channel */
+inline void box_filter_rows(const SDL_Surface& source,
+                            SDL_Surface& target,
+                            const box_filter& columns,
+                            const box_filter& rows,
+                            const int firstRow,
+                            const int lastRow)
+{
+  const auto sourceWidth = static_cast<usize>(source.w);
+  std::vector<float> accumulated(sourceWidth * 4);
+
+  for (auto y = firstRow; y < lastRow; ++y) {
+    std::fill(accumulated.begin(), accumulated.end(), 0.0f);
+
+    /* Vertical pass, into a single row of accumulated channels */
+    const auto rowTaps = rows.taps(y);
+    for (usize tap = 0; tap < rowTaps; ++tap) {
+      const auto weight = rows.weights[rows.offsets[static_cast<usize>(y)] + tap];
+      const auto sourceRow = rows.first[static_cast<usize>(y)] + static_cast<int>(tap);
+      const auto* pixels = static_cast<const uint8*>(source.pixels) + sourceRow * source.pitch;
+
+      for (usize index = 0; index < sourceWidth * 4; ++index) {
+        accumulated[index] += weight * static_cast<float>(pixels[index]);
+      }
+    }
+
+    /* Horizontal pass, straight into the target row */
+    auto* output = static_cast<uint8*>(target.pixels) + y * target.pitch;
+    for (int x = 0; x < target.w; ++x, output += 4) {
+      float channels[4] {};
+
+      const auto columnTaps = columns.taps(x);
+      for (usize tap = 0; tap < columnTaps; ++tap) {
+        const auto weight = columns.weights[columns.offsets[static_cast<usize>(x)] + tap];
+        const auto column = static_cast<usize>(columns.first[static_cast<usize>(x)]) + tap;
+
+        for (usize channel = 0; channel < 4; ++channel) {
+          channels[channel] += weight * accumulated[column * 4 + channel];
+        }
+      }
+
+      for (usize channel = 0; channel < 4; ++channel) {
+        const auto value = (detail::min)(channels[channel] + 0.5f, 255.0f);
+        output[channel] = static_cast<uint8>(value);
+      }
+    }
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Copies a surface onto another surface.
+ *
+ * \param source the surface that will be copied.
+ * \param destination the surface that will be copied onto.
+ * \param position the position of the source surface in the destination surface.
+ *
+ * \return `success` if the surface was copied; `failure` otherwise.
+ */
+template <typename T, typename U>
+auto blit(const basic_surface<T>& source,
+          basic_surface<U>& destination,
+          const ipoint& position = {}) noexcept -> result
+{
+  irect dst {position, {0, 0}};
+  return SDL_BlitSurface(source.get(), nullptr, destination.get(), dst.data()) == 0;
+}
+
+/// Copies a region of a surface onto another surface.
+template <typename T, typename U>
+auto blit(const basic_surface<T>& source,
+          const irect& region,
+          basic_surface<U>& destination,
+          const ipoint& position) noexcept -> result
+{
+  irect dst {position, {0, 0}};
+  return SDL_BlitSurface(source.get(), region.data(), destination.get(), dst.data()) == 0;
+}
+
+/**
+ * Copies a surface onto another surface, scaling it to fill the destination surface.
+ *
+ * SDL uses nearest-neighbour sampling, see `downscale()` for a filtered alternative.
+ *
+ * \param source the surface that will be copied.
+ * \param destination the surface that will be copied onto.
+ *
+ * \return `success` if the surface was copied; `failure` otherwise.
+ */
+template <typename T, typename U>
+auto blit_scaled(const basic_surface<T>& source, basic_surface<U>& destination) noexcept
+    -> result
+{
+  return SDL_BlitScaled(source.get(), nullptr, destination.get(), nullptr) == 0;
+}
+
+/// Copies a region of a surface onto a region of another surface, scaling it to fit.
+template <typename T, typename U>
+auto blit_scaled(const basic_surface<T>& source,
+                 const irect& region,
+                 basic_surface<U>& destination,
+                 const irect& target) noexcept -> result
+{
+  irect dst = target;
+  return SDL_BlitScaled(source.get(), region.data(), destination.get(), dst.data()) == 0;
+}
+
+/**
+ * Copies a region of a surface onto another surface, using a thread pool.
+ *
+ * The source region is split into bands that are copied concurrently, the calling thread
+ * copies the first band and then helps the workers. Surfaces with RLE acceleration are
+ * copied by the calling thread alone.
+ *
+ * \param pool the thread pool that will copy the bands.
+ * \param source the surface that will be copied.
+ * \param region the region of the source surface that will be copied.
+ * \param destination the surface that will be copied onto.
+ * \param position the position of the source region in the destination surface.
+ *
+ * \return `success` if every band was copied; `failure` otherwise.
+ */
+template <typename T, typename U>
+auto parallel_blit(thread_pool& pool,
+                   const basic_surface<T>& source,
+                   const irect& region,
+                   basic_surface<U>& destination,
+                   const ipoint& position) -> result
+{
+  if (!detail::can_blit_in_parallel(source.get(), destination.get())) {
+    return blit(source, region, destination, position);
+  }
+
+  const auto bandHeight = detail::band_height(pool, region.height());
+  const auto bands = (region.height() + bandHeight - 1) / bandHeight;
+
+  const auto blitBand = [&](const int band) {
+    const auto offset = band * bandHeight;
+    const irect rows {region.x(),
+                      region.y() + offset,
+                      region.width(),
+                      (detail::min)(bandHeight, region.height() - offset)};
+    return blit(source, rows, destination, {position.x(), position.y() + offset});
+  };
+
+  /* The first blit prepares the blit map of the source, which the workers only read */
+  if (bands <= 0 || !blitBand(0)) {
+    return failure;
+  }
+
+  std::atomic<bool> ok {true};
+  const auto task = [&](const usize band) {
+    if (!blitBand(static_cast<int>(band))) {
+      ok.store(false, std::memory_order_relaxed);
+    }
+  };
+
+  pool.parallel_for(1, static_cast<usize>(bands), task, 1);
+  return ok.load(std::memory_order_relaxed);
+}
+
+/// Copies a surface onto another surface, using a thread pool.
+template <typename T, typename U>
+auto parallel_blit(thread_pool& pool,
+                   const basic_surface<T>& source,
+                   basic_surface<U>& destination,
+                   const ipoint& position = {}) -> result
+{
+  return parallel_blit(pool, source, irect {{0, 0}, source.size()}, destination, position);
+}
+
+/**
+ * Copies a region of a surface onto a region of another surface scaled, using a thread pool.
+ *
+ * The target region is split into bands whose edges line up exactly with source rows, so
+ * the result is the same as a single scaled blit. This requires that the regions lie within
+ * the surfaces and the destination clip, and that the heights share a common divisor above
+ * one; otherwise the calling thread performs the blit alone. Parallel scaled blits also
+ * require SDL 2.0.16, since older versions of `SDL_SoftStretch()` are not reentrant.
+ *
+ * \param pool the thread pool that will copy the bands.
+ * \param source the surface that will be copied.
+ * \param region the region of the source surface that will be copied.
+ * \param destination the surface that will be copied onto.
+ * \param target the region of the destination surface that will be filled.
+ *
+ * \return `success` if every band was copied; `failure` otherwise.
+ */
+template <typename T, typename U>
+auto parallel_blit_scaled(thread_pool& pool,
+                          const basic_surface<T>& source,
+                          const irect& region,
+                          basic_surface<U>& destination,
+                          const irect& target) -> result
+{
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+  const auto units = std::gcd(region.height(), target.height());
+#else
+  const auto units = 1;
+#endif  // SDL_VERSION_ATLEAST(2, 0, 16)
+
+  if (units <= 1 || !detail::can_blit_in_parallel(source.get(), destination.get()) ||
+      !detail::is_within(region, irect {{0, 0}, source.size()}) ||
+      !detail::is_within(target, destination.clip())) {
+    return blit_scaled(source, region, destination, target);
+  }
+
+  const auto sourceUnit = region.height() / units;
+  const auto targetUnit = target.height() / units;
+  const auto unitsPerBand =
+      (detail::max)(detail::band_height(pool, target.height()) / targetUnit, 1);
+  const auto bands = (units + unitsPerBand - 1) / unitsPerBand;
+
+  /* The regions are already clipped, so the lower blit is used to avoid clipping each band
+     again, which could round the band edges differently */
+  const auto blitBand = [&](const int band) {
+    const auto first = band * unitsPerBand;
+    const auto count = (detail::min)(unitsPerBand, units - first);
+
+    irect src {region.x(), region.y() + first * sourceUnit, region.width(), 0};
+    src.set_height(count * sourceUnit);
+
+    irect dst {target.x(), target.y() + first * targetUnit, target.width(), 0};
+    dst.set_height(count * targetUnit);
+
+    return SDL_LowerBlitScaled(source.get(), src.data(), destination.get(), dst.data()) == 0;
+  };
+
+  if (!blitBand(0)) {
+    return failure;
+  }
+
+  std::atomic<bool> ok {true};
+  const auto task = [&](const usize band) {
+    if (!blitBand(static_cast<int>(band))) {
+      ok.store(false, std::memory_order_relaxed);
+    }
+  };
+
+  pool.parallel_for(1, static_cast<usize>(bands), task, 1);
+  return ok.load(std::memory_order_relaxed);
+}
+
+/// Copies a surface scaled to fill another surface, using a thread pool.
+template <typename T, typename U>
+auto parallel_blit_scaled(thread_pool& pool,
+                          const basic_surface<T>& source,
+                          basic_surface<U>& destination) -> result
+{
+  return parallel_blit_scaled(pool,
+                              source,
+                              irect {{0, 0}, source.size()},
+                              destination,
+                              irect {{0, 0}, destination.size()});
+}
+
+/**
+ * Creates a filtered copy of a surface with another size, using a thread pool.
+ *
+ * Every target pixel is the area-weighted average of the source pixels it covers, which
+ * avoids the aliasing of nearest-neighbour scaling. This is intended for thumbnails and mip
+ * levels, premultiply the source first to avoid dark fringes around transparent pixels.
+ *
+ * Surfaces that don't use four bytes per pixel are converted to `argb8888` first.
+ *
+ * \param pool the thread pool that will filter the rows.
+ * \param source the surface that will be filtered.
+ * \param size the size of the created surface.
+ *
+ * \return a surface of the requested size, with the pixel format of the source surface.
+ *
+ * \throws sdl_error if the surfaces cannot be created or locked.
+ */
+template <typename T>
+[[nodiscard]] auto downscale(thread_pool& pool,
+                             const basic_surface<T>& source,
+                             const iarea& size) -> surface
+{
+  assert(size.width > 0);
+  assert(size.height > 0);
+
+  if (source.get()->format->BytesPerPixel != 4) {
+    return downscale(pool, source.convert_to(pixel_format::argb8888), size);
+  }
+
+  auto input = surface_handle {source.get()};
+  if (!input.lock()) {
+    throw sdl_error {};
+  }
+
+  surface output {size, source.format_info().format()};
+  output.set_blend_mode(source.get_blend_mode());
+
+  const auto columns = detail::make_box_filter(source.width(), size.width);
+  const auto rows = detail::make_box_filter(source.height(), size.height);
+
+  try {
+    const auto bandHeight = detail::band_height(pool, size.height);
+    const auto bands = static_cast<usize>((size.height + bandHeight - 1) / bandHeight);
+
+    const auto task = [&](const usize band) {
+      const auto first = static_cast<int>(band) * bandHeight;
+      const auto last = (detail::min)(first + bandHeight, size.height);
+      detail::box_filter_rows(*input.get(), *output.get(), columns, rows, first, last);
+    };
+
+    pool.parallel_for(0, bands, task, 1);
+  }
+  catch (...) {
+    input.unlock();
+    throw;
+  }
+
+  input.unlock();
+  return output;
+}
+
+/**
+ * Creates the mip chain of a surface, using a thread pool.
+ *
+ * Each level halves the size of the previous level, rounding down, until the size is 1x1.
+ * The levels are filtered with `downscale()`, each one from the previous level.
+ *
+ * \param pool the thread pool that will filter the levels.
+ * \param source the surface at the base of the chain, which isn't included.
+ *
+ * \return the mip levels, ordered from largest to smallest.
+ */
+template <typename T>
+[[nodiscard]] auto make_mip_chain(thread_pool& pool, const basic_surface<T>& source)
+    -> std::vector<surface>
+{
+  std::vector<surface> levels;
+
+  auto size = source.size();
+  while (size.width > 1 || size.height > 1) {
+    size.width = (detail::max)(size.width / 2, 1);
+    size.height = (detail::max)(size.height / 2, 1);
+
+    if (levels.empty()) {
+      levels.push_back(downscale(pool, source, size));
+    }
+    else {
+      levels.push_back(downscale(pool, levels.back(), size));
+    }
+  }
+
+  return levels;
+}
+
+/**
+ * Selects the mip level to use when an image is drawn at a specific scale.
+ *
+ * The selected level is the smallest level that is still at least as large as the drawn
+ * image, e.g. a scale of 0.5 selects the first halved level, and a scale of 0.6 selects the
+ * full size level.
+ *
+ * \param scale the amount of output pixels per full size image pixel.
+ * \param levelCount the amount of levels, including the full size level.
+ * \param bias an offset added to the selected level, positive values prefer smaller levels.
+ *
+ * \return the index of the selected level, where zero is the full size level.
+ */
+[[nodiscard]] inline auto select_mip_level(const float scale,
+                                           const usize levelCount,
+                                           const float bias = 0) noexcept -> usize
+{
+  if (levelCount == 0) {
+    return 0;
+  }
+
+  if (!(scale > 0)) {
+    return levelCount - 1;
+  }
+
+  const auto level = std::floor(bias - std::log2(scale));
+  if (level <= 0) {
+    return 0;
+  }
+  else {
+    return (detail::min)(static_cast<usize>(level), levelCount - 1);
+  }
+}
+
+namespace detail {
+
+/* Maps a region of a full size image to the corresponding region of a mip level */
+[[nodiscard]] inline auto mip_source(const irect& source,
+                                     const iarea& base,
+                                     const iarea& level) noexcept -> irect
+{
+  const auto sx = static_cast<double>(level.width) / static_cast<double>(base.width);
+  const auto sy = static_cast<double>(level.height) / static_cast<double>(base.height);
+
+  const auto x = static_cast<int>(std::floor(source.x() * sx));
+  const auto y = static_cast<int>(std::floor(source.y() * sy));
+  const auto maxX = (detail::max)(static_cast<int>(std::lround(source.max_x() * sx)), x + 1);
+  const auto maxY = (detail::max)(static_cast<int>(std::lround(source.max_y() * sy)), y + 1);
+
+  return {x, y, maxX - x, maxY - y};
+}
+
+}  // namespace detail
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_SURFACE_OPS_HPP_
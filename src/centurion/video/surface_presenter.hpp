@@ -0,0 +1,242 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_SURFACE_PRESENTER_HPP_
+#define CENTURION_VIDEO_SURFACE_PRESENTER_HPP_
+
+#include <SDL.h>
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../events/window_events.hpp"
+#include "damage_tracker.hpp"
+#include "surface.hpp"
+#include "surface_canvas.hpp"
+#include "window.hpp"
+
+namespace cen {
+
+/**
+ * Renders into the surface of a window in software, and presents only what changed.
+ *
+ * This avoids the renderer entirely, which is considerably faster than the software renderer
+ * on machines without usable GPU drivers, e.g. virtual machines and thin clients. Frames are
+ * drawn with a `surface_canvas` directly into the window surface, and only the damaged areas
+ * are copied to the screen.
+ *
+ * SDL invalidates the window surface when the window is resized, so the surface is acquired
+ * again before each redraw. A new surface has undefined contents, so the whole window is
+ * marked as damaged whenever the surface changes. The window must not have a renderer.
+ *
+ * \see surface_canvas
+ * \see damage_tracker
+ */
+class surface_presenter final {
+ public:
+  /**
+   * Creates a presenter for the surface of a window.
+   *
+   * The surface is acquired lazily, by the first call to `acquire()` or `redraw()`.
+   *
+   * \param window the window that will be presented to, which must outlive the presenter.
+   * \param pool an optional thread pool used to draw large rectangles.
+   * \param maxRects the maximum amount of separate damaged areas, see `damage_tracker`.
+   */
+  template <typename T>
+  explicit surface_presenter(basic_window<T>& window,
+                             thread_pool* pool = nullptr,
+                             const usize maxRects = 16)
+      : mWindow {window.get()}
+      , mPool {pool}
+      , mDamage {iarea {0, 0}, maxRects}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(surface_presenter)
+  CENTURION_DISABLE_MOVE(surface_presenter)
+
+  /**
+   * Returns the window surface, which is acquired again if it was invalidated.
+   *
+   * \return the window surface; a null handle if the surface isn't available.
+   */
+  [[nodiscard]] auto acquire() -> surface_handle
+  {
+    auto target = mWindow.get_surface();
+
+    if (target && (mDirty || target.get() != mSurface || target.size() != mDamage.bounds())) {
+      mSurface = target.get();
+      mDamage.resize(target.size());
+      mDirty = false;
+    }
+
+    return target;
+  }
+
+  /**
+   * Redraws each damaged area of the window surface.
+   *
+   * The clip of the surface is restricted to each area while the callable is invoked, so
+   * drawing outside of the area has no effect. The damaged areas are kept until the next
+   * call to `present()`.
+   *
+   * \param callable the function object invoked for each damaged area, with the signature
+   *        `void(surface_canvas&, const irect&)`.
+   *
+   * \return `success` if the surface was acquired; `failure` otherwise.
+   *
+   * \throws sdl_error if the surface cannot be locked.
+   */
+  template <typename Callable>
+  auto redraw(Callable&& callable) -> result
+  {
+    auto target = acquire();
+    if (!target) {
+      return failure;
+    }
+
+    if (mDamage.empty()) {
+      return success;
+    }
+
+    const auto previous = target.clip();
+
+    try {
+      surface_canvas canvas {target, mPool};
+
+      for (const auto& rect : mDamage.rects()) {
+        SDL_SetClipRect(target.get(), rect.data());
+        callable(canvas, rect);
+      }
+    }
+    catch (...) {
+      SDL_SetClipRect(target.get(), previous.data());
+      throw;
+    }
+
+    SDL_SetClipRect(target.get(), previous.data());
+    return success;
+  }
+
+  /**
+   * Copies the damaged areas of the window surface to the screen, and clears the damage.
+   *
+   * The whole surface is updated at once if it's entirely damaged, otherwise only the
+   * damaged areas are updated. If the surface was invalidated after it was acquired, e.g.
+   * by a resize, nothing is presented and the presenter prepares a full redraw.
+   *
+   * \return `success` if the surface was presented; `failure` otherwise.
+   */
+  auto present() -> result
+  {
+    if (mDamage.empty()) {
+      return success;
+    }
+
+    const auto& rects = mDamage.rects();
+    const irect all {{0, 0}, mDamage.bounds()};
+
+    const auto ok = (rects.size() == 1 && rects.front() == all)
+                        ? mWindow.update_surface()
+                        : mWindow.update_surface(rects);
+
+    if (ok) {
+      mDamage.clear();
+      return success;
+    }
+    else {
+      mDirty = true;
+      return failure;
+    }
+  }
+
+  /**
+   * Redraws the damaged areas, and presents them.
+   *
+   * \see redraw()
+   * \see present()
+   */
+  template <typename Callable>
+  auto render(Callable&& callable) -> result
+  {
+    if (redraw(callable)) {
+      return present();
+    }
+    else {
+      return failure;
+    }
+  }
+
+  /**
+   * Marks an area of the window as damaged, so that it's redrawn and presented.
+   *
+   * Areas added before the surface is acquired are discarded, since the whole surface is
+   * damaged at that point.
+   *
+   * \param area the damaged area, in window surface coordinates.
+   */
+  void add_damage(const irect& area) { mDamage.add(area); }
+
+  /// Marks the whole window as damaged.
+  void invalidate() { mDamage.invalidate(); }
+
+  /// Schedules a full redraw when the window has been resized or exposed.
+  void handle(const window_event& event) noexcept
+  {
+    switch (event.event_id()) {
+      case window_event_id::resized:
+      case window_event_id::size_changed:
+      case window_event_id::exposed:
+        mDirty = true;
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  void set_thread_pool(thread_pool* pool) noexcept { mPool = pool; }
+
+  [[nodiscard]] auto get_thread_pool() const noexcept -> thread_pool* { return mPool; }
+
+  /// Returns the damaged areas that haven't been presented yet.
+  [[nodiscard]] auto damage() const noexcept -> const damage_tracker& { return mDamage; }
+
+  /// Returns the size of the most recently acquired surface.
+  [[nodiscard]] auto size() const noexcept -> iarea { return mDamage.bounds(); }
+
+ private:
+  window_handle mWindow;
+  thread_pool* mPool {};
+  SDL_Surface* mSurface {};  ///< The last acquired surface, only used for comparisons.
+  damage_tracker mDamage;
+  bool mDirty {true};
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_SURFACE_PRESENTER_HPP_
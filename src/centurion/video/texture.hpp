@@ -29,14 +29,16 @@
 
 #include <cassert>      // assert
 #include <cstddef>      // size_t
-#include <ostream>      // ostream
+#include <iterator>     // back_inserter, ostreambuf_iterator
 #include <string>       // string, to_string
 #include <string_view>  // string_view
 
 #include "../common/errors.hpp"
+#include "../common/formatting.hpp"
 #include "../common/math.hpp"
 #include "../common/primitives.hpp"
 #include "../common/result.hpp"
+#include "../common/utils.hpp"
 #include "../detail/owner_handle_api.hpp"
 #include "../detail/stdlib.hpp"
 #include "../features.hpp"
@@ -46,10 +48,16 @@
 
 #if CENTURION_HAS_FEATURE_FORMAT
 
-#include <format>  // format
+#include <format>  // format_to, formatter
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 enum class texture_access {
@@ -75,11 +83,15 @@ enum class texture_access {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const texture_access access) -> std::ostream&
 {
   return stream << to_string(access);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 #if SDL_VERSION_ATLEAST(2, 0, 12)
 
 enum class scale_mode {
@@ -105,16 +117,50 @@ enum class scale_mode {
   }
 }
 
+#ifndef CENTURION_NO_IOSTREAM
+
 inline auto operator<<(std::ostream& stream, const scale_mode mode) -> std::ostream&
 {
   return stream << to_string(mode);
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 #endif  // SDL_VERSION_ATLEAST(2, 0, 12)
 
 template <typename T>
 class basic_texture;
 
+namespace detail {
+
+/// Shadow copies of texture state, used to skip redundant state changes.
+struct texture_state final {
+  maybe<color> color_mod;
+  maybe<uint8> alpha_mod;
+  maybe<blend_mode> blend;
+  bool enabled {};
+
+  void invalidate() noexcept
+  {
+    color_mod.reset();
+    alpha_mod.reset();
+    blend.reset();
+  }
+
+  template <typename Value>
+  void update(maybe<Value>& cached, const Value& value, const bool ok) noexcept
+  {
+    if (enabled && ok) {
+      cached = value;
+    }
+    else {
+      cached.reset();
+    }
+  }
+};
+
+}  // namespace detail
+
 using texture = basic_texture<detail::owner_tag>;
 using texture_handle = basic_texture<detail::handle_tag>;
 
@@ -149,18 +195,65 @@ class basic_texture final {
   {
   }
 
-  void set_alpha_mod(const uint8 alpha) noexcept { SDL_SetTextureAlphaMod(mTexture, alpha); }
+  void set_alpha_mod(const uint8 alpha) noexcept
+  {
+    if (mState.enabled && mState.alpha_mod == alpha) {
+      return;
+    }
+
+    const auto ok = SDL_SetTextureAlphaMod(mTexture, alpha) == 0;
+    mState.update(mState.alpha_mod, alpha, ok);
+  }
 
   void set_color_mod(const color& color) noexcept
   {
-    SDL_SetTextureColorMod(mTexture, color.red(), color.green(), color.blue());
+    /* The alpha component is ignored, so it doesn't take part in the comparison */
+    const cen::color mod {color.red(), color.green(), color.blue()};
+    if (mState.enabled && mState.color_mod == mod) {
+      return;
+    }
+
+    const auto ok =
+        SDL_SetTextureColorMod(mTexture, color.red(), color.green(), color.blue()) == 0;
+    mState.update(mState.color_mod, mod, ok);
   }
 
   void set_blend_mode(const blend_mode mode) noexcept
   {
-    SDL_SetTextureBlendMode(mTexture, static_cast<SDL_BlendMode>(mode));
+    if (mState.enabled && mState.blend == mode) {
+      return;
+    }
+
+    const auto ok = SDL_SetTextureBlendMode(mTexture, static_cast<SDL_BlendMode>(mode)) == 0;
+    mState.update(mState.blend, mode, ok);
+  }
+
+  /**
+   * Enables or disables caching of the color modulation, alpha modulation and blend mode.
+   *
+   * When enabled, the texture remembers the latest modulation and blend mode, and skips calls
+   * that would not change anything, which is useful when the same texture is tinted over and
+   * over. The getters also return the cached values without querying SDL.
+   *
+   * Note, the cache is only aware of changes made through this texture instance. Call
+   * `invalidate_state_cache()` if the state may have been changed in other ways, e.g. through
+   * another handle or raw SDL calls. To render differently tinted copies of a texture in a
+   * single geometry call, use per-vertex colors instead, see `sprite_batch`.
+   *
+   * \param enabled `true` if the state should be cached; `false` otherwise.
+   */
+  void set_state_caching(const bool enabled) noexcept
+  {
+    mState.invalidate();
+    mState.enabled = enabled;
   }
 
+  /// Forgets all cached state, so that the next state changes are always forwarded to SDL.
+  void invalidate_state_cache() noexcept { mState.invalidate(); }
+
+  /// Indicates whether the texture caches its modulation and blend mode.
+  [[nodiscard]] auto is_caching_state() const noexcept -> bool { return mState.enabled; }
+
 #if SDL_VERSION_ATLEAST(2, 0, 12)
 
   void set_scale_mode(const scale_mode mode) noexcept
@@ -170,6 +263,64 @@ class basic_texture final {
 
 #endif  // SDL_VERSION_ATLEAST(2, 0, 12)
 
+  /**
+   * Updates the entire texture with new pixel data.
+   *
+   * This is fairly slow, prefer locking streaming textures with `texture_lock` if the texture
+   * is updated frequently.
+   *
+   * \param pixels the pixel data, in the format of the texture.
+   * \param pitch the number of bytes in a row of pixel data.
+   *
+   * \return `success` if the texture was updated; `failure` otherwise.
+   */
+  auto update(const void* pixels, const int pitch) noexcept -> result
+  {
+    assert(pixels);
+    return SDL_UpdateTexture(mTexture, nullptr, pixels, pitch) == 0;
+  }
+
+  /// Updates a region of the texture with new pixel data.
+  auto update(const irect& region, const void* pixels, const int pitch) noexcept -> result
+  {
+    assert(pixels);
+    return SDL_UpdateTexture(mTexture, region.data(), pixels, pitch) == 0;
+  }
+
+  /// Updates a region of a planar YV12 or IYUV texture with new pixel data.
+  auto update_yuv(const irect& region,
+                  const uint8* yPlane,
+                  const int yPitch,
+                  const uint8* uPlane,
+                  const int uPitch,
+                  const uint8* vPlane,
+                  const int vPitch) noexcept -> result
+  {
+    return SDL_UpdateYUVTexture(mTexture,
+                                region.data(),
+                                yPlane,
+                                yPitch,
+                                uPlane,
+                                uPitch,
+                                vPlane,
+                                vPitch) == 0;
+  }
+
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+
+  /// Updates a region of a planar NV12 or NV21 texture with new pixel data.
+  auto update_nv(const irect& region,
+                 const uint8* yPlane,
+                 const int yPitch,
+                 const uint8* uvPlane,
+                 const int uvPitch) noexcept -> result
+  {
+    return SDL_UpdateNVTexture(mTexture, region.data(), yPlane, yPitch, uvPlane, uvPitch) ==
+           0;
+  }
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 16)
+
 #if SDL_VERSION_ATLEAST(2, 0, 18)
 
   auto set_user_data(void* data) noexcept -> result
@@ -230,6 +381,10 @@ class basic_texture final {
 
   [[nodiscard]] auto alpha_mod() const noexcept -> uint8
   {
+    if (mState.alpha_mod) {
+      return *mState.alpha_mod;
+    }
+
     uint8 alpha {};
     SDL_GetTextureAlphaMod(mTexture, &alpha);
     return alpha;
@@ -237,6 +392,10 @@ class basic_texture final {
 
   [[nodiscard]] auto color_mod() const noexcept -> color
   {
+    if (mState.color_mod) {
+      return *mState.color_mod;
+    }
+
     uint8 red {};
     uint8 green {};
     uint8 blue {};
@@ -246,6 +405,10 @@ class basic_texture final {
 
   [[nodiscard]] auto get_blend_mode() const noexcept -> blend_mode
   {
+    if (mState.blend) {
+      return *mState.blend;
+    }
+
     SDL_BlendMode mode {};
     SDL_GetTextureBlendMode(mTexture, &mode);
     return static_cast<blend_mode>(mode);
@@ -286,29 +449,154 @@ class basic_texture final {
 
  private:
   detail::pointer<T, SDL_Texture> mTexture;
+  detail::texture_state mState;
 };
 
-template <typename T>
-[[nodiscard]] auto to_string(const basic_texture<T>& texture) -> std::string
+/**
+ * An RAII style lock that provides write-only access to the pixels of a streaming texture.
+ *
+ * The texture is unlocked when the lock is destroyed, which uploads the pixel data. Note, the
+ * pixel data that is exposed by the lock is not necessarily the previous contents of the
+ * texture, so every locked pixel should be written.
+ *
+ * \see basic_texture::is_streaming
+ */
+class texture_lock final {
+ public:
+  /**
+   * Locks an entire streaming texture.
+   *
+   * \param texture the streaming texture that will be locked.
+   *
+   * \throws sdl_error if the texture cannot be locked.
+   */
+  template <typename T>
+  CENTURION_NODISCARD_CTOR explicit texture_lock(basic_texture<T>& texture)
+      : mTexture {texture.get()}
+      , mSize {texture.size()}
+  {
+    if (SDL_LockTexture(mTexture, nullptr, &mPixels, &mPitch) != 0) {
+      throw sdl_error {};
+    }
+  }
+
+  /**
+   * Locks a region of a streaming texture.
+   *
+   * \param texture the streaming texture that will be locked.
+   * \param region the region of the texture that will be locked.
+   *
+   * \throws sdl_error if the texture cannot be locked.
+   */
+  template <typename T>
+  CENTURION_NODISCARD_CTOR texture_lock(basic_texture<T>& texture, const irect& region)
+      : mTexture {texture.get()}
+      , mSize {region.size()}
+  {
+    if (SDL_LockTexture(mTexture, region.data(), &mPixels, &mPitch) != 0) {
+      throw sdl_error {};
+    }
+  }
+
+  CENTURION_DISABLE_COPY(texture_lock)
+  CENTURION_DISABLE_MOVE(texture_lock)
+
+  ~texture_lock() noexcept { SDL_UnlockTexture(mTexture); }
+
+  /// Returns a pointer to the first byte of a row of pixels.
+  [[nodiscard]] auto row(const int y) noexcept -> uint8*
+  {
+    assert(y >= 0 && y < mSize.height);
+    return static_cast<uint8*>(mPixels) + (static_cast<usize>(y) * static_cast<usize>(mPitch));
+  }
+
+  /**
+   * Returns a row of pixels, interpreted as a specific pixel type.
+   *
+   * \tparam Pixel the pixel type, e.g. `uint32` for 32-bit pixel formats.
+   *
+   * \param y the index of the row.
+   *
+   * \return a pointer to the first pixel in the row.
+   */
+  template <typename Pixel>
+  [[nodiscard]] auto row_as(const int y) noexcept -> Pixel*
+  {
+    return reinterpret_cast<Pixel*>(row(y));
+  }
+
+  /// Returns the raw locked pixel data.
+  [[nodiscard]] auto pixels() noexcept -> void* { return mPixels; }
+
+  /// Returns the number of bytes in a row of pixel data.
+  [[nodiscard]] auto pitch() const noexcept -> int { return mPitch; }
+
+  /// Returns the size of the locked region.
+  [[nodiscard]] auto size() const noexcept -> iarea { return mSize; }
+
+  /// Returns the total number of bytes of locked pixel data.
+  [[nodiscard]] auto byte_count() const noexcept -> usize
+  {
+    return static_cast<usize>(mPitch) * static_cast<usize>(mSize.height);
+  }
+
+ private:
+  SDL_Texture* mTexture {};
+  void* mPixels {};
+  int mPitch {};
+  iarea mSize {};
+};
+
+/**
+ * Writes a textual representation of a texture to an output iterator, without allocating.
+ *
+ * \return the output iterator past the last written character.
+ */
+template <typename OutputIt, typename T>
+auto format_to(OutputIt out, const basic_texture<T>& texture) -> OutputIt
 {
 #if CENTURION_HAS_FEATURE_FORMAT
-  return std::format("texture(data: {}, width: {}, height: {})",
-                     detail::address_of(texture.get()),
-                     texture.width(),
-                     texture.height());
+  out = detail::write_text(out, "texture(data: ");
+  out = detail::write_address(out, texture.get());
+  return std::format_to(out, ", width: {}, height: {})", texture.width(), texture.height());
 #else
-  return "texture(data: " + detail::address_of(texture.get()) +
-         ", width: " + std::to_string(texture.width()) +
-         ", height: " + std::to_string(texture.height()) + ")";
+  out = detail::write_text(out, "texture(data: ");
+  out = detail::write_address(out, texture.get());
+  out = detail::write_text(out, ", width: ");
+  out = detail::write_number(out, texture.width());
+  out = detail::write_text(out, ", height: ");
+  out = detail::write_number(out, texture.height());
+  return detail::write_text(out, ")");
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+template <typename T>
+[[nodiscard]] auto to_string(const basic_texture<T>& texture) -> std::string
+{
+  std::string result;
+  format_to(std::back_inserter(result), texture);
+  return result;
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_texture<T>& texture) -> std::ostream&
 {
-  return stream << to_string(texture);
+  format_to(std::ostreambuf_iterator<char> {stream}, texture);
+  return stream;
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 }  // namespace cen
 
+#if CENTURION_HAS_FEATURE_FORMAT
+
+template <typename T>
+struct std::formatter<cen::basic_texture<T>>
+    : cen::detail::value_formatter<cen::basic_texture<T>> {};
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
 #endif  // CENTURION_VIDEO_TEXTURE_HPP_
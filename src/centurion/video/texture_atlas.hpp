@@ -0,0 +1,284 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_TEXTURE_ATLAS_HPP_
+#define CENTURION_VIDEO_TEXTURE_ATLAS_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>  // sort
+#include <string>     // string, to_string
+#include <utility>    // move
+#include <vector>     // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../detail/skyline_packer.hpp"
+#include "../features.hpp"
+#include "atlas_region.hpp"
+#include "blend.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+#include "texture.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/**
+ * Packs several images into a small amount of large textures.
+ *
+ * Images are first added to the atlas, which returns an identifier for each image. The pending
+ * images are then packed into pages and uploaded to the GPU by `build()`, after which the
+ * regions of the images can be obtained using their identifiers. Each page is uploaded
+ * exactly once, and images added after a build end up in new pages.
+ *
+ * Rendering several atlas regions that share a page doesn't require any texture changes,
+ * which makes it possible for SDL to batch the render calls.
+ *
+ * \see atlas_region
+ */
+class texture_atlas final {
+ public:
+  using id_type = usize;
+  using size_type = usize;
+
+  /**
+   * Creates an empty texture atlas.
+   *
+   * \param pageSize the size of each atlas page.
+   * \param padding the amount of empty pixels between images.
+   */
+  explicit texture_atlas(const iarea& pageSize = {2048, 2048}, const int padding = 1)
+      : mPageSize {pageSize}
+      , mPadding {padding}
+  {
+    if (pageSize.width <= 0 || pageSize.height <= 0) {
+      throw exception {"Invalid texture atlas page size!"};
+    }
+  }
+
+  /**
+   * Adds an image to the atlas.
+   *
+   * \param image the image that will be added, must not be larger than a page.
+   *
+   * \return the identifier of the image.
+   *
+   * \throws exception if the image is larger than an atlas page.
+   */
+  auto add(surface image) -> id_type
+  {
+    const auto size = image.size();
+    if (size.width + (2 * mPadding) > mPageSize.width ||
+        size.height + (2 * mPadding) > mPageSize.height) {
+      throw exception {"Image is too large for texture atlas page!"};
+    }
+
+    const auto id = mRegions.size();
+
+    mRegions.push_back({nullptr, irect {0, 0, size.width, size.height}, 0});
+    mPending.push_back({id, std::move(image)});
+
+    return id;
+  }
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+  /// Loads an image and adds it to the atlas.
+  auto add(const char* file) -> id_type
+  {
+    assert(file);
+    return add(surface {file});
+  }
+
+  auto add(const std::string& file) -> id_type { return add(file.c_str()); }
+
+#endif  // CENTURION_NO_SDL_IMAGE
+
+  /**
+   * Packs all pending images into atlas pages, and uploads the pages.
+   *
+   * \param renderer the renderer used to create the page textures.
+   *
+   * \throws sdl_error if an image cannot be copied to a page.
+   */
+  template <typename T>
+  void build(const basic_renderer<T>& renderer)
+  {
+    if (mPending.empty()) {
+      return;
+    }
+
+    /* Packing the tallest images first yields a flatter skyline */
+    std::sort(mPending.begin(), mPending.end(), [](const pending& a, const pending& b) {
+      return a.image.height() > b.image.height();
+    });
+
+    std::vector<surface> pages;
+    std::vector<detail::skyline_packer> packers;
+
+    for (auto& [id, image] : mPending) {
+      const iarea padded {image.width() + (2 * mPadding), image.height() + (2 * mPadding)};
+
+      maybe<ipoint> position;
+      usize index {};
+
+      for (; index < packers.size(); ++index) {
+        position = packers[index].insert(padded);
+        if (position) {
+          break;
+        }
+      }
+
+      if (!position) {
+        pages.emplace_back(mPageSize, pixel_format::rgba32);
+        pages.back().set_blend_mode(blend_mode::none);
+
+        packers.emplace_back(mPageSize);
+        position = packers.back().insert(padded);
+
+        index = packers.size() - 1u;
+      }
+
+      auto& region = mRegions[id];
+      region.page = mPages.size() + index;
+      region.source.set_position({position->x() + mPadding, position->y() + mPadding});
+
+      /* Copy the pixels as they are, including the alpha channel */
+      image.set_blend_mode(blend_mode::none);
+
+      SDL_Rect dst {region.source.x(), region.source.y(), 0, 0};
+      if (SDL_BlitSurface(image.get(), nullptr, pages[index].get(), &dst) != 0) {
+        throw sdl_error {};
+      }
+    }
+
+    for (const auto& page : pages) {
+      auto& texture = mPages.emplace_back(renderer.make_texture(page));
+      texture.set_blend_mode(blend_mode::blend);
+    }
+
+    for (const auto& [id, image] : mPending) {
+      auto& region = mRegions[id];
+      region.texture = mPages.at(region.page).get();
+    }
+
+    mPending.clear();
+  }
+
+  /**
+   * Returns the region associated with an image.
+   *
+   * Note, the region of an image is not associated with a texture until the atlas is built.
+   *
+   * \param id the identifier of the image.
+   *
+   * \return the region of the image.
+   *
+   * \throws std::out_of_range if the identifier is invalid.
+   */
+  [[nodiscard]] auto region(const id_type id) const -> const atlas_region&
+  {
+    return mRegions.at(id);
+  }
+
+  /// Returns the region associated with an image, if the identifier is valid.
+  [[nodiscard]] auto find_region(const id_type id) const noexcept -> const atlas_region*
+  {
+    return (id < mRegions.size()) ? &mRegions[id] : nullptr;
+  }
+
+  /// Returns the texture for an atlas page.
+  [[nodiscard]] auto page(const size_type index) const -> const texture&
+  {
+    return mPages.at(index);
+  }
+
+  /// Returns the texture for an atlas page, if the index is valid.
+  [[nodiscard]] auto find_page(const size_type index) const noexcept -> const texture*
+  {
+    return (index < mPages.size()) ? &mPages[index] : nullptr;
+  }
+
+  /// Returns the amount of uploaded atlas pages.
+  [[nodiscard]] auto page_count() const noexcept -> size_type { return mPages.size(); }
+
+  /// Returns the amount of images in the atlas, including pending images.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mRegions.size(); }
+
+  /// Returns the amount of images that have not been uploaded yet.
+  [[nodiscard]] auto pending_count() const noexcept -> size_type { return mPending.size(); }
+
+  [[nodiscard]] auto page_size() const noexcept -> const iarea& { return mPageSize; }
+
+  [[nodiscard]] auto padding() const noexcept -> int { return mPadding; }
+
+ private:
+  struct pending final {
+    id_type id {};
+    surface image;
+  };
+
+  iarea mPageSize;
+  int mPadding {};
+  std::vector<atlas_region> mRegions;
+  std::vector<texture> mPages;
+  std::vector<pending> mPending;
+};
+
+[[nodiscard]] inline auto to_string(const texture_atlas& atlas) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("texture_atlas(size: {}, pages: {})", atlas.size(), atlas.page_count());
+#else
+  return "texture_atlas(size: " + std::to_string(atlas.size()) +
+         ", pages: " + std::to_string(atlas.page_count()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const texture_atlas& atlas) -> std::ostream&
+{
+  return stream << to_string(atlas);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_TEXTURE_ATLAS_HPP_
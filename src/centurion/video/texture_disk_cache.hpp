@@ -0,0 +1,455 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_TEXTURE_DISK_CACHE_HPP_
+#define CENTURION_VIDEO_TEXTURE_DISK_CACHE_HPP_
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+#include <SDL.h>
+
+#include <cassert>      // assert
+#include <cstdio>       // snprintf, remove, rename
+#include <cstring>      // memcpy, memcmp
+#include <string>       // string
+#include <string_view>  // string_view
+#include <utility>      // move
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/hash.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../detail/lz4.hpp"
+#include "../io/asset_pack.hpp"
+#include "../io/file.hpp"
+#include "../io/file_mode.hpp"
+#include "../io/mapped_file.hpp"
+#include "../system/endian.hpp"
+#include "blend.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+#include "texture.hpp"
+
+namespace cen {
+
+namespace detail {
+
+/* All integers in a cache blob are stored in little-endian byte order. A blob consists of a
+   header followed by the rows of pixel data without padding, optionally compressed as a
+   single LZ4 block.
+
+   Header (56 bytes): magic[4], version (u32), pixel format (u32), width (u32), height (u32),
+                      blend mode (u32), compression (u32), reserved (u32), source hash (u64),
+                      pixel data size (u64), stored size (u64).
+*/
+inline constexpr char texture_cache_magic[4] = {'C', 'T', 'E', 'X'};
+inline constexpr uint32 texture_cache_version = 1;
+inline constexpr usize texture_cache_header_size = 56;
+
+inline constexpr uint32 texture_cache_raw = 0;
+inline constexpr uint32 texture_cache_lz4 = 1;
+
+/* A validated view of a cache blob */
+struct texture_cache_blob final {
+  pixel_format format {pixel_format::unknown};
+  iarea size;
+  blend_mode blend {blend_mode::none};
+  uint32 compression {};
+  usize rowSize {};
+  usize pixelSize {};
+  const uint8* data {};
+  usize storedSize {};
+};
+
+[[nodiscard]] inline auto parse_texture_cache_blob(const mapped_file& file,
+                                                   const uint64 hash,
+                                                   const pixel_format format) noexcept
+    -> maybe<texture_cache_blob>
+{
+  const auto* data = file.data();
+  const auto fileSize = file.size();
+
+  if (!file || fileSize < texture_cache_header_size ||
+      std::memcmp(data, texture_cache_magic, sizeof texture_cache_magic) != 0 ||
+      read_little_endian<uint32>(data + 4) != texture_cache_version ||
+      read_little_endian<uint32>(data + 8) != to_underlying(format) ||
+      read_little_endian<uint64>(data + 32) != hash) {
+    return nothing;
+  }
+
+  texture_cache_blob blob;
+  blob.format = format;
+  blob.size.width = static_cast<int>(read_little_endian<uint32>(data + 12));
+  blob.size.height = static_cast<int>(read_little_endian<uint32>(data + 16));
+  blob.blend = static_cast<blend_mode>(read_little_endian<uint32>(data + 20));
+  blob.compression = read_little_endian<uint32>(data + 24);
+  blob.rowSize = static_cast<usize>(blob.size.width) *
+                 static_cast<usize>(SDL_BYTESPERPIXEL(to_underlying(format)));
+  blob.pixelSize = static_cast<usize>(read_little_endian<uint64>(data + 40));
+  blob.storedSize = static_cast<usize>(read_little_endian<uint64>(data + 48));
+  blob.data = data + texture_cache_header_size;
+
+  const auto expectedSize = blob.rowSize * static_cast<usize>(blob.size.height);
+
+  if (blob.size.width <= 0 || blob.size.height <= 0 || blob.pixelSize != expectedSize ||
+      blob.storedSize != fileSize - texture_cache_header_size ||
+      (blob.compression == texture_cache_raw && blob.storedSize != blob.pixelSize) ||
+      blob.compression > texture_cache_lz4) {
+    return nothing;
+  }
+
+  return blob;
+}
+
+}  // namespace detail
+
+/**
+ * Caches decoded and converted images on disk, so that later launches skip decoding.
+ *
+ * Each image is stored as a raw blob of pixel data in the target pixel format, optionally
+ * compressed with LZ4, and keyed by a hash of the encoded source data and the pixel format.
+ * Loading an image hashes its source data, and if a valid blob exists, the blob is mapped
+ * into memory and uploaded straight into a texture, without any image decoding or pixel
+ * conversion. Otherwise, the image is decoded, converted, stored and then uploaded.
+ *
+ * \code{cpp}
+ * const auto format = cen::get_info(renderer)->get_format(0);
+ * cen::texture_disk_cache cache {cen::preferred_path("org", "game").copy()};
+ *
+ * const auto texture = cache.load(renderer, "art/castle.png", format);
+ * \endcode
+ *
+ * \details The cache directory must exist. Blobs are written to a temporary file that is
+ *          renamed when it's complete, so an interrupted write never leaves a truncated blob.
+ *          Corrupt or stale blobs are detected when they are loaded, and are replaced. Images
+ *          with a color key or RLE acceleration are never cached, since the pixel data alone
+ *          cannot reproduce them.
+ *
+ * \see mapped_file
+ */
+class texture_disk_cache final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a cache that uses the specified directory.
+   *
+   * \param directory the directory that stores the blobs, with or without a trailing
+   *        separator.
+   * \param compress indicates whether new blobs are compressed with LZ4.
+   */
+  explicit texture_disk_cache(std::string directory, const bool compress = true)
+      : mDirectory {std::move(directory)}
+      , mCompress {compress}
+  {
+    if (!mDirectory.empty() && mDirectory.back() != '/' && mDirectory.back() != '\\') {
+      mDirectory += '/';
+    }
+  }
+
+  /**
+   * Loads an image file as a texture, using the cache if possible.
+   *
+   * \param renderer the renderer used to create the texture.
+   * \param path the path of the image file.
+   * \param format the pixel format of the texture, usually a format of the renderer.
+   *
+   * \return the loaded texture.
+   *
+   * \throws exception if the image file cannot be read.
+   * \throws img_error if the image cannot be decoded.
+   * \throws sdl_error if the image cannot be converted or uploaded.
+   */
+  template <typename T>
+  auto load(const basic_renderer<T>& renderer, const char* path, const pixel_format format)
+      -> texture
+  {
+    assert(path);
+
+    const mapped_file source {path};
+    if (!source) {
+      throw exception {"Failed to read image file!"};
+    }
+
+    auto view = source.view();
+    return load(renderer, view, source.data(), source.size(), format);
+  }
+
+  template <typename T>
+  auto load(const basic_renderer<T>& renderer,
+            const std::string& path,
+            const pixel_format format) -> texture
+  {
+    return load(renderer, path.c_str(), format);
+  }
+
+  /**
+   * Loads an image in an asset pack as a texture, using the cache if possible.
+   *
+   * \param renderer the renderer used to create the texture.
+   * \param pack the asset pack that contains the image.
+   * \param name the name of the pack entry.
+   * \param format the pixel format of the texture, usually a format of the renderer.
+   *
+   * \return the loaded texture.
+   *
+   * \throws exception if there is no such entry.
+   * \throws img_error if the image cannot be decoded.
+   * \throws sdl_error if the image cannot be converted or uploaded.
+   */
+  template <typename T>
+  auto load(const basic_renderer<T>& renderer,
+            const asset_pack& pack,
+            const std::string_view name,
+            const pixel_format format) -> texture
+  {
+    const auto entry = pack.find(name);
+    if (!entry) {
+      throw exception {"Failed to find image in asset pack!"};
+    }
+
+    auto view = pack.open(*entry);
+    if (!view) {
+      throw exception {"Failed to open image in asset pack!"};
+    }
+
+    return load(renderer, view, pack.data(*entry), entry->stored_size, format);
+  }
+
+  /**
+   * Creates a texture from a cached blob.
+   *
+   * \param renderer the renderer used to create the texture.
+   * \param hash the hash of the encoded source data, see `source_hash()`.
+   * \param format the pixel format of the texture.
+   *
+   * \return the texture; an empty optional if there is no valid blob.
+   *
+   * \throws sdl_error if the texture cannot be created.
+   */
+  template <typename T>
+  auto find(const basic_renderer<T>& renderer, const uint64 hash, const pixel_format format)
+      -> maybe<texture>
+  {
+    const mapped_file file {path_of(hash, format)};
+
+    const auto blob = detail::parse_texture_cache_blob(file, hash, format);
+    if (!blob) {
+      return nothing;
+    }
+
+    const auto* pixels = blob->data;
+    if (blob->compression == detail::texture_cache_lz4) {
+      mScratch.resize(blob->pixelSize);
+      if (!detail::lz4_decompress(blob->data,
+                                  blob->storedSize,
+                                  mScratch.data(),
+                                  mScratch.size())) {
+        return nothing;
+      }
+
+      pixels = mScratch.data();
+    }
+
+    auto result = renderer.make_texture(blob->size, format, texture_access::non_lockable);
+    if (!result.update(pixels, static_cast<int>(blob->rowSize))) {
+      throw sdl_error {};
+    }
+
+    result.set_blend_mode(blob->blend);
+    return result;
+  }
+
+  /**
+   * Stores a decoded image in the cache.
+   *
+   * \param hash the hash of the encoded source data, see `source_hash()`.
+   * \param image the decoded image, which is converted to the pixel format if necessary.
+   * \param format the pixel format of the stored pixel data.
+   *
+   * \return `success` if the image was stored; `failure` otherwise.
+   *
+   * \throws sdl_error if the image cannot be converted.
+   */
+  template <typename T>
+  auto store(const uint64 hash, const basic_surface<T>& image, const pixel_format format)
+      -> result
+  {
+    if (image.format_info().format() != format) {
+      return store(hash, image.convert_to(format), format);
+    }
+
+    if (SDL_HasColorKey(image.get()) || image.must_lock()) {
+      return failure;
+    }
+
+    const auto rowSize = static_cast<usize>(image.width()) *
+                         static_cast<usize>(SDL_BYTESPERPIXEL(to_underlying(format)));
+    const auto pixelSize = rowSize * static_cast<usize>(image.height());
+
+    /* The rows are packed without padding, which is also the layout used for compression */
+    mScratch.resize(pixelSize);
+
+    const auto* rows = static_cast<const uint8*>(image.pixel_data());
+    for (int y = 0; y < image.height(); ++y) {
+      std::memcpy(mScratch.data() + (static_cast<usize>(y) * rowSize),
+                  rows + (static_cast<usize>(y) * static_cast<usize>(image.pitch())),
+                  rowSize);
+    }
+
+    const uint8* stored = mScratch.data();
+    usize storedSize = pixelSize;
+    auto compression = detail::texture_cache_raw;
+
+    if (mCompress) {
+      mCompressed.resize(detail::lz4_compress_bound(pixelSize));
+      const auto compressedSize = detail::lz4_compress(mScratch.data(),
+                                                       pixelSize,
+                                                       mCompressed.data(),
+                                                       mCompressed.size());
+
+      /* Incompressible images are stored as-is, since decompressing would be wasted work */
+      if (compressedSize != 0 && compressedSize < pixelSize) {
+        stored = mCompressed.data();
+        storedSize = compressedSize;
+        compression = detail::texture_cache_lz4;
+      }
+    }
+
+    uint8 header[detail::texture_cache_header_size] {};
+    std::memcpy(header, detail::texture_cache_magic, sizeof detail::texture_cache_magic);
+    detail::write_little_endian(header + 4, detail::texture_cache_version);
+    detail::write_little_endian(header + 8, to_underlying(format));
+    detail::write_little_endian(header + 12, static_cast<uint32>(image.width()));
+    detail::write_little_endian(header + 16, static_cast<uint32>(image.height()));
+    detail::write_little_endian(header + 20, static_cast<uint32>(image.get_blend_mode()));
+    detail::write_little_endian(header + 24, compression);
+    detail::write_little_endian(header + 32, hash);
+    detail::write_little_endian(header + 40, static_cast<uint64>(pixelSize));
+    detail::write_little_endian(header + 48, static_cast<uint64>(storedSize));
+
+    const auto path = path_of(hash, format);
+    const auto temporary = path + ".tmp";
+
+    {
+      file blob {temporary, file_mode::wb};
+      if (!blob) {
+        return failure;
+      }
+
+      const auto ok = blob.write(header) == sizeof header &&
+                      blob.write(stored, storedSize) == storedSize && blob.close();
+      if (!ok) {
+        std::remove(temporary.c_str());
+        return failure;
+      }
+    }
+
+    /* Renaming doesn't replace existing files on all platforms */
+    std::remove(path.c_str());
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+      std::remove(temporary.c_str());
+      return failure;
+    }
+
+    return success;
+  }
+
+  /// Returns the hash of encoded source data, which is used as the cache key.
+  [[nodiscard]] static auto source_hash(const void* data, const size_type size) noexcept
+      -> uint64
+  {
+    return hash64(data, size);
+  }
+
+  /// Returns the path of the blob for a source hash and pixel format.
+  [[nodiscard]] auto path_of(const uint64 hash, const pixel_format format) const
+      -> std::string
+  {
+    char name[48] {};
+    std::snprintf(name,
+                  sizeof name,
+                  "%016llx_%08x.ctex",
+                  static_cast<unsigned long long>(hash),
+                  static_cast<unsigned>(to_underlying(format)));
+    return mDirectory + name;
+  }
+
+  /// Sets whether new blobs are compressed, existing blobs are not affected.
+  void set_compression(const bool compress) noexcept { mCompress = compress; }
+
+  [[nodiscard]] auto compression() const noexcept -> bool { return mCompress; }
+
+  [[nodiscard]] auto directory() const noexcept -> const std::string& { return mDirectory; }
+
+  /// Returns the amount of loads that were served by the cache.
+  [[nodiscard]] auto hits() const noexcept -> uint64 { return mHits; }
+
+  /// Returns the amount of loads that had to decode the image.
+  [[nodiscard]] auto misses() const noexcept -> uint64 { return mMisses; }
+
+ private:
+  std::string mDirectory;
+  std::vector<uint8> mScratch;
+  std::vector<uint8> mCompressed;
+  uint64 mHits {};
+  uint64 mMisses {};
+  bool mCompress {};
+
+  template <typename T>
+  auto load(const basic_renderer<T>& renderer,
+            file& source,
+            const uint8* data,
+            const size_type size,
+            const pixel_format format) -> texture
+  {
+    const auto hash = source_hash(data, size);
+
+    if (auto cached = find(renderer, hash, format)) {
+      ++mHits;
+      return std::move(*cached);
+    }
+
+    ++mMisses;
+
+    surface image {source};
+    if (image.format_info().format() != format) {
+      image = image.convert_to(format);
+    }
+
+    /* Failing to write the cache only costs performance, so it isn't reported */
+    static_cast<void>(store(hash, image, format));
+
+    return renderer.make_texture(image);
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_IMAGE
+#endif  // CENTURION_VIDEO_TEXTURE_DISK_CACHE_HPP_
@@ -0,0 +1,396 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_TEXTURE_MEMORY_HPP_
+#define CENTURION_VIDEO_TEXTURE_MEMORY_HPP_
+
+#include <SDL.h>
+
+#include <algorithm>      // partial_sort, stable_sort
+#include <cstddef>        // ptrdiff_t
+#include <functional>     // less
+#include <map>            // map
+#include <string>         // string, to_string
+#include <string_view>    // string_view
+#include <unordered_map>  // unordered_map
+#include <utility>        // move
+#include <vector>         // vector
+
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "pixels.hpp"
+#include "texture.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/**
+ * Estimates the amount of memory used by a texture.
+ *
+ * Packed formats use their bytes per pixel. Planar YUV formats store a full resolution luma
+ * plane and chroma planes at half the width and height, i.e. 12 bits per pixel, and packed
+ * YUV formats store two bytes per pixel with the width rounded up to an even number. The
+ * real usage depends on the driver, e.g. due to row alignment or padding of 24-bit formats,
+ * so the estimate is a lower bound.
+ *
+ * \param size the size of the texture.
+ * \param format the pixel format of the texture.
+ *
+ * \return the estimated amount of bytes; zero for unknown and external formats.
+ */
+[[nodiscard]] inline auto estimate_texture_bytes(const iarea& size,
+                                                 const pixel_format format) noexcept -> usize
+{
+  if (size.width <= 0 || size.height <= 0) {
+    return 0;
+  }
+
+  const auto width = static_cast<usize>(size.width);
+  const auto height = static_cast<usize>(size.height);
+  const auto halfWidth = (width + 1) / 2;
+  const auto halfHeight = (height + 1) / 2;
+
+  switch (format) {
+    case pixel_format::yv12:
+    case pixel_format::iyuv:
+    case pixel_format::nv12:
+    case pixel_format::nv21:
+      return (width * height) + (2 * halfWidth * halfHeight);
+
+    case pixel_format::yuy2:
+    case pixel_format::uyvy:
+    case pixel_format::yvyu:
+      return 4 * halfWidth * height;
+
+    case pixel_format::external_oes:
+      return 0;
+
+    default:
+      return width * height * SDL_BYTESPERPIXEL(to_underlying(format));
+  }
+}
+
+/// Estimates the amount of memory used by a texture.
+template <typename T>
+[[nodiscard]] auto estimate_texture_bytes(const basic_texture<T>& texture) noexcept -> usize
+{
+  return estimate_texture_bytes(texture.size(), texture.format());
+}
+
+/// Describes a texture tracked by a `texture_memory_registry`.
+struct texture_memory_entry final {
+  SDL_Texture* texture {};                      ///< The tracked texture.
+  std::string tag;                              ///< The group of the texture.
+  iarea size;                                   ///< The size of the texture.
+  pixel_format format {pixel_format::unknown};  ///< The pixel format of the texture.
+  usize bytes {};                               ///< The estimated memory usage.
+};
+
+/// The memory usage of a group of textures in a `texture_memory_registry`.
+struct texture_memory_tag final {
+  std::string name;  ///< The tag of the textures.
+  usize bytes {};    ///< The estimated memory used by the textures.
+  usize peak {};     ///< The largest amount of memory used by the textures at once.
+  usize count {};    ///< The amount of tracked textures.
+};
+
+/**
+ * Estimates the memory used by textures, and compares it to a budget.
+ *
+ * Textures are tracked explicitly, usually right after they are created, with an optional
+ * tag that groups them, e.g. "ui", "tiles" or "fonts". The registry reports the total, peak
+ * and per-tag usage, and the largest textures, which is useful to stay within the memory
+ * budget of integrated and mobile GPUs. The memory usage is estimated from the size and
+ * format of the textures, see `estimate_texture_bytes()`.
+ *
+ * The registry doesn't own the textures, and textures are not untracked automatically when
+ * they are destroyed, so `untrack()` should be called before a texture is destroyed.
+ * Tracking a texture that is already tracked replaces the previous entry, e.g. after the
+ * texture was recreated with another size.
+ *
+ * \see frame_stats_overlay::set_texture_memory
+ */
+class texture_memory_registry final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a registry.
+   *
+   * \param budget the memory budget in bytes, zero means that there is no budget.
+   */
+  explicit texture_memory_registry(const size_type budget = 0) noexcept : mBudget {budget} {}
+
+  /**
+   * Starts tracking a texture.
+   *
+   * \param texture the texture that will be tracked.
+   * \param tag the group of the texture, may be empty.
+   *
+   * \return the estimated memory usage of the texture.
+   */
+  template <typename T>
+  auto track(const basic_texture<T>& texture, std::string tag = {}) -> size_type
+  {
+    return track(texture.get(), texture.size(), texture.format(), std::move(tag));
+  }
+
+  /**
+   * Starts tracking a texture, described by its size and format.
+   *
+   * \param texture the texture that will be tracked.
+   * \param size the size of the texture.
+   * \param format the pixel format of the texture.
+   * \param tag the group of the texture, may be empty.
+   *
+   * \return the estimated memory usage of the texture.
+   */
+  auto track(SDL_Texture* texture,
+             const iarea& size,
+             const pixel_format format,
+             std::string tag = {}) -> size_type
+  {
+    untrack(texture);
+
+    const auto bytes = estimate_texture_bytes(size, format);
+
+    auto& group = mTags[tag];
+    group.bytes += bytes;
+    group.peak = (detail::max)(group.peak, group.bytes);
+    ++group.count;
+
+    mTotal += bytes;
+    mPeak = (detail::max)(mPeak, mTotal);
+
+    mEntries[texture] = texture_memory_entry {texture, std::move(tag), size, format, bytes};
+    return bytes;
+  }
+
+  /**
+   * Stops tracking a texture.
+   *
+   * \param texture the texture that will no longer be tracked.
+   *
+   * \return `true` if the texture was tracked; `false` otherwise.
+   */
+  auto untrack(SDL_Texture* texture) -> bool
+  {
+    const auto it = mEntries.find(texture);
+    if (it == mEntries.end()) {
+      return false;
+    }
+
+    const auto& entry = it->second;
+
+    /* Tags are kept after their last texture is untracked, to preserve their peak usage */
+    auto& group = mTags[entry.tag];
+    group.bytes -= entry.bytes;
+    --group.count;
+
+    mTotal -= entry.bytes;
+    mEntries.erase(it);
+
+    return true;
+  }
+
+  template <typename T>
+  auto untrack(const basic_texture<T>& texture) -> bool
+  {
+    return untrack(texture.get());
+  }
+
+  /// Stops tracking all textures, and resets all tags and the peak usage.
+  void clear() noexcept
+  {
+    mEntries.clear();
+    mTags.clear();
+    mTotal = 0;
+    mPeak = 0;
+  }
+
+  /// Resets the peak usage, of the registry and of every tag, to the current usage.
+  void reset_peak() noexcept
+  {
+    mPeak = mTotal;
+    for (auto& [name, group] : mTags) {
+      group.peak = group.bytes;
+    }
+  }
+
+  /**
+   * Returns the largest tracked textures.
+   *
+   * \param count the maximum amount of returned textures.
+   *
+   * \return the largest textures, ordered by their memory usage in descending order.
+   */
+  [[nodiscard]] auto largest(const size_type count) const -> std::vector<texture_memory_entry>
+  {
+    std::vector<const texture_memory_entry*> entries;
+    entries.reserve(mEntries.size());
+
+    for (const auto& [texture, entry] : mEntries) {
+      entries.push_back(&entry);
+    }
+
+    const auto n = (detail::min)(count, entries.size());
+    std::partial_sort(entries.begin(),
+                      entries.begin() + static_cast<std::ptrdiff_t>(n),
+                      entries.end(),
+                      [](const texture_memory_entry* a, const texture_memory_entry* b) {
+                        return a->bytes > b->bytes;
+                      });
+
+    std::vector<texture_memory_entry> result;
+    result.reserve(n);
+
+    for (size_type index = 0; index < n; ++index) {
+      result.push_back(*entries[index]);
+    }
+
+    return result;
+  }
+
+  /// Returns the usage of every tag, ordered by their memory usage in descending order.
+  [[nodiscard]] auto tags() const -> std::vector<texture_memory_tag>
+  {
+    std::vector<texture_memory_tag> result;
+    result.reserve(mTags.size());
+
+    for (const auto& [name, group] : mTags) {
+      result.push_back({name, group.bytes, group.peak, group.count});
+    }
+
+    std::stable_sort(result.begin(),
+                     result.end(),
+                     [](const texture_memory_tag& a, const texture_memory_tag& b) {
+                       return a.bytes > b.bytes;
+                     });
+
+    return result;
+  }
+
+  /// Returns the estimated memory used by the textures with a specific tag.
+  [[nodiscard]] auto tag_bytes(const std::string_view tag) const -> size_type
+  {
+    const auto it = mTags.find(tag);
+    return (it != mTags.end()) ? it->second.bytes : 0;
+  }
+
+  /// Returns the estimated memory used by a tracked texture.
+  [[nodiscard]] auto bytes_of(SDL_Texture* texture) const -> maybe<size_type>
+  {
+    const auto it = mEntries.find(texture);
+    if (it != mEntries.end()) {
+      return it->second.bytes;
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Sets the memory budget in bytes, zero means that there is no budget.
+  void set_budget(const size_type budget) noexcept { mBudget = budget; }
+
+  [[nodiscard]] auto budget() const noexcept -> size_type { return mBudget; }
+
+  /// Indicates whether a budget is set and the current usage exceeds it.
+  [[nodiscard]] auto over_budget() const noexcept -> bool
+  {
+    return mBudget != 0 && mTotal > mBudget;
+  }
+
+  /// Returns the current usage as a fraction of the budget, or zero if there is no budget.
+  [[nodiscard]] auto budget_usage() const noexcept -> double
+  {
+    return (mBudget != 0) ? static_cast<double>(mTotal) / static_cast<double>(mBudget) : 0.0;
+  }
+
+  /// Returns the estimated memory used by all tracked textures.
+  [[nodiscard]] auto total() const noexcept -> size_type { return mTotal; }
+
+  /// Returns the largest amount of memory used by the tracked textures at once.
+  [[nodiscard]] auto peak() const noexcept -> size_type { return mPeak; }
+
+  /// Returns the amount of tracked textures.
+  [[nodiscard]] auto count() const noexcept -> size_type { return mEntries.size(); }
+
+ private:
+  struct tag_usage final {
+    size_type bytes {};
+    size_type peak {};
+    size_type count {};
+  };
+
+  std::unordered_map<SDL_Texture*, texture_memory_entry> mEntries;
+  std::map<std::string, tag_usage, std::less<>> mTags;
+  size_type mTotal {};
+  size_type mPeak {};
+  size_type mBudget {};
+};
+
+[[nodiscard]] inline auto to_string(const texture_memory_registry& registry) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("texture_memory_registry(count: {}, total: {}, peak: {}, budget: {})",
+                     registry.count(),
+                     registry.total(),
+                     registry.peak(),
+                     registry.budget());
+#else
+  return "texture_memory_registry(count: " + std::to_string(registry.count()) +
+         ", total: " + std::to_string(registry.total()) +
+         ", peak: " + std::to_string(registry.peak()) +
+         ", budget: " + std::to_string(registry.budget()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const texture_memory_registry& registry)
+    -> std::ostream&
+{
+  return stream << to_string(registry);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_TEXTURE_MEMORY_HPP_
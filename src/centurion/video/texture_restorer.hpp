@@ -0,0 +1,379 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_TEXTURE_RESTORER_HPP_
+#define CENTURION_VIDEO_TEXTURE_RESTORER_HPP_
+
+#include <SDL.h>
+
+#include <functional>     // function
+#include <string>         // string
+#include <unordered_map>  // unordered_map
+#include <utility>        // move
+
+#include "../common/errors.hpp"
+#include "../common/primitives.hpp"
+#include "../common/utils.hpp"
+#include "../io/asset_pack.hpp"
+#include "../system/cache_manager.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+#include "texture_memory.hpp"
+
+namespace cen {
+
+/**
+ * Keeps lightweight descriptors of textures, so that the textures can be released and
+ * re-uploaded lazily.
+ *
+ * Each texture is described by a loader, e.g. an image path, and is only uploaded once it is
+ * first obtained with `get()`. Textures can be released at any time with `evict()`, e.g. when
+ * the application enters the background, in which case the next call to `get()` uploads the
+ * texture again. The alpha, color, blend and scale modes of evicted textures are preserved.
+ *
+ * The restorer can be registered with a `cache_manager`, which evicts the least recently
+ * obtained textures. References returned by `get()` are invalidated by evictions.
+ *
+ * The restorer doesn't own the associated renderer, which must outlive the restorer.
+ *
+ * \see app_lifecycle
+ */
+class texture_restorer final {
+ public:
+  using size_type = usize;
+  using id_type = usize;
+  using loader_type = std::function<texture(const renderer_handle&)>;
+
+  template <typename T>
+  explicit texture_restorer(const basic_renderer<T>& renderer) noexcept
+      : mRenderer {renderer.get()}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(texture_restorer)
+  CENTURION_DISABLE_MOVE(texture_restorer)
+
+  /**
+   * Adds a texture, which isn't uploaded until it is obtained.
+   *
+   * \param loader the function object that creates the texture, the loader is copied and
+   *        invoked every time that the texture is uploaded.
+   *
+   * \return the identifier of the texture.
+   */
+  auto add(loader_type loader) -> id_type
+  {
+    const auto id = mNextId++;
+    mEntries[id].loader = std::move(loader);
+    return id;
+  }
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+  /// Adds a texture that is loaded from an image file.
+  auto add(std::string path) -> id_type
+  {
+    return add([path = std::move(path)](const renderer_handle& renderer) {
+      return renderer.make_texture(path);
+    });
+  }
+
+  /// Adds a texture that is loaded from an asset pack entry, the pack must outlive this.
+  auto add(const asset_pack& pack, std::string name) -> id_type
+  {
+    return add([&pack, name = std::move(name)](const renderer_handle& renderer) {
+      auto source = pack.open(name);
+      return renderer.make_texture(source);
+    });
+  }
+
+#endif  // CENTURION_NO_SDL_IMAGE
+
+  /**
+   * Returns a texture, which is uploaded if necessary.
+   *
+   * \param id the identifier of the texture.
+   *
+   * \return the texture, which is valid until it is evicted.
+   *
+   * \throws exception if there is no texture with the identifier.
+   * \throws any exception thrown by the loader.
+   */
+  auto get(const id_type id) -> texture&
+  {
+    auto& entry = lookup(id);
+
+    if (!entry.tex) {
+      upload(entry);
+    }
+
+    entry.last_use = cache_manager::tick();
+    return *entry.tex;
+  }
+
+  /// Returns a texture if it is uploaded, without uploading it.
+  [[nodiscard]] auto find(const id_type id) noexcept -> texture*
+  {
+    if (const auto iter = mEntries.find(id); iter != mEntries.end() && iter->second.tex) {
+      iter->second.last_use = cache_manager::tick();
+      return &*iter->second.tex;
+    }
+    else {
+      return nullptr;
+    }
+  }
+
+  /// Indicates whether a texture is currently uploaded.
+  [[nodiscard]] auto is_loaded(const id_type id) const noexcept -> bool
+  {
+    const auto iter = mEntries.find(id);
+    return iter != mEntries.end() && iter->second.tex.has_value();
+  }
+
+  [[nodiscard]] auto contains(const id_type id) const noexcept -> bool
+  {
+    return mEntries.find(id) != mEntries.end();
+  }
+
+  /**
+   * Removes a texture and its descriptor.
+   *
+   * \param id the identifier of the texture.
+   *
+   * \return `true` if a texture was removed; `false` otherwise.
+   */
+  auto erase(const id_type id) -> bool
+  {
+    if (const auto iter = mEntries.find(id); iter != mEntries.end()) {
+      mBytes -= iter->second.bytes;
+      mEntries.erase(iter);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Releases a texture, which is uploaded again the next time that it is obtained.
+   *
+   * \param id the identifier of the texture.
+   *
+   * \return `true` if a texture was released; `false` if it wasn't uploaded.
+   */
+  auto evict(const id_type id) -> bool
+  {
+    if (const auto iter = mEntries.find(id); iter != mEntries.end() && iter->second.tex) {
+      release(iter->second);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /**
+   * Releases all uploaded textures, while keeping their descriptors.
+   *
+   * \return the amount of released textures.
+   */
+  auto evict() noexcept -> size_type
+  {
+    size_type count = 0;
+
+    for (auto& [id, entry] : mEntries) {
+      if (entry.tex) {
+        release(entry);
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  /**
+   * Uploads all textures that aren't uploaded, instead of waiting for them to be obtained.
+   *
+   * \return the amount of uploaded textures.
+   *
+   * \throws any exception thrown by a loader.
+   */
+  auto reload() -> size_type
+  {
+    size_type count = 0;
+
+    for (auto& [id, entry] : mEntries) {
+      if (!entry.tex) {
+        upload(entry);
+        ++count;
+      }
+    }
+
+    return count;
+  }
+
+  /// Removes all textures and descriptors.
+  void clear() noexcept
+  {
+    mEntries.clear();
+    mBytes = 0;
+  }
+
+  /// Returns the estimated memory used by the uploaded textures, in bytes.
+  [[nodiscard]] auto memory_usage() const noexcept -> size_type { return mBytes; }
+
+  /// Returns the usage stamp of the least recently obtained uploaded texture, if any.
+  [[nodiscard]] auto oldest_use() const noexcept -> maybe<uint64>
+  {
+    if (const auto oldest = find_oldest(); oldest != mEntries.end()) {
+      return oldest->second.last_use;
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Releases the least recently obtained uploaded texture, see `cache_manager`.
+  auto evict_oldest() noexcept -> bool
+  {
+    if (const auto oldest = find_oldest(); oldest != mEntries.end()) {
+      release(mEntries.find(oldest->first)->second);
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+
+  /// Returns the amount of textures, including those that aren't uploaded.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mEntries.size(); }
+
+  [[nodiscard]] auto empty() const noexcept -> bool { return mEntries.empty(); }
+
+  /// Returns the amount of uploaded textures.
+  [[nodiscard]] auto loaded_count() const noexcept -> size_type
+  {
+    size_type count = 0;
+    for (const auto& [id, entry] : mEntries) {
+      count += entry.tex ? 1u : 0u;
+    }
+
+    return count;
+  }
+
+ private:
+  /// The modes of an evicted texture, which are restored when it is uploaded again.
+  struct texture_state final {
+    uint8 alpha {0xFF};
+    color tint {colors::white};
+    blend_mode blend {blend_mode::none};
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+    scale_mode scale {scale_mode::nearest};
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
+  };
+
+  struct entry final {
+    loader_type loader;
+    maybe<texture> tex;
+    maybe<texture_state> state;
+    usize bytes {};
+    uint64 last_use {};
+  };
+
+  using entry_map = std::unordered_map<id_type, entry>;
+
+  renderer_handle mRenderer;
+  entry_map mEntries;
+  id_type mNextId {1};
+  size_type mBytes {};
+
+  [[nodiscard]] auto lookup(const id_type id) -> entry&
+  {
+    if (const auto iter = mEntries.find(id); iter != mEntries.end()) {
+      return iter->second;
+    }
+    else {
+      throw exception {"Invalid texture restorer identifier!"};
+    }
+  }
+
+  [[nodiscard]] auto find_oldest() const noexcept -> entry_map::const_iterator
+  {
+    auto oldest = mEntries.end();
+
+    for (auto iter = mEntries.begin(); iter != mEntries.end(); ++iter) {
+      if (iter->second.tex &&
+          (oldest == mEntries.end() || iter->second.last_use < oldest->second.last_use)) {
+        oldest = iter;
+      }
+    }
+
+    return oldest;
+  }
+
+  void upload(entry& entry)
+  {
+    entry.tex.emplace(entry.loader(mRenderer));
+    entry.bytes = estimate_texture_bytes(*entry.tex);
+    entry.last_use = cache_manager::tick();
+    mBytes += entry.bytes;
+
+    if (entry.state) {
+      restore_state(*entry.tex, *entry.state);
+    }
+  }
+
+  void release(entry& entry) noexcept
+  {
+    texture_state state;
+    state.alpha = entry.tex->alpha_mod();
+    state.tint = entry.tex->color_mod();
+    state.blend = entry.tex->get_blend_mode();
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+    state.scale = entry.tex->get_scale_mode();
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
+
+    entry.state = state;
+    entry.tex.reset();
+
+    mBytes -= entry.bytes;
+    entry.bytes = 0;
+  }
+
+  static void restore_state(texture& texture, const texture_state& state) noexcept
+  {
+    texture.set_alpha_mod(state.alpha);
+    texture.set_color_mod(state.tint);
+    texture.set_blend_mode(state.blend);
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+    texture.set_scale_mode(state.scale);
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_TEXTURE_RESTORER_HPP_
@@ -0,0 +1,634 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_TEXTURE_STREAMER_HPP_
+#define CENTURION_VIDEO_TEXTURE_STREAMER_HPP_
+
+#ifndef CENTURION_NO_SDL_IMAGE
+
+#include <SDL.h>
+
+#include <algorithm>      // sort, stable_sort
+#include <atomic>         // atomic
+#include <deque>          // deque
+#include <memory>         // shared_ptr, make_shared
+#include <string>         // string
+#include <string_view>    // string_view
+#include <unordered_map>  // unordered_map
+#include <utility>        // move
+#include <vector>         // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/spin_lock.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "../io/asset_pack.hpp"
+#include "image_loader.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "surface.hpp"
+#include "surface_ops.hpp"
+#include "texture.hpp"
+#include "texture_memory.hpp"
+
+namespace cen {
+
+namespace detail {
+
+/* A texture that competes for the memory budget of a texture_streamer */
+struct lod_candidate final {
+  uint64 id {};                             ///< The identifier of the texture.
+  usize level {};                           ///< The selected level, adjusted to the budget.
+  const std::vector<usize>* levelBytes {};  ///< The memory used by each level.
+  double priority {};                       ///< Lower priorities are downgraded first.
+};
+
+/* Downgrades the candidates with the lowest priorities, one level at a time, until the
+   selected levels fit the budget or every candidate uses its smallest level. The candidates
+   are sorted by their priority, and the total memory of the selected levels is returned. */
+inline auto fit_lod_budget(std::vector<lod_candidate>& candidates, const usize budget) -> usize
+{
+  usize total = 0;
+  for (const auto& candidate : candidates) {
+    total += (*candidate.levelBytes)[candidate.level];
+  }
+
+  std::stable_sort(candidates.begin(),
+                   candidates.end(),
+                   [](const lod_candidate& a, const lod_candidate& b) {
+                     return a.priority < b.priority;
+                   });
+
+  auto downgraded = true;
+  while (total > budget && downgraded) {
+    downgraded = false;
+
+    for (auto& candidate : candidates) {
+      if (total <= budget) {
+        break;
+      }
+
+      const auto& bytes = *candidate.levelBytes;
+      if (candidate.level + 1 < bytes.size()) {
+        total -= bytes[candidate.level];
+        ++candidate.level;
+        total += bytes[candidate.level];
+        downgraded = true;
+      }
+    }
+  }
+
+  return total;
+}
+
+}  // namespace detail
+
+/**
+ * Streams texture detail levels within a memory budget.
+ *
+ * Images are decoded by an image loader, and their mip chains are generated with
+ * `make_mip_chain()`, both on a thread pool. All levels are kept in system memory, but only
+ * one level of each image is resident as a texture. Drawing an image with `render()` records
+ * how large it appears on screen, and `update()` uses the recorded usage to select the level
+ * of every image, upgrading and downgrading textures so that the resident levels fit the
+ * memory budget. Images that are drawn the largest keep the most detail when the budget is
+ * exceeded.
+ *
+ * \code{cpp}
+ * cen::texture_streamer streamer {pool, 256 * 1024 * 1024};
+ * const auto id = streamer.load("art/castle.png");
+ *
+ * // Once per frame
+ * streamer.update(renderer);
+ * streamer.render(renderer, id, cen::frect {0, 0, 400, 300});
+ * \endcode
+ *
+ * \details The memory usage is estimated with `estimate_texture_bytes()`. Images that
+ *          haven't been drawn for a while are downgraded to their smallest level. Level
+ *          changes are uploaded gradually, see `set_max_uploads()`, and downgrades that free
+ *          memory are applied before upgrades.
+ *
+ * \see image_loader
+ * \see make_mip_chain
+ */
+class texture_streamer final {
+ public:
+  using id_type = uint64;
+  using size_type = usize;
+
+  /**
+   * Creates a texture streamer.
+   *
+   * \param pool the thread pool used to decode images and generate mip chains, must outlive
+   *        the streamer.
+   * \param budget the maximum amount of memory used by resident textures, in bytes.
+   * \param format the pixel format that decoded images are converted to, if any.
+   */
+  texture_streamer(thread_pool& pool,
+                   const size_type budget,
+                   const maybe<pixel_format> format = nothing)
+      : mPool {&pool}
+      , mLoader {pool, format}
+      , mState {std::make_shared<shared_state>()}
+      , mBudget {budget}
+  {
+  }
+
+  CENTURION_DISABLE_COPY(texture_streamer)
+  CENTURION_DISABLE_MOVE(texture_streamer)
+
+  /**
+   * Starts streaming an image file.
+   *
+   * \param path the path of the image file.
+   *
+   * \return the identifier of the image.
+   */
+  auto load(std::string path) -> id_type
+  {
+    return track(mLoader.load(std::move(path)));
+  }
+
+  /**
+   * Starts streaming an image in an asset pack.
+   *
+   * \param pack the asset pack that contains the image, must outlive the decoding.
+   * \param name the name of the pack entry.
+   *
+   * \return the identifier of the image.
+   */
+  auto load(const asset_pack& pack, const std::string_view name) -> id_type
+  {
+    return track(mLoader.load(pack, name));
+  }
+
+  /**
+   * Starts streaming an image that has already been decoded.
+   *
+   * \param image the image, the mip chain is still generated on the thread pool.
+   *
+   * \return the identifier of the image.
+   */
+  auto add(surface image) -> id_type
+  {
+    const auto id = mNextId++;
+    mEntries[id];
+    build_levels(id, std::move(image));
+    return id;
+  }
+
+  /// Stops streaming an image, and releases its texture and levels.
+  auto remove(const id_type id) -> bool
+  {
+    const auto it = mEntries.find(id);
+    if (it == mEntries.end()) {
+      return false;
+    }
+
+    if (it->second.resident) {
+      mResidentBytes -= it->second.levelBytes[it->second.level];
+    }
+
+    mEntries.erase(it);
+    return true;
+  }
+
+  /**
+   * Records that an image is drawn at a specific scale during the current frame.
+   *
+   * This is done automatically by `render()`, but may also be called for images that are
+   * drawn in other ways, or that are about to become visible.
+   *
+   * \param id the identifier of the image.
+   * \param scale the amount of output pixels per full size image pixel.
+   */
+  void report_usage(const id_type id, const float scale)
+  {
+    if (const auto it = mEntries.find(id); it != mEntries.end()) {
+      auto& entry = it->second;
+      entry.scale = (detail::max)(entry.scale, scale);
+      entry.lastUsed = mFrame;
+    }
+  }
+
+  /**
+   * Renders an entire image, using the resident level.
+   *
+   * \param renderer the renderer that will be used.
+   * \param id the identifier of the image.
+   * \param destination the destination of the image.
+   *
+   * \return `success` if the image was rendered; `failure` if it isn't resident yet or if
+   *         it couldn't be rendered.
+   */
+  template <typename T>
+  auto render(basic_renderer<T>& renderer, const id_type id, const frect& destination)
+      -> result
+  {
+    const auto it = mEntries.find(id);
+    if (it == mEntries.end() || it->second.levels.empty()) {
+      return failure;
+    }
+
+    const irect source {{0, 0}, it->second.levels.front().size()};
+    return render(renderer, id, source, destination);
+  }
+
+  /**
+   * Renders a region of an image, using the resident level.
+   *
+   * \param renderer the renderer that will be used.
+   * \param id the identifier of the image.
+   * \param source the region of the full size image that will be rendered.
+   * \param destination the destination of the region.
+   *
+   * \return `success` if the image was rendered; `failure` if it isn't resident yet or if
+   *         it couldn't be rendered.
+   */
+  template <typename T>
+  auto render(basic_renderer<T>& renderer,
+              const id_type id,
+              const irect& source,
+              const frect& destination) -> result
+  {
+    const auto it = mEntries.find(id);
+    if (it == mEntries.end() || !source.has_area()) {
+      return failure;
+    }
+
+    auto& entry = it->second;
+
+    const auto sx = destination.width() / static_cast<float>(source.width());
+    const auto sy = destination.height() / static_cast<float>(source.height());
+    report_usage(id, (detail::max)(sx, sy));
+
+    if (!entry.resident) {
+      return failure;
+    }
+
+    const auto base = entry.levels.front().size();
+    const auto level = entry.levels[entry.level].size();
+    const auto region = detail::mip_source(source, base, level);
+    return renderer.render(*entry.resident, region, destination);
+  }
+
+  /**
+   * Selects and uploads the resident levels, should be called once per frame.
+   *
+   * Newly decoded images are handed to the thread pool to generate their mip chains, and
+   * images with finished mip chains become available at their smallest level. The levels of
+   * all images are then selected from the usage recorded since the previous update, and
+   * adjusted to fit the budget.
+   *
+   * \param renderer the renderer used to create the textures.
+   *
+   * \return the amount of textures that were created.
+   */
+  template <typename T>
+  auto update(const basic_renderer<T>& renderer) -> size_type
+  {
+    mLoader.poll([this](const id_type loaderId, maybe<surface> image) {
+      const auto it = mLoading.find(loaderId);
+      if (it == mLoading.end()) {
+        return;
+      }
+
+      const auto id = it->second;
+      mLoading.erase(it);
+
+      if (!mEntries.count(id)) {
+        return; /* The image was removed while it was being decoded */
+      }
+
+      if (image) {
+        build_levels(id, std::move(*image));
+      }
+      else {
+        mEntries[id].failed = true;
+      }
+    });
+
+    collect_levels();
+    select_levels();
+
+    const auto uploads = apply_levels(renderer);
+
+    for (auto& [id, entry] : mEntries) {
+      entry.scale = 0;
+    }
+
+    ++mFrame;
+    return uploads;
+  }
+
+  /// Sets the maximum amount of memory used by resident textures, in bytes.
+  void set_budget(const size_type budget) noexcept { mBudget = budget; }
+
+  /// Sets the maximum amount of upgrades per update, downgrades are never limited.
+  void set_max_uploads(const size_type uploads) noexcept
+  {
+    mMaxUploads = (detail::max)(uploads, size_type {1});
+  }
+
+  /// Sets the level bias, positive values prefer smaller levels.
+  void set_lod_bias(const float bias) noexcept { mBias = bias; }
+
+  /// Sets the amount of updates without usage before an image uses its smallest level.
+  void set_idle_frames(const uint64 frames) noexcept { mIdleFrames = frames; }
+
+  /**
+   * Returns the resident level of an image.
+   *
+   * \param id the identifier of the image.
+   *
+   * \return the index of the resident level, where zero is the full size level; an empty
+   *         optional if the image isn't resident.
+   */
+  [[nodiscard]] auto resident_level(const id_type id) const -> maybe<size_type>
+  {
+    const auto it = mEntries.find(id);
+    if (it != mEntries.end() && it->second.resident) {
+      return it->second.level;
+    }
+    else {
+      return nothing;
+    }
+  }
+
+  /// Returns the amount of levels of an image, which is zero until its mip chain is ready.
+  [[nodiscard]] auto level_count(const id_type id) const -> size_type
+  {
+    const auto it = mEntries.find(id);
+    return (it != mEntries.end()) ? it->second.levels.size() : 0;
+  }
+
+  /// Indicates whether an image couldn't be decoded.
+  [[nodiscard]] auto failed(const id_type id) const -> bool
+  {
+    const auto it = mEntries.find(id);
+    return it != mEntries.end() && it->second.failed;
+  }
+
+  /// Indicates whether there are images that are still being decoded or processed.
+  [[nodiscard]] auto loading() const -> bool
+  {
+    return !mLoading.empty() || mState->building.load(std::memory_order_acquire) != 0 ||
+           !mLoader.idle();
+  }
+
+  /// Returns the estimated memory used by resident textures.
+  [[nodiscard]] auto resident_bytes() const noexcept -> size_type { return mResidentBytes; }
+
+  [[nodiscard]] auto budget() const noexcept -> size_type { return mBudget; }
+
+  [[nodiscard]] auto max_uploads() const noexcept -> size_type { return mMaxUploads; }
+
+  [[nodiscard]] auto lod_bias() const noexcept -> float { return mBias; }
+
+  [[nodiscard]] auto idle_frames() const noexcept -> uint64 { return mIdleFrames; }
+
+  /// Returns the amount of streamed images.
+  [[nodiscard]] auto size() const noexcept -> size_type { return mEntries.size(); }
+
+ private:
+  struct entry final {
+    std::vector<surface> levels;      ///< The full size image followed by its mip chain.
+    std::vector<size_type> levelBytes;  ///< The estimated texture memory of each level.
+    maybe<texture> resident;          ///< The texture of the resident level.
+    size_type level {};               ///< The index of the resident level.
+    size_type target {};              ///< The selected level.
+    float scale {};                   ///< The largest scale used during the current frame.
+    uint64 lastUsed {};               ///< The update during which the image was last used.
+    bool failed {};                   ///< Indicates whether the image couldn't be decoded.
+  };
+
+  struct built_levels final {
+    id_type id {};
+    std::vector<surface> levels;
+  };
+
+  struct shared_state final {
+    spin_lock lock;
+    std::deque<built_levels> built;
+    std::atomic<size_type> building {};
+  };
+
+  thread_pool* mPool {};
+  image_loader mLoader;
+  std::shared_ptr<shared_state> mState;
+  std::unordered_map<id_type, entry> mEntries;
+  std::unordered_map<image_loader::id_type, id_type> mLoading;
+  std::vector<detail::lod_candidate> mCandidates;
+  size_type mBudget {};
+  size_type mResidentBytes {};
+  size_type mMaxUploads {4};
+  float mBias {};
+  uint64 mIdleFrames {120};
+  uint64 mFrame {};
+  id_type mNextId {1};
+
+  auto track(const image_loader::id_type loaderId) -> id_type
+  {
+    const auto id = mNextId++;
+    mEntries[id];
+    mLoading.emplace(loaderId, id);
+    return id;
+  }
+
+  void build_levels(const id_type id, surface image)
+  {
+    mState->building.fetch_add(1, std::memory_order_relaxed);
+    mPool->submit([state = mState, pool = mPool, id, image = std::move(image)]() mutable {
+      built_levels result {id, {}};
+
+      try {
+        auto chain = make_mip_chain(*pool, image);
+
+        result.levels.reserve(chain.size() + 1);
+        result.levels.push_back(std::move(image));
+        for (auto& level : chain) {
+          result.levels.push_back(std::move(level));
+        }
+      }
+      catch (const exception&) {
+        /* The failure is reported through the empty chain */
+        result.levels.clear();
+      }
+
+      {
+        scoped_lock lock {state->lock};
+        state->built.push_back(std::move(result));
+      }
+
+      state->building.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  void collect_levels()
+  {
+    std::deque<built_levels> built;
+
+    {
+      scoped_lock lock {mState->lock};
+      built.swap(mState->built);
+    }
+
+    for (auto& result : built) {
+      const auto it = mEntries.find(result.id);
+      if (it == mEntries.end()) {
+        continue;
+      }
+
+      auto& entry = it->second;
+      if (result.levels.empty()) {
+        entry.failed = true;
+        continue;
+      }
+
+      entry.levels = std::move(result.levels);
+      entry.levelBytes.clear();
+
+      for (const auto& level : entry.levels) {
+        entry.levelBytes.push_back(
+            estimate_texture_bytes(level.size(), level.format_info().format()));
+      }
+
+      /* New images start out at their smallest level until they are drawn */
+      entry.target = entry.levels.size() - 1;
+    }
+  }
+
+  void select_levels()
+  {
+    mCandidates.clear();
+
+    for (auto& [id, entry] : mEntries) {
+      if (entry.levels.empty()) {
+        continue;
+      }
+
+      const auto count = entry.levels.size();
+      const auto idle = entry.scale <= 0 && (mFrame - entry.lastUsed) >= mIdleFrames;
+
+      if (entry.scale > 0) {
+        entry.target = select_mip_level(entry.scale, count, mBias);
+      }
+      else if (idle || !entry.resident) {
+        entry.target = count - 1;
+      }
+
+      /* Images that cover more of the screen keep their detail for longer */
+      const auto base = entry.levels.front().size();
+      const auto covered = static_cast<double>(entry.scale) * entry.scale *
+                           static_cast<double>(base.width) * static_cast<double>(base.height);
+
+      mCandidates.push_back({id, entry.target, &entry.levelBytes, covered});
+    }
+
+    detail::fit_lod_budget(mCandidates, mBudget);
+
+    for (const auto& candidate : mCandidates) {
+      mEntries.at(candidate.id).target = candidate.level;
+    }
+  }
+
+  template <typename T>
+  auto apply_levels(const basic_renderer<T>& renderer) -> size_type
+  {
+    size_type uploads = 0;
+
+    /* The candidates are sorted by ascending priority, so all downgrades are applied first
+       to free memory, and then upgrades are applied starting with the most important image */
+    for (const auto& candidate : mCandidates) {
+      auto& entry = mEntries.at(candidate.id);
+      if (entry.resident && entry.target > entry.level) {
+        uploads += upload(renderer, entry) ? 1u : 0u;
+      }
+    }
+
+    size_type upgrades = 0;
+    for (auto it = mCandidates.rbegin(); it != mCandidates.rend(); ++it) {
+      if (upgrades == mMaxUploads) {
+        break;
+      }
+
+      auto& entry = mEntries.at(it->id);
+      if (entry.resident && entry.target >= entry.level) {
+        continue;
+      }
+
+      const auto current = entry.resident ? entry.levelBytes[entry.level] : 0;
+      const auto fits = mResidentBytes - current + entry.levelBytes[entry.target] <= mBudget;
+
+      /* Images always become resident, at their smallest level if they don't fit */
+      if (!fits) {
+        if (entry.resident) {
+          continue;
+        }
+
+        entry.target = entry.levels.size() - 1;
+      }
+
+      if (upload(renderer, entry)) {
+        ++uploads;
+        ++upgrades;
+      }
+    }
+
+    return uploads;
+  }
+
+  template <typename T>
+  auto upload(const basic_renderer<T>& renderer, entry& entry) -> bool
+  {
+    try {
+      auto texture = renderer.make_texture(entry.levels[entry.target]);
+
+      if (entry.resident) {
+        mResidentBytes -= entry.levelBytes[entry.level];
+      }
+
+      entry.resident.emplace(std::move(texture));
+      entry.level = entry.target;
+      mResidentBytes += entry.levelBytes[entry.level];
+
+      return true;
+    }
+    catch (const sdl_error&) {
+      /* The previous level stays resident, and the upload is retried by the next update */
+      return false;
+    }
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_SDL_IMAGE
+#endif  // CENTURION_VIDEO_TEXTURE_STREAMER_HPP_
@@ -0,0 +1,485 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_TILEMAP_LAYER_HPP_
+#define CENTURION_VIDEO_TILEMAP_LAYER_HPP_
+
+#include <SDL.h>
+
+#include <cmath>        // floor
+#include <string>       // string, to_string
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../detail/stdlib.hpp"
+#include "../features.hpp"
+#include "blend.hpp"
+#include "color.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+#include <format>  // format
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+/// Represents the different ways that a tilemap layer caches its chunks.
+enum class chunk_cache {
+  geometry,  ///< Chunks are cached as vertices, all visible chunks share one geometry call.
+  texture    ///< Chunks are rendered into target textures, one render call per chunk.
+};
+
+[[nodiscard]] constexpr auto to_string(const chunk_cache cache) -> std::string_view
+{
+  switch (cache) {
+    case chunk_cache::geometry:
+      return "geometry";
+
+    case chunk_cache::texture:
+      return "texture";
+
+    default:
+      throw exception {"Did not recognize chunk cache!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const chunk_cache cache) -> std::ostream&
+{
+  return stream << to_string(cache);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/**
+ * A layer of tiles that is rendered in chunks of cached geometry.
+ *
+ * The tiles are grouped in square chunks, and each chunk is built at most once until one of
+ * its tiles changes. Rendering the layer only considers the chunks that overlap the view,
+ * which makes the cost of a frame independent of the size of the map.
+ *
+ * Tiles are identified by their index in the tileset, starting at one for the tile in the
+ * top-left corner and increasing from left to right, and then from top to bottom. The
+ * identifier zero represents an empty tile.
+ *
+ * Note, the layer only stores a raw pointer to the tileset, which must outlive the layer.
+ *
+ * \see chunk_cache
+ */
+class tilemap_layer final {
+ public:
+  using size_type = usize;
+  using tile_id = uint32;
+
+  inline constexpr static tile_id empty = 0;
+
+  /**
+   * Creates an empty tilemap layer.
+   *
+   * \param tileset the texture that contains the tiles, in a grid.
+   * \param tileSize the size of each tile, in pixels.
+   * \param mapSize the size of the map, in tiles.
+   * \param chunkSize the width and height of each chunk, in tiles.
+   * \param cache the way that the chunks are cached.
+   *
+   * \throws exception if any of the sizes are invalid.
+   */
+  template <typename T>
+  tilemap_layer(const basic_texture<T>& tileset,
+                const iarea& tileSize,
+                const iarea& mapSize,
+                const int chunkSize = 16,
+                const chunk_cache cache = chunk_cache::geometry)
+      : mTileset {tileset.get()}
+      , mTilesetSize {tileset.size().as_f()}
+      , mTileSize {tileSize}
+      , mSize {mapSize}
+      , mChunkSize {chunkSize}
+      , mCache {cache}
+  {
+    if (tileSize.width <= 0 || tileSize.height <= 0 || mapSize.width <= 0 ||
+        mapSize.height <= 0 || chunkSize <= 0) {
+      throw exception {"Invalid tilemap layer size!"};
+    }
+
+    mColumns = tileset.width() / tileSize.width;
+    if (mColumns <= 0) {
+      throw exception {"Tileset is narrower than a tile!"};
+    }
+
+    mChunkColumns = (mSize.width + mChunkSize - 1) / mChunkSize;
+    mChunkRows = (mSize.height + mChunkSize - 1) / mChunkSize;
+
+    mTiles.resize(static_cast<usize>(mSize.width) * static_cast<usize>(mSize.height), empty);
+    mChunks.resize(static_cast<usize>(mChunkColumns) * static_cast<usize>(mChunkRows));
+  }
+
+  /**
+   * Changes a tile, the associated chunk is rebuilt when it is rendered next.
+   *
+   * \param x the column of the tile.
+   * \param y the row of the tile.
+   * \param id the new tile identifier.
+   *
+   * \throws exception if the position is outside of the map.
+   */
+  void set(const int x, const int y, const tile_id id)
+  {
+    auto& tile = mTiles[index_of(x, y)];
+    if (tile != id) {
+      tile = id;
+      mChunks[chunk_index(x / mChunkSize, y / mChunkSize)].dirty = true;
+    }
+  }
+
+  /// Returns the tile at a position, throws if the position is outside of the map.
+  [[nodiscard]] auto at(const int x, const int y) const -> tile_id
+  {
+    return mTiles[index_of(x, y)];
+  }
+
+  /// Changes all tiles of the layer.
+  void fill(const tile_id id)
+  {
+    for (auto& tile : mTiles) {
+      tile = id;
+    }
+
+    for (auto& chunk : mChunks) {
+      chunk.dirty = true;
+    }
+  }
+
+  /**
+   * Renders the part of the layer that is visible in a view.
+   *
+   * \param renderer the renderer that will be used.
+   * \param view the area of the map that is visible, in pixels, its top-left corner is
+   * rendered at the origin of the render target.
+   *
+   * \return `success` if the visible chunks were rendered; `failure` otherwise.
+   *
+   * \throws sdl_error if a chunk texture cannot be created.
+   */
+  template <typename T>
+  auto render(basic_renderer<T>& renderer, const frect& view) -> result
+  {
+    mDrawCalls = 0;
+    mVertices.clear();
+
+    const auto chunkWidth = static_cast<float>(mChunkSize * mTileSize.width);
+    const auto chunkHeight = static_cast<float>(mChunkSize * mTileSize.height);
+
+    const auto firstColumn = visible_chunk(view.x(), chunkWidth, mChunkColumns);
+    const auto lastColumn = visible_chunk(view.max_x(), chunkWidth, mChunkColumns);
+    const auto firstRow = visible_chunk(view.y(), chunkHeight, mChunkRows);
+    const auto lastRow = visible_chunk(view.max_y(), chunkHeight, mChunkRows);
+
+    result res = success;
+
+    for (auto row = firstRow; row <= lastRow; ++row) {
+      for (auto column = firstColumn; column <= lastColumn; ++column) {
+        auto& chunk = mChunks[chunk_index(column, row)];
+
+        if (chunk.dirty) {
+          build(chunk, column, row);
+          if (mCache == chunk_cache::texture && !bake(renderer, chunk, column, row)) {
+            res = failure;
+          }
+        }
+
+        if (chunk.vertices.empty()) {
+          continue;
+        }
+
+        if (mCache == chunk_cache::texture && chunk.baked) {
+          const frect dst {column * chunkWidth - view.x(),
+                           row * chunkHeight - view.y(),
+                           static_cast<float>(chunk.baked->width()),
+                           static_cast<float>(chunk.baked->height())};
+          if (!renderer.render(*chunk.baked, dst)) {
+            res = failure;
+          }
+
+          ++mDrawCalls;
+        }
+        else {
+          append(chunk, {-view.x(), -view.y()});
+        }
+      }
+    }
+
+    if (!mVertices.empty()) {
+      if (!submit(renderer.get(), mVertices)) {
+        res = failure;
+      }
+
+      ++mDrawCalls;
+    }
+
+    return res;
+  }
+
+  /// Renders the layer, where the view covers the entire render output.
+  template <typename T>
+  auto render(basic_renderer<T>& renderer, const fpoint& camera = {}) -> result
+  {
+    const auto size = renderer.output_size().as_f();
+    return render(renderer, frect {camera, size});
+  }
+
+  [[nodiscard]] auto width() const noexcept -> int { return mSize.width; }
+  [[nodiscard]] auto height() const noexcept -> int { return mSize.height; }
+
+  /// Returns the size of the map, in tiles.
+  [[nodiscard]] auto size() const noexcept -> iarea { return mSize; }
+
+  /// Returns the size of each tile, in pixels.
+  [[nodiscard]] auto tile_size() const noexcept -> iarea { return mTileSize; }
+
+  /// Returns the width and height of each chunk, in tiles.
+  [[nodiscard]] auto chunk_size() const noexcept -> int { return mChunkSize; }
+
+  /// Returns the amount of chunks in the layer.
+  [[nodiscard]] auto chunk_count() const noexcept -> size_type { return mChunks.size(); }
+
+  [[nodiscard]] auto cache() const noexcept -> chunk_cache { return mCache; }
+
+  /// Returns the amount of chunks that have been built, including rebuilds.
+  [[nodiscard]] auto build_count() const noexcept -> uint64 { return mBuilds; }
+
+  /// Returns the amount of render calls issued by the latest call to `render()`.
+  [[nodiscard]] auto draw_calls() const noexcept -> size_type { return mDrawCalls; }
+
+ private:
+  struct chunk final {
+    std::vector<SDL_Vertex> vertices;  ///< The quads of the chunk, relative to the chunk.
+    maybe<texture> baked;              ///< The rendered chunk, when cached in textures.
+    bool dirty {true};                 ///< Indicates whether the chunk must be rebuilt.
+  };
+
+  SDL_Texture* mTileset {};
+  farea mTilesetSize;
+  iarea mTileSize;
+  iarea mSize;
+  int mChunkSize {};
+  chunk_cache mCache {};
+  int mColumns {};
+  int mChunkColumns {};
+  int mChunkRows {};
+  std::vector<tile_id> mTiles;
+  std::vector<chunk> mChunks;
+  std::vector<SDL_Vertex> mVertices;
+  std::vector<int> mIndices;
+  size_type mDrawCalls {};
+  uint64 mBuilds {};
+
+  [[nodiscard]] auto index_of(const int x, const int y) const -> usize
+  {
+    if (x < 0 || y < 0 || x >= mSize.width || y >= mSize.height) {
+      throw exception {"Invalid tile position!"};
+    }
+
+    return static_cast<usize>(y) * static_cast<usize>(mSize.width) + static_cast<usize>(x);
+  }
+
+  [[nodiscard]] auto chunk_index(const int column, const int row) const noexcept -> usize
+  {
+    return static_cast<usize>(row) * static_cast<usize>(mChunkColumns) +
+           static_cast<usize>(column);
+  }
+
+  [[nodiscard]] static auto visible_chunk(const float position,
+                                          const float chunkSize,
+                                          const int count) noexcept -> int
+  {
+    const auto index = static_cast<int>(std::floor(position / chunkSize));
+    return detail::clamp(index, 0, count - 1);
+  }
+
+  /* Creates the quads of the non-empty tiles in a chunk */
+  void build(chunk& chunk, const int column, const int row)
+  {
+    chunk.vertices.clear();
+    chunk.dirty = false;
+    ++mBuilds;
+
+    const auto firstX = column * mChunkSize;
+    const auto firstY = row * mChunkSize;
+    const auto lastX = (detail::min)(firstX + mChunkSize, mSize.width);
+    const auto lastY = (detail::min)(firstY + mChunkSize, mSize.height);
+
+    const auto tileWidth = static_cast<float>(mTileSize.width);
+    const auto tileHeight = static_cast<float>(mTileSize.height);
+    const SDL_Color tint {0xFF, 0xFF, 0xFF, 0xFF};
+
+    for (auto y = firstY; y < lastY; ++y) {
+      for (auto x = firstX; x < lastX; ++x) {
+        const auto id = mTiles[index_of(x, y)];
+        if (id == empty) {
+          continue;
+        }
+
+        const auto tile = static_cast<int>(id - 1u);
+        const auto srcX = static_cast<float>((tile % mColumns) * mTileSize.width);
+        const auto srcY = static_cast<float>((tile / mColumns) * mTileSize.height);
+
+        const auto u0 = srcX / mTilesetSize.width;
+        const auto v0 = srcY / mTilesetSize.height;
+        const auto u1 = (srcX + tileWidth) / mTilesetSize.width;
+        const auto v1 = (srcY + tileHeight) / mTilesetSize.height;
+
+        const auto x0 = static_cast<float>(x - firstX) * tileWidth;
+        const auto y0 = static_cast<float>(y - firstY) * tileHeight;
+        const auto x1 = x0 + tileWidth;
+        const auto y1 = y0 + tileHeight;
+
+        chunk.vertices.push_back({{x0, y0}, tint, {u0, v0}});
+        chunk.vertices.push_back({{x1, y0}, tint, {u1, v0}});
+        chunk.vertices.push_back({{x1, y1}, tint, {u1, v1}});
+        chunk.vertices.push_back({{x0, y1}, tint, {u0, v1}});
+      }
+    }
+  }
+
+  /* Renders the geometry of a chunk into its target texture */
+  template <typename T>
+  auto bake(basic_renderer<T>& renderer, chunk& chunk, const int column, const int row)
+      -> result
+  {
+    if (chunk.vertices.empty()) {
+      chunk.baked.reset();
+      return success;
+    }
+
+    if (!chunk.baked) {
+      const auto firstX = column * mChunkSize;
+      const auto firstY = row * mChunkSize;
+      const iarea size {
+          ((detail::min)(firstX + mChunkSize, mSize.width) - firstX) * mTileSize.width,
+          ((detail::min)(firstY + mChunkSize, mSize.height) - firstY) * mTileSize.height};
+
+      chunk.baked = renderer.make_texture(size, pixel_format::rgba32, texture_access::target);
+      chunk.baked->set_blend_mode(blend_mode::blend);
+    }
+
+    auto previous = renderer.get_target();
+    if (!renderer.set_target(*chunk.baked)) {
+      chunk.baked.reset();
+      return failure;
+    }
+
+    renderer.clear_with(colors::transparent);
+
+    /* The chunk vertices are already relative to the chunk */
+    const auto res = submit(renderer.get(), chunk.vertices);
+
+    if (previous) {
+      renderer.set_target(previous);
+    }
+    else {
+      renderer.reset_target();
+    }
+
+    if (!res) {
+      chunk.baked.reset();
+    }
+
+    return res;
+  }
+
+  void append(const chunk& chunk, const fpoint& offset)
+  {
+    for (auto vertex : chunk.vertices) {
+      vertex.position.x += offset.x();
+      vertex.position.y += offset.y();
+      mVertices.push_back(vertex);
+    }
+  }
+
+  /* Renders a list of quads, all frames share the same index buffer */
+  auto submit(SDL_Renderer* renderer, const std::vector<SDL_Vertex>& vertices) -> result
+  {
+    const auto quads = vertices.size() / 4u;
+
+    for (auto quad = mIndices.size() / 6u; quad < quads; ++quad) {
+      const auto first = static_cast<int>(quad * 4u);
+      mIndices.insert(mIndices.end(),
+                      {first, first + 1, first + 2, first + 2, first + 3, first});
+    }
+
+    return SDL_RenderGeometry(renderer,
+                              mTileset,
+                              vertices.data(),
+                              static_cast<int>(vertices.size()),
+                              mIndices.data(),
+                              static_cast<int>(quads * 6u)) == 0;
+  }
+};
+
+[[nodiscard]] inline auto to_string(const tilemap_layer& layer) -> std::string
+{
+#if CENTURION_HAS_FEATURE_FORMAT
+  return std::format("tilemap_layer(width: {}, height: {}, chunks: {})",
+                     layer.width(),
+                     layer.height(),
+                     layer.chunk_count());
+#else
+  return "tilemap_layer(width: " + std::to_string(layer.width()) +
+         ", height: " + std::to_string(layer.height()) +
+         ", chunks: " + std::to_string(layer.chunk_count()) + ")";
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const tilemap_layer& layer) -> std::ostream&
+{
+  return stream << to_string(layer);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_TILEMAP_LAYER_HPP_
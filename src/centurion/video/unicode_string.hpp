@@ -25,10 +25,12 @@
 #ifndef CENTURION_VIDEO_UNICODE_STRING_HPP_
 #define CENTURION_VIDEO_UNICODE_STRING_HPP_
 
+#include <algorithm>         // copy_n
 #include <cassert>           // assert
 #include <initializer_list>  // initializer_list
 #include <string_view>       // u16string_view
 #include <type_traits>       // is_same_v, decay_t
+#include <utility>           // move
 #include <vector>            // vector
 
 #include "../common/errors.hpp"
@@ -36,45 +38,116 @@
 
 namespace cen {
 
-/// Represents a null-terminated string of Unicode characters.
+/**
+ * Represents a null-terminated string of Unicode characters.
+ *
+ * Short strings are stored inline, so strings of up to `inline_capacity` characters never
+ * allocate any memory. Longer strings are stored in a dynamically allocated buffer.
+ *
+ * \see unicode_string_view
+ */
 class unicode_string final {
  public:
-  using value_type = std::vector<unicode_t>::value_type;
+  using value_type = unicode_t;
+
+  using pointer = unicode_t*;
+  using const_pointer = const unicode_t*;
 
-  using pointer = std::vector<unicode_t>::pointer;
-  using const_pointer = std::vector<unicode_t>::const_pointer;
+  using reference = unicode_t&;
+  using const_reference = const unicode_t&;
 
-  using reference = std::vector<unicode_t>::reference;
-  using const_reference = std::vector<unicode_t>::const_reference;
+  using iterator = pointer;
+  using const_iterator = const_pointer;
 
-  using iterator = std::vector<unicode_t>::iterator;
-  using const_iterator = std::vector<unicode_t>::const_iterator;
+  using size_type = usize;
 
-  using size_type = std::vector<unicode_t>::size_type;
+  /// The amount of characters that can be stored without allocating memory.
+  inline static constexpr size_type inline_capacity = 15;
 
-  unicode_string() { mData.push_back(0); }
+  unicode_string() noexcept = default;
 
   /* implicit */ unicode_string(const std::u16string_view str)
   {
     reserve(str.size());
 
     for (const auto ch : str) {
-      mData.push_back(ch);
+      append(static_cast<unicode_t>(ch));
     }
-
-    mData.push_back(0);
   }
 
   unicode_string(std::initializer_list<unicode_t> codes)
   {
-    reserve(codes.size() + 1);
-    mData.insert(mData.end(), codes.begin(), codes.end());
-    mData.push_back(0);
+    reserve(codes.size());
+
+    for (const auto ch : codes) {
+      append(ch);
+    }
   }
 
-  void reserve(const size_type n) { mData.reserve(n + 1u); }
+  unicode_string(const unicode_string&) = default;
 
-  void append(const unicode_t ch) { mData.insert(mData.end() - 1, ch); }
+  unicode_string(unicode_string&& other) noexcept
+      : mHeap {std::move(other.mHeap)}
+      , mSize {other.mSize}
+  {
+    if (mHeap.empty()) {
+      std::copy_n(other.mInline, mSize + 1u, mInline);
+    }
+
+    other.reset();
+  }
+
+  auto operator=(const unicode_string&) -> unicode_string& = default;
+
+  auto operator=(unicode_string&& other) noexcept -> unicode_string&
+  {
+    if (this != &other) {
+      mHeap = std::move(other.mHeap);
+      mSize = other.mSize;
+
+      if (mHeap.empty()) {
+        std::copy_n(other.mInline, mSize + 1u, mInline);
+      }
+
+      other.reset();
+    }
+
+    return *this;
+  }
+
+  void reserve(const size_type n)
+  {
+    if (n <= capacity()) {
+      return;
+    }
+
+    if (is_inline()) {
+      std::vector<unicode_t> heap;
+      heap.reserve(n + 1u);
+      heap.assign(mInline, mInline + mSize + 1u); /* Include the null-terminator */
+      mHeap = std::move(heap);
+    }
+    else {
+      mHeap.reserve(n + 1u);
+    }
+  }
+
+  void append(const unicode_t ch)
+  {
+    if (is_inline()) {
+      if (mSize < inline_capacity) {
+        mInline[mSize] = ch;
+        mInline[++mSize] = 0;
+        return;
+      }
+
+      reserve(inline_capacity * 2u);
+    }
+
+    mHeap.back() = ch;
+    mHeap.push_back(0);
+    ++mSize;
+  }
 
   template <typename... Character>
   void append(Character... code)
@@ -90,14 +163,30 @@ class unicode_string final {
   void pop_back()
   {
     if (!empty()) {
-      mData.erase(mData.end() - 2);
+      if (!is_inline()) {
+        mHeap.pop_back();
+      }
+
+      --mSize;
+      data()[mSize] = 0;
+    }
+  }
+
+  /// Removes all characters, the capacity is not affected.
+  void clear() noexcept
+  {
+    if (!is_inline()) {
+      mHeap.resize(1);
     }
+
+    mSize = 0;
+    data()[0] = 0;
   }
 
   [[nodiscard]] auto at(const size_type index) -> reference
   {
     if (is_valid_index(index)) {
-      return mData[index];
+      return data()[index];
     }
     else {
       throw exception {"Invalid unicode string index!"};
@@ -107,7 +196,7 @@ class unicode_string final {
   [[nodiscard]] auto at(const size_type index) const -> const_reference
   {
     if (is_valid_index(index)) {
-      return mData[index];
+      return data()[index];
     }
     else {
       throw exception {"Invalid unicode string index!"};
@@ -118,7 +207,7 @@ class unicode_string final {
   [[nodiscard]] auto operator[](const size_type index) noexcept(on_msvc) -> reference
   {
     assert(is_valid_index(index));
-    return mData[index];
+    return data()[index];
   }
 
   /// Returns the element at the specified index (with no bounds checking).
@@ -126,44 +215,151 @@ class unicode_string final {
       -> const_reference
   {
     assert(is_valid_index(index));
-    return mData[index];
+    return data()[index];
   }
 
-  [[nodiscard]] auto size() const noexcept -> size_type
-  {
-    assert(!mData.empty());
-    return mData.size() - 1u;
-  }
+  [[nodiscard]] auto size() const noexcept -> size_type { return mSize; }
 
   [[nodiscard]] auto capacity() const noexcept -> size_type
   {
-    assert(mData.capacity() >= 1u);
-    return mData.capacity() - 1u;
+    if (is_inline()) {
+      return inline_capacity;
+    }
+    else {
+      assert(mHeap.capacity() >= 1u);
+      return mHeap.capacity() - 1u;
+    }
   }
 
-  [[nodiscard]] auto empty() const noexcept -> bool { return mData.size() == 1; }
+  [[nodiscard]] auto empty() const noexcept -> bool { return mSize == 0; }
+
+  /// Indicates whether the characters are stored inline, i.e. without any allocated memory.
+  [[nodiscard]] auto is_inline() const noexcept -> bool { return mHeap.empty(); }
+
+  [[nodiscard]] auto data() noexcept -> pointer
+  {
+    return is_inline() ? mInline : mHeap.data();
+  }
 
-  [[nodiscard]] auto data() noexcept -> pointer { return mData.data(); }
-  [[nodiscard]] auto data() const noexcept -> const_pointer { return mData.data(); }
+  [[nodiscard]] auto data() const noexcept -> const_pointer
+  {
+    return is_inline() ? mInline : mHeap.data();
+  }
 
-  [[nodiscard]] auto begin() noexcept -> iterator { return mData.begin(); }
-  [[nodiscard]] auto begin() const noexcept -> const_iterator { return mData.begin(); }
+  [[nodiscard]] auto begin() noexcept -> iterator { return data(); }
+  [[nodiscard]] auto begin() const noexcept -> const_iterator { return data(); }
 
-  [[nodiscard]] auto end() noexcept -> iterator { return mData.end() - 1; }
-  [[nodiscard]] auto end() const noexcept -> const_iterator { return mData.end() - 1; }
+  [[nodiscard]] auto end() noexcept -> iterator { return data() + mSize; }
+  [[nodiscard]] auto end() const noexcept -> const_iterator { return data() + mSize; }
 
   template <typename Archive>
   void serialize(Archive& archive)
   {
-    archive(mData);
+    /* The same function is used to save and load, so the characters are always copied */
+    std::vector<unicode_t> codes(begin(), end());
+    archive(codes);
+
+    clear();
+    reserve(codes.size());
+
+    for (const auto ch : codes) {
+      append(ch);
+    }
   }
 
  private:
-  std::vector<unicode_t> mData;
+  unicode_t mInline[inline_capacity + 1] {};
+  std::vector<unicode_t> mHeap;  ///< Holds the characters and terminator of long strings.
+  size_type mSize {};
 
   [[nodiscard]] auto is_valid_index(const size_type index) const noexcept -> bool
   {
-    return index < mData.size() - 1; /* Do not include null-terminator */
+    return index < mSize; /* Do not include null-terminator */
+  }
+
+  void reset() noexcept
+  {
+    mHeap.clear();
+    mSize = 0;
+    mInline[0] = 0;
+  }
+};
+
+/**
+ * Represents a non-owning view of a null-terminated string of Unicode characters.
+ *
+ * Views are cheap to copy, and unicode strings are implicitly converted to views, so this
+ * type is suitable for function parameters that accept any Unicode string.
+ *
+ * \see unicode_string
+ */
+class unicode_string_view final {
+ public:
+  using value_type = unicode_t;
+  using const_pointer = const unicode_t*;
+  using const_reference = const unicode_t&;
+  using const_iterator = const_pointer;
+  using size_type = usize;
+
+  constexpr unicode_string_view() noexcept = default;
+
+  /* implicit */ constexpr unicode_string_view(const unicode_t* str) noexcept
+      : mData {str}
+      , mSize {length(str)}
+  {
+    assert(str);
+  }
+
+  /* implicit */ unicode_string_view(const unicode_string& str) noexcept
+      : mData {str.data()}
+      , mSize {str.size()}
+  {}
+
+  [[nodiscard]] auto at(const size_type index) const -> const_reference
+  {
+    if (index < mSize) {
+      return mData[index];
+    }
+    else {
+      throw exception {"Invalid unicode string index!"};
+    }
+  }
+
+  /// Returns the element at the specified index (with no bounds checking).
+  [[nodiscard]] constexpr auto operator[](const size_type index) const noexcept(on_msvc)
+      -> const_reference
+  {
+    assert(index < mSize);
+    return mData[index];
+  }
+
+  [[nodiscard]] constexpr auto size() const noexcept -> size_type { return mSize; }
+
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool { return mSize == 0; }
+
+  /// Returns a pointer to the null-terminated characters.
+  [[nodiscard]] constexpr auto data() const noexcept -> const_pointer { return mData; }
+
+  [[nodiscard]] constexpr auto begin() const noexcept -> const_iterator { return mData; }
+  [[nodiscard]] constexpr auto end() const noexcept -> const_iterator { return mData + mSize; }
+
+ private:
+  inline static constexpr unicode_t mEmpty[1] {};
+
+  const_pointer mData {mEmpty};
+  size_type mSize {};
+
+  [[nodiscard]] constexpr static auto length(const unicode_t* str) noexcept -> size_type
+  {
+    size_type size = 0;
+
+    if (str) {
+      while (str[size] != 0) {
+        ++size;
+      }
+    }
+
+    return size;
   }
 };
 
@@ -0,0 +1,542 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CENTURION_VIDEO_VIDEO_STREAM_HPP_
+#define CENTURION_VIDEO_VIDEO_STREAM_HPP_
+
+#include <SDL.h>
+
+#include <cassert>      // assert
+#include <deque>        // deque
+#include <functional>   // function
+#include <string_view>  // string_view
+#include <utility>      // move
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../concurrency/locks.hpp"
+#include "../concurrency/spin_lock.hpp"
+#include "../concurrency/thread_pool.hpp"
+#include "../detail/stdlib.hpp"
+#include "../system/timer.hpp"
+#include "pixels.hpp"
+#include "renderer.hpp"
+#include "texture.hpp"
+
+#ifndef CENTURION_NO_SDL_MIXER
+
+#include "../audio/music.hpp"
+
+#endif  // CENTURION_NO_SDL_MIXER
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// Represents the planar YUV layouts that video frames can be decoded into.
+enum class video_frame_format {
+  nv12,  ///< A luma plane followed by an interleaved chroma plane.
+  iyuv   ///< A luma plane followed by separate U and V planes, also known as I420.
+};
+
+[[nodiscard]] constexpr auto to_string(const video_frame_format format) -> std::string_view
+{
+  switch (format) {
+    case video_frame_format::nv12:
+      return "nv12";
+
+    case video_frame_format::iyuv:
+      return "iyuv";
+
+    default:
+      throw exception {"Did not recognize video frame format!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const video_frame_format format) -> std::ostream&
+{
+  return stream << to_string(format);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/// Returns the texture pixel format that corresponds to a video frame format.
+[[nodiscard]] constexpr auto to_pixel_format(const video_frame_format format) noexcept
+    -> pixel_format
+{
+  return (format == video_frame_format::nv12) ? pixel_format::nv12 : pixel_format::iyuv;
+}
+
+/**
+ * A decoded video frame, stored as planar YUV.
+ *
+ * The planes are stored back to back in a single buffer, which is allocated once. The chroma
+ * planes are subsampled by two in both directions, rounded up for odd sizes.
+ *
+ * \see video_stream
+ */
+class video_frame final {
+ public:
+  using size_type = usize;
+
+  /**
+   * Creates a video frame.
+   *
+   * \param size the size of the luma plane, i.e. the size of the video.
+   * \param format the layout of the planes.
+   */
+  video_frame(const iarea& size, const video_frame_format format)
+      : mSize {size}
+      , mFormat {format}
+  {
+    assert(size.width > 0);
+    assert(size.height > 0);
+
+    const auto lumaPitch = static_cast<size_type>(size.width);
+    const auto chromaPitch = static_cast<size_type>((size.width + 1) / 2);
+    const auto lumaRows = static_cast<size_type>(size.height);
+    const auto chromaRows = static_cast<size_type>((size.height + 1) / 2);
+
+    mPitches[0] = lumaPitch;
+    if (format == video_frame_format::nv12) {
+      mPitches[1] = chromaPitch * 2u;
+      mOffsets[1] = lumaPitch * lumaRows;
+      mOffsets[2] = mOffsets[1] + mPitches[1] * chromaRows;
+    }
+    else {
+      mPitches[1] = chromaPitch;
+      mPitches[2] = chromaPitch;
+      mOffsets[1] = lumaPitch * lumaRows;
+      mOffsets[2] = mOffsets[1] + chromaPitch * chromaRows;
+      mOffsets[3] = mOffsets[2] + chromaPitch * chromaRows;
+    }
+
+    mData.resize(mOffsets[plane_count()]);
+  }
+
+  /// Returns a plane, where the luma plane has index zero.
+  [[nodiscard]] auto plane(const size_type index) noexcept -> uint8*
+  {
+    assert(index < plane_count());
+    return mData.data() + mOffsets[index];
+  }
+
+  /// Returns a plane, where the luma plane has index zero.
+  [[nodiscard]] auto plane(const size_type index) const noexcept -> const uint8*
+  {
+    assert(index < plane_count());
+    return mData.data() + mOffsets[index];
+  }
+
+  /// Returns the amount of bytes in each row of a plane.
+  [[nodiscard]] auto pitch(const size_type index) const noexcept -> int
+  {
+    assert(index < plane_count());
+    return static_cast<int>(mPitches[index]);
+  }
+
+  /// Returns the amount of planes, two for NV12 and three for IYUV.
+  [[nodiscard]] auto plane_count() const noexcept -> size_type
+  {
+    return (mFormat == video_frame_format::nv12) ? 2u : 3u;
+  }
+
+  /// Sets the presentation time of the frame, relative to the start of the video.
+  void set_timestamp(const seconds<double> timestamp) noexcept { mTimestamp = timestamp; }
+
+  [[nodiscard]] auto timestamp() const noexcept -> seconds<double> { return mTimestamp; }
+
+  [[nodiscard]] auto data() noexcept -> uint8* { return mData.data(); }
+
+  [[nodiscard]] auto data() const noexcept -> const uint8* { return mData.data(); }
+
+  /// Returns the size of all planes, in bytes.
+  [[nodiscard]] auto byte_size() const noexcept -> size_type { return mData.size(); }
+
+  [[nodiscard]] auto size() const noexcept -> const iarea& { return mSize; }
+
+  [[nodiscard]] auto format() const noexcept -> video_frame_format { return mFormat; }
+
+ private:
+  std::vector<uint8> mData;
+  iarea mSize {};
+  video_frame_format mFormat {};
+  seconds<double> mTimestamp {};
+  size_type mOffsets[4] {};  ///< The start of each plane, followed by the end of the last.
+  size_type mPitches[3] {};
+};
+
+/**
+ * Plays a video by streaming decoded frames into a texture.
+ *
+ * Decoding is left to a user-supplied function, e.g. a wrapper around a video codec, which
+ * fills a frame with planar YUV data and sets its timestamp. The decoder runs on a thread
+ * pool and fills a ring of preallocated frames ahead of the playback position. Each call
+ * to `update()` uploads the newest frame that is due, using `SDL_UpdateNVTexture()` or
+ * `SDL_UpdateYUVTexture()`, and skips frames that are already late. The texture can then be
+ * rendered like any other texture, and YUV conversion is done by the renderer.
+ *
+ * By default, playback follows a wall clock controlled by `play()` and `pause()`. Use
+ * `set_clock()` to synchronize the video with another clock instead, e.g. `music_clock()`.
+ *
+ * The decoder is never invoked concurrently with itself, but it runs on another thread than
+ * the one that calls `update()`. The video stream must be destroyed before its renderer.
+ *
+ * \see video_frame
+ * \see music_clock()
+ */
+class video_stream final {
+ public:
+  using size_type = usize;
+
+  /**
+   * The function that decodes frames.
+   *
+   * The function is invoked with a frame to decode into, and should set its timestamp. The
+   * timestamps must be increasing. Return `false` at the end of the video, or throw an
+   * exception on errors, which ends the stream and is rethrown by `update()`.
+   */
+  using decoder_type = std::function<bool(video_frame&)>;
+
+  /// A function that returns the current playback position.
+  using clock_type = std::function<seconds<double>()>;
+
+  /**
+   * Creates a video stream, and starts decoding frames.
+   *
+   * \param renderer the renderer used to create the streaming texture.
+   * \param size the size of the video.
+   * \param format the layout of the decoded frames.
+   * \param decoder the function object that decodes frames.
+   * \param pool the thread pool that runs the decoder.
+   * \param capacity the amount of frames in the ring, at least two.
+   *
+   * \throws exception if the decoder is empty.
+   * \throws sdl_error if the texture cannot be created.
+   */
+  template <typename T>
+  video_stream(const basic_renderer<T>& renderer,
+               const iarea& size,
+               const video_frame_format format,
+               decoder_type decoder,
+               thread_pool& pool,
+               const size_type capacity = 4)
+      : mTexture {renderer.make_texture(size,
+                                        to_pixel_format(format),
+                                        texture_access::streaming)}
+      , mPool {&pool}
+      , mDecoder {std::move(decoder)}
+      , mClockTime {false}
+  {
+    if (!mDecoder) {
+      throw exception {"Cannot create video stream with empty decoder!"};
+    }
+
+    const auto count = (detail::max)(capacity, size_type {2});
+    mFrames.reserve(count);
+    mFree.reserve(count);
+
+    for (size_type index = 0; index < count; ++index) {
+      mFrames.emplace_back(size, format);
+      mFree.push_back(count - index - 1u);
+    }
+
+    schedule();
+  }
+
+  CENTURION_DISABLE_COPY(video_stream)
+  CENTURION_DISABLE_MOVE(video_stream)
+
+  ~video_stream() noexcept
+  {
+    {
+      scoped_lock lock {mLock};
+      mStopped = true;
+    }
+
+    try {
+      mTask.wait();
+    }
+    catch (...) {
+      /* Decoder errors are reported by update(), there is no one to report to here */
+    }
+  }
+
+  /**
+   * Uploads the newest frame that is due, if any, and schedules more decoding.
+   *
+   * This should be called once per frame, before rendering the texture. Frames that were
+   * superseded by a later due frame are dropped without being uploaded.
+   *
+   * \return `true` if a new frame was uploaded; `false` otherwise.
+   *
+   * \throws any exception thrown by the decoder.
+   * \throws sdl_error if the frame cannot be uploaded.
+   */
+  auto update() -> bool
+  {
+    if (mTask && !is_decoding()) {
+      /* The task is done or about to be, reset the handle so errors are only reported once */
+      const auto task = std::move(mTask);
+      mTask = task_handle {};
+      task.wait();
+    }
+
+    const auto time = position();
+
+    bool found = false;
+    size_type slot {};
+    {
+      scoped_lock lock {mLock};
+      while (!mReady.empty() && mFrames[mReady.front()].timestamp() <= time) {
+        if (found) {
+          mFree.push_back(slot);
+          ++mDropped;
+        }
+
+        slot = mReady.front();
+        found = true;
+        mReady.pop_front();
+      }
+    }
+
+    if (found) {
+      const auto uploaded = upload(mFrames[slot]);
+
+      {
+        scoped_lock lock {mLock};
+        mFree.push_back(slot);
+      }
+
+      if (!uploaded) {
+        throw sdl_error {};
+      }
+
+      ++mPresented;
+    }
+
+    schedule();
+    return found;
+  }
+
+  /// Starts or resumes the default wall clock, has no effect with a custom clock.
+  void play() noexcept { mClockTime.start(); }
+
+  /// Pauses the default wall clock, has no effect with a custom clock.
+  void pause() noexcept { mClockTime.stop(); }
+
+  /// Indicates whether the default wall clock is running.
+  [[nodiscard]] auto is_playing() const noexcept -> bool { return mClockTime.is_running(); }
+
+  /**
+   * Sets the clock that the playback follows.
+   *
+   * \param clock the clock used by the playback, the default wall clock is used if empty.
+   */
+  void set_clock(clock_type clock) { mClock = std::move(clock); }
+
+  /// Returns the current playback position, according to the active clock.
+  [[nodiscard]] auto position() const -> seconds<double>
+  {
+    if (mClock) {
+      return mClock();
+    }
+    else {
+      return mClockTime.elapsed<seconds<double>>();
+    }
+  }
+
+  /// Indicates whether the decoder has ended and every decoded frame has been consumed.
+  [[nodiscard]] auto is_finished() const -> bool
+  {
+    scoped_lock lock {mLock};
+    return mEnded && !mDecoding && mReady.empty();
+  }
+
+  /// Returns the amount of decoded frames that are waiting to be presented.
+  [[nodiscard]] auto buffered() const -> size_type
+  {
+    scoped_lock lock {mLock};
+    return mReady.size();
+  }
+
+  /// Returns the amount of frames in the ring.
+  [[nodiscard]] auto capacity() const noexcept -> size_type { return mFrames.size(); }
+
+  /// Returns the amount of frames that have been uploaded to the texture.
+  [[nodiscard]] auto presented() const noexcept -> uint64 { return mPresented; }
+
+  /// Returns the amount of frames that were skipped because they were late.
+  [[nodiscard]] auto dropped() const noexcept -> uint64 { return mDropped; }
+
+  /// Returns the streaming texture that holds the latest presented frame.
+  [[nodiscard]] auto get_texture() const noexcept -> const texture& { return mTexture; }
+
+ private:
+  texture mTexture;
+  thread_pool* mPool {};
+  decoder_type mDecoder;
+  clock_type mClock;
+  stopwatch mClockTime;
+  task_handle mTask;
+  std::vector<video_frame> mFrames;
+
+  /* The fields below are guarded by the lock, and shared with the decoder task */
+  mutable spin_lock mLock;
+  std::deque<size_type> mReady;  ///< Decoded frames, in presentation order.
+  std::vector<size_type> mFree;  ///< Frames that can be decoded into.
+  bool mDecoding {};  ///< Indicates whether a decoder task is active.
+  bool mEnded {};     ///< Indicates whether the decoder has reached the end of the video.
+  bool mStopped {};   ///< Indicates whether the stream is being destroyed.
+
+  uint64 mPresented {};
+  uint64 mDropped {};
+
+  void schedule()
+  {
+    {
+      scoped_lock lock {mLock};
+      if (mDecoding || mEnded || mFree.empty()) {
+        return;
+      }
+
+      mDecoding = true;
+    }
+
+    mTask = mPool->submit([this] { decode(); });
+  }
+
+  /* Decodes frames until the ring is full, runs on the thread pool */
+  void decode()
+  {
+    while (true) {
+      size_type slot {};
+      {
+        scoped_lock lock {mLock};
+        if (mStopped || mFree.empty()) {
+          mDecoding = false;
+          return;
+        }
+
+        slot = mFree.back();
+        mFree.pop_back();
+      }
+
+      bool decoded = false;
+      try {
+        decoded = mDecoder(mFrames[slot]);
+      }
+      catch (...) {
+        end(slot);
+        throw;
+      }
+
+      if (decoded) {
+        scoped_lock lock {mLock};
+        mReady.push_back(slot);
+      }
+      else {
+        end(slot);
+        return;
+      }
+    }
+  }
+
+  [[nodiscard]] auto is_decoding() const -> bool
+  {
+    scoped_lock lock {mLock};
+    return mDecoding;
+  }
+
+  void end(const size_type slot)
+  {
+    scoped_lock lock {mLock};
+    mFree.push_back(slot);
+    mEnded = true;
+    mDecoding = false;
+  }
+
+  [[nodiscard]] auto upload(const video_frame& frame) noexcept -> result
+  {
+    const irect region {ipoint {0, 0}, frame.size()};
+
+    if (frame.format() == video_frame_format::nv12) {
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+      return mTexture.update_nv(region,
+                                frame.plane(0),
+                                frame.pitch(0),
+                                frame.plane(1),
+                                frame.pitch(1));
+#else
+      /* The chroma plane directly follows the luma plane, as expected by SDL */
+      return mTexture.update(frame.data(), frame.pitch(0));
+#endif  // SDL_VERSION_ATLEAST(2, 0, 16)
+    }
+    else {
+      return mTexture.update_yuv(region,
+                                 frame.plane(0),
+                                 frame.pitch(0),
+                                 frame.plane(1),
+                                 frame.pitch(1),
+                                 frame.plane(2),
+                                 frame.pitch(2));
+    }
+  }
+};
+
+#ifndef CENTURION_NO_SDL_MIXER
+#if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+
+/**
+ * Returns a clock that follows the playback position of a music track.
+ *
+ * This is intended to be used with `video_stream::set_clock()`, to synchronize a video with
+ * its soundtrack. Pausing or seeking the music also pauses or seeks the video, but note that
+ * frames that were already decoded are not discarded when seeking backwards.
+ *
+ * \param track the music that provides the playback position, must outlive the clock.
+ *
+ * \return a clock that reports the position of the music, or zero if it is unavailable.
+ */
+[[nodiscard]] inline auto music_clock(const music& track) -> video_stream::clock_type
+{
+  return [&track] { return seconds<double> {track.position().value_or(0.0)}; };
+}
+
+#endif  // SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+#endif  // CENTURION_NO_SDL_MIXER
+
+}  // namespace cen
+
+#endif  // CENTURION_VIDEO_VIDEO_STREAM_HPP_
@@ -0,0 +1,716 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef CENTURION_VIDEO_VK_SWAPCHAIN_HPP_
+#define CENTURION_VIDEO_VK_SWAPCHAIN_HPP_
+
+#ifndef CENTURION_NO_VULKAN
+
+#include <SDL.h>
+#include <SDL_vulkan.h>
+#include <vulkan/vulkan.h>
+
+#include <algorithm>    // clamp, find
+#include <cassert>      // assert
+#include <limits>       // numeric_limits
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+#include "../common/errors.hpp"
+#include "../common/math.hpp"
+#include "../common/primitives.hpp"
+#include "../common/result.hpp"
+#include "../common/utils.hpp"
+#include "../events/window_events.hpp"
+#include "vulkan.hpp"
+#include "window.hpp"
+
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
+namespace cen {
+
+/// The presentation modes of a Vulkan swapchain.
+enum class vk_present_mode {
+  immediate = VK_PRESENT_MODE_IMMEDIATE_KHR,       ///< No synchronization, may tear.
+  mailbox = VK_PRESENT_MODE_MAILBOX_KHR,           ///< Low latency, replaces queued images.
+  fifo = VK_PRESENT_MODE_FIFO_KHR,                 ///< Synchronized, always supported.
+  fifo_relaxed = VK_PRESENT_MODE_FIFO_RELAXED_KHR  ///< Synchronized, unless a frame is late.
+};
+
+[[nodiscard]] constexpr auto to_string(const vk_present_mode mode) -> std::string_view
+{
+  switch (mode) {
+    case vk_present_mode::immediate:
+      return "immediate";
+
+    case vk_present_mode::mailbox:
+      return "mailbox";
+
+    case vk_present_mode::fifo:
+      return "fifo";
+
+    case vk_present_mode::fifo_relaxed:
+      return "fifo_relaxed";
+
+    default:
+      throw exception {"Did not recognize Vulkan present mode!"};
+  }
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
+inline auto operator<<(std::ostream& stream, const vk_present_mode mode) -> std::ostream&
+{
+  return stream << to_string(mode);
+}
+
+#endif  // CENTURION_NO_IOSTREAM
+
+/// Describes the desired properties of a Vulkan swapchain.
+struct vk_swapchain_config final {
+  vk_present_mode present_mode {vk_present_mode::fifo};  ///< Falls back to FIFO.
+  uint32 frames_in_flight {2};  ///< The amount of frames recorded ahead of the GPU.
+  uint32 min_image_count {3};
+  VkFormat format {VK_FORMAT_B8G8R8A8_SRGB};  ///< Falls back to the first supported format.
+  VkColorSpaceKHR color_space {VK_COLOR_SPACE_SRGB_NONLINEAR_KHR};
+  VkImageUsageFlags usage {VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT};
+};
+
+/**
+ * A swapchain image acquired for rendering a frame.
+ *
+ * Rendering must wait for `image_available`, signal `render_finished` and use `in_flight` as
+ * the fence of the last queue submission of the frame.
+ */
+struct vk_frame final {
+  uint32 frame_index {};  ///< The frame-in-flight slot of the frame.
+  uint32 image_index {};  ///< The index of the acquired swapchain image.
+  VkImage image {};
+  VkImageView view {};
+  VkSemaphore image_available {};
+  VkSemaphore render_finished {};
+  VkFence in_flight {};
+};
+
+/**
+ * A table of the Vulkan functions used by swapchains.
+ *
+ * The functions are loaded through SDL with `load()`, so that applications don't have to link
+ * to the Vulkan loader.
+ *
+ * \see vk_swapchain
+ */
+struct vk_swapchain_functions final {
+  PFN_vkGetDeviceProcAddr get_device_proc_addr {};
+  PFN_vkGetPhysicalDeviceSurfaceCapabilitiesKHR get_surface_capabilities {};
+  PFN_vkGetPhysicalDeviceSurfaceFormatsKHR get_surface_formats {};
+  PFN_vkGetPhysicalDeviceSurfacePresentModesKHR get_surface_present_modes {};
+  PFN_vkCreateSwapchainKHR create_swapchain {};
+  PFN_vkDestroySwapchainKHR destroy_swapchain {};
+  PFN_vkGetSwapchainImagesKHR get_swapchain_images {};
+  PFN_vkAcquireNextImageKHR acquire_next_image {};
+  PFN_vkQueuePresentKHR queue_present {};
+  PFN_vkCreateImageView create_image_view {};
+  PFN_vkDestroyImageView destroy_image_view {};
+  PFN_vkCreateSemaphore create_semaphore {};
+  PFN_vkDestroySemaphore destroy_semaphore {};
+  PFN_vkCreateFence create_fence {};
+  PFN_vkDestroyFence destroy_fence {};
+  PFN_vkWaitForFences wait_for_fences {};
+  PFN_vkResetFences reset_fences {};
+  PFN_vkDeviceWaitIdle device_wait_idle {};
+
+  [[nodiscard]] static auto load(VkInstance instance, VkDevice device)
+      -> maybe<vk_swapchain_functions>
+  {
+    const auto getInstanceProc =
+        reinterpret_cast<PFN_vkGetInstanceProcAddr>(vk::get_instance_proc_addr());
+    if (!getInstanceProc) {
+      return nothing;
+    }
+
+    vk_swapchain_functions fn;
+
+    const auto instanceLoaded =
+        get(getInstanceProc, instance, fn.get_device_proc_addr, "vkGetDeviceProcAddr") &&
+        get(getInstanceProc,
+            instance,
+            fn.get_surface_capabilities,
+            "vkGetPhysicalDeviceSurfaceCapabilitiesKHR") &&
+        get(getInstanceProc,
+            instance,
+            fn.get_surface_formats,
+            "vkGetPhysicalDeviceSurfaceFormatsKHR") &&
+        get(getInstanceProc,
+            instance,
+            fn.get_surface_present_modes,
+            "vkGetPhysicalDeviceSurfacePresentModesKHR");
+    if (!instanceLoaded) {
+      return nothing;
+    }
+
+    const auto getDeviceProc = fn.get_device_proc_addr;
+    const auto deviceLoaded =
+        get(getDeviceProc, device, fn.create_swapchain, "vkCreateSwapchainKHR") &&
+        get(getDeviceProc, device, fn.destroy_swapchain, "vkDestroySwapchainKHR") &&
+        get(getDeviceProc, device, fn.get_swapchain_images, "vkGetSwapchainImagesKHR") &&
+        get(getDeviceProc, device, fn.acquire_next_image, "vkAcquireNextImageKHR") &&
+        get(getDeviceProc, device, fn.queue_present, "vkQueuePresentKHR") &&
+        get(getDeviceProc, device, fn.create_image_view, "vkCreateImageView") &&
+        get(getDeviceProc, device, fn.destroy_image_view, "vkDestroyImageView") &&
+        get(getDeviceProc, device, fn.create_semaphore, "vkCreateSemaphore") &&
+        get(getDeviceProc, device, fn.destroy_semaphore, "vkDestroySemaphore") &&
+        get(getDeviceProc, device, fn.create_fence, "vkCreateFence") &&
+        get(getDeviceProc, device, fn.destroy_fence, "vkDestroyFence") &&
+        get(getDeviceProc, device, fn.wait_for_fences, "vkWaitForFences") &&
+        get(getDeviceProc, device, fn.reset_fences, "vkResetFences") &&
+        get(getDeviceProc, device, fn.device_wait_idle, "vkDeviceWaitIdle");
+    if (!deviceLoaded) {
+      return nothing;
+    }
+
+    return fn;
+  }
+
+ private:
+  template <typename Loader, typename Object, typename Function>
+  [[nodiscard]] static auto get(Loader loader,
+                                Object object,
+                                Function& function,
+                                const char* name) noexcept -> bool
+  {
+    function = reinterpret_cast<Function>(loader(object, name));
+    return function != nullptr;
+  }
+};
+
+/**
+ * Owns a Vulkan swapchain, its image views and the synchronization of frames in flight.
+ *
+ * The swapchain is recreated automatically when it becomes out of date, when the window is
+ * resized (see `handle()`) or when the present mode is changed. While the window has no
+ * drawable area, e.g. when it is minimized, no images are acquired.
+ *
+ * A typical frame looks like the following.
+ *
+ * \code{cpp}
+ * if (const auto frame = swapchain.acquire()) {
+ *   // Record commands that render to frame->view, then submit them, waiting for
+ *   // frame->image_available, signaling frame->render_finished and the frame->in_flight fence
+ *   swapchain.present(*frame);
+ * }
+ * \endcode
+ *
+ * The device, surface and queue must outlive the swapchain.
+ *
+ * \note This header requires the Vulkan headers, and is only included by `centurion.hpp` if
+ * they are available. The Vulkan functions are loaded through SDL.
+ *
+ * \see vk_swapchain_config
+ * \see vk_frame
+ */
+class vk_swapchain final {
+ public:
+  /**
+   * Creates a swapchain.
+   *
+   * \param window the Vulkan window that the surface was created for.
+   * \param instance the instance used to create the device and the surface.
+   * \param physicalDevice the physical device of the logical device.
+   * \param device the logical device that owns the swapchain.
+   * \param surface the surface of the window.
+   * \param presentQueue a queue that supports presenting to the surface.
+   * \param config the desired swapchain properties.
+   *
+   * \throws exception if the Vulkan functions cannot be loaded, or if any of the Vulkan
+   *         objects cannot be created.
+   */
+  template <typename T>
+  vk_swapchain(basic_window<T>& window,
+               VkInstance instance,
+               VkPhysicalDevice physicalDevice,
+               VkDevice device,
+               VkSurfaceKHR surface,
+               VkQueue presentQueue,
+               const vk_swapchain_config& config = {})
+      : vk_swapchain {load_functions(instance, device),
+                      window,
+                      physicalDevice,
+                      device,
+                      surface,
+                      presentQueue,
+                      config}
+  {}
+
+  /**
+   * Creates a swapchain that uses existing functions, all of which must be set.
+   *
+   * \throws exception if any of the Vulkan objects cannot be created.
+   */
+  template <typename T>
+  vk_swapchain(const vk_swapchain_functions& functions,
+               basic_window<T>& window,
+               VkPhysicalDevice physicalDevice,
+               VkDevice device,
+               VkSurfaceKHR surface,
+               VkQueue presentQueue,
+               const vk_swapchain_config& config = {})
+      : mWindow {window.get()}
+      , mPhysicalDevice {physicalDevice}
+      , mDevice {device}
+      , mSurface {surface}
+      , mQueue {presentQueue}
+      , mConfig {config}
+      , mFn {functions}
+  {
+    assert(window.is_vulkan());
+    assert(config.frames_in_flight > 0);
+
+    try {
+      create_frame_sync();
+      recreate();
+    }
+    catch (...) {
+      destroy();
+      throw;
+    }
+  }
+
+  CENTURION_DISABLE_COPY(vk_swapchain)
+  CENTURION_DISABLE_MOVE(vk_swapchain)
+
+  ~vk_swapchain() noexcept { destroy(); }
+
+  /**
+   * Waits for the next frame-in-flight slot and acquires a swapchain image.
+   *
+   * \return the acquired frame; an empty optional if no image could be acquired, e.g. when
+   *         the window is minimized or the swapchain had to be recreated.
+   *
+   * \throws exception if the swapchain cannot be recreated.
+   */
+  [[nodiscard]] auto acquire() -> maybe<vk_frame>
+  {
+    if (mDirty && !recreate()) {
+      return nothing;
+    }
+
+    if (!mSwapchain) {
+      return nothing;
+    }
+
+    auto fence = mInFlight[mFrameIndex];
+    mFn.wait_for_fences(mDevice, 1, &fence, VK_TRUE, (std::numeric_limits<uint64>::max)());
+
+    uint32 imageIndex {};
+    const auto res = mFn.acquire_next_image(mDevice,
+                                            mSwapchain,
+                                            (std::numeric_limits<uint64>::max)(),
+                                            mImageAvailable[mFrameIndex],
+                                            VK_NULL_HANDLE,
+                                            &imageIndex);
+
+    if (res == VK_ERROR_OUT_OF_DATE_KHR) {
+      mDirty = true;
+      return nothing;
+    }
+    else if (res != VK_SUCCESS && res != VK_SUBOPTIMAL_KHR) {
+      return nothing;
+    }
+
+    /* A previous frame may still be rendering to the image, if images are acquired out of
+       order or if there are more frames in flight than images */
+    if (auto imageFence = mImagesInFlight[imageIndex]; imageFence != VK_NULL_HANDLE) {
+      mFn.wait_for_fences(mDevice,
+                          1,
+                          &imageFence,
+                          VK_TRUE,
+                          (std::numeric_limits<uint64>::max)());
+    }
+
+    mImagesInFlight[imageIndex] = fence;
+    mFn.reset_fences(mDevice, 1, &fence);
+
+    vk_frame frame;
+    frame.frame_index = mFrameIndex;
+    frame.image_index = imageIndex;
+    frame.image = mImages[imageIndex];
+    frame.view = mViews[imageIndex];
+    frame.image_available = mImageAvailable[mFrameIndex];
+    frame.render_finished = mRenderFinished[imageIndex];
+    frame.in_flight = fence;
+
+    return frame;
+  }
+
+  /**
+   * Presents a rendered frame, and advances to the next frame-in-flight slot.
+   *
+   * \param frame the frame obtained from the latest call to `acquire()`.
+   *
+   * \return `success` if the frame was queued for presentation; `failure` otherwise.
+   */
+  auto present(const vk_frame& frame) -> result
+  {
+    VkPresentInfoKHR info {};
+    info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+    info.waitSemaphoreCount = 1;
+    info.pWaitSemaphores = &frame.render_finished;
+    info.swapchainCount = 1;
+    info.pSwapchains = &mSwapchain;
+    info.pImageIndices = &frame.image_index;
+
+    const auto res = mFn.queue_present(mQueue, &info);
+    mFrameIndex = (mFrameIndex + 1u) % mConfig.frames_in_flight;
+
+    if (res == VK_ERROR_OUT_OF_DATE_KHR || res == VK_SUBOPTIMAL_KHR) {
+      mDirty = true;
+    }
+
+    return res == VK_SUCCESS || res == VK_SUBOPTIMAL_KHR;
+  }
+
+  /// Schedules a recreation of the swapchain when the window has been resized.
+  void handle(const window_event& event) noexcept
+  {
+    switch (event.event_id()) {
+      case window_event_id::resized:
+      case window_event_id::size_changed:
+      case window_event_id::minimized:
+      case window_event_id::restored:
+        mDirty = true;
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  /// Schedules a recreation of the swapchain, e.g. after the surface was lost.
+  void invalidate() noexcept { mDirty = true; }
+
+  /**
+   * Changes the present mode, which takes effect when the next frame is acquired.
+   *
+   * \param mode the desired present mode, FIFO is used if it isn't supported.
+   */
+  void set_present_mode(const vk_present_mode mode) noexcept
+  {
+    if (mConfig.present_mode != mode) {
+      mConfig.present_mode = mode;
+      mDirty = true;
+    }
+  }
+
+  /// Returns the present mode in use, which may differ from the requested one.
+  [[nodiscard]] auto present_mode() const noexcept -> vk_present_mode { return mPresentMode; }
+
+  [[nodiscard]] auto get() const noexcept -> VkSwapchainKHR { return mSwapchain; }
+
+  [[nodiscard]] auto format() const noexcept -> VkFormat { return mFormat; }
+
+  [[nodiscard]] auto extent() const noexcept -> VkExtent2D { return mExtent; }
+
+  [[nodiscard]] auto images() const noexcept -> const std::vector<VkImage>& { return mImages; }
+
+  [[nodiscard]] auto views() const noexcept -> const std::vector<VkImageView>&
+  {
+    return mViews;
+  }
+
+  [[nodiscard]] auto frames_in_flight() const noexcept -> uint32
+  {
+    return mConfig.frames_in_flight;
+  }
+
+  /// Returns the amount of times the swapchain has been created.
+  [[nodiscard]] auto generation() const noexcept -> uint64 { return mGeneration; }
+
+ private:
+  SDL_Window* mWindow {};
+  VkPhysicalDevice mPhysicalDevice {};
+  VkDevice mDevice {};
+  VkSurfaceKHR mSurface {};
+  VkQueue mQueue {};
+  vk_swapchain_config mConfig;
+  vk_swapchain_functions mFn;
+
+  VkSwapchainKHR mSwapchain {};
+  VkFormat mFormat {};
+  VkExtent2D mExtent {};
+  vk_present_mode mPresentMode {vk_present_mode::fifo};
+  std::vector<VkImage> mImages;
+  std::vector<VkImageView> mViews;
+  std::vector<VkSemaphore> mRenderFinished;  ///< One per image, signaled by rendering.
+  std::vector<VkFence> mImagesInFlight;      ///< The fence of the frame using each image.
+
+  std::vector<VkSemaphore> mImageAvailable;  ///< One per frame in flight.
+  std::vector<VkFence> mInFlight;            ///< One per frame in flight, created signaled.
+  uint32 mFrameIndex {};
+  uint64 mGeneration {};
+  bool mDirty {};
+
+  [[nodiscard]] static auto load_functions(VkInstance instance, VkDevice device)
+      -> vk_swapchain_functions
+  {
+    if (auto functions = vk_swapchain_functions::load(instance, device)) {
+      return *functions;
+    }
+    else {
+      throw exception {"Failed to load Vulkan swapchain functions!"};
+    }
+  }
+
+  void destroy() noexcept
+  {
+    mFn.device_wait_idle(mDevice);
+
+    destroy_images();
+
+    if (mSwapchain) {
+      mFn.destroy_swapchain(mDevice, mSwapchain, nullptr);
+    }
+
+    for (const auto semaphore : mImageAvailable) {
+      mFn.destroy_semaphore(mDevice, semaphore, nullptr);
+    }
+
+    for (const auto fence : mInFlight) {
+      mFn.destroy_fence(mDevice, fence, nullptr);
+    }
+  }
+
+  void create_frame_sync()
+  {
+    VkSemaphoreCreateInfo semaphoreInfo {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    VkFenceCreateInfo fenceInfo {};
+    fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+
+    for (uint32 index = 0; index < mConfig.frames_in_flight; ++index) {
+      VkSemaphore semaphore {};
+      VkFence fence {};
+
+      if (mFn.create_semaphore(mDevice, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+        throw exception {"Failed to create Vulkan semaphore!"};
+      }
+
+      mImageAvailable.push_back(semaphore);
+
+      if (mFn.create_fence(mDevice, &fenceInfo, nullptr, &fence) != VK_SUCCESS) {
+        throw exception {"Failed to create Vulkan fence!"};
+      }
+
+      mInFlight.push_back(fence);
+    }
+  }
+
+  [[nodiscard]] auto choose_format() const -> VkSurfaceFormatKHR
+  {
+    uint32 count {};
+    mFn.get_surface_formats(mPhysicalDevice, mSurface, &count, nullptr);
+
+    std::vector<VkSurfaceFormatKHR> formats(count);
+    mFn.get_surface_formats(mPhysicalDevice, mSurface, &count, formats.data());
+
+    for (const auto& format : formats) {
+      if (format.format == mConfig.format && format.colorSpace == mConfig.color_space) {
+        return format;
+      }
+    }
+
+    if (formats.empty()) {
+      throw exception {"Vulkan surface has no supported formats!"};
+    }
+
+    return formats.front();
+  }
+
+  [[nodiscard]] auto choose_present_mode() const -> vk_present_mode
+  {
+    uint32 count {};
+    mFn.get_surface_present_modes(mPhysicalDevice, mSurface, &count, nullptr);
+
+    std::vector<VkPresentModeKHR> modes(count);
+    mFn.get_surface_present_modes(mPhysicalDevice, mSurface, &count, modes.data());
+
+    const auto requested = static_cast<VkPresentModeKHR>(mConfig.present_mode);
+    if (std::find(modes.begin(), modes.end(), requested) != modes.end()) {
+      return mConfig.present_mode;
+    }
+    else {
+      return vk_present_mode::fifo;
+    }
+  }
+
+  [[nodiscard]] auto choose_extent(const VkSurfaceCapabilitiesKHR& caps) const -> VkExtent2D
+  {
+    if (caps.currentExtent.width != (std::numeric_limits<uint32>::max)()) {
+      return caps.currentExtent;
+    }
+
+    int width {};
+    int height {};
+    SDL_Vulkan_GetDrawableSize(mWindow, &width, &height);
+
+    VkExtent2D extent;
+    extent.width = std::clamp(static_cast<uint32>(width),
+                              caps.minImageExtent.width,
+                              caps.maxImageExtent.width);
+    extent.height = std::clamp(static_cast<uint32>(height),
+                               caps.minImageExtent.height,
+                               caps.maxImageExtent.height);
+    return extent;
+  }
+
+  /* Returns false if the swapchain could not be created because the window has no area */
+  auto recreate() -> bool
+  {
+    VkSurfaceCapabilitiesKHR caps {};
+    if (mFn.get_surface_capabilities(mPhysicalDevice, mSurface, &caps) != VK_SUCCESS) {
+      throw exception {"Failed to query Vulkan surface capabilities!"};
+    }
+
+    const auto extent = choose_extent(caps);
+    if (extent.width == 0 || extent.height == 0) {
+      mDirty = true;
+      return false;
+    }
+
+    mFn.device_wait_idle(mDevice);
+
+    const auto surfaceFormat = choose_format();
+    const auto presentMode = choose_present_mode();
+
+    auto imageCount = (detail::max)(mConfig.min_image_count, caps.minImageCount);
+    if (caps.maxImageCount != 0) {
+      imageCount = (detail::min)(imageCount, caps.maxImageCount);
+    }
+
+    VkSwapchainCreateInfoKHR info {};
+    info.sType = VK_STRUCTURE_TYPE_SWAPCHAIN_CREATE_INFO_KHR;
+    info.surface = mSurface;
+    info.minImageCount = imageCount;
+    info.imageFormat = surfaceFormat.format;
+    info.imageColorSpace = surfaceFormat.colorSpace;
+    info.imageExtent = extent;
+    info.imageArrayLayers = 1;
+    info.imageUsage = mConfig.usage;
+    info.imageSharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    info.preTransform = caps.currentTransform;
+    info.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
+    info.presentMode = static_cast<VkPresentModeKHR>(presentMode);
+    info.clipped = VK_TRUE;
+    info.oldSwapchain = mSwapchain;
+
+    VkSwapchainKHR swapchain {};
+    if (mFn.create_swapchain(mDevice, &info, nullptr, &swapchain) != VK_SUCCESS) {
+      throw exception {"Failed to create Vulkan swapchain!"};
+    }
+
+    destroy_images();
+    if (mSwapchain) {
+      mFn.destroy_swapchain(mDevice, mSwapchain, nullptr);
+    }
+
+    mSwapchain = swapchain;
+    mFormat = surfaceFormat.format;
+    mExtent = extent;
+    mPresentMode = presentMode;
+
+    create_images();
+
+    mDirty = false;
+    ++mGeneration;
+
+    return true;
+  }
+
+  void create_images()
+  {
+    uint32 count {};
+    mFn.get_swapchain_images(mDevice, mSwapchain, &count, nullptr);
+
+    mImages.resize(count);
+    mFn.get_swapchain_images(mDevice, mSwapchain, &count, mImages.data());
+
+    VkSemaphoreCreateInfo semaphoreInfo {};
+    semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+    for (const auto image : mImages) {
+      VkImageViewCreateInfo viewInfo {};
+      viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+      viewInfo.image = image;
+      viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+      viewInfo.format = mFormat;
+      viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+      viewInfo.subresourceRange.levelCount = 1;
+      viewInfo.subresourceRange.layerCount = 1;
+
+      VkImageView view {};
+      if (mFn.create_image_view(mDevice, &viewInfo, nullptr, &view) != VK_SUCCESS) {
+        throw exception {"Failed to create Vulkan image view!"};
+      }
+
+      mViews.push_back(view);
+
+      VkSemaphore semaphore {};
+      if (mFn.create_semaphore(mDevice, &semaphoreInfo, nullptr, &semaphore) != VK_SUCCESS) {
+        throw exception {"Failed to create Vulkan semaphore!"};
+      }
+
+      mRenderFinished.push_back(semaphore);
+    }
+
+    mImagesInFlight.assign(mImages.size(), VK_NULL_HANDLE);
+  }
+
+  void destroy_images() noexcept
+  {
+    for (const auto view : mViews) {
+      mFn.destroy_image_view(mDevice, view, nullptr);
+    }
+
+    for (const auto semaphore : mRenderFinished) {
+      mFn.destroy_semaphore(mDevice, semaphore, nullptr);
+    }
+
+    mViews.clear();
+    mRenderFinished.clear();
+    mImagesInFlight.clear();
+    mImages.clear();
+  }
+};
+
+}  // namespace cen
+
+#endif  // CENTURION_NO_VULKAN
+#endif  // CENTURION_VIDEO_VK_SWAPCHAIN_HPP_
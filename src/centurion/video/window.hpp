@@ -27,14 +27,16 @@
 
 #include <SDL.h>
 
-#include <cassert>   // assert
-#include <cstddef>   // size_t
-#include <memory>    // unique_ptr
-#include <optional>  // optional, nullopt
-#include <ostream>   // ostream
-#include <string>    // string, to_string
-#include <utility>   // pair, make_pair, move
-
+#include <cassert>      // assert
+#include <cstddef>      // size_t
+#include <memory>       // unique_ptr
+#include <optional>     // optional, nullopt
+#include <iterator>     // back_inserter, ostreambuf_iterator
+#include <string>       // string, to_string
+#include <type_traits>  // is_same_v
+#include <utility>      // pair, make_pair, move
+
+#include "../common/formatting.hpp"
 #include "../common/math.hpp"
 #include "../common/primitives.hpp"
 #include "../common/utils.hpp"
@@ -48,10 +50,16 @@
 
 #if CENTURION_HAS_FEATURE_FORMAT
 
-#include <format>  // format
+#include <format>  // format_to, formatter
 
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 
+#ifndef CENTURION_NO_IOSTREAM
+
+#include <ostream>  // ostream
+
+#endif  // CENTURION_NO_IOSTREAM
+
 namespace cen {
 
 template <typename T>
@@ -198,6 +206,41 @@ class basic_window final {
 
   auto update_surface() noexcept -> result { return SDL_UpdateWindowSurface(mWindow) == 0; }
 
+  /**
+   * Copies the specified areas of the window surface to the screen.
+   *
+   * This is a cheaper alternative to update_surface() when only parts of the window changed.
+   * Nothing is done if the container is empty.
+   *
+   * \tparam Container a contiguous container of `irect` instances.
+   *
+   * \param rects the areas of the window surface that should be updated.
+   *
+   * \return `success` if the areas were updated; `failure` otherwise.
+   */
+  template <typename Container>
+  auto update_surface(const Container& rects) noexcept -> result
+  {
+    using rect_t = typename Container::value_type;
+
+    static_assert(std::is_same_v<rect_t, irect>, "Window surface areas must be irect!");
+    static_assert(sizeof(rect_t) == sizeof(typename rect_t::rect_type),
+                  "Rectangles must have the same layout as the SDL rectangle types!");
+
+    if (!rects.empty()) {
+      const auto* first = rects.front().data();
+      return SDL_UpdateWindowSurfaceRects(mWindow, first, isize(rects)) == 0;
+    }
+    else {
+      return success;
+    }
+  }
+
+  auto update_surface(const irect& area) noexcept -> result
+  {
+    return SDL_UpdateWindowSurfaceRects(mWindow, area.data(), 1) == 0;
+  }
+
 #if SDL_VERSION_ATLEAST(2, 0, 16)
 
   auto flash(const flash_op op = flash_op::briefly) noexcept -> result
@@ -553,27 +596,48 @@ class basic_window final {
   detail::pointer<T, SDL_Window> mWindow;
 };
 
-template <typename T>
-[[nodiscard]] auto to_string(const basic_window<T>& window) -> std::string
+/**
+ * Writes a textual representation of a window to an output iterator, without allocating.
+ *
+ * \return the output iterator past the last written character.
+ */
+template <typename OutputIt, typename T>
+auto format_to(OutputIt out, const basic_window<T>& window) -> OutputIt
 {
 #if CENTURION_HAS_FEATURE_FORMAT
-  return std::format("window(data: {}, width: {}, height: {})",
-                     detail::address_of(window.get()),
-                     window.width(),
-                     window.height());
+  out = detail::write_text(out, "window(data: ");
+  out = detail::write_address(out, window.get());
+  return std::format_to(out, ", width: {}, height: {})", window.width(), window.height());
 #else
-  return "window(data: " + detail::address_of(window.get()) +
-         ", width: " + std::to_string(window.width()) +
-         ", height: " + std::to_string(window.height()) + ")";
+  out = detail::write_text(out, "window(data: ");
+  out = detail::write_address(out, window.get());
+  out = detail::write_text(out, ", width: ");
+  out = detail::write_number(out, window.width());
+  out = detail::write_text(out, ", height: ");
+  out = detail::write_number(out, window.height());
+  return detail::write_text(out, ")");
 #endif  // CENTURION_HAS_FEATURE_FORMAT
 }
 
+template <typename T>
+[[nodiscard]] auto to_string(const basic_window<T>& window) -> std::string
+{
+  std::string result;
+  format_to(std::back_inserter(result), window);
+  return result;
+}
+
+#ifndef CENTURION_NO_IOSTREAM
+
 template <typename T>
 auto operator<<(std::ostream& stream, const basic_window<T>& window) -> std::ostream&
 {
-  return stream << to_string(window);
+  format_to(std::ostreambuf_iterator<char> {stream}, window);
+  return stream;
 }
 
+#endif  // CENTURION_NO_IOSTREAM
+
 [[nodiscard]] inline auto get_grabbed_window() noexcept -> window_handle
 {
   return window_handle {SDL_GetGrabbedWindow()};
@@ -605,4 +669,12 @@ auto operator<<(std::ostream& stream, const basic_window<T>& window) -> std::ost
 
 }  // namespace cen
 
+#if CENTURION_HAS_FEATURE_FORMAT
+
+template <typename T>
+struct std::formatter<cen::basic_window<T>>
+    : cen::detail::value_formatter<cen::basic_window<T>> {};
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
+
 #endif  // CENTURION_VIDEO_WINDOW_HPP_
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/audio/mixer_profiling.hpp"
+
+#include <fff.h>
+#include <gtest/gtest.h>
+
+#include "core_mocks.hpp"
+#include "mixer_mocks.hpp"
+
+using post_mix_callback = void(SDLCALL*)(void*, Uint8*, int);
+
+extern "C" {
+FAKE_VOID_FUNC(Mix_SetPostMix, post_mix_callback, void*)
+}
+
+namespace {
+
+auto query_spec(int* frequency, Uint16* format, int* channels) -> int
+{
+  *frequency = 1'000;
+  *format = AUDIO_S16SYS;
+  *channels = 2;
+  return 1;
+}
+
+/* A buffer of 10 stereo frames with 16-bit samples, i.e. 10 ms at 1 kHz */
+inline constexpr int buffer_size = 10 * 2 * 2;
+
+void mix_buffer(const Uint64 counter, const int channels)
+{
+  SDL_GetPerformanceCounter_fake.return_val = counter;
+  Mix_Playing_fake.return_val = channels;
+  cen::detail::profile_post_mix(nullptr, nullptr, buffer_size);
+}
+
+}  // namespace
+
+class MixerProfilingTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    mocks::reset_core();
+    mocks::reset_mixer();
+    RESET_FAKE(Mix_SetPostMix)
+
+    SDL_GetPerformanceFrequency_fake.return_val = 1'000;
+    cen::reset_mixer_statistics();
+  }
+
+  void TearDown() override { cen::disable_mixer_profiling(); }
+};
+
+TEST_F(MixerProfilingTest, EnableWithoutOpenDevice)
+{
+  ASSERT_FALSE(cen::enable_mixer_profiling());
+  ASSERT_FALSE(cen::is_profiling_mixer());
+  ASSERT_EQ(0u, Mix_SetPostMix_fake.call_count);
+}
+
+TEST_F(MixerProfilingTest, EnableAndDisable)
+{
+  Mix_QuerySpec_fake.custom_fake = query_spec;
+
+  ASSERT_TRUE(cen::enable_mixer_profiling());
+  ASSERT_TRUE(cen::is_profiling_mixer());
+  ASSERT_EQ(cen::detail::profile_post_mix, Mix_SetPostMix_fake.arg0_val);
+
+  cen::disable_mixer_profiling();
+  ASSERT_FALSE(cen::is_profiling_mixer());
+  ASSERT_EQ(nullptr, Mix_SetPostMix_fake.arg0_val);
+}
+
+TEST_F(MixerProfilingTest, Buffers)
+{
+  Mix_QuerySpec_fake.custom_fake = query_spec;
+  ASSERT_TRUE(cen::enable_mixer_profiling());
+
+  mix_buffer(100, 1);  // The first buffer only starts the measurements
+  mix_buffer(110, 2);
+  mix_buffer(120, 4);
+  mix_buffer(150, 3);  // Mixed 30 ms after the previous 10 ms buffer
+
+  const auto stats = cen::mixer_statistics();
+  ASSERT_EQ(3u, stats.buffers.count);
+  ASSERT_EQ(50u, stats.buffers.ticks);
+  ASSERT_EQ(30u, stats.buffers.max_ticks);
+  ASSERT_EQ(1u, stats.underruns);
+  ASSERT_EQ(3, stats.active_channels);
+  ASSERT_EQ(4, stats.peak_channels);
+  ASSERT_DOUBLE_EQ(3.0, stats.mean_channels());
+  ASSERT_DOUBLE_EQ(1.0 / 3.0, stats.underrun_ratio());
+  ASSERT_DOUBLE_EQ(0.01, stats.buffer_period.count());
+
+  cen::reset_mixer_statistics();
+  ASSERT_EQ(0u, cen::mixer_statistics().buffers.count);
+  ASSERT_EQ(0u, cen::mixer_statistics().underruns);
+}
+
+TEST_F(MixerProfilingTest, Loads)
+{
+  auto load = [] { return static_cast<Mix_Chunk*>(nullptr); };
+
+  // Loads are only timed while profiling
+  ASSERT_EQ(nullptr, cen::detail::profiled_sound_load(load));
+  ASSERT_EQ(0u, cen::mixer_statistics().sound_loads.count);
+
+  Mix_QuerySpec_fake.custom_fake = query_spec;
+  ASSERT_TRUE(cen::enable_mixer_profiling());
+
+  Uint64 counters[] = {10, 25};
+  SET_RETURN_SEQ(SDL_GetPerformanceCounter, counters, 2)
+
+  ASSERT_EQ(nullptr, cen::detail::profiled_sound_load(load));
+
+  const auto stats = cen::mixer_statistics();
+  ASSERT_EQ(1u, stats.sound_loads.count);
+  ASSERT_EQ(15u, stats.sound_loads.ticks);
+  ASSERT_EQ(0u, stats.music_loads.count);
+}
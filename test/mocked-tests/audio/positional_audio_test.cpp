@@ -0,0 +1,122 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/audio/positional_audio.hpp"
+
+#include <fff.h>
+#include <gtest/gtest.h>
+
+#include <array>  // array
+
+#include "core_mocks.hpp"
+
+extern "C" {
+FAKE_VALUE_FUNC(int, Mix_SetPosition, int, Sint16, Uint8)
+}
+
+class PositionalAudioTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    mocks::reset_core();
+    RESET_FAKE(Mix_SetPosition)
+  }
+
+  cen::positional_audio mAudio {100, 1'100};
+  cen::audio_listener mListener {{500, 500}, 0};
+};
+
+TEST_F(PositionalAudioTest, AngleAndDistance)
+{
+  const std::array emitters {
+      cen::audio_emitter {0, {500, 420}},    // In front, within full volume distance
+      cen::audio_emitter {1, {1'100, 500}},  // To the right, halfway to silence
+      cen::audio_emitter {2, {500, 2'000}},  // Behind, out of range
+      cen::audio_emitter {3, {0, 500}},      // To the left
+  };
+
+  ASSERT_EQ(4u, mAudio.update(mListener, emitters.data(), emitters.size()));
+  ASSERT_EQ(4u, Mix_SetPosition_fake.call_count);
+
+  ASSERT_EQ(0, Mix_SetPosition_fake.arg0_history[0]);
+  ASSERT_EQ(0, Mix_SetPosition_fake.arg2_history[0]);
+
+  ASSERT_EQ(90, Mix_SetPosition_fake.arg1_history[1]);
+  ASSERT_EQ(128, Mix_SetPosition_fake.arg2_history[1]);
+
+  ASSERT_EQ(180, Mix_SetPosition_fake.arg1_history[2]);
+  ASSERT_EQ(255, Mix_SetPosition_fake.arg2_history[2]);
+
+  ASSERT_EQ(270, Mix_SetPosition_fake.arg1_history[3]);
+  ASSERT_EQ(102, Mix_SetPosition_fake.arg2_history[3]);
+
+  // Turning the listener to the right moves the sounds to the left
+  mListener.direction = 90;
+  ASSERT_EQ(3u, mAudio.update(mListener, emitters.data(), emitters.size()));
+  ASSERT_EQ(0, Mix_SetPosition_fake.arg1_history[4]);
+  ASSERT_EQ(90, Mix_SetPosition_fake.arg1_history[5]);
+  ASSERT_EQ(180, Mix_SetPosition_fake.arg1_history[6]);
+}
+
+TEST_F(PositionalAudioTest, OnlyChangedChannelsArePushed)
+{
+  std::array emitters {
+      cen::audio_emitter {0, {800, 500}},
+      cen::audio_emitter {1, {500, 800}},
+  };
+
+  ASSERT_EQ(2u, mAudio.update(mListener, emitters.data(), emitters.size()));
+
+  // Nothing changed
+  ASSERT_EQ(0u, mAudio.update(mListener, emitters.data(), emitters.size()));
+
+  // Movements smaller than the resolution of the mixer are ignored
+  emitters[0].position.set_x(800.5f);
+  ASSERT_EQ(0u, mAudio.update(mListener, emitters.data(), emitters.size()));
+
+  emitters[1].position.set_y(900);
+  ASSERT_EQ(1u, mAudio.update(mListener, emitters.data(), emitters.size()));
+  ASSERT_EQ(1, Mix_SetPosition_fake.arg0_val);
+  ASSERT_EQ(3u, Mix_SetPosition_fake.call_count);
+}
+
+TEST_F(PositionalAudioTest, RemovedEmittersAreReset)
+{
+  const std::array emitters {
+      cen::audio_emitter {2, {800, 500}},
+      cen::audio_emitter {5, {500, 800}},
+  };
+
+  ASSERT_EQ(2u, mAudio.update(mListener, emitters.data(), emitters.size()));
+
+  ASSERT_EQ(1u, mAudio.update(mListener, emitters.data(), 1));
+  ASSERT_EQ(5, Mix_SetPosition_fake.arg0_val);
+  ASSERT_EQ(0, Mix_SetPosition_fake.arg1_val);
+  ASSERT_EQ(0, Mix_SetPosition_fake.arg2_val);
+
+  mAudio.reset();
+  ASSERT_EQ(4u, Mix_SetPosition_fake.call_count);
+  ASSERT_EQ(2, Mix_SetPosition_fake.arg0_val);
+}
@@ -35,11 +35,9 @@ FAKE_VOID_FUNC(Mix_Pause, int)
 FAKE_VALUE_FUNC(int, Mix_PlayChannelTimed, int, Mix_Chunk*, int, int)
 FAKE_VALUE_FUNC(int, Mix_FadeInChannelTimed, int, Mix_Chunk*, int, int, int)
 FAKE_VALUE_FUNC(int, Mix_FadeOutChannel, int, int)
-FAKE_VALUE_FUNC(int, Mix_Playing, int)
 FAKE_VALUE_FUNC(int, Mix_VolumeChunk, Mix_Chunk*, int)
 
 #if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
-FAKE_VALUE_FUNC(int, Mix_PlayChannel, int, Mix_Chunk*, int)
 FAKE_VALUE_FUNC(int, Mix_FadeInChannel, int, Mix_Chunk*, int, int)
 FAKE_VALUE_FUNC(int, Mix_MasterVolume, int)
 #endif  // SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
@@ -57,11 +55,9 @@ class SoundEffectTest : public testing::Test {
     RESET_FAKE(Mix_PlayChannelTimed)
     RESET_FAKE(Mix_FadeInChannelTimed)
     RESET_FAKE(Mix_FadeOutChannel)
-    RESET_FAKE(Mix_Playing)
     RESET_FAKE(Mix_VolumeChunk)
 
 #if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
-    RESET_FAKE(Mix_PlayChannel)
     RESET_FAKE(Mix_FadeInChannel)
     RESET_FAKE(Mix_MasterVolume)
 #endif  // SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
@@ -0,0 +1,203 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/audio/voice_manager.hpp"
+
+#include <fff.h>
+#include <gtest/gtest.h>
+
+#include "core_mocks.hpp"
+#include "mixer_mocks.hpp"
+
+extern "C" {
+FAKE_VALUE_FUNC(int, Mix_AllocateChannels, int)
+FAKE_VALUE_FUNC(int, Mix_GroupChannels, int, int, int)
+FAKE_VALUE_FUNC(int, Mix_ReserveChannels, int)
+FAKE_VALUE_FUNC(int, Mix_HaltChannel, int)
+FAKE_VALUE_FUNC(int, Mix_HaltGroup, int)
+}
+
+namespace {
+
+auto allocate_channels(const int channels) -> int
+{
+  static int allocated = 8;
+  if (channels >= 0) {
+    allocated = channels;
+  }
+  return allocated;
+}
+
+auto group_channels(const int from, const int to, int) -> int
+{
+  return to - from + 1;
+}
+
+#if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+
+auto play_channel(const int channel, Mix_Chunk*, int) -> int
+{
+  return channel;
+}
+
+#endif  // SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+
+}  // namespace
+
+class VoiceManagerTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    mocks::reset_core();
+    mocks::reset_mixer();
+
+    RESET_FAKE(Mix_AllocateChannels)
+    RESET_FAKE(Mix_GroupChannels)
+    RESET_FAKE(Mix_ReserveChannels)
+    RESET_FAKE(Mix_HaltChannel)
+    RESET_FAKE(Mix_HaltGroup)
+
+    Mix_AllocateChannels_fake.custom_fake = allocate_channels;
+    Mix_GroupChannels_fake.custom_fake = group_channels;
+    SDL_GetPerformanceFrequency_fake.return_val = 1'000;
+
+#if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+    Mix_PlayChannel_fake.custom_fake = play_channel;
+#endif  // SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+  }
+
+  Mix_Chunk* mFirst {reinterpret_cast<Mix_Chunk*>(0x10)};
+  Mix_Chunk* mSecond {reinterpret_cast<Mix_Chunk*>(0x20)};
+  Mix_Chunk* mThird {reinterpret_cast<Mix_Chunk*>(0x30)};
+};
+
+TEST_F(VoiceManagerTest, AddCategory)
+{
+  allocate_channels(8);
+
+  cen::voice_manager manager;
+  ASSERT_FALSE(manager.add_category(0));
+
+  ASSERT_EQ(0, manager.add_category(4));
+  ASSERT_EQ(1u, Mix_GroupChannels_fake.call_count);
+  ASSERT_EQ(0, Mix_GroupChannels_fake.arg0_val);
+  ASSERT_EQ(3, Mix_GroupChannels_fake.arg1_val);
+  ASSERT_EQ(0, Mix_GroupChannels_fake.arg2_val);
+  ASSERT_EQ(4, Mix_ReserveChannels_fake.arg0_val);
+
+  // Requires more channels than currently allocated
+  ASSERT_EQ(1, manager.add_category(6));
+  ASSERT_EQ(10, Mix_AllocateChannels_fake.arg0_val);
+  ASSERT_EQ(4, Mix_GroupChannels_fake.arg0_val);
+  ASSERT_EQ(9, Mix_GroupChannels_fake.arg1_val);
+  ASSERT_EQ(1, Mix_GroupChannels_fake.arg2_val);
+  ASSERT_EQ(10, Mix_ReserveChannels_fake.arg0_val);
+
+  ASSERT_EQ(2, manager.category_count());
+  ASSERT_EQ(10, manager.channel_count());
+  ASSERT_EQ(4, manager.category_size(0));
+  ASSERT_EQ(6, manager.category_size(1));
+}
+
+#if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+
+TEST_F(VoiceManagerTest, PlayStealsOldestVoice)
+{
+  cen::voice_manager manager;
+
+  const auto effects = manager.add_category(2).value();
+  const auto ui = manager.add_category(1).value();
+
+  Mix_Playing_fake.return_val = 1;
+
+  ASSERT_EQ(2, manager.play(ui, mFirst));
+
+  ASSERT_EQ(0, manager.play(effects, mFirst));
+  SDL_GetPerformanceCounter_fake.return_val = 100;
+  ASSERT_EQ(1, manager.play(effects, mSecond));
+  ASSERT_EQ(2, manager.active_count(effects));
+
+  SDL_GetPerformanceCounter_fake.return_val = 200;
+  ASSERT_EQ(0, manager.play(effects, mThird));
+  ASSERT_EQ(1u, Mix_HaltChannel_fake.call_count);
+  ASSERT_EQ(0, Mix_HaltChannel_fake.arg0_val);
+
+  SDL_GetPerformanceCounter_fake.return_val = 300;
+  ASSERT_EQ(1, manager.play(effects, mFirst));
+  ASSERT_EQ(1, Mix_HaltChannel_fake.arg0_val);
+
+  ASSERT_EQ(5u, manager.stats().played);
+  ASSERT_EQ(2u, manager.stats().stolen);
+}
+
+TEST_F(VoiceManagerTest, PlayRespectsPriority)
+{
+  cen::voice_manager manager;
+  const auto category = manager.add_category(2).value();
+
+  Mix_Playing_fake.return_val = 1;
+
+  ASSERT_EQ(0, manager.play(category, mFirst, 5));
+  ASSERT_EQ(1, manager.play(category, mSecond, 1));
+
+  // Cannot steal any voice with a higher priority
+  SDL_GetPerformanceCounter_fake.return_val = 100;
+  ASSERT_FALSE(manager.play(category, mThird, 0));
+  ASSERT_EQ(1u, manager.stats().dropped);
+
+  // The lowest priority voice is stolen, even though it is the newest
+  ASSERT_EQ(1, manager.play(category, mThird, 3));
+  ASSERT_EQ(1, Mix_HaltChannel_fake.arg0_val);
+
+  manager.stop(category);
+  ASSERT_EQ(1u, Mix_HaltGroup_fake.call_count);
+  ASSERT_EQ(category, Mix_HaltGroup_fake.arg0_val);
+  ASSERT_EQ(0, manager.active_count(category));
+}
+
+TEST_F(VoiceManagerTest, PlayDeduplicates)
+{
+  cen::voice_manager manager {cen::u32ms {30}};
+  const auto category = manager.add_category(4).value();
+
+  ASSERT_EQ(0, manager.play(category, mFirst));
+  Mix_Playing_fake.return_val = 1;
+
+  SDL_GetPerformanceCounter_fake.return_val = 10;
+  ASSERT_FALSE(manager.play(category, mFirst));
+  ASSERT_EQ(1, manager.play(category, mSecond));
+  ASSERT_EQ(1u, manager.stats().deduplicated);
+
+  SDL_GetPerformanceCounter_fake.return_val = 40;
+  ASSERT_EQ(2, manager.play(category, mFirst));
+
+  manager.set_dedup_window(cen::u32ms::zero());
+  ASSERT_EQ(3, manager.play(category, mFirst));
+
+  manager.reset_stats();
+  ASSERT_EQ(0u, manager.stats().played);
+}
+
+#endif  // SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
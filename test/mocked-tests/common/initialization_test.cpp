@@ -27,12 +27,43 @@
 #include <gtest/gtest.h>
 
 #include "core_mocks.hpp"
+#include "mixer_mocks.hpp"
+#include "thread_mocks.hpp"
+
+extern "C" {
+DECLARE_FAKE_VALUE_FUNC(int, SDL_GameControllerAddMappingsFromRW, SDL_RWops*, int)
+
+FAKE_VALUE_FUNC(Uint32, SDL_WasInit, Uint32)
+FAKE_VALUE_FUNC(int, SDL_InitSubSystem, Uint32)
+FAKE_VALUE_FUNC(int, SDL_setenv, const char*, const char*, int)
+FAKE_VALUE_FUNC(const char*, SDL_GetCurrentVideoDriver)
+}
+
+namespace {
+
+auto query_spec(int* frequency, Uint16* format, int* channels) -> int
+{
+  *frequency = 48'000;
+  *format = AUDIO_F32SYS;
+  *channels = 2;
+  return 1;
+}
+
+}  // namespace
 
 class InitializationTest : public testing::Test {
  protected:
   void SetUp() override
   {
     mocks::reset_core();
+    mocks::reset_mixer();
+    mocks::reset_thread();
+
+    RESET_FAKE(SDL_GameControllerAddMappingsFromRW)
+    RESET_FAKE(SDL_WasInit)
+    RESET_FAKE(SDL_InitSubSystem)
+    RESET_FAKE(SDL_setenv)
+    RESET_FAKE(SDL_GetCurrentVideoDriver)
 
     /* Sets up expected return values for OK initialization */
     SDL_Init_fake.return_val = cen::sdl_cfg {}.flags;
@@ -40,7 +71,10 @@ class InitializationTest : public testing::Test {
     Mix_Init_fake.return_val = cen::mix_cfg {}.flags;
     TTF_Init_fake.return_val = 0;
 
-    Mix_OpenAudio_fake.return_val = 0;
+    Mix_OpenAudioDevice_fake.return_val = 0;
+
+    static int dummy = 0;
+    SDL_CreateMutex_fake.return_val = reinterpret_cast<SDL_mutex*>(&dummy);
   }
 };
 
@@ -58,6 +92,21 @@ TEST_F(InitializationTest, CoreDefaultConfiguration)
   }
 }
 
+TEST_F(InitializationTest, CoreDriverOverrides)
+{
+  cen::sdl_cfg cfg;
+  cfg.video_driver = "dummy";
+  cfg.audio_driver = "disk";
+
+  const cen::sdl sdl {cfg};
+  ASSERT_EQ(2u, SDL_setenv_fake.call_count);
+  ASSERT_STREQ("SDL_VIDEODRIVER", SDL_setenv_fake.arg0_history[0]);
+  ASSERT_STREQ("dummy", SDL_setenv_fake.arg1_history[0]);
+  ASSERT_STREQ("SDL_AUDIODRIVER", SDL_setenv_fake.arg0_history[1]);
+  ASSERT_STREQ("disk", SDL_setenv_fake.arg1_history[1]);
+  ASSERT_EQ(1u, SDL_Init_fake.call_count);
+}
+
 TEST_F(InitializationTest, ImgDefaultConfiguration)
 {
   try {
@@ -79,10 +128,58 @@ TEST_F(InitializationTest, MixDefaultConfiguration)
     ASSERT_EQ(1u, Mix_Init_fake.call_count);
 
     constexpr cen::mix_cfg cfg;
-    ASSERT_EQ(cfg.frequency, Mix_OpenAudio_fake.arg0_val);
-    ASSERT_EQ(cfg.format, Mix_OpenAudio_fake.arg1_val);
-    ASSERT_EQ(cfg.channels, Mix_OpenAudio_fake.arg2_val);
-    ASSERT_EQ(cfg.chunk_size, Mix_OpenAudio_fake.arg3_val);
+    ASSERT_EQ(cfg.frequency, Mix_OpenAudioDevice_fake.arg0_val);
+    ASSERT_EQ(cfg.format, Mix_OpenAudioDevice_fake.arg1_val);
+    ASSERT_EQ(cfg.channels, Mix_OpenAudioDevice_fake.arg2_val);
+    ASSERT_EQ(cfg.chunk_size, Mix_OpenAudioDevice_fake.arg3_val);
+    ASSERT_EQ(cfg.device, Mix_OpenAudioDevice_fake.arg4_val);
+    ASSERT_EQ(cfg.allowed_changes, Mix_OpenAudioDevice_fake.arg5_val);
+  }
+  catch (...) {
+    FAIL();
+  }
+}
+
+TEST_F(InitializationTest, MixCustomConfiguration)
+{
+  try {
+    cen::mix_cfg cfg;
+    cfg.frequency = 48'000;
+    cfg.chunk_size = 240;
+    cfg.device = "Headphones";
+    cfg.allowed_changes = 0;
+
+    const cen::mix lib {cfg};
+    ASSERT_EQ(48'000, Mix_OpenAudioDevice_fake.arg0_val);
+    ASSERT_EQ(240, Mix_OpenAudioDevice_fake.arg3_val);
+    ASSERT_STREQ("Headphones", Mix_OpenAudioDevice_fake.arg4_val);
+    ASSERT_EQ(0, Mix_OpenAudioDevice_fake.arg5_val);
+    ASSERT_EQ(240, lib.chunk_size());
+  }
+  catch (...) {
+    FAIL();
+  }
+}
+
+TEST_F(InitializationTest, MixSpecAndLatency)
+{
+  try {
+    cen::mix_cfg cfg;
+    cfg.chunk_size = 480;
+
+    const cen::mix lib {cfg};
+    ASSERT_FALSE(lib.spec());
+    ASSERT_FALSE(lib.estimated_latency());
+
+    Mix_QuerySpec_fake.custom_fake = query_spec;
+
+    const auto spec = lib.spec();
+    ASSERT_TRUE(spec);
+    ASSERT_EQ(48'000, spec->frequency);
+    ASSERT_EQ(AUDIO_F32SYS, spec->format);
+    ASSERT_EQ(2, spec->channels);
+
+    ASSERT_DOUBLE_EQ(10.0, lib.estimated_latency()->count());
   }
   catch (...) {
     FAIL();
@@ -126,6 +223,114 @@ TEST_F(InitializationTest, SDLMixInitFailure)
 
 TEST_F(InitializationTest, SDLMixOpenFailure)
 {
-  Mix_OpenAudio_fake.return_val = -1;
+  Mix_OpenAudioDevice_fake.return_val = -1;
   ASSERT_THROW(cen::mix {}, cen::mix_error);
 }
+
+TEST_F(InitializationTest, InitializerSequential)
+{
+  cen::initializer_cfg cfg;
+  cfg.parallel = false;
+
+  const cen::initializer init {cfg};
+  ASSERT_TRUE(init.is_ready());
+
+  ASSERT_EQ(1u, SDL_Init_fake.call_count);
+  ASSERT_EQ(cfg.core.flags, SDL_Init_fake.arg0_val);
+  ASSERT_EQ(1u, TTF_Init_fake.call_count);
+  ASSERT_EQ(1u, IMG_Init_fake.call_count);
+  ASSERT_EQ(1u, Mix_OpenAudioDevice_fake.call_count);
+
+  /* The audio subsystem is initialized before the mixer opens the device */
+  ASSERT_EQ(1u, SDL_InitSubSystem_fake.call_count);
+  ASSERT_EQ(static_cast<Uint32>(SDL_INIT_AUDIO), SDL_InitSubSystem_fake.arg0_val);
+
+  const auto timings = init.timings();
+  ASSERT_EQ(5u, timings.size());
+  ASSERT_EQ("core", timings.at(0).name);
+  ASSERT_EQ("ttf", timings.at(1).name);
+  ASSERT_EQ("image", timings.at(2).name);
+  ASSERT_EQ("audio", timings.at(3).name);
+  ASSERT_EQ("mixer", timings.at(4).name);
+
+  for (const auto& timing : timings) {
+    ASSERT_TRUE(timing.succeeded);
+  }
+}
+
+TEST_F(InitializationTest, InitializerRequire)
+{
+  cen::initializer_cfg cfg;
+  cfg.parallel = false;
+  cfg.controller_db = "gamecontrollerdb.txt";
+  cfg.image = cen::nothing;
+  cfg.mixer = cen::nothing;
+
+  cen::initializer init {cfg};
+  ASSERT_EQ(0u, IMG_Init_fake.call_count);
+  ASSERT_EQ(0u, Mix_OpenAudioDevice_fake.call_count);
+
+  ASSERT_TRUE(init.require(SDL_INIT_GAMECONTROLLER | SDL_INIT_JOYSTICK));
+  ASSERT_EQ(2u, SDL_InitSubSystem_fake.call_count);
+  ASSERT_EQ(static_cast<Uint32>(SDL_INIT_JOYSTICK), SDL_InitSubSystem_fake.arg0_history[0]);
+  ASSERT_EQ(static_cast<Uint32>(SDL_INIT_GAMECONTROLLER),
+            SDL_InitSubSystem_fake.arg0_history[1]);
+  ASSERT_EQ(1u, SDL_GameControllerAddMappingsFromRW_fake.call_count);
+
+  /* Subsystems that are already initialized are skipped */
+  SDL_WasInit_fake.return_val = SDL_INIT_GAMECONTROLLER | SDL_INIT_JOYSTICK;
+  ASSERT_TRUE(init.require(SDL_INIT_GAMECONTROLLER));
+  ASSERT_EQ(2u, SDL_InitSubSystem_fake.call_count);
+
+  SDL_WasInit_fake.return_val = 0;
+  SDL_InitSubSystem_fake.return_val = -1;
+  ASSERT_FALSE(init.require(SDL_INIT_HAPTIC));
+  ASSERT_FALSE(init.timings().back().succeeded);
+}
+
+TEST_F(InitializationTest, InitializerBackgroundFailure)
+{
+  cen::initializer_cfg cfg;
+  cfg.parallel = false;
+
+  Mix_Init_fake.return_val = 0;
+
+  cen::initializer init {cfg};
+  ASSERT_TRUE(init.is_ready());
+  ASSERT_THROW(init.wait(), cen::exception);
+}
+
+TEST_F(InitializationTest, InitializerHeadless)
+{
+  const auto cfg = cen::headless_cfg();
+  ASSERT_FALSE(cfg.parallel);
+  ASSERT_FALSE(cfg.image);
+  ASSERT_FALSE(cfg.ttf);
+  ASSERT_TRUE(cfg.mixer);
+
+  cen::initializer init {cfg};
+  ASSERT_TRUE(init.is_ready());
+  ASSERT_NO_THROW(init.wait());
+
+  ASSERT_EQ(cfg.core.flags, SDL_Init_fake.arg0_val);
+  ASSERT_EQ(2u, SDL_setenv_fake.call_count);
+  ASSERT_STREQ("dummy", SDL_setenv_fake.arg1_history[0]);
+  ASSERT_STREQ("dummy", SDL_setenv_fake.arg1_history[1]);
+
+  /* The mixer doesn't need any decoders, but still opens the silent audio device */
+  ASSERT_EQ(0u, Mix_Init_fake.call_count);
+  ASSERT_EQ(0u, IMG_Init_fake.call_count);
+  ASSERT_EQ(0u, TTF_Init_fake.call_count);
+  ASSERT_EQ(1u, Mix_OpenAudioDevice_fake.call_count);
+}
+
+TEST_F(InitializationTest, IsHeadless)
+{
+  ASSERT_TRUE(cen::is_headless());
+
+  SDL_GetCurrentVideoDriver_fake.return_val = "dummy";
+  ASSERT_TRUE(cen::is_headless());
+
+  SDL_GetCurrentVideoDriver_fake.return_val = "x11";
+  ASSERT_FALSE(cen::is_headless());
+}
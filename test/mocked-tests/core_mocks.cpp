@@ -31,7 +31,7 @@ DEFINE_FAKE_VALUE_FUNC(int, SDL_Init, Uint32)
 DEFINE_FAKE_VALUE_FUNC(int, TTF_Init)
 DEFINE_FAKE_VALUE_FUNC(int, IMG_Init, int)
 DEFINE_FAKE_VALUE_FUNC(int, Mix_Init, int)
-DEFINE_FAKE_VALUE_FUNC(int, Mix_OpenAudio, int, Uint16, int, int)
+DEFINE_FAKE_VALUE_FUNC(int, Mix_OpenAudioDevice, int, Uint16, int, int, const char*, int)
 DEFINE_FAKE_VALUE_FUNC(SDL_Window*, SDL_CreateWindow, const char*, int, int, int, int, Uint32)
 
 DEFINE_FAKE_VOID_FUNC(SDL_Quit)
@@ -44,9 +44,15 @@ DEFINE_FAKE_VOID_FUNC(SDL_DestroyWindow, SDL_Window*)
 DEFINE_FAKE_VOID_FUNC(SDL_FreeSurface, SDL_Surface*)
 
 DEFINE_FAKE_VALUE_FUNC(const char*, SDL_GetError);
+DEFINE_FAKE_VALUE_FUNC(Uint64, SDL_GetPerformanceCounter);
+DEFINE_FAKE_VALUE_FUNC(Uint64, SDL_GetPerformanceFrequency);
 DEFINE_FAKE_VALUE_FUNC(SDL_RWops*, SDL_RWFromFile, const char*, const char*)
 
 DEFINE_FAKE_VALUE_FUNC(Uint32, SDL_GetWindowFlags, SDL_Window*)
+
+DEFINE_FAKE_VOID_FUNC(SDL_UnloadObject, void*)
+DEFINE_FAKE_VALUE_FUNC(void*, SDL_LoadObject, const char*)
+DEFINE_FAKE_VALUE_FUNC(void*, SDL_LoadFunction, void*, const char*)
 }
 
 namespace mocks {
@@ -61,7 +67,8 @@ void reset_core()
   RESET_FAKE(SDL_Init)
   RESET_FAKE(TTF_Init)
   RESET_FAKE(IMG_Init)
-  RESET_FAKE(Mix_OpenAudio)
+  RESET_FAKE(Mix_Init)
+  RESET_FAKE(Mix_OpenAudioDevice)
   RESET_FAKE(SDL_CreateWindow)
 
   RESET_FAKE(SDL_Quit)
@@ -74,10 +81,16 @@ void reset_core()
   RESET_FAKE(SDL_FreeSurface)
 
   RESET_FAKE(SDL_GetError)
+  RESET_FAKE(SDL_GetPerformanceCounter)
+  RESET_FAKE(SDL_GetPerformanceFrequency)
   RESET_FAKE(SDL_RWFromFile)
 
   RESET_FAKE(SDL_GetWindowFlags)
 
+  RESET_FAKE(SDL_UnloadObject)
+  RESET_FAKE(SDL_LoadObject)
+  RESET_FAKE(SDL_LoadFunction)
+
   SET_RETURN_SEQ(SDL_GetError, dummy_error_msg.data(), cen::isize(dummy_error_msg))
 }
 
@@ -44,7 +44,7 @@ DECLARE_FAKE_VALUE_FUNC(int, SDL_Init, Uint32)
 DECLARE_FAKE_VALUE_FUNC(int, TTF_Init)
 DECLARE_FAKE_VALUE_FUNC(int, IMG_Init, int)
 DECLARE_FAKE_VALUE_FUNC(int, Mix_Init, int)
-DECLARE_FAKE_VALUE_FUNC(int, Mix_OpenAudio, int, Uint16, int, int)
+DECLARE_FAKE_VALUE_FUNC(int, Mix_OpenAudioDevice, int, Uint16, int, int, const char*, int)
 DECLARE_FAKE_VALUE_FUNC(SDL_Window*, SDL_CreateWindow, const char*, int, int, int, int, Uint32)
 
 // Cleanup
@@ -59,10 +59,17 @@ DECLARE_FAKE_VOID_FUNC(SDL_FreeSurface, SDL_Surface*)
 
 // Misc
 DECLARE_FAKE_VALUE_FUNC(const char*, SDL_GetError)
+DECLARE_FAKE_VALUE_FUNC(Uint64, SDL_GetPerformanceCounter)
+DECLARE_FAKE_VALUE_FUNC(Uint64, SDL_GetPerformanceFrequency)
 DECLARE_FAKE_VALUE_FUNC(SDL_RWops*, SDL_RWFromFile, const char*, const char*)
 
 // Window
 DECLARE_FAKE_VALUE_FUNC(Uint32, SDL_GetWindowFlags, SDL_Window*)
+
+// Shared objects
+DECLARE_FAKE_VOID_FUNC(SDL_UnloadObject, void*)
+DECLARE_FAKE_VALUE_FUNC(void*, SDL_LoadObject, const char*)
+DECLARE_FAKE_VALUE_FUNC(void*, SDL_LoadFunction, void*, const char*)
 }
 
 namespace mocks {
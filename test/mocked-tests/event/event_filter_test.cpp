@@ -0,0 +1,115 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/events/event_filter.hpp"
+
+#include <fff.h>
+#include <gtest/gtest.h>
+
+#include "centurion/events/event_handler.hpp"
+#include "core_mocks.hpp"
+
+extern "C" {
+FAKE_VOID_FUNC(SDL_SetEventFilter, SDL_EventFilter, void*)
+FAKE_VALUE_FUNC(SDL_bool, SDL_GetEventFilter, SDL_EventFilter*, void**)
+FAKE_VOID_FUNC(SDL_AddEventWatch, SDL_EventFilter, void*)
+FAKE_VOID_FUNC(SDL_DelEventWatch, SDL_EventFilter, void*)
+FAKE_VALUE_FUNC(Uint8, SDL_EventState, Uint32, int)
+}
+
+class EventFilterTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    mocks::reset_core();
+
+    RESET_FAKE(SDL_SetEventFilter)
+    RESET_FAKE(SDL_GetEventFilter)
+    RESET_FAKE(SDL_AddEventWatch)
+    RESET_FAKE(SDL_DelEventWatch)
+    RESET_FAKE(SDL_EventState)
+  }
+};
+
+TEST_F(EventFilterTest, SetEventEnabled)
+{
+  cen::event_handler::set_event_enabled(cen::event_type::sensor_update, false);
+  ASSERT_EQ(static_cast<Uint32>(SDL_SENSORUPDATE), SDL_EventState_fake.arg0_val);
+  ASSERT_EQ(SDL_IGNORE, SDL_EventState_fake.arg1_val);
+
+  cen::event_handler::set_event_enabled(cen::event_type::sensor_update, true);
+  ASSERT_EQ(SDL_ENABLE, SDL_EventState_fake.arg1_val);
+
+  SDL_EventState_fake.return_val = SDL_ENABLE;
+  ASSERT_TRUE(cen::event_handler::is_event_enabled(cen::event_type::sensor_update));
+  ASSERT_EQ(SDL_QUERY, SDL_EventState_fake.arg1_val);
+
+  SDL_EventState_fake.return_val = SDL_IGNORE;
+  ASSERT_FALSE(cen::event_handler::is_event_enabled(cen::event_type::sensor_update));
+}
+
+TEST_F(EventFilterTest, Filter)
+{
+  auto predicate = [](const SDL_Event& event) { return event.type != SDL_SENSORUPDATE; };
+
+  {
+    const cen::event_filter filter {predicate};
+    ASSERT_EQ(1u, SDL_GetEventFilter_fake.call_count);
+    ASSERT_EQ(1u, SDL_SetEventFilter_fake.call_count);
+
+    auto callback = SDL_SetEventFilter_fake.arg0_val;
+    auto* data = SDL_SetEventFilter_fake.arg1_val;
+    ASSERT_TRUE(callback);
+
+    SDL_Event event {};
+    event.type = SDL_SENSORUPDATE;
+    ASSERT_EQ(0, callback(data, &event));
+
+    event.type = SDL_MOUSEMOTION;
+    ASSERT_EQ(1, callback(data, &event));
+  }
+
+  /* The previous (null) filter is restored */
+  ASSERT_EQ(2u, SDL_SetEventFilter_fake.call_count);
+  ASSERT_EQ(nullptr, SDL_SetEventFilter_fake.arg0_val);
+}
+
+TEST_F(EventFilterTest, Watch)
+{
+  int count {};
+  auto callable = [&](const SDL_Event&) { ++count; };
+
+  {
+    const cen::event_watch watch {callable};
+    ASSERT_EQ(1u, SDL_AddEventWatch_fake.call_count);
+
+    SDL_Event event {};
+    SDL_AddEventWatch_fake.arg0_val(SDL_AddEventWatch_fake.arg1_val, &event);
+    ASSERT_EQ(1, count);
+  }
+
+  ASSERT_EQ(1u, SDL_DelEventWatch_fake.call_count);
+  ASSERT_EQ(SDL_AddEventWatch_fake.arg0_val, SDL_DelEventWatch_fake.arg0_val);
+  ASSERT_EQ(SDL_AddEventWatch_fake.arg1_val, SDL_DelEventWatch_fake.arg1_val);
+}
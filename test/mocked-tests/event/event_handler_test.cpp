@@ -22,11 +22,14 @@
  * SOFTWARE.
  */
 
+#include "centurion/events/event_batch.hpp"
 #include "centurion/events/event_handler.hpp"
 
 #include <fff.h>
 #include <gtest/gtest.h>
 
+#include <array>  // array
+
 #include "core_mocks.hpp"
 
 extern "C" {
@@ -34,9 +37,31 @@ FAKE_VOID_FUNC(SDL_PumpEvents)
 FAKE_VOID_FUNC(SDL_FlushEvents, Uint32, Uint32)
 FAKE_VALUE_FUNC(int, SDL_PushEvent, SDL_Event*)
 FAKE_VALUE_FUNC(int, SDL_PollEvent, SDL_Event*)
+FAKE_VALUE_FUNC(int, SDL_WaitEvent, SDL_Event*)
+FAKE_VALUE_FUNC(int, SDL_WaitEventTimeout, SDL_Event*, int)
+FAKE_VALUE_FUNC(Uint32, SDL_RegisterEvents, int)
 FAKE_VALUE_FUNC(int, SDL_PeepEvents, SDL_Event*, int, SDL_eventaction, Uint32, Uint32)
 }
 
+namespace {
+
+inline auto peep_events(SDL_Event* events,
+                        const int count,
+                        SDL_eventaction,
+                        Uint32,
+                        Uint32) -> int
+{
+  const auto n = (count < 3) ? count : 3;
+  for (int i = 0; i < n; ++i) {
+    events[i] = {};
+    events[i].type = (i == 1) ? SDL_MOUSEMOTION : SDL_QUIT;
+  }
+
+  return n;
+}
+
+}  // namespace
+
 class EventTest : public testing::Test {
  protected:
   void SetUp() override
@@ -47,6 +72,9 @@ class EventTest : public testing::Test {
     RESET_FAKE(SDL_FlushEvents)
     RESET_FAKE(SDL_PushEvent)
     RESET_FAKE(SDL_PollEvent)
+    RESET_FAKE(SDL_WaitEvent)
+    RESET_FAKE(SDL_WaitEventTimeout)
+    RESET_FAKE(SDL_RegisterEvents)
     RESET_FAKE(SDL_PeepEvents)
   }
 };
@@ -82,6 +110,45 @@ TEST_F(EventTest, Poll)
   ASSERT_EQ(1u, SDL_PollEvent_fake.call_count);
 }
 
+TEST_F(EventTest, Wait)
+{
+  cen::event_handler handler;
+
+  std::array values {0, 1};
+  SET_RETURN_SEQ(SDL_WaitEvent, values.data(), cen::isize(values));
+
+  ASSERT_FALSE(handler.wait());
+  ASSERT_TRUE(handler.wait());
+  ASSERT_EQ(2u, SDL_WaitEvent_fake.call_count);
+}
+
+TEST_F(EventTest, WaitFor)
+{
+  cen::event_handler handler;
+
+  std::array values {0, 1};
+  SET_RETURN_SEQ(SDL_WaitEventTimeout, values.data(), cen::isize(values));
+
+  ASSERT_FALSE(handler.wait_for(cen::u32ms {10}));
+  ASSERT_EQ(10, SDL_WaitEventTimeout_fake.arg1_val);
+
+  ASSERT_TRUE(handler.wait_for(cen::u32ms {20}));
+  ASSERT_EQ(20, SDL_WaitEventTimeout_fake.arg1_val);
+}
+
+TEST_F(EventTest, Wake)
+{
+  /* The wake event type is registered once, so this fake must keep its return value */
+  SDL_RegisterEvents_fake.return_val = SDL_USEREVENT + 1;
+
+  ASSERT_EQ(SDL_USEREVENT + 1, cen::event_handler::wake_event_type());
+  ASSERT_TRUE(cen::event_handler::wake());
+  ASSERT_EQ(1u, SDL_PushEvent_fake.call_count);
+
+  SDL_PushEvent_fake.return_val = -1;
+  ASSERT_FALSE(cen::event_handler::wake());
+}
+
 TEST_F(EventTest, QueueCount)
 {
   const auto count [[maybe_unused]] = cen::event_handler::queue_count();
@@ -103,4 +170,91 @@ TEST_F(EventTest, QueueCountSpecific)
   ASSERT_EQ(SDL_PEEKEVENT, SDL_PeepEvents_fake.arg2_val);
   ASSERT_EQ(static_cast<Uint32>(SDL_QUIT), SDL_PeepEvents_fake.arg3_val);
   ASSERT_EQ(static_cast<Uint32>(SDL_QUIT), SDL_PeepEvents_fake.arg4_val);
-}
\ No newline at end of file
+}
+TEST_F(EventTest, EventBatchDrain)
+{
+  cen::event_batch batch {8};
+  ASSERT_EQ(8u, batch.capacity());
+  ASSERT_TRUE(batch.empty());
+
+  SDL_PeepEvents_fake.custom_fake = peep_events;
+
+  ASSERT_EQ(3u, batch.drain());
+  ASSERT_EQ(1u, SDL_PumpEvents_fake.call_count);
+  ASSERT_EQ(1u, SDL_PeepEvents_fake.call_count);
+  ASSERT_EQ(8, SDL_PeepEvents_fake.arg1_val);
+  ASSERT_EQ(SDL_GETEVENT, SDL_PeepEvents_fake.arg2_val);
+
+  ASSERT_EQ(3u, batch.size());
+  ASSERT_FALSE(batch.full());
+  ASSERT_EQ(static_cast<Uint32>(SDL_MOUSEMOTION), batch[1].type);
+
+  int quitCount {};
+  batch.each<cen::quit_event>([&](const cen::quit_event&) { ++quitCount; });
+  ASSERT_EQ(2, quitCount);
+
+  int total {};
+  batch.each([&](const cen::event_handler& event) {
+    if (event.is<cen::mouse_motion_event>()) {
+      ++total;
+    }
+  });
+  ASSERT_EQ(1, total);
+
+  batch.clear();
+  ASSERT_TRUE(batch.empty());
+}
+
+TEST_F(EventTest, EventBatchDrainFailure)
+{
+  cen::event_batch batch;
+
+  SDL_PeepEvents_fake.return_val = -1;
+  ASSERT_EQ(0u, batch.drain());
+  ASSERT_TRUE(batch.empty());
+}
+
+TEST_F(EventTest, EventBatchCoalesce)
+{
+  cen::event_batch batch {8};
+  batch.set_coalescing(true);
+  ASSERT_TRUE(batch.is_coalescing());
+
+  SDL_PeepEvents_fake.custom_fake =
+      [](SDL_Event* events, int, SDL_eventaction, Uint32, Uint32) {
+        for (int i = 0; i < 5; ++i) {
+          events[i] = {};
+          events[i].type = SDL_MOUSEMOTION;
+          events[i].motion.x = i;
+          events[i].motion.xrel = 1;
+          events[i].motion.yrel = 2;
+        }
+
+        /* A different button state must not be merged */
+        events[3].motion.state = SDL_BUTTON_LMASK;
+        events[4].motion.state = SDL_BUTTON_LMASK;
+
+        events[5] = {};
+        events[5].type = SDL_MOUSEWHEEL;
+        events[5].wheel.y = 1;
+
+        events[6] = events[5];
+        return 7;
+      };
+
+  ASSERT_EQ(3u, batch.drain());
+  ASSERT_FALSE(batch.full());
+
+  ASSERT_EQ(2, batch[0].motion.x);
+  ASSERT_EQ(3, batch[0].motion.xrel);
+  ASSERT_EQ(6, batch[0].motion.yrel);
+
+  ASSERT_EQ(4, batch[1].motion.x);
+  ASSERT_EQ(2, batch[1].motion.xrel);
+  ASSERT_EQ(static_cast<Uint32>(SDL_BUTTON_LMASK), batch[1].motion.state);
+
+  ASSERT_EQ(static_cast<Uint32>(SDL_MOUSEWHEEL), batch[2].type);
+  ASSERT_EQ(2, batch[2].wheel.y);
+
+  ASSERT_EQ(0u, batch.coalesce());
+}
@@ -23,12 +23,14 @@
  */
 
 #include "centurion/input/controller.hpp"
+#include "centurion/input/controller_state.hpp"
 
 #include <fff.h>
 #include <gtest/gtest.h>
 
 #include <array>     // array
 #include <iostream>  // cout
+#include <vector>    // vector
 
 #include "centurion/common/literals.hpp"
 #include "centurion/video/color.hpp"
@@ -37,6 +39,11 @@
 using namespace cen::literals;
 
 extern "C" {
+DECLARE_FAKE_VALUE_FUNC(int, SDL_NumJoysticks)
+DECLARE_FAKE_VALUE_FUNC(SDL_JoystickID, SDL_JoystickGetDeviceInstanceID, int)
+DECLARE_FAKE_VALUE_FUNC(SDL_JoystickID, SDL_JoystickInstanceID, SDL_Joystick*)
+
+FAKE_VALUE_FUNC(SDL_GameController*, SDL_GameControllerFromInstanceID, SDL_JoystickID)
 FAKE_VOID_FUNC(SDL_GameControllerUpdate)
 FAKE_VOID_FUNC(SDL_GameControllerSetPlayerIndex, SDL_GameController*, int)
 
@@ -167,6 +174,10 @@ class ControllerTest : public testing::Test {
   {
     mocks::reset_core();
 
+    RESET_FAKE(SDL_NumJoysticks)
+    RESET_FAKE(SDL_JoystickGetDeviceInstanceID)
+    RESET_FAKE(SDL_JoystickInstanceID)
+    RESET_FAKE(SDL_GameControllerFromInstanceID)
     RESET_FAKE(SDL_GameControllerUpdate)
     RESET_FAKE(SDL_GameControllerSetPlayerIndex)
     RESET_FAKE(SDL_GameControllerGetProduct)
@@ -757,3 +768,56 @@ TEST_F(ControllerTest, FirmwareVersion)
 }
 
 #endif  // SDL_VERSION_ATLEAST(2, 24, 0)
+
+TEST_F(ControllerTest, Capture)
+{
+  std::array buttons {Uint8 {1}, Uint8 {0}, Uint8 {1}};
+  SET_RETURN_SEQ(SDL_GameControllerGetButton, buttons.data(), cen::isize(buttons));
+
+  SDL_GameControllerGetAxis_fake.return_val = 42;
+  SDL_JoystickInstanceID_fake.return_val = 7;
+  SDL_GameControllerGetTouchpadFinger_fake.return_val = -1;
+  SDL_GameControllerGetSensorData_fake.return_val = -1;
+
+  const auto state = cen::capture(mController);
+  ASSERT_EQ(7, state.id);
+  ASSERT_TRUE(state.is_pressed(cen::controller_button::a));
+  ASSERT_FALSE(state.is_pressed(cen::controller_button::b));
+  ASSERT_TRUE(state.is_pressed(cen::controller_button::x));
+  ASSERT_FALSE(state.is_pressed(cen::controller_button::invalid));
+  ASSERT_EQ(42, state.axis(cen::controller_axis::left_x));
+  ASSERT_EQ(0, state.axis(cen::controller_axis::invalid));
+
+  ASSERT_EQ(cen::controller_state::button_count,
+            static_cast<int>(SDL_GameControllerGetButton_fake.call_count));
+  ASSERT_EQ(cen::controller_state::axis_count,
+            static_cast<int>(SDL_GameControllerGetAxis_fake.call_count));
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+  ASSERT_FALSE(state.has_gyro);
+  ASSERT_FALSE(state.has_accel);
+  ASSERT_EQ(cen::button_state::released, state.fingers[0].state);
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+}
+
+TEST_F(ControllerTest, PollAllControllers)
+{
+  std::array supported {SDL_TRUE, SDL_FALSE, SDL_TRUE};
+  SET_RETURN_SEQ(SDL_IsGameController, supported.data(), cen::isize(supported));
+
+  std::array<SDL_GameController*, 2> controllers {reinterpret_cast<SDL_GameController*>(1),
+                                                  nullptr};
+  SET_RETURN_SEQ(SDL_GameControllerFromInstanceID,
+                 controllers.data(),
+                 cen::isize(controllers));
+
+  SDL_NumJoysticks_fake.return_val = 3;
+
+  std::vector<cen::controller_state> states(4);
+  ASSERT_EQ(1u, cen::poll_all_controllers(states));
+  ASSERT_EQ(1u, states.size());
+
+  ASSERT_EQ(1u, SDL_GameControllerUpdate_fake.call_count);
+  ASSERT_EQ(3u, SDL_IsGameController_fake.call_count);
+  ASSERT_EQ(2u, SDL_GameControllerFromInstanceID_fake.call_count);
+}
@@ -0,0 +1,170 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/input/device_registry.hpp"
+
+#include <fff.h>
+#include <gtest/gtest.h>
+
+#include <array>    // array
+#include <cstdint>  // uintptr_t
+
+#include "centurion/events/controller_events.hpp"
+#include "centurion/events/joystick_events.hpp"
+
+extern "C" {
+DECLARE_FAKE_VALUE_FUNC(SDL_bool, SDL_IsGameController, int)
+DECLARE_FAKE_VALUE_FUNC(SDL_Joystick*, SDL_GameControllerGetJoystick, SDL_GameController*)
+DECLARE_FAKE_VALUE_FUNC(SDL_JoystickID, SDL_JoystickInstanceID, SDL_Joystick*)
+DECLARE_FAKE_VALUE_FUNC(int, SDL_GameControllerGetPlayerIndex, SDL_GameController*)
+
+FAKE_VALUE_FUNC(SDL_GameController*, SDL_GameControllerOpen, int)
+FAKE_VOID_FUNC(SDL_GameControllerClose, SDL_GameController*)
+FAKE_VALUE_FUNC(SDL_Joystick*, SDL_JoystickOpen, int)
+FAKE_VOID_FUNC(SDL_JoystickClose, SDL_Joystick*)
+}
+
+using cen::event_type;
+
+namespace {
+
+/* Device indices are used as both fake pointers and instance IDs */
+
+auto open_controller(const int index) -> SDL_GameController*
+{
+  return reinterpret_cast<SDL_GameController*>(static_cast<std::uintptr_t>(index + 1));
+}
+
+auto open_joystick(const int index) -> SDL_Joystick*
+{
+  return reinterpret_cast<SDL_Joystick*>(static_cast<std::uintptr_t>(index + 1));
+}
+
+auto get_joystick(SDL_GameController* controller) -> SDL_Joystick*
+{
+  return reinterpret_cast<SDL_Joystick*>(controller);
+}
+
+auto instance_id(SDL_Joystick* joystick) -> SDL_JoystickID
+{
+  return static_cast<SDL_JoystickID>(reinterpret_cast<std::uintptr_t>(joystick)) - 1;
+}
+
+auto player_index(SDL_GameController* controller) -> int
+{
+  return static_cast<int>(reinterpret_cast<std::uintptr_t>(controller)) * 10;
+}
+
+auto make_controller_event(const cen::event_type type, const int which)
+    -> cen::controller_device_event
+{
+  cen::controller_device_event event;
+  event.set_type(type);
+  event.set_which(which);
+  return event;
+}
+
+auto make_joystick_event(const cen::event_type type, const int which)
+    -> cen::joy_device_event
+{
+  cen::joy_device_event event;
+  event.set_type(type);
+  event.set_which(which);
+  return event;
+}
+
+}  // namespace
+
+class DeviceRegistryTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    RESET_FAKE(SDL_IsGameController)
+    RESET_FAKE(SDL_GameControllerGetJoystick)
+    RESET_FAKE(SDL_JoystickInstanceID)
+    RESET_FAKE(SDL_GameControllerGetPlayerIndex)
+    RESET_FAKE(SDL_GameControllerOpen)
+    RESET_FAKE(SDL_GameControllerClose)
+    RESET_FAKE(SDL_JoystickOpen)
+    RESET_FAKE(SDL_JoystickClose)
+
+    SDL_GameControllerOpen_fake.custom_fake = open_controller;
+    SDL_JoystickOpen_fake.custom_fake = open_joystick;
+    SDL_GameControllerGetJoystick_fake.custom_fake = get_joystick;
+    SDL_JoystickInstanceID_fake.custom_fake = instance_id;
+    SDL_GameControllerGetPlayerIndex_fake.custom_fake = player_index;
+  }
+};
+
+TEST_F(DeviceRegistryTest, Controllers)
+{
+  cen::device_registry registry;
+
+  ASSERT_TRUE(registry.update(make_controller_event(event_type::controller_device_added, 0)));
+  ASSERT_TRUE(registry.update(make_controller_event(event_type::controller_device_added, 1)));
+  ASSERT_TRUE(registry.update(make_controller_event(event_type::controller_device_added, 2)));
+  ASSERT_EQ(3u, registry.controller_count());
+
+  /* Duplicate events are ignored, and the extra reference is released */
+  ASSERT_FALSE(registry.update(make_controller_event(event_type::controller_device_added, 1)));
+  ASSERT_EQ(3u, registry.controller_count());
+  ASSERT_EQ(1u, SDL_GameControllerClose_fake.call_count);
+
+  ASSERT_TRUE(registry.find_controller(1));
+  ASSERT_FALSE(registry.find_controller(3));
+  ASSERT_EQ(open_controller(2), registry.find_player(30).get());
+
+  ASSERT_TRUE(
+      registry.update(make_controller_event(event_type::controller_device_removed, 0)));
+  ASSERT_EQ(2u, registry.controller_count());
+  ASSERT_FALSE(registry.find_controller(0));
+  ASSERT_FALSE(registry.find_player(10));
+
+  /* The moved controller must still be found */
+  ASSERT_EQ(open_controller(2), registry.find_controller(2).get());
+  ASSERT_EQ(open_controller(1), registry.find_controller(1).get());
+
+  ASSERT_FALSE(
+      registry.update(make_controller_event(event_type::controller_device_removed, 0)));
+}
+
+TEST_F(DeviceRegistryTest, Joysticks)
+{
+  cen::device_registry registry;
+
+  std::array values {SDL_TRUE, SDL_FALSE};
+  SET_RETURN_SEQ(SDL_IsGameController, values.data(), cen::isize(values));
+
+  /* Game controllers are only opened through controller events */
+  ASSERT_FALSE(registry.update(make_joystick_event(event_type::joy_device_added, 0)));
+  ASSERT_TRUE(registry.update(make_joystick_event(event_type::joy_device_added, 4)));
+  ASSERT_EQ(1u, registry.joystick_count());
+  ASSERT_EQ(1u, SDL_JoystickOpen_fake.call_count);
+
+  ASSERT_EQ(open_joystick(4), registry.find_joystick(4).get());
+
+  ASSERT_TRUE(registry.update(make_joystick_event(event_type::joy_device_removed, 4)));
+  ASSERT_EQ(0u, registry.joystick_count());
+  ASSERT_EQ(1u, SDL_JoystickClose_fake.call_count);
+}
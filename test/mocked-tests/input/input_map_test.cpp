@@ -0,0 +1,183 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/input/input_map.hpp"
+
+#include <fff.h>
+#include <gtest/gtest.h>
+
+#include <array>  // array
+
+extern "C" {
+DECLARE_FAKE_VALUE_FUNC(const Uint8*, SDL_GetKeyboardState, int*)
+DECLARE_FAKE_VALUE_FUNC(Uint8,
+                        SDL_GameControllerGetButton,
+                        SDL_GameController*,
+                        SDL_GameControllerButton)
+DECLARE_FAKE_VALUE_FUNC(Sint16,
+                        SDL_GameControllerGetAxis,
+                        SDL_GameController*,
+                        SDL_GameControllerAxis)
+FAKE_VALUE_FUNC(Uint32, SDL_GetMouseState, int*, int*)
+}
+
+namespace {
+
+inline std::array<Uint8, SDL_NUM_SCANCODES> keys {};
+
+auto get_keyboard_state(int* count) -> const Uint8*
+{
+  *count = SDL_NUM_SCANCODES;
+  return keys.data();
+}
+
+}  // namespace
+
+class InputMapTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    RESET_FAKE(SDL_GetKeyboardState)
+    RESET_FAKE(SDL_GameControllerGetButton)
+    RESET_FAKE(SDL_GameControllerGetAxis)
+    RESET_FAKE(SDL_GetMouseState)
+
+    keys = {};
+    SDL_GetKeyboardState_fake.custom_fake = get_keyboard_state;
+  }
+
+  cen::input_map mMap;
+};
+
+TEST_F(InputMapTest, AddAction)
+{
+  const auto jump = mMap.add_action("jump");
+  const auto fire = mMap.add_action("fire");
+  ASSERT_NE(jump, fire);
+  ASSERT_EQ(2u, mMap.action_count());
+
+  ASSERT_EQ(jump, mMap.find_action("jump"));
+  ASSERT_FALSE(mMap.find_action("crouch"));
+  ASSERT_THROW(mMap.add_action("jump"), cen::exception);
+}
+
+TEST_F(InputMapTest, AddAxis)
+{
+  const auto x = mMap.add_axis("move_x");
+  ASSERT_EQ(1u, mMap.axis_count());
+  ASSERT_EQ(x, mMap.find_axis("move_x"));
+  ASSERT_FALSE(mMap.find_axis("move_y"));
+  ASSERT_THROW(mMap.add_axis("move_x"), cen::exception);
+}
+
+TEST_F(InputMapTest, KeyboardAction)
+{
+  const auto jump = mMap.add_action("jump");
+  mMap.bind(jump, cen::scan_code {SDL_SCANCODE_SPACE});
+  mMap.bind(jump, cen::scan_code {SDL_SCANCODE_W});
+  ASSERT_EQ(2u, mMap.binding_count());
+
+  mMap.update();
+  ASSERT_FALSE(mMap.is_active(jump));
+  ASSERT_EQ(1u, SDL_GetKeyboardState_fake.call_count);
+
+  keys[SDL_SCANCODE_W] = 1;
+  mMap.update();
+  ASSERT_TRUE(mMap.is_active(jump));
+  ASSERT_TRUE(mMap.just_activated(jump));
+
+  mMap.update();
+  ASSERT_TRUE(mMap.is_active(jump));
+  ASSERT_FALSE(mMap.just_activated(jump));
+
+  keys[SDL_SCANCODE_W] = 0;
+  mMap.update();
+  ASSERT_FALSE(mMap.is_active(jump));
+  ASSERT_TRUE(mMap.just_deactivated(jump));
+}
+
+TEST_F(InputMapTest, MouseAction)
+{
+  const auto fire = mMap.add_action("fire");
+  mMap.bind(fire, cen::mouse_button::left);
+
+  SDL_GetMouseState_fake.return_val = SDL_BUTTON_RMASK;
+  mMap.update();
+  ASSERT_FALSE(mMap.is_active(fire));
+
+  SDL_GetMouseState_fake.return_val = SDL_BUTTON_LMASK;
+  mMap.update();
+  ASSERT_TRUE(mMap.is_active(fire));
+}
+
+TEST_F(InputMapTest, KeyboardAxis)
+{
+  const auto x = mMap.add_axis("move_x");
+  mMap.bind_axis(x, cen::scan_code {SDL_SCANCODE_A}, cen::scan_code {SDL_SCANCODE_D});
+
+  mMap.update();
+  ASSERT_EQ(0, mMap.value(x));
+
+  keys[SDL_SCANCODE_A] = 1;
+  mMap.update();
+  ASSERT_EQ(-1, mMap.value(x));
+
+  keys[SDL_SCANCODE_D] = 1;
+  mMap.update();
+  ASSERT_EQ(0, mMap.value(x));
+}
+
+TEST_F(InputMapTest, ControllerBindings)
+{
+  const auto jump = mMap.add_action("jump");
+  const auto x = mMap.add_axis("move_x");
+
+  mMap.bind(jump, cen::controller_button::a);
+  mMap.bind_axis(x, cen::controller_axis::left_x, 0.25f);
+  mMap.bind_axis(x, cen::scan_code {SDL_SCANCODE_A}, cen::scan_code {SDL_SCANCODE_D});
+
+  const cen::controller_handle controller {reinterpret_cast<SDL_GameController*>(1)};
+
+  SDL_GameControllerGetButton_fake.return_val = 1;
+  SDL_GameControllerGetAxis_fake.return_val = 1'000;  // Within the deadzone
+  mMap.update(controller);
+  ASSERT_TRUE(mMap.is_active(jump));
+  ASSERT_EQ(0, mMap.value(x));
+  ASSERT_EQ(1u, SDL_GameControllerGetButton_fake.call_count);
+  ASSERT_EQ(SDL_CONTROLLER_BUTTON_A, SDL_GameControllerGetButton_fake.arg1_val);
+
+  /* The sum of all bindings is clamped */
+  keys[SDL_SCANCODE_D] = 1;
+  SDL_GameControllerGetAxis_fake.return_val = 32'767;
+  mMap.update(controller);
+  ASSERT_EQ(1, mMap.value(x));
+
+  /* Controller bindings are ignored when no controller is supplied */
+  mMap.update();
+  ASSERT_FALSE(mMap.is_active(jump));
+  ASSERT_EQ(2u, SDL_GameControllerGetButton_fake.call_count);
+
+  mMap.clear_bindings();
+  ASSERT_EQ(0u, mMap.binding_count());
+}
@@ -28,6 +28,12 @@ extern "C" {
 DEFINE_FAKE_VALUE_FUNC(const char*, Mix_GetChunkDecoder, int)
 DEFINE_FAKE_VALUE_FUNC(SDL_bool, Mix_HasChunkDecoder, const char*)
 DEFINE_FAKE_VALUE_FUNC(int, Mix_GetNumChunkDecoders)
+DEFINE_FAKE_VALUE_FUNC(int, Mix_Playing, int)
+DEFINE_FAKE_VALUE_FUNC(int, Mix_QuerySpec, int*, Uint16*, int*)
+
+#if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+DEFINE_FAKE_VALUE_FUNC(int, Mix_PlayChannel, int, Mix_Chunk*, int)
+#endif  // SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
 }
 
 namespace mocks {
@@ -37,6 +43,12 @@ void reset_mixer()
   RESET_FAKE(Mix_GetChunkDecoder)
   RESET_FAKE(Mix_HasChunkDecoder)
   RESET_FAKE(Mix_GetNumChunkDecoders)
+  RESET_FAKE(Mix_Playing)
+  RESET_FAKE(Mix_QuerySpec)
+
+#if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+  RESET_FAKE(Mix_PlayChannel)
+#endif  // SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
 }
 
 }  // namespace mocks
@@ -32,6 +32,12 @@ extern "C" {
 DECLARE_FAKE_VALUE_FUNC(const char*, Mix_GetChunkDecoder, int)
 DECLARE_FAKE_VALUE_FUNC(SDL_bool, Mix_HasChunkDecoder, const char*)
 DECLARE_FAKE_VALUE_FUNC(int, Mix_GetNumChunkDecoders)
+DECLARE_FAKE_VALUE_FUNC(int, Mix_Playing, int)
+DECLARE_FAKE_VALUE_FUNC(int, Mix_QuerySpec, int*, Uint16*, int*)
+
+#if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+DECLARE_FAKE_VALUE_FUNC(int, Mix_PlayChannel, int, Mix_Chunk*, int)
+#endif  // SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
 }
 
 namespace mocks {
@@ -0,0 +1,137 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/system/plugin_interface.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>  // strcmp
+
+#include "core_mocks.hpp"
+
+namespace {
+
+struct test_api final {
+  int (*version)() {};
+  int (*add)(int, int) {};
+  void (*shutdown)() {};
+};
+
+void bind_symbols(cen::symbol_binder& binder, test_api& api)
+{
+  binder.required("plugin_version", api.version);
+  binder.required("plugin_add", api.add);
+  binder.optional("plugin_shutdown", api.shutdown);
+}
+
+auto version_one() -> int { return 1; }
+auto version_two() -> int { return 2; }
+auto add(const int a, const int b) -> int { return a + b; }
+
+int version_generation = 1;
+bool provide_add = true;
+
+auto load_function(void*, const char* name) -> void*
+{
+  if (std::strcmp(name, "plugin_version") == 0) {
+    return reinterpret_cast<void*>((version_generation == 1) ? &version_one : &version_two);
+  }
+  else if (std::strcmp(name, "plugin_add") == 0 && provide_add) {
+    return reinterpret_cast<void*>(&add);
+  }
+  else {
+    return nullptr;
+  }
+}
+
+}  // namespace
+
+class PluginInterfaceTest : public testing::Test {
+ public:
+  void SetUp() override
+  {
+    mocks::reset_core();
+
+    version_generation = 1;
+    provide_add = true;
+
+    static int object {};
+    SDL_LoadObject_fake.return_val = &object;
+    SDL_LoadFunction_fake.custom_fake = load_function;
+  }
+};
+
+TEST_F(PluginInterfaceTest, Load)
+{
+  cen::plugin_interface<test_api> plugin {"plugin.so"};
+
+  ASSERT_EQ(1u, SDL_LoadObject_fake.call_count);
+  ASSERT_EQ(3u, SDL_LoadFunction_fake.call_count);
+
+  ASSERT_EQ(1, plugin->version());
+  ASSERT_EQ(5, plugin.table().add(2, 3));
+  ASSERT_EQ(nullptr, plugin->shutdown);
+
+  ASSERT_EQ("plugin.so", plugin.path());
+  ASSERT_EQ(1u, plugin.loads());
+  ASSERT_EQ(0u, plugin.retired_count());
+
+  /* The table is cached, so calls don't resolve symbols */
+  ASSERT_EQ(1, plugin->version());
+  ASSERT_EQ(3u, SDL_LoadFunction_fake.call_count);
+}
+
+TEST_F(PluginInterfaceTest, LoadFailure)
+{
+  provide_add = false;
+  ASSERT_THROW(cen::plugin_interface<test_api> {"plugin.so"}, cen::exception);
+
+  SDL_LoadObject_fake.return_val = nullptr;
+  ASSERT_THROW(cen::plugin_interface<test_api> {"plugin.so"}, cen::sdl_error);
+}
+
+TEST_F(PluginInterfaceTest, Reload)
+{
+  cen::plugin_interface<test_api> plugin {"plugin.so"};
+
+  version_generation = 2;
+  ASSERT_TRUE(plugin.reload("plugin-2.so"));
+  ASSERT_EQ(2, plugin->version());
+  ASSERT_EQ("plugin-2.so", plugin.path());
+  ASSERT_EQ(1u, plugin.retired_count());
+
+  /* The previous version stays loaded until it's released */
+  ASSERT_EQ(0u, SDL_UnloadObject_fake.call_count);
+  plugin.release_retired();
+  ASSERT_EQ(1u, SDL_UnloadObject_fake.call_count);
+  ASSERT_EQ(0u, plugin.retired_count());
+
+  /* A failed reload keeps the current table */
+  provide_add = false;
+  version_generation = 1;
+  ASSERT_FALSE(plugin.reload());
+  ASSERT_STREQ("plugin_add", plugin.missing_symbol());
+  ASSERT_EQ(2, plugin->version());
+  ASSERT_EQ(2u, plugin.loads());
+}
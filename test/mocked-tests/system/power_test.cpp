@@ -144,3 +144,39 @@ TEST_F(BatteryTest, IsBatteryCharged)
   SDL_GetPowerInfo_fake.return_val = SDL_POWERSTATE_CHARGING;
   ASSERT_FALSE(cen::is_battery_charged());
 }
+
+TEST_F(BatteryTest, QueryPowerInfo)
+{
+  SDL_GetPowerInfo_fake.custom_fake = PowerDelegate;
+
+  const auto info = cen::query_power_info();
+  ASSERT_EQ(1u, SDL_GetPowerInfo_fake.call_count);
+  ASSERT_EQ(cen::power_state::on_battery, info.state);
+  ASSERT_EQ(seconds, info.seconds_left);
+  ASSERT_EQ(percentage, info.percentage);
+}
+
+TEST_F(BatteryTest, PowerCache)
+{
+  SDL_GetPowerInfo_fake.return_val = SDL_POWERSTATE_CHARGING;
+
+  cen::power_cache cache {cen::u32ms {1'000}};
+  ASSERT_EQ(1u, SDL_GetPowerInfo_fake.call_count);
+  ASSERT_EQ(cen::power_state::charging, cache.state());
+  ASSERT_FALSE(cache.percentage());
+
+  /* Queries in between refreshes are served from the cache */
+  ASSERT_EQ(cen::power_state::charging, cache.state());
+  ASSERT_EQ(1u, SDL_GetPowerInfo_fake.call_count);
+
+  SDL_GetPowerInfo_fake.return_val = SDL_POWERSTATE_CHARGED;
+  ASSERT_TRUE(cache.refresh());
+  ASSERT_FALSE(cache.refresh());
+  ASSERT_EQ(cen::power_state::charged, cache.state());
+  ASSERT_EQ(3u, SDL_GetPowerInfo_fake.call_count);
+
+  SDL_GetPowerInfo_fake.custom_fake = PowerDelegate;
+  ASSERT_TRUE(cache.poll(cen::u32ms {SDL_GetTicks() + 1'000}));
+  ASSERT_EQ(percentage, cache.percentage());
+  ASSERT_EQ(seconds, cache.seconds_left());
+}
@@ -27,20 +27,11 @@
 #include "centurion/system.hpp"
 #include "core_mocks.hpp"
 
-extern "C" {
-FAKE_VOID_FUNC(SDL_UnloadObject, void*)
-FAKE_VALUE_FUNC(void*, SDL_LoadObject, const char*)
-FAKE_VALUE_FUNC(void*, SDL_LoadFunction, void*, const char*)
-}
-
 class SharedObjectTest : public testing::Test {
  public:
   void SetUp() override
   {
     mocks::reset_core();
-    RESET_FAKE(SDL_UnloadObject)
-    RESET_FAKE(SDL_LoadObject)
-    RESET_FAKE(SDL_LoadFunction)
   }
 
   cen::shared_object mObject;
@@ -0,0 +1,176 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/display_registry.hpp"
+
+#include <fff.h>
+#include <gtest/gtest.h>
+
+#include "centurion/events/misc_events.hpp"
+#include "centurion/events/window_events.hpp"
+
+extern "C" {
+FAKE_VALUE_FUNC(int, SDL_GetNumVideoDisplays)
+FAKE_VALUE_FUNC(const char*, SDL_GetDisplayName, int)
+FAKE_VALUE_FUNC(int, SDL_GetCurrentDisplayMode, int, SDL_DisplayMode*)
+FAKE_VALUE_FUNC(int, SDL_GetDesktopDisplayMode, int, SDL_DisplayMode*)
+FAKE_VALUE_FUNC(SDL_DisplayOrientation, SDL_GetDisplayOrientation, int)
+FAKE_VALUE_FUNC(int, SDL_GetDisplayDPI, int, float*, float*, float*)
+FAKE_VALUE_FUNC(int, SDL_GetDisplayBounds, int, SDL_Rect*)
+FAKE_VALUE_FUNC(int, SDL_GetDisplayUsableBounds, int, SDL_Rect*)
+}
+
+namespace {
+
+/* Displays are laid out side by side, each 1920 pixels wide */
+
+float fake_dpi = 96;
+
+auto get_display_mode(const int index, SDL_DisplayMode* mode) -> int
+{
+  *mode = {};
+  mode->w = 1920;
+  mode->h = 1080;
+  mode->refresh_rate = 60 * (index + 1);
+  return 0;
+}
+
+auto get_display_dpi(int, float* diagonal, float* horizontal, float* vertical) -> int
+{
+  *diagonal = fake_dpi;
+  *horizontal = fake_dpi;
+  *vertical = fake_dpi;
+  return 0;
+}
+
+auto get_display_bounds(const int index, SDL_Rect* rect) -> int
+{
+  *rect = {index * 1920, 0, 1920, 1080};
+  return 0;
+}
+
+}  // namespace
+
+class DisplayRegistryTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    RESET_FAKE(SDL_GetNumVideoDisplays)
+    RESET_FAKE(SDL_GetDisplayName)
+    RESET_FAKE(SDL_GetCurrentDisplayMode)
+    RESET_FAKE(SDL_GetDesktopDisplayMode)
+    RESET_FAKE(SDL_GetDisplayOrientation)
+    RESET_FAKE(SDL_GetDisplayDPI)
+    RESET_FAKE(SDL_GetDisplayBounds)
+    RESET_FAKE(SDL_GetDisplayUsableBounds)
+
+    fake_dpi = 96;
+
+    SDL_GetNumVideoDisplays_fake.return_val = 2;
+    SDL_GetDisplayName_fake.return_val = "foo";
+    SDL_GetCurrentDisplayMode_fake.custom_fake = get_display_mode;
+    SDL_GetDesktopDisplayMode_fake.custom_fake = get_display_mode;
+    SDL_GetDisplayDPI_fake.custom_fake = get_display_dpi;
+    SDL_GetDisplayBounds_fake.custom_fake = get_display_bounds;
+    SDL_GetDisplayUsableBounds_fake.custom_fake = get_display_bounds;
+  }
+};
+
+TEST_F(DisplayRegistryTest, Construction)
+{
+  const cen::display_registry registry;
+  ASSERT_EQ(2u, registry.count());
+  ASSERT_EQ(1u, registry.generation());
+  ASSERT_EQ(2u, SDL_GetDisplayDPI_fake.call_count);
+
+  ASSERT_EQ("foo", registry.name(1).value());
+  ASSERT_EQ(120, registry.current_mode(1)->refresh_rate());
+  ASSERT_EQ(1920, registry.desktop_mode(0)->width());
+  ASSERT_EQ(96, registry.dpi(0)->horizontal);
+  ASSERT_EQ(cen::irect(1920, 0, 1920, 1080), registry.bounds(1));
+
+  /* Queries are served from the cache */
+  ASSERT_EQ(2u, SDL_GetDisplayDPI_fake.call_count);
+  ASSERT_EQ(2u, SDL_GetDisplayBounds_fake.call_count);
+
+  ASSERT_FALSE(registry.find(-1));
+  ASSERT_FALSE(registry.find(2));
+  ASSERT_FALSE(registry.dpi(2));
+}
+
+TEST_F(DisplayRegistryTest, Refresh)
+{
+  cen::display_registry registry;
+
+  /* Unchanged display properties don't invalidate dependent caches */
+  ASSERT_FALSE(registry.refresh());
+  ASSERT_EQ(1u, registry.generation());
+
+  fake_dpi = 144;
+  ASSERT_TRUE(registry.refresh());
+  ASSERT_EQ(2u, registry.generation());
+  ASSERT_EQ(144, registry.dpi(1)->diagonal);
+
+  SDL_GetNumVideoDisplays_fake.return_val = 1;
+  ASSERT_TRUE(registry.refresh());
+  ASSERT_EQ(3u, registry.generation());
+  ASSERT_EQ(1u, registry.count());
+}
+
+TEST_F(DisplayRegistryTest, DisplayWith)
+{
+  const cen::display_registry registry;
+  ASSERT_EQ(0, registry.display_with(cen::ipoint {10, 10}));
+  ASSERT_EQ(1, registry.display_with(cen::ipoint {1930, 10}));
+  ASSERT_FALSE(registry.display_with(cen::ipoint {-10, 10}));
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+TEST_F(DisplayRegistryTest, Events)
+{
+  cen::display_registry registry;
+
+  cen::display_event display;
+  display.set_event_id(cen::display_event_id::connected);
+
+  SDL_GetNumVideoDisplays_fake.return_val = 3;
+  ASSERT_TRUE(registry.update(display));
+  ASSERT_EQ(3u, registry.count());
+
+  cen::window_event window;
+  window.set_event_id(cen::window_event_id::moved);
+
+  fake_dpi = 72;
+  ASSERT_FALSE(registry.update(window));
+  ASSERT_EQ(96, registry.dpi()->vertical);
+
+  window.set_event_id(cen::window_event_id::display_changed);
+  ASSERT_TRUE(registry.update(window));
+  ASSERT_EQ(72, registry.dpi()->vertical);
+  ASSERT_EQ(3u, registry.generation());
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
@@ -30,7 +30,9 @@
 #include <array>        // array
 #include <tuple>        // tuple, make_tuple
 #include <type_traits>  // is_same_v
+#include <vector>       // vector
 
+#include "centurion/video/render_command_list.hpp"
 #include "core_mocks.hpp"
 
 extern "C" {
@@ -48,6 +50,12 @@ FAKE_VALUE_FUNC(int, SDL_RenderDrawLine, SDL_Renderer*, int, int, int, int)
 FAKE_VALUE_FUNC(int, SDL_RenderDrawLineF, SDL_Renderer*, float, float, float, float)
 FAKE_VALUE_FUNC(int, SDL_RenderDrawLines, SDL_Renderer*, const SDL_Point*, int)
 FAKE_VALUE_FUNC(int, SDL_RenderDrawLinesF, SDL_Renderer*, const SDL_FPoint*, int)
+FAKE_VALUE_FUNC(int, SDL_RenderDrawPoints, SDL_Renderer*, const SDL_Point*, int)
+FAKE_VALUE_FUNC(int, SDL_RenderDrawPointsF, SDL_Renderer*, const SDL_FPoint*, int)
+FAKE_VALUE_FUNC(int, SDL_RenderDrawRects, SDL_Renderer*, const SDL_Rect*, int)
+FAKE_VALUE_FUNC(int, SDL_RenderDrawRectsF, SDL_Renderer*, const SDL_FRect*, int)
+FAKE_VALUE_FUNC(int, SDL_RenderFillRects, SDL_Renderer*, const SDL_Rect*, int)
+FAKE_VALUE_FUNC(int, SDL_RenderFillRectsF, SDL_Renderer*, const SDL_FRect*, int)
 FAKE_VALUE_FUNC(int,
                 SDL_RenderCopy,
                 SDL_Renderer*,
@@ -90,6 +98,28 @@ FAKE_VALUE_FUNC(SDL_bool, SDL_RenderIsClipEnabled, SDL_Renderer*)
 #if SDL_VERSION_ATLEAST(2, 0, 18)
 
 FAKE_VALUE_FUNC(int, SDL_RenderSetVSync, SDL_Renderer*, int)
+FAKE_VALUE_FUNC(int,
+                SDL_RenderGeometry,
+                SDL_Renderer*,
+                SDL_Texture*,
+                const SDL_Vertex*,
+                int,
+                const int*,
+                int)
+FAKE_VALUE_FUNC(int,
+                SDL_RenderGeometryRaw,
+                SDL_Renderer*,
+                SDL_Texture*,
+                const float*,
+                int,
+                const SDL_Color*,
+                int,
+                const float*,
+                int,
+                int,
+                const void*,
+                int,
+                int)
 
 #endif  // SDL_VERSION_ATLEAST(2, 0, 18)
 }
@@ -115,6 +145,12 @@ class RendererTest : public testing::Test {
     RESET_FAKE(SDL_RenderDrawLineF)
     RESET_FAKE(SDL_RenderDrawLines)
     RESET_FAKE(SDL_RenderDrawLinesF)
+    RESET_FAKE(SDL_RenderDrawPoints)
+    RESET_FAKE(SDL_RenderDrawPointsF)
+    RESET_FAKE(SDL_RenderDrawRects)
+    RESET_FAKE(SDL_RenderDrawRectsF)
+    RESET_FAKE(SDL_RenderFillRects)
+    RESET_FAKE(SDL_RenderFillRectsF)
     RESET_FAKE(SDL_RenderCopy)
     RESET_FAKE(SDL_RenderCopyF)
     RESET_FAKE(SDL_RenderCopyEx)
@@ -130,6 +166,8 @@ class RendererTest : public testing::Test {
 #if SDL_VERSION_ATLEAST(2, 0, 18)
 
     RESET_FAKE(SDL_RenderSetVSync)
+    RESET_FAKE(SDL_RenderGeometry)
+    RESET_FAKE(SDL_RenderGeometryRaw)
 
 #endif  // SDL_VERSION_ATLEAST(2, 0, 18)
   }
@@ -344,6 +382,84 @@ TEST_F(RendererTest, DrawLines)
   }
 }
 
+TEST_F(RendererTest, DrawRects)
+{
+  {
+    const std::vector<cen::irect> rects;
+    ASSERT_EQ(cen::failure, mRenderer.draw_rects(rects));
+    ASSERT_EQ(0u, SDL_RenderDrawRects_fake.call_count);
+  }
+
+  {
+    const std::vector<cen::irect> rects {{1, 2, 3, 4}, {5, 6, 7, 8}};
+    ASSERT_EQ(cen::success, mRenderer.draw_rects(rects));
+    ASSERT_EQ(1u, SDL_RenderDrawRects_fake.call_count);
+    ASSERT_EQ(rects.front().data(), SDL_RenderDrawRects_fake.arg1_val);
+    ASSERT_EQ(2, SDL_RenderDrawRects_fake.arg2_val);
+  }
+
+  {
+    const std::array<cen::frect, 3> rects {};
+    ASSERT_EQ(cen::success, mRenderer.draw_rects(rects));
+    ASSERT_EQ(1u, SDL_RenderDrawRectsF_fake.call_count);
+    ASSERT_EQ(rects.front().data(), SDL_RenderDrawRectsF_fake.arg1_val);
+    ASSERT_EQ(3, SDL_RenderDrawRectsF_fake.arg2_val);
+  }
+}
+
+TEST_F(RendererTest, FillRects)
+{
+  const std::vector<cen::irect> irects {{1, 2, 3, 4}, {5, 6, 7, 8}};
+  ASSERT_EQ(cen::success, mRenderer.fill_rects(irects));
+  ASSERT_EQ(1u, SDL_RenderFillRects_fake.call_count);
+  ASSERT_EQ(irects.front().data(), SDL_RenderFillRects_fake.arg1_val);
+  ASSERT_EQ(2, SDL_RenderFillRects_fake.arg2_val);
+
+  const std::vector<cen::frect> frects {{1, 2, 3, 4}};
+  ASSERT_EQ(cen::success, mRenderer.fill_rects(frects));
+  ASSERT_EQ(1u, SDL_RenderFillRectsF_fake.call_count);
+  ASSERT_EQ(1, SDL_RenderFillRectsF_fake.arg2_val);
+}
+
+TEST_F(RendererTest, DrawPoints)
+{
+  const std::vector<cen::ipoint> ipoints {{1, 2}, {3, 4}, {5, 6}};
+  ASSERT_EQ(cen::success, mRenderer.draw_points(ipoints));
+  ASSERT_EQ(1u, SDL_RenderDrawPoints_fake.call_count);
+  ASSERT_EQ(ipoints.front().data(), SDL_RenderDrawPoints_fake.arg1_val);
+  ASSERT_EQ(3, SDL_RenderDrawPoints_fake.arg2_val);
+
+  const std::vector<cen::fpoint> fpoints {{1, 2}};
+  ASSERT_EQ(cen::success, mRenderer.draw_points(fpoints));
+  ASSERT_EQ(1u, SDL_RenderDrawPointsF_fake.call_count);
+  ASSERT_EQ(1, SDL_RenderDrawPointsF_fake.arg2_val);
+
+  ASSERT_EQ(cen::failure, mRenderer.draw_points(std::vector<cen::fpoint> {}));
+}
+
+TEST_F(RendererTest, DrawCircle)
+{
+  mRenderer.draw_circle(cen::ipoint {100, 100}, 200);
+  ASSERT_EQ(1u, SDL_RenderDrawPointsF_fake.call_count);
+  ASSERT_EQ(0u, SDL_RenderDrawPoint_fake.call_count);
+  ASSERT_GT(SDL_RenderDrawPointsF_fake.arg2_val, 1000);
+
+  mRenderer.draw_circle(cen::fpoint {100, 100}, 20);
+  ASSERT_EQ(2u, SDL_RenderDrawPointsF_fake.call_count);
+  ASSERT_EQ(0u, SDL_RenderDrawPointF_fake.call_count);
+}
+
+TEST_F(RendererTest, FillCircle)
+{
+  mRenderer.fill_circle(cen::fpoint {100, 100}, 50);
+  ASSERT_EQ(1u, SDL_RenderFillRectsF_fake.call_count);
+  ASSERT_EQ(100, SDL_RenderFillRectsF_fake.arg2_val);
+  ASSERT_EQ(0u, SDL_RenderDrawLineF_fake.call_count);
+
+  ASSERT_EQ(cen::failure, mRenderer.fill_circle(cen::fpoint {100, 100}, 0));
+  ASSERT_EQ(1u, SDL_RenderFillRectsF_fake.call_count);
+}
+
 TEST_F(RendererTest, RenderWithPoint)
 {
   {
@@ -485,6 +601,130 @@ TEST_F(RendererTest, SetColor)
   ASSERT_EQ(2u, SDL_SetRenderDrawColor_fake.call_count);
 }
 
+TEST_F(RendererTest, StateCaching)
+{
+  ASSERT_FALSE(mRenderer.is_caching_state());
+
+  mRenderer.set_state_caching(true);
+  ASSERT_TRUE(mRenderer.is_caching_state());
+
+  ASSERT_EQ(cen::success, mRenderer.set_color(cen::colors::cyan));
+  ASSERT_EQ(cen::success, mRenderer.set_color(cen::colors::cyan));
+  ASSERT_EQ(1u, SDL_SetRenderDrawColor_fake.call_count);
+
+  ASSERT_EQ(cen::colors::cyan, mRenderer.get_color());
+  ASSERT_EQ(0u, SDL_GetRenderDrawColor_fake.call_count);
+
+  ASSERT_EQ(cen::success, mRenderer.set_blend_mode(cen::blend_mode::add));
+  ASSERT_EQ(cen::success, mRenderer.set_blend_mode(cen::blend_mode::add));
+  ASSERT_EQ(1u, SDL_SetRenderDrawBlendMode_fake.call_count);
+
+  const cen::irect area {10, 20, 30, 40};
+
+  ASSERT_EQ(cen::success, mRenderer.set_viewport(area));
+  ASSERT_EQ(cen::success, mRenderer.set_viewport(area));
+  ASSERT_EQ(1u, SDL_RenderSetViewport_fake.call_count);
+
+  ASSERT_EQ(cen::success, mRenderer.set_clip(area));
+  ASSERT_EQ(cen::success, mRenderer.set_clip(area));
+  ASSERT_EQ(cen::success, mRenderer.reset_clip());
+  ASSERT_EQ(cen::success, mRenderer.reset_clip());
+  ASSERT_EQ(2u, SDL_RenderSetClipRect_fake.call_count);
+
+  /* Changing the target resets the viewport */
+  ASSERT_EQ(cen::success, mRenderer.reset_target());
+  ASSERT_EQ(cen::success, mRenderer.reset_target());
+  ASSERT_EQ(1u, SDL_SetRenderTarget_fake.call_count);
+
+  ASSERT_EQ(cen::success, mRenderer.set_viewport(area));
+  ASSERT_EQ(2u, SDL_RenderSetViewport_fake.call_count);
+
+  /* Failed state changes are not cached */
+  SDL_SetRenderDrawColor_fake.return_val = -1;
+  ASSERT_EQ(cen::failure, mRenderer.set_color(cen::colors::red));
+  ASSERT_EQ(cen::failure, mRenderer.set_color(cen::colors::red));
+  ASSERT_EQ(3u, SDL_SetRenderDrawColor_fake.call_count);
+
+  mRenderer.invalidate_state_cache();
+  ASSERT_EQ(cen::success, mRenderer.set_blend_mode(cen::blend_mode::add));
+  ASSERT_EQ(2u, SDL_SetRenderDrawBlendMode_fake.call_count);
+
+  mRenderer.set_state_caching(false);
+  ASSERT_EQ(cen::success, mRenderer.set_blend_mode(cen::blend_mode::add));
+  ASSERT_EQ(3u, SDL_SetRenderDrawBlendMode_fake.call_count);
+}
+
+TEST_F(RendererTest, StateCachingWithCommandList)
+{
+  std::array functions {QueryTexture};
+  SET_CUSTOM_FAKE_SEQ(SDL_QueryTexture, functions.data(), cen::isize(functions));
+
+  mRenderer.set_state_caching(true);
+
+  const cen::irect area {10, 20, 30, 40};
+  ASSERT_EQ(cen::success, mRenderer.reset_target());
+  ASSERT_EQ(cen::success, mRenderer.set_viewport(area));
+  ASSERT_EQ(1u, SDL_SetRenderTarget_fake.call_count);
+  ASSERT_EQ(1u, SDL_RenderSetViewport_fake.call_count);
+
+  auto* raw = reinterpret_cast<SDL_Texture*>(0x1);
+  cen::texture_handle target {raw};
+
+  cen::render_command_list list;
+  list.set_target(target);
+  list.set_viewport(area);
+
+  /* Replayed target changes must reset the cached viewport, just like direct calls */
+  ASSERT_EQ(cen::success, list.execute(mRenderer));
+  ASSERT_EQ(2u, SDL_SetRenderTarget_fake.call_count);
+  ASSERT_EQ(raw, SDL_SetRenderTarget_fake.arg1_val);
+  ASSERT_EQ(2u, SDL_RenderSetViewport_fake.call_count);
+
+  /* The renderer knows that the target was changed, so resetting it isn't skipped */
+  ASSERT_EQ(cen::success, mRenderer.reset_target());
+  ASSERT_EQ(3u, SDL_SetRenderTarget_fake.call_count);
+  ASSERT_EQ(nullptr, SDL_SetRenderTarget_fake.arg1_val);
+}
+
+TEST_F(RendererTest, Counters)
+{
+  ASSERT_TRUE(cen::renderer_handle::has_counters());
+  mRenderer.set_state_caching(true);
+
+  const cen::irect area {10, 20, 30, 40};
+  auto* other = reinterpret_cast<SDL_Texture*>(0x1);
+
+  mRenderer.clear();
+  mRenderer.fill_rect(area);
+  mRenderer.fill_rects(std::vector<cen::irect> {area, area});
+  mRenderer.draw_points(std::vector<cen::ipoint> {});  // Nothing is drawn
+
+  mRenderer.render(mTexture, area);
+  mRenderer.render(mTexture, area);
+  mRenderer.render(cen::texture_handle {other}, area);
+
+  mRenderer.set_color(cen::colors::cyan);
+  mRenderer.set_color(cen::colors::cyan);
+  mRenderer.set_clip(area);
+  mRenderer.reset_target();
+  mRenderer.present();
+
+  const auto counters = mRenderer.counters();
+  ASSERT_EQ(3u, counters.draw_calls);
+  ASSERT_EQ(3u, counters.copies);
+  ASSERT_EQ(0u, counters.geometry_calls);
+  ASSERT_EQ(6u, counters.submissions());
+  ASSERT_EQ(2u, counters.texture_binds);
+  ASSERT_EQ(2u, counters.state_changes);
+  ASSERT_EQ(1u, counters.skipped_state_changes);
+  ASSERT_EQ(1u, counters.target_changes);
+  ASSERT_EQ(1u, counters.presents);
+
+  mRenderer.reset_counters();
+  ASSERT_EQ(0u, mRenderer.counters().submissions());
+  ASSERT_EQ(0u, mRenderer.counters().presents);
+}
+
 TEST_F(RendererTest, SetClip)
 {
   std::array values {-1, 0};
@@ -565,4 +805,120 @@ TEST_F(RendererTest, SetVSync)
   ASSERT_EQ(1, SDL_RenderSetVSync_fake.arg1_val);
 }
 
-#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
\ No newline at end of file
+TEST_F(RendererTest, RenderGeoWithContainers)
+{
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+
+  ASSERT_EQ(cen::failure, mRenderer.render_geo(mTexture, vertices, indices));
+  ASSERT_EQ(0u, SDL_RenderGeometry_fake.call_count);
+
+  vertices.resize(4);
+  indices = {0, 1, 2, 2, 3, 0};
+
+  ASSERT_EQ(cen::success, mRenderer.render_geo(mTexture, vertices, indices));
+  ASSERT_EQ(1u, SDL_RenderGeometry_fake.call_count);
+  ASSERT_EQ(vertices.data(), SDL_RenderGeometry_fake.arg2_val);
+  ASSERT_EQ(4, SDL_RenderGeometry_fake.arg3_val);
+  ASSERT_EQ(indices.data(), SDL_RenderGeometry_fake.arg4_val);
+  ASSERT_EQ(6, SDL_RenderGeometry_fake.arg5_val);
+}
+
+TEST_F(RendererTest, RenderGeoWithCompactIndices)
+{
+  std::vector<SDL_Vertex> vertices(4);
+  const std::vector<cen::uint16> indices {0, 1, 2, 2, 3, 0};
+
+  ASSERT_EQ(cen::success, mRenderer.render_geo(mTexture, vertices, indices));
+  ASSERT_EQ(0u, SDL_RenderGeometry_fake.call_count);
+  ASSERT_EQ(1u, SDL_RenderGeometryRaw_fake.call_count);
+  ASSERT_EQ(&vertices.front().position.x, SDL_RenderGeometryRaw_fake.arg2_val);
+  ASSERT_EQ(static_cast<int>(sizeof(SDL_Vertex)), SDL_RenderGeometryRaw_fake.arg3_val);
+  ASSERT_EQ(&vertices.front().color, SDL_RenderGeometryRaw_fake.arg4_val);
+  ASSERT_EQ(&vertices.front().tex_coord.x, SDL_RenderGeometryRaw_fake.arg6_val);
+  ASSERT_EQ(4, SDL_RenderGeometryRaw_fake.arg8_val);
+  ASSERT_EQ(indices.data(), SDL_RenderGeometryRaw_fake.arg9_val);
+  ASSERT_EQ(6, SDL_RenderGeometryRaw_fake.arg10_val);
+  ASSERT_EQ(2, SDL_RenderGeometryRaw_fake.arg11_val);
+}
+
+TEST_F(RendererTest, RenderGeoWithRuntimeCounts)
+{
+  std::vector<SDL_Vertex> vertices(4);
+  const std::vector<cen::uint32> indices {0, 1, 2, 2, 3, 0};
+
+  ASSERT_EQ(cen::success, mRenderer.render_geo(vertices.data(), vertices.size()));
+  ASSERT_EQ(1u, SDL_RenderGeometry_fake.call_count);
+  ASSERT_EQ(nullptr, SDL_RenderGeometry_fake.arg1_val);
+  ASSERT_EQ(nullptr, SDL_RenderGeometry_fake.arg4_val);
+  ASSERT_EQ(0, SDL_RenderGeometry_fake.arg5_val);
+
+  ASSERT_EQ(cen::success,
+            mRenderer.render_geo(mTexture,
+                                 vertices.data(),
+                                 vertices.size(),
+                                 indices.data(),
+                                 indices.size()));
+  ASSERT_EQ(1u, SDL_RenderGeometryRaw_fake.call_count);
+  ASSERT_EQ(4, SDL_RenderGeometryRaw_fake.arg11_val);
+
+  ASSERT_EQ(cen::failure,
+            mRenderer.render_geo(static_cast<const SDL_Vertex*>(nullptr),
+                                 0,
+                                 indices.data(),
+                                 indices.size()));
+  ASSERT_EQ(1u, SDL_RenderGeometryRaw_fake.call_count);
+}
+
+TEST_F(RendererTest, RenderGeoWithNonConstPointer)
+{
+  std::vector<SDL_Vertex> vertices(3);
+  SDL_Vertex* data = vertices.data();
+
+  // Must select the pointer overload rather than the container overload
+  ASSERT_EQ(cen::success, mRenderer.render_geo(mTexture, data, vertices.size()));
+  ASSERT_EQ(1u, SDL_RenderGeometry_fake.call_count);
+  ASSERT_EQ(data, SDL_RenderGeometry_fake.arg2_val);
+  ASSERT_EQ(3, SDL_RenderGeometry_fake.arg3_val);
+  ASSERT_EQ(nullptr, SDL_RenderGeometry_fake.arg4_val);
+}
+
+TEST_F(RendererTest, RenderGeoRaw)
+{
+  const float xy[] {0, 0, 10, 0, 10, 10};
+  const SDL_Color color {0xFF, 0, 0, 0xFF};
+  const float uv[] {0, 0, 1, 0, 1, 1};
+
+  ASSERT_EQ(cen::success,
+            mRenderer.render_geo_raw(mTexture,
+                                     xy,
+                                     2 * sizeof(float),
+                                     &color,
+                                     0,
+                                     uv,
+                                     2 * sizeof(float),
+                                     3));
+  ASSERT_EQ(1u, SDL_RenderGeometryRaw_fake.call_count);
+  ASSERT_EQ(xy, SDL_RenderGeometryRaw_fake.arg2_val);
+  ASSERT_EQ(8, SDL_RenderGeometryRaw_fake.arg3_val);
+  ASSERT_EQ(&color, SDL_RenderGeometryRaw_fake.arg4_val);
+  ASSERT_EQ(0, SDL_RenderGeometryRaw_fake.arg5_val);
+  ASSERT_EQ(uv, SDL_RenderGeometryRaw_fake.arg6_val);
+  ASSERT_EQ(3, SDL_RenderGeometryRaw_fake.arg8_val);
+  ASSERT_EQ(nullptr, SDL_RenderGeometryRaw_fake.arg9_val);
+
+  const cen::uint8 indices[] {0, 1, 2};
+  ASSERT_EQ(cen::success,
+            mRenderer.render_geo_raw(xy, 2 * sizeof(float), &color, 0, 3, indices, 3));
+  ASSERT_EQ(2u, SDL_RenderGeometryRaw_fake.call_count);
+  ASSERT_EQ(nullptr, SDL_RenderGeometryRaw_fake.arg1_val);
+  ASSERT_EQ(nullptr, SDL_RenderGeometryRaw_fake.arg6_val);
+  ASSERT_EQ(1, SDL_RenderGeometryRaw_fake.arg11_val);
+
+  std::array values {-1};
+  SET_RETURN_SEQ(SDL_RenderGeometryRaw, values.data(), cen::isize(values));
+  ASSERT_EQ(cen::failure,
+            mRenderer.render_geo_raw(xy, 2 * sizeof(float), &color, 0, 3, indices, 3));
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
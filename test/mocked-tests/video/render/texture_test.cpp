@@ -0,0 +1,204 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/texture.hpp"
+
+#include <fff.h>
+#include <gtest/gtest.h>
+
+#include <array>  // array
+
+#include "core_mocks.hpp"
+
+extern "C" {
+FAKE_VALUE_FUNC(int, SDL_QueryTexture, SDL_Texture*, Uint32*, int*, int*, int*)
+FAKE_VALUE_FUNC(int, SDL_LockTexture, SDL_Texture*, const SDL_Rect*, void**, int*)
+FAKE_VOID_FUNC(SDL_UnlockTexture, SDL_Texture*)
+FAKE_VALUE_FUNC(int, SDL_UpdateTexture, SDL_Texture*, const SDL_Rect*, const void*, int)
+FAKE_VALUE_FUNC(int, SDL_SetTextureColorMod, SDL_Texture*, Uint8, Uint8, Uint8)
+FAKE_VALUE_FUNC(int, SDL_SetTextureAlphaMod, SDL_Texture*, Uint8)
+FAKE_VALUE_FUNC(int, SDL_SetTextureBlendMode, SDL_Texture*, SDL_BlendMode)
+FAKE_VALUE_FUNC(int, SDL_GetTextureAlphaMod, SDL_Texture*, Uint8*)
+FAKE_VALUE_FUNC(int,
+                SDL_UpdateYUVTexture,
+                SDL_Texture*,
+                const SDL_Rect*,
+                const Uint8*,
+                int,
+                const Uint8*,
+                int,
+                const Uint8*,
+                int)
+FAKE_VALUE_FUNC(int,
+                SDL_UpdateNVTexture,
+                SDL_Texture*,
+                const SDL_Rect*,
+                const Uint8*,
+                int,
+                const Uint8*,
+                int)
+}
+
+namespace {
+
+inline std::array<Uint32, 16> pixel_buffer {};
+
+inline auto lock_texture(SDL_Texture*, const SDL_Rect*, void** pixels, int* pitch) -> int
+{
+  *pixels = pixel_buffer.data();
+  *pitch = 4 * static_cast<int>(sizeof(Uint32));
+  return 0;
+}
+
+}  // namespace
+
+class TextureTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    mocks::reset_core();
+
+    RESET_FAKE(SDL_QueryTexture)
+    RESET_FAKE(SDL_LockTexture)
+    RESET_FAKE(SDL_UnlockTexture)
+    RESET_FAKE(SDL_UpdateTexture)
+    RESET_FAKE(SDL_SetTextureColorMod)
+    RESET_FAKE(SDL_SetTextureAlphaMod)
+    RESET_FAKE(SDL_SetTextureBlendMode)
+    RESET_FAKE(SDL_GetTextureAlphaMod)
+    RESET_FAKE(SDL_UpdateYUVTexture)
+    RESET_FAKE(SDL_UpdateNVTexture)
+  }
+
+  cen::texture_handle mTexture {nullptr};
+};
+
+TEST_F(TextureTest, Update)
+{
+  const std::array<Uint32, 4> pixels {};
+
+  std::array values {-1, 0};
+  SET_RETURN_SEQ(SDL_UpdateTexture, values.data(), cen::isize(values));
+
+  ASSERT_EQ(cen::failure, mTexture.update(pixels.data(), 16));
+  ASSERT_EQ(cen::success, mTexture.update(cen::irect {1, 2, 2, 2}, pixels.data(), 8));
+  ASSERT_EQ(2u, SDL_UpdateTexture_fake.call_count);
+  ASSERT_EQ(8, SDL_UpdateTexture_fake.arg3_val);
+}
+
+TEST_F(TextureTest, StateCaching)
+{
+  /* Without caching, every call is forwarded */
+  ASSERT_FALSE(mTexture.is_caching_state());
+  mTexture.set_alpha_mod(0x80);
+  mTexture.set_alpha_mod(0x80);
+  ASSERT_EQ(2u, SDL_SetTextureAlphaMod_fake.call_count);
+
+  mTexture.set_state_caching(true);
+  ASSERT_TRUE(mTexture.is_caching_state());
+
+  mTexture.set_alpha_mod(0x80);
+  mTexture.set_alpha_mod(0x80);
+  ASSERT_EQ(3u, SDL_SetTextureAlphaMod_fake.call_count);
+  ASSERT_EQ(0x80, mTexture.alpha_mod());
+  ASSERT_EQ(0u, SDL_GetTextureAlphaMod_fake.call_count);
+
+  /* The alpha of color modulations is ignored */
+  mTexture.set_color_mod(cen::colors::red);
+  mTexture.set_color_mod(cen::colors::red.with_alpha(0x10));
+  mTexture.set_color_mod(cen::colors::blue);
+  ASSERT_EQ(2u, SDL_SetTextureColorMod_fake.call_count);
+
+  mTexture.set_blend_mode(cen::blend_mode::add);
+  mTexture.set_blend_mode(cen::blend_mode::add);
+  ASSERT_EQ(1u, SDL_SetTextureBlendMode_fake.call_count);
+
+  /* Failed calls are not cached */
+  SDL_SetTextureAlphaMod_fake.return_val = -1;
+  mTexture.set_alpha_mod(0x40);
+  mTexture.set_alpha_mod(0x40);
+  ASSERT_EQ(5u, SDL_SetTextureAlphaMod_fake.call_count);
+
+  SDL_SetTextureAlphaMod_fake.return_val = 0;
+  mTexture.invalidate_state_cache();
+  mTexture.set_alpha_mod(0x80);
+  ASSERT_EQ(6u, SDL_SetTextureAlphaMod_fake.call_count);
+}
+
+TEST_F(TextureTest, UpdateYUV)
+{
+  const std::array<Uint8, 4> plane {};
+
+  std::array values {-1, 0};
+  SET_RETURN_SEQ(SDL_UpdateYUVTexture, values.data(), cen::isize(values));
+
+  const cen::irect region {0, 0, 2, 2};
+  ASSERT_EQ(cen::failure,
+            mTexture.update_yuv(region, plane.data(), 2, plane.data(), 1, plane.data(), 1));
+  ASSERT_EQ(cen::success,
+            mTexture.update_yuv(region, plane.data(), 2, plane.data(), 1, plane.data(), 1));
+  ASSERT_EQ(2u, SDL_UpdateYUVTexture_fake.call_count);
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 16)
+
+TEST_F(TextureTest, UpdateNV)
+{
+  const std::array<Uint8, 4> plane {};
+
+  std::array values {-1, 0};
+  SET_RETURN_SEQ(SDL_UpdateNVTexture, values.data(), cen::isize(values));
+
+  const cen::irect region {0, 0, 2, 2};
+  ASSERT_EQ(cen::failure, mTexture.update_nv(region, plane.data(), 2, plane.data(), 2));
+  ASSERT_EQ(cen::success, mTexture.update_nv(region, plane.data(), 2, plane.data(), 2));
+  ASSERT_EQ(2u, SDL_UpdateNVTexture_fake.call_count);
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 16)
+
+TEST_F(TextureTest, Lock)
+{
+  SDL_LockTexture_fake.return_val = -1;
+  ASSERT_THROW(cen::texture_lock {mTexture}, cen::sdl_error);
+  ASSERT_EQ(0u, SDL_UnlockTexture_fake.call_count);
+
+  SDL_LockTexture_fake.return_val = 0;
+  SDL_LockTexture_fake.custom_fake = lock_texture;
+
+  {
+    cen::texture_lock lock {mTexture, cen::irect {0, 0, 4, 4}};
+    ASSERT_EQ(16, lock.pitch());
+    ASSERT_EQ(4, lock.size().height);
+    ASSERT_EQ(64u, lock.byte_count());
+    ASSERT_EQ(pixel_buffer.data(), lock.pixels());
+    ASSERT_EQ(pixel_buffer.data() + 8, lock.row_as<Uint32>(2));
+
+    lock.row_as<Uint32>(1)[3] = 0xFF00FF00u;
+    ASSERT_EQ(0u, SDL_UnlockTexture_fake.call_count);
+  }
+
+  ASSERT_EQ(0xFF00FF00u, pixel_buffer.at(7));
+  ASSERT_EQ(1u, SDL_UnlockTexture_fake.call_count);
+}
@@ -0,0 +1,454 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/vk_swapchain.hpp"
+
+#include <fff.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>  // uintptr_t
+#include <cstring>  // memcpy
+#include <deque>    // deque
+#include <vector>   // vector
+
+#include "core_mocks.hpp"
+
+namespace {
+
+/* Emulates the subset of Vulkan used by swapchains, handles are unique non-zero values */
+struct fake_device final {
+  std::uintptr_t nextHandle {};
+  VkExtent2D extent {800, 600};
+  std::vector<VkPresentModeKHR> presentModes {VK_PRESENT_MODE_FIFO_KHR};
+  uint32_t imageCount {3};
+
+  std::deque<VkResult> acquireResults;  ///< Returned by acquire, then VK_SUCCESS.
+  VkResult presentResult {VK_SUCCESS};
+  uint32_t nextImage {};
+
+  VkSwapchainCreateInfoKHR lastSwapchainInfo {};
+  int swapchains {};  ///< The amount of live swapchains.
+  int views {};
+  int semaphores {};
+  int fences {};
+
+  std::vector<VkFence> waitedFences;
+  std::vector<VkFence> resetFences;
+  std::vector<VkSemaphore> acquireSemaphores;
+};
+
+fake_device device;
+
+template <typename Handle>
+[[nodiscard]] auto make_handle() -> Handle
+{
+  Handle handle {};
+  const auto value = ++device.nextHandle;
+  std::memcpy(&handle, &value, sizeof value);
+  return handle;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_get_surface_capabilities(VkPhysicalDevice,
+                                                             VkSurfaceKHR,
+                                                             VkSurfaceCapabilitiesKHR* caps)
+{
+  *caps = VkSurfaceCapabilitiesKHR {};
+  caps->minImageCount = 2;
+  caps->maxImageCount = 8;
+  caps->currentExtent = device.extent;
+  caps->minImageExtent = VkExtent2D {1, 1};
+  caps->maxImageExtent = VkExtent2D {4096, 4096};
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_get_surface_formats(VkPhysicalDevice,
+                                                        VkSurfaceKHR,
+                                                        uint32_t* count,
+                                                        VkSurfaceFormatKHR* formats)
+{
+  if (formats) {
+    formats[0].format = VK_FORMAT_B8G8R8A8_SRGB;
+    formats[0].colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+  }
+
+  *count = 1;
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_get_surface_present_modes(VkPhysicalDevice,
+                                                              VkSurfaceKHR,
+                                                              uint32_t* count,
+                                                              VkPresentModeKHR* modes)
+{
+  if (modes) {
+    for (uint32_t index = 0; index < *count; ++index) {
+      modes[index] = device.presentModes.at(index);
+    }
+  }
+
+  *count = static_cast<uint32_t>(device.presentModes.size());
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_create_swapchain(VkDevice,
+                                                     const VkSwapchainCreateInfoKHR* info,
+                                                     const VkAllocationCallbacks*,
+                                                     VkSwapchainKHR* swapchain)
+{
+  device.lastSwapchainInfo = *info;
+  ++device.swapchains;
+  *swapchain = make_handle<VkSwapchainKHR>();
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL fake_destroy_swapchain(VkDevice,
+                                                  VkSwapchainKHR,
+                                                  const VkAllocationCallbacks*)
+{
+  --device.swapchains;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_get_swapchain_images(VkDevice,
+                                                         VkSwapchainKHR,
+                                                         uint32_t* count,
+                                                         VkImage* images)
+{
+  if (images) {
+    for (uint32_t index = 0; index < *count; ++index) {
+      images[index] = make_handle<VkImage>();
+    }
+  }
+
+  *count = device.imageCount;
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_acquire_next_image(VkDevice,
+                                                       VkSwapchainKHR,
+                                                       uint64_t,
+                                                       VkSemaphore semaphore,
+                                                       VkFence,
+                                                       uint32_t* index)
+{
+  if (!device.acquireResults.empty()) {
+    const auto result = device.acquireResults.front();
+    device.acquireResults.pop_front();
+
+    if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
+      return result;
+    }
+  }
+
+  device.acquireSemaphores.push_back(semaphore);
+
+  *index = device.nextImage;
+  device.nextImage = (device.nextImage + 1u) % device.imageCount;
+
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_queue_present(VkQueue, const VkPresentInfoKHR*)
+{
+  return device.presentResult;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_create_image_view(VkDevice,
+                                                      const VkImageViewCreateInfo*,
+                                                      const VkAllocationCallbacks*,
+                                                      VkImageView* view)
+{
+  ++device.views;
+  *view = make_handle<VkImageView>();
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL fake_destroy_image_view(VkDevice,
+                                                   VkImageView,
+                                                   const VkAllocationCallbacks*)
+{
+  --device.views;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_create_semaphore(VkDevice,
+                                                     const VkSemaphoreCreateInfo*,
+                                                     const VkAllocationCallbacks*,
+                                                     VkSemaphore* semaphore)
+{
+  ++device.semaphores;
+  *semaphore = make_handle<VkSemaphore>();
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL fake_destroy_semaphore(VkDevice,
+                                                  VkSemaphore,
+                                                  const VkAllocationCallbacks*)
+{
+  --device.semaphores;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_create_fence(VkDevice,
+                                                 const VkFenceCreateInfo* info,
+                                                 const VkAllocationCallbacks*,
+                                                 VkFence* fence)
+{
+  /* Frames in flight must not wait for fences that will never be signaled */
+  EXPECT_NE(0u, info->flags & VK_FENCE_CREATE_SIGNALED_BIT);
+
+  ++device.fences;
+  *fence = make_handle<VkFence>();
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR void VKAPI_CALL fake_destroy_fence(VkDevice, VkFence, const VkAllocationCallbacks*)
+{
+  --device.fences;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL
+fake_wait_for_fences(VkDevice, const uint32_t count, const VkFence* fences, VkBool32, uint64_t)
+{
+  device.waitedFences.insert(device.waitedFences.end(), fences, fences + count);
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_reset_fences(VkDevice,
+                                                 const uint32_t count,
+                                                 const VkFence* fences)
+{
+  device.resetFences.insert(device.resetFences.end(), fences, fences + count);
+  return VK_SUCCESS;
+}
+
+VKAPI_ATTR VkResult VKAPI_CALL fake_device_wait_idle(VkDevice)
+{
+  return VK_SUCCESS;
+}
+
+[[nodiscard]] auto make_functions() -> cen::vk_swapchain_functions
+{
+  cen::vk_swapchain_functions functions;
+  functions.get_surface_capabilities = &fake_get_surface_capabilities;
+  functions.get_surface_formats = &fake_get_surface_formats;
+  functions.get_surface_present_modes = &fake_get_surface_present_modes;
+  functions.create_swapchain = &fake_create_swapchain;
+  functions.destroy_swapchain = &fake_destroy_swapchain;
+  functions.get_swapchain_images = &fake_get_swapchain_images;
+  functions.acquire_next_image = &fake_acquire_next_image;
+  functions.queue_present = &fake_queue_present;
+  functions.create_image_view = &fake_create_image_view;
+  functions.destroy_image_view = &fake_destroy_image_view;
+  functions.create_semaphore = &fake_create_semaphore;
+  functions.destroy_semaphore = &fake_destroy_semaphore;
+  functions.create_fence = &fake_create_fence;
+  functions.destroy_fence = &fake_destroy_fence;
+  functions.wait_for_fences = &fake_wait_for_fences;
+  functions.reset_fences = &fake_reset_fences;
+  functions.device_wait_idle = &fake_device_wait_idle;
+  return functions;
+}
+
+}  // namespace
+
+class VulkanSwapchainTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    mocks::reset_core();
+    device = fake_device {};
+
+    SDL_GetWindowFlags_fake.return_val = cen::window::vulkan;
+  }
+
+  void TearDown() override
+  {
+    /* Every test destroys its swapchain, which must release all Vulkan objects */
+    ASSERT_EQ(0, device.swapchains);
+    ASSERT_EQ(0, device.views);
+    ASSERT_EQ(0, device.semaphores);
+    ASSERT_EQ(0, device.fences);
+  }
+
+  cen::window_handle mWindow {nullptr};
+};
+
+TEST_F(VulkanSwapchainTest, Construction)
+{
+  const cen::vk_swapchain swapchain {make_functions(), mWindow, {}, {}, {}, {}};
+
+  ASSERT_TRUE(swapchain.get());
+  ASSERT_EQ(1u, swapchain.generation());
+  ASSERT_EQ(VK_FORMAT_B8G8R8A8_SRGB, swapchain.format());
+  ASSERT_EQ(800u, swapchain.extent().width);
+  ASSERT_EQ(600u, swapchain.extent().height);
+  ASSERT_EQ(3u, swapchain.images().size());
+  ASSERT_EQ(3u, swapchain.views().size());
+  ASSERT_EQ(2u, swapchain.frames_in_flight());
+
+  /* One image available semaphore per frame in flight, one render finished per image */
+  ASSERT_EQ(3, device.views);
+  ASSERT_EQ(5, device.semaphores);
+  ASSERT_EQ(2, device.fences);
+}
+
+TEST_F(VulkanSwapchainTest, PresentModeSelection)
+{
+  device.presentModes = {VK_PRESENT_MODE_FIFO_KHR, VK_PRESENT_MODE_MAILBOX_KHR};
+
+  cen::vk_swapchain_config config;
+  config.present_mode = cen::vk_present_mode::mailbox;
+
+  cen::vk_swapchain swapchain {make_functions(), mWindow, {}, {}, {}, {}, config};
+  ASSERT_EQ(cen::vk_present_mode::mailbox, swapchain.present_mode());
+  ASSERT_EQ(VK_PRESENT_MODE_MAILBOX_KHR, device.lastSwapchainInfo.presentMode);
+
+  /* Unsupported modes fall back to FIFO when the next frame is acquired */
+  swapchain.set_present_mode(cen::vk_present_mode::immediate);
+  ASSERT_EQ(1u, swapchain.generation());
+
+  ASSERT_TRUE(swapchain.acquire());
+  ASSERT_EQ(2u, swapchain.generation());
+  ASSERT_EQ(cen::vk_present_mode::fifo, swapchain.present_mode());
+  ASSERT_EQ(VK_PRESENT_MODE_FIFO_KHR, device.lastSwapchainInfo.presentMode);
+
+  /* Requesting the current mode again doesn't recreate the swapchain */
+  swapchain.set_present_mode(cen::vk_present_mode::immediate);
+  ASSERT_TRUE(swapchain.acquire());
+  ASSERT_EQ(2u, swapchain.generation());
+}
+
+TEST_F(VulkanSwapchainTest, RecreateWhenOutOfDate)
+{
+  cen::vk_swapchain swapchain {make_functions(), mWindow, {}, {}, {}, {}};
+  const auto original = swapchain.get();
+
+  device.acquireResults.push_back(VK_ERROR_OUT_OF_DATE_KHR);
+  ASSERT_FALSE(swapchain.acquire());
+  ASSERT_EQ(1u, swapchain.generation());
+
+  /* The old swapchain is handed to the driver and released after the new one is created */
+  const auto frame = swapchain.acquire();
+  ASSERT_TRUE(frame);
+  ASSERT_EQ(2u, swapchain.generation());
+  ASSERT_EQ(original, device.lastSwapchainInfo.oldSwapchain);
+  ASSERT_NE(original, swapchain.get());
+  ASSERT_EQ(1, device.swapchains);
+  ASSERT_EQ(3, device.views);
+
+  /* Suboptimal presentation still succeeds, but recreates the swapchain */
+  device.presentResult = VK_SUBOPTIMAL_KHR;
+  ASSERT_EQ(cen::success, swapchain.present(*frame));
+
+  device.presentResult = VK_SUCCESS;
+  ASSERT_TRUE(swapchain.acquire());
+  ASSERT_EQ(3u, swapchain.generation());
+
+  device.presentResult = VK_ERROR_OUT_OF_DATE_KHR;
+  ASSERT_EQ(cen::failure, swapchain.present(*frame));
+  ASSERT_TRUE(swapchain.acquire());
+  ASSERT_EQ(4u, swapchain.generation());
+}
+
+TEST_F(VulkanSwapchainTest, RecreateWhenResized)
+{
+  cen::vk_swapchain swapchain {make_functions(), mWindow, {}, {}, {}, {}};
+
+  cen::window_event moved;
+  moved.set_event_id(cen::window_event_id::moved);
+  swapchain.handle(moved);
+
+  ASSERT_TRUE(swapchain.acquire());
+  ASSERT_EQ(1u, swapchain.generation());
+
+  cen::window_event resized;
+  resized.set_event_id(cen::window_event_id::resized);
+  swapchain.handle(resized);
+
+  device.extent = VkExtent2D {1024, 768};
+  ASSERT_TRUE(swapchain.acquire());
+  ASSERT_EQ(2u, swapchain.generation());
+  ASSERT_EQ(1024u, swapchain.extent().width);
+  ASSERT_EQ(768u, swapchain.extent().height);
+
+  /* No images are acquired while the window has no drawable area */
+  cen::window_event minimized;
+  minimized.set_event_id(cen::window_event_id::minimized);
+  swapchain.handle(minimized);
+
+  device.extent = VkExtent2D {0, 0};
+  ASSERT_FALSE(swapchain.acquire());
+  ASSERT_FALSE(swapchain.acquire());
+  ASSERT_EQ(2u, swapchain.generation());
+
+  device.extent = VkExtent2D {1024, 768};
+  ASSERT_TRUE(swapchain.acquire());
+  ASSERT_EQ(3u, swapchain.generation());
+}
+
+TEST_F(VulkanSwapchainTest, FrameSynchronization)
+{
+  cen::vk_swapchain swapchain {make_functions(), mWindow, {}, {}, {}, {}};
+
+  std::vector<cen::vk_frame> frames;
+  for (int i = 0; i < 4; ++i) {
+    const auto frame = swapchain.acquire();
+    ASSERT_TRUE(frame);
+    ASSERT_EQ(cen::success, swapchain.present(*frame));
+    frames.push_back(*frame);
+  }
+
+  /* The frame-in-flight slots alternate, and each slot reuses its fence and semaphore */
+  ASSERT_EQ(0u, frames[0].frame_index);
+  ASSERT_EQ(1u, frames[1].frame_index);
+  ASSERT_EQ(0u, frames[2].frame_index);
+  ASSERT_EQ(1u, frames[3].frame_index);
+
+  ASSERT_NE(frames[0].in_flight, frames[1].in_flight);
+  ASSERT_EQ(frames[0].in_flight, frames[2].in_flight);
+  ASSERT_EQ(frames[1].in_flight, frames[3].in_flight);
+
+  ASSERT_NE(frames[0].image_available, frames[1].image_available);
+  ASSERT_EQ(frames[0].image_available, frames[2].image_available);
+  ASSERT_EQ(frames[0].image_available, device.acquireSemaphores.at(0));
+  ASSERT_EQ(frames[1].image_available, device.acquireSemaphores.at(1));
+
+  /* Render finished semaphores belong to the images, of which there are three */
+  ASSERT_EQ(0u, frames[0].image_index);
+  ASSERT_EQ(1u, frames[1].image_index);
+  ASSERT_EQ(2u, frames[2].image_index);
+  ASSERT_EQ(0u, frames[3].image_index);
+  ASSERT_EQ(frames[0].render_finished, frames[3].render_finished);
+  ASSERT_NE(frames[0].render_finished, frames[2].render_finished);
+  ASSERT_EQ(swapchain.views().at(2), frames[2].view);
+
+  /* Every acquire waits for the fence of its slot before resetting it */
+  ASSERT_EQ(4u, device.resetFences.size());
+  for (cen::usize index = 0; index < frames.size(); ++index) {
+    ASSERT_EQ(frames[index].in_flight, device.resetFences[index]);
+  }
+
+  /* The fourth frame reuses the first image, so it also waits for the fence of that image */
+  ASSERT_EQ(5u, device.waitedFences.size());
+  ASSERT_EQ(frames[3].in_flight, device.waitedFences[3]);
+  ASSERT_EQ(frames[0].in_flight, device.waitedFences[4]);
+}
@@ -27,7 +27,8 @@
 #include <fff.h>
 #include <gtest/gtest.h>
 
-#include <array>  // array
+#include <array>   // array
+#include <vector>  // vector
 
 #include "core_mocks.hpp"
 
@@ -59,6 +60,7 @@ FAKE_VALUE_FUNC(SDL_Surface*, SDL_GetWindowSurface, SDL_Window*)
 FAKE_VALUE_FUNC(const char*, SDL_GetWindowTitle, SDL_Window*)
 FAKE_VALUE_FUNC(int, SDL_CaptureMouse, SDL_bool)
 FAKE_VALUE_FUNC(int, SDL_UpdateWindowSurface, SDL_Window*)
+FAKE_VALUE_FUNC(int, SDL_UpdateWindowSurfaceRects, SDL_Window*, const SDL_Rect*, int)
 FAKE_VALUE_FUNC(int, SDL_GetWindowDisplayIndex, SDL_Window*)
 FAKE_VALUE_FUNC(int, SDL_SetWindowFullscreen, SDL_Window*, Uint32)
 FAKE_VALUE_FUNC(int, SDL_SetWindowBrightness, SDL_Window*, float)
@@ -123,6 +125,7 @@ class WindowTest : public testing::Test {
     RESET_FAKE(SDL_GetWindowTitle)
     RESET_FAKE(SDL_CaptureMouse)
     RESET_FAKE(SDL_UpdateWindowSurface)
+    RESET_FAKE(SDL_UpdateWindowSurfaceRects)
     RESET_FAKE(SDL_GetWindowDisplayIndex)
     RESET_FAKE(SDL_SetWindowFullscreen)
     RESET_FAKE(SDL_SetWindowBrightness)
@@ -213,6 +216,25 @@ TEST_F(WindowTest, UpdateSurface)
   ASSERT_EQ(1u, SDL_UpdateWindowSurface_fake.call_count);
 }
 
+TEST_F(WindowTest, UpdateSurfaceRects)
+{
+  std::vector<cen::irect> rects;
+  ASSERT_TRUE(mWindow.update_surface(rects));
+  ASSERT_EQ(0u, SDL_UpdateWindowSurfaceRects_fake.call_count);
+
+  rects.emplace_back(0, 0, 10, 10);
+  rects.emplace_back(20, 20, 5, 5);
+
+  std::array values {-1, 0};
+  SET_RETURN_SEQ(SDL_UpdateWindowSurfaceRects, values.data(), cen::isize(values));
+
+  ASSERT_FALSE(mWindow.update_surface(rects));
+  ASSERT_TRUE(mWindow.update_surface(rects.front()));
+  ASSERT_EQ(2u, SDL_UpdateWindowSurfaceRects_fake.call_count);
+  ASSERT_EQ(1, SDL_UpdateWindowSurfaceRects_fake.arg2_val);
+  ASSERT_EQ(2, SDL_UpdateWindowSurfaceRects_fake.arg2_history[0]);
+}
+
 TEST_F(WindowTest, SetFullscreen)
 {
   std::array values {0, 1};
@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/audio/audio_effects.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>        // array
+#include <cmath>        // fabs
+#include <type_traits>  // ...
+#include <vector>       // vector
+
+using stereo_chain = cen::effect_chain<cen::gain_effect, cen::low_pass_effect>;
+
+static_assert(std::is_final_v<stereo_chain>);
+static_assert(!std::is_copy_constructible_v<stereo_chain>);
+static_assert(!std::is_move_constructible_v<stereo_chain>);
+
+inline constexpr cen::mix_spec spec {48'000, AUDIO_F32SYS, 2};
+
+TEST(AudioEffects, Gain)
+{
+  cen::effect_chain<cen::gain_effect> chain {spec};
+  chain.stage<0>().set_gain(0.5f);
+
+  std::vector<float> samples(256, 1.0f);
+
+  // The gain is ramped over the first buffer after a change
+  chain.process(samples.data(), 128);
+  ASSERT_GT(samples.front(), 0.5f);
+  ASSERT_FLOAT_EQ(0.5f, samples.back());
+
+  samples.assign(256, 1.0f);
+  chain.process(samples.data(), 128);
+  for (const auto sample : samples) {
+    ASSERT_FLOAT_EQ(0.5f, sample);
+  }
+
+  chain.stage<cen::gain_effect>().set_gain_db(-20.0f);
+  ASSERT_NEAR(0.1f, chain.stage<cen::gain_effect>().gain(), 1e-6f);
+}
+
+TEST(AudioEffects, LowPass)
+{
+  cen::effect_chain<cen::low_pass_effect> chain {spec};
+  chain.stage<0>().set_cutoff(500.0f);
+
+  // A constant signal passes through
+  std::vector<float> constant(4'096, 0.8f);
+  chain.process(constant.data(), constant.size() / 2);
+  ASSERT_NEAR(0.8f, constant.back(), 1e-4f);
+
+  // A signal at the Nyquist frequency is strongly attenuated
+  std::vector<float> alternating(4'096);
+  for (std::size_t index = 0; index < alternating.size(); ++index) {
+    alternating[index] = ((index / 2) % 2 == 0) ? 1.0f : -1.0f;
+  }
+
+  chain.process(alternating.data(), alternating.size() / 2);
+  ASSERT_LT(std::fabs(alternating.back()), 0.1f);
+}
+
+TEST(AudioEffects, Compressor)
+{
+  cen::effect_chain<cen::compressor_effect> chain {spec};
+
+  auto& compressor = chain.stage<0>();
+  compressor.set_threshold(-12.0f);
+  compressor.set_ratio(4.0f);
+  compressor.set_attack(cen::millis<float> {1.0f});
+
+  std::vector<float> loud(9'600, 1.0f);
+  chain.process(loud.data(), loud.size() / 2);
+
+  // 0 dB input, 12 dB above the threshold, is reduced to 3 dB above it
+  const auto expected = std::pow(10.0f, -9.0f / 20.0f);
+  ASSERT_NEAR(expected, loud.back(), 0.01f);
+
+  // The gain is restored once the envelope has been released
+  std::vector<float> quiet(48'000, 0.1f);
+  chain.process(quiet.data(), quiet.size() / 2);
+  ASSERT_FLOAT_EQ(0.1f, quiet.back());
+}
+
+TEST(AudioEffects, Reverb)
+{
+  cen::effect_chain<cen::reverb_effect> chain {spec};
+
+  std::vector<float> samples(48'000, 0.0f);
+  samples[0] = 1.0f;
+  samples[1] = 1.0f;
+
+  chain.process(samples.data(), samples.size() / 2);
+
+  // The impulse is unchanged, followed by a decaying tail on both channels
+  ASSERT_FLOAT_EQ(1.0f, samples[0]);
+
+  float tail = 0;
+  for (std::size_t index = 2'000; index < samples.size(); index += 2) {
+    ASSERT_FLOAT_EQ(samples[index], samples[index + 1]);
+    tail += std::fabs(samples[index]);
+  }
+
+  ASSERT_GT(tail, 0.0f);
+
+  chain.stage<0>().set_room_size(2.0f);
+  ASSERT_FLOAT_EQ(1.0f, chain.stage<0>().room_size());
+}
+
+TEST(AudioEffects, Disabled)
+{
+  stereo_chain chain {spec};
+  chain.stage<cen::gain_effect>().set_gain(0.0f);
+  chain.set_enabled(false);
+  ASSERT_FALSE(chain.is_enabled());
+
+  std::array samples {0.25f, -0.25f, 0.5f, -0.5f};
+  chain.process(samples.data(), 2);
+
+  ASSERT_FLOAT_EQ(0.25f, samples[0]);
+  ASSERT_FLOAT_EQ(-0.5f, samples[3]);
+}
+
+TEST(AudioEffects, SampleConversion)
+{
+  const std::array<cen::int16, 11> input {0, 1, -1, 16'384, -16'384, 32'767, -32'768, 100,
+                                          -100, 12'345, -12'345};
+
+  std::array<float, 11> floats {};
+  cen::detail::s16_to_f32_n(input.data(), floats.data(), input.size());
+  ASSERT_FLOAT_EQ(0.5f, floats[3]);
+  ASSERT_FLOAT_EQ(-1.0f, floats[6]);
+
+  std::array<cen::int16, 11> output {};
+  cen::detail::f32_to_s16_n(floats.data(), output.data(), floats.size());
+  ASSERT_EQ(input, output);
+
+  // Out of range samples saturate
+  const std::array overflow {2.0f, -2.0f, 1.0f, -1.0f, 1.5f, -1.5f, 0.0f, 0.0f, 3.0f};
+  std::array<cen::int16, 9> clipped {};
+  cen::detail::f32_to_s16_n(overflow.data(), clipped.data(), overflow.size());
+
+  const std::array<cen::int16, 9> expected {32'767, -32'768, 32'767, -32'768, 32'767,
+                                            -32'768, 0, 0, 32'767};
+  ASSERT_EQ(expected, clipped);
+}
@@ -0,0 +1,98 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/audio/music_player.hpp"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>  // ...
+
+#include "centurion/concurrency/thread_pool.hpp"
+
+static_assert(std::is_final_v<cen::music_player>);
+static_assert(!std::is_copy_constructible_v<cen::music_player>);
+static_assert(!std::is_move_constructible_v<cen::music_player>);
+
+namespace {
+
+inline constexpr auto track = "resources/hidden_pond.mp3";
+
+void wait_until_loaded(cen::music_player& player)
+{
+  player.update();
+  while (player.is_loading() || player.is_pending()) {
+    SDL_Delay(1);
+    player.update();
+  }
+}
+
+}  // namespace
+
+TEST(MusicPlayer, Defaults)
+{
+  cen::thread_pool pool {1};
+  const cen::music_player player {pool};
+
+  ASSERT_EQ(cen::music_player_mode::stream, player.mode());
+  ASSERT_EQ(0u, player.track_count());
+  ASSERT_FALSE(player.current_track());
+  ASSERT_FALSE(player.is_loading());
+  ASSERT_FALSE(player.is_pending());
+  ASSERT_TRUE(player.is_looping());
+}
+
+TEST(MusicPlayer, Play)
+{
+  cen::thread_pool pool {1};
+  cen::music_player player {pool};
+
+  player.add(track);
+  player.add(track);
+  ASSERT_EQ(2u, player.track_count());
+
+  player.play(1);
+  ASSERT_TRUE(player.is_pending());
+
+  wait_until_loaded(player);
+  ASSERT_EQ(1u, player.current_track().value());
+  ASSERT_TRUE(cen::music::is_playing());
+
+  player.stop(cen::music_player::ms_type::zero());
+  ASSERT_FALSE(player.current_track());
+}
+
+TEST(MusicPlayer, SkipsBrokenTracks)
+{
+  cen::thread_pool pool {1};
+  cen::music_player player {pool};
+
+  player.add("foobar.mp3");
+  player.add(track);
+
+  player.play(0);
+  wait_until_loaded(player);
+
+  ASSERT_EQ(1u, player.failed_count());
+  ASSERT_EQ(1u, player.current_track().value());
+}
@@ -62,6 +62,38 @@ TEST_F(MusicTest, Constructor)
   ASSERT_THROW(cen::music {"foobar"s}, cen::mix_error);
 }
 
+TEST_F(MusicTest, ConstructFromMemory)
+{
+  const cen::mapped_file mapping {"resources/hidden_pond.mp3"};
+  ASSERT_TRUE(mapping);
+
+  const cen::music mapped {mapping};
+  ASSERT_EQ(cen::music_type::mp3, mapped.type());
+  ASSERT_FALSE(mapped.is_preloaded());
+
+  cen::file source {"resources/hidden_pond.mp3", cen::file_mode::rb};
+  const cen::music owned {std::move(source)};
+  ASSERT_FALSE(source);
+
+  const cen::asset_pack missing {"this_pack_does_not_exist.pak"};
+  ASSERT_THROW(cen::music(missing, "music.mp3"), cen::mix_error);
+}
+
+TEST_F(MusicTest, Preload)
+{
+  ASSERT_THROW(cen::music::preload("foobar.mp3"), cen::exception);
+
+  auto music = cen::music::preload("resources/hidden_pond.mp3");
+  ASSERT_TRUE(music.is_preloaded());
+  ASSERT_EQ(cen::music_type::mp3, music.type());
+
+  auto moved = std::move(music);
+  ASSERT_TRUE(moved.is_preloaded());
+  ASSERT_TRUE(moved.play());
+
+  cen::music::halt();
+}
+
 TEST_F(MusicTest, Play)
 {
   mMusic->play();
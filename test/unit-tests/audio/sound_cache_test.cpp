@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/audio/sound_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>  // ...
+
+#include "centurion/io/asset_pack.hpp"
+#include "centurion/io/mapped_file.hpp"
+#include "centurion/io/paths.hpp"
+
+static_assert(std::is_final_v<cen::sound_cache>);
+static_assert(!std::is_copy_constructible_v<cen::sound_cache>);
+static_assert(!std::is_copy_assignable_v<cen::sound_cache>);
+
+inline constexpr auto path = "resources/click.wav";
+
+TEST(SoundCache, Load)
+{
+  cen::sound_cache cache;
+  ASSERT_TRUE(cache.empty());
+
+  ASSERT_FALSE(cache.load("foobar.wav"));
+  ASSERT_TRUE(cache.empty());
+
+  const auto sound = cache.load(path);
+  ASSERT_TRUE(sound);
+  ASSERT_EQ(1u, cache.size());
+  ASSERT_LT(0u, cache.memory_usage());
+
+  // The sound is only decoded once
+  const auto again = cache.load(path);
+  ASSERT_EQ(sound.get(), again.get());
+  ASSERT_EQ(1u, cache.size());
+
+  ASSERT_TRUE(cache.contains(path));
+  ASSERT_EQ(sound.get(), cache.get(path).get());
+  ASSERT_FALSE(cache.get("foobar.wav"));
+}
+
+TEST(SoundCache, LoadFromMappedFile)
+{
+  const cen::mapped_file mapping {path};
+  ASSERT_TRUE(mapping);
+
+  cen::sound_cache cache;
+
+  auto view = mapping.view();
+  const auto sound = cache.load("click", view);
+  ASSERT_TRUE(sound);
+  ASSERT_TRUE(cache.contains("click"));
+  ASSERT_FALSE(cache.contains(path));
+}
+
+TEST(SoundCache, Preload)
+{
+  const auto pakPath = cen::preferred_path("centurion", "tests").copy() + "sounds.pak";
+
+  {
+    cen::asset_pack_builder builder;
+    ASSERT_TRUE(builder.add_file("sounds/a.wav", path));
+    ASSERT_TRUE(builder.add_file("sounds/b.wav", path));
+    ASSERT_TRUE(builder.add_file("music/c.wav", path));
+    ASSERT_TRUE(builder.write(pakPath));
+  }
+
+  const cen::asset_pack pack {pakPath};
+  ASSERT_TRUE(pack);
+
+  cen::sound_cache cache;
+  ASSERT_EQ(2u, cache.preload(pack, "sounds/"));
+  ASSERT_TRUE(cache.contains("sounds/a.wav"));
+  ASSERT_TRUE(cache.contains("sounds/b.wav"));
+  ASSERT_FALSE(cache.contains("music/c.wav"));
+
+  ASSERT_TRUE(cache.load(pack, "music/c.wav"));
+  ASSERT_FALSE(cache.load(pack, "music/d.wav"));
+  ASSERT_EQ(3u, cache.size());
+}
+
+TEST(SoundCache, EraseAndClear)
+{
+  cen::sound_cache cache;
+  ASSERT_TRUE(cache.load(path));
+
+  ASSERT_FALSE(cache.erase("foobar.wav"));
+  ASSERT_TRUE(cache.erase(path));
+  ASSERT_TRUE(cache.empty());
+  ASSERT_EQ(0u, cache.memory_usage());
+
+  ASSERT_TRUE(cache.load(path));
+  cache.clear();
+  ASSERT_TRUE(cache.empty());
+  ASSERT_EQ(0u, cache.memory_usage());
+}
@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/audio/spectrum_analyzer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>        // sin
+#include <type_traits>  // ...
+#include <vector>       // vector
+
+static_assert(std::is_final_v<cen::spectrum_analyzer>);
+static_assert(!std::is_copy_constructible_v<cen::spectrum_analyzer>);
+static_assert(!std::is_move_constructible_v<cen::spectrum_analyzer>);
+
+namespace {
+
+inline constexpr int frequency = 48'000;
+inline constexpr cen::usize window_size = 1'024;
+
+/* The frequency of the 64th bin, i.e. 3 kHz */
+inline constexpr float tone = 64.0f * frequency / window_size;
+
+[[nodiscard]] auto make_tone(const cen::usize frames, const float amplitude) -> std::vector<float>
+{
+  std::vector<float> samples(frames * 2);
+  for (cen::usize frame = 0; frame < frames; ++frame) {
+    const auto time = static_cast<float>(frame) / frequency;
+    const auto value = amplitude * std::sin(6.2831853f * tone * time);
+    samples[frame * 2] = value;
+    samples[frame * 2 + 1] = value;
+  }
+
+  return samples;
+}
+
+}  // namespace
+
+TEST(SpectrumAnalyzer, Constructor)
+{
+  const cen::mix_spec spec {frequency, AUDIO_F32SYS, 2};
+  ASSERT_THROW(cen::spectrum_analyzer(spec, 32), cen::exception);
+  ASSERT_THROW(cen::spectrum_analyzer(spec, 1'000), cen::exception);
+  ASSERT_THROW(cen::spectrum_analyzer(spec, 32'768), cen::exception);
+  ASSERT_THROW(cen::spectrum_analyzer(cen::mix_spec {frequency, AUDIO_U8, 2}), cen::exception);
+
+  cen::spectrum_analyzer analyzer {spec, window_size};
+  ASSERT_EQ(window_size, analyzer.window_size());
+  ASSERT_EQ(window_size / 2, analyzer.bin_count());
+  ASSERT_FALSE(analyzer.is_attached());
+  ASSERT_FALSE(analyzer.is_running());
+
+  const auto& spectrum = analyzer.latest();
+  ASSERT_EQ(0u, spectrum.sequence);
+  ASSERT_EQ(window_size / 2, spectrum.magnitudes.size());
+  ASSERT_FLOAT_EQ(46.875f, spectrum.bin_width);
+}
+
+TEST(SpectrumAnalyzer, Analyze)
+{
+  cen::spectrum_analyzer analyzer {{frequency, AUDIO_F32SYS, 2}, window_size};
+  ASSERT_FALSE(analyzer.analyze());
+
+  // Less than half a window doesn't produce a spectrum
+  const auto partial = make_tone(window_size / 4, 0.5f);
+  analyzer.push(partial.data(), partial.size() * sizeof(float));
+  ASSERT_FALSE(analyzer.analyze());
+
+  const auto samples = make_tone(window_size, 0.5f);
+  analyzer.push(samples.data(), samples.size() * sizeof(float));
+  ASSERT_TRUE(analyzer.analyze());
+  ASSERT_FALSE(analyzer.analyze());
+
+  const auto& spectrum = analyzer.latest();
+  ASSERT_EQ(1u, spectrum.sequence);
+  ASSERT_NEAR(0.5f, spectrum.magnitudes[64], 1e-3f);
+  ASSERT_NEAR(0.5f, spectrum.band(2'900.0f, 3'100.0f), 1e-3f);
+  ASSERT_LT(spectrum.band(10'000.0f, 20'000.0f), 1e-3f);
+  ASSERT_FLOAT_EQ(3'000.0f, spectrum.bin_frequency(64));
+
+  ASSERT_NEAR(0.5f * 0.70710678f, spectrum.rms, 1e-3f);
+  ASSERT_NEAR(0.5f, spectrum.peak, 1e-3f);
+}
+
+TEST(SpectrumAnalyzer, SignedSamples)
+{
+  cen::spectrum_analyzer analyzer {{frequency, AUDIO_S16SYS, 2}, window_size};
+
+  const auto samples = make_tone(window_size, 1.0f);
+
+  std::vector<cen::int16> converted(samples.size());
+  for (cen::usize index = 0; index < samples.size(); ++index) {
+    converted[index] = static_cast<cen::int16>(samples[index] * 32'767.0f);
+  }
+
+  analyzer.push(converted.data(), converted.size() * sizeof(cen::int16));
+  ASSERT_TRUE(analyzer.analyze());
+
+  const auto& spectrum = analyzer.latest();
+  ASSERT_NEAR(1.0f, spectrum.magnitudes[64], 1e-3f);
+  ASSERT_NEAR(1.0f, spectrum.peak, 1e-3f);
+}
+
+TEST(SpectrumAnalyzer, DroppedFrames)
+{
+  cen::spectrum_analyzer analyzer {{frequency, AUDIO_F32SYS, 2}, window_size};
+
+  // The ring buffer fills up when nothing is analysed
+  const auto samples = make_tone(window_size * 4, 0.5f);
+  for (int index = 0; index < 8; ++index) {
+    analyzer.push(samples.data(), samples.size() * sizeof(float));
+  }
+
+  ASSERT_GT(analyzer.dropped_frames(), 0u);
+  ASSERT_TRUE(analyzer.analyze());
+}
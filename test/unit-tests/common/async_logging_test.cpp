@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/common/async_logging.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>    // atomic
+#include <iostream>  // cout
+#include <string>    // string
+#include <vector>    // vector
+
+#include "centurion/concurrency/locks.hpp"
+#include "centurion/concurrency/mutex.hpp"
+
+namespace {
+
+struct capture final {
+  cen::mutex mutex;
+  std::vector<std::string> messages;
+  std::atomic<bool> stalled {false};
+  std::atomic<bool> entered {false};
+};
+
+void SDLCALL capture_output(void* data, int, SDL_LogPriority, const char* message)
+{
+  auto* self = static_cast<capture*>(data);
+  self->entered = true;
+
+  while (self->stalled) {
+    cen::thread::sleep(cen::u32ms {1});
+  }
+
+  cen::scoped_lock lock {self->mutex};
+  self->messages.emplace_back(message);
+}
+
+class AsyncLogSinkTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    SDL_LogGetOutputFunction(&mPrevious, &mPreviousData);
+    SDL_LogSetOutputFunction(&capture_output, &mCapture);
+    cen::set_priority(cen::log_priority::verbose);
+  }
+
+  void TearDown() override
+  {
+    SDL_LogSetOutputFunction(mPrevious, mPreviousData);
+    cen::reset_log_priorities();
+  }
+
+  capture mCapture;
+  SDL_LogOutputFunction mPrevious {};
+  void* mPreviousData {};
+};
+
+}  // namespace
+
+TEST_F(AsyncLogSinkTest, Forwarding)
+{
+  {
+    cen::async_log_sink sink;
+    ASSERT_EQ(cen::log_overflow_policy::drop, sink.policy());
+    ASSERT_EQ(1024u, sink.capacity());
+
+    cen::log_info("foo %i", 1);
+    cen::log_warn("bar");
+
+    sink.flush();
+    ASSERT_EQ(2u, sink.written());
+    ASSERT_EQ(0u, sink.dropped());
+    ASSERT_EQ(2u, mCapture.messages.size());
+    ASSERT_EQ("foo 1", mCapture.messages.at(0));
+    ASSERT_EQ("bar", mCapture.messages.at(1));
+  }
+
+  /* The previous output function is restored */
+  cen::log_info("baz");
+  ASSERT_EQ(3u, mCapture.messages.size());
+}
+
+TEST_F(AsyncLogSinkTest, Truncation)
+{
+  cen::async_log_sink sink;
+
+  const std::string message(cen::async_log_message_size * 2u, 'x');
+  cen::log_info("%s", message.c_str());
+
+  sink.flush();
+  ASSERT_EQ(1u, mCapture.messages.size());
+  ASSERT_EQ(cen::async_log_message_size - 1u, mCapture.messages.at(0).size());
+}
+
+TEST_F(AsyncLogSinkTest, DropPolicy)
+{
+  mCapture.stalled = true;
+
+  cen::async_log_sink sink {cen::log_overflow_policy::drop, 2};
+  ASSERT_EQ(2u, sink.capacity());
+
+  /* The first message occupies the background thread, which then stalls */
+  cen::log_info("first");
+  while (!mCapture.entered) {
+    cen::thread::sleep(cen::u32ms {1});
+  }
+
+  cen::log_info("second");
+  cen::log_info("third");
+  cen::log_error("fourth");
+  cen::log_error("fifth");
+
+  ASSERT_EQ(2u, sink.dropped());
+  ASSERT_EQ(0u, sink.dropped(cen::log_priority::info));
+  ASSERT_EQ(2u, sink.dropped(cen::log_priority::error));
+
+  mCapture.stalled = false;
+  sink.flush();
+  ASSERT_EQ(3u, sink.written());
+  ASSERT_EQ(3u, mCapture.messages.size());
+
+  sink.reset_dropped();
+  ASSERT_EQ(0u, sink.dropped());
+}
+
+TEST_F(AsyncLogSinkTest, BlockPolicy)
+{
+  cen::async_log_sink sink {cen::log_overflow_policy::block, 2};
+
+  for (int index = 0; index < 100; ++index) {
+    cen::log_debug("%i", index);
+  }
+
+  sink.flush();
+  ASSERT_EQ(100u, sink.written());
+  ASSERT_EQ(0u, sink.dropped());
+  ASSERT_EQ("99", mCapture.messages.back());
+}
+
+TEST(LogOverflowPolicy, ToString)
+{
+  ASSERT_EQ("drop", cen::to_string(cen::log_overflow_policy::drop));
+  ASSERT_EQ("block", cen::to_string(cen::log_overflow_policy::block));
+
+  std::cout << "log_overflow_policy::block == " << cen::log_overflow_policy::block << '\n';
+}
@@ -0,0 +1,158 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/common/binary_logging.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>  // stringstream, ostringstream
+#include <string>   // string, getline
+#include <vector>   // vector
+
+namespace {
+
+/* Decodes a stream and returns the messages without their timestamps */
+[[nodiscard]] auto decode(const cen::binary_log_writer& writer) -> std::vector<std::string>
+{
+  std::ostringstream output;
+  if (!cen::decode_binary_log(writer.data(), writer.size(), output)) {
+    return {};
+  }
+
+  std::vector<std::string> lines;
+
+  std::istringstream input {output.str()};
+  for (std::string line; std::getline(input, line);) {
+    lines.push_back(line.substr(line.find("] ") + 2u));
+  }
+
+  return lines;
+}
+
+}  // namespace
+
+TEST(BinaryLogging, RegisterFormat)
+{
+  const auto a = cen::register_log_format(cen::log_priority::warn, cen::log_category::audio, "a");
+  const auto b = cen::register_log_format(cen::log_priority::info, cen::log_category::app, "b");
+  ASSERT_NE(a, b);
+
+  const auto format = cen::get_log_format(a);
+  ASSERT_TRUE(format);
+  ASSERT_STREQ("a", format->format);
+  ASSERT_EQ(cen::log_priority::warn, format->priority);
+  ASSERT_EQ(cen::log_category::audio, format->category);
+
+  ASSERT_FALSE(cen::get_log_format(b + 1000u));
+}
+
+TEST(BinaryLogging, RoundTrip)
+{
+  const auto id = cen::register_log_format(cen::log_priority::info,
+                                           cen::log_category::render,
+                                           "%s drew %d sprites in %.2f ms (%u%%, %c, %x)");
+
+  cen::binary_log_writer writer;
+  writer.write(id, "Batch", -42, 1.5, 75u, 'k', 255);
+  writer.write(id, std::string {"Overlay"}, 7, 0.25f, 100u, 'z', 16);
+
+  const auto lines = decode(writer);
+  ASSERT_EQ(2u, lines.size());
+  ASSERT_EQ("render info: Batch drew -42 sprites in 1.50 ms (75%, k, ff)", lines.at(0));
+  ASSERT_EQ("render info: Overlay drew 7 sprites in 0.25 ms (100%, z, 10)", lines.at(1));
+}
+
+TEST(BinaryLogging, Flush)
+{
+  const auto id =
+      cen::register_log_format(cen::log_priority::debug, cen::log_category::app, "%lld");
+
+  cen::binary_log_writer writer;
+  std::stringstream stream;
+
+  writer.write(id, 1LL << 40);
+  ASSERT_TRUE(writer.flush(stream));
+  ASSERT_EQ(0u, writer.size());
+
+  /* The format isn't embedded again in the continued stream */
+  writer.write(id, 2);
+  ASSERT_TRUE(writer.flush(stream));
+
+  std::ostringstream output;
+  const auto bytes = stream.str();
+  ASSERT_TRUE(cen::decode_binary_log(reinterpret_cast<const cen::uint8*>(bytes.data()),
+                                     bytes.size(),
+                                     output));
+
+  const auto text = output.str();
+  ASSERT_NE(std::string::npos, text.find("app debug: 1099511627776\n"));
+  ASSERT_NE(std::string::npos, text.find("app debug: 2\n"));
+}
+
+TEST(BinaryLogging, MissingArguments)
+{
+  const auto id =
+      cen::register_log_format(cen::log_priority::info, cen::log_category::app, "%d and %d");
+
+  cen::binary_log_writer writer;
+  writer.write(id, 1);
+
+  const auto lines = decode(writer);
+  ASSERT_EQ(1u, lines.size());
+  ASSERT_EQ("app info: 1 and <?>", lines.at(0));
+}
+
+TEST(BinaryLogging, MalformedStream)
+{
+  std::ostringstream output;
+
+  const cen::uint8 garbage[] {1, 2, 3, 4, 5, 6, 7, 8};
+  ASSERT_FALSE(cen::decode_binary_log(garbage, sizeof garbage, output));
+
+  const auto id =
+      cen::register_log_format(cen::log_priority::info, cen::log_category::app, "%s");
+
+  cen::binary_log_writer writer;
+  writer.write(id, "truncated");
+  ASSERT_FALSE(cen::decode_binary_log(writer.data(), writer.size() - 1u, output));
+}
+
+TEST(BinaryLogging, Macro)
+{
+  cen::set_priority(cen::log_priority::info);
+
+  cen::binary_log_writer writer;
+  for (int index = 0; index < 3; ++index) {
+    CENTURION_LOG_BINARY(writer, info, input, "Pressed key %i", index);
+    CENTURION_LOG_BINARY(writer, debug, input, "Skipped %i", index);
+  }
+
+  const auto lines = decode(writer);
+  ASSERT_EQ(3u, lines.size());
+  ASSERT_EQ("input info: Pressed key 0", lines.at(0));
+  ASSERT_EQ("input info: Pressed key 2", lines.at(2));
+
+  cen::reset_log_priorities();
+}
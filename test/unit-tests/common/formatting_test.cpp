@@ -0,0 +1,110 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/common/formatting.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>     // array
+#include <cstring>   // strlen
+#include <iterator>  // back_inserter
+#include <sstream>   // stringstream
+#include <string>    // string
+
+#include "centurion/common/math.hpp"
+#include "centurion/video/color.hpp"
+
+TEST(Formatting, FormatToMatchesToString)
+{
+  const cen::ipoint ip {12, -34};
+  const cen::fpoint fp {1.5f, -2.25f};
+  const cen::iarea ia {56, 78};
+  const cen::frect fr {{1.5f, 2.5f}, {3.5f, 4.5f}};
+  const cen::color color {0x12, 0xAB, 0x0F, 0xFE};
+
+  const auto expect_same = [](const auto& value) {
+    std::string text;
+    cen::format_to(std::back_inserter(text), value);
+    ASSERT_EQ(cen::to_string(value), text);
+  };
+
+  expect_same(ip);
+  expect_same(fp);
+  expect_same(ia);
+  expect_same(fr);
+  expect_same(color);
+}
+
+TEST(Formatting, FormatToBuffer)
+{
+  char buffer[64] {};
+
+  const auto length = cen::format_to_buffer(buffer, cen::irect {1, 2, 3, 4});
+  ASSERT_EQ("(x: 1, y: 2, width: 3, height: 4)", std::string {buffer});
+  ASSERT_EQ(std::strlen(buffer), length);
+
+  std::array<char, 16> array {};
+  cen::format_to_buffer(array, cen::color {0xFF, 0x80, 0, 0x7F});
+  ASSERT_EQ("#FF80007F", std::string {array.data()});
+}
+
+TEST(Formatting, FormatToBufferTruncates)
+{
+  std::array<char, 8> buffer {};
+  buffer.fill('?');
+
+  const auto length = cen::format_to_buffer(buffer, cen::ipoint {123, 456});
+  ASSERT_EQ(7u, length);
+  ASSERT_EQ("(x: 123", std::string {buffer.data()});
+
+  char tiny[1] {'?'};
+  ASSERT_EQ(0u, cen::format_to_buffer(tiny, cen::ipoint {1, 2}));
+  ASSERT_EQ('\0', tiny[0]);
+
+  ASSERT_EQ(0u, cen::format_to_buffer(nullptr, 0, cen::ipoint {1, 2}));
+}
+
+TEST(Formatting, StreamOperators)
+{
+  std::stringstream stream;
+  stream << cen::iarea {1, 2} << ' ' << cen::color {1, 2, 3, 4};
+
+  ASSERT_EQ(cen::to_string(cen::iarea {1, 2}) + " #01020304", stream.str());
+}
+
+#if CENTURION_HAS_FEATURE_FORMAT
+
+TEST(Formatting, StdFormatter)
+{
+  const cen::ipoint point {1, 2};
+  const cen::color color {0xAA, 0xBB, 0xCC, 0xDD};
+
+  ASSERT_EQ("(x: 1, y: 2) #AABBCCDD", std::format("{} {}", point, color));
+
+  std::array<char, 32> buffer {};
+  const auto result = std::format_to_n(buffer.data(), buffer.size() - 1, "{}", point);
+  ASSERT_EQ("(x: 1, y: 2)", std::string(buffer.data(), result.out));
+}
+
+#endif  // CENTURION_HAS_FEATURE_FORMAT
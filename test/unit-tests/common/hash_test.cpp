@@ -0,0 +1,118 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/common/hash.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>      // min
+#include <string>         // string
+#include <unordered_map>  // unordered_map
+#include <vector>         // vector
+
+namespace {
+
+/* A stream that yields its contents in small, uneven pieces */
+class chunked_source final {
+ public:
+  explicit chunked_source(const std::vector<cen::uint8>& data) : mData {data} {}
+
+  auto read_to(cen::uint8* out, const cen::usize maxCount) -> cen::usize
+  {
+    const auto count = std::min({maxCount, mData.size() - mPos, mPos % 7 + 1});
+    std::copy_n(mData.data() + mPos, count, out);
+    mPos += count;
+    return count;
+  }
+
+ private:
+  const std::vector<cen::uint8>& mData;
+  cen::usize mPos {};
+};
+
+}  // namespace
+
+TEST(Hash, KnownValues)
+{
+  ASSERT_EQ(0xEF46DB3751D8E999u, cen::hash64(""));
+  ASSERT_EQ(0x44BC2CF5AD770999u, cen::hash64("abc"));
+  ASSERT_EQ(cen::hash64("abc"), cen::hash64("abc", 3));
+  ASSERT_NE(cen::hash64("abc"), cen::hash64("abc", 1));
+}
+
+TEST(Hash, Incremental)
+{
+  std::vector<cen::uint8> data(1'000);
+  for (cen::usize index = 0; index < data.size(); ++index) {
+    data[index] = static_cast<cen::uint8>(index * 31u);
+  }
+
+  for (const cen::usize size : {0u, 5u, 31u, 32u, 33u, 100u, 1'000u}) {
+    const auto expected = cen::hash64(data.data(), size, 42);
+
+    for (const cen::usize step : {1u, 3u, 32u, 50u}) {
+      cen::hasher64 hasher {42};
+      for (cen::usize offset = 0; offset < size; offset += step) {
+        hasher.update(data.data() + offset, std::min(step, size - offset));
+      }
+
+      ASSERT_EQ(size, hasher.length());
+      ASSERT_EQ(expected, hasher.digest());
+    }
+  }
+
+  cen::hasher64 hasher;
+  hasher.update("abc");
+  hasher.reset();
+  ASSERT_EQ(0u, hasher.length());
+  ASSERT_EQ(cen::hash64(""), hasher.digest());
+}
+
+TEST(Hash, Stream)
+{
+  std::vector<cen::uint8> data(200'000);
+  for (cen::usize index = 0; index < data.size(); ++index) {
+    data[index] = static_cast<cen::uint8>(index ^ (index >> 8));
+  }
+
+  chunked_source source {data};
+  ASSERT_EQ(cen::hash64(data.data(), data.size(), 7), cen::hash64_stream(source, 7));
+}
+
+TEST(Hash, ContentHash)
+{
+  const cen::content_hash hash;
+
+  const std::string text = "foo";
+  ASSERT_EQ(hash(text), hash("foo"));
+  ASSERT_EQ(hash(text), hash(std::string_view {"foo"}));
+  ASSERT_EQ(hash(cen::uint32 {42}), hash(cen::uint32 {42}));
+
+  std::unordered_map<std::string, int, cen::content_hash> map;
+  map["foo"] = 1;
+  map["bar"] = 2;
+  ASSERT_EQ(1, map.at("foo"));
+  ASSERT_EQ(2, map.at("bar"));
+}
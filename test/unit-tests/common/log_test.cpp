@@ -62,6 +62,101 @@ TEST(Log, GetPriority)
             cen::to_underlying(cen::get_priority(cen::log_category::app)));
 }
 
+TEST(Log, IsLogCompiled)
+{
+  ASSERT_TRUE(cen::is_log_compiled(cen::log_priority::verbose));
+  ASSERT_TRUE(cen::is_log_compiled(cen::log_priority::critical));
+}
+
+TEST(Log, IsLogEnabled)
+{
+  cen::set_priority(cen::log_priority::warn);
+  ASSERT_FALSE(cen::is_log_enabled(cen::log_category::app, cen::log_priority::info));
+  ASSERT_TRUE(cen::is_log_enabled(cen::log_category::app, cen::log_priority::warn));
+  ASSERT_TRUE(cen::is_log_enabled(cen::log_category::test, cen::log_priority::error));
+
+  cen::set_priority(cen::log_category::video, cen::log_priority::debug);
+  ASSERT_TRUE(cen::is_log_enabled(cen::log_category::video, cen::log_priority::debug));
+  ASSERT_FALSE(cen::is_log_enabled(cen::log_category::audio, cen::log_priority::debug));
+
+  /* Changes made directly through SDL require a refresh */
+  SDL_LogSetPriority(SDL_LOG_CATEGORY_AUDIO, SDL_LOG_PRIORITY_VERBOSE);
+  cen::refresh_log_priorities();
+  ASSERT_TRUE(cen::is_log_enabled(cen::log_category::audio, cen::log_priority::verbose));
+
+  cen::reset_log_priorities();
+  ASSERT_EQ(cen::get_priority(cen::log_category::app) <= cen::log_priority::info,
+            cen::is_log_enabled(cen::log_category::app, cen::log_priority::info));
+}
+
+TEST(Log, LimiterInterval)
+{
+  cen::log_limiter limiter;
+
+  ASSERT_TRUE(limiter.try_acquire(cen::u64ms {60'000}));
+  ASSERT_FALSE(limiter.try_acquire(cen::u64ms {60'000}));
+  ASSERT_FALSE(limiter.try_acquire(cen::u64ms {60'000}));
+  ASSERT_EQ(2u, limiter.suppressed());
+
+  ASSERT_TRUE(limiter.try_acquire(cen::u64ms {0}));
+  ASSERT_EQ(2u, limiter.take_suppressed());
+  ASSERT_EQ(0u, limiter.suppressed());
+}
+
+TEST(Log, LimiterOnce)
+{
+  cen::log_limiter limiter;
+
+  ASSERT_TRUE(limiter.try_acquire_once());
+  ASSERT_FALSE(limiter.try_acquire_once());
+  ASSERT_FALSE(limiter.try_acquire_once());
+  ASSERT_EQ(2u, limiter.suppressed());
+}
+
+TEST(Log, LogEvery)
+{
+  cen::set_priority(cen::log_priority::info);
+  cen::log_limiter limiter;
+
+  for (int index = 0; index < 10; ++index) {
+    cen::log_every(limiter,
+                   cen::u64ms {60'000},
+                   cen::log_priority::warn,
+                   cen::log_category::render,
+                   "Failed to render texture %i",
+                   index);
+  }
+
+  ASSERT_EQ(9u, limiter.suppressed());
+
+  /* Disabled messages are neither logged nor counted */
+  cen::log_every(limiter,
+                 cen::u64ms {0},
+                 cen::log_priority::verbose,
+                 cen::log_category::render,
+                 "Hidden");
+  ASSERT_EQ(9u, limiter.suppressed());
+
+  cen::log_every(limiter,
+                 cen::u64ms {0},
+                 cen::log_priority::warn,
+                 cen::log_category::render,
+                 "Failed to render texture %i",
+                 10);
+  ASSERT_EQ(0u, limiter.suppressed());
+
+  cen::log_once(limiter, cen::log_priority::warn, cen::log_category::render, "Once");
+  cen::reset_log_priorities();
+}
+
+TEST(Log, RateLimitedMacros)
+{
+  for (int index = 0; index < 10; ++index) {
+    CENTURION_LOG_EVERY(warn, cen::u64ms {1'000}, "Missing glyph %i", index);
+    CENTURION_LOG_ONCE(error, "Failed to load %s", "font");
+  }
+}
+
 TEST(Log, MaxMessageSize)
 {
   ASSERT_EQ(SDL_MAX_LOG_MESSAGE, cen::max_log_message_size());
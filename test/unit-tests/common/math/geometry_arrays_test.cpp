@@ -0,0 +1,172 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/common/geometry_arrays.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>  // mt19937, uniform_real_distribution
+#include <vector>  // vector
+
+namespace {
+
+[[nodiscard]] auto random_rects(const cen::usize count) -> std::vector<cen::frect>
+{
+  std::mt19937 engine {7};
+  std::uniform_real_distribution<float> position {-100.0f, 100.0f};
+  std::uniform_real_distribution<float> size {0.0f, 50.0f};
+
+  std::vector<cen::frect> rects;
+  for (cen::usize index = 0; index < count; ++index) {
+    rects.emplace_back(position(engine), position(engine), size(engine), size(engine));
+  }
+
+  return rects;
+}
+
+}  // namespace
+
+TEST(PointArray, Conversion)
+{
+  const std::vector<cen::ipoint> points {{1, 2}, {3, 4}, {5, 6}};
+
+  cen::ipoint_array array {points.data(), points.size()};
+  ASSERT_EQ(3u, array.size());
+  ASSERT_EQ(cen::ipoint(3, 4), array.get(1));
+
+  array.push_back({7, 8});
+  array.set(0, {-1, -2});
+  ASSERT_EQ(7, array.x()[3]);
+
+  std::vector<cen::ipoint> out(array.size());
+  array.copy_to(out.data());
+  ASSERT_EQ(cen::ipoint(-1, -2), out[0]);
+  ASSERT_EQ(cen::ipoint(7, 8), out[3]);
+
+  array.clear();
+  ASSERT_TRUE(array.empty());
+}
+
+TEST(PointArray, Within)
+{
+  cen::fpoint_array array;
+  for (int index = 0; index < 11; ++index) {
+    array.push_back({static_cast<float>(index), static_cast<float>(index)});
+  }
+
+  std::vector<cen::uint8> mask;
+  ASSERT_EQ(5u, array.within(cen::frect {2, 2, 4, 4}, mask));
+  ASSERT_EQ((std::vector<cen::uint8> {0, 0, 1, 1, 1, 1, 1, 0, 0, 0, 0}), mask);
+}
+
+TEST(PointArray, TransformAndClamp)
+{
+  cen::fpoint_array array;
+  for (int index = 0; index < 9; ++index) {
+    array.push_back({static_cast<float>(index), -static_cast<float>(index)});
+  }
+
+  array.translate({1, 1});
+  ASSERT_EQ(cen::fpoint(9, -7), array.get(8));
+
+  array.transform({2, 0.5f}, {-1, 10});
+  ASSERT_EQ(cen::fpoint(17, 6.5f), array.get(8));
+
+  array.clamp({0, 0, 10, 8});
+  ASSERT_EQ(cen::fpoint(10, 6.5f), array.get(8));
+  ASSERT_EQ(cen::fpoint(1, 8), array.get(0));
+}
+
+TEST(RectArray, Conversion)
+{
+  const auto rects = random_rects(13);
+
+  const cen::frect_array array {rects.data(), rects.size()};
+  ASSERT_EQ(rects.size(), array.size());
+
+  std::vector<cen::frect> out(array.size());
+  array.copy_to(out.data());
+  ASSERT_EQ(rects, out);
+}
+
+TEST(RectArray, MatchesScalarTests)
+{
+  const auto rects = random_rects(1'003);
+  const cen::frect_array array {rects.data(), rects.size()};
+
+  const cen::frect region {-20, -10, 60, 40};
+  const cen::fpoint point {5, 5};
+
+  std::vector<cen::uint8> intersecting;
+  std::vector<cen::uint8> containing;
+  const auto intersectCount = array.intersects(region, intersecting);
+  const auto containCount = array.contains(point, containing);
+
+  cen::usize expectedIntersections = 0;
+  cen::usize expectedContains = 0;
+
+  for (cen::usize index = 0; index < rects.size(); ++index) {
+    const auto intersects = cen::intersects(rects[index], region);
+    const auto contains = rects[index].contains(point);
+
+    ASSERT_EQ(intersects ? 1 : 0, intersecting[index]);
+    ASSERT_EQ(contains ? 1 : 0, containing[index]);
+
+    expectedIntersections += intersects ? 1u : 0u;
+    expectedContains += contains ? 1u : 0u;
+  }
+
+  ASSERT_EQ(expectedIntersections, intersectCount);
+  ASSERT_EQ(expectedContains, containCount);
+}
+
+TEST(RectArray, TransformAndClamp)
+{
+  cen::irect_array array;
+  array.push_back({0, 0, 10, 10});
+  array.push_back({-5, 5, 10, 10});
+  array.push_back({50, 50, 10, 10});
+
+  array.translate({5, 0});
+  ASSERT_EQ(cen::irect(5, 0, 10, 10), array.get(0));
+
+  array.transform({2, 2}, {0, 1});
+  ASSERT_EQ(cen::irect(10, 1, 20, 20), array.get(0));
+  ASSERT_EQ(cen::irect(0, 11, 20, 20), array.get(1));
+
+  array.clamp({0, 0, 25, 25});
+  ASSERT_EQ(cen::irect(10, 1, 15, 20), array.get(0));
+  ASSERT_EQ(cen::irect(0, 11, 20, 14), array.get(1));
+  ASSERT_EQ(cen::irect(25, 25, 0, 0), array.get(2));
+
+  cen::frect_array floats;
+  for (int index = 0; index < 6; ++index) {
+    floats.push_back({static_cast<float>(index * 10), 0, 10, 10});
+  }
+
+  floats.clamp({5, 0, 40, 5});
+  ASSERT_EQ(cen::frect(5, 0, 5, 5), floats.get(0));
+  ASSERT_EQ(cen::frect(40, 0, 5, 5), floats.get(4));
+  ASSERT_EQ(cen::frect(45, 0, 0, 5), floats.get(5));
+}
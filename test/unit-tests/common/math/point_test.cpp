@@ -89,6 +89,19 @@ TEST(Point, DistanceFloat)
   ASSERT_FLOAT_EQ(cen::distance(b, a), expected);
 }
 
+#if CENTURION_HAS_FEATURE_IS_CONSTANT_EVALUATED
+
+TEST(Point, ConstexprDistance)
+{
+  static_assert(cen::distance(cen::ipoint {0, 0}, cen::ipoint {3, 4}) == 5);
+  static_assert(cen::distance(cen::fpoint {1, 1}, cen::fpoint {4, 5}) == 5.0f);
+
+  constexpr auto distance = cen::distance(cen::fpoint {189, 86}, cen::fpoint {66, 36});
+  ASSERT_FLOAT_EQ(17.0f * std::sqrt(61.0f), distance);
+}
+
+#endif  // CENTURION_HAS_FEATURE_IS_CONSTANT_EVALUATED
+
 TEST(Point, EqualityOperatorReflexivity)
 {
   const cen::fpoint point;
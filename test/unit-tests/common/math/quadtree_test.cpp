@@ -0,0 +1,144 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/common/quadtree.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // sort
+#include <random>     // mt19937, uniform_real_distribution
+#include <vector>     // vector
+
+namespace {
+
+[[nodiscard]] auto random_rects(const cen::usize count, const float world, const float maxSize)
+    -> std::vector<cen::frect>
+{
+  std::mt19937 engine {42};
+  std::uniform_real_distribution<float> position {-50.0f, world};
+  std::uniform_real_distribution<float> size {0.0f, maxSize};
+
+  std::vector<cen::frect> rects;
+  rects.reserve(count);
+
+  for (cen::usize index = 0; index < count; ++index) {
+    rects.emplace_back(position(engine), position(engine), size(engine), size(engine));
+  }
+
+  return rects;
+}
+
+[[nodiscard]] auto brute_force(const std::vector<cen::frect>& rects,
+                               const std::vector<bool>& alive,
+                               const cen::frect& region) -> std::vector<cen::uint32>
+{
+  std::vector<cen::uint32> ids;
+  for (cen::usize index = 0; index < rects.size(); ++index) {
+    if (alive[index] && cen::intersects(rects[index], region)) {
+      ids.push_back(static_cast<cen::uint32>(index));
+    }
+  }
+
+  return ids;
+}
+
+}  // namespace
+
+TEST(Quadtree, InsertAndRemove)
+{
+  cen::iquadtree index {{0, 0, 256, 256}, 6};
+  ASSERT_TRUE(index.empty());
+
+  index.insert(1, {10, 10, 20, 20});
+  index.insert(2, {100, 100, 5, 5});
+  ASSERT_EQ(2u, index.size());
+  ASSERT_TRUE(index.contains(1));
+  ASSERT_EQ(cen::irect(10, 10, 20, 20), index.get(1));
+
+  /* Inserting an existing id moves it */
+  index.insert(1, {200, 200, 4, 4});
+  ASSERT_EQ(2u, index.size());
+  ASSERT_EQ(0u, index.query(cen::irect {0, 0, 50, 50}, [](cen::uint32) {}));
+
+  ASSERT_TRUE(index.remove(2));
+  ASSERT_FALSE(index.remove(2));
+  ASSERT_FALSE(index.contains(2));
+  ASSERT_FALSE(index.get(2));
+  ASSERT_EQ(1u, index.size());
+
+  index.clear();
+  ASSERT_TRUE(index.empty());
+}
+
+TEST(Quadtree, PointQuery)
+{
+  cen::iquadtree index {{0, 0, 256, 256}, 6};
+  index.insert(1, {0, 0, 10, 10});
+  index.insert(2, {5, 5, 10, 10});
+  index.insert(3, {-40, -40, 5, 5});
+
+  std::vector<cen::uint32> ids;
+  ASSERT_EQ(2u, index.query(cen::ipoint {7, 7}, [&](const cen::uint32 id) {
+    ids.push_back(id);
+  }));
+
+  std::sort(ids.begin(), ids.end());
+  ASSERT_EQ((std::vector<cen::uint32> {1, 2}), ids);
+
+  ASSERT_EQ(1u, index.query(cen::ipoint {-38, -38}, [](cen::uint32) {}));
+  ASSERT_EQ(0u, index.query(cen::ipoint {100, 100}, [](cen::uint32) {}));
+}
+
+TEST(Quadtree, MatchesBruteForce)
+{
+  const auto rects = random_rects(2'000, 1000.0f, 80.0f);
+  std::vector<bool> alive(rects.size(), true);
+  std::vector<cen::uint32> ids;
+
+  for (cen::usize index = 0; index < rects.size(); ++index) {
+    ids.push_back(static_cast<cen::uint32>(index));
+  }
+
+  cen::fquadtree index {{0, 0, 1000, 1000}};
+  index.insert(ids.data(), rects.data(), rects.size());
+  ASSERT_EQ(rects.size(), index.size());
+
+  /* Remove every third entry */
+  std::vector<cen::uint32> removed;
+  for (cen::usize id = 0; id < rects.size(); id += 3) {
+    removed.push_back(static_cast<cen::uint32>(id));
+    alive[id] = false;
+  }
+
+  ASSERT_EQ(removed.size(), index.remove(removed.data(), removed.size()));
+
+  const auto regions = random_rects(200, 1000.0f, 300.0f);
+  for (const auto& region : regions) {
+    std::vector<cen::uint32> found;
+    index.query(region, [&](const cen::uint32 id) { found.push_back(id); });
+
+    std::sort(found.begin(), found.end());
+    ASSERT_EQ(brute_force(rects, alive, region), found);
+  }
+}
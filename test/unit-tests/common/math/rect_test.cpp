@@ -604,6 +604,19 @@ TEST(Rect, GetUnion)
   ASSERT_EQ(ba, ab);
 }
 
+#if CENTURION_HAS_FEATURE_IS_CONSTANT_EVALUATED
+
+TEST(Rect, ConstexprGetUnion)
+{
+  constexpr cen::irect a {10, 10, 50, 50};
+  constexpr cen::irect b {40, 40, 50, 50};
+
+  static_assert(cen::get_union(a, b) == cen::irect {10, 10, 80, 80});
+  static_assert(cen::get_union(a, cen::irect {}) == a);
+}
+
+#endif  // CENTURION_HAS_FEATURE_IS_CONSTANT_EVALUATED
+
 TEST(Rect, IRectToFRect)
 {
   const cen::irect source {{78, 12}, {283, 313}};
@@ -0,0 +1,173 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/common/allocation_tracking.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>  // max_align_t
+#include <cstdint>  // uintptr_t
+#include <cstdlib>  // malloc, calloc, realloc, free
+#include <cstring>  // memset
+
+namespace {
+
+int mallocCount = 0;
+int freeCount = 0;
+
+void* SDLCALL test_malloc(const size_t size)
+{
+  ++mallocCount;
+  return std::malloc(size);
+}
+
+void* SDLCALL test_calloc(const size_t count, const size_t size)
+{
+  ++mallocCount;
+  return std::calloc(count, size);
+}
+
+void* SDLCALL test_realloc(void* memory, const size_t size)
+{
+  return std::realloc(memory, size);
+}
+
+void SDLCALL test_free(void* memory)
+{
+  ++freeCount;
+  std::free(memory);
+}
+
+class AllocationTrackingTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    auto& tracker = cen::detail::get_allocation_tracker();
+    mBase = tracker.base;
+    tracker.base = {test_malloc, test_calloc, test_realloc, test_free};
+
+    mallocCount = 0;
+    freeCount = 0;
+  }
+
+  void TearDown() override { cen::detail::get_allocation_tracker().base = mBase; }
+
+ private:
+  cen::memory_functions mBase;
+};
+
+}  // namespace
+
+TEST_F(AllocationTrackingTest, MallocAndFree)
+{
+  const auto before = cen::allocation_statistics();
+
+  void* memory = cen::detail::tracked_malloc(100);
+  ASSERT_TRUE(memory);
+  ASSERT_EQ(1, mallocCount);
+  ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(memory) % alignof(std::max_align_t));
+
+  std::memset(memory, 0xFF, 100);
+
+  const auto during = cen::allocation_statistics();
+  ASSERT_EQ(before.live_bytes + 100, during.live_bytes);
+  ASSERT_EQ(before.live_allocations + 1, during.live_allocations);
+  ASSERT_EQ(before.total_allocations + 1, during.total_allocations);
+  ASSERT_GE(during.peak_bytes, during.live_bytes);
+
+  cen::detail::tracked_free(memory);
+  ASSERT_EQ(1, freeCount);
+
+  const auto after = cen::allocation_statistics();
+  ASSERT_EQ(before.live_bytes, after.live_bytes);
+  ASSERT_EQ(before.live_allocations, after.live_allocations);
+  ASSERT_EQ(before.total_frees + 1, after.total_frees);
+  ASSERT_GE(after.peak_bytes, before.live_bytes + 100);
+}
+
+TEST_F(AllocationTrackingTest, Calloc)
+{
+  const auto before = cen::allocation_statistics();
+
+  auto* memory = static_cast<unsigned char*>(cen::detail::tracked_calloc(8, 16));
+  ASSERT_TRUE(memory);
+
+  for (int index = 0; index < 8 * 16; ++index) {
+    ASSERT_EQ(0, memory[index]);
+  }
+
+  ASSERT_EQ(before.live_bytes + 128, cen::allocation_statistics().live_bytes);
+
+  cen::detail::tracked_free(memory);
+  ASSERT_EQ(before.live_bytes, cen::allocation_statistics().live_bytes);
+
+  const auto huge = static_cast<size_t>(-1);
+  ASSERT_FALSE(cen::detail::tracked_calloc(huge, 2));
+  ASSERT_EQ(1, mallocCount);
+}
+
+TEST_F(AllocationTrackingTest, Realloc)
+{
+  const auto before = cen::allocation_statistics();
+
+  auto* memory = static_cast<unsigned char*>(cen::detail::tracked_realloc(nullptr, 10));
+  ASSERT_TRUE(memory);
+  ASSERT_EQ(before.live_bytes + 10, cen::allocation_statistics().live_bytes);
+
+  for (int index = 0; index < 10; ++index) {
+    memory[index] = static_cast<unsigned char>(index);
+  }
+
+  memory = static_cast<unsigned char*>(cen::detail::tracked_realloc(memory, 1'000));
+  ASSERT_TRUE(memory);
+  ASSERT_EQ(before.live_bytes + 1'000, cen::allocation_statistics().live_bytes);
+  ASSERT_EQ(before.live_allocations + 1, cen::allocation_statistics().live_allocations);
+
+  for (int index = 0; index < 10; ++index) {
+    ASSERT_EQ(index, memory[index]);
+  }
+
+  memory = static_cast<unsigned char*>(cen::detail::tracked_realloc(memory, 4));
+  ASSERT_EQ(before.live_bytes + 4, cen::allocation_statistics().live_bytes);
+
+  cen::detail::tracked_free(memory);
+  ASSERT_EQ(before.live_bytes, cen::allocation_statistics().live_bytes);
+}
+
+TEST_F(AllocationTrackingTest, FreeNull)
+{
+  const auto before = cen::allocation_statistics();
+
+  cen::detail::tracked_free(nullptr);
+  ASSERT_EQ(0, freeCount);
+  ASSERT_EQ(before.total_frees, cen::allocation_statistics().total_frees);
+}
+
+TEST_F(AllocationTrackingTest, EnableWithInvalidAllocator)
+{
+  if (!cen::is_tracking_allocations()) {
+    ASSERT_FALSE(cen::enable_allocation_tracking(cen::memory_functions {}));
+    ASSERT_FALSE(cen::is_tracking_allocations());
+  }
+}
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/common/frame_arena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>  // uintptr_t
+#include <vector>   // vector
+
+#if CENTURION_HAS_FEATURE_MEMORY_RESOURCE
+#include <memory_resource>  // polymorphic_allocator
+#endif  // CENTURION_HAS_FEATURE_MEMORY_RESOURCE
+
+namespace {
+
+struct vertex final {
+  float x {};
+  float y {};
+};
+
+[[nodiscard]] auto is_aligned(const void* ptr, const std::uintptr_t alignment) -> bool
+{
+  return reinterpret_cast<std::uintptr_t>(ptr) % alignment == 0;
+}
+
+}  // namespace
+
+TEST(FrameArena, Defaults)
+{
+  const cen::frame_arena arena;
+  ASSERT_EQ(arena.used(), 0u);
+  ASSERT_EQ(arena.peak(), 0u);
+  ASSERT_EQ(arena.capacity(), 64u * 1024u);
+  ASSERT_EQ(arena.block_count(), 1u);
+}
+
+TEST(FrameArena, Allocate)
+{
+  cen::frame_arena arena {256};
+
+  auto* a = arena.allocate(10, 1);
+  auto* b = arena.allocate(16, 16);
+  ASSERT_NE(a, b);
+  ASSERT_TRUE(is_aligned(b, 16));
+  ASSERT_GE(arena.used(), 26u);
+
+  auto* value = arena.make<vertex>(1.0f, 2.0f);
+  ASSERT_TRUE(is_aligned(value, alignof(vertex)));
+  ASSERT_EQ(value->x, 1.0f);
+  ASSERT_EQ(value->y, 2.0f);
+
+  auto* array = arena.allocate_array<int>(8);
+  ASSERT_TRUE(is_aligned(array, alignof(int)));
+  ASSERT_EQ(arena.block_count(), 1u);
+}
+
+TEST(FrameArena, Growth)
+{
+  cen::frame_arena arena {64};
+
+  (void) arena.allocate(48);
+  (void) arena.allocate(48);
+  (void) arena.allocate(1024);
+  ASSERT_EQ(arena.block_count(), 3u);
+
+  const auto capacity = arena.capacity();
+  const auto used = arena.used();
+
+  /* The blocks are merged, so the next frame fits in a single block */
+  arena.reset();
+  ASSERT_EQ(arena.block_count(), 1u);
+  ASSERT_EQ(arena.capacity(), capacity);
+  ASSERT_EQ(arena.used(), 0u);
+  ASSERT_EQ(arena.peak(), used);
+
+  (void) arena.allocate(48);
+  (void) arena.allocate(48);
+  (void) arena.allocate(1024);
+  ASSERT_EQ(arena.block_count(), 1u);
+}
+
+TEST(FrameArena, Reuse)
+{
+  cen::frame_arena arena {128};
+
+  auto* first = arena.allocate(32);
+  arena.reset();
+
+  ASSERT_EQ(arena.allocate(32), first);
+}
+
+TEST(FrameArena, Local)
+{
+  auto& arena = cen::frame_arena::local();
+  ASSERT_EQ(&arena, &cen::frame_arena::local());
+}
+
+#if CENTURION_HAS_FEATURE_MEMORY_RESOURCE
+
+TEST(ArenaResource, Containers)
+{
+  cen::frame_arena arena {1024};
+  cen::arena_resource resource {arena};
+  ASSERT_EQ(&resource.arena(), &arena);
+
+  std::pmr::vector<int> values {&resource};
+  for (int i = 0; i < 100; ++i) {
+    values.push_back(i);
+  }
+
+  ASSERT_EQ(values.size(), 100u);
+  ASSERT_EQ(values.back(), 99);
+  ASSERT_GE(arena.used(), sizeof(int) * 100u);
+
+  cen::arena_resource other {arena};
+  ASSERT_TRUE(resource.is_equal(other));
+  ASSERT_FALSE(resource.is_equal(*std::pmr::new_delete_resource()));
+}
+
+#endif  // CENTURION_HAS_FEATURE_MEMORY_RESOURCE
@@ -0,0 +1,179 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/common/simd_vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>      // uintptr_t
+#include <stdexcept>    // out_of_range
+#include <type_traits>  // is_nothrow_move_constructible_v
+#include <utility>      // move
+
+static_assert(std::is_nothrow_move_constructible_v<cen::simd_vector<float>>);
+static_assert(std::is_nothrow_move_assignable_v<cen::simd_vector<float>>);
+
+namespace {
+
+template <typename T>
+[[nodiscard]] auto is_simd_aligned(const cen::simd_vector<T>& vector) -> bool
+{
+  const auto address = reinterpret_cast<std::uintptr_t>(vector.data());
+  return address % cen::simd_vector<T>::alignment() == 0;
+}
+
+}  // namespace
+
+TEST(SIMDVector, Defaults)
+{
+  const cen::simd_vector<float> vector;
+  ASSERT_TRUE(vector.empty());
+  ASSERT_EQ(vector.size(), 0u);
+  ASSERT_EQ(vector.capacity(), 0u);
+  ASSERT_EQ(vector.data(), nullptr);
+  ASSERT_EQ(vector.begin(), vector.end());
+}
+
+TEST(SIMDVector, SizeConstructor)
+{
+  const cen::simd_vector<int> zeroes(10);
+  ASSERT_EQ(zeroes.size(), 10u);
+  ASSERT_TRUE(is_simd_aligned(zeroes));
+
+  for (const auto value : zeroes) {
+    ASSERT_EQ(value, 0);
+  }
+
+  const cen::simd_vector<int> sevens(4, 7);
+  ASSERT_EQ(sevens, (cen::simd_vector<int> {7, 7, 7, 7}));
+}
+
+TEST(SIMDVector, PushBack)
+{
+  cen::simd_vector<float> vector;
+
+  for (int i = 0; i < 100; ++i) {
+    vector.push_back(static_cast<float>(i));
+    ASSERT_TRUE(is_simd_aligned(vector));
+  }
+
+  ASSERT_EQ(vector.size(), 100u);
+  ASSERT_GE(vector.capacity(), 100u);
+  ASSERT_EQ(vector.size_bytes(), 100u * sizeof(float));
+
+  ASSERT_EQ(vector.front(), 0.0f);
+  ASSERT_EQ(vector.back(), 99.0f);
+  ASSERT_EQ(vector[42], 42.0f);
+
+  /* Pushing an element of the vector itself must survive the reallocation */
+  cen::simd_vector<int> values {1};
+  for (int i = 0; i < 20; ++i) {
+    values.push_back(values.back());
+  }
+  ASSERT_EQ(values.back(), 1);
+
+  vector.pop_back();
+  ASSERT_EQ(vector.size(), 99u);
+}
+
+TEST(SIMDVector, Resize)
+{
+  cen::simd_vector<int> vector {1, 2, 3};
+
+  vector.resize(5);
+  ASSERT_EQ(vector, (cen::simd_vector<int> {1, 2, 3, 0, 0}));
+
+  vector.resize(2);
+  ASSERT_EQ(vector, (cen::simd_vector<int> {1, 2}));
+
+  vector.resize(4, 9);
+  ASSERT_EQ(vector, (cen::simd_vector<int> {1, 2, 9, 9}));
+
+  vector.reserve(64);
+  ASSERT_EQ(vector.capacity(), 64u);
+  ASSERT_EQ(vector.size(), 4u);
+
+  vector.shrink_to_fit();
+  ASSERT_EQ(vector.capacity(), 4u);
+  ASSERT_EQ(vector, (cen::simd_vector<int> {1, 2, 9, 9}));
+
+  vector.clear();
+  ASSERT_TRUE(vector.empty());
+
+  vector.shrink_to_fit();
+  ASSERT_EQ(vector.data(), nullptr);
+}
+
+TEST(SIMDVector, At)
+{
+  cen::simd_vector<int> vector {1, 2};
+  ASSERT_EQ(vector.at(1), 2);
+  ASSERT_THROW((void) vector.at(2), std::out_of_range);
+
+  const auto& ref = vector;
+  ASSERT_EQ(ref.at(0), 1);
+  ASSERT_THROW((void) ref.at(2), std::out_of_range);
+}
+
+TEST(SIMDVector, CopyAndMove)
+{
+  const cen::simd_vector<int> original {1, 2, 3};
+
+  cen::simd_vector<int> copy {original};
+  ASSERT_EQ(copy, original);
+  ASSERT_NE(copy.data(), original.data());
+
+  cen::simd_vector<int> moved {std::move(copy)};
+  ASSERT_EQ(moved, original);
+  ASSERT_TRUE(copy.empty());
+
+  cen::simd_vector<int> assigned;
+  assigned = original;
+  ASSERT_EQ(assigned, original);
+
+  assigned = std::move(moved);
+  ASSERT_EQ(assigned, original);
+
+  assigned.push_back(4);
+  ASSERT_NE(assigned, original);
+}
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+TEST(SIMDVector, Span)
+{
+  cen::simd_vector<int> vector {1, 2, 3};
+
+  const auto span = vector.span();
+  ASSERT_EQ(span.size(), 3u);
+  ASSERT_EQ(span.data(), vector.data());
+
+  span[0] = 10;
+  ASSERT_EQ(vector[0], 10);
+
+  const auto& ref = vector;
+  ASSERT_EQ(ref.span().size(), 3u);
+}
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
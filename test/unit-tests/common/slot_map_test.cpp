@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/common/slot_map.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>     // unique_ptr, make_unique
+#include <stdexcept>  // length_error
+#include <string>     // string
+#include <vector>     // vector
+
+TEST(SlotMap, Defaults)
+{
+  const cen::slot_map<int> map;
+  ASSERT_TRUE(map.empty());
+  ASSERT_EQ(0u, map.size());
+  ASSERT_FALSE(map.contains(cen::slot_id<int> {}));
+  ASSERT_FALSE(map.find(cen::slot_id<int> {}));
+  ASSERT_THROW((void) map.at(cen::slot_id<int> {}), cen::exception);
+  ASSERT_FALSE(cen::slot_id<int> {});
+}
+
+TEST(SlotMap, InsertAndErase)
+{
+  cen::slot_map<std::string> map;
+
+  const auto a = map.insert("a");
+  const auto b = map.emplace(3, 'b');
+  const auto c = map.insert("c");
+
+  ASSERT_TRUE(a);
+  ASSERT_EQ(3u, map.size());
+  ASSERT_EQ("a", map[a]);
+  ASSERT_EQ("bbb", map.at(b));
+  ASSERT_EQ("c", *map.find(c));
+
+  ASSERT_TRUE(map.erase(a));
+  ASSERT_FALSE(map.erase(a));
+  ASSERT_FALSE(map.contains(a));
+  ASSERT_FALSE(map.find(a));
+
+  /* The remaining values are still contiguous, and keep their identifiers */
+  ASSERT_EQ(2u, map.size());
+  ASSERT_EQ("bbb", map[b]);
+  ASSERT_EQ("c", map[c]);
+
+  for (cen::usize position = 0; position < map.size(); ++position) {
+    ASSERT_EQ(map.data() + position, map.find(map.id_at(position)));
+  }
+
+  /* A reused slot doesn't make old identifiers valid */
+  const auto d = map.insert("d");
+  ASSERT_EQ(a.index(), d.index());
+  ASSERT_NE(a.generation(), d.generation());
+  ASSERT_FALSE(map.contains(a));
+  ASSERT_EQ("d", map[d]);
+
+  map.clear();
+  ASSERT_TRUE(map.empty());
+  ASSERT_FALSE(map.contains(b));
+  ASSERT_FALSE(map.contains(c));
+  ASSERT_FALSE(map.contains(d));
+}
+
+TEST(SlotMap, Replace)
+{
+  cen::slot_map<std::unique_ptr<int>> map;
+
+  const auto id = map.insert(std::make_unique<int>(1));
+  const auto* before = map.find(id);
+
+  ASSERT_TRUE(map.replace(id, std::make_unique<int>(2)));
+  ASSERT_EQ(before, map.find(id));
+  ASSERT_EQ(2, *map[id]);
+
+  ASSERT_TRUE(map.erase(id));
+  ASSERT_FALSE(map.replace(id, std::make_unique<int>(3)));
+}
+
+TEST(SlotMap, ThrowingConstructor)
+{
+  cen::slot_map<std::string> map;
+
+  const auto a = map.insert("a");
+  const auto b = map.insert("b");
+  ASSERT_TRUE(map.erase(a));
+
+  /* A failed emplacement must not leak the free slot or desynchronize the storage */
+  ASSERT_THROW(map.emplace(std::string::npos, 'x'), std::length_error);
+  ASSERT_EQ(1u, map.size());
+  ASSERT_EQ("b", map[b]);
+
+  const auto c = map.insert("c");
+  ASSERT_EQ(a.index(), c.index());
+  ASSERT_EQ(2u, map.size());
+
+  for (cen::usize position = 0; position < map.size(); ++position) {
+    ASSERT_EQ(map.data() + position, map.find(map.id_at(position)));
+  }
+}
+
+TEST(SlotMap, Stress)
+{
+  cen::slot_map<int> map;
+  std::vector<cen::slot_id<int>> live;
+  std::vector<cen::slot_id<int>> dead;
+
+  cen::uint32 state = 42;
+  const auto next = [&] {
+    state = state * 1'664'525u + 1'013'904'223u;
+    return state >> 8u;
+  };
+
+  for (int iteration = 0; iteration < 20'000; ++iteration) {
+    if (live.empty() || next() % 3u != 0u) {
+      live.push_back(map.insert(iteration));
+    }
+    else {
+      const auto position = next() % live.size();
+      ASSERT_TRUE(map.erase(live[position]));
+
+      dead.push_back(live[position]);
+      live[position] = live.back();
+      live.pop_back();
+    }
+  }
+
+  ASSERT_EQ(live.size(), map.size());
+
+  for (const auto id : live) {
+    ASSERT_TRUE(map.contains(id));
+  }
+
+  for (const auto id : dead) {
+    ASSERT_FALSE(map.contains(id));
+  }
+
+  cen::usize visited = 0;
+  map.each([&](const cen::slot_id<int> id, const int value) {
+    ASSERT_EQ(value, map[id]);
+    ++visited;
+  });
+
+  ASSERT_EQ(map.size(), visited);
+}
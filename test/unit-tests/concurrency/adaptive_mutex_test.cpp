@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/concurrency/adaptive_mutex.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>       // thread
+#include <type_traits>  // is_copy_constructible_v, is_copy_assignable_v
+#include <vector>       // vector
+
+#include "centurion/concurrency/locks.hpp"
+
+static_assert(!std::is_copy_constructible_v<cen::adaptive_mutex>);
+static_assert(!std::is_copy_assignable_v<cen::adaptive_mutex>);
+
+namespace {
+
+template <typename Mutex>
+void increment(Mutex& mutex, int& counter, const int iterations)
+{
+  for (int i = 0; i < iterations; ++i) {
+    cen::scoped_lock lock {mutex};
+    ++counter;
+  }
+}
+
+template <typename Mutex>
+auto contended_increments(Mutex& mutex, const int threads, const int iterations) -> int
+{
+  int counter = 0;
+
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; ++i) {
+    workers.emplace_back([&] { increment(mutex, counter, iterations); });
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  return counter;
+}
+
+}  // namespace
+
+TEST(AdaptiveMutex, Defaults)
+{
+  cen::adaptive_mutex mutex;
+  ASSERT_EQ(mutex.spins(), 128);
+
+  cen::adaptive_mutex other {0};
+  ASSERT_EQ(other.spins(), 0);
+}
+
+TEST(AdaptiveMutex, LockAndUnlock)
+{
+  cen::adaptive_mutex mutex;
+
+  ASSERT_TRUE(mutex.lock());
+  ASSERT_EQ(mutex.try_lock(), cen::lock_status::timed_out);
+
+  ASSERT_TRUE(mutex.unlock());
+  ASSERT_EQ(mutex.try_lock(), cen::lock_status::success);
+  ASSERT_TRUE(mutex.unlock());
+
+  {
+    cen::scoped_lock lock {mutex};
+
+    cen::try_lock attempt {mutex};
+    ASSERT_TRUE(attempt.timed_out());
+  }
+
+  cen::try_lock attempt {mutex};
+  ASSERT_TRUE(attempt.locked());
+}
+
+TEST(AdaptiveMutex, Contention)
+{
+  /* Without spinning, every contended lock parks on the internal condition */
+  cen::adaptive_mutex parking {0};
+  ASSERT_EQ(contended_increments(parking, 4, 10'000), 40'000);
+
+  cen::adaptive_mutex spinning;
+  ASSERT_EQ(contended_increments(spinning, 4, 10'000), 40'000);
+}
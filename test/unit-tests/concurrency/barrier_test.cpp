@@ -0,0 +1,158 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/concurrency/barrier.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>       // atomic
+#include <type_traits>  // ...
+#include <vector>       // vector
+
+static_assert(!std::is_copy_constructible_v<cen::latch>);
+static_assert(!std::is_copy_constructible_v<cen::barrier>);
+
+TEST(Latch, CountDown)
+{
+  cen::latch latch {3};
+  ASSERT_EQ(3u, latch.count());
+  ASSERT_FALSE(latch.try_wait());
+
+  latch.count_down();
+  ASSERT_EQ(2u, latch.count());
+
+  latch.count_down(2);
+  ASSERT_EQ(0u, latch.count());
+  ASSERT_TRUE(latch.try_wait());
+
+  latch.wait();  // Returns immediately
+}
+
+TEST(Latch, Threads)
+{
+  cen::latch latch {4, 0};  // Parks immediately
+  std::atomic<int> sum {0};
+
+  cen::thread_pool pool {4};
+  for (int i = 1; i <= 4; ++i) {
+    pool.submit([&, i] {
+      sum += i;
+      latch.count_down();
+    });
+  }
+
+  latch.wait();
+  ASSERT_EQ(10, sum.load());
+}
+
+TEST(Barrier, Constructor)
+{
+  ASSERT_THROW(cen::barrier {0}, cen::exception);
+
+  cen::barrier barrier {2};
+  ASSERT_EQ(2u, barrier.participants());
+  ASSERT_EQ(0u, barrier.phase());
+}
+
+TEST(Barrier, SingleParticipant)
+{
+  cen::barrier barrier {1};
+  ASSERT_EQ(0u, barrier.arrive_and_wait());
+  ASSERT_EQ(1u, barrier.arrive_and_wait());
+  ASSERT_EQ(2u, barrier.phase());
+}
+
+TEST(Barrier, Phases)
+{
+  constexpr int phases = 50;
+
+  cen::barrier barrier {3};
+  std::atomic<int> counter {0};
+  std::atomic<bool> failed {false};
+
+  // The workers block, so each worker takes one of the tasks
+  cen::thread_pool pool {2};
+  auto work = [&] {
+    for (int phase = 0; phase < phases; ++phase) {
+      ++counter;
+      barrier.arrive_and_wait();
+
+      // Every participant has incremented the counter before anyone continues
+      if (counter.load() < (phase + 1) * 3) {
+        failed = true;
+      }
+
+      barrier.arrive_and_wait();
+    }
+  };
+
+  auto first = pool.submit(work);
+  auto second = pool.submit(work);
+  work();
+
+  first.wait();
+  second.wait();
+
+  ASSERT_FALSE(failed.load());
+  ASSERT_EQ(phases * 3, counter.load());
+  ASSERT_EQ(static_cast<cen::barrier::phase_type>(phases * 2), barrier.phase());
+}
+
+TEST(Barrier, WorkersExecuteTasksWhileWaiting)
+{
+  cen::thread_pool pool {1};
+  cen::barrier barrier {2};
+  std::atomic<bool> helped {false};
+
+  // The only worker waits at the barrier, so the second task can only run on it if the
+  // worker executes pending tasks while it waits
+  auto waiting = pool.submit([&] { barrier.arrive_and_wait(pool); });
+  auto other = pool.submit([&] { helped = true; });
+
+  while (!helped.load()) {
+    SDL_Delay(1);
+  }
+
+  barrier.arrive_and_wait();
+  waiting.wait();
+  other.wait();
+
+  ASSERT_TRUE(helped.load());
+}
+
+TEST(Barrier, ArriveAndDrop)
+{
+  cen::barrier barrier {2};
+
+  barrier.arrive_and_drop();
+  ASSERT_EQ(1u, barrier.participants());
+  ASSERT_EQ(0u, barrier.phase());
+
+  barrier.arrive_and_wait();
+  ASSERT_EQ(1u, barrier.phase());
+
+  barrier.arrive_and_wait();
+  ASSERT_EQ(2u, barrier.phase());
+}
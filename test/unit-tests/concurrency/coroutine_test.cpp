@@ -0,0 +1,140 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/concurrency/coroutine.hpp"
+
+#include <gtest/gtest.h>
+
+#if CENTURION_HAS_FEATURE_COROUTINES
+
+#include <stdexcept>  // runtime_error
+#include <vector>     // vector
+
+namespace {
+
+auto answer() -> cen::task<int>
+{
+  co_return 42;
+}
+
+auto sum_of_answers() -> cen::task<int>
+{
+  const auto first = co_await answer();
+  const auto second = co_await answer();
+  co_return first + second;
+}
+
+auto failing() -> cen::task<int>
+{
+  throw std::runtime_error {"foo"};
+  co_return 0;
+}
+
+auto sequence(cen::task_queue& queue, std::vector<int>& frames) -> cen::task<>
+{
+  for (int frame = 0; frame < 3; ++frame) {
+    frames.push_back(frame);
+    co_await cen::next_frame(queue);
+  }
+}
+
+auto pipeline(cen::thread_pool& pool, cen::task_queue& queue) -> cen::task<int>
+{
+  const auto value = co_await cen::run_on(pool, [] { return 20; });
+  co_await cen::next_frame(queue);
+  co_return co_await cen::run_on(queue, [value] { return value * 2 + 2; });
+}
+
+}  // namespace
+
+TEST(Task, Defaults)
+{
+  const cen::task<int> task;
+  ASSERT_FALSE(task.valid());
+  ASSERT_FALSE(task.is_done());
+}
+
+TEST(Task, Lazy)
+{
+  auto task = answer();
+  ASSERT_TRUE(task.valid());
+  ASSERT_FALSE(task.is_done());
+
+  task.start();
+  ASSERT_TRUE(task.is_done());
+  ASSERT_EQ(task.get(), 42);
+}
+
+TEST(Task, Await)
+{
+  auto task = sum_of_answers();
+  task.start();
+
+  ASSERT_TRUE(task.is_done());
+  ASSERT_EQ(task.get(), 84);
+}
+
+TEST(Task, Exceptions)
+{
+  auto task = failing();
+  task.start();
+
+  ASSERT_TRUE(task.is_done());
+  ASSERT_THROW(task.get(), std::runtime_error);
+}
+
+TEST(Task, NextFrame)
+{
+  cen::task_queue queue;
+  std::vector<int> frames;
+
+  auto task = sequence(queue, frames);
+  task.start();
+  ASSERT_EQ(frames, (std::vector<int> {0}));
+
+  queue.run_pending();
+  ASSERT_EQ(frames, (std::vector<int> {0, 1}));
+
+  queue.run_pending();
+  queue.run_pending();
+  ASSERT_EQ(frames, (std::vector<int> {0, 1, 2}));
+  ASSERT_TRUE(task.is_done());
+}
+
+TEST(Task, RunOn)
+{
+  cen::thread_pool pool {2};
+  cen::task_queue queue;
+
+  auto task = pipeline(pool, queue);
+  task.start();
+
+  while (!task.is_done()) {
+    queue.run_pending();
+  }
+
+  ASSERT_EQ(task.get(), 42);
+}
+
+#endif  // CENTURION_HAS_FEATURE_COROUTINES
@@ -0,0 +1,136 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/concurrency/future.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>     // atomic
+#include <stdexcept>  // runtime_error
+#include <string>     // string, to_string
+#include <vector>     // vector
+
+TEST(Future, Defaults)
+{
+  const cen::future<int> future;
+  ASSERT_FALSE(future.valid());
+}
+
+TEST(Future, Async)
+{
+  cen::thread_pool pool {2};
+
+  auto future = cen::async(pool, [] { return 42; });
+  ASSERT_TRUE(future.valid());
+
+  ASSERT_EQ(future.get(), 42);
+  ASSERT_FALSE(future.valid());
+
+  auto empty = cen::async(pool, [] {});
+  empty.wait();
+  ASSERT_TRUE(empty.is_ready());
+  ASSERT_NO_THROW(empty.get());
+}
+
+TEST(Future, Exceptions)
+{
+  cen::thread_pool pool {1};
+
+  auto future = cen::async(pool, []() -> int { throw std::runtime_error {"foo"}; });
+
+  /* Continuations of failed futures are skipped */
+  bool invoked = false;
+  auto chained = future.then([&invoked](const int value) {
+    invoked = true;
+    return value;
+  });
+
+  ASSERT_THROW(chained.get(), std::runtime_error);
+  ASSERT_FALSE(invoked);
+}
+
+TEST(Future, Then)
+{
+  cen::thread_pool pool {2};
+
+  auto future = cen::async(pool, [] { return 20; })
+                    .then([](const int value) { return value + 1; })
+                    .then([](const int value) { return std::to_string(value * 2); });
+
+  ASSERT_EQ(future.get(), "42");
+}
+
+TEST(Future, ThenOnTaskQueue)
+{
+  cen::thread_pool pool {2};
+  cen::task_queue queue;
+
+  auto future = cen::async(pool, [] { return 10; }).then(queue, [](const int value) {
+    return value * 3;
+  });
+
+  /* The continuation only runs once the queue is drained */
+  while (!future.is_ready()) {
+    queue.run_pending();
+  }
+
+  ASSERT_EQ(future.get(), 30);
+}
+
+TEST(Future, WhenAll)
+{
+  cen::thread_pool pool {4};
+
+  std::vector<cen::future<int>> futures;
+  for (int i = 0; i < 10; ++i) {
+    futures.push_back(cen::async(pool, [i] { return i * i; }));
+  }
+
+  const auto values = cen::when_all(std::move(futures)).get();
+  ASSERT_EQ(values.size(), 10u);
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(values.at(static_cast<std::size_t>(i)), i * i);
+  }
+
+  auto none = cen::when_all(std::vector<cen::future<int>> {});
+  ASSERT_TRUE(none.is_ready());
+  ASSERT_TRUE(none.get().empty());
+}
+
+TEST(Future, WhenAllVoid)
+{
+  cen::thread_pool pool {2};
+  std::atomic<int> count {0};
+
+  std::vector<cen::future<void>> futures;
+  for (int i = 0; i < 5; ++i) {
+    futures.push_back(cen::async(pool, [&count] { ++count; }));
+  }
+
+  futures.push_back(cen::async(pool, [] { throw std::runtime_error {"foo"}; }));
+
+  ASSERT_THROW(cen::when_all(std::move(futures)).get(), std::runtime_error);
+  ASSERT_EQ(count.load(), 5);
+}
@@ -0,0 +1,161 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/concurrency/lock_free_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>     // unique_ptr, make_unique
+#include <stdexcept>  // runtime_error
+
+#include "centurion/common/literals.hpp"
+
+TEST(SPSCQueue, Defaults)
+{
+  cen::spsc_queue<int> queue {5};
+  ASSERT_EQ(queue.capacity(), 8u);
+  ASSERT_EQ(queue.size(), 0u);
+  ASSERT_TRUE(queue.empty());
+  ASSERT_FALSE(queue.try_pop());
+}
+
+TEST(SPSCQueue, PushAndPop)
+{
+  cen::spsc_queue<int> queue {4};
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.try_push(i));
+  }
+
+  ASSERT_FALSE(queue.try_push(4));
+  ASSERT_EQ(queue.size(), 4u);
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(queue.try_pop(), i);
+  }
+
+  ASSERT_FALSE(queue.try_pop());
+
+  /* Wrap around the ring buffer */
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(queue.try_push(i));
+    ASSERT_EQ(queue.try_pop(), i);
+  }
+}
+
+TEST(SPSCQueue, MoveOnlyValues)
+{
+  cen::spsc_queue<std::unique_ptr<int>> queue {2};
+
+  ASSERT_TRUE(queue.try_push(std::make_unique<int>(42)));
+  ASSERT_TRUE(queue.try_emplace(new int {7}));
+
+  const auto first = queue.try_pop();
+  ASSERT_TRUE(first);
+  ASSERT_EQ(**first, 42);
+
+  const auto second = queue.try_pop();
+  ASSERT_TRUE(second);
+  ASSERT_EQ(**second, 7);
+}
+
+TEST(MPMCQueue, PushAndPop)
+{
+  cen::mpmc_queue<int> queue {3};
+  ASSERT_EQ(queue.capacity(), 4u);
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.try_push(i));
+  }
+
+  ASSERT_FALSE(queue.try_push(4));
+  ASSERT_EQ(queue.size(), 4u);
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(queue.try_pop(), i);
+  }
+
+  ASSERT_TRUE(queue.empty());
+  ASSERT_FALSE(queue.try_pop());
+}
+
+TEST(MPMCQueue, FailedPushes)
+{
+  struct throwing final {
+    explicit throwing(const bool fail)
+    {
+      if (fail) {
+        throw std::runtime_error {"!"};
+      }
+    }
+  };
+
+  /* A throwing constructor must not claim a slot that consumers would wait for */
+  cen::mpmc_queue<throwing> throwingQueue {2};
+  ASSERT_THROW(throwingQueue.try_emplace(true), std::runtime_error);
+  ASSERT_TRUE(throwingQueue.empty());
+  ASSERT_TRUE(throwingQueue.try_emplace(false));
+  ASSERT_TRUE(throwingQueue.try_pop());
+
+  /* A value is only moved from when it was added, so pushes can be retried */
+  cen::mpmc_queue<std::unique_ptr<int>> queue {2};
+  ASSERT_TRUE(queue.try_push(std::make_unique<int>(1)));
+  ASSERT_TRUE(queue.try_push(std::make_unique<int>(2)));
+
+  auto value = std::make_unique<int>(3);
+  ASSERT_FALSE(queue.try_push(std::move(value)));
+  ASSERT_TRUE(value);
+
+  ASSERT_TRUE(queue.try_pop());
+  ASSERT_TRUE(queue.try_push(std::move(value)));
+  ASSERT_FALSE(value);
+}
+
+TEST(BlockingQueue, PushAndPop)
+{
+  using namespace cen::literals::time_literals;
+
+  cen::blocking_mpmc_queue<int> queue {2};
+  ASSERT_EQ(queue.capacity(), 2u);
+
+  ASSERT_TRUE(queue.push(1));
+  ASSERT_TRUE(queue.try_push(2));
+  ASSERT_FALSE(queue.try_push(3));
+
+  ASSERT_EQ(queue.pop(), 1);
+  ASSERT_EQ(queue.try_pop(), 2);
+
+  ASSERT_FALSE(queue.try_pop());
+  ASSERT_FALSE(queue.pop(1_ms));
+}
+
+TEST(BlockingQueue, SPSC)
+{
+  cen::blocking_spsc_queue<int> queue {4};
+
+  ASSERT_TRUE(queue.push(10));
+  ASSERT_EQ(queue.size(), 1u);
+  ASSERT_EQ(queue.pop(), 10);
+  ASSERT_TRUE(queue.empty());
+}
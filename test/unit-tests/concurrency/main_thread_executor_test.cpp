@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/concurrency/main_thread_executor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>  // atomic
+#include <thread>  // thread
+#include <vector>  // vector
+
+#include "centurion/common/errors.hpp"
+#include "centurion/concurrency/thread.hpp"
+
+TEST(MainThreadExecutor, Defaults)
+{
+  cen::main_thread_executor executor;
+  ASSERT_TRUE(executor.empty());
+  ASSERT_TRUE(executor.is_owner());
+  ASSERT_EQ(cen::thread::current_id(), executor.owner());
+  ASSERT_EQ(0u, executor.run_pending());
+  ASSERT_EQ(0u, executor.run_for(cen::u32ms {1}));
+  ASSERT_EQ(0u, executor.executed());
+}
+
+TEST(MainThreadExecutor, Overflow)
+{
+  cen::main_thread_executor executor {4};
+  std::vector<int> values;
+
+  /* The first four functions fit in the queue, the rest overflow */
+  for (int index = 0; index < 10; ++index) {
+    executor.post([&values, index] { values.push_back(index); });
+  }
+
+  ASSERT_FALSE(executor.empty());
+  ASSERT_TRUE(executor.run_one());
+  ASSERT_TRUE(executor.run_one());
+
+  /* Posted while the overflow is pending, so they must run after it */
+  executor.post([&values] { values.push_back(10); });
+  executor.post([&values] { values.push_back(11); });
+
+  ASSERT_EQ(10u, executor.run_pending());
+  ASSERT_EQ(values, (std::vector<int> {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}));
+  ASSERT_EQ(12u, executor.executed());
+  ASSERT_TRUE(executor.empty());
+}
+
+TEST(MainThreadExecutor, RunForExecutesAtLeastOne)
+{
+  cen::main_thread_executor executor;
+  int count = 0;
+
+  executor.post([&count] { ++count; });
+  executor.post([&count] { ++count; });
+
+  ASSERT_LE(1u, executor.run_for(cen::u32ms {0}));
+  ASSERT_LE(1, count);
+
+  executor.run_pending();
+  ASSERT_EQ(2, count);
+}
+
+TEST(MainThreadExecutor, PostAndWait)
+{
+  cen::main_thread_executor executor;
+
+  /* Invoked immediately when called on the owning thread */
+  ASSERT_EQ(42, executor.post_and_wait([] { return 42; }));
+
+  std::atomic<bool> done {false};
+  std::atomic<bool> threw {false};
+  cen::thread_id executedBy {};
+  int result {};
+
+  std::thread worker {[&] {
+    result = executor.post_and_wait([&] {
+      executedBy = cen::thread::current_id();
+      return 7;
+    });
+
+    try {
+      executor.post_and_wait([] { throw cen::exception {}; });
+    }
+    catch (const cen::exception&) {
+      threw = true;
+    }
+
+    done = true;
+  }};
+
+  while (!done) {
+    executor.run_pending();
+  }
+
+  worker.join();
+
+  ASSERT_EQ(7, result);
+  ASSERT_TRUE(threw);
+  ASSERT_EQ(cen::thread::current_id(), executedBy);
+}
@@ -0,0 +1,136 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/concurrency/shared_mutex.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>       // atomic
+#include <thread>       // thread
+#include <type_traits>  // is_copy_constructible_v, is_copy_assignable_v
+#include <vector>       // vector
+
+#include "centurion/concurrency/locks.hpp"
+
+static_assert(!std::is_copy_constructible_v<cen::shared_mutex>);
+static_assert(!std::is_copy_assignable_v<cen::shared_mutex>);
+
+static_assert(!std::is_copy_constructible_v<cen::shared_lock>);
+static_assert(!std::is_copy_assignable_v<cen::shared_lock>);
+
+TEST(SharedMutex, Defaults)
+{
+  const cen::shared_mutex mutex;
+  ASSERT_EQ(mutex.readers(), 0u);
+  ASSERT_FALSE(mutex.is_write_locked());
+}
+
+TEST(SharedMutex, MultipleReaders)
+{
+  cen::shared_mutex mutex;
+
+  ASSERT_TRUE(mutex.lock_shared());
+  ASSERT_EQ(mutex.try_lock_shared(), cen::lock_status::success);
+  ASSERT_EQ(mutex.readers(), 2u);
+
+  /* Writers must wait for all readers */
+  ASSERT_EQ(mutex.try_lock(), cen::lock_status::timed_out);
+
+  ASSERT_TRUE(mutex.unlock_shared());
+  ASSERT_TRUE(mutex.unlock_shared());
+  ASSERT_EQ(mutex.readers(), 0u);
+
+  ASSERT_EQ(mutex.try_lock(), cen::lock_status::success);
+  ASSERT_TRUE(mutex.unlock());
+}
+
+TEST(SharedMutex, ExclusiveWriter)
+{
+  cen::shared_mutex mutex;
+
+  ASSERT_TRUE(mutex.lock());
+  ASSERT_TRUE(mutex.is_write_locked());
+  ASSERT_EQ(mutex.readers(), 0u);
+
+  ASSERT_EQ(mutex.try_lock(), cen::lock_status::timed_out);
+  ASSERT_EQ(mutex.try_lock_shared(), cen::lock_status::timed_out);
+
+  ASSERT_TRUE(mutex.unlock());
+  ASSERT_FALSE(mutex.is_write_locked());
+}
+
+TEST(SharedMutex, Locks)
+{
+  cen::shared_mutex mutex;
+
+  {
+    cen::shared_lock first {mutex};
+    cen::shared_lock second {mutex};
+    ASSERT_EQ(mutex.readers(), 2u);
+  }
+
+  ASSERT_EQ(mutex.readers(), 0u);
+
+  {
+    cen::scoped_lock lock {mutex};
+    ASSERT_TRUE(mutex.is_write_locked());
+  }
+
+  ASSERT_FALSE(mutex.is_write_locked());
+}
+
+TEST(SharedMutex, Contention)
+{
+  cen::shared_mutex mutex;
+  int value = 0;
+  std::atomic<int> reads {0};
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 2; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 1'000; ++j) {
+        cen::scoped_lock lock {mutex};
+        ++value;
+      }
+    });
+  }
+
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      for (int j = 0; j < 1'000; ++j) {
+        cen::shared_lock lock {mutex};
+        if (value >= 0) {
+          ++reads;
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(value, 2'000);
+  ASSERT_EQ(reads.load(), 4'000);
+}
@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/concurrency/spin_lock.hpp"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>
+
+#include "centurion/concurrency/locks.hpp"
+
+static_assert(!std::is_copy_constructible_v<cen::spin_lock>);
+static_assert(!std::is_copy_assignable_v<cen::spin_lock>);
+
+TEST(SpinLock, LockAndUnlock)
+{
+  cen::spin_lock lock;
+  ASSERT_EQ(*lock.data(), 0);
+
+  ASSERT_TRUE(lock.lock());
+  ASSERT_EQ(lock.try_lock(), cen::lock_status::timed_out);
+
+  ASSERT_TRUE(lock.unlock());
+  ASSERT_EQ(lock.try_lock(), cen::lock_status::success);
+  ASSERT_TRUE(lock.unlock());
+}
+
+TEST(SpinLock, ScopedLock)
+{
+  cen::spin_lock lock;
+
+  {
+    cen::scoped_lock guard {lock};
+    ASSERT_EQ(lock.try_lock(), cen::lock_status::timed_out);
+  }
+
+  ASSERT_EQ(lock.try_lock(), cen::lock_status::success);
+  ASSERT_TRUE(lock.unlock());
+}
+
+TEST(SpinLock, TryLock)
+{
+  cen::spin_lock lock;
+
+  {
+    cen::try_lock first {lock};
+    ASSERT_TRUE(first.locked());
+
+    cen::try_lock second {lock};
+    ASSERT_TRUE(second.timed_out());
+  }
+
+  cen::try_lock third {lock};
+  ASSERT_TRUE(third);
+}
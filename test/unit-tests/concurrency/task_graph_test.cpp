@@ -0,0 +1,147 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/concurrency/task_graph.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>     // atomic
+#include <stdexcept>  // runtime_error
+#include <vector>     // vector
+
+#include "centurion/concurrency/thread.hpp"
+#include "centurion/concurrency/thread_pool.hpp"
+
+TEST(TaskGraph, Defaults)
+{
+  cen::thread_pool pool {2};
+  cen::task_graph graph;
+
+  ASSERT_TRUE(graph.empty());
+  ASSERT_EQ(0u, graph.size());
+  ASSERT_NO_THROW(graph.run(pool));
+}
+
+TEST(TaskGraph, Dependencies)
+{
+  cen::thread_pool pool {4};
+  cen::task_graph graph;
+
+  std::atomic<int> clock {0};
+  std::vector<int> finished(5, -1);
+
+  const auto stamp = [&](const cen::usize index) {
+    return [&, index] { finished[index] = clock.fetch_add(1); };
+  };
+
+  const auto input = graph.add("input", stamp(0), cen::task_affinity::main);
+  const auto simulation = graph.add("simulation", stamp(1));
+  const auto audio = graph.add("audio", stamp(2));
+  const auto culling = graph.add("culling", stamp(3));
+  const auto submit = graph.add("submit", stamp(4), cen::task_affinity::main);
+
+  ASSERT_EQ(5u, graph.size());
+  ASSERT_STREQ("culling", graph.name(culling));
+  ASSERT_EQ(cen::task_affinity::main, graph.affinity(submit));
+
+  graph.precede(input, simulation);
+  graph.precede(input, audio);
+  graph.precede(simulation, culling);
+  graph.depend(submit, culling);
+  graph.depend(submit, audio);
+
+  /* The graph is reused, so every run must respect the dependencies */
+  for (int run = 0; run < 100; ++run) {
+    graph.run(pool);
+
+    ASSERT_LT(finished[0], finished[1]);
+    ASSERT_LT(finished[0], finished[2]);
+    ASSERT_LT(finished[1], finished[3]);
+    ASSERT_LT(finished[3], finished[4]);
+    ASSERT_LT(finished[2], finished[4]);
+  }
+
+  ASSERT_EQ(100u, graph.runs());
+}
+
+TEST(TaskGraph, MainAffinity)
+{
+  cen::thread_pool pool {2};
+  cen::task_graph graph;
+
+  const auto caller = cen::thread::current_id();
+  std::atomic<int> wrongThread {0};
+
+  cen::task_id previous = graph.add("worker", [] {});
+  for (int index = 0; index < 20; ++index) {
+    const auto main = graph.add("main", [&] {
+      if (cen::thread::current_id() != caller) {
+        ++wrongThread;
+      }
+    }, cen::task_affinity::main);
+
+    const auto worker = graph.add("worker", [] {});
+    graph.precede(previous, main);
+    graph.precede(main, worker);
+
+    previous = worker;
+  }
+
+  graph.run(pool);
+  ASSERT_EQ(0, wrongThread);
+}
+
+TEST(TaskGraph, Exceptions)
+{
+  cen::thread_pool pool {2};
+  cen::task_graph graph;
+
+  bool skipped = true;
+  const auto failing = graph.add("failing", [] { throw std::runtime_error {"failed"}; });
+  const auto dependent = graph.add("dependent", [&] { skipped = false; });
+  graph.precede(failing, dependent);
+
+  ASSERT_THROW(graph.run(pool), std::runtime_error);
+  ASSERT_TRUE(skipped);
+}
+
+TEST(TaskGraph, Cycle)
+{
+  cen::thread_pool pool {2};
+  cen::task_graph graph;
+
+  const auto a = graph.add("a", [] {});
+  const auto b = graph.add("b", [] {});
+  const auto c = graph.add("c", [] {});
+
+  graph.precede(a, b);
+  graph.precede(b, c);
+  graph.precede(c, b);
+
+  ASSERT_THROW(graph.run(pool), cen::exception);
+
+  graph.clear();
+  ASSERT_TRUE(graph.empty());
+}
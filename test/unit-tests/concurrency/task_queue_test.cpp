@@ -0,0 +1,70 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/concurrency/task_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+TEST(TaskQueue, Defaults)
+{
+  cen::task_queue queue;
+  ASSERT_TRUE(queue.empty());
+  ASSERT_EQ(queue.size(), 0u);
+  ASSERT_EQ(queue.run_pending(), 0u);
+}
+
+TEST(TaskQueue, RunPending)
+{
+  cen::task_queue queue;
+  std::vector<int> values;
+
+  queue.post([&values] { values.push_back(1); });
+  queue.post([&values] { values.push_back(2); });
+  ASSERT_EQ(queue.size(), 2u);
+
+  ASSERT_EQ(queue.run_pending(), 2u);
+  ASSERT_EQ(values, (std::vector<int> {1, 2}));
+  ASSERT_TRUE(queue.empty());
+}
+
+TEST(TaskQueue, PostFromTask)
+{
+  cen::task_queue queue;
+  int count = 0;
+
+  queue.post([&] {
+    ++count;
+    queue.post([&count] { ++count; });
+  });
+
+  /* Tasks posted while draining are deferred to the next call */
+  ASSERT_EQ(queue.run_pending(), 1u);
+  ASSERT_EQ(count, 1);
+  ASSERT_EQ(queue.size(), 1u);
+
+  ASSERT_EQ(queue.run_pending(), 1u);
+  ASSERT_EQ(count, 2);
+}
@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/concurrency/thread_local_storage.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>       // atomic
+#include <type_traits>  // ...
+
+#include "centurion/concurrency/thread.hpp"
+
+static_assert(!std::is_copy_constructible_v<cen::thread_local_storage<int>>);
+static_assert(!std::is_move_constructible_v<cen::thread_local_storage<int>>);
+static_assert(!std::is_copy_constructible_v<cen::thread_local_storage<int*>>);
+
+namespace {
+
+std::atomic<int> destroyed {};
+
+struct tracked final {
+  int value {7};
+
+  ~tracked() noexcept { ++destroyed; }
+};
+
+cen::thread_local_storage<tracked> storage;
+
+}  // namespace
+
+TEST(ThreadLocalStorage, GetAndEmplace)
+{
+  cen::thread_local_storage<int> ints;
+  ASSERT_NE(0u, ints.id());
+  ASSERT_FALSE(ints.has_value());
+  ASSERT_EQ(nullptr, ints.try_get());
+
+  ASSERT_EQ(0, ints.get());
+  ASSERT_TRUE(ints.has_value());
+
+  ints.get() = 42;
+  ASSERT_EQ(42, *ints.try_get());
+
+  ASSERT_EQ(12, ints.emplace(12));
+  ASSERT_EQ(12, ints.get());
+
+  ints.reset();
+  ASSERT_FALSE(ints.has_value());
+}
+
+TEST(ThreadLocalStorage, SeparateThreads)
+{
+  destroyed = 0;
+
+  storage.get().value = 1;
+
+  cen::thread thread {[](void*) -> int {
+    // The value of the new thread is independent of the main thread
+    const auto value = storage.get().value;
+    storage.get().value = 2;
+    return value;
+  }};
+
+  ASSERT_EQ(7, thread.join());
+
+  // The value of the exited thread was destroyed
+  ASSERT_EQ(1, destroyed.load());
+  ASSERT_EQ(1, storage.get().value);
+
+  storage.reset();
+  ASSERT_EQ(2, destroyed.load());
+}
+
+TEST(ThreadLocalStorage, Pointers)
+{
+  cen::thread_local_storage<int*> pointers;
+  ASSERT_EQ(nullptr, pointers.get());
+
+  int value = 3;
+  ASSERT_TRUE(pointers.set(&value));
+  ASSERT_EQ(&value, pointers.get());
+
+  cen::thread thread {[](void* data) -> int {
+    auto* self = static_cast<cen::thread_local_storage<int*>*>(data);
+    return (self->get() == nullptr) ? 0 : 1;
+  },
+                      "tls",
+                      &pointers};
+
+  ASSERT_EQ(0, thread.join());
+
+  ASSERT_TRUE(pointers.set(nullptr));
+  ASSERT_EQ(nullptr, pointers.get());
+}
@@ -0,0 +1,218 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/concurrency/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>     // atomic
+#include <stdexcept>  // runtime_error
+#include <vector>     // vector
+
+TEST(ThreadPool, Defaults)
+{
+  cen::thread_pool pool {3};
+  ASSERT_EQ(pool.size(), 3u);
+  ASSERT_EQ(pool.pending(), 0u);
+
+  cen::thread_pool fallback {0};
+  ASSERT_EQ(fallback.size(), 1u);
+
+  ASSERT_GE(cen::thread_pool::default_worker_count(), 1u);
+}
+
+TEST(ThreadPool, Submit)
+{
+  cen::thread_pool pool {2};
+  std::atomic<int> sum {0};
+
+  std::vector<cen::task_handle> tasks;
+  for (int i = 1; i <= 100; ++i) {
+    tasks.push_back(pool.submit([&sum, i] { sum += i; }));
+  }
+
+  for (const auto& task : tasks) {
+    task.wait();
+    ASSERT_TRUE(task.is_done());
+  }
+
+  ASSERT_EQ(sum.load(), 5050);
+}
+
+TEST(ThreadPool, NestedSubmit)
+{
+  cen::thread_pool pool {2};
+  std::atomic<int> count {0};
+
+  auto outer = pool.submit([&] {
+    std::vector<cen::task_handle> inner;
+    for (int i = 0; i < 10; ++i) {
+      inner.push_back(pool.submit([&count] { ++count; }));
+    }
+
+    for (const auto& task : inner) {
+      task.wait();
+    }
+  });
+
+  outer.wait();
+  ASSERT_EQ(count.load(), 10);
+}
+
+TEST(ThreadPool, Exceptions)
+{
+  cen::thread_pool pool {1};
+
+  auto task = pool.submit([] { throw std::runtime_error {"foo"}; });
+  ASSERT_THROW(task.wait(), std::runtime_error);
+  ASSERT_TRUE(task.is_done());
+}
+
+TEST(ThreadPool, Then)
+{
+  cen::thread_pool pool {2};
+  std::vector<int> order;
+
+  auto first = pool.submit([&order] { order.push_back(1); });
+  auto second = first.then([&order] { order.push_back(2); });
+  auto third = second.then([&order] { order.push_back(3); });
+
+  third.wait();
+  ASSERT_EQ(order, (std::vector<int> {1, 2, 3}));
+
+  /* Continuations of finished tasks are scheduled immediately */
+  auto fourth = third.then([&order] { order.push_back(4); });
+  fourth.wait();
+  ASSERT_EQ(order.back(), 4);
+}
+
+TEST(ThreadPool, ParallelFor)
+{
+  cen::thread_pool pool {4};
+  std::vector<int> values(1000, 0);
+
+  pool.parallel_for(0, values.size(), [&values](const cen::usize index) {
+    values[index] = static_cast<int>(index) * 2;
+  });
+
+  for (cen::usize index = 0; index < values.size(); ++index) {
+    ASSERT_EQ(values[index], static_cast<int>(index) * 2);
+  }
+
+  std::atomic<int> calls {0};
+  pool.parallel_for(5, 5, [&calls](cen::usize) { ++calls; });
+  pool.parallel_for(0, 10, [&calls](cen::usize) { ++calls; }, 3);
+  ASSERT_EQ(calls.load(), 10);
+}
+
+TEST(ThreadPool, ParallelForWaitsForAllChunksBeforeThrowing)
+{
+  cen::thread_pool pool {4};
+  std::atomic<int> calls {0};
+
+  const auto callable = [&calls](const cen::usize index) {
+    if (index == 0) {
+      throw std::runtime_error {"chunk failed"};
+    }
+
+    SDL_Delay(1);
+    ++calls;
+  };
+
+  ASSERT_THROW(pool.parallel_for(0, 40, callable, 1), std::runtime_error);
+  ASSERT_EQ(calls.load(), 39);
+}
+
+TEST(ThreadPool, DestructorFinishesTasks)
+{
+  std::atomic<int> count {0};
+
+  {
+    cen::thread_pool pool {2};
+    for (int i = 0; i < 50; ++i) {
+      pool.submit([&count] { ++count; });
+    }
+  }
+
+  ASSERT_EQ(count.load(), 50);
+}
+
+TEST(ThreadPool, Options)
+{
+  cen::thread_pool_options options;
+  options.workers = 2;
+  options.name = "worker";
+  options.stack_size = 512u * 1024u;
+  options.priority = cen::thread_priority::low;
+  options.pin_to_physical_cores = true;
+
+  cen::thread_pool pool {options};
+  ASSERT_EQ(pool.size(), 2u);
+
+  std::atomic<int> count {0};
+  pool.parallel_for(0, 100, [&count](cen::usize) { ++count; });
+  ASSERT_EQ(count.load(), 100);
+
+  /* Pinned pools default to one worker per physical core */
+  cen::thread_pool_options pinned;
+  pinned.pin_to_physical_cores = true;
+
+  cen::thread_pool physical {pinned};
+  ASSERT_EQ(physical.size(), static_cast<cen::usize>(cen::physical_core_count()));
+}
+
+TEST(ThreadPool, ActiveWorkers)
+{
+  cen::thread_pool pool {4};
+  ASSERT_EQ(pool.active_workers(), 4u);
+
+  pool.set_active_workers(0);
+  ASSERT_EQ(pool.active_workers(), 1u);
+
+  std::atomic<int> count {0};
+  pool.parallel_for(0, 100, [&count](cen::usize) { ++count; });
+  ASSERT_EQ(count.load(), 100);
+
+  pool.set_active_workers(10);
+  ASSERT_EQ(pool.active_workers(), 4u);
+
+  pool.set_active_workers(2);
+  for (int i = 0; i < 50; ++i) {
+    pool.post([&count] { ++count; });
+  }
+
+  pool.set_active_workers(3);
+  pool.submit([] {}).wait();
+  pool.parallel_for(0, 50, [&count](cen::usize) { ++count; });
+
+  while (pool.pending() != 0) {
+    pool.run_pending_task();
+  }
+
+  /* Tasks that were queued while workers were parked are completed by the active workers */
+  for (int attempt = 0; attempt < 1'000 && count.load() != 200; ++attempt) {
+    SDL_Delay(1);
+  }
+  ASSERT_EQ(count.load(), 200);
+}
@@ -28,9 +28,12 @@
 
 #include <iostream>
 #include <type_traits>
+#include <vector>
 
 #include "centurion/common/literals.hpp"
 #include "centurion/common/logging.hpp"
+#include "centurion/system/cpu.hpp"
+#include "centurion/system/platform.hpp"
 
 namespace {
 
@@ -159,6 +162,31 @@ TEST(Thread, StreamOperator)
   std::cout << thread << '\n';
 }
 
+TEST(Thread, StackSize)
+{
+  int value = 7;
+  cen::thread thread {[](void* data) noexcept -> int { return *static_cast<int*>(data); },
+                      "cen-thread",
+                      256u * 1024u,
+                      &value};
+
+  ASSERT_EQ(thread.name(), "cen-thread");
+  ASSERT_EQ(thread.join(), 7);
+}
+
+TEST(Thread, SetAffinity)
+{
+  /* Pinning to no CPUs at all is always rejected */
+  ASSERT_FALSE(cen::thread::set_affinity(std::vector<int> {}));
+  ASSERT_FALSE(cen::thread::set_affinity(-1));
+
+  if constexpr (cen::on_linux) {
+    const auto cpus = cen::physical_core_cpus();
+    ASSERT_TRUE(cen::thread::set_affinity(cpus.front()));
+    ASSERT_TRUE(cen::thread::set_affinity(cpus));
+  }
+}
+
 #if CENTURION_HAS_FEATURE_CONCEPTS
 
 TEST(Thread, Init)
@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/detail/lz4.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+TEST(LZ4, CompressBound)
+{
+  ASSERT_GE(cen::detail::lz4_compress_bound(0), 1u);
+  ASSERT_GT(cen::detail::lz4_compress_bound(1'000), 1'000u);
+}
+
+TEST(LZ4, InsufficientCapacity)
+{
+  const std::vector<cen::uint8> data(256, 7);
+  std::vector<cen::uint8> compressed(16);
+  ASSERT_EQ(0u, cen::detail::lz4_compress(data.data(), data.size(), compressed.data(), 16));
+}
+
+TEST(LZ4, RoundTrip)
+{
+  std::vector<cen::uint8> data(10'000);
+
+  cen::uint32 state = 1;
+  for (cen::usize index = 0; index < data.size(); ++index) {
+    state = state * 1'103'515'245u + 12'345u;
+
+    /* Mix repeating runs with noise, to exercise both literals and matches */
+    data[index] = (index / 500) % 2 == 0 ? static_cast<cen::uint8>(index % 13)
+                                         : static_cast<cen::uint8>(state >> 24);
+  }
+
+  std::vector<cen::uint8> compressed(cen::detail::lz4_compress_bound(data.size()));
+  const auto size = cen::detail::lz4_compress(data.data(),
+                                              data.size(),
+                                              compressed.data(),
+                                              compressed.size());
+  ASSERT_NE(0u, size);
+  ASSERT_LT(size, data.size());
+
+  std::vector<cen::uint8> decompressed(data.size());
+  ASSERT_TRUE(cen::detail::lz4_decompress(compressed.data(),
+                                          size,
+                                          decompressed.data(),
+                                          decompressed.size()));
+  ASSERT_EQ(data, decompressed);
+
+  /* The decompressed size must match exactly */
+  decompressed.resize(data.size() + 1);
+  ASSERT_FALSE(cen::detail::lz4_decompress(compressed.data(),
+                                           size,
+                                           decompressed.data(),
+                                           decompressed.size()));
+}
+
+TEST(LZ4, TruncatedInput)
+{
+  const std::vector<cen::uint8> data(1'000, 42);
+
+  std::vector<cen::uint8> compressed(cen::detail::lz4_compress_bound(data.size()));
+  const auto size = cen::detail::lz4_compress(data.data(),
+                                              data.size(),
+                                              compressed.data(),
+                                              compressed.size());
+  ASSERT_NE(0u, size);
+
+  std::vector<cen::uint8> decompressed(data.size());
+  ASSERT_FALSE(cen::detail::lz4_decompress(compressed.data(),
+                                           size - 1,
+                                           decompressed.data(),
+                                           decompressed.size()));
+}
@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/detail/utf8.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>  // string
+#include <vector>  // vector
+
+namespace {
+
+[[nodiscard]] auto decode(const std::string& str) -> std::vector<cen::unicode32_t>
+{
+  std::vector<cen::unicode32_t> codepoints;
+  cen::detail::for_each_utf8(str, [&](const cen::unicode32_t glyph) {
+    codepoints.push_back(glyph);
+  });
+  return codepoints;
+}
+
+}  // namespace
+
+TEST(UTF8, ASCII)
+{
+  ASSERT_TRUE(decode("").empty());
+
+  const std::string text = "The quick brown fox jumps over the lazy dog!";
+  const auto codepoints = decode(text);
+
+  ASSERT_EQ(text.size(), codepoints.size());
+  for (std::size_t index = 0; index < text.size(); ++index) {
+    ASSERT_EQ(static_cast<cen::unicode32_t>(text[index]), codepoints[index]);
+  }
+}
+
+TEST(UTF8, Multibyte)
+{
+  using codepoints = std::vector<cen::unicode32_t>;
+
+  ASSERT_EQ((codepoints {0xE4, 0x20AC, 0x1F600}),
+            decode("\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80"));
+
+  /* Multibyte characters after a run of ASCII characters longer than sixteen bytes */
+  const auto mixed = decode(std::string(20, 'a') + "\xC3\xA4" + std::string(17, 'b'));
+  ASSERT_EQ(38u, mixed.size());
+  ASSERT_EQ('a', mixed.at(19));
+  ASSERT_EQ(0xE4u, mixed.at(20));
+  ASSERT_EQ('b', mixed.at(21));
+  ASSERT_EQ('b', mixed.back());
+}
+
+TEST(UTF8, Malformed)
+{
+  using codepoints = std::vector<cen::unicode32_t>;
+  constexpr auto r = cen::detail::utf8_replacement;
+
+  /* Stray continuation byte, truncated sequence and missing continuation byte */
+  ASSERT_EQ((codepoints {r, 'a'}), decode(std::string {"\x80"} + "a"));
+  ASSERT_EQ((codepoints {r, r}), decode("\xE2\x82"));
+  ASSERT_EQ((codepoints {r, 'b'}), decode(std::string {"\xC3"} + "b"));
+
+  /* Overlong encoding and surrogate */
+  ASSERT_EQ((codepoints {r, r}), decode("\xC0\xAF"));
+  ASSERT_EQ((codepoints {r, r, r}), decode("\xED\xA0\x80"));
+}
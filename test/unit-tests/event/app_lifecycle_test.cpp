@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/events/app_lifecycle.hpp"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>  // ...
+
+static_assert(std::is_final_v<cen::app_lifecycle>);
+static_assert(!std::is_copy_constructible_v<cen::app_lifecycle>);
+static_assert(!std::is_move_constructible_v<cen::app_lifecycle>);
+
+namespace {
+
+void push_app_event(const SDL_EventType type)
+{
+  SDL_Event event {};
+  event.type = type;
+  SDL_PushEvent(&event);
+}
+
+}  // namespace
+
+TEST(AppLifecycle, Defaults)
+{
+  const cen::app_lifecycle lifecycle;
+  ASSERT_FALSE(lifecycle.is_suspended());
+  ASSERT_EQ(0u, lifecycle.suspension_count());
+  ASSERT_EQ(0u, lifecycle.paused_channel_count());
+  ASSERT_TRUE(lifecycle.options().pause_audio);
+  ASSERT_TRUE(lifecycle.options().evict_textures);
+  ASSERT_FALSE(lifecycle.options().reload_textures);
+}
+
+TEST(AppLifecycle, SuspendAndResume)
+{
+  cen::app_lifecycle lifecycle;
+
+  lifecycle.suspend();
+  lifecycle.suspend();
+  ASSERT_TRUE(lifecycle.is_suspended());
+  ASSERT_EQ(1u, lifecycle.suspension_count());
+
+  /* Manual suspensions are kept until the application enters the foreground */
+  ASSERT_FALSE(lifecycle.update());
+  ASSERT_TRUE(lifecycle.is_suspended());
+
+  lifecycle.resume();
+  ASSERT_FALSE(lifecycle.is_suspended());
+  ASSERT_EQ(0u, lifecycle.paused_channel_count());
+}
+
+TEST(AppLifecycle, Events)
+{
+  cen::app_lifecycle lifecycle;
+
+  /* Events pushed from the thread that created the handler are applied immediately */
+  push_app_event(SDL_APP_WILLENTERBACKGROUND);
+  ASSERT_TRUE(lifecycle.is_suspended());
+  ASSERT_FALSE(lifecycle.update());
+
+  push_app_event(SDL_APP_DIDENTERFOREGROUND);
+  ASSERT_FALSE(lifecycle.is_suspended());
+  ASSERT_EQ(1u, lifecycle.suspension_count());
+
+  SDL_FlushEvents(SDL_APP_WILLENTERBACKGROUND, SDL_APP_DIDENTERFOREGROUND);
+}
@@ -0,0 +1,119 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/events/event_bus.hpp"
+
+#include <gtest/gtest.h>
+
+#include "centurion/events/event_handler.hpp"
+#include "centurion/events/misc_events.hpp"
+#include "centurion/events/window_events.hpp"
+
+namespace {
+
+struct score_event final {
+  int points {};
+};
+
+}  // namespace
+
+using EventBus = cen::event_bus<cen::quit_event, cen::window_event, score_event>;
+
+TEST(EventBus, Defaults)
+{
+  const EventBus bus;
+  ASSERT_TRUE(bus.empty());
+  ASSERT_EQ(0u, bus.size());
+  ASSERT_TRUE(bus.view<cen::quit_event>().empty());
+  ASSERT_EQ(0u, bus.count<score_event>());
+}
+
+TEST(EventBus, Poll)
+{
+  cen::event_handler::flush_all();
+
+  EventBus bus;
+
+  cen::window_event windowEvent;
+  windowEvent.set_event_id(cen::window_event_id::resized);
+
+  ASSERT_TRUE(cen::event_handler::push(windowEvent));
+  ASSERT_TRUE(cen::event_handler::push(cen::quit_event {}));
+  ASSERT_TRUE(cen::event_handler::push(windowEvent));
+  ASSERT_TRUE(cen::event_handler::push(cen::keyboard_event {}));
+
+  bus.poll();
+
+  /* Keyboard events aren't collected */
+  ASSERT_EQ(3u, bus.size());
+  ASSERT_EQ(1u, bus.count<cen::quit_event>());
+  ASSERT_EQ(2u, bus.count<cen::window_event>());
+
+  /* Views may be iterated by any amount of systems */
+  for (int pass = 0; pass < 2; ++pass) {
+    int count = 0;
+    for (const auto& event : bus.view<cen::window_event>()) {
+      ASSERT_EQ(cen::window_event_id::resized, event.event_id());
+      ++count;
+    }
+
+    ASSERT_EQ(2, count);
+  }
+
+  bus.clear();
+  ASSERT_TRUE(bus.empty());
+  ASSERT_TRUE(bus.view<cen::window_event>().empty());
+}
+
+TEST(EventBus, Push)
+{
+  EventBus bus;
+  cen::event_channel<score_event> channel;
+
+  /* Enough events to span several arena blocks */
+  for (int frame = 0; frame < 3; ++frame) {
+    for (int index = 0; index < 5'000; ++index) {
+      bus.push(score_event {index});
+    }
+
+    ASSERT_TRUE(channel.push(score_event {-1}));
+    ASSERT_EQ(1u, bus.poll(channel));
+
+    const auto scores = bus.view<score_event>();
+    ASSERT_EQ(5'001u, scores.size());
+
+    for (int index = 0; index < 5'000; ++index) {
+      ASSERT_EQ(index, scores[static_cast<cen::usize>(index)].points);
+    }
+
+    ASSERT_EQ(-1, scores[5'000].points);
+
+    bus.clear();
+    ASSERT_EQ(0u, bus.count<score_event>());
+  }
+
+  /* The arena is merged into a single block after the first frame */
+  ASSERT_EQ(1u, bus.arena().block_count());
+}
@@ -0,0 +1,134 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/events/event_channel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <string>    // string
+#include <thread>    // thread
+#include <vector>    // vector
+
+#include "centurion/events/event_dispatcher.hpp"
+
+namespace {
+
+struct load_complete final {
+  int id {};
+  std::string name;
+};
+
+}  // namespace
+
+TEST(EventChannel, Capacity)
+{
+  const cen::event_channel<int> a {1};
+  ASSERT_EQ(2u, a.capacity());
+
+  const cen::event_channel<int> b {100};
+  ASSERT_EQ(128u, b.capacity());
+}
+
+TEST(EventChannel, PushAndPop)
+{
+  cen::event_channel<load_complete> channel {4};
+  ASSERT_FALSE(channel.pop());
+
+  ASSERT_TRUE(channel.push({1, "foo"}));
+  ASSERT_TRUE(channel.emplace(load_complete {2, "bar"}));
+  ASSERT_TRUE(channel.push({3, "abc"}));
+  ASSERT_TRUE(channel.push({4, "def"}));
+  ASSERT_FALSE(channel.push({5, "full"}));
+
+  const auto first = channel.pop();
+  ASSERT_TRUE(first);
+  ASSERT_EQ(1, first->id);
+  ASSERT_EQ("foo", first->name);
+
+  /* Popping an event makes room for another one */
+  ASSERT_TRUE(channel.push({5, "ghi"}));
+
+  std::vector<int> ids;
+  ASSERT_EQ(4u, channel.drain([&](load_complete&& event) { ids.push_back(event.id); }));
+  ASSERT_EQ((std::vector {2, 3, 4, 5}), ids);
+}
+
+TEST(EventChannel, MultipleProducers)
+{
+  constexpr int threadCount = 4;
+  constexpr int eventsPerThread = 1'000;
+
+  cen::event_channel<int> channel {256};
+
+  std::vector<std::thread> producers;
+  for (int t = 0; t < threadCount; ++t) {
+    producers.emplace_back([&] {
+      for (int i = 0; i < eventsPerThread; ++i) {
+        while (!channel.push(1)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  int sum {};
+  while (sum < threadCount * eventsPerThread) {
+    channel.drain([&](const int value) { sum += value; });
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  ASSERT_EQ(threadCount * eventsPerThread, sum);
+  ASSERT_FALSE(channel.pop());
+}
+
+TEST(EventChannel, Dispatcher)
+{
+  cen::event_channel<load_complete> channel;
+  cen::event_dispatcher<cen::quit_event, load_complete> dispatcher;
+
+  int count {};
+  dispatcher.bind<load_complete>().to([&](const load_complete& event) { count += event.id; });
+
+  std::thread worker {[&] {
+    channel.push({1, "a"});
+    channel.push({2, "b"});
+  }};
+  worker.join();
+
+  ASSERT_EQ(2u, dispatcher.poll(channel));
+  ASSERT_EQ(3, count);
+
+  /* Subscribing to custom events must not interfere with regular polling */
+  ASSERT_NO_THROW(dispatcher.poll());
+}
+
+TEST(EventChannel, StreamOperator)
+{
+  const cen::event_channel<int> channel;
+  std::cout << channel << '\n';
+}
@@ -80,6 +80,142 @@ TEST(EventDispatcher, Bind)
   ASSERT_TRUE(visitedLambda);
 }
 
+TEST(EventDispatcher, Listeners)
+{
+  cen::event_handler::flush_all();
+
+  ButtonHandler first;
+  ButtonHandler second;
+
+  int count {};
+  auto callable = [&](const cen::window_event&) { ++count; };
+
+  EventDispatcher dispatcher;
+
+  auto& buttonSink = dispatcher.bind<cen::controller_button_event>();
+  buttonSink.connect<&ButtonHandler::OnEvent>(&first);
+  const auto conn = buttonSink.connect<&ButtonHandler::OnEvent>(&second);
+  ASSERT_EQ(2u, buttonSink.listener_count());
+
+  ASSERT_TRUE(buttonSink.disconnect(conn));
+  ASSERT_FALSE(buttonSink.disconnect(conn));
+  ASSERT_EQ(1u, buttonSink.listener_count());
+
+  auto& windowSink = dispatcher.bind<cen::window_event>();
+  windowSink.to(callable);
+  windowSink.connect(callable);
+
+  dispatcher.bind<cen::quit_event>().connect<&OnQuit>();
+  ASSERT_EQ(3u, dispatcher.active_count());
+
+  ASSERT_TRUE(cen::event_handler::push(cen::controller_button_event {}));
+  ASSERT_TRUE(cen::event_handler::push(cen::window_event {}));
+
+  dispatcher.poll();
+  ASSERT_TRUE(first.visited);
+  ASSERT_FALSE(second.visited);
+  ASSERT_EQ(2, count);
+
+  dispatcher.reset();
+  ASSERT_EQ(0u, dispatcher.active_count());
+}
+
+TEST(EventDispatcher, DisconnectWhilePublishing)
+{
+  cen::event_sink<cen::quit_event> sink;
+
+  struct one_shot final {
+    cen::event_sink<cen::quit_event>* sink {};
+    cen::event_sink<cen::quit_event>::connection conn;
+    int count {};
+
+    void operator()(const cen::quit_event&)
+    {
+      ++count;
+      ASSERT_TRUE(sink->disconnect(conn));
+    }
+  };
+
+  int later {};
+  int added {};
+  auto counter = [&](const cen::quit_event&) { ++later; };
+  auto adder = [&](const cen::quit_event&) { ++added; };
+
+  /* A listener disconnects itself, and another one connects a listener while publishing */
+  one_shot first {&sink};
+  first.conn = sink.connect(first);
+
+  auto connector = [&](const cen::quit_event&) { sink.connect(adder); };
+  const auto connectorConn = sink.connect(connector);
+  sink.connect(counter);
+
+  sink.publish(cen::quit_event {});
+  ASSERT_EQ(1, first.count);
+  ASSERT_EQ(1, later);
+  ASSERT_EQ(0, added);  // Listeners connected while publishing wait for the next event
+  ASSERT_EQ(3u, sink.listener_count());
+
+  ASSERT_TRUE(sink.disconnect(connectorConn));
+  sink.publish(cen::quit_event {});
+  ASSERT_EQ(1, first.count);
+  ASSERT_EQ(2, later);
+  ASSERT_EQ(1, added);
+  ASSERT_EQ(2u, sink.listener_count());
+}
+
+TEST(EventDispatcher, UnsubscribedEvents)
+{
+  cen::event_handler::flush_all();
+
+  int count {};
+
+  cen::event_dispatcher<cen::quit_event> dispatcher;
+  dispatcher.bind<cen::quit_event>().to([&](const cen::quit_event&) { ++count; });
+
+  ASSERT_TRUE(cen::event_handler::push(cen::mouse_motion_event {}));
+  ASSERT_TRUE(cen::event_handler::push(cen::quit_event {}));
+  ASSERT_TRUE(cen::event_handler::push(cen::window_event {}));
+
+  dispatcher.poll();
+  ASSERT_EQ(1, count);
+}
+
+TEST(EventDispatcher, PollBatch)
+{
+  cen::event_handler::flush_all();
+
+  int count {};
+
+  cen::event_dispatcher<cen::quit_event> dispatcher;
+  dispatcher.bind<cen::quit_event>().to([&](const cen::quit_event&) { ++count; });
+
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(cen::event_handler::push(cen::quit_event {}));
+  }
+
+  /* The batch is smaller than the amount of events, so several drains are required */
+  cen::event_batch batch {2};
+  dispatcher.poll(batch);
+
+  ASSERT_EQ(5, count);
+}
+
+TEST(EventDispatcher, EventIndices)
+{
+  using handler = cen::event_handler;
+
+  static_assert(handler::index_of<cen::quit_event>() < handler::index_count());
+  static_assert(handler::index_of<cen::quit_event>() !=
+                handler::index_of<cen::window_event>());
+
+  cen::event_handler::flush_all();
+  ASSERT_TRUE(cen::event_handler::push(cen::quit_event {}));
+
+  cen::event_handler events;
+  ASSERT_TRUE(events.poll());
+  ASSERT_EQ(handler::index_of<cen::quit_event>(), events.index());
+}
+
 TEST(EventDispatcher, Reset)
 {
   EventDispatcher dispatcher;
@@ -130,3 +266,94 @@ TEST(EventDispatcher, StreamOperator)
   EventDispatcher dispatcher;
   std::cout << dispatcher << '\n';
 }
+
+TEST(EventDispatcher, Instrumentation)
+{
+  cen::event_handler::flush_all();
+
+  EventDispatcher dispatcher;
+  ASSERT_FALSE(dispatcher.is_instrumented());
+
+  int count {};
+  dispatcher.bind<cen::window_event>().to([&](const cen::window_event&) { ++count; });
+
+  ASSERT_TRUE(cen::event_handler::push(cen::window_event {}));
+  dispatcher.poll();
+  ASSERT_EQ(0u, dispatcher.statistics().latency().count());
+  ASSERT_EQ(0u, dispatcher.handler_stats<cen::window_event>().calls);
+
+  dispatcher.set_instrumented(true);
+  ASSERT_TRUE(dispatcher.is_instrumented());
+
+  ASSERT_TRUE(cen::event_handler::push(cen::window_event {}));
+  ASSERT_TRUE(cen::event_handler::push(cen::window_event {}));
+  ASSERT_TRUE(cen::event_handler::push(cen::quit_event {}));
+  dispatcher.poll();
+  ASSERT_EQ(3, count);
+
+  const auto& stats = dispatcher.statistics();
+  ASSERT_EQ(3u, stats.latency().count());
+  ASSERT_EQ(2u, stats.count(cen::event_type::window));
+  ASSERT_EQ(1u, stats.count(cen::event_type::quit));
+  ASSERT_EQ(1u, stats.polls().polls);
+  ASSERT_EQ(3u, stats.polls().last_depth);
+
+  /* Only sinks with handlers are timed */
+  ASSERT_EQ(2u, dispatcher.handler_stats<cen::window_event>().calls);
+  ASSERT_EQ(0u, dispatcher.handler_stats<cen::quit_event>().calls);
+
+  dispatcher.reset_statistics();
+  ASSERT_EQ(0u, dispatcher.statistics().latency().count());
+  ASSERT_EQ(0u, dispatcher.handler_stats<cen::window_event>().calls);
+}
+
+TEST(EventDispatcher, WindowRouting)
+{
+  cen::event_handler::flush_all();
+
+  EventDispatcher dispatcher;
+
+  int global {};
+  int first {};
+  int second {};
+
+  dispatcher.bind<cen::window_event>().to([&](const cen::window_event&) { ++global; });
+  dispatcher.bind<cen::window_event>(1).to([&](const cen::window_event& event) {
+    ASSERT_EQ(1u, event.window_id());
+    ++first;
+  });
+  dispatcher.bind<cen::window_event>(2).to([&](const cen::window_event& event) {
+    ASSERT_EQ(2u, event.window_id());
+    ++second;
+  });
+
+  ASSERT_EQ(2u, dispatcher.route_count());
+
+  const auto push = [](const cen::uint32 window) {
+    cen::window_event event;
+    event.set_window_id(window);
+    ASSERT_TRUE(cen::event_handler::push(event));
+  };
+
+  push(2);
+  push(1);
+  push(3);  // Not routed, so the global sink receives it
+  push(2);
+  dispatcher.poll();
+
+  ASSERT_EQ(1, first);
+  ASSERT_EQ(2, second);
+  ASSERT_EQ(1, global);
+
+  /* Events of unbound windows fall back to the global sink */
+  ASSERT_TRUE(dispatcher.unbind(2));
+  ASSERT_FALSE(dispatcher.unbind(2));
+
+  push(2);
+  dispatcher.poll();
+  ASSERT_EQ(2, global);
+  ASSERT_EQ(2, second);
+
+  dispatcher.reset();
+  ASSERT_EQ(0u, dispatcher.route_count());
+}
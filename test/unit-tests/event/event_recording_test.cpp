@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/events/event_recording.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+namespace {
+
+inline constexpr auto path = "event_recording_test.bin";
+
+}  // namespace
+
+TEST(EventRecording, InvalidFiles)
+{
+  ASSERT_THROW(cen::event_recorder(cen::file {nullptr}), cen::exception);
+  ASSERT_THROW(cen::event_player(cen::file {nullptr}), cen::exception);
+  ASSERT_THROW(cen::event_player(cen::file {"resources/panda.png", cen::file_mode::rb}),
+               cen::exception);
+}
+
+TEST(EventRecording, RoundTrip)
+{
+  {
+    cen::event_recorder recorder {cen::file {path, cen::file_mode::wb}};
+    const auto start = cen::ticks64();
+
+    SDL_Event motion {};
+    motion.type = SDL_MOUSEMOTION;
+    motion.motion.x = 123;
+    motion.motion.xrel = -4;
+    ASSERT_TRUE(recorder.record(motion, start + cen::u64ms {10}));
+
+    SDL_Event drop {};
+    drop.type = SDL_DROPFILE;
+    drop.drop.file = const_cast<char*>("foo");
+    ASSERT_TRUE(recorder.record(drop, start + cen::u64ms {1'000}));
+
+    SDL_Event quit {};
+    quit.type = SDL_QUIT;
+    ASSERT_TRUE(recorder.record(quit, start + cen::u64ms {1'500}));
+
+    ASSERT_EQ(3u, recorder.count());
+    std::cout << recorder << '\n';
+  }
+
+  cen::event_player player {cen::file {path, cen::file_mode::rb}};
+  ASSERT_FALSE(player.done());
+
+  const auto first = player.next();
+  ASSERT_TRUE(first);
+  ASSERT_EQ(static_cast<Uint32>(SDL_MOUSEMOTION), first->event.type);
+  ASSERT_EQ(123, first->event.motion.x);
+  ASSERT_EQ(-4, first->event.motion.xrel);
+  ASSERT_GE(first->time.count(), 10u);
+
+  const auto second = player.next();
+  ASSERT_TRUE(second);
+  ASSERT_EQ(static_cast<Uint32>(SDL_DROPFILE), second->event.type);
+  ASSERT_EQ(nullptr, second->event.drop.file);
+  ASSERT_EQ(990u, (second->time - first->time).count());
+
+  /* Replay the remaining events as fast as possible */
+  cen::event_handler::flush_all();
+  ASSERT_EQ(1u, player.push_all());
+  ASSERT_TRUE(player.done());
+  ASSERT_FALSE(player.next());
+
+  cen::event_handler handler;
+  ASSERT_TRUE(handler.poll());
+  ASSERT_TRUE(handler.is<cen::quit_event>());
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/events/event_statistics.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(LatencyHistogram, Defaults)
+{
+  const cen::latency_histogram histogram;
+  ASSERT_EQ(0u, histogram.count());
+  ASSERT_EQ(cen::u32ms::zero(), histogram.max());
+  ASSERT_EQ(0, histogram.mean());
+  ASSERT_EQ(cen::u32ms::zero(), histogram.percentile(0.99));
+}
+
+TEST(LatencyHistogram, Record)
+{
+  cen::latency_histogram histogram;
+  histogram.record(cen::u32ms {0});
+  histogram.record(cen::u32ms {1});
+  histogram.record(cen::u32ms {3});
+  histogram.record(cen::u32ms {100'000});
+
+  ASSERT_EQ(4u, histogram.count());
+  ASSERT_EQ(cen::u32ms {100'000}, histogram.max());
+
+  ASSERT_EQ(1u, histogram.bucket(0));
+  ASSERT_EQ(1u, histogram.bucket(1));
+  ASSERT_EQ(1u, histogram.bucket(2));
+  ASSERT_EQ(1u, histogram.bucket(cen::latency_histogram::bucket_count - 1));
+
+  const auto invalid = cen::latency_histogram::bucket_count;
+  ASSERT_THROW((void) histogram.bucket(invalid), std::out_of_range);
+
+  ASSERT_EQ(cen::u32ms {4}, histogram.percentile(0.75));
+  ASSERT_EQ(cen::u32ms {100'000}, histogram.percentile(1));
+
+  histogram.reset();
+  ASSERT_EQ(0u, histogram.count());
+}
+
+TEST(LatencyHistogram, BucketLimit)
+{
+  ASSERT_EQ(cen::u32ms {1}, cen::latency_histogram::bucket_limit(0));
+  ASSERT_EQ(cen::u32ms {2}, cen::latency_histogram::bucket_limit(1));
+  ASSERT_EQ(cen::u32ms {4}, cen::latency_histogram::bucket_limit(2));
+  ASSERT_EQ(cen::u32ms::max(),
+            cen::latency_histogram::bucket_limit(cen::latency_histogram::bucket_count - 1));
+}
+
+TEST(EventStatistics, RecordEvent)
+{
+  cen::event_statistics stats;
+
+  SDL_Event event {};
+  event.type = SDL_KEYDOWN;
+  event.common.timestamp = 100;
+
+  stats.record_event(event, 110);
+  stats.record_event(event, 102);
+
+  event.type = SDL_QUIT;
+  event.common.timestamp = 0xFFFF'FFFF;
+  stats.record_event(event, 1);
+
+  ASSERT_EQ(3u, stats.latency().count());
+  ASSERT_EQ(cen::u32ms {10}, stats.latency().max());
+
+  ASSERT_EQ(2u, stats.count(cen::event_type::key_down));
+  ASSERT_EQ(1u, stats.count(cen::event_type::quit));
+  ASSERT_EQ(0u, stats.count(cen::event_type::key_up));
+  ASSERT_FALSE(stats.latency(cen::event_type::key_up));
+
+  /* The tick counter wrapped around between the timestamp and the dispatch */
+  ASSERT_EQ(cen::u32ms {2}, stats.latency(cen::event_type::quit)->max());
+}
+
+TEST(EventStatistics, RecordPoll)
+{
+  cen::event_statistics stats;
+  stats.record_poll(4);
+  stats.record_poll(0);
+  stats.record_poll(2);
+
+  const auto& polls = stats.polls();
+  ASSERT_EQ(3u, polls.polls);
+  ASSERT_EQ(6u, polls.events);
+  ASSERT_EQ(2u, polls.last_depth);
+  ASSERT_EQ(4u, polls.max_depth);
+  ASSERT_EQ(2, polls.mean_depth());
+
+  stats.reset();
+  ASSERT_EQ(0u, stats.polls().polls);
+}
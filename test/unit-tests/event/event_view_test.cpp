@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/events/event_view.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(EventView, Defaults)
+{
+  const cen::event_view view;
+  ASSERT_EQ(cen::event_type::first_event, view.type());
+  ASSERT_FALSE(view.is<cen::quit_event>());
+  ASSERT_FALSE(view.try_get<cen::window_event>());
+}
+
+TEST(EventView, Is)
+{
+  SDL_Event event {};
+  event.type = SDL_KEYUP;
+
+  const cen::event_view view {event};
+  ASSERT_TRUE(view.is<cen::keyboard_event>());
+  ASSERT_TRUE(view.is(cen::event_type::key_up));
+  ASSERT_FALSE(view.is(cen::event_type::key_down));
+  ASSERT_FALSE(view.is<cen::mouse_button_event>());
+}
+
+TEST(EventView, IsUserEvent)
+{
+  SDL_Event event {};
+  event.type = SDL_USEREVENT + 4;
+
+  const cen::event_view view {event};
+  ASSERT_TRUE(view.is<cen::user_event>());
+  ASSERT_TRUE(view.is(cen::event_type::user));
+}
+
+TEST(EventView, Get)
+{
+  SDL_Event event {};
+  event.type = SDL_MOUSEMOTION;
+  event.motion.timestamp = 123;
+  event.motion.x = 42;
+  event.motion.y = 24;
+
+  const cen::event_view view {event};
+  ASSERT_EQ(cen::u32ms {123}, view.timestamp());
+
+  const auto motion = view.get<cen::mouse_motion_event>();
+  ASSERT_EQ(42, motion.x());
+  ASSERT_EQ(24, motion.y());
+
+  ASSERT_TRUE(view.try_get<cen::mouse_motion_event>());
+  ASSERT_FALSE(view.try_get<cen::keyboard_event>());
+  ASSERT_THROW((void) view.get<cen::keyboard_event>(), cen::exception);
+}
+
+TEST(EventView, Data)
+{
+  SDL_Event event {};
+  event.type = SDL_QUIT;
+
+  const cen::event_view view {event};
+  ASSERT_EQ(SDL_QUIT, view.data().type);
+  ASSERT_EQ(cen::event_type::quit, view.get<cen::quit_event>().type());
+}
@@ -0,0 +1,64 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/events/input_thread.hpp"
+
+#include <gtest/gtest.h>
+
+#include "centurion/events/event_handler.hpp"
+
+TEST(InputThread, Defaults)
+{
+  cen::input_thread thread;
+  ASSERT_TRUE(thread.is_running());
+  ASSERT_EQ(cen::u32ms {1}, thread.interval());
+  ASSERT_EQ(4096u, thread.capacity());
+  ASSERT_EQ(0u, thread.dropped());
+
+  thread.stop();
+  ASSERT_FALSE(thread.is_running());
+
+  /* Stopping a stopped thread has no effect */
+  thread.stop();
+}
+
+TEST(InputThread, Drain)
+{
+  cen::event_handler::flush_all();
+
+  cen::input_thread thread;
+  ASSERT_TRUE(cen::event_handler::push(cen::quit_event {}));
+
+  /* Give the input thread some time to obtain the event */
+  cen::usize count {};
+  for (int attempt = 0; attempt < 100 && count == 0; ++attempt) {
+    cen::thread::sleep(cen::u32ms {5});
+    count += thread.drain([](cen::timed_event&& timed) {
+      ASSERT_EQ(SDL_QUIT, timed.event.type);
+      ASSERT_NE(0u, timed.counter);
+    });
+  }
+
+  ASSERT_EQ(1u, count);
+}
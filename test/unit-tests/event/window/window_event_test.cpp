@@ -67,6 +67,15 @@ TEST(WindowEvent, SetData2)
   ASSERT_EQ(data, event.data2());
 }
 
+TEST(WindowEvent, SetWindowID)
+{
+  cen::window_event event;
+  ASSERT_EQ(0u, event.window_id());
+
+  event.set_window_id(7);
+  ASSERT_EQ(7u, event.window_id());
+}
+
 TEST(WindowEvent, AsSDLEvent)
 {
   const cen::window_event event;
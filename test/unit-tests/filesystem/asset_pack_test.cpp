@@ -0,0 +1,159 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/io/asset_pack.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>  // string, to_string
+
+#include "centurion/io/paths.hpp"
+
+class AssetPackTest : public testing::Test {
+ protected:
+  inline static const auto prefs = cen::preferred_path("centurion", "tests").copy();
+  inline static const auto path = prefs + "assets.pak";
+};
+
+TEST_F(AssetPackTest, InvalidPack)
+{
+  const cen::asset_pack missing {"this_pack_does_not_exist.pak"};
+  ASSERT_FALSE(missing);
+  ASSERT_FALSE(missing.find("foo"));
+  ASSERT_FALSE(missing.open("foo"));
+
+  {
+    cen::file file {path, cen::file_mode::wb};
+    ASSERT_EQ(12u, file.write("not an asset", 12));
+  }
+
+  const cen::asset_pack garbage {path};
+  ASSERT_FALSE(garbage);
+}
+
+TEST_F(AssetPackTest, Builder)
+{
+  cen::asset_pack_builder builder {32};
+  ASSERT_EQ(32u, builder.alignment());
+
+  ASSERT_TRUE(builder.add("a.txt", "abc", 3));
+  ASSERT_FALSE(builder.add("a.txt", "def", 3));
+  ASSERT_FALSE(builder.add(std::string(70'000, 'x'), "abc", 3));
+
+  ASSERT_TRUE(builder.contains("a.txt"));
+  ASSERT_FALSE(builder.contains("b.txt"));
+  ASSERT_EQ(1u, builder.size());
+
+  ASSERT_FALSE(builder.add_file("b.txt", "this_file_does_not_exist.txt"));
+}
+
+TEST_F(AssetPackTest, WriteAndRead)
+{
+  {
+    cen::asset_pack_builder builder;
+
+    for (int index = 0; index < 100; ++index) {
+      const auto contents = "entry " + std::to_string(index);
+      const auto name = "folder/" + std::to_string(index) + ".txt";
+      ASSERT_TRUE(builder.add(name, contents.data(), contents.size()));
+    }
+
+    ASSERT_TRUE(builder.add("empty", nullptr, 0));
+    ASSERT_TRUE(builder.write(path));
+  }
+
+  const cen::asset_pack pack {path};
+  ASSERT_TRUE(pack);
+  ASSERT_EQ(101u, pack.size());
+  ASSERT_EQ(16u, pack.alignment());
+
+  for (int index = 0; index < 100; ++index) {
+    const auto contents = "entry " + std::to_string(index);
+    const auto name = "folder/" + std::to_string(index) + ".txt";
+
+    const auto entry = pack.find(name);
+    ASSERT_TRUE(entry);
+    ASSERT_EQ(name, entry->name);
+    ASSERT_EQ(contents.size(), entry->size);
+    ASSERT_EQ(contents.size(), entry->stored_size);
+    ASSERT_EQ(cen::asset_compression::none, entry->compression);
+    ASSERT_EQ(0u, entry->offset % pack.alignment());
+
+    const std::string data(reinterpret_cast<const char*>(pack.data(*entry)), entry->size);
+    ASSERT_EQ(contents, data);
+  }
+
+  ASSERT_TRUE(pack.contains("empty"));
+  ASSERT_FALSE(pack.contains("folder/100.txt"));
+  ASSERT_FALSE(pack.find("folder"));
+
+  auto file = pack.open("folder/42.txt");
+  ASSERT_TRUE(file);
+  ASSERT_EQ(8u, file.size().value());
+  ASSERT_EQ('e', file.read_byte());
+
+  /* Entries are ordered by the hashes of their names */
+  for (cen::usize index = 1; index < pack.size(); ++index) {
+    ASSERT_LE(cen::detail::asset_hash(pack.at(index - 1).name),
+              cen::detail::asset_hash(pack.at(index).name));
+  }
+}
+
+TEST_F(AssetPackTest, CompressedEntries)
+{
+  std::string text;
+  for (int index = 0; index < 2'000; ++index) {
+    text += "line " + std::to_string(index % 10) + '\n';
+  }
+
+  {
+    cen::asset_pack_builder builder;
+    ASSERT_TRUE(builder.add("text", text.data(), text.size(), cen::asset_compression::lz4));
+
+    /* Incompressible entries are stored as-is */
+    ASSERT_TRUE(builder.add("short", "abc", 3, cen::asset_compression::lz4));
+    ASSERT_TRUE(builder.write(path));
+  }
+
+  const cen::asset_pack pack {path};
+  ASSERT_TRUE(pack);
+
+  const auto text_entry = pack.find("text");
+  ASSERT_TRUE(text_entry);
+  ASSERT_EQ(cen::asset_compression::lz4, text_entry->compression);
+  ASSERT_EQ(text.size(), text_entry->size);
+  ASSERT_LT(text_entry->stored_size, text_entry->size);
+
+  const auto short_entry = pack.find("short");
+  ASSERT_TRUE(short_entry);
+  ASSERT_EQ(cen::asset_compression::none, short_entry->compression);
+
+  auto file = pack.open(*text_entry);
+  ASSERT_TRUE(file);
+  ASSERT_EQ(text.size(), file.size().value());
+
+  std::string data(text.size(), '\0');
+  ASSERT_EQ(text.size(), file.read_to(data.data(), data.size()));
+  ASSERT_EQ(text, data);
+}
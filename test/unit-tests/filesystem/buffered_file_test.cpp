@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/io/buffered_file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>   // array
+#include <vector>  // vector
+
+#include "centurion/io/paths.hpp"
+
+class BufferedFileTest : public testing::Test {
+ protected:
+  inline static const auto prefs = cen::preferred_path("centurion", "tests").copy();
+  inline static const auto path = prefs + "buffered_file";
+};
+
+TEST_F(BufferedFileTest, WriteAndRead)
+{
+  std::vector<cen::uint32> large(1'000);
+  for (cen::usize index = 0; index < large.size(); ++index) {
+    large[index] = static_cast<cen::uint32>(index);
+  }
+
+  {
+    cen::file file {path, cen::file_mode::wb};
+    ASSERT_TRUE(file);
+
+    /* A tiny buffer forces both refills and direct writes */
+    cen::buffered_file_writer writer {file, 16};
+    ASSERT_EQ(16u, writer.buffer_size());
+
+    ASSERT_TRUE(writer.write_byte(42));
+    ASSERT_TRUE(writer.write_native_as_little_endian(cen::uint16 {0x1234}));
+    ASSERT_TRUE(writer.write_native_as_little_endian(cen::uint32 {0x12345678}));
+    ASSERT_TRUE(writer.write_native_as_little_endian(cen::uint64 {0x123456789ABCDEF0}));
+    ASSERT_TRUE(writer.write_native_as_big_endian(cen::uint16 {0x1234}));
+    ASSERT_TRUE(writer.write_native_as_big_endian(cen::uint32 {0x12345678}));
+    ASSERT_TRUE(writer.write_native_as_big_endian(cen::uint64 {0x123456789ABCDEF0}));
+    ASSERT_GT(writer.buffered(), 0u);
+
+    ASSERT_EQ(large.size(), writer.write(large));
+    ASSERT_EQ(3u, writer.write("abc", 3));
+    ASSERT_EQ(static_cast<cen::int64>(29 + (large.size() * 4) + 3), writer.offset());
+
+    ASSERT_TRUE(writer.flush());
+    ASSERT_EQ(0u, writer.buffered());
+  }
+
+  {
+    cen::file file {path, cen::file_mode::rb};
+    ASSERT_TRUE(file);
+
+    cen::buffered_file_reader reader {file, 16};
+    ASSERT_EQ(42, reader.read_byte());
+    ASSERT_EQ(0x1234, reader.read_little_endian_u16());
+    ASSERT_EQ(0x12345678u, reader.read_little_endian_u32());
+    ASSERT_EQ(0x123456789ABCDEF0u, reader.read_little_endian_u64());
+    ASSERT_EQ(0x1234, reader.read_big_endian_u16());
+    ASSERT_EQ(0x12345678u, reader.read_big_endian_u32());
+    ASSERT_EQ(0x123456789ABCDEF0u, reader.read_big_endian_u64());
+    ASSERT_EQ(29, reader.offset());
+
+    std::vector<cen::uint32> values(large.size());
+    ASSERT_EQ(values.size(), reader.read_to(values));
+    ASSERT_EQ(large, values);
+
+    std::array<char, 8> chars {};
+    ASSERT_EQ(3u, reader.read_to(chars));
+    ASSERT_EQ('a', chars[0]);
+    ASSERT_EQ('c', chars[2]);
+
+    ASSERT_TRUE(reader.eof());
+    ASSERT_EQ(0, reader.read_byte());
+  }
+}
+
+TEST_F(BufferedFileTest, SkipAndSeek)
+{
+  {
+    cen::file file {path, cen::file_mode::wb};
+    cen::buffered_file_writer writer {file};
+
+    for (int value = 0; value < 100; ++value) {
+      ASSERT_TRUE(writer.write_byte(static_cast<cen::uint8>(value)));
+    }
+  }
+
+  cen::file file {path, cen::file_mode::rb};
+  cen::buffered_file_reader reader {file, 32};
+
+  ASSERT_EQ(0, reader.read_byte());
+  ASSERT_TRUE(reader.skip(9));
+  ASSERT_EQ(10, reader.read_byte());
+
+  /* Skipping past the buffered data seeks in the file */
+  ASSERT_TRUE(reader.skip(50));
+  ASSERT_EQ(61, reader.offset());
+  ASSERT_EQ(61, reader.read_byte());
+
+  ASSERT_EQ(10, reader.seek(10, cen::seek_mode::from_beginning));
+  ASSERT_EQ(10, reader.read_byte());
+
+  ASSERT_EQ(12, reader.seek(1, cen::seek_mode::relative_to_current));
+  ASSERT_EQ(12, reader.read_byte());
+
+  ASSERT_FALSE(reader.eof());
+}
@@ -0,0 +1,161 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/io/bulk_serialization.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>   // array
+#include <vector>  // vector
+
+#include "centurion/io/buffered_file.hpp"
+#include "centurion/io/file.hpp"
+#include "centurion/io/paths.hpp"
+
+class BulkSerializationTest : public testing::Test {
+ protected:
+  inline static const auto prefs = cen::preferred_path("centurion", "tests").copy();
+  inline static const auto path = prefs + "bulk_serialization";
+};
+
+static_assert(cen::is_bulk_serializable_v<int>);
+static_assert(cen::is_bulk_serializable_v<cen::fpoint>);
+static_assert(cen::is_bulk_serializable_v<cen::iarea>);
+static_assert(cen::is_bulk_serializable_v<cen::frect>);
+static_assert(cen::is_bulk_serializable_v<cen::color>);
+static_assert(!cen::is_bulk_serializable_v<bool>);
+static_assert(!cen::is_bulk_serializable_v<std::vector<int>>);
+
+TEST_F(BulkSerializationTest, WriteAndRead)
+{
+  std::vector<cen::frect> rects;
+  for (int index = 0; index < 10'000; ++index) {
+    const auto value = static_cast<float>(index);
+    rects.push_back(cen::frect {value, -value, value * 0.5f, value + 0.25f});
+  }
+
+  const std::array<cen::color, 3> colors {cen::colors::red, cen::colors::lime, cen::colors::blue};
+
+  {
+    cen::file file {path, cen::file_mode::wb};
+    ASSERT_TRUE(file);
+
+    ASSERT_TRUE(cen::write_bulk(file, rects));
+    ASSERT_TRUE(cen::write_bulk(file, colors));
+    ASSERT_TRUE(cen::write_bulk(file, static_cast<const cen::ipoint*>(nullptr), 0));
+  }
+
+  {
+    cen::file file {path, cen::file_mode::rb};
+    ASSERT_TRUE(file);
+
+    std::vector<cen::frect> readRects;
+    ASSERT_TRUE(cen::read_bulk(file, readRects));
+    ASSERT_EQ(rects, readRects);
+
+    std::array<cen::color, 3> readColors {};
+    ASSERT_EQ(3u, cen::read_bulk(file, readColors.data(), readColors.size()));
+    ASSERT_EQ(colors, readColors);
+
+    std::vector<cen::ipoint> points;
+    ASSERT_TRUE(cen::read_bulk(file, points));
+    ASSERT_TRUE(points.empty());
+  }
+}
+
+TEST_F(BulkSerializationTest, BufferedWriteAndRead)
+{
+  const std::vector<cen::fpoint> points {{1.5f, 2.5f}, {-3, 4}, {5, -6.75f}};
+
+  {
+    cen::file file {path, cen::file_mode::wb};
+    cen::buffered_file_writer writer {file, 16};
+
+    ASSERT_TRUE(cen::write_bulk(writer, points));
+    ASSERT_TRUE(cen::write_bulk(writer, points));
+    ASSERT_TRUE(writer.flush());
+  }
+
+  {
+    cen::file file {path, cen::file_mode::rb};
+    cen::buffered_file_reader reader {file, 16};
+
+    std::vector<cen::fpoint> read;
+    ASSERT_TRUE(cen::read_bulk(reader, read));
+    ASSERT_TRUE(cen::read_bulk(reader, read));  // Appends to the vector
+    ASSERT_EQ(6u, read.size());
+    ASSERT_EQ(points.back(), read.back());
+  }
+}
+
+TEST_F(BulkSerializationTest, RejectsMismatches)
+{
+  const std::vector<cen::fpoint> points {{1, 2}, {3, 4}};
+
+  {
+    cen::file file {path, cen::file_mode::wb};
+    ASSERT_TRUE(cen::write_bulk(file, points));
+  }
+
+  {
+    /* The element type is part of the header, even if the layouts are identical */
+    cen::file file {path, cen::file_mode::rb};
+    std::vector<cen::farea> areas;
+    ASSERT_FALSE(cen::read_bulk(file, areas));
+  }
+
+  {
+    cen::file file {path, cen::file_mode::rb};
+    std::vector<cen::fpoint> read {{7, 8}};
+    ASSERT_FALSE(cen::read_bulk(file, read, 1));
+    ASSERT_EQ(1u, read.size());
+  }
+
+  {
+    cen::file file {path, cen::file_mode::rb};
+    std::array<cen::fpoint, 1> read {};
+    ASSERT_FALSE(cen::read_bulk(file, read.data(), read.size()));
+  }
+
+  std::vector<cen::uint8> bytes;
+
+  {
+    cen::file file {path, cen::file_mode::rb};
+    bytes.resize(file.size().value());
+    ASSERT_EQ(bytes.size(), file.read_to(bytes));
+  }
+
+  {
+    cen::file file {path, cen::file_mode::wb};
+    ASSERT_EQ(bytes.size() - 4u, file.write(bytes.data(), bytes.size() - 4u));
+  }
+
+  {
+    /* Truncated arrays are rejected, and don't modify the vector */
+    cen::file file {path, cen::file_mode::rb};
+    std::vector<cen::fpoint> read {{7, 8}};
+    ASSERT_FALSE(cen::read_bulk(file, read));
+    ASSERT_EQ(1u, read.size());
+  }
+}
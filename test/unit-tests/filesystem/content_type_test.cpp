@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/io/content_type.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>     // cout
+#include <string_view>  // string_view
+#include <vector>       // vector
+
+namespace {
+
+[[nodiscard]] auto sniff(const std::string_view bytes, const cen::usize size = 0)
+    -> cen::content_type
+{
+  std::vector<cen::uint8> buffer(bytes.begin(), bytes.end());
+  if (buffer.size() < size) {
+    buffer.resize(size);
+  }
+
+  return cen::detail::sniff_content(buffer.data(), buffer.size());
+}
+
+}  // namespace
+
+TEST(ContentType, Images)
+{
+  using namespace std::string_view_literals;
+
+  ASSERT_EQ(cen::content_type::png, sniff("\x89PNG\r\n\x1A\n\0\0\0\rIHDR"sv));
+  ASSERT_EQ(cen::content_type::jpg, sniff("\xFF\xD8\xFF\xE0\0\x10JFIF"sv));
+  ASSERT_EQ(cen::content_type::gif, sniff("GIF89a"));
+  ASSERT_EQ(cen::content_type::bmp, sniff("BM6\0\0\0"sv));
+  ASSERT_EQ(cen::content_type::webp, sniff("RIFF\x10\0\0\0WEBPVP8L"sv));
+  ASSERT_EQ(cen::content_type::tif, sniff("II*\0"sv));
+  ASSERT_EQ(cen::content_type::tif, sniff("MM\0*"sv));
+  ASSERT_EQ(cen::content_type::ico, sniff("\0\0\1\0\1\0"sv));
+  ASSERT_EQ(cen::content_type::cur, sniff("\0\0\2\0\1\0"sv));
+  ASSERT_EQ(cen::content_type::pnm, sniff("P6\n16 16\n255\n"));
+  ASSERT_EQ(cen::content_type::xv, sniff("P7 332\n"));
+  ASSERT_EQ(cen::content_type::pcx, sniff("\x0A\x05\x01\x08"sv));
+  ASSERT_EQ(cen::content_type::lbm, sniff("FORM\0\0\0\0ILBM"sv));
+  ASSERT_EQ(cen::content_type::xcf, sniff("gimp xcf v011"));
+  ASSERT_EQ(cen::content_type::xpm, sniff("/* XPM */\nstatic char"));
+  ASSERT_EQ(cen::content_type::qoi, sniff("qoif"));
+  ASSERT_EQ(cen::content_type::jxl, sniff("\xFF\x0A"sv));
+  ASSERT_EQ(cen::content_type::avif, sniff("\0\0\0\x1C" "ftypmif1\0\0\0\0avifmiaf"sv));
+  ASSERT_EQ(cen::content_type::svg, sniff("<?xml version=\"1.0\"?>\n<svg width=\"8\">"));
+
+  ASSERT_TRUE(cen::is_image(cen::content_type::png));
+  ASSERT_TRUE(cen::is_image(cen::content_type::qoi));
+  ASSERT_FALSE(cen::is_image(cen::content_type::wav));
+}
+
+TEST(ContentType, Audio)
+{
+  using namespace std::string_view_literals;
+
+  ASSERT_EQ(cen::content_type::wav, sniff("RIFF\x24\0\0\0WAVEfmt "sv));
+  ASSERT_EQ(cen::content_type::aiff, sniff("FORM\0\0\0\0AIFF"sv));
+  ASSERT_EQ(cen::content_type::voc, sniff("Creative Voice File\x1A"sv));
+  ASSERT_EQ(cen::content_type::ogg, sniff("OggS\0\2"sv, 64));
+  ASSERT_EQ(cen::content_type::flac, sniff("fLaC"));
+  ASSERT_EQ(cen::content_type::mp3, sniff("ID3\4\0"sv));
+  ASSERT_EQ(cen::content_type::mp3, sniff("\xFF\xFB\x90\x64"sv));
+  ASSERT_EQ(cen::content_type::midi, sniff("MThd\0\0\0\6"sv));
+  ASSERT_EQ(cen::content_type::mod, sniff("Extended Module: song"));
+
+  std::string opus {"OggS"};
+  opus.resize(28);
+  opus += "OpusHead";
+  ASSERT_EQ(cen::content_type::opus, sniff(opus));
+
+  ASSERT_TRUE(cen::is_audio(cen::content_type::wav));
+  ASSERT_TRUE(cen::is_audio(cen::content_type::mod));
+  ASSERT_FALSE(cen::is_audio(cen::content_type::svg));
+}
+
+TEST(ContentType, Unknown)
+{
+  ASSERT_EQ(cen::content_type::unknown, sniff(""));
+  ASSERT_EQ(cen::content_type::unknown, sniff("Hello, world!"));
+  ASSERT_EQ(cen::content_type::unknown, sniff("\x89PN"));
+  ASSERT_EQ(cen::content_type::unknown, sniff("GIF90a"));
+}
+
+TEST(ContentType, ImageTypeName)
+{
+  ASSERT_STREQ("PNG", cen::detail::image_type_name(cen::content_type::png));
+  ASSERT_STREQ("SVG", cen::detail::image_type_name(cen::content_type::svg));
+  ASSERT_EQ(nullptr, cen::detail::image_type_name(cen::content_type::wav));
+  ASSERT_EQ(nullptr, cen::detail::image_type_name(cen::content_type::unknown));
+}
+
+TEST(ContentType, ToString)
+{
+  ASSERT_EQ("unknown", to_string(cen::content_type::unknown));
+  ASSERT_EQ("png", to_string(cen::content_type::png));
+  ASSERT_EQ("jxl", to_string(cen::content_type::jxl));
+  ASSERT_EQ("opus", to_string(cen::content_type::opus));
+  ASSERT_EQ("mod", to_string(cen::content_type::mod));
+
+  std::cout << "content_type::png == " << cen::content_type::png << '\n';
+}
@@ -119,6 +119,28 @@ TEST_F(FileTest, WriteAndRead)
   }
 }
 
+TEST_F(FileTest, ReadEndianArrays)
+{
+  const std::array<Uint8, 8> bytes {0x00, 0x01, 0x00, 0x02, 0x03, 0x00, 0x04, 0x00};
+
+  {
+    cen::file file {path, cen::file_mode::wb};
+    ASSERT_EQ(bytes.size(), file.write(bytes));
+  }
+
+  cen::file file {path, cen::file_mode::rb};
+
+  std::array<Uint16, 2> big {};
+  ASSERT_EQ(2u, file.read_big_endian_array(big));
+  ASSERT_EQ(1u, big.at(0));
+  ASSERT_EQ(2u, big.at(1));
+
+  std::array<Uint16, 4> little {};
+  ASSERT_EQ(2u, file.read_little_endian_array(little.data(), little.size()));
+  ASSERT_EQ(3u, little.at(0));
+  ASSERT_EQ(4u, little.at(1));
+}
+
 TEST_F(FileTest, Queries)
 {
   const cen::file file {path, cen::file_mode::rb};
@@ -134,3 +156,17 @@ TEST_F(FileTest, IsPNG)
 
   ASSERT_TRUE(file.is_png());
 }
+
+TEST_F(FileTest, DetectType)
+{
+  cen::file file {"resources/panda.png", cen::file_mode::rb};
+  ASSERT_TRUE(file);
+
+  ASSERT_EQ(cen::content_type::png, file.detect_type());
+  ASSERT_EQ(0, file.offset());
+
+  /* The detection starts at the current offset */
+  ASSERT_TRUE(file.seek(1, cen::seek_mode::from_beginning));
+  ASSERT_EQ(cen::content_type::unknown, file.detect_type());
+  ASSERT_EQ(1, file.offset());
+}
@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/io/io_service.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>   // array
+#include <string>  // string
+#include <vector>  // vector
+
+#include "centurion/io/paths.hpp"
+
+class IOServiceTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    cen::file file {path, cen::file_mode::wb};
+    ASSERT_TRUE(file);
+    ASSERT_EQ(26u, file.write("abcdefghijklmnopqrstuvwxyz", 26));
+  }
+
+  inline static const auto prefs = cen::preferred_path("centurion", "tests").copy();
+  inline static const auto path = prefs + "io_service";
+  inline static const auto packPath = prefs + "io_service.pak";
+};
+
+TEST_F(IOServiceTest, ReadFile)
+{
+  cen::io_service service;
+
+  std::array<char, 4> buffer {};
+  auto future = service.read(path, 2, buffer.size(), buffer.data(), 7);
+
+  const auto result = future.get();
+  ASSERT_TRUE(result.succeeded);
+  ASSERT_EQ(7u, result.id);
+  ASSERT_EQ(buffer.data(), result.buffer);
+  ASSERT_EQ(4u, result.requested);
+  ASSERT_EQ(4u, result.bytes_read);
+  ASSERT_EQ("cdef", std::string(buffer.data(), buffer.size()));
+}
+
+TEST_F(IOServiceTest, ReadPastEnd)
+{
+  cen::io_service service;
+
+  std::array<char, 8> buffer {};
+  const auto result = service.read(path, 22, buffer.size(), buffer.data()).get();
+  ASSERT_TRUE(result.succeeded);
+  ASSERT_EQ(4u, result.bytes_read);
+  ASSERT_EQ("wxyz", std::string(buffer.data(), result.bytes_read));
+}
+
+TEST_F(IOServiceTest, ReadMissingFile)
+{
+  cen::io_service service;
+
+  std::array<char, 8> buffer {};
+  const auto result = service.read("this_file_does_not_exist", 0, 8, buffer.data()).get();
+  ASSERT_FALSE(result.succeeded);
+  ASSERT_EQ(0u, result.bytes_read);
+}
+
+TEST_F(IOServiceTest, ReadPackEntry)
+{
+  {
+    cen::asset_pack_builder builder;
+    ASSERT_TRUE(builder.add("entry", "0123456789", 10));
+    ASSERT_TRUE(builder.write(packPath));
+  }
+
+  const cen::asset_pack pack {packPath};
+  ASSERT_TRUE(pack);
+
+  const auto entry = pack.find("entry");
+  ASSERT_TRUE(entry);
+
+  cen::io_service service;
+
+  std::array<char, 16> buffer {};
+  const auto result = service.read(pack, *entry, 6, buffer.size(), buffer.data()).get();
+  ASSERT_TRUE(result.succeeded);
+  ASSERT_EQ(4u, result.bytes_read);
+  ASSERT_EQ("6789", std::string(buffer.data(), result.bytes_read));
+
+  ASSERT_FALSE(service.read(pack, *entry, 11, 1, buffer.data()).get().succeeded);
+}
+
+TEST_F(IOServiceTest, ReadIntoChannel)
+{
+  cen::event_channel<cen::read_result> channel;
+  std::vector<std::array<char, 2>> buffers(10);
+
+  {
+    cen::io_service service;
+
+    for (cen::usize index = 0; index < buffers.size(); ++index) {
+      service.read(channel, path, index * 2, 2, buffers[index].data(), index);
+    }
+
+    service.wait_idle();
+    ASSERT_EQ(0u, service.pending());
+  }
+
+  cen::usize count = 0;
+  while (const auto result = channel.pop()) {
+    ASSERT_TRUE(result->succeeded);
+    ASSERT_EQ(2u, result->bytes_read);
+
+    const auto& buffer = buffers.at(result->id);
+    ASSERT_EQ(static_cast<char>('a' + (result->id * 2)), buffer[0]);
+    ++count;
+  }
+
+  ASSERT_EQ(buffers.size(), count);
+}
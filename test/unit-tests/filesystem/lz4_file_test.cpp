@@ -0,0 +1,113 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/io/lz4_file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // min
+#include <string>     // string, to_string
+
+#include "centurion/io/paths.hpp"
+
+class LZ4FileTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    for (int index = 0; index < 50'000; ++index) {
+      contents += "entry " + std::to_string(index % 1'000) + '\n';
+    }
+
+    auto file = cen::create_lz4(cen::file {path, cen::file_mode::wb});
+    ASSERT_TRUE(file);
+
+    /* Write in pieces that straddle the block boundaries */
+    for (cen::usize offset = 0; offset < contents.size(); offset += 10'000) {
+      const auto count = std::min(contents.size() - offset, cen::usize {10'000});
+      ASSERT_EQ(count, file.write(contents.data() + offset, count));
+    }
+
+    ASSERT_EQ(static_cast<cen::int64>(contents.size()), file.offset());
+    ASSERT_TRUE(file.close());
+  }
+
+  inline static const auto prefs = cen::preferred_path("centurion", "tests").copy();
+  inline static const auto path = prefs + "stream.lz4";
+  inline static std::string contents;
+};
+
+TEST_F(LZ4FileTest, InvalidSource)
+{
+  ASSERT_FALSE(cen::open_lz4(cen::file {nullptr}));
+  ASSERT_FALSE(cen::create_lz4(cen::file {nullptr}));
+  ASSERT_FALSE(cen::open_lz4(cen::file {"this_file_does_not_exist.lz4", cen::file_mode::rb}));
+
+  {
+    cen::file file {prefs + "garbage.lz4", cen::file_mode::wb};
+    ASSERT_EQ(12u, file.write("not an lz4 f", 12));
+  }
+
+  ASSERT_FALSE(cen::open_lz4(cen::file {prefs + "garbage.lz4", cen::file_mode::rb}));
+}
+
+TEST_F(LZ4FileTest, Read)
+{
+  auto file = cen::open_lz4(cen::file {path, cen::file_mode::rb});
+  ASSERT_TRUE(file);
+  const cen::file compressed {path, cen::file_mode::rb};
+  ASSERT_LT(compressed.size().value(), contents.size());
+
+  std::string data(contents.size(), '\0');
+  ASSERT_EQ(contents.size(), file.read_to(data.data(), data.size()));
+  ASSERT_EQ(contents, data);
+
+  /* The end of the stream */
+  ASSERT_EQ(0u, file.read_to(data.data(), 1));
+}
+
+TEST_F(LZ4FileTest, Seek)
+{
+  auto file = cen::open_lz4(cen::file {path, cen::file_mode::rb});
+  ASSERT_TRUE(file);
+
+  ASSERT_EQ(contents.size(), file.size().value());
+  ASSERT_EQ(static_cast<cen::int64>(contents.size()),
+            file.seek(0, cen::seek_mode::relative_to_end).value());
+
+  /* Seek backwards and forwards across blocks */
+  for (const cen::usize offset : {300'000u, 10u, 70'000u, 65'530u, 0u}) {
+    const auto position = static_cast<cen::int64>(offset);
+    ASSERT_EQ(position, file.seek(position, cen::seek_mode::from_beginning).value());
+
+    std::string data(100, '\0');
+    ASSERT_EQ(100u, file.read_to(data.data(), data.size()));
+    ASSERT_EQ(contents.substr(offset, 100), data);
+  }
+
+  ASSERT_EQ(110, file.seek(10, cen::seek_mode::relative_to_current).value());
+  ASSERT_EQ(contents[110], static_cast<char>(file.read_byte()));
+
+  ASSERT_FALSE(file.seek(-1, cen::seek_mode::from_beginning));
+}
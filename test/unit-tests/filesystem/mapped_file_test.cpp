@@ -0,0 +1,126 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/io/mapped_file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <utility>  // move
+
+#include "centurion/io/paths.hpp"
+
+class MappedFileTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    cen::file file {path, cen::file_mode::wb};
+    ASSERT_TRUE(file);
+    ASSERT_EQ(10u, file.write("0123456789", 10));
+
+    cen::file empty {emptyPath, cen::file_mode::wb};
+    ASSERT_TRUE(empty);
+  }
+
+  inline static const auto prefs = cen::preferred_path("centurion", "tests").copy();
+  inline static const auto path = prefs + "mapped_file";
+  inline static const auto emptyPath = prefs + "mapped_file_empty";
+};
+
+TEST_F(MappedFileTest, InvalidPath)
+{
+  const cen::mapped_file file {"this_file_does_not_exist.bin"};
+  ASSERT_FALSE(file);
+  ASSERT_FALSE(file.is_ok());
+  ASSERT_EQ(nullptr, file.data());
+  ASSERT_EQ(0u, file.size());
+  ASSERT_FALSE(file.view());
+
+  const cen::mapped_file null {static_cast<const char*>(nullptr)};
+  ASSERT_FALSE(null);
+}
+
+TEST_F(MappedFileTest, Contents)
+{
+  const cen::mapped_file file {path};
+  ASSERT_TRUE(file);
+  ASSERT_EQ(10u, file.size());
+  ASSERT_FALSE(file.empty());
+
+  ASSERT_EQ('0', file.data()[0]);
+  ASSERT_EQ('9', file.data()[9]);
+  ASSERT_EQ(10, file.end() - file.begin());
+
+#if CENTURION_HAS_FEATURE_SPAN
+  ASSERT_EQ(10u, file.bytes().size());
+  ASSERT_EQ(std::byte {'5'}, file.bytes()[5]);
+#endif  // CENTURION_HAS_FEATURE_SPAN
+}
+
+TEST_F(MappedFileTest, View)
+{
+  const cen::mapped_file file {path};
+
+  auto whole = file.view();
+  ASSERT_TRUE(whole);
+  ASSERT_EQ(10u, whole.size().value());
+  ASSERT_EQ('0', whole.read_byte());
+
+  auto region = file.view(4, 3);
+  ASSERT_TRUE(region);
+  ASSERT_EQ(3u, region.size().value());
+  ASSERT_EQ('4', region.read_byte());
+  ASSERT_EQ('5', region.read_byte());
+
+  ASSERT_FALSE(file.view(4, 0));
+  ASSERT_FALSE(file.view(8, 3));
+  ASSERT_FALSE(file.view(11, 1));
+  ASSERT_TRUE(file.view(9, 1));
+}
+
+TEST_F(MappedFileTest, EmptyFile)
+{
+  const cen::mapped_file file {emptyPath};
+  ASSERT_TRUE(file);
+  ASSERT_TRUE(file.empty());
+  ASSERT_FALSE(file.view());
+}
+
+TEST_F(MappedFileTest, Move)
+{
+  cen::mapped_file file {path};
+  const auto* data = file.data();
+  const auto mapped = file.is_mapped();
+
+  cen::mapped_file other {std::move(file)};
+  ASSERT_FALSE(file);
+  ASSERT_EQ(nullptr, file.data());
+
+  ASSERT_TRUE(other);
+  ASSERT_EQ(data, other.data());
+  ASSERT_EQ(mapped, other.is_mapped());
+
+  file = std::move(other);
+  ASSERT_TRUE(file);
+  ASSERT_EQ(data, file.data());
+}
@@ -0,0 +1,146 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/io/save_writer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <string>  // string
+#include <vector>  // vector
+
+#include "centurion/io/file.hpp"
+#include "centurion/io/paths.hpp"
+
+namespace {
+
+[[nodiscard]] auto read_contents(const std::string& path) -> std::string
+{
+  cen::file file {path, cen::file_mode::rb};
+  if (!file) {
+    return {};
+  }
+
+  std::string contents(file.size().value(), '\0');
+  file.read_to(contents.data(), contents.size());
+
+  return contents;
+}
+
+[[nodiscard]] auto to_bytes(const std::string& str) -> std::vector<cen::uint8>
+{
+  return {str.begin(), str.end()};
+}
+
+}  // namespace
+
+class SaveWriterTest : public testing::Test {
+ protected:
+  inline static const auto prefs = cen::preferred_path("centurion", "tests").copy();
+};
+
+TEST_F(SaveWriterTest, Save)
+{
+  cen::event_channel<cen::save_result> channel {8};
+
+  {
+    cen::save_writer writer {channel, "centurion", "tests"};
+    ASSERT_EQ(prefs, writer.directory());
+    ASSERT_EQ(prefs + "save.sav", writer.path_of("save.sav"));
+
+    writer.save("save.sav", to_bytes("first"));
+    writer.wait_idle();
+
+    ASSERT_EQ(0u, writer.pending());
+    ASSERT_EQ(1u, writer.written());
+    ASSERT_EQ("first", read_contents(prefs + "save.sav"));
+
+    /* Replacing an existing file */
+    writer.save("save.sav", "second!", 7);
+  }
+
+  ASSERT_EQ("second!", read_contents(prefs + "save.sav"));
+  ASSERT_FALSE(cen::file(prefs + "save.sav.tmp", cen::file_mode::rb));
+
+  const auto first = channel.pop();
+  ASSERT_TRUE(first);
+  ASSERT_EQ("save.sav", first->name);
+  ASSERT_EQ(5u, first->size);
+  ASSERT_TRUE(first->succeeded);
+
+  const auto second = channel.pop();
+  ASSERT_TRUE(second);
+  ASSERT_EQ(7u, second->size);
+  ASSERT_TRUE(second->succeeded);
+
+  ASSERT_FALSE(channel.pop());
+}
+
+TEST_F(SaveWriterTest, Coalescing)
+{
+  cen::event_channel<cen::save_result> channel {64};
+  cen::save_writer writer {channel, prefs};
+
+  for (int index = 0; index < 50; ++index) {
+    writer.save("autosave.sav", to_bytes("autosave " + std::to_string(index)));
+  }
+
+  writer.wait_idle();
+  ASSERT_EQ("autosave 49", read_contents(prefs + "autosave.sav"));
+
+  /* Every save is either written or superseded */
+  cen::usize results = 0;
+  cen::usize coalesced = 0;
+  channel.drain([&](const cen::save_result& result) {
+    ASSERT_TRUE(result.succeeded);
+    ++results;
+    coalesced += result.coalesced;
+  });
+
+  ASSERT_EQ(results, writer.written());
+  ASSERT_EQ(coalesced, writer.coalesced());
+  ASSERT_EQ(50u, results + coalesced);
+}
+
+TEST_F(SaveWriterTest, Failure)
+{
+  cen::event_channel<cen::save_result> channel {2};
+  cen::save_writer writer {channel, prefs + "this_directory_does_not_exist"};
+
+  writer.save("a.sav", to_bytes("a"));
+  writer.wait_idle();
+  writer.save("b.sav", to_bytes("b"));
+  writer.wait_idle();
+  writer.save("c.sav", to_bytes("c"));
+  writer.wait_idle();
+
+  ASSERT_EQ(0u, writer.written());
+  ASSERT_EQ(3u, writer.failed());
+  ASSERT_EQ(1u, writer.dropped());
+
+  const auto result = channel.pop();
+  ASSERT_TRUE(result);
+  ASSERT_EQ("a.sav", result->name);
+  ASSERT_FALSE(result->succeeded);
+}
@@ -0,0 +1,118 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/input/controller_db.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>  // remove
+#include <string>  // string
+
+namespace {
+
+inline constexpr auto db =
+    "# Game Controller DB\r\n"
+    "\r\n"
+    "03000000a,Pad A,a:b0,b:b1,platform:Windows,\r\n"
+    "03000000b,Pad B,a:b0,b:b1,platform:Linux,\r\n"
+    "03000000c,Pad C,a:b0,b:b1,\r\n"
+    "03000000d,Pad D,a:b0,platform:Linux,b:b1,\n"
+    "03000000e,Pad E,a:b0,b:b1,platform:Mac OS X,";
+
+}  // namespace
+
+TEST(ControllerDB, FilterMappings)
+{
+  const auto linuxMappings = cen::detail::filter_controller_mappings(db, "Linux");
+  ASSERT_EQ(
+      "03000000b,Pad B,a:b0,b:b1,platform:Linux,\n"
+      "03000000c,Pad C,a:b0,b:b1,\n"
+      "03000000d,Pad D,a:b0,platform:Linux,b:b1,\n",
+      linuxMappings);
+
+  const auto macMappings = cen::detail::filter_controller_mappings(db, "Mac OS X");
+  ASSERT_EQ(
+      "03000000c,Pad C,a:b0,b:b1,\n"
+      "03000000e,Pad E,a:b0,b:b1,platform:Mac OS X,\n",
+      macMappings);
+
+  ASSERT_TRUE(cen::detail::filter_controller_mappings("# Comment\n\n", "Linux").empty());
+}
+
+TEST(ControllerDB, CacheKey)
+{
+  ASSERT_EQ(cen::detail::controller_db_key(db, "Linux"),
+            cen::detail::controller_db_key(db, "Linux"));
+  ASSERT_NE(cen::detail::controller_db_key(db, "Linux"),
+            cen::detail::controller_db_key(db, "Windows"));
+  ASSERT_NE(cen::detail::controller_db_key(db, "Linux"),
+            cen::detail::controller_db_key("", "Linux"));
+}
+
+TEST(ControllerDB, FromMemory)
+{
+  cen::controller_db_cfg cfg;
+  cfg.platform = "Windows";
+
+  cen::controller_db loader {db, cfg};
+  ASSERT_EQ(
+      "03000000a,Pad A,a:b0,b:b1,platform:Windows,\n"
+      "03000000c,Pad C,a:b0,b:b1,\n",
+      loader.mappings());
+  ASSERT_TRUE(loader.is_ready());
+  ASSERT_FALSE(loader.from_cache());
+}
+
+TEST(ControllerDB, Cache)
+{
+  const std::string path = "controller_db_cache.txt";
+  std::remove(path.c_str());
+
+  cen::controller_db_cfg cfg;
+  cfg.platform = "Linux";
+  cfg.cache_path = path;
+
+  std::string first;
+  {
+    cen::controller_db loader {db, cfg};
+    ASSERT_FALSE(loader.from_cache());
+    first = std::string {loader.mappings()};
+  }
+
+  {
+    cen::controller_db loader {db, cfg};
+    ASSERT_TRUE(loader.from_cache());
+    ASSERT_EQ(first, loader.mappings());
+  }
+
+  /* A different platform doesn't match the cached mappings */
+  cfg.platform = "Windows";
+  {
+    cen::controller_db loader {db, cfg};
+    ASSERT_FALSE(loader.from_cache());
+  }
+
+  std::remove(path.c_str());
+}
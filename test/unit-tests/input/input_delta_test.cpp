@@ -0,0 +1,200 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/input/input_delta.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>  // mt19937, uniform_int_distribution
+#include <vector>  // vector
+
+TEST(InputDeltaEncoder, Constructor)
+{
+  ASSERT_THROW(cen::input_delta_encoder {0}, cen::exception);
+  ASSERT_THROW(cen::input_delta_encoder {17}, cen::exception);
+  ASSERT_THROW(cen::input_delta_decoder {0}, cen::exception);
+
+  ASSERT_EQ(8, cen::input_delta_encoder {}.axis_bits());
+  ASSERT_EQ(16, cen::input_delta_decoder {16}.axis_bits());
+}
+
+TEST(InputDeltaEncoder, IdleTick)
+{
+  cen::input_delta_encoder encoder;
+  std::vector<cen::uint8> buffer;
+
+  ASSERT_EQ(1u, encoder.encode(cen::input_snapshot {}, buffer));
+  ASSERT_EQ(1u, buffer.size());
+  ASSERT_EQ(0u, buffer.front());
+}
+
+TEST(InputDeltaEncoder, RoundTrip)
+{
+  cen::input_delta_encoder encoder;
+  cen::input_delta_decoder decoder;
+  std::vector<cen::uint8> buffer;
+
+  cen::input_snapshot snapshot;
+  snapshot.keys.set(cen::scancodes::w, true);
+  snapshot.keys.set(cen::scancodes::left_shift, true);
+  snapshot.buttons = 0b101;
+  snapshot.axes[0] = 12'345;
+  snapshot.axes[1] = -32'768;
+
+  /* Two keys, a button mask and two axes */
+  const auto size = encoder.encode(snapshot, buffer);
+  ASSERT_LE(size, 12u);
+
+  ASSERT_EQ(size, decoder.decode(buffer.data(), buffer.size()));
+  ASSERT_EQ(encoder.reference(), decoder.current());
+  ASSERT_EQ(snapshot.keys, decoder.current().keys);
+  ASSERT_EQ(snapshot.buttons, decoder.current().buttons);
+
+  /* Axes are quantized to 8 bits */
+  ASSERT_EQ(12'288, decoder.current().axes[0]);
+  ASSERT_EQ(-32'768, decoder.current().axes[1]);
+
+  /* Releasing a key and slightly moving an axis */
+  buffer.clear();
+  snapshot.keys.set(cen::scancodes::w, false);
+  snapshot.axes[0] = 12'300;
+  ASSERT_EQ(3u, encoder.encode(snapshot, buffer));
+
+  ASSERT_EQ(3u, decoder.decode(buffer.data(), buffer.size()));
+  ASSERT_FALSE(decoder.current().keys.is_pressed(cen::scancodes::w));
+  ASSERT_TRUE(decoder.current().keys.is_pressed(cen::scancodes::left_shift));
+  ASSERT_EQ(12'288, decoder.current().axes[0]);
+}
+
+TEST(InputDeltaEncoder, Stream)
+{
+  constexpr int ticks = 500;
+
+  std::mt19937 engine {42};
+  std::uniform_int_distribution<int> key {0, cen::scan_code::count() - 1};
+  std::uniform_int_distribution<int> axis {-32'768, 32'767};
+  std::uniform_int_distribution<int> chance {0, 9};
+
+  cen::input_delta_encoder encoder {10};
+  std::vector<cen::uint8> buffer;
+  std::vector<cen::input_snapshot> expected;
+
+  cen::input_snapshot snapshot;
+  for (int tick = 0; tick < ticks; ++tick) {
+    if (chance(engine) == 0) {
+      const cen::scan_code code {static_cast<SDL_Scancode>(key(engine))};
+      snapshot.keys.set(code, !snapshot.keys.is_pressed(code));
+    }
+
+    if (chance(engine) == 0) {
+      snapshot.buttons ^= 1u << static_cast<unsigned>(chance(engine));
+    }
+
+    if (chance(engine) < 3) {
+      snapshot.axes[static_cast<cen::usize>(chance(engine) % 6)] =
+          static_cast<cen::int16>(axis(engine));
+    }
+
+    encoder.encode(snapshot, buffer);
+    expected.push_back(encoder.reference());
+  }
+
+  /* Idle ticks take a single byte, and each changed part only a few more */
+  ASSERT_LT(buffer.size(), static_cast<cen::usize>(ticks) * 3u);
+
+  cen::input_delta_decoder decoder {10};
+  cen::usize offset = 0;
+
+  for (const auto& reference : expected) {
+    const auto consumed = decoder.decode(buffer.data() + offset, buffer.size() - offset);
+    ASSERT_TRUE(consumed);
+
+    offset += *consumed;
+    ASSERT_EQ(reference, decoder.current());
+  }
+
+  ASSERT_EQ(buffer.size(), offset);
+}
+
+TEST(InputDeltaDecoder, Malformed)
+{
+  cen::input_delta_decoder decoder;
+  ASSERT_FALSE(decoder.decode(nullptr, 0));
+
+  /* Unknown flags */
+  const cen::uint8 flags[] {0x80};
+  ASSERT_FALSE(decoder.decode(flags, sizeof flags));
+
+  /* A key list that is cut short */
+  const cen::uint8 keys[] {0x01, 0x02, 0x04};
+  ASSERT_FALSE(decoder.decode(keys, sizeof keys));
+
+  /* A scan code that is out of range */
+  const cen::uint8 range[] {0x01, 0x01, 0xFF, 0x7F};
+  ASSERT_FALSE(decoder.decode(range, sizeof range));
+
+  /* An axis that is out of range */
+  const cen::uint8 axes[] {0x04, 0x01, 0x80, 0x02};
+  ASSERT_FALSE(decoder.decode(axes, sizeof axes));
+
+  ASSERT_EQ(cen::input_snapshot {}, decoder.current());
+}
+
+TEST(InputHistory, Constructor)
+{
+  ASSERT_THROW(cen::input_history {0}, cen::exception);
+  ASSERT_EQ(4u, cen::input_history {4}.capacity());
+  ASSERT_TRUE(cen::input_history {}.empty());
+}
+
+TEST(InputHistory, PushAndRewind)
+{
+  cen::input_history history {4};
+
+  for (cen::uint64 tick = 10; tick < 16; ++tick) {
+    cen::input_snapshot snapshot;
+    snapshot.buttons = static_cast<cen::uint32>(tick);
+    history.push(tick, snapshot);
+  }
+
+  ASSERT_THROW(history.push(20, {}), cen::exception);
+
+  ASSERT_EQ(4u, history.size());
+  ASSERT_EQ(12u, history.oldest_tick());
+  ASSERT_EQ(15u, history.newest_tick());
+
+  ASSERT_FALSE(history.find(11));
+  ASSERT_FALSE(history.find(16));
+  ASSERT_EQ(13u, history.find(13)->buttons);
+
+  history.rewind(13);
+  ASSERT_EQ(2u, history.size());
+  ASSERT_FALSE(history.contains(14));
+
+  history.push(14, {});
+  ASSERT_EQ(0u, history.find(14)->buttons);
+
+  history.rewind(5);
+  ASSERT_TRUE(history.empty());
+}
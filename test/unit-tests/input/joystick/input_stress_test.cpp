@@ -0,0 +1,157 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/input/input_stress.hpp"
+
+#include <gtest/gtest.h>
+
+#include <utility>  // move
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+
+TEST(StressScript, Add)
+{
+  cen::stress_script script;
+  ASSERT_TRUE(script.empty());
+  ASSERT_EQ(cen::u64ms {0}, script.duration());
+
+  script.add({cen::u64ms {20}, 1, cen::stress_input::button, 2, SDL_PRESSED});
+  script.add({cen::u64ms {10}, 0, cen::stress_input::axis, 0, 100});
+  script.add({cen::u64ms {20}, 0, cen::stress_input::hat, 0, SDL_HAT_UP});
+
+  ASSERT_EQ(3u, script.size());
+  ASSERT_EQ(2u, script.device_count());
+  ASSERT_EQ(cen::u64ms {20}, script.duration());
+
+  const auto& steps = script.steps();
+  ASSERT_EQ(cen::stress_input::axis, steps.at(0).input);
+  ASSERT_EQ(cen::stress_input::button, steps.at(1).input);
+  ASSERT_EQ(cen::stress_input::hat, steps.at(2).input);
+
+  script.clear();
+  ASSERT_TRUE(script.empty());
+  ASSERT_EQ(0u, script.device_count());
+}
+
+TEST(StressScript, Record)
+{
+  cen::stress_script script;
+
+  cen::joy_axis_event axis;
+  axis.set_which(42);
+  axis.set_axis(3);
+  axis.set_value(-1'000);
+
+  cen::joy_button_event button;
+  button.set_which(7);
+  button.set_button(1);
+  button.set_state(cen::button_state::pressed);
+
+  script.record(axis, cen::u64ms {5});
+  script.record(button, cen::u64ms {8});
+  axis.set_value(1'000);
+  script.record(axis, cen::u64ms {9});
+
+  ASSERT_EQ(2u, script.device_count());
+
+  const auto& steps = script.steps();
+  ASSERT_EQ(0u, steps.at(0).device);
+  ASSERT_EQ(3, steps.at(0).index);
+  ASSERT_EQ(-1'000, steps.at(0).value);
+
+  ASSERT_EQ(1u, steps.at(1).device);
+  ASSERT_EQ(cen::stress_input::button, steps.at(1).input);
+  ASSERT_EQ(SDL_PRESSED, steps.at(1).value);
+
+  ASSERT_EQ(0u, steps.at(2).device);
+  ASSERT_EQ(1'000, steps.at(2).value);
+}
+
+TEST(InputStress, Replay)
+{
+  cen::stress_cfg cfg;
+  cfg.devices = 2;
+  cfg.loop = false;
+
+  cen::input_stress stress {cfg};
+  ASSERT_EQ(2u, stress.device_count());
+  ASSERT_TRUE(stress.device_index_of(0));
+  ASSERT_TRUE(stress.device_index_of(1));
+  ASSERT_FALSE(stress.device_index_of(2));
+
+  cen::stress_script script;
+  script.add({cen::u64ms {0}, 0, cen::stress_input::axis, 0, 1'234});
+  script.add({cen::u64ms {10}, 1, cen::stress_input::button, 0, SDL_PRESSED});
+  script.add({cen::u64ms {10}, 5, cen::stress_input::button, 0, SDL_PRESSED});
+  stress.play(std::move(script));
+
+  ASSERT_EQ(1u, stress.update(cen::u64ms {5}));
+  ASSERT_EQ(1u, stress.update(cen::u64ms {5}));
+  ASSERT_EQ(0u, stress.update(cen::u64ms {5}));
+  ASSERT_EQ(2u, stress.changes());
+  ASSERT_EQ(cen::u64ms {15}, stress.clock());
+
+  SDL_JoystickUpdate();
+
+  auto first = cen::joystick_handle::from_id(stress.id_of(0));
+  ASSERT_EQ(1'234, first.query_axis(0));
+
+  auto second = cen::joystick_handle::from_id(stress.id_of(1));
+  ASSERT_EQ(cen::button_state::pressed, second.query_button(0));
+}
+
+TEST(InputStress, Generate)
+{
+  cen::stress_cfg cfg;
+  cfg.devices = 4;
+  cfg.rate = 100;
+
+  const auto count = [&] {
+    cen::input_stress stress {cfg};
+    cen::usize total = 0;
+    for (int frame = 0; frame < 60; ++frame) {
+      total += stress.update(cen::u64ms {16});
+    }
+    return total;
+  };
+
+  /* 4 devices, 100 changes per second, for 0.96 seconds */
+  ASSERT_EQ(384u, count());
+  ASSERT_EQ(count(), count());
+}
+
+TEST(InputStress, DetachOnDestruction)
+{
+  const auto before = SDL_NumJoysticks();
+
+  {
+    cen::input_stress stress;
+    ASSERT_EQ(before + 8, SDL_NumJoysticks());
+  }
+
+  ASSERT_EQ(before, SDL_NumJoysticks());
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
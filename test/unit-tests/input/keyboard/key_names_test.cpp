@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <gtest/gtest.h>
+
+#include <string>  // string
+
+#include "centurion/input/keyboard.hpp"
+
+static_assert(cen::scan_code::from_name("Escape") == cen::scancodes::escape);
+static_assert(cen::key_code::from_name("left shift") == cen::keycodes::left_shift);
+static_assert(cen::key_code::from_name("Q") == cen::keycodes::q);
+static_assert(cen::keycodes::q.name_view() == "Q");
+
+TEST(KeyNames, ScancodeNamesMatchSDL)
+{
+  for (int index = 0; index < cen::scan_code::count(); ++index) {
+    const auto code = static_cast<SDL_Scancode>(index);
+    const std::string expected = SDL_GetScancodeName(code);
+
+    ASSERT_EQ(expected, cen::scan_code {code}.name()) << "index: " << index;
+
+    if (!expected.empty()) {
+      ASSERT_EQ(SDL_GetScancodeFromName(expected.c_str()),
+                cen::scan_code::from_name(expected).get())
+          << "name: " << expected;
+    }
+  }
+}
+
+TEST(KeyNames, KeycodeNamesMatchSDL)
+{
+  for (int index = 0; index < cen::scan_code::count(); ++index) {
+    const auto key = SDL_GetKeyFromScancode(static_cast<SDL_Scancode>(index));
+    const std::string expected = SDL_GetKeyName(key);
+
+    ASSERT_EQ(expected, cen::key_code {static_cast<SDL_KeyCode>(key)}.name())
+        << "key: " << key;
+
+    if (!expected.empty()) {
+      ASSERT_EQ(SDL_GetKeyFromName(expected.c_str()), cen::key_code::from_name(expected).get())
+          << "name: " << expected;
+    }
+  }
+}
+
+TEST(KeyNames, FromName)
+{
+  ASSERT_EQ(cen::scancodes::unknown, cen::scan_code::from_name(""));
+  ASSERT_EQ(cen::scancodes::unknown, cen::scan_code::from_name("foobar"));
+  ASSERT_EQ(SDL_SCANCODE_KP_ENTER, cen::scan_code::from_name("KEYPAD ENTER").get());
+
+  /* The first scan code is used for duplicate names, like in SDL */
+  ASSERT_EQ(SDL_SCANCODE_RETURN, cen::scan_code::from_name("Return").get());
+
+  ASSERT_EQ(cen::keycodes::unknown, cen::key_code::from_name(""));
+  ASSERT_EQ(cen::keycodes::unknown, cen::key_code::from_name("foobar"));
+  ASSERT_EQ(cen::keycodes::a, cen::key_code::from_name("A"));
+  ASSERT_EQ(cen::keycodes::a, cen::key_code::from_name("a"));
+  ASSERT_EQ(cen::keycodes::escape, cen::key_code::from_name("escape"));
+
+  /* Names of single UTF-8 encoded characters are the key codes themselves */
+  ASSERT_EQ(0xE4, cen::key_code::from_name("\xC3\xA4").get());
+}
+
+TEST(KeyNames, NameView)
+{
+  ASSERT_EQ("Space", cen::keycodes::space.name_view());
+  ASSERT_EQ("Left Ctrl", cen::keycodes::left_ctrl.name_view());
+  ASSERT_EQ("", cen::keycodes::unknown.name_view());
+  ASSERT_EQ("", cen::key_code {static_cast<SDL_KeyCode>(0xE4)}.name_view());
+
+  ASSERT_EQ("Keypad 0", cen::scan_code {SDL_SCANCODE_KP_0}.name_view());
+  ASSERT_EQ("", cen::scancodes::unknown.name_view());
+}
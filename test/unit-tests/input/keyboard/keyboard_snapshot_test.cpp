@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/input/keyboard_snapshot.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>   // array
+#include <vector>  // vector
+
+TEST(KeyboardSnapshot, Defaults)
+{
+  const cen::keyboard_snapshot snapshot;
+  ASSERT_TRUE(snapshot.empty());
+  ASSERT_EQ(0u, snapshot.count());
+  ASSERT_FALSE(snapshot.is_pressed(SDL_SCANCODE_A));
+}
+
+TEST(KeyboardSnapshot, From)
+{
+  std::array<cen::uint8, SDL_NUM_SCANCODES> state {};
+  state[SDL_SCANCODE_A] = 1;
+  state[SDL_SCANCODE_RETURN] = 1;
+  state[SDL_NUM_SCANCODES - 1] = 1;
+
+  const auto snapshot = cen::keyboard_snapshot::from(state.data(), cen::isize(state));
+  ASSERT_EQ(3u, snapshot.count());
+  ASSERT_TRUE(snapshot.is_pressed(SDL_SCANCODE_A));
+  ASSERT_TRUE(snapshot.is_pressed(SDL_SCANCODE_RETURN));
+  ASSERT_TRUE(snapshot.is_pressed(static_cast<SDL_Scancode>(SDL_NUM_SCANCODES - 1)));
+  ASSERT_FALSE(snapshot.is_pressed(SDL_SCANCODE_B));
+  ASSERT_FALSE(snapshot.is_pressed(static_cast<SDL_Scancode>(SDL_NUM_SCANCODES)));
+}
+
+TEST(KeyboardSnapshot, Set)
+{
+  cen::keyboard_snapshot snapshot;
+
+  snapshot.set(SDL_SCANCODE_W, true);
+  ASSERT_TRUE(snapshot.is_pressed(SDL_SCANCODE_W));
+
+  snapshot.set(SDL_SCANCODE_W, false);
+  ASSERT_FALSE(snapshot.is_pressed(SDL_SCANCODE_W));
+
+  /* Out-of-bounds scan codes are ignored */
+  snapshot.set(static_cast<SDL_Scancode>(SDL_NUM_SCANCODES), true);
+  ASSERT_TRUE(snapshot.empty());
+}
+
+TEST(KeyboardSnapshot, Edges)
+{
+  cen::keyboard_snapshot previous;
+  previous.set(SDL_SCANCODE_A, true);
+  previous.set(SDL_SCANCODE_S, true);
+
+  cen::keyboard_snapshot current;
+  current.set(SDL_SCANCODE_S, true);
+  current.set(SDL_SCANCODE_D, true);
+
+  const auto pressed = current.pressed_since(previous);
+  ASSERT_EQ(1u, pressed.count());
+  ASSERT_TRUE(pressed.is_pressed(SDL_SCANCODE_D));
+
+  const auto released = current.released_since(previous);
+  ASSERT_EQ(1u, released.count());
+  ASSERT_TRUE(released.is_pressed(SDL_SCANCODE_A));
+
+  const auto changed = current.changed_since(previous);
+  ASSERT_EQ(2u, changed.count());
+  ASSERT_FALSE(changed.is_pressed(SDL_SCANCODE_S));
+}
+
+TEST(KeyboardSnapshot, Each)
+{
+  cen::keyboard_snapshot snapshot;
+  snapshot.set(SDL_SCANCODE_Z, true);
+  snapshot.set(SDL_SCANCODE_A, true);
+  snapshot.set(SDL_SCANCODE_F12, true);
+
+  std::vector<SDL_Scancode> codes;
+  snapshot.each([&](const cen::scan_code code) { codes.push_back(code.get()); });
+
+  const std::vector expected {SDL_SCANCODE_A, SDL_SCANCODE_Z, SDL_SCANCODE_F12};
+  ASSERT_EQ(expected, codes);
+}
+
+TEST(KeyboardSnapshot, Equality)
+{
+  cen::keyboard_snapshot a;
+  cen::keyboard_snapshot b;
+  ASSERT_EQ(a, b);
+
+  a.set(SDL_SCANCODE_Q, true);
+  ASSERT_NE(a, b);
+
+  a.clear();
+  ASSERT_EQ(a, b);
+}
+
+TEST(KeyboardState, Refresh)
+{
+  cen::keyboard_state state;
+
+  cen::keyboard_snapshot first;
+  first.set(SDL_SCANCODE_SPACE, true);
+  state.refresh(first);
+
+  ASSERT_TRUE(state.is_pressed(SDL_SCANCODE_SPACE));
+  ASSERT_TRUE(state.just_pressed(SDL_SCANCODE_SPACE));
+  ASSERT_FALSE(state.is_held(SDL_SCANCODE_SPACE));
+  ASSERT_EQ(1u, state.pressed().count());
+
+  state.refresh(first);
+  ASSERT_TRUE(state.is_held(SDL_SCANCODE_SPACE));
+  ASSERT_FALSE(state.just_pressed(SDL_SCANCODE_SPACE));
+  ASSERT_TRUE(state.pressed().empty());
+
+  state.refresh(cen::keyboard_snapshot {});
+  ASSERT_TRUE(state.just_released(SDL_SCANCODE_SPACE));
+  ASSERT_TRUE(state.released().is_pressed(SDL_SCANCODE_SPACE));
+  ASSERT_EQ(first, state.previous());
+}
@@ -0,0 +1,117 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/input/cursor_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+namespace {
+inline constexpr auto kPath = "resources/panda.png";
+}  // namespace
+
+TEST(CursorCache, Constructor)
+{
+  ASSERT_THROW(cen::cursor_cache {std::vector<float> {}}, cen::exception);
+  ASSERT_THROW(cen::cursor_cache({1.0f, 0.0f}), cen::exception);
+
+  const cen::cursor_cache cache {{2.0f, 1.0f, 2.0f}};
+  ASSERT_EQ(2u, cache.scales().size());
+  ASSERT_EQ(1.0f, cache.scales().front());
+  ASSERT_EQ(2.0f, cache.scales().back());
+  ASSERT_EQ(0u, cache.size());
+  ASSERT_FALSE(cache.is_enabled());
+}
+
+TEST(CursorCache, DisplayScales)
+{
+  const auto scales = cen::cursor_cache::display_scales();
+  ASSERT_FALSE(scales.empty());
+}
+
+TEST(CursorCache, Add)
+{
+  const cen::surface image {kPath};
+  cen::cursor_cache cache {{1.0f, 2.0f}};
+
+  const auto id = cache.add(image, {12, 14});
+  ASSERT_EQ(1u, cache.size());
+  ASSERT_EQ(1u, cache.frame_count(id));
+  ASSERT_EQ(2u, cache.cursor_instances());
+
+  ASSERT_THROW(cache.add_animated(image, {0, 10}, {0, 0}, cen::u64ms {100}), cen::exception);
+  ASSERT_THROW(cache.add_animated(image, {500, 10}, {0, 0}, cen::u64ms {100}),
+               cen::exception);
+}
+
+TEST(CursorCache, Enable)
+{
+  const cen::surface image {kPath};
+  cen::cursor_cache cache {{1.0f, 2.0f}};
+
+  const auto id = cache.add(image, {12, 14});
+  ASSERT_THROW(cache.enable(id + 1), cen::exception);
+
+  cache.enable(id);
+  ASSERT_TRUE(cache.is_enabled());
+  ASSERT_EQ(id, cache.active());
+  ASSERT_EQ(cache.get(id).get(), SDL_GetCursor());
+
+  cache.set_scale(1.8f);
+  ASSERT_EQ(2.0f, cache.scale());
+  ASSERT_EQ(cache.get(id).get(), SDL_GetCursor());
+
+  cache.disable();
+  ASSERT_FALSE(cache.is_enabled());
+  ASSERT_EQ(SDL_GetDefaultCursor(), SDL_GetCursor());
+}
+
+TEST(CursorCache, Animation)
+{
+  const cen::surface sheet {kPath};
+  cen::cursor_cache cache;
+
+  const auto id = cache.add_animated(sheet, {50, 50}, {25, 25}, cen::u64ms {100});
+  ASSERT_EQ(12u, cache.frame_count(id));
+  ASSERT_EQ(12u, cache.cursor_instances());
+  ASSERT_THROW((void) cache.get(id, 12), cen::exception);
+
+  cache.enable(id);
+  ASSERT_EQ(0u, cache.frame());
+
+  cache.update(cen::u64ms {50});
+  ASSERT_EQ(0u, cache.frame());
+
+  cache.update(cen::u64ms {60});
+  ASSERT_EQ(1u, cache.frame());
+  ASSERT_EQ(cache.get(id, 1).get(), SDL_GetCursor());
+
+  cache.update(cen::u64ms {1'100});
+  ASSERT_EQ(0u, cache.frame());
+  ASSERT_EQ(cache.get(id, 0).get(), SDL_GetCursor());
+
+  cache.disable();
+}
@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/input/mouse_history.hpp"
+
+#include <gtest/gtest.h>
+
+namespace {
+
+auto make_motion(const cen::uint32 time, const int x, const int y, const int dx, const int dy)
+    -> cen::mouse_motion_event
+{
+  cen::mouse_motion_event event;
+  event.set_timestamp(cen::u32ms {time});
+  event.set_x(x);
+  event.set_y(y);
+  event.set_dx(dx);
+  event.set_dy(dy);
+  return event;
+}
+
+}  // namespace
+
+TEST(MouseHistory, Defaults)
+{
+  const cen::mouse_history history;
+  ASSERT_TRUE(history.empty());
+  ASSERT_EQ(0u, history.size());
+  ASSERT_EQ(0u, history.frame_size());
+  ASSERT_FALSE(history.latest());
+  ASSERT_EQ(cen::fpoint {}, history.frame_delta());
+}
+
+TEST(MouseHistory, Constructor)
+{
+  ASSERT_THROW(cen::mouse_history {0}, cen::exception);
+  ASSERT_EQ(4u, cen::mouse_history {4}.capacity());
+}
+
+TEST(MouseHistory, Record)
+{
+  cen::mouse_history history {4};
+
+  history.record(make_motion(10, 1, 2, 1, 2));
+  history.record(make_motion(12, 4, 2, 3, 0));
+  ASSERT_EQ(2u, history.size());
+  ASSERT_EQ(2u, history.frame_size());
+  ASSERT_EQ((cen::fpoint {4, 2}), history.latest()->position);
+  ASSERT_EQ((cen::fpoint {4, 2}), history.frame_delta());
+
+  const auto& first = history.at(0);
+  ASSERT_EQ(cen::u32ms {10}, first.time);
+  ASSERT_EQ((cen::fpoint {1, 2}), first.position);
+  ASSERT_EQ((cen::fpoint {1, 2}), first.delta);
+}
+
+TEST(MouseHistory, NewFrame)
+{
+  cen::mouse_history history {4};
+  history.record(make_motion(1, 1, 1, 1, 1));
+
+  history.new_frame();
+  ASSERT_EQ(1u, history.size());
+  ASSERT_EQ(0u, history.frame_size());
+  ASSERT_EQ(cen::fpoint {}, history.frame_delta());
+
+  history.record(make_motion(2, 2, 1, 1, 0));
+  ASSERT_EQ(1u, history.frame_size());
+  ASSERT_EQ(cen::u32ms {2}, history.frame_sample(0).time);
+}
+
+TEST(MouseHistory, Overflow)
+{
+  cen::mouse_history history {3};
+
+  for (cen::uint32 i = 0; i < 5; ++i) {
+    history.record(make_motion(i, static_cast<int>(i), 0, 1, 0));
+  }
+
+  /* The oldest samples are discarded, but still contribute to the frame delta */
+  ASSERT_EQ(3u, history.size());
+  ASSERT_EQ(3u, history.frame_size());
+  ASSERT_EQ(cen::u32ms {2}, history.at(0).time);
+  ASSERT_EQ(cen::u32ms {4}, history.at(2).time);
+  ASSERT_EQ(cen::u32ms {2}, history.frame_sample(0).time);
+  ASSERT_EQ((cen::fpoint {5, 0}), history.frame_delta());
+
+  history.clear();
+  ASSERT_TRUE(history.empty());
+}
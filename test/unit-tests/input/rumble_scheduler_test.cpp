@@ -0,0 +1,98 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/input/rumble_scheduler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+
+#include "centurion/common/literals.hpp"
+
+using namespace cen::literals::time_literals;
+
+TEST(RumbleMix, ToString)
+{
+  ASSERT_THROW(to_string(static_cast<cen::rumble_mix>(100)), cen::exception);
+
+  ASSERT_EQ("max", to_string(cen::rumble_mix::max));
+  ASSERT_EQ("sum", to_string(cen::rumble_mix::sum));
+
+  std::cout << "rumble_mix::sum == " << cen::rumble_mix::sum << '\n';
+}
+
+TEST(RumbleScheduler, Defaults)
+{
+  const cen::rumble_scheduler scheduler;
+  ASSERT_EQ(cen::rumble_mix::max, scheduler.mix());
+  ASSERT_EQ(0u, scheduler.count());
+}
+
+TEST(RumbleScheduler, SetMix)
+{
+  cen::rumble_scheduler scheduler;
+
+  scheduler.set_mix(cen::rumble_mix::sum);
+  ASSERT_EQ(cen::rumble_mix::sum, scheduler.mix());
+}
+
+TEST(RumbleScheduler, AddAndCancel)
+{
+  cen::rumble_scheduler scheduler;
+
+  const auto a = scheduler.add(1, {0xFFFF, 0, 0, 0, 100_ms, 0});
+  const auto b = scheduler.add(1, {0, 0xFFFF, 0, 0, 200_ms, 1});
+  const auto c = scheduler.add(2, {0x8000, 0x8000, 0, 0, 50_ms, 0});
+
+  ASSERT_NE(a, b);
+  ASSERT_NE(b, c);
+
+  ASSERT_EQ(2u, scheduler.count(1));
+  ASSERT_EQ(1u, scheduler.count(2));
+  ASSERT_EQ(0u, scheduler.count(3));
+  ASSERT_EQ(3u, scheduler.count());
+
+  ASSERT_TRUE(scheduler.cancel(b));
+  ASSERT_FALSE(scheduler.cancel(b));
+  ASSERT_EQ(1u, scheduler.count(1));
+
+  scheduler.cancel_all(2);
+  ASSERT_EQ(0u, scheduler.count(2));
+  ASSERT_EQ(1u, scheduler.count());
+
+  scheduler.cancel_all();
+  ASSERT_EQ(0u, scheduler.count());
+}
+
+TEST(RumbleScheduler, UpdateForgetsDisconnectedControllers)
+{
+  cen::rumble_scheduler scheduler;
+
+  scheduler.add(42, {0xFFFF, 0xFFFF, 0, 0, 1'000_ms, 0});
+  ASSERT_EQ(1u, scheduler.count());
+
+  /* No controller with the instance ID is open, so nothing should be sent */
+  ASSERT_EQ(0u, scheduler.update(cen::u64ms {10}));
+  ASSERT_EQ(0u, scheduler.count());
+}
@@ -0,0 +1,126 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/input/sensor_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+TEST(SensorBuffer, Defaults)
+{
+  cen::sensor_buffer buffer;
+  ASSERT_EQ(1024u, buffer.capacity());
+  ASSERT_EQ(0u, buffer.dropped());
+
+  std::vector<cen::sensor_sample> samples;
+  ASSERT_EQ(0u, buffer.take(samples));
+  ASSERT_TRUE(samples.empty());
+}
+
+TEST(SensorBuffer, Record)
+{
+  cen::sensor_buffer buffer;
+
+  SDL_SensorEvent event {};
+  event.type = SDL_SENSORUPDATE;
+  event.timestamp = 10;
+  event.which = 3;
+  event.data[0] = 1.5f;
+  event.data[5] = 2.5f;
+
+  ASSERT_TRUE(buffer.record(event));
+
+  event.timestamp = 11;
+  ASSERT_TRUE(buffer.record(event));
+
+  std::vector<cen::sensor_sample> samples;
+  ASSERT_EQ(2u, buffer.take(samples));
+  ASSERT_EQ(2u, samples.size());
+
+  ASSERT_EQ(3, samples.at(0).which);
+  ASSERT_EQ(cen::u32ms {10}, samples.at(0).time);
+  ASSERT_EQ(cen::u32ms {11}, samples.at(1).time);
+  ASSERT_EQ(1.5f, samples.at(0).data.at(0));
+  ASSERT_EQ(2.5f, samples.at(0).data.at(5));
+
+  /* Samples are only obtained once */
+  ASSERT_EQ(0u, buffer.take(samples));
+  ASSERT_TRUE(samples.empty());
+}
+
+TEST(SensorBuffer, Filter)
+{
+  cen::sensor_buffer buffer {7, 16};
+
+  SDL_SensorEvent event {};
+  event.which = 3;
+  ASSERT_FALSE(buffer.record(event));
+
+  event.which = 7;
+  ASSERT_TRUE(buffer.record(event));
+  ASSERT_EQ(0u, buffer.dropped());
+}
+
+TEST(SensorBuffer, EventWatchCallable)
+{
+  cen::sensor_buffer buffer;
+
+  SDL_Event event {};
+  event.type = SDL_QUIT;
+  buffer(event);
+
+  event.type = SDL_SENSORUPDATE;
+  buffer(event);
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+  event = {};
+  event.type = SDL_CONTROLLERSENSORUPDATE;
+  event.csensor.sensor = SDL_SENSOR_GYRO;
+  event.csensor.data[2] = 4;
+  buffer(event);
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+
+  std::vector<cen::sensor_sample> samples;
+  buffer.take(samples);
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+  ASSERT_EQ(2u, samples.size());
+  ASSERT_EQ(cen::sensor_type::gyroscope, samples.at(1).type);
+  ASSERT_EQ(4, samples.at(1).data.at(2));
+#else
+  ASSERT_EQ(1u, samples.size());
+#endif  // SDL_VERSION_ATLEAST(2, 0, 14)
+}
+
+TEST(SensorBuffer, Overflow)
+{
+  cen::sensor_buffer buffer {2};
+
+  SDL_SensorEvent event {};
+  ASSERT_TRUE(buffer.record(event));
+  ASSERT_TRUE(buffer.record(event));
+  ASSERT_FALSE(buffer.record(event));
+  ASSERT_EQ(1u, buffer.dropped());
+}
@@ -0,0 +1,149 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/input/touch_tracker.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>  // cos, sin
+
+#include "centurion/events/misc_events.hpp"
+
+namespace {
+
+auto make_finger(const cen::event_type type,
+                 const SDL_FingerID id,
+                 const float x,
+                 const float y,
+                 const cen::uint32 time = 0) -> cen::touch_finger_event
+{
+  cen::touch_finger_event event;
+  event.set_type(type);
+  event.set_finger_id(id);
+  event.set_x(x);
+  event.set_y(y);
+  event.set_timestamp(cen::u32ms {time});
+  return event;
+}
+
+}  // namespace
+
+TEST(TouchTracker, Defaults)
+{
+  const cen::touch_tracker tracker;
+  ASSERT_TRUE(tracker.empty());
+  ASSERT_EQ(0u, tracker.count());
+  ASSERT_EQ(1, tracker.pinch());
+  ASSERT_EQ(0, tracker.rotation());
+  ASSERT_EQ(nullptr, tracker.find(0));
+}
+
+TEST(TouchTracker, PressAndRelease)
+{
+  cen::touch_tracker tracker;
+
+  ASSERT_TRUE(tracker.update(make_finger(cen::event_type::finger_down, 1, 0.2f, 0.2f)));
+  ASSERT_TRUE(tracker.update(make_finger(cen::event_type::finger_down, 2, 0.4f, 0.6f)));
+  ASSERT_EQ(2u, tracker.count());
+
+  const auto* finger = tracker.find(2);
+  ASSERT_NE(nullptr, finger);
+  ASSERT_EQ((cen::fpoint {0.4f, 0.6f}), finger->position);
+  ASSERT_EQ(finger->position, finger->start);
+
+  const auto centroid = tracker.centroid();
+  ASSERT_FLOAT_EQ(0.3f, centroid.x());
+  ASSERT_FLOAT_EQ(0.4f, centroid.y());
+
+  ASSERT_TRUE(tracker.update(make_finger(cen::event_type::finger_up, 1, 0.2f, 0.2f)));
+  ASSERT_EQ(1u, tracker.count());
+  ASSERT_EQ(nullptr, tracker.find(1));
+  ASSERT_EQ(2, tracker.at(0).id);
+
+  ASSERT_FALSE(tracker.update(make_finger(cen::event_type::quit, 3, 0, 0)));
+}
+
+TEST(TouchTracker, Capacity)
+{
+  cen::touch_tracker tracker;
+
+  for (SDL_FingerID id = 0; id < SDL_FingerID {cen::touch_tracker::max_fingers}; ++id) {
+    ASSERT_TRUE(tracker.update(make_finger(cen::event_type::finger_down, id, 0, 0)));
+  }
+
+  ASSERT_FALSE(tracker.update(make_finger(cen::event_type::finger_down, 42, 0, 0)));
+  ASSERT_EQ(cen::touch_tracker::max_fingers, tracker.count());
+
+  tracker.clear();
+  ASSERT_TRUE(tracker.empty());
+}
+
+TEST(TouchTracker, Velocity)
+{
+  cen::touch_tracker tracker;
+  tracker.update(make_finger(cen::event_type::finger_down, 1, 0.5f, 0.5f, 0));
+  tracker.update(make_finger(cen::event_type::finger_motion, 1, 0.6f, 0.5f, 100));
+
+  const auto& finger = tracker.at(0);
+  ASSERT_FLOAT_EQ(0.5f, finger.velocity.x());
+  ASSERT_FLOAT_EQ(0, finger.velocity.y());
+  ASSERT_EQ(cen::u32ms {100}, finger.last_time);
+}
+
+TEST(TouchTracker, Pinch)
+{
+  cen::touch_tracker tracker;
+  tracker.update(make_finger(cen::event_type::finger_down, 1, 0.4f, 0.5f));
+  tracker.update(make_finger(cen::event_type::finger_down, 2, 0.6f, 0.5f));
+
+  tracker.new_frame();
+  tracker.update(make_finger(cen::event_type::finger_motion, 1, 0.3f, 0.5f));
+  tracker.update(make_finger(cen::event_type::finger_motion, 2, 0.7f, 0.5f));
+
+  ASSERT_NEAR(2.0f, tracker.pinch(), 0.001f);
+  ASSERT_NEAR(0.0f, tracker.rotation(), 0.001f);
+
+  tracker.new_frame();
+  ASSERT_EQ(1, tracker.pinch());
+}
+
+TEST(TouchTracker, Rotation)
+{
+  cen::touch_tracker tracker;
+  tracker.update(make_finger(cen::event_type::finger_down, 1, 0.4f, 0.5f));
+  tracker.update(make_finger(cen::event_type::finger_down, 2, 0.6f, 0.5f));
+
+  /* Rotate both fingers a quarter turn around the centroid, in small steps */
+  constexpr int steps = 20;
+  for (int step = 1; step <= steps; ++step) {
+    const auto angle = 1.5708f * static_cast<float>(step) / steps;
+    const auto dx = 0.1f * std::cos(angle);
+    const auto dy = 0.1f * std::sin(angle);
+    tracker.update(make_finger(cen::event_type::finger_motion, 1, 0.5f - dx, 0.5f - dy));
+    tracker.update(make_finger(cen::event_type::finger_motion, 2, 0.5f + dx, 0.5f + dy));
+  }
+
+  ASSERT_NEAR(1.5708f, tracker.rotation(), 0.01f);
+  ASSERT_NEAR(1.0f, tracker.pinch(), 0.01f);
+}
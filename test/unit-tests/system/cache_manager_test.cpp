@@ -0,0 +1,226 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/system/cache_manager.hpp"
+
+#include <gtest/gtest.h>
+
+#include <type_traits>  // ...
+#include <vector>       // vector
+
+namespace {
+
+/* A cache of fixed-size entries, ordered from least to most recently used */
+struct fake_cache final {
+  std::vector<cen::uint64> stamps;
+  cen::usize entry_size {100};
+  cen::usize pinned {};  ///< The amount of entries that cannot be evicted.
+
+  void use() { stamps.push_back(cen::cache_manager::tick()); }
+
+  [[nodiscard]] auto memory_usage() const noexcept -> cen::usize
+  {
+    return stamps.size() * entry_size;
+  }
+
+  [[nodiscard]] auto oldest_use() const -> cen::maybe<cen::uint64>
+  {
+    if (stamps.size() > pinned) {
+      return stamps[pinned];
+    }
+    else {
+      return cen::nothing;
+    }
+  }
+
+  auto evict_oldest() -> bool
+  {
+    if (stamps.size() > pinned) {
+      stamps.erase(stamps.begin() + static_cast<std::ptrdiff_t>(pinned));
+      return true;
+    }
+    else {
+      return false;
+    }
+  }
+};
+
+}  // namespace
+
+static_assert(std::is_final_v<cen::cache_manager>);
+static_assert(!std::is_copy_constructible_v<cen::cache_manager>);
+static_assert(!std::is_move_constructible_v<cen::cache_manager>);
+
+TEST(CacheManager, Defaults)
+{
+  const cen::cache_manager manager;
+  ASSERT_EQ(0u, manager.size());
+  ASSERT_EQ(0u, manager.memory_usage());
+  ASSERT_EQ(0u, manager.evictions());
+  ASSERT_TRUE(manager.is_watching_events());
+  ASSERT_EQ(cen::cache_manager::default_budget(), manager.budget());
+  ASSERT_GT(manager.budget(), 0u);
+
+  cen::cache_manager_options options;
+  options.budget = 1'000;
+  options.watch_events = false;
+
+  const cen::cache_manager configured {options};
+  ASSERT_EQ(1'000u, configured.budget());
+  ASSERT_FALSE(configured.is_watching_events());
+}
+
+TEST(CacheManager, Tick)
+{
+  const auto first = cen::cache_manager::tick();
+  const auto second = cen::cache_manager::tick();
+  ASSERT_LT(first, second);
+}
+
+TEST(CacheManager, AddAndRemove)
+{
+  fake_cache fonts;
+  fake_cache sounds;
+  fonts.use();
+  sounds.use();
+  sounds.use();
+
+  cen::cache_manager manager;
+  const auto fontsId = manager.add(fonts, "fonts");
+  const auto soundsId = manager.add(sounds, "sounds");
+  ASSERT_NE(fontsId, soundsId);
+  ASSERT_EQ(2u, manager.size());
+  ASSERT_EQ(300u, manager.memory_usage());
+
+  const auto caches = manager.caches();
+  ASSERT_EQ(2u, caches.size());
+  ASSERT_EQ("fonts", caches.at(0).name);
+  ASSERT_EQ(100u, caches.at(0).bytes);
+  ASSERT_EQ(soundsId, caches.at(1).id);
+  ASSERT_EQ(200u, caches.at(1).bytes);
+
+  ASSERT_TRUE(manager.remove(fontsId));
+  ASSERT_FALSE(manager.remove(fontsId));
+  ASSERT_EQ(200u, manager.memory_usage());
+}
+
+TEST(CacheManager, TrimAcrossCaches)
+{
+  fake_cache a;
+  fake_cache b;
+
+  /* The entries are used in the order a, b, a, b, a, b */
+  for (int i = 0; i < 3; ++i) {
+    a.use();
+    b.use();
+  }
+
+  cen::cache_manager_options options;
+  options.budget = 300;
+  options.watch_events = false;
+
+  cen::cache_manager manager {options};
+  manager.add(a);
+  manager.add(b);
+
+  ASSERT_EQ(300u, manager.update());
+  ASSERT_EQ(300u, manager.memory_usage());
+  ASSERT_EQ(3u, manager.evictions());
+
+  /* The three least recently used entries were a, b and a */
+  ASSERT_EQ(1u, a.stamps.size());
+  ASSERT_EQ(2u, b.stamps.size());
+  ASSERT_LT(b.stamps.front(), a.stamps.front());
+
+  ASSERT_EQ(0u, manager.update());
+}
+
+TEST(CacheManager, PinnedEntries)
+{
+  fake_cache cache;
+  cache.use();
+  cache.use();
+  cache.use();
+  cache.pinned = 2;
+
+  cen::cache_manager_options options;
+  options.watch_events = false;
+
+  cen::cache_manager manager {options};
+  manager.add(cache);
+
+  ASSERT_EQ(100u, manager.trim(0));
+  ASSERT_EQ(200u, manager.memory_usage());
+  ASSERT_EQ(0u, manager.trim(0));
+}
+
+TEST(CacheManager, LowMemory)
+{
+  fake_cache cache;
+  for (int i = 0; i < 10; ++i) {
+    cache.use();
+  }
+
+  cen::cache_manager_options options;
+  options.budget = 1'000;
+  options.low_memory_fraction = 0.3;
+  options.watch_events = false;
+
+  cen::cache_manager manager {options};
+  manager.add(cache);
+
+  ASSERT_EQ(0u, manager.update());
+  ASSERT_EQ(700u, manager.trim_for_low_memory());
+  ASSERT_EQ(3u, cache.stamps.size());
+}
+
+TEST(CacheManager, Events)
+{
+  fake_cache cache;
+  for (int i = 0; i < 10; ++i) {
+    cache.use();
+  }
+
+  cen::cache_manager_options options;
+  options.budget = 1'000;
+  options.low_memory_fraction = 0.5;
+
+  cen::cache_manager manager {options};
+  manager.add(cache);
+
+  SDL_Event event {};
+  event.type = SDL_APP_LOWMEMORY;
+  SDL_PushEvent(&event);
+
+  ASSERT_EQ(500u, manager.update());
+  ASSERT_EQ(5u, cache.stamps.size());
+
+  event.type = SDL_APP_WILLENTERBACKGROUND;
+  SDL_PushEvent(&event);
+
+  ASSERT_EQ(500u, manager.update());
+  ASSERT_TRUE(cache.stamps.empty());
+
+  SDL_FlushEvents(SDL_APP_LOWMEMORY, SDL_APP_WILLENTERBACKGROUND);
+}
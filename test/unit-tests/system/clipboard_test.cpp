@@ -44,3 +44,27 @@ TEST(Clipboard, SetClipboard)
   ASSERT_TRUE(cen::set_clipboard("bar"s));
   ASSERT_EQ(cen::get_clipboard(), "bar");
 }
+
+TEST(Clipboard, ClipboardCache)
+{
+  ASSERT_TRUE(cen::set_clipboard("foo"));
+
+  cen::clipboard_cache cache;
+  ASSERT_TRUE(cache.has_text());
+  ASSERT_EQ("foo", cache.text());
+  ASSERT_EQ(1u, cache.generation());
+
+  /* External changes are only observed after update events */
+  ASSERT_TRUE(cen::set_clipboard("bar"));
+  ASSERT_FALSE(cache.update(cen::event_type::key_down));
+  ASSERT_EQ("foo", cache.text());
+
+  ASSERT_TRUE(cache.update(cen::event_type::clipboard_update));
+  ASSERT_EQ("bar", cache.text());
+  ASSERT_EQ(2u, cache.generation());
+
+  ASSERT_TRUE(cache.set("foobar"));
+  ASSERT_EQ("foobar", cache.text());
+  ASSERT_EQ("foobar", cen::get_clipboard());
+  ASSERT_EQ(3u, cache.generation());
+}
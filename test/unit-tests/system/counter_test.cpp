@@ -54,3 +54,65 @@ TEST(Counter, Ticks64)
 }
 
 #endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+TEST(Stopwatch, Defaults)
+{
+  const cen::stopwatch started;
+  ASSERT_TRUE(started.is_running());
+
+  const cen::stopwatch stopped {false};
+  ASSERT_FALSE(stopped.is_running());
+  ASSERT_EQ(0u, stopped.elapsed_ticks());
+  ASSERT_EQ(cen::stopwatch::duration::zero(), stopped.elapsed());
+}
+
+TEST(Stopwatch, Accumulate)
+{
+  cen::stopwatch stopwatch;
+  SDL_Delay(5);
+  stopwatch.stop();
+
+  const auto first = stopwatch.elapsed();
+  ASSERT_GE(first, std::chrono::milliseconds {4});
+
+  SDL_Delay(5);
+  ASSERT_EQ(first, stopwatch.elapsed()); /* Stopped stopwatches don't accumulate time */
+
+  stopwatch.start();
+  SDL_Delay(5);
+  ASSERT_GT(stopwatch.elapsed(), first);
+  ASSERT_GE(stopwatch.elapsed<cen::millis<double>>().count(), 8.0);
+
+  stopwatch.reset();
+  ASSERT_FALSE(stopwatch.is_running());
+  ASSERT_EQ(0u, stopwatch.elapsed_ticks());
+}
+
+TEST(Stopwatch, LapAndSplit)
+{
+  cen::stopwatch stopwatch;
+  SDL_Delay(5);
+
+  const auto split = stopwatch.split();
+  const auto first = stopwatch.lap();
+  ASSERT_GE(first, split);
+  ASSERT_GE(first, std::chrono::milliseconds {4});
+
+  /* A new lap was started, so the split is reset */
+  ASSERT_LT(stopwatch.split(), first);
+
+  SDL_Delay(5);
+  const auto second = stopwatch.lap();
+  ASSERT_GE(stopwatch.elapsed(), first + second);
+}
+
+TEST(Stopwatch, Restart)
+{
+  cen::stopwatch stopwatch;
+  SDL_Delay(5);
+
+  const auto elapsed = stopwatch.restart();
+  ASSERT_GE(elapsed, std::chrono::milliseconds {4});
+  ASSERT_TRUE(stopwatch.is_running());
+  ASSERT_LT(stopwatch.elapsed(), elapsed);
+}
@@ -0,0 +1,52 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/system/cpu.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // is_sorted, adjacent_find
+
+TEST(CPU, LogicalCount)
+{
+  ASSERT_GE(cen::logical_cpu_count(), 1);
+  ASSERT_EQ(cen::logical_cpu_count(), SDL_GetCPUCount());
+}
+
+TEST(CPU, PhysicalCores)
+{
+  const auto cpus = cen::physical_core_cpus();
+
+  ASSERT_FALSE(cpus.empty());
+  ASSERT_LE(static_cast<int>(cpus.size()), cen::logical_cpu_count());
+  ASSERT_EQ(cen::physical_core_count(), static_cast<int>(cpus.size()));
+
+  ASSERT_TRUE(std::is_sorted(cpus.begin(), cpus.end()));
+  ASSERT_EQ(std::adjacent_find(cpus.begin(), cpus.end()), cpus.end());
+
+  for (const auto cpu : cpus) {
+    ASSERT_GE(cpu, 0);
+    ASSERT_LT(cpu, cen::logical_cpu_count());
+  }
+}
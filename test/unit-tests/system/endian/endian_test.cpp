@@ -26,6 +26,42 @@
 
 #include <gtest/gtest.h>
 
+#include <vector>  // vector
+
+namespace {
+
+template <typename T>
+void test_bulk_swap()
+{
+  /* Odd sizes exercise both the vectorized and the scalar paths */
+  for (const auto size : {0u, 1u, 7u, 16u, 33u}) {
+    std::vector<T> values(size);
+    for (unsigned index = 0; index < size; ++index) {
+      values[index] = static_cast<T>((index + 1) * 0x01020304u);
+    }
+
+    auto swapped = values;
+    cen::swap_byte_order(swapped.data(), swapped.size());
+
+    for (unsigned index = 0; index < size; ++index) {
+      ASSERT_EQ(cen::swap_byte_order(values[index]), swapped[index]);
+    }
+
+    auto little = values;
+    cen::swap_little_endian(little.data(), little.size());
+
+    auto big = values;
+    cen::swap_big_endian(big.data(), big.size());
+
+    for (unsigned index = 0; index < size; ++index) {
+      ASSERT_EQ(cen::swap_little_endian(values[index]), little[index]);
+      ASSERT_EQ(cen::swap_big_endian(values[index]), big[index]);
+    }
+  }
+}
+
+}  // namespace
+
 TEST(Endian, IsLittleEndian)
 {
   ASSERT_EQ(SDL_BYTEORDER == SDL_LIL_ENDIAN, cen::is_little_endian());
@@ -106,4 +142,41 @@ TEST(Endian, SwapBigEndianFloat)
 {
   const float source = 123.4f;
   ASSERT_EQ(SDL_SwapFloatBE(source), cen::swap_big_endian(source));
-}
\ No newline at end of file
+}
+TEST(Endian, BulkSwapU16)
+{
+  test_bulk_swap<Uint16>();
+}
+
+TEST(Endian, BulkSwapU32)
+{
+  test_bulk_swap<Uint32>();
+}
+
+TEST(Endian, BulkSwapU64)
+{
+  test_bulk_swap<Uint64>();
+}
+
+TEST(Endian, BulkSwapSigned)
+{
+  std::vector<Sint32> values {-1, 1, 0x12345678};
+  cen::swap_byte_order(values.data(), values.size());
+
+  ASSERT_EQ(-1, values.at(0));
+  ASSERT_EQ(0x01000000, values.at(1));
+  ASSERT_EQ(0x78563412, values.at(2));
+}
+
+#if CENTURION_HAS_FEATURE_SPAN
+
+TEST(Endian, BulkSwapSpan)
+{
+  std::vector<Uint16> values {0x1234, 0x5678};
+  cen::swap_byte_order(std::span {values});
+
+  ASSERT_EQ(0x3412, values.at(0));
+  ASSERT_EQ(0x7856, values.at(1));
+}
+
+#endif  // CENTURION_HAS_FEATURE_SPAN
@@ -44,4 +44,18 @@ TEST(Locale, GetPreferred)
   }
 }
 
+TEST(Locale, LocaleCache)
+{
+  cen::locale_cache cache;
+  ASSERT_EQ(1u, cache.generation());
+  ASSERT_EQ(cen::locale::get_preferred().size(), cache.get().size());
+
+  ASSERT_FALSE(cache.update(cen::event_type::quit));
+  ASSERT_EQ(1u, cache.generation());
+
+  ASSERT_TRUE(cache.update(cen::event_type::locale_changed));
+  ASSERT_EQ(2u, cache.generation());
+  ASSERT_FALSE(cache.has_language("foo", "bar"));
+}
+
 #endif  // SDL_VERSION_ATLEAST(2, 0, 14)
\ No newline at end of file
@@ -0,0 +1,84 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/system/periodic_timer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+
+TEST(PeriodicTimer, Fire)
+{
+  cen::event_channel<cen::timer_event> channel;
+  const cen::periodic_timer timer {channel, cen::u32ms {1}};
+
+  ASSERT_NE(0, timer.id());
+  ASSERT_EQ(cen::u32ms {1}, timer.interval());
+
+  cen::uint64 received {};
+  for (int attempt = 0; attempt < 500 && received < 3; ++attempt) {
+    SDL_Delay(1);
+    channel.drain([&](cen::timer_event&& event) {
+      ASSERT_EQ(timer.id(), event.id);
+      ASSERT_EQ(++received, event.count);
+    });
+  }
+
+  ASSERT_GE(received, 3u);
+  ASSERT_GE(timer.fired(), received);
+  ASSERT_EQ(0u, timer.dropped());
+}
+
+TEST(PeriodicTimer, Destroy)
+{
+  cen::event_channel<cen::timer_event> channel;
+
+  {
+    const cen::periodic_timer timer {channel, cen::u32ms {1}};
+    SDL_Delay(5);
+  }
+
+  channel.drain([](cen::timer_event&&) {});
+
+  /* No events are emitted after the timer has been destroyed */
+  SDL_Delay(5);
+  ASSERT_FALSE(channel.pop().has_value());
+}
+
+TEST(PeriodicTimer, SetInterval)
+{
+  cen::event_channel<cen::timer_event> channel;
+  cen::periodic_timer timer {channel, cen::u32ms {1'000}};
+
+  timer.set_interval(cen::u32ms {10});
+  ASSERT_EQ(cen::u32ms {10}, timer.interval());
+}
+
+TEST(PeriodicTimer, StreamOperator)
+{
+  cen::event_channel<cen::timer_event> channel;
+  const cen::periodic_timer timer {channel, cen::u32ms {1'000}};
+  std::cout << timer << '\n';
+}
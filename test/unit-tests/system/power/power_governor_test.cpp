@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/system/power_governor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+
+TEST(PowerGovernor, Classify)
+{
+  const cen::power_governor_options options;
+
+  cen::power_info info;
+  ASSERT_EQ(cen::power_profile::full, cen::power_governor::classify(info, options));
+
+  info.state = cen::power_state::charging;
+  info.percentage = 5;
+  ASSERT_EQ(cen::power_profile::full, cen::power_governor::classify(info, options));
+
+  info.state = cen::power_state::on_battery;
+  ASSERT_EQ(cen::power_profile::low_battery, cen::power_governor::classify(info, options));
+
+  info.percentage = 80;
+  ASSERT_EQ(cen::power_profile::battery, cen::power_governor::classify(info, options));
+
+  info.percentage.reset();
+  ASSERT_EQ(cen::power_profile::battery, cen::power_governor::classify(info, options));
+}
+
+TEST(PowerGovernor, SetProfile)
+{
+  cen::frame_pacer_options pacerOptions;
+  pacerOptions.refresh_rate = 144;
+
+  cen::frame_pacer pacer {pacerOptions};
+  cen::thread_pool pool {8};
+
+  cen::power_governor governor;
+  governor.set_profile(cen::power_profile::full);
+  governor.attach(pacer);
+  governor.attach(pool);
+
+  ASSERT_FALSE(governor.prefers_cached_rendering());
+  ASSERT_EQ(144.0, pacer.refresh_rate());
+  ASSERT_EQ(8u, pool.active_workers());
+
+  ASSERT_TRUE(governor.set_profile(cen::power_profile::battery));
+  ASSERT_FALSE(governor.set_profile(cen::power_profile::battery));
+  ASSERT_TRUE(governor.prefers_cached_rendering());
+  ASSERT_EQ(30.0, pacer.refresh_rate());
+  ASSERT_EQ(4u, pool.active_workers());
+
+  ASSERT_TRUE(governor.set_profile(cen::power_profile::low_battery));
+  ASSERT_EQ(20.0, pacer.refresh_rate());
+  ASSERT_EQ(2u, pool.active_workers());
+
+  ASSERT_TRUE(governor.set_profile(cen::power_profile::full));
+  ASSERT_EQ(144.0, pacer.refresh_rate());
+  ASSERT_EQ(8u, pool.active_workers());
+
+  governor.set_profile(cen::power_profile::low_battery);
+  governor.detach();
+  ASSERT_EQ(144.0, pacer.refresh_rate());
+  ASSERT_EQ(8u, pool.active_workers());
+}
+
+TEST(PowerGovernor, WorkerCount)
+{
+  cen::power_governor governor;
+
+  governor.set_profile(cen::power_profile::low_battery);
+  ASSERT_EQ(1u, governor.worker_count(1));
+  ASSERT_EQ(1u, governor.worker_count(2));
+  ASSERT_EQ(3u, governor.worker_count(12));
+
+  governor.set_profile(cen::power_profile::full);
+  ASSERT_EQ(12u, governor.worker_count(12));
+}
+
+TEST(PowerGovernor, ToString)
+{
+  ASSERT_THROW(to_string(static_cast<cen::power_profile>(3)), cen::exception);
+
+  ASSERT_EQ("full", to_string(cen::power_profile::full));
+  ASSERT_EQ("battery", to_string(cen::power_profile::battery));
+  ASSERT_EQ("low_battery", to_string(cen::power_profile::low_battery));
+
+  std::cout << "power_profile::battery == " << cen::power_profile::battery << '\n';
+}
@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/system/profiler.hpp"
+
+#include <gtest/gtest.h>
+
+#include <sstream>  // stringstream
+#include <string>   // string
+#include <thread>   // thread
+
+class ProfilerTest : public testing::Test {
+ protected:
+  void SetUp() override { (void) cen::collect_profile(); }
+
+  void TearDown() override { cen::disable_profiling(); }
+};
+
+TEST_F(ProfilerTest, Disabled)
+{
+  ASSERT_FALSE(cen::is_profiling());
+
+  {
+    const cen::profile_zone zone {"disabled"};
+  }
+
+  cen::mark_profile_frame();
+  ASSERT_TRUE(cen::collect_profile().empty());
+}
+
+TEST_F(ProfilerTest, Zones)
+{
+  cen::enable_profiling();
+  ASSERT_TRUE(cen::is_profiling());
+
+  {
+    const cen::profile_zone outer {"outer"};
+    const cen::profile_zone inner {"inner"};
+  }
+
+  cen::mark_profile_frame();
+
+  const auto events = cen::collect_profile();
+  ASSERT_EQ(3u, events.size());
+
+  // Events are sorted by their start time, and zones are recorded when they end
+  ASSERT_STREQ("outer", events.at(0).name);
+  ASSERT_STREQ("inner", events.at(1).name);
+  ASSERT_STREQ("frame", events.at(2).name);
+
+  ASSERT_EQ(cen::profile_event_kind::zone, events.at(0).kind);
+  ASSERT_EQ(cen::profile_event_kind::frame, events.at(2).kind);
+  ASSERT_LE(events.at(0).begin, events.at(1).begin);
+  ASSERT_GE(events.at(0).end, events.at(1).end);
+  ASSERT_EQ(events.at(2).begin, events.at(2).end);
+
+  // Collecting removes the events
+  ASSERT_TRUE(cen::collect_profile().empty());
+}
+
+TEST_F(ProfilerTest, Threads)
+{
+  cen::enable_profiling();
+
+  std::thread worker {[] { const cen::profile_zone zone {"worker"}; }};
+  worker.join();
+
+  {
+    const cen::profile_zone zone {"main"};
+  }
+
+  const auto events = cen::collect_profile();
+  ASSERT_EQ(2u, events.size());
+  ASSERT_NE(events.at(0).thread, events.at(1).thread);
+}
+
+TEST_F(ProfilerTest, ChromeTrace)
+{
+  cen::enable_profiling();
+
+  {
+    CENTURION_PROFILE_SCOPE("macro");
+    const cen::profile_zone zone {"quote\"d"};
+  }
+
+  cen::mark_profile_frame("present");
+
+  std::stringstream stream;
+  cen::write_chrome_trace(stream, cen::collect_profile());
+
+  const auto json = stream.str();
+  ASSERT_EQ(0u, json.find("{\"traceEvents\":["));
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"quote\\\"d\",\"ph\":\"X\""));
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"present\",\"ph\":\"i\""));
+
+#ifdef CENTURION_ENABLE_PROFILING
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"macro\""));
+#else
+  ASSERT_EQ(std::string::npos, json.find("\"name\":\"macro\""));
+#endif  // CENTURION_ENABLE_PROFILING
+}
+
+TEST_F(ProfilerTest, GpuZones)
+{
+  cen::record_gpu_profile_zone("disabled", 1, 2);
+  ASSERT_TRUE(cen::collect_profile().empty());
+
+  cen::enable_profiling();
+
+  const auto now = cen::now();
+  cen::record_gpu_profile_zone("shadows", now, now + cen::frequency() / 1'000);
+
+  std::stringstream stream;
+  cen::write_chrome_trace(stream, cen::collect_profile());
+
+  // GPU passes are written as a separate process
+  const auto json = stream.str();
+  ASSERT_NE(std::string::npos, json.find("\"args\":{\"name\":\"GPU\"}"));
+  ASSERT_NE(std::string::npos, json.find("\"name\":\"shadows\",\"ph\":\"X\""));
+  ASSERT_NE(std::string::npos, json.find("\"pid\":2,\"tid\":0"));
+}
@@ -70,10 +70,71 @@ TEST(FontBundle, Usage)
   ASSERT_THROW(bundle.at(c, 10), cen::exception);
 }
 
+TEST(FontBundle, Find)
+{
+  cen::experimental::font_bundle bundle;
+  const auto id = bundle.load_font("resources/daniel.ttf", 12);
+
+  ASSERT_EQ(&bundle.at(id, 12), bundle.find(id, 12));
+  ASSERT_EQ(&bundle.get_font(id, 12), bundle.find_font(id, 12));
+
+  ASSERT_FALSE(bundle.find(id, 13));
+  ASSERT_FALSE(bundle.find(id + 1, 12));
+  ASSERT_FALSE(bundle.find_font(id, 13));
+
+  const auto& ref = bundle;
+  ASSERT_EQ(&ref.at(id, 12), ref.find(id, 12));
+  ASSERT_FALSE(ref.find_font(id + 1, 12));
+  ASSERT_THROW((void) ref.at(id + 1, 12), cen::exception);
+}
+
 TEST(FontBundle, ToString)
 {
   cen::experimental::font_bundle bundle;
   bundle.load_font("resources/daniel.ttf", 12);
   bundle.load_font("resources/daniel.ttf", 16);
   ASSERT_EQ("font_bundle(#pools: 1, #fonts: 2)", to_string(bundle));
-}
\ No newline at end of file
+}
+
+TEST(FontBundle, Fallback)
+{
+  cen::experimental::font_bundle bundle;
+
+  const auto daniel = bundle.load_font("resources/daniel.ttf", 12);
+  const auto mono = bundle.load_font("resources/jetbrains_mono.ttf", 12);
+
+  ASSERT_ANY_THROW(bundle.add_fallback(daniel, daniel));
+  ASSERT_ANY_THROW(bundle.add_fallback(daniel, 42));
+  ASSERT_ANY_THROW(bundle.add_fallback(42, mono));
+
+  bundle.add_fallback(daniel, mono);
+  ASSERT_EQ(1u, bundle.at(daniel, 12).fallback_count());
+  ASSERT_EQ(0u, bundle.at(mono, 12).fallback_count());
+
+  /* Sizes that are loaded later get the same fallbacks */
+  bundle.load_font("resources/daniel.ttf", 16);
+
+  const auto& cache = bundle.at(daniel, 16);
+  ASSERT_EQ(1u, cache.fallback_count());
+  ASSERT_EQ(16, cache.get_fallback(0).size());
+  ASSERT_EQ(&cache.get_fallback(0), cache.resolve_font(0x100));
+}
+
+TEST(FontBundle, SharedFileData)
+{
+  cen::experimental::font_bundle bundle;
+
+  const auto id = bundle.load_font("resources/daniel.ttf", 8);
+  for (int size = 9; size <= 14; ++size) {
+    ASSERT_EQ(id, bundle.load_font("resources/daniel.ttf", size));
+  }
+
+  ASSERT_EQ(7, bundle.font_count());
+  ASSERT_EQ(1, bundle.pool_count());
+
+  for (int size = 8; size <= 14; ++size) {
+    const auto& font = bundle.get_font(id, size);
+    ASSERT_EQ(size, font.size());
+    ASSERT_STREQ("Daniel", font.family_name());
+  }
+}
@@ -28,6 +28,8 @@
 
 #include <memory>  // unique_ptr
 
+#include "centurion/concurrency/thread_pool.hpp"
+#include "centurion/io/paths.hpp"
 #include "centurion/video/renderer.hpp"
 #include "centurion/video/window.hpp"
 
@@ -202,6 +204,80 @@ TEST_F(FontCacheTest, FindGlyph)
   ASSERT_FALSE(mCache.find_glyph(0x7F));
 }
 
+TEST_F(FontCacheTest, Atlas)
+{
+  ASSERT_FALSE(mCache.is_atlas_enabled());
+
+  mCache.enable_atlas({256, 256});
+  ASSERT_TRUE(mCache.is_atlas_enabled());
+  ASSERT_EQ(0u, mCache.atlas_page_count());
+
+  mCache.store_basic_latin_glyphs(*mRenderer);
+  ASSERT_TRUE(mCache.has_glyph('a'));
+  ASSERT_FALSE(mCache.find_glyph('a'));
+  ASSERT_GE(mCache.atlas_page_count(), 1u);
+
+  const auto* a = mCache.find_atlas_glyph('a');
+  const auto* b = mCache.find_atlas_glyph('b');
+  ASSERT_TRUE(a);
+  ASSERT_TRUE(b);
+  ASSERT_FALSE(cen::overlaps(a->source, b->source));
+  ASSERT_EQ(mCache.get_font().get_metrics('a')->advance, a->metrics.advance);
+
+  ASSERT_NO_THROW(mCache.render_text(*mRenderer, kUnicodeString, {10, 10}));
+  ASSERT_THROW((void) mCache.atlas_page(mCache.atlas_page_count()), std::out_of_range);
+
+  ASSERT_EQ(&mCache.atlas_page(0), mCache.find_atlas_page(0));
+  ASSERT_FALSE(mCache.find_atlas_page(mCache.atlas_page_count()));
+
+  /* The page size is fixed once the atlas has pages */
+  ASSERT_TRUE(mCache.enable_atlas({256, 256}));
+  ASSERT_FALSE(mCache.enable_atlas({512, 512}));
+  ASSERT_EQ((cen::iarea {256, 256}), mCache.atlas_page_size());
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+TEST_F(FontCacheTest, RenderTextBatched)
+{
+  mCache.enable_atlas();
+  mCache.store_basic_latin_glyphs(*mRenderer);
+
+  ASSERT_NO_THROW(mCache.render_text_batched(*mRenderer, kUnicodeString, {10, 10}));
+
+  const cen::unicode_string multiline {'a', '\n', 'b', 0xE4};
+  ASSERT_NO_THROW(mCache.render_text_batched(*mRenderer, multiline, {10, 10}));
+}
+
+TEST_F(FontCacheTest, RenderTextScaled)
+{
+  mCache.store_basic_latin_glyphs(*mRenderer);
+  ASSERT_NO_THROW(mCache.render_text_scaled(*mRenderer, kUnicodeString, {10, 10}, 2.5f));
+}
+
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+
+TEST_F(FontCacheTest, SDF)
+{
+  ASSERT_FALSE(mCache.is_sdf_enabled());
+
+  ASSERT_TRUE(mCache.enable_sdf());
+  ASSERT_TRUE(mCache.is_sdf_enabled());
+  ASSERT_TRUE(mCache.is_atlas_enabled());
+  ASSERT_TRUE(mCache.get_font().sdf_enabled());
+
+  mCache.store_basic_latin_glyphs(*mRenderer);
+  ASSERT_TRUE(mCache.has_glyph('a'));
+
+  const cen::unicode_string multiline {'a', '\n', 'b', 0xE4};
+  ASSERT_NO_THROW(mCache.render_text_scaled(*mRenderer, multiline, {10, 10}, 0.5f));
+  ASSERT_NO_THROW(mCache.render_text_scaled(*mRenderer, multiline, {10, 10}, 4));
+}
+
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 0, 18)
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
 TEST_F(FontCacheTest, GetString)
 {
   mCache.store_latin1_glyphs(*mRenderer);
@@ -227,6 +303,66 @@ TEST_F(FontCacheTest, FindString)
   ASSERT_EQ(mCache.find_string(id + 1), nullptr);
 }
 
+TEST_F(FontCacheTest, GetOrRender)
+{
+  const auto& text = mCache.get_or_render(*mRenderer, "Score: 42", cen::colors::white);
+  ASSERT_EQ(1u, mCache.string_count());
+  ASSERT_EQ(1u, mCache.string_stats().misses);
+
+  ASSERT_EQ(&text, &mCache.get_or_render(*mRenderer, "Score: 42", cen::colors::white));
+  ASSERT_EQ(1u, mCache.string_count());
+  ASSERT_EQ(1u, mCache.string_stats().hits);
+
+  mCache.get_or_render(*mRenderer, "Score: 42", cen::colors::red);
+  mCache.get_or_render(*mRenderer,
+                       std::string {"Score: 42"},
+                       cen::colors::white,
+                       cen::font_cache::render_mode::solid);
+  ASSERT_EQ(3u, mCache.string_count());
+
+  mCache.set_string_budget({1, 0});
+  ASSERT_EQ(1u, mCache.string_count());
+
+  mCache.get_or_render(*mRenderer, "Score: 42", cen::colors::white);
+  ASSERT_EQ(1u, mCache.string_count());
+  ASSERT_EQ(4u, mCache.string_stats().misses);
+}
+
+TEST_F(FontCacheTest, CalcSize)
+{
+  auto& font = mCache.get_font();
+  const auto height = font.height();
+
+  ASSERT_EQ(0, mCache.calc_size("").width);
+  ASSERT_EQ(height, mCache.calc_size("").height);
+
+  font.set_kerning(false);
+
+  const auto advance = font.get_metrics('a').value().advance;
+  ASSERT_EQ(3 * advance, mCache.calc_size("abc").width);
+
+  const auto lines = mCache.calc_size("abc\nabcdef");
+  ASSERT_EQ(mCache.calc_size("abcdef").width, lines.width);
+  ASSERT_EQ(height + font.line_skip(), lines.height);
+}
+
+TEST_F(FontCacheTest, CalcWrappedSize)
+{
+  const auto word = mCache.calc_size("word").width;
+  const auto words = mCache.calc_size("word word").width;
+
+  const auto wrapped = mCache.calc_wrapped_size("word word word", words);
+  ASSERT_EQ(words, wrapped.width);
+  ASSERT_EQ(mCache.calc_size("a\nb").height, wrapped.height);
+
+  const auto narrow = mCache.calc_wrapped_size("word word word", word);
+  ASSERT_EQ(word, narrow.width);
+  ASSERT_EQ(mCache.calc_size("a\nb\nc").height, narrow.height);
+
+  ASSERT_EQ(mCache.calc_size("word word").height,
+            mCache.calc_wrapped_size("word word", 0).height);
+}
+
 TEST_F(FontCacheTest, GetFont)
 {
   const auto& font = mCache.get_font();
@@ -236,4 +372,266 @@ TEST_F(FontCacheTest, GetFont)
 TEST_F(FontCacheTest, ToString)
 {
   ASSERT_EQ("font_cache(font: 'JetBrains Mono', size: 12)", cen::to_string(mCache));
-}
\ No newline at end of file
+}
+TEST_F(FontCacheTest, GlyphBudget)
+{
+  mCache.set_glyph_budget({10, 0});
+  ASSERT_EQ(10u, mCache.glyph_budget().max_count);
+  ASSERT_EQ(0u, mCache.glyph_budget().max_bytes);
+
+  mCache.store_glyphs(*mRenderer, 'a', 'a' + 15);
+  ASSERT_EQ(10u, mCache.glyph_count());
+  ASSERT_EQ(5u, mCache.glyph_stats().evictions);
+
+  /* The least recently stored glyphs are evicted first */
+  ASSERT_FALSE(mCache.has_glyph('a'));
+  ASSERT_TRUE(mCache.has_glyph('a' + 14));
+
+  /* Looking up a glyph makes it the most recently used glyph */
+  ASSERT_TRUE(mCache.find_glyph('f'));
+  mCache.store_glyph(*mRenderer, 'A');
+  ASSERT_TRUE(mCache.has_glyph('f'));
+  ASSERT_FALSE(mCache.has_glyph('g'));
+
+  mCache.set_glyph_budget({0, mCache.glyph_memory() / 2});
+  ASSERT_LE(mCache.glyph_memory(), mCache.glyph_budget().max_bytes);
+  ASSERT_TRUE(mCache.has_glyph('A'));
+}
+
+TEST_F(FontCacheTest, AtlasGlyphBudget)
+{
+  mCache.enable_atlas({64, 64});
+  mCache.set_glyph_budget({0, 2u * 64u * 64u * sizeof(cen::uint32)});
+
+  mCache.store_latin1_glyphs(*mRenderer);
+  ASSERT_EQ(2u, mCache.atlas_page_count());
+  ASSERT_LE(mCache.glyph_memory(), mCache.glyph_budget().max_bytes);
+  ASSERT_GT(mCache.glyph_stats().evictions, 0u);
+
+  /* The most recently stored glyph must always be available */
+  ASSERT_TRUE(mCache.has_glyph(0xFF));
+  ASSERT_FALSE(mCache.has_glyph(0x20));
+  ASSERT_NO_THROW(mCache.render_text(*mRenderer, kUnicodeString, {10, 10}));
+}
+
+TEST_F(FontCacheTest, StringBudget)
+{
+  const auto& font = mCache.get_font();
+  mCache.set_string_budget({2, 0});
+
+  const auto a = mCache.store(*mRenderer, font.render_blended("a", cen::colors::white));
+  const auto b = mCache.store(*mRenderer, font.render_blended("b", cen::colors::white));
+
+  ASSERT_TRUE(mCache.find_string(a));
+  const auto c = mCache.store(*mRenderer, font.render_blended("c", cen::colors::white));
+
+  ASSERT_EQ(2u, mCache.string_count());
+  ASSERT_TRUE(mCache.has_string(a));
+  ASSERT_FALSE(mCache.has_string(b));
+  ASSERT_TRUE(mCache.has_string(c));
+  ASSERT_EQ(1u, mCache.string_stats().evictions);
+
+  mCache.set_string_budget({0, 1});
+  ASSERT_EQ(1u, mCache.string_count());
+  ASSERT_TRUE(mCache.has_string(c));
+  ASSERT_GT(mCache.string_memory(), 0u);
+}
+
+TEST_F(FontCacheTest, EvictOldest)
+{
+  ASSERT_FALSE(mCache.oldest_use());
+  ASSERT_FALSE(mCache.evict_oldest());
+
+  const auto& font = mCache.get_font();
+
+  mCache.store_glyph(*mRenderer, 'a');
+  const auto str = mCache.store(*mRenderer, font.render_blended("a", cen::colors::white));
+  mCache.store_glyph(*mRenderer, 'b');
+  ASSERT_EQ(mCache.glyph_memory() + mCache.string_memory(), mCache.memory_usage());
+
+  /* Glyphs and strings are evicted in the order that they were last used */
+  ASSERT_TRUE(mCache.find_glyph('a'));
+
+  ASSERT_TRUE(mCache.evict_oldest());
+  ASSERT_FALSE(mCache.has_string(str));
+
+  ASSERT_TRUE(mCache.evict_oldest());
+  ASSERT_FALSE(mCache.has_glyph('b'));
+  ASSERT_TRUE(mCache.has_glyph('a'));
+
+  ASSERT_TRUE(mCache.evict_oldest());
+  ASSERT_FALSE(mCache.evict_oldest());
+  ASSERT_EQ(0u, mCache.memory_usage());
+}
+
+TEST_F(FontCacheTest, Stats)
+{
+  mCache.store_basic_latin_glyphs(*mRenderer);
+  ASSERT_EQ(0u, mCache.glyph_stats().hits);
+  ASSERT_EQ(0u, mCache.glyph_stats().misses);
+
+  ASSERT_TRUE(mCache.find_glyph('a'));
+  ASSERT_FALSE(mCache.find_glyph(0x100));
+  ASSERT_TRUE(mCache.find_metrics('b'));
+
+  const cen::unicode_string str {'a', 'b', 0x100};
+  mCache.render_text(*mRenderer, str, {10, 10});
+
+  ASSERT_EQ(4u, mCache.glyph_stats().hits);
+  ASSERT_EQ(2u, mCache.glyph_stats().misses);
+  ASSERT_EQ(0u, mCache.glyph_stats().evictions);
+
+  ASSERT_FALSE(mCache.find_string(42));
+  ASSERT_EQ(1u, mCache.string_stats().misses);
+
+  mCache.reset_stats();
+  ASSERT_EQ(0u, mCache.glyph_stats().hits);
+  ASSERT_EQ(0u, mCache.string_stats().misses);
+}
+
+TEST_F(FontCacheTest, Lazy)
+{
+  ASSERT_FALSE(mCache.is_lazy());
+  mCache.render_text(*mRenderer, kUnicodeString, {10, 10});
+  ASSERT_FALSE(mCache.has_glyph('b'));
+
+  mCache.set_lazy(true);
+  ASSERT_TRUE(mCache.is_lazy());
+
+  mCache.render_text(*mRenderer, kUnicodeString, {10, 10});
+  ASSERT_TRUE(mCache.has_glyph('b'));
+  ASSERT_TRUE(mCache.has_glyph('a'));
+  ASSERT_TRUE(mCache.has_glyph('r'));
+  ASSERT_EQ(3u, mCache.glyph_count());
+
+  /* Glyphs that are not provided by the font are still skipped */
+  ASSERT_NO_THROW(mCache.render_glyph(*mRenderer, 0x7F, {10, 10}));
+  ASSERT_FALSE(mCache.has_glyph(0x7F));
+}
+
+TEST_F(FontCacheTest, Async)
+{
+  cen::thread_pool pool {2};
+
+  ASSERT_FALSE(mCache.is_async());
+  ASSERT_EQ(0u, mCache.upload_glyphs(*mRenderer, cen::millis<double> {1'000}));
+
+  mCache.enable_async(pool, cen::font {"resources/jetbrains_mono.ttf", 12});
+  ASSERT_TRUE(mCache.is_async());
+
+  mCache.store_glyph(*mRenderer, '?');
+  mCache.set_placeholder('?');
+  ASSERT_EQ('?', mCache.placeholder());
+
+  /* Missing glyphs are requested and rendered as the placeholder */
+  ASSERT_NO_THROW(mCache.render_text(*mRenderer, kUnicodeString, {10, 10}));
+  ASSERT_EQ(3u, mCache.pending_glyph_count());
+  ASSERT_FALSE(mCache.has_glyph('b'));
+
+  mCache.prefetch_glyphs(*mRenderer, 'a', 'z' + 1);
+  ASSERT_EQ(26u, mCache.pending_glyph_count());
+
+  while (mCache.pending_glyph_count() != 0) {
+    mCache.upload_glyphs(*mRenderer, cen::millis<double> {1'000});
+    SDL_Delay(1);
+  }
+
+  ASSERT_TRUE(mCache.has_glyph('a'));
+  ASSERT_TRUE(mCache.has_glyph('z'));
+  ASSERT_TRUE(mCache.find_glyph('b'));
+  ASSERT_EQ(27u, mCache.glyph_count());
+}
+
+TEST_F(FontCacheTest, Effects)
+{
+  ASSERT_FALSE(mCache.has_effects());
+  ASSERT_EQ(0, mCache.effects().outline);
+
+  cen::font_cache styled {"resources/jetbrains_mono.ttf", 12};
+  styled.set_effects({2, cen::colors::black, {1, 1}, cen::colors::gray});
+  ASSERT_TRUE(styled.has_effects());
+  ASSERT_EQ(2, styled.effects().outline);
+
+  mCache.store_glyph(*mRenderer, 'a');
+  styled.store_glyph(*mRenderer, 'a');
+
+  /* The layers extend the glyph images, but not the metrics */
+  const auto& plain = mCache.get_glyph('a');
+  const auto& baked = styled.get_glyph('a');
+  ASSERT_EQ(plain.glyph.width() + 5, baked.glyph.width());
+  ASSERT_EQ(plain.glyph.height() + 5, baked.glyph.height());
+  ASSERT_EQ(plain.metrics.advance, baked.metrics.advance);
+
+  styled.enable_atlas();
+  styled.store_glyph(*mRenderer, 'b');
+  ASSERT_NO_THROW(styled.render_text(*mRenderer, kUnicodeString, {10, 10}));
+
+  /* Transparent layers are disabled */
+  styled.set_effects({2, cen::colors::transparent, {}, cen::colors::gray});
+  ASSERT_FALSE(styled.has_effects());
+}
+
+TEST_F(FontCacheTest, Fallback)
+{
+  cen::font_cache cache {"resources/daniel.ttf", 12};
+  ASSERT_EQ(0u, cache.fallback_count());
+  ASSERT_EQ(&cache.get_font(), cache.resolve_font('a'));
+  ASSERT_EQ(nullptr, cache.resolve_font(0x100));
+
+  cache.add_fallback(cen::font {"resources/jetbrains_mono.ttf", 12});
+  ASSERT_EQ(1u, cache.fallback_count());
+  ASSERT_ANY_THROW(cache.get_fallback(1));
+
+  /* The cached font is preferred, and glyphs provided by no font are still skipped */
+  ASSERT_EQ(&cache.get_font(), cache.resolve_font('a'));
+  ASSERT_EQ(&cache.get_fallback(0), cache.resolve_font(0x100));
+  ASSERT_EQ(nullptr, cache.resolve_font(0x4E00));
+
+  cache.store_glyph(*mRenderer, 0x100);
+  cache.store_glyph(*mRenderer, 0x4E00);
+  ASSERT_TRUE(cache.has_glyph(0x100));
+  ASSERT_FALSE(cache.has_glyph(0x4E00));
+
+  const cen::unicode_string mixed {'a', 0x100, 'b'};
+  cache.set_lazy(true);
+  ASSERT_NO_THROW(cache.render_text(*mRenderer, mixed, {10, 10}));
+  ASSERT_EQ(3u, cache.glyph_count());
+}
+
+TEST_F(FontCacheTest, SaveAndLoadAtlas)
+{
+  const auto prefs = cen::preferred_path("centurion", "tests").copy();
+  const auto path = prefs + "font_atlas.bin";
+
+  const auto hash = cen::font_cache::hash_font_file("resources/jetbrains_mono.ttf");
+  ASSERT_TRUE(hash.has_value());
+  ASSERT_FALSE(cen::font_cache::hash_font_file("foo.ttf").has_value());
+
+  mCache.enable_atlas({256, 256});
+  mCache.store_basic_latin_glyphs(*mRenderer);
+  ASSERT_TRUE(mCache.save_atlas(*mRenderer, path, *hash));
+
+  cen::font_cache cache {"resources/jetbrains_mono.ttf", 12};
+  ASSERT_FALSE(cache.load_atlas(*mRenderer, "foo.bin", *hash));
+  ASSERT_FALSE(cache.load_atlas(*mRenderer, path, *hash + 1));
+  ASSERT_FALSE(cache.is_atlas_enabled());
+
+  ASSERT_TRUE(cache.load_atlas(*mRenderer, path, *hash));
+  ASSERT_TRUE(cache.is_atlas_enabled());
+  ASSERT_EQ(mCache.atlas_page_count(), cache.atlas_page_count());
+  ASSERT_EQ(mCache.glyph_count(), cache.glyph_count());
+
+  const auto* expected = mCache.find_atlas_glyph('a');
+  const auto* actual = cache.find_atlas_glyph('a');
+  ASSERT_TRUE(actual);
+  ASSERT_EQ(expected->page, actual->page);
+  ASSERT_EQ(expected->source, actual->source);
+  ASSERT_EQ(expected->metrics.advance, actual->metrics.advance);
+
+  /* Atlases created for other font configurations are rejected */
+  cen::font_cache other {"resources/jetbrains_mono.ttf", 16};
+  ASSERT_FALSE(other.load_atlas(*mRenderer, path, *hash));
+
+  ASSERT_NO_THROW(cache.store_glyph(*mRenderer, 0xE4));
+  ASSERT_TRUE(cache.has_glyph(0xE4));
+}
@@ -0,0 +1,88 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/fonts/frame_stats_overlay.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // unique_ptr
+
+#include "centurion/video/renderer.hpp"
+#include "centurion/video/window.hpp"
+
+class FrameStatsOverlayTest : public testing::Test {
+ protected:
+  FrameStatsOverlayTest() : mCache {"resources/jetbrains_mono.ttf", 12} {}
+
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  cen::font_cache mCache;
+};
+
+TEST_F(FrameStatsOverlayTest, Settings)
+{
+  cen::frame_stats_overlay overlay {mCache};
+
+  overlay.set_budget(1'000.0 / 30.0);
+  ASSERT_DOUBLE_EQ(1'000.0 / 30.0, overlay.budget());
+
+  overlay.set_graph_height(0);
+  ASSERT_EQ(1, overlay.graph_height());
+
+  overlay.set_bar_width(3);
+  ASSERT_EQ(3, overlay.bar_width());
+}
+
+TEST_F(FrameStatsOverlayTest, Render)
+{
+  mCache.store_basic_latin_glyphs(*mRenderer);
+
+  cen::frame_stats stats {8};
+  stats.begin_frame(0);
+
+  for (int frame = 1; frame <= 10; ++frame) {
+    stats.record(cen::frame_metric::draw_calls, 3);
+    stats.begin_frame(cen::frequency() / 60u * static_cast<cen::uint64>(frame));
+  }
+
+  cen::frame_stats_overlay overlay {mCache};
+
+  const auto color = cen::colors::magenta;
+  mRenderer->set_color(color);
+
+  overlay.render(*mRenderer, stats, {10, 10});
+  ASSERT_EQ(color, mRenderer->get_color());
+}
@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/fonts/text_layout.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+
+#include "centurion/video/renderer.hpp"
+#include "centurion/video/unicode_string.hpp"
+#include "centurion/video/window.hpp"
+
+class TextLayoutTest : public testing::Test {
+ protected:
+  TextLayoutTest() : mCache {"resources/jetbrains_mono.ttf", 12} {}
+
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  cen::font_cache mCache;
+};
+
+TEST_F(TextLayoutTest, Empty)
+{
+  const cen::unicode_string str;
+  const cen::text_layout layout {mCache, str};
+
+  ASSERT_TRUE(layout.empty());
+  ASSERT_EQ(0u, layout.glyph_count());
+  ASSERT_EQ(1u, layout.line_count());
+  ASSERT_EQ(0, layout.size().width);
+}
+
+TEST_F(TextLayoutTest, IgnoresUncachedGlyphs)
+{
+  const cen::unicode_string str {'a', 'b', 'c'};
+  const cen::text_layout layout {mCache, str};
+
+  ASSERT_TRUE(layout.empty());
+}
+
+TEST_F(TextLayoutTest, Positions)
+{
+  mCache.store_basic_latin_glyphs(*mRenderer);
+
+  const cen::unicode_string str {'a', 'b', '\n', 'c'};
+  const cen::text_layout layout {mCache, str};
+
+  ASSERT_EQ(3u, layout.glyph_count());
+  ASSERT_EQ(2u, layout.line_count());
+
+  const auto& glyphs = layout.glyphs();
+  ASSERT_EQ('a', glyphs.at(0).glyph);
+  ASSERT_EQ(0, glyphs.at(0).position.x());
+  ASSERT_EQ(0, glyphs.at(0).position.y());
+
+  ASSERT_LT(glyphs.at(0).position.x(), glyphs.at(1).position.x());
+  ASSERT_EQ(0, glyphs.at(1).position.y());
+
+  const auto lineSkip = mCache.get_font().line_skip();
+  ASSERT_EQ(0, glyphs.at(2).position.x());
+  ASSERT_EQ(lineSkip, glyphs.at(2).position.y());
+  ASSERT_EQ(2 * lineSkip, layout.size().height);
+
+  ASSERT_NO_THROW(layout.render(mCache, *mRenderer, {10, 10}));
+}
+
+TEST_F(TextLayoutTest, StreamOperator)
+{
+  const cen::unicode_string str;
+  const cen::text_layout layout {mCache, str};
+  std::cout << layout << '\n';
+}
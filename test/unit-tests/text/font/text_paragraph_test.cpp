@@ -0,0 +1,149 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/fonts/text_paragraph.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+
+#include "centurion/video/renderer.hpp"
+#include "centurion/video/unicode_string.hpp"
+#include "centurion/video/window.hpp"
+
+class TextParagraphTest : public testing::Test {
+ protected:
+  TextParagraphTest() : mCache {"resources/jetbrains_mono.ttf", 12}
+  {
+    mCache.get_font().set_kerning(false);
+  }
+
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  [[nodiscard]] auto advance() const -> int { return mCache.find_metrics('a')->advance; }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  cen::font_cache mCache;
+};
+
+TEST_F(TextParagraphTest, Empty)
+{
+  const cen::text_paragraph paragraph {mCache, 100};
+
+  ASSERT_TRUE(paragraph.empty());
+  ASSERT_EQ(0u, paragraph.line_count());
+  ASSERT_EQ(0, paragraph.size().height);
+}
+
+TEST_F(TextParagraphTest, Wrapping)
+{
+  mCache.store_basic_latin_glyphs(*mRenderer);
+
+  /* Glyphs are monospaced, so five glyphs fit on each line */
+  cen::text_paragraph paragraph {mCache, 5 * advance()};
+  paragraph.append_utf8("aa bb cc\nddddddd");
+
+  const auto& lines = paragraph.lines();
+  ASSERT_EQ(4u, lines.size());
+
+  ASSERT_EQ(0u, lines.at(0).first);
+  ASSERT_EQ(5u, lines.at(0).count);
+  ASSERT_EQ(6u, lines.at(1).first);
+  ASSERT_EQ(2u, lines.at(1).count);
+  ASSERT_EQ(5u, lines.at(2).count);
+  ASSERT_EQ(2u, lines.at(3).count);
+
+  ASSERT_EQ(5 * advance(), paragraph.size().width);
+  ASSERT_EQ(4 * paragraph.line_height(), paragraph.size().height);
+
+  paragraph.set_wrap_width(0);
+  ASSERT_EQ(2u, paragraph.line_count());
+  ASSERT_EQ(8 * advance(), paragraph.size().width);
+}
+
+TEST_F(TextParagraphTest, Append)
+{
+  mCache.store_basic_latin_glyphs(*mRenderer);
+
+  cen::text_paragraph paragraph {mCache, 5 * advance()};
+  paragraph.append_utf8("aa bb c");
+  ASSERT_EQ(2u, paragraph.line_count());
+
+  paragraph.append_utf8("cc dd\n");
+  ASSERT_EQ(4u, paragraph.line_count());
+  ASSERT_EQ(3u, paragraph.lines().at(1).count);
+  ASSERT_EQ(0u, paragraph.lines().back().count);
+
+  const cen::unicode_string str {'e', 'e'};
+  paragraph.append(str);
+  ASSERT_EQ(4u, paragraph.line_count());
+  ASSERT_EQ(2u, paragraph.lines().back().count);
+
+  paragraph.clear();
+  ASSERT_TRUE(paragraph.empty());
+  ASSERT_EQ(0u, paragraph.line_count());
+}
+
+TEST_F(TextParagraphTest, Render)
+{
+  mCache.store_basic_latin_glyphs(*mRenderer);
+
+  cen::text_paragraph paragraph {mCache, 100};
+  for (int line = 0; line < 100; ++line) {
+    paragraph.append_utf8("The quick brown fox jumps over the lazy dog\n");
+  }
+
+#if SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+  paragraph.set_alignment(cen::wrap_alignment::center);
+  ASSERT_EQ(cen::wrap_alignment::center, paragraph.alignment());
+#endif  // SDL_TTF_VERSION_ATLEAST(2, 20, 0)
+
+  ASSERT_NO_THROW(paragraph.render(mCache, *mRenderer, {10, 10}));
+  ASSERT_NO_THROW(paragraph.render(mCache, *mRenderer, {10, -500}, {0, 0, 800, 600}));
+
+  ASSERT_EQ(2u, paragraph.line_at(2 * paragraph.line_height()));
+  ASSERT_FALSE(paragraph.line_at(-1));
+  ASSERT_FALSE(paragraph.line_at(paragraph.size().height));
+}
+
+TEST_F(TextParagraphTest, StreamOperator)
+{
+  mCache.store_basic_latin_glyphs(*mRenderer);
+
+  cen::text_paragraph paragraph {mCache};
+  paragraph.append_utf8("foo");
+  std::cout << paragraph << '\n';
+}
@@ -33,9 +33,10 @@ TEST(UnicodeString, Defaults)
 {
   const cen::unicode_string str;
   ASSERT_TRUE(str.empty());
+  ASSERT_TRUE(str.is_inline());
 
   ASSERT_EQ(0u, str.size());
-  ASSERT_EQ(0u, str.capacity());
+  ASSERT_EQ(cen::unicode_string::inline_capacity, str.capacity());
 
   ASSERT_THROW(str.at(0), cen::exception);
 }
@@ -46,7 +47,7 @@ TEST(UnicodeString, StringViewConstructor)
 
   const cen::unicode_string str = u"foobar"sv;
   ASSERT_EQ(6u, str.size());
-  ASSERT_EQ(6u, str.capacity());
+  ASSERT_LE(6u, str.capacity());
 
   ASSERT_EQ('f', str.at(0));
   ASSERT_EQ('o', str.at(1));
@@ -65,7 +66,6 @@ TEST(UnicodeString, StringViewConstructorEmpty)
   const cen::unicode_string str = u""sv;
   ASSERT_TRUE(str.empty());
   ASSERT_EQ(0u, str.size());
-  ASSERT_EQ(0u, str.capacity());
 
   ASSERT_THROW(str.at(0), cen::exception);
 }
@@ -219,19 +219,98 @@ TEST(UnicodeString, Empty)
 
 TEST(UnicodeString, Reserve)
 {
+  constexpr auto n = cen::unicode_string::inline_capacity + 5u;
+
   cen::unicode_string str;
-  ASSERT_EQ(0u, str.capacity());
+  ASSERT_EQ(cen::unicode_string::inline_capacity, str.capacity());
 
   str.reserve(5u);
-  ASSERT_EQ(5u, str.capacity());
+  ASSERT_EQ(cen::unicode_string::inline_capacity, str.capacity());
+  ASSERT_TRUE(str.is_inline());
+
+  str.reserve(n);
+  ASSERT_EQ(n, str.capacity());
+  ASSERT_FALSE(str.is_inline());
+
+  for (cen::unicode_string::size_type index = 0; index < n; ++index) {
+    str += 'a';
+  }
 
-  str.append('a', 'b', 'c', 'd', 'e');
-  ASSERT_EQ(5u, str.size());
-  ASSERT_EQ(5u, str.capacity());
+  ASSERT_EQ(n, str.size());
+  ASSERT_EQ(n, str.capacity());
 
   str += 'f';
-  ASSERT_EQ(6u, str.size());
-  ASSERT_LT(5u, str.capacity());
+  ASSERT_EQ(n + 1u, str.size());
+  ASSERT_LT(n, str.capacity());
+}
+
+TEST(UnicodeString, InlineStorage)
+{
+  cen::unicode_string str;
+
+  for (cen::unicode_string::size_type index = 0; index < str.inline_capacity; ++index) {
+    str += static_cast<cen::unicode_t>('a' + index);
+  }
+
+  ASSERT_TRUE(str.is_inline());
+  ASSERT_EQ(0, str.data()[str.size()]);
+
+  str += 'z';
+  ASSERT_FALSE(str.is_inline());
+  ASSERT_EQ(str.inline_capacity + 1u, str.size());
+  ASSERT_EQ('a', str.at(0));
+  ASSERT_EQ('z', str.at(str.inline_capacity));
+  ASSERT_EQ(0, str.data()[str.size()]);
+
+  str.pop_back();
+  ASSERT_EQ('a' + str.inline_capacity - 1u, str.at(str.size() - 1u));
+  ASSERT_EQ(0, str.data()[str.size()]);
+
+  str.clear();
+  ASSERT_TRUE(str.empty());
+  ASSERT_EQ(0, *str.data());
+}
+
+TEST(UnicodeString, CopyAndMove)
+{
+  const cen::unicode_string small {'a', 'b', 'c'};
+  const auto large = cen::unicode_string {u"The quick brown fox jumps"};
+
+  for (const auto& original : {small, large}) {
+    auto copy = original;
+    ASSERT_EQ(original, copy);
+
+    auto moved = std::move(copy);
+    ASSERT_EQ(original, moved);
+    ASSERT_TRUE(copy.empty());  // NOLINT
+    ASSERT_EQ(0, *copy.data());
+
+    cen::unicode_string assigned {'x'};
+    assigned = std::move(moved);
+    ASSERT_EQ(original, assigned);
+    ASSERT_TRUE(moved.empty());  // NOLINT
+  }
+}
+
+TEST(UnicodeStringView, Construction)
+{
+  const cen::unicode_string_view empty;
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQ(0u, empty.size());
+  ASSERT_EQ(0, *empty.data());
+
+  const cen::unicode_string str {'f', 'o', 'o'};
+  const cen::unicode_string_view view = str;
+  ASSERT_EQ(3u, view.size());
+  ASSERT_EQ(str.data(), view.data());
+  ASSERT_EQ('o', view[2]);
+  ASSERT_THROW(view.at(3), cen::exception);
+
+  const cen::unicode_t raw[] {'b', 'a', 'r', 0};
+  const cen::unicode_string_view rawView {raw};
+  ASSERT_EQ(3u, rawView.size());
+  ASSERT_EQ(3, rawView.end() - rawView.begin());
+  ASSERT_EQ('b', rawView.at(0));
 }
 
 TEST(UnicodeString, EqualityOperator)
@@ -57,4 +57,21 @@ TEST(BlendMode, ToString)
 #endif  // SDL_VERSION_ATLEAST(2, 0, 12)
 
   std::cout << "blend_mode::blend == " << cen::blend_mode::blend << '\n';
-}
\ No newline at end of file
+}
+
+TEST(BlendMode, PremultipliedBlendMode)
+{
+  const auto mode = cen::premultiplied_blend_mode();
+  ASSERT_NE(cen::blend_mode::invalid, mode);
+  ASSERT_NE(cen::blend_mode::blend, mode);
+}
+
+TEST(AlphaMode, ToString)
+{
+  ASSERT_THROW(to_string(static_cast<cen::alpha_mode>(2)), cen::exception);
+
+  ASSERT_EQ("straight", to_string(cen::alpha_mode::straight));
+  ASSERT_EQ("premultiplied", to_string(cen::alpha_mode::premultiplied));
+
+  std::cout << "alpha_mode::premultiplied == " << cen::alpha_mode::premultiplied << '\n';
+}
@@ -26,9 +26,11 @@
 
 #include <gtest/gtest.h>
 
+#include <cstdlib>      // abs
 #include <iostream>     // cout
 #include <type_traits>  // is_nothrow_X...
 #include <utility>      // move
+#include <vector>       // vector
 
 #include "serialization_utils.hpp"
 
@@ -158,6 +160,96 @@ TEST(Color, FromHSL)
   ASSERT_EQ(cen::colors::white, cen::color::from_hsl(359, 100, 100));
 }
 
+TEST(Color, FromHSVInt)
+{
+  static_assert(cen::color::from_hsv_int(0, 0, 0) == cen::colors::black);
+  static_assert(cen::color::from_hsv_int(0, 0, 100) == cen::colors::white);
+  static_assert(cen::color::from_hsv_int(0, 100, 100) == cen::colors::red);
+  static_assert(cen::color::from_hsv_int(120, 100, 100) == cen::colors::lime);
+  static_assert(cen::color::from_hsv_int(240, 100, 100) == cen::colors::blue);
+
+  for (auto hue = 0; hue <= 360; hue += 7) {
+    for (auto saturation = 0; saturation <= 100; saturation += 11) {
+      for (auto value = 0; value <= 100; value += 13) {
+        const auto expected = cen::color::from_hsv(static_cast<float>(hue),
+                                                   static_cast<float>(saturation),
+                                                   static_cast<float>(value));
+        const auto actual = cen::color::from_hsv_int(hue, saturation, value);
+        ASSERT_LE(std::abs(expected.red() - actual.red()), 1);
+        ASSERT_LE(std::abs(expected.green() - actual.green()), 1);
+        ASSERT_LE(std::abs(expected.blue() - actual.blue()), 1);
+      }
+    }
+  }
+}
+
+TEST(Color, FromHSLInt)
+{
+  static_assert(cen::color::from_hsl_int(0, 0, 0) == cen::colors::black);
+  static_assert(cen::color::from_hsl_int(0, 0, 100) == cen::colors::white);
+  static_assert(cen::color::from_hsl_int(0, 100, 50) == cen::colors::red);
+  static_assert(cen::color::from_hsl_int(120, 100, 50) == cen::colors::lime);
+  static_assert(cen::color::from_hsl_int(240, 100, 50) == cen::colors::blue);
+
+  for (auto hue = 0; hue <= 360; hue += 7) {
+    for (auto saturation = 0; saturation <= 100; saturation += 11) {
+      for (auto lightness = 0; lightness <= 100; lightness += 13) {
+        const auto expected = cen::color::from_hsl(static_cast<float>(hue),
+                                                   static_cast<float>(saturation),
+                                                   static_cast<float>(lightness));
+        const auto actual = cen::color::from_hsl_int(hue, saturation, lightness);
+        ASSERT_LE(std::abs(expected.red() - actual.red()), 1);
+        ASSERT_LE(std::abs(expected.green() - actual.green()), 1);
+        ASSERT_LE(std::abs(expected.blue() - actual.blue()), 1);
+      }
+    }
+  }
+}
+
+TEST(Color, FromHSVN)
+{
+  std::vector<cen::hsv> values;
+  for (auto hue = 0; hue < 360; hue += 9) {
+    for (auto saturation = 0; saturation <= 100; saturation += 25) {
+      values.push_back({static_cast<float>(hue), static_cast<float>(saturation), 80.5f});
+    }
+  }
+
+  std::vector<cen::color> colors(values.size());
+  cen::color::from_hsv_n(values.data(), colors.data(), values.size());
+
+  for (std::size_t index = 0; index < values.size(); ++index) {
+    const auto& [hue, saturation, value] = values[index];
+    const auto expected = cen::color::from_hsv(hue, saturation, value);
+    ASSERT_LE(std::abs(expected.red() - colors[index].red()), 1);
+    ASSERT_LE(std::abs(expected.green() - colors[index].green()), 1);
+    ASSERT_LE(std::abs(expected.blue() - colors[index].blue()), 1);
+    ASSERT_EQ(255, colors[index].alpha());
+  }
+}
+
+TEST(Color, FromHSLN)
+{
+  std::vector<cen::hsl> values;
+  for (auto hue = 0; hue < 360; hue += 9) {
+    for (auto saturation = 0; saturation <= 100; saturation += 25) {
+      values.push_back({static_cast<float>(hue), static_cast<float>(saturation), 35.5f});
+    }
+  }
+
+  std::vector<cen::color> colors(values.size());
+  cen::color::from_hsl_n(values.data(), colors.data(), values.size());
+
+  for (std::size_t index = 0; index < values.size(); ++index) {
+    const auto& [hue, saturation, lightness] = values[index];
+    const auto expected = cen::color::from_hsl(hue, saturation, lightness);
+    ASSERT_LE(std::abs(expected.red() - colors[index].red()), 1);
+    ASSERT_LE(std::abs(expected.green() - colors[index].green()), 1);
+    ASSERT_LE(std::abs(expected.blue() - colors[index].blue()), 1);
+    ASSERT_EQ(255, colors[index].alpha());
+  }
+}
+
 TEST(Color, FromRGB)
 {
   ASSERT_FALSE(cen::color::from_rgb("112233"));
@@ -215,6 +307,59 @@ TEST(Color, FromARGB)
   ASSERT_EQ("#890FE1CA", cen::color::from_argb("#890FE1CA").value().as_argb());
 }
 
+TEST(Color, ConstexprFromHex)
+{
+  constexpr auto rgb = cen::color::from_rgb("#2AEB9C");
+  static_assert(rgb && rgb->red() == 0x2A && rgb->green() == 0xEB && rgb->blue() == 0x9C);
+
+  constexpr auto rgba = cen::color::from_rgba("#7bcf39ea");
+  static_assert(rgba && rgba->alpha() == 0xEA);
+
+  constexpr auto argb = cen::color::from_argb("#B281CDA7");
+  static_assert(argb && argb->alpha() == 0xB2 && argb->red() == 0x81);
+
+  static_assert(!cen::color::from_rgb("#XY0000"));
+  static_assert(!cen::color::from_argb("#112233"));
+}
+
+TEST(Color, Literals)
+{
+  using namespace cen::literals;
+
+  constexpr auto rgb = "#2AEB9C"_rgb;
+  static_assert(rgb == cen::color {0x2A, 0xEB, 0x9C});
+
+  constexpr auto rgba = "#7BCF39EA"_rgba;
+  static_assert(rgba == cen::color {0x7B, 0xCF, 0x39, 0xEA});
+
+  constexpr auto argb = "#B281CDA7"_argb;
+  static_assert(argb == cen::color {0x81, 0xCD, 0xA7, 0xB2});
+
+  ASSERT_THROW((void) operator""_rgb("#12345", 6), cen::exception);
+  ASSERT_THROW((void) operator""_rgba("#1234567G", 9), cen::exception);
+  ASSERT_THROW((void) operator""_argb("", 0), cen::exception);
+}
+
+#if CENTURION_HAS_FEATURE_IS_CONSTANT_EVALUATED
+
+TEST(Color, ConstexprFromHSVAndHSL)
+{
+  static_assert(cen::color::from_hsv(120, 100, 100) == cen::colors::lime);
+  static_assert(cen::color::from_hsl(240, 100, 50) == cen::colors::blue);
+
+  /* Constant evaluation must produce the same results as the runtime path */
+  constexpr auto hsv = cen::color::from_hsv(211.5f, 37.3f, 81.9f);
+  constexpr auto hsl = cen::color::from_hsl(47.2f, 63.1f, 28.8f);
+
+  float hue = 211.5f;
+  ASSERT_EQ(hsv, cen::color::from_hsv(hue, 37.3f, 81.9f));
+
+  hue = 47.2f;
+  ASSERT_EQ(hsl, cen::color::from_hsl(hue, 63.1f, 28.8f));
+}
+
+#endif  // CENTURION_HAS_FEATURE_IS_CONSTANT_EVALUATED
+
 TEST(Color, FromNorm)
 {
   {
@@ -342,6 +487,44 @@ TEST(Color, blend)
   ASSERT_EQ(0xFF, c.alpha());
 }
 
+TEST(Color, BlendInt)
+{
+  static_assert(cen::blend_int(cen::colors::white, cen::colors::black, 0) ==
+                cen::colors::white);
+  static_assert(cen::blend_int(cen::colors::white, cen::colors::black, 255) ==
+                cen::colors::black);
+
+  // light pink: #FFB6C1, crimson:  #DC143C
+  constexpr auto c = cen::blend_int(cen::colors::light_pink, cen::colors::crimson, 102);
+  ASSERT_EQ(0xF1, c.red());
+  ASSERT_EQ(0x75, c.green());
+  ASSERT_EQ(0x8C, c.blue());
+  ASSERT_EQ(0xFF, c.alpha());
+}
+
+TEST(Color, BlendN)
+{
+  // An odd amount of colors, to exercise both the vectorized and the scalar code paths
+  std::vector<cen::color> a;
+  std::vector<cen::color> b;
+  for (auto index = 0; index < 23; ++index) {
+    const auto value = static_cast<cen::uint8>(index * 11);
+    a.emplace_back(value, 255 - value, value / 2, 255);
+    b.emplace_back(255 - value, value, 200, value);
+  }
+
+  std::vector<cen::color> out(a.size());
+  cen::blend_n(a.data(), b.data(), out.data(), a.size(), 0.4f);
+
+  for (std::size_t index = 0; index < a.size(); ++index) {
+    ASSERT_EQ(cen::blend_int(a[index], b[index], 102), out[index]);
+  }
+
+  // The output may alias the input
+  cen::blend_n(a.data(), b.data(), a.data(), a.size(), 0.4f);
+  ASSERT_EQ(out, a);
+}
+
 TEST(Color, Data)
 {
   auto white = cen::colors::white;
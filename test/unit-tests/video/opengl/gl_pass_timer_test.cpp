@@ -0,0 +1,161 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/gl_pass_timer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <map>  // map
+
+namespace {
+
+/* Emulates timer queries with a GPU clock that advances by one millisecond per query */
+GLuint nextQuery {};
+GLint64 gpuClock {};
+bool resultsAvailable {};
+std::map<GLuint, GLuint64> timestamps;
+
+void APIENTRY fake_gen_queries(const GLsizei count, GLuint* queries)
+{
+  for (GLsizei index = 0; index < count; ++index) {
+    queries[index] = ++nextQuery;
+  }
+}
+
+void APIENTRY fake_delete_queries(GLsizei, const GLuint*) {}
+
+void APIENTRY fake_query_counter(const GLuint query, GLenum)
+{
+  gpuClock += 1'000'000;
+  timestamps[query] = static_cast<GLuint64>(gpuClock);
+}
+
+void APIENTRY fake_get_query_objectiv(GLuint, GLenum, GLint* value)
+{
+  *value = resultsAvailable ? 1 : 0;
+}
+
+void APIENTRY fake_get_query_objectui64v(const GLuint query, GLenum, GLuint64* value)
+{
+  *value = timestamps.at(query);
+}
+
+void APIENTRY fake_get_integer64v(GLenum, GLint64* value)
+{
+  *value = gpuClock;
+}
+
+[[nodiscard]] auto make_functions() -> cen::gl_functions
+{
+  cen::gl_functions functions;
+  functions.gen_queries = &fake_gen_queries;
+  functions.delete_queries = &fake_delete_queries;
+  functions.query_counter = &fake_query_counter;
+  functions.get_query_objectiv = &fake_get_query_objectiv;
+  functions.get_query_objectui64v = &fake_get_query_objectui64v;
+  functions.get_integer64v = &fake_get_integer64v;
+  return functions;
+}
+
+}  // namespace
+
+class GLPassTimerTest : public testing::Test {
+ protected:
+  void SetUp() override
+  {
+    timestamps.clear();
+    resultsAvailable = true;
+  }
+};
+
+TEST_F(GLPassTimerTest, IsSupported)
+{
+  ASSERT_FALSE(cen::gl_pass_timer::is_supported(cen::gl_functions {}));
+  ASSERT_TRUE(cen::gl_pass_timer::is_supported(make_functions()));
+}
+
+TEST_F(GLPassTimerTest, Results)
+{
+  cen::gl_pass_timer timer {make_functions()};
+
+  timer.begin_frame();
+  {
+    const cen::gl_pass_scope scene {timer, "scene"};
+    const cen::gl_pass_scope shadows {timer, "shadows"};
+  }
+
+  // The results of a frame are read when its queries are reused, two frames later
+  timer.begin_frame();
+  ASSERT_TRUE(timer.results().empty());
+
+  timer.begin_frame();
+  ASSERT_EQ(2u, timer.results().size());
+
+  const auto& scene = timer.results().at(0);
+  const auto& shadows = timer.results().at(1);
+  ASSERT_STREQ("scene", scene.name);
+  ASSERT_STREQ("shadows", shadows.name);
+
+  // The nested pass spans one query, and the outer pass spans three queries
+  ASSERT_LE(scene.begin, shadows.begin);
+  ASSERT_GE(scene.end, shadows.end);
+  ASSERT_NEAR(3.0, cen::millis<double> {scene.elapsed()}.count(), 0.01);
+  ASSERT_NEAR(1.0, cen::millis<double> {shadows.elapsed()}.count(), 0.01);
+  ASSERT_EQ(0u, timer.dropped());
+}
+
+TEST_F(GLPassTimerTest, Unavailable)
+{
+  cen::gl_pass_timer timer {make_functions()};
+
+  timer.begin_frame();
+  timer.begin("pass");
+  timer.end();
+
+  // Unavailable results are dropped instead of waiting for them
+  resultsAvailable = false;
+  timer.begin_frame();
+  timer.begin_frame();
+
+  ASSERT_TRUE(timer.results().empty());
+  ASSERT_EQ(1u, timer.dropped());
+}
+
+TEST_F(GLPassTimerTest, MaxPasses)
+{
+  cen::gl_pass_timer timer {make_functions(), 1};
+
+  timer.begin_frame();
+  timer.begin("first");
+  timer.begin("second");
+  timer.end();
+  timer.end();
+
+  ASSERT_EQ(1u, timer.dropped());
+
+  timer.begin_frame();
+  timer.begin_frame();
+  ASSERT_EQ(1u, timer.results().size());
+}
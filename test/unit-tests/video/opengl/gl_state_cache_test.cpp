@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/gl_state.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+namespace {
+
+/* Records the OpenGL calls made by the cache, instead of calling a real driver */
+std::vector<GLenum> calls;
+
+void APIENTRY fake_bind_texture(GLenum, GLuint)
+{
+  calls.push_back(GL_TEXTURE_2D);
+}
+
+void APIENTRY fake_active_texture(const GLenum unit)
+{
+  calls.push_back(unit);
+}
+
+void APIENTRY fake_use_program(GLuint)
+{
+  calls.push_back(GL_CURRENT_PROGRAM);
+}
+
+void APIENTRY fake_enable(const GLenum cap)
+{
+  calls.push_back(cap);
+}
+
+void APIENTRY fake_disable(const GLenum cap)
+{
+  calls.push_back(cap);
+}
+
+void APIENTRY fake_blend_func_separate(GLenum, GLenum, GLenum, GLenum)
+{
+  calls.push_back(GL_BLEND_SRC_RGB);
+}
+
+void APIENTRY fake_blend_equation_separate(GLenum, GLenum)
+{
+  calls.push_back(GL_BLEND_EQUATION_RGB);
+}
+
+void APIENTRY fake_bind_buffer(const GLenum target, GLuint)
+{
+  calls.push_back(target);
+}
+
+void APIENTRY fake_viewport(GLint, GLint, GLsizei, GLsizei)
+{
+  calls.push_back(GL_VIEWPORT);
+}
+
+[[nodiscard]] auto make_functions() -> cen::gl_functions
+{
+  cen::gl_functions functions;
+  functions.bind_texture = &fake_bind_texture;
+  functions.active_texture = &fake_active_texture;
+  functions.use_program = &fake_use_program;
+  functions.enable = &fake_enable;
+  functions.disable = &fake_disable;
+  functions.blend_func_separate = &fake_blend_func_separate;
+  functions.blend_equation_separate = &fake_blend_equation_separate;
+  functions.bind_buffer = &fake_bind_buffer;
+  functions.viewport = &fake_viewport;
+  return functions;
+}
+
+}  // namespace
+
+class GLStateCacheTest : public testing::Test {
+ protected:
+  void SetUp() override { calls.clear(); }
+};
+
+TEST_F(GLStateCacheTest, Defaults)
+{
+  const cen::gl_functions functions;
+  ASSERT_FALSE(functions.bind_texture);
+  ASSERT_FALSE(functions.bind_vertex_array);
+
+  const cen::gl_state_cache cache {make_functions()};
+  ASSERT_FALSE(cache.bound_texture().has_value());
+  ASSERT_FALSE(cache.current_program().has_value());
+  ASSERT_EQ(0u, cache.issued());
+  ASSERT_EQ(0u, cache.skipped());
+}
+
+TEST_F(GLStateCacheTest, BindTexture)
+{
+  cen::gl_state_cache cache {make_functions()};
+
+  cache.bind_texture(7);
+  ASSERT_EQ((std::vector<GLenum> {GL_TEXTURE0, GL_TEXTURE_2D}), calls);
+  ASSERT_EQ(7u, cache.bound_texture());
+
+  cache.bind_texture(7);
+  ASSERT_EQ(2u, calls.size());
+  ASSERT_EQ(1u, cache.issued());
+  ASSERT_EQ(1u, cache.skipped());
+
+  /* Units are tracked separately, and the active unit is only changed when necessary */
+  cache.bind_texture(7, 1);
+  cache.bind_texture(8, 1);
+  ASSERT_EQ((std::vector<GLenum> {GL_TEXTURE0,
+                                  GL_TEXTURE_2D,
+                                  GL_TEXTURE1,
+                                  GL_TEXTURE_2D,
+                                  GL_TEXTURE_2D}),
+            calls);
+  ASSERT_EQ(7u, cache.bound_texture(0));
+  ASSERT_EQ(8u, cache.bound_texture(1));
+}
+
+TEST_F(GLStateCacheTest, Program)
+{
+  cen::gl_state_cache cache {make_functions()};
+
+  cache.use_program(3);
+  cache.use_program(3);
+  cache.use_program(4);
+
+  ASSERT_EQ(2u, calls.size());
+  ASSERT_EQ(4u, cache.current_program());
+  ASSERT_EQ(1u, cache.skipped());
+}
+
+TEST_F(GLStateCacheTest, Blending)
+{
+  cen::gl_state_cache cache {make_functions()};
+
+  cache.set_blend_enabled(true);
+  cache.set_blend_enabled(true);
+  cache.set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  cache.set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+  cache.set_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ZERO);
+  cache.set_blend_equation(GL_FUNC_ADD);
+  cache.set_blend_equation(GL_FUNC_ADD, GL_FUNC_ADD);
+  cache.set_blend_enabled(false);
+
+  ASSERT_EQ((std::vector<GLenum> {GL_BLEND,
+                                  GL_BLEND_SRC_RGB,
+                                  GL_BLEND_SRC_RGB,
+                                  GL_BLEND_EQUATION_RGB,
+                                  GL_BLEND}),
+            calls);
+  ASSERT_EQ(5u, cache.issued());
+  ASSERT_EQ(3u, cache.skipped());
+}
+
+TEST_F(GLStateCacheTest, BuffersAndViewport)
+{
+  cen::gl_state_cache cache {make_functions()};
+
+  cache.bind_buffer(GL_ARRAY_BUFFER, 1);
+  cache.bind_buffer(GL_ELEMENT_ARRAY_BUFFER, 1);
+  cache.bind_buffer(GL_ARRAY_BUFFER, 1);
+  cache.set_viewport({0, 0, 800, 600});
+  cache.set_viewport({0, 0, 800, 600});
+
+  ASSERT_EQ((std::vector<GLenum> {GL_ARRAY_BUFFER, GL_ELEMENT_ARRAY_BUFFER, GL_VIEWPORT}),
+            calls);
+  ASSERT_EQ(2u, cache.skipped());
+}
+
+TEST_F(GLStateCacheTest, Invalidate)
+{
+  cen::gl_state_cache cache {make_functions()};
+
+  cache.bind_texture(1);
+  cache.use_program(2);
+  calls.clear();
+
+  cache.invalidate();
+  ASSERT_FALSE(cache.bound_texture().has_value());
+  ASSERT_FALSE(cache.current_program().has_value());
+
+  cache.bind_texture(1);
+  cache.use_program(2);
+  ASSERT_EQ((std::vector<GLenum> {GL_TEXTURE0, GL_TEXTURE_2D, GL_CURRENT_PROGRAM}), calls);
+
+  cache.reset_counters();
+  ASSERT_EQ(0u, cache.issued());
+  ASSERT_EQ(0u, cache.skipped());
+}
@@ -0,0 +1,137 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/gl_texture_streamer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+namespace {
+
+/* Emulates the subset of OpenGL used by the streamer without persistent mapping */
+GLuint boundUnpackBuffer {};
+int uploads {};
+std::vector<unsigned char> uploaded;
+
+void APIENTRY fake_gen_buffers(const GLsizei count, GLuint* buffers)
+{
+  for (GLsizei index = 0; index < count; ++index) {
+    buffers[index] = static_cast<GLuint>(index + 1);
+  }
+}
+
+void APIENTRY fake_delete_buffers(GLsizei, const GLuint*) {}
+
+void APIENTRY fake_bind_buffer(const GLenum target, const GLuint buffer)
+{
+  ASSERT_EQ(GL_PIXEL_UNPACK_BUFFER, target);
+  boundUnpackBuffer = buffer;
+}
+
+void APIENTRY fake_buffer_data(GLenum, const GLsizeiptr size, const void* data, GLenum)
+{
+  ASSERT_NE(0u, boundUnpackBuffer);
+
+  const auto* bytes = static_cast<const unsigned char*>(data);
+  uploaded.assign(bytes, bytes + size);
+}
+
+void APIENTRY fake_tex_sub_image_2d(GLenum,
+                                    GLint,
+                                    GLint,
+                                    GLint,
+                                    GLsizei,
+                                    GLsizei,
+                                    GLenum,
+                                    GLenum,
+                                    const void* pixels)
+{
+  /* Pixels are read from the bound buffer, so the pointer is an offset */
+  ASSERT_NE(0u, boundUnpackBuffer);
+  ASSERT_EQ(nullptr, pixels);
+  ++uploads;
+}
+
+void APIENTRY fake_pixel_storei(GLenum, GLint) {}
+void APIENTRY fake_bind_texture(GLenum, GLuint) {}
+void APIENTRY fake_active_texture(GLenum) {}
+
+[[nodiscard]] auto make_functions() -> cen::gl_functions
+{
+  cen::gl_functions functions;
+  functions.gen_buffers = &fake_gen_buffers;
+  functions.delete_buffers = &fake_delete_buffers;
+  functions.bind_buffer = &fake_bind_buffer;
+  functions.buffer_data = &fake_buffer_data;
+  functions.tex_sub_image_2d = &fake_tex_sub_image_2d;
+  functions.pixel_storei = &fake_pixel_storei;
+  functions.bind_texture = &fake_bind_texture;
+  functions.active_texture = &fake_active_texture;
+  return functions;
+}
+
+}  // namespace
+
+TEST(GLTextureStreamer, Defaults)
+{
+  cen::gl_state_cache cache {make_functions()};
+  const cen::gl_texture_streamer streamer {cache, 1, {4, 2}};
+
+  ASSERT_FALSE(streamer.is_persistent());
+  ASSERT_EQ((cen::iarea {4, 2}), streamer.size());
+  ASSERT_EQ(16, streamer.pitch());
+  ASSERT_EQ(3u, streamer.depth());
+  ASSERT_EQ(0u, streamer.frames());
+  ASSERT_EQ(0u, streamer.stalls());
+}
+
+TEST(GLTextureStreamer, Upload)
+{
+  uploads = 0;
+
+  cen::gl_state_cache cache {make_functions()};
+  cen::gl_texture_streamer streamer {cache, 1, {2, 2}, GL_RGBA, GL_UNSIGNED_BYTE, 1};
+
+  /* Rows are repacked when the source pitch is larger than the frame pitch */
+  const unsigned char pixels[] {1, 2, 0, 3, 4, 0};
+  streamer.upload(pixels, 3);
+
+  ASSERT_EQ((std::vector<unsigned char> {1, 2, 3, 4}), uploaded);
+  ASSERT_EQ(1, uploads);
+  ASSERT_EQ(0u, boundUnpackBuffer);
+
+  auto* frame = static_cast<unsigned char*>(streamer.acquire());
+  frame[0] = 5;
+  frame[1] = 6;
+  frame[2] = 7;
+  frame[3] = 8;
+  streamer.commit();
+
+  ASSERT_EQ((std::vector<unsigned char> {5, 6, 7, 8}), uploaded);
+  ASSERT_EQ(2, uploads);
+  ASSERT_EQ(2u, streamer.frames());
+  ASSERT_EQ(0u, boundUnpackBuffer);
+}
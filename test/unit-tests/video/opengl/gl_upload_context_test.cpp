@@ -0,0 +1,188 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/gl_upload_context.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>     // atomic
+#include <stdexcept>  // runtime_error
+#include <vector>     // vector
+
+namespace {
+
+/* Emulates the sync objects of a driver, fences are only signaled once the test allows it */
+std::atomic<bool> signaled {};
+std::atomic<int> fences {};
+std::atomic<int> polls {};
+std::atomic<int> deleted {};
+std::atomic<int> flushes {};
+std::atomic<int> finishes {};
+
+int syncObject {};
+const auto fence = reinterpret_cast<GLsync>(&syncObject);
+
+GLsync APIENTRY fake_fence_sync(const GLenum condition, const GLbitfield flags)
+{
+  EXPECT_EQ(static_cast<GLenum>(GL_SYNC_GPU_COMMANDS_COMPLETE), condition);
+  EXPECT_EQ(0u, flags);
+
+  ++fences;
+  return fence;
+}
+
+GLenum APIENTRY fake_client_wait_sync(const GLsync sync, GLbitfield, GLuint64)
+{
+  EXPECT_EQ(fence, sync);
+
+  ++polls;
+  return signaled ? GL_CONDITION_SATISFIED : GL_TIMEOUT_EXPIRED;
+}
+
+void APIENTRY fake_delete_sync(const GLsync sync)
+{
+  EXPECT_EQ(fence, sync);
+  ++deleted;
+}
+
+void APIENTRY fake_flush()
+{
+  ++flushes;
+}
+
+void APIENTRY fake_finish()
+{
+  ++finishes;
+}
+
+[[nodiscard]] auto make_functions(const bool sync = true) -> cen::gl_functions
+{
+  cen::gl_functions functions;
+  functions.flush = &fake_flush;
+  functions.finish = &fake_finish;
+
+  if (sync) {
+    functions.fence_sync = &fake_fence_sync;
+    functions.client_wait_sync = &fake_client_wait_sync;
+    functions.delete_sync = &fake_delete_sync;
+  }
+
+  return functions;
+}
+
+void reset()
+{
+  signaled = false;
+  fences = 0;
+  polls = 0;
+  deleted = 0;
+  flushes = 0;
+  finishes = 0;
+}
+
+}  // namespace
+
+TEST(GLUploadContext, FencePolling)
+{
+  reset();
+
+  cen::gl_upload_context context {make_functions()};
+  ASSERT_EQ(nullptr, context.get());
+
+  std::atomic<bool> uploaded {};
+  const auto id = context.submit([&](const cen::gl_functions&) { uploaded = true; });
+  ASSERT_EQ(1u, id);
+
+  /* The upload has run, but it isn't complete until its fence is signaled */
+  while (!uploaded || polls < 3) {
+    cen::thread::sleep(cen::u32ms {1});
+  }
+
+  ASSERT_FALSE(context.is_complete(id));
+  ASSERT_EQ(1u, context.pending());
+  ASSERT_EQ(1, fences.load());
+  ASSERT_EQ(1, flushes.load());
+  ASSERT_EQ(0, deleted.load());
+
+  signaled = true;
+  context.wait(id);
+
+  ASSERT_TRUE(context.is_complete(id));
+  ASSERT_EQ(0u, context.pending());
+  ASSERT_EQ(1, deleted.load());
+  ASSERT_EQ(0, finishes.load());
+}
+
+TEST(GLUploadContext, FinishWithoutSyncObjects)
+{
+  reset();
+
+  cen::gl_upload_context context {make_functions(false)};
+
+  const auto id = context.submit([](const cen::gl_functions&) {});
+  context.wait(id);
+
+  ASSERT_EQ(1, finishes.load());
+  ASSERT_EQ(0, fences.load());
+}
+
+TEST(GLUploadContext, UploadDelivery)
+{
+  reset();
+  signaled = true;
+
+  const auto caller = SDL_ThreadID();
+  std::vector<int> order;
+  std::atomic<bool> onLoaderThread {true};
+  std::atomic<bool> receivedFunctions {true};
+
+  {
+    cen::gl_upload_context context {make_functions()};
+
+    for (int i = 0; i < 5; ++i) {
+      context.submit([&, i](const cen::gl_functions& functions) {
+        onLoaderThread = onLoaderThread && SDL_ThreadID() != caller;
+        receivedFunctions = receivedFunctions && functions.fence_sync == &fake_fence_sync;
+        order.push_back(i);
+      });
+    }
+
+    /* Failed uploads are counted, and still complete so that waiting never hangs */
+    const auto failing =
+        context.submit([](const cen::gl_functions&) { throw std::runtime_error {"!"}; });
+    context.wait(failing);
+    ASSERT_EQ(1u, context.failed());
+
+    ASSERT_EQ((std::vector<int> {0, 1, 2, 3, 4}), order);
+
+    /* The destructor completes uploads that are still pending */
+    context.submit([&](const cen::gl_functions&) { order.push_back(5); });
+  }
+
+  ASSERT_EQ(6u, order.size());
+  ASSERT_EQ(5, order.back());
+  ASSERT_TRUE(onLoaderThread);
+  ASSERT_TRUE(receivedFunctions);
+  ASSERT_EQ(fences.load(), deleted.load());
+}
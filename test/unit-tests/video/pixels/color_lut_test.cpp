@@ -0,0 +1,240 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/color_lut.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>  // abs
+#include <vector>   // vector
+
+#include "centurion/concurrency/thread_pool.hpp"
+#include "centurion/video/color.hpp"
+#include "centurion/video/pixel_span.hpp"
+#include "centurion/video/pixels.hpp"
+#include "centurion/video/surface.hpp"
+
+namespace {
+
+using argb_span = cen::pixel_span<cen::pixel_format::argb8888>;
+
+[[nodiscard]] auto test_color(const int x, const int y) -> cen::color
+{
+  return {static_cast<cen::uint8>(x * 7),
+          static_cast<cen::uint8>(y * 13),
+          static_cast<cen::uint8>(x * y),
+          static_cast<cen::uint8>(255 - x)};
+}
+
+/* Fills a span, wide enough that the vectorized kernels also process a remainder */
+template <cen::pixel_format Format>
+void fill_span(const cen::pixel_span<Format>& span)
+{
+  for (int y = 0; y < span.height(); ++y) {
+    for (int x = 0; x < span.width(); ++x) {
+      span.set_color(x, y, test_color(x, y));
+    }
+  }
+}
+
+[[nodiscard]] auto near(const cen::color& a, const cen::color& b) -> bool
+{
+  return std::abs(a.red() - b.red()) <= 1 && std::abs(a.green() - b.green()) <= 1 &&
+         std::abs(a.blue() - b.blue()) <= 1 && a.alpha() == b.alpha();
+}
+
+}  // namespace
+
+TEST(ColorLut, Defaults)
+{
+  const cen::color_lut lut;
+  const cen::color color {0x12, 0x34, 0x56, 0x78};
+
+  ASSERT_EQ(color, lut.apply(color));
+  ASSERT_EQ(color, cen::color_lut::gamma(1).apply(color));
+  ASSERT_EQ(color, cen::color_lut::brightness_contrast(0, 1).apply(color));
+}
+
+TEST(ColorLut, Factories)
+{
+  const auto brighter = cen::color_lut::gamma(2.2f);
+  ASSERT_GT(brighter.red()[64], 64);
+  ASSERT_EQ(0, brighter.red()[0]);
+  ASSERT_EQ(255, brighter.red()[255]);
+
+  /* The alpha channel is left unchanged */
+  ASSERT_EQ(100, brighter.alpha()[100]);
+
+  const auto adjusted = cen::color_lut::brightness_contrast(0.5f, 2.0f);
+  ASSERT_EQ(255, adjusted.green()[200]);
+  ASSERT_EQ(0, adjusted.green()[0]);
+
+  const auto inverted = cen::color_lut::from_curve([](const float v) { return 1 - v; });
+  ASSERT_EQ((cen::color {255, 0, 155, 40}), inverted.apply(cen::color {0, 255, 100, 40}));
+}
+
+TEST(ColorLut, Then)
+{
+  const auto gamma = cen::color_lut::gamma(1.8f);
+  const auto contrast = cen::color_lut::brightness_contrast(-0.1f, 1.5f);
+  const auto combined = gamma.then(contrast);
+
+  for (int value = 0; value < 256; ++value) {
+    const cen::color color {static_cast<cen::uint8>(value),
+                            static_cast<cen::uint8>(255 - value),
+                            static_cast<cen::uint8>(value / 2)};
+    ASSERT_EQ(contrast.apply(gamma.apply(color)), combined.apply(color));
+  }
+}
+
+TEST(ColorLut, PackedSpan)
+{
+  auto lut = cen::color_lut::gamma(0.6f);
+  lut.alpha()[255 - 3] = 17;
+
+  std::vector<cen::uint32> pixels(40 * 9, 0);
+  const argb_span span {pixels.data(), {37, 9}, 40 * 4};
+  fill_span(span);
+
+  cen::apply_lut(span, lut);
+
+  for (int y = 0; y < span.height(); ++y) {
+    for (int x = 0; x < span.width(); ++x) {
+      ASSERT_EQ(lut.apply(test_color(x, y)), span.color_at(x, y));
+    }
+  }
+
+  /* The pixels outside of the span are never touched */
+  ASSERT_EQ(0u, pixels.at(37));
+  ASSERT_EQ(0u, pixels.at(39));
+}
+
+TEST(ColorLut, ParallelMatchesSerial)
+{
+  cen::thread_pool pool {4};
+  const auto lut = cen::color_lut::brightness_contrast(0.1f, 1.3f);
+
+  std::vector<cen::uint32> serial(61 * 120);
+  std::vector<cen::uint32> parallel(61 * 120);
+  const argb_span serialSpan {serial.data(), {61, 120}, 61 * 4};
+  const argb_span parallelSpan {parallel.data(), {61, 120}, 61 * 4};
+
+  fill_span(serialSpan);
+  fill_span(parallelSpan);
+
+  cen::apply_lut(serialSpan, lut);
+  cen::apply_lut(pool, parallelSpan, lut);
+
+  ASSERT_EQ(serial, parallel);
+}
+
+TEST(ColorLut, GenericSpan)
+{
+  const auto lut = cen::color_lut::gamma(1.5f);
+
+  std::vector<cen::uint16> pixels(11 * 3);
+  const cen::pixel_span<cen::pixel_format::rgb565> span {pixels.data(), {11, 3}, 11 * 2};
+  fill_span(span);
+
+  std::vector<cen::color> expected;
+  for (int y = 0; y < span.height(); ++y) {
+    for (int x = 0; x < span.width(); ++x) {
+      expected.push_back(lut.apply(span.color_at(x, y)));
+    }
+  }
+
+  cen::apply_lut(span, lut);
+
+  for (int y = 0; y < span.height(); ++y) {
+    for (int x = 0; x < span.width(); ++x) {
+      const auto& color = expected.at(static_cast<cen::usize>(y * span.width() + x));
+      ASSERT_EQ(cen::pixel_traits<cen::pixel_format::rgb565>::from_color(color),
+                span.at(x, y));
+    }
+  }
+}
+
+TEST(ColorCube, Identity)
+{
+  const cen::color_cube cube {9};
+  ASSERT_EQ(9, cube.size());
+  ASSERT_EQ(cen::colors::white, cube.at(8, 8, 8));
+  ASSERT_EQ(cen::colors::black, cube.at(0, 0, 0));
+
+  for (int value = 0; value < 256; value += 5) {
+    const cen::color color {static_cast<cen::uint8>(value),
+                            static_cast<cen::uint8>(255 - value),
+                            static_cast<cen::uint8>(value / 3),
+                            0x42};
+    ASSERT_TRUE(near(color, cube.apply(color)));
+  }
+}
+
+TEST(ColorCube, FromFunction)
+{
+  /* Swapping channels can't be expressed with per-channel tables */
+  const auto swap = [](const cen::color& color) {
+    return cen::color {color.blue(), color.red(), color.green()};
+  };
+
+  const auto cube = cen::color_cube::from_function(swap, 5);
+  ASSERT_EQ(swap(cube.at(1, 2, 3)), cube.at(3, 1, 2));
+
+  std::vector<cen::uint32> pixels(19 * 4);
+  const argb_span span {pixels.data(), {19, 4}, 19 * 4};
+  fill_span(span);
+
+  cen::thread_pool pool {2};
+  cen::apply_lut(pool, span, cube);
+
+  for (int y = 0; y < span.height(); ++y) {
+    for (int x = 0; x < span.width(); ++x) {
+      auto expected = swap(test_color(x, y));
+      expected.set_alpha(test_color(x, y).alpha());
+      ASSERT_TRUE(near(expected, span.color_at(x, y)));
+    }
+  }
+}
+
+TEST(ColorLut, Surface)
+{
+  const auto lut = cen::color_lut::gamma(2.0f);
+
+  cen::surface surface {{20, 20}, cen::pixel_format::rgba32};
+  const cen::pixel_span<cen::pixel_format::rgba32> span {surface};
+  fill_span(span);
+
+  cen::thread_pool pool {2};
+  ASSERT_TRUE(cen::apply_lut(pool, surface, lut));
+  ASSERT_EQ(lut.apply(test_color(5, 7)), span.color_at(5, 7));
+
+  /* Indexed surfaces are transformed through their palettes */
+  cen::surface indexed {{4, 4}, cen::pixel_format::index8};
+  cen::palette palette {2};
+  ASSERT_TRUE(palette.set_color(1, cen::color {64, 128, 192}));
+  ASSERT_TRUE(indexed.set_palette(palette));
+
+  ASSERT_TRUE(cen::apply_lut(indexed, lut));
+  ASSERT_EQ(lut.apply(cen::color {64, 128, 192}), palette.at(1));
+}
@@ -0,0 +1,222 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/detail/pixel_conversion.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // copy, equal
+#include <iterator>   // begin, end
+#include <vector>     // vector
+
+#include "centurion/video/pixels.hpp"
+#include "centurion/video/surface.hpp"
+
+namespace {
+
+/* Odd widths exercise the scalar tails of the vectorized kernels */
+constexpr int widths[] {1, 3, 7, 13, 31, 67};
+
+const cen::detail::simd_level levels[] {cen::detail::simd_level::scalar,
+                                        cen::detail::best_simd_level()};
+
+[[nodiscard]] auto make_pixels(const cen::usize bytes) -> std::vector<cen::uint8>
+{
+  std::vector<cen::uint8> pixels(bytes);
+  for (cen::usize index = 0; index < bytes; ++index) {
+    pixels[index] = static_cast<cen::uint8>(index * 7 + 3);
+  }
+  return pixels;
+}
+
+[[nodiscard]] auto fill_surface(const cen::iarea size, const cen::pixel_format format)
+    -> cen::surface
+{
+  cen::surface surface {size, format};
+  const auto pixels = make_pixels(static_cast<cen::usize>(surface.pitch() * size.height));
+
+  auto* data = static_cast<cen::uint8*>(surface.pixel_data());
+  std::copy(pixels.begin(), pixels.end(), data);
+
+  return surface;
+}
+
+void expect_same_pixels(const cen::surface& a, const cen::surface& b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  ASSERT_EQ(a.format_info().format(), b.format_info().format());
+
+  const auto* lhs = static_cast<const cen::uint8*>(a.pixel_data());
+  const auto* rhs = static_cast<const cen::uint8*>(b.pixel_data());
+
+  for (int y = 0; y < a.height(); ++y) {
+    for (int x = 0; x < a.width() * 4; ++x) {
+      ASSERT_EQ(lhs[y * a.pitch() + x], rhs[y * b.pitch() + x]);
+    }
+  }
+}
+
+void expect_matches_sdl(const cen::pixel_format from, const cen::pixel_format to)
+{
+  for (const auto width : widths) {
+    const auto source = fill_surface({width, 5}, from);
+
+    auto* converted = SDL_ConvertSurfaceFormat(source.get(), cen::to_underlying(to), 0);
+    ASSERT_TRUE(converted);
+
+    const cen::surface expected {converted};
+    const auto actual = source.convert_to(to);
+
+    expect_same_pixels(expected, actual);
+  }
+}
+
+}  // namespace
+
+TEST(PixelConversion, FindPixelKernel)
+{
+  using cen::detail::find_pixel_kernel;
+  using cen::detail::pixel_kernel;
+
+  if constexpr (SDL_BYTEORDER == SDL_LIL_ENDIAN) {
+    ASSERT_EQ(pixel_kernel::swap_02,
+              find_pixel_kernel(SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ABGR8888));
+    ASSERT_EQ(pixel_kernel::swap_13,
+              find_pixel_kernel(SDL_PIXELFORMAT_RGBA8888, SDL_PIXELFORMAT_BGRA8888));
+    ASSERT_EQ(pixel_kernel::expand_012,
+              find_pixel_kernel(SDL_PIXELFORMAT_BGR24, SDL_PIXELFORMAT_ARGB8888));
+    ASSERT_EQ(pixel_kernel::expand_210,
+              find_pixel_kernel(SDL_PIXELFORMAT_RGB24, SDL_PIXELFORMAT_ARGB8888));
+  }
+
+  ASSERT_FALSE(find_pixel_kernel(SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_RGB565));
+  ASSERT_FALSE(find_pixel_kernel(SDL_PIXELFORMAT_ARGB8888, SDL_PIXELFORMAT_ARGB8888));
+}
+
+TEST(PixelConversion, Swizzle)
+{
+  for (const auto level : levels) {
+    for (const auto width : widths) {
+      const auto count = static_cast<cen::usize>(width);
+      const auto src = make_pixels(count * 4);
+
+      std::vector<cen::uint8> dst(count * 4);
+      cen::detail::convert_pixels(cen::detail::pixel_kernel::swap_02,
+                                  level,
+                                  src.data(),
+                                  dst.data(),
+                                  count);
+
+      for (cen::usize index = 0; index < count * 4; index += 4) {
+        ASSERT_EQ(src[index + 2], dst[index + 0]);
+        ASSERT_EQ(src[index + 1], dst[index + 1]);
+        ASSERT_EQ(src[index + 0], dst[index + 2]);
+        ASSERT_EQ(src[index + 3], dst[index + 3]);
+      }
+    }
+  }
+}
+
+TEST(PixelConversion, Expand)
+{
+  for (const auto level : levels) {
+    for (const auto width : widths) {
+      const auto count = static_cast<cen::usize>(width);
+      const auto src = make_pixels(count * 3);
+
+      std::vector<cen::uint8> dst(count * 4);
+      cen::detail::convert_pixels(cen::detail::pixel_kernel::expand_210,
+                                  level,
+                                  src.data(),
+                                  dst.data(),
+                                  count);
+
+      for (cen::usize index = 0; index < count; ++index) {
+        ASSERT_EQ(src[index * 3 + 2], dst[index * 4 + 0]);
+        ASSERT_EQ(src[index * 3 + 1], dst[index * 4 + 1]);
+        ASSERT_EQ(src[index * 3 + 0], dst[index * 4 + 2]);
+        ASSERT_EQ(0xFF, dst[index * 4 + 3]);
+      }
+    }
+  }
+}
+
+TEST(PixelConversion, Premultiply)
+{
+  /* Every combination of channel and alpha value */
+  std::vector<cen::uint8> source;
+  for (int alpha = 0; alpha < 256; ++alpha) {
+    for (int channel = 0; channel < 256; ++channel) {
+      const auto value = static_cast<cen::uint8>(channel);
+      source.insert(source.end(), {value, value, value, static_cast<cen::uint8>(alpha)});
+    }
+  }
+
+  const auto count = source.size() / 4;
+
+  for (const auto level : levels) {
+    for (const auto width : widths) {
+      auto pixels = source;
+      cen::detail::premultiply_pixels(3, level, pixels.data(), static_cast<cen::usize>(width));
+      cen::detail::premultiply_pixels(3,
+                                      level,
+                                      pixels.data() + width * 4,
+                                      count - static_cast<cen::usize>(width));
+
+      for (cen::usize index = 0; index < pixels.size(); index += 4) {
+        const auto alpha = source[index + 3];
+        const auto expected = (source[index] * alpha + 127) / 255;
+
+        ASSERT_EQ(expected, pixels[index + 0]);
+        ASSERT_EQ(expected, pixels[index + 1]);
+        ASSERT_EQ(expected, pixels[index + 2]);
+        ASSERT_EQ(alpha, pixels[index + 3]);
+      }
+    }
+  }
+}
+
+TEST(PixelConversion, Unpremultiply)
+{
+  cen::uint8 pixels[] {128, 100, 50, 25, 255, 10, 20, 30, 0, 40, 40, 40};
+  cen::detail::unpremultiply_pixels(0, pixels, 3);
+
+  const cen::uint8 expected[] {128, 199, 100, 50, 255, 10, 20, 30, 0, 0, 0, 0};
+  ASSERT_TRUE(std::equal(std::begin(pixels), std::end(pixels), std::begin(expected)));
+}
+
+TEST(PixelConversion, MatchesSDL)
+{
+  using cen::pixel_format;
+
+  expect_matches_sdl(pixel_format::argb8888, pixel_format::abgr8888);
+  expect_matches_sdl(pixel_format::abgr8888, pixel_format::argb8888);
+  expect_matches_sdl(pixel_format::xrgb8888, pixel_format::xbgr8888);
+  expect_matches_sdl(pixel_format::rgba8888, pixel_format::bgra8888);
+  expect_matches_sdl(pixel_format::bgra8888, pixel_format::rgba8888);
+  expect_matches_sdl(pixel_format::rgb24, pixel_format::argb8888);
+  expect_matches_sdl(pixel_format::rgb24, pixel_format::abgr8888);
+  expect_matches_sdl(pixel_format::bgr24, pixel_format::argb8888);
+  expect_matches_sdl(pixel_format::bgr24, pixel_format::xbgr8888);
+}
@@ -24,6 +24,7 @@
 
 #include <gtest/gtest.h>
 
+#include <array>     // array
 #include <iostream>  // cout
 #include <memory>    // unique_ptr
 
@@ -103,6 +104,53 @@ TEST_F(PixelFormatInfoTest, PixelToRGBA)
   ASSERT_EQ(color, mInfo->pixel_to_rgba(pixel));
 }
 
+TEST_F(PixelFormatInfoTest, RGBAToPixels)
+{
+  const std::array colors {cen::colors::honey_dew,
+                           cen::colors::hot_pink,
+                           cen::colors::aquamarine.with_alpha(0x7F),
+                           cen::colors::transparent};
+
+  for (const auto format : {cen::pixel_format::argb8888,
+                            cen::pixel_format::rgba8888,
+                            cen::pixel_format::abgr8888,
+                            cen::pixel_format::bgra8888,
+                            cen::pixel_format::rgb888,
+                            cen::pixel_format::bgrx8888,
+                            cen::pixel_format::rgb565}) {
+    const cen::pixel_format_info info {format};
+
+    std::array<cen::uint32, colors.size()> pixels {};
+    info.rgba_to_pixels(colors.data(), pixels.data(), colors.size());
+
+    for (std::size_t index = 0; index < colors.size(); ++index) {
+      ASSERT_EQ(info.rgba_to_pixel(colors[index]), pixels[index]);
+    }
+  }
+}
+
+TEST_F(PixelFormatInfoTest, PixelsToRGBA)
+{
+  const std::array<cen::uint32, 4> pixels {0x00000000, 0xFFFFFFFF, 0x12345678, 0x80FF0040};
+
+  for (const auto format : {cen::pixel_format::argb8888,
+                            cen::pixel_format::rgba8888,
+                            cen::pixel_format::abgr8888,
+                            cen::pixel_format::bgra8888,
+                            cen::pixel_format::rgb888,
+                            cen::pixel_format::bgrx8888,
+                            cen::pixel_format::rgb565}) {
+    const cen::pixel_format_info info {format};
+
+    std::array<cen::color, pixels.size()> colors {};
+    info.pixels_to_rgba(pixels.data(), colors.data(), pixels.size());
+
+    for (std::size_t index = 0; index < pixels.size(); ++index) {
+      ASSERT_EQ(info.pixel_to_rgba(pixels[index]), colors[index]);
+    }
+  }
+}
+
 TEST_F(PixelFormatInfoTest, ToString)
 {
   std::cout << *mInfo << '\n';
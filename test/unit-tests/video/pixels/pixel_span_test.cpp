@@ -0,0 +1,162 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/pixel_span.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>   // atomic
+#include <cstring>  // memcpy
+#include <vector>   // vector
+
+#include "centurion/concurrency/thread_pool.hpp"
+#include "centurion/video/color.hpp"
+#include "centurion/video/pixels.hpp"
+#include "centurion/video/surface.hpp"
+
+using argb_traits = cen::pixel_traits<cen::pixel_format::argb8888>;
+using rgb565_traits = cen::pixel_traits<cen::pixel_format::rgb565>;
+using rgb24_traits = cen::pixel_traits<cen::pixel_format::rgb24>;
+
+static_assert(argb_traits::from_color(cen::color {0x11, 0x22, 0x33, 0x44}) == 0x44112233u);
+static_assert(argb_traits::to_color(0x44112233u) == cen::color {0x11, 0x22, 0x33, 0x44});
+static_assert(rgb565_traits::from_color(cen::colors::white) == 0xFFFFu);
+static_assert(rgb565_traits::to_color(0xF800u) == cen::colors::red);
+static_assert(sizeof(rgb24_traits::value_type) == 3);
+
+namespace {
+
+template <cen::pixel_format Format>
+void expect_matches_format_info()
+{
+  cen::surface surface {{7, 3}, Format};
+  const auto info = surface.format_info();
+
+  cen::pixel_span<Format> span {surface};
+  const cen::color colors[] {cen::colors::red,
+                             cen::colors::lime,
+                             cen::colors::blue,
+                             cen::color {0x12, 0x34, 0x56, 0x78}};
+
+  for (const auto& color : colors) {
+    span.set_color(3, 1, color);
+    span.set_color(6, 2, color);
+
+    const auto* row = static_cast<const cen::uint8*>(surface.pixel_data()) + surface.pitch();
+    constexpr auto bytes = sizeof(typename cen::pixel_traits<Format>::value_type);
+
+    cen::uint32 pixel {};
+    std::memcpy(&pixel, row + 3 * bytes, bytes);
+
+    ASSERT_EQ(info.pixel_to_rgba(pixel), span.color_at(3, 1));
+    ASSERT_EQ(info.pixel_to_rgba(pixel), span.color_at(6, 2));
+  }
+}
+
+}  // namespace
+
+TEST(PixelSpan, MatchesFormatInfo)
+{
+  expect_matches_format_info<cen::pixel_format::argb8888>();
+  expect_matches_format_info<cen::pixel_format::rgba8888>();
+  expect_matches_format_info<cen::pixel_format::abgr8888>();
+  expect_matches_format_info<cen::pixel_format::bgra8888>();
+  expect_matches_format_info<cen::pixel_format::rgb888>();
+  expect_matches_format_info<cen::pixel_format::bgrx8888>();
+  expect_matches_format_info<cen::pixel_format::rgb565>();
+  expect_matches_format_info<cen::pixel_format::argb4444>();
+  expect_matches_format_info<cen::pixel_format::rgb24>();
+  expect_matches_format_info<cen::pixel_format::bgr24>();
+}
+
+TEST(PixelSpan, Rows)
+{
+  std::vector<cen::uint32> pixels(6 * 4, 0);
+  cen::pixel_span<cen::pixel_format::argb8888> span {pixels.data(), {5, 4}, 6 * 4};
+
+  ASSERT_EQ(5, span.width());
+  ASSERT_EQ(4, span.height());
+  ASSERT_EQ(24, span.pitch());
+  ASSERT_FALSE(span.empty());
+
+  int y = 0;
+  for (const auto row : span.rows()) {
+    ASSERT_EQ(5, row.width());
+    for (auto& pixel : row) {
+      pixel = static_cast<cen::uint32>(y);
+    }
+    ++y;
+  }
+
+  ASSERT_EQ(4, y);
+  ASSERT_EQ(0u, pixels.at(4));
+  ASSERT_EQ(1u, pixels.at(6));
+  ASSERT_EQ(3u, pixels.at(18 + 4));
+
+  /* The padding is never touched */
+  ASSERT_EQ(0u, pixels.at(5));
+  ASSERT_EQ(0u, pixels.at(23));
+}
+
+TEST(PixelSpan, Subspan)
+{
+  std::vector<cen::uint32> pixels(8 * 8, 0);
+  cen::pixel_span<cen::pixel_format::argb8888> span {pixels.data(), {8, 8}, 8 * 4};
+
+  const auto tile = span.subspan({2, 4, 3, 2});
+  ASSERT_EQ((cen::iarea {3, 2}), tile.size());
+  ASSERT_EQ(span.pitch(), tile.pitch());
+
+  tile.fill(cen::colors::white);
+  tile.set_color(0, 0, cen::colors::red);
+
+  ASSERT_EQ(cen::colors::red, span.color_at(2, 4));
+  ASSERT_EQ(cen::colors::white, span.color_at(4, 5));
+  ASSERT_EQ(0u, span.at(5, 5));
+  ASSERT_EQ(0u, span.at(2, 6));
+
+  const auto band = span.rows(4, 6);
+  ASSERT_EQ((cen::iarea {8, 2}), band.size());
+  ASSERT_EQ(cen::colors::red, band.color_at(2, 0));
+}
+
+TEST(PixelSpan, ParallelForRows)
+{
+  cen::thread_pool pool {4};
+
+  cen::surface surface {{64, 200}, cen::pixel_format::argb8888};
+  const cen::pixel_span<cen::pixel_format::argb8888> span {surface};
+
+  std::atomic<int> rows {0};
+  cen::parallel_for_rows(pool, span, [&](const auto row, const int y) {
+    for (int x = 0; x < row.width(); ++x) {
+      row.set_color(x, cen::color {static_cast<cen::uint8>(x), static_cast<cen::uint8>(y), 0});
+    }
+    ++rows;
+  });
+
+  ASSERT_EQ(200, rows.load());
+  ASSERT_EQ((cen::color {63, 199, 0}), span.color_at(63, 199));
+  ASSERT_EQ((cen::color {10, 20, 0}), span.color_at(10, 20));
+}
@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/animated_texture.hpp"
+
+#include <gtest/gtest.h>
+
+#include <initializer_list>  // initializer_list
+#include <iostream>          // cout
+#include <memory>            // unique_ptr
+#include <stdexcept>         // out_of_range
+
+#include "centurion/common/literals.hpp"
+#include "centurion/video/window.hpp"
+
+#if SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
+
+using namespace cen::literals::time_literals;
+
+namespace {
+
+/* Creates an animation in the same way as SDL_image, which frees it with IMG_FreeAnimation */
+[[nodiscard]] auto make_animation(const cen::iarea& size, std::initializer_list<int> delays)
+    -> cen::animation
+{
+  auto* anim = static_cast<IMG_Animation*>(SDL_malloc(sizeof(IMG_Animation)));
+  anim->w = size.width;
+  anim->h = size.height;
+  anim->count = static_cast<int>(delays.size());
+  anim->frames = static_cast<SDL_Surface**>(SDL_calloc(delays.size(), sizeof(SDL_Surface*)));
+  anim->delays = static_cast<int*>(SDL_calloc(delays.size(), sizeof(int)));
+
+  int index = 0;
+  for (const auto delay : delays) {
+    anim->frames[index] =
+        SDL_CreateRGBSurfaceWithFormat(0, size.width, size.height, 32, SDL_PIXELFORMAT_RGBA32);
+    anim->delays[index] = delay;
+    ++index;
+  }
+
+  return cen::animation {anim};
+}
+
+}  // namespace
+
+class AnimatedTextureTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(AnimatedTextureTest, Upload)
+{
+  const auto anim = make_animation({40, 30}, {10, 20, 30, 40, 50});
+  const cen::animated_texture texture {*mRenderer, anim};
+
+  ASSERT_EQ(5u, texture.count());
+  ASSERT_EQ(anim.size(), texture.size());
+  ASSERT_EQ(150_ms, texture.duration());
+
+  /* All frames fit in a single page */
+  ASSERT_EQ(1u, texture.atlas().page_count());
+
+  for (cen::usize index = 0; index < texture.count(); ++index) {
+    const auto& region = texture.region(index);
+    ASSERT_TRUE(region);
+    ASSERT_EQ(anim.size(), region.size());
+    ASSERT_EQ(0u, region.page);
+  }
+
+  ASSERT_FALSE(cen::overlaps(texture.region(0).source, texture.region(1).source));
+  ASSERT_THROW((void) texture.region(5), std::out_of_range);
+
+  ASSERT_EQ(cen::success, mRenderer->render(texture.region_at(25_ms), cen::ipoint {10, 10}));
+}
+
+TEST_F(AnimatedTextureTest, FrameAt)
+{
+  const auto anim = make_animation({8, 8}, {10, 0, 20, 30});
+  const cen::animated_texture texture {*mRenderer, anim};
+
+  ASSERT_EQ(60_ms, texture.duration());
+
+  ASSERT_EQ(0u, texture.frame_at(0_ms));
+  ASSERT_EQ(0u, texture.frame_at(9_ms));
+
+  /* The second frame has no delay, so it is never shown */
+  ASSERT_EQ(2u, texture.frame_at(10_ms));
+  ASSERT_EQ(2u, texture.frame_at(29_ms));
+  ASSERT_EQ(3u, texture.frame_at(30_ms));
+  ASSERT_EQ(3u, texture.frame_at(59_ms));
+
+  ASSERT_EQ(0u, texture.frame_at(60_ms));
+  ASSERT_EQ(2u, texture.frame_at(75_ms));
+  ASSERT_EQ(3u, texture.frame_at(75_ms, false));
+  ASSERT_EQ(3u, texture.frame_at(6000_ms, false));
+
+  ASSERT_EQ(10_ms, texture.delay(0));
+  ASSERT_EQ(0_ms, texture.delay(1));
+  ASSERT_EQ(30_ms, texture.delay(3));
+  ASSERT_THROW((void) texture.delay(4), cen::exception);
+}
+
+TEST_F(AnimatedTextureTest, InvalidAnimation)
+{
+  const auto empty = make_animation({8, 8}, {});
+  ASSERT_THROW(cen::animated_texture(*mRenderer, empty), cen::exception);
+
+  const auto huge = make_animation({100'000, 1}, {10});
+  ASSERT_THROW(cen::animated_texture(*mRenderer, huge), cen::exception);
+}
+
+TEST_F(AnimatedTextureTest, StreamOperator)
+{
+  const auto anim = make_animation({8, 8}, {10, 20});
+  std::cout << cen::animated_texture {*mRenderer, anim} << '\n';
+}
+
+#endif  // SDL_IMAGE_VERSION_ATLEAST(2, 6, 0)
@@ -0,0 +1,197 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/animation_system.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+namespace {
+
+/* The textures are never dereferenced, since the sprite batch is never flushed */
+[[nodiscard]] auto make_clip(const cen::usize frames, const bool loop) -> cen::animation_clip
+{
+  cen::animation_clip clip;
+  clip.loop = loop;
+
+  for (cen::usize index = 0; index < frames; ++index) {
+    cen::atlas_region region;
+    region.source = cen::irect {static_cast<int>(index) * 16, 0, 16, 24};
+    clip.frames.push_back(region);
+    clip.durations.push_back(0.25f);
+  }
+
+  return clip;
+}
+
+}  // namespace
+
+TEST(AnimationSystem, AdvanceMatchesScalar)
+{
+  constexpr cen::usize count = 23;
+
+  std::vector<float> time(count), speed(count), length(count), loop(count);
+  for (cen::usize index = 0; index < count; ++index) {
+    time[index] = static_cast<float>(index) * 0.1f;
+    speed[index] = (index % 3 == 0) ? -1.5f : 0.75f + static_cast<float>(index) * 0.2f;
+    length[index] = 0.5f + static_cast<float>(index % 4);
+    loop[index] = (index % 2 == 0) ? 1.0f : 0.0f;
+  }
+
+  auto time2 = time;
+
+  const cen::detail::animation_arrays simd {time.data(),
+                                            speed.data(),
+                                            length.data(),
+                                            loop.data()};
+  const cen::detail::animation_arrays scalar {time2.data(),
+                                              speed.data(),
+                                              length.data(),
+                                              loop.data()};
+
+  for (int step = 0; step < 50; ++step) {
+    cen::detail::advance_n(simd, count, 0.37f);
+    cen::detail::advance_scalar(scalar, 0, count, 0.37f);
+  }
+
+  for (cen::usize index = 0; index < count; ++index) {
+    ASSERT_EQ(time2[index], time[index]) << "index: " << index;
+    ASSERT_GE(time[index], 0.0f);
+    ASSERT_LE(time[index], length[index]);
+  }
+}
+
+TEST(AnimationSystem, FindFrame)
+{
+  const float ends[] = {0.25f, 0.5f, 1.0f, 2.0f};
+
+  ASSERT_EQ(0u, cen::detail::find_frame(ends, 4, 0, 0.0f));
+  ASSERT_EQ(1u, cen::detail::find_frame(ends, 4, 0, 0.3f));
+  ASSERT_EQ(3u, cen::detail::find_frame(ends, 4, 0, 1.5f));
+  ASSERT_EQ(0u, cen::detail::find_frame(ends, 4, 3, 0.1f));
+  ASSERT_EQ(3u, cen::detail::find_frame(ends, 4, 1, 2.0f));
+}
+
+TEST(AnimationSystem, AddClip)
+{
+  cen::animation_system system;
+  ASSERT_EQ(0u, system.add_clip(make_clip(4, true)));
+  ASSERT_EQ(1u, system.add_clip(make_clip(2, false)));
+  ASSERT_EQ(2u, system.clip_count());
+
+  ASSERT_THROW(system.add_clip({}), cen::exception);
+
+  auto mismatched = make_clip(3, true);
+  mismatched.durations.pop_back();
+  ASSERT_THROW(system.add_clip(mismatched), cen::exception);
+
+  auto zero = make_clip(3, true);
+  zero.durations[1] = 0;
+  ASSERT_THROW(system.add_clip(zero), cen::exception);
+
+  ASSERT_THROW(system.play(2), cen::exception);
+}
+
+TEST(AnimationSystem, Update)
+{
+  cen::animation_system system;
+  const auto looping = system.add_clip(make_clip(4, true));
+  const auto once = system.add_clip(make_clip(4, false));
+
+  const auto a = system.play(looping, {10, 20});
+  const auto b = system.play(once, {}, 2.0f);
+  const auto c = system.play(once, {}, -1.0f);
+
+  ASSERT_EQ(0u, system.frame(a));
+  ASSERT_EQ(3u, system.frame(c));
+
+  system.update(0.3f);
+  ASSERT_EQ(1u, system.frame(a));
+  ASSERT_EQ(2u, system.frame(b));
+  ASSERT_EQ(2u, system.frame(c));
+  ASSERT_EQ(32, system.region(b).source.x());
+
+  system.update(0.8f);
+  ASSERT_EQ(0u, system.frame(a));  // Wrapped around, at 0.1 seconds
+  ASSERT_EQ(3u, system.frame(b));
+  ASSERT_TRUE(system.is_finished(b));
+  ASSERT_FALSE(system.is_finished(a));
+
+  system.update(1.0f);
+  ASSERT_EQ(0u, system.frame(c));
+  ASSERT_TRUE(system.is_finished(c));
+
+  system.set_time(b, 0.6f);
+  ASSERT_EQ(2u, system.frame(b));
+  ASSERT_FALSE(system.is_finished(b));
+}
+
+TEST(AnimationSystem, Erase)
+{
+  cen::animation_system system;
+  const auto clip = system.add_clip(make_clip(2, true));
+
+  const auto a = system.play(clip, {1, 1});
+  const auto b = system.play(clip, {2, 2});
+  const auto c = system.play(clip, {3, 3});
+  ASSERT_EQ(3u, system.size());
+
+  ASSERT_TRUE(system.erase(a));
+  ASSERT_FALSE(system.erase(a));
+  ASSERT_FALSE(system.contains(a));
+  ASSERT_THROW((void) system.time(a), cen::exception);
+
+  ASSERT_EQ(2u, system.size());
+  ASSERT_EQ(2.0f, system.position(b).x());
+  ASSERT_EQ(3.0f, system.position(c).x());
+
+  const auto d = system.play(clip);
+  ASSERT_EQ(a.index(), d.index());
+  ASSERT_NE(a, d);
+
+  system.clear();
+  ASSERT_TRUE(system.empty());
+  ASSERT_FALSE(system.contains(b));
+  ASSERT_FALSE(system.contains(cen::animation_system::instance_id {}));
+}
+
+TEST(AnimationSystem, Render)
+{
+  cen::animation_system system;
+  const auto clip = system.add_clip(make_clip(3, true));
+
+  system.play(clip, {5, 6});
+  system.play(clip, {7, 8});
+  system.update(0.5f);
+
+  cen::sprite_batch batch;
+  system.render(batch, 2);
+  ASSERT_EQ(2u, batch.size());
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
@@ -0,0 +1,118 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/camera.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>     // array
+#include <iostream>  // cout
+#include <vector>    // vector
+
+TEST(Camera, Construction)
+{
+  const cen::camera identity {cen::farea {800, 600}};
+  ASSERT_EQ(cen::frect(0, 0, 800, 600), identity.view());
+  ASSERT_FLOAT_EQ(1, identity.scale_x());
+  ASSERT_FLOAT_EQ(1, identity.scale_y());
+
+  const cen::camera zoomed {{100, 50, 400, 300}, {800, 600}};
+  ASSERT_FLOAT_EQ(2, zoomed.scale_x());
+  ASSERT_FLOAT_EQ(2, zoomed.scale_y());
+  ASSERT_EQ(cen::fpoint(100, 50), zoomed.position());
+
+  const cen::camera empty {{0, 0, 0, 0}, {800, 600}};
+  ASSERT_FLOAT_EQ(0, empty.scale_x());
+}
+
+TEST(Camera, Movement)
+{
+  cen::camera camera {{0, 0, 100, 50}, {200, 100}};
+
+  camera.move_by({10, 20});
+  ASSERT_EQ(cen::fpoint(10, 20), camera.position());
+
+  camera.center_on({500, 500});
+  ASSERT_EQ(cen::fpoint(450, 475), camera.position());
+
+  camera.set_position({0, 0});
+  ASSERT_EQ(cen::fpoint(0, 0), camera.position());
+}
+
+TEST(Camera, Visible)
+{
+  const cen::camera camera {{100, 100, 200, 100}, {400, 200}};
+
+  ASSERT_TRUE(camera.visible(cen::frect {150, 150, 10, 10}));
+  ASSERT_TRUE(camera.visible(cen::frect {90, 90, 20, 20}));
+  ASSERT_FALSE(camera.visible(cen::frect {0, 0, 100, 100}));
+  ASSERT_FALSE(camera.visible(cen::frect {300, 100, 10, 10}));
+
+  ASSERT_TRUE(camera.visible(cen::fpoint {200, 150}));
+  ASSERT_FALSE(camera.visible(cen::fpoint {50, 150}));
+}
+
+TEST(Camera, Transforms)
+{
+  const cen::camera camera {{100, 100, 200, 100}, {400, 200}};
+
+  ASSERT_EQ(cen::fpoint(0, 0), camera.to_screen(cen::fpoint {100, 100}));
+  ASSERT_EQ(cen::frect(20, 40, 20, 10), camera.to_screen(cen::frect {110, 120, 10, 5}));
+  ASSERT_EQ(cen::fpoint(110, 120), camera.to_world(camera.to_screen(cen::fpoint {110, 120})));
+
+  std::array<cen::frect, 2> rects {cen::frect {100, 100, 1, 1}, cen::frect {150, 125, 2, 2}};
+  camera.to_screen(rects.data(), rects.data(), rects.size());
+
+  ASSERT_EQ(cen::frect(0, 0, 2, 2), rects[0]);
+  ASSERT_EQ(cen::frect(100, 50, 4, 4), rects[1]);
+}
+
+TEST(Camera, Cull)
+{
+  const cen::camera camera {{0, 0, 100, 100}, {200, 200}};
+  const std::vector<cen::frect> rects {{10, 10, 5, 5},
+                                       {200, 200, 5, 5},
+                                       {-10, 50, 20, 5},
+                                       {-50, -50, 10, 10}};
+
+  std::vector<cen::usize> indices;
+  camera.cull(rects, indices);
+  ASSERT_EQ((std::vector<cen::usize> {0, 2}), indices);
+
+  std::array<cen::frect, 4> out;
+  std::array<cen::usize, 4> visible;
+  const auto count =
+      camera.cull_to_screen(rects.data(), rects.size(), out.data(), visible.data());
+
+  ASSERT_EQ(2u, count);
+  ASSERT_EQ(cen::frect(20, 20, 10, 10), out[0]);
+  ASSERT_EQ(cen::frect(-20, 100, 40, 10), out[1]);
+  ASSERT_EQ(2u, visible[1]);
+}
+
+TEST(Camera, ToString)
+{
+  const cen::camera camera {{1, 2, 3, 4}, {5, 6}};
+  std::cout << camera << '\n';
+}
@@ -0,0 +1,113 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/damage_tracker.hpp"
+
+#include <gtest/gtest.h>
+
+#include "centurion/video/window.hpp"
+
+TEST(DamageTracker, Construction)
+{
+  const cen::damage_tracker tracker {{800, 600}, 0};
+  ASSERT_EQ(1u, tracker.max_rects());
+  ASSERT_EQ(1u, tracker.count());
+  ASSERT_EQ(cen::irect(0, 0, 800, 600), tracker.rects().front());
+  ASSERT_EQ(800 * 600, tracker.damaged_area());
+
+  const cen::damage_tracker empty {{0, 0}};
+  ASSERT_TRUE(empty.empty());
+}
+
+TEST(DamageTracker, Add)
+{
+  cen::damage_tracker tracker {{100, 100}};
+  tracker.clear();
+  ASSERT_TRUE(tracker.empty());
+
+  tracker.add({-10, -10, 20, 20});
+  ASSERT_EQ(1u, tracker.count());
+  ASSERT_EQ(cen::irect(0, 0, 10, 10), tracker.rects().front());
+
+  tracker.add({200, 200, 10, 10});
+  tracker.add({50, 50, 0, 10});
+  ASSERT_EQ(1u, tracker.count());
+
+  tracker.add({50, 50, 10, 10});
+  ASSERT_EQ(2u, tracker.count());
+  ASSERT_EQ(200, tracker.damaged_area());
+
+  /* Touching both areas merges all of them into one */
+  tracker.add({5, 5, 50, 50});
+  ASSERT_EQ(1u, tracker.count());
+  ASSERT_EQ(cen::irect(0, 0, 60, 60), tracker.rects().front());
+}
+
+TEST(DamageTracker, MaxRects)
+{
+  cen::damage_tracker tracker {{100, 100}, 2};
+  tracker.clear();
+
+  tracker.add({0, 0, 5, 5});
+  tracker.add({20, 20, 5, 5});
+  ASSERT_EQ(2u, tracker.count());
+
+  tracker.add({90, 90, 10, 10});
+  ASSERT_EQ(1u, tracker.count());
+  ASSERT_EQ(cen::irect(0, 0, 100, 100), tracker.rects().front());
+}
+
+TEST(DamageTracker, Resize)
+{
+  cen::damage_tracker tracker {{100, 100}};
+  tracker.clear();
+
+  tracker.resize({40, 30});
+  ASSERT_EQ((cen::iarea {40, 30}), tracker.bounds());
+  ASSERT_EQ(cen::irect(0, 0, 40, 30), tracker.rects().front());
+}
+
+TEST(DamageTracker, Redraw)
+{
+  cen::window window;
+  auto renderer = window.make_renderer();
+
+  cen::damage_tracker tracker {window.size()};
+  tracker.clear();
+  tracker.add({10, 10, 20, 20});
+  tracker.add({100, 100, 20, 20});
+
+  ASSERT_TRUE(renderer.set_clip({0, 0, 50, 50}));
+
+  int calls = 0;
+  ASSERT_TRUE(tracker.redraw(renderer, [&](const cen::irect& area) {
+    ASSERT_EQ(area, renderer.clip());
+    renderer.fill_with(cen::colors::red);
+    ++calls;
+  }));
+
+  ASSERT_EQ(2, calls);
+  ASSERT_EQ(cen::irect(0, 0, 50, 50), renderer.clip());
+  ASSERT_EQ(2u, tracker.count());
+}
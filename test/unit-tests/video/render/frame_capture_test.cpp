@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/frame_capture.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>  // atomic
+#include <memory>  // unique_ptr
+#include <vector>  // vector
+
+#include "centurion/video/window.hpp"
+
+class FrameCaptureTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(FrameCaptureTest, Defaults)
+{
+  cen::thread_pool pool {1};
+  const cen::frame_capture capture {pool, [](const cen::surface&, cen::uint64) {}};
+
+  ASSERT_EQ(0u, capture.count());
+  ASSERT_EQ(2u, capture.latency());
+  ASSERT_EQ(cen::pixel_format::argb8888, capture.format());
+
+  ASSERT_THROW(cen::frame_capture(pool, nullptr), cen::exception);
+  const cen::frame_capture minimal {pool, [](const cen::surface&, cen::uint64) {}, 0};
+  ASSERT_EQ(1u, minimal.latency());
+}
+
+TEST_F(FrameCaptureTest, Capture)
+{
+  constexpr cen::uint64 frames = 10;
+
+  cen::thread_pool pool {2};
+
+  std::vector<std::atomic<cen::uint32>> pixels(frames);
+  std::atomic<cen::uint64> calls {};
+
+  const cen::pixel_format_info info {cen::pixel_format::argb8888};
+  const auto size = mRenderer->output_size();
+
+  {
+    cen::frame_capture capture {pool, [&](const cen::surface& frame, const cen::uint64 index) {
+                                  ASSERT_EQ(size, frame.size());
+                                  ASSERT_LT(index, frames);
+
+                                  const auto* data =
+                                      static_cast<const cen::uint32*>(frame.pixel_data());
+                                  pixels[index] = data[0];
+                                  ++calls;
+                                }};
+
+    for (cen::uint64 index = 0; index < frames; ++index) {
+      const auto red = static_cast<cen::uint8>(index * 20u);
+      mRenderer->clear_with(cen::color {red, 0, 0});
+      ASSERT_EQ(cen::success, capture.capture(*mRenderer));
+      mRenderer->present();
+    }
+
+    capture.flush(*mRenderer);
+    ASSERT_EQ(frames, capture.count());
+    ASSERT_EQ(frames, calls);
+  }
+
+  for (cen::uint64 index = 0; index < frames; ++index) {
+    const auto red = static_cast<cen::uint8>(index * 20u);
+    ASSERT_EQ(info.rgba_to_pixel(cen::color {red, 0, 0}), pixels[index]);
+  }
+}
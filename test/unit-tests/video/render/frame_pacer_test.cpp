@@ -0,0 +1,149 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/frame_pacer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+
+#include "centurion/system/timer.hpp"
+
+namespace {
+
+/* Records frames that are presented with a fixed interval, expressed in refresh periods */
+void simulate(cen::frame_pacer& pacer, const cen::usize frames, const double periods)
+{
+  const auto period = static_cast<double>(cen::frequency()) / pacer.refresh_rate();
+  const auto interval = static_cast<cen::uint64>(period * periods);
+
+  static cen::uint64 time = 1'000;
+  for (cen::usize index = 0; index < frames; ++index) {
+    time += interval;
+    pacer.record(time, time + 10);
+  }
+}
+
+}  // namespace
+
+TEST(FramePacer, Defaults)
+{
+  const cen::frame_pacer pacer;
+  ASSERT_EQ(cen::pacing_mode::vsync, pacer.mode());
+  ASSERT_EQ(60.0, pacer.refresh_rate());
+  ASSERT_EQ(0u, pacer.frame_count());
+  ASSERT_EQ(0u, pacer.missed_frames());
+
+  cen::frame_pacer_options options;
+  options.refresh_rate = 0;
+  ASSERT_THROW(cen::frame_pacer {options}, cen::exception);
+}
+
+TEST(FramePacer, MissedFrames)
+{
+  cen::frame_pacer_options options;
+  options.window = 1'000;
+
+  cen::frame_pacer pacer {options};
+
+  simulate(pacer, 5, 1.0);
+  ASSERT_EQ(4u, pacer.frame_count());
+  ASSERT_EQ(0u, pacer.missed_frames());
+
+  simulate(pacer, 2, 2.0);
+  ASSERT_EQ(6u, pacer.frame_count());
+  ASSERT_EQ(2u, pacer.missed_frames());
+
+  ASSERT_NEAR(2.0 / 60.0, pacer.frame_time().count(), 0.001);
+}
+
+TEST(FramePacer, LateSwapTear)
+{
+  cen::frame_pacer_options options;
+  options.window = 10;
+
+  {
+    cen::frame_pacer pacer {options};
+    simulate(pacer, 20, 2.0);
+    ASSERT_EQ(cen::pacing_mode::late_swap_tear, pacer.mode());
+  }
+
+  {
+    options.allow_tearing = false;
+
+    cen::frame_pacer pacer {options};
+    simulate(pacer, 20, 2.0);
+    ASSERT_EQ(cen::pacing_mode::vsync, pacer.mode());
+  }
+}
+
+TEST(FramePacer, Limiter)
+{
+  cen::frame_pacer_options options;
+  options.window = 10;
+
+  cen::frame_pacer pacer {options};
+
+  /* Frames that are presented faster than the refresh rate mean that vsync is off */
+  simulate(pacer, 20, 0.25);
+  ASSERT_EQ(cen::pacing_mode::limiter, pacer.mode());
+  ASSERT_EQ(0u, pacer.missed_frames());
+}
+
+TEST(FramePacer, SetRefreshRate)
+{
+  cen::frame_pacer_options options;
+  options.window = 10;
+
+  cen::frame_pacer pacer {options};
+  ASSERT_THROW(pacer.set_refresh_rate(0), cen::exception);
+
+  simulate(pacer, 20, 0.25);
+  ASSERT_EQ(cen::pacing_mode::limiter, pacer.mode());
+
+  /* Changing the rate starts over with the initial strategy */
+  pacer.set_refresh_rate(30);
+  ASSERT_EQ(30.0, pacer.refresh_rate());
+  ASSERT_EQ(cen::pacing_mode::vsync, pacer.mode());
+
+  simulate(pacer, 20, 1.0);
+  ASSERT_EQ(cen::pacing_mode::vsync, pacer.mode());
+}
+
+TEST(FramePacer, ToString)
+{
+  const cen::frame_pacer pacer;
+  std::cout << pacer << '\n';
+}
+
+TEST(PacingMode, ToString)
+{
+  ASSERT_THROW(cen::to_string(static_cast<cen::pacing_mode>(3)), cen::exception);
+
+  ASSERT_EQ("vsync", cen::to_string(cen::pacing_mode::vsync));
+  ASSERT_EQ("late_swap_tear", cen::to_string(cen::pacing_mode::late_swap_tear));
+  ASSERT_EQ("limiter", cen::to_string(cen::pacing_mode::limiter));
+
+  std::cout << "pacing_mode::vsync == " << cen::pacing_mode::vsync << '\n';
+}
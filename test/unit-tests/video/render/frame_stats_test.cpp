@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/frame_stats.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>   // cout
+#include <stdexcept>  // out_of_range
+
+TEST(FrameStats, Defaults)
+{
+  const cen::frame_stats stats;
+  ASSERT_EQ(120u, stats.window());
+  ASSERT_EQ(0u, stats.sample_count());
+  ASSERT_EQ(0u, stats.frame_count());
+  ASSERT_EQ(0.0, stats.latest(cen::frame_metric::frame_time));
+  ASSERT_EQ(0.0, stats.summary(cen::frame_metric::frame_time).max);
+  ASSERT_THROW((void) stats.at(0, cen::frame_metric::frame_time), std::out_of_range);
+
+  ASSERT_THROW(cen::frame_stats {0}, cen::exception);
+}
+
+TEST(FrameStats, FrameTime)
+{
+  cen::frame_stats stats;
+  const auto ticksPerMilli = cen::frequency() / 1'000;
+
+  // The first frame only starts the measurements
+  stats.begin_frame(ticksPerMilli * 10);
+  ASSERT_EQ(0u, stats.frame_count());
+
+  stats.begin_frame(ticksPerMilli * 26);
+  stats.begin_frame(ticksPerMilli * 60);
+
+  ASSERT_EQ(2u, stats.frame_count());
+  ASSERT_NEAR(16.0, stats.at(0, cen::frame_metric::frame_time), 0.01);
+  ASSERT_NEAR(34.0, stats.latest(cen::frame_metric::frame_time), 0.01);
+}
+
+TEST(FrameStats, Counters)
+{
+  cen::frame_stats stats {4};
+  stats.begin_frame(0);
+
+  for (int frame = 1; frame <= 6; ++frame) {
+    stats.record(cen::frame_metric::draw_calls, frame * 10);
+    stats.record(cen::frame_metric::draw_calls, 1);
+    stats.begin_frame(static_cast<cen::uint64>(frame));
+  }
+
+  // Only the last four frames are kept
+  ASSERT_EQ(6u, stats.frame_count());
+  ASSERT_EQ(4u, stats.sample_count());
+  ASSERT_EQ(31.0, stats.at(0, cen::frame_metric::draw_calls));
+  ASSERT_EQ(61.0, stats.at(3, cen::frame_metric::draw_calls));
+
+  const auto summary = stats.summary(cen::frame_metric::draw_calls);
+  ASSERT_EQ(31.0, summary.min);
+  ASSERT_EQ(46.0, summary.mean);
+  ASSERT_EQ(61.0, summary.p99);
+  ASSERT_EQ(61.0, summary.max);
+
+  ASSERT_EQ(0.0, stats.latest(cen::frame_metric::texture_binds));
+
+  stats.reset();
+  ASSERT_EQ(0u, stats.sample_count());
+  ASSERT_EQ(0u, stats.frame_count());
+}
+
+TEST(FrameStats, RenderCounters)
+{
+  cen::frame_stats stats;
+  stats.begin_frame(0);
+
+  cen::render_counters counters;
+  counters.draw_calls = 3;
+  counters.copies = 5;
+  counters.geometry_calls = 2;
+  counters.texture_binds = 4;
+
+  stats.record(counters);
+  stats.record(counters);
+  stats.begin_frame(1);
+
+  ASSERT_EQ(20.0, stats.latest(cen::frame_metric::draw_calls));
+  ASSERT_EQ(8.0, stats.latest(cen::frame_metric::texture_binds));
+}
+
+TEST(FrameStats, Percentile)
+{
+  cen::frame_stats stats {200};
+  stats.begin_frame(0);
+
+  for (int frame = 1; frame <= 200; ++frame) {
+    stats.record(cen::frame_metric::submit_time, frame);
+    stats.begin_frame(static_cast<cen::uint64>(frame));
+  }
+
+  ASSERT_EQ(198.0, stats.summary(cen::frame_metric::submit_time).p99);
+}
+
+TEST(FrameStats, PhaseTimer)
+{
+  cen::frame_stats stats;
+  stats.begin_frame();
+
+  {
+    const auto timer = stats.time(cen::frame_metric::event_time);
+  }
+
+  stats.begin_frame();
+  ASSERT_LE(0.0, stats.latest(cen::frame_metric::event_time));
+  ASSERT_LE(stats.latest(cen::frame_metric::event_time),
+            stats.latest(cen::frame_metric::frame_time));
+}
+
+TEST(FrameStats, ToString)
+{
+  ASSERT_EQ("draw_calls", cen::to_string(cen::frame_metric::draw_calls));
+  std::cout << cen::frame_stats {} << '\n';
+}
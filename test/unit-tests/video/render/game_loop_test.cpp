@@ -0,0 +1,120 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/game_loop.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+
+#include "centurion/system/timer.hpp"
+
+TEST(GameLoop, Defaults)
+{
+  const cen::game_loop loop;
+  ASSERT_EQ(60.0, loop.tick_rate());
+  ASSERT_EQ(0u, loop.tick_count());
+  ASSERT_EQ(0u, loop.dropped_ticks());
+  ASSERT_FALSE(loop.is_running());
+  ASSERT_NEAR(1.0 / 60.0, loop.tick_duration().count(), 0.0001);
+
+  cen::game_loop_options options;
+  options.tick_rate = 0;
+  ASSERT_THROW(cen::game_loop {options}, cen::exception);
+}
+
+TEST(GameLoop, Advance)
+{
+  cen::game_loop loop;
+
+  const auto step = static_cast<cen::uint64>(static_cast<double>(cen::frequency()) / 60.0);
+  auto time = cen::uint64 {1'000};
+
+  /* The first call only establishes the starting point */
+  ASSERT_EQ(0u, loop.advance(time));
+  ASSERT_EQ(0.0, loop.alpha());
+
+  time += step;
+  ASSERT_EQ(1u, loop.advance(time));
+
+  time += step / 2u;
+  ASSERT_EQ(0u, loop.advance(time));
+  ASSERT_NEAR(0.5, loop.alpha(), 0.01);
+
+  time += 2u * step;
+  ASSERT_EQ(2u, loop.advance(time));
+  ASSERT_NEAR(0.5, loop.alpha(), 0.01);
+
+  ASSERT_EQ(3u, loop.tick_count());
+  ASSERT_EQ(0u, loop.dropped_ticks());
+}
+
+TEST(GameLoop, SpiralOfDeathProtection)
+{
+  cen::game_loop_options options;
+  options.max_ticks_per_frame = 4;
+
+  cen::game_loop loop {options};
+
+  const auto step = static_cast<cen::uint64>(static_cast<double>(cen::frequency()) / 60.0);
+
+  ASSERT_EQ(0u, loop.advance(1'000));
+  ASSERT_EQ(4u, loop.advance(1'000 + (10u * step)));
+
+  ASSERT_EQ(4u, loop.tick_count());
+  ASSERT_EQ(6u, loop.dropped_ticks());
+  ASSERT_LT(loop.alpha(), 1.0);
+}
+
+TEST(GameLoop, Run)
+{
+  cen::game_loop loop;
+
+  int inputs = 0;
+  int frames = 0;
+
+  loop.run([&] { ++inputs; },
+           [&](const cen::seconds<double> step) {
+             ASSERT_EQ(loop.tick_duration(), step);
+             ASSERT_TRUE(loop.is_running());
+           },
+           [&](const double alpha) {
+             ASSERT_GE(alpha, 0.0);
+             ASSERT_LT(alpha, 1.0);
+
+             if (++frames == 3) {
+               loop.stop();
+             }
+           });
+
+  ASSERT_EQ(3, inputs);
+  ASSERT_EQ(3, frames);
+  ASSERT_FALSE(loop.is_running());
+}
+
+TEST(GameLoop, ToString)
+{
+  const cen::game_loop loop;
+  std::cout << loop << '\n';
+}
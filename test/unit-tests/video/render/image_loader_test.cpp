@@ -0,0 +1,120 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/image_loader.hpp"
+
+#include <gtest/gtest.h>
+
+#include <map>     // map
+#include <memory>  // unique_ptr
+
+#include "centurion/video/window.hpp"
+
+class ImageLoaderTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  static void wait_until_decoded(const cen::image_loader& loader)
+  {
+    while (loader.decoding() != 0) {
+      SDL_Delay(1);
+    }
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(ImageLoaderTest, Upload)
+{
+  cen::thread_pool pool {2};
+  cen::image_loader loader {pool};
+  ASSERT_TRUE(loader.idle());
+
+  const auto a = loader.load("resources/panda.png");
+  const auto b = loader.load("resources/this_image_does_not_exist.png");
+  ASSERT_NE(a, b);
+
+  wait_until_decoded(loader);
+  ASSERT_EQ(2u, loader.ready());
+
+  std::map<cen::image_loader::id_type, bool> results;
+  const auto callback = [&](const auto id, const cen::maybe<cen::texture>& texture) {
+    results[id] = texture.has_value();
+  };
+
+  const auto count = loader.upload(*mRenderer, cen::millis<double> {1'000}, callback);
+
+  ASSERT_EQ(2u, count);
+  ASSERT_TRUE(results.at(a));
+  ASSERT_FALSE(results.at(b));
+  ASSERT_TRUE(loader.idle());
+}
+
+TEST_F(ImageLoaderTest, UploadBudget)
+{
+  cen::thread_pool pool {2};
+  cen::image_loader loader {pool};
+
+  for (int index = 0; index < 3; ++index) {
+    loader.load("resources/panda.png");
+  }
+
+  wait_until_decoded(loader);
+
+  /* At least one image is always uploaded, even with an empty budget */
+  const auto count = loader.upload(*mRenderer, cen::millis<double> {0}, [](auto, auto) {});
+  ASSERT_EQ(1u, count);
+  ASSERT_EQ(2u, loader.ready());
+}
+
+TEST_F(ImageLoaderTest, PollWithConversion)
+{
+  cen::thread_pool pool {2};
+  cen::image_loader loader {pool, cen::pixel_format::rgba32};
+  ASSERT_EQ(cen::pixel_format::rgba32, loader.format());
+
+  const auto id = loader.load("resources/panda.png");
+  wait_until_decoded(loader);
+
+  const auto callback = [&](const auto imageId, const cen::maybe<cen::surface>& image) {
+    ASSERT_EQ(id, imageId);
+    ASSERT_TRUE(image);
+    ASSERT_EQ(cen::pixel_format::rgba32, image->format_info().format());
+  };
+
+  const auto count = loader.poll(callback);
+
+  ASSERT_EQ(1u, count);
+}
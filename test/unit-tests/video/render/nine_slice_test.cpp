@@ -0,0 +1,181 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/nine_slice.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+#include <vector>    // vector
+
+#include "centurion/video/window.hpp"
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+class NineSliceTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+    mTexture = std::make_unique<cen::texture>(mRenderer->make_texture("resources/panda.png"));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mTexture.reset();
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  inline static std::unique_ptr<cen::texture> mTexture;
+};
+
+TEST_F(NineSliceTest, Construction)
+{
+  ASSERT_THROW(cen::nine_slice(*mTexture, cen::nine_slice_insets {-1, 0, 0, 0}),
+               cen::exception);
+  ASSERT_THROW(cen::nine_slice(*mTexture, cen::nine_slice_insets {100, 0, 101, 0}),
+               cen::exception);
+  ASSERT_THROW(cen::nine_slice(*mTexture, cen::nine_slice_insets {0, 75, 0, 76}),
+               cen::exception);
+
+  const cen::nine_slice slice {*mTexture, {10, 20, 100, 50}, {8, 4, 12, 6}};
+  ASSERT_EQ(mTexture->get(), slice.get());
+  ASSERT_EQ(cen::nine_slice_fill::stretch, slice.edge_fill());
+  ASSERT_EQ(cen::nine_slice_fill::stretch, slice.center_fill());
+
+  const auto& sources = slice.sources();
+  ASSERT_EQ(cen::frect(10, 20, 8, 4), sources.at(0));
+  ASSERT_EQ(cen::frect(18, 20, 80, 4), sources.at(1));
+  ASSERT_EQ(cen::frect(98, 20, 12, 4), sources.at(2));
+  ASSERT_EQ(cen::frect(10, 24, 8, 40), sources.at(3));
+  ASSERT_EQ(cen::frect(18, 24, 80, 40), sources.at(4));
+  ASSERT_EQ(cen::frect(98, 64, 12, 6), sources.at(8));
+}
+
+TEST_F(NineSliceTest, Stretch)
+{
+  const cen::nine_slice slice {*mTexture, {8, 8, 8, 8}};
+
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+  slice.append({0, 0, 300, 100}, vertices, indices);
+
+  ASSERT_EQ(9u, slice.quad_count({0, 0, 300, 100}));
+  ASSERT_EQ(36u, vertices.size());
+  ASSERT_EQ(54u, indices.size());
+
+  /* Top-left corner */
+  ASSERT_FLOAT_EQ(0, vertices.at(0).position.x);
+  ASSERT_FLOAT_EQ(8, vertices.at(2).position.x);
+  ASSERT_FLOAT_EQ(8, vertices.at(2).position.y);
+  ASSERT_FLOAT_EQ(8.0f / 200.0f, vertices.at(2).tex_coord.x);
+  ASSERT_FLOAT_EQ(8.0f / 150.0f, vertices.at(2).tex_coord.y);
+
+  /* Bottom-right corner */
+  ASSERT_FLOAT_EQ(300, vertices.at(34).position.x);
+  ASSERT_FLOAT_EQ(100, vertices.at(34).position.y);
+  ASSERT_FLOAT_EQ(1, vertices.at(34).tex_coord.x);
+  ASSERT_FLOAT_EQ(1, vertices.at(34).tex_coord.y);
+
+  ASSERT_EQ(32, indices.back());
+}
+
+TEST_F(NineSliceTest, SmallDestination)
+{
+  const cen::nine_slice slice {*mTexture, {10, 10, 10, 10}};
+
+  /* The corners are scaled down, and the edges and center are skipped */
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+  slice.append({0, 0, 10, 40}, vertices, indices);
+
+  ASSERT_EQ(6u, slice.quad_count({0, 0, 10, 40}));
+  ASSERT_FLOAT_EQ(5, vertices.at(2).position.x);
+  ASSERT_FLOAT_EQ(10, vertices.at(2).position.y);
+}
+
+TEST_F(NineSliceTest, Tile)
+{
+  /* The horizontal edges are 180 pixels wide, the vertical edges are 130 pixels high */
+  const cen::nine_slice slice {*mTexture,
+                               {10, 10, 10, 10},
+                               cen::nine_slice_fill::tile,
+                               cen::nine_slice_fill::stretch};
+  ASSERT_EQ(cen::nine_slice_fill::tile, slice.edge_fill());
+
+  /* 2 tiles per horizontal edge, 3 tiles per vertical edge */
+  const cen::frect destination {0, 0, 300, 300};
+  ASSERT_EQ(4u + 2u * 2u + 2u * 3u + 1u, slice.quad_count(destination));
+
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+  slice.append(destination, vertices, indices);
+
+  /* The second top tile is cropped to 100 pixels */
+  const auto* tile = vertices.data() + 8;
+  ASSERT_FLOAT_EQ(190, tile[0].position.x);
+  ASSERT_FLOAT_EQ(290, tile[1].position.x);
+  ASSERT_FLOAT_EQ(10.0f / 200.0f, tile[0].tex_coord.x);
+  ASSERT_FLOAT_EQ(110.0f / 200.0f, tile[1].tex_coord.x);
+
+  const cen::nine_slice tiled {*mTexture,
+                               {10, 10, 10, 10},
+                               cen::nine_slice_fill::tile,
+                               cen::nine_slice_fill::tile};
+  ASSERT_EQ(4u + 2u * 2u + 2u * 3u + 2u * 3u, tiled.quad_count(destination));
+}
+
+TEST_F(NineSliceTest, Batching)
+{
+  cen::nine_slice slice {*mTexture, {8, 8, 8, 8}, cen::nine_slice_fill::tile};
+
+  cen::sprite_batch batch;
+  for (int i = 0; i < 10; ++i) {
+    slice.add_to(batch, {20.0f * i, 0, 300, 100});
+  }
+
+  ASSERT_EQ(10u * slice.quad_count({0, 0, 300, 100}), batch.size());
+  ASSERT_EQ(cen::success, batch.flush(*mRenderer));
+  ASSERT_EQ(1u, batch.draw_calls());
+
+  ASSERT_EQ(cen::success, slice.render(*mRenderer, {0, 0, 300, 100}));
+}
+
+TEST_F(NineSliceTest, ToString)
+{
+  ASSERT_EQ("stretch", cen::to_string(cen::nine_slice_fill::stretch));
+  ASSERT_EQ("tile", cen::to_string(cen::nine_slice_fill::tile));
+
+  const cen::nine_slice slice {*mTexture, {1, 2, 3, 4}};
+  ASSERT_EQ("nine_slice(left: 1, top: 2, right: 3, bottom: 4)", cen::to_string(slice));
+
+  std::cout << slice << '\n';
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
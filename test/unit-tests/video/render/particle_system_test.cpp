@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/particle_system.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+namespace {
+
+[[nodiscard]] auto make_particle(const float x, const float lifetime) -> cen::particle
+{
+  return {{x, 2 * x}, {1, -1}, lifetime, 4};
+}
+
+}  // namespace
+
+TEST(ParticleSystem, IntegrateMatchesScalar)
+{
+  constexpr cen::usize count = 19;
+
+  std::vector<float> x(count), y(count), vx(count), vy(count), age(count);
+  for (cen::usize index = 0; index < count; ++index) {
+    x[index] = static_cast<float>(index);
+    y[index] = static_cast<float>(index) * 0.5f;
+    vx[index] = 3;
+    vy[index] = -2;
+  }
+
+  auto x2 = x, y2 = y, vx2 = vx, vy2 = vy, age2 = age;
+
+  const cen::detail::particle_arrays simd {x.data(),
+                                           y.data(),
+                                           vx.data(),
+                                           vy.data(),
+                                           age.data()};
+  const cen::detail::particle_arrays scalar {x2.data(),
+                                             y2.data(),
+                                             vx2.data(),
+                                             vy2.data(),
+                                             age2.data()};
+
+  cen::detail::integrate_n(simd, count, 0.5f, 1.0f, 0.9f, 0.1f);
+  cen::detail::integrate_scalar(scalar, 0, count, 0.5f, 1.0f, 0.9f, 0.1f);
+
+  for (cen::usize index = 0; index < count; ++index) {
+    ASSERT_FLOAT_EQ(x2[index], x[index]);
+    ASSERT_FLOAT_EQ(y2[index], y[index]);
+    ASSERT_FLOAT_EQ(vx2[index], vx[index]);
+    ASSERT_FLOAT_EQ(vy2[index], vy[index]);
+    ASSERT_FLOAT_EQ(age2[index], age[index]);
+  }
+
+  ASSERT_FLOAT_EQ((3 + 0.5f) * 0.9f, vx.front());
+  ASSERT_FLOAT_EQ(0.1f, age.back());
+}
+
+TEST(ParticleSystem, Update)
+{
+  cen::particle_system system;
+  ASSERT_TRUE(system.empty());
+
+  system.set_acceleration({0, 10});
+  system.emit(make_particle(0, 1));
+
+  system.update(0.5f);
+  ASSERT_EQ(1u, system.size());
+  ASSERT_FLOAT_EQ(0.5f, system.age()[0]);
+  ASSERT_FLOAT_EQ(0.5f, system.x()[0]);
+  ASSERT_FLOAT_EQ((-1 + 5) * 0.5f, system.y()[0]);
+}
+
+TEST(ParticleSystem, RemovesDeadParticles)
+{
+  cen::particle_system system;
+  system.emit(make_particle(1, 0.25f));
+  system.emit(make_particle(2, 1));
+  system.emit(make_particle(3, 0.25f));
+  system.emit(make_particle(4, 1));
+
+  system.update(0.5f);
+  ASSERT_EQ(2u, system.size());
+
+  /* The survivors are the second and fourth particles, in any order */
+  const auto first = system.x()[0];
+  const auto second = system.x()[1];
+  ASSERT_FLOAT_EQ(2 + 4 + 1.0f, first + second);
+
+  system.update(1);
+  ASSERT_TRUE(system.empty());
+}
+
+TEST(ParticleSystem, Drag)
+{
+  cen::particle_system system;
+  system.set_drag(2);
+  ASSERT_FLOAT_EQ(2, system.drag());
+
+  /* A damping factor that would be negative is clamped to zero */
+  system.emit(make_particle(0, 10));
+  system.update(1);
+  ASSERT_FLOAT_EQ(0, system.x()[0]);
+}
+
+TEST(ParticleSystem, UpdateWithThreadPool)
+{
+  cen::particle_system serial;
+  cen::particle_system parallel;
+  serial.set_acceleration({3, 4});
+  parallel.set_acceleration({3, 4});
+
+  for (auto index = 0; index < 1'000; ++index) {
+    const auto particle = make_particle(static_cast<float>(index), 100);
+    serial.emit(particle);
+    parallel.emit(particle);
+  }
+
+  cen::thread_pool pool {2};
+
+  serial.update(0.1f);
+  parallel.update(0.1f, pool, 64);
+
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (cen::usize index = 0; index < serial.size(); ++index) {
+    ASSERT_FLOAT_EQ(serial.x()[index], parallel.x()[index]);
+    ASSERT_FLOAT_EQ(serial.y()[index], parallel.y()[index]);
+  }
+
+  parallel.build_geometry(pool, 64);
+  ASSERT_EQ(4'000u, parallel.vertices().size());
+  ASSERT_EQ(6'000u, parallel.indices().size());
+  ASSERT_EQ(3'996, parallel.indices()[5'994]);
+}
+
+TEST(ParticleSystem, Quads)
+{
+  const float x[] {10, 20};
+  const float y[] {10, 30};
+  const float size[] {4, 2};
+  const float age[] {0, 0.5f};
+  const float lifetime[] {1, 1};
+  const SDL_Color tint[] {{255, 255, 255, 255}, {255, 0, 0, 200}};
+  const SDL_FRect uv {0, 0, 1, 1};
+
+  SDL_Vertex vertices[8] {};
+  int indices[12] {};
+  cen::detail::particle_quads(x,
+                              y,
+                              size,
+                              age,
+                              lifetime,
+                              tint,
+                              0,
+                              2,
+                              uv,
+                              true,
+                              vertices,
+                              indices);
+
+  ASSERT_FLOAT_EQ(8, vertices[0].position.x);
+  ASSERT_FLOAT_EQ(8, vertices[0].position.y);
+  ASSERT_FLOAT_EQ(12, vertices[2].position.x);
+  ASSERT_FLOAT_EQ(12, vertices[2].position.y);
+  ASSERT_FLOAT_EQ(1, vertices[2].tex_coord.x);
+  ASSERT_FLOAT_EQ(1, vertices[2].tex_coord.y);
+  ASSERT_EQ(255, vertices[0].color.a);
+
+  ASSERT_FLOAT_EQ(19, vertices[4].position.x);
+  ASSERT_FLOAT_EQ(31, vertices[6].position.y);
+  ASSERT_EQ(100, vertices[4].color.a);
+
+  const int expected[] {0, 1, 2, 2, 3, 0, 4, 5, 6, 6, 7, 4};
+  for (auto index = 0; index < 12; ++index) {
+    ASSERT_EQ(expected[index], indices[index]);
+  }
+}
+
+TEST(ParticleSystem, Clear)
+{
+  cen::particle_system system {16};
+  system.emit(make_particle(0, 1));
+  system.emit(make_particle(1, 1));
+
+  system.clear();
+  ASSERT_TRUE(system.empty());
+  ASSERT_EQ(0u, system.size());
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
@@ -0,0 +1,148 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/pixel_pipeline.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+
+#include "centurion/video/window.hpp"
+
+#if SDL_VERSION_ATLEAST(2, 0, 12)
+
+TEST(UpscaleLayout, Integer)
+{
+  const auto layout =
+      cen::make_upscale_layout({320, 180}, {1920, 1200}, cen::upscale_mode::integer);
+
+  ASSERT_EQ(6, layout.prescale);
+  ASSERT_FLOAT_EQ(6, layout.scale());
+  ASSERT_EQ(cen::irect(0, 60, 1920, 1080), layout.destination);
+
+  /* The scale never goes below one */
+  const auto small =
+      cen::make_upscale_layout({320, 180}, {200, 100}, cen::upscale_mode::integer);
+  ASSERT_EQ(1, small.prescale);
+  ASSERT_EQ(cen::irect(-60, -40, 320, 180), small.destination);
+
+  const auto empty = cen::make_upscale_layout({320, 180}, {0, 0}, cen::upscale_mode::integer);
+  ASSERT_EQ(0, empty.destination.width());
+}
+
+TEST(UpscaleLayout, SharpBilinear)
+{
+  const auto layout =
+      cen::make_upscale_layout({320, 180}, {1000, 1000}, cen::upscale_mode::sharp_bilinear);
+
+  ASSERT_EQ(3, layout.prescale);
+  ASSERT_EQ(cen::irect(0, 218, 1000, 563), layout.destination);
+
+  const auto down =
+      cen::make_upscale_layout({320, 180}, {160, 90}, cen::upscale_mode::sharp_bilinear);
+  ASSERT_EQ(1, down.prescale);
+  ASSERT_EQ(cen::irect(0, 0, 160, 90), down.destination);
+}
+
+TEST(UpscaleLayout, Mapping)
+{
+  auto layout = cen::make_upscale_layout({320, 180}, {1920, 1200}, cen::upscale_mode::integer);
+
+  ASSERT_EQ(cen::fpoint(0, 0), layout.to_native(cen::ipoint {0, 60}));
+  ASSERT_EQ(cen::fpoint(160, 90), layout.to_native(cen::ipoint {960, 600}));
+  ASSERT_EQ(cen::fpoint(-10, -10), layout.to_native(cen::ipoint {-60, 0}));
+
+  ASSERT_EQ(cen::ipoint(960, 600), layout.from_native({160, 90}));
+
+  /* High-DPI outputs have more pixels than window coordinates */
+  layout.window_scale = {2, 2};
+  ASSERT_EQ(cen::fpoint(160, 90), layout.to_native(cen::ipoint {480, 300}));
+  ASSERT_EQ(cen::ipoint(480, 300), layout.from_native({160, 90}));
+}
+
+TEST(UpscaleLayout, ToString)
+{
+  ASSERT_EQ("integer", cen::to_string(cen::upscale_mode::integer));
+  ASSERT_EQ("sharp_bilinear", cen::to_string(cen::upscale_mode::sharp_bilinear));
+
+  const auto layout =
+      cen::make_upscale_layout({100, 100}, {200, 300}, cen::upscale_mode::integer);
+  ASSERT_EQ("upscale_layout(x: 0, y: 50, width: 200, height: 200, prescale: 2)",
+            cen::to_string(layout));
+
+  std::cout << layout << '\n';
+}
+
+class PixelPipelineTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(PixelPipelineTest, Frame)
+{
+  ASSERT_THROW(cen::pixel_pipeline(*mRenderer, {0, 180}), cen::exception);
+
+  cen::pixel_pipeline pipeline {*mRenderer, {160, 90}};
+  ASSERT_EQ(cen::upscale_mode::integer, pipeline.mode());
+  ASSERT_EQ(160, pipeline.native_size().width);
+  ASSERT_EQ(90, pipeline.native_size().height);
+  ASSERT_EQ(160, pipeline.target().width());
+  ASSERT_EQ(90, pipeline.target().height());
+
+  ASSERT_EQ(cen::success, pipeline.begin(*mRenderer));
+  ASSERT_EQ(pipeline.target().get(), mRenderer->get_target().get());
+
+  mRenderer->fill_rect(cen::irect {10, 10, 20, 20});
+
+  ASSERT_EQ(cen::success, pipeline.end(*mRenderer));
+  ASSERT_FALSE(mRenderer->get_target());
+
+  const auto& layout = pipeline.layout();
+  ASSERT_GE(layout.destination.width(), 160);
+  ASSERT_EQ(0, layout.destination.width() % 160);
+
+  pipeline.set_mode(cen::upscale_mode::sharp_bilinear);
+  ASSERT_EQ(cen::success, pipeline.begin(*mRenderer));
+  ASSERT_EQ(cen::success, pipeline.end(*mRenderer));
+
+  pipeline.set_native_size(*mRenderer, {80, 45});
+  ASSERT_EQ(80, pipeline.target().width());
+  ASSERT_EQ(45, pipeline.target().height());
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 12)
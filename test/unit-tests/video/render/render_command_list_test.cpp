@@ -0,0 +1,168 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/render_command_list.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+#include <thread>    // thread
+#include <vector>    // vector
+
+#include "centurion/video/window.hpp"
+
+class RenderCommandListTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+    mTexture = std::make_unique<cen::texture>(mRenderer->make_texture("resources/panda.png"));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mTexture.reset();
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  inline static std::unique_ptr<cen::texture> mTexture;
+};
+
+TEST_F(RenderCommandListTest, Defaults)
+{
+  const cen::render_command_list list;
+  ASSERT_TRUE(list.empty());
+  ASSERT_EQ(0u, list.size());
+}
+
+TEST_F(RenderCommandListTest, Execute)
+{
+  cen::render_command_list list;
+
+  /* Commands are recorded on another thread, but executed on the rendering thread */
+  std::thread worker {[&] {
+    list.clear_with(cen::colors::black);
+    list.set_color(cen::colors::red);
+    list.fill_rect(cen::irect {10, 10, 50, 50});
+    list.draw_line(cen::fpoint {0, 0}, cen::fpoint {100, 100});
+    list.render(*mTexture, cen::frect {100, 100, 50, 50});
+    list.render(*mTexture, cen::irect {0, 0, 10, 10}, cen::frect {200, 100, 50, 50});
+  }};
+  worker.join();
+
+  ASSERT_EQ(6u, list.size());
+  ASSERT_EQ(cen::success, list.execute(*mRenderer));
+  ASSERT_EQ(cen::colors::red, mRenderer->get_color());
+
+  /* Lists may be executed several times */
+  ASSERT_EQ(cen::success, list.execute(*mRenderer));
+
+  list.reset();
+  ASSERT_TRUE(list.empty());
+}
+
+TEST_F(RenderCommandListTest, Optimize)
+{
+  cen::render_command_list list;
+
+  list.set_color(cen::colors::red);
+  list.set_color(cen::colors::blue);  // Overrides the previous color
+  list.set_blend_mode(cen::blend_mode::blend);
+  list.fill_rect(cen::frect {0, 0, 10, 10});
+
+  list.set_color(cen::colors::blue);  // Same as the current color
+  list.set_blend_mode(cen::blend_mode::add);
+  list.fill_rect(cen::frect {0, 0, 10, 10});
+
+  list.set_clip(cen::irect {0, 0, 50, 50});
+  list.reset_clip();  // Overrides the previous clip
+
+  ASSERT_EQ(10u, list.size());
+  ASSERT_EQ(4u, list.optimize());
+  ASSERT_EQ(6u, list.size());
+
+  ASSERT_EQ(cen::success, list.execute(*mRenderer));
+  ASSERT_EQ(cen::colors::blue, mRenderer->get_color());
+  ASSERT_EQ(cen::blend_mode::add, mRenderer->get_blend_mode());
+}
+
+TEST_F(RenderCommandListTest, ExecuteViews)
+{
+  const auto output = mRenderer->output_size();
+  const auto viewports = cen::split_screen(cen::irect {{0, 0}, output}, 2);
+
+  std::vector<cen::render_view> views;
+  views.push_back(cen::make_render_view(viewports.at(0), cen::frect {0, 0, 100, 100}));
+  views.push_back(cen::make_render_view(viewports.at(1), cen::frect {50, 50, 100, 100}));
+
+  cen::render_command_list list;
+  list.clear_with(cen::colors::black);
+  list.set_viewport(cen::irect {0, 0, 10, 10});  // Ignored, the views own the viewport
+  list.set_color(cen::colors::red);
+  list.fill_rect(cen::frect {10, 10, 50, 50});
+  list.set_clip(cen::irect {0, 0, 75, 75});
+  list.draw_line(cen::fpoint {0, 0}, cen::fpoint {100, 100});
+  list.reset_clip();
+  list.render(*mTexture, cen::frect {120, 120, 20, 20});
+
+  const auto viewport = mRenderer->viewport();
+  ASSERT_EQ(cen::success, list.execute(*mRenderer, views));
+
+  ASSERT_EQ(cen::colors::red, mRenderer->get_color());
+  ASSERT_EQ(viewport, mRenderer->viewport());
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+TEST_F(RenderCommandListTest, RenderGeo)
+{
+  const auto& color = cen::colors::white.get();
+
+  std::vector<SDL_Vertex> vertices;
+  vertices.push_back({{0, 0}, color, {0, 0}});
+  vertices.push_back({{10, 0}, color, {1, 0}});
+  vertices.push_back({{10, 10}, color, {1, 1}});
+
+  const std::vector<int> indices {0, 1, 2};
+
+  cen::render_command_list list;
+  list.render_geo(*mTexture, vertices, indices);
+  list.render_geo(*mTexture, vertices, std::vector<int> {});
+
+  ASSERT_EQ(2u, list.size());
+  ASSERT_EQ(cen::success, list.execute(*mRenderer));
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
+
+TEST_F(RenderCommandListTest, StreamOperator)
+{
+  const cen::render_command_list list;
+  std::cout << list << '\n';
+}
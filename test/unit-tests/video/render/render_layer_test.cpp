@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/render_layer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+
+#include "centurion/video/window.hpp"
+
+class RenderLayerTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(RenderLayerTest, Construction)
+{
+  const auto draw = [](cen::renderer_handle&) {};
+
+  ASSERT_THROW(cen::render_layer({0, 10}, draw), cen::exception);
+  ASSERT_THROW(cen::render_layer({10, -1}, draw), cen::exception);
+  ASSERT_THROW(cen::render_layer({10, 10}, nullptr), cen::exception);
+
+  const cen::render_layer layer {{100, 50}, draw};
+  ASSERT_TRUE(layer.is_dirty());
+  ASSERT_EQ(0u, layer.redraws());
+  ASSERT_EQ(0u, layer.revision());
+  ASSERT_EQ(nullptr, layer.get());
+}
+
+TEST_F(RenderLayerTest, Render)
+{
+  int calls = 0;
+  cen::render_layer layer {{100, 50}, [&](cen::renderer_handle& renderer) {
+                             renderer.set_color(cen::colors::red);
+                             renderer.fill_rect(cen::irect {0, 0, 50, 50});
+                             ++calls;
+                           }};
+
+  ASSERT_EQ(cen::success, layer.render(*mRenderer, {10, 10}));
+  ASSERT_EQ(cen::success, layer.render(*mRenderer, {20, 10}));
+  ASSERT_EQ(1, calls);
+  ASSERT_EQ(1u, layer.redraws());
+  ASSERT_FALSE(layer.is_dirty());
+  ASSERT_TRUE(layer.get());
+  ASSERT_FALSE(mRenderer->get_target());
+
+  layer.invalidate();
+  ASSERT_TRUE(layer.is_dirty());
+  ASSERT_EQ(cen::success, layer.render(*mRenderer, {10, 10}));
+  ASSERT_EQ(2, calls);
+
+  /* Only new revisions cause a redraw */
+  layer.set_revision(7);
+  ASSERT_EQ(cen::success, layer.prepare(*mRenderer));
+  layer.set_revision(7);
+  ASSERT_EQ(cen::success, layer.prepare(*mRenderer));
+  ASSERT_EQ(3, calls);
+
+  /* A new renderer scale recreates the texture */
+  const auto scale = mRenderer->scale();
+  mRenderer->set_scale({2, 2});
+  ASSERT_EQ(cen::success, layer.render(*mRenderer, {0, 0}));
+  ASSERT_EQ(4, calls);
+  ASSERT_EQ(200, cen::texture_handle {layer.get()}.width());
+  mRenderer->set_scale(scale);
+}
+
+TEST_F(RenderLayerTest, Update)
+{
+  cen::render_layer layer {{10, 10}, [](cen::renderer_handle&) {}};
+  ASSERT_EQ(cen::success, layer.prepare(*mRenderer));
+  ASSERT_FALSE(layer.is_dirty());
+
+  ASSERT_FALSE(layer.update(cen::event_type::quit));
+  ASSERT_FALSE(layer.is_dirty());
+
+  ASSERT_TRUE(layer.update(cen::event_type::render_targets_reset));
+  ASSERT_TRUE(layer.is_dirty());
+  ASSERT_EQ(cen::success, layer.prepare(*mRenderer));
+
+  ASSERT_TRUE(layer.update(cen::event_type::render_device_reset));
+  ASSERT_EQ(nullptr, layer.get());
+
+  layer.set_size({20, 10});
+  ASSERT_FLOAT_EQ(20, layer.size().width);
+  ASSERT_THROW(layer.set_size({0, 0}), cen::exception);
+}
+
+TEST_F(RenderLayerTest, StreamOperator)
+{
+  const cen::render_layer layer {{10, 20}, [](cen::renderer_handle&) {}};
+  std::cout << layer << '\n';
+}
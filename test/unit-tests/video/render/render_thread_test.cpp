@@ -0,0 +1,132 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/render_thread.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+#include "centurion/concurrency/semaphore.hpp"
+
+namespace {
+
+/* Blocks the render thread until the gate is opened, so that frames pile up */
+void block(cen::render_thread& rendering, cen::semaphore& started, cen::semaphore& gate)
+{
+  rendering.post([&](cen::renderer&) {
+    started.release();
+    gate.acquire();
+  });
+
+  started.acquire();
+}
+
+}  // namespace
+
+TEST(RenderThread, Defaults)
+{
+  cen::render_thread rendering {cen::window {}};
+  ASSERT_EQ(0u, rendering.submitted());
+  ASSERT_EQ(0u, rendering.rendered());
+  ASSERT_EQ(0u, rendering.dropped());
+  ASSERT_EQ(0u, rendering.failed());
+}
+
+TEST(RenderThread, SubmitOrdering)
+{
+  cen::render_thread rendering {cen::window {}};
+
+  /* Posted functions run after every frame that was submitted before them */
+  std::vector<cen::uint64> observed;
+  for (int i = 0; i < 3; ++i) {
+    auto& frame = rendering.begin_frame();
+    frame.commands.clear_with(cen::colors::black);
+    rendering.submit_frame();
+
+    rendering.invoke([&](cen::renderer&) { observed.push_back(rendering.rendered()); });
+  }
+
+  ASSERT_EQ((std::vector<cen::uint64> {1, 2, 3}), observed);
+  ASSERT_EQ(3u, rendering.submitted());
+  ASSERT_EQ(0u, rendering.dropped());
+  ASSERT_EQ(0u, rendering.failed());
+
+  /* Frame buffers are handed over, so the next frame never reuses the one being rendered */
+  auto* first = &rendering.begin_frame();
+  rendering.submit_frame();
+  auto* second = &rendering.begin_frame();
+  rendering.submit_frame();
+  ASSERT_NE(first, second);
+}
+
+TEST(RenderThread, DropStaleFrames)
+{
+  cen::render_thread rendering {cen::window {}};
+
+  cen::semaphore started {0};
+  cen::semaphore gate {0};
+  block(rendering, started, gate);
+
+  /* Only the most recent of the frames submitted while the render thread is busy is used */
+  for (int i = 0; i < 4; ++i) {
+    rendering.begin_frame().commands.clear_with(cen::colors::black);
+    rendering.submit_frame();
+  }
+
+  gate.release();
+  rendering.invoke([](cen::renderer&) {});
+
+  ASSERT_EQ(4u, rendering.submitted());
+  ASSERT_EQ(1u, rendering.rendered());
+  ASSERT_EQ(3u, rendering.dropped());
+}
+
+TEST(RenderThread, ShutdownWithPendingFrame)
+{
+  cen::uint64 renderedBeforeTask {};
+  bool ranTask {};
+
+  {
+    cen::render_thread rendering {cen::window {}};
+
+    cen::semaphore started {0};
+    cen::semaphore gate {0};
+    block(rendering, started, gate);
+
+    rendering.begin_frame().commands.clear_with(cen::colors::black);
+    rendering.submit_frame();
+
+    rendering.post([&](cen::renderer&) {
+      renderedBeforeTask = rendering.rendered();
+      ranTask = true;
+    });
+
+    /* The destructor must still render the pending frame and run the pending function */
+    gate.release();
+  }
+
+  ASSERT_TRUE(ranTask);
+  ASSERT_EQ(1u, renderedBeforeTask);
+}
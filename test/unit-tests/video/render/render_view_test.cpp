@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/render_view.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+
+TEST(RenderView, MakeRenderView)
+{
+  const auto view = cen::make_render_view(cen::irect {400, 0, 400, 300},
+                                          cen::frect {100, 100, 200, 150});
+
+  ASSERT_EQ(cen::irect(400, 0, 400, 300), view.viewport);
+  ASSERT_EQ(400, view.eye.logical_size().width);
+  ASSERT_EQ(300, view.eye.logical_size().height);
+  ASSERT_FLOAT_EQ(2.0f, view.eye.scale_x());
+  ASSERT_FLOAT_EQ(2.0f, view.eye.scale_y());
+
+  /* World coordinates are relative to the viewport, not the rendering target */
+  const auto screen = view.eye.to_screen(cen::fpoint {150, 125});
+  ASSERT_FLOAT_EQ(100, screen.x());
+  ASSERT_FLOAT_EQ(50, screen.y());
+}
+
+TEST(RenderView, SplitScreen)
+{
+  const cen::irect area {0, 0, 801, 600};
+
+  ASSERT_TRUE(cen::split_screen(area, 0).empty());
+
+  const auto single = cen::split_screen(area, 1);
+  ASSERT_EQ(1u, single.size());
+  ASSERT_EQ(area, single.at(0));
+
+  /* Two views are side by side, and the last column gets the remainder */
+  const auto pair = cen::split_screen(area, 2);
+  ASSERT_EQ(2u, pair.size());
+  ASSERT_EQ(cen::irect(0, 0, 400, 600), pair.at(0));
+  ASSERT_EQ(cen::irect(400, 0, 401, 600), pair.at(1));
+
+  const auto three = cen::split_screen(area, 3);
+  ASSERT_EQ(3u, three.size());
+  ASSERT_EQ(cen::irect(0, 0, 400, 300), three.at(0));
+  ASSERT_EQ(cen::irect(400, 0, 401, 300), three.at(1));
+  ASSERT_EQ(cen::irect(0, 300, 400, 300), three.at(2));
+
+  const auto four = cen::split_screen(cen::irect {10, 20, 100, 100}, 4);
+  ASSERT_EQ(4u, four.size());
+  ASSERT_EQ(cen::irect(60, 70, 50, 50), four.at(3));
+}
+
+TEST(RenderView, StreamOperator)
+{
+  const auto view = cen::make_render_view(cen::irect {0, 0, 400, 300},
+                                          cen::frect {0, 0, 400, 300});
+  std::cout << view << '\n';
+}
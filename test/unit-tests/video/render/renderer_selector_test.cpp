@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/renderer_selector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>  // remove
+#include <string>  // string
+
+#include "centurion/video/renderer_info.hpp"
+#include "centurion/video/window.hpp"
+
+namespace {
+
+inline const std::string cache_path = "renderer_selector_test.cache";
+
+[[nodiscard]] auto make_cfg() -> cen::renderer_selector_cfg
+{
+  cen::renderer_selector_cfg cfg;
+  cfg.cache_path = cache_path;
+  cfg.flags = 0;
+  cfg.frames = 2;
+  cfg.sprites = 16;
+  cfg.triangles = 16;
+  cfg.glyphs = 16;
+  cfg.allow_software = true;
+  return cfg;
+}
+
+}  // namespace
+
+TEST(RendererSelector, Benchmark)
+{
+  cen::window window;
+  cen::renderer_selector selector {make_cfg()};
+
+  const auto& scores = selector.benchmark(window);
+  ASSERT_FALSE(scores.empty());
+  ASSERT_TRUE(scores.front().succeeded);
+  ASSERT_FALSE(scores.front().name.empty());
+
+  for (cen::usize index = 1; index < scores.size(); ++index) {
+    if (scores[index].succeeded) {
+      ASSERT_LE(scores[index - 1].frame_time, scores[index].frame_time);
+    }
+  }
+}
+
+TEST(RendererSelector, CachedSelection)
+{
+  std::remove(cache_path.c_str());
+
+  cen::window window;
+  cen::renderer_selector selector {make_cfg()};
+
+  {
+    const auto renderer = selector.make_renderer(window);
+    ASSERT_FALSE(selector.used_cache());
+    ASSERT_FALSE(selector.scores().empty());
+  }
+
+  cen::renderer_selector other {make_cfg()};
+  {
+    const auto renderer = other.make_renderer(window);
+    ASSERT_TRUE(other.used_cache());
+    ASSERT_TRUE(other.scores().empty());
+
+    const auto info = cen::get_info(renderer);
+    ASSERT_TRUE(info);
+    ASSERT_EQ(selector.scores().front().name, info->name());
+  }
+
+  std::remove(cache_path.c_str());
+}
+
+TEST(RendererSelector, CacheKey)
+{
+  const cen::window window;
+  const auto key = cen::renderer_selector::cache_key(window);
+  ASSERT_EQ(key, cen::renderer_selector::cache_key(window));
+  ASSERT_NE(std::string::npos, key.find('|'));
+}
@@ -0,0 +1,290 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/resource_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>   // unique_ptr
+#include <utility>  // move
+
+#include "centurion/video/window.hpp"
+
+class ResourcePoolTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(ResourcePoolTest, TextureRecycling)
+{
+  cen::texture_pool pool {*mRenderer, 2};
+  ASSERT_EQ(2u, pool.max_idle());
+  ASSERT_EQ(0u, pool.idle_count());
+
+  SDL_Texture* first {};
+
+  {
+    auto texture =
+        pool.acquire({32, 16}, cen::pixel_format::rgba32, cen::texture_access::target);
+    ASSERT_TRUE(texture.is_pooled());
+    ASSERT_EQ(32, texture->width());
+    ASSERT_EQ(16, texture->height());
+    ASSERT_EQ(cen::texture_access::target, texture->access());
+
+    texture->set_alpha_mod(10);
+    texture->set_blend_mode(cen::blend_mode::add);
+
+    first = texture->get();
+  }
+
+  ASSERT_EQ(1u, pool.idle_count());
+  ASSERT_EQ(0u, pool.hits());
+  ASSERT_EQ(1u, pool.misses());
+
+  {
+    auto texture =
+        pool.acquire({32, 16}, cen::pixel_format::rgba32, cen::texture_access::target);
+    ASSERT_EQ(first, texture->get());
+    ASSERT_EQ(0xFF, texture->alpha_mod());
+    ASSERT_EQ(cen::blend_mode::none, texture->get_blend_mode());
+    ASSERT_EQ(0u, pool.idle_count());
+    ASSERT_EQ(1u, pool.hits());
+
+    /* Different keys never share textures */
+    auto other =
+        pool.acquire({32, 16}, cen::pixel_format::rgba32, cen::texture_access::streaming);
+    ASSERT_NE(first, other->get());
+    ASSERT_EQ(2u, pool.misses());
+  }
+
+  ASSERT_EQ(2u, pool.idle_count());
+
+  pool.clear();
+  ASSERT_EQ(0u, pool.idle_count());
+}
+
+TEST_F(ResourcePoolTest, MaxIdle)
+{
+  cen::texture_pool pool {*mRenderer, 1};
+
+  {
+    auto a = pool.acquire({8, 8}, cen::pixel_format::rgba32, cen::texture_access::streaming);
+    auto b = pool.acquire({8, 8}, cen::pixel_format::rgba32, cen::texture_access::streaming);
+  }
+
+  ASSERT_EQ(1u, pool.idle_count());
+
+  pool.set_max_idle(0);
+  ASSERT_EQ(0u, pool.idle_count());
+}
+
+TEST_F(ResourcePoolTest, Release)
+{
+  cen::texture_pool pool {*mRenderer};
+
+  {
+    auto texture =
+        pool.acquire({8, 8}, cen::pixel_format::rgba32, cen::texture_access::target);
+    const cen::texture released = texture.release();
+    ASSERT_TRUE(released.get());
+    ASSERT_FALSE(texture.is_pooled());
+  }
+
+  ASSERT_EQ(0u, pool.idle_count());
+}
+
+TEST_F(ResourcePoolTest, Upload)
+{
+  cen::texture_pool pool {*mRenderer};
+  cen::surface image {{20, 10}, cen::pixel_format::rgba32};
+
+  {
+    auto texture = pool.upload(image);
+    ASSERT_EQ(20, texture->width());
+    ASSERT_EQ(10, texture->height());
+    ASSERT_TRUE(texture->is_streaming());
+    ASSERT_EQ(cen::blend_mode::blend, texture->get_blend_mode());
+  }
+
+  auto texture = pool.upload(image);
+  ASSERT_EQ(1u, pool.hits());
+}
+
+TEST_F(ResourcePoolTest, SurfaceRecycling)
+{
+  cen::surface_pool pool;
+
+  SDL_Surface* first {};
+
+  {
+    auto surface = pool.acquire({16, 16}, cen::pixel_format::rgba32);
+    surface->set_alpha_mod(20);
+    first = surface->get();
+
+    cen::pooled_surface moved {std::move(surface)};
+    ASSERT_FALSE(surface.is_pooled());
+    ASSERT_TRUE(moved.is_pooled());
+  }
+
+  ASSERT_EQ(1u, pool.idle_count());
+
+  auto surface = pool.acquire({16, 16}, cen::pixel_format::rgba32);
+  ASSERT_EQ(first, surface->get());
+  ASSERT_EQ(0xFF, surface->alpha());
+  ASSERT_EQ(16, surface->width());
+
+  auto other = pool.acquire({16, 16}, cen::pixel_format::rgb24);
+  ASSERT_NE(first, other->get());
+  ASSERT_EQ(1u, pool.hits());
+  ASSERT_EQ(2u, pool.misses());
+}
+
+TEST_F(ResourcePoolTest, EvictOldest)
+{
+  cen::surface_pool pool;
+  ASSERT_FALSE(pool.oldest_use());
+  ASSERT_FALSE(pool.evict_oldest());
+  ASSERT_EQ(0u, pool.memory_usage());
+
+  SDL_Surface* small {};
+
+  {
+    auto first = pool.acquire({16, 16}, cen::pixel_format::rgba32);
+    auto second = pool.acquire({8, 8}, cen::pixel_format::rgba32);
+    small = second->get();
+  }
+
+  /* The second surface is destroyed first, so it is the oldest idle surface */
+  ASSERT_EQ(2u, pool.idle_count());
+  ASSERT_EQ(16u * 16u * 4u + 8u * 8u * 4u, pool.memory_usage());
+  ASSERT_TRUE(pool.oldest_use());
+
+  const auto oldest = *pool.oldest_use();
+  ASSERT_TRUE(pool.evict_oldest());
+  ASSERT_LT(oldest, *pool.oldest_use());
+  ASSERT_EQ(1u, pool.idle_count());
+  ASSERT_EQ(16u * 16u * 4u, pool.memory_usage());
+
+  auto recycled = pool.acquire({8, 8}, cen::pixel_format::rgba32);
+  ASSERT_NE(small, recycled->get());
+
+  auto large = pool.acquire({16, 16}, cen::pixel_format::rgba32);
+  ASSERT_EQ(0u, pool.memory_usage());
+  ASSERT_FALSE(pool.evict_oldest());
+}
+
+TEST_F(ResourcePoolTest, RenderTargetRecycling)
+{
+  cen::render_target_pool pool {*mRenderer};
+  ASSERT_EQ(mRenderer->output_size(), pool.output_size());
+  ASSERT_EQ(cen::pixel_format::rgba8888, pool.format());
+
+  SDL_Texture* first {};
+
+  {
+    auto target = pool.acquire(2);
+    ASSERT_TRUE(target->is_target());
+    ASSERT_EQ(pool.output_size().width / 2, target->width());
+    ASSERT_EQ(pool.output_size().height / 2, target->height());
+    first = target->get();
+  }
+
+  ASSERT_EQ(1u, pool.idle_count());
+
+  {
+    auto target = pool.acquire(2);
+    ASSERT_EQ(first, target->get());
+    ASSERT_EQ(1u, pool.hits());
+  }
+
+  /* Nothing happens if the output size didn't change */
+  ASSERT_FALSE(pool.sync());
+  ASSERT_EQ(1u, pool.idle_count());
+}
+
+TEST_F(ResourcePoolTest, RenderTargetResize)
+{
+  cen::render_target_pool pool {*mRenderer};
+  pool.set_output_size({64, 32});
+
+  {
+    auto stale = pool.acquire();
+    ASSERT_EQ(64, stale->width());
+
+    {
+      auto target = pool.acquire();
+    }
+
+    ASSERT_EQ(1u, pool.idle_count());
+
+    ASSERT_TRUE(pool.set_output_size({128, 64}));
+    ASSERT_EQ(0u, pool.idle_count());
+  }
+
+  /* Targets acquired before the resize are not recycled */
+  ASSERT_EQ(0u, pool.idle_count());
+
+  auto target = pool.acquire(0);
+  ASSERT_EQ(128, target->width());
+  ASSERT_EQ(64, target->height());
+}
+
+TEST_F(ResourcePoolTest, ScopedTarget)
+{
+  cen::render_target_pool pool {*mRenderer};
+
+  auto outer = pool.acquire();
+  auto inner = pool.acquire(4);
+
+  ASSERT_FALSE(mRenderer->get_target());
+
+  {
+    const cen::scoped_target a {*mRenderer, outer};
+    ASSERT_EQ(outer->get(), mRenderer->get_target().get());
+    ASSERT_FALSE(a.previous());
+
+    {
+      const cen::scoped_target b {*mRenderer, inner};
+      ASSERT_EQ(inner->get(), mRenderer->get_target().get());
+      ASSERT_EQ(outer->get(), b.previous().get());
+    }
+
+    ASSERT_EQ(outer->get(), mRenderer->get_target().get());
+  }
+
+  ASSERT_FALSE(mRenderer->get_target());
+}
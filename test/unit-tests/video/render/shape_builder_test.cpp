@@ -0,0 +1,229 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/shape_builder.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>  // min, max, reverse
+#include <cmath>      // abs
+#include <iostream>   // cout
+#include <vector>     // vector
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+namespace {
+
+[[nodiscard]] auto total_area(const cen::shape_builder& builder) -> float
+{
+  const auto& vertices = builder.vertices();
+  const auto& indices = builder.indices();
+
+  float area = 0;
+  for (cen::usize index = 0; index + 2 < indices.size(); index += 3) {
+    const auto& a = vertices.at(static_cast<cen::usize>(indices[index])).position;
+    const auto& b = vertices.at(static_cast<cen::usize>(indices[index + 1])).position;
+    const auto& c = vertices.at(static_cast<cen::usize>(indices[index + 2])).position;
+    area += std::abs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) * 0.5f;
+  }
+
+  return area;
+}
+
+}  // namespace
+
+TEST(ShapeBuilder, Defaults)
+{
+  const cen::shape_builder builder;
+  ASSERT_TRUE(builder.empty());
+  ASSERT_EQ(0u, builder.triangle_count());
+}
+
+TEST(ShapeBuilder, Line)
+{
+  cen::shape_builder builder;
+  builder.add_line({0, 0}, {10, 0}, {4});
+
+  ASSERT_EQ(2u, builder.triangle_count());
+  ASSERT_FLOAT_EQ(40, total_area(builder));
+
+  const auto& vertices = builder.vertices();
+  ASSERT_FLOAT_EQ(0, vertices.at(0).position.x);
+  ASSERT_FLOAT_EQ(2, vertices.at(0).position.y);
+  ASSERT_FLOAT_EQ(10, vertices.at(2).position.x);
+  ASSERT_FLOAT_EQ(-2, vertices.at(2).position.y);
+
+  /* Zero length and zero width lines are ignored */
+  builder.clear();
+  builder.add_line({5, 5}, {5, 5}, {4});
+  builder.add_line({0, 0}, {10, 0}, {0});
+  ASSERT_TRUE(builder.empty());
+}
+
+TEST(ShapeBuilder, Caps)
+{
+  cen::shape_builder builder;
+
+  cen::stroke_style style;
+  style.width = 4;
+  style.cap = cen::line_cap::square;
+
+  builder.add_line({0, 0}, {10, 0}, style);
+  ASSERT_FLOAT_EQ(-2, builder.vertices().at(0).position.x);
+  ASSERT_FLOAT_EQ(12, builder.vertices().at(1).position.x);
+  ASSERT_FLOAT_EQ(14 * 4, total_area(builder));
+
+  builder.clear();
+  style.cap = cen::line_cap::round;
+  builder.add_line({0, 0}, {10, 0}, style);
+
+  /* The caps are half circles beyond the end points */
+  const auto pi = 3.14159265f;
+  ASSERT_NEAR(40 + pi * 4, total_area(builder), 1.5f);
+
+  float minX = 0;
+  float maxX = 0;
+  for (const auto& vertex : builder.vertices()) {
+    minX = (std::min)(minX, vertex.position.x);
+    maxX = (std::max)(maxX, vertex.position.x);
+  }
+
+  ASSERT_NEAR(-2, minX, 0.01f);
+  ASSERT_NEAR(12, maxX, 0.01f);
+}
+
+TEST(ShapeBuilder, Joins)
+{
+  const std::vector<cen::fpoint> points {{0, 0}, {10, 0}, {10, 10}};
+
+  cen::shape_builder builder;
+  cen::stroke_style style;
+  style.width = 2;
+
+  builder.add_polyline(points, style);
+  ASSERT_EQ(6u, builder.triangle_count());
+
+  const auto& tip = builder.vertices().at(10).position;
+  ASSERT_FLOAT_EQ(11, tip.x);
+  ASSERT_FLOAT_EQ(-1, tip.y);
+
+  /* A right angle exceeds a miter limit of one, so a bevel is used instead */
+  builder.clear();
+  style.miter_limit = 1;
+  builder.add_polyline(points, style);
+  ASSERT_EQ(5u, builder.triangle_count());
+
+  builder.clear();
+  style.join = cen::line_join::bevel;
+  builder.add_polyline(points, style);
+  ASSERT_EQ(5u, builder.triangle_count());
+
+  builder.clear();
+  style.width = 20;
+  style.join = cen::line_join::round;
+  builder.add_polyline(points, style);
+  ASSERT_GT(builder.triangle_count(), 6u);
+
+  /* The outer corner area is approximately a quarter circle */
+  const auto pi = 3.14159265f;
+  ASSERT_NEAR(20 * 20 + pi * 100 / 4, total_area(builder), 4);
+}
+
+TEST(ShapeBuilder, ClosedPolyline)
+{
+  const std::vector<cen::fpoint> square {{0, 0}, {10, 0}, {10, 10}, {0, 10}};
+
+  cen::shape_builder builder;
+  builder.add_polyline(square, {2}, cen::colors::white, true);
+
+  /* Four segments and four miter joins, where the segments overlap at the inner corners */
+  ASSERT_EQ(16u, builder.triangle_count());
+  ASSERT_FLOAT_EQ(12 * 12 - 8 * 8 + 4, total_area(builder));
+}
+
+TEST(ShapeBuilder, Polygon)
+{
+  cen::shape_builder builder;
+
+  /* An L-shaped concave polygon, with clockwise and counter-clockwise windings */
+  std::vector<cen::fpoint> shape {{0, 0}, {10, 0}, {10, 5}, {5, 5}, {5, 10}, {0, 10}};
+  ASSERT_TRUE(builder.add_polygon(shape, cen::colors::red));
+  ASSERT_EQ(4u, builder.triangle_count());
+  ASSERT_FLOAT_EQ(75, total_area(builder));
+  ASSERT_EQ(cen::colors::red.get().r, builder.vertices().front().color.r);
+
+  builder.clear();
+  std::reverse(shape.begin(), shape.end());
+  ASSERT_TRUE(builder.add_polygon(shape));
+  ASSERT_EQ(4u, builder.triangle_count());
+  ASSERT_FLOAT_EQ(75, total_area(builder));
+
+  /* Collinear points do not produce triangles */
+  builder.clear();
+  const std::vector<cen::fpoint> collinear {{0, 0}, {5, 0}, {10, 0}, {10, 10}, {0, 10}};
+  ASSERT_TRUE(builder.add_polygon(collinear));
+  ASSERT_EQ(3u, builder.triangle_count());
+  ASSERT_FLOAT_EQ(100, total_area(builder));
+
+  /* Degenerate polygons are rejected */
+  builder.clear();
+  const std::vector<cen::fpoint> line {{0, 0}, {5, 0}, {10, 0}};
+  ASSERT_FALSE(builder.add_polygon(line));
+  ASSERT_FALSE(builder.add_polygon(line.data(), 2));
+  ASSERT_TRUE(builder.empty());
+  ASSERT_TRUE(builder.vertices().empty());
+}
+
+TEST(ShapeBuilder, ConvexPolygon)
+{
+  const std::vector<cen::fpoint> pentagon {{0, 0}, {10, 0}, {12, 6}, {5, 10}, {-2, 6}};
+
+  cen::shape_builder builder;
+  builder.add_convex_polygon(pentagon);
+
+  ASSERT_EQ(5u, builder.vertices().size());
+  ASSERT_EQ(3u, builder.triangle_count());
+
+  ASSERT_TRUE(builder.add_polygon(pentagon));
+  ASSERT_EQ(6u, builder.triangle_count());
+}
+
+TEST(ShapeBuilder, ToString)
+{
+  ASSERT_EQ("miter", cen::to_string(cen::line_join::miter));
+  ASSERT_EQ("bevel", cen::to_string(cen::line_join::bevel));
+  ASSERT_EQ("round", cen::to_string(cen::line_join::round));
+
+  ASSERT_EQ("butt", cen::to_string(cen::line_cap::butt));
+  ASSERT_EQ("square", cen::to_string(cen::line_cap::square));
+  ASSERT_EQ("round", cen::to_string(cen::line_cap::round));
+
+  cen::shape_builder builder;
+  builder.add_line({0, 0}, {10, 0}, {4});
+  ASSERT_EQ("shape_builder(triangles: 2)", cen::to_string(builder));
+
+  std::cout << builder << '\n';
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
@@ -0,0 +1,58 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/software_canvas.hpp"
+
+#include <gtest/gtest.h>
+
+#include "centurion/video/color.hpp"
+
+TEST(SoftwareCanvas, Defaults)
+{
+  cen::software_canvas canvas;
+  ASSERT_EQ((cen::iarea {800, 600}), canvas.size());
+  ASSERT_EQ(cen::pixel_format::argb8888, canvas.get_surface().format_info().format());
+}
+
+TEST(SoftwareCanvas, Checksum)
+{
+  cen::software_canvas a {{64, 32}};
+  cen::software_canvas b {{64, 32}};
+  ASSERT_EQ(a.checksum(), b.checksum());
+
+  auto& renderer = a.get_renderer();
+  renderer.clear_with(cen::colors::red);
+  renderer.present();
+  ASSERT_NE(a.checksum(), b.checksum());
+
+  b.get_renderer().clear_with(cen::colors::red);
+  b.get_renderer().present();
+  ASSERT_EQ(a.checksum(), b.checksum());
+
+  renderer.set_color(cen::colors::blue);
+  renderer.fill_rect(cen::irect {0, 0, 1, 1});
+  renderer.present();
+  ASSERT_NE(a.checksum(), b.checksum());
+}
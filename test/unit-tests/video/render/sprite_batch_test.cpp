@@ -0,0 +1,146 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "centurion/video/sprite_batch.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+#include <vector>    // vector
+
+#include "centurion/video/window.hpp"
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+class SpriteBatchTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+    mFirst = std::make_unique<cen::texture>(mRenderer->make_texture("resources/panda.png"));
+    mSecond = std::make_unique<cen::texture>(mRenderer->make_texture("resources/panda.png"));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mSecond.reset();
+    mFirst.reset();
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  inline static std::unique_ptr<cen::texture> mFirst;
+  inline static std::unique_ptr<cen::texture> mSecond;
+};
+
+TEST_F(SpriteBatchTest, Defaults)
+{
+  const cen::sprite_batch batch;
+  ASSERT_TRUE(batch.empty());
+  ASSERT_EQ(0u, batch.size());
+  ASSERT_EQ(0u, batch.draw_calls());
+}
+
+TEST_F(SpriteBatchTest, Flush)
+{
+  cen::sprite_batch batch;
+
+  /* Interleaved textures should still only result in one call per texture and layer */
+  for (int i = 0; i < 10; ++i) {
+    batch.add(*mFirst, cen::frect {10.0f * i, 0, 10, 10});
+    batch.add(*mSecond, cen::frect {10.0f * i, 20, 10, 10});
+  }
+
+  batch.add(*mFirst, cen::frect {0, 40, 10, 10}, 1);
+
+  ASSERT_EQ(21u, batch.size());
+  ASSERT_EQ(cen::success, batch.flush(*mRenderer));
+
+  ASSERT_TRUE(batch.empty());
+  ASSERT_EQ(3u, batch.draw_calls());
+}
+
+TEST_F(SpriteBatchTest, FlushRestoresBlendMode)
+{
+  const auto previous = mFirst->get_blend_mode();
+  mFirst->set_blend_mode(cen::blend_mode::none);
+
+  cen::sprite_batch batch;
+  batch.add(*mFirst,
+            cen::irect {{0, 0}, mFirst->size()},
+            cen::frect {0, 0, 10, 10},
+            0,
+            cen::colors::white,
+            cen::blend_mode::add);
+
+  ASSERT_EQ(cen::success, batch.flush(*mRenderer));
+  ASSERT_EQ(cen::blend_mode::none, mFirst->get_blend_mode());
+
+  mFirst->set_blend_mode(previous);
+}
+
+TEST_F(SpriteBatchTest, FlushViews)
+{
+  const auto output = mRenderer->output_size();
+  const auto viewports = cen::split_screen(cen::irect {{0, 0}, output}, 2);
+
+  std::vector<cen::render_view> views;
+  views.push_back(cen::make_render_view(viewports.at(0), cen::frect {0, 0, 100, 100}));
+  views.push_back(cen::make_render_view(viewports.at(1), cen::frect {200, 0, 100, 100}));
+
+  cen::sprite_batch batch;
+  batch.add(*mFirst, cen::frect {10, 10, 10, 10});   // Only visible in the first view
+  batch.add(*mSecond, cen::frect {210, 10, 10, 10});  // Only visible in the second view
+  batch.add(*mFirst, cen::frect {500, 500, 10, 10});  // Not visible in any view
+
+  const auto viewport = mRenderer->viewport();
+  ASSERT_EQ(cen::success, batch.flush(*mRenderer, views));
+
+  ASSERT_TRUE(batch.empty());
+  ASSERT_EQ(2u, batch.draw_calls());
+  ASSERT_EQ(viewport, mRenderer->viewport());
+
+  ASSERT_EQ(cen::success, batch.flush(*mRenderer, nullptr, 0));
+  ASSERT_EQ(0u, batch.draw_calls());
+}
+
+TEST_F(SpriteBatchTest, Clear)
+{
+  cen::sprite_batch batch;
+  batch.add(*mFirst, cen::frect {0, 0, 10, 10});
+
+  batch.clear();
+  ASSERT_TRUE(batch.empty());
+}
+
+TEST_F(SpriteBatchTest, StreamOperator)
+{
+  const cen::sprite_batch batch;
+  std::cout << batch << '\n';
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
@@ -0,0 +1,107 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/mipmapped_texture.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+
+#include "centurion/video/window.hpp"
+
+class MipmappedTextureTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+    mPool = std::make_unique<cen::thread_pool>(2);
+
+    const cen::surface image {"resources/panda.png"};
+    mTexture = std::make_unique<cen::mipmapped_texture>(*mRenderer, *mPool, image);
+  }
+
+  static void TearDownTestSuite()
+  {
+    mTexture.reset();
+    mPool.reset();
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  inline static std::unique_ptr<cen::thread_pool> mPool;
+  inline static std::unique_ptr<cen::mipmapped_texture> mTexture;
+};
+
+TEST_F(MipmappedTextureTest, Levels)
+{
+  ASSERT_EQ(8u, mTexture->level_count());
+  ASSERT_EQ(200, mTexture->size().width);
+  ASSERT_EQ(150, mTexture->size().height);
+  ASSERT_EQ(100, mTexture->level(1).width());
+  ASSERT_EQ(75, mTexture->level(1).height());
+  ASSERT_EQ(1, mTexture->level(7).width());
+
+  const cen::surface image {"resources/panda.png"};
+  const cen::mipmapped_texture limited {*mRenderer, *mPool, image, 3};
+  ASSERT_EQ(3u, limited.level_count());
+}
+
+TEST_F(MipmappedTextureTest, SelectLevel)
+{
+  const cen::irect source {0, 0, 200, 150};
+
+  ASSERT_EQ(0u, mTexture->select_level(source, {0, 0, 400, 300}));
+  ASSERT_EQ(0u, mTexture->select_level(source, {0, 0, 200, 150}));
+  ASSERT_EQ(1u, mTexture->select_level(source, {0, 0, 100, 75}));
+  ASSERT_EQ(3u, mTexture->select_level(source, {0, 0, 25, 18.75f}));
+  ASSERT_EQ(7u, mTexture->select_level(source, {0, 0, 0.1f, 0.1f}));
+
+  /* The least minified axis decides the level */
+  ASSERT_EQ(0u, mTexture->select_level(source, {0, 0, 200, 20}));
+}
+
+TEST_F(MipmappedTextureTest, Render)
+{
+  ASSERT_EQ(cen::success, mTexture->render(*mRenderer, cen::frect {0, 0, 50, 37.5f}));
+  ASSERT_EQ(2u, mTexture->last_level());
+
+  const cen::irect source {50, 50, 100, 100};
+  ASSERT_EQ(cen::success, mTexture->render(*mRenderer, source, cen::frect {0, 0, 100, 100}));
+  ASSERT_EQ(0u, mTexture->last_level());
+
+  mTexture->set_lod_bias(1);
+  ASSERT_EQ(cen::success, mTexture->render(*mRenderer, source, cen::frect {0, 0, 100, 100}));
+  ASSERT_EQ(1u, mTexture->last_level());
+  mTexture->set_lod_bias(0);
+}
+
+TEST_F(MipmappedTextureTest, StreamOperator)
+{
+  std::cout << *mTexture << '\n';
+}
@@ -0,0 +1,123 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/texture_disk_cache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>  // remove
+#include <memory>  // unique_ptr
+
+#include "centurion/io/paths.hpp"
+#include "centurion/video/window.hpp"
+
+class TextureDiskCacheTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static const auto prefs = cen::preferred_path("centurion", "tests").copy();
+  inline static const auto path = "resources/panda.png";
+  inline static const auto format = cen::pixel_format::rgba32;
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(TextureDiskCacheTest, Load)
+{
+  for (const auto compress : {false, true}) {
+    cen::texture_disk_cache cache {prefs, compress};
+
+    const cen::mapped_file source {path};
+    const auto hash = cen::texture_disk_cache::source_hash(source.data(), source.size());
+    std::remove(cache.path_of(hash, format).c_str());
+
+    const auto first = cache.load(*mRenderer, path, format);
+    ASSERT_EQ(0u, cache.hits());
+    ASSERT_EQ(1u, cache.misses());
+
+    const auto second = cache.load(*mRenderer, path, format);
+    ASSERT_EQ(1u, cache.hits());
+    ASSERT_EQ(1u, cache.misses());
+
+    ASSERT_EQ(first.size(), second.size());
+    ASSERT_EQ(format, second.format());
+
+    std::remove(cache.path_of(hash, format).c_str());
+  }
+}
+
+TEST_F(TextureDiskCacheTest, CorruptBlob)
+{
+  cen::texture_disk_cache cache {prefs};
+
+  const cen::mapped_file source {path};
+  const auto hash = cen::texture_disk_cache::source_hash(source.data(), source.size());
+  const auto blob = cache.path_of(hash, format);
+
+  {
+    cen::file file {blob, cen::file_mode::wb};
+    ASSERT_TRUE(file.write_byte(0x42));
+  }
+
+  ASSERT_FALSE(cache.find(*mRenderer, hash, format));
+
+  /* The corrupt blob is replaced by a valid one */
+  cache.load(*mRenderer, path, format);
+  ASSERT_EQ(1u, cache.misses());
+  ASSERT_TRUE(cache.find(*mRenderer, hash, format));
+
+  std::remove(blob.c_str());
+}
+
+TEST_F(TextureDiskCacheTest, PathOf)
+{
+  const cen::texture_disk_cache cache {"foo"};
+  ASSERT_EQ(cache.directory(), "foo/");
+
+  const auto blob = cache.path_of(0x1234, cen::pixel_format::rgba8888);
+  ASSERT_EQ(blob.rfind("foo/", 0), 0u);
+  ASSERT_NE(blob.find("0000000000001234"), std::string::npos);
+  ASSERT_NE(blob.find(".ctex"), std::string::npos);
+}
+
+TEST_F(TextureDiskCacheTest, Compression)
+{
+  cen::texture_disk_cache cache {prefs};
+  ASSERT_TRUE(cache.compression());
+
+  cache.set_compression(false);
+  ASSERT_FALSE(cache.compression());
+}
@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/texture_memory.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>   // uintptr_t
+#include <iostream>  // cout
+
+namespace {
+
+auto fake_texture(const std::uintptr_t value) noexcept -> SDL_Texture*
+{
+  return reinterpret_cast<SDL_Texture*>(value);
+}
+
+}  // namespace
+
+TEST(TextureMemory, EstimateTextureBytes)
+{
+  ASSERT_EQ(40'000u, cen::estimate_texture_bytes({100, 100}, cen::pixel_format::rgba32));
+  ASSERT_EQ(30'000u, cen::estimate_texture_bytes({100, 100}, cen::pixel_format::rgb24));
+  ASSERT_EQ(20'000u, cen::estimate_texture_bytes({100, 100}, cen::pixel_format::rgb565));
+
+  /* Planar formats use 12 bits per pixel, with rounded up chroma planes */
+  ASSERT_EQ(15'000u, cen::estimate_texture_bytes({100, 100}, cen::pixel_format::iyuv));
+  ASSERT_EQ(15'000u, cen::estimate_texture_bytes({100, 100}, cen::pixel_format::nv12));
+  ASSERT_EQ(9u + 8u, cen::estimate_texture_bytes({3, 3}, cen::pixel_format::yv12));
+
+  /* Packed YUV formats use two bytes per pixel, with an even width */
+  ASSERT_EQ(20'000u, cen::estimate_texture_bytes({100, 100}, cen::pixel_format::yuy2));
+  ASSERT_EQ(8u, cen::estimate_texture_bytes({3, 1}, cen::pixel_format::uyvy));
+
+  ASSERT_EQ(0u, cen::estimate_texture_bytes({100, 100}, cen::pixel_format::external_oes));
+  ASSERT_EQ(0u, cen::estimate_texture_bytes({0, 100}, cen::pixel_format::rgba32));
+}
+
+TEST(TextureMemory, Defaults)
+{
+  const cen::texture_memory_registry registry;
+  ASSERT_EQ(0u, registry.count());
+  ASSERT_EQ(0u, registry.total());
+  ASSERT_EQ(0u, registry.peak());
+  ASSERT_EQ(0u, registry.budget());
+  ASSERT_FALSE(registry.over_budget());
+  ASSERT_TRUE(registry.tags().empty());
+  ASSERT_TRUE(registry.largest(10).empty());
+}
+
+TEST(TextureMemory, TrackAndUntrack)
+{
+  cen::texture_memory_registry registry;
+
+  const auto a = fake_texture(0x10);
+  const auto b = fake_texture(0x20);
+  const auto c = fake_texture(0x30);
+
+  ASSERT_EQ(40'000u, registry.track(a, {100, 100}, cen::pixel_format::rgba32, "tiles"));
+  ASSERT_EQ(160'000u, registry.track(b, {200, 200}, cen::pixel_format::rgba32, "tiles"));
+  ASSERT_EQ(4'000u, registry.track(c, {10, 100}, cen::pixel_format::rgba32, "ui"));
+
+  ASSERT_EQ(3u, registry.count());
+  ASSERT_EQ(204'000u, registry.total());
+  ASSERT_EQ(200'000u, registry.tag_bytes("tiles"));
+  ASSERT_EQ(4'000u, registry.tag_bytes("ui"));
+  ASSERT_EQ(0u, registry.tag_bytes("fonts"));
+  ASSERT_EQ(160'000u, registry.bytes_of(b).value());
+  ASSERT_FALSE(registry.bytes_of(fake_texture(0x40)).has_value());
+
+  /* Tracking a texture again replaces the previous entry */
+  ASSERT_EQ(10'000u, registry.track(b, {50, 50}, cen::pixel_format::rgba32, "ui"));
+  ASSERT_EQ(3u, registry.count());
+  ASSERT_EQ(54'000u, registry.total());
+  ASSERT_EQ(40'000u, registry.tag_bytes("tiles"));
+  ASSERT_EQ(14'000u, registry.tag_bytes("ui"));
+  ASSERT_EQ(204'000u, registry.peak());
+
+  ASSERT_TRUE(registry.untrack(a));
+  ASSERT_FALSE(registry.untrack(a));
+  ASSERT_EQ(2u, registry.count());
+  ASSERT_EQ(14'000u, registry.total());
+  ASSERT_EQ(204'000u, registry.peak());
+
+  registry.reset_peak();
+  ASSERT_EQ(14'000u, registry.peak());
+
+  registry.clear();
+  ASSERT_EQ(0u, registry.count());
+  ASSERT_EQ(0u, registry.total());
+  ASSERT_TRUE(registry.tags().empty());
+}
+
+TEST(TextureMemory, Reports)
+{
+  cen::texture_memory_registry registry;
+  registry.track(fake_texture(0x10), {100, 100}, cen::pixel_format::rgba32, "tiles");
+  registry.track(fake_texture(0x20), {200, 200}, cen::pixel_format::rgba32, "tiles");
+  registry.track(fake_texture(0x30), {300, 300}, cen::pixel_format::rgba32, "ui");
+  registry.track(fake_texture(0x40), {10, 10}, cen::pixel_format::rgba32);
+
+  const auto largest = registry.largest(2);
+  ASSERT_EQ(2u, largest.size());
+  ASSERT_EQ(fake_texture(0x30), largest.at(0).texture);
+  ASSERT_EQ("ui", largest.at(0).tag);
+  ASSERT_EQ(360'000u, largest.at(0).bytes);
+  ASSERT_EQ(fake_texture(0x20), largest.at(1).texture);
+
+  ASSERT_EQ(4u, registry.largest(10).size());
+
+  registry.untrack(fake_texture(0x20));
+
+  const auto tags = registry.tags();
+  ASSERT_EQ(3u, tags.size());
+  ASSERT_EQ("ui", tags.at(0).name);
+  ASSERT_EQ("tiles", tags.at(1).name);
+  ASSERT_EQ(40'000u, tags.at(1).bytes);
+  ASSERT_EQ(200'000u, tags.at(1).peak);
+  ASSERT_EQ(1u, tags.at(1).count);
+  ASSERT_EQ("", tags.at(2).name);
+}
+
+TEST(TextureMemory, Budget)
+{
+  cen::texture_memory_registry registry {100'000};
+  ASSERT_EQ(100'000u, registry.budget());
+
+  registry.track(fake_texture(0x10), {100, 100}, cen::pixel_format::rgba32);
+  ASSERT_FALSE(registry.over_budget());
+  ASSERT_DOUBLE_EQ(0.4, registry.budget_usage());
+
+  registry.track(fake_texture(0x20), {200, 100}, cen::pixel_format::rgba32);
+  ASSERT_TRUE(registry.over_budget());
+
+  registry.set_budget(0);
+  ASSERT_FALSE(registry.over_budget());
+  ASSERT_DOUBLE_EQ(0.0, registry.budget_usage());
+}
+
+TEST(TextureMemory, StreamOperator)
+{
+  const cen::texture_memory_registry registry;
+  std::cout << registry << '\n';
+}
@@ -0,0 +1,144 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/texture_atlas.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>   // cout
+#include <memory>     // unique_ptr
+#include <stdexcept>  // out_of_range
+
+#include "centurion/video/window.hpp"
+
+class TextureAtlasTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(TextureAtlasTest, Defaults)
+{
+  const cen::texture_atlas atlas;
+  ASSERT_EQ(0u, atlas.size());
+  ASSERT_EQ(0u, atlas.page_count());
+  ASSERT_EQ(0u, atlas.pending_count());
+  ASSERT_EQ(2048, atlas.page_size().width);
+  ASSERT_EQ(2048, atlas.page_size().height);
+  ASSERT_EQ(1, atlas.padding());
+
+  ASSERT_THROW(cen::texture_atlas({0, 10}), cen::exception);
+}
+
+TEST_F(TextureAtlasTest, Build)
+{
+  cen::texture_atlas atlas {{128, 128}};
+
+  const auto a = atlas.add(cen::surface {{60, 60}, cen::pixel_format::rgba32});
+  const auto b = atlas.add(cen::surface {{60, 30}, cen::pixel_format::rgba32});
+  const auto c = atlas.add(cen::surface {{100, 100}, cen::pixel_format::rgba32});
+
+  ASSERT_THROW(atlas.add(cen::surface {{200, 10}, cen::pixel_format::rgba32}),
+               cen::exception);
+
+  ASSERT_EQ(3u, atlas.size());
+  ASSERT_EQ(3u, atlas.pending_count());
+  ASSERT_FALSE(atlas.region(a));
+
+  atlas.build(*mRenderer);
+  ASSERT_EQ(0u, atlas.pending_count());
+  ASSERT_EQ(2u, atlas.page_count());
+
+  const auto& ra = atlas.region(a);
+  const auto& rb = atlas.region(b);
+  const auto& rc = atlas.region(c);
+
+  ASSERT_TRUE(ra);
+  ASSERT_TRUE(rb);
+  ASSERT_TRUE(rc);
+
+  ASSERT_EQ(60, ra.source.width());
+  ASSERT_EQ(30, rb.source.height());
+  ASSERT_EQ(100, rc.source.width());
+
+  /* The small images share a page, and must not overlap */
+  ASSERT_EQ(ra.page, rb.page);
+  ASSERT_NE(ra.page, rc.page);
+  ASSERT_FALSE(cen::overlaps(ra.source, rb.source));
+
+  ASSERT_EQ(cen::success, mRenderer->render(ra, cen::ipoint {10, 10}));
+  ASSERT_EQ(cen::success, mRenderer->render(rc, cen::frect {10, 10, 50, 50}));
+
+  ASSERT_THROW((void) atlas.region(42), std::out_of_range);
+  ASSERT_THROW((void) atlas.page(42), std::out_of_range);
+}
+
+TEST_F(TextureAtlasTest, Find)
+{
+  cen::texture_atlas atlas {{128, 128}};
+  const auto id = atlas.add(cen::surface {{20, 20}, cen::pixel_format::rgba32});
+
+  ASSERT_FALSE(atlas.find_page(0));
+  ASSERT_FALSE(atlas.find_region(id + 1));
+  ASSERT_EQ(&atlas.region(id), atlas.find_region(id));
+
+  atlas.build(*mRenderer);
+  ASSERT_EQ(&atlas.page(0), atlas.find_page(0));
+  ASSERT_FALSE(atlas.find_page(1));
+}
+
+TEST_F(TextureAtlasTest, IncrementalBuild)
+{
+  cen::texture_atlas atlas {{256, 256}};
+
+  atlas.add("resources/panda.png");
+  atlas.build(*mRenderer);
+  ASSERT_EQ(1u, atlas.page_count());
+
+  atlas.add(cen::surface {{10, 10}, cen::pixel_format::rgba32});
+  atlas.build(*mRenderer);
+  ASSERT_EQ(2u, atlas.page_count());
+  ASSERT_EQ(1u, atlas.region(1).page);
+}
+
+TEST_F(TextureAtlasTest, StreamOperator)
+{
+  cen::texture_atlas atlas;
+  std::cout << atlas << '\n';
+
+  atlas.add(cen::surface {{10, 10}, cen::pixel_format::rgba32});
+  std::cout << atlas.region(0) << '\n';
+}
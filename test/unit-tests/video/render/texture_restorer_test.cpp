@@ -0,0 +1,157 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/texture_restorer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // unique_ptr
+
+#include "centurion/video/window.hpp"
+
+class TextureRestorerTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  /* Creates a texture loader that counts how many times it has been invoked */
+  [[nodiscard]] static auto make_loader(int& uploads) -> cen::texture_restorer::loader_type
+  {
+    return [&uploads](const cen::renderer_handle& renderer) {
+      ++uploads;
+      return renderer.make_texture({16, 8},
+                                   cen::pixel_format::rgba32,
+                                   cen::texture_access::non_lockable);
+    };
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST_F(TextureRestorerTest, LazyUpload)
+{
+  cen::texture_restorer restorer {*mRenderer};
+  ASSERT_TRUE(restorer.empty());
+
+  int uploads = 0;
+  const auto id = restorer.add(make_loader(uploads));
+  ASSERT_TRUE(restorer.contains(id));
+  ASSERT_FALSE(restorer.is_loaded(id));
+  ASSERT_FALSE(restorer.find(id));
+  ASSERT_EQ(0, uploads);
+  ASSERT_EQ(0u, restorer.memory_usage());
+
+  auto& texture = restorer.get(id);
+  ASSERT_EQ(16, texture.width());
+  ASSERT_EQ(1, uploads);
+  ASSERT_EQ(&texture, restorer.find(id));
+  ASSERT_EQ(1u, restorer.loaded_count());
+  ASSERT_EQ(16u * 8u * 4u, restorer.memory_usage());
+
+  restorer.get(id);
+  ASSERT_EQ(1, uploads);
+
+  ASSERT_THROW(restorer.get(id + 1), cen::exception);
+}
+
+TEST_F(TextureRestorerTest, Evict)
+{
+  cen::texture_restorer restorer {*mRenderer};
+
+  int uploads = 0;
+  const auto id = restorer.add(make_loader(uploads));
+
+  auto& texture = restorer.get(id);
+  texture.set_alpha_mod(42);
+  texture.set_color_mod(cen::colors::red);
+  texture.set_blend_mode(cen::blend_mode::add);
+
+  ASSERT_EQ(1u, restorer.evict());
+  ASSERT_FALSE(restorer.is_loaded(id));
+  ASSERT_TRUE(restorer.contains(id));
+  ASSERT_EQ(0u, restorer.memory_usage());
+  ASSERT_FALSE(restorer.evict(id));
+
+  /* The modes of the evicted texture are restored when it is uploaded again */
+  auto& restored = restorer.get(id);
+  ASSERT_EQ(2, uploads);
+  ASSERT_EQ(42, restored.alpha_mod());
+  ASSERT_EQ(cen::colors::red, restored.color_mod());
+  ASSERT_EQ(cen::blend_mode::add, restored.get_blend_mode());
+
+  ASSERT_TRUE(restorer.evict(id));
+  ASSERT_EQ(1u, restorer.reload());
+  ASSERT_TRUE(restorer.is_loaded(id));
+  ASSERT_EQ(3, uploads);
+
+  ASSERT_TRUE(restorer.erase(id));
+  ASSERT_FALSE(restorer.erase(id));
+  ASSERT_EQ(0u, restorer.memory_usage());
+}
+
+TEST_F(TextureRestorerTest, EvictOldest)
+{
+  cen::texture_restorer restorer {*mRenderer};
+  ASSERT_FALSE(restorer.oldest_use());
+  ASSERT_FALSE(restorer.evict_oldest());
+
+  int uploads = 0;
+  const auto a = restorer.add(make_loader(uploads));
+  const auto b = restorer.add(make_loader(uploads));
+
+  restorer.get(a);
+  restorer.get(b);
+  restorer.get(a);
+
+  ASSERT_TRUE(restorer.oldest_use());
+  ASSERT_TRUE(restorer.evict_oldest());
+  ASSERT_TRUE(restorer.is_loaded(a));
+  ASSERT_FALSE(restorer.is_loaded(b));
+
+  ASSERT_TRUE(restorer.evict_oldest());
+  ASSERT_FALSE(restorer.evict_oldest());
+  ASSERT_EQ(0u, restorer.loaded_count());
+}
+
+TEST_F(TextureRestorerTest, LoadFromFile)
+{
+  cen::texture_restorer restorer {*mRenderer};
+
+  const auto id = restorer.add("resources/panda.png");
+  ASSERT_FALSE(restorer.is_loaded(id));
+  ASSERT_GT(restorer.get(id).width(), 0);
+
+  const auto missing = restorer.add("foobar.png");
+  ASSERT_THROW(restorer.get(missing), cen::img_error);
+}
@@ -0,0 +1,152 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/texture_streamer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>  // unique_ptr
+#include <vector>  // vector
+
+#include "centurion/video/window.hpp"
+
+class TextureStreamerTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+    mPool = std::make_unique<cen::thread_pool>(2);
+  }
+
+  static void TearDownTestSuite()
+  {
+    mPool.reset();
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  static void wait_until_loaded(cen::texture_streamer& streamer)
+  {
+    while (streamer.loading()) {
+      streamer.update(*mRenderer);
+      SDL_Delay(1);
+    }
+
+    streamer.update(*mRenderer);
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  inline static std::unique_ptr<cen::thread_pool> mPool;
+};
+
+TEST_F(TextureStreamerTest, FitLodBudget)
+{
+  const std::vector<cen::usize> large {400, 100, 25};
+  const std::vector<cen::usize> small {40, 10};
+
+  std::vector<cen::detail::lod_candidate> candidates;
+  candidates.push_back({1, 0, &large, 10.0});
+  candidates.push_back({2, 0, &large, 1.0});
+  candidates.push_back({3, 0, &small, 5.0});
+
+  /* Everything fits, so nothing is downgraded */
+  ASSERT_EQ(840u, cen::detail::fit_lod_budget(candidates, 1'000));
+  ASSERT_EQ(2u, candidates.at(0).id);
+
+  for (auto& candidate : candidates) {
+    candidate.level = 0;
+  }
+
+  /* The least important textures are downgraded first */
+  ASSERT_EQ(540u, cen::detail::fit_lod_budget(candidates, 600));
+  ASSERT_EQ(1u, candidates.at(0).level);
+  ASSERT_EQ(0u, candidates.at(1).level);
+  ASSERT_EQ(0u, candidates.at(2).level);
+
+  /* Every texture ends up at its smallest level if the budget is too small */
+  ASSERT_EQ(60u, cen::detail::fit_lod_budget(candidates, 1));
+  ASSERT_EQ(2u, candidates.at(0).level);
+  ASSERT_EQ(1u, candidates.at(1).level);
+  ASSERT_EQ(2u, candidates.at(2).level);
+}
+
+TEST_F(TextureStreamerTest, Defaults)
+{
+  const cen::texture_streamer streamer {*mPool, 1'000};
+  ASSERT_EQ(1'000u, streamer.budget());
+  ASSERT_EQ(0u, streamer.resident_bytes());
+  ASSERT_EQ(0u, streamer.size());
+  ASSERT_EQ(4u, streamer.max_uploads());
+  ASSERT_FALSE(streamer.loading());
+}
+
+TEST_F(TextureStreamerTest, Stream)
+{
+  cen::texture_streamer streamer {*mPool, 64 * 1024 * 1024};
+
+  const auto id = streamer.load("resources/panda.png");
+  const auto missing = streamer.load("this_file_does_not_exist.png");
+  wait_until_loaded(streamer);
+
+  ASSERT_TRUE(streamer.failed(missing));
+  ASSERT_FALSE(streamer.resident_level(missing));
+
+  /* Images start out at their smallest level */
+  const auto count = streamer.level_count(id);
+  ASSERT_EQ(8u, count);
+  ASSERT_EQ(count - 1, streamer.resident_level(id).value());
+
+  /* Drawing the image at full size upgrades it */
+  ASSERT_EQ(cen::success, streamer.render(*mRenderer, id, cen::frect {0, 0, 200, 150}));
+  streamer.update(*mRenderer);
+  ASSERT_EQ(0u, streamer.resident_level(id).value());
+
+  /* Drawing the image at a quarter of its size downgrades it */
+  ASSERT_EQ(cen::success, streamer.render(*mRenderer, id, cen::frect {0, 0, 50, 37.5f}));
+  streamer.update(*mRenderer);
+  ASSERT_EQ(2u, streamer.resident_level(id).value());
+
+  ASSERT_TRUE(streamer.remove(id));
+  ASSERT_FALSE(streamer.remove(id));
+  ASSERT_EQ(0u, streamer.resident_bytes());
+}
+
+TEST_F(TextureStreamerTest, Budget)
+{
+  /* The full size image doesn't fit, but the first halved level does */
+  const auto fullSize = cen::usize {200 * 150 * 4};
+  cen::texture_streamer streamer {*mPool, fullSize / 2};
+
+  const auto id = streamer.add(cen::surface {"resources/panda.png"});
+  wait_until_loaded(streamer);
+
+  streamer.render(*mRenderer, id, cen::frect {0, 0, 400, 300});
+  streamer.update(*mRenderer);
+
+  ASSERT_EQ(1u, streamer.resident_level(id).value());
+  ASSERT_LE(streamer.resident_bytes(), streamer.budget());
+}
@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/tilemap_layer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <iostream>  // cout
+#include <memory>    // unique_ptr
+
+#include "centurion/video/window.hpp"
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+
+class TilemapLayerTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+    mTileset = std::make_unique<cen::texture>(mRenderer->make_texture("resources/panda.png"));
+  }
+
+  static void TearDownTestSuite()
+  {
+    mTileset.reset();
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+  inline static std::unique_ptr<cen::texture> mTileset;
+};
+
+TEST_F(TilemapLayerTest, Construction)
+{
+  const cen::tilemap_layer layer {*mTileset, {16, 16}, {100, 50}};
+  ASSERT_EQ(100, layer.width());
+  ASSERT_EQ(50, layer.height());
+  ASSERT_EQ(16, layer.chunk_size());
+  ASSERT_EQ(7u * 4u, layer.chunk_count());
+  ASSERT_EQ(cen::chunk_cache::geometry, layer.cache());
+  ASSERT_EQ(cen::tilemap_layer::empty, layer.at(99, 49));
+
+  ASSERT_THROW(cen::tilemap_layer(*mTileset, {0, 16}, {10, 10}), cen::exception);
+  ASSERT_THROW(cen::tilemap_layer(*mTileset, {16, 16}, {10, 0}), cen::exception);
+  ASSERT_THROW(cen::tilemap_layer(*mTileset, {16, 16}, {10, 10}, 0), cen::exception);
+  ASSERT_THROW(cen::tilemap_layer(*mTileset, {100'000, 16}, {10, 10}), cen::exception);
+}
+
+TEST_F(TilemapLayerTest, SetAndAt)
+{
+  cen::tilemap_layer layer {*mTileset, {16, 16}, {20, 20}};
+
+  layer.set(3, 4, 7);
+  ASSERT_EQ(7u, layer.at(3, 4));
+
+  ASSERT_THROW(layer.set(-1, 0, 1), cen::exception);
+  ASSERT_THROW(layer.set(0, 20, 1), cen::exception);
+  ASSERT_THROW((void) layer.at(20, 0), cen::exception);
+
+  layer.fill(2);
+  ASSERT_EQ(2u, layer.at(19, 19));
+}
+
+TEST_F(TilemapLayerTest, Render)
+{
+  cen::tilemap_layer layer {*mTileset, {16, 16}, {64, 64}, 8};
+  layer.fill(1);
+
+  /* Only the chunks that overlap the view are built, and all share one geometry call */
+  ASSERT_EQ(cen::success, layer.render(*mRenderer, cen::frect {0, 0, 200, 100}));
+  ASSERT_EQ(2u, layer.build_count());
+  ASSERT_EQ(1u, layer.draw_calls());
+
+  const auto builds = layer.build_count();
+
+  /* Static chunks are not rebuilt */
+  ASSERT_EQ(cen::success, layer.render(*mRenderer, cen::frect {0, 0, 200, 100}));
+  ASSERT_EQ(builds, layer.build_count());
+
+  /* Only the chunk that contains the changed tile is rebuilt */
+  layer.set(1, 1, 3);
+  ASSERT_EQ(cen::success, layer.render(*mRenderer, cen::frect {0, 0, 200, 100}));
+  ASSERT_EQ(builds + 1u, layer.build_count());
+}
+
+TEST_F(TilemapLayerTest, TextureCache)
+{
+  cen::tilemap_layer layer {*mTileset, {16, 16}, {32, 32}, 16, cen::chunk_cache::texture};
+  layer.fill(1);
+
+  /* Each chunk texture is rendered separately */
+  ASSERT_EQ(cen::success, layer.render(*mRenderer, cen::frect {0, 0, 300, 300}));
+  ASSERT_EQ(4u, layer.build_count());
+  ASSERT_EQ(4u, layer.draw_calls());
+  ASSERT_FALSE(mRenderer->get_target());
+}
+
+TEST_F(TilemapLayerTest, ToString)
+{
+  const cen::tilemap_layer layer {*mTileset, {16, 16}, {10, 10}};
+  std::cout << layer << '\n';
+}
+
+TEST(ChunkCache, ToString)
+{
+  ASSERT_THROW(cen::to_string(static_cast<cen::chunk_cache>(2)), cen::exception);
+
+  ASSERT_EQ("geometry", cen::to_string(cen::chunk_cache::geometry));
+  ASSERT_EQ("texture", cen::to_string(cen::chunk_cache::texture));
+
+  std::cout << "chunk_cache::geometry == " << cen::chunk_cache::geometry << '\n';
+}
+
+#endif  // SDL_VERSION_ATLEAST(2, 0, 18)
@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/video_stream.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>     // unique_ptr
+#include <stdexcept>  // runtime_error
+
+#include "centurion/video/window.hpp"
+
+namespace {
+
+/* Waits until the decoder has decoded the specified amount of frames ahead */
+void wait_for_decoder(const cen::video_stream& stream, const cen::usize count)
+{
+  for (int attempt = 0; attempt < 1'000 && stream.buffered() < count; ++attempt) {
+    SDL_Delay(1);
+  }
+}
+
+}  // namespace
+
+class VideoStreamTest : public testing::Test {
+ protected:
+  static void SetUpTestSuite()
+  {
+    mWindow = std::make_unique<cen::window>();
+    mRenderer = std::make_unique<cen::renderer>(mWindow->make_renderer());
+  }
+
+  static void TearDownTestSuite()
+  {
+    mRenderer.reset();
+    mWindow.reset();
+  }
+
+  inline static std::unique_ptr<cen::window> mWindow;
+  inline static std::unique_ptr<cen::renderer> mRenderer;
+};
+
+TEST(VideoFrame, Layout)
+{
+  const cen::video_frame nv12 {{5, 3}, cen::video_frame_format::nv12};
+  ASSERT_EQ(2u, nv12.plane_count());
+  ASSERT_EQ(5, nv12.pitch(0));
+  ASSERT_EQ(6, nv12.pitch(1));
+  ASSERT_EQ(nv12.data() + 15, nv12.plane(1));
+  ASSERT_EQ(15u + 12u, nv12.byte_size());
+
+  const cen::video_frame iyuv {{5, 3}, cen::video_frame_format::iyuv};
+  ASSERT_EQ(3u, iyuv.plane_count());
+  ASSERT_EQ(3, iyuv.pitch(1));
+  ASSERT_EQ(3, iyuv.pitch(2));
+  ASSERT_EQ(iyuv.data() + 15, iyuv.plane(1));
+  ASSERT_EQ(iyuv.data() + 21, iyuv.plane(2));
+  ASSERT_EQ(15u + 6u + 6u, iyuv.byte_size());
+}
+
+TEST(VideoFrameFormat, ToString)
+{
+  ASSERT_THROW(cen::to_string(static_cast<cen::video_frame_format>(2)), cen::exception);
+
+  ASSERT_EQ("nv12", cen::to_string(cen::video_frame_format::nv12));
+  ASSERT_EQ("iyuv", cen::to_string(cen::video_frame_format::iyuv));
+
+  ASSERT_EQ(cen::pixel_format::nv12, cen::to_pixel_format(cen::video_frame_format::nv12));
+  ASSERT_EQ(cen::pixel_format::iyuv, cen::to_pixel_format(cen::video_frame_format::iyuv));
+}
+
+TEST_F(VideoStreamTest, EmptyDecoder)
+{
+  cen::thread_pool pool {1};
+  ASSERT_THROW(cen::video_stream(*mRenderer,
+                                 {16, 16},
+                                 cen::video_frame_format::nv12,
+                                 nullptr,
+                                 pool),
+               cen::exception);
+}
+
+TEST_F(VideoStreamTest, Playback)
+{
+  constexpr int frames = 6;
+
+  cen::thread_pool pool {1};
+
+  int decoded = 0;
+  const auto decoder = [&](cen::video_frame& frame) {
+    if (decoded == frames) {
+      return false;
+    }
+
+    frame.set_timestamp(cen::seconds<double> {decoded * 0.1});
+    ++decoded;
+
+    return true;
+  };
+
+  double time = 0;
+  cen::video_stream stream {*mRenderer,
+                            {16, 16},
+                            cen::video_frame_format::iyuv,
+                            decoder,
+                            pool};
+  stream.set_clock([&] { return cen::seconds<double> {time}; });
+
+  ASSERT_EQ(4u, stream.capacity());
+  ASSERT_EQ(cen::pixel_format::iyuv, stream.get_texture().format());
+
+  wait_for_decoder(stream, stream.capacity());
+  ASSERT_EQ(4u, stream.buffered());
+
+  /* The first frame is due immediately */
+  ASSERT_TRUE(stream.update());
+  ASSERT_EQ(1u, stream.presented());
+  ASSERT_FALSE(stream.update());
+
+  /* The second and third frames are late, so only the third frame is presented */
+  time = 0.25;
+  ASSERT_TRUE(stream.update());
+  ASSERT_EQ(2u, stream.presented());
+  ASSERT_EQ(1u, stream.dropped());
+
+  time = 10;
+  while (!stream.is_finished()) {
+    stream.update();
+    SDL_Delay(1);
+  }
+
+  ASSERT_EQ(frames, decoded);
+  ASSERT_EQ(static_cast<cen::uint64>(frames), stream.presented() + stream.dropped());
+}
+
+TEST_F(VideoStreamTest, WallClock)
+{
+  cen::thread_pool pool {1};
+
+  const auto decoder = [](cen::video_frame&) { return false; };
+  cen::video_stream stream {*mRenderer,
+                            {16, 16},
+                            cen::video_frame_format::nv12,
+                            decoder,
+                            pool};
+
+  ASSERT_FALSE(stream.is_playing());
+  ASSERT_EQ(0, stream.position().count());
+
+  stream.play();
+  ASSERT_TRUE(stream.is_playing());
+
+  SDL_Delay(5);
+  stream.pause();
+  ASSERT_FALSE(stream.is_playing());
+
+  const auto position = stream.position();
+  ASSERT_GT(position.count(), 0);
+  ASSERT_EQ(position, stream.position());
+}
+
+TEST_F(VideoStreamTest, DecoderError)
+{
+  cen::thread_pool pool {1};
+
+  const auto decoder = [](cen::video_frame&) -> bool { throw std::runtime_error {"codec"}; };
+  cen::video_stream stream {*mRenderer,
+                            {16, 16},
+                            cen::video_frame_format::nv12,
+                            decoder,
+                            pool};
+
+  for (int attempt = 0; attempt < 1'000 && !stream.is_finished(); ++attempt) {
+    SDL_Delay(1);
+  }
+
+  ASSERT_TRUE(stream.is_finished());
+  ASSERT_THROW(stream.update(), std::runtime_error);
+  ASSERT_NO_THROW(stream.update());
+}
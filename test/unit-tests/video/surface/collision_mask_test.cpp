@@ -0,0 +1,192 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/collision_mask.hpp"
+
+#include <gtest/gtest.h>
+
+#include <random>  // mt19937
+
+#include "centurion/video/color.hpp"
+#include "centurion/video/pixels.hpp"
+#include "centurion/video/surface.hpp"
+
+namespace {
+
+[[nodiscard]] auto make_random_mask(const cen::iarea size,
+                                    std::mt19937& engine,
+                                    const unsigned density) -> cen::collision_mask
+{
+  cen::collision_mask mask {size};
+
+  for (int y = 0; y < size.height; ++y) {
+    for (int x = 0; x < size.width; ++x) {
+      if (engine() % 100u < density) {
+        mask.set({x, y});
+      }
+    }
+  }
+
+  return mask;
+}
+
+[[nodiscard]] auto naive_overlap_count(const cen::collision_mask& a,
+                                       const cen::collision_mask& b,
+                                       const cen::ipoint offset) -> cen::usize
+{
+  cen::usize count = 0;
+
+  for (int y = 0; y < a.height(); ++y) {
+    for (int x = 0; x < a.width(); ++x) {
+      if (a.test({x, y}) && b.test({x - offset.x(), y - offset.y()})) {
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+}  // namespace
+
+TEST(CollisionMask, Defaults)
+{
+  const cen::collision_mask mask;
+  ASSERT_EQ(0, mask.width());
+  ASSERT_EQ(0, mask.height());
+  ASSERT_EQ(0u, mask.count());
+  ASSERT_TRUE(mask.empty());
+  ASSERT_FALSE(mask.overlaps(mask, {0, 0}));
+}
+
+TEST(CollisionMask, SetAndTest)
+{
+  cen::collision_mask mask {{130, 3}};
+  ASSERT_EQ(3, mask.words_per_row());
+  ASSERT_TRUE(mask.empty());
+
+  mask.set({0, 0});
+  mask.set({64, 1});
+  mask.set({129, 2});
+
+  ASSERT_TRUE(mask.test({0, 0}));
+  ASSERT_TRUE(mask.test({64, 1}));
+  ASSERT_TRUE(mask.test({129, 2}));
+  ASSERT_FALSE(mask.test({1, 0}));
+  ASSERT_FALSE(mask.test({-1, 0}));
+  ASSERT_FALSE(mask.test({130, 2}));
+
+  ASSERT_EQ(3u, mask.count());
+  ASSERT_EQ(cen::irect(0, 0, 130, 3), mask.bounds());
+
+  mask.set({64, 1}, false);
+  ASSERT_FALSE(mask.test({64, 1}));
+  ASSERT_EQ(2u, mask.count());
+}
+
+TEST(CollisionMask, FromSurface)
+{
+  cen::surface surface {{70, 2}, cen::pixel_format::rgba32};
+  const auto info = surface.format_info();
+
+  for (int y = 0; y < surface.height(); ++y) {
+    auto* row = reinterpret_cast<cen::uint32*>(static_cast<cen::uint8*>(surface.pixel_data()) +
+                                               y * surface.pitch());
+    for (int x = 0; x < surface.width(); ++x) {
+      const auto alpha = static_cast<cen::uint8>((x * 4) % 256);
+      row[x] = info.rgba_to_pixel(cen::color {0xFF, 0xFF, 0xFF, alpha});
+    }
+  }
+
+  const cen::collision_mask mask {surface, 128};
+  ASSERT_EQ(surface.size(), mask.size());
+
+  for (int y = 0; y < surface.height(); ++y) {
+    for (int x = 0; x < surface.width(); ++x) {
+      ASSERT_EQ((x * 4) % 256 >= 128, mask.test({x, y}));
+    }
+  }
+
+  ASSERT_EQ(cen::irect(32, 0, 32, 2), mask.bounds());
+}
+
+TEST(CollisionMask, FromSurfaceWithoutAlpha)
+{
+  cen::surface surface {{8, 8}, cen::pixel_format::rgb888};
+  const auto* format = surface.get()->format;
+
+  const SDL_Rect left {0, 0, 4, 8};
+  ASSERT_EQ(0, SDL_FillRect(surface.get(), nullptr, SDL_MapRGB(format, 0xFF, 0, 0)));
+  ASSERT_EQ(0, SDL_FillRect(surface.get(), &left, SDL_MapRGB(format, 0, 0, 0)));
+  ASSERT_EQ(0, SDL_SetColorKey(surface.get(), SDL_TRUE, SDL_MapRGB(format, 0, 0, 0)));
+
+  const cen::collision_mask mask {surface};
+  ASSERT_EQ(32u, mask.count());
+  ASSERT_EQ(cen::irect(4, 0, 4, 8), mask.bounds());
+}
+
+TEST(CollisionMask, Overlaps)
+{
+  cen::collision_mask a {{100, 10}};
+  cen::collision_mask b {{10, 10}};
+
+  a.set({70, 5});
+  b.set({3, 2});
+
+  ASSERT_TRUE(a.overlaps(b, {67, 3}));
+  ASSERT_FALSE(a.overlaps(b, {66, 3}));
+  ASSERT_FALSE(a.overlaps(b, {67, 4}));
+  ASSERT_EQ(cen::ipoint(70, 5), a.find_overlap(b, {67, 3}));
+
+  /* The masks are symmetric, with the offset negated */
+  ASSERT_TRUE(b.overlaps(a, {-67, -3}));
+  ASSERT_EQ(cen::ipoint(3, 2), b.find_overlap(a, {-67, -3}));
+
+  ASSERT_FALSE(a.overlaps(b, {1'000, 0}));
+  ASSERT_FALSE(a.overlaps(b, {-1'000, 0}));
+}
+
+TEST(CollisionMask, MatchesNaiveOverlap)
+{
+  std::mt19937 engine {42};
+
+  const auto a = make_random_mask({150, 20}, engine, 5);
+  const auto b = make_random_mask({90, 15}, engine, 10);
+
+  for (int dy = -16; dy <= 21; dy += 3) {
+    for (int dx = -92; dx <= 152; ++dx) {
+      const cen::ipoint offset {dx, dy};
+      const auto expected = naive_overlap_count(a, b, offset);
+
+      ASSERT_EQ(expected, a.overlap_count(b, offset));
+      ASSERT_EQ(expected != 0, a.overlaps(b, offset));
+
+      if (const auto pixel = a.find_overlap(b, offset)) {
+        ASSERT_TRUE(a.test(*pixel));
+        ASSERT_TRUE(b.test(*pixel - offset));
+      }
+    }
+  }
+}
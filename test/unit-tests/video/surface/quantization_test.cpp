@@ -0,0 +1,222 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/quantization.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>   // abs
+#include <iostream>  // cout
+
+#include "centurion/concurrency/thread_pool.hpp"
+#include "centurion/video/color.hpp"
+#include "centurion/video/pixels.hpp"
+#include "centurion/video/surface.hpp"
+
+namespace {
+
+[[nodiscard]] auto make_gradient(const cen::iarea size) -> cen::surface
+{
+  cen::surface surface {size, cen::pixel_format::rgba32};
+  const auto info = surface.format_info();
+
+  for (int y = 0; y < size.height; ++y) {
+    auto* row = reinterpret_cast<cen::uint32*>(static_cast<cen::uint8*>(surface.pixel_data()) +
+                                               y * surface.pitch());
+    for (int x = 0; x < size.width; ++x) {
+      const auto red = static_cast<cen::uint8>(x);
+      const auto green = static_cast<cen::uint8>(y);
+      row[x] = info.rgba_to_pixel(cen::color {red, green, 0x80, 0xFF});
+    }
+  }
+
+  return surface;
+}
+
+[[nodiscard]] auto index_at(const cen::surface& surface, const int x, const int y)
+    -> cen::uint8
+{
+  return static_cast<const cen::uint8*>(surface.pixel_data())[y * surface.pitch() + x];
+}
+
+[[nodiscard]] auto color_at(const cen::surface& surface, const int x, const int y)
+    -> cen::color
+{
+  return cen::color {surface.get()->format->palette->colors[index_at(surface, x, y)]};
+}
+
+void expect_same_indices(const cen::surface& a, const cen::surface& b)
+{
+  ASSERT_EQ(a.size(), b.size());
+
+  for (int y = 0; y < a.height(); ++y) {
+    for (int x = 0; x < a.width(); ++x) {
+      ASSERT_EQ(index_at(a, x, y), index_at(b, x, y));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(Quantization, ExactColors)
+{
+  auto source = make_gradient({4, 4});
+  const auto info = source.format_info();
+
+  const cen::color colors[] {cen::colors::red, cen::colors::lime, cen::colors::blue,
+                             cen::colors::transparent};
+
+  for (int y = 0; y < 4; ++y) {
+    auto* row = reinterpret_cast<cen::uint32*>(static_cast<cen::uint8*>(source.pixel_data()) +
+                                               y * source.pitch());
+    for (int x = 0; x < 4; ++x) {
+      row[x] = info.rgba_to_pixel(colors[(x + y) % 4]);
+    }
+  }
+
+  const auto palette = cen::make_palette(source);
+  ASSERT_EQ(4, palette.size());
+
+  const auto indexed = cen::quantize(source, {16});
+  ASSERT_EQ(cen::pixel_format::index8, indexed.format_info().format());
+  ASSERT_EQ(source.size(), indexed.size());
+
+  for (int y = 0; y < 4; ++y) {
+    for (int x = 0; x < 4; ++x) {
+      ASSERT_EQ(colors[(x + y) % 4], color_at(indexed, x, y));
+    }
+  }
+}
+
+TEST(Quantization, ReducesColors)
+{
+  const auto source = make_gradient({64, 64});
+  const auto info = source.format_info();
+
+  const auto palette = cen::make_palette(source, 16);
+  ASSERT_EQ(16, palette.size());
+
+  const auto indexed = cen::quantize(source, {16});
+
+  /* Each box spans a quarter of both gradients, so the error is small */
+  for (int y = 0; y < 64; ++y) {
+    const auto* row = reinterpret_cast<const cen::uint32*>(
+        static_cast<const cen::uint8*>(source.pixel_data()) + y * source.pitch());
+
+    for (int x = 0; x < 64; ++x) {
+      const auto expected = info.pixel_to_rgba(row[x]);
+      const auto actual = color_at(indexed, x, y);
+
+      ASSERT_LE(std::abs(expected.red() - actual.red()), 8);
+      ASSERT_LE(std::abs(expected.green() - actual.green()), 8);
+      ASSERT_EQ(expected.blue(), actual.blue());
+      ASSERT_EQ(expected.alpha(), actual.alpha());
+    }
+  }
+}
+
+TEST(Quantization, ParallelMatchesSerial)
+{
+  cen::thread_pool pool {4};
+  const auto source = make_gradient({97, 123});
+
+  for (const auto dither : {cen::dither_mode::none,
+                            cen::dither_mode::ordered,
+                            cen::dither_mode::error_diffusion}) {
+    const cen::quantize_options options {32, dither};
+    expect_same_indices(cen::quantize(source, options), cen::quantize(pool, source, options));
+  }
+}
+
+TEST(Quantization, Remap)
+{
+  cen::palette palette {2};
+  ASSERT_TRUE(palette.set_color(0, cen::colors::black));
+  ASSERT_TRUE(palette.set_color(1, cen::colors::white));
+
+  cen::surface source {{2, 1}, cen::pixel_format::rgba32};
+  const auto info = source.format_info();
+
+  auto* row = static_cast<cen::uint32*>(source.pixel_data());
+  row[0] = info.rgba_to_pixel(cen::color {0x20, 0x20, 0x20});
+  row[1] = info.rgba_to_pixel(cen::color {0xD0, 0xD0, 0xD0});
+
+  const auto indexed = cen::remap(source, palette);
+  ASSERT_EQ(0, index_at(indexed, 0, 0));
+  ASSERT_EQ(1, index_at(indexed, 1, 0));
+
+  /* Swapping the palette recolors the image */
+  cen::palette inverted {2};
+  ASSERT_TRUE(inverted.set_color(0, cen::colors::white));
+  ASSERT_TRUE(inverted.set_color(1, cen::colors::black));
+
+  auto swapped = cen::remap(source, palette);
+  ASSERT_TRUE(swapped.set_palette(inverted));
+  ASSERT_EQ(cen::colors::white, color_at(swapped, 0, 0));
+  ASSERT_EQ(cen::colors::black, color_at(swapped, 1, 0));
+}
+
+TEST(Quantization, ErrorDiffusion)
+{
+  cen::palette palette {2};
+  ASSERT_TRUE(palette.set_color(0, cen::colors::black));
+  ASSERT_TRUE(palette.set_color(1, cen::colors::white));
+
+  cen::surface source {{16, 16}, cen::pixel_format::rgba32};
+  const auto info = source.format_info();
+
+  for (int y = 0; y < 16; ++y) {
+    auto* row = reinterpret_cast<cen::uint32*>(static_cast<cen::uint8*>(source.pixel_data()) +
+                                               y * source.pitch());
+    for (int x = 0; x < 16; ++x) {
+      row[x] = info.rgba_to_pixel(cen::color {0x80, 0x80, 0x80});
+    }
+  }
+
+  /* Without dithering, a uniform gray maps to a single color */
+  int white = 0;
+  const auto plain = cen::remap(source, palette);
+  const auto diffused = cen::remap(source, palette, cen::dither_mode::error_diffusion);
+
+  for (int y = 0; y < 16; ++y) {
+    for (int x = 0; x < 16; ++x) {
+      ASSERT_EQ(index_at(plain, 0, 0), index_at(plain, x, y));
+      white += index_at(diffused, x, y);
+    }
+  }
+
+  ASSERT_GT(white, 96);
+  ASSERT_LT(white, 160);
+}
+
+TEST(Quantization, DitherModeToString)
+{
+  ASSERT_THROW(cen::to_string(static_cast<cen::dither_mode>(3)), cen::exception);
+
+  ASSERT_EQ("none", cen::to_string(cen::dither_mode::none));
+  ASSERT_EQ("ordered", cen::to_string(cen::dither_mode::ordered));
+  ASSERT_EQ("error_diffusion", cen::to_string(cen::dither_mode::error_diffusion));
+
+  std::cout << "dither_mode::ordered == " << cen::dither_mode::ordered << '\n';
+}
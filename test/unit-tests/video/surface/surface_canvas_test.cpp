@@ -0,0 +1,212 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/surface_canvas.hpp"
+
+#include <gtest/gtest.h>
+
+#include "centurion/concurrency/thread_pool.hpp"
+#include "centurion/detail/color_kernels.hpp"
+#include "centurion/video/color.hpp"
+#include "centurion/video/pixels.hpp"
+#include "centurion/video/surface.hpp"
+
+namespace {
+
+inline constexpr auto kFormat = cen::pixel_format::rgba32;
+
+[[nodiscard]] auto pixel_at(const cen::surface& surface, const int x, const int y)
+    -> cen::color
+{
+  const auto* row = static_cast<const cen::uint8*>(surface.pixel_data()) + y * surface.pitch();
+  return surface.format_info().pixel_to_rgba(reinterpret_cast<const cen::uint32*>(row)[x]);
+}
+
+[[nodiscard]] auto count_pixels(const cen::surface& surface, const cen::color& color) -> int
+{
+  int count = 0;
+
+  for (int y = 0; y < surface.height(); ++y) {
+    for (int x = 0; x < surface.width(); ++x) {
+      if (pixel_at(surface, x, y) == color) {
+        ++count;
+      }
+    }
+  }
+
+  return count;
+}
+
+}  // namespace
+
+TEST(SurfaceCanvas, FillRect)
+{
+  cen::surface surface {{40, 30}, kFormat};
+
+  {
+    cen::surface_canvas canvas {surface};
+    canvas.clear(cen::colors::black);
+    canvas.fill_rect({-5, -5, 15, 10}, cen::colors::red);
+  }
+
+  ASSERT_EQ(10 * 5, count_pixels(surface, cen::colors::red));
+  ASSERT_EQ(cen::colors::red, pixel_at(surface, 9, 4));
+  ASSERT_EQ(cen::colors::black, pixel_at(surface, 10, 4));
+  ASSERT_EQ(cen::colors::black, pixel_at(surface, 9, 5));
+}
+
+TEST(SurfaceCanvas, RespectsClip)
+{
+  cen::surface surface {{16, 16}, kFormat};
+  const SDL_Rect clip {4, 4, 8, 8};
+  ASSERT_TRUE(SDL_SetClipRect(surface.get(), &clip));
+
+  cen::surface_canvas canvas {surface};
+  canvas.fill_rect({0, 0, 16, 16}, cen::colors::white);
+  canvas.draw_line({0, 0}, {15, 15}, cen::colors::red);
+
+  ASSERT_EQ(64, count_pixels(surface, cen::colors::white) +
+                    count_pixels(surface, cen::colors::red));
+  ASSERT_EQ(8, count_pixels(surface, cen::colors::red));
+}
+
+TEST(SurfaceCanvas, BlendRect)
+{
+  cen::surface surface {{37, 3}, kFormat};
+  cen::surface_canvas canvas {surface};
+
+  const cen::color background {10, 200, 30, 0xFF};
+  const cen::color overlay {250, 20, 100, 0x60};
+
+  canvas.clear(background);
+  canvas.blend_rect({0, 0, 37, 3}, overlay);
+
+  const cen::color expected {cen::detail::blend_channel(10, 250, 0x60),
+                             cen::detail::blend_channel(200, 20, 0x60),
+                             cen::detail::blend_channel(30, 100, 0x60),
+                             0xFF};
+  ASSERT_EQ(37 * 3, count_pixels(surface, expected));
+}
+
+TEST(SurfaceCanvas, BlendRectWithoutByteChannels)
+{
+  cen::surface surface {{9, 9}, cen::pixel_format::rgb565};
+  cen::surface_canvas canvas {surface};
+  ASSERT_FALSE(canvas.has_fast_blending());
+
+  canvas.clear(cen::colors::black);
+  canvas.blend_rect({0, 0, 9, 9}, cen::colors::white.with_alpha(0x80));
+
+  const auto pixel = pixel_at(surface, 4, 4);
+  ASSERT_NEAR(0x80, pixel.red(), 8);
+  ASSERT_NEAR(0x80, pixel.green(), 8);
+  ASSERT_NEAR(0x80, pixel.blue(), 8);
+}
+
+TEST(SurfaceCanvas, Lines)
+{
+  cen::surface surface {{20, 20}, kFormat};
+  cen::surface_canvas canvas {surface};
+
+  canvas.clear(cen::colors::black);
+  canvas.draw_hline({2, 1}, 10, cen::colors::red);
+  canvas.draw_vline({1, 2}, 5, cen::colors::lime);
+  canvas.draw_line({19, 10}, {10, 19}, cen::colors::blue);
+
+  ASSERT_EQ(10, count_pixels(surface, cen::colors::red));
+  ASSERT_EQ(5, count_pixels(surface, cen::colors::lime));
+  ASSERT_EQ(10, count_pixels(surface, cen::colors::blue));
+
+  ASSERT_EQ(cen::colors::blue, pixel_at(surface, 19, 10));
+  ASSERT_EQ(cen::colors::blue, pixel_at(surface, 10, 19));
+  ASSERT_EQ(cen::colors::blue, pixel_at(surface, 15, 14));
+}
+
+TEST(SurfaceCanvas, DrawRect)
+{
+  cen::surface surface {{10, 10}, kFormat};
+  cen::surface_canvas canvas {surface};
+
+  const cen::color background {0, 0, 0, 0xFF};
+  const cen::color outline {0xFF, 0xFF, 0xFF, 0x80};
+
+  canvas.clear(background);
+  canvas.draw_rect({1, 1, 8, 6}, outline);
+
+  /* Every edge pixel is blended exactly once */
+  const auto value = cen::detail::blend_channel(0, 0xFF, 0x80);
+  ASSERT_EQ(2 * 8 + 2 * 4, count_pixels(surface, cen::color {value, value, value, 0xFF}));
+}
+
+TEST(SurfaceCanvas, DrawGlyph)
+{
+  cen::surface glyph {{6, 2}, kFormat};
+  {
+    cen::surface_canvas canvas {glyph};
+    canvas.clear(cen::colors::white.with_alpha(0));
+    canvas.fill_rect({0, 0, 3, 2}, cen::colors::white);
+    canvas.fill_rect({3, 0, 1, 2}, cen::colors::white.with_alpha(0x40));
+  }
+
+  cen::surface surface {{8, 4}, kFormat};
+  cen::surface_canvas canvas {surface};
+  canvas.clear(cen::colors::black);
+  canvas.draw_glyph(glyph, {-1, 1}, cen::colors::red);
+
+  ASSERT_EQ(4, count_pixels(surface, cen::colors::red));
+  ASSERT_EQ(cen::colors::red, pixel_at(surface, 1, 2));
+
+  const cen::color partial {cen::detail::blend_channel(0, 0xFF, 0x40), 0, 0, 0xFF};
+  ASSERT_EQ(partial, pixel_at(surface, 2, 1));
+  ASSERT_EQ(cen::colors::black, pixel_at(surface, 3, 1));
+}
+
+TEST(SurfaceCanvas, ParallelMatchesSerial)
+{
+  cen::thread_pool pool {4};
+
+  cen::surface serial {{512, 300}, kFormat};
+  cen::surface parallel {{512, 300}, kFormat};
+
+  const cen::color overlay {40, 80, 160, 0x90};
+
+  {
+    cen::surface_canvas canvas {serial};
+    canvas.clear(cen::colors::orange);
+    canvas.blend_rect({1, 3, 510, 290}, overlay);
+  }
+
+  {
+    cen::surface_canvas canvas {parallel, &pool};
+    canvas.clear(cen::colors::orange);
+    canvas.blend_rect({1, 3, 510, 290}, overlay);
+  }
+
+  for (int y = 0; y < serial.height(); ++y) {
+    for (int x = 0; x < serial.width(); ++x) {
+      ASSERT_EQ(pixel_at(serial, x, y), pixel_at(parallel, x, y));
+    }
+  }
+}
@@ -0,0 +1,180 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/surface_ops.hpp"
+
+#include <gtest/gtest.h>
+
+#include "centurion/concurrency/thread_pool.hpp"
+#include "centurion/video/color.hpp"
+#include "centurion/video/pixels.hpp"
+#include "centurion/video/surface.hpp"
+
+namespace {
+
+inline constexpr auto kFormat = cen::pixel_format::rgba32;
+
+[[nodiscard]] auto make_gradient(const cen::iarea size) -> cen::surface
+{
+  cen::surface surface {size, kFormat};
+  const auto info = surface.format_info();
+
+  for (int y = 0; y < size.height; ++y) {
+    auto* row = reinterpret_cast<cen::uint32*>(static_cast<cen::uint8*>(surface.pixel_data()) +
+                                               y * surface.pitch());
+    for (int x = 0; x < size.width; ++x) {
+      const auto red = static_cast<cen::uint8>(x);
+      const auto green = static_cast<cen::uint8>(y);
+      row[x] = info.rgba_to_pixel(cen::color {red, green, 0x80, 0xFF});
+    }
+  }
+
+  return surface;
+}
+
+[[nodiscard]] auto pixel_at(const cen::surface& surface, const int x, const int y)
+    -> cen::color
+{
+  const auto* row = static_cast<const cen::uint8*>(surface.pixel_data()) + y * surface.pitch();
+  return surface.format_info().pixel_to_rgba(reinterpret_cast<const cen::uint32*>(row)[x]);
+}
+
+void expect_same_pixels(const cen::surface& a, const cen::surface& b)
+{
+  ASSERT_EQ(a.size(), b.size());
+
+  for (int y = 0; y < a.height(); ++y) {
+    for (int x = 0; x < a.width(); ++x) {
+      ASSERT_EQ(pixel_at(a, x, y), pixel_at(b, x, y));
+    }
+  }
+}
+
+}  // namespace
+
+TEST(SurfaceOps, Blit)
+{
+  const auto source = make_gradient({8, 8});
+  cen::surface destination {{16, 16}, kFormat};
+
+  ASSERT_TRUE(cen::blit(source, destination, {4, 4}));
+  ASSERT_EQ(pixel_at(source, 0, 0), pixel_at(destination, 4, 4));
+  ASSERT_EQ(pixel_at(source, 7, 7), pixel_at(destination, 11, 11));
+
+  ASSERT_TRUE(cen::blit(source, {{2, 2}, {2, 2}}, destination, {0, 0}));
+  ASSERT_EQ(pixel_at(source, 2, 2), pixel_at(destination, 0, 0));
+}
+
+TEST(SurfaceOps, ParallelBlit)
+{
+  cen::thread_pool pool {4};
+
+  const auto source = make_gradient({200, 300});
+  cen::surface serial {{256, 320}, kFormat};
+  cen::surface parallel {{256, 320}, kFormat};
+
+  ASSERT_TRUE(cen::blit(source, serial, {10, -5}));
+  ASSERT_TRUE(cen::parallel_blit(pool, source, parallel, {10, -5}));
+
+  expect_same_pixels(serial, parallel);
+}
+
+TEST(SurfaceOps, ParallelBlitScaled)
+{
+  cen::thread_pool pool {4};
+
+  const auto source = make_gradient({240, 240});
+  cen::surface serial {{120, 480}, kFormat};
+  cen::surface parallel {{120, 480}, kFormat};
+
+  ASSERT_TRUE(cen::blit_scaled(source, serial));
+  ASSERT_TRUE(cen::parallel_blit_scaled(pool, source, parallel));
+
+  expect_same_pixels(serial, parallel);
+}
+
+TEST(SurfaceOps, Downscale)
+{
+  cen::thread_pool pool {2};
+
+  const auto source = make_gradient({4, 2});
+  const auto result = cen::downscale(pool, source, {2, 1});
+
+  ASSERT_EQ((cen::iarea {2, 1}), result.size());
+  ASSERT_EQ(kFormat, result.format_info().format());
+
+  /* Each target pixel averages a 2x2 block of the source */
+  ASSERT_EQ(cen::color(1, 1, 0x80, 0xFF), pixel_at(result, 0, 0));
+  ASSERT_EQ(cen::color(3, 1, 0x80, 0xFF), pixel_at(result, 1, 0));
+}
+
+TEST(SurfaceOps, DownscaleFractional)
+{
+  cen::thread_pool pool {2};
+
+  cen::surface source {{3, 1}, kFormat};
+  auto* pixels = static_cast<cen::uint32*>(source.pixel_data());
+  pixels[0] = source.format_info().rgba_to_pixel(cen::color {0, 0, 0, 0xFF});
+  pixels[1] = source.format_info().rgba_to_pixel(cen::color {90, 0, 0, 0xFF});
+  pixels[2] = source.format_info().rgba_to_pixel(cen::color {180, 0, 0, 0xFF});
+
+  /* The middle pixel is split evenly between the two target pixels */
+  const auto result = cen::downscale(pool, source, {2, 1});
+  ASSERT_EQ(cen::color(30, 0, 0, 0xFF), pixel_at(result, 0, 0));
+  ASSERT_EQ(cen::color(150, 0, 0, 0xFF), pixel_at(result, 1, 0));
+}
+
+TEST(SurfaceOps, MakeMipChain)
+{
+  cen::thread_pool pool {2};
+
+  const auto source = make_gradient({64, 16});
+  const auto levels = cen::make_mip_chain(pool, source);
+
+  ASSERT_EQ(6u, levels.size());
+  ASSERT_EQ((cen::iarea {32, 8}), levels.at(0).size());
+  ASSERT_EQ((cen::iarea {16, 4}), levels.at(1).size());
+  ASSERT_EQ((cen::iarea {8, 2}), levels.at(2).size());
+  ASSERT_EQ((cen::iarea {4, 1}), levels.at(3).size());
+  ASSERT_EQ((cen::iarea {2, 1}), levels.at(4).size());
+  ASSERT_EQ((cen::iarea {1, 1}), levels.at(5).size());
+}
+
+TEST(SurfaceOps, SelectMipLevel)
+{
+  ASSERT_EQ(0u, cen::select_mip_level(2.0f, 6));
+  ASSERT_EQ(0u, cen::select_mip_level(1.0f, 6));
+  ASSERT_EQ(0u, cen::select_mip_level(0.6f, 6));
+  ASSERT_EQ(1u, cen::select_mip_level(0.5f, 6));
+  ASSERT_EQ(2u, cen::select_mip_level(0.2f, 6));
+
+  /* The level is limited to the smallest level */
+  ASSERT_EQ(5u, cen::select_mip_level(0.001f, 6));
+  ASSERT_EQ(5u, cen::select_mip_level(0.0f, 6));
+  ASSERT_EQ(0u, cen::select_mip_level(0.5f, 0));
+
+  /* Positive biases prefer smaller levels */
+  ASSERT_EQ(1u, cen::select_mip_level(1.0f, 6, 1.0f));
+  ASSERT_EQ(0u, cen::select_mip_level(0.5f, 6, -1.0f));
+}
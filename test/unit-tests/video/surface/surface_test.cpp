@@ -27,11 +27,14 @@
 #include <SDL_image.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>    // fill_n
 #include <iostream>     // cout
 #include <memory>       // unique_ptr
 #include <type_traits>  // ...
 #include <utility>      // move
+#include <vector>       // vector
 
+#include "centurion/common/memory.hpp"
 #include "centurion/video/color.hpp"
 #include "centurion/video/window.hpp"
 
@@ -232,6 +235,80 @@ TEST_F(SurfaceTest, ConvertTo)
   ASSERT_EQ(source.color_mod(), converted.color_mod());
 }
 
+TEST_F(SurfaceTest, FromPixels)
+{
+  /* Four pixels per row, with one pixel of padding */
+  std::vector<cen::uint32> pixels(5 * 2, 0);
+
+  auto view = cen::surface::from_pixels(pixels.data(), {4, 2}, 20, cen::pixel_format::rgba32);
+  ASSERT_FALSE(view.owns_pixels());
+  ASSERT_EQ(pixels.data(), view.pixel_data());
+  ASSERT_EQ(20, view.pitch());
+  ASSERT_EQ((cen::iarea {4, 2}), view.size());
+
+  /* Blits into the surface are visible in the wrapped memory */
+  cen::surface source {{4, 2}, cen::pixel_format::rgba32};
+  const auto red = source.format_info().rgba_to_pixel(cen::colors::red);
+  std::fill_n(static_cast<cen::uint32*>(source.pixel_data()), 8, red);
+
+  ASSERT_EQ(0, SDL_BlitSurface(source.get(), nullptr, view.get(), nullptr));
+  ASSERT_EQ(red, pixels.at(0));
+  ASSERT_EQ(red, pixels.at(5 + 3));
+  ASSERT_EQ(0u, pixels.at(4));
+
+  const auto copy = view;
+  ASSERT_TRUE(copy.owns_pixels());
+  ASSERT_NE(view.pixel_data(), copy.pixel_data());
+
+  ASSERT_TRUE(mSurface->owns_pixels());
+}
+
+TEST_F(SurfaceTest, FromPixelsSIMDBlock)
+{
+  const auto format = cen::pixel_format::argb8888;
+  cen::simd_block block {static_cast<cen::usize>(cen::surface::min_pitch(16, format) * 8)};
+  ASSERT_TRUE(block);
+
+  const auto view = cen::surface::from_pixels(block, {16, 8}, format);
+  ASSERT_FALSE(view.owns_pixels());
+  ASSERT_EQ(block.data(), view.pixel_data());
+  ASSERT_EQ(64, view.pitch());
+}
+
+TEST(Surface, MinPitch)
+{
+  static_assert(cen::surface::min_pitch(10, cen::pixel_format::argb8888) == 40);
+  static_assert(cen::surface::min_pitch(10, cen::pixel_format::rgb24) == 30);
+  static_assert(cen::surface::min_pitch(10, cen::pixel_format::index1_lsb) == 2);
+}
+
+TEST_F(SurfaceTest, Premultiply)
+{
+  cen::surface surface {{3, 1}, cen::pixel_format::rgba32};
+  auto* pixels = static_cast<cen::uint32*>(surface.pixel_data());
+
+  const auto& format = *surface.get()->format;
+  pixels[0] = SDL_MapRGBA(&format, 200, 100, 50, 0xFF);
+  pixels[1] = SDL_MapRGBA(&format, 200, 100, 50, 0x80);
+  pixels[2] = SDL_MapRGBA(&format, 200, 100, 50, 0);
+
+  ASSERT_TRUE(surface.premultiply());
+
+  ASSERT_EQ(cen::color(200, 100, 50, 0xFF), surface.format_info().pixel_to_rgba(pixels[0]));
+  ASSERT_EQ(cen::color(100, 50, 25, 0x80), surface.format_info().pixel_to_rgba(pixels[1]));
+  ASSERT_EQ(cen::color(0, 0, 0, 0), surface.format_info().pixel_to_rgba(pixels[2]));
+
+  ASSERT_TRUE(surface.unpremultiply());
+
+  ASSERT_EQ(cen::color(200, 100, 50, 0xFF), surface.format_info().pixel_to_rgba(pixels[0]));
+  ASSERT_EQ(cen::color(199, 100, 50, 0x80), surface.format_info().pixel_to_rgba(pixels[1]));
+  ASSERT_EQ(cen::color(0, 0, 0, 0), surface.format_info().pixel_to_rgba(pixels[2]));
+
+  cen::surface opaque {{3, 1}, cen::pixel_format::rgb24};
+  ASSERT_FALSE(opaque.premultiply());
+  ASSERT_FALSE(opaque.unpremultiply());
+}
+
 TEST_F(SurfaceTest, Get)
 {
   ASSERT_TRUE(mSurface->get());
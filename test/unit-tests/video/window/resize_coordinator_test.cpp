@@ -0,0 +1,116 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "centurion/video/resize_coordinator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+#include "centurion/events/window_events.hpp"
+
+namespace {
+
+auto make_size_event(const int width, const int height, const cen::u32ms timestamp)
+    -> cen::window_event
+{
+  cen::window_event event;
+  event.set_event_id(cen::window_event_id::size_changed);
+  event.set_data1(width);
+  event.set_data2(height);
+  event.set_timestamp(timestamp);
+  return event;
+}
+
+}  // namespace
+
+TEST(ResizeCoordinator, Defaults)
+{
+  const cen::resize_coordinator coordinator {cen::iarea {800, 600}};
+  ASSERT_FALSE(coordinator.is_resizing());
+  ASSERT_EQ(800, coordinator.live_size().width);
+  ASSERT_EQ(600, coordinator.committed_size().height);
+  ASSERT_EQ(cen::resize_coordinator::default_delay, coordinator.delay());
+  ASSERT_EQ(1.0f, coordinator.scale().x);
+  ASSERT_EQ(0u, coordinator.commits());
+}
+
+TEST(ResizeCoordinator, Debounce)
+{
+  cen::resize_coordinator coordinator {cen::iarea {800, 600}, cen::u32ms {100}};
+
+  std::vector<cen::iarea> commits;
+  coordinator.on_commit([&](const cen::iarea& size) { commits.push_back(size); });
+
+  ASSERT_TRUE(coordinator.update(make_size_event(810, 600, cen::u32ms {1000})));
+  ASSERT_TRUE(coordinator.update(make_size_event(820, 610, cen::u32ms {1020})));
+  ASSERT_TRUE(coordinator.update(make_size_event(1000, 500, cen::u32ms {1040})));
+  ASSERT_FALSE(coordinator.update(make_size_event(1000, 500, cen::u32ms {1050})));
+
+  ASSERT_TRUE(coordinator.is_resizing());
+  ASSERT_EQ(1.25f, coordinator.scale().x);
+  ASSERT_EQ(500.0f / 600.0f, coordinator.scale().y);
+
+  /* Still within the delay of the last size change */
+  ASSERT_FALSE(coordinator.poll(cen::u32ms {1100}));
+  ASSERT_TRUE(commits.empty());
+
+  ASSERT_TRUE(coordinator.poll(cen::u32ms {1140}));
+  ASSERT_FALSE(coordinator.poll(cen::u32ms {1200}));
+  ASSERT_FALSE(coordinator.is_resizing());
+
+  ASSERT_EQ(1u, commits.size());
+  ASSERT_EQ(1000, commits.front().width);
+  ASSERT_EQ(500, commits.front().height);
+  ASSERT_EQ(1u, coordinator.commits());
+  ASSERT_EQ(2u, coordinator.coalesced());
+  ASSERT_EQ(1.0f, coordinator.scale().y);
+}
+
+TEST(ResizeCoordinator, LiveResizeAndFlush)
+{
+  cen::resize_coordinator coordinator {cen::iarea {800, 600}};
+
+  int live = 0;
+  coordinator.on_live_resize([&](const cen::iarea&) { ++live; });
+
+  cen::window_event moved;
+  moved.set_event_id(cen::window_event_id::moved);
+  ASSERT_FALSE(coordinator.update(moved));
+
+  ASSERT_TRUE(coordinator.update(make_size_event(640, 480, cen::u32ms {10})));
+  ASSERT_TRUE(coordinator.update(make_size_event(320, 240, cen::u32ms {20})));
+  ASSERT_EQ(2, live);
+
+  ASSERT_TRUE(coordinator.flush());
+  ASSERT_FALSE(coordinator.flush());
+  ASSERT_EQ(320, coordinator.committed_size().width);
+
+  /* Returning to the committed size cancels the pending resize */
+  ASSERT_TRUE(coordinator.update(make_size_event(330, 240, cen::u32ms {30})));
+  ASSERT_TRUE(coordinator.update(make_size_event(320, 240, cen::u32ms {40})));
+  ASSERT_FALSE(coordinator.is_resizing());
+  ASSERT_FALSE(coordinator.poll(cen::u32ms {1000}));
+}
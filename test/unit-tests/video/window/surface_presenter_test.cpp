@@ -0,0 +1,105 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2019-2023 Albin Johansson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "centurion/video/surface_presenter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <vector>  // vector
+
+#include "centurion/events/window_events.hpp"
+#include "centurion/video/color.hpp"
+#include "centurion/video/window.hpp"
+
+TEST(SurfacePresenter, FullRedraw)
+{
+  cen::window window {"", cen::iarea {64, 48}, cen::window::hidden};
+  cen::surface_presenter presenter {window};
+
+  std::vector<cen::irect> areas;
+  ASSERT_TRUE(presenter.redraw([&](cen::surface_canvas& canvas, const cen::irect& area) {
+    canvas.clear(cen::colors::red);
+    areas.push_back(area);
+  }));
+
+  /* A newly acquired surface is entirely damaged */
+  ASSERT_EQ(1u, areas.size());
+  ASSERT_EQ((cen::irect {0, 0, 64, 48}), areas.front());
+  ASSERT_EQ((cen::iarea {64, 48}), presenter.size());
+
+  ASSERT_TRUE(presenter.present());
+  ASSERT_TRUE(presenter.damage().empty());
+}
+
+TEST(SurfacePresenter, PartialRedraw)
+{
+  cen::window window {"", cen::iarea {64, 48}, cen::window::hidden};
+  cen::surface_presenter presenter {window};
+
+  ASSERT_TRUE(presenter.render([](cen::surface_canvas& canvas, const cen::irect&) {
+    canvas.clear(cen::colors::black);
+  }));
+
+  presenter.add_damage({4, 4, 8, 8});
+  presenter.add_damage({40, 30, 100, 100});
+
+  std::vector<cen::irect> areas;
+  ASSERT_TRUE(presenter.render([&](cen::surface_canvas& canvas, const cen::irect& area) {
+    /* Drawing is clipped to the damaged area */
+    ASSERT_EQ(area, canvas.clip());
+    canvas.clear(cen::colors::white);
+    areas.push_back(area);
+  }));
+
+  ASSERT_EQ(2u, areas.size());
+  ASSERT_EQ((cen::irect {40, 30, 24, 18}), areas.back());
+  ASSERT_TRUE(presenter.damage().empty());
+
+  /* The clip of the surface is restored */
+  ASSERT_EQ((cen::irect {0, 0, 64, 48}), window.get_surface().clip());
+}
+
+TEST(SurfacePresenter, Resize)
+{
+  cen::window window {"", cen::iarea {64, 48}, cen::window::hidden};
+  cen::surface_presenter presenter {window};
+
+  const auto noop = [](cen::surface_canvas&, const cen::irect&) {};
+  ASSERT_TRUE(presenter.render(noop));
+
+  window.set_size({80, 60});
+
+  cen::window_event event;
+  event.set_event_id(cen::window_event_id::size_changed);
+  presenter.handle(event);
+
+  std::vector<cen::irect> areas;
+  ASSERT_TRUE(presenter.render([&](cen::surface_canvas&, const cen::irect& area) {
+    areas.push_back(area);
+  }));
+
+  ASSERT_EQ(1u, areas.size());
+  ASSERT_EQ((cen::irect {0, 0, 80, 60}), areas.front());
+  ASSERT_EQ((cen::iarea {80, 60}), presenter.size());
+}